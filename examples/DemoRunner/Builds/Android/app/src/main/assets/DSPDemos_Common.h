@@ -96,9 +96,8 @@ class AudioThumbnailComponent    : public Component,
                                    private Timer
 {
 public:
-    AudioThumbnailComponent (AudioDeviceManager& adm, AudioFormatManager& afm)
-        : audioDeviceManager (adm),
-          thumbnailCache (5),
+    AudioThumbnailComponent (AudioDeviceManager&, AudioFormatManager& afm)
+        : thumbnailCache (5),
           thumbnail (128, afm, thumbnailCache)
     {
         thumbnail.addChangeListener (this);
@@ -160,7 +159,6 @@ public:
     }
 
 private:
-    AudioDeviceManager& audioDeviceManager;
     AudioThumbnailCache thumbnailCache;
     AudioThumbnail thumbnail;
     AudioTransportSource* transportSource = nullptr;
@@ -208,8 +206,6 @@ private:
     {
         if (transportSource != nullptr)
         {
-            const ScopedLock sl (audioDeviceManager.getAudioCallbackLock());
-
             transportSource->setPosition ((jmax (static_cast<double> (e.x), 0.0) / getWidth())
                                             * thumbnail.getTotalLength());
         }
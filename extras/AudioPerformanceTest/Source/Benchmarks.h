@@ -0,0 +1,613 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Benchmarks for the hot paths of the audio and DSP modules.
+
+    Each benchmark prepares its own state from a fixed random seed, and is then timed
+    over several repetitions, so that results are comparable between runs and builds.
+    Results can be written as JSON, and compared against a baseline written by an
+    earlier run to find regressions.
+*/
+class BenchmarkSuite
+{
+public:
+    //==============================================================================
+    struct Result
+    {
+        String name;
+        double medianMicroseconds = 0.0;    // per iteration
+        double minMicroseconds = 0.0;       // per iteration
+        int numIterations = 0;              // per repetition
+    };
+
+    struct Comparison
+    {
+        String name;
+        double baselineMicroseconds = 0.0, currentMicroseconds = 0.0;
+        bool isRegression = false;
+
+        double getChange() const    { return currentMicroseconds / baselineMicroseconds - 1.0; }
+    };
+
+    //==============================================================================
+    /*  Runs every benchmark whose name contains the filter string, calling
+        onResult after each one finishes.
+    */
+    static Array<Result> run (const String& filter = {},
+                              std::function<void (const Result&)> onResult = nullptr)
+    {
+        Array<Result> results;
+
+        for (auto& benchmark : getBenchmarks())
+        {
+            if (filter.isNotEmpty() && ! benchmark.name.containsIgnoreCase (filter))
+                continue;
+
+            auto result = measure (benchmark);
+            results.add (result);
+
+            if (onResult != nullptr)
+                onResult (result);
+        }
+
+        return results;
+    }
+
+    //==============================================================================
+    static var toJSON (const Array<Result>& results)
+    {
+        Array<var> list;
+
+        for (auto& r : results)
+        {
+            DynamicObject::Ptr obj (new DynamicObject());
+            obj->setProperty ("name", r.name);
+            obj->setProperty ("medianMicroseconds", r.medianMicroseconds);
+            obj->setProperty ("minMicroseconds", r.minMicroseconds);
+            obj->setProperty ("iterations", r.numIterations);
+            list.add (var (obj.get()));
+        }
+
+        DynamicObject::Ptr root (new DynamicObject());
+        root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+        root->setProperty ("operatingSystem", SystemStats::getOperatingSystemName());
+        root->setProperty ("cpu", SystemStats::getCpuModel());
+        root->setProperty ("numCpus", SystemStats::getNumCpus());
+        root->setProperty ("results", list);
+        return var (root.get());
+    }
+
+    static Array<Result> fromJSON (const var& json)
+    {
+        Array<Result> results;
+
+        if (auto* list = json["results"].getArray())
+            for (auto& item : *list)
+                results.add ({ item["name"].toString(),
+                               (double) item["medianMicroseconds"],
+                               (double) item["minMicroseconds"],
+                               (int) item["iterations"] });
+
+        return results;
+    }
+
+    //==============================================================================
+    /*  Compares results with a baseline. A benchmark is flagged as a regression when
+        its median time has grown by more than the given proportion of the baseline.
+    */
+    static Array<Comparison> compare (const Array<Result>& baseline, const Array<Result>& current,
+                                      double tolerance)
+    {
+        Array<Comparison> comparisons;
+
+        for (auto& r : current)
+        {
+            for (auto& b : baseline)
+            {
+                if (b.name == r.name && b.medianMicroseconds > 0.0)
+                {
+                    Comparison c { r.name, b.medianMicroseconds, r.medianMicroseconds, false };
+                    c.isRegression = c.getChange() > tolerance;
+                    comparisons.add (c);
+                    break;
+                }
+            }
+        }
+
+        return comparisons;
+    }
+
+    //==============================================================================
+    static String formatResult (const Result& r)
+    {
+        return r.name.paddedRight (' ', 52) + " | "
+             + String (r.medianMicroseconds, 3).paddedRight (' ', 12) + " | "
+             + String (r.minMicroseconds, 3);
+    }
+
+    static String formatComparison (const Comparison& c)
+    {
+        return c.name.paddedRight (' ', 52) + " | "
+             + String (c.baselineMicroseconds, 3).paddedRight (' ', 12) + " | "
+             + String (c.currentMicroseconds, 3).paddedRight (' ', 12) + " | "
+             + (c.getChange() >= 0.0 ? "+" : "") + String (100.0 * c.getChange(), 1) + "%"
+             + (c.isRegression ? "  REGRESSION" : "");
+    }
+
+private:
+    //==============================================================================
+    using Iteration = std::function<void()>;
+
+    struct Benchmark
+    {
+        String name;
+        std::function<Iteration()> prepare;
+    };
+
+    static constexpr int blockSize = 512;
+    static constexpr int numChannels = 2;
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int64 seed = 0x1234567;
+    static constexpr int numRepetitions = 7;
+    static constexpr double targetRepetitionMs = 20.0;
+    static constexpr int encodedLengthInSamples = 1 << 16;
+
+    static double getPreciseTimeMs() noexcept
+    {
+        return 1000.0 * (double) Time::getHighResolutionTicks() / (double) Time::getHighResolutionTicksPerSecond();
+    }
+
+    static Result measure (const Benchmark& benchmark)
+    {
+        auto iteration = benchmark.prepare();
+
+        // Warm up, and choose the number of iterations so that each repetition
+        // takes long enough to be timed reliably.
+        int numIterations = 1;
+
+        for (;;)
+        {
+            const auto start = getPreciseTimeMs();
+
+            for (int i = 0; i < numIterations; ++i)
+                iteration();
+
+            const auto elapsed = getPreciseTimeMs() - start;
+
+            if (elapsed >= targetRepetitionMs || numIterations >= (1 << 24))
+                break;
+
+            numIterations = elapsed > 0.0 ? jlimit (numIterations * 2, 1 << 24, (int) (numIterations * targetRepetitionMs / elapsed) + 1)
+                                          : numIterations * 16;
+        }
+
+        std::vector<double> times;
+
+        for (int rep = 0; rep < numRepetitions; ++rep)
+        {
+            const auto start = getPreciseTimeMs();
+
+            for (int i = 0; i < numIterations; ++i)
+                iteration();
+
+            times.push_back (1000.0 * (getPreciseTimeMs() - start) / numIterations);
+        }
+
+        std::sort (times.begin(), times.end());
+        return { benchmark.name, times[times.size() / 2], times.front(), numIterations };
+    }
+
+    static void fillWithNoise (AudioBuffer<float>& buffer, Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    static AudioBuffer<float> createNoise (int channels, int samples)
+    {
+        AudioBuffer<float> buffer (channels, samples);
+        Random random (seed);
+        fillWithNoise (buffer, random);
+        return buffer;
+    }
+
+    //==============================================================================
+    static std::vector<Benchmark> getBenchmarks()
+    {
+        std::vector<Benchmark> benchmarks;
+
+        addFloatVectorOperationsBenchmarks (benchmarks);
+       #if JUCE_MODULE_AVAILABLE_juce_dsp
+        addDspBenchmarks (benchmarks);
+       #endif
+        addSynthesiserBenchmark (benchmarks);
+        addGraphBenchmark (benchmarks);
+        addAudioFormatBenchmarks (benchmarks);
+
+        return benchmarks;
+    }
+
+    //==============================================================================
+    static void addFloatVectorOperationsBenchmarks (std::vector<Benchmark>& benchmarks)
+    {
+        struct Vectors
+        {
+            AudioBuffer<float> buffers = createNoise (3, blockSize);
+            float* a = buffers.getWritePointer (0);
+            float* b = buffers.getWritePointer (1);
+            float* c = buffers.getWritePointer (2);
+        };
+
+        const auto add = [&] (const String& name, std::function<void (Vectors&)> fn)
+        {
+            benchmarks.push_back ({ "FloatVectorOperations::" + name + ", " + String (blockSize) + " samples", [fn]
+            {
+                auto v = std::make_shared<Vectors>();
+                return Iteration ([v, fn] { fn (*v); });
+            } });
+        };
+
+        add ("multiply",        [] (Vectors& v) { FloatVectorOperations::multiply (v.c, v.a, v.b, blockSize); });
+        add ("addWithMultiply", [] (Vectors& v) { FloatVectorOperations::addWithMultiply (v.c, v.a, v.b, blockSize); });
+        add ("copyWithMultiply",[] (Vectors& v) { FloatVectorOperations::copyWithMultiply (v.c, v.a, 0.5f, blockSize); });
+        add ("clip",            [] (Vectors& v) { FloatVectorOperations::clip (v.c, v.a, -0.5f, 0.5f, blockSize); });
+        add ("findMinAndMax",   [] (Vectors& v) { ignoreUnused (FloatVectorOperations::findMinAndMax (v.a, blockSize)); });
+    }
+
+   #if JUCE_MODULE_AVAILABLE_juce_dsp
+    //==============================================================================
+    static void addDspBenchmarks (std::vector<Benchmark>& benchmarks)
+    {
+        for (const auto order : { 8, 10, 12, 14 })
+        {
+            benchmarks.push_back ({ "dsp::FFT real forward, order " + String (order), [order]
+            {
+                auto fft = std::make_shared<dsp::FFT> (order);
+                auto data = std::make_shared<AudioBuffer<float>> (createNoise (1, 2 << order));
+
+                return Iteration ([fft, data]
+                {
+                    fft->performRealOnlyForwardTransform (data->getWritePointer (0), true);
+                });
+            } });
+
+            benchmarks.push_back ({ "dsp::FFT complex forward, order " + String (order), [order]
+            {
+                auto fft = std::make_shared<dsp::FFT> (order);
+                auto input = std::make_shared<std::vector<dsp::Complex<float>>> ((size_t) 1 << order);
+                auto output = std::make_shared<std::vector<dsp::Complex<float>>> ((size_t) 1 << order);
+
+                Random random (seed);
+
+                for (auto& x : *input)
+                    x = { random.nextFloat(), random.nextFloat() };
+
+                return Iteration ([fft, input, output] { fft->perform (input->data(), output->data(), false); });
+            } });
+        }
+
+        const auto addConvolution = [&] (const String& name, int irLength, std::function<std::unique_ptr<dsp::Convolution>()> create)
+        {
+            benchmarks.push_back ({ "dsp::Convolution " + name + ", " + String (irLength) + " sample stereo IR", [irLength, create]
+            {
+                auto convolution = std::shared_ptr<dsp::Convolution> (create());
+                auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize));
+
+                // Loading the IR before prepare() makes it active immediately.
+                auto ir = createNoise (numChannels, irLength);
+                ir.applyGainRamp (0, irLength, 1.0f, 0.0f);
+                convolution->loadImpulseResponse (std::move (ir), sampleRate, dsp::Convolution::Stereo::yes,
+                                                  dsp::Convolution::Trim::no, dsp::Convolution::Normalise::yes);
+                convolution->prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+
+                return Iteration ([convolution, buffer]
+                {
+                    dsp::AudioBlock<float> block (*buffer);
+                    convolution->process (dsp::ProcessContextReplacing<float> (block));
+                });
+            } });
+        };
+
+        addConvolution ("uniform", 16384, [] { return std::make_unique<dsp::Convolution>(); });
+        addConvolution ("non-uniform", 65536, [] { return std::make_unique<dsp::Convolution> (dsp::Convolution::NonUniform { 512 }); });
+
+        benchmarks.push_back ({ "dsp::IIR::Filter low-pass, stereo", []
+        {
+            using Filter = dsp::ProcessorDuplicator<dsp::IIR::Filter<float>, dsp::IIR::Coefficients<float>>;
+
+            auto filter = std::make_shared<Filter> (dsp::IIR::Coefficients<float>::makeLowPass (sampleRate, 1000.0f));
+            filter->prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+            auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize));
+
+            return Iteration ([filter, buffer]
+            {
+                dsp::AudioBlock<float> block (*buffer);
+                filter->process (dsp::ProcessContextReplacing<float> (block));
+            });
+        } });
+
+        for (auto type : { dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                           dsp::Oversampling<float>::filterHalfBandPolyphaseIIR })
+        {
+            for (const auto order : { 1, 2, 3, 4 })
+            {
+                const auto name = String ("dsp::Oversampling ")
+                                + (type == dsp::Oversampling<float>::filterHalfBandFIREquiripple ? "FIR" : "IIR")
+                                + " " + String (1 << order) + "x, up and down";
+
+                benchmarks.push_back ({ name, [type, order]
+                {
+                    auto oversampling = std::make_shared<dsp::Oversampling<float>> (numChannels, (size_t) order, type);
+                    oversampling->initProcessing (blockSize);
+                    auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize));
+
+                    return Iteration ([oversampling, buffer]
+                    {
+                        dsp::AudioBlock<float> block (*buffer);
+                        oversampling->processSamplesUp (block);
+                        oversampling->processSamplesDown (block);
+                    });
+                } });
+            }
+        }
+    }
+   #endif
+
+    //==============================================================================
+    struct SineSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct SineVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound* sound) override
+        {
+            return dynamic_cast<SineSound*> (sound) != nullptr;
+        }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            angle = 0.0;
+            level = velocity * 0.1;
+            delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+        }
+
+        void stopNote (float, bool) override    { clearCurrentNote(); }
+        void pitchWheelMoved (int) override     {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (float) (std::sin (angle) * level);
+                angle += delta;
+
+                for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                    output.addSample (ch, i, sample);
+            }
+        }
+
+        double angle = 0.0, delta = 0.0, level = 0.0;
+    };
+
+    static void addSynthesiserBenchmark (std::vector<Benchmark>& benchmarks)
+    {
+        constexpr int numVoices = 16;
+
+        benchmarks.push_back ({ "Synthesiser, " + String (numVoices) + " sine voices", []
+        {
+            auto synth = std::make_shared<Synthesiser>();
+
+            for (int i = 0; i < numVoices; ++i)
+                synth->addVoice (new SineVoice());
+
+            synth->addSound (new SineSound());
+            synth->setCurrentPlaybackSampleRate (sampleRate);
+
+            for (int i = 0; i < numVoices; ++i)
+                synth->noteOn (1, 48 + i, 0.8f);
+
+            auto buffer = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+            auto midi = std::make_shared<MidiBuffer>();
+
+            return Iteration ([synth, buffer, midi]
+            {
+                buffer->clear();
+                synth->renderNextBlock (*buffer, *midi, 0, blockSize);
+            });
+        } });
+    }
+
+    //==============================================================================
+    struct GainProcessor  : public AudioProcessor
+    {
+        GainProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::stereo())
+                                               .withOutput ("Output", AudioChannelSet::stereo()))
+        {}
+
+        const String getName() const override                   { return "Gain"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            buffer.applyGain (0.99f);
+        }
+    };
+
+    static void addGraphBenchmark (std::vector<Benchmark>& benchmarks)
+    {
+        constexpr int numChains = 4, numNodesPerChain = 16;
+
+        benchmarks.push_back ({ "AudioProcessorGraph, " + String (numChains) + " chains of "
+                                    + String (numNodesPerChain) + " nodes", []
+        {
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+            auto graph = std::make_shared<AudioProcessorGraph>();
+            graph->setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+
+            const auto input  = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+            const auto connect = [&] (AudioProcessorGraph::NodeID source, AudioProcessorGraph::NodeID dest)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    graph->addConnection ({ { source, ch }, { dest, ch } }, AudioProcessorGraph::UpdateKind::async);
+            };
+
+            for (int chain = 0; chain < numChains; ++chain)
+            {
+                auto previous = input;
+
+                for (int i = 0; i < numNodesPerChain; ++i)
+                {
+                    const auto node = graph->addNode (std::make_unique<GainProcessor>(), {}, AudioProcessorGraph::UpdateKind::async)->nodeID;
+                    connect (previous, node);
+                    previous = node;
+                }
+
+                connect (previous, output);
+            }
+
+            // prepareToPlay() rebuilds the graph synchronously, picking up all of the deferred changes.
+            graph->prepareToPlay (sampleRate, blockSize);
+
+            auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize));
+            auto midi = std::make_shared<MidiBuffer>();
+
+            return Iteration ([graph, buffer, midi] { graph->processBlock (*buffer, *midi); });
+        } });
+    }
+
+    //==============================================================================
+    static std::shared_ptr<MemoryBlock> encodeNoise (AudioFormat& format)
+    {
+        auto encoded = std::make_shared<MemoryBlock>();
+        auto source = createNoise (numChannels, encodedLengthInSamples);
+        source.applyGain (0.5f);
+
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (*encoded, false),
+                                                                           sampleRate, (unsigned int) numChannels,
+                                                                           16, {}, 0));
+        jassert (writer != nullptr);
+        writer->writeFromAudioSampleBuffer (source, 0, encodedLengthInSamples);
+        return encoded;
+    }
+
+    // JUCE can't encode MP3, so this makes a stream of silent MPEG-1 layer III frames. Their
+    // spectra are empty, but they still go through the whole IMDCT and synthesis filterbank.
+    static std::shared_ptr<MemoryBlock> createSilentMP3Stream()
+    {
+        constexpr int frameSize = 417; // 128kbps at 44.1kHz, without padding
+        constexpr uint8 header[] = { 0xff, 0xfb, 0x90, 0x00 };
+
+        auto encoded = std::make_shared<MemoryBlock> ((size_t) (encodedLengthInSamples / 1152 + 1) * frameSize, true);
+
+        for (size_t pos = 0; pos < encoded->getSize(); pos += frameSize)
+            encoded->copyFrom (header, (int) pos, sizeof (header));
+
+        return encoded;
+    }
+
+    static void addAudioFormatBenchmarks (std::vector<Benchmark>& benchmarks)
+    {
+        using CreateFormat = std::function<std::unique_ptr<AudioFormat>()>;
+        using CreateStream = std::function<std::shared_ptr<MemoryBlock> (AudioFormat&)>;
+
+        const auto addDecode = [&] (const String& name, CreateFormat createFormat, CreateStream createStream)
+        {
+            benchmarks.push_back ({ name + " decode, 16-bit stereo, " + String (encodedLengthInSamples) + " samples", [createFormat, createStream]
+            {
+                auto format = std::shared_ptr<AudioFormat> (createFormat());
+                auto encoded = createStream (*format);
+                auto decoded = std::make_shared<AudioBuffer<float>> (numChannels, encodedLengthInSamples);
+
+                return Iteration ([format, encoded, decoded]
+                {
+                    std::unique_ptr<AudioFormatReader> reader (format->createReaderFor (new MemoryInputStream (*encoded, false), true));
+                    jassert (reader != nullptr);
+                    reader->read (decoded.get(), 0, (int) jmin ((int64) encodedLengthInSamples, reader->lengthInSamples), 0, true, true);
+                });
+            } });
+        };
+
+        // Each iteration reads a short block from 16 random places, the way a waveform scrubber would
+        const auto addSeek = [&] (const String& name, CreateFormat createFormat, CreateStream createStream)
+        {
+            benchmarks.push_back ({ name + " random seeks, 16 x " + String (blockSize) + " samples", [createFormat, createStream]
+            {
+                auto format = std::shared_ptr<AudioFormat> (createFormat());
+                auto encoded = createStream (*format);
+                auto reader = std::shared_ptr<AudioFormatReader> (format->createReaderFor (new MemoryInputStream (*encoded, false), true));
+                auto decoded = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+                jassert (reader != nullptr);
+
+                return Iteration ([format, encoded, reader, decoded]
+                {
+                    Random random (seed);
+
+                    for (int i = 0; i < 16; ++i)
+                        reader->read (decoded.get(), 0, blockSize, random.nextInt ((int) reader->lengthInSamples - blockSize), true, true);
+                });
+            } });
+        };
+
+        addDecode ("WavAudioFormat",  [] { return std::make_unique<WavAudioFormat>(); }, encodeNoise);
+       #if JUCE_USE_FLAC
+        addDecode ("FlacAudioFormat", [] { return std::make_unique<FlacAudioFormat>(); }, encodeNoise);
+       #endif
+       #if JUCE_USE_OGGVORBIS
+        addDecode ("OggVorbisAudioFormat", [] { return std::make_unique<OggVorbisAudioFormat>(); }, encodeNoise);
+        addSeek   ("OggVorbisAudioFormat", [] { return std::make_unique<OggVorbisAudioFormat>(); }, encodeNoise);
+       #endif
+       #if JUCE_USE_MP3AUDIOFORMAT
+        addDecode ("MP3AudioFormat", [] { return std::make_unique<MP3AudioFormat>(); }, [] (AudioFormat&) { return createSilentMP3Stream(); });
+        addSeek   ("MP3AudioFormat", [] { return std::make_unique<MP3AudioFormat>(); }, [] (AudioFormat&) { return createSilentMP3Stream(); });
+       #endif
+    }
+};
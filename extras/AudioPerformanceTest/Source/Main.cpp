@@ -24,6 +24,7 @@
 */
 
 #include <JuceHeader.h>
+#include "Benchmarks.h"
 #include "MainComponent.h"
 
 //==============================================================================
@@ -38,8 +39,17 @@ public:
     bool moreThanOneInstanceAllowed() override       { return true; }
 
     //==============================================================================
-    void initialise (const String&) override
+    void initialise (const String& commandLine) override
     {
+        const ArgumentList args (getApplicationName(), commandLine);
+
+        if (args.containsOption ("--benchmark"))
+        {
+            setApplicationReturnValue (runBenchmarks (args));
+            quit();
+            return;
+        }
+
         mainWindow.reset (new MainWindow (getApplicationName()));
     }
 
@@ -54,6 +64,76 @@ public:
         quit();
     }
 
+    //==============================================================================
+    /*  Runs the benchmark suite without showing any UI, e.g. from a CI job:
+
+            --benchmark                 run the suite and print the results
+            --filter=<text>             only run benchmarks whose names contain this text
+            --output=<file>             write the results to this JSON file
+            --baseline=<file>           compare against results written by an earlier run
+            --tolerance=<percent>       slow-down allowed before a benchmark counts as a regression (default 10)
+
+        Returns a non-zero exit code if a file couldn't be read or written, or if any
+        benchmark has regressed against the baseline.
+    */
+    static int runBenchmarks (const ArgumentList& args)
+    {
+        Logger::writeToLog (String ("benchmark").paddedRight (' ', 52) + " | " + String ("median us").paddedRight (' ', 12) + " | min us");
+
+        const auto results = BenchmarkSuite::run (args.getValueForOption ("--filter"), [] (const BenchmarkSuite::Result& result)
+        {
+            Logger::writeToLog (BenchmarkSuite::formatResult (result));
+        });
+
+        if (args.containsOption ("--output"))
+        {
+            const auto file = File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--output"));
+
+            if (! file.replaceWithText (JSON::toString (BenchmarkSuite::toJSON (results))))
+            {
+                Logger::writeToLog ("Couldn't write " + file.getFullPathName());
+                return 1;
+            }
+        }
+
+        if (args.containsOption ("--baseline"))
+        {
+            const auto file = File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--baseline"));
+            const auto baseline = BenchmarkSuite::fromJSON (JSON::parse (file));
+
+            if (baseline.isEmpty())
+            {
+                Logger::writeToLog ("Couldn't read a baseline from " + file.getFullPathName());
+                return 1;
+            }
+
+            const auto toleranceText = args.getValueForOption ("--tolerance");
+            const auto tolerance = (toleranceText.isNotEmpty() ? toleranceText.getDoubleValue() : 10.0) / 100.0;
+
+            Logger::writeToLog ("");
+            Logger::writeToLog (String ("benchmark").paddedRight (' ', 52) + " | " + String ("baseline us").paddedRight (' ', 12)
+                                  + " | " + String ("current us").paddedRight (' ', 12) + " | change");
+
+            int numRegressions = 0;
+
+            for (auto& comparison : BenchmarkSuite::compare (baseline, results, tolerance))
+            {
+                Logger::writeToLog (BenchmarkSuite::formatComparison (comparison));
+
+                if (comparison.isRegression)
+                    ++numRegressions;
+            }
+
+            if (numRegressions > 0)
+            {
+                Logger::writeToLog (String (numRegressions) + " benchmark(s) regressed by more than " + String (tolerance * 100.0, 1) + "%");
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
     //==============================================================================
     class MainWindow    : public DocumentWindow
     {
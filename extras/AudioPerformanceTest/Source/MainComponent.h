@@ -28,6 +28,8 @@
 #include <JuceHeader.h>
 #include <mutex>
 
+#include "Benchmarks.h"
+
 //==============================================================================
 class MainContentComponent   : public AudioAppComponent,
                                private Timer
@@ -118,6 +120,8 @@ public:
     void resized() override
     {
         loopIterationsSlider.setBounds (getLocalBounds().withSizeKeepingCentre (proportionOfWidth (0.9f), 50));
+
+        benchmarkButton.setBounds (getLocalBounds().removeFromBottom (60).withSizeKeepingCentre (proportionOfWidth (0.5f), 30));
     }
 
 private:
@@ -131,6 +135,21 @@ private:
         loopIterationsSlider.setColour (Slider::textBoxTextColourId, Colours::grey);
         updateNumLoopIterationsPerCallback();
         addAndMakeVisible (loopIterationsSlider);
+
+        benchmarkButton.onClick = [this] { runBenchmarks(); };
+        addAndMakeVisible (benchmarkButton);
+    }
+
+    //==============================================================================
+    void runBenchmarks()
+    {
+        Logger::writeToLog ("");
+        Logger::writeToLog (String ("benchmark").paddedRight (' ', 52) + " | " + String ("median us").paddedRight (' ', 12) + " | min us");
+
+        BenchmarkSuite::run ({}, [] (const BenchmarkSuite::Result& result)
+        {
+            Logger::writeToLog (BenchmarkSuite::formatResult (result));
+        });
     }
 
     //==============================================================================
@@ -266,6 +285,9 @@ private:
     int numLoopIterationsPerCallback;
 
     Slider loopIterationsSlider;
+
+    TextButton benchmarkButton { "Run benchmarks" };
+
     std::mutex metricMutex;
 
     //==============================================================================
@@ -476,6 +476,19 @@ bool InternalPluginFormat::requiresUnblockedMessageThreadDuringCreation (const P
     return false;
 }
 
+bool InternalPluginFormat::canCreateInstancesOffMessageThread (const PluginDescription& desc) const
+{
+    // The I/O processors, sine wave synth and reverb come first in the factory, and don't
+    // touch anything that belongs to the message thread. The demo plugins may start timers
+    // or load resources when they're constructed, so they're still created on the message thread.
+    const auto numTypesSafeToCreateInBackground = 6;
+
+    const auto& types = getAllTypes();
+    const auto end = types.begin() + jmin (numTypesSafeToCreateInBackground, (int) types.size());
+
+    return std::any_of (types.begin(), end, [&] (const PluginDescription& d) { return desc.name.equalsIgnoreCase (d.name); });
+}
+
 const std::vector<PluginDescription>& InternalPluginFormat::getAllTypes() const
 {
     return factory.getDescriptions();
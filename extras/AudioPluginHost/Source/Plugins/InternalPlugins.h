@@ -79,6 +79,7 @@ private:
     std::unique_ptr<AudioPluginInstance> createInstance (const String& name);
 
     bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override;
+    bool canCreateInstancesOffMessageThread (const PluginDescription&) const override;
 
     InternalPluginFactory factory;
 };
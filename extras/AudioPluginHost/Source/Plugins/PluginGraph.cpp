@@ -50,6 +50,7 @@ PluginGraph::PluginGraph (AudioPluginFormatManager& fm, KnownPluginList& kpl)
 
 PluginGraph::~PluginGraph()
 {
+    batchLoader.reset();
     graph.removeListener (this);
     graph.removeChangeListener (this);
     graph.clear();
@@ -147,6 +148,7 @@ Point<double> PluginGraph::getNodePosition (NodeID nodeID) const
 //==============================================================================
 void PluginGraph::clear()
 {
+    batchLoader.reset();
     closeAnyOpenPluginWindows();
     graph.clear();
     changed();
@@ -228,12 +230,14 @@ Result PluginGraph::loadDocument (const File& file)
     if (auto xml = parseXMLIfTagMatches (file, "FILTERGRAPH"))
     {
         graph.removeChangeListener (this);
-        restoreFromXml (*xml);
 
-        MessageManager::callAsync ([this]
+        restoreFromXml (*xml, [this]
         {
-            setChangedFlag (false);
-            graph.addChangeListener (this);
+            MessageManager::callAsync ([this]
+            {
+                setChangedFlag (false);
+                graph.addChangeListener (this);
+            });
         });
 
         return Result::ok();
@@ -382,79 +386,81 @@ static XmlElement* createNodeXml (AudioProcessorGraph::Node* const node) noexcep
     return nullptr;
 }
 
-void PluginGraph::createNodeFromXml (const XmlElement& xml)
+void PluginGraph::requestNodeFromXml (std::shared_ptr<const XmlElement> xml,
+                                      const PluginDescriptionAndPreference& pd,
+                                      bool allowFallback)
 {
-    PluginDescriptionAndPreference pd;
-    const auto nodeUsesARA = xml.getBoolAttribute ("useARA");
+   #if JUCE_PLUGINHOST_ARA && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX)
+    const auto wrapForARA = pd.useARA == PluginDescriptionAndPreference::UseARA::yes
+                         && pd.pluginDescription.hasARAExtension;
+   #else
+    const auto wrapForARA = false;
+   #endif
 
-    for (auto* e : xml.getChildIterator())
-    {
-        if (pd.pluginDescription.loadFromXml (*e))
-        {
-            pd.useARA = nodeUsesARA ? PluginDescriptionAndPreference::UseARA::yes
-                                    : PluginDescriptionAndPreference::UseARA::no;
-            break;
-        }
-    }
+    AudioPluginBatchLoader::Request request;
+    request.description = pd.pluginDescription;
+    request.initialSampleRate = graph.getSampleRate();
+    request.initialBufferSize = graph.getBlockSize();
+
+    // An ARA wrapper needs to restore the state itself, so that's done once it exists
+    if (! wrapForARA)
+        if (auto* state = xml->getChildByName ("STATE"))
+            request.state.fromBase64Encoding (state->getAllSubText());
 
-    auto createInstanceWithFallback = [&]() -> std::unique_ptr<AudioPluginInstance>
+    request.prepareInstance = [xml] (AudioPluginInstance& instance)
     {
-        auto createInstance = [this] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
+        if (auto* layoutEntity = xml->getChildByName ("LAYOUT"))
         {
-            String errorMessage;
+            auto layout = instance.getBusesLayout();
 
-            auto localDpiDisabler = makeDPIAwarenessDisablerForPlugin (description.pluginDescription);
+            readBusLayoutFromXml (layout, instance, *layoutEntity, true);
+            readBusLayoutFromXml (layout, instance, *layoutEntity, false);
 
-            auto instance = formatManager.createPluginInstance (description.pluginDescription,
-                                                                graph.getSampleRate(),
-                                                                graph.getBlockSize(),
-                                                                errorMessage);
+            instance.setBusesLayout (layout);
+        }
+    };
 
-           #if JUCE_PLUGINHOST_ARA && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX)
-            if (instance
-                && description.useARA == PluginDescriptionAndPreference::UseARA::yes
-                && description.pluginDescription.hasARAExtension)
-            {
-                return std::make_unique<ARAPluginInstanceWrapper> (std::move (instance));
-            }
-           #endif
+    std::shared_ptr<ScopedDPIAwarenessDisabler> dpiDisabler = makeDPIAwarenessDisablerForPlugin (pd.pluginDescription);
 
-            return instance;
-        };
+    request.callback = [this, xml, pd, allowFallback, wrapForARA, dpiDisabler] (std::unique_ptr<AudioPluginInstance> instance, const String&)
+    {
+        if (instance != nullptr)
+        {
+            addNodeFromXml (std::move (instance), *xml, wrapForARA);
+            return;
+        }
 
-        if (auto instance = createInstance (pd))
-            return instance;
+        if (! allowFallback)
+            return;
 
         const auto allFormats = formatManager.getFormats();
         const auto matchingFormat = std::find_if (allFormats.begin(), allFormats.end(),
                                                   [&] (const AudioPluginFormat* f) { return f->getName() == pd.pluginDescription.pluginFormatName; });
 
         if (matchingFormat == allFormats.end())
-            return nullptr;
+            return;
 
         const auto plugins = knownPlugins.getTypesForFormat (**matchingFormat);
         const auto matchingPlugin = std::find_if (plugins.begin(), plugins.end(),
                                                   [&] (const PluginDescription& desc) { return pd.pluginDescription.uniqueId == desc.uniqueId; });
 
-        if (matchingPlugin == plugins.end())
-            return nullptr;
-
-        return createInstance (PluginDescriptionAndPreference { *matchingPlugin });
+        if (matchingPlugin != plugins.end())
+            requestNodeFromXml (xml, PluginDescriptionAndPreference { *matchingPlugin }, false);
     };
 
-    if (auto instance = createInstanceWithFallback())
-    {
-        if (auto* layoutEntity = xml.getChildByName ("LAYOUT"))
-        {
-            auto layout = instance->getBusesLayout();
-
-            readBusLayoutFromXml (layout, *instance, *layoutEntity, true);
-            readBusLayoutFromXml (layout, *instance, *layoutEntity, false);
+    batchLoader->addRequest (std::move (request));
+}
 
-            instance->setBusesLayout (layout);
-        }
+void PluginGraph::addNodeFromXml (std::unique_ptr<AudioPluginInstance> instance, const XmlElement& xml, bool wrapForARA)
+{
+   #if JUCE_PLUGINHOST_ARA && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX)
+    if (wrapForARA)
+        instance = std::make_unique<ARAPluginInstanceWrapper> (std::move (instance));
+   #endif
 
-        if (auto node = graph.addNode (std::move (instance), NodeID ((uint32) xml.getIntAttribute ("uid"))))
+    if (auto node = graph.addNode (std::move (instance), NodeID ((uint32) xml.getIntAttribute ("uid"))))
+    {
+        if (wrapForARA)
         {
             if (auto* state = xml.getChildByName ("STATE"))
             {
@@ -463,31 +469,33 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 
                 node->getProcessor()->setStateInformation (m.getData(), (int) m.getSize());
             }
+        }
+
+        node->properties.set ("x", xml.getDoubleAttribute ("x"));
+        node->properties.set ("y", xml.getDoubleAttribute ("y"));
+        node->properties.set ("useARA", xml.getBoolAttribute ("useARA"));
 
-            node->properties.set ("x", xml.getDoubleAttribute ("x"));
-            node->properties.set ("y", xml.getDoubleAttribute ("y"));
-            node->properties.set ("useARA", xml.getBoolAttribute ("useARA"));
+        for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
+        {
+            auto type = (PluginWindow::Type) i;
 
-            for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
+            if (xml.hasAttribute (PluginWindow::getOpenProp (type)))
             {
-                auto type = (PluginWindow::Type) i;
+                node->properties.set (PluginWindow::getLastXProp (type), xml.getIntAttribute (PluginWindow::getLastXProp (type)));
+                node->properties.set (PluginWindow::getLastYProp (type), xml.getIntAttribute (PluginWindow::getLastYProp (type)));
+                node->properties.set (PluginWindow::getOpenProp  (type), xml.getIntAttribute (PluginWindow::getOpenProp (type)));
 
-                if (xml.hasAttribute (PluginWindow::getOpenProp (type)))
+                if (node->properties[PluginWindow::getOpenProp (type)])
                 {
-                    node->properties.set (PluginWindow::getLastXProp (type), xml.getIntAttribute (PluginWindow::getLastXProp (type)));
-                    node->properties.set (PluginWindow::getLastYProp (type), xml.getIntAttribute (PluginWindow::getLastYProp (type)));
-                    node->properties.set (PluginWindow::getOpenProp  (type), xml.getIntAttribute (PluginWindow::getOpenProp (type)));
-
-                    if (node->properties[PluginWindow::getOpenProp (type)])
-                    {
-                        jassert (node->getProcessor() != nullptr);
+                    jassert (node->getProcessor() != nullptr);
 
-                        if (auto w = getOrCreateWindowFor (node, type))
-                            w->toFront (true);
-                    }
+                    if (auto w = getOrCreateWindowFor (node, type))
+                        w->toFront (true);
                 }
             }
         }
+
+        changed();
     }
 }
 
@@ -511,23 +519,72 @@ std::unique_ptr<XmlElement> PluginGraph::createXml() const
     return xml;
 }
 
-void PluginGraph::restoreFromXml (const XmlElement& xml)
+void PluginGraph::restoreFromXml (const XmlElement& xml, std::function<void()> onRestored)
 {
     clear();
 
-    for (auto* e : xml.getChildWithTagNameIterator ("FILTER"))
+    // The plugins are created and restored in the background, and the connections are
+    // added once they've all arrived
+    auto graphXml = std::make_shared<const XmlElement> (xml);
+
+    batchLoader = std::make_unique<AudioPluginBatchLoader> (formatManager);
+
+    batchLoader->onProgress = [this] (int numLoaded, int numToLoad)
     {
-        createNodeFromXml (*e);
-        changed();
+        if (onLoadingProgress != nullptr)
+            onLoadingProgress (numLoaded, numToLoad);
+    };
+
+    batchLoader->onFinished = [this, graphXml, onRestored]
+    {
+        for (auto* e : graphXml->getChildWithTagNameIterator ("CONNECTION"))
+        {
+            graph.addConnection ({ { NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
+                                   { NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+        }
+
+        graph.removeIllegalConnections();
+        batchLoader.reset();
+
+        if (onRestored != nullptr)
+            onRestored();
+    };
+
+    for (auto* e : graphXml->getChildWithTagNameIterator ("FILTER"))
+    {
+        // this shares ownership of the whole document, so that the element stays valid
+        std::shared_ptr<const XmlElement> filterXml (graphXml, e);
+
+        PluginDescriptionAndPreference pd;
+        const auto nodeUsesARA = e->getBoolAttribute ("useARA");
+
+        for (auto* child : e->getChildIterator())
+        {
+            if (pd.pluginDescription.loadFromXml (*child))
+            {
+                pd.useARA = nodeUsesARA ? PluginDescriptionAndPreference::UseARA::yes
+                                        : PluginDescriptionAndPreference::UseARA::no;
+                break;
+            }
+        }
+
+        requestNodeFromXml (filterXml, pd, true);
     }
 
-    for (auto* e : xml.getChildWithTagNameIterator ("CONNECTION"))
+    if (onLoadingProgress != nullptr)
+        onLoadingProgress (0, batchLoader->getNumRequests());
+
+    // with nothing to load, the loader won't call onFinished
+    if (batchLoader->getNumRequests() == 0)
     {
-        graph.addConnection ({ { NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
-                               { NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+        auto finish = batchLoader->onFinished;
+        finish();
     }
+}
 
-    graph.removeIllegalConnections();
+bool PluginGraph::isLoading() const noexcept
+{
+    return batchLoader != nullptr;
 }
 
 File PluginGraph::getDefaultGraphDocumentOnMobile()
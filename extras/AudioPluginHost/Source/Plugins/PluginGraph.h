@@ -87,7 +87,19 @@ public:
 
     //==============================================================================
     std::unique_ptr<XmlElement> createXml() const;
-    void restoreFromXml (const XmlElement&);
+
+    /** Replaces the graph with one loaded from some XML.
+
+        The plugins are loaded in the background, so this returns before they've all
+        been added. The callback is called once the whole graph has been restored.
+    */
+    void restoreFromXml (const XmlElement&, std::function<void()> onRestored = nullptr);
+
+    /** Returns true while the plugins from restoreFromXml() are still being loaded. */
+    bool isLoading() const noexcept;
+
+    /** Called while a graph is being restored, with the number of plugins loaded so far. */
+    std::function<void (int numLoaded, int numToLoad)> onLoadingProgress;
 
     static const char* getFilenameSuffix()      { return ".filtergraph"; }
     static const char* getFilenameWildcard()    { return "*.filtergraph"; }
@@ -114,7 +126,10 @@ private:
     NodeID lastUID;
     NodeID getNextUID() noexcept;
 
-    void createNodeFromXml (const XmlElement&);
+    std::unique_ptr<AudioPluginBatchLoader> batchLoader;
+
+    void requestNodeFromXml (std::shared_ptr<const XmlElement>, const PluginDescriptionAndPreference&, bool allowFallback);
+    void addNodeFromXml (std::unique_ptr<AudioPluginInstance>, const XmlElement&, bool wrapForARA);
     void addPluginCallback (std::unique_ptr<AudioPluginInstance>,
                             const String& error,
                             Point<double>,
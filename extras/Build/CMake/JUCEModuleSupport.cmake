@@ -412,6 +412,19 @@ endfunction()
 
 # ==================================================================================================
 
+# Wraps each of the module sources in a generator expression, so that the sources aren't added to
+# targets that already link a prebuilt copy of the module. See juce_add_module_library.
+function(_juce_skip_sources_if_prebuilt module_name sources_var)
+    set(prebuilt_modules "$<TARGET_PROPERTY:JUCE_PREBUILT_MODULES>")
+    set(result)
+
+    foreach(source IN LISTS ${sources_var})
+        list(APPEND result "$<$<NOT:$<IN_LIST:${module_name},${prebuilt_modules}>>:${source}>")
+    endforeach()
+
+    set(${sources_var} ${result} PARENT_SCOPE)
+endfunction()
+
 function(_juce_remove_empty_list_elements arg)
     list(FILTER ${arg} EXCLUDE REGEX "^$")
     set(${arg} ${${arg}} PARENT_SCOPE)
@@ -467,6 +480,7 @@ function(juce_add_module module_path)
         list(APPEND all_module_sources ${globbed_sources})
     endif()
 
+    _juce_skip_sources_if_prebuilt(${module_name} all_module_sources)
     _juce_add_interface_library(${module_name} ${all_module_sources})
 
     set_property(GLOBAL APPEND PROPERTY _juce_module_names ${module_name})
@@ -488,7 +502,9 @@ function(juce_add_module module_path)
         if(CMAKE_SYSTEM_NAME MATCHES ".*BSD")
             target_link_libraries(juce_core INTERFACE execinfo)
         elseif(CMAKE_SYSTEM_NAME STREQUAL "Android")
-            target_sources(juce_core INTERFACE "${ANDROID_NDK}/sources/android/cpufeatures/cpu-features.c")
+            set(cpufeatures_source "${ANDROID_NDK}/sources/android/cpufeatures/cpu-features.c")
+            _juce_skip_sources_if_prebuilt(${module_name} cpufeatures_source)
+            target_sources(juce_core INTERFACE ${cpufeatures_source})
             target_include_directories(juce_core INTERFACE "${ANDROID_NDK}/sources/android/cpufeatures")
             target_link_libraries(juce_core INTERFACE android log)
         endif()
@@ -660,6 +676,240 @@ function(juce_add_modules)
     endforeach()
 endfunction()
 
+# ==================================================================================================
+
+function(_juce_get_aliased_target target out_var)
+    get_target_property(aliased ${target} ALIASED_TARGET)
+
+    if(aliased)
+        set(${out_var} ${aliased} PARENT_SCOPE)
+    else()
+        set(${out_var} ${target} PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Appends the names of the provided modules and all the modules they depend on to out_var.
+function(_juce_get_module_closure out_var)
+    get_property(all_modules GLOBAL PROPERTY _juce_module_names)
+    set(result ${${out_var}})
+
+    foreach(module IN LISTS ARGN)
+        if(NOT TARGET ${module})
+            continue()
+        endif()
+
+        _juce_get_aliased_target(${module} module_name)
+
+        if((NOT module_name IN_LIST all_modules) OR (module_name IN_LIST result))
+            continue()
+        endif()
+
+        list(APPEND result ${module_name})
+        get_target_property(dependencies ${module_name} INTERFACE_LINK_LIBRARIES)
+
+        if(dependencies)
+            _juce_get_module_closure(result ${dependencies})
+        endif()
+    endforeach()
+
+    set(${out_var} ${result} PARENT_SCOPE)
+endfunction()
+
+# Splits a compile definition into its name and value. Definitions without a value are given the
+# value 1, matching the behaviour of the compiler.
+function(_juce_split_definition definition name_var value_var)
+    string(FIND "${definition}" "=" equals_index)
+
+    if(equals_index EQUAL -1)
+        set(${name_var} "${definition}" PARENT_SCOPE)
+        set(${value_var} 1 PARENT_SCOPE)
+    else()
+        string(SUBSTRING "${definition}" 0 ${equals_index} name)
+        math(EXPR value_index "${equals_index} + 1")
+        string(SUBSTRING "${definition}" ${value_index} -1 value)
+        set(${name_var} "${name}" PARENT_SCOPE)
+        set(${value_var} "${value}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Definitions that change the way that module code is compiled, and which must therefore be
+# identical for the module library and every target linking it.
+function(_juce_is_module_config_definition name out_var)
+    if((name MATCHES "^(JUCE_|JucePlugin_Build_|JucePlugin_Enable_)")
+       AND NOT (name MATCHES "^(JUCE_MODULE_AVAILABLE_|JUCE_SHARED_CODE$|JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED$)"))
+        set(${out_var} TRUE PARENT_SCOPE)
+    else()
+        set(${out_var} FALSE PARENT_SCOPE)
+    endif()
+endfunction()
+
+function(_juce_hash_module_config out_var modules definitions)
+    string(SHA1 hash "${CMAKE_CXX_COMPILER_ID};${CMAKE_CXX_COMPILER_VERSION};${modules};${definitions}")
+    set(${out_var} ${hash} PARENT_SCOPE)
+endfunction()
+
+function(_juce_write_module_library_check target modules definitions)
+    set(content "// Generated by juce_add_module_library. This file is compiled into each target linking\n")
+    string(APPEND content "// ${target}, and checks that the target uses the same JUCE configuration as the\n")
+    string(APPEND content "// prebuilt module code.\n\n")
+
+    foreach(definition IN LISTS definitions)
+        _juce_split_definition("${definition}" name value)
+        set(message "\"${name} must be set to ${value} to match the module library ${target}\"")
+
+        if(value MATCHES "\"")
+            string(APPEND content "#ifndef ${name}\n #error ${message}\n#endif\n\n")
+        else()
+            string(APPEND content "#if ! defined (${name}) || ((${name}) != (${value}))\n #error ${message}\n#endif\n\n")
+        endif()
+    endforeach()
+
+    get_property(all_modules GLOBAL PROPERTY _juce_module_names)
+
+    foreach(module_name IN LISTS all_modules)
+        set(expected 0)
+
+        if((module_name IN_LIST modules) OR ("JUCE_MODULE_AVAILABLE_${module_name}=1" IN_LIST definitions))
+            set(expected 1)
+        endif()
+
+        set(macro "JUCE_MODULE_AVAILABLE_${module_name}")
+        set(message "\"The availability of ${module_name} must match the module library ${target}\"")
+        string(APPEND content "#if (${macro} + 0) != ${expected}\n #error ${message}\n#endif\n\n")
+    endforeach()
+
+    set(check_file "${CMAKE_CURRENT_BINARY_DIR}/${target}_ModuleLibrary/${target}_ModuleLibraryCheck.cpp")
+    file(GENERATE OUTPUT "${check_file}" CONTENT "${content}")
+    set_target_properties(${target} PROPERTIES JUCE_MODULE_LIBRARY_CHECK_FILE "${check_file}")
+endfunction()
+
+function(juce_add_module_library target)
+    set(multi_value_args MODULES DEFINITIONS LINK_LIBRARIES)
+    cmake_parse_arguments(JUCE_ARG "" "" "${multi_value_args}" ${ARGN})
+
+    if(NOT JUCE_ARG_MODULES)
+        message(FATAL_ERROR "juce_add_module_library requires at least one module")
+    endif()
+
+    foreach(module IN LISTS JUCE_ARG_MODULES)
+        if(NOT TARGET ${module})
+            message(FATAL_ERROR "'${module}' is not a JUCE module target")
+        endif()
+    endforeach()
+
+    set(modules)
+    _juce_get_module_closure(modules ${JUCE_ARG_MODULES})
+
+    if(juce_audio_plugin_client IN_LIST modules)
+        message(FATAL_ERROR "juce_audio_plugin_client is built separately for each plugin, "
+                            "so it can't be added to the module library ${target}")
+    endif()
+
+    set(definitions)
+
+    foreach(definition IN LISTS JUCE_ARG_DEFINITIONS)
+        if(definition MATCHES "\\$<")
+            message(FATAL_ERROR "Module library definitions may not contain generator expressions: ${definition}")
+        endif()
+
+        _juce_split_definition("${definition}" name value)
+        list(APPEND definitions "${name}=${value}")
+    endforeach()
+
+    list(SORT modules)
+    list(SORT definitions)
+    _juce_hash_module_config(config_hash "${modules}" "${definitions}")
+
+    add_library(${target} STATIC)
+    target_link_libraries(${target} PRIVATE ${JUCE_ARG_MODULES} ${JUCE_ARG_LINK_LIBRARIES})
+    target_compile_definitions(${target} PRIVATE ${definitions})
+
+    set_target_properties(${target} PROPERTIES
+        JUCE_MODULE_LIBRARY_MODULES "${modules}"
+        JUCE_MODULE_LIBRARY_DEFINITIONS "${definitions}"
+        JUCE_MODULE_LIBRARY_CONFIG_HASH "${config_hash}")
+
+    _juce_write_module_library_check(${target} "${modules}" "${definitions}")
+    _juce_fixup_module_source_groups()
+endfunction()
+
+function(juce_link_module_library target library)
+    get_target_property(modules ${library} JUCE_MODULE_LIBRARY_MODULES)
+
+    if(NOT modules)
+        message(FATAL_ERROR "'${library}' was not created with juce_add_module_library")
+    endif()
+
+    get_target_property(existing_library ${target} JUCE_MODULE_LIBRARY)
+
+    if(existing_library)
+        message(FATAL_ERROR "${target} already links the module library ${existing_library}")
+    endif()
+
+    get_target_property(library_definitions ${library} JUCE_MODULE_LIBRARY_DEFINITIONS)
+    get_target_property(library_hash ${library} JUCE_MODULE_LIBRARY_CONFIG_HASH)
+    get_target_property(target_definitions ${target} COMPILE_DEFINITIONS)
+
+    if(NOT target_definitions)
+        set(target_definitions)
+    endif()
+
+    # Work out the configuration that the target will be built with. Definitions set with generator
+    # expressions can't be evaluated here, so those are only checked when the target is compiled.
+    set(effective_definitions ${library_definitions})
+    set(target_names)
+    set(mismatches)
+
+    foreach(definition IN LISTS target_definitions)
+        _juce_split_definition("${definition}" name value)
+        list(APPEND target_names "${name}")
+        _juce_is_module_config_definition("${name}" is_config)
+
+        if((NOT is_config) OR (definition MATCHES "\\$<"))
+            continue()
+        endif()
+
+        list(FILTER effective_definitions EXCLUDE REGEX "^${name}=")
+        list(APPEND effective_definitions "${name}=${value}")
+
+        if(NOT "${name}=${value}" IN_LIST library_definitions)
+            list(APPEND mismatches "${name}=${value}")
+        endif()
+    endforeach()
+
+    list(REMOVE_DUPLICATES effective_definitions)
+    list(SORT effective_definitions)
+    _juce_hash_module_config(target_hash "${modules}" "${effective_definitions}")
+
+    if(NOT target_hash STREQUAL library_hash)
+        string(REPLACE ";" "\n    " mismatch_string "${mismatches}")
+        message(FATAL_ERROR "The JUCE configuration of ${target} doesn't match the module library "
+                            "${library}. Add these definitions to the library, or remove them from "
+                            "the target:\n    ${mismatch_string}")
+    endif()
+
+    # Definitions that the target doesn't set itself are inherited from the library
+    set(inherited_definitions)
+
+    foreach(definition IN LISTS library_definitions)
+        _juce_split_definition("${definition}" name value)
+
+        if(NOT name IN_LIST target_names)
+            list(APPEND inherited_definitions "${definition}")
+        endif()
+    endforeach()
+
+    get_target_property(check_file ${library} JUCE_MODULE_LIBRARY_CHECK_FILE)
+
+    set_target_properties(${target} PROPERTIES
+        JUCE_MODULE_LIBRARY ${library}
+        JUCE_PREBUILT_MODULES "${modules}")
+
+    target_compile_definitions(${target} PUBLIC ${inherited_definitions})
+    target_sources(${target} PRIVATE "${check_file}")
+    target_link_libraries(${target} PRIVATE ${modules} ${library})
+endfunction()
+
 # When source groups are enabled, this function sets the HEADER_FILE_ONLY property on any module
 # source files that should not be built. This is called automatically by the juce_add_* functions.
 function(_juce_fixup_module_source_groups)
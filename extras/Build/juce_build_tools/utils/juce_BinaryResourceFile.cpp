@@ -88,6 +88,20 @@ namespace build_tools
                << "namespace " << className << newLine
                << "{" << newLine;
 
+        if (compressed)
+        {
+            header << "    // These resources are stored compressed. Each one is decompressed the first time it's"          << newLine
+                   << "    // converted to a pointer, and the decompressed data stays valid until the program exits."      << newLine
+                   << "    struct CompressedResource"                                                                      << newLine
+                   << "    {"                                                                                              << newLine
+                   << "        int index;"                                                                                 << newLine
+                   <<                                                                                                         newLine
+                   << "        const char* get() const;"                                                                   << newLine
+                   << "        operator const char*() const   { return get(); }"                                          << newLine
+                   << "    };"                                                                                             << newLine
+                   << newLine;
+        }
+
         for (int i = 0; i < files.size(); ++i)
         {
             auto& file = files.getReference(i);
@@ -103,7 +117,11 @@ namespace build_tools
 
             if (fileStream.openedOk())
             {
-                header << "    extern const char*   " << variableName << ";" << newLine;
+                if (compressed)
+                    header << "    extern const CompressedResource " << variableName << ";" << newLine;
+                else
+                    header << "    extern const char*   " << variableName << ";" << newLine;
+
                 header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
             }
         }
@@ -183,54 +201,304 @@ namespace build_tools
                     << "{";
             }
 
-            cpp << newLine
-                << newLine
-                << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes);" << newLine
-                << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)"  << newLine
-                << "{" << newLine;
+            writeLookupFunctions (cpp);
+        }
+
+        cpp << "}" << newLine;
+
+        return Result::ok();
+    }
+
+    void ResourceFile::writeLookupFunctions (MemoryOutputStream& cpp)
+    {
+        cpp << newLine
+            << newLine
+            << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes);" << newLine
+            << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)"  << newLine
+            << "{" << newLine;
+
+        StringArray returnCodes;
+        for (auto& file : files)
+        {
+            auto dataSize = file.getSize();
+            returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[files.indexOf (file)] + ";");
+        }
+
+        createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
+
+        cpp << "    numBytes = 0;" << newLine
+            << "    return nullptr;" << newLine
+            << "}" << newLine
+            << newLine;
+
+        cpp << "const char* namedResourceList[] =" << newLine
+            << "{" << newLine;
+
+        for (int j = 0; j < files.size(); ++j)
+            cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
+
+        cpp << "};" << newLine << newLine;
+
+        cpp << "const char* originalFilenames[] =" << newLine
+            << "{" << newLine;
+
+        for (auto& f : files)
+            cpp << "    " << f.getFileName().quoted() << (files.indexOf (f) < files.size() - 1 ? "," : "") << newLine;
+
+        cpp << "};" << newLine << newLine;
+
+        cpp << "const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                        << newLine
+            << "const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8)"                         << newLine
+            << "{"                                                                                                   << newLine
+            << "    for (unsigned int i = 0; i < (sizeof (namedResourceList) / sizeof (namedResourceList[0])); ++i)" << newLine
+            << "        if (strcmp (namedResourceList[i], resourceNameUTF8) == 0)"                                   << newLine
+            << "            return originalFilenames[i];"                                                            << newLine
+            <<                                                                                                          newLine
+            << "    return nullptr;"                                                                                 << newLine
+            << "}"                                                                                                   << newLine
+            <<                                                                                                          newLine;
+    }
+
+    //==============================================================================
+    /*  Compresses a block of data using the LZ4 block format.
+
+        This is a simple greedy encoder, which is quick enough for build-time use and keeps
+        the generated decoder small enough to emit into each BinaryData file.
+    */
+    static MemoryBlock compressLZ4Block (const MemoryBlock& input)
+    {
+        constexpr int minMatch = 4, maxOffset = 65535, hashBits = 16;
+
+        // The format requires the last 5 bytes to be literals, and the last match to start
+        // at least 12 bytes before the end of the block.
+        constexpr int lastLiterals = 5, lastMatchDistance = 12;
+
+        const auto* src = static_cast<const uint8*> (input.getData());
+        const auto size = (int) input.getSize();
+
+        MemoryOutputStream out ((size_t) size + (size_t) size / 255 + 16);
+        std::vector<int> table ((size_t) 1 << hashBits, -1);
+
+        const auto read32 = [src] (int pos)
+        {
+            uint32 v;
+            memcpy (&v, src + pos, sizeof (v));
+            return v;
+        };
+
+        const auto hash = [&] (int pos)
+        {
+            return (size_t) ((read32 (pos) * 2654435761u) >> (32 - hashBits));
+        };
+
+        const auto writeExtraLength = [&] (int length)
+        {
+            for (; length >= 255; length -= 255)
+                out.writeByte ((char) 255);
+
+            out.writeByte ((char) length);
+        };
+
+        const auto writeLiterals = [&] (int start, int length, int matchToken)
+        {
+            out.writeByte ((char) ((jmin (length, 15) << 4) | matchToken));
+
+            if (length >= 15)
+                writeExtraLength (length - 15);
 
-            StringArray returnCodes;
-            for (auto& file : files)
+            out.write (src + start, (size_t) length);
+        };
+
+        int anchor = 0, pos = 0;
+
+        while (pos < size - lastMatchDistance)
+        {
+            const auto h = hash (pos);
+            const auto candidate = std::exchange (table[h], pos);
+
+            if (candidate < 0 || pos - candidate > maxOffset || read32 (candidate) != read32 (pos))
             {
-                auto dataSize = file.getSize();
-                returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[files.indexOf (file)] + ";");
+                ++pos;
+                continue;
             }
 
-            createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
+            auto matchLength = minMatch;
+
+            while (pos + matchLength < size - lastLiterals && src[candidate + matchLength] == src[pos + matchLength])
+                ++matchLength;
 
-            cpp << "    numBytes = 0;" << newLine
-                << "    return nullptr;" << newLine
-                << "}" << newLine
-                << newLine;
+            const auto extraMatchLength = matchLength - minMatch;
 
-            cpp << "const char* namedResourceList[] =" << newLine
-                << "{" << newLine;
+            writeLiterals (anchor, pos - anchor, jmin (extraMatchLength, 15));
+            out.writeShort ((short) (pos - candidate));
 
-            for (int j = 0; j < files.size(); ++j)
-                cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
+            if (extraMatchLength >= 15)
+                writeExtraLength (extraMatchLength - 15);
 
-            cpp << "};" << newLine << newLine;
+            pos += matchLength;
+            anchor = pos;
+        }
 
-            cpp << "const char* originalFilenames[] =" << newLine
-                << "{" << newLine;
+        writeLiterals (anchor, size - anchor, 0);
+        return out.getMemoryBlock();
+    }
 
-            for (auto& f : files)
-                cpp << "    " << f.getFileName().quoted() << (files.indexOf (f) < files.size() - 1 ? "," : "") << newLine;
+    Result ResourceFile::writeCompressedCpp (MemoryOutputStream& cpp, const File& headerFile)
+    {
+        MemoryOutputStream blob;
+        StringArray indexEntries;
 
-            cpp << "};" << newLine << newLine;
+        for (int i = 0; i < files.size(); ++i)
+        {
+            auto& file = files.getReference (i);
+            FileInputStream fileStream (file);
 
-            cpp << "const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                        << newLine
-                << "const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8)"                         << newLine
-                << "{"                                                                                                   << newLine
-                << "    for (unsigned int i = 0; i < (sizeof (namedResourceList) / sizeof (namedResourceList[0])); ++i)" << newLine
-                << "        if (strcmp (namedResourceList[i], resourceNameUTF8) == 0)"                                   << newLine
-                << "            return originalFilenames[i];"                                                            << newLine
-                <<                                                                                                          newLine
-                << "    return nullptr;"                                                                                 << newLine
-                << "}"                                                                                                   << newLine
-                <<                                                                                                          newLine;
+            if (! fileStream.openedOk())
+                return Result::fail ("Can't open resource file: " + file.getFullPathName());
+
+            MemoryBlock data;
+            fileStream.readIntoMemoryBlock (data);
+
+            const auto compressedData = compressLZ4Block (data);
+
+            indexEntries.add ("    { " + String ((int64) blob.getPosition()) + ", "
+                                       + String ((int64) compressedData.getSize()) + ", "
+                                       + String ((int64) data.getSize()) + " }"
+                                       + (i < files.size() - 1 ? "," : " ")
+                                       + " // " + file.getFileName());
+
+            blob << compressedData;
         }
 
+        cpp << "/* ==================================== " << resourceFileIdentifierString << " ====================================";
+        writeComment (cpp);
+        cpp << "#include <atomic>" << newLine
+            << "#include <cstring>" << newLine
+            << "#include <memory>" << newLine
+            << "#include <mutex>" << newLine
+            << newLine
+            << "#include \"" << headerFile.getFileName() << "\"" << newLine
+            << newLine
+            << "namespace " << className << newLine
+            << "{" << newLine
+            << newLine
+            << "//================== Compressed resources ==================" << newLine
+            << "static const unsigned char compressedResourceData[] =" << newLine;
+
+        writeDataAsCppLiteral (blob.getMemoryBlock(), cpp, false, true);
+
+        cpp << newLine << newLine
+            << "struct CompressedResourceInfo { unsigned int offset, compressedSize, size; };" << newLine
+            << newLine
+            << "static const CompressedResourceInfo compressedResourceInfo[] =" << newLine
+            << "{" << newLine
+            << indexEntries.joinIntoString (newLine) << newLine
+            << "};" << newLine
+            << newLine
+            << "// Decodes a block in the LZ4 block format, returning false if it's malformed."                << newLine
+            << "static bool decompressResource (const unsigned char* src, const unsigned char* srcEnd,"        << newLine
+            << "                                unsigned char* dst, unsigned char* dstEnd)"                    << newLine
+            << "{"                                                                                             << newLine
+            << "    auto* const dstStart = dst;"                                                               << newLine
+            <<                                                                                                    newLine
+            << "    // A length field of 15 is continued in the following bytes, until one is less than 255."  << newLine
+            << "    const auto readExtraLength = [&] (unsigned int& length)"                                   << newLine
+            << "    {"                                                                                         << newLine
+            << "        if (length != 15)"                                                                     << newLine
+            << "            return true;"                                                                      << newLine
+            <<                                                                                                    newLine
+            << "        for (;;)"                                                                              << newLine
+            << "        {"                                                                                     << newLine
+            << "            if (src >= srcEnd)"                                                                << newLine
+            << "                return false;"                                                                 << newLine
+            <<                                                                                                    newLine
+            << "            const unsigned int b = *src++;"                                                    << newLine
+            << "            length += b;"                                                                      << newLine
+            <<                                                                                                    newLine
+            << "            if (b != 255)"                                                                     << newLine
+            << "                return true;"                                                                  << newLine
+            << "        }"                                                                                     << newLine
+            << "    };"                                                                                        << newLine
+            <<                                                                                                    newLine
+            << "    while (src < srcEnd)"                                                                      << newLine
+            << "    {"                                                                                         << newLine
+            << "        const unsigned int token = *src++;"                                                    << newLine
+            << "        unsigned int literalLength = token >> 4;"                                              << newLine
+            <<                                                                                                    newLine
+            << "        if (! readExtraLength (literalLength)"                                                 << newLine
+            << "             || literalLength > (unsigned int) (srcEnd - src)"                                 << newLine
+            << "             || literalLength > (unsigned int) (dstEnd - dst))"                                << newLine
+            << "            return false;"                                                                     << newLine
+            <<                                                                                                    newLine
+            << "        memcpy (dst, src, literalLength);"                                                     << newLine
+            << "        src += literalLength;"                                                                 << newLine
+            << "        dst += literalLength;"                                                                 << newLine
+            <<                                                                                                    newLine
+            << "        if (src == srcEnd)"                                                                    << newLine
+            << "            break;"                                                                            << newLine
+            <<                                                                                                    newLine
+            << "        if (srcEnd - src < 2)"                                                                 << newLine
+            << "            return false;"                                                                     << newLine
+            <<                                                                                                    newLine
+            << "        const auto offset = (unsigned int) src[0] | ((unsigned int) src[1] << 8);"             << newLine
+            << "        src += 2;"                                                                             << newLine
+            <<                                                                                                    newLine
+            << "        unsigned int matchLength = token & 15;"                                                << newLine
+            <<                                                                                                    newLine
+            << "        if (! readExtraLength (matchLength))"                                                  << newLine
+            << "            return false;"                                                                     << newLine
+            <<                                                                                                    newLine
+            << "        matchLength += 4;"                                                                     << newLine
+            <<                                                                                                    newLine
+            << "        if (offset == 0 || offset > (unsigned int) (dst - dstStart)"                           << newLine
+            << "             || matchLength > (unsigned int) (dstEnd - dst))"                                  << newLine
+            << "            return false;"                                                                     << newLine
+            <<                                                                                                    newLine
+            << "        // Matches may overlap the bytes they produce, so they must be copied forwards."       << newLine
+            << "        for (auto* match = dst - offset; matchLength > 0; --matchLength)"                      << newLine
+            << "            *dst++ = *match++;"                                                                << newLine
+            << "    }"                                                                                         << newLine
+            <<                                                                                                    newLine
+            << "    return dst == dstEnd;"                                                                     << newLine
+            << "}"                                                                                             << newLine
+            <<                                                                                                    newLine
+            << "const char* CompressedResource::get() const"                                                   << newLine
+            << "{"                                                                                             << newLine
+            << "    constexpr auto numResources = sizeof (compressedResourceInfo) / sizeof (compressedResourceInfo[0]);" << newLine
+            << "    static std::atomic<const char*> resources[numResources];"                                  << newLine
+            << "    static std::unique_ptr<char[]> storage[numResources];"                                     << newLine
+            << "    static std::mutex mutex;"                                                                  << newLine
+            <<                                                                                                    newLine
+            << "    if (auto* data = resources[index].load (std::memory_order_acquire))"                       << newLine
+            << "        return data;"                                                                          << newLine
+            <<                                                                                                    newLine
+            << "    const std::lock_guard<std::mutex> lock (mutex);"                                           << newLine
+            <<                                                                                                    newLine
+            << "    if (auto* data = resources[index].load (std::memory_order_relaxed))"                       << newLine
+            << "        return data;"                                                                          << newLine
+            <<                                                                                                    newLine
+            << "    const auto& info = compressedResourceInfo[index];"                                         << newLine
+            << "    const auto* src = compressedResourceData + info.offset;"                                   << newLine
+            <<                                                                                                    newLine
+            << "    // Like the uncompressed resources, the data is followed by a null terminator."            << newLine
+            << "    std::unique_ptr<char[]> data (new char[info.size + 1]);"                                   << newLine
+            << "    auto* dst = reinterpret_cast<unsigned char*> (data.get());"                                << newLine
+            << "    dst[info.size] = 0;"                                                                       << newLine
+            <<                                                                                                    newLine
+            << "    if (! decompressResource (src, src + info.compressedSize, dst, dst + info.size))"          << newLine
+            << "        return nullptr;"                                                                       << newLine
+            <<                                                                                                    newLine
+            << "    storage[index] = std::move (data);"                                                        << newLine
+            << "    resources[index].store (storage[index].get(), std::memory_order_release);"                 << newLine
+            << "    return storage[index].get();"                                                              << newLine
+            << "}"                                                                                             << newLine
+            << newLine;
+
+        for (int i = 0; i < files.size(); ++i)
+            cpp << "const CompressedResource " << variableNames[i] << " { " << i << " };" << newLine;
+
+        writeLookupFunctions (cpp);
+
         cpp << "}" << newLine;
 
         return Result::ok();
@@ -258,6 +526,25 @@ namespace build_tools
             filesCreated.add (headerFile);
         }
 
+        if (compressed)
+        {
+            auto cpp = getCppFile (0);
+
+            MemoryOutputStream mo;
+            mo.setNewLineString (projectLineFeed);
+
+            auto r = writeCompressedCpp (mo, headerFile);
+
+            if (r.failed())
+                return { r, std::move (filesCreated) };
+
+            if (! overwriteFileWithNewDataIfDifferent (cpp, mo))
+                return { Result::fail ("Can't write to file: " + cpp.getFullPathName()), std::move (filesCreated) };
+
+            filesCreated.add (cpp);
+            return { Result::ok(), std::move (filesCreated) };
+        }
+
         int i = 0;
         int fileIndex = 0;
 
@@ -34,6 +34,11 @@ namespace build_tools
 
         void setClassName (const String& className);
 
+        /*  If enabled, the resources are written to a single cpp file as one compressed blob,
+            and each resource is decompressed the first time it's accessed.
+        */
+        void setCompressed (bool shouldCompress) { compressed = shouldCompress; }
+
         String getClassName() const { return className; }
 
         void addFile (const File& file);
@@ -63,11 +68,16 @@ namespace build_tools
         Array<File> files;
         StringArray variableNames;
         String className { "BinaryData" };
+        bool compressed = false;
 
         Result writeHeader (MemoryOutputStream&);
 
         Result writeCpp (MemoryOutputStream&, const File&, int&, int);
 
+        Result writeCompressedCpp (MemoryOutputStream&, const File&);
+
+        void writeLookupFunctions (MemoryOutputStream&);
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResourceFile)
     };
 }
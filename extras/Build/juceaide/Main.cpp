@@ -78,6 +78,7 @@ int writeBinaryData (juce::ArgumentList&& args)
     juce::build_tools::ResourceFile resourceFile;
 
     resourceFile.setClassName (namespaceName.text);
+    resourceFile.setCompressed (args.removeOptionIfFound ("--compressed"));
     const auto lineEndings = args.removeOptionIfFound ("--windows") ? "\r\n" : "\n";
 
     const auto allLines = [&]
@@ -55,7 +55,8 @@ int main (int argc, char **argv)
 
     if (args.containsOption ("--help|-h"))
     {
-        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category category] [--seed seed]" << std::endl;
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category category] [--seed seed]"
+                                " [--jobs=n] [--shard=index/count] [--timings] [--slowest=n]" << std::endl;
         return 0;
     }
 
@@ -72,6 +73,9 @@ int main (int argc, char **argv)
 
     ConsoleUnitTestRunner runner;
 
+    if (args.containsOption ("--jobs"))
+        runner.setNumThreads (args.getValueForOption ("--jobs").getIntValue());
+
     auto seed = [&args]
     {
         if (args.containsOption ("--seed"))
@@ -87,10 +91,54 @@ int main (int argc, char **argv)
         return Random::getSystemRandom().nextInt64();
     }();
 
-    if (args.containsOption ("--category"))
-        runner.runTestsInCategory (args.getValueForOption ("--category"), seed);
-    else
-        runner.runAllTests (seed);
+    auto tests = UnitTest::getTestsInCategory (args.getValueForOption ("--category"));
+
+    if (args.containsOption ("--shard"))
+    {
+        // Each shard takes every n-th test, so separate processes can share out a run
+        auto shard = args.getValueForOption ("--shard");
+        auto index = shard.upToFirstOccurrenceOf ("/", false, false).getIntValue();
+        auto count = shard.fromFirstOccurrenceOf ("/", false, false).getIntValue();
+
+        if (count <= 0 || ! isPositiveAndBelow (index, count))
+        {
+            std::cout << "Invalid shard \"" << shard << "\", expected index/count" << std::endl;
+            Logger::setCurrentLogger (nullptr);
+            return 1;
+        }
+
+        Array<UnitTest*> shardTests;
+
+        for (int i = index; i < tests.size(); i += count)
+            shardTests.add (tests.getUnchecked (i));
+
+        tests = shardTests;
+    }
+
+    runner.runTests (tests, seed);
+
+    if (args.containsOption ("--timings|--slowest"))
+    {
+        std::map<String, RelativeTime> durations;
+
+        for (int i = 0; i < runner.getNumResults(); ++i)
+        {
+            auto* result = runner.getResult (i);
+            durations[result->unitTestName] += result->endTime - result->startTime;
+        }
+
+        std::vector<std::pair<String, RelativeTime>> sorted (durations.begin(), durations.end());
+        std::sort (sorted.begin(), sorted.end(), [] (const auto& a, const auto& b) { return a.second > b.second; });
+
+        auto slowest = args.getValueForOption ("--slowest");
+        auto numToShow = args.containsOption ("--timings") ? sorted.size()
+                                                            : jmin (sorted.size(), (size_t) jmax (1, slowest.isEmpty() ? 10 : slowest.getIntValue()));
+
+        logger.writeToLog (newLine + (args.containsOption ("--timings") ? "Test timings:" : "Slowest tests:") + newLine);
+
+        for (size_t i = 0; i < numToShow; ++i)
+            logger.writeToLog (String (sorted[i].second.inMilliseconds()).paddedLeft (' ', 8) + " ms  " + sorted[i].first);
+    }
 
     std::vector<String> failures;
 
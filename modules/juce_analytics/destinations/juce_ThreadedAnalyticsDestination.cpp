@@ -26,8 +26,328 @@
 namespace juce
 {
 
+//==============================================================================
+/*  An append-only file of compressed blocks of events.
+
+    The file starts with a header that records how far sending has got: the start of
+    a block, and how many of that block's events have been sent. Each block has its
+    own header with a checksum, so a block that was only partly written when the app
+    crashed is found and cut off when the file is next opened.
+*/
+class ThreadedAnalyticsDestination::EventSpool
+{
+public:
+    explicit EventSpool (const File& spoolFile)
+        : file (spoolFile)
+    {
+        file.getParentDirectory().createDirectory();
+        open();
+    }
+
+    bool isOpen() const noexcept                    { return writer != nullptr; }
+    bool hasUnreadBlocks() const noexcept           { return readPosition < writePosition; }
+    int getNumUnreadEvents() const noexcept         { return numUnreadEvents; }
+
+    /*  Appends a block, returning its position, or -1 if it couldn't be written. If
+        markAsRead is true, the caller is keeping the events in memory, so the block
+        won't be returned by readNextBlock(). This is only allowed if there are no
+        unread blocks before it.
+    */
+    int64 append (const AnalyticsEvent* events, int numEvents, bool markAsRead)
+    {
+        jassert (! (markAsRead && hasUnreadBlocks()));
+
+        if (writer == nullptr || numEvents <= 0)
+            return -1;
+
+        MemoryOutputStream raw;
+
+        for (int i = 0; i < numEvents; ++i)
+            writeEvent (raw, events[i]);
+
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream zipper (compressed);
+            zipper.write (raw.getData(), raw.getDataSize());
+        }
+
+        const auto blockStart = writePosition;
+
+        writer->setPosition (blockStart);
+        writer->writeInt (blockMagic);
+        writer->writeInt (numEvents);
+        writer->writeInt ((int) compressed.getDataSize());
+        writer->writeInt ((int) raw.getDataSize());
+        writer->writeInt ((int) getChecksum (compressed.getData(), compressed.getDataSize()));
+        writer->write (compressed.getData(), compressed.getDataSize());
+        writer->flush();
+
+        if (writer->getStatus().failed())
+        {
+            writer->setPosition (blockStart);
+            writer->truncate();
+            return -1;
+        }
+
+        writePosition = writer->getPosition();
+
+        if (markAsRead)
+            readPosition = writePosition;
+        else
+            numUnreadEvents += numEvents;
+
+        return blockStart;
+    }
+
+    /*  Reads the next unread block, skipping any of its events that were already sent
+        in an earlier session.
+    */
+    bool readNextBlock (std::vector<AnalyticsEvent>& events, int64& blockStart, int& blockSize, int& numSkipped)
+    {
+        events.clear();
+
+        if (! hasUnreadBlocks())
+            return false;
+
+        FileInputStream in (file);
+
+        if (in.failedToOpen() || ! in.setPosition (readPosition))
+            return false;
+
+        int64 blockEnd = 0;
+        int numEvents = 0;
+
+        if (! readBlock (in, &events, numEvents, blockEnd))
+        {
+            // The file has been changed by something else, so give up on the rest of it
+            numUnreadEvents = 0;
+            readPosition = writePosition;
+            return false;
+        }
+
+        blockStart = readPosition;
+        blockSize = (int) events.size();
+        numSkipped = blockStart == firstBlockStart ? jmin (numSentFromFirstBlock, blockSize) : 0;
+
+        events.erase (events.begin(), events.begin() + numSkipped);
+
+        numUnreadEvents = jmax (0, numUnreadEvents - (int) events.size());
+        readPosition = blockEnd;
+        return true;
+    }
+
+    /*  Records that all the events up to and including a certain one have been sent.
+        If nothing else is waiting, the file is emptied.
+    */
+    void eventsWereSent (int64 blockStart, int numSentFromBlock, bool anyMoreInMemory)
+    {
+        if (writer == nullptr)
+            return;
+
+        if (! anyMoreInMemory && ! hasUnreadBlocks())
+        {
+            writer->setPosition (headerSize);
+            writer->truncate();
+            writePosition = readPosition = headerSize;
+            numUnreadEvents = 0;
+            blockStart = headerSize;
+            numSentFromBlock = 0;
+        }
+
+        firstBlockStart = blockStart;
+        numSentFromFirstBlock = numSentFromBlock;
+        writeHeader();
+        writer->setPosition (writePosition);
+    }
+
+    //==============================================================================
+    static void writeEvent (OutputStream& out, const AnalyticsEvent& event)
+    {
+        out.writeString (event.name);
+        out.writeInt (event.eventType);
+        out.writeInt ((int) event.timestamp);
+        writeStringPairs (out, event.parameters);
+        out.writeString (event.userID);
+        writeStringPairs (out, event.userProperties);
+    }
+
+    static AnalyticsEvent readEvent (InputStream& in)
+    {
+        AnalyticsEvent event;
+        event.name = in.readString();
+        event.eventType = in.readInt();
+        event.timestamp = (uint32) in.readInt();
+        event.parameters = readStringPairs (in);
+        event.userID = in.readString();
+        event.userProperties = readStringPairs (in);
+        return event;
+    }
+
+private:
+    static constexpr int spoolMagic = 0x4a415350;    // "JASP"
+    static constexpr int blockMagic = 0x4a41424b;    // "JABK"
+    static constexpr int headerSize = 16;
+    static constexpr int blockHeaderSize = 20;
+
+    void open()
+    {
+        int64 validEnd = headerSize;
+        numUnreadEvents = 0;
+
+        {
+            FileInputStream in (file);
+
+            if (in.openedOk() && in.getTotalLength() >= headerSize && in.readInt() == spoolMagic)
+            {
+                firstBlockStart = in.readInt64();
+                numSentFromFirstBlock = in.readInt();
+
+                bool foundFirstBlock = false;
+                int64 blockEnd = 0;
+                int numEventsInBlock = 0;
+
+                for (auto position = validEnd;
+                     in.setPosition (position) && readBlock (in, nullptr, numEventsInBlock, blockEnd);
+                     position = blockEnd)
+                {
+                    foundFirstBlock = foundFirstBlock || position == firstBlockStart;
+
+                    if (foundFirstBlock)
+                        numUnreadEvents += numEventsInBlock - (position == firstBlockStart ? jmin (numSentFromFirstBlock, numEventsInBlock) : 0);
+
+                    validEnd = blockEnd;
+                }
+
+                readPosition = foundFirstBlock ? firstBlockStart : validEnd;
+
+                if (! foundFirstBlock)
+                    numUnreadEvents = 0;
+            }
+        }
+
+        writer = std::make_unique<FileOutputStream> (file);
+
+        if (writer->failedToOpen())
+        {
+            writer.reset();
+            return;
+        }
+
+        // Anything after the last complete block was cut off by a crash
+        writer->setPosition (validEnd);
+        writer->truncate();
+        writePosition = validEnd;
+
+        if (readPosition == 0 || numUnreadEvents == 0)
+        {
+            readPosition = writePosition;
+            eventsWereSent (headerSize, 0, false);
+        }
+    }
+
+    void writeHeader()
+    {
+        writer->setPosition (0);
+        writer->writeInt (spoolMagic);
+        writer->writeInt64 (firstBlockStart);
+        writer->writeInt (numSentFromFirstBlock);
+        writer->flush();
+    }
+
+    // Checks the block at the stream's position, and reads its events if events isn't null
+    static bool readBlock (InputStream& in, std::vector<AnalyticsEvent>* events, int& numEvents, int64& blockEnd)
+    {
+        const auto start = in.getPosition();
+
+        if (in.getTotalLength() - start < blockHeaderSize || in.readInt() != blockMagic)
+            return false;
+
+        numEvents = in.readInt();
+        const auto compressedSize = in.readInt();
+        const auto rawSize = in.readInt();
+        const auto checksum = (uint32) in.readInt();
+
+        if (numEvents <= 0 || compressedSize <= 0 || rawSize < 0
+             || in.getTotalLength() - in.getPosition() < compressedSize)
+            return false;
+
+        MemoryBlock compressed;
+
+        if (in.readIntoMemoryBlock (compressed, compressedSize) != (size_t) compressedSize
+             || getChecksum (compressed.getData(), compressed.getSize()) != checksum)
+            return false;
+
+        blockEnd = start + blockHeaderSize + compressedSize;
+
+        if (events == nullptr)
+            return true;
+
+        MemoryInputStream compressedStream (compressed, false);
+        GZIPDecompressorInputStream unzipper (compressedStream);
+        MemoryBlock raw;
+
+        if (unzipper.readIntoMemoryBlock (raw, rawSize) != (size_t) rawSize)
+            return false;
+
+        MemoryInputStream rawStream (raw, false);
+
+        for (int i = 0; i < numEvents; ++i)
+            events->push_back (readEvent (rawStream));
+
+        return true;
+    }
+
+    static void writeStringPairs (OutputStream& out, const StringPairArray& pairs)
+    {
+        out.writeCompressedInt (pairs.size());
+
+        for (auto& key : pairs.getAllKeys())
+        {
+            out.writeString (key);
+            out.writeString (pairs[key]);
+        }
+    }
+
+    static StringPairArray readStringPairs (InputStream& in)
+    {
+        StringPairArray pairs;
+
+        for (auto i = in.readCompressedInt(); --i >= 0;)
+        {
+            const auto key = in.readString();
+            pairs.set (key, in.readString());
+        }
+
+        return pairs;
+    }
+
+    static uint32 getChecksum (const void* data, size_t size) noexcept
+    {
+        // FNV-1a
+        uint32 hash = 2166136261u;
+
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ static_cast<const uint8*> (data)[i]) * 16777619u;
+
+        return hash;
+    }
+
+    //==============================================================================
+    const File file;
+    std::unique_ptr<FileOutputStream> writer;
+    int64 readPosition = 0, writePosition = headerSize;
+    int64 firstBlockStart = headerSize;
+    int numSentFromFirstBlock = 0, numUnreadEvents = 0;
+};
+
+//==============================================================================
 ThreadedAnalyticsDestination::ThreadedAnalyticsDestination (const String& threadName)
-    : dispatcher (threadName, *this)
+    : ThreadedAnalyticsDestination (threadName, Options{})
+{}
+
+ThreadedAnalyticsDestination::ThreadedAnalyticsDestination (const String& threadName, const Options& options)
+    : dispatcher (threadName, *this, options)
 {}
 
 ThreadedAnalyticsDestination::~ThreadedAnalyticsDestination()
@@ -47,6 +367,18 @@ void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
     dispatcher.addToQueue (event);
 }
 
+ThreadedAnalyticsDestination::Statistics ThreadedAnalyticsDestination::getStatistics() const
+{
+    Statistics s;
+    s.numEventsLogged  = dispatcher.numLogged;
+    s.numEventsSent    = dispatcher.numSent;
+    s.numEventsDropped = dispatcher.numDropped;
+    s.numEventsSpooled = dispatcher.numSpooled;
+    s.numFailedBatches = dispatcher.numFailedBatches;
+    s.numEventsWaiting = dispatcher.incomingEvents.getNumReady() + dispatcher.numWaitingInMemory + dispatcher.numWaitingOnDisk;
+    return s;
+}
+
 void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodMilliseconds)
 {
     setBatchPeriod (initialBatchPeriodMilliseconds);
@@ -56,19 +388,25 @@ void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodM
 void ThreadedAnalyticsDestination::stopAnalyticsThread (int timeout)
 {
     dispatcher.signalThreadShouldExit();
+    dispatcher.notify();
     stopLoggingEvents();
     dispatcher.stopThread (timeout);
 
-    if (dispatcher.eventQueue.size() > 0)
-        saveUnloggedEvents (dispatcher.eventQueue);
+    dispatcher.saveEventsOnShutdown();
 }
 
+//==============================================================================
 ThreadedAnalyticsDestination::EventDispatcher::EventDispatcher (const String& dispatcherThreadName,
-                                                                ThreadedAnalyticsDestination& destination)
+                                                                ThreadedAnalyticsDestination& destination,
+                                                                const Options& opts)
     : Thread (dispatcherThreadName),
-      parent (destination)
+      parent (destination),
+      options (opts),
+      incomingEvents (jmax (1, opts.queueSize))
 {}
 
+ThreadedAnalyticsDestination::EventDispatcher::~EventDispatcher() = default;
+
 void ThreadedAnalyticsDestination::EventDispatcher::run()
 {
     // We may have inserted some events into the queue (on the message thread)
@@ -78,34 +416,42 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
         std::deque<AnalyticsEvent> restoredEventQueue;
         parent.restoreUnloggedEvents (restoredEventQueue);
 
-        const ScopedLock lock (queueAccess);
+        for (auto& event : restoredEventQueue)
+            addWaitingEvent ({ std::move (event) });
+    }
+
+    if (options.spoolFile != File())
+    {
+        spool = std::make_unique<EventSpool> (options.spoolFile);
 
-        for (auto rit = restoredEventQueue.rbegin(); rit != restoredEventQueue.rend(); ++rit)
-            eventQueue.push_front (*rit);
+        // Events left over from an earlier session come before anything new
+        readEventsFromSpool();
     }
 
     const int maxBatchSize = parent.getMaximumBatchSize();
 
+    if (options.sendFullBatchesImmediately)
+        batchSizeToWakeUpFor = maxBatchSize;
+
     while (! threadShouldExit())
     {
-        {
-            const ScopedLock lock (queueAccess);
+        takeEventsFromQueue();
+        readEventsFromSpool();
 
-            const auto numEventsInBatch = eventsToSend.size();
-            const auto freeBatchCapacity = maxBatchSize - numEventsInBatch;
+        const auto numEventsInBatch = eventsToSend.size();
+        const auto freeBatchCapacity = maxBatchSize - numEventsInBatch;
 
-            if (freeBatchCapacity > 0)
-            {
-                const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
+        if (freeBatchCapacity > 0)
+        {
+            const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
 
-                if (numNewEvents > 0)
-                {
-                    const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
-                    const auto newBatchSize = numEventsInBatch + numEventsToAdd;
+            if (numNewEvents > 0)
+            {
+                const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
+                const auto newBatchSize = numEventsInBatch + numEventsToAdd;
 
-                    for (auto i = numEventsInBatch; i < newBatchSize; ++i)
-                        eventsToSend.add (eventQueue[(size_t) i]);
-                }
+                for (auto i = numEventsInBatch; i < newBatchSize; ++i)
+                    eventsToSend.add (eventQueue[(size_t) i].event);
             }
         }
 
@@ -113,15 +459,18 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
 
         if (! eventsToSend.isEmpty())
         {
-            if (parent.logBatchedEvents (eventsToSend))
-            {
-                const ScopedLock lock (queueAccess);
-
-                for (auto i = 0; i < eventsToSend.size(); ++i)
-                    eventQueue.pop_front();
+            const auto succeeded = parent.logBatchedEvents (eventsToSend);
+            lastBatchFailed = ! succeeded;
 
+            if (succeeded)
+            {
+                eventsWereSent (eventsToSend.size());
                 eventsToSend.clearQuick();
             }
+            else
+            {
+                ++numFailedBatches;
+            }
         }
 
         while (Time::getMillisecondCounter() - submissionTime < (uint32) batchPeriodMilliseconds.get())
@@ -129,17 +478,163 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
             if (threadShouldExit())
                 return;
 
-            Thread::sleep (100);
+            if (shouldSendBatchEarly())
+                break;
+
+            wait (100);
         }
     }
 }
 
+bool ThreadedAnalyticsDestination::EventDispatcher::shouldSendBatchEarly() const
+{
+    const auto batchSize = batchSizeToWakeUpFor.load();
+
+    return batchSize > 0
+        && ! lastBatchFailed
+        && (int) eventQueue.size() + incomingEvents.getNumReady() + numWaitingOnDisk >= batchSize;
+}
+
 void ThreadedAnalyticsDestination::EventDispatcher::addToQueue (const AnalyticsEvent& event)
 {
-    const ScopedLock lock (queueAccess);
-    eventQueue.push_back (event);
+    if (! incomingEvents.push (event))
+    {
+        ++numDropped;
+        notify();
+        return;
+    }
+
+    ++numLogged;
+
+    // Only wake the thread once for each batch's worth of events, so that logging
+    // doesn't usually need to touch the thread's lock
+    const auto batchSize = batchSizeToWakeUpFor.load();
+
+    if (batchSize > 0 && ++numEventsSinceWakeUp == batchSize)
+        notify();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::takeEventsFromQueue()
+{
+    numEventsSinceWakeUp = 0;
+
+    std::vector<AnalyticsEvent> newEvents;
+    incomingEvents.popAll ([&] (AnalyticsEvent& e) { newEvents.push_back (std::move (e)); });
+
+    if (newEvents.empty())
+        return;
+
+    if (spool == nullptr || ! spool->isOpen())
+    {
+        for (auto& event : newEvents)
+            addWaitingEvent ({ std::move (event) });
+
+        return;
+    }
+
+    static constexpr int maxEventsPerBlock = 256;
+
+    for (size_t start = 0; start < newEvents.size(); start += maxEventsPerBlock)
+    {
+        const auto numInBlock = (int) jmin ((size_t) maxEventsPerBlock, newEvents.size() - start);
+
+        // If there's a backlog on disk, or no room in memory, the new events are only
+        // kept on disk until readEventsFromSpool() has room for them
+        const auto keepInMemory = ! spool->hasUnreadBlocks()
+                                    && (int) eventQueue.size() + numInBlock <= options.maxEventsInMemory;
+
+        const auto blockStart = spool->append (newEvents.data() + start, numInBlock, keepInMemory);
+
+        if (blockStart >= 0)
+            numSpooled += numInBlock;
+
+        if (blockStart < 0 || keepInMemory)
+            for (int i = 0; i < numInBlock; ++i)
+                addWaitingEvent ({ std::move (newEvents[start + (size_t) i]), blockStart, i, numInBlock });
+    }
+
+    numWaitingOnDisk = spool->getNumUnreadEvents();
 }
 
+void ThreadedAnalyticsDestination::EventDispatcher::readEventsFromSpool()
+{
+    if (spool == nullptr)
+        return;
+
+    std::vector<AnalyticsEvent> events;
+    int64 blockStart = 0;
+    int blockSize = 0, numSkipped = 0;
+
+    while ((int) eventQueue.size() < options.maxEventsInMemory
+            && spool->readNextBlock (events, blockStart, blockSize, numSkipped))
+    {
+        for (size_t i = 0; i < events.size(); ++i)
+            eventQueue.push_back ({ std::move (events[i]), blockStart, numSkipped + (int) i, blockSize });
+    }
+
+    numWaitingInMemory = (int) eventQueue.size();
+    numWaitingOnDisk = spool->getNumUnreadEvents();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::addWaitingEvent (WaitingEvent event)
+{
+    // Events that are part of the batch being retried have to stay where they are,
+    // so the oldest event after them is dropped instead
+    if ((int) eventQueue.size() >= options.maxEventsInMemory
+         && (int) eventQueue.size() > eventsToSend.size())
+    {
+        eventQueue.erase (eventQueue.begin() + eventsToSend.size());
+        ++numDropped;
+    }
+
+    eventQueue.push_back (std::move (event));
+    numWaitingInMemory = (int) eventQueue.size();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::eventsWereSent (int numEventsSent)
+{
+    int64 lastBlockStart = -1;
+    int numSentFromLastBlock = 0;
+
+    for (int i = 0; i < numEventsSent; ++i)
+    {
+        const auto& event = eventQueue.front();
+
+        if (event.spoolBlockStart >= 0)
+        {
+            lastBlockStart = event.spoolBlockStart;
+            numSentFromLastBlock = event.indexInBlock + 1;
+        }
+
+        eventQueue.pop_front();
+    }
+
+    numSent += numEventsSent;
+    numWaitingInMemory = (int) eventQueue.size();
+
+    if (spool != nullptr && lastBlockStart >= 0)
+    {
+        const auto anySpooledEventsInMemory = std::any_of (eventQueue.begin(), eventQueue.end(),
+                                                           [] (const WaitingEvent& e) { return e.spoolBlockStart >= 0; });
+
+        spool->eventsWereSent (lastBlockStart, numSentFromLastBlock, anySpooledEventsInMemory);
+    }
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::saveEventsOnShutdown()
+{
+    takeEventsFromQueue();
+
+    // Events that are in the spool file will be sent again by the next session
+    std::deque<AnalyticsEvent> unsavedEvents;
+
+    for (auto& event : eventQueue)
+        if (event.spoolBlockStart < 0)
+            unsavedEvents.push_back (event.event);
+
+    if (! unsavedEvents.empty())
+        parent.saveUnloggedEvents (unsavedEvents);
+}
 
 //==============================================================================
 //==============================================================================
@@ -151,8 +646,9 @@ namespace DestinationTestHelpers
     struct BasicDestination   : public ThreadedAnalyticsDestination
     {
         BasicDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                          std::deque<AnalyticsEvent>& unloggedEvents)
-            : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest"),
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          const Options& options = {})
+            : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest", options),
               loggedEventQueue (loggedEvents),
               unloggedEventStore (unloggedEvents)
         {
@@ -281,6 +777,80 @@ struct ThreadedAnalyticsDestinationTests   : public UnitTest
 
         compareEventQueues (unloggedEvents, testEvents);
         expect (loggedEvents.size() == 0);
+
+        unloggedEvents.clear();
+
+        beginTest ("Spooled events are sent after a restart");
+        {
+            TemporaryFile spoolFile;
+            const auto options = ThreadedAnalyticsDestination::Options{}.withSpoolFile (spoolFile.getFile());
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, options);
+                destination.setLoggingEnabled (false);
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+
+                waitFor ([&] { return destination.getStatistics().numEventsSpooled == (int64) testEvents.size(); });
+            }
+
+            expect (unloggedEvents.empty());
+            expect (loggedEvents.empty());
+
+            // Simulate a crash part-way through writing another block
+            if (FileOutputStream out (spoolFile.getFile()); out.openedOk())
+                out.writeInt (0x4a41424b);
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, options);
+
+                waitFor ([&]
+                {
+                    const ScopedLock lock (destination.eventQueueChanging);
+                    return loggedEvents.size() >= testEvents.size() && destination.getStatistics().numEventsWaiting == 0;
+                });
+            }
+
+            compareEventQueues (loggedEvents, testEvents);
+            expect (unloggedEvents.empty());
+            expectEquals (spoolFile.getFile().getSize(), (int64) 16);
+        }
+
+        loggedEvents.clear();
+
+        beginTest ("Events beyond the memory limit are dropped");
+        {
+            DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents,
+                                                                  ThreadedAnalyticsDestination::Options{}.withMaxEventsInMemory (3));
+            destination.setLoggingEnabled (false);
+
+            for (auto& event : testEvents)
+                destination.logEvent (event);
+
+            waitFor ([&] { return destination.getStatistics().numEventsDropped == 4; });
+
+            const auto stats = destination.getStatistics();
+            expectEquals (stats.numEventsLogged, (int64) testEvents.size());
+            expectEquals (stats.numEventsWaiting, 3);
+        }
+
+        expectEquals ((int) unloggedEvents.size(), 3);
+    }
+
+    template <typename Condition>
+    void waitFor (Condition&& condition)
+    {
+        for (int waitTime = 0; ! condition(); waitTime += 10)
+        {
+            if (waitTime > 4000)
+            {
+                expect (waitTime < 4000);
+                break;
+            }
+
+            Thread::sleep (10);
+        }
     }
 };
 
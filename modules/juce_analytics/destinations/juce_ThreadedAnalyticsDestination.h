@@ -45,6 +45,15 @@ namespace juce
     Calling stopAnalyticsThread will, in turn, call stopLoggingEvents, which
     you should use to terminate the currently running logBatchedEvents call.
 
+    Logging an event just pushes it into a lock-free queue, so threads that log
+    events don't contend with each other or with the analytics thread. The number
+    of events that are kept in memory while they wait to be sent is limited; if
+    a spool file is given in the Options, events are also appended to that file
+    in compressed blocks, so that a backlog can grow beyond what's kept in memory,
+    and events that were never sent are replayed after a crash. Otherwise, the
+    oldest waiting events are dropped once the limit is reached. getStatistics()
+    can be used to keep an eye on this.
+
     @see Analytics, AnalyticsDestination, AnalyticsDestination::AnalyticsEvent
 
     @tags{Analytics}
@@ -52,6 +61,62 @@ namespace juce
 class JUCE_API  ThreadedAnalyticsDestination   : public AnalyticsDestination
 {
 public:
+    //==============================================================================
+    /** Settings for a ThreadedAnalyticsDestination. */
+    struct JUCE_API  Options
+    {
+        /** The number of events that can be waiting to be picked up by the analytics
+            thread. If more events than this are logged between two batches, the extra
+            events are dropped.
+        */
+        [[nodiscard]] auto withQueueSize (int x) const                      { return with (&Options::queueSize, x); }
+
+        /** The number of events that can wait in memory to be sent. Beyond this, events
+            are only kept in the spool file if there is one, or dropped if there isn't.
+        */
+        [[nodiscard]] auto withMaxEventsInMemory (int x) const              { return with (&Options::maxEventsInMemory, x); }
+
+        /** If this is set, every event is appended to this file until it has been sent,
+            and any events left in the file when the analytics thread starts are sent
+            again. The file is created if it doesn't exist.
+
+            When a spool file is used, saveUnloggedEvents() is only called for events
+            that restoreUnloggedEvents() provided and that still haven't been sent.
+        */
+        [[nodiscard]] auto withSpoolFile (File x) const                     { return with (&Options::spoolFile, std::move (x)); }
+
+        /** If this is true, a batch is sent as soon as getMaximumBatchSize() events are
+            waiting, rather than waiting for the end of the batch period. After a batch
+            fails to be logged, the whole period is still waited for before retrying.
+        */
+        [[nodiscard]] auto withFullBatchesSentImmediately (bool x) const    { return with (&Options::sendFullBatchesImmediately, x); }
+
+        int queueSize = 4096;
+        int maxEventsInMemory = 16384;
+        File spoolFile;
+        bool sendFullBatchesImmediately = false;
+
+    private:
+        template <typename Member, typename Item>
+        Options with (Member&& member, Item&& item) const
+        {
+            auto copy = *this;
+            copy.*member = std::forward<Item> (item);
+            return copy;
+        }
+    };
+
+    /** Counts of what has happened to the events passed to logEvent(). */
+    struct JUCE_API  Statistics
+    {
+        int64 numEventsLogged = 0;      /**< The events that were accepted by logEvent(). */
+        int64 numEventsSent = 0;        /**< The events that logBatchedEvents() has logged successfully. */
+        int64 numEventsDropped = 0;     /**< The events that were lost because a queue or the memory limit was full. */
+        int64 numEventsSpooled = 0;     /**< The events that have been written to the spool file. */
+        int64 numFailedBatches = 0;     /**< The number of times logBatchedEvents() returned false. */
+        int numEventsWaiting = 0;       /**< The events waiting to be sent, including those only in the spool file. */
+    };
+
     //==============================================================================
     /**
         Creates a ThreadedAnalyticsDestination.
@@ -61,6 +126,15 @@ public:
     */
     ThreadedAnalyticsDestination (const String& threadName = "Analytics thread");
 
+    /**
+        Creates a ThreadedAnalyticsDestination with some Options.
+
+        @param threadName     used to identify the analytics
+                              thread in debug builds
+        @param options        the queue, memory and spooling settings to use
+    */
+    ThreadedAnalyticsDestination (const String& threadName, const Options& options);
+
     /** Destructor. */
     ~ThreadedAnalyticsDestination() override;
 
@@ -128,6 +202,12 @@ public:
     */
     void logEvent (const AnalyticsEvent& event) override final;
 
+    /** Returns counts of what has happened to the events that have been logged.
+
+        This method is thread safe.
+    */
+    Statistics getStatistics() const;
+
 protected:
     //==============================================================================
     /**
@@ -191,21 +271,45 @@ private:
     */
     virtual void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue) = 0;
 
+    class EventSpool;
+
+    struct WaitingEvent
+    {
+        AnalyticsEvent event;
+        int64 spoolBlockStart = -1;     // -1 if the event isn't in the spool file
+        int indexInBlock = 0, blockSize = 0;
+    };
+
     struct EventDispatcher   : public Thread
     {
-        EventDispatcher (const String& threadName, ThreadedAnalyticsDestination&);
+        EventDispatcher (const String& threadName, ThreadedAnalyticsDestination&, const Options&);
+        ~EventDispatcher() override;
 
         void run() override;
         void addToQueue (const AnalyticsEvent&);
+        void takeEventsFromQueue();
+        void readEventsFromSpool();
+        void addWaitingEvent (WaitingEvent);
+        void eventsWereSent (int numEventsSent);
+        bool shouldSendBatchEarly() const;
+        void saveEventsOnShutdown();
 
         ThreadedAnalyticsDestination& parent;
+        const Options options;
+
+        MPSCQueue<AnalyticsEvent> incomingEvents;
+        std::atomic<int> numEventsSinceWakeUp { 0 }, batchSizeToWakeUpFor { 0 };
+        std::atomic<bool> lastBatchFailed { false };
 
-        std::deque<AnalyticsEvent> eventQueue;
-        CriticalSection queueAccess;
+        std::deque<WaitingEvent> eventQueue;
+        std::unique_ptr<EventSpool> spool;
 
         Atomic<int> batchPeriodMilliseconds { 1000 };
 
         Array<AnalyticsEvent> eventsToSend;
+
+        std::atomic<int64> numLogged { 0 }, numSent { 0 }, numDropped { 0 }, numSpooled { 0 }, numFailedBatches { 0 };
+        std::atomic<int> numWaitingInMemory { 0 }, numWaitingOnDisk { 0 };
     };
 
     const String destinationName;
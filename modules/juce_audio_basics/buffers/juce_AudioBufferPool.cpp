@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioBufferPool::AudioBufferPool() = default;
+
+AudioBufferPool::AudioBufferPool (size_t numBytes, int maxNumLeases)
+{
+    reserve (numBytes, maxNumLeases);
+}
+
+AudioBufferPool::~AudioBufferPool()
+{
+    // All the leases must be released before the pool they came from is deleted!
+    jassert (numLeases == 0);
+}
+
+void AudioBufferPool::reserve (size_t numBytes, int maxNumLeases)
+{
+    jassert (maxNumLeases > 0);
+
+    const SpinLock::ScopedLockType sl (lock);
+
+    // You can't change the size of the pool while any of its memory is in use!
+    jassert (numLeases == 0);
+
+    capacity = alignUp (numBytes);
+    storage.malloc (capacity + alignment);
+    data = reinterpret_cast<char*> (alignUp ((size_t) (pointer_sized_uint) storage.get()));
+
+    // There can never be more free regions than one more than the number of leases,
+    // so this is the only place that the list needs to allocate
+    maxLeases = maxNumLeases;
+    freeRegions.clear();
+    freeRegions.reserve ((size_t) maxLeases + 1);
+
+    if (capacity > 0)
+        freeRegions.push_back ({ 0, capacity });
+}
+
+size_t AudioBufferPool::getNumBytesAvailable() const noexcept
+{
+    const SpinLock::ScopedLockType sl (lock);
+
+    size_t total = 0;
+
+    for (auto& region : freeRegions)
+        total += region.size;
+
+    return total;
+}
+
+int AudioBufferPool::getNumLeases() const noexcept
+{
+    const SpinLock::ScopedLockType sl (lock);
+    return numLeases;
+}
+
+size_t AudioBufferPool::allocateBytes (size_t numBytes) noexcept
+{
+    const SpinLock::ScopedLockType sl (lock);
+
+    if (numLeases >= maxLeases)
+    {
+        // If you hit this, pass a larger maxNumLeases to reserve()
+        jassertfalse;
+        return failedAllocation;
+    }
+
+    for (auto it = freeRegions.begin(); it != freeRegions.end(); ++it)
+    {
+        if (it->size < numBytes)
+            continue;
+
+        const auto offset = it->offset;
+
+        if (it->size == numBytes)
+        {
+            freeRegions.erase (it);
+        }
+        else
+        {
+            it->offset += numBytes;
+            it->size -= numBytes;
+        }
+
+        ++numLeases;
+        return offset;
+    }
+
+    return failedAllocation;
+}
+
+void AudioBufferPool::releaseBytes (size_t offset, size_t numBytes) noexcept
+{
+    const SpinLock::ScopedLockType sl (lock);
+
+    jassert (numLeases > 0);
+    --numLeases;
+
+    auto next = std::lower_bound (freeRegions.begin(), freeRegions.end(), offset,
+                                  [] (const FreeRegion& region, size_t o) { return region.offset < o; });
+
+    const auto joinsNext = next != freeRegions.end() && offset + numBytes == next->offset;
+    const auto joinsPrevious = next != freeRegions.begin() && std::prev (next)->offset + std::prev (next)->size == offset;
+
+    if (joinsPrevious && joinsNext)
+    {
+        std::prev (next)->size += numBytes + next->size;
+        freeRegions.erase (next);
+    }
+    else if (joinsPrevious)
+    {
+        std::prev (next)->size += numBytes;
+    }
+    else if (joinsNext)
+    {
+        next->offset = offset;
+        next->size += numBytes;
+    }
+    else
+    {
+        jassert (freeRegions.size() < freeRegions.capacity());
+        freeRegions.insert (next, { offset, numBytes });
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioBufferPoolTests  : public UnitTest
+{
+public:
+    AudioBufferPoolTests()
+        : UnitTest ("AudioBufferPool", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Channels are aligned and padded");
+        {
+            for (auto numSamples : { 1, 100, 256, 512, 1024, 1031 })
+            {
+                AudioBuffer<float> buffer (4, numSamples);
+                checkChannelLayout (buffer);
+
+                buffer.setSize (3, numSamples * 2, true);
+                checkChannelLayout (buffer);
+
+                buffer.setSize (5, numSamples / 2 + 1);
+                checkChannelLayout (buffer);
+            }
+
+            AudioBufferPool pool (AudioBufferPool::getBytesNeeded<double> (8, 512));
+            auto lease = pool.allocate<double> (8, 512);
+            expect (lease.isValid());
+            checkChannelLayout (lease.getBuffer());
+        }
+
+        beginTest ("Leases return their memory to the pool");
+        {
+            const auto bytesPerBuffer = AudioBufferPool::getBytesNeeded<float> (2, 480);
+            AudioBufferPool pool (bytesPerBuffer * 3);
+            expectEquals ((int) pool.getNumBytesAvailable(), (int) pool.getCapacity());
+
+            {
+                auto a = pool.allocate<float> (2, 480);
+                auto b = pool.allocate<float> (2, 480);
+                auto c = pool.allocate<float> (2, 480);
+                auto d = pool.allocate<float> (2, 480);
+
+                expect (a.isValid() && b.isValid() && c.isValid());
+                expect (! d.isValid());
+                expectEquals (d.getBuffer().getNumChannels(), 0);
+                expectEquals (pool.getNumLeases(), 3);
+
+                a.getBuffer().clear();
+                b.getBuffer().applyGain (0.5f);
+                c.getBuffer().clear();
+                b.getBuffer().clear();
+
+                for (auto* lease : { &a, &b, &c })
+                {
+                    expectEquals (lease->getBuffer().getNumChannels(), 2);
+                    expectEquals (lease->getBuffer().getNumSamples(), 480);
+                }
+
+                const auto* middle = b.getBuffer().getReadPointer (0);
+                b.release();
+                expect (! b.isValid());
+                d = pool.allocate<float> (2, 480);
+                expect (d.isValid());
+                expect (d.getBuffer().getReadPointer (0) == middle);
+
+                auto moved = std::move (d);
+                expect (moved.isValid() && ! d.isValid());
+                expectEquals (pool.getNumLeases(), 3);
+            }
+
+            expectEquals (pool.getNumLeases(), 0);
+            expectEquals ((int) pool.getNumBytesAvailable(), (int) pool.getCapacity());
+
+            auto large = pool.allocate<float> (6, 480);
+            expect (large.isValid());
+        }
+
+        beginTest ("Released regions are merged in any order");
+        {
+            AudioBufferPool pool (AudioBufferPool::getBytesNeeded<float> (1, 64) * 16);
+            auto random = getRandom();
+
+            for (int iteration = 0; iteration < 20; ++iteration)
+            {
+                std::vector<AudioBufferPool::Lease<float>> leases;
+
+                for (int i = 0; i < 16; ++i)
+                    leases.push_back (pool.allocate<float> (1, 64));
+
+                expect (std::all_of (leases.begin(), leases.end(), [] (auto& l) { return l.isValid(); }));
+
+                while (! leases.empty())
+                    leases.erase (leases.begin() + random.nextInt ((int) leases.size()));
+
+                expectEquals ((int) pool.getNumBytesAvailable(), (int) pool.getCapacity());
+                expect (pool.allocate<float> (16, 64).isValid());
+            }
+        }
+    }
+
+private:
+    template <typename Type>
+    void checkChannelLayout (const AudioBuffer<Type>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto address = (pointer_sized_uint) buffer.getReadPointer (ch);
+            expectEquals ((int) (address % 64), 0);
+
+            if (ch > 0)
+            {
+                const auto stride = address - (pointer_sized_uint) buffer.getReadPointer (ch - 1);
+                expect (stride >= (pointer_sized_uint) buffer.getNumSamples() * sizeof (Type));
+                expect (stride % 1024 != 0);
+            }
+        }
+    }
+};
+
+static AudioBufferPoolTests audioBufferPoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A preallocated block of memory from which temporary AudioBuffers can be taken
+    without allocating.
+
+    Call reserve() when you prepare for playback, then call allocate() on the audio
+    thread to get a Lease. A lease holds an AudioBuffer that refers to memory in the
+    pool. When the lease is destroyed, its memory goes back to the pool. A single pool
+    can be shared by all the nodes of a graph or all the voices of a synth, so their
+    scratch buffers come out of one contiguous, cache-friendly region.
+
+    Every channel starts on a 64-byte boundary. Channels and allocations whose size is
+    a multiple of 1K get an extra cache line of padding, so that the same sample index
+    in different channels doesn't map onto the same cache sets.
+
+    allocate() and releasing a lease are lock-free apart from a short spin-lock, and
+    never touch the system allocator. If the pool doesn't have enough space left,
+    allocate() returns an invalid lease rather than allocating more.
+
+    The AudioBuffer inside a lease only refers to the pool's memory. If you resize it,
+    it will allocate its own memory and stop using the pool. Buffers with 32 or more
+    channels also need to allocate their list of channel pointers.
+
+    e.g.
+    @code
+    void prepareToPlay (double, int maximumExpectedSamplesPerBlock) override
+    {
+        pool.reserve (8 * AudioBufferPool::getBytesNeeded<float> (2, maximumExpectedSamplesPerBlock));
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        auto scratch = pool.allocate<float> (buffer.getNumChannels(), buffer.getNumSamples());
+
+        if (scratch.isValid())
+            renderInto (scratch.getBuffer());
+    }
+    @endcode
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioBufferPool
+{
+public:
+    //==============================================================================
+    /** Creates an empty pool. Call reserve() before trying to allocate from it. */
+    AudioBufferPool();
+
+    /** Creates a pool and reserves the given number of bytes.
+        @see reserve
+    */
+    explicit AudioBufferPool (size_t numBytes, int maxNumLeases = 256);
+
+    /** Destructor. All the leases must have been released before the pool is deleted. */
+    ~AudioBufferPool();
+
+    //==============================================================================
+    /** Allocates the pool's memory.
+
+        This allocates, so don't call it on the audio thread. It must not be called while
+        any leases are outstanding.
+
+        @param numBytes         the total size of the pool. Use getBytesNeeded() to work
+                                out how much each buffer will take.
+        @param maxNumLeases     the largest number of leases that may be outstanding at
+                                once
+    */
+    void reserve (size_t numBytes, int maxNumLeases = 256);
+
+    /** Returns the number of bytes of the pool that a buffer of a given size will use. */
+    template <typename Type>
+    static size_t getBytesNeeded (int numChannels, int numSamples) noexcept
+    {
+        return getAllocationSize (getChannelDataOffset<Type> (numChannels)
+                                    + (size_t) numChannels * getChannelStride<Type> (numSamples) * sizeof (Type));
+    }
+
+    /** Returns the total number of bytes in the pool. */
+    size_t getCapacity() const noexcept                 { return capacity; }
+
+    /** Returns the number of bytes that are not in use by any lease.
+
+        The free space may be fragmented, so a single allocation of this size isn't
+        guaranteed to succeed.
+    */
+    size_t getNumBytesAvailable() const noexcept;
+
+    /** Returns the number of leases that are currently outstanding. */
+    int getNumLeases() const noexcept;
+
+    //==============================================================================
+    /**
+        An AudioBuffer whose memory belongs to an AudioBufferPool.
+
+        The memory is returned to the pool when the lease is destroyed or released.
+
+        @tags{Audio}
+    */
+    template <typename Type>
+    class Lease
+    {
+    public:
+        /** Creates an invalid lease. */
+        Lease() = default;
+
+        /** Destructor. This returns the memory to the pool. */
+        ~Lease()                                         { release(); }
+
+        /** Move constructor. */
+        Lease (Lease&& other) noexcept                   { swapWith (other); }
+
+        /** Move assignment. */
+        Lease& operator= (Lease&& other) noexcept
+        {
+            Lease temp (std::move (other));
+            swapWith (temp);
+            return *this;
+        }
+
+        /** Returns true if the pool had enough space for this lease. */
+        bool isValid() const noexcept                    { return pool != nullptr; }
+
+        /** Returns the buffer. This is empty if the lease is invalid. */
+        AudioBuffer<Type>& getBuffer() noexcept          { return buffer; }
+
+        /** Returns the buffer. This is empty if the lease is invalid. */
+        const AudioBuffer<Type>& getBuffer() const noexcept    { return buffer; }
+
+        /** Returns the memory to the pool and leaves this lease invalid. */
+        void release() noexcept
+        {
+            if (pool != nullptr)
+            {
+                buffer = AudioBuffer<Type>();
+                pool->releaseBytes (offset, numBytes);
+                pool = nullptr;
+            }
+        }
+
+    private:
+        friend class AudioBufferPool;
+
+        Lease (AudioBufferPool& p, size_t offsetInPool, size_t bytes, Type* const* channels, int numChannels, int numSamples)
+            : pool (&p), offset (offsetInPool), numBytes (bytes), buffer (channels, numChannels, numSamples)
+        {
+        }
+
+        void swapWith (Lease& other) noexcept
+        {
+            std::swap (pool, other.pool);
+            std::swap (offset, other.offset);
+            std::swap (numBytes, other.numBytes);
+            std::swap (buffer, other.buffer);
+        }
+
+        AudioBufferPool* pool = nullptr;
+        size_t offset = 0, numBytes = 0;
+        AudioBuffer<Type> buffer;
+
+        JUCE_DECLARE_NON_COPYABLE (Lease)
+    };
+
+    /** Takes a buffer from the pool.
+
+        This doesn't allocate, so it can be called on the audio thread. The contents of
+        the buffer are undefined. If there isn't a large enough free region, the lease
+        that is returned will be invalid.
+    */
+    template <typename Type>
+    Lease<Type> allocate (int numChannels, int numSamples) noexcept
+    {
+        jassert (numChannels >= 0 && numSamples >= 0);
+
+        const auto bytes = getBytesNeeded<Type> (numChannels, numSamples);
+        const auto offset = allocateBytes (bytes);
+
+        if (offset == failedAllocation)
+            return {};
+
+        auto* start = data + offset;
+        auto** channels = unalignedPointerCast<Type**> (start);
+        auto* chan = unalignedPointerCast<Type*> (start + getChannelDataOffset<Type> (numChannels));
+        const auto stride = getChannelStride<Type> (numSamples);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            channels[i] = chan;
+            chan += stride;
+        }
+
+        return Lease<Type> (*this, offset, bytes, channels, numChannels, numSamples);
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t alignment = 64;
+    static constexpr size_t failedAllocation = std::numeric_limits<size_t>::max();
+
+    static constexpr size_t alignUp (size_t bytes) noexcept
+    {
+        return (bytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    static size_t getAllocationSize (size_t bytes) noexcept
+    {
+        bytes = alignUp (bytes);
+        return (bytes > 0 && bytes % 1024 == 0) ? bytes + alignment : bytes;
+    }
+
+    template <typename Type>
+    static size_t getChannelStride (int numSamples) noexcept
+    {
+        static_assert (alignof (Type) <= alignment, "AudioBufferPool can't hold types with such large alignment requirements");
+        return (getAllocationSize ((size_t) numSamples * sizeof (Type)) + sizeof (Type) - 1) / sizeof (Type);
+    }
+
+    template <typename Type>
+    static size_t getChannelDataOffset (int numChannels) noexcept
+    {
+        // a buffer with no channels still needs a valid channel list to refer to
+        return alignUp ((size_t) jmax (1, numChannels) * sizeof (Type*));
+    }
+
+    size_t allocateBytes (size_t numBytes) noexcept;
+    void releaseBytes (size_t offset, size_t numBytes) noexcept;
+
+    struct FreeRegion
+    {
+        size_t offset, size;
+    };
+
+    HeapBlock<char> storage;
+    char* data = nullptr;
+    size_t capacity = 0;
+    std::vector<FreeRegion> freeRegions;
+    int numLeases = 0, maxLeases = 0;
+    mutable SpinLock lock;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioBufferPool)
+    JUCE_LEAK_DETECTOR (AudioBufferPool)
+};
+
+} // namespace juce
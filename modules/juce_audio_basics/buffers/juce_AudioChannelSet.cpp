@@ -39,6 +39,29 @@ bool AudioChannelSet::operator== (const AudioChannelSet& other) const noexcept
 bool AudioChannelSet::operator!= (const AudioChannelSet& other) const noexcept  { return channels != other.channels; }
 bool AudioChannelSet::operator<  (const AudioChannelSet& other) const noexcept  { return channels <  other.channels; }
 
+std::optional<AudioChannelSet::ChannelMask> AudioChannelSet::getChannelMask() const noexcept
+{
+    if (channels.getHighestBit() >= ChannelMask::numBits)
+        return {};
+
+    ChannelMask mask;
+
+    for (size_t i = 0; i < mask.words.size(); ++i)
+        mask.words[i] = channels.getBitRangeAsInt ((int) i * 32, 32);
+
+    return mask;
+}
+
+AudioChannelSet AudioChannelSet::fromChannelMask (const ChannelMask& mask)
+{
+    AudioChannelSet set;
+
+    for (size_t i = 0; i < mask.words.size(); ++i)
+        set.channels.setBitRangeAsInt ((int) i * 32, 32, mask.words[i]);
+
+    return set;
+}
+
 String AudioChannelSet::getChannelTypeName (AudioChannelSet::ChannelType type)
 {
     if (type >= discreteChannel0)
@@ -702,6 +725,33 @@ public:
                   | (1ull << AudioChannelSet::ambisonicACN34) | (1ull << AudioChannelSet::ambisonicACN35);
             checkAmbisonic (mask, 5, "5th Order Ambisonics");
         }
+
+        beginTest ("ChannelMask round trip");
+        {
+            Array<AudioChannelSet> sets { AudioChannelSet::disabled(),
+                                          AudioChannelSet::stereo(),
+                                          AudioChannelSet::create7point1point6(),
+                                          AudioChannelSet::create9point1point6(),
+                                          AudioChannelSet::ambisonic (5),
+                                          AudioChannelSet::discreteChannels (1),
+                                          AudioChannelSet::discreteChannels (128) };
+
+            auto mixed = AudioChannelSet::stereo();
+            mixed.addChannel (static_cast<AudioChannelSet::ChannelType> (AudioChannelSet::discreteChannel0 + 100));
+            sets.add (mixed);
+
+            for (const auto& set : sets)
+            {
+                const auto mask = set.getChannelMask();
+                expect (mask.has_value());
+                expect (AudioChannelSet::fromChannelMask (*mask) == set);
+
+                for (const auto& other : sets)
+                    expect ((*mask == *other.getChannelMask()) == (set == other));
+            }
+
+            expect (AudioChannelSet::discreteChannels (129).getChannelMask() == std::nullopt);
+        }
     }
 
 private:
@@ -510,6 +510,35 @@ public:
     bool operator!= (const AudioChannelSet&) const noexcept;
     bool operator<  (const AudioChannelSet&) const noexcept;
 
+    //==============================================================================
+    /** A fixed-size bitmask holding the same channel types as an AudioChannelSet.
+
+        Unlike an AudioChannelSet, a ChannelMask never allocates, so it's cheap to copy,
+        compare and use as a key in a container. It can hold every named channel type and
+        the first 128 discrete channels.
+
+        @see getChannelMask, fromChannelMask
+    */
+    struct ChannelMask
+    {
+        static constexpr int numBits = discreteChannel0 + 128;
+
+        /** Bit n of the mask is bit (n % 32) of words[n / 32]. */
+        std::array<uint32, (size_t) numBits / 32> words{};
+
+        bool operator== (const ChannelMask& other) const noexcept  { return words == other.words; }
+        bool operator!= (const ChannelMask& other) const noexcept  { return words != other.words; }
+        bool operator<  (const ChannelMask& other) const noexcept  { return words <  other.words; }
+    };
+
+    /** Returns the channels in this set as a ChannelMask, or nullopt if the set contains
+        a discrete channel that is too high to be held in a ChannelMask.
+    */
+    std::optional<ChannelMask> getChannelMask() const noexcept;
+
+    /** Creates a channel set holding the channel types in a ChannelMask. */
+    static AudioChannelSet JUCE_CALLTYPE fromChannelMask (const ChannelMask&);
+
 private:
     //==============================================================================
     BigInteger channels;
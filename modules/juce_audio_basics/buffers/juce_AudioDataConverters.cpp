@@ -450,6 +450,302 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+namespace AudioDataFastConversionHelpers
+{
+    // Each of these converts four samples at a time, and gives exactly the same
+    // results as the corresponding AudioData::Pointer methods
+    inline void intsToFloats (const int32* in, float scale, float* out) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        _mm_storeu_ps (out, _mm_mul_ps (_mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*) in)), _mm_set1_ps (scale)));
+       #elif JUCE_USE_ARM_NEON
+        vst1q_f32 (out, vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (in)), scale));
+       #else
+        for (int i = 0; i < 4; ++i)
+            out[i] = (float) in[i] * scale;
+       #endif
+    }
+
+    // Integer formats are written from floats via a full-range 32-bit value (see
+    // Float32::getAsInt32()), which is then shifted down to the format's size
+    inline int32 floatToInt (float in, int shift) noexcept
+    {
+        return roundToInt (jlimit (-1.0, 1.0, (double) in) * (double) 0x7fffffff) >> shift;
+    }
+
+    inline void floatsToInts (const float* in, int shift, int32* out) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto x = _mm_loadu_ps (in);
+        const auto minusOne = _mm_set1_pd (-1.0), one = _mm_set1_pd (1.0), maxValue = _mm_set1_pd ((double) 0x7fffffff);
+        const auto lo = _mm_mul_pd (_mm_min_pd (_mm_max_pd (_mm_cvtps_pd (x), minusOne), one), maxValue);
+        const auto hi = _mm_mul_pd (_mm_min_pd (_mm_max_pd (_mm_cvtps_pd (_mm_movehl_ps (x, x)), minusOne), one), maxValue);
+        const auto ints = _mm_unpacklo_epi64 (_mm_cvtpd_epi32 (lo), _mm_cvtpd_epi32 (hi));
+        _mm_storeu_si128 ((__m128i*) out, _mm_sra_epi32 (ints, _mm_cvtsi32_si128 (shift)));
+       #else
+        for (int i = 0; i < 4; ++i)
+            out[i] = floatToInt (in[i], shift);
+       #endif
+    }
+
+    //==============================================================================
+    template <typename DataFormat>
+    struct LittleEndianSamples;
+
+    template <>
+    struct LittleEndianSamples<AudioData::Int16>
+    {
+        using Value = int32;
+        static constexpr int bytesPerSample = 2;
+        static constexpr float toFloatScale = 1.0f / 32768.0f;
+
+        static Value read (const char* p) noexcept              { return (int16) readUnaligned<uint16> (p); }
+        static void write (char* p, Value v) noexcept           { writeUnaligned<uint16> (p, (uint16) v); }
+        static float toFloat (Value v) noexcept                 { return (float) v * toFloatScale; }
+        static Value fromFloat (float f) noexcept               { return floatToInt (f, 16); }
+        static void toFloats (const Value* in, float* out) noexcept     { intsToFloats (in, toFloatScale, out); }
+        static void fromFloats (const float* in, Value* out) noexcept   { floatsToInts (in, 16, out); }
+    };
+
+    template <>
+    struct LittleEndianSamples<AudioData::Int24>
+    {
+        using Value = int32;
+        static constexpr int bytesPerSample = 3;
+        static constexpr float toFloatScale = 1.0f / 8388608.0f;
+
+        static Value read (const char* p) noexcept              { return ByteOrder::littleEndian24Bit (p); }
+        static void write (char* p, Value v) noexcept           { ByteOrder::littleEndian24BitToChars (v, p); }
+        static float toFloat (Value v) noexcept                 { return (float) v * toFloatScale; }
+        static Value fromFloat (float f) noexcept               { return floatToInt (f, 8); }
+        static void toFloats (const Value* in, float* out) noexcept     { intsToFloats (in, toFloatScale, out); }
+        static void fromFloats (const float* in, Value* out) noexcept   { floatsToInts (in, 8, out); }
+    };
+
+    template <>
+    struct LittleEndianSamples<AudioData::Int32>
+    {
+        using Value = int32;
+        static constexpr int bytesPerSample = 4;
+        static constexpr float toFloatScale = 1.0f / 2147483648.0f;
+
+        static Value read (const char* p) noexcept              { return readUnaligned<int32> (p); }
+        static void write (char* p, Value v) noexcept           { writeUnaligned<int32> (p, v); }
+        static float toFloat (Value v) noexcept                 { return (float) v * toFloatScale; }
+        static Value fromFloat (float f) noexcept               { return floatToInt (f, 0); }
+        static void toFloats (const Value* in, float* out) noexcept     { intsToFloats (in, toFloatScale, out); }
+        static void fromFloats (const float* in, Value* out) noexcept   { floatsToInts (in, 0, out); }
+    };
+
+    template <>
+    struct LittleEndianSamples<AudioData::Float32>
+    {
+        using Value = float;
+        static constexpr int bytesPerSample = 4;
+
+        static Value read (const char* p) noexcept              { return readUnaligned<float> (p); }
+        static void write (char* p, Value v) noexcept           { writeUnaligned<float> (p, v); }
+        static float toFloat (Value v) noexcept                 { return v; }
+        static Value fromFloat (float f) noexcept               { return f; }
+        static void toFloats (const Value* in, float* out) noexcept     { memcpy (out, in, 4 * sizeof (float)); }
+        static void fromFloats (const float* in, Value* out) noexcept   { memcpy (out, in, 4 * sizeof (float)); }
+    };
+
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS
+    // Stereo is by far the most common layout, so it gets dedicated shuffles
+    // instead of going through the general gather/scatter loops
+    inline bool deinterleaveStereo (AudioData::Int16, const char* src, float* left, float* right, int i) noexcept
+    {
+        const auto frames = _mm_loadu_si128 ((const __m128i*) (src + i * 4));
+        const auto scale = _mm_set1_ps (LittleEndianSamples<AudioData::Int16>::toFloatScale);
+        _mm_storeu_ps (left + i,  _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_slli_epi32 (frames, 16), 16)), scale));
+        _mm_storeu_ps (right + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (frames, 16)), scale));
+        return true;
+    }
+
+    inline bool deinterleaveStereo (AudioData::Float32, const char* src, float* left, float* right, int i) noexcept
+    {
+        const auto a = _mm_loadu_ps ((const float*) src + i * 2);
+        const auto b = _mm_loadu_ps ((const float*) src + i * 2 + 4);
+        _mm_storeu_ps (left + i,  _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+        _mm_storeu_ps (right + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+        return true;
+    }
+
+    inline bool deinterleaveStereo (AudioData::Int32, const char* src, float* left, float* right, int i) noexcept
+    {
+        const auto a = _mm_castsi128_ps (_mm_loadu_si128 ((const __m128i*) (src + i * 8)));
+        const auto b = _mm_castsi128_ps (_mm_loadu_si128 ((const __m128i*) (src + i * 8 + 16)));
+        const auto scale = _mm_set1_ps (LittleEndianSamples<AudioData::Int32>::toFloatScale);
+        _mm_storeu_ps (left + i,  _mm_mul_ps (_mm_cvtepi32_ps (_mm_castps_si128 (_mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)))), scale));
+        _mm_storeu_ps (right + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_castps_si128 (_mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)))), scale));
+        return true;
+    }
+
+    inline bool interleaveStereo (AudioData::Int16, const float* left, const float* right, char* dest, int i) noexcept
+    {
+        int32 l[4], r[4];
+        LittleEndianSamples<AudioData::Int16>::fromFloats (left + i, l);
+        LittleEndianSamples<AudioData::Int16>::fromFloats (right + i, r);
+
+        const auto li = _mm_loadu_si128 ((const __m128i*) l);
+        const auto ri = _mm_loadu_si128 ((const __m128i*) r);
+        _mm_storeu_si128 ((__m128i*) (dest + i * 4), _mm_packs_epi32 (_mm_unpacklo_epi32 (li, ri), _mm_unpackhi_epi32 (li, ri)));
+        return true;
+    }
+
+    inline bool interleaveStereo (AudioData::Float32, const float* left, const float* right, char* dest, int i) noexcept
+    {
+        const auto l = _mm_loadu_ps (left + i);
+        const auto r = _mm_loadu_ps (right + i);
+        _mm_storeu_ps ((float*) dest + i * 2,     _mm_unpacklo_ps (l, r));
+        _mm_storeu_ps ((float*) dest + i * 2 + 4, _mm_unpackhi_ps (l, r));
+        return true;
+    }
+   #endif
+
+    // Fallbacks for the formats that don't have a dedicated stereo version
+    template <typename DataFormat>
+    bool deinterleaveStereo (DataFormat, const char*, float*, float*, int) noexcept                 { return false; }
+
+    template <typename DataFormat>
+    bool interleaveStereo (DataFormat, const float*, const float*, char*, int) noexcept             { return false; }
+
+    //==============================================================================
+    template <typename DataFormat, int fixedNumChannels>
+    void deinterleave (const char* src, float* const* dest, int numChannelsToUse, int numSamples) noexcept
+    {
+        using Samples = LittleEndianSamples<DataFormat>;
+        const auto numChannels = fixedNumChannels > 0 ? fixedNumChannels : numChannelsToUse;
+        const auto frameSize = numChannels * Samples::bytesPerSample;
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            if constexpr (fixedNumChannels == 2)
+                if (deinterleaveStereo (DataFormat (nullptr), src, dest[0], dest[1], i))
+                    continue;
+
+            auto* frame = src + i * frameSize;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* sample = frame + ch * Samples::bytesPerSample;
+                const typename Samples::Value values[] = { Samples::read (sample),
+                                                           Samples::read (sample + frameSize),
+                                                           Samples::read (sample + frameSize * 2),
+                                                           Samples::read (sample + frameSize * 3) };
+                Samples::toFloats (values, dest[ch] + i);
+            }
+        }
+
+        for (; i < numSamples; ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                dest[ch][i] = Samples::toFloat (Samples::read (src + i * frameSize + ch * Samples::bytesPerSample));
+    }
+
+    template <typename DataFormat, int fixedNumChannels>
+    void interleave (const float* const* source, char* dest, int numChannelsToUse, int numSamples) noexcept
+    {
+        using Samples = LittleEndianSamples<DataFormat>;
+        const auto numChannels = fixedNumChannels > 0 ? fixedNumChannels : numChannelsToUse;
+        const auto frameSize = numChannels * Samples::bytesPerSample;
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            if constexpr (fixedNumChannels == 2)
+                if (interleaveStereo (DataFormat (nullptr), source[0], source[1], dest, i))
+                    continue;
+
+            auto* frame = dest + i * frameSize;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                typename Samples::Value values[4];
+                Samples::fromFloats (source[ch] + i, values);
+
+                auto* sample = frame + ch * Samples::bytesPerSample;
+
+                for (int k = 0; k < 4; ++k)
+                    Samples::write (sample + k * frameSize, values[k]);
+            }
+        }
+
+        for (; i < numSamples; ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                Samples::write (dest + i * frameSize + ch * Samples::bytesPerSample, Samples::fromFloat (source[ch][i]));
+    }
+
+    template <typename ChannelPointer>
+    bool canUseChannels (ChannelPointer* const* channels, int numChannels, int numOtherChannels) noexcept
+    {
+        return numChannels == numOtherChannels
+            && std::none_of (channels, channels + numChannels, [] (auto* c) { return c == nullptr; });
+    }
+}
+
+template <typename DataFormat>
+bool AudioData::FastConversion::deinterleave (const void* source, int numSourceChannels,
+                                              float* const* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataFastConversionHelpers;
+
+    if (! canUseChannels (dest, numDestChannels, numSourceChannels))
+        return false;
+
+    auto* src = static_cast<const char*> (source);
+
+    switch (numSourceChannels)
+    {
+        case 1:   AudioDataFastConversionHelpers::deinterleave<DataFormat, 1> (src, dest, 1, numSamples); break;
+        case 2:   AudioDataFastConversionHelpers::deinterleave<DataFormat, 2> (src, dest, 2, numSamples); break;
+        case 4:   AudioDataFastConversionHelpers::deinterleave<DataFormat, 4> (src, dest, 4, numSamples); break;
+        case 6:   AudioDataFastConversionHelpers::deinterleave<DataFormat, 6> (src, dest, 6, numSamples); break;
+        case 8:   AudioDataFastConversionHelpers::deinterleave<DataFormat, 8> (src, dest, 8, numSamples); break;
+        default:  AudioDataFastConversionHelpers::deinterleave<DataFormat, 0> (src, dest, numSourceChannels, numSamples); break;
+    }
+
+    return true;
+}
+
+template <typename DataFormat>
+bool AudioData::FastConversion::interleave (const float* const* source, int numSourceChannels,
+                                            void* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataFastConversionHelpers;
+
+    if (! canUseChannels (source, numSourceChannels, numDestChannels))
+        return false;
+
+    auto* dst = static_cast<char*> (dest);
+
+    switch (numDestChannels)
+    {
+        case 1:   AudioDataFastConversionHelpers::interleave<DataFormat, 1> (source, dst, 1, numSamples); break;
+        case 2:   AudioDataFastConversionHelpers::interleave<DataFormat, 2> (source, dst, 2, numSamples); break;
+        case 4:   AudioDataFastConversionHelpers::interleave<DataFormat, 4> (source, dst, 4, numSamples); break;
+        case 6:   AudioDataFastConversionHelpers::interleave<DataFormat, 6> (source, dst, 6, numSamples); break;
+        case 8:   AudioDataFastConversionHelpers::interleave<DataFormat, 8> (source, dst, 8, numSamples); break;
+        default:  AudioDataFastConversionHelpers::interleave<DataFormat, 0> (source, dst, numDestChannels, numSamples); break;
+    }
+
+    return true;
+}
+
+#if JUCE_LITTLE_ENDIAN
+ template bool AudioData::FastConversion::deinterleave<AudioData::Int16>   (const void*, int, float* const*, int, int) noexcept;
+ template bool AudioData::FastConversion::deinterleave<AudioData::Int24>   (const void*, int, float* const*, int, int) noexcept;
+ template bool AudioData::FastConversion::deinterleave<AudioData::Int32>   (const void*, int, float* const*, int, int) noexcept;
+ template bool AudioData::FastConversion::deinterleave<AudioData::Float32> (const void*, int, float* const*, int, int) noexcept;
+ template bool AudioData::FastConversion::interleave<AudioData::Int16>     (const float* const*, int, void*, int, int) noexcept;
+ template bool AudioData::FastConversion::interleave<AudioData::Int24>     (const float* const*, int, void*, int, int) noexcept;
+ template bool AudioData::FastConversion::interleave<AudioData::Int32>     (const float* const*, int, void*, int, int) noexcept;
+ template bool AudioData::FastConversion::interleave<AudioData::Float32>   (const float* const*, int, void*, int, int) noexcept;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -622,6 +918,67 @@ public:
                 for (int i = 0; i < numSamples; ++i)
                     expect (sourceBuffer.getSample (0, ch + (i * numChannels)) == destBuffer.getSample (ch, i));
         }
+
+        beginTest ("Single-pass interleaving matches per-channel conversion");
+        {
+            testSinglePassConversion<AudioData::Int16>   (r);
+            testSinglePassConversion<AudioData::Int24>   (r);
+            testSinglePassConversion<AudioData::Int32>   (r);
+            testSinglePassConversion<AudioData::Float32> (r);
+        }
+    }
+
+    template <typename DataFormat>
+    void testSinglePassConversion (Random& r)
+    {
+        using PlanarFormat      = AudioData::Format<AudioData::Float32, AudioData::NativeEndian>;
+        using InterleavedFormat = AudioData::Format<DataFormat, AudioData::LittleEndian>;
+        using InterleavedConst  = AudioData::Pointer<DataFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+        using InterleavedWrite  = AudioData::Pointer<DataFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::NonConst>;
+        using PlanarConst       = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using PlanarWrite       = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+        const auto bytesPerSample = InterleavedConst::getBytesPerSample();
+
+        for (auto numChannels : { 1, 2, 3, 6, 8 })
+        {
+            for (auto numSamples : { 1, 4, 37, 256 })
+            {
+                AudioBuffer<float> planar (numChannels, numSamples), result (numChannels, numSamples), expected (numChannels, numSamples);
+                HeapBlock<char> interleaved ((size_t) (numChannels * numSamples * bytesPerSample)),
+                                reference   ((size_t) (numChannels * numSamples * bytesPerSample));
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        // Include exact half-steps and values beyond the clipping range
+                        const auto value = r.nextInt (4) == 0 ? (float) (r.nextInt (65536) - 32768) / 32768.0f + 0.5f / 32768.0f
+                                                              : r.nextFloat() * 2.4f - 1.2f;
+                        planar.setSample (ch, i, value);
+                    }
+                }
+
+                AudioData::interleaveSamples (AudioData::NonInterleavedSource<PlanarFormat> { planar.getArrayOfReadPointers(), numChannels },
+                                              AudioData::InterleavedDest<InterleavedFormat> { reinterpret_cast<typename AudioData::InterleavedDest<InterleavedFormat>::DataType> (interleaved.get()), numChannels },
+                                              numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    InterleavedWrite (reference.get() + ch * bytesPerSample, numChannels).convertSamples (PlanarConst (planar.getReadPointer (ch)), numSamples);
+
+                expect (memcmp (interleaved.get(), reference.get(), (size_t) (numChannels * numSamples * bytesPerSample)) == 0);
+
+                AudioData::deinterleaveSamples (AudioData::InterleavedSource<InterleavedFormat> { reinterpret_cast<typename AudioData::InterleavedSource<InterleavedFormat>::DataType> (interleaved.get()), numChannels },
+                                                AudioData::NonInterleavedDest<PlanarFormat>     { result.getArrayOfWritePointers(), numChannels },
+                                                numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    PlanarWrite (expected.getWritePointer (ch)).convertSamples (InterleavedConst (reference.get() + ch * bytesPerSample, numChannels), numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    expect (memcmp (result.getReadPointer (ch), expected.getReadPointer (ch), sizeof (float) * (size_t) numSamples) == 0);
+            }
+        }
     }
 };
 
@@ -601,6 +601,36 @@ public:
         */
         virtual void convertSamples (void* destSamples, int destSubChannel,
                                      const void* sourceSamples, int sourceSubChannel, int numSamples) const = 0;
+
+        /** Converts a block of interleaved samples from the converter's source format into a set
+            of separate channels in the dest format.
+
+            The number of channels must match the number of interleaved channels that the converter
+            was created with. The default implementation converts each channel in turn, but
+            ConverterInstance does the whole block in a single pass when its formats allow it.
+        */
+        virtual void deinterleaveSamples (void* const* destChannels, const void* interleavedSource,
+                                          int numChannels, int numSamples) const
+        {
+            for (int i = 0; i < numChannels; ++i)
+                if (destChannels[i] != nullptr)
+                    convertSamples (destChannels[i], 0, interleavedSource, i, numSamples);
+        }
+
+        /** Converts a set of separate channels in the converter's source format into a block of
+            interleaved samples in the dest format.
+
+            The number of channels must match the number of interleaved channels that the converter
+            was created with. The default implementation converts each channel in turn, but
+            ConverterInstance does the whole block in a single pass when its formats allow it.
+        */
+        virtual void interleaveSamples (void* interleavedDest, const void* const* sourceChannels,
+                                        int numChannels, int numSamples) const
+        {
+            for (int i = 0; i < numChannels; ++i)
+                if (sourceChannels[i] != nullptr)
+                    convertSamples (interleavedDest, i, sourceChannels[i], 0, numSamples);
+        }
     };
 
     //==============================================================================
@@ -637,6 +667,46 @@ public:
             d.convertSamples (s, numSamples);
         }
 
+        void deinterleaveSamples (void* const* destChannelData, const void* interleavedSource,
+                                  int numChannels, int numSamples) const override
+        {
+            using Source = PointerTraits<SourceSampleType>;
+            using Dest   = PointerTraits<DestSampleType>;
+
+            if constexpr (Source::isInterleaved && ! Dest::isInterleaved && ! Dest::isConst)
+            {
+                jassert (numChannels == sourceChannels);
+
+                AudioData::deinterleaveSamples (InterleavedSource<typename Source::FormatType>  { static_cast<typename Source::ConstElementType*> (interleavedSource), numChannels },
+                                                NonInterleavedDest<typename Dest::FormatType>   { reinterpret_cast<typename Dest::ElementType* const*> (destChannelData), numChannels },
+                                                numSamples);
+            }
+            else
+            {
+                Converter::deinterleaveSamples (destChannelData, interleavedSource, numChannels, numSamples);
+            }
+        }
+
+        void interleaveSamples (void* interleavedDest, const void* const* sourceChannelData,
+                                int numChannels, int numSamples) const override
+        {
+            using Source = PointerTraits<SourceSampleType>;
+            using Dest   = PointerTraits<DestSampleType>;
+
+            if constexpr (! Source::isInterleaved && Dest::isInterleaved && ! Dest::isConst)
+            {
+                jassert (numChannels == destChannels);
+
+                AudioData::interleaveSamples (NonInterleavedSource<typename Source::FormatType> { reinterpret_cast<typename Source::ConstElementType* const*> (sourceChannelData), numChannels },
+                                              InterleavedDest<typename Dest::FormatType>        { static_cast<typename Dest::ElementType*> (interleavedDest), numChannels },
+                                              numSamples);
+            }
+            else
+            {
+                Converter::interleaveSamples (interleavedDest, sourceChannelData, numChannels, numSamples);
+            }
+        }
+
     private:
         JUCE_DECLARE_NON_COPYABLE (ConverterInstance)
 
@@ -657,12 +727,69 @@ public:
     };
 
 private:
+    template <typename>
+    struct PointerTraits;
+
+    template <typename DataFormat, typename Endianness, typename InterleavingType, typename Constness>
+    struct PointerTraits<Pointer<DataFormat, Endianness, InterleavingType, Constness>>
+    {
+        using FormatType       = Format<DataFormat, Endianness>;
+        using ElementType      = std::remove_pointer_t<decltype (DataFormat::data)>;
+        using ConstElementType = const ElementType;
+
+        static constexpr bool isInterleaved = InterleavingType::isInterleavedType != 0;
+        static constexpr bool isConst       = Constness::isConst != 0;
+    };
+
+    /*  Single-pass conversions between planar native-endian floats and the interleaved
+        little-endian formats that audio devices commonly use. These are implemented with
+        SIMD instructions in juce_AudioDataConverters.cpp, and return false if the channel
+        layout isn't one they can handle, in which case the generic code is used instead.
+    */
+    struct FastConversion
+    {
+        template <typename DataFormat, typename Endianness>
+        static constexpr bool isSupportedInterleavedFormat()
+        {
+           #if JUCE_LITTLE_ENDIAN
+            return (std::is_same_v<Endianness, LittleEndian> || std::is_same_v<Endianness, NativeEndian>)
+                && (std::is_same_v<DataFormat, Int16> || std::is_same_v<DataFormat, Int24>
+                     || std::is_same_v<DataFormat, Int32> || std::is_same_v<DataFormat, Float32>);
+           #else
+            return false;
+           #endif
+        }
+
+        template <typename DataFormat, typename Endianness>
+        static constexpr bool isPlanarFloat()
+        {
+            return std::is_same_v<DataFormat, Float32> && std::is_same_v<Endianness, NativeEndian>;
+        }
+
+        template <typename InterleavedSubtypes, typename PlanarSubtypes>
+        static constexpr bool canConvert()
+        {
+            return isSupportedInterleavedFormat<typename InterleavedSubtypes::SampleFormat, typename InterleavedSubtypes::SampleEndianness>()
+                && isPlanarFloat<typename PlanarSubtypes::SampleFormat, typename PlanarSubtypes::SampleEndianness>();
+        }
+
+        template <typename DataFormat>
+        static bool deinterleave (const void* source, int numSourceChannels,
+                                  float* const* dest, int numDestChannels, int numSamples) noexcept;
+
+        template <typename DataFormat>
+        static bool interleave (const float* const* source, int numSourceChannels,
+                                void* dest, int numDestChannels, int numSamples) noexcept;
+    };
+
     template <bool IsInterleaved, bool IsConst, typename...>
     struct ChannelDataSubtypes;
 
     template <bool IsInterleaved, bool IsConst, typename DataFormat, typename Endianness>
     struct ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>
     {
+        using SampleFormat = DataFormat;
+        using SampleEndianness = Endianness;
         using ElementType = std::remove_pointer_t<decltype (DataFormat::data)>;
         using ChannelType = std::conditional_t<IsConst, const ElementType*, ElementType*>;
         using DataType = std::conditional_t<IsInterleaved, ChannelType, ChannelType const*>;
@@ -675,9 +802,11 @@ private:
     template <bool IsInterleaved, bool IsConst, typename DataFormat, typename Endianness>
     struct ChannelDataSubtypes<IsInterleaved, IsConst, Format<DataFormat, Endianness>>
     {
-        using Subtypes    = ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>;
-        using DataType    = typename Subtypes::DataType;
-        using PointerType = typename Subtypes::PointerType;
+        using Subtypes         = ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>;
+        using SampleFormat     = DataFormat;
+        using SampleEndianness = Endianness;
+        using DataType         = typename Subtypes::DataType;
+        using PointerType      = typename Subtypes::PointerType;
     };
 
     template <bool IsInterleaved, bool IsConst, typename... Format>
@@ -727,6 +856,10 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (FastConversion::canConvert<typename decltype (dest)::Subtypes, typename decltype (source)::Subtypes>())
+            if (FastConversion::interleave<typename decltype (dest)::Subtypes::SampleFormat> (source.data, source.channels, dest.data, dest.channels, numSamples))
+                return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -771,6 +904,10 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (FastConversion::canConvert<typename decltype (source)::Subtypes, typename decltype (dest)::Subtypes>())
+            if (FastConversion::deinterleave<typename decltype (source)::Subtypes::SampleFormat> (source.data, source.channels, dest.data, dest.channels, numSamples))
+                return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
@@ -375,10 +375,8 @@ public:
 
         if (newNumSamples != size || newNumChannels != numChannels)
         {
-            auto allocatedSamplesPerChannel = ((size_t) newNumSamples + 3) & ~3u;
-            auto channelListSize = ((static_cast<size_t> (1 + newNumChannels) * sizeof (Type*)) + 15) & ~15u;
-            auto newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (Type))
-                                    + channelListSize + 32;
+            auto allocatedSamplesPerChannel = getChannelStride (newNumSamples);
+            auto newTotalBytes = getBytesNeeded (newNumChannels, newNumSamples);
 
             if (keepExistingContent)
             {
@@ -394,7 +392,7 @@ public:
                     auto numSamplesToCopy = (size_t) jmin (newNumSamples, size);
 
                     auto newChannels = unalignedPointerCast<Type**> (newData.get());
-                    auto newChan     = unalignedPointerCast<Type*> (newData + channelListSize);
+                    auto newChan     = getFirstChannel (newData, newNumChannels);
 
                     for (int j = 0; j < newNumChannels; ++j)
                     {
@@ -429,7 +427,7 @@ public:
                     channels = unalignedPointerCast<Type**> (allocatedData.get());
                 }
 
-                auto* chan = unalignedPointerCast<Type*> (allocatedData + channelListSize);
+                auto* chan = getFirstChannel (allocatedData, newNumChannels);
 
                 for (int i = 0; i < newNumChannels; ++i)
                 {
@@ -738,13 +736,7 @@ public:
                 jassert (startSample >= 0 && numSamples >= 0 && startSample + numSamples <= size);
 
                 const auto increment = (endGain - startGain) / (float) numSamples;
-                auto* d = channels[channel] + startSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ *= startGain;
-                    startGain += increment;
-                }
+                FloatVectorOperations::multiplyWithRamp (channels[channel] + startSample, startGain, (Type) increment, numSamples);
             }
         }
     }
@@ -912,14 +904,9 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                const auto increment = (endGain - startGain) / (Type) numSamples;
+                FloatVectorOperations::addWithMultiplyRamp (channels[destChannel] + destStartSample, source,
+                                                            startGain, increment, numSamples);
             }
         }
     }
@@ -1084,14 +1071,9 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ = startGain * *source++;
-                    startGain += increment;
-                }
+                const auto increment = (endGain - startGain) / (Type) numSamples;
+                FloatVectorOperations::copyWithMultiplyRamp (channels[destChannel] + destStartSample, source,
+                                                             startGain, increment, numSamples);
             }
         }
     }
@@ -1192,22 +1174,16 @@ private:
        #endif
         jassert (size >= 0);
 
-        auto channelListSize = (size_t) (numChannels + 1) * sizeof (Type*);
-        auto requiredSampleAlignment = std::alignment_of_v<Type>;
-        size_t alignmentOverflow = channelListSize % requiredSampleAlignment;
-
-        if (alignmentOverflow != 0)
-            channelListSize += requiredSampleAlignment - alignmentOverflow;
-
-        allocatedBytes = (size_t) numChannels * (size_t) size * sizeof (Type) + channelListSize + 32;
+        allocatedBytes = getBytesNeeded (numChannels, size);
         allocatedData.malloc (allocatedBytes);
         channels = unalignedPointerCast<Type**> (allocatedData.get());
-        auto chan = unalignedPointerCast<Type*> (allocatedData + channelListSize);
+        auto chan = getFirstChannel (allocatedData, numChannels);
+        auto stride = getChannelStride (size);
 
         for (int i = 0; i < numChannels; ++i)
         {
             channels[i] = chan;
-            chan += size;
+            chan += stride;
         }
 
         channels[numChannels] = nullptr;
@@ -1240,6 +1216,36 @@ private:
         isClear = false;
     }
 
+    /*  Each channel starts on its own cache line. When the distance between channels is a
+        multiple of 1K, the same sample index in every channel would map onto the same few
+        cache sets, so an extra cache line of padding is added to stagger them.
+    */
+    static constexpr size_t channelAlignment = 64;
+
+    static size_t getChannelStride (int numSamples) noexcept
+    {
+        auto bytes = ((size_t) numSamples * sizeof (Type) + channelAlignment - 1) & ~(channelAlignment - 1);
+
+        if (bytes % 1024 == 0 && bytes > 0)
+            bytes += channelAlignment;
+
+        return (bytes + sizeof (Type) - 1) / sizeof (Type);
+    }
+
+    static size_t getBytesNeeded (int numChans, int numSamples) noexcept
+    {
+        // the extra cache line leaves room to align the first channel, wherever the block starts
+        return (size_t) (numChans + 1) * sizeof (Type*)
+                 + (size_t) numChans * getChannelStride (numSamples) * sizeof (Type)
+                 + channelAlignment;
+    }
+
+    static Type* getFirstChannel (char* block, int numChans) noexcept
+    {
+        auto start = (pointer_sized_uint) (block + (size_t) (numChans + 1) * sizeof (Type*));
+        return reinterpret_cast<Type*> ((start + channelAlignment - 1) & ~(pointer_sized_uint) (channelAlignment - 1));
+    }
+
     /*  On iOS/arm7 the alignment of `double` is greater than the alignment of
         `std::max_align_t`, so we can't trust max_align_t. Instead, we query
         lots of primitive types and use the maximum alignment of all of them.
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  Generic FloatVectorOperations kernels for wide registers.
+
+    This file is included once for each instruction set that FloatVectorOperations
+    can dispatch to at runtime, from within a block that enables that instruction
+    set for the compiler. Before including it, the includer must declare the
+    FloatOps and DoubleOps structures that wrap the registers of the instruction set.
+*/
+
+template <typename Type> struct OpsFor;
+template <> struct OpsFor<float>  { using Ops = FloatOps; };
+template <> struct OpsFor<double> { using Ops = DoubleOps; };
+
+#define JUCE_WIDE_KERNEL_LOOP(vectorOp, scalarOp) \
+    using Ops = typename OpsFor<Type>::Ops; \
+    Size i = 0; \
+    for (; i + (Size) Ops::width <= num; i += (Size) Ops::width) { vectorOp; } \
+    for (; i < num; ++i) { scalarOp; }
+
+template <typename Type, typename Size>
+void add (Type* dest, Type amount, Size num) noexcept
+{
+    const auto am = OpsFor<Type>::Ops::set1 (amount);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (Ops::load (dest + i), am)),
+                           dest[i] += amount)
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src, Type amount, Size num) noexcept
+{
+    const auto am = OpsFor<Type>::Ops::set1 (amount);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (am, Ops::load (src + i))),
+                           dest[i] = src[i] + amount)
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src, Size num) noexcept
+{
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (Ops::load (dest + i), Ops::load (src + i))),
+                           dest[i] += src[i])
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (Ops::load (src1 + i), Ops::load (src2 + i))),
+                           dest[i] = src1[i] + src2[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src, Size num) noexcept
+{
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::mul (Ops::load (dest + i), Ops::load (src + i))),
+                           dest[i] *= src[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::mul (Ops::load (src1 + i), Ops::load (src2 + i))),
+                           dest[i] = src1[i] * src2[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, Type multiplier, Size num) noexcept
+{
+    const auto mult = OpsFor<Type>::Ops::set1 (multiplier);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::mul (Ops::load (dest + i), mult)),
+                           dest[i] *= multiplier)
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    const auto mult = OpsFor<Type>::Ops::set1 (multiplier);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::mul (mult, Ops::load (src + i))),
+                           dest[i] = src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+void copyWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    multiply (dest, src, multiplier, num);
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    const auto mult = OpsFor<Type>::Ops::set1 (multiplier);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (Ops::load (dest + i), Ops::mul (mult, Ops::load (src + i)))),
+                           dest[i] += src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::add (Ops::load (dest + i), Ops::mul (Ops::load (src1 + i), Ops::load (src2 + i)))),
+                           dest[i] += src1[i] * src2[i])
+}
+
+template <typename Type, typename Size>
+void clip (Type* dest, const Type* src, Type low, Type high, Size num) noexcept
+{
+    const auto lo = OpsFor<Type>::Ops::set1 (low);
+    const auto hi = OpsFor<Type>::Ops::set1 (high);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::max (Ops::min (Ops::load (src + i), hi), lo)),
+                           dest[i] = jmax (jmin (src[i], high), low))
+}
+
+template <typename Type, typename Size>
+Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+
+    if (num < (Size) (2 * Ops::width))
+        return Range<Type>::findMinAndMax (src, num);
+
+    auto mn = Ops::load (src);
+    auto mx = mn;
+    Size i = (Size) Ops::width;
+
+    for (; i + (Size) Ops::width <= num; i += (Size) Ops::width)
+    {
+        const auto v = Ops::load (src + i);
+        mn = Ops::min (mn, v);
+        mx = Ops::max (mx, v);
+    }
+
+    Range<Type> result (Ops::min (mn), Ops::max (mx));
+
+    for (; i < num; ++i)
+        result = result.getUnionWith (src[i]);
+
+    return result;
+}
+
+template <typename Size>
+void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
+{
+    using Type = float;
+    const auto mult = OpsFor<Type>::Ops::set1 (multiplier);
+    JUCE_WIDE_KERNEL_LOOP (Ops::store (dest + i, Ops::mul (mult, Ops::loadInt (src + i))),
+                           dest[i] = (float) src[i] * multiplier)
+}
+
+#undef JUCE_WIDE_KERNEL_LOOP
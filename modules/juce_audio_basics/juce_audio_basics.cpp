@@ -49,20 +49,47 @@
  #undef JUCE_USE_VDSP_FRAMEWORK
 #endif
 
+// Lets FloatVectorOperations use AVX2/AVX-512 kernels when the CPU supports them,
+// even if the rest of the code is built for baseline SSE2
+#if JUCE_USE_SSE_INTRINSICS && ! JUCE_USE_VDSP_FRAMEWORK && ! defined (JUCE_FLOAT_VECTOR_RUNTIME_DISPATCH) \
+     && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5))
+ #define JUCE_FLOAT_VECTOR_RUNTIME_DISPATCH 1
+#endif
+
+#if JUCE_FLOAT_VECTOR_RUNTIME_DISPATCH
+ #include <immintrin.h>
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
 #if JUCE_USE_ARM_NEON
  #include <arm_neon.h>
 #endif
 
+#if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+ #include <os/workgroup.h>
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
 #include "buffers/juce_AudioProcessLoadMeasurer.cpp"
+#include "buffers/juce_AudioBufferPool.cpp"
 #include "utilities/juce_IIRFilter.cpp"
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
+#include "utilities/juce_LoudnessAccumulator.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_AudioWorkgroup.cpp"
 #include "midi/juce_MidiBuffer.cpp"
+#include "midi/juce_MidiEventFifo.cpp"
+#include "midi/juce_MidiEventStore.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
@@ -78,6 +105,7 @@
 #include "mpe/juce_MPESynthesiser.cpp"
 #include "mpe/juce_MPEUtils.cpp"
 #include "sources/juce_BufferingAudioSource.cpp"
+#include "sources/juce_AudioStreamingEngine.cpp"
 #include "sources/juce_ChannelRemappingAudioSource.cpp"
 #include "sources/juce_IIRFilterAudioSource.cpp"
 #include "sources/juce_MemoryAudioSource.cpp"
@@ -89,12 +117,12 @@
 #include "synthesisers/juce_Synthesiser.cpp"
 #include "audio_play_head/juce_AudioPlayHead.cpp"
 
-#include "midi/ump/juce_UMP.h"
 #include "midi/ump/juce_UMPUtils.cpp"
 #include "midi/ump/juce_UMPView.cpp"
 #include "midi/ump/juce_UMPSysEx7.cpp"
 #include "midi/ump/juce_UMPMidi1ToMidi2DefaultTranslator.cpp"
 #include "midi/ump/juce_UMPIterator.cpp"
+#include "midi/ump/juce_UMPEventBuffer.cpp"
 
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
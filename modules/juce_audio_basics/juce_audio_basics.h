@@ -70,7 +70,13 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
-#if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
+#if (JUCE_MAC && defined (MAC_OS_VERSION_11_0)) || (JUCE_IOS && defined (__IPHONE_14_0))
+ #define JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE 1
+#else
+ #define JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE 0
+#endif
+
+#if (__ARM_NEON__ || __ARM_NEON) && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
 
@@ -87,21 +93,29 @@ JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4661)
 #include "buffers/juce_FloatVectorOperations.h"
 JUCE_END_IGNORE_WARNINGS_MSVC
 #include "buffers/juce_AudioSampleBuffer.h"
+#include "buffers/juce_AudioBufferPool.h"
 #include "buffers/juce_AudioChannelSet.h"
 #include "buffers/juce_AudioProcessLoadMeasurer.h"
 #include "utilities/juce_Decibels.h"
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
+#include "utilities/juce_LoudnessAccumulator.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_AudioWorkgroup.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
+#include "midi/juce_MidiEventFifo.h"
 #include "midi/juce_MidiMessageSequence.h"
+#include "midi/juce_MidiEventStore.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
+#include "midi/ump/juce_UMP.h"
+#include "synthesisers/juce_VoiceIndex.h"
 #include "mpe/juce_MPEValue.h"
 #include "mpe/juce_MPENote.h"
 #include "mpe/juce_MPEZoneLayout.h"
@@ -114,6 +128,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "sources/juce_AudioSource.h"
 #include "sources/juce_PositionableAudioSource.h"
 #include "sources/juce_BufferingAudioSource.h"
+#include "sources/juce_AudioStreamingEngine.h"
 #include "sources/juce_ChannelRemappingAudioSource.h"
 #include "sources/juce_IIRFilterAudioSource.h"
 #include "sources/juce_MemoryAudioSource.h"
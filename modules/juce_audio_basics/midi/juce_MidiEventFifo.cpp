@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Each event is stored as a 32-bit timestamp, a 16-bit size and then the MIDI bytes,
+// just like in a MidiBuffer, except that an event may wrap around the end of the ring.
+static constexpr int midiEventFifoHeaderSize = (int) (sizeof (int32) + sizeof (uint16));
+
+MidiEventFifo::MidiEventFifo (int capacityInBytes)
+    : fifo (capacityInBytes + 1),
+      storage ((size_t) capacityInBytes + 1),
+      scratch ((size_t) jmax (capacityInBytes, midiEventFifoHeaderSize))
+{
+}
+
+bool MidiEventFifo::push (const MidiMessage& message, int samplePosition) noexcept
+{
+    return push (message.getRawData(), message.getRawDataSize(), samplePosition);
+}
+
+bool MidiEventFifo::push (const void* rawMidiData, int numBytes, int samplePosition) noexcept
+{
+    if (numBytes <= 0)
+        return true;
+
+    if (std::numeric_limits<uint16>::max() < numBytes
+         || fifo.getFreeSpace() < numBytes + midiEventFifoHeaderSize)
+        return false;
+
+    uint8 header[midiEventFifoHeaderSize];
+    writeUnaligned<int32>  (header, samplePosition);
+    writeUnaligned<uint16> (header + sizeof (int32), static_cast<uint16> (numBytes));
+
+    int offset = 0;
+
+    const auto copyIn = [&] (int start, int size)
+    {
+        for (auto i = 0; i < size; ++i, ++offset)
+            storage[start + i] = offset < midiEventFifoHeaderSize
+                               ? header[offset]
+                               : static_cast<const uint8*> (rawMidiData)[offset - midiEventFifoHeaderSize];
+    };
+
+    const auto scope = fifo.write (numBytes + midiEventFifoHeaderSize);
+    copyIn (scope.startIndex1, scope.blockSize1);
+    copyIn (scope.startIndex2, scope.blockSize2);
+    return true;
+}
+
+int MidiEventFifo::push (const MidiBuffer& events) noexcept
+{
+    int numDropped = 0;
+
+    for (const auto metadata : events)
+        if (! push (metadata.data, metadata.numBytes, metadata.samplePosition))
+            ++numDropped;
+
+    return numDropped;
+}
+
+void MidiEventFifo::read (uint8* dest, int startIndex, int numBytes) const noexcept
+{
+    const auto totalSize = fifo.getTotalSize();
+    const auto numBeforeWrap = jmin (numBytes, totalSize - startIndex);
+
+    memcpy (dest, storage + startIndex, (size_t) numBeforeWrap);
+    memcpy (dest + numBeforeWrap, storage.get(), (size_t) (numBytes - numBeforeWrap));
+}
+
+template <typename Callback>
+int MidiEventFifo::popEvents (Callback&& callback) noexcept
+{
+    const auto numReady = fifo.getNumReady();
+    const auto totalSize = fifo.getTotalSize();
+    const auto scope = fifo.read (numReady);
+
+    int numEvents = 0;
+
+    for (int offset = 0; offset < numReady; ++numEvents)
+    {
+        const auto index = (scope.startIndex1 + offset) % totalSize;
+
+        uint8 header[midiEventFifoHeaderSize];
+        read (header, index, midiEventFifoHeaderSize);
+
+        const auto samplePosition = readUnaligned<int32>  (header);
+        const auto numBytes = (int) readUnaligned<uint16> (header + sizeof (int32));
+        const auto dataIndex = (index + midiEventFifoHeaderSize) % totalSize;
+
+        if (dataIndex + numBytes <= totalSize)
+        {
+            callback (storage + dataIndex, numBytes, samplePosition);
+        }
+        else
+        {
+            read (scratch, dataIndex, numBytes);
+            callback (scratch.get(), numBytes, samplePosition);
+        }
+
+        offset += midiEventFifoHeaderSize + numBytes;
+    }
+
+    return numEvents;
+}
+
+int MidiEventFifo::pop (MidiBuffer& destination, int sampleDeltaToAdd)
+{
+    return popEvents ([&] (const uint8* data, int numBytes, int samplePosition)
+    {
+        destination.addEvent (data, numBytes, samplePosition + sampleDeltaToAdd);
+    });
+}
+
+int MidiEventFifo::pop (FixedCapacityMidiBuffer& destination, int sampleDeltaToAdd) noexcept
+{
+    return popEvents ([&] (const uint8* data, int numBytes, int samplePosition)
+    {
+        destination.addEvent (data, numBytes, samplePosition + sampleDeltaToAdd);
+    });
+}
+
+void MidiEventFifo::clear() noexcept
+{
+    fifo.finishedRead (fifo.getNumReady());
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiEventFifoTest  : public UnitTest
+{
+    MidiEventFifoTest()
+        : UnitTest ("MidiEventFifo", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("FixedCapacityMidiBuffer keeps events sorted and drops events that don't fit");
+        {
+            const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+            FixedCapacityMidiBuffer buffer (4 * 9);
+
+            expect (buffer.addEvent (message, 20));
+            expect (buffer.addEvent (message, 0));
+            expect (buffer.addEvent (message, 10));
+            expect (buffer.addEvent (message, 30));
+            expect (! buffer.addEvent (message, 40));
+
+            expectEquals (buffer.getNumEvents(), 4);
+            expectEquals (buffer.getNumDroppedEvents(), 1);
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 30);
+
+            int lastTime = -1;
+
+            for (const auto metadata : buffer)
+            {
+                expect (metadata.samplePosition > lastTime);
+                expect (metadata.getMessage().isNoteOn());
+                lastTime = metadata.samplePosition;
+            }
+
+            buffer.clear (10, 5);
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getNumBytesUsed(), (size_t) 27);
+            expectEquals ((*buffer.findNextSamplePosition (5)).samplePosition, 20);
+
+            MidiBuffer copy;
+            buffer.copyTo (copy);
+            expectEquals (copy.getNumEvents(), 3);
+            expectEquals (copy.getLastEventTime(), 30);
+        }
+
+        beginTest ("Events survive wrapping around the end of the FIFO");
+        {
+            MidiEventFifo fifo (100);
+            FixedCapacityMidiBuffer buffer (1000);
+            const uint8 sysex[] = { 0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0xf7 };
+
+            for (int round = 0; round < 20; ++round)
+            {
+                expect (fifo.push (MidiMessage::controllerEvent (1, 74, round), round));
+                expect (fifo.push (sysex, (int) sizeof (sysex), round + 1));
+
+                buffer.clear();
+                expectEquals (fifo.pop (buffer, 100), 2);
+                expectEquals (fifo.getNumBytesReady(), 0);
+
+                auto it = buffer.begin();
+                const auto controller = (*it++).getMessage();
+                expect (controller.isController() && controller.getControllerValue() == round);
+                expectEquals (controller.getTimeStamp(), (double) (round + 100));
+
+                const auto metadata = *it;
+                expectEquals (metadata.numBytes, (int) sizeof (sysex));
+                expect (std::equal (sysex, sysex + sizeof (sysex), metadata.data));
+            }
+        }
+
+        beginTest ("Pushing to a full FIFO drops events");
+        {
+            MidiEventFifo fifo (18);
+            const auto message = MidiMessage::noteOff (1, 64);
+
+            expect (fifo.push (message, 0));
+            expect (fifo.push (message, 1));
+            expect (! fifo.push (message, 2));
+
+            MidiBuffer buffer;
+            expectEquals (fifo.pop (buffer), 2);
+            expectEquals (buffer.getNumEvents(), 2);
+        }
+
+        beginTest ("Events can be handed between threads");
+        {
+            MidiEventFifo fifo (256);
+            constexpr int numEvents = 10000;
+
+            std::thread producer ([&]
+            {
+                for (int i = 0; i < numEvents;)
+                {
+                    if (fifo.push (MidiMessage::controllerEvent (1, 1, i % 128), i))
+                        ++i;
+                    else
+                        std::this_thread::yield();
+                }
+            });
+
+            FixedCapacityMidiBuffer buffer (1024);
+            int numReceived = 0;
+            bool inOrder = true;
+
+            while (numReceived < numEvents)
+            {
+                buffer.clear();
+                fifo.pop (buffer);
+
+                for (const auto metadata : buffer)
+                {
+                    inOrder = inOrder && metadata.samplePosition == numReceived
+                                      && metadata.data[2] == (uint8) (numReceived % 128);
+                    ++numReceived;
+                }
+            }
+
+            producer.join();
+            expect (inOrder);
+            expectEquals (numReceived, numEvents);
+        }
+    }
+};
+
+static MidiEventFifoTest midiEventFifoTest;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A wait-free single-producer, single-consumer queue of timestamped MIDI events.
+
+    All the storage is allocated in the constructor, so neither pushing nor
+    popping will ever allocate or lock. This makes it suitable for handing MIDI
+    from a UI or network thread to the audio thread, or back again.
+
+    Only one thread may call push() and only one (other) thread may call pop()
+    at any one time.
+
+    @code
+    // On the message thread
+    fifo.push (MidiMessage::controllerEvent (1, 74, value), 0);
+
+    // In processBlock
+    fifo.pop (incomingMidi);
+    @endcode
+
+    @see FixedCapacityMidiBuffer, MidiMessageCollector
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiEventFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO which can hold up to the given number of bytes.
+
+        Each event uses six bytes of storage in addition to its MIDI data.
+    */
+    explicit MidiEventFifo (int capacityInBytes);
+
+    //==============================================================================
+    /** Adds an event to the FIFO. This must only be called from the producer thread.
+
+        @returns false if there wasn't enough space for the event, in which case it
+                 will have been dropped
+    */
+    bool push (const MidiMessage& message, int samplePosition) noexcept;
+
+    /** Adds an event from raw MIDI data to the FIFO. This must only be called from
+        the producer thread.
+
+        @returns false if there wasn't enough space for the event, in which case it
+                 will have been dropped
+    */
+    bool push (const void* rawMidiData, int numBytes, int samplePosition) noexcept;
+
+    /** Adds all the events in a MidiBuffer to the FIFO. This must only be called
+        from the producer thread.
+
+        @returns the number of events that didn't fit and were dropped
+    */
+    int push (const MidiBuffer& events) noexcept;
+
+    //==============================================================================
+    /** Moves all the pending events into a MidiBuffer. This must only be called from
+        the consumer thread.
+
+        The MidiBuffer may need to allocate if it doesn't already have enough storage
+        reserved with MidiBuffer::ensureSize().
+
+        @returns the number of events that were removed from the FIFO
+    */
+    int pop (MidiBuffer& destination, int sampleDeltaToAdd = 0);
+
+    /** Moves all the pending events into a FixedCapacityMidiBuffer. This must only be
+        called from the consumer thread.
+
+        Events that don't fit into the destination will be dropped.
+
+        @returns the number of events that were removed from the FIFO
+    */
+    int pop (FixedCapacityMidiBuffer& destination, int sampleDeltaToAdd = 0) noexcept;
+
+    /** Discards any pending events. This must only be called from the consumer thread. */
+    void clear() noexcept;
+
+    //==============================================================================
+    /** Returns the number of bytes waiting to be popped. */
+    int getNumBytesReady() const noexcept           { return fifo.getNumReady(); }
+
+    /** Returns the number of bytes which could be pushed before the FIFO is full. */
+    int getFreeSpace() const noexcept               { return fifo.getFreeSpace(); }
+
+private:
+    //==============================================================================
+    template <typename Callback>
+    int popEvents (Callback&&) noexcept;
+
+    void read (uint8* dest, int startIndex, int numBytes) const noexcept;
+
+    AbstractFifo fifo;
+    HeapBlock<uint8> storage, scratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiEventFifo)
+};
+
+} // namespace juce
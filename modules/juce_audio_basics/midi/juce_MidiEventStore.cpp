@@ -0,0 +1,682 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace MidiEventStoreHelpers
+{
+    static bool isNoteOn (const uint8* data, uint32 size) noexcept
+    {
+        return size >= 3 && (data[0] & 0xf0) == 0x90 && data[2] != 0;
+    }
+
+    static bool isNoteOff (const uint8* data, uint32 size) noexcept
+    {
+        return size >= 3 && ((data[0] & 0xf0) == 0x80 || ((data[0] & 0xf0) == 0x90 && data[2] == 0));
+    }
+
+    static size_t getChannelAndNote (const uint8* data) noexcept
+    {
+        return (size_t) ((data[0] & 0x0f) * 128 + (data[1] & 0x7f));
+    }
+
+    template <typename ElementType>
+    static void applyPermutation (Array<ElementType>& column, const Array<int>& order)
+    {
+        Array<ElementType> result;
+        result.ensureStorageAllocated (order.size());
+
+        for (auto index : order)
+            result.add (column.getUnchecked (index));
+
+        column.swapWith (result);
+    }
+}
+
+//==============================================================================
+MidiEventStore::MidiEventStore (const MidiMessageSequence& sequence)
+{
+    const auto numEvents = sequence.getNumEvents();
+    int numBytes = 0;
+
+    for (auto* holder : sequence)
+        numBytes += holder->message.getRawDataSize();
+
+    ensureStorageAllocated (numEvents, numBytes);
+
+    FlatHashMap<const void*, int> indices;
+    indices.reserve (numEvents);
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        auto* holder = sequence.getEventPointer (i);
+        appendEvent (holder->message.getRawData(), holder->message.getRawDataSize(), holder->message.getTimeStamp());
+        indices.set (holder, i);
+    }
+
+    for (int i = 0; i < numEvents; ++i)
+        if (auto* noteOff = sequence.getEventPointer (i)->noteOffObject)
+            if (auto* noteOffIndex = indices.find (noteOff))
+                noteOffIndices.set (i, *noteOffIndex);
+}
+
+void MidiEventStore::clear() noexcept
+{
+    timeStamps.clear();
+    dataOffsets.clear();
+    dataSizes.clear();
+    noteOffIndices.clear();
+    midiData.clear();
+}
+
+void MidiEventStore::ensureStorageAllocated (int numEvents, int numBytesOfMidiData)
+{
+    timeStamps.ensureStorageAllocated (numEvents);
+    dataOffsets.ensureStorageAllocated (numEvents);
+    dataSizes.ensureStorageAllocated (numEvents);
+    noteOffIndices.ensureStorageAllocated (numEvents);
+    midiData.ensureStorageAllocated (numBytesOfMidiData);
+}
+
+void MidiEventStore::swapWith (MidiEventStore& other) noexcept
+{
+    timeStamps.swapWith (other.timeStamps);
+    dataOffsets.swapWith (other.dataOffsets);
+    dataSizes.swapWith (other.dataSizes);
+    noteOffIndices.swapWith (other.noteOffIndices);
+    midiData.swapWith (other.midiData);
+}
+
+MidiMessage MidiEventStore::getMessage (int index) const
+{
+    if (! isPositiveAndBelow (index, getNumEvents()))
+        return {};
+
+    return MidiMessage (getRawData (index), getRawDataSize (index), timeStamps.getUnchecked (index));
+}
+
+int MidiEventStore::getNextIndexAtTime (double timeStamp) const noexcept
+{
+    return (int) (std::lower_bound (timeStamps.begin(), timeStamps.end(), timeStamp) - timeStamps.begin());
+}
+
+double MidiEventStore::getTimeOfMatchingKeyUp (int index) const noexcept
+{
+    auto noteOffIndex = getIndexOfMatchingKeyUp (index);
+    return noteOffIndex >= 0 ? timeStamps.getUnchecked (noteOffIndex) : 0.0;
+}
+
+//==============================================================================
+void MidiEventStore::appendEvent (const uint8* data, int numBytes, double timeStamp)
+{
+    jassert (numBytes > 0);
+
+    timeStamps.add (timeStamp);
+    dataOffsets.add ((uint32) midiData.size());
+    dataSizes.add ((uint32) numBytes);
+    noteOffIndices.add (-1);
+    midiData.addArray (data, numBytes);
+}
+
+void MidiEventStore::appendEvent (uint8 firstByte, const uint8* otherBytes, int numOtherBytes, double timeStamp)
+{
+    jassert (numOtherBytes >= 0);
+
+    timeStamps.add (timeStamp);
+    dataOffsets.add ((uint32) midiData.size());
+    dataSizes.add ((uint32) numOtherBytes + 1);
+    noteOffIndices.add (-1);
+    midiData.add (firstByte);
+    midiData.addArray (otherBytes, numOtherBytes);
+}
+
+void MidiEventStore::addEvent (const MidiMessage& message, double timeAdjustment)
+{
+    addEvent (message.getRawData(), message.getRawDataSize(), message.getTimeStamp() + timeAdjustment);
+}
+
+void MidiEventStore::addEvent (const uint8* rawMidiData, int numBytes, double timeStamp)
+{
+    const auto index = (int) (std::upper_bound (timeStamps.begin(), timeStamps.end(), timeStamp) - timeStamps.begin());
+    const auto numEvents = getNumEvents();
+
+    appendEvent (rawMidiData, numBytes, timeStamp);
+
+    if (index == numEvents)
+        return;
+
+    // Move the new event from the end into its place, and update any indices that have moved
+    const auto rotateLastInto = [index] (auto& column)
+    {
+        std::rotate (column.begin() + index, column.end() - 1, column.end());
+    };
+
+    rotateLastInto (timeStamps);
+    rotateLastInto (dataOffsets);
+    rotateLastInto (dataSizes);
+    rotateLastInto (noteOffIndices);
+
+    for (auto& noteOffIndex : noteOffIndices)
+        if (noteOffIndex >= index)
+            ++noteOffIndex;
+}
+
+void MidiEventStore::deleteEvent (int index, bool deleteMatchingNoteUp)
+{
+    if (! isPositiveAndBelow (index, getNumEvents()))
+        return;
+
+    if (deleteMatchingNoteUp)
+    {
+        const auto noteOffIndex = noteOffIndices.getUnchecked (index);
+
+        if (noteOffIndex >= 0)
+        {
+            deleteEvent (noteOffIndex, false);
+
+            if (noteOffIndex < index)
+                --index;
+        }
+    }
+
+    const auto offset = dataOffsets.getUnchecked (index);
+    const auto size = dataSizes.getUnchecked (index);
+
+    timeStamps.remove (index);
+    dataOffsets.remove (index);
+    dataSizes.remove (index);
+    noteOffIndices.remove (index);
+    midiData.removeRange ((int) offset, (int) size);
+
+    for (auto& o : dataOffsets)
+        if (o > offset)
+            o -= size;
+
+    for (auto& noteOffIndex : noteOffIndices)
+    {
+        if (noteOffIndex == index)
+            noteOffIndex = -1;
+        else if (noteOffIndex > index)
+            --noteOffIndex;
+    }
+}
+
+void MidiEventStore::addTimeToMessages (double deltaTime) noexcept
+{
+    if (deltaTime != 0)
+        for (auto& t : timeStamps)
+            t += deltaTime;
+}
+
+//==============================================================================
+void MidiEventStore::updateMatchedPairs()
+{
+    using namespace MidiEventStoreHelpers;
+
+    const auto numEvents = getNumEvents();
+
+    // For each channel and note, the index of the note-on that's still waiting for its note-off
+    std::array<int, 16 * 128> pendingNoteOns;
+    pendingNoteOns.fill (-1);
+
+    // The note-ons that end an earlier note, which need a note-off adding before them.
+    // Until those are added, the earlier note's note-off index refers to this list.
+    Array<int> notesToEnd;
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const auto* data = getRawData (i);
+        const auto size = dataSizes.getUnchecked (i);
+        noteOffIndices.set (i, -1);
+
+        if (isNoteOn (data, size))
+        {
+            auto& pending = pendingNoteOns[getChannelAndNote (data)];
+
+            if (pending >= 0)
+            {
+                noteOffIndices.set (pending, -2 - notesToEnd.size());
+                notesToEnd.add (i);
+            }
+
+            pending = i;
+        }
+        else if (isNoteOff (data, size))
+        {
+            auto& pending = pendingNoteOns[getChannelAndNote (data)];
+
+            if (pending >= 0)
+            {
+                noteOffIndices.set (pending, i);
+                pending = -1;
+            }
+        }
+    }
+
+    if (notesToEnd.isEmpty())
+        return;
+
+    MidiEventStore result;
+    result.ensureStorageAllocated (numEvents + notesToEnd.size(), midiData.size() + 3 * notesToEnd.size());
+
+    Array<int> newIndices;
+    newIndices.ensureStorageAllocated (numEvents);
+
+    for (int i = 0, nextNoteToEnd = 0; i < numEvents; ++i)
+    {
+        const auto* data = getRawData (i);
+
+        if (nextNoteToEnd < notesToEnd.size() && notesToEnd.getUnchecked (nextNoteToEnd) == i)
+        {
+            const uint8 noteOff[] = { (uint8) (0x80 | (data[0] & 0x0f)), data[1], 0 };
+            result.appendEvent (noteOff, 3, timeStamps.getUnchecked (i));
+            ++nextNoteToEnd;
+        }
+
+        newIndices.add (result.getNumEvents());
+        result.appendEvent (data, getRawDataSize (i), timeStamps.getUnchecked (i));
+    }
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const auto noteOffIndex = noteOffIndices.getUnchecked (i);
+
+        if (noteOffIndex >= 0)
+        {
+            result.noteOffIndices.set (newIndices.getUnchecked (i), newIndices.getUnchecked (noteOffIndex));
+        }
+        else if (noteOffIndex <= -2)
+        {
+            // the added note-off goes just before the note-on that ended this note
+            const auto noteToEnd = -2 - noteOffIndex;
+            result.noteOffIndices.set (newIndices.getUnchecked (i), newIndices.getUnchecked (notesToEnd.getUnchecked (noteToEnd)) - 1);
+        }
+    }
+
+    swapWith (result);
+}
+
+void MidiEventStore::sortNoteOffsBeforeOtherEventsAtSameTime()
+{
+    using namespace MidiEventStoreHelpers;
+
+    const auto numEvents = getNumEvents();
+
+    // The events are usually in the right order already, in which case there's nothing to move
+    bool needsSorting = false;
+
+    for (int i = 1, runStart = 0; i < numEvents && ! needsSorting; ++i)
+    {
+        if (timeStamps.getUnchecked (i) != timeStamps.getUnchecked (runStart))
+        {
+            runStart = i;
+            continue;
+        }
+
+        if (isNoteOff (getRawData (i), dataSizes.getUnchecked (i)))
+            for (int j = runStart; j < i && ! needsSorting; ++j)
+                needsSorting = isNoteOn (getRawData (j), dataSizes.getUnchecked (j));
+    }
+
+    if (! needsSorting)
+        return;
+
+    Array<int> order;
+    order.ensureStorageAllocated (numEvents);
+
+    for (int i = 0; i < numEvents; ++i)
+        order.add (i);
+
+    // This matches the ordering that MidiFile uses for a MidiMessageSequence
+    std::stable_sort (order.begin(), order.end(), [this] (int a, int b)
+    {
+        auto t1 = timeStamps.getUnchecked (a);
+        auto t2 = timeStamps.getUnchecked (b);
+
+        if (t1 < t2)  return true;
+        if (t2 < t1)  return false;
+
+        return isNoteOff (getRawData (a), dataSizes.getUnchecked (a))
+                && isNoteOn (getRawData (b), dataSizes.getUnchecked (b));
+    });
+
+    applyPermutation (timeStamps, order);
+    applyPermutation (dataOffsets, order);
+    applyPermutation (dataSizes, order);
+
+    noteOffIndices.fill (-1);
+}
+
+MidiMessageSequence MidiEventStore::toMidiMessageSequence() const
+{
+    MidiMessageSequence result;
+    const auto numEvents = getNumEvents();
+
+    for (int i = 0; i < numEvents; ++i)
+        result.addEvent (getMessage (i));
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const auto noteOffIndex = noteOffIndices.getUnchecked (i);
+
+        if (noteOffIndex >= 0)
+            result.getEventPointer (i)->noteOffObject = result.getEventPointer (noteOffIndex);
+    }
+
+    return result;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiEventStoreTests  : public UnitTest
+{
+public:
+    MidiEventStoreTests()
+        : UnitTest ("MidiEventStore", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Adding events and seeking");
+        {
+            MidiEventStore store;
+            store.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+            store.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+            store.addEvent (MidiMessage::noteOn  (1, 30, 0.5f).withTimeStamp (2.0));
+            store.addEvent (MidiMessage::noteOff (1, 30, 0.5f).withTimeStamp (8.0));
+            store.updateMatchedPairs();
+
+            expectEquals (store.getNumEvents(), 4);
+            expectEquals (store.getStartTime(), 0.0);
+            expectEquals (store.getEndTime(), 8.0);
+            expectEquals (store.getEventTime (1), 2.0);
+            expectEquals (store.getIndexOfMatchingKeyUp (0), 2);
+            expectEquals (store.getIndexOfMatchingKeyUp (1), 3);
+            expectEquals (store.getTimeOfMatchingKeyUp (1), 8.0);
+            expect (store.getMessage (1).isNoteOn());
+            expectEquals (store.getMessage (1).getNoteNumber(), 30);
+
+            expectEquals (store.getNextIndexAtTime (0.5), 1);
+            expectEquals (store.getNextIndexAtTime (2.0), 1);
+            expectEquals (store.getNextIndexAtTime (2.5), 2);
+            expectEquals (store.getNextIndexAtTime (9.0), 4);
+
+            store.addEvent (MidiMessage::controllerEvent (1, 7, 100).withTimeStamp (1.0));
+            expectEquals (store.getIndexOfMatchingKeyUp (0), 3);
+            expectEquals (store.getIndexOfMatchingKeyUp (2), 4);
+
+            store.deleteEvent (0, true);
+            expectEquals (store.getNumEvents(), 3);
+            expect (store.getMessage (0).isController());
+            expectEquals (store.getIndexOfMatchingKeyUp (1), 2);
+            expectEquals (store.getMessage (2).getNoteNumber(), 30);
+        }
+
+        beginTest ("Matched pairs are the same as MidiMessageSequence's");
+        {
+            auto r = getRandom();
+
+            for (int iteration = 0; iteration < 20; ++iteration)
+            {
+                MidiMessageSequence sequence;
+
+                for (int i = 0; i < 500; ++i)
+                {
+                    const auto channel = r.nextInt ({ 1, 3 });
+                    const auto note = r.nextInt ({ 60, 64 });
+                    const auto time = (double) r.nextInt (200);
+
+                    switch (r.nextInt (4))
+                    {
+                        case 0:   sequence.addEvent (MidiMessage::noteOff (channel, note).withTimeStamp (time)); break;
+                        case 1:   sequence.addEvent (MidiMessage::pitchWheel (channel, r.nextInt (16384)).withTimeStamp (time)); break;
+                        default:  sequence.addEvent (MidiMessage::noteOn (channel, note, (uint8) r.nextInt ({ 1, 128 })).withTimeStamp (time)); break;
+                    }
+                }
+
+                MidiEventStore store (sequence);
+                store.updateMatchedPairs();
+                sequence.updateMatchedPairs();
+
+                expectSameEvents (store, sequence);
+                expectSameEvents (MidiEventStore (sequence), sequence);
+                expectSameEvents (store, store.toMidiMessageSequence());
+            }
+        }
+
+        beginTest ("Reading a MIDI file");
+        {
+            MidiMessageSequence track;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                track.addEvent (MidiMessage::noteOn (1 + i % 4, 40 + i % 20, (uint8) 100).withTimeStamp (i * 10));
+                track.addEvent (MidiMessage::noteOff (1 + i % 4, 40 + i % 20).withTimeStamp (i * 10 + 15));
+                track.addEvent (MidiMessage::textMetaEvent (1, "event " + String (i)).withTimeStamp (i * 10));
+            }
+
+            MidiFile file;
+            file.setTicksPerQuarterNote (480);
+            file.addTrack (track);
+            file.addTrack (track);
+
+            MemoryOutputStream out;
+            file.writeTo (out);
+
+            MidiFile expected;
+            MemoryInputStream expectedIn (out.getData(), out.getDataSize(), false);
+            expect (expected.readFrom (expectedIn));
+
+            MidiFile reader;
+            OwnedArray<MidiEventStore> tracks;
+            int fileType = -1;
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expect (reader.readFrom (in, tracks, true, &fileType));
+
+            expectEquals (fileType, 1);
+            expectEquals ((int) reader.getTimeFormat(), 480);
+            expectEquals (tracks.size(), 2);
+
+            for (int i = 0; i < tracks.size(); ++i)
+                expectSameEvents (*tracks.getUnchecked (i), *expected.getTrack (i));
+        }
+
+        beginTest ("Reading raw events matches reading MidiMessages");
+        {
+            auto r = getRandom();
+
+            for (int iteration = 0; iteration < 50; ++iteration)
+            {
+                const auto fileData = createRandomMidiFile (r, 1 + r.nextInt (4), iteration % 5 == 0);
+
+                for (auto createMatchingNoteOffs : { false, true })
+                {
+                    MidiFile expected;
+                    MemoryInputStream expectedIn (fileData, false);
+                    const auto expectedResult = expected.readFrom (expectedIn, createMatchingNoteOffs);
+
+                    MidiFile reader;
+                    OwnedArray<MidiEventStore> tracks;
+                    MemoryInputStream in (fileData, false);
+                    expect (reader.readFrom (in, tracks, createMatchingNoteOffs) == expectedResult);
+
+                    expectEquals (tracks.size(), expected.getNumTracks());
+
+                    for (int i = 0; i < jmin (tracks.size(), expected.getNumTracks()); ++i)
+                        expectSameEvents (*tracks.getUnchecked (i), *expected.getTrack (i));
+                }
+            }
+        }
+
+        beginTest ("Reading tracks in parallel");
+        {
+            auto r = getRandom();
+            const auto fileData = createRandomMidiFile (r, 16, false);
+            WorkStealingThreadPool pool (4);
+
+            MidiFile reader;
+            OwnedArray<MidiEventStore> serialTracks, parallelTracks;
+            MemoryInputStream serialIn (fileData, false), parallelIn (fileData, false);
+
+            expect (reader.readFrom (serialIn, serialTracks));
+            expect (reader.readFrom (parallelIn, parallelTracks, true, nullptr, &pool));
+            expectEquals (parallelTracks.size(), 16);
+
+            for (int i = 0; i < jmin (serialTracks.size(), parallelTracks.size()); ++i)
+                expectSameEvents (*parallelTracks.getUnchecked (i), serialTracks.getUnchecked (i)->toMidiMessageSequence());
+        }
+
+        beginTest ("Writing tracks");
+        {
+            auto r = getRandom();
+            const auto fileData = createRandomMidiFile (r, 3, false);
+
+            MidiFile file;
+            MemoryInputStream fileIn (fileData, false);
+            expect (file.readFrom (fileIn));
+
+            OwnedArray<MidiEventStore> tracks;
+
+            for (int i = 0; i < file.getNumTracks(); ++i)
+                tracks.add (new MidiEventStore (*file.getTrack (i)));
+
+            MemoryOutputStream expected, written;
+            expect (file.writeTo (expected));
+            expect (file.writeTo (written, tracks));
+            expect (expected.getMemoryBlock() == written.getMemoryBlock());
+
+            MidiFile expectedReadBack;
+            MemoryInputStream expectedIn (expected.getMemoryBlock(), true);
+            expect (expectedReadBack.readFrom (expectedIn));
+
+            OwnedArray<MidiEventStore> readBack;
+            MemoryInputStream in (written.getMemoryBlock(), true);
+            expect (file.readFrom (in, readBack));
+            expectEquals (readBack.size(), expectedReadBack.getNumTracks());
+
+            for (int i = 0; i < jmin (readBack.size(), expectedReadBack.getNumTracks()); ++i)
+                expectSameEvents (*readBack.getUnchecked (i), *expectedReadBack.getTrack (i));
+        }
+    }
+
+private:
+    static MemoryBlock createRandomMidiFile (Random& r, int numTracks, bool truncateTracks)
+    {
+        MemoryOutputStream out;
+        out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"));
+        out.writeIntBigEndian (6);
+        out.writeShortBigEndian (1);
+        out.writeShortBigEndian ((short) numTracks);
+        out.writeShortBigEndian (96);
+
+        for (int track = 0; track < numTracks; ++track)
+        {
+            MemoryOutputStream trackData;
+            uint8 lastStatusByte = 0;
+
+            for (int i = 0; i < 300; ++i)
+            {
+                trackData.writeByte ((char) (r.nextInt (4) == 0 ? r.nextInt (128) : 0));
+
+                switch (r.nextInt (8))
+                {
+                    case 0:
+                    {
+                        const auto text = "text " + String (i);
+                        trackData.writeByte ((char) 0xff);
+                        trackData.writeByte (0x01);
+                        trackData.writeByte ((char) text.length());
+                        trackData.write (text.toRawUTF8(), (size_t) text.length());
+                        break;
+                    }
+
+                    case 1:
+                    {
+                        trackData.writeByte ((char) 0xf0);
+                        trackData.writeByte (4);
+                        trackData.writeByte (0x7e);
+                        trackData.writeByte (0x10);
+                        trackData.writeByte (0x20);
+                        trackData.writeByte ((char) 0xf7);
+                        break;
+                    }
+
+                    default:
+                    {
+                        const uint8 types[] = { 0x80, 0x90, 0x90, 0xb0, 0xc0, 0xe0 };
+                        const auto status = (uint8) (types[r.nextInt (6)] | r.nextInt (2));
+
+                        if (status != lastStatusByte || r.nextBool())
+                            trackData.writeByte ((char) status);
+
+                        trackData.writeByte ((char) (60 + r.nextInt (4)));
+
+                        if (MidiMessage::getMessageLengthFromFirstByte (status) > 2)
+                            trackData.writeByte ((char) r.nextInt (3));
+
+                        lastStatusByte = status;
+                        break;
+                    }
+                }
+            }
+
+            auto size = (int) trackData.getDataSize();
+
+            if (truncateTracks)
+                size = r.nextInt ({ 1, size });
+
+            out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MTrk"));
+            out.writeIntBigEndian (size);
+            out.write (trackData.getData(), (size_t) size);
+        }
+
+        return out.getMemoryBlock();
+    }
+
+    void expectSameEvents (const MidiEventStore& store, const MidiMessageSequence& sequence)
+    {
+        expectEquals (store.getNumEvents(), sequence.getNumEvents());
+
+        for (int i = 0; i < jmin (store.getNumEvents(), sequence.getNumEvents()); ++i)
+        {
+            const auto& message = sequence.getEventPointer (i)->message;
+
+            expectEquals (store.getEventTime (i), message.getTimeStamp());
+            expect (store.getRawDataSize (i) == message.getRawDataSize()
+                     && std::equal (store.getRawData (i), store.getRawData (i) + store.getRawDataSize (i), message.getRawData()));
+            expectEquals (store.getIndexOfMatchingKeyUp (i), sequence.getIndexOfMatchingKeyUp (i));
+        }
+    }
+};
+
+static MidiEventStoreTests midiEventStoreTests;
+
+#endif
+
+} // namespace juce
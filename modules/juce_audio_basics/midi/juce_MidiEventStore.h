@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A time-ordered list of MIDI events, stored as contiguous columns rather than
+    as a separate object for each event.
+
+    This holds the same information as a MidiMessageSequence, but keeps the
+    timestamps, the raw MIDI bytes and the indices of matching note-offs in flat
+    arrays. That makes it much cheaper to build and to scan when there are millions
+    of events, e.g. when importing a large orchestral MIDI file with
+    MidiFile::readFrom().
+
+    Pairing note-ons with their note-offs takes a single pass over the events, and
+    getNextIndexAtTime() uses a binary search.
+
+    @code
+    OwnedArray<MidiEventStore> tracks;
+    MidiFile file;
+
+    if (file.readFrom (stream, tracks))
+        for (auto* track : tracks)
+            for (int i = track->getNextIndexAtTime (startTick); i < track->getNumEvents(); ++i)
+                handleEvent (track->getRawData (i), track->getRawDataSize (i));
+    @endcode
+
+    @see MidiMessageSequence, MidiFile
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiEventStore
+{
+public:
+    //==============================================================================
+    /** Creates an empty store. */
+    MidiEventStore() = default;
+
+    /** Creates a store containing the events of a MidiMessageSequence, including
+        its matched note-off pairs.
+    */
+    explicit MidiEventStore (const MidiMessageSequence&);
+
+    //==============================================================================
+    /** Removes all events. */
+    void clear() noexcept;
+
+    /** Pre-allocates space for a number of events and bytes of MIDI data. */
+    void ensureStorageAllocated (int numEvents, int numBytesOfMidiData);
+
+    /** Returns the number of events. */
+    int getNumEvents() const noexcept                               { return timeStamps.size(); }
+
+    /** Returns the timestamp of one of the events. */
+    double getEventTime (int index) const noexcept                  { return timeStamps[index]; }
+
+    /** Returns a pointer to the raw MIDI data of one of the events. */
+    const uint8* getRawData (int index) const noexcept              { return midiData.begin() + dataOffsets.getUnchecked (index); }
+
+    /** Returns the number of bytes of raw MIDI data that an event has. */
+    int getRawDataSize (int index) const noexcept                   { return (int) dataSizes.getUnchecked (index); }
+
+    /** Creates a MidiMessage for one of the events. */
+    MidiMessage getMessage (int index) const;
+
+    /** Returns the time of the first event, or 0 if there are none. */
+    double getStartTime() const noexcept                            { return timeStamps.isEmpty() ? 0.0 : timeStamps.getFirst(); }
+
+    /** Returns the time of the last event, or 0 if there are none. */
+    double getEndTime() const noexcept                              { return timeStamps.isEmpty() ? 0.0 : timeStamps.getLast(); }
+
+    /** Returns the index of the first event at or after the given time, or the
+        number of events if they're all earlier.
+    */
+    int getNextIndexAtTime (double timeStamp) const noexcept;
+
+    //==============================================================================
+    /** Adds an event, keeping the events sorted by time.
+
+        Events with the same time as existing ones are added after them. Adding events
+        in time order is fastest, as each one is just appended; otherwise the later
+        events have to be moved up.
+
+        Remember to call updateMatchedPairs() after adding note-on events.
+    */
+    void addEvent (const MidiMessage& message, double timeAdjustment = 0);
+
+    /** Adds an event from raw MIDI data, keeping the events sorted by time.
+        @see addEvent
+    */
+    void addEvent (const uint8* rawMidiData, int numBytes, double timeStamp);
+
+    /** Removes an event, and optionally its matching note-off. */
+    void deleteEvent (int index, bool deleteMatchingNoteUp);
+
+    /** Adds a value to the timestamps of all the events. */
+    void addTimeToMessages (double deltaTime) noexcept;
+
+    //==============================================================================
+    /** Pairs up each note-on with the next note-off for the same channel and note.
+
+        As with MidiMessageSequence::updateMatchedPairs(), a note-on for a note that's
+        already playing ends the previous note, by adding a note-off at the same time
+        just before it. This takes a single pass over the events.
+    */
+    void updateMatchedPairs();
+
+    /** Returns the index of the note-off that matches the note-on at this index,
+        or -1 if the event isn't a note-on or doesn't have a note-off.
+    */
+    int getIndexOfMatchingKeyUp (int index) const noexcept          { return noteOffIndices[index]; }
+
+    /** Returns the time of the note-off that matches the note-on at this index,
+        or 0 if the event isn't a note-on or doesn't have a note-off.
+    */
+    double getTimeOfMatchingKeyUp (int index) const noexcept;
+
+    //==============================================================================
+    /** Creates a MidiMessageSequence containing the same events and note-off pairs. */
+    MidiMessageSequence toMidiMessageSequence() const;
+
+    /** Swaps the contents of two stores. */
+    void swapWith (MidiEventStore&) noexcept;
+
+private:
+    //==============================================================================
+    friend class MidiFile;
+
+    Array<double> timeStamps;
+    Array<uint32> dataOffsets, dataSizes;
+    Array<int> noteOffIndices;
+    Array<uint8> midiData;
+
+    void appendEvent (const uint8*, int, double);
+    void appendEvent (uint8, const uint8*, int, double);
+    void sortNoteOffsBeforeOtherEventsAtSameTime();
+
+    JUCE_LEAK_DETECTOR (MidiEventStore)
+};
+
+} // namespace juce
@@ -208,13 +208,12 @@ namespace MidiFileHelpers
         }
     }
 
-    static MidiMessageSequence readTrack (const uint8* data, int size)
+    template <typename Callback>
+    static void readTrackEvents (const uint8* data, int size, Callback&& callback)
     {
         double time = 0;
         uint8 lastStatusByte = 0;
 
-        MidiMessageSequence result;
-
         while (size > 0)
         {
             const auto delay = MidiMessage::readVariableLengthValue (data, (int) size);
@@ -238,16 +237,265 @@ namespace MidiFileHelpers
             size -= messSize;
             data += messSize;
 
-            result.addEvent (mm);
+            callback (mm);
 
             auto firstByte = *(mm.getRawData());
 
             if ((firstByte & 0xf0) != 0xf0)
                 lastStatusByte = firstByte;
         }
+    }
 
+    static MidiMessageSequence readTrack (const uint8* data, int size)
+    {
+        MidiMessageSequence result;
+        readTrackEvents (data, size, [&result] (const MidiMessage& m) { result.addEvent (m); });
         return result;
     }
+
+    /*  Parses the events in a track in the same way as readTrackEvents(), but without
+        creating a MidiMessage for each one. The callback is given each event's first
+        byte, followed by a pointer to the rest of its bytes, which may point into the
+        track data or to a temporary buffer.
+    */
+    template <typename Callback>
+    static void readRawTrackEvents (const uint8* data, int size, Callback&& callback)
+    {
+        double time = 0;
+        uint8 lastStatusByte = 0;
+
+        while (size > 0)
+        {
+            const auto delay = MidiMessage::readVariableLengthValue (data, (int) size);
+
+            if (! delay.isValid())
+                break;
+
+            data += delay.bytesUsed;
+            size -= delay.bytesUsed;
+            time += delay.value;
+
+            if (size <= 0)
+                break;
+
+            // This must match the way that the MidiMessage constructor parses events
+            auto src = data;
+            auto bytesAvailable = size;
+            auto firstByte = *src;
+            int messSize;
+
+            if (firstByte < 0x80)
+            {
+                firstByte = lastStatusByte;
+                messSize = -1;
+            }
+            else
+            {
+                messSize = 0;
+                --bytesAvailable;
+                ++src;
+            }
+
+            if (firstByte < 0x80)
+                break;
+
+            if (firstByte == 0xf0)
+            {
+                auto d = src;
+                bool haveReadAllLengthBytes = false;
+                int numVariableLengthSysexBytes = 0;
+
+                while (d < src + bytesAvailable)
+                {
+                    if (*d >= 0x80)
+                    {
+                        if (*d == 0xf7)
+                        {
+                            ++d;
+                            break;
+                        }
+
+                        if (haveReadAllLengthBytes)
+                            break;
+
+                        ++numVariableLengthSysexBytes;
+                    }
+                    else if (! haveReadAllLengthBytes)
+                    {
+                        haveReadAllLengthBytes = true;
+                        ++numVariableLengthSysexBytes;
+                    }
+
+                    ++d;
+                }
+
+                src += numVariableLengthSysexBytes;
+                const auto numDataBytes = (int) (d - src);
+                callback (firstByte, src, numDataBytes, time);
+                messSize += numVariableLengthSysexBytes + 1 + numDataBytes;
+            }
+            else if (firstByte == 0xff)
+            {
+                const auto bytesLeft = MidiMessage::readVariableLengthValue (src + 1, bytesAvailable - 1);
+                const auto eventSize = jmin (bytesAvailable + 1, bytesLeft.bytesUsed + 2 + bytesLeft.value);
+                callback (firstByte, src, eventSize - 1, time);
+                messSize += eventSize;
+            }
+            else
+            {
+                const auto eventSize = MidiMessage::getMessageLengthFromFirstByte (firstByte);
+                const uint8 dataBytes[] = { bytesAvailable > 0 ? src[0] : (uint8) 0,
+                                            bytesAvailable > 1 ? src[1] : (uint8) 0 };
+                callback (firstByte, dataBytes, eventSize - 1, time);
+                messSize += jmin (eventSize, bytesAvailable + 1);
+            }
+
+            if (messSize <= 0)
+                break;
+
+            size -= messSize;
+            data += messSize;
+
+            if ((firstByte & 0xf0) != 0xf0)
+                lastStatusByte = firstByte;
+        }
+    }
+
+    static bool readFileData (InputStream& sourceStream, MemoryBlock& data)
+    {
+        const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
+
+        // (put a sanity-check on the file size, as midi files are generally small)
+        return sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize);
+    }
+
+    template <typename TrackCallback>
+    static bool readChunks (const MemoryBlock& data, short& timeFormat, int* fileType, TrackCallback&& trackCallback)
+    {
+        auto size = data.getSize();
+        auto d = static_cast<const uint8*> (data.getData());
+
+        const auto optHeader = parseMidiHeader (d, size);
+
+        if (! optHeader.hasValue())
+            return false;
+
+        const auto header = *optHeader;
+        timeFormat = header.timeFormat;
+
+        d += header.bytesRead;
+        size -= (size_t) header.bytesRead;
+
+        for (int track = 0; track < header.numberOfTracks; ++track)
+        {
+            const auto optChunkType = tryRead<uint32> (d, size);
+
+            if (! optChunkType.hasValue())
+                return false;
+
+            const auto optChunkSize = tryRead<uint32> (d, size);
+
+            if (! optChunkSize.hasValue())
+                return false;
+
+            const auto chunkSize = *optChunkSize;
+
+            if (size < chunkSize)
+                return false;
+
+            if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
+                trackCallback (d, (int) chunkSize);
+
+            size -= chunkSize;
+            d += chunkSize;
+        }
+
+        const auto successful = (size == 0);
+
+        if (successful && fileType != nullptr)
+            *fileType = header.fileType;
+
+        return successful;
+    }
+
+    struct RawEvent
+    {
+        const uint8* data;
+        int size;
+        double time;
+    };
+
+    template <typename EventAccessor>
+    static void writeTrackEvents (OutputStream& out, int numEvents, EventAccessor&& getEvent)
+    {
+        int lastTick = 0;
+        uint8 lastStatusByte = 0;
+        bool endOfTrackEventWritten = false;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const RawEvent event = getEvent (i);
+            auto* data = event.data;
+            auto dataSize = event.size;
+
+            if (dataSize >= 2 && data[0] == 0xff && data[1] == 0x2f)
+                endOfTrackEventWritten = true;
+
+            auto tick = roundToInt (event.time);
+            auto delta = jmax (0, tick - lastTick);
+            writeVariableLengthInt (out, (uint32) delta);
+            lastTick = tick;
+
+            auto statusByte = data[0];
+
+            if (statusByte == lastStatusByte
+                 && (statusByte & 0xf0) != 0xf0
+                 && dataSize > 1
+                 && i > 0)
+            {
+                ++data;
+                --dataSize;
+            }
+            else if (statusByte == 0xf0)  // Write sysex message with length bytes.
+            {
+                out.writeByte ((char) statusByte);
+
+                ++data;
+                --dataSize;
+
+                writeVariableLengthInt (out, (uint32) dataSize);
+            }
+
+            out.write (data, (size_t) dataSize);
+            lastStatusByte = statusByte;
+        }
+
+        if (! endOfTrackEventWritten)
+        {
+            out.writeByte (0); // (tick delta)
+            auto m = MidiMessage::endOfTrack();
+            out.write (m.getRawData(), (size_t) m.getRawDataSize());
+        }
+    }
+
+    static bool writeHeader (OutputStream& out, int midiFileType, int numTracks, short timeFormat)
+    {
+        jassert (midiFileType >= 0 && midiFileType <= 2);
+
+        return out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"))
+            && out.writeIntBigEndian (6)
+            && out.writeShortBigEndian ((short) midiFileType)
+            && out.writeShortBigEndian ((short) numTracks)
+            && out.writeShortBigEndian (timeFormat);
+    }
+
+    static bool writeTrackChunk (OutputStream& out, const MemoryOutputStream& trackData)
+    {
+        if (! out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MTrk"))) return false;
+        if (! out.writeIntBigEndian ((int) trackData.getDataSize()))          return false;
+
+        return out.write (trackData.getData(), trackData.getDataSize());
+    }
 }
 
 //==============================================================================
@@ -350,54 +598,53 @@ bool MidiFile::readFrom (InputStream& sourceStream,
     clear();
     MemoryBlock data;
 
-    const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
-
-    // (put a sanity-check on the file size, as midi files are generally small)
-    if (! sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize))
+    if (! MidiFileHelpers::readFileData (sourceStream, data))
         return false;
 
-    auto size = data.getSize();
-    auto d = static_cast<const uint8*> (data.getData());
+    return MidiFileHelpers::readChunks (data, timeFormat, fileType, [&] (const uint8* trackData, int size)
+    {
+        readNextTrack (trackData, size, createMatchingNoteOffs);
+    });
+}
 
-    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+bool MidiFile::readFrom (InputStream& sourceStream,
+                         OwnedArray<MidiEventStore>& destTracks,
+                         bool createMatchingNoteOffs,
+                         int* fileType,
+                         WorkStealingThreadPool* threadPool)
+{
+    clear();
+    destTracks.clear();
+    MemoryBlock data;
 
-    if (! optHeader.hasValue())
+    if (! MidiFileHelpers::readFileData (sourceStream, data))
         return false;
 
-    const auto header = *optHeader;
-    timeFormat = header.timeFormat;
+    Array<std::pair<const uint8*, int>> trackChunks;
 
-    d += header.bytesRead;
-    size -= (size_t) header.bytesRead;
-
-    for (int track = 0; track < header.numberOfTracks; ++track)
+    const auto successful = MidiFileHelpers::readChunks (data, timeFormat, fileType, [&] (const uint8* trackData, int size)
     {
-        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
-
-        if (! optChunkType.hasValue())
-            return false;
-
-        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
-
-        if (! optChunkSize.hasValue())
-            return false;
-
-        const auto chunkSize = *optChunkSize;
+        trackChunks.add ({ trackData, size });
+    });
 
-        if (size < chunkSize)
-            return false;
+    for (int i = 0; i < trackChunks.size(); ++i)
+        destTracks.add (new MidiEventStore());
 
-        if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
-            readNextTrack (d, (int) chunkSize, createMatchingNoteOffs);
+    const auto readTrackChunk = [&] (int i)
+    {
+        const auto chunk = trackChunks.getUnchecked (i);
+        readNextTrack (*destTracks.getUnchecked (i), chunk.first, chunk.second, createMatchingNoteOffs);
+    };
 
-        size -= chunkSize;
-        d += chunkSize;
+    if (threadPool != nullptr)
+    {
+        threadPool->parallelFor (0, trackChunks.size(), readTrackChunk, 1);
+    }
+    else
+    {
+        for (int i = 0; i < trackChunks.size(); ++i)
+            readTrackChunk (i);
     }
-
-    const auto successful = (size == 0);
-
-    if (successful && fileType != nullptr)
-        *fileType = header.fileType;
 
     return successful;
 }
@@ -426,6 +673,24 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
     addTrack (sequence);
 }
 
+void MidiFile::readNextTrack (MidiEventStore& track, const uint8* data, int size, bool createMatchingNoteOffs)
+{
+    // (a rough guess, to avoid reallocating while reading)
+    track.ensureStorageAllocated (size / 3, size);
+
+    // the events in a track are already in time order, so can just be appended
+    MidiFileHelpers::readRawTrackEvents (data, size, [&track] (uint8 firstByte, const uint8* rest, int numRestBytes, double time)
+    {
+        track.appendEvent (firstByte, rest, numRestBytes, time);
+    });
+
+    // put all the note-offs before note-ons that have the same time
+    track.sortNoteOffsBeforeOtherEventsAtSameTime();
+
+    if (createMatchingNoteOffs)
+        track.updateMatchedPairs();
+}
+
 //==============================================================================
 void MidiFile::convertTimestampTicksToSeconds()
 {
@@ -449,13 +714,8 @@ void MidiFile::convertTimestampTicksToSeconds()
 //==============================================================================
 bool MidiFile::writeTo (OutputStream& out, int midiFileType) const
 {
-    jassert (midiFileType >= 0 && midiFileType <= 2);
-
-    if (! out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"))) return false;
-    if (! out.writeIntBigEndian (6))                                      return false;
-    if (! out.writeShortBigEndian ((short) midiFileType))                 return false;
-    if (! out.writeShortBigEndian ((short) tracks.size()))                return false;
-    if (! out.writeShortBigEndian (timeFormat))                           return false;
+    if (! MidiFileHelpers::writeHeader (out, midiFileType, tracks.size(), timeFormat))
+        return false;
 
     for (auto* ms : tracks)
         if (! writeTrack (out, *ms))
@@ -465,65 +725,44 @@ bool MidiFile::writeTo (OutputStream& out, int midiFileType) const
     return true;
 }
 
-bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms) const
+bool MidiFile::writeTo (OutputStream& out, const OwnedArray<MidiEventStore>& tracksToWrite, int midiFileType) const
 {
-    MemoryOutputStream out;
+    if (! MidiFileHelpers::writeHeader (out, midiFileType, tracksToWrite.size(), timeFormat))
+        return false;
 
-    int lastTick = 0;
-    uint8 lastStatusByte = 0;
-    bool endOfTrackEventWritten = false;
+    // The same buffer is re-used for each track, so once it's big enough for the
+    // largest one, nothing else needs to be allocated
+    MemoryOutputStream trackData;
 
-    for (int i = 0; i < ms.getNumEvents(); ++i)
+    for (auto* track : tracksToWrite)
     {
-        auto& mm = ms.getEventPointer(i)->message;
-
-        if (mm.isEndOfTrackMetaEvent())
-            endOfTrackEventWritten = true;
+        trackData.reset();
+        trackData.preallocate ((size_t) (track->midiData.size() + 4 * track->getNumEvents() + 4));
 
-        auto tick = roundToInt (mm.getTimeStamp());
-        auto delta = jmax (0, tick - lastTick);
-        MidiFileHelpers::writeVariableLengthInt (out, (uint32) delta);
-        lastTick = tick;
-
-        auto* data = mm.getRawData();
-        auto dataSize = mm.getRawDataSize();
-        auto statusByte = data[0];
-
-        if (statusByte == lastStatusByte
-             && (statusByte & 0xf0) != 0xf0
-             && dataSize > 1
-             && i > 0)
+        MidiFileHelpers::writeTrackEvents (trackData, track->getNumEvents(), [track] (int i)
         {
-            ++data;
-            --dataSize;
-        }
-        else if (statusByte == 0xf0)  // Write sysex message with length bytes.
-        {
-            out.writeByte ((char) statusByte);
-
-            ++data;
-            --dataSize;
+            return MidiFileHelpers::RawEvent { track->getRawData (i), track->getRawDataSize (i), track->getEventTime (i) };
+        });
 
-            MidiFileHelpers::writeVariableLengthInt (out, (uint32) dataSize);
-        }
-
-        out.write (data, (size_t) dataSize);
-        lastStatusByte = statusByte;
+        if (! MidiFileHelpers::writeTrackChunk (out, trackData))
+            return false;
     }
 
-    if (! endOfTrackEventWritten)
-    {
-        out.writeByte (0); // (tick delta)
-        auto m = MidiMessage::endOfTrack();
-        out.write (m.getRawData(), (size_t) m.getRawDataSize());
-    }
+    out.flush();
+    return true;
+}
 
-    if (! mainOut.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MTrk"))) return false;
-    if (! mainOut.writeIntBigEndian ((int) out.getDataSize()))                return false;
+bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms) const
+{
+    MemoryOutputStream out;
 
-    mainOut << out;
+    MidiFileHelpers::writeTrackEvents (out, ms.getNumEvents(), [&ms] (int i)
+    {
+        auto& mm = ms.getEventPointer (i)->message;
+        return MidiFileHelpers::RawEvent { mm.getRawData(), mm.getRawDataSize(), mm.getTimeStamp() };
+    });
 
-    return true;
+    return MidiFileHelpers::writeTrackChunk (mainOut, out);
 }
 
 //==============================================================================
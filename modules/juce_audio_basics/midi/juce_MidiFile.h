@@ -166,6 +166,32 @@ public:
                    bool createMatchingNoteOffs = true,
                    int* midiFileType = nullptr);
 
+    /** Reads a midi file format stream into a set of MidiEventStore objects.
+
+        This is much faster than the other readFrom() method for files with a large
+        number of events, as it avoids creating a separate object for each event. The
+        tracks are added to the destTracks array rather than to this MidiFile, although
+        this object's time format is set to the one that was read.
+
+        @param sourceStream              the source stream
+        @param destTracks                the array to fill with the tracks that were read. Any
+                                         existing contents are removed.
+        @param createMatchingNoteOffs    if true, any missing note-offs for previous note-ons will
+                                         be automatically added by calling
+                                         MidiEventStore::updateMatchedPairs on each track.
+        @param midiFileType              if not nullptr, the integer at this address will be set
+                                         to 0, 1, or 2 depending on the type of the midi file
+        @param threadPool                if not nullptr, the tracks will be parsed in parallel
+                                         using this pool's threads
+
+        @returns true if the stream was read successfully
+    */
+    bool readFrom (InputStream& sourceStream,
+                   OwnedArray<MidiEventStore>& destTracks,
+                   bool createMatchingNoteOffs = true,
+                   int* midiFileType = nullptr,
+                   WorkStealingThreadPool* threadPool = nullptr);
+
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
         or 2 - see the midi file spec for more info about that.
@@ -177,6 +203,22 @@ public:
     */
     bool writeTo (OutputStream& destStream, int midiFileType = 1) const;
 
+    /** Writes a set of MidiEventStore tracks as a standard midi file, using this
+        object's time format.
+
+        The tracks in this MidiFile are ignored. This doesn't need to allocate any
+        memory for each event, so is much faster than writeTo() for large tracks.
+
+        @param destStream        the destination stream
+        @param tracksToWrite     the tracks to write, whose timestamps are in midi ticks
+        @param midiFileType      the type of midi file
+
+        @returns true if the operation succeeded.
+    */
+    bool writeTo (OutputStream& destStream,
+                  const OwnedArray<MidiEventStore>& tracksToWrite,
+                  int midiFileType = 1) const;
+
     /** Converts the timestamp of all the midi events from midi ticks to seconds.
 
         This will use the midi time format and tempo/time signature info in the
@@ -190,6 +232,7 @@ private:
     short timeFormat;
 
     void readNextTrack (const uint8*, int, bool);
+    static void readNextTrack (MidiEventStore&, const uint8*, int, bool);
     bool writeTrack (OutputStream&, const MidiMessageSequence&) const;
 
     JUCE_LEAK_DETECTOR (MidiFile)
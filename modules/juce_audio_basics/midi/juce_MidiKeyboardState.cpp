@@ -25,15 +25,22 @@ namespace juce
 
 MidiKeyboardState::MidiKeyboardState()
 {
-    zerostruct (noteStates);
+    for (auto& channel : noteBits)
+        for (auto& word : channel)
+            word.store (0, std::memory_order_relaxed);
+
+    // Each event takes about ten bytes in a MidiBuffer
+    eventsToAdd.ensureSize ((size_t) maxNumPendingEvents * 12);
 }
 
 //==============================================================================
 void MidiKeyboardState::reset()
 {
-    const ScopedLock sl (lock);
-    zerostruct (noteStates);
-    eventsToAdd.clear();
+    for (auto& channel : noteBits)
+        for (auto& word : channel)
+            word.store (0, std::memory_order_release);
+
+    ++resetCount;
 }
 
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
@@ -41,13 +48,58 @@ bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noex
     jassert (midiChannel > 0 && midiChannel <= 16);
 
     return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & (1 << (midiChannel - 1))) != 0;
+            && isPositiveAndBelow (midiChannel - 1, 16)
+            && ((noteBits[midiChannel - 1][n >> 6].load (std::memory_order_acquire) >> (n & 63)) & 1) != 0;
 }
 
 bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const int n) const noexcept
 {
-    return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & midiChannelMask) != 0;
+    if (! isPositiveAndBelow (n, 128))
+        return false;
+
+    for (int i = 0; i < 16; ++i)
+        if ((midiChannelMask & (1 << i)) != 0
+             && ((noteBits[i][n >> 6].load (std::memory_order_acquire) >> (n & 63)) & 1) != 0)
+            return true;
+
+    return false;
+}
+
+BigInteger MidiKeyboardState::getNotesOnForChannels (const int midiChannelMask) const noexcept
+{
+    uint64 low = 0, high = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((midiChannelMask & (1 << i)) != 0)
+        {
+            low  |= noteBits[i][0].load (std::memory_order_acquire);
+            high |= noteBits[i][1].load (std::memory_order_acquire);
+        }
+    }
+
+    BigInteger result;
+    result.setBitRangeAsInt (0,  32, (uint32) low);
+    result.setBitRangeAsInt (32, 32, (uint32) (low >> 32));
+    result.setBitRangeAsInt (64, 32, (uint32) high);
+    result.setBitRangeAsInt (96, 32, (uint32) (high >> 32));
+    return result;
+}
+
+bool MidiKeyboardState::setNoteBit (const int midiChannel, const int midiNoteNumber, const bool shouldBeOn) noexcept
+{
+    if (! (isPositiveAndBelow (midiNoteNumber, 128) && isPositiveAndBelow (midiChannel - 1, 16)))
+        return false;
+
+    auto& word = noteBits[midiChannel - 1][midiNoteNumber >> 6];
+    const auto bit = (uint64) 1 << (midiNoteNumber & 63);
+
+    // The previous value tells us whether this call was the one that changed the key,
+    // so two threads releasing the same key won't both notify the listeners
+    const auto previous = shouldBeOn ? word.fetch_or (bit, std::memory_order_acq_rel)
+                                     : word.fetch_and (~bit, std::memory_order_acq_rel);
+
+    return ((previous & bit) != 0) != shouldBeOn;
 }
 
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
@@ -55,13 +107,11 @@ void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber,
     jassert (midiChannel > 0 && midiChannel <= 16);
     jassert (isPositiveAndBelow (midiNoteNumber, 128));
 
-    const ScopedLock sl (lock);
-
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
+        pendingEvents.push ({ MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity)
+                                .withTimeStamp ((double) Time::getMillisecondCounter()),
+                              resetCount.load() });
 
         noteOnInternal (midiChannel, midiNoteNumber, velocity);
     }
@@ -71,20 +121,20 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 {
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] | (1 << (midiChannel - 1)));
+        setNoteBit (midiChannel, midiNoteNumber, true);
+
+        const ScopedLock sl (listenerLock);
         listeners.call ([&] (Listener& l) { l.handleNoteOn (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
 
 void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    const ScopedLock sl (lock);
-
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
+        pendingEvents.push ({ MidiMessage::noteOff (midiChannel, midiNoteNumber)
+                                .withTimeStamp ((double) Time::getMillisecondCounter()),
+                              resetCount.load() });
 
         noteOffInternal (midiChannel, midiNoteNumber, velocity);
     }
@@ -92,17 +142,15 @@ void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber
 
 void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    if (isNoteOn (midiChannel, midiNoteNumber))
+    if (setNoteBit (midiChannel, midiNoteNumber, false))
     {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] & ~(1 << (midiChannel - 1)));
+        const ScopedLock sl (listenerLock);
         listeners.call ([&] (Listener& l) { l.handleNoteOff (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
 
 void MidiKeyboardState::allNotesOff (const int midiChannel)
 {
-    const ScopedLock sl (lock);
-
     if (midiChannel <= 0)
     {
         for (int i = 1; i <= 16; ++i)
@@ -137,13 +185,23 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
                                                const int numSamples,
                                                const bool injectIndirectEvents)
 {
-    const ScopedLock sl (lock);
-
     for (const auto metadata : buffer)
         processNextMidiEvent (metadata.getMessage());
 
-    if (injectIndirectEvents)
+    const auto currentResetCount = resetCount.load();
+
+    pendingEvents.popAll ([&] (PendingEvent& event)
     {
+        if (injectIndirectEvents && event.resetCount == currentResetCount)
+            eventsToAdd.addEvent (event.message, (int) (uint32) event.message.getTimeStamp());
+    });
+
+    if (! eventsToAdd.isEmpty())
+    {
+        // Only the last half-second of events is kept, as if the events had been
+        // added to the stream as they arrived
+        eventsToAdd.clear (0, eventsToAdd.getLastEventTime() - 500);
+
         const int firstEventToAdd = eventsToAdd.getFirstEventTime();
         const double scaleFactor = numSamples / (double) (eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
 
@@ -152,22 +210,158 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
             const auto pos = jlimit (0, numSamples - 1, roundToInt ((metadata.samplePosition - firstEventToAdd) * scaleFactor));
             buffer.addEvent (metadata.getMessage(), startSample + pos);
         }
-    }
 
-    eventsToAdd.clear();
+        eventsToAdd.clear();
+    }
 }
 
 //==============================================================================
 void MidiKeyboardState::addListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.add (listener);
 }
 
 void MidiKeyboardState::removeListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.remove (listener);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiKeyboardStateTests  : public UnitTest
+{
+public:
+    MidiKeyboardStateTests()
+        : UnitTest ("MidiKeyboardState", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Note bitmaps");
+        {
+            MidiKeyboardState state;
+            state.noteOn (1, 60, 1.0f);
+            state.noteOn (3, 127, 1.0f);
+            state.noteOn (16, 0, 1.0f);
+
+            expect (state.isNoteOn (1, 60) && state.isNoteOn (3, 127) && state.isNoteOn (16, 0));
+            expect (! state.isNoteOn (2, 60) && ! state.isNoteOn (1, 61));
+            expect (state.isNoteOnForChannels (0x6, 127) && ! state.isNoteOnForChannels (0x3, 127));
+
+            const auto notes = state.getNotesOnForChannels (0xffff);
+            expectEquals (notes.countNumberOfSetBits(), 3);
+            expect (notes[0] && notes[60] && notes[127]);
+            expectEquals (state.getNotesOnForChannels (0x1).getHighestBit(), 60);
+
+            state.noteOff (3, 127, 0.0f);
+            expect (! state.isNoteOn (3, 127));
+
+            state.reset();
+            expect (state.getNotesOnForChannels (0xffff).isZero());
+        }
+
+        beginTest ("Events are injected into the stream");
+        {
+            MidiKeyboardState state;
+            state.noteOn (1, 60, 1.0f);
+            state.noteOff (1, 60, 0.0f);
+            state.noteOff (1, 61, 0.0f); // not down, so ignored
+
+            MidiBuffer buffer;
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expectEquals (buffer.getNumEvents(), 2);
+            expect ((*buffer.begin()).getMessage().isNoteOn());
+
+            buffer.clear();
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+
+            state.noteOn (2, 64, 1.0f);
+            state.processNextMidiBuffer (buffer, 0, 256, false);
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+
+            state.noteOn (2, 65, 1.0f);
+            state.reset();
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+        }
+
+        beginTest ("Incoming events update the state and listeners");
+        {
+            struct Counter  : public MidiKeyboardState::Listener
+            {
+                void handleNoteOn  (MidiKeyboardState*, int, int, float) override   { ++numOn; }
+                void handleNoteOff (MidiKeyboardState*, int, int, float) override   { ++numOff; }
+                int numOn = 0, numOff = 0;
+            };
+
+            MidiKeyboardState state;
+            Counter counter;
+            state.addListener (&counter);
+
+            MidiBuffer buffer;
+            buffer.addEvent (MidiMessage::noteOn (5, 70, 0.5f), 0);
+            buffer.addEvent (MidiMessage::noteOff (5, 70), 10);
+            buffer.addEvent (MidiMessage::noteOff (5, 70), 20);
+            buffer.addEvent (MidiMessage::noteOn (5, 71, 0.5f), 30);
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+
+            expect (state.isNoteOn (5, 71) && ! state.isNoteOn (5, 70));
+            expectEquals (counter.numOn, 2);
+            expectEquals (counter.numOff, 1);
+            state.removeListener (&counter);
+        }
+
+        beginTest ("Notes played on another thread");
+        {
+            MidiKeyboardState state;
+            std::atomic<bool> finished { false };
+
+            std::thread player ([&]
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    state.noteOn (1 + i % 16, i % 128, 1.0f);
+                    state.noteOff (1 + i % 16, i % 128, 0.0f);
+                }
+
+                finished = true;
+            });
+
+            int numNoteOns = 0, numNoteOffs = 0;
+            MidiBuffer buffer;
+
+            for (bool done = false; ! done;)
+            {
+                done = finished.load();
+                buffer.clear();
+                state.processNextMidiBuffer (buffer, 0, 512, true);
+
+                for (const auto metadata : buffer)
+                {
+                    numNoteOns  += metadata.getMessage().isNoteOn()  ? 1 : 0;
+                    numNoteOffs += metadata.getMessage().isNoteOff() ? 1 : 0;
+                }
+
+                Thread::yield();
+            }
+
+            player.join();
+
+            expect (state.getNotesOnForChannels (0xffff).isZero());
+            // Events can be dropped if the queue fills up, so only the final state is exact
+            expect (numNoteOns > 0 && numNoteOffs > 0);
+        }
+    }
+};
+
+static MidiKeyboardStateTests midiKeyboardStateTests;
+
+#endif
+
 } // namespace juce
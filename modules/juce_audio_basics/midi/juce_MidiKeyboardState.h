@@ -36,6 +36,12 @@ namespace juce
     methods, and midi messages for these events will be merged into the
     midi stream that gets processed by processNextMidiBuffer().
 
+    The state of each channel's keys is held in atomic bitmaps, so isNoteOn() and
+    getNotesOnForChannels() can be polled from any thread without locking. The
+    events created by noteOn() and noteOff() are handed to the audio thread through
+    a lock-free queue, so a UI thread playing notes never blocks processNextMidiBuffer().
+    The only lock that's left protects the listener list while callbacks are made.
+
     @tags{Audio}
 */
 class JUCE_API  MidiKeyboardState
@@ -52,6 +58,9 @@ public:
 
         If you want to release any keys that are currently down, and to send out note-up
         midi messages for this, use the allNotesOff() method instead.
+
+        Any events from noteOn() and noteOff() that are still waiting to be added to the
+        midi stream are discarded by the next call to processNextMidiBuffer().
     */
     void reset();
 
@@ -71,10 +80,20 @@ public:
     */
     bool isNoteOnForChannels (int midiChannelMask, int midiNoteNumber) const noexcept;
 
+    /** Returns a bitmap of the keys that are currently held down on any of a set of midi channels.
+
+        Bit n of the result is set if note n is down. The channel mask works in the same way
+        as for isNoteOnForChannels(). This is a cheap way to take a snapshot of the whole
+        keyboard, e.g. when painting it.
+    */
+    BigInteger getNotesOnForChannels (int midiChannelMask) const noexcept;
+
     /** Turns a specified note on.
 
         This will cause a suitable midi note-on event to be injected into the midi buffer during the
-        next call to processNextMidiBuffer().
+        next call to processNextMidiBuffer(). This is lock-free and can be called from any thread,
+        but if more than maxNumPendingEvents events are waiting to be processed, any more will
+        be dropped.
 
         It will also trigger a synchronous callback to the listeners to tell them that the key has
         gone down.
@@ -84,7 +103,7 @@ public:
     /** Turns a specified note off.
 
         This will cause a suitable midi note-off event to be injected into the midi buffer during the
-        next call to processNextMidiBuffer().
+        next call to processNextMidiBuffer(). Like noteOn(), this can be called from any thread.
 
         It will also trigger a synchronous callback to the listeners to tell them that the key has
         gone up.
@@ -127,6 +146,10 @@ public:
 
         To process a single midi event at a time, use the processNextMidiEvent() method
         instead.
+
+        The only lock this takes is the one that protects the listener list while the listeners
+        are called. It must only be called by one thread at a time, which will normally be the
+        audio thread.
     */
     void processNextMidiBuffer (MidiBuffer& buffer,
                                 int startSample,
@@ -177,13 +200,26 @@ public:
     */
     void removeListener (Listener* listener);
 
+    /** The number of noteOn() and noteOff() events that can wait for processNextMidiBuffer(). */
+    static constexpr int maxNumPendingEvents = 512;
+
 private:
     //==============================================================================
-    CriticalSection lock;
-    std::atomic<uint16> noteStates[128];
+    struct PendingEvent
+    {
+        MidiMessage message;
+        uint32 resetCount = 0;
+    };
+
+    // One bitmap of 128 notes for each channel
+    std::atomic<uint64> noteBits[16][2];
+    std::atomic<uint32> resetCount { 0 };
+    MPSCQueue<PendingEvent> pendingEvents { maxNumPendingEvents };
     MidiBuffer eventsToAdd;
+    CriticalSection listenerLock;
     ListenerList<Listener> listeners;
 
+    bool setNoteBit (int midiChannel, int midiNoteNumber, bool shouldBeOn) noexcept;
     void noteOnInternal  (int midiChannel, int midiNoteNumber, float velocity);
     void noteOffInternal (int midiChannel, int midiNoteNumber, float velocity);
 
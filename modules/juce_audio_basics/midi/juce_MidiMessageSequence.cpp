@@ -225,43 +225,79 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
-    for (int i = 0; i < list.size(); ++i)
+    // For each channel and note, the note-on that's still waiting for its note-off
+    std::array<MidiEventHolder*, 16 * 128> pendingNoteOns {};
+    int numNoteOffsToAdd = 0;
+
+    const auto getPendingNoteOn = [&pendingNoteOns] (const MidiMessage& m) -> MidiEventHolder*&
     {
-        auto* meh = list.getUnchecked(i);
-        auto& m1 = meh->message;
+        return pendingNoteOns[(size_t) ((m.getChannel() - 1) * 128 + m.getNoteNumber())];
+    };
 
-        if (m1.isNoteOn())
+    for (auto* meh : list)
+    {
+        auto& m = meh->message;
+
+        if (m.isNoteOn())
         {
+            auto& pending = getPendingNoteOn (m);
             meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
 
-            for (int j = i + 1; j < len; ++j)
+            // A note-on for a note that's already playing ends the previous note, with a
+            // note-off that gets added just before it
+            if (pending != nullptr)
             {
-                auto* meh2 = list.getUnchecked(j);
-                auto& m = meh2->message;
+                pending->noteOffObject = new MidiEventHolder (MidiMessage::noteOff (m.getChannel(), m.getNoteNumber())
+                                                                  .withTimeStamp (m.getTimeStamp()));
+                ++numNoteOffsToAdd;
+            }
 
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
-                {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = meh2;
-                        break;
-                    }
-
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
-                }
+            pending = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            auto& pending = getPendingNoteOn (m);
+
+            if (pending != nullptr)
+            {
+                pending->noteOffObject = meh;
+                pending = nullptr;
             }
         }
     }
+
+    if (numNoteOffsToAdd == 0)
+        return;
+
+    // Make a second pass to put the new note-offs into the list
+    pendingNoteOns.fill (nullptr);
+
+    OwnedArray<MidiEventHolder> newList;
+    newList.ensureStorageAllocated (list.size() + numNoteOffsToAdd);
+
+    for (auto* meh : list)
+    {
+        auto& m = meh->message;
+
+        if (m.isNoteOn())
+        {
+            auto& pending = getPendingNoteOn (m);
+
+            if (pending != nullptr)
+                newList.add (pending->noteOffObject);
+
+            pending = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            getPendingNoteOn (m) = nullptr;
+        }
+
+        newList.add (meh);
+    }
+
+    list.clearQuick (false);
+    list.swapWith (newList);
 }
 
 void MidiMessageSequence::addTimeToMessages (double delta) noexcept
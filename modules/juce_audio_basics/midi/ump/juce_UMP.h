@@ -34,6 +34,7 @@
 #include "juce_UMPMidi1ToBytestreamTranslator.h"
 #include "juce_UMPMidi1ToMidi2DefaultTranslator.h"
 #include "juce_UMPConverters.h"
+#include "juce_UMPEventBuffer.h"
 #include "juce_UMPDispatcher.h"
 #include "juce_UMPReceiver.h"
 
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace universal_midi_packets
+{
+
+void EventBuffer::add (const View& packet, int samplePosition)
+{
+    const auto numWords = (size_t) packet.size();
+
+    if (runs.empty() || samplePosition >= runs.back().samplePosition)
+    {
+        if (runs.empty() || samplePosition > runs.back().samplePosition)
+            runs.push_back ({ samplePosition, words.size() });
+
+        words.insert (words.end(), packet.cbegin(), packet.cend());
+        ++numEvents;
+        return;
+    }
+
+    // The packet goes after any others at the same position, so in front of the first
+    // run that starts later
+    auto next = std::upper_bound (runs.begin(), runs.end(), samplePosition,
+                                  [] (int pos, const Run& run) { return pos < run.samplePosition; });
+
+    const auto insertAt = next->firstWord;
+    words.insert (words.begin() + (std::ptrdiff_t) insertAt, packet.cbegin(), packet.cend());
+
+    for (auto it = next; it != runs.end(); ++it)
+        it->firstWord += numWords;
+
+    if (next == runs.begin() || std::prev (next)->samplePosition != samplePosition)
+        runs.insert (next, { samplePosition, insertAt });
+
+    ++numEvents;
+}
+
+void EventBuffer::addEvents (const EventBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd)
+{
+    for (const auto event : otherBuffer)
+    {
+        if (event.samplePosition < startSample)
+            continue;
+
+        if (numSamples >= 0 && event.samplePosition >= startSample + numSamples)
+            break;
+
+        add (event.packet, event.samplePosition + sampleDeltaToAdd);
+    }
+}
+
+void EventBuffer::clear() noexcept
+{
+    words.clear();
+    runs.clear();
+    numEvents = 0;
+}
+
+void EventBuffer::reserve (size_t numWords)
+{
+    words.reserve (numWords);
+    runs.reserve (numWords);
+}
+
+void EventBuffer::swapWith (EventBuffer& other) noexcept
+{
+    std::swap (words, other.words);
+    std::swap (runs, other.runs);
+    std::swap (numEvents, other.numEvents);
+}
+
+//==============================================================================
+EventBuffer::Iterator& EventBuffer::Iterator::operator++() noexcept
+{
+    wordIndex += View (buffer->words.data() + wordIndex).size();
+
+    if (wordIndex >= buffer->words.size())
+        runIndex = buffer->runs.size();
+    else if (runIndex + 1 < buffer->runs.size() && wordIndex >= buffer->runs[runIndex + 1].firstWord)
+        ++runIndex;
+
+    return *this;
+}
+
+EventBuffer::Event EventBuffer::Iterator::operator*() const noexcept
+{
+    return { View (buffer->words.data() + wordIndex), buffer->runs[runIndex].samplePosition };
+}
+
+//==============================================================================
+void EventBufferConverter::toEventBuffer (const MidiBuffer& source, EventBuffer& dest)
+{
+    for (const auto metadata : source)
+        toEventBuffer (metadata.getMessage(), metadata.samplePosition, dest);
+}
+
+void EventBufferConverter::toEventBuffer (const MidiMessage& message, int samplePosition, EventBuffer& dest)
+{
+    toUMP.convert (message, [&] (const View& packet)
+    {
+        dest.add (packet, samplePosition);
+    });
+}
+
+void EventBufferConverter::toMidiBuffer (const EventBuffer& source, MidiBuffer& dest)
+{
+    for (const auto event : source)
+    {
+        toBytestream.convert (event.packet, (double) event.samplePosition, [&] (const MidiMessage& message)
+        {
+            dest.addEvent (message, event.samplePosition);
+        });
+    }
+}
+
+void EventBufferConverter::reset()
+{
+    toUMP.reset();
+    toBytestream.reset();
+}
+
+}
+}
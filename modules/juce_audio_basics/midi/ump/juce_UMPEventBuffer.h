@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace universal_midi_packets
+{
+
+/**
+    Holds the Universal MIDI Packets for a block of audio, each with a sample position.
+
+    The packets are stored back-to-back as raw 32-bit words in time order, with nothing
+    in between them, so the whole block can be handed to code that reads UMP directly.
+    The sample positions are kept separately, once for each run of packets that share a
+    position, so a burst of events at the same time costs no more than the packets
+    themselves.
+
+    This is what AudioProcessor::processPacketBlock() uses in place of a MidiBuffer.
+
+    @see Packets, MidiBuffer, EventBufferConverter
+
+    @tags{Audio}
+*/
+class EventBuffer
+{
+public:
+    /** Creates an empty buffer. */
+    EventBuffer() = default;
+
+    //==============================================================================
+    /** Adds a packet at a given sample position.
+
+        Packets at the same position are kept in the order in which they were added.
+        Adding packets in time order is fastest, as each one is simply appended.
+
+        The View must be valid for this to work. If the view points to a malformed
+        message, or if the view points to a region too short for the contained message,
+        this call will result in undefined behaviour.
+    */
+    void add (const View& packet, int samplePosition);
+
+    /** Adds a packet at a given sample position. */
+    template <size_t numWords>
+    void add (const Packet<numWords>& packet, int samplePosition)
+    {
+        jassert (Utils::getNumWordsForMessageType (packet[0]) == numWords);
+        add (View (packet.data()), samplePosition);
+    }
+
+    /** Adds the packets from another buffer that fall within a range of sample positions.
+
+        @param otherBuffer          the buffer containing the packets to add
+        @param startSample          the lowest sample position to copy
+        @param numSamples           the number of sample positions to copy, or a negative
+                                    number to copy everything from startSample onwards
+        @param sampleDeltaToAdd     an amount to add to the positions of the copied packets
+    */
+    void addEvents (const EventBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd);
+
+    /** Removes all the packets, keeping the storage that was allocated for them. */
+    void clear() noexcept;
+
+    /** Pre-allocates space for at least `numWords` 32-bit words of packets. */
+    void reserve (size_t numWords);
+
+    /** Exchanges the contents of this buffer with another one. */
+    void swapWith (EventBuffer& other) noexcept;
+
+    //==============================================================================
+    /** Returns true if the buffer contains no packets. */
+    bool isEmpty() const noexcept                   { return words.empty(); }
+
+    /** Returns the number of packets in the buffer. */
+    int getNumEvents() const noexcept               { return numEvents; }
+
+    /** Returns the sample position of the first packet, or 0 if the buffer is empty. */
+    int getFirstEventTime() const noexcept          { return runs.empty() ? 0 : runs.front().samplePosition; }
+
+    /** Returns the sample position of the last packet, or 0 if the buffer is empty. */
+    int getLastEventTime() const noexcept           { return runs.empty() ? 0 : runs.back().samplePosition; }
+
+    /** Returns a pointer to the packets as a contiguous range of raw 32-bit words. */
+    const uint32_t* data() const noexcept           { return words.data(); }
+
+    /** Returns the number of 32-bit words in the buffer. */
+    size_t size() const noexcept                    { return words.size(); }
+
+    //==============================================================================
+    /** A packet in the buffer, and the sample position at which it happens. */
+    struct Event
+    {
+        View packet;
+        int samplePosition;
+    };
+
+    /** Iterates over the packets in a buffer, in time order. */
+    class Iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = Event;
+        using reference         = const Event&;
+        using pointer           = const Event*;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator() = default;
+
+        Iterator& operator++() noexcept;
+        Iterator operator++ (int) noexcept              { auto copy = *this; ++(*this); return copy; }
+
+        bool operator== (const Iterator& other) const noexcept  { return wordIndex == other.wordIndex; }
+        bool operator!= (const Iterator& other) const noexcept  { return ! operator== (other); }
+
+        Event operator*() const noexcept;
+
+    private:
+        friend class EventBuffer;
+
+        Iterator (const EventBuffer& b, size_t word, size_t run) noexcept
+            : buffer (&b), wordIndex (word), runIndex (run) {}
+
+        const EventBuffer* buffer = nullptr;
+        size_t wordIndex = 0, runIndex = 0;
+    };
+
+    Iterator begin() const noexcept                 { return { *this, 0, 0 }; }
+    Iterator end() const noexcept                   { return { *this, words.size(), runs.size() }; }
+    Iterator cbegin() const noexcept                { return begin(); }
+    Iterator cend() const noexcept                  { return end(); }
+
+private:
+    //==============================================================================
+    struct Run
+    {
+        int samplePosition;
+        size_t firstWord;
+    };
+
+    std::vector<uint32_t> words;
+    std::vector<Run> runs;
+    int numEvents = 0;
+
+    JUCE_LEAK_DETECTOR (EventBuffer)
+};
+
+//==============================================================================
+/**
+    Converts between the contents of MidiBuffers and EventBuffers.
+
+    Messages from a MidiBuffer become MIDI 2.0 Protocol packets, and packets become
+    plain MIDI 1.0 messages, using the default translations from the MIDI 2.0
+    specification. Packets that have no MIDI 1.0 equivalent are dropped. Because some
+    messages (such as RPNs and SysEx) are spread over several messages or packets, the
+    converter keeps some state between calls, so use one converter per stream.
+
+    @tags{Audio}
+*/
+class EventBufferConverter
+{
+public:
+    EventBufferConverter() = default;
+
+    /** Adds the messages in a MidiBuffer to an EventBuffer. */
+    void toEventBuffer (const MidiBuffer& source, EventBuffer& dest);
+
+    /** Adds a single message to an EventBuffer. */
+    void toEventBuffer (const MidiMessage& message, int samplePosition, EventBuffer& dest);
+
+    /** Adds the packets in an EventBuffer to a MidiBuffer. */
+    void toMidiBuffer (const EventBuffer& source, MidiBuffer& dest);
+
+    /** Forgets any partly-converted messages. */
+    void reset();
+
+private:
+    ToUMP2Converter toUMP;
+    ToBytestreamConverter toBytestream { 2048 };
+
+    JUCE_LEAK_DETECTOR (EventBufferConverter)
+};
+
+}
+}
@@ -871,6 +871,66 @@ public:
 
             checkMidi1ToMidi2Conversion (midi1, midi2);
         }
+
+        beginTest ("EventBuffer keeps packets contiguous and in time order");
+        {
+            EventBuffer events;
+            events.add (PacketX1 { 0x20901040 }, 10);
+            events.add (PacketX2 { 0x40b00100, 0x12345678 }, 10);
+            events.add (PacketX1 { 0x20801000 }, 20);
+            events.add (PacketX1 { 0x20e00040 }, 5);
+            events.add (PacketX1 { 0x20d00010 }, 10);
+            events.add (PacketX1 { 0x20a01020 }, 15);
+
+            expectEquals (events.getNumEvents(), 6);
+            expectEquals ((int) events.size(), 7);
+            expectEquals (events.getFirstEventTime(), 5);
+            expectEquals (events.getLastEventTime(), 20);
+
+            const std::vector<uint32_t> expectedWords { 0x20e00040, 0x20901040, 0x40b00100, 0x12345678,
+                                                        0x20d00010, 0x20a01020, 0x20801000 };
+            expect (std::equal (expectedWords.begin(), expectedWords.end(), events.data(), events.data() + events.size()));
+
+            const std::vector<int> expectedTimes { 5, 10, 10, 10, 15, 20 };
+            std::vector<int> times;
+
+            for (const auto event : events)
+                times.push_back (event.samplePosition);
+
+            expect (times == expectedTimes);
+
+            EventBuffer range;
+            range.addEvents (events, 10, 6, -10);
+
+            expectEquals (range.getNumEvents(), 4);
+            expectEquals (range.getFirstEventTime(), 0);
+            expectEquals (range.getLastEventTime(), 5);
+
+            events.clear();
+            expect (events.isEmpty());
+            expect (events.begin() == events.end());
+        }
+
+        beginTest ("EventBufferConverter converts between MidiBuffers and EventBuffers");
+        {
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 3);
+            midi.addEvent (MidiMessage::controllerEvent (2, 7, 64), 8);
+            midi.addEvent (createRandomSysEx (random, 100), 12);
+
+            EventBufferConverter eventConverter;
+            EventBuffer events;
+            eventConverter.toEventBuffer (midi, events);
+
+            expectEquals (events.getFirstEventTime(), 3);
+            expectEquals (events.getLastEventTime(), 12);
+            expect (Utils::getMessageType (events.data()[0]) == 0x4);
+
+            MidiBuffer result;
+            eventConverter.toMidiBuffer (events, result);
+
+            expect (equal (midi, result));
+        }
     }
 
 private:
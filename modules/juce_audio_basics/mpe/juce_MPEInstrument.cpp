@@ -48,6 +48,10 @@ MPEInstrument::MPEInstrument() noexcept
 
     resetLastReceivedValues();
 
+    notes.ensureStorageAllocated (maxNumNotes);
+    mpeInstrumentFill (noteIndices, (int16) -1);
+    mpeInstrumentFill (pendingDimensionChanges, (uint8) 0);
+
     legacyMode.channelRange = allChannels;
 }
 
@@ -92,6 +96,7 @@ void MPEInstrument::setZoneLayout (MPEZoneLayout newLayout)
     if (zoneLayout != newLayout)
     {
         zoneLayout = newLayout;
+        sendPendingExpressionChanges();
         listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
     }
 }
@@ -111,6 +116,7 @@ void MPEInstrument::enableLegacyMode (int pitchbendRange, Range<int> channelRang
     legacyMode.channelRange = channelRange;
 
     zoneLayout.clearAllZones();
+    sendPendingExpressionChanges();
     listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
 }
 
@@ -134,6 +140,7 @@ void MPEInstrument::setLegacyModeChannelRange (Range<int> channelRange)
     if (legacyMode.channelRange != channelRange)
     {
         legacyMode.channelRange = channelRange;
+        sendPendingExpressionChanges();
         listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
     }
 }
@@ -153,6 +160,7 @@ void MPEInstrument::setLegacyModePitchbendRange (int pitchbendRange)
     if (legacyMode.pitchbendRange != pitchbendRange)
     {
         legacyMode.pitchbendRange = pitchbendRange;
+        sendPendingExpressionChanges();
         listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
     }
 }
@@ -263,6 +271,8 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
     // in MPE mode, "reset all controllers" is per-zone and expected on the master channel;
     // in legacy mode, it is per MIDI channel (within the channel range used).
 
+    sendPendingExpressionChanges();
+
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
         for (int i = notes.size(); --i >= 0;)
@@ -273,8 +283,9 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+                invalidateChannelNotes (note.midiChannel);
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -291,8 +302,9 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+                invalidateChannelNotes (note.midiChannel);
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -342,6 +354,12 @@ void MPEInstrument::noteOn (int midiChannel,
     if (! isUsingChannel (midiChannel))
         return;
 
+    // note numbers must be 0-127!
+    jassert (isPositiveAndBelow (midiNoteNumber, 128));
+
+    if (! isPositiveAndBelow (midiNoteNumber, 128))
+        return;
+
     MPENote newNote (midiChannel,
                      midiNoteNumber,
                      midiNoteOnVelocity,
@@ -352,17 +370,19 @@ void MPEInstrument::noteOn (int midiChannel,
 
     const ScopedLock sl (lock);
     updateNoteTotalPitchbend (newNote);
+    sendPendingExpressionChanges();
 
     if (auto* alreadyPlayingNote = getNotePtr (midiChannel, midiNoteNumber))
     {
         // pathological case: second note-on received for same note -> retrigger it
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+        invalidateChannelNotes (midiChannel);
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        removeNote (noteIndices[(size_t) getNoteKey (midiChannel, midiNoteNumber)]);
     }
 
-    notes.add (newNote);
+    addNote (newNote);
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
 }
 
@@ -378,8 +398,11 @@ void MPEInstrument::noteOff (int midiChannel,
 
     if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
+        sendPendingExpressionChanges();
+
         note->keyState = (note->keyState == MPENote::keyDownAndSustained) ? MPENote::sustained : MPENote::off;
         note->noteOffVelocity = midiNoteOffVelocity;
+        invalidateChannelNotes (midiChannel);
 
         // If no more notes are playing on this channel in mpe mode, reset the dimension values
         if (! legacyMode.isEnabled && getLastNotePlayedPtr (midiChannel) == nullptr)
@@ -392,7 +415,7 @@ void MPEInstrument::noteOff (int midiChannel,
         if (note->keyState == MPENote::off)
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            removeNote (noteIndices[(size_t) getNoteKey (midiChannel, midiNoteNumber)]);
         }
         else
         {
@@ -424,16 +447,12 @@ void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValu
 {
     const ScopedLock sl (lock);
 
-    for (int i = notes.size(); --i >= 0;)
+    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-            && note.initialNote == midiNoteNumber
-            && pressureDimension.getValue (note) != value)
+        if (pressureDimension.getValue (*note) != value)
         {
-            pressureDimension.getValue (note) = value;
-            callListenersDimensionChanged (note, pressureDimension);
+            pressureDimension.getValue (*note) = value;
+            callListenersDimensionChanged (*note, pressureDimension);
         }
     }
 }
@@ -499,7 +518,7 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+            callListenersDimensionChanged (note, pitchbendDimension);
         }
         else if (dimension.getValue (note) != value)
         {
@@ -526,6 +545,21 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (const MPENote& note, const MPEDimension& dimension)
 {
+    if (isBatchingExpressionChanges)
+    {
+        const auto noteKey = getNoteKey (note);
+        auto& pendingChanges = pendingDimensionChanges[(size_t) noteKey];
+
+        if (pendingChanges == 0)
+        {
+            jassert (numNotesWithPendingChanges < maxNumNotes);
+            notesWithPendingChanges[(size_t) numNotesWithPendingChanges++] = (int16) noteKey;
+        }
+
+        pendingChanges |= (&dimension == &pressureDimension ? 1 : (&dimension == &pitchbendDimension ? 2 : 4));
+        return;
+    }
+
     if (&dimension == &pressureDimension)  { listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); }); return; }
     if (&dimension == &timbreDimension)    { listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); }); return; }
     if (&dimension == &pitchbendDimension) { listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); return; }
@@ -596,6 +630,8 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
     auto zone = (midiChannel == 1 ? zoneLayout.getLowerZone()
                                   : zoneLayout.getUpperZone());
 
+    sendPendingExpressionChanges();
+
     for (int i = notes.size(); --i >= 0;)
     {
         auto& note = notes.getReference (i);
@@ -609,10 +645,12 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             else if (note.keyState == MPENote::keyDownAndSustained && ! isDown)
                 note.keyState = MPENote::keyDown;
 
+            invalidateChannelNotes (note.midiChannel);
+
             if (note.keyState == MPENote::off)
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
             else
             {
@@ -727,15 +765,10 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || ! isPositiveAndBelow (midiNoteNumber, 128))
+        return nullptr;
 
-    return nullptr;
+    return getNoteForKey (getNoteKey (midiChannel, midiNoteNumber));
 }
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) noexcept
@@ -765,18 +798,11 @@ MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
-    const ScopedLock sl (lock);
-
-    for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
-            return &note;
-    }
-
-    return nullptr;
+    const ScopedLock sl (lock);
+    return getNoteForKey (getChannelNotes (midiChannel).lastPlayed);
 }
 
 MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
@@ -787,23 +813,10 @@ MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 {
-    int initialNoteMax = -1;
-    const MPENote* result = nullptr;
-
-    for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
-             && note.initialNote > initialNoteMax)
-        {
-            result = &note;
-            initialNoteMax = note.initialNote;
-        }
-    }
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
 
-    return result;
+    return getNoteForKey (getChannelNotes (midiChannel).highest);
 }
 
 MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
@@ -813,23 +826,10 @@ MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
 
 const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 {
-    int initialNoteMin = 128;
-    const MPENote* result = nullptr;
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
-             && note.initialNote < initialNoteMin)
-        {
-            result = &note;
-            initialNoteMin = note.initialNote;
-        }
-    }
-
-    return result;
+    return getNoteForKey (getChannelNotes (midiChannel).lowest);
 }
 
 MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) noexcept
@@ -841,16 +841,140 @@ MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) noexcept
 void MPEInstrument::releaseAllNotes()
 {
     const ScopedLock sl (lock);
+    sendPendingExpressionChanges();
 
     for (auto i = notes.size(); --i >= 0;)
     {
         auto& note = notes.getReference (i);
         note.keyState = MPENote::off;
         note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+        invalidateChannelNotes (note.midiChannel);
         listeners.call ([&] (Listener& l) { l.noteReleased (note); });
     }
 
-    notes.clear();
+    removeAllNotes();
+}
+
+//==============================================================================
+void MPEInstrument::beginExpressionChangeBatch()
+{
+    const ScopedLock sl (lock);
+
+    // this can't be nested!
+    jassert (! isBatchingExpressionChanges);
+    isBatchingExpressionChanges = true;
+}
+
+void MPEInstrument::endExpressionChangeBatch()
+{
+    const ScopedLock sl (lock);
+    isBatchingExpressionChanges = false;
+    sendPendingExpressionChanges();
+}
+
+void MPEInstrument::sendPendingExpressionChanges()
+{
+    // (the listeners might cause more changes, which will be added to the end of the list)
+    for (int i = 0; i < numNotesWithPendingChanges; ++i)
+    {
+        const auto noteKey = notesWithPendingChanges[(size_t) i];
+        const auto changes = std::exchange (pendingDimensionChanges[(size_t) noteKey], (uint8) 0);
+
+        if (auto* note = getNoteForKey (noteKey))
+        {
+            const auto changedNote = *note;
+
+            if ((changes & 1) != 0)  listeners.call ([&] (Listener& l) { l.notePressureChanged  (changedNote); });
+            if ((changes & 2) != 0)  listeners.call ([&] (Listener& l) { l.notePitchbendChanged (changedNote); });
+            if ((changes & 4) != 0)  listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (changedNote); });
+        }
+    }
+
+    numNotesWithPendingChanges = 0;
+}
+
+//==============================================================================
+void MPEInstrument::addNote (const MPENote& note)
+{
+    noteIndices[(size_t) getNoteKey (note)] = (int16) notes.size();
+    notes.add (note);
+    invalidateChannelNotes (note.midiChannel);
+}
+
+void MPEInstrument::removeNote (int index)
+{
+    const auto noteKey = getNoteKey (notes.getReference (index));
+    invalidateChannelNotes (notes.getReference (index).midiChannel);
+    notes.remove (index);
+
+    noteIndices[(size_t) noteKey] = -1;
+    pendingDimensionChanges[(size_t) noteKey] = 0;
+
+    // the notes after this one have all moved down
+    for (int i = index; i < notes.size(); ++i)
+        noteIndices[(size_t) getNoteKey (notes.getReference (i))] = (int16) i;
+}
+
+void MPEInstrument::removeAllNotes()
+{
+    for (auto& note : notes)
+    {
+        noteIndices[(size_t) getNoteKey (note)] = -1;
+        pendingDimensionChanges[(size_t) getNoteKey (note)] = 0;
+    }
+
+    notes.clearQuick();
+
+    for (auto& channel : channelNotes)
+        channel.isValid = false;
+}
+
+void MPEInstrument::invalidateChannelNotes (int midiChannel) noexcept
+{
+    channelNotes[(size_t) (midiChannel - 1)].isValid = false;
+}
+
+const MPEInstrument::ChannelNotes& MPEInstrument::getChannelNotes (int midiChannel) const noexcept
+{
+    auto& channel = channelNotes[(size_t) (midiChannel - 1)];
+
+    if (! channel.isValid)
+    {
+        channel = {};
+
+        for (auto i = notes.size(); --i >= 0;)
+        {
+            auto& note = notes.getReference (i);
+
+            if (note.midiChannel == midiChannel
+                 && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+            {
+                const auto noteKey = getNoteKey (note);
+
+                if (channel.lastPlayed < 0)
+                    channel.lastPlayed = noteKey;
+
+                if (channel.highest < 0 || noteKey > channel.highest)
+                    channel.highest = noteKey;
+
+                if (channel.lowest < 0 || noteKey < channel.lowest)
+                    channel.lowest = noteKey;
+            }
+        }
+
+        channel.isValid = true;
+    }
+
+    return channel;
+}
+
+const MPENote* MPEInstrument::getNoteForKey (int noteKey) const noexcept
+{
+    if (noteKey < 0)
+        return nullptr;
+
+    const auto index = noteIndices[(size_t) noteKey];
+    return index >= 0 ? &notes.getReference (index) : nullptr;
 }
 
 //==============================================================================
@@ -2193,6 +2317,95 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("expression change batching");
+        {
+            UnitTestInstrument test;
+            test.setZoneLayout (testLayout);
+
+            test.noteOn (3, 60, MPEValue::from7BitInt (100));
+            test.noteOn (4, 62, MPEValue::from7BitInt (100));
+
+            test.beginExpressionChangeBatch();
+
+            for (int i = 0; i < 10; ++i)
+            {
+                test.pitchbend (3, MPEValue::from14BitInt (1000 + i));
+                test.pressure (3, MPEValue::from7BitInt (10 + i));
+                test.timbre (4, MPEValue::from7BitInt (20 + i));
+            }
+
+            // the notes change straight away, but the callbacks are held back
+            expectNote (test.getNote (3, 60), 100, 19, 1009, 64, MPENote::keyDown);
+            expectNote (test.getNote (4, 62), 100, 0, 8192, 29, MPENote::keyDown);
+            expectEquals (test.notePitchbendChangedCallCounter, 0);
+            expectEquals (test.notePressureChangedCallCounter, 0);
+            expectEquals (test.noteTimbreChangedCallCounter, 0);
+
+            // other callbacks send the changes so far first
+            test.noteOff (4, 62, MPEValue::from7BitInt (64));
+            expectEquals (test.noteTimbreChangedCallCounter, 1);
+            expectEquals (test.noteReleasedCallCounter, 1);
+
+            test.pitchbend (3, MPEValue::from14BitInt (2000));
+            test.endExpressionChangeBatch();
+
+            expectEquals (test.notePitchbendChangedCallCounter, 2);
+            expectEquals (test.notePressureChangedCallCounter, 1);
+            expectEquals (test.noteTimbreChangedCallCounter, 1);
+
+            test.pitchbend (3, MPEValue::from14BitInt (3000));
+            expectEquals (test.notePitchbendChangedCallCounter, 3);
+        }
+
+        beginTest ("note lookups with many notes");
+        {
+            UnitTestInstrument test;
+            test.enableLegacyMode();
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                const auto channel = r.nextInt ({ 1, 5 });
+                const auto noteNumber = r.nextInt ({ 50, 70 });
+
+                switch (r.nextInt (6))
+                {
+                    case 0:   test.noteOff (channel, noteNumber, MPEValue::from7BitInt (64)); break;
+                    case 1:   test.sustainPedal (channel, r.nextBool()); break;
+                    case 2:   test.pitchbend (channel, MPEValue::from14BitInt (r.nextInt (16384))); break;
+                    default:  test.noteOn (channel, noteNumber, MPEValue::from7BitInt (100)); break;
+                }
+
+                // compare with searching through all the notes
+                for (int ch = 1; ch <= 4; ++ch)
+                {
+                    MPENote expectedMostRecent;
+
+                    for (int j = test.getNumPlayingNotes(); --j >= 0;)
+                    {
+                        const auto note = test.getNote (j);
+
+                        if (note.midiChannel == ch && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+                        {
+                            expectedMostRecent = note;
+                            break;
+                        }
+                    }
+
+                    const auto mostRecent = test.getMostRecentNote (ch);
+                    expect (mostRecent.isValid() == expectedMostRecent.isValid());
+                    expect (mostRecent.noteID == expectedMostRecent.noteID);
+                }
+
+                for (int j = 0; j < test.getNumPlayingNotes(); ++j)
+                {
+                    const auto note = test.getNote (j);
+                    expectEquals (test.getNote (note.midiChannel, note.initialNote).noteID, note.noteID);
+                }
+            }
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 
@@ -213,6 +213,29 @@ public:
     */
     void releaseAllNotes();
 
+    //==============================================================================
+    /** Starts collecting expression changes rather than sending them to the
+        listeners straight away.
+
+        Until endExpressionChangeBatch() is called, changes to the pressure, pitchbend
+        and timbre of the playing notes are applied to the notes immediately, but the
+        notePressureChanged(), notePitchbendChanged() and noteTimbreChanged() callbacks
+        are only made once for each note and dimension that changed, with the latest
+        value. Any other listener callback will first send the changes collected so far,
+        so the callbacks for a note always arrive in a sensible order.
+
+        This is useful when a burst of controller messages arrives between two blocks
+        of audio, where only the latest value of each dimension matters.
+
+        @see endExpressionChangeBatch, MPESynthesiserBase::setExpressionChangeBatchingEnabled
+    */
+    void beginExpressionChangeBatch();
+
+    /** Sends any expression changes that were collected since beginExpressionChangeBatch()
+        was called, and goes back to sending them to the listeners straight away.
+    */
+    void endExpressionChangeBatch();
+
     //==============================================================================
     /** Returns the number of MPE notes currently played by the instrument. */
     int getNumPlayingNotes() const noexcept;
@@ -361,7 +384,11 @@ protected:
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    // As there can only be one note for each channel and note number, this many
+    // notes can be stored without the list ever needing to be reallocated
+    static constexpr int maxNumNotes = 16 * 128;
+
+    Array<MPENote, DummyCriticalSection, maxNumNotes> notes;
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -384,9 +411,37 @@ private:
         MPEValue& getValue (MPENote& note) noexcept   { return note.*(value); }
     };
 
+    // The most recent, lowest and highest notes with their keys down on a channel,
+    // as note keys, or -1 for none
+    struct ChannelNotes
+    {
+        int lastPlayed = -1, lowest = -1, highest = -1;
+        bool isValid = false;
+    };
+
     LegacyMode legacyMode;
     MPEDimension pitchbendDimension, pressureDimension, timbreDimension;
 
+    // The index in the notes array of the note for each channel and note number
+    std::array<int16, maxNumNotes> noteIndices;
+    mutable std::array<ChannelNotes, 16> channelNotes;
+
+    std::array<uint8, maxNumNotes> pendingDimensionChanges;
+    std::array<int16, maxNumNotes> notesWithPendingChanges;
+    int numNotesWithPendingChanges = 0;
+    bool isBatchingExpressionChanges = false;
+
+    static int getNoteKey (int midiChannel, int midiNoteNumber) noexcept   { return (midiChannel - 1) * 128 + midiNoteNumber; }
+    static int getNoteKey (const MPENote& note) noexcept                  { return getNoteKey (note.midiChannel, note.initialNote); }
+
+    void addNote (const MPENote&);
+    void removeNote (int index);
+    void removeAllNotes();
+    void invalidateChannelNotes (int midiChannel) noexcept;
+    const ChannelNotes& getChannelNotes (int midiChannel) const noexcept;
+    const MPENote* getNoteForKey (int noteKey) const noexcept;
+    void sendPendingExpressionChanges();
+
     void resetLastReceivedValues();
 
     void updateDimension (int midiChannel, MPEDimension&, MPEValue);
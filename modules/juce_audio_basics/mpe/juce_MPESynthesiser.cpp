@@ -37,6 +37,11 @@ MPESynthesiser::~MPESynthesiser()
 }
 
 //==============================================================================
+static int getVoiceIndexKey (MPENote note) noexcept
+{
+    return note.noteID % detail::VoiceIndex::numKeys;
+}
+
 void MPESynthesiser::startVoice (MPESynthesiserVoice* voice, MPENote noteToStart)
 {
     jassert (voice != nullptr);
@@ -44,6 +49,9 @@ void MPESynthesiser::startVoice (MPESynthesiserVoice* voice, MPENote noteToStart
     voice->currentlyPlayingNote = noteToStart;
     voice->noteOnTime = lastNoteOnCounter++;
     voice->noteStarted();
+
+    if (canUseVoiceIndex() && voices[voice->indexInSynthesiser] == voice)
+        voiceIndex.voiceStarted (voice->indexInSynthesiser, getVoiceIndexKey (noteToStart), noteToStart.midiChannel - 1);
 }
 
 void MPESynthesiser::stopVoice (MPESynthesiserVoice* voice, MPENote noteToStop, bool allowTailOff)
@@ -52,6 +60,94 @@ void MPESynthesiser::stopVoice (MPESynthesiserVoice* voice, MPENote noteToStop,
 
     voice->currentlyPlayingNote = noteToStop;
     voice->noteStopped (allowTailOff);
+    markVoiceFreeIfFinished (voice);
+}
+
+//==============================================================================
+bool MPESynthesiser::canUseVoiceIndex() const noexcept
+{
+    return voiceIndex.getNumVoices() == voices.size();
+}
+
+void MPESynthesiser::rebuildVoiceIndex()
+{
+    voiceIndex.reset (voices.size());
+
+    std::vector<MPESynthesiserVoice*> activeVoices;
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->indexInSynthesiser = i;
+
+        if (voice->isActive())
+            activeVoices.push_back (voice);
+    }
+
+    std::sort (activeVoices.begin(), activeVoices.end(),
+               [] (const MPESynthesiserVoice* a, const MPESynthesiserVoice* b) { return a->noteOnTime < b->noteOnTime; });
+
+    for (auto* voice : activeVoices)
+        voiceIndex.voiceStarted (voice->indexInSynthesiser,
+                                 getVoiceIndexKey (voice->currentlyPlayingNote),
+                                 voice->currentlyPlayingNote.midiChannel - 1);
+}
+
+void MPESynthesiser::refreshFreeVoices()
+{
+    // Subclasses are allowed to change the voices array directly
+    if (! canUseVoiceIndex())
+    {
+        rebuildVoiceIndex();
+        return;
+    }
+
+    for (int i = 0; i < voices.size(); ++i)
+        if (! voiceIndex.isFree (i) && ! voices.getUnchecked (i)->isActive())
+            voiceIndex.setFree (i);
+}
+
+void MPESynthesiser::markVoiceFreeIfFinished (MPESynthesiserVoice* voice)
+{
+    if (canUseVoiceIndex() && voices[voice->indexInSynthesiser] == voice && ! voice->isActive())
+        voiceIndex.setFree (voice->indexInSynthesiser);
+}
+
+template <typename Fn>
+void MPESynthesiser::forEachVoicePlayingNote (MPENote note, Fn&& fn)
+{
+    if (! canUseVoiceIndex())
+    {
+        for (auto* voice : voices)
+            if (voice->isCurrentlyPlayingNote (note))
+                fn (voice);
+
+        return;
+    }
+
+    voiceIndex.forEachVoiceWithKey (getVoiceIndexKey (note), [&] (int i)
+    {
+        if (auto* voice = voices.getUnchecked (i); voice->isCurrentlyPlayingNote (note))
+            fn (voice);
+    });
+}
+
+template <typename Predicate>
+MPESynthesiserVoice* MPESynthesiser::findOldestVoice (Predicate&& predicate) const
+{
+    if (canUseVoiceIndex())
+    {
+        const auto index = voiceIndex.findOldestVoice ([&] (int i) { return predicate (voices.getUnchecked (i)); });
+        return index >= 0 ? voices.getUnchecked (index) : nullptr;
+    }
+
+    MPESynthesiserVoice* oldest = nullptr;
+
+    for (auto* voice : voices)
+        if ((oldest == nullptr || voice->noteOnTime < oldest->noteOnTime) && predicate (voice))
+            oldest = voice;
+
+    return oldest;
 }
 
 //==============================================================================
@@ -67,69 +163,54 @@ void MPESynthesiser::notePressureChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice* voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->notePressureChanged();
-        }
-    }
+        voice->currentlyPlayingNote = changedNote;
+        voice->notePressureChanged();
+    });
 }
 
 void MPESynthesiser::notePitchbendChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice* voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->notePitchbendChanged();
-        }
-    }
+        voice->currentlyPlayingNote = changedNote;
+        voice->notePitchbendChanged();
+    });
 }
 
 void MPESynthesiser::noteTimbreChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice* voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->noteTimbreChanged();
-        }
-    }
+        voice->currentlyPlayingNote = changedNote;
+        voice->noteTimbreChanged();
+    });
 }
 
 void MPESynthesiser::noteKeyStateChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice* voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->noteKeyStateChanged();
-        }
-    }
+        voice->currentlyPlayingNote = changedNote;
+        voice->noteKeyStateChanged();
+    });
 }
 
 void MPESynthesiser::noteReleased (MPENote finishedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto i = voices.size(); --i >= 0;)
+    forEachVoicePlayingNote (finishedNote, [&] (MPESynthesiserVoice* voice)
     {
-        auto* voice = voices.getUnchecked (i);
-
-        if (voice->isCurrentlyPlayingNote (finishedNote))
-            stopVoice (voice, finishedNote, true);
-    }
+        stopVoice (voice, finishedNote, true);
+    });
 }
 
 void MPESynthesiser::setCurrentPlaybackSampleRate (const double newRate)
@@ -158,6 +239,16 @@ MPESynthesiserVoice* MPESynthesiser::findFreeVoice (MPENote noteToFindVoiceFor,
 {
     const ScopedLock sl (voicesLock);
 
+    if (canUseVoiceIndex())
+    {
+        const auto index = voiceIndex.findFreeVoice ([this] (int i) { return ! voices.getUnchecked (i)->isActive(); });
+
+        if (index >= 0)
+            return voices.getUnchecked (index);
+    }
+
+    // Voices that have finished by themselves since they were last rendered won't
+    // have been marked as free yet
     for (auto* voice : voices)
     {
         if (! voice->isActive())
@@ -184,29 +275,10 @@ MPESynthesiserVoice* MPESynthesiser::findVoiceToSteal (MPENote noteToStealVoiceF
     MPESynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     MPESynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // All major OSes use double-locking so this will be lock- and wait-free as long as stealLock is not
-    // contended. This is always the case if you do not call findVoiceToSteal on multiple threads at
-    // the same time.
-    const ScopedLock sl (stealLock);
-
-    // this is a list of voices we can steal, sorted by how long they've been running
-    usableVoicesToStealArray.clear();
-
     for (auto* voice : voices)
     {
         jassert (voice->isActive()); // We wouldn't be here otherwise
 
-        usableVoicesToStealArray.add (voice);
-
-        // NB: Using a functor rather than a lambda here due to scare-stories about
-        // compilers generating code containing heap allocations..
-        struct Sorter
-        {
-            bool operator() (const MPESynthesiserVoice* a, const MPESynthesiserVoice* b) const noexcept { return a->noteOnTime < b->noteOnTime; }
-        };
-
-        std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
-
         if (! voice->isPlayingButReleased()) // Don't protect released notes
         {
             auto noteNumber = voice->getCurrentlyPlayingNote().initialNote;
@@ -226,26 +298,27 @@ MPESynthesiserVoice* MPESynthesiser::findVoiceToSteal (MPENote noteToStealVoiceF
     // If we want to re-use the voice to trigger a new note,
     // then The oldest note that's playing the same note number is ideal.
     if (noteToStealVoiceFor.isValid())
-        for (auto* voice : usableVoicesToStealArray)
-            if (voice->getCurrentlyPlayingNote().initialNote == noteToStealVoiceFor.initialNote)
-                return voice;
+        if (auto* voice = findOldestVoice ([&] (MPESynthesiserVoice* v) { return v->getCurrentlyPlayingNote().initialNote == noteToStealVoiceFor.initialNote; }))
+            return voice;
+
+    const auto isUnprotected = [low, top] (MPESynthesiserVoice* v) { return v != low && v != top; };
 
     // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (MPESynthesiserVoice* v) { return isUnprotected (v) && v->isPlayingButReleased(); }))
+        return voice;
 
     // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top
-             && voice->getCurrentlyPlayingNote().keyState != MPENote::keyDown
-             && voice->getCurrentlyPlayingNote().keyState != MPENote::keyDownAndSustained)
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (MPESynthesiserVoice* v)
+                                       {
+                                           return isUnprotected (v)
+                                               && v->getCurrentlyPlayingNote().keyState != MPENote::keyDown
+                                               && v->getCurrentlyPlayingNote().keyState != MPENote::keyDownAndSustained;
+                                       }))
+        return voice;
 
     // Oldest voice that isn't protected
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top)
-            return voice;
+    if (auto* voice = findOldestVoice (isUnprotected))
+        return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
     jassert (low != nullptr);
@@ -264,11 +337,7 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
         const ScopedLock sl (voicesLock);
         newVoice->setCurrentSampleRate (getSampleRate());
         voices.add (newVoice);
-    }
-
-    {
-        const ScopedLock sl (stealLock);
-        usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
+        rebuildVoiceIndex();
     }
 }
 
@@ -276,6 +345,7 @@ void MPESynthesiser::clearVoices()
 {
     const ScopedLock sl (voicesLock);
     voices.clear();
+    rebuildVoiceIndex();
 }
 
 MPESynthesiserVoice* MPESynthesiser::getVoice (const int index) const
@@ -288,6 +358,7 @@ void MPESynthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (voicesLock);
     voices.remove (index);
+    rebuildVoiceIndex();
 }
 
 void MPESynthesiser::reduceNumVoices (const int newNumVoices)
@@ -304,6 +375,8 @@ void MPESynthesiser::reduceNumVoices (const int newNumVoices)
         else
             voices.remove (0); // if there's no voice to steal, kill the oldest voice
     }
+
+    rebuildVoiceIndex();
 }
 
 void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
@@ -320,6 +393,8 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 
             voice->noteStopped (allowTailOff);
         }
+
+        refreshFreeVoices();
     }
 
     // finally make sure the MPE Instrument also doesn't have any notes anymore.
@@ -336,6 +411,8 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
         if (voice->isActive())
             voice->renderNextBlock (buffer, startSample, numSamples);
     }
+
+    refreshFreeVoices();
 }
 
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
@@ -347,6 +424,8 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
         if (voice->isActive())
             voice->renderNextBlock (buffer, startSample, numSamples);
     }
+
+    refreshFreeVoices();
 }
 
 } // namespace juce
@@ -304,8 +304,18 @@ private:
     //==============================================================================
     std::atomic<bool> shouldStealVoices { false };
     uint32 lastNoteOnCounter = 0;
-    mutable CriticalSection stealLock;
-    mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
+    detail::VoiceIndex voiceIndex;
+
+    bool canUseVoiceIndex() const noexcept;
+    void rebuildVoiceIndex();
+    void refreshFreeVoices();
+    void markVoiceFreeIfFinished (MPESynthesiserVoice*);
+
+    template <typename Fn>
+    void forEachVoicePlayingNote (MPENote, Fn&&);
+
+    template <typename Predicate>
+    MPESynthesiserVoice* findOldestVoice (Predicate&&) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
@@ -114,6 +114,20 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
     auto prevSample = startSample;
     const auto endSample = startSample + numSamples;
 
+    const auto renderSubBlock = [&] (int subBlockStart, int subBlockLength)
+    {
+        if (batchExpressionChanges)
+            instrument.endExpressionChangeBatch();
+
+        renderNextSubBlock (outputAudio, subBlockStart, subBlockLength);
+
+        if (batchExpressionChanges)
+            instrument.beginExpressionChangeBatch();
+    };
+
+    if (batchExpressionChanges)
+        instrument.beginExpressionChangeBatch();
+
     for (auto it = inputMidi.findNextSamplePosition (startSample); it != inputMidi.cend(); ++it)
     {
         const auto metadata = *it;
@@ -126,7 +140,7 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
 
         if (metadata.samplePosition >= prevSample + thisBlockSize)
         {
-            renderNextSubBlock (outputAudio, prevSample, metadata.samplePosition - prevSample);
+            renderSubBlock (prevSample, metadata.samplePosition - prevSample);
             prevSample = metadata.samplePosition;
         }
 
@@ -134,7 +148,10 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
     }
 
     if (prevSample < endSample)
-        renderNextSubBlock (outputAudio, prevSample, endSample - prevSample);
+        renderSubBlock (prevSample, endSample - prevSample);
+
+    if (batchExpressionChanges)
+        instrument.endExpressionChangeBatch();
 }
 
 // explicit instantiation for supported float types:
@@ -160,6 +177,12 @@ void MPESynthesiserBase::setMinimumRenderingSubdivisionSize (int numSamples, boo
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void MPESynthesiserBase::setExpressionChangeBatchingEnabled (bool shouldBatchChanges) noexcept
+{
+    const ScopedLock sl (noteStateLock);
+    batchExpressionChanges = shouldBatchChanges;
+}
+
 #if JUCE_UNIT_TESTS
 
 namespace
@@ -139,6 +139,20 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Enables or disables batching of expression changes when rendering.
+
+        When this is enabled, renderNextBlock() collects the pressure, pitchbend and timbre
+        changes for all the MIDI messages before each audio sub-block, and the note listener
+        callbacks are made once per note and dimension with the latest value, just before
+        the sub-block is rendered. This can save a lot of work when there are many expression
+        messages between sub-blocks, as only the latest values affect the rendered audio.
+
+        The default is false, so that a callback is made for every change.
+
+        @see MPEInstrument::beginExpressionChangeBatch
+    */
+    void setExpressionChangeBatchingEnabled (bool shouldBatchChanges) noexcept;
+
     //==============================================================================
     /** Puts the synthesiser into legacy mode.
 
@@ -209,6 +223,7 @@ private:
     double sampleRate = 0.0;
     int minimumSubBlockSize = 32;
     bool subBlockSubdivisionIsStrict = false;
+    bool batchExpressionChanges = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserBase)
 };
@@ -185,6 +185,8 @@ private:
     //==============================================================================
     friend class MPESynthesiser;
 
+    int indexInSynthesiser = -1;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserVoice)
 };
 
@@ -0,0 +1,455 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioStreamingEngine::SourceInfo
+{
+    explicit SourceInfo (BufferingAudioSource& s)  : source (s) {}
+
+    BufferingAudioSource& source;
+    Worker* worker = nullptr;           // the thread that's reading from the source, if any
+    int bufferSize = 0;
+    double slowestReadSeconds = 0;      // a peak of the recent read times, which decays over time
+    uint32 lastReadTime = 0, nextCheckTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (SourceInfo)
+};
+
+//==============================================================================
+class AudioStreamingEngine::Worker  : public Thread
+{
+public:
+    Worker (AudioStreamingEngine& e, int index)
+        : Thread ("Audio streaming " + String (index + 1)), engine (e)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread (10000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! engine.readMostUrgentSource (*this))
+                engine.sourcesNeedReading.wait (5);
+    }
+
+private:
+    AudioStreamingEngine& engine;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+AudioStreamingEngine::AudioStreamingEngine()
+    : AudioStreamingEngine (Options())
+{
+}
+
+AudioStreamingEngine::AudioStreamingEngine (const Options& o)
+    : options (o)
+{
+    jassert (options.numThreads > 0);
+    jassert (options.minimumReadAheadSeconds > 0 && options.maximumReadAheadSeconds >= options.minimumReadAheadSeconds);
+
+    for (int i = 0; i < jmax (1, options.numThreads); ++i)
+        workers.add (new Worker (*this, i))->startThread (options.threadPriority);
+}
+
+AudioStreamingEngine::~AudioStreamingEngine()
+{
+    // All the BufferingAudioSources using this engine must be deleted before it is!
+    jassert (sources.isEmpty());
+
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    workers.clear();
+}
+
+int AudioStreamingEngine::getNumSources() const
+{
+    const ScopedLock sl (lock);
+    return sources.size();
+}
+
+size_t AudioStreamingEngine::getMemoryInUse() const
+{
+    const ScopedLock sl (lock);
+    size_t total = 0;
+
+    for (auto* info : sources)
+        total += (size_t) info->bufferSize * (size_t) info->source.numberOfChannels * sizeof (float);
+
+    return total;
+}
+
+//==============================================================================
+void AudioStreamingEngine::addSource (BufferingAudioSource& source)
+{
+    {
+        const ScopedLock sl (lock);
+
+        for (auto* info : sources)
+            if (&info->source == &source)
+                return;
+
+        auto* info = sources.add (new SourceInfo (source));
+        info->bufferSize = source.buffer.getNumSamples();
+        info->lastReadTime = Time::getMillisecondCounter();
+    }
+
+    sourcesNeedReading.signal();
+}
+
+void AudioStreamingEngine::removeSource (BufferingAudioSource& source)
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            auto* info = [&]() -> SourceInfo*
+            {
+                for (auto* i : sources)
+                    if (&i->source == &source)
+                        return i;
+
+                return nullptr;
+            }();
+
+            if (info == nullptr)
+                return;
+
+            if (info->worker == nullptr)
+            {
+                sources.removeObject (info);
+                return;
+            }
+        }
+
+        // One of the threads is reading from this source, so it can't go until that's finished
+        Thread::yield();
+    }
+}
+
+void AudioStreamingEngine::sourceNeedsReading()
+{
+    sourcesNeedReading.signal();
+}
+
+int AudioStreamingEngine::getInitialBufferSize (int samplesPerBlock, double sampleRate) const
+{
+    return jmax (jmax (samplesPerBlock * 4, 4096), roundToInt (options.minimumReadAheadSeconds * sampleRate));
+}
+
+int AudioStreamingEngine::getMinimumBufferSize (const BufferingAudioSource& source) const
+{
+    return jmax (source.samplesPerBlock * 4, 4096);
+}
+
+int AudioStreamingEngine::getWantedBufferSize (const SourceInfo& info) const
+{
+    const auto readAheadSeconds = jlimit (options.minimumReadAheadSeconds,
+                                          options.maximumReadAheadSeconds,
+                                          info.slowestReadSeconds * options.latencySafetyFactor);
+
+    return jmax (getMinimumBufferSize (info.source), roundToInt (readAheadSeconds * info.source.sampleRate));
+}
+
+double AudioStreamingEngine::getSecondsUntilBufferRunsOut (const BufferingAudioSource& source, uint32 now) const
+{
+    const ScopedLock sl (source.bufferRangeLock);
+
+    const auto pos = jmax ((int64) 0, source.nextPlayPos.load());
+    const auto start = source.bufferValidStart, end = source.bufferValidEnd;
+    const auto isInBuffer = pos >= start && pos < end;
+
+    // This matches the test in BufferingAudioSource::readNextBufferChunk()
+    const auto needsReading = ! isInBuffer
+                               || pos - start > 512
+                               || (pos + source.buffer.getNumSamples() - 4) - end > 512;
+
+    if (! needsReading)
+        return -1.0;
+
+    const auto secondsBuffered = isInBuffer ? (double) (end - pos) / source.sampleRate : 0.0;
+    const auto isPlaying = now - source.lastPlaybackTime.load() < 500;
+
+    // A source that isn't playing is treated as though it already had the minimum
+    // amount buffered, so it only gets ahead of a playing one that is close to running out.
+    return isPlaying ? secondsBuffered
+                     : secondsBuffered + options.minimumReadAheadSeconds;
+}
+
+bool AudioStreamingEngine::readMostUrgentSource (Worker& worker)
+{
+    SourceInfo* info = nullptr;
+    int newBufferSize = 0;
+
+    {
+        const ScopedLock sl (lock);
+        const auto now = Time::getMillisecondCounter();
+
+        // When the buffers ask for more than the budget, each gets the same share of what it wanted
+        double bytesWanted = 0;
+
+        for (auto* i : sources)
+            bytesWanted += (double) getWantedBufferSize (*i) * (double) i->source.numberOfChannels * sizeof (float);
+
+        const auto budget = (double) options.memoryBudgetBytes;
+        const auto budgetScale = bytesWanted > budget ? budget / bytesWanted : 1.0;
+
+        auto soonestDeadline = std::numeric_limits<double>::max();
+
+        for (auto* i : sources)
+        {
+            if (i->worker != nullptr || (int) (i->nextCheckTime - now) > 0)
+                continue;
+
+            const auto deadline = getSecondsUntilBufferRunsOut (i->source, now);
+
+            if (deadline >= 0 && deadline < soonestDeadline)
+            {
+                soonestDeadline = deadline;
+                info = i;
+            }
+        }
+
+        if (info == nullptr)
+            return false;
+
+        info->worker = &worker;
+
+        const auto targetSize = jmax (getMinimumBufferSize (info->source),
+                                      roundToInt (getWantedBufferSize (*info) * budgetScale));
+
+        // Small changes aren't worth the cost of moving the buffered audio
+        if (std::abs (targetSize - info->bufferSize) > info->bufferSize / 4)
+            newBufferSize = targetSize;
+    }
+
+    if (newBufferSize > 0)
+        info->source.resizeBuffer (newBufferSize);
+
+    const auto startTime = Time::getMillisecondCounterHiRes();
+    const auto didRead = info->source.readNextBufferChunk();
+    const auto secondsTaken = (Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+    {
+        const ScopedLock sl (lock);
+        const auto now = Time::getMillisecondCounter();
+
+        if (newBufferSize > 0)
+            info->bufferSize = newBufferSize;
+
+        if (didRead)
+        {
+            // The peak halves every ten seconds, so that one slow read doesn't inflate the buffer for ever
+            const auto decay = std::pow (0.5, (double) (now - info->lastReadTime) / 10000.0);
+            info->slowestReadSeconds = jmax (secondsTaken, info->slowestReadSeconds * decay);
+            info->lastReadTime = now;
+        }
+        else
+        {
+            info->nextCheckTime = now + 10;
+        }
+
+        info->worker = nullptr;
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioStreamingEngineTests  : public UnitTest
+{
+public:
+    AudioStreamingEngineTests()
+        : UnitTest ("AudioStreamingEngine", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Sources read through an engine play back their audio unchanged");
+        {
+            AudioStreamingEngine::Options options;
+            options.numThreads = 3;
+            AudioStreamingEngine engine (options);
+
+            OwnedArray<AudioBuffer<float>> contents;
+            OwnedArray<BufferingAudioSource> sources;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                auto* content = contents.add (createRamp (2, 44100 * 2, (float) i));
+                sources.add (new BufferingAudioSource (new MemoryAudioSource (*content, false), engine, true));
+                sources.getLast()->prepareToPlay (blockSize, sampleRate);
+            }
+
+            expectEquals (engine.getNumSources(), 8);
+
+            AudioBuffer<float> block (2, blockSize);
+            auto allMatched = true;
+
+            for (int pos = 0; pos + blockSize <= contents[0]->getNumSamples(); pos += blockSize)
+            {
+                for (int i = 0; i < sources.size(); ++i)
+                {
+                    const AudioSourceChannelInfo info (block);
+                    expect (sources[i]->waitForNextAudioBlockReady (info, 2000));
+                    sources[i]->getNextAudioBlock (info);
+
+                    allMatched = allMatched && matches (block, *contents[i], pos);
+                }
+            }
+
+            expect (allMatched);
+
+            sources.clear();
+            expectEquals (engine.getNumSources(), 0);
+        }
+
+        beginTest ("The buffers are shrunk to fit the memory budget");
+        {
+            AudioStreamingEngine::Options options;
+            options.memoryBudgetBytes = 1024 * 1024;
+            AudioStreamingEngine engine (options);
+
+            AudioBuffer<float> content (1, 44100 * 3);
+            content.clear();
+
+            OwnedArray<BufferingAudioSource> sources;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                sources.add (new BufferingAudioSource (new MemoryAudioSource (content, false), engine, true, 1));
+                sources.getLast()->prepareToPlay (blockSize, sampleRate);
+            }
+
+            // 20 sources with half a second each would need over 1.7MB
+            expectGreaterThan (engine.getMemoryInUse(), options.memoryBudgetBytes);
+
+            play (sources, 1);
+            expectLessOrEqual (engine.getMemoryInUse(), options.memoryBudgetBytes + options.memoryBudgetBytes / 20);
+        }
+
+        beginTest ("A source that is slow to read gets a longer read-ahead");
+        {
+            AudioStreamingEngine::Options options;
+            options.minimumReadAheadSeconds = 0.1;
+
+            AudioBuffer<float> content (1, 44100 * 4);
+            content.clear();
+
+            size_t memoryUsed[2];
+
+            for (int slowness = 0; slowness < 2; ++slowness)
+            {
+                AudioStreamingEngine engine (options);
+                OwnedArray<BufferingAudioSource> sources;
+
+                sources.add (new BufferingAudioSource (new SlowSource (content, slowness * 30), engine, true, 1));
+                sources.getLast()->prepareToPlay (blockSize, sampleRate);
+
+                play (sources, 1);
+                memoryUsed[slowness] = engine.getMemoryInUse();
+            }
+
+            // Reads of 30ms need about 0.3 seconds of read-ahead, rather than the minimum of 0.1
+            expectGreaterThan (memoryUsed[1], memoryUsed[0] * 2);
+        }
+    }
+
+private:
+    static constexpr int blockSize = 512;
+    static constexpr double sampleRate = 44100.0;
+
+    struct SlowSource  : public MemoryAudioSource
+    {
+        SlowSource (AudioBuffer<float>& content, int msPerRead)
+            : MemoryAudioSource (content, false), delay (msPerRead)
+        {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            Thread::sleep (delay);
+            MemoryAudioSource::getNextAudioBlock (info);
+        }
+
+        const int delay;
+    };
+
+    static AudioBuffer<float>* createRamp (int numChannels, int numSamples, float offset)
+    {
+        auto* buffer = new AudioBuffer<float> (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                buffer->setSample (chan, i, offset + (float) chan * 0.5f + (float) i * 1.0e-5f);
+
+        return buffer;
+    }
+
+    static bool matches (const AudioBuffer<float>& block, const AudioBuffer<float>& content, int position)
+    {
+        for (int chan = 0; chan < block.getNumChannels(); ++chan)
+            for (int i = 0; i < block.getNumSamples(); ++i)
+                if (block.getSample (chan, i) != content.getSample (chan, position + i))
+                    return false;
+
+        return true;
+    }
+
+    // Plays each source in real time, so that the engine can see which ones are playing
+    static void play (OwnedArray<BufferingAudioSource>& sources, int seconds)
+    {
+        AudioBuffer<float> block (2, blockSize);
+        const auto numBlocks = roundToInt (seconds * sampleRate / blockSize);
+        const auto startTime = Time::getMillisecondCounterHiRes();
+
+        for (int n = 0; n < numBlocks; ++n)
+        {
+            for (auto* source : sources)
+                source->getNextAudioBlock (AudioSourceChannelInfo (block));
+
+            const auto blockEndTime = startTime + (n + 1) * blockSize * 1000.0 / sampleRate;
+            const auto timeLeft = blockEndTime - Time::getMillisecondCounterHiRes();
+
+            if (timeLeft > 1.0)
+                Thread::sleep ((int) timeLeft);
+        }
+    }
+};
+
+static AudioStreamingEngineTests audioStreamingEngineTests;
+
+#endif
+
+} // namespace juce
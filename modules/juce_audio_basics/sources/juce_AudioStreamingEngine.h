@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads ahead for a large number of BufferingAudioSources using a pool of threads.
+
+    A TimeSliceThread gives each of its clients a turn in order, and each
+    BufferingAudioSource that uses one holds a buffer of a fixed size. With hundreds of
+    sources, that wastes memory on the ones that are idle while the ones that are playing
+    wait their turn behind them. An AudioStreamingEngine instead:
+
+    - always reads next for the source whose buffered audio will run out soonest, with
+      sources that are playing taking priority over ones that are stopped,
+    - reads with several threads, so that a slow read doesn't hold up every other source,
+    - measures how long each source takes to read, and sizes its buffer to cover a
+      multiple of the slowest recent reads, within the limits set in the Options,
+    - keeps the total memory used by all the buffers within a budget, shrinking every
+      buffer in proportion when there isn't enough to go round.
+
+    To use it, create a BufferingAudioSource with the constructor that takes an
+    AudioStreamingEngine. The engine must outlive all the sources that use it.
+
+    @see BufferingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioStreamingEngine
+{
+public:
+    //==============================================================================
+    /** The settings for an AudioStreamingEngine. */
+    struct Options
+    {
+        /** The number of threads that read from the sources. */
+        int numThreads = 2;
+
+        /** The most memory, in bytes, that the buffers of all the sources may use between them. */
+        size_t memoryBudgetBytes = (size_t) 256 * 1024 * 1024;
+
+        /** The shortest and longest amounts of audio, in seconds, that a source will buffer. */
+        double minimumReadAheadSeconds = 0.5, maximumReadAheadSeconds = 10.0;
+
+        /** How many times longer than its slowest recent read a source's read-ahead should be. */
+        double latencySafetyFactor = 10.0;
+
+        /** The priority of the reading threads. */
+        Thread::Priority threadPriority = Thread::Priority::high;
+    };
+
+    /** Creates an engine with the default Options. */
+    AudioStreamingEngine();
+
+    /** Creates an engine with some custom Options. */
+    explicit AudioStreamingEngine (const Options& options);
+
+    /** Destructor.
+
+        All the BufferingAudioSources using this engine must have been deleted first.
+    */
+    ~AudioStreamingEngine();
+
+    //==============================================================================
+    /** Returns the options that the engine was created with. */
+    const Options& getOptions() const noexcept          { return options; }
+
+    /** Returns the number of sources that are being read ahead at the moment. */
+    int getNumSources() const;
+
+    /** Returns the number of bytes currently used by the buffers of all the sources. */
+    size_t getMemoryInUse() const;
+
+private:
+    //==============================================================================
+    friend class BufferingAudioSource;
+
+    class Worker;
+    struct SourceInfo;
+
+    void addSource (BufferingAudioSource&);
+    void removeSource (BufferingAudioSource&);
+    void sourceNeedsReading();
+    int getInitialBufferSize (int samplesPerBlock, double sampleRate) const;
+    int getMinimumBufferSize (const BufferingAudioSource&) const;
+    int getWantedBufferSize (const SourceInfo&) const;
+    double getSecondsUntilBufferRunsOut (const BufferingAudioSource&, uint32 now) const;
+    bool readMostUrgentSource (Worker&);
+
+    Options options;
+    OwnedArray<Worker> workers;
+    OwnedArray<SourceInfo> sources;
+    CriticalSection lock;
+    WaitableEvent sourcesNeedReading;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioStreamingEngine)
+};
+
+} // namespace juce
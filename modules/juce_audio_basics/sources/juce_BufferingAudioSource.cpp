@@ -30,7 +30,7 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             int numChannels,
                                             bool prefillBufferOnPrepareToPlay)
     : source (s, deleteSourceWhenDeleted),
-      backgroundThread (thread),
+      backgroundThread (&thread),
       numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
       numberOfChannels (numChannels),
       prefillBuffer (prefillBufferOnPrepareToPlay)
@@ -41,6 +41,20 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                               //  not using a larger buffer..
 }
 
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            AudioStreamingEngine& engine,
+                                            bool deleteSourceWhenDeleted,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
+    : source (s, deleteSourceWhenDeleted),
+      streamingEngine (&engine),
+      numberOfSamplesToBuffer (0),
+      numberOfChannels (numChannels),
+      prefillBuffer (prefillBufferOnPrepareToPlay)
+{
+    jassert (source != nullptr);
+}
+
 BufferingAudioSource::~BufferingAudioSource()
 {
     releaseResources();
@@ -51,17 +65,25 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 {
     auto bufferSizeNeeded = jmax (samplesPerBlockExpected * 2, numberOfSamplesToBuffer);
 
+    // An engine resizes the buffer as it goes, so only a change of settings means starting again
+    auto bufferNeedsReallocating = streamingEngine != nullptr ? samplesPerBlockExpected != samplesPerBlock
+                                                              : bufferSizeNeeded != buffer.getNumSamples();
+
     if (newSampleRate != sampleRate
-         || bufferSizeNeeded != buffer.getNumSamples()
+         || bufferNeedsReallocating
          || ! isPrepared)
     {
-        backgroundThread.removeTimeSliceClient (this);
+        stopReadingAhead();
 
         isPrepared = true;
         sampleRate = newSampleRate;
+        samplesPerBlock = samplesPerBlockExpected;
 
         source->prepareToPlay (samplesPerBlockExpected, newSampleRate);
 
+        if (streamingEngine != nullptr)
+            bufferSizeNeeded = streamingEngine->getInitialBufferSize (samplesPerBlockExpected, newSampleRate);
+
         buffer.setSize (numberOfChannels, bufferSizeNeeded);
         buffer.clear();
 
@@ -70,13 +92,18 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         bufferValidStart = 0;
         bufferValidEnd = 0;
 
-        backgroundThread.addTimeSliceClient (this);
+        {
+            const ScopedUnlock ul (bufferRangeLock);
+            startReadingAhead();
+        }
 
         do
         {
             const ScopedUnlock ul (bufferRangeLock);
 
-            backgroundThread.moveToFrontOfQueue (this);
+            if (backgroundThread != nullptr)
+                backgroundThread->moveToFrontOfQueue (this);
+
             Thread::sleep (5);
         }
         while (prefillBuffer
@@ -84,10 +111,26 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
     }
 }
 
+void BufferingAudioSource::startReadingAhead()
+{
+    if (streamingEngine != nullptr)
+        streamingEngine->addSource (*this);
+    else
+        backgroundThread->addTimeSliceClient (this);
+}
+
+void BufferingAudioSource::stopReadingAhead()
+{
+    if (streamingEngine != nullptr)
+        streamingEngine->removeSource (*this);
+    else
+        backgroundThread->removeTimeSliceClient (this);
+}
+
 void BufferingAudioSource::releaseResources()
 {
     isPrepared = false;
-    backgroundThread.removeTimeSliceClient (this);
+    stopReadingAhead();
 
     buffer.setSize (numberOfChannels, 0);
 
@@ -100,6 +143,12 @@ void BufferingAudioSource::releaseResources()
 
 void BufferingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
+    lastPlaybackTime = Time::getMillisecondCounter();
+
+    // (This is taken first so that an engine can't resize the buffer between finding
+    // the valid range and copying from it)
+    const ScopedLock sl (callbackLock);
+
     const auto bufferRange = getValidBufferRange (info.numSamples);
 
     if (bufferRange.isEmpty())
@@ -112,8 +161,6 @@ void BufferingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     const auto validStart = bufferRange.getStart();
     const auto validEnd = bufferRange.getEnd();
 
-    const ScopedLock sl (callbackLock);
-
     if (validStart > 0)
         info.buffer->clear (info.startSample, validStart);  // partial cache miss at start
 
@@ -215,7 +262,11 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     const ScopedLock sl (bufferRangeLock);
 
     nextPlayPos = newPosition;
-    backgroundThread.moveToFrontOfQueue (this);
+
+    if (streamingEngine != nullptr)
+        streamingEngine->sourceNeedsReading();
+    else
+        backgroundThread->moveToFrontOfQueue (this);
 }
 
 Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
@@ -247,7 +298,8 @@ bool BufferingAudioSource::readNextBufferChunk()
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
+        // An engine can read bigger chunks, as it doesn't hold the callback lock while reading
+        const int maxChunkSize = streamingEngine != nullptr ? jmax (2048, buffer.getNumSamples() / 8) : 2048;
 
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
@@ -317,10 +369,52 @@ void BufferingAudioSource::readBufferSection (int64 start, int length, int buffe
 
     AudioSourceChannelInfo info (&buffer, bufferOffset, length);
 
+    // The section being read is outside the range that getNextAudioBlock() copies from,
+    // and an engine never resizes a buffer while it's reading into it, so the audio
+    // thread doesn't need to wait for the read to finish.
+    if (streamingEngine != nullptr)
+    {
+        source->getNextAudioBlock (info);
+        return;
+    }
+
     const ScopedLock sl (callbackLock);
     source->getNextAudioBlock (info);
 }
 
+void BufferingAudioSource::resizeBuffer (int newSize)
+{
+    AudioBuffer<float> newBuffer (numberOfChannels, newSize);
+    newBuffer.clear();
+
+    {
+        const ScopedLock sl (callbackLock);
+        const ScopedLock sl2 (bufferRangeLock);
+
+        // Keep as much of the audio after the play position as will fit
+        const auto start = jlimit (bufferValidStart, bufferValidEnd, nextPlayPos.load());
+        const auto end = jmin (bufferValidEnd, start + newSize - 4);
+        const auto oldSize = buffer.getNumSamples();
+
+        for (auto pos = start; pos < end;)
+        {
+            const auto oldIndex = (int) (pos % oldSize);
+            const auto newIndex = (int) (pos % newSize);
+            const auto numToCopy = (int) jmin (end - pos, (int64) (oldSize - oldIndex), (int64) (newSize - newIndex));
+
+            for (int chan = 0; chan < numberOfChannels; ++chan)
+                newBuffer.copyFrom (chan, newIndex, buffer, chan, oldIndex, numToCopy);
+
+            pos += numToCopy;
+        }
+
+        bufferValidStart = start < end ? start : 0;
+        bufferValidEnd = start < end ? end : 0;
+
+        std::swap (buffer, newBuffer);
+    }
+}
+
 int BufferingAudioSource::useTimeSlice()
 {
     return readNextBufferChunk() ? 1 : 100;
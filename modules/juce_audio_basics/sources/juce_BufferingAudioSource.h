@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class AudioStreamingEngine;
+
 //==============================================================================
 /**
     An AudioSource which takes another source as input, and buffers it using a thread.
@@ -31,7 +33,11 @@ namespace juce
     a background thread to smooth out playback. You can either create one of these
     directly, or use it indirectly using an AudioTransportSource.
 
-    @see PositionableAudioSource, AudioTransportSource
+    The read-ahead can be done either by a TimeSliceThread with a buffer of a fixed
+    size, or by an AudioStreamingEngine, which picks the size of each source's buffer
+    and reads first for the sources that are closest to running out.
+
+    @see PositionableAudioSource, AudioTransportSource, AudioStreamingEngine
 
     @tags{Audio}
 */
@@ -61,6 +67,27 @@ public:
                           int numberOfChannels = 2,
                           bool prefillBufferOnPrepareToPlay = true);
 
+    /** Creates a BufferingAudioSource that is read ahead by an AudioStreamingEngine.
+
+        Rather than using a buffer of a fixed size, the engine decides how much of the
+        source to hold from the read latency it observes and its memory budget.
+
+        @param source                       the input source to read from
+        @param streamingEngine              the engine that will read ahead. This object must not
+                                            be deleted until after any BufferingAudioSources that
+                                            are using it have been deleted!
+        @param deleteSourceWhenDeleted      if true, then the input source object will
+                                            be deleted when this object is deleted
+        @param numberOfChannels             the number of channels that will be played
+        @param prefillBufferOnPrepareToPlay if true, then calling prepareToPlay on this object will
+                                            block until the buffer has been filled
+    */
+    BufferingAudioSource (PositionableAudioSource* source,
+                          AudioStreamingEngine& streamingEngine,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfChannels = 2,
+                          bool prefillBufferOnPrepareToPlay = true);
+
     /** Destructor.
 
         The input source may be deleted depending on whether the deleteSourceWhenDeleted
@@ -99,20 +126,27 @@ public:
 
 private:
     //==============================================================================
+    friend class AudioStreamingEngine;
+
     Range<int> getValidBufferRange (int numSamples) const;
     bool readNextBufferChunk();
     void readBufferSection (int64 start, int length, int bufferOffset);
     int useTimeSlice() override;
+    void startReadingAhead();
+    void stopReadingAhead();
+    void resizeBuffer (int newSize);
 
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
-    TimeSliceThread& backgroundThread;
-    int numberOfSamplesToBuffer, numberOfChannels;
+    TimeSliceThread* backgroundThread = nullptr;
+    AudioStreamingEngine* streamingEngine = nullptr;
+    int numberOfSamplesToBuffer, numberOfChannels, samplesPerBlock = 0;
     AudioBuffer<float> buffer;
     CriticalSection callbackLock, bufferRangeLock;
     WaitableEvent bufferReadyEvent;
     int64 bufferValidStart = 0, bufferValidEnd = 0;
     std::atomic<int64> nextPlayPos { 0 };
+    std::atomic<uint32> lastPlaybackTime { 0 };
     double sampleRate = 0;
     bool wasSourceLooping = false, isPrepared = false;
     const bool prefillBuffer;
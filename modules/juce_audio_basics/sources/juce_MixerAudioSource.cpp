@@ -54,6 +54,7 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
 
         inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
         inputs.add (input);
+        publishInputs();
     }
 }
 
@@ -75,6 +76,7 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 
             inputsToDelete.shiftBits (-1, index);
             inputs.remove (index);
+            publishInputs();
         }
 
         input->releaseResources();
@@ -93,6 +95,7 @@ void MixerAudioSource::removeAllInputs()
                 toDelete.add (inputs.getUnchecked(i));
 
         inputs.clear();
+        publishInputs();
     }
 
     for (int i = toDelete.size(); --i >= 0;)
@@ -125,24 +128,32 @@ void MixerAudioSource::releaseResources()
     bufferSizeExpected = 0;
 }
 
+void MixerAudioSource::publishInputs()
+{
+    // Called with the lock held. This returns once the audio thread has stopped using
+    // the previous list.
+    realtimeInputs.reset (std::make_unique<Array<AudioSource*>> (inputs));
+}
+
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (lock);
+    const ReadCopyUpdatePointer<Array<AudioSource*>>::ScopedReader activeInputs (realtimeInputs);
 
-    if (inputs.size() > 0)
+    if (activeInputs != nullptr && ! activeInputs->isEmpty())
     {
-        inputs.getUnchecked(0)->getNextAudioBlock (info);
+        auto& sources = *activeInputs;
+        sources.getUnchecked(0)->getNextAudioBlock (info);
 
-        if (inputs.size() > 1)
+        if (sources.size() > 1)
         {
             tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
                                 info.buffer->getNumSamples());
 
             AudioSourceChannelInfo info2 (&tempBuffer, 0, info.numSamples);
 
-            for (int i = 1; i < inputs.size(); ++i)
+            for (int i = 1; i < sources.size(); ++i)
             {
-                inputs.getUnchecked(i)->getNextAudioBlock (info2);
+                sources.getUnchecked(i)->getNextAudioBlock (info2);
 
                 for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
                     info.buffer->addFrom (chan, info.startSample, tempBuffer, chan, 0, info.numSamples);
@@ -31,6 +31,9 @@ namespace juce
     prepareToPlay() and releaseResources() methods are called before and after adding
     them to the mixer.
 
+    Adding and removing inputs never blocks the audio thread. The thread that removes
+    an input waits instead until the audio thread has stopped using it.
+
     @tags{Audio}
 */
 class JUCE_API  MixerAudioSource  : public AudioSource
@@ -60,6 +63,9 @@ public:
     /** Removes an input source.
         If the source was added by calling addInputSource() with the deleteWhenRemoved
         flag set, it will be deleted by this method.
+
+        Once this returns, the source won't be used by getNextAudioBlock() again, so it
+        mustn't be called from inside getNextAudioBlock().
     */
     void removeInputSource (AudioSource* input);
 
@@ -86,9 +92,12 @@ public:
 
 private:
     //==============================================================================
+    void publishInputs();
+
     Array<AudioSource*> inputs;
     BigInteger inputsToDelete;
     CriticalSection lock;
+    ReadCopyUpdatePointer<Array<AudioSource*>> realtimeInputs;
     AudioBuffer<float> tempBuffer;
     double currentSampleRate;
     int bufferSizeExpected;
@@ -26,6 +26,25 @@ namespace juce
 SynthesiserSound::SynthesiserSound() {}
 SynthesiserSound::~SynthesiserSound() {}
 
+bool SynthesiserSound::canRenderVoiceBatches() const
+{
+    return false;
+}
+
+void SynthesiserSound::renderVoiceBatch (SynthesiserVoice* const* voices, int numVoices,
+                                         AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    for (int i = 0; i < numVoices; ++i)
+        voices[i]->renderNextBlock (outputBuffer, startSample, numSamples);
+}
+
+void SynthesiserSound::renderVoiceBatch (SynthesiserVoice* const* voices, int numVoices,
+                                         AudioBuffer<double>& outputBuffer, int startSample, int numSamples)
+{
+    for (int i = 0; i < numVoices; ++i)
+        voices[i]->renderNextBlock (outputBuffer, startSample, numSamples);
+}
+
 //==============================================================================
 SynthesiserVoice::SynthesiserVoice() {}
 SynthesiserVoice::~SynthesiserVoice() {}
@@ -94,6 +113,7 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    rebuildVoiceIndex();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
@@ -104,11 +124,8 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
-    }
-
-    {
-        const ScopedLock sl (stealLock);
-        usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
+        reserveRenderItems();
+        rebuildVoiceIndex();
     }
 
     return voice;
@@ -118,6 +135,129 @@ void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    rebuildVoiceIndex();
+}
+
+//==============================================================================
+static int getVoiceIndexKey (int midiChannel, int midiNoteNumber) noexcept
+{
+    if (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128))
+        return (midiChannel - 1) * 128 + midiNoteNumber;
+
+    return -1;
+}
+
+bool Synthesiser::canUseVoiceIndex() const noexcept
+{
+    return voiceIndex.getNumVoices() == voices.size();
+}
+
+void Synthesiser::rebuildVoiceIndex()
+{
+    voiceIndex.reset (voices.size());
+
+    std::vector<SynthesiserVoice*> activeVoices;
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->indexInSynthesiser = i;
+
+        if (voice->isVoiceActive())
+            activeVoices.push_back (voice);
+    }
+
+    std::sort (activeVoices.begin(), activeVoices.end(),
+               [] (const SynthesiserVoice* a, const SynthesiserVoice* b) { return a->wasStartedBefore (*b); });
+
+    for (auto* voice : activeVoices)
+        voiceIndex.voiceStarted (voice->indexInSynthesiser,
+                                 getVoiceIndexKey (voice->currentPlayingMidiChannel, voice->currentlyPlayingNote),
+                                 voice->currentPlayingMidiChannel - 1);
+}
+
+void Synthesiser::refreshFreeVoices()
+{
+    if (! canUseVoiceIndex())
+        return;
+
+    for (int i = 0; i < voices.size(); ++i)
+        if (! voiceIndex.isFree (i) && ! voices.getUnchecked (i)->isVoiceActive())
+            voiceIndex.setFree (i);
+}
+
+void Synthesiser::markVoiceFreeIfFinished (SynthesiserVoice* voice)
+{
+    if (canUseVoiceIndex() && voices[voice->indexInSynthesiser] == voice && ! voice->isVoiceActive())
+        voiceIndex.setFree (voice->indexInSynthesiser);
+}
+
+template <typename Fn>
+void Synthesiser::forEachVoicePlayingNote (int midiChannel, int midiNoteNumber, Fn&& fn)
+{
+    const auto isPlayingNote = [&] (SynthesiserVoice* voice)
+    {
+        return voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel);
+    };
+
+    const auto key = getVoiceIndexKey (midiChannel, midiNoteNumber);
+
+    if (key < 0 || ! canUseVoiceIndex())
+    {
+        for (auto* voice : voices)
+            if (isPlayingNote (voice))
+                fn (voice);
+
+        return;
+    }
+
+    voiceIndex.forEachVoiceWithKey (key, [&] (int i)
+    {
+        if (auto* voice = voices.getUnchecked (i); isPlayingNote (voice))
+            fn (voice);
+    });
+}
+
+template <typename Fn>
+void Synthesiser::forEachVoiceOnChannel (int midiChannel, Fn&& fn)
+{
+    const auto isOnChannel = [&] (SynthesiserVoice* voice)
+    {
+        return midiChannel <= 0 || voice->isPlayingChannel (midiChannel);
+    };
+
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || ! canUseVoiceIndex())
+    {
+        for (auto* voice : voices)
+            if (isOnChannel (voice))
+                fn (voice);
+
+        return;
+    }
+
+    voiceIndex.forEachVoiceOnChannel (midiChannel - 1, [&] (int i)
+    {
+        if (auto* voice = voices.getUnchecked (i); isOnChannel (voice))
+            fn (voice);
+    });
+}
+
+template <typename Predicate>
+SynthesiserVoice* Synthesiser::findOldestVoice (Predicate&& predicate) const
+{
+    if (canUseVoiceIndex())
+    {
+        const auto index = voiceIndex.findOldestVoice ([&] (int i) { return predicate (voices.getUnchecked (i)); });
+        return index >= 0 ? voices.getUnchecked (index) : nullptr;
+    }
+
+    SynthesiserVoice* oldest = nullptr;
+
+    for (auto* voice : voices)
+        if ((oldest == nullptr || voice->wasStartedBefore (*oldest)) && predicate (voice))
+            oldest = voice;
+
+    return oldest;
 }
 
 void Synthesiser::clearSounds()
@@ -180,6 +320,10 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
 
     const ScopedLock sl (lock);
 
+    // Subclasses are allowed to change the voices array directly
+    if (! canUseVoiceIndex())
+        rebuildVoiceIndex();
+
     for (; numSamples > 0; ++midiIterator)
     {
         if (midiIterator == midiData.cend())
@@ -241,14 +385,154 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    prepareRenderItems();
+
+    if (renderPool != nullptr && renderItems.size() > 1)
+        renderVoicesInParallel (buffer, accumulationBuffersFloat, startSample, numSamples);
+    else
+        for (const auto& item : renderItems)
+            renderItem (item, buffer, startSample, numSamples);
+
+    refreshFreeVoices();
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    prepareRenderItems();
+
+    if (renderPool != nullptr && renderItems.size() > 1)
+        renderVoicesInParallel (buffer, accumulationBuffersDouble, startSample, numSamples);
+    else
+        for (const auto& item : renderItems)
+            renderItem (item, buffer, startSample, numSamples);
+
+    refreshFreeVoices();
+}
+
+//==============================================================================
+void Synthesiser::enableParallelRendering (WorkStealingThreadPool& pool, int maxNumChannels, int maximumBlockSize)
+{
+    jassert (maxNumChannels > 0 && maximumBlockSize > 0);
+
+    const ScopedLock sl (lock);
+
+    // Each thread renders into its own buffer, and the calling thread helps out too
+    const auto numBuffers = (size_t) pool.getNumThreads() + 1;
+
+    accumulationBuffersFloat .assign (numBuffers, AudioBuffer<float>  (maxNumChannels, maximumBlockSize));
+    accumulationBuffersDouble.assign (numBuffers, AudioBuffer<double> (maxNumChannels, maximumBlockSize));
+    maxParallelBlockSize = maximumBlockSize;
+    renderPool = &pool;
+}
+
+void Synthesiser::disableParallelRendering()
+{
+    const ScopedLock sl (lock);
+
+    renderPool = nullptr;
+    accumulationBuffersFloat.clear();
+    accumulationBuffersDouble.clear();
+    maxParallelBlockSize = 0;
+}
+
+void Synthesiser::reserveRenderItems()
+{
+    orderedVoices.reserve ((size_t) voices.size());
+    renderItems.reserve ((size_t) voices.size());
+    voiceIsQueued.reserve ((size_t) voices.size());
+}
+
+void Synthesiser::prepareRenderItems()
+{
+    // Voices that are playing a sound which can render batches are grouped together
+    // in the position of the first one. Every other voice keeps its place, so the
+    // voices are rendered in the same order as they always have been.
+    const auto numVoices = voices.size();
+
+    orderedVoices.clear();
+    renderItems.clear();
+    voiceIsQueued.assign ((size_t) numVoices, false);
+
+    for (int i = 0; i < numVoices; ++i)
+    {
+        if (voiceIsQueued[(size_t) i])
+            continue;
+
+        auto* voice = voices.getUnchecked (i);
+        auto* sound = voice->getCurrentlyPlayingSound().get();
+        const auto firstVoice = (int) orderedVoices.size();
+
+        orderedVoices.push_back (voice);
+
+        if (sound == nullptr || ! sound->canRenderVoiceBatches())
+        {
+            renderItems.push_back ({ nullptr, firstVoice, 1 });
+            continue;
+        }
+
+        for (int j = i + 1; j < numVoices; ++j)
+        {
+            auto* other = voices.getUnchecked (j);
+
+            if (! voiceIsQueued[(size_t) j] && other->getCurrentlyPlayingSound().get() == sound)
+            {
+                voiceIsQueued[(size_t) j] = true;
+                orderedVoices.push_back (other);
+            }
+        }
+
+        renderItems.push_back ({ sound, firstVoice, (int) orderedVoices.size() - firstVoice });
+    }
+}
+
+template <typename floatType>
+void Synthesiser::renderItem (const RenderItem& item, AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    if (item.batchSound != nullptr)
+        item.batchSound->renderVoiceBatch (orderedVoices.data() + item.firstVoice, item.numVoices,
+                                           buffer, startSample, numSamples);
+    else
+        orderedVoices[(size_t) item.firstVoice]->renderNextBlock (buffer, startSample, numSamples);
+}
+
+template <typename floatType>
+void Synthesiser::renderVoicesInParallel (AudioBuffer<floatType>& buffer,
+                                          std::vector<AudioBuffer<floatType>>& accumulationBuffers,
+                                          int startSample, int numSamples)
+{
+    const auto numChannels = buffer.getNumChannels();
+
+    // The accumulation buffers must be big enough for everything that's rendered!
+    jassert (numChannels <= accumulationBuffers.front().getNumChannels());
+
+    const auto numItems = (int) renderItems.size();
+    const auto numGroups = jmin (numItems, (int) accumulationBuffers.size());
+    const auto numChannelsToUse = jmin (numChannels, accumulationBuffers.front().getNumChannels());
+
+    while (numSamples > 0)
+    {
+        const auto numThisTime = jmin (numSamples, maxParallelBlockSize);
+
+        renderPool->parallelFor (0, numGroups, [&] (int group)
+        {
+            AudioBuffer<floatType> groupBuffer (accumulationBuffers[(size_t) group].getArrayOfWritePointers(),
+                                                numChannelsToUse, 0, numThisTime);
+            groupBuffer.clear();
+
+            const auto firstItem = group * numItems / numGroups;
+            const auto lastItem = (group + 1) * numItems / numGroups;
+
+            for (auto i = firstItem; i < lastItem; ++i)
+                renderItem (renderItems[(size_t) i], groupBuffer, 0, numThisTime);
+        }, 1);
+
+        for (int group = 0; group < numGroups; ++group)
+            for (int channel = 0; channel < numChannelsToUse; ++channel)
+                buffer.addFrom (channel, startSample, accumulationBuffers[(size_t) group], channel, 0, numThisTime);
+
+        startSample += numThisTime;
+        numSamples  -= numThisTime;
+    }
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -304,9 +588,10 @@ void Synthesiser::noteOn (const int midiChannel,
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
-                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
-                    stopVoice (voice, 1.0f, true);
+            forEachVoicePlayingNote (midiChannel, midiNoteNumber, [&] (SynthesiserVoice* voice)
+            {
+                stopVoice (voice, 1.0f, true);
+            });
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -335,6 +620,9 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
 
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
+
+        if (canUseVoiceIndex() && voices[voice->indexInSynthesiser] == voice)
+            voiceIndex.voiceStarted (voice->indexInSynthesiser, getVoiceIndexKey (midiChannel, midiNoteNumber), midiChannel - 1);
     }
 }
 
@@ -346,6 +634,8 @@ void Synthesiser::stopVoice (SynthesiserVoice* voice, float velocity, const bool
 
     // the subclass MUST call clearCurrentNote() if it's not tailing off! RTFM for stopNote()!
     jassert (allowTailOff || (voice->getCurrentlyPlayingNote() < 0 && voice->getCurrentlyPlayingSound() == nullptr));
+
+    markVoiceFreeIfFinished (voice);
 }
 
 void Synthesiser::noteOff (const int midiChannel,
@@ -355,35 +645,33 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (midiChannel, midiNoteNumber, [&] (SynthesiserVoice* voice)
     {
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && voice->isPlayingChannel (midiChannel))
+        if (auto sound = voice->getCurrentlyPlayingSound())
         {
-            if (auto sound = voice->getCurrentlyPlayingSound())
+            if (sound->appliesToNote (midiNoteNumber)
+                 && sound->appliesToChannel (midiChannel))
             {
-                if (sound->appliesToNote (midiNoteNumber)
-                     && sound->appliesToChannel (midiChannel))
-                {
-                    jassert (! voice->keyIsDown || voice->isSustainPedalDown() == sustainPedalsDown [midiChannel]);
+                jassert (! voice->keyIsDown || voice->isSustainPedalDown() == sustainPedalsDown [midiChannel]);
 
-                    voice->setKeyDown (false);
+                voice->setKeyDown (false);
 
-                    if (! (voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
-                        stopVoice (voice, velocity, allowTailOff);
-                }
+                if (! (voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
+                    stopVoice (voice, velocity, allowTailOff);
             }
         }
-    }
+    });
 }
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
-            voice->stopNote (1.0f, allowTailOff);
+    forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
+    {
+        voice->stopNote (1.0f, allowTailOff);
+        markVoiceFreeIfFinished (voice);
+    });
 
     sustainPedalsDown.clear();
 }
@@ -392,9 +680,10 @@ void Synthesiser::handlePitchWheel (const int midiChannel, const int wheelValue)
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
-            voice->pitchWheelMoved (wheelValue);
+    forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
+    {
+        voice->pitchWheelMoved (wheelValue);
+    });
 }
 
 void Synthesiser::handleController (const int midiChannel,
@@ -411,28 +700,39 @@ void Synthesiser::handleController (const int midiChannel,
 
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
-            voice->controllerMoved (controllerNumber, controllerValue);
+    forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
+    {
+        voice->controllerMoved (controllerNumber, controllerValue);
+    });
 }
 
 void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aftertouchValue)
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
-            voice->aftertouchChanged (aftertouchValue);
+    if (midiChannel <= 0)
+    {
+        for (auto* voice : voices)
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+                voice->aftertouchChanged (aftertouchValue);
+
+        return;
+    }
+
+    forEachVoicePlayingNote (midiChannel, midiNoteNumber, [&] (SynthesiserVoice* voice)
+    {
+        voice->aftertouchChanged (aftertouchValue);
+    });
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
-            voice->channelPressureChanged (channelPressureValue);
+    forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
+    {
+        voice->channelPressureChanged (channelPressureValue);
+    });
 }
 
 void Synthesiser::handleSustainPedal (int midiChannel, bool isDown)
@@ -444,22 +744,21 @@ void Synthesiser::handleSustainPedal (int midiChannel, bool isDown)
     {
         sustainPedalsDown.setBit (midiChannel);
 
-        for (auto* voice : voices)
-            if (voice->isPlayingChannel (midiChannel) && voice->isKeyDown())
+        forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
+        {
+            if (voice->isKeyDown())
                 voice->setSustainPedalDown (true);
+        });
     }
     else
     {
-        for (auto* voice : voices)
+        forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
         {
-            if (voice->isPlayingChannel (midiChannel))
-            {
-                voice->setSustainPedalDown (false);
+            voice->setSustainPedalDown (false);
 
-                if (! (voice->isKeyDown() || voice->isSostenutoPedalDown()))
-                    stopVoice (voice, 1.0f, true);
-            }
-        }
+            if (! (voice->isKeyDown() || voice->isSostenutoPedalDown()))
+                stopVoice (voice, 1.0f, true);
+        });
 
         sustainPedalsDown.clearBit (midiChannel);
     }
@@ -470,16 +769,13 @@ void Synthesiser::handleSostenutoPedal (int midiChannel, bool isDown)
     jassert (midiChannel > 0 && midiChannel <= 16);
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    forEachVoiceOnChannel (midiChannel, [&] (SynthesiserVoice* voice)
     {
-        if (voice->isPlayingChannel (midiChannel))
-        {
-            if (isDown)
-                voice->setSostenutoPedalDown (true);
-            else if (voice->isSostenutoPedalDown())
-                stopVoice (voice, 1.0f, true);
-        }
-    }
+        if (isDown)
+            voice->setSostenutoPedalDown (true);
+        else if (voice->isSostenutoPedalDown())
+            stopVoice (voice, 1.0f, true);
+    });
 }
 
 void Synthesiser::handleSoftPedal ([[maybe_unused]] int midiChannel, bool /*isDown*/)
@@ -500,8 +796,23 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
 {
     const ScopedLock sl (lock);
 
+    const auto isUsable = [soundToPlay] (SynthesiserVoice* voice)
+    {
+        return (! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay);
+    };
+
+    if (canUseVoiceIndex())
+    {
+        const auto index = voiceIndex.findFreeVoice ([&] (int i) { return isUsable (voices.getUnchecked (i)); });
+
+        if (index >= 0)
+            return voices.getUnchecked (index);
+    }
+
+    // Voices that have finished by themselves since they were last rendered won't
+    // have been marked as free yet
     for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+        if (isUsable (voice))
             return voice;
 
     if (stealIfNoneAvailable)
@@ -524,31 +835,12 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     SynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     SynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // All major OSes use double-locking so this will be lock- and wait-free as long as the lock is not
-    // contended. This is always the case if you do not call findVoiceToSteal on multiple threads at
-    // the same time.
-    const ScopedLock sl (stealLock);
-
-    // this is a list of voices we can steal, sorted by how long they've been running
-    usableVoicesToStealArray.clear();
-
     for (auto* voice : voices)
     {
         if (voice->canPlaySound (soundToPlay))
         {
             jassert (voice->isVoiceActive()); // We wouldn't be here otherwise
 
-            usableVoicesToStealArray.add (voice);
-
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -566,25 +858,27 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     if (top == low)
         top = nullptr;
 
+    const auto isUsable = [soundToPlay, low, top] (SynthesiserVoice* voice)
+    {
+        return voice != low && voice != top && voice->canPlaySound (soundToPlay);
+    };
+
     // The oldest note that's playing with the target pitch is ideal..
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (SynthesiserVoice* v) { return v->canPlaySound (soundToPlay)
+                                                                            && v->getCurrentlyPlayingNote() == midiNoteNumber; }))
+        return voice;
 
     // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (SynthesiserVoice* v) { return isUsable (v) && v->isPlayingButReleased(); }))
+        return voice;
 
     // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top && ! voice->isKeyDown())
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (SynthesiserVoice* v) { return isUsable (v) && ! v->isKeyDown(); }))
+        return voice;
 
     // Oldest voice that isn't protected
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top)
-            return voice;
+    if (auto* voice = findOldestVoice (isUsable))
+        return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
     jassert (low != nullptr);
@@ -596,4 +890,207 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SynthesiserTests  : public UnitTest
+{
+public:
+    SynthesiserTests()
+        : UnitTest ("Synthesiser", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Sounds that can render batches are given all their voices at once");
+        {
+            auto sound = new TestSound (true);
+            auto synth = makeSynth (sound);
+
+            AudioBuffer<float> buffer (2, 256);
+            buffer.clear();
+            synth->renderNextBlock (buffer, makeChord (0), 0, buffer.getNumSamples());
+
+            expectEquals (sound->numBatches.load(), 1);
+            expectEquals (sound->numBatchedVoices.load(), 2 * numNotes);
+        }
+
+        beginTest ("Rendering in parallel matches rendering serially");
+        {
+            for (auto batches : { false, true })
+            {
+                const auto serial = render (batches, nullptr);
+
+                WorkStealingThreadPool pool (3);
+                const auto parallel = render (batches, &pool);
+
+                expect (serial.getMagnitude (0, serial.getNumSamples()) > 0.1f);
+
+                float maxDifference = 0.0f;
+
+                for (int channel = 0; channel < serial.getNumChannels(); ++channel)
+                    for (int i = 0; i < serial.getNumSamples(); ++i)
+                        maxDifference = jmax (maxDifference, std::abs (serial.getSample (channel, i) - parallel.getSample (channel, i)));
+
+                expect (maxDifference < 1.0e-5f);
+            }
+        }
+
+        beginTest ("The oldest unprotected voice is stolen");
+        {
+            auto synth = makeSynth (new TestSound (false), 4);
+
+            for (auto note : { 60, 62, 64, 65 })
+                synth->noteOn (1, note, 0.5f);
+
+            auto* stolen = findVoicePlaying (*synth, 1, 62);
+            expect (stolen != nullptr);
+
+            synth->noteOn (1, 67, 0.5f);
+
+            expect (stolen->getCurrentlyPlayingNote() == 67);
+            expect (findVoicePlaying (*synth, 1, 62) == nullptr);
+
+            for (auto note : { 60, 64, 65 })
+                expect (findVoicePlaying (*synth, 1, note) != nullptr);
+        }
+
+        beginTest ("Voices are found by channel and note, and reused once they're free");
+        {
+            auto synth = makeSynth (new TestSound (false), 8);
+
+            synth->noteOn (1, 60, 0.5f);
+            synth->noteOn (2, 60, 0.5f);
+            synth->noteOn (2, 64, 0.5f);
+
+            auto* released = findVoicePlaying (*synth, 2, 60);
+            synth->noteOff (2, 60, 0.5f, true);
+
+            expect (! released->isVoiceActive());
+            expect (findVoicePlaying (*synth, 1, 60) != nullptr);
+            expect (findVoicePlaying (*synth, 2, 64) != nullptr);
+
+            synth->noteOn (3, 70, 0.5f);
+            expect (findVoicePlaying (*synth, 3, 70) == released);
+
+            synth->handleSustainPedal (1, true);
+            synth->noteOff (1, 60, 0.5f, true);
+            expect (findVoicePlaying (*synth, 1, 60) != nullptr);
+
+            synth->handleSustainPedal (1, false);
+            expect (findVoicePlaying (*synth, 1, 60) == nullptr);
+
+            synth->allNotesOff (0, false);
+
+            for (int i = 0; i < synth->getNumVoices(); ++i)
+                expect (! synth->getVoice (i)->isVoiceActive());
+        }
+    }
+
+private:
+    static constexpr int numNotes = 24;
+
+    struct TestSound  : public SynthesiserSound
+    {
+        explicit TestSound (bool batches)  : supportsBatches (batches) {}
+
+        bool appliesToNote (int) override               { return true; }
+        bool appliesToChannel (int) override            { return true; }
+        bool canRenderVoiceBatches() const override     { return supportsBatches; }
+
+        void renderVoiceBatch (SynthesiserVoice* const* v, int numVoices,
+                               AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            ++numBatches;
+            numBatchedVoices += numVoices;
+            SynthesiserSound::renderVoiceBatch (v, numVoices, buffer, startSample, numSamples);
+        }
+
+        const bool supportsBatches;
+        std::atomic<int> numBatches { 0 }, numBatchedVoices { 0 };
+    };
+
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+        void stopNote (float, bool) override            { clearCurrentNote(); }
+        void pitchWheelMoved (int) override             {}
+        void controllerMoved (int, int) override        {}
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0.0;
+            increment = MidiMessage::getMidiNoteInHertz (note) * MathConstants<double>::twoPi / getSampleRate();
+            level = velocity * 0.05f;
+        }
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i, phase += increment)
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, level * (float) std::sin (phase + channel));
+        }
+
+        double phase = 0.0, increment = 0.0;
+        float level = 0.0f;
+    };
+
+    static std::unique_ptr<Synthesiser> makeSynth (SynthesiserSound* sound, int numVoices = 2 * numNotes)
+    {
+        auto synth = std::make_unique<Synthesiser>();
+        synth->setCurrentPlaybackSampleRate (44100.0);
+        synth->addSound (sound);
+
+        for (int i = 0; i < numVoices; ++i)
+            synth->addVoice (new TestVoice());
+
+        return synth;
+    }
+
+    static SynthesiserVoice* findVoicePlaying (const Synthesiser& synth, int midiChannel, int midiNoteNumber)
+    {
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (auto* voice = synth.getVoice (i); voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
+                return voice;
+
+        return nullptr;
+    }
+
+    static MidiBuffer makeChord (int spacing)
+    {
+        MidiBuffer midi;
+
+        for (int i = 0; i < numNotes; ++i)
+        {
+            midi.addEvent (MidiMessage::noteOn (1, 40 + i, 0.8f), i * spacing);
+            midi.addEvent (MidiMessage::noteOn (2, 40 + i, 0.6f), i * spacing);
+        }
+
+        return midi;
+    }
+
+    static AudioBuffer<float> render (bool batches, WorkStealingThreadPool* pool)
+    {
+        auto synth = makeSynth (new TestSound (batches));
+
+        if (pool != nullptr)
+            synth->enableParallelRendering (*pool, 2, 100);
+
+        AudioBuffer<float> result (2, 1024);
+        result.clear();
+
+        const auto midi = makeChord (3);
+
+        for (int start = 0; start < result.getNumSamples(); start += 256)
+            synth->renderNextBlock (result, start == 0 ? midi : MidiBuffer(), start, 256);
+
+        return result;
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
+
 } // namespace juce
@@ -38,6 +38,8 @@ namespace juce
 
     @tags{Audio}
 */
+class SynthesiserVoice;
+
 class JUCE_API  SynthesiserSound    : public ReferenceCountedObject
 {
 protected:
@@ -63,6 +65,36 @@ public:
     */
     virtual bool appliesToChannel (int midiChannel) = 0;
 
+    //==============================================================================
+    /** Should return true if renderVoiceBatch() can render all the voices that are
+        playing this sound at once.
+
+        By default this returns false, and the Synthesiser will call
+        SynthesiserVoice::renderNextBlock() on each voice separately.
+    */
+    virtual bool canRenderVoiceBatches() const;
+
+    /** Renders a group of voices which are all playing this sound.
+
+        If canRenderVoiceBatches() returns true, the Synthesiser's default renderVoices()
+        implementation will gather up all the voices that are playing this sound and pass
+        them to this method together, instead of rendering them one at a time. This lets
+        you process several voices at once, e.g. by giving each one a lane of a SIMD
+        register, or by sharing the work of reading the sound's data between them.
+
+        Just like SynthesiserVoice::renderNextBlock(), the output must be added to the
+        existing contents of the buffer, and voices that finish must call clearCurrentNote().
+
+        The default implementation just calls renderNextBlock() on each of the voices.
+    */
+    virtual void renderVoiceBatch (SynthesiserVoice* const* voices, int numVoices,
+                                   AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+
+    /** A double-precision version of renderVoiceBatch() */
+    virtual void renderVoiceBatch (SynthesiserVoice* const* voices, int numVoices,
+                                   AudioBuffer<double>& outputBuffer, int startSample, int numSamples);
+
+    //==============================================================================
     /** The class is reference-counted, so this is a handy pointer class for it. */
     using Ptr = ReferenceCountedObjectPtr<SynthesiserSound>;
 
@@ -268,6 +300,7 @@ private:
 
     double currentSampleRate = 44100.0;
     int currentlyPlayingNote = -1, currentPlayingMidiChannel = 0;
+    int indexInSynthesiser = -1;
     uint32 noteOnTime = 0;
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
@@ -557,6 +590,38 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Lets the default renderVoices() implementation render voices in parallel.
+
+        Once this has been called, each sub-block of voices will be split into a few
+        groups. The groups are rendered into separate accumulation buffers by the pool's
+        threads and by the thread that called renderNextBlock(), and then summed into
+        the output buffer in a fixed order, so the result doesn't depend on which thread
+        rendered which group. Voices that are rendered in a batch with renderVoiceBatch()
+        always stay together in the same group.
+
+        Only use this if your voices are happy to render at the same time as each other
+        on different threads. Note that a WorkStealingThreadPool may allocate memory when
+        work is handed to it, so this will be most useful for heavy voices in large
+        numbers, e.g. a dense patch on a sampler with lots of voices.
+
+        @param pool                 the pool to use. This must stay alive until
+                                    disableParallelRendering() is called, or the
+                                    synthesiser is deleted
+        @param maxNumChannels       the largest number of channels that will be rendered
+        @param maximumBlockSize     the largest block size that will be rendered. Larger
+                                    blocks will be rendered in several pieces
+
+        @see disableParallelRendering, SynthesiserSound::renderVoiceBatch
+    */
+    void enableParallelRendering (WorkStealingThreadPool& pool, int maxNumChannels, int maximumBlockSize);
+
+    /** Goes back to rendering all the voices on the thread that calls renderNextBlock(). */
+    void disableParallelRendering();
+
+    /** Returns true if enableParallelRendering() has been called. */
+    bool isRenderingInParallel() const noexcept                 { return renderPool != nullptr; }
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -627,12 +692,52 @@ private:
     bool subBlockSubdivisionIsStrict = false;
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
-    mutable CriticalSection stealLock;
-    mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    //==============================================================================
+    detail::VoiceIndex voiceIndex;
+
+    bool canUseVoiceIndex() const noexcept;
+    void rebuildVoiceIndex();
+    void refreshFreeVoices();
+    void markVoiceFreeIfFinished (SynthesiserVoice*);
+
+    template <typename Fn>
+    void forEachVoicePlayingNote (int midiChannel, int midiNoteNumber, Fn&&);
+
+    template <typename Fn>
+    void forEachVoiceOnChannel (int midiChannel, Fn&&);
+
+    template <typename Predicate>
+    SynthesiserVoice* findOldestVoice (Predicate&&) const;
+
+    //==============================================================================
+    struct RenderItem
+    {
+        SynthesiserSound* batchSound;
+        int firstVoice, numVoices;
+    };
+
+    std::vector<SynthesiserVoice*> orderedVoices;
+    std::vector<RenderItem> renderItems;
+    std::vector<bool> voiceIsQueued;
+
+    WorkStealingThreadPool* renderPool = nullptr;
+    std::vector<AudioBuffer<float>> accumulationBuffersFloat;
+    std::vector<AudioBuffer<double>> accumulationBuffersDouble;
+    int maxParallelBlockSize = 0;
+
+    void reserveRenderItems();
+    void prepareRenderItems();
+
+    template <typename floatType>
+    void renderItem (const RenderItem&, AudioBuffer<floatType>&, int startSample, int numSamples);
+
+    template <typename floatType>
+    void renderVoicesInParallel (AudioBuffer<floatType>&, std::vector<AudioBuffer<floatType>>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Synthesiser)
 };
 
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace detail
+{
+
+//==============================================================================
+/*  Keeps track of a synthesiser's voices, so that allocating, stealing and releasing
+    voices doesn't mean searching through all of them for every MIDI event.
+
+    Voices are identified by their position in the synthesiser's list. Each voice that
+    is started gets linked into a list for its key (e.g. a channel and note pair) and
+    its channel, and moves to the end of a list of voices in the order they started.
+
+    Voices can also finish by themselves while rendering, so the lists are only hints:
+    anything found in them must still be checked against the voice itself, and the
+    owner should call setFree() when it notices a voice has stopped.
+*/
+class VoiceIndex
+{
+public:
+    static constexpr int numKeys = 16 * 128;
+    static constexpr int numChannels = 16;
+
+    /** Forgets everything and marks all the voices as free. This allocates. */
+    void reset (int numVoicesToUse)
+    {
+        voices.assign ((size_t) numVoicesToUse, {});
+        freeVoices.assign (((size_t) numVoicesToUse + 63) / 64, 0);
+        keyHeads.fill (-1);
+        channelHeads.fill (-1);
+        oldest = newest = -1;
+
+        for (int i = 0; i < numVoicesToUse; ++i)
+        {
+            appendToOrder (i);
+            setFreeFlag (i, true);
+        }
+    }
+
+    int getNumVoices() const noexcept      { return (int) voices.size(); }
+
+    /** Records that a voice has started, making it the newest one. The key and channel
+        may be -1 if the voice shouldn't be found by key or by channel.
+    */
+    void voiceStarted (int voice, int key, int channel) noexcept
+    {
+        jassert (isPositiveAndBelow (voice, getNumVoices()));
+
+        unlinkFromKeyAndChannel (voice);
+        removeFromOrder (voice);
+        appendToOrder (voice);
+
+        auto& v = voices[(size_t) voice];
+
+        if (isPositiveAndBelow (key, numKeys))
+        {
+            v.key = key;
+            pushFront (keys, voice, keyHeads[(size_t) key]);
+        }
+
+        if (isPositiveAndBelow (channel, numChannels))
+        {
+            v.channel = channel;
+            pushFront (channels, voice, channelHeads[(size_t) channel]);
+        }
+
+        setFreeFlag (voice, false);
+    }
+
+    /** Records that a voice has stopped. */
+    void setFree (int voice) noexcept
+    {
+        jassert (isPositiveAndBelow (voice, getNumVoices()));
+
+        unlinkFromKeyAndChannel (voice);
+        setFreeFlag (voice, true);
+    }
+
+    bool isFree (int voice) const noexcept
+    {
+        return (freeVoices[(size_t) voice / 64] & (uint64 { 1 } << (voice % 64))) != 0;
+    }
+
+    /** Returns the lowest-numbered free voice that satisfies a predicate, or -1. */
+    template <typename Predicate>
+    int findFreeVoice (Predicate&& predicate) const
+    {
+        for (size_t word = 0; word < freeVoices.size(); ++word)
+        {
+            for (auto bits = freeVoices[word]; bits != 0; bits &= bits - 1)
+            {
+                const auto voice = (int) word * 64 + countNumberOfBits ((bits & (~bits + 1)) - 1);
+
+                if (predicate (voice))
+                    return voice;
+            }
+        }
+
+        return -1;
+    }
+
+    /** Returns the first voice, from oldest to newest, that satisfies a predicate, or -1. */
+    template <typename Predicate>
+    int findOldestVoice (Predicate&& predicate) const
+    {
+        for (auto voice = oldest; voice >= 0; voice = voices[(size_t) voice].links[order].next)
+            if (predicate (voice))
+                return voice;
+
+        return -1;
+    }
+
+    /** Calls a function for each voice started with the given key that hasn't been freed
+        or restarted since. The function is allowed to free the voice it's given.
+    */
+    template <typename Fn>
+    void forEachVoiceWithKey (int key, Fn&& fn) const
+    {
+        if (isPositiveAndBelow (key, numKeys))
+            forEachInList (keys, keyHeads[(size_t) key], fn);
+    }
+
+    /** Calls a function for each voice started on the given channel (0 to 15) that hasn't
+        been freed or restarted since. The function is allowed to free the voice it's given.
+    */
+    template <typename Fn>
+    void forEachVoiceOnChannel (int channel, Fn&& fn) const
+    {
+        if (isPositiveAndBelow (channel, numChannels))
+            forEachInList (channels, channelHeads[(size_t) channel], fn);
+    }
+
+private:
+    //==============================================================================
+    enum ListType { order, keys, channels };
+
+    struct Links
+    {
+        int previous = -1, next = -1;
+    };
+
+    struct Voice
+    {
+        std::array<Links, 3> links;
+        int key = -1, channel = -1;
+    };
+
+    void appendToOrder (int voice) noexcept
+    {
+        auto& l = voices[(size_t) voice].links[order];
+        l.previous = newest;
+        l.next = -1;
+
+        if (newest >= 0)
+            voices[(size_t) newest].links[order].next = voice;
+        else
+            oldest = voice;
+
+        newest = voice;
+    }
+
+    void removeFromOrder (int voice) noexcept
+    {
+        auto& l = voices[(size_t) voice].links[order];
+
+        if (l.previous >= 0)  voices[(size_t) l.previous].links[order].next = l.next;
+        else                  oldest = l.next;
+
+        if (l.next >= 0)      voices[(size_t) l.next].links[order].previous = l.previous;
+        else                  newest = l.previous;
+
+        l = {};
+    }
+
+    void pushFront (ListType type, int voice, int& head) noexcept
+    {
+        auto& l = voices[(size_t) voice].links[type];
+        l.previous = -1;
+        l.next = head;
+
+        if (head >= 0)
+            voices[(size_t) head].links[type].previous = voice;
+
+        head = voice;
+    }
+
+    void remove (ListType type, int voice, int& head) noexcept
+    {
+        auto& l = voices[(size_t) voice].links[type];
+
+        if (l.previous >= 0)  voices[(size_t) l.previous].links[type].next = l.next;
+        else                  head = l.next;
+
+        if (l.next >= 0)
+            voices[(size_t) l.next].links[type].previous = l.previous;
+
+        l = {};
+    }
+
+    void unlinkFromKeyAndChannel (int voice) noexcept
+    {
+        auto& v = voices[(size_t) voice];
+
+        if (v.key >= 0)
+            remove (keys, voice, keyHeads[(size_t) std::exchange (v.key, -1)]);
+
+        if (v.channel >= 0)
+            remove (channels, voice, channelHeads[(size_t) std::exchange (v.channel, -1)]);
+    }
+
+    template <typename Fn>
+    void forEachInList (ListType type, int head, Fn& fn) const
+    {
+        for (auto voice = head; voice >= 0;)
+        {
+            const auto next = voices[(size_t) voice].links[type].next;
+            fn (voice);
+            voice = next;
+        }
+    }
+
+    void setFreeFlag (int voice, bool shouldBeFree) noexcept
+    {
+        auto& word = freeVoices[(size_t) voice / 64];
+        const auto bit = uint64 { 1 } << (voice % 64);
+        word = shouldBeFree ? (word | bit) : (word & ~bit);
+    }
+
+    //==============================================================================
+    std::vector<Voice> voices;
+    std::vector<uint64> freeVoices;
+    std::array<int, numKeys> keyHeads;
+    std::array<int, numChannels> channelHeads;
+    int oldest = -1, newest = -1;
+};
+
+} // namespace detail
+} // namespace juce
@@ -35,6 +35,12 @@ namespace juce
     release stage has completed then you must call reset() before the next call to
     noteOn().
 
+    When rendering whole blocks, applyEnvelopeToBuffer() and renderNextBlock() work out
+    where each stage ends in advance and process each stage as a single vectorised ramp,
+    rather than stepping the envelope one sample at a time. processSegments() gives
+    access to the same information, including the exact sample on which each stage
+    changes.
+
     @tags{Audio}
 */
 class JUCE_API  ADSR
@@ -46,6 +52,10 @@ public:
         recalculateRates();
     }
 
+    //==============================================================================
+    /** The stages that an envelope moves through. */
+    enum class Stage { idle, attack, decay, sustain, release };
+
     //==============================================================================
     /**
         Holds the parameters being used by an ADSR object.
@@ -93,7 +103,10 @@ public:
     const Parameters& getParameters() const noexcept  { return parameters; }
 
     /** Returns true if the envelope is in its attack, decay, sustain or release stage. */
-    bool isActive() const noexcept                    { return state != State::idle; }
+    bool isActive() const noexcept                    { return state != Stage::idle; }
+
+    /** Returns the stage that the envelope is currently in. */
+    Stage getStage() const noexcept                   { return state; }
 
     //==============================================================================
     /** Sets the sample rate that will be used for the envelope.
@@ -111,7 +124,7 @@ public:
     void reset() noexcept
     {
         envelopeVal = 0.0f;
-        state = State::idle;
+        state = Stage::idle;
     }
 
     /** Starts the attack phase of the envelope. */
@@ -119,29 +132,29 @@ public:
     {
         if (attackRate > 0.0f)
         {
-            state = State::attack;
+            state = Stage::attack;
         }
         else if (decayRate > 0.0f)
         {
             envelopeVal = 1.0f;
-            state = State::decay;
+            state = Stage::decay;
         }
         else
         {
             envelopeVal = parameters.sustain;
-            state = State::sustain;
+            state = Stage::sustain;
         }
     }
 
     /** Starts the release phase of the envelope. */
     void noteOff() noexcept
     {
-        if (state != State::idle)
+        if (state != Stage::idle)
         {
             if (parameters.release > 0.0f)
             {
                 releaseRate = (float) (envelopeVal / (parameters.release * sampleRate));
-                state = State::release;
+                state = Stage::release;
             }
             else
             {
@@ -159,12 +172,12 @@ public:
     {
         switch (state)
         {
-            case State::idle:
+            case Stage::idle:
             {
                 return 0.0f;
             }
 
-            case State::attack:
+            case Stage::attack:
             {
                 envelopeVal += attackRate;
 
@@ -177,7 +190,7 @@ public:
                 break;
             }
 
-            case State::decay:
+            case Stage::decay:
             {
                 envelopeVal -= decayRate;
 
@@ -190,13 +203,13 @@ public:
                 break;
             }
 
-            case State::sustain:
+            case Stage::sustain:
             {
                 envelopeVal = parameters.sustain;
                 break;
             }
 
-            case State::release:
+            case Stage::release:
             {
                 envelopeVal -= releaseRate;
 
@@ -213,35 +226,122 @@ public:
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
-        @see getNextSample
+        @see getNextSample, renderNextBlock
     */
     template <typename FloatType>
     void applyEnvelopeToBuffer (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
     {
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
-        if (state == State::idle)
+        processSegments (numSamples, [&] (const Segment& segment)
         {
-            buffer.clear (startSample, numSamples);
-            return;
-        }
+            const auto start = startSample + segment.startSample;
 
-        if (state == State::sustain)
+            if (segment.stage == Stage::idle)
+            {
+                buffer.clear (start, segment.numSamples);
+            }
+            else if (segment.increment == 0.0f)
+            {
+                buffer.applyGain (start, segment.numSamples, (FloatType) segment.startValue);
+            }
+            else
+            {
+                for (int i = 0; i < buffer.getNumChannels(); ++i)
+                    FloatVectorOperations::multiplyWithRamp (buffer.getWritePointer (i, start),
+                                                             (FloatType) segment.startValue,
+                                                             (FloatType) segment.increment,
+                                                             segment.numSamples);
+            }
+        });
+    }
+
+    /** Writes the next numSamples envelope values into an array.
+
+        @see applyEnvelopeToBuffer
+    */
+    void renderNextBlock (float* destination, int numSamples) noexcept
+    {
+        processSegments (numSamples, [destination] (const Segment& segment)
         {
-            buffer.applyGain (startSample, numSamples, parameters.sustain);
-            return;
-        }
+            auto* dest = destination + segment.startSample;
+
+            if (segment.increment == 0.0f)
+            {
+                FloatVectorOperations::fill (dest, segment.startValue, segment.numSamples);
+            }
+            else
+            {
+                for (int i = 0; i < segment.numSamples; ++i)
+                    dest[i] = segment.startValue + segment.increment * (float) i;
+            }
+        });
+    }
 
-        auto numChannels = buffer.getNumChannels();
+    //==============================================================================
+    /** Describes a run of samples during which the envelope stays in one stage and
+        changes by a fixed amount on each sample.
+    */
+    struct Segment
+    {
+        int startSample = 0, numSamples = 0;
+        Stage stage = Stage::idle;
+        float startValue = 0.0f, increment = 0.0f;
+    };
 
-        while (--numSamples >= 0)
+    /** Advances the envelope by a number of samples, calling the callback with a Segment
+        for each stage that it passes through.
+
+        The startSample of every segment after the first is the offset at which the
+        envelope changed stage, so for example a synth can free a voice on the exact
+        sample that its release finishes.
+
+        The ramps that this produces are adjusted so that each stage lands exactly on its
+        target level, so the values may differ very slightly from those returned by
+        getNextSample().
+    */
+    template <typename Callback>
+    void processSegments (int numSamples, Callback&& callback) noexcept
+    {
+        for (int position = 0; position < numSamples;)
         {
-            auto env = getNextSample();
+            const auto remaining = numSamples - position;
 
-            for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            if (state == Stage::idle || state == Stage::sustain)
+            {
+                envelopeVal = (state == Stage::idle ? 0.0f : parameters.sustain);
+                callback (Segment { position, remaining, state, envelopeVal, 0.0f });
+                return;
+            }
 
-            ++startSample;
+            const auto rate   = state == Stage::attack ? attackRate : (state == Stage::decay ? decayRate : releaseRate);
+            const auto target = state == Stage::attack ? 1.0f       : (state == Stage::decay ? parameters.sustain : 0.0f);
+
+            if (rate <= 0.0f)
+            {
+                goToNextState();
+                continue;
+            }
+
+            // The stage ends on the first sample that reaches the target. The small margin stops
+            // rounding errors in the rates from adding an extra sample to the stage.
+            const auto distance = std::abs ((double) target - (double) envelopeVal);
+            const auto stageLength = (int) jlimit (1.0, (double) std::numeric_limits<int>::max(), std::ceil (distance / rate - 1.0e-4));
+            const auto increment = (target - envelopeVal) / (float) stageLength;
+            const auto length = jmin (stageLength, remaining);
+
+            callback (Segment { position, length, state, envelopeVal + increment, increment });
+            position += length;
+
+            if (length == stageLength)
+            {
+                envelopeVal = target;
+                goToNextState();
+            }
+            else
+            {
+                envelopeVal += increment * (float) length;
+            }
         }
     }
 
@@ -258,9 +358,9 @@ private:
         decayRate   = getRate (1.0f - parameters.sustain, parameters.decay, sampleRate);
         releaseRate = getRate (parameters.sustain, parameters.release, sampleRate);
 
-        if ((state == State::attack && attackRate <= 0.0f)
-            || (state == State::decay && (decayRate <= 0.0f || envelopeVal <= parameters.sustain))
-            || (state == State::release && releaseRate <= 0.0f))
+        if ((state == Stage::attack && attackRate <= 0.0f)
+            || (state == Stage::decay && (decayRate <= 0.0f || envelopeVal <= parameters.sustain))
+            || (state == Stage::release && releaseRate <= 0.0f))
         {
             goToNextState();
         }
@@ -268,26 +368,24 @@ private:
 
     void goToNextState() noexcept
     {
-        if (state == State::attack)
+        if (state == Stage::attack)
         {
-            state = (decayRate > 0.0f ? State::decay : State::sustain);
+            state = (decayRate > 0.0f ? Stage::decay : Stage::sustain);
             return;
         }
 
-        if (state == State::decay)
+        if (state == Stage::decay)
         {
-            state = State::sustain;
+            state = Stage::sustain;
             return;
         }
 
-        if (state == State::release)
+        if (state == Stage::release)
             reset();
     }
 
     //==============================================================================
-    enum class State { idle, attack, decay, sustain, release };
-
-    State state = State::idle;
+    Stage state = Stage::idle;
     Parameters parameters;
 
     double sampleRate = 44100.0;
@@ -177,6 +177,70 @@ struct ADSRTests  : public UnitTest
 
             expect (! adsr.isActive());
         }
+
+        beginTest ("Block rendering matches per-sample rendering");
+        {
+            auto random = getRandom();
+
+            ADSR perSample, perBlock;
+
+            for (auto* a : { &perSample, &perBlock })
+            {
+                a->setSampleRate (sampleRate);
+                a->setParameters ({ 0.01f, 0.02f, 0.6f, 0.03f });
+                a->noteOn();
+            }
+
+            std::vector<float> block (512);
+
+            for (int position = 0; position < 4000;)
+            {
+                if (position > 2000 && perBlock.getStage() == ADSR::Stage::sustain)
+                {
+                    perSample.noteOff();
+                    perBlock.noteOff();
+                }
+
+                const auto numSamples = random.nextInt ({ 1, (int) block.size() });
+                perBlock.renderNextBlock (block.data(), numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (block[(size_t) i], perSample.getNextSample(), 1.0e-3f);
+
+                position += numSamples;
+            }
+
+            expect (! perBlock.isActive());
+        }
+
+        beginTest ("Segments report the sample on which each stage starts");
+        {
+            ADSR envelope;
+            envelope.setSampleRate (1000.0);
+            envelope.setParameters ({ 0.1f, 0.05f, 0.5f, 0.02f });
+            envelope.noteOn();
+
+            std::vector<ADSR::Segment> segments;
+            const auto collect = [&] (const ADSR::Segment& s) { segments.push_back (s); };
+
+            envelope.processSegments (200, collect);
+            envelope.noteOff();
+            envelope.processSegments (30, collect);
+
+            expect (segments.size() == 5);
+
+            const std::pair<ADSR::Stage, int> expected[] { { ADSR::Stage::attack, 0 },  { ADSR::Stage::decay, 100 },
+                                                           { ADSR::Stage::sustain, 150 }, { ADSR::Stage::release, 0 },
+                                                           { ADSR::Stage::idle, 20 } };
+
+            for (size_t i = 0; i < jmin (segments.size(), std::size (expected)); ++i)
+            {
+                expect (segments[i].stage == expected[i].first);
+                expectEquals (segments[i].startSample, expected[i].second);
+            }
+
+            expectWithinAbsoluteError (segments[0].startValue + segments[0].increment * 99.0f, 1.0f, 1.0e-6f);
+        }
     }
 
     static void advanceADSR (ADSR& adsr, int numSamplesToAdvance)
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct WorkgroupToken::Impl
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    std::shared_ptr<void> workgroup;
+    os_workgroup_join_token_s token {};
+   #endif
+};
+
+WorkgroupToken::WorkgroupToken() = default;
+WorkgroupToken::~WorkgroupToken()  { reset(); }
+
+WorkgroupToken::WorkgroupToken (WorkgroupToken&& other) noexcept
+    : impl (std::move (other.impl))
+{
+}
+
+WorkgroupToken& WorkgroupToken::operator= (WorkgroupToken&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        impl = std::move (other.impl);
+    }
+
+    return *this;
+}
+
+void WorkgroupToken::reset()
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (impl != nullptr)
+        if (@available (macOS 11.0, iOS 14.0, *))
+            os_workgroup_leave ((os_workgroup_t) impl->workgroup.get(), &impl->token);
+   #endif
+
+    impl.reset();
+}
+
+//==============================================================================
+AudioWorkgroup AudioWorkgroup::fromNativeHandle ([[maybe_unused]] void* nativeHandle)
+{
+    AudioWorkgroup result;
+
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (nativeHandle != nullptr)
+    {
+        if (@available (macOS 11.0, iOS 14.0, *))
+        {
+            os_retain ((os_workgroup_t) nativeHandle);
+            result.handle = std::shared_ptr<void> (nativeHandle, [] (void* p) { os_release ((os_workgroup_t) p); });
+        }
+    }
+   #endif
+
+    return result;
+}
+
+void AudioWorkgroup::join (WorkgroupToken& token) const
+{
+    token.reset();
+
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (handle != nullptr)
+    {
+        if (@available (macOS 11.0, iOS 14.0, *))
+        {
+            auto impl = std::make_unique<WorkgroupToken::Impl>();
+            impl->workgroup = handle;
+
+            // This fails if the workgroup has been cancelled, e.g. because its device has stopped
+            if (os_workgroup_join ((os_workgroup_t) handle.get(), &impl->token) == 0)
+                token.impl = std::move (impl);
+        }
+    }
+   #endif
+}
+
+int AudioWorkgroup::getMaxParallelThreadCount() const
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (handle != nullptr)
+        if (@available (macOS 11.0, iOS 14.0, *))
+            return jmax (0, os_workgroup_max_parallel_threads ((os_workgroup_t) handle.get(), nullptr));
+   #endif
+
+    return 0;
+}
+
+WorkStealingThreadPool::Options AudioWorkgroup::makeThreadPoolOptions (WorkStealingThreadPool::Options options) const
+{
+    if (! isValid())
+        return options;
+
+    // The device's IO thread is already one of the workgroup's members
+    if (const auto maxThreads = getMaxParallelThreadCount(); maxThreads > 0)
+        options.numThreads = jlimit (1, jmax (1, maxThreads - 1), options.numThreads > 0 ? options.numThreads : maxThreads - 1);
+
+    const auto numTokens = options.numThreads > 0 ? options.numThreads : SystemStats::getNumCpus();
+    auto tokens = std::make_shared<std::vector<WorkgroupToken>> ((size_t) numTokens);
+
+    return options.withThreadStartCallback ([workgroup = *this, tokens, previous = options.onThreadStart] (int index)
+                  {
+                      if (isPositiveAndBelow (index, (int) tokens->size()))
+                          workgroup.join ((*tokens)[(size_t) index]);
+
+                      if (previous != nullptr)
+                          previous (index);
+                  })
+                  .withThreadStopCallback ([tokens, previous = options.onThreadStop] (int index)
+                  {
+                      if (previous != nullptr)
+                          previous (index);
+
+                      if (isPositiveAndBelow (index, (int) tokens->size()))
+                          (*tokens)[(size_t) index].reset();
+                  });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioWorkgroupTests  : public UnitTest
+{
+public:
+    AudioWorkgroupTests()
+        : UnitTest ("AudioWorkgroup", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("An invalid workgroup leaves thread pool options unchanged");
+        {
+            const AudioWorkgroup workgroup;
+            expect (! workgroup.isValid());
+            expectEquals (workgroup.getMaxParallelThreadCount(), 0);
+
+            const auto options = workgroup.makeThreadPoolOptions (WorkStealingThreadPool::Options{}.withNumThreads (3));
+            expectEquals (options.numThreads, 3);
+            expect (options.onThreadStart == nullptr);
+            expect (options.onThreadStop == nullptr);
+
+            WorkgroupToken token;
+            workgroup.join (token);
+            expect (! token.isValid());
+        }
+    }
+};
+
+static AudioWorkgroupTests audioWorkgroupTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Represents a thread's membership of an AudioWorkgroup.
+
+    A thread stays in the workgroup until this token is reset or destroyed, which
+    must happen on the same thread that joined it.
+
+    @see AudioWorkgroup::join
+
+    @tags{Audio}
+*/
+class JUCE_API  WorkgroupToken
+{
+public:
+    /** Creates a token which doesn't represent membership of any workgroup. */
+    WorkgroupToken();
+
+    /** Destructor. If the thread is still a member of a workgroup, it leaves it. */
+    ~WorkgroupToken();
+
+    WorkgroupToken (WorkgroupToken&&) noexcept;
+    WorkgroupToken& operator= (WorkgroupToken&&) noexcept;
+
+    /** Leaves the workgroup, if the thread is a member of one. */
+    void reset();
+
+    /** Returns true if this token represents membership of a workgroup. */
+    bool isValid() const noexcept                { return impl != nullptr; }
+
+    /** Returns true if this token represents membership of a workgroup. */
+    explicit operator bool() const noexcept      { return isValid(); }
+
+private:
+    friend class AudioWorkgroup;
+
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    JUCE_DECLARE_NON_COPYABLE (WorkgroupToken)
+};
+
+//==============================================================================
+/**
+    A group of threads that work together to meet an audio device's deadline.
+
+    On Apple platforms an audio device's IO thread belongs to an os_workgroup.
+    Any other real-time threads that help to render each buffer should join that
+    workgroup, so that the OS knows about their deadline and schedules them on
+    suitable cores.
+
+    On other platforms workgroups aren't available, so an AudioWorkgroup will
+    always be invalid and joining it does nothing.
+
+    @code
+    WorkStealingThreadPool pool (device->getWorkgroup().makeThreadPoolOptions (WorkStealingThreadPool::Options{}.withRealtimeOptions ({})));
+    @endcode
+
+    @see AudioIODevice::getWorkgroup, WorkgroupToken
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioWorkgroup
+{
+public:
+    /** Creates an invalid workgroup. */
+    AudioWorkgroup() = default;
+
+    /** Creates a workgroup which refers to a native workgroup handle.
+
+        On Apple platforms the handle must be an os_workgroup_t, which will be retained
+        for as long as any copy of this object exists. Elsewhere this returns an invalid
+        workgroup.
+    */
+    static AudioWorkgroup fromNativeHandle (void* nativeHandle);
+
+    /** Adds the calling thread to this workgroup, and stores its membership in a token.
+
+        If the token already represents membership of a workgroup, it's reset first. If
+        the thread couldn't join the workgroup, the token will be left invalid.
+    */
+    void join (WorkgroupToken& token) const;
+
+    /** Returns the number of threads which the OS recommends having in this workgroup,
+        or 0 if that's not known.
+    */
+    int getMaxParallelThreadCount() const;
+
+    /** Returns true if this refers to an actual workgroup. */
+    bool isValid() const noexcept                { return handle != nullptr; }
+
+    /** Returns true if this refers to an actual workgroup. */
+    explicit operator bool() const noexcept      { return isValid(); }
+
+    bool operator== (const AudioWorkgroup& other) const noexcept  { return handle == other.handle; }
+    bool operator!= (const AudioWorkgroup& other) const noexcept  { return handle != other.handle; }
+
+    /** Returns a copy of some thread pool options which makes each of the pool's
+        workers join this workgroup when it starts, and leave it when it stops.
+
+        The number of threads is limited to leave room in the workgroup for the audio
+        device's own thread. Any thread callbacks that were already set are still called.
+        If this workgroup is invalid, the options are returned unchanged.
+    */
+    WorkStealingThreadPool::Options makeThreadPoolOptions (WorkStealingThreadPool::Options options = {}) const;
+
+private:
+    std::shared_ptr<void> handle;
+};
+
+} // namespace juce
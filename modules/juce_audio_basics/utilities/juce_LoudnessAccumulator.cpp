@@ -0,0 +1,400 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+LoudnessAccumulator::LoudnessAccumulator() = default;
+
+LoudnessAccumulator::LoudnessAccumulator (double sampleRate, int numChannels)
+{
+    prepare (sampleRate, numChannels);
+}
+
+LoudnessAccumulator::~LoudnessAccumulator() = default;
+
+//==============================================================================
+void LoudnessAccumulator::prepare (double sampleRate, int numChannels)
+{
+    jassert (sampleRate > 0 && numChannels > 0);
+
+    // These are the BS.1770 pre-filter and RLB filter, recalculated for the sample
+    // rate so that they match the published 48kHz coefficients exactly at 48kHz
+    {
+        const auto k = std::tan (MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+        const auto q = 0.7071752369554196;
+        const auto vh = std::pow (10.0, 3.999843853973347 / 20.0);
+        const auto vb = std::pow (vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const auto k = std::tan (MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+        const auto q = 0.5003270373238773;
+        const auto a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    channels.assign ((size_t) numChannels, {});
+    samplesPerStep = jmax (1, roundToInt (sampleRate / 10.0));
+    reset();
+}
+
+void LoudnessAccumulator::setChannelWeight (int channel, float weight)
+{
+    if (isPositiveAndBelow (channel, getNumChannels()))
+        channels[(size_t) channel].weight = weight;
+    else
+        jassertfalse;
+}
+
+void LoudnessAccumulator::setChannelLayout (const AudioChannelSet& layout)
+{
+    jassert (layout.size() == getNumChannels());
+
+    for (int i = 0; i < jmin (layout.size(), getNumChannels()); ++i)
+    {
+        switch (layout.getTypeOfChannel (i))
+        {
+            case AudioChannelSet::LFE:
+            case AudioChannelSet::LFE2:
+                setChannelWeight (i, 0.0f);
+                break;
+
+            case AudioChannelSet::leftSurround:
+            case AudioChannelSet::rightSurround:
+            case AudioChannelSet::leftSurroundSide:
+            case AudioChannelSet::rightSurroundSide:
+            case AudioChannelSet::leftSurroundRear:
+            case AudioChannelSet::rightSurroundRear:
+                setChannelWeight (i, 1.41f);
+                break;
+
+            default:
+                setChannelWeight (i, 1.0f);
+                break;
+        }
+    }
+}
+
+void LoudnessAccumulator::reset() noexcept
+{
+    for (auto& c : channels)
+        c.s1 = c.s2 = c.s3 = c.s4 = c.sum = 0.0;
+
+    samplesInStep = 0;
+    numStepsSeen = 0;
+    recentSteps.fill (0.0);
+    momentaryBlocks.clear();
+    shortTermBlocks.clear();
+    maxMomentaryEnergy = maxShortTermEnergy = 0.0;
+}
+
+//==============================================================================
+void LoudnessAccumulator::process (const float* const* channelData, int numSamples)
+{
+    jassert (samplesPerStep > 0); // you need to call prepare() first!
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        const auto numThisTime = jmin (numSamples - offset, samplesPerStep - samplesInStep);
+
+        for (size_t i = 0; i < channels.size(); ++i)
+        {
+            auto& c = channels[i];
+
+            if (c.weight == 0.0)
+                continue;
+
+            auto s1 = c.s1, s2 = c.s2, s3 = c.s3, s4 = c.s4, sum = c.sum;
+            const auto* src = channelData[i] + offset;
+
+            for (int j = 0; j < numThisTime; ++j)
+            {
+                const auto x = (double) src[j];
+
+                const auto y = shelf.b0 * x + s1;
+                s1 = shelf.b1 * x - shelf.a1 * y + s2;
+                s2 = shelf.b2 * x - shelf.a2 * y;
+
+                const auto z = highPass.b0 * y + s3;
+                s3 = highPass.b1 * y - highPass.a1 * z + s4;
+                s4 = highPass.b2 * y - highPass.a2 * z;
+
+                sum += z * z;
+            }
+
+            c.s1 = s1;
+            c.s2 = s2;
+            c.s3 = s3;
+            c.s4 = s4;
+            c.sum = sum;
+        }
+
+        offset += numThisTime;
+        samplesInStep += numThisTime;
+
+        if (samplesInStep == samplesPerStep)
+            finishStep();
+    }
+}
+
+void LoudnessAccumulator::process (const AudioBuffer<float>& buffer)
+{
+    jassert (buffer.getNumChannels() >= getNumChannels());
+    process (buffer.getArrayOfReadPointers(), buffer.getNumSamples());
+}
+
+void LoudnessAccumulator::finishStep()
+{
+    auto energy = 0.0;
+
+    for (auto& c : channels)
+    {
+        energy += c.weight * c.sum;
+        c.sum = 0.0;
+    }
+
+    recentSteps[(size_t) (numStepsSeen % stepsPerShortTermBlock)] = energy / samplesPerStep;
+    ++numStepsSeen;
+    samplesInStep = 0;
+
+    if (numStepsSeen >= stepsPerMomentaryBlock)
+    {
+        const auto momentary = getRecentEnergy (stepsPerMomentaryBlock);
+        momentaryBlocks.push_back (momentary);
+        maxMomentaryEnergy = jmax (maxMomentaryEnergy, momentary);
+    }
+
+    if (numStepsSeen >= stepsPerShortTermBlock)
+    {
+        const auto shortTerm = getRecentEnergy (stepsPerShortTermBlock);
+        shortTermBlocks.push_back (shortTerm);
+        maxShortTermEnergy = jmax (maxShortTermEnergy, shortTerm);
+    }
+}
+
+double LoudnessAccumulator::getRecentEnergy (int numSteps) const noexcept
+{
+    // Any steps from before the start of the stream count as silence
+    auto total = 0.0;
+
+    for (int i = 1; i <= jmin (numSteps, numStepsSeen); ++i)
+        total += recentSteps[(size_t) ((numStepsSeen - i) % stepsPerShortTermBlock)];
+
+    return total / numSteps;
+}
+
+//==============================================================================
+std::vector<double> LoudnessAccumulator::applyGates (const std::vector<double>& energies, double relativeGate)
+{
+    const auto absoluteThreshold = loudnessToEnergy (-70.0);
+
+    std::vector<double> gated;
+    gated.reserve (energies.size());
+    auto total = 0.0;
+
+    for (auto e : energies)
+    {
+        if (e > absoluteThreshold)
+        {
+            gated.push_back (e);
+            total += e;
+        }
+    }
+
+    if (gated.empty())
+        return gated;
+
+    const auto relativeThreshold = total / (double) gated.size() * std::pow (10.0, -relativeGate / 10.0);
+
+    gated.erase (std::remove_if (gated.begin(), gated.end(), [=] (double e) { return e <= relativeThreshold; }),
+                 gated.end());
+
+    return gated;
+}
+
+double LoudnessAccumulator::getIntegratedLoudness() const
+{
+    const auto gated = applyGates (momentaryBlocks, 10.0);
+
+    if (gated.empty())
+        return -std::numeric_limits<double>::infinity();
+
+    return energyToLoudness (std::accumulate (gated.begin(), gated.end(), 0.0) / (double) gated.size());
+}
+
+double LoudnessAccumulator::getLoudnessRange() const
+{
+    auto gated = applyGates (shortTermBlocks, 20.0);
+
+    if (gated.empty())
+        return 0.0;
+
+    std::sort (gated.begin(), gated.end());
+
+    const auto percentile = [&gated] (double proportion)
+    {
+        return energyToLoudness (gated[(size_t) roundToInt (proportion * (double) (gated.size() - 1))]);
+    };
+
+    return percentile (0.95) - percentile (0.1);
+}
+
+double LoudnessAccumulator::getMomentaryLoudness() const noexcept
+{
+    return energyToLoudness (getRecentEnergy (stepsPerMomentaryBlock));
+}
+
+double LoudnessAccumulator::getShortTermLoudness() const noexcept
+{
+    return energyToLoudness (getRecentEnergy (stepsPerShortTermBlock));
+}
+
+double LoudnessAccumulator::energyToLoudness (double energy) noexcept
+{
+    return energy > 0.0 ? -0.691 + 10.0 * std::log10 (energy)
+                        : -std::numeric_limits<double>::infinity();
+}
+
+double LoudnessAccumulator::loudnessToEnergy (double loudness) noexcept
+{
+    return std::pow (10.0, (loudness + 0.691) / 10.0);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LoudnessAccumulatorTests  : public UnitTest
+{
+public:
+    LoudnessAccumulatorTests()
+        : UnitTest ("LoudnessAccumulator", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Stereo sine matches its level");
+        {
+            // EBU Tech 3341 case 1: a 1kHz stereo sine at -23 dBFS reads -23 LUFS
+            for (auto sampleRate : { 44100.0, 48000.0, 96000.0 })
+            {
+                LoudnessAccumulator loudness (sampleRate, 2);
+                addSine (loudness, sampleRate, -23.0, 20.0);
+
+                expectWithinAbsoluteError (loudness.getIntegratedLoudness(), -23.0, 0.1);
+                expectWithinAbsoluteError (loudness.getMomentaryLoudness(), -23.0, 0.1);
+                expectWithinAbsoluteError (loudness.getShortTermLoudness(), -23.0, 0.1);
+                expectWithinAbsoluteError (loudness.getMaxShortTermLoudness(), -23.0, 0.1);
+            }
+        }
+
+        beginTest ("Block size doesn't affect the result");
+        {
+            LoudnessAccumulator a (48000.0, 2), b (48000.0, 2);
+            addSine (a, 48000.0, -18.0, 5.0, 4096);
+            addSine (b, 48000.0, -18.0, 5.0, 333);
+
+            expectEquals (a.getIntegratedLoudness(), b.getIntegratedLoudness());
+            expectEquals (a.getMaxMomentaryLoudness(), b.getMaxMomentaryLoudness());
+        }
+
+        beginTest ("Gating");
+        {
+            // EBU Tech 3341 case 3: the quiet sections are gated out
+            LoudnessAccumulator loudness (48000.0, 2);
+            addSine (loudness, 48000.0, -36.0, 10.0);
+            addSine (loudness, 48000.0, -23.0, 60.0);
+            addSine (loudness, 48000.0, -36.0, 10.0);
+
+            expectWithinAbsoluteError (loudness.getIntegratedLoudness(), -23.0, 0.1);
+
+            LoudnessAccumulator silent (48000.0, 2);
+            addSine (silent, 48000.0, -80.0, 5.0);
+            expect (std::isinf (silent.getIntegratedLoudness()));
+        }
+
+        beginTest ("Loudness range");
+        {
+            // EBU Tech 3342 case 1: 20s at -20 dBFS followed by 20s at -30 dBFS
+            LoudnessAccumulator loudness (48000.0, 2);
+            addSine (loudness, 48000.0, -20.0, 20.0);
+            addSine (loudness, 48000.0, -30.0, 20.0);
+
+            expectWithinAbsoluteError (loudness.getLoudnessRange(), 10.0, 1.0);
+        }
+
+        beginTest ("Channel weights");
+        {
+            LoudnessAccumulator loudness (48000.0, 2);
+            loudness.setChannelLayout (AudioChannelSet::canonicalChannelSet (2));
+            addSine (loudness, 48000.0, -23.0, 5.0);
+            const auto stereo = loudness.getIntegratedLoudness();
+
+            loudness.reset();
+            loudness.setChannelWeight (1, 0.0f);
+            addSine (loudness, 48000.0, -23.0, 5.0);
+
+            expectWithinAbsoluteError (stereo - loudness.getIntegratedLoudness(), 10.0 * std::log10 (2.0), 0.01);
+        }
+    }
+
+private:
+    static void addSine (LoudnessAccumulator& loudness, double sampleRate, double gainDb,
+                         double seconds, int blockSize = 1024)
+    {
+        const auto numSamples = (int) (sampleRate * seconds);
+        const auto gain = Decibels::decibelsToGain (gainDb);
+        AudioBuffer<float> buffer (loudness.getNumChannels(), numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.setSample (ch, i, (float) (gain * std::sin (MathConstants<double>::twoPi * 1000.0 * i / sampleRate)));
+
+        for (int i = 0; i < numSamples; i += blockSize)
+        {
+            const float* channels[] = { buffer.getReadPointer (0, i), buffer.getReadPointer (1, i) };
+            loudness.process (channels, jmin (blockSize, numSamples - i));
+        }
+    }
+};
+
+static LoudnessAccumulatorTests loudnessAccumulatorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Measures the loudness of a stream of audio as described by EBU R128 and
+    ITU-R BS.1770.
+
+    The audio is K-weighted, split into overlapping 400ms gating blocks, and
+    accumulated, so you can push a whole file through it in blocks of any size
+    and then ask for its gated integrated loudness and its loudness range. The
+    momentary and short-term loudness of the most recent audio are also available,
+    so the same object can drive a live meter.
+
+    The gating needs the loudness of every block that has been seen, so the
+    accumulator stores ten values per second of audio until it's reset.
+
+    @code
+    LoudnessAccumulator loudness (reader->sampleRate, (int) reader->numChannels);
+
+    for (auto& block : blocks)
+        loudness.process (block);
+
+    DBG (loudness.getIntegratedLoudness() << " LUFS");
+    @endcode
+
+    @see AudioLevelScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  LoudnessAccumulator
+{
+public:
+    //==============================================================================
+    /** Creates an accumulator. You must call prepare() before using it. */
+    LoudnessAccumulator();
+
+    /** Creates an accumulator and prepares it for the given sample rate and number of channels. */
+    LoudnessAccumulator (double sampleRate, int numChannels);
+
+    /** Destructor. */
+    ~LoudnessAccumulator();
+
+    //==============================================================================
+    /** Calculates the filters for a sample rate, sets the number of channels,
+        and resets the accumulator.
+
+        All channels are given a weight of 1.0. Use setChannelWeight() or
+        setChannelLayout() to change this for surround material.
+    */
+    void prepare (double sampleRate, int numChannels);
+
+    /** Sets how much a channel contributes to the loudness.
+
+        BS.1770 uses 1.0 for the front channels, 1.41 for the surround channels,
+        and 0 to leave out an LFE channel.
+    */
+    void setChannelWeight (int channel, float weight);
+
+    /** Sets the channel weights that BS.1770 recommends for a layout.
+
+        LFE channels are ignored, surround channels are weighted by 1.41, and
+        all other channels count fully.
+    */
+    void setChannelLayout (const AudioChannelSet& layout);
+
+    /** Clears all the accumulated measurements and the state of the filters. */
+    void reset() noexcept;
+
+    /** Returns the number of channels the accumulator was prepared with. */
+    int getNumChannels() const noexcept                 { return (int) channels.size(); }
+
+    //==============================================================================
+    /** Adds a block of audio to the measurement.
+
+        There must be one channel pointer for each of the channels that the
+        accumulator was prepared with.
+    */
+    void process (const float* const* channelData, int numSamples);
+
+    /** Adds a block of audio to the measurement. */
+    void process (const AudioBuffer<float>& buffer);
+
+    //==============================================================================
+    /** Returns the gated integrated loudness of all the audio so far, in LUFS.
+
+        This will be minus infinity if none of the gating blocks were louder
+        than the -70 LUFS absolute gate.
+    */
+    double getIntegratedLoudness() const;
+
+    /** Returns the loudness range of all the audio so far, in LU, as described by
+        EBU Tech 3342.
+    */
+    double getLoudnessRange() const;
+
+    /** Returns the loudness of the most recent 400ms of audio, in LUFS. */
+    double getMomentaryLoudness() const noexcept;
+
+    /** Returns the loudness of the most recent 3 seconds of audio, in LUFS. */
+    double getShortTermLoudness() const noexcept;
+
+    /** Returns the highest momentary loudness that has been seen, in LUFS. */
+    double getMaxMomentaryLoudness() const noexcept     { return energyToLoudness (maxMomentaryEnergy); }
+
+    /** Returns the highest short-term loudness that has been seen, in LUFS. */
+    double getMaxShortTermLoudness() const noexcept     { return energyToLoudness (maxShortTermEnergy); }
+
+    //==============================================================================
+    /** Converts a mean-square energy to a loudness in LUFS. */
+    static double energyToLoudness (double energy) noexcept;
+
+    /** Converts a loudness in LUFS to a mean-square energy. */
+    static double loudnessToEnergy (double loudness) noexcept;
+
+private:
+    //==============================================================================
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct Channel
+    {
+        double s1 = 0.0, s2 = 0.0, s3 = 0.0, s4 = 0.0;
+        double sum = 0.0;
+        double weight = 1.0;
+    };
+
+    // The energy of each 100ms step is kept for the last 3 seconds, which is
+    // enough to build both the momentary and short-term windows
+    static constexpr int stepsPerMomentaryBlock = 4, stepsPerShortTermBlock = 30;
+
+    void finishStep();
+    double getRecentEnergy (int numSteps) const noexcept;
+    static std::vector<double> applyGates (const std::vector<double>& energies, double relativeGate);
+
+    Biquad shelf, highPass;
+    std::vector<Channel> channels;
+    int samplesPerStep = 0, samplesInStep = 0;
+
+    std::array<double, stepsPerShortTermBlock> recentSteps {};
+    int numStepsSeen = 0;
+
+    std::vector<double> momentaryBlocks, shortTermBlocks;
+    double maxMomentaryEnergy = 0.0, maxShortTermEnergy = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessAccumulator)
+};
+
+} // namespace juce
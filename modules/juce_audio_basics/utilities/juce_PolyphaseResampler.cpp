@@ -0,0 +1,466 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    struct Preset
+    {
+        int numTaps, numPhases;
+        double kaiserBeta, cutoff;
+    };
+
+    static Preset getPreset (PolyphaseResampler::Quality quality) noexcept
+    {
+        switch (quality)
+        {
+            case PolyphaseResampler::Quality::draft:    return { 16,  128, 5.0,  0.80 };
+            case PolyphaseResampler::Quality::high:     return { 64,  512, 9.0,  0.93 };
+            case PolyphaseResampler::Quality::best:     return { 128, 1024, 11.0, 0.96 };
+            case PolyphaseResampler::Quality::normal:   break;
+        }
+
+        return { 32, 256, 7.0, 0.88 };
+    }
+
+    // The zeroth order modified Bessel function of the first kind, used by the Kaiser window
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+        const auto halfX = x * 0.5;
+
+        for (int k = 1; k < 500; ++k)
+        {
+            const auto factor = halfX / k;
+            term *= factor * factor;
+            sum += term;
+
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    static float dotProduct (const float* a, const float* b, int num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_dotpr (a, 1, b, 1, &result, (vDSP_Length) num);
+        return result;
+       #else
+        int i = 0;
+        float result = 0;
+
+        #if JUCE_USE_SSE_INTRINSICS
+         auto sum0 = _mm_setzero_ps();
+         auto sum1 = _mm_setzero_ps();
+
+         for (; i + 8 <= num; i += 8)
+         {
+             sum0 = _mm_add_ps (sum0, _mm_mul_ps (_mm_loadu_ps (a + i),     _mm_loadu_ps (b + i)));
+             sum1 = _mm_add_ps (sum1, _mm_mul_ps (_mm_loadu_ps (a + i + 4), _mm_loadu_ps (b + i + 4)));
+         }
+
+         for (; i + 4 <= num; i += 4)
+             sum0 = _mm_add_ps (sum0, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+
+         float lanes[4];
+         _mm_storeu_ps (lanes, _mm_add_ps (sum0, sum1));
+         result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        #elif JUCE_USE_ARM_NEON
+         auto sum = vdupq_n_f32 (0.0f);
+
+         for (; i + 4 <= num; i += 4)
+             sum = vmlaq_f32 (sum, vld1q_f32 (a + i), vld1q_f32 (b + i));
+
+         float lanes[4];
+         vst1q_f32 (lanes, sum);
+         result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        #endif
+
+        for (; i < num; ++i)
+            result += a[i] * b[i];
+
+        return result;
+       #endif
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler() {}
+PolyphaseResampler::~PolyphaseResampler() {}
+
+void PolyphaseResampler::prepare (int newNumChannels, Quality newQuality, double maximumDownsamplingRatio)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    jassert (newNumChannels > 0 && maximumDownsamplingRatio >= 1.0);
+
+    const auto preset = getPreset (newQuality);
+
+    quality = newQuality;
+    numChannels = newNumChannels;
+    baseNumTaps = preset.numTaps;
+    numPhases = preset.numPhases;
+    maxRatio = jmax (1.0, maximumDownsamplingRatio);
+    maxNumTaps = getNumTaps (maxRatio);
+
+    // The prototype is a windowed sinc spanning baseNumTaps input samples, with a few
+    // extra zeros at the end so that the interpolation never has to check its bounds
+    const auto prototypeLength = baseNumTaps * numPhases + 1;
+    const auto halfLength = baseNumTaps * 0.5;
+    const auto windowScale = 1.0 / besselI0 (preset.kaiserBeta);
+
+    prototype.assign ((size_t) prototypeLength + 2, 0.0f);
+
+    for (int i = 0; i < prototypeLength; ++i)
+    {
+        const auto distance = (double) i / numPhases - halfLength;
+        const auto x = preset.cutoff * distance;
+        const auto sinc = x == 0.0 ? 1.0 : std::sin (MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+        const auto windowPos = distance / halfLength;
+        const auto window = besselI0 (preset.kaiserBeta * std::sqrt (jmax (0.0, 1.0 - windowPos * windowPos))) * windowScale;
+
+        prototype[(size_t) i] = (float) (preset.cutoff * sinc * window);
+    }
+
+    // Normalise for unity gain at DC, averaged over all the phases
+    double sum = 0;
+
+    for (int i = 0; i < baseNumTaps * numPhases; ++i)
+        sum += prototype[(size_t) i];
+
+    const auto gain = (float) (numPhases / sum);
+
+    for (auto& value : prototype)
+        value *= gain;
+
+    phaseTable.assign ((size_t) ((numPhases + 2) * baseNumTaps), 0.0f);
+
+    for (int phase = 0; phase < numPhases + 2; ++phase)
+        for (int tap = 0; tap < baseNumTaps; ++tap)
+            phaseTable[(size_t) (phase * baseNumTaps + tap)] = prototype[(size_t) jmin (phase + tap * numPhases, prototypeLength + 1)];
+
+    coefficients.assign ((size_t) maxNumTaps, 0.0f);
+    history.setSize (numChannels, maxNumTaps + 1024);
+
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    history.clear();
+    writePosition = maxNumTaps;
+    subSamplePos = 1.0;
+}
+
+int PolyphaseResampler::getNumTaps (double speedRatio) const noexcept
+{
+    if (speedRatio <= 1.0)
+        return baseNumTaps;
+
+    const auto numTaps = (int) std::ceil (baseNumTaps * jmin (speedRatio, maxRatio));
+    return (numTaps + 3) & ~3;
+}
+
+int PolyphaseResampler::getLatencyInInputSamples (double speedRatio) const noexcept
+{
+    return getNumTaps (speedRatio) / 2;
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept
+{
+    int numNeeded = 0;
+    auto pos = subSamplePos;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            ++numNeeded;
+            pos -= 1.0;
+        }
+
+        pos += speedRatio;
+    }
+
+    return numNeeded;
+}
+
+int PolyphaseResampler::getNumOutputSamplesAvailable (double speedRatio, int numInputSamplesAvailable) const noexcept
+{
+    jassert (speedRatio > 0.0);
+
+    int numOutputs = 0, numUsed = 0;
+    auto pos = subSamplePos;
+
+    for (;;)
+    {
+        while (pos >= 1.0)
+        {
+            if (numUsed == numInputSamplesAvailable)
+                return numOutputs;
+
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        pos += speedRatio;
+        ++numOutputs;
+    }
+}
+
+//==============================================================================
+void PolyphaseResampler::pushSample (const float* const* inputs, int index) noexcept
+{
+    if (writePosition == history.getNumSamples())
+    {
+        // Move the newest samples back to the start, keeping enough for the longest filter
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* data = history.getWritePointer (channel);
+            std::memmove (data, data + writePosition - maxNumTaps, (size_t) maxNumTaps * sizeof (float));
+        }
+
+        writePosition = maxNumTaps;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        history.setSample (channel, writePosition, inputs[channel][index]);
+
+    ++writePosition;
+}
+
+const float* PolyphaseResampler::calculateCoefficients (double speedRatio, int numTaps, float offset) noexcept
+{
+    auto* dest = coefficients.data();
+
+    if (speedRatio <= 1.0)
+    {
+        // Tap k sits at (k + 1 - offset) samples along the prototype, so all the taps share
+        // the same pair of neighbouring phases and we can interpolate between two table rows
+        const auto phasePos = (float) numPhases * (1.0f - offset);
+        const auto phase = jlimit (0, numPhases, (int) phasePos);
+        const auto alpha = phasePos - (float) phase;
+
+        const auto* rowA = phaseTable.data() + phase * baseNumTaps;
+        const auto* rowB = rowA + baseNumTaps;
+
+        for (int i = 0; i < numTaps; ++i)
+            dest[i] = rowA[i] + alpha * (rowB[i] - rowA[i]);
+
+        return dest;
+    }
+
+    // When downsampling, the prototype is stretched by the ratio to lower its cutoff
+    const auto stretch = jmin (speedRatio, maxRatio);
+    const auto step = numPhases / stretch;
+    const auto prototypeEnd = (double) (baseNumTaps * numPhases);
+    const auto gain = (float) (1.0 / stretch);
+
+    auto pos = ((1.0 - numTaps * 0.5 - offset) / stretch + baseNumTaps * 0.5) * numPhases;
+
+    for (int i = 0; i < numTaps; ++i, pos += step)
+    {
+        if (pos < 0.0 || pos >= prototypeEnd)
+        {
+            dest[i] = 0.0f;
+            continue;
+        }
+
+        const auto index = (int) pos;
+        const auto alpha = (float) (pos - index);
+        const auto a = prototype[(size_t) index];
+        const auto b = prototype[(size_t) index + 1];
+
+        dest[i] = gain * (a + alpha * (b - a));
+    }
+
+    return dest;
+}
+
+int PolyphaseResampler::process (double speedRatio,
+                                 const float* const* inputs,
+                                 float* const* outputs,
+                                 int numOutputSamplesToProduce) noexcept
+{
+    // You need to call prepare() before using this!
+    jassert (numChannels > 0);
+
+    const auto numTaps = getNumTaps (speedRatio);
+    int numUsed = 0;
+    auto pos = subSamplePos;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            pushSample (inputs, numUsed++);
+            pos -= 1.0;
+        }
+
+        const auto* coeffs = calculateCoefficients (speedRatio, numTaps, (float) pos);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            outputs[channel][i] = PolyphaseResamplerHelpers::dotProduct (history.getReadPointer (channel, writePosition - numTaps),
+                                                                         coeffs, numTaps);
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+    return numUsed;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PolyphaseResamplerTests  : public UnitTest
+{
+public:
+    PolyphaseResamplerTests()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Resampled sine waves match the expected signal");
+        {
+            const std::pair<PolyphaseResampler::Quality, float> qualitiesAndTolerances[]
+            {
+                { PolyphaseResampler::Quality::draft,  4.0e-3f },
+                { PolyphaseResampler::Quality::normal, 5.0e-4f },
+                { PolyphaseResampler::Quality::high,   2.0e-5f },
+                { PolyphaseResampler::Quality::best,   5.0e-6f }
+            };
+
+            for (const auto& [quality, tolerance] : qualitiesAndTolerances)
+                for (auto ratio : { 1.0, 0.75, 0.3, 1.5, 2.7 })
+                    expectLessThan (getErrorForSine (quality, ratio, 0.02), tolerance);
+        }
+
+        beginTest ("Input consumption is predicted exactly");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (2, PolyphaseResampler::Quality::normal);
+
+            AudioBuffer<float> input (2, 4096), output (2, 512);
+            input.clear();
+
+            for (auto ratio : { 1.37, 0.61, 1.0, 3.3, 0.999 })
+            {
+                for (int block = 0; block < 4; ++block)
+                {
+                    const auto numNeeded = resampler.getNumInputSamplesNeeded (ratio, output.getNumSamples());
+                    const auto numUsed = resampler.process (ratio, input.getArrayOfReadPointers(),
+                                                            output.getArrayOfWritePointers(), output.getNumSamples());
+                    expectEquals (numUsed, numNeeded);
+
+                    const auto numAvailable = resampler.getNumOutputSamplesAvailable (ratio, 300);
+                    expectLessOrEqual (resampler.getNumInputSamplesNeeded (ratio, numAvailable), 300);
+                    expectGreaterThan (resampler.getNumInputSamplesNeeded (ratio, numAvailable + 1), 300);
+                }
+            }
+        }
+
+        beginTest ("Frequencies above the new Nyquist limit are removed when downsampling");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (1, PolyphaseResampler::Quality::normal);
+
+            constexpr auto ratio = 2.0;
+            const auto input = makeSine (1, 0.4, 8192);
+            AudioBuffer<float> output (1, 4000);
+
+            resampler.process (ratio, input.getArrayOfReadPointers(), output.getArrayOfWritePointers(), output.getNumSamples());
+
+            const auto start = resampler.getLatencyInInputSamples (ratio);
+            expectLessThan (output.getRMSLevel (0, start, output.getNumSamples() - start), 1.0e-3f);
+        }
+    }
+
+private:
+    static AudioBuffer<float> makeSine (int numChannels, double frequency, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, (float) std::sin (MathConstants<double>::twoPi * frequency * i + channel));
+
+        return buffer;
+    }
+
+    static float getErrorForSine (PolyphaseResampler::Quality quality, double ratio, double frequency)
+    {
+        PolyphaseResampler resampler;
+        resampler.prepare (2, quality);
+
+        constexpr int numOutputs = 2000;
+        const auto input = makeSine (2, frequency, (int) (numOutputs * ratio) + 16);
+        AudioBuffer<float> output (2, numOutputs);
+
+        // Feed the input in uneven blocks to check that the state carries over correctly
+        int inputPos = 0;
+
+        for (int outputPos = 0; outputPos < numOutputs;)
+        {
+            const auto numToDo = jmin (numOutputs - outputPos, 1 + (outputPos % 97));
+            const float* inputs[]  = { input.getReadPointer (0, inputPos),  input.getReadPointer (1, inputPos) };
+            float* outputs[]       = { output.getWritePointer (0, outputPos), output.getWritePointer (1, outputPos) };
+
+            inputPos += resampler.process (ratio, inputs, outputs, numToDo);
+            outputPos += numToDo;
+        }
+
+        // Output sample i lines up with input time (i * ratio - latency)
+        const auto latency = resampler.getLatencyInInputSamples (ratio);
+        auto maxError = 0.0f;
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < numOutputs; ++i)
+            {
+                const auto time = i * ratio - latency;
+
+                if (time < latency * 2)
+                    continue;
+
+                const auto expected = (float) std::sin (MathConstants<double>::twoPi * frequency * time + channel);
+                maxError = jmax (maxError, std::abs (output.getSample (channel, i) - expected));
+            }
+        }
+
+        return maxError;
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+#endif
+
+} // namespace juce
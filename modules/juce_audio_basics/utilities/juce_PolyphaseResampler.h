@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high-quality multichannel resampler using a windowed-sinc filter.
+
+    Unlike the GenericInterpolator classes, which work on one channel and use a
+    handful of neighbouring samples, this processes all channels of a stream at
+    once with a band-limited Kaiser-windowed sinc kernel. The kernel is precomputed
+    into a polyphase table when the resampler is prepared, so each output sample
+    only costs one set of dot products per channel. When downsampling, the kernel
+    is stretched to lower its cutoff below the new Nyquist frequency, which keeps
+    the output free of aliasing.
+
+    Like the other interpolators this is stateful, so call reset() whenever
+    there's a break in the continuity of the input stream.
+
+    @see ResamplingAudioSource, GenericInterpolator
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The available trade-offs between filter length and quality. */
+    enum class Quality
+    {
+        draft,      /**< 16 taps, around 50 dB of stopband attenuation. */
+        normal,     /**< 32 taps, around 70 dB of stopband attenuation. */
+        high,       /**< 64 taps, around 90 dB of stopband attenuation. */
+        best        /**< 128 taps, around 110 dB of stopband attenuation. */
+    };
+
+    //==============================================================================
+    /** Creates an unprepared resampler. You must call prepare() before using it. */
+    PolyphaseResampler();
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Allocates the filter tables and history buffers, and resets the resampler.
+
+        @param numChannels                  the number of channels that will be processed
+        @param quality                      the filter quality to use
+        @param maximumDownsamplingRatio     the largest speed ratio that the filter will
+                                            be scaled for. Higher ratios will still work, but
+                                            may let some aliasing through
+    */
+    void prepare (int numChannels, Quality quality, double maximumDownsamplingRatio = 4.0);
+
+    /** Clears the history of the resampler.
+
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    /** Returns the number of channels the resampler was prepared with. */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+    /** Returns the quality that the resampler was prepared with. */
+    Quality getQuality() const noexcept                 { return quality; }
+
+    /** Returns the delay introduced by the filter, measured in input samples.
+
+        The filter gets longer when downsampling, so this depends on the speed ratio.
+    */
+    int getLatencyInInputSamples (double speedRatio) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of input samples that a call to process() with the
+        same arguments would consume.
+
+        This is exact, so it can be used to read precisely the right amount of
+        audio from a source before resampling it.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept;
+
+    /** Returns the largest number of output samples that process() could produce
+        without needing more than the given number of input samples.
+
+        This is the counterpart of getNumInputSamplesNeeded(), for when the amount of
+        input is fixed and the amount of output can vary.
+    */
+    int getNumOutputSamplesAvailable (double speedRatio, int numInputSamplesAvailable) const noexcept;
+
+    /** Resamples a block of audio.
+
+        @param speedRatio                   the number of input samples to use for each output sample
+        @param inputs                       the source channels to read from. These must contain at
+                                            least getNumInputSamplesNeeded() samples
+        @param outputs                      the channels to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* const* inputs,
+                 float* const* outputs,
+                 int numOutputSamplesToProduce) noexcept;
+
+private:
+    //==============================================================================
+    int getNumTaps (double speedRatio) const noexcept;
+    void pushSample (const float* const* inputs, int index) noexcept;
+    const float* calculateCoefficients (double speedRatio, int numTaps, float offset) noexcept;
+
+    Quality quality = Quality::normal;
+    int numChannels = 0, baseNumTaps = 0, numPhases = 0, maxNumTaps = 0;
+    double maxRatio = 1.0;
+
+    // The prototype kernel, sampled numPhases times per input sample, and the same
+    // values rearranged so that each phase's taps are contiguous
+    std::vector<float> prototype, phaseTable;
+    std::vector<float> coefficients;
+
+    AudioBuffer<float> history;
+    int writePosition = 0;
+    double subSamplePos = 1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
@@ -78,6 +78,27 @@ public:
         countdown = 0;
     }
 
+    //==============================================================================
+    /** Fills an array with the next values of the ramp.
+
+        This is identical to calling getNextValue numSamples times, but once the
+        ramp has reached its target the rest of the array is filled in one go.
+
+        @param dest         Pointer to a raw array to fill
+        @param numSamples   Length of the array
+    */
+    void fillRamp (FloatType* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        auto i = 0;
+
+        for (; i < numSamples && isSmoothing(); ++i)
+            dest[i] = getNextSmoothedValue();
+
+        FloatVectorOperations::fill (dest + i, target, numSamples - i);
+    }
+
     //==============================================================================
     /** Applies a smoothed gain to a stream of samples
         S[i] *= gain
@@ -86,17 +107,7 @@ public:
     */
     void applyGain (FloatType* samples, int numSamples) noexcept
     {
-        jassert (numSamples >= 0);
-
-        if (isSmoothing())
-        {
-            for (int i = 0; i < numSamples; ++i)
-                samples[i] *= getNextSmoothedValue();
-        }
-        else
-        {
-            FloatVectorOperations::multiply (samples, target, numSamples);
-        }
+        applyGain (samples, samples, numSamples);
     }
 
     /** Computes output as a smoothed gain applied to a stream of samples.
@@ -111,8 +122,10 @@ public:
 
         if (isSmoothing())
         {
-            for (int i = 0; i < numSamples; ++i)
-                samplesOut[i] = samplesIn[i] * getNextSmoothedValue();
+            forEachRampChunk (numSamples, [&] (const FloatType* ramp, int start, int num)
+            {
+                FloatVectorOperations::multiply (samplesOut + start, samplesIn + start, ramp, num);
+            });
         }
         else
         {
@@ -127,23 +140,11 @@ public:
 
         if (isSmoothing())
         {
-            if (buffer.getNumChannels() == 1)
+            forEachRampChunk (numSamples, [&] (const FloatType* ramp, int start, int num)
             {
-                auto* samples = buffer.getWritePointer (0);
-
-                for (int i = 0; i < numSamples; ++i)
-                    samples[i] *= getNextSmoothedValue();
-            }
-            else
-            {
-                for (auto i = 0; i < numSamples; ++i)
-                {
-                    auto gain = getNextSmoothedValue();
-
-                    for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-                        buffer.setSample (channel, i, buffer.getSample (channel, i) * gain);
-                }
-            }
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    FloatVectorOperations::multiply (buffer.getWritePointer (channel, start), ramp, num);
+            });
         }
         else
         {
@@ -151,6 +152,25 @@ public:
         }
     }
 
+    /** Generates the next numSamples values of the ramp a chunk at a time, in a
+        buffer on the stack, and passes each chunk to a function along with its
+        position and length. This lets the ramp be applied with vector operations
+        without allocating any memory.
+    */
+    template <typename Fn>
+    void forEachRampChunk (int numSamples, Fn&& fn) noexcept
+    {
+        constexpr int maxChunkSize = 128;
+        FloatType ramp[maxChunkSize];
+
+        for (int start = 0; start < numSamples; start += maxChunkSize)
+        {
+            const auto num = jmin (maxChunkSize, numSamples - start);
+            static_cast<SmoothedValueType*> (this)->fillRamp (ramp, num);
+            fn (static_cast<const FloatType*> (ramp), start, num);
+        }
+    }
+
 private:
     //==============================================================================
     FloatType getNextSmoothedValue() noexcept
@@ -307,6 +327,41 @@ public:
         return this->currentValue;
     }
 
+    //==============================================================================
+    /** Fills an array with the next values of the ramp.
+
+        This gives exactly the same values as calling getNextValue numSamples times,
+        but without checking on every sample whether the ramp has finished.
+
+        @param dest         Pointer to a raw array to fill
+        @param numSamples   Length of the array
+        @see getNextValue
+    */
+    void fillRamp (FloatType* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        const auto numSteps = jmin (numSamples, this->countdown);
+
+        if (numSteps > 0)
+        {
+            this->countdown -= numSteps;
+
+            if (this->isSmoothing())
+            {
+                fillRampSteps (dest, numSteps);
+            }
+            else
+            {
+                // the last step lands exactly on the target
+                fillRampSteps (dest, numSteps - 1);
+                dest[numSteps - 1] = this->currentValue = this->target;
+            }
+        }
+
+        FloatVectorOperations::fill (dest + numSteps, this->target, numSamples - numSteps);
+    }
+
     //==============================================================================
     /** Skip the next numSamples samples.
         This is identical to calling getNextValue numSamples times. It returns
@@ -393,6 +448,25 @@ private:
         }
     }
 
+    //==============================================================================
+    template <typename T = SmoothingType>
+    void fillRampSteps (FloatType* dest, int numSteps) noexcept
+    {
+        auto value = this->currentValue;
+
+        for (int i = 0; i < numSteps; ++i)
+        {
+            if constexpr (std::is_same_v<T, ValueSmoothingTypes::Linear>)
+                value += step;
+            else if constexpr (std::is_same_v<T, ValueSmoothingTypes::Multiplicative>)
+                value *= step;
+
+            dest[i] = value;
+        }
+
+        this->currentValue = value;
+    }
+
     //==============================================================================
     FloatType step = FloatType();
     int stepsToTarget = 0;
@@ -549,6 +623,52 @@ public:
             compareData (testData, referenceData);
         }
 
+        beginTest ("Filling ramps");
+        {
+            SmoothedValueType reference, sv;
+
+            for (auto* value : { &reference, &sv })
+            {
+                value->reset (100);
+                value->setCurrentAndTargetValue (1.0f);
+                value->setTargetValue (2.0f);
+            }
+
+            // Chunks that end before, on and after the end of the ramp
+            for (auto numSamples : { 7, 40, 53, 10 })
+            {
+                HeapBlock<float> ramp ((size_t) numSamples);
+                sv.fillRamp (ramp, numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (ramp[i], reference.getNextValue());
+
+                expectEquals (sv.getCurrentValue(), reference.getCurrentValue());
+                expect (sv.isSmoothing() == reference.isSmoothing());
+            }
+
+            expectEquals (sv.getCurrentValue(), 2.0f);
+
+            sv.setTargetValue (1.0f);
+            reference.setTargetValue (1.0f);
+
+            AudioBuffer<float> buffer (2, 150);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (channel, i, 0.5f);
+
+            sv.applyGain (buffer, buffer.getNumSamples());
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto expected = 0.5f * reference.getNextValue();
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    expectEquals (buffer.getSample (channel, i), expected);
+            }
+        }
+
         beginTest ("Skip");
         {
             SmoothedValueType sv;
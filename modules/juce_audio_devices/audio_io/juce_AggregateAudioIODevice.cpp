@@ -0,0 +1,1264 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A second-order control loop that works out how fast a device is running
+    relative to the clock device, from the error in the level of its FIFO.
+
+    The error is measured in seconds. Because a resampling ratio that's too low by
+    a fraction d makes the error grow at d seconds per second, this is a classic
+    phase-locked loop, so a proportional and an integral gain of 2w and w^2 give a
+    critically damped response with a natural frequency of w. The integral term
+    settles on the device's drift.
+*/
+class AggregateAudioIODevice::DriftEstimator
+{
+public:
+    void reset() noexcept
+    {
+        integral = 0.0;
+        restartAcquisition();
+    }
+
+    // Widens the loop again after a dropout, while keeping the drift that's been measured so far
+    void restartAcquisition() noexcept
+    {
+        smoothedError = 0.0;
+        timeSinceLock = 0.0;
+    }
+
+    // Returns the fraction by which the nominal resampling ratio should be corrected
+    double update (double errorSeconds, double periodSeconds) noexcept
+    {
+        timeSinceLock += periodSeconds;
+
+        const auto bandwidth = finalBandwidthHz + (initialBandwidthHz - finalBandwidthHz) * std::exp (-timeSinceLock / narrowingTimeSeconds);
+        const auto omega = MathConstants<double>::twoPi * bandwidth;
+
+        // The error jumps around by up to a block, so smooth it a bit above the loop's bandwidth
+        smoothedError += (errorSeconds - smoothedError) * (1.0 - std::exp (-periodSeconds * 4.0 * omega));
+        integral = jlimit (-maxDrift, maxDrift, integral + omega * omega * smoothedError * periodSeconds);
+
+        return jlimit (-maxDrift, maxDrift, 2.0 * omega * smoothedError + integral);
+    }
+
+    double getDrift() const noexcept    { return integral; }
+
+private:
+    static constexpr double initialBandwidthHz = 0.2, finalBandwidthHz = 0.03, narrowingTimeSeconds = 8.0;
+    static constexpr double maxDrift = 0.01;
+
+    double smoothedError = 0.0, integral = 0.0, timeSinceLock = 0.0;
+};
+
+//==============================================================================
+class AggregateAudioIODevice::SubDevice  : private AudioIODeviceCallback
+{
+public:
+    SubDevice (AggregateAudioIODevice& ownerIn, std::unique_ptr<AudioIODevice> deviceIn, bool isClock)
+        : owner (ownerIn), device (std::move (deviceIn)), isClockDevice (isClock)
+    {
+        jassert (device != nullptr && ! device->isOpen());
+    }
+
+    ~SubDevice() override
+    {
+        close();
+    }
+
+    AudioIODevice& getDevice() const noexcept   { return *device; }
+    String getName() const                      { return device->getName(); }
+    bool isActive() const noexcept              { return active; }
+
+    StringArray getChannelNames (bool forInput) const
+    {
+        StringArray result;
+
+        for (auto& name : forInput ? device->getInputChannelNames() : device->getOutputChannelNames())
+            result.add (device->getName() + ": " + name);
+
+        return result;
+    }
+
+    //==============================================================================
+    String open (const BigInteger& inputs, const BigInteger& outputs, double clockRate, int clockBufferSize)
+    {
+        close();
+
+        auto rate = clockRate;
+        auto bufferSize = clockBufferSize;
+
+        if (! isClockDevice)
+        {
+            rate = findClosest (device->getAvailableSampleRates(), clockRate);
+            bufferSize = findClosest (device->getAvailableBufferSizes(), roundToInt (clockBufferSize * rate / clockRate));
+        }
+
+        auto error = device->open (inputs, outputs, rate, bufferSize);
+
+        if (error.isNotEmpty())
+        {
+            device->close();
+            return error;
+        }
+
+        active = true;
+        numInputs = device->getActiveInputChannels().countNumberOfSetBits();
+        numOutputs = device->getActiveOutputChannels().countNumberOfSetBits();
+        deviceRate = device->getCurrentSampleRate() > 0 ? device->getCurrentSampleRate() : rate;
+        return {};
+    }
+
+    void close()
+    {
+        stop();
+
+        if (active)
+            device->close();
+
+        active = false;
+        numInputs = numOutputs = 0;
+    }
+
+    void start()
+    {
+        if (active)
+            device->start (this);
+    }
+
+    void stop()
+    {
+        if (active && device->isPlaying())
+            device->stop();
+    }
+
+    //==============================================================================
+    // Sets up the FIFOs and the state used by the clock device's callback. This must
+    // only be called while neither device is running.
+    void prepare (double clockRate, int maxClockBlockSize, PolyphaseResampler::Quality quality)
+    {
+        const auto expectedRatio = deviceRate.load() / clockRate;
+        const auto deviceBlockSize = jmax (1, device->getCurrentBufferSizeSamples());
+        const auto maxBlockInDevice = (int) std::ceil (maxClockBlockSize * expectedRatio * maxRatioChange) + 2;
+        const auto fifoSize = 4 * (deviceBlockSize + maxBlockInDevice) + 256;
+
+        inputFifo.setTotalSize (fifoSize);
+        outputFifo.setTotalSize (fifoSize);
+        inputFifoBuffer.setSize (jmax (1, numInputs), fifoSize);
+        outputFifoBuffer.setSize (jmax (1, numOutputs), fifoSize);
+
+        if (numInputs > 0)
+            inputResampler.prepare (numInputs, quality, jmax (1.0, expectedRatio * maxRatioChange));
+
+        if (numOutputs > 0)
+            outputResampler.prepare (numOutputs, quality, jmax (1.0, maxRatioChange / expectedRatio));
+
+        inputScratch.setSize (jmax (1, numInputs), maxBlockInDevice + 2);
+        inputBlock.setSize (jmax (1, numInputs), maxClockBlockSize);
+        outputBlock.setSize (jmax (1, numOutputs), maxClockBlockSize + maxLeftoverSamples);
+        outputScratch.setSize (jmax (1, numOutputs), maxBlockInDevice + 2);
+
+        estimator.reset();
+        resetState();
+    }
+
+    void resetState()
+    {
+        inputFifo.reset();
+        outputFifo.reset();
+        inputResampler.reset();
+        outputResampler.reset();
+        numLeftoverOutputs = 0;
+        setLocked (false);
+        running = false;
+        bufferedSeconds = 0.0;
+    }
+
+    //==============================================================================
+    // These are called on the clock device's thread. At the start of each of its
+    // callbacks, the secondary device's FIFO level is measured and the resampling
+    // ratio is updated, and then each chunk of audio is passed through readInputs()
+    // and writeOutputs().
+    void beginClockBlock (uint64 nowTicksNs, const uint64_t* nowHostTimeNs, int numClockSamples, double clockRate)
+    {
+        if (! running.load (std::memory_order_acquire))
+        {
+            setLocked (false);
+            return;
+        }
+
+        const auto rate = deviceRate.load();
+        const auto deviceBlockSize = (double) lastBlockSize.load();
+        const auto clockBlockInDevice = numClockSamples * rate / clockRate;
+        const auto target = deviceBlockSize + clockBlockInDevice + jmax (deviceBlockSize, clockBlockInDevice) * 0.5;
+        const auto level = getVirtualFifoLevel (nowTicksNs, nowHostTimeNs, rate, deviceBlockSize);
+
+        bufferedSeconds = level / rate;
+        nominalRatio = rate / clockRate;
+
+        if (! isLocked || numDeviceOverruns.load() != lastDeviceOverruns)
+        {
+            if (numInputs > 0)
+            {
+                if (level < target)
+                    return;
+
+                inputFifo.read ((int) (level - target));
+                inputResampler.reset();
+            }
+
+            outputResampler.reset();
+            numLeftoverOutputs = 0;
+            fillOutputFifo ((int) target);
+            estimator.restartAcquisition();
+            ratio = nominalRatio * (1.0 + estimator.getDrift());
+            lastDeviceOverruns = numDeviceOverruns.load();
+            lastDeviceUnderruns = numDeviceUnderruns.load();
+            setLocked (true);
+            return;
+        }
+
+        if (numDeviceUnderruns.load() != lastDeviceUnderruns)
+        {
+            lastDeviceUnderruns = numDeviceUnderruns.load();
+            fillOutputFifo ((int) target);
+        }
+
+        // With inputs, a high level means that the device is producing audio too quickly;
+        // with only outputs, a low level means that it's consuming it too quickly.
+        const auto error = (numInputs > 0 ? level - target : target - level) / rate;
+        ratio = nominalRatio * (1.0 + estimator.update (error, numClockSamples / clockRate));
+        driftPpm = estimator.getDrift() * 1.0e6;
+    }
+
+    void readInputs (int numSamples)
+    {
+        if (numInputs == 0)
+            return;
+
+        if (isLocked)
+        {
+            const auto numNeeded = inputResampler.getNumInputSamplesNeeded (ratio, numSamples);
+            jassert (numNeeded <= inputScratch.getNumSamples());
+
+            if (inputFifo.getNumReady() >= numNeeded)
+            {
+                const auto scope = inputFifo.read (numNeeded);
+
+                for (int channel = 0; channel < numInputs; ++channel)
+                {
+                    inputScratch.copyFrom (channel, 0, inputFifoBuffer, channel, scope.startIndex1, scope.blockSize1);
+                    inputScratch.copyFrom (channel, scope.blockSize1, inputFifoBuffer, channel, scope.startIndex2, scope.blockSize2);
+                }
+
+                inputResampler.process (ratio, inputScratch.getArrayOfReadPointers(), inputBlock.getArrayOfWritePointers(), numSamples);
+                return;
+            }
+
+            ++numClockUnderruns;
+            setLocked (false);
+        }
+
+        inputBlock.clear (0, numSamples);
+    }
+
+    void writeOutputs (int numSamples)
+    {
+        if (numOutputs == 0 || ! isLocked)
+            return;
+
+        // When downsampling, the next output sample may need more input than is left, so
+        // the last few samples can be carried over to the start of the next chunk
+        const auto outputRatio = 1.0 / ratio;
+        const auto numAvailable = numLeftoverOutputs + numSamples;
+        const auto numResampled = outputResampler.getNumOutputSamplesAvailable (outputRatio, numAvailable);
+        jassert (numResampled <= outputScratch.getNumSamples());
+
+        const auto numUsed = outputResampler.process (outputRatio, outputBlock.getArrayOfReadPointers(),
+                                                      outputScratch.getArrayOfWritePointers(), numResampled);
+        numLeftoverOutputs = numAvailable - numUsed;
+        jassert (numLeftoverOutputs <= maxLeftoverSamples);
+
+        for (int channel = 0; channel < numOutputs; ++channel)
+            std::memmove (outputBlock.getWritePointer (channel), outputBlock.getReadPointer (channel, numUsed),
+                          (size_t) numLeftoverOutputs * sizeof (float));
+
+        if (writeToFifo (outputFifo, outputFifoBuffer, outputScratch.getArrayOfReadPointers(), numOutputs, numResampled) < numResampled)
+            ++numClockOverruns;
+    }
+
+    int getNumInputs() const noexcept                       { return numInputs; }
+    int getNumOutputs() const noexcept                      { return numOutputs; }
+    const float* getInputChannel (int channel) const        { return inputBlock.getReadPointer (channel); }
+    float* getOutputChannel (int channel)                   { return outputBlock.getWritePointer (channel, numLeftoverOutputs); }
+
+    int getLatencyInClockSamples (bool forInput, double clockRate) const
+    {
+        const auto rate = deviceRate.load();
+        auto latency = (double) (forInput ? device->getInputLatencyInSamples() : device->getOutputLatencyInSamples());
+
+        if (! isClockDevice)
+        {
+            const auto blockSize = (double) device->getCurrentBufferSizeSamples();
+            const auto clockBlockInDevice = owner.maxChunkSize * rate / clockRate;
+            const auto targetLevel = blockSize + clockBlockInDevice + jmax (blockSize, clockBlockInDevice) * 0.5;
+            const auto& resampler = forInput ? inputResampler : outputResampler;
+            latency += targetLevel + resampler.getLatencyInInputSamples (forInput ? rate / clockRate : clockRate / rate);
+        }
+
+        return roundToInt (latency * clockRate / rate);
+    }
+
+    DeviceStatistics getStatistics() const
+    {
+        DeviceStatistics stats;
+
+        if (isClockDevice)
+        {
+            stats.isLocked = true;
+            return stats;
+        }
+
+        stats.isLocked = locked.load();
+        stats.estimatedDriftPpm = driftPpm.load();
+        stats.bufferedSeconds = bufferedSeconds.load();
+        stats.numUnderruns = numDeviceUnderruns.load() + numClockUnderruns.load();
+        stats.numOverruns = numDeviceOverruns.load() + numClockOverruns.load();
+        return stats;
+    }
+
+    BigInteger activeInputs, activeOutputs;
+    int firstInputChannel = 0, firstOutputChannel = 0;
+
+private:
+    //==============================================================================
+    void audioDeviceIOCallbackWithContext (const float* const* inputChannelData, int numInputChannels,
+                                           float* const* outputChannelData, int numOutputChannels,
+                                           int numSamples, const AudioIODeviceCallbackContext& context) override
+    {
+        if (isClockDevice)
+        {
+            owner.processClockBlock (inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context);
+            return;
+        }
+
+        // The count is odd while the FIFOs and timestamps are being updated, so that the clock
+        // device's thread can tell whether it's read a consistent set of them
+        callbackCount.fetch_add (1, std::memory_order_acq_rel);
+
+        if (numInputs > 0)
+            if (writeToFifo (inputFifo, inputFifoBuffer, inputChannelData, numInputChannels, numSamples) < numSamples && locked.load())
+                ++numDeviceOverruns;
+
+        if (numOutputs > 0)
+        {
+            const auto scope = outputFifo.read (numSamples);
+            const auto numRead = scope.blockSize1 + scope.blockSize2;
+
+            for (int channel = 0; channel < numOutputChannels; ++channel)
+            {
+                if (auto* dest = outputChannelData[channel])
+                {
+                    if (channel < numOutputs)
+                    {
+                        FloatVectorOperations::copy (dest, outputFifoBuffer.getReadPointer (channel, scope.startIndex1), scope.blockSize1);
+                        FloatVectorOperations::copy (dest + scope.blockSize1, outputFifoBuffer.getReadPointer (channel, scope.startIndex2), scope.blockSize2);
+                        FloatVectorOperations::clear (dest + numRead, numSamples - numRead);
+                    }
+                    else
+                    {
+                        FloatVectorOperations::clear (dest, numSamples);
+                    }
+                }
+            }
+
+            if (numRead < numSamples && locked.load())
+                ++numDeviceUnderruns;
+        }
+        else
+        {
+            for (int channel = 0; channel < numOutputChannels; ++channel)
+                if (outputChannelData[channel] != nullptr)
+                    FloatVectorOperations::clear (outputChannelData[channel], numSamples);
+        }
+
+        lastBlockSize = numSamples;
+        lastTicksNs = getTicksNs();
+        lastHostTimeNs = context.hostTimeNs != nullptr ? *context.hostTimeNs : 0;
+        running.store (true, std::memory_order_release);
+
+        callbackCount.fetch_add (1, std::memory_order_release);
+    }
+
+    void audioDeviceAboutToStart (AudioIODevice*) override
+    {
+        if (isClockDevice)
+        {
+            owner.clockDeviceAboutToStart();
+            return;
+        }
+
+        running = false;
+
+        if (device->getCurrentSampleRate() > 0)
+            deviceRate = device->getCurrentSampleRate();
+    }
+
+    void audioDeviceStopped() override
+    {
+        if (isClockDevice)
+            owner.clockDeviceStopped();
+        else
+            running = false;
+    }
+
+    void audioDeviceError (const String& errorMessage) override
+    {
+        owner.handleError (*this, errorMessage);
+    }
+
+    //==============================================================================
+    // Works out how much audio would be in the FIFO if the device delivered or consumed
+    // its samples continuously rather than a block at a time, which removes the
+    // sawtooth that the block size would otherwise add to the measurement.
+    double getVirtualFifoLevel (uint64 nowTicksNs, const uint64_t* nowHostTimeNs, double rate, double deviceBlockSize) const noexcept
+    {
+        auto& fifo = numInputs > 0 ? inputFifo : outputFifo;
+        int level = 0;
+        uint64 ticksNs = 0, hostTimeNs = 0;
+
+        for (int attempt = 0; attempt < 8; ++attempt)
+        {
+            const auto countBefore = callbackCount.load (std::memory_order_acquire);
+
+            level = fifo.getNumReady();
+            ticksNs = lastTicksNs.load();
+            hostTimeNs = lastHostTimeNs.load();
+
+            if ((countBefore & 1) == 0 && callbackCount.load (std::memory_order_acquire) == countBefore)
+                break;
+        }
+
+        const auto elapsedNs = (nowHostTimeNs != nullptr && hostTimeNs != 0) ? (int64) (*nowHostTimeNs - hostTimeNs)
+                                                                              : (int64) (nowTicksNs - ticksNs);
+        const auto elapsedSamples = jlimit (0.0, deviceBlockSize, (double) elapsedNs * 1.0e-9 * rate);
+
+        return numInputs > 0 ? level + elapsedSamples : level - elapsedSamples;
+    }
+
+    void fillOutputFifo (int targetLevel)
+    {
+        const auto numToAdd = targetLevel - outputFifo.getNumReady();
+
+        if (numOutputs == 0 || numToAdd <= 0)
+            return;
+
+        const auto scope = outputFifo.write (numToAdd);
+
+        for (int channel = 0; channel < numOutputs; ++channel)
+        {
+            outputFifoBuffer.clear (channel, scope.startIndex1, scope.blockSize1);
+            outputFifoBuffer.clear (channel, scope.startIndex2, scope.blockSize2);
+        }
+    }
+
+    void setLocked (bool shouldBeLocked) noexcept
+    {
+        isLocked = shouldBeLocked;
+        locked = shouldBeLocked;
+    }
+
+    static int writeToFifo (AbstractFifo& fifo, AudioBuffer<float>& buffer,
+                            const float* const* source, int numSourceChannels, int numSamples)
+    {
+        const auto scope = fifo.write (numSamples);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            if (channel < numSourceChannels && source[channel] != nullptr)
+            {
+                buffer.copyFrom (channel, scope.startIndex1, source[channel], scope.blockSize1);
+                buffer.copyFrom (channel, scope.startIndex2, source[channel] + scope.blockSize1, scope.blockSize2);
+            }
+            else
+            {
+                buffer.clear (channel, scope.startIndex1, scope.blockSize1);
+                buffer.clear (channel, scope.startIndex2, scope.blockSize2);
+            }
+        }
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    template <typename Value>
+    static Value findClosest (const Array<Value>& values, Value target)
+    {
+        if (values.isEmpty() || values.contains (target))
+            return target;
+
+        auto result = values.getFirst();
+
+        for (auto value : values)
+            if (std::abs (value - target) < std::abs (result - target))
+                result = value;
+
+        return result;
+    }
+
+    //==============================================================================
+    // The resampling ratio never moves further than this from its nominal value
+    static constexpr double maxRatioChange = 1.02;
+    static constexpr int maxLeftoverSamples = 16;
+
+    AggregateAudioIODevice& owner;
+    std::unique_ptr<AudioIODevice> device;
+    const bool isClockDevice;
+    bool active = false;
+    int numInputs = 0, numOutputs = 0;
+
+    // Shared between the two devices' threads
+    AbstractFifo inputFifo { 1 }, outputFifo { 1 };
+    AudioBuffer<float> inputFifoBuffer, outputFifoBuffer;
+    std::atomic<uint32> callbackCount { 0 };
+    std::atomic<uint64> lastTicksNs { 0 }, lastHostTimeNs { 0 };
+    std::atomic<int> lastBlockSize { 0 };
+    std::atomic<double> deviceRate { 0.0 };
+    std::atomic<bool> running { false }, locked { false };
+    std::atomic<int> numDeviceUnderruns { 0 }, numDeviceOverruns { 0 }, numClockUnderruns { 0 }, numClockOverruns { 0 };
+    std::atomic<double> driftPpm { 0.0 }, bufferedSeconds { 0.0 };
+
+    // Only used by the clock device's thread
+    PolyphaseResampler inputResampler, outputResampler;
+    AudioBuffer<float> inputScratch, inputBlock, outputBlock, outputScratch;
+    DriftEstimator estimator;
+    double nominalRatio = 1.0, ratio = 1.0;
+    bool isLocked = false;
+    int numLeftoverOutputs = 0, lastDeviceUnderruns = 0, lastDeviceOverruns = 0;
+
+    static uint64 getTicksNs() noexcept
+    {
+        return (uint64) (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks()) * 1.0e9);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SubDevice)
+};
+
+//==============================================================================
+AggregateAudioIODevice::AggregateAudioIODevice (const String& deviceName,
+                                                std::vector<std::unique_ptr<AudioIODevice>> devicesToCombine)
+    : AudioIODevice (deviceName, "Aggregate")
+{
+    for (auto& device : devicesToCombine)
+        if (device != nullptr)
+            devices.push_back (std::make_unique<SubDevice> (*this, std::move (device), devices.empty()));
+
+    if (devices.empty())
+        lastError = TRANS("There are no devices in the aggregate");
+}
+
+AggregateAudioIODevice::~AggregateAudioIODevice()
+{
+    close();
+}
+
+int AggregateAudioIODevice::getNumDevices() const noexcept
+{
+    return (int) devices.size();
+}
+
+AudioIODevice* AggregateAudioIODevice::getDevice (int index) const noexcept
+{
+    return isPositiveAndBelow (index, (int) devices.size()) ? &devices[(size_t) index]->getDevice() : nullptr;
+}
+
+AggregateAudioIODevice::DeviceStatistics AggregateAudioIODevice::getDeviceStatistics (int index) const
+{
+    return isPositiveAndBelow (index, (int) devices.size()) ? devices[(size_t) index]->getStatistics() : DeviceStatistics();
+}
+
+//==============================================================================
+StringArray AggregateAudioIODevice::getOutputChannelNames()
+{
+    StringArray names;
+
+    for (auto& d : devices)
+        names.addArray (d->getChannelNames (false));
+
+    return names;
+}
+
+StringArray AggregateAudioIODevice::getInputChannelNames()
+{
+    StringArray names;
+
+    for (auto& d : devices)
+        names.addArray (d->getChannelNames (true));
+
+    return names;
+}
+
+Array<double> AggregateAudioIODevice::getAvailableSampleRates()
+{
+    return devices.empty() ? Array<double>() : devices.front()->getDevice().getAvailableSampleRates();
+}
+
+Array<int> AggregateAudioIODevice::getAvailableBufferSizes()
+{
+    return devices.empty() ? Array<int>() : devices.front()->getDevice().getAvailableBufferSizes();
+}
+
+int AggregateAudioIODevice::getDefaultBufferSize()
+{
+    return devices.empty() ? 512 : devices.front()->getDevice().getDefaultBufferSize();
+}
+
+String AggregateAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                     double sampleRate, int bufferSizeSamples)
+{
+    close();
+    lastError.clear();
+
+    if (devices.empty())
+        return lastError = TRANS("There are no devices in the aggregate");
+
+    auto& clockDevice = devices.front()->getDevice();
+    int firstInput = 0, firstOutput = 0;
+
+    for (auto& d : devices)
+    {
+        const auto numDeviceInputs  = d->getChannelNames (true).size();
+        const auto numDeviceOutputs = d->getChannelNames (false).size();
+
+        d->firstInputChannel  = firstInput;
+        d->firstOutputChannel = firstOutput;
+        d->activeInputs  = inputChannels .getBitRange (firstInput,  numDeviceInputs);
+        d->activeOutputs = outputChannels.getBitRange (firstOutput, numDeviceOutputs);
+
+        firstInput  += numDeviceInputs;
+        firstOutput += numDeviceOutputs;
+
+        // Devices without any active channels aren't opened, except for the one that provides the clock
+        if (d.get() != devices.front().get() && d->activeInputs.isZero() && d->activeOutputs.isZero())
+            continue;
+
+        const auto error = d->open (d->activeInputs, d->activeOutputs,
+                                    sampleRate, bufferSizeSamples);
+
+        if (error.isNotEmpty())
+        {
+            lastError = d->getName() + ": " + error;
+            close();
+            return lastError;
+        }
+
+        if (d.get() == devices.front().get())
+        {
+            sampleRate = clockDevice.getCurrentSampleRate();
+            bufferSizeSamples = clockDevice.getCurrentBufferSizeSamples();
+        }
+    }
+
+    for (auto& d : devices)
+    {
+        if (! d->isActive())
+            continue;
+
+        const auto deviceInputs  = d->getDevice().getActiveInputChannels();
+        const auto deviceOutputs = d->getDevice().getActiveOutputChannels();
+
+        for (auto bit = deviceInputs.findNextSetBit (0); bit >= 0; bit = deviceInputs.findNextSetBit (bit + 1))
+            activeInputs.setBit (d->firstInputChannel + bit);
+
+        for (auto bit = deviceOutputs.findNextSetBit (0); bit >= 0; bit = deviceOutputs.findNextSetBit (bit + 1))
+            activeOutputs.setBit (d->firstOutputChannel + bit);
+    }
+
+    prepareBuffers();
+    return {};
+}
+
+void AggregateAudioIODevice::prepareBuffers()
+{
+    const auto clockRate = devices.front()->getDevice().getCurrentSampleRate();
+
+    maxChunkSize = jmax (1, devices.front()->getDevice().getCurrentBufferSizeSamples());
+    totalNumActiveInputs = totalNumActiveOutputs = 0;
+
+    for (auto& d : devices)
+    {
+        totalNumActiveInputs  += d->getNumInputs();
+        totalNumActiveOutputs += d->getNumOutputs();
+    }
+
+    inputPointers .calloc ((size_t) jmax (1, totalNumActiveInputs));
+    outputPointers.calloc ((size_t) jmax (1, totalNumActiveOutputs));
+
+    if (clockRate > 0)
+        for (size_t i = 1; i < devices.size(); ++i)
+            if (devices[i]->isActive())
+                devices[i]->prepare (clockRate, maxChunkSize, resamplingQuality);
+}
+
+void AggregateAudioIODevice::close()
+{
+    stop();
+
+    for (auto& d : devices)
+        d->close();
+
+    activeInputs.clear();
+    activeOutputs.clear();
+    totalNumActiveInputs = totalNumActiveOutputs = 0;
+}
+
+bool AggregateAudioIODevice::isOpen()
+{
+    return ! devices.empty() && devices.front()->isActive();
+}
+
+void AggregateAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    if (newCallback == nullptr || ! isOpen())
+        return;
+
+    stop();
+
+    for (size_t i = 1; i < devices.size(); ++i)
+        if (devices[i]->isActive())
+            devices[i]->resetState();
+
+    // The clock device starts first, so that the FIFOs aren't filled up before anything reads them
+    callback = newCallback;
+    devices.front()->start();
+
+    for (size_t i = 1; i < devices.size(); ++i)
+        devices[i]->start();
+
+    playing = true;
+}
+
+void AggregateAudioIODevice::stop()
+{
+    if (! playing)
+        return;
+
+    devices.front()->stop();
+
+    for (size_t i = 1; i < devices.size(); ++i)
+        devices[i]->stop();
+
+    playing = false;
+    callback = nullptr;
+}
+
+bool AggregateAudioIODevice::isPlaying()
+{
+    return playing && devices.front()->getDevice().isPlaying();
+}
+
+String AggregateAudioIODevice::getLastError()
+{
+    return lastError;
+}
+
+int AggregateAudioIODevice::getCurrentBufferSizeSamples()
+{
+    return isOpen() ? devices.front()->getDevice().getCurrentBufferSizeSamples() : 0;
+}
+
+double AggregateAudioIODevice::getCurrentSampleRate()
+{
+    return isOpen() ? devices.front()->getDevice().getCurrentSampleRate() : 0.0;
+}
+
+int AggregateAudioIODevice::getCurrentBitDepth()
+{
+    int depth = 0;
+
+    for (auto& d : devices)
+        if (d->isActive())
+            if (const auto deviceDepth = d->getDevice().getCurrentBitDepth(); deviceDepth > 0)
+                depth = depth == 0 ? deviceDepth : jmin (depth, deviceDepth);
+
+    return depth;
+}
+
+BigInteger AggregateAudioIODevice::getActiveOutputChannels() const    { return activeOutputs; }
+BigInteger AggregateAudioIODevice::getActiveInputChannels() const     { return activeInputs; }
+
+int AggregateAudioIODevice::getOutputLatencyInSamples()               { return getLatencyInSamples (false); }
+int AggregateAudioIODevice::getInputLatencyInSamples()                { return getLatencyInSamples (true); }
+
+int AggregateAudioIODevice::getLatencyInSamples (bool forInput)
+{
+    const auto clockRate = getCurrentSampleRate();
+    int latency = 0;
+
+    if (clockRate > 0)
+        for (auto& d : devices)
+            if (d->isActive() && (forInput ? d->getNumInputs() : d->getNumOutputs()) > 0)
+                latency = jmax (latency, d->getLatencyInClockSamples (forInput, clockRate));
+
+    return latency;
+}
+
+int AggregateAudioIODevice::getXRunCount() const noexcept
+{
+    int count = 0;
+
+    for (auto& d : devices)
+    {
+        if (d->isActive())
+        {
+            const auto stats = d->getStatistics();
+            count += jmax (0, d->getDevice().getXRunCount()) + stats.numUnderruns + stats.numOverruns;
+        }
+    }
+
+    return count;
+}
+
+//==============================================================================
+void AggregateAudioIODevice::clockDeviceAboutToStart()
+{
+    clockSampleRate = devices.front()->getDevice().getCurrentSampleRate();
+
+    if (callback != nullptr)
+        callback->audioDeviceAboutToStart (this);
+}
+
+void AggregateAudioIODevice::clockDeviceStopped()
+{
+    if (callback != nullptr)
+        callback->audioDeviceStopped();
+}
+
+void AggregateAudioIODevice::handleError (const SubDevice& source, const String& errorMessage)
+{
+    if (callback != nullptr)
+        callback->audioDeviceError (source.getName() + ": " + errorMessage);
+}
+
+void AggregateAudioIODevice::processClockBlock (const float* const* inputChannelData, int numInputChannels,
+                                                float* const* outputChannelData, int numOutputChannels,
+                                                int numSamples, const AudioIODeviceCallbackContext& context)
+{
+    const auto& clock = *devices.front();
+    const auto nowTicksNs = (uint64) (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks()) * 1.0e9);
+
+    numInputChannels  = jmin (numInputChannels,  clock.getNumInputs());
+    numOutputChannels = jmin (numOutputChannels, clock.getNumOutputs());
+
+    for (size_t i = 1; i < devices.size(); ++i)
+        if (devices[i]->isActive())
+            devices[i]->beginClockBlock (nowTicksNs, context.hostTimeNs, numSamples, clockSampleRate);
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto num = jmin (numSamples - start, maxChunkSize);
+        int numIns = 0, numOuts = 0;
+
+        for (int i = 0; i < numInputChannels; ++i)
+            inputPointers[numIns++] = inputChannelData[i] + start;
+
+        for (int i = 0; i < numOutputChannels; ++i)
+            outputPointers[numOuts++] = outputChannelData[i] + start;
+
+        for (size_t i = 1; i < devices.size(); ++i)
+        {
+            auto& d = *devices[i];
+
+            if (! d.isActive())
+                continue;
+
+            d.readInputs (num);
+
+            for (int channel = 0; channel < d.getNumInputs(); ++channel)
+                inputPointers[numIns++] = d.getInputChannel (channel);
+
+            for (int channel = 0; channel < d.getNumOutputs(); ++channel)
+                outputPointers[numOuts++] = d.getOutputChannel (channel);
+        }
+
+        if (callback != nullptr)
+        {
+            callback->audioDeviceIOCallbackWithContext (inputPointers, numIns, outputPointers, numOuts, num, context);
+        }
+        else
+        {
+            for (int i = 0; i < numOuts; ++i)
+                FloatVectorOperations::clear (outputPointers[i], num);
+        }
+
+        for (size_t i = 1; i < devices.size(); ++i)
+            if (devices[i]->isActive())
+                devices[i]->writeOutputs (num);
+
+        start += num;
+    }
+}
+
+//==============================================================================
+AggregateAudioIODeviceType::AggregateAudioIODeviceType (const String& nameOfType)
+    : AudioIODeviceType (nameOfType)
+{
+}
+
+AggregateAudioIODeviceType::~AggregateAudioIODeviceType() = default;
+
+void AggregateAudioIODeviceType::addAggregateDevice (const String& deviceName, DeviceFactory createDevices)
+{
+    jassert (createDevices != nullptr);
+
+    if (const auto index = names.indexOf (deviceName); index >= 0)
+    {
+        factories[(size_t) index] = std::move (createDevices);
+    }
+    else
+    {
+        names.add (deviceName);
+        factories.push_back (std::move (createDevices));
+    }
+
+    callDeviceChangeListeners();
+}
+
+void AggregateAudioIODeviceType::removeAggregateDevice (const String& deviceName)
+{
+    if (const auto index = names.indexOf (deviceName); index >= 0)
+    {
+        names.remove (index);
+        factories.erase (factories.begin() + index);
+        callDeviceChangeListeners();
+    }
+}
+
+void AggregateAudioIODeviceType::scanForDevices() {}
+
+StringArray AggregateAudioIODeviceType::getDeviceNames (bool) const
+{
+    return names;
+}
+
+int AggregateAudioIODeviceType::getDefaultDeviceIndex (bool) const
+{
+    return 0;
+}
+
+int AggregateAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool) const
+{
+    return device != nullptr ? names.indexOf (device->getName()) : -1;
+}
+
+bool AggregateAudioIODeviceType::hasSeparateInputsAndOutputs() const
+{
+    return false;
+}
+
+AudioIODevice* AggregateAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    auto index = names.indexOf (outputDeviceName);
+
+    if (index < 0)
+        index = names.indexOf (inputDeviceName);
+
+    if (index < 0)
+        return nullptr;
+
+    auto devices = factories[(size_t) index]();
+
+    if (std::none_of (devices.begin(), devices.end(), [] (const auto& d) { return d != nullptr; }))
+        return nullptr;
+
+    return new AggregateAudioIODevice (names[index], std::move (devices));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AggregateAudioIODeviceTests  : public UnitTest
+{
+public:
+    AggregateAudioIODeviceTests() : UnitTest ("AggregateAudioIODevice", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("Channels from each device are presented one after the other");
+        {
+            AggregateAudioIODevice aggregate ("aggregate", makeDevices ({ { 48000.0, 0.0, 256, 2, 2 },
+                                                                          { 48000.0, 0.0, 128, 3, 1 } }));
+
+            expect (aggregate.getInputChannelNames() == StringArray ("d0: in 0", "d0: in 1", "d1: in 0", "d1: in 1", "d1: in 2"));
+            expect (aggregate.getOutputChannelNames() == StringArray ("d0: out 0", "d0: out 1", "d1: out 0"));
+
+            BigInteger inputs, outputs;
+            inputs.setBit (1);
+            inputs.setBit (4);
+            outputs.setBit (2);
+
+            expect (aggregate.open (inputs, outputs, 48000.0, 256).isEmpty());
+            expect (aggregate.getActiveInputChannels() == inputs);
+            expect (aggregate.getActiveOutputChannels() == outputs);
+            expect (aggregate.getDevice (1)->getActiveInputChannels() == BigInteger (4));
+            expect (aggregate.getDevice (1)->getActiveOutputChannels() == BigInteger (1));
+            expectEquals (aggregate.getCurrentSampleRate(), 48000.0);
+            expectEquals (aggregate.getCurrentBufferSizeSamples(), 256);
+        }
+
+        beginTest ("Devices with drifting clocks stay in sync with the clock device");
+        {
+            constexpr double clockRate = 48000.0, driftA = 150.0, driftB = -80.0;
+            constexpr double inputFrequency = 1000.0, outputFrequency = 997.0, amplitude = 0.5;
+
+            AggregateAudioIODevice aggregate ("aggregate", makeDevices ({ { clockRate, 0.0,    256, 2, 2 },
+                                                                          { clockRate, driftA, 128, 1, 1 },
+                                                                          { 44100.0,   driftB, 441, 0, 1 } }));
+            aggregate.setResamplingQuality (PolyphaseResampler::Quality::normal);
+
+            BigInteger inputs, outputs;
+            inputs.setRange (0, 3, true);
+            outputs.setRange (0, 4, true);
+
+            expect (aggregate.open (inputs, outputs, clockRate, 256).isEmpty());
+            expect (aggregate.getDevice (2)->getCurrentSampleRate() == 44100.0);
+
+            // Reads the first input of the second device, and writes a sine to every output
+            struct Callback  : public AudioIODeviceCallback
+            {
+                void audioDeviceIOCallbackWithContext (const float* const* ins, int numIns,
+                                                       float* const* outs, int numOuts,
+                                                       int numSamples, const AudioIODeviceCallbackContext&) override
+                {
+                    jassert (numIns == 3 && numOuts == 4);
+                    received.insert (received.end(), ins[2], ins[2] + numSamples);
+
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        const auto sample = (float) (amplitude * std::sin (MathConstants<double>::twoPi * outputFrequency * (double) position++ / clockRate));
+
+                        for (int channel = 0; channel < numOuts; ++channel)
+                            outs[channel][i] = sample;
+                    }
+                }
+
+                void audioDeviceAboutToStart (AudioIODevice*) override  { ++numStarts; }
+                void audioDeviceStopped() override                      { ++numStops; }
+
+                std::vector<float> received;
+                int64 position = 0;
+                int numStarts = 0, numStops = 0;
+            };
+
+            Callback callback;
+            aggregate.start (&callback);
+            expectEquals (callback.numStarts, 1);
+
+            std::vector<ClockedDevice*> clocked;
+
+            for (int i = 0; i < aggregate.getNumDevices(); ++i)
+                clocked.push_back (dynamic_cast<ClockedDevice*> (aggregate.getDevice (i)));
+
+            clocked[1]->inputFrequency = inputFrequency;
+
+            constexpr double secondsToRun = 30.0;
+
+            for (;;)
+            {
+                auto* next = *std::min_element (clocked.begin(), clocked.end(), [] (auto* a, auto* b)
+                {
+                    return a->getNextCallbackTime() < b->getNextCallbackTime();
+                });
+
+                if (next->getNextCallbackTime() > secondsToRun)
+                    break;
+
+                next->process();
+            }
+
+            aggregate.stop();
+            expectEquals (callback.numStops, 1);
+
+            for (auto [index, expectedDrift] : { std::make_pair (1, driftA), std::make_pair (2, driftB) })
+            {
+                const auto stats = aggregate.getDeviceStatistics (index);
+                expect (stats.isLocked);
+                expectWithinAbsoluteError (stats.estimatedDriftPpm, expectedDrift, 5.0);
+                expectEquals (stats.numUnderruns, 0);
+                expectEquals (stats.numOverruns, 0);
+            }
+
+            // Once the devices have locked, there shouldn't be any clicks or gaps in either direction
+            const auto checkContinuity = [this] (const std::vector<float>& signal, double rate, double frequency)
+            {
+                const auto start = (size_t) (rate * 2.0);
+                expectGreaterThan (signal.size(), start * 4);
+
+                const auto maxStep = amplitude * MathConstants<double>::twoPi * frequency / rate;
+                auto largestStep = 0.0, peak = 0.0;
+
+                for (auto i = start; i < signal.size(); ++i)
+                {
+                    largestStep = jmax (largestStep, (double) std::abs (signal[i] - signal[i - 1]));
+                    peak = jmax (peak, (double) std::abs (signal[i]));
+                }
+
+                expectLessThan (largestStep, maxStep * 1.05);
+                expectWithinAbsoluteError (peak, amplitude, 0.02);
+            };
+
+            checkContinuity (callback.received, clockRate, inputFrequency);
+            checkContinuity (clocked[1]->recorded, clockRate, outputFrequency);
+            checkContinuity (clocked[2]->recorded, 44100.0, outputFrequency);
+        }
+    }
+
+private:
+    //==============================================================================
+    // A device whose callbacks are driven by the test, at times given by its own clock
+    class ClockedDevice  : public AudioIODevice
+    {
+    public:
+        struct Options
+        {
+            double sampleRate, driftPpm;
+            int blockSize, numInputs, numOutputs;
+        };
+
+        ClockedDevice (const String& deviceName, Options o)
+            : AudioIODevice (deviceName, "clocked"), options (o)
+        {
+        }
+
+        StringArray getOutputChannelNames() override    { return getNames ("out ", options.numOutputs); }
+        StringArray getInputChannelNames() override     { return getNames ("in ", options.numInputs); }
+
+        Array<double> getAvailableSampleRates() override    { return { options.sampleRate }; }
+        Array<int> getAvailableBufferSizes() override       { return { options.blockSize }; }
+        int getDefaultBufferSize() override                 { return options.blockSize; }
+
+        String open (const BigInteger& ins, const BigInteger& outs, double, int) override
+        {
+            inputs = ins;
+            outputs = outs;
+            inputBuffer.setSize (jmax (1, ins.countNumberOfSetBits()), options.blockSize);
+            outputBuffer.setSize (jmax (1, outs.countNumberOfSetBits()), options.blockSize);
+            opened = true;
+            return {};
+        }
+
+        void close() override                               { opened = false; }
+        bool isOpen() override                              { return opened; }
+
+        void start (AudioIODeviceCallback* c) override
+        {
+            callback = c;
+            callback->audioDeviceAboutToStart (this);
+            playing = true;
+        }
+
+        void stop() override
+        {
+            playing = false;
+            callback->audioDeviceStopped();
+        }
+
+        bool isPlaying() override                           { return playing; }
+        String getLastError() override                      { return {}; }
+        int getCurrentBufferSizeSamples() override          { return options.blockSize; }
+        double getCurrentSampleRate() override              { return options.sampleRate; }
+        int getCurrentBitDepth() override                   { return 24; }
+        BigInteger getActiveOutputChannels() const override { return outputs; }
+        BigInteger getActiveInputChannels() const override  { return inputs; }
+        int getOutputLatencyInSamples() override            { return 0; }
+        int getInputLatencyInSamples() override             { return 0; }
+
+        double getNextCallbackTime() const
+        {
+            return (double) (numCallbacks + 1) * options.blockSize / (options.sampleRate * (1.0 + options.driftPpm * 1.0e-6));
+        }
+
+        void process()
+        {
+            const auto hostTimeNs = (uint64_t) (getNextCallbackTime() * 1.0e9);
+            ++numCallbacks;
+
+            for (int channel = 0; channel < inputs.countNumberOfSetBits(); ++channel)
+                for (int i = 0; i < options.blockSize; ++i)
+                    inputBuffer.setSample (channel, i, (float) (0.5 * std::sin (MathConstants<double>::twoPi * inputFrequency
+                                                                                * (double) (position + i) / options.sampleRate)));
+
+            AudioIODeviceCallbackContext context;
+            context.hostTimeNs = &hostTimeNs;
+
+            if (playing)
+                callback->audioDeviceIOCallbackWithContext (inputBuffer.getArrayOfReadPointers(), inputs.countNumberOfSetBits(),
+                                                            outputBuffer.getArrayOfWritePointers(), outputs.countNumberOfSetBits(),
+                                                            options.blockSize, context);
+
+            if (! outputs.isZero())
+                recorded.insert (recorded.end(), outputBuffer.getReadPointer (0), outputBuffer.getReadPointer (0) + options.blockSize);
+
+            position += options.blockSize;
+        }
+
+        double inputFrequency = 0.0;
+        std::vector<float> recorded;
+
+    private:
+        static StringArray getNames (const String& prefix, int num)
+        {
+            StringArray names;
+
+            for (int i = 0; i < num; ++i)
+                names.add (prefix + String (i));
+
+            return names;
+        }
+
+        const Options options;
+        BigInteger inputs, outputs;
+        AudioBuffer<float> inputBuffer, outputBuffer;
+        AudioIODeviceCallback* callback = nullptr;
+        int64 numCallbacks = 0, position = 0;
+        bool opened = false, playing = false;
+    };
+
+    static std::vector<std::unique_ptr<AudioIODevice>> makeDevices (std::initializer_list<ClockedDevice::Options> options)
+    {
+        std::vector<std::unique_ptr<AudioIODevice>> devices;
+
+        for (auto& o : options)
+            devices.push_back (std::make_unique<ClockedDevice> ("d" + String ((int) devices.size()), o));
+
+        return devices;
+    }
+};
+
+static AggregateAudioIODeviceTests aggregateAudioIODeviceTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioIODevice that combines several other devices into one.
+
+    The first device in the list provides the clock: its audio callback drives the
+    callback of the aggregate device, and the aggregate runs at its sample rate and
+    buffer size. The channels of all the devices are presented one after the other,
+    with each channel's name prefixed by the name of the device that it belongs to.
+
+    Every other device runs on its own thread, at whichever of its sample rates is
+    closest to that of the clock device, and exchanges audio with the clock device's
+    callback through a pair of lock-free FIFOs. As no two interfaces have quite the
+    same clock, the amount of audio in these FIFOs is watched and fed into a
+    control loop, which estimates the drift of each device against the clock device
+    and adjusts the ratio of a high-quality PolyphaseResampler to compensate. The
+    loop starts out with a wide bandwidth so that it locks quickly, and then narrows
+    it so that timing jitter doesn't modulate the resampling ratio.
+
+    If a device's callback provides AudioIODeviceCallbackContext::hostTimeNs, this is
+    used to work out how far through a block the device was when the FIFO levels were
+    measured; otherwise, the time of the callback is used.
+
+    You can use one of these directly, or through an AggregateAudioIODeviceType to
+    make it available in an AudioDeviceManager.
+
+    @see AggregateAudioIODeviceType
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODevice  : public AudioIODevice
+{
+public:
+    //==============================================================================
+    /** Creates an aggregate of some devices.
+
+        The aggregate takes ownership of the devices, which mustn't be open. The first
+        one in the list provides the clock for the others.
+    */
+    AggregateAudioIODevice (const String& deviceName,
+                            std::vector<std::unique_ptr<AudioIODevice>> devicesToCombine);
+
+    /** Destructor. */
+    ~AggregateAudioIODevice() override;
+
+    //==============================================================================
+    /** Returns the number of devices in the aggregate. */
+    int getNumDevices() const noexcept;
+
+    /** Returns one of the devices in the aggregate. The device at index 0 is the clock device. */
+    AudioIODevice* getDevice (int index) const noexcept;
+
+    /** Sets the quality of the resamplers that are used for the devices which aren't
+        the clock device.
+
+        This takes effect the next time the device is opened.
+    */
+    void setResamplingQuality (PolyphaseResampler::Quality newQuality) noexcept    { resamplingQuality = newQuality; }
+
+    /** Returns the quality of the resamplers. */
+    PolyphaseResampler::Quality getResamplingQuality() const noexcept              { return resamplingQuality; }
+
+    /** Some information about the synchronisation of one of the devices. */
+    struct DeviceStatistics
+    {
+        /** True if the device is running and its audio is being passed through. */
+        bool isLocked = false;
+
+        /** The estimated speed of the device's clock relative to the clock device, in parts
+            per million. A positive value means that the device is running faster than it should.
+        */
+        double estimatedDriftPpm = 0.0;
+
+        /** The amount of audio that's currently waiting in the device's FIFO, in seconds. */
+        double bufferedSeconds = 0.0;
+
+        /** The number of times that the FIFO ran dry. */
+        int numUnderruns = 0;
+
+        /** The number of times that the FIFO overflowed. */
+        int numOverruns = 0;
+    };
+
+    /** Returns the synchronisation statistics for one of the devices.
+
+        This can be called from any thread while the aggregate is running. For the clock
+        device, the statistics are always those of a locked device with no drift.
+    */
+    DeviceStatistics getDeviceStatistics (int index) const;
+
+    //==============================================================================
+    StringArray getOutputChannelNames() override;
+    StringArray getInputChannelNames() override;
+    Array<double> getAvailableSampleRates() override;
+    Array<int> getAvailableBufferSizes() override;
+    int getDefaultBufferSize() override;
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override;
+    void start (AudioIODeviceCallback*) override;
+    void stop() override;
+    bool isPlaying() override;
+    String getLastError() override;
+    int getCurrentBufferSizeSamples() override;
+    double getCurrentSampleRate() override;
+    int getCurrentBitDepth() override;
+    BigInteger getActiveOutputChannels() const override;
+    BigInteger getActiveInputChannels() const override;
+    int getOutputLatencyInSamples() override;
+    int getInputLatencyInSamples() override;
+    int getXRunCount() const noexcept override;
+
+private:
+    //==============================================================================
+    class SubDevice;
+    class DriftEstimator;
+
+    void clockDeviceAboutToStart();
+    void clockDeviceStopped();
+    void processClockBlock (const float* const* inputChannelData, int numInputChannels,
+                            float* const* outputChannelData, int numOutputChannels,
+                            int numSamples, const AudioIODeviceCallbackContext&);
+    void handleError (const SubDevice&, const String& errorMessage);
+
+    void prepareBuffers();
+    int getLatencyInSamples (bool forInput);
+
+    std::vector<std::unique_ptr<SubDevice>> devices;
+    PolyphaseResampler::Quality resamplingQuality = PolyphaseResampler::Quality::high;
+
+    AudioIODeviceCallback* callback = nullptr;
+    BigInteger activeInputs, activeOutputs;
+    HeapBlock<const float*> inputPointers;
+    HeapBlock<float*> outputPointers;
+    int totalNumActiveInputs = 0, totalNumActiveOutputs = 0, maxChunkSize = 0;
+    double clockSampleRate = 0.0;
+    bool playing = false;
+    String lastError;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODevice)
+};
+
+//==============================================================================
+/**
+    An AudioIODeviceType that creates AggregateAudioIODevices.
+
+    Each aggregate device is given a name, and a function that creates the devices
+    that it combines. The function is called whenever the aggregate is opened, so it
+    can look up devices from any other AudioIODeviceType, e.g.
+
+    @code
+    auto aggregates = std::make_unique<AggregateAudioIODeviceType>();
+
+    aggregates->addAggregateDevice ("Stage rig", [&deviceManager]
+    {
+        std::vector<std::unique_ptr<AudioIODevice>> devices;
+
+        for (auto* type : deviceManager.getAvailableDeviceTypes())
+            if (type->getTypeName() == "Windows Audio")
+                for (auto name : { "Interface A", "Interface B", "Interface C" })
+                    devices.emplace_back (type->createDevice (name, name));
+
+        return devices;
+    });
+
+    deviceManager.addAudioDeviceType (std::move (aggregates));
+    @endcode
+
+    Any AudioIODeviceTypes that the function uses must outlive this one.
+
+    @see AggregateAudioIODevice
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODeviceType  : public AudioIODeviceType
+{
+public:
+    //==============================================================================
+    /** A function that creates the devices for an aggregate, with the clock device first. */
+    using DeviceFactory = std::function<std::vector<std::unique_ptr<AudioIODevice>>()>;
+
+    /** Creates an empty device type. */
+    explicit AggregateAudioIODeviceType (const String& nameOfType = "Aggregate");
+
+    /** Destructor. */
+    ~AggregateAudioIODeviceType() override;
+
+    /** Adds an aggregate device, or replaces the one that has the same name. */
+    void addAggregateDevice (const String& deviceName, DeviceFactory createDevices);
+
+    /** Removes one of the aggregate devices. */
+    void removeAggregateDevice (const String& deviceName);
+
+    //==============================================================================
+    void scanForDevices() override;
+    StringArray getDeviceNames (bool wantInputNames = false) const override;
+    int getDefaultDeviceIndex (bool forInput) const override;
+    int getIndexOfDevice (AudioIODevice* device, bool asInput) const override;
+    bool hasSeparateInputsAndOutputs() const override;
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    //==============================================================================
+    StringArray names;
+    std::vector<DeviceFactory> factories;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODeviceType)
+};
+
+} // namespace juce
@@ -109,6 +109,302 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackHandler)
 };
 
+//==============================================================================
+struct AudioDeviceManager::TestSound
+{
+    AudioBuffer<float> buffer;
+
+    // Only the audio thread moves this on, which it does while reading the sound
+    mutable std::atomic<int> position { 0 };
+};
+
+//==============================================================================
+/*  Measures how long one of the callbacks takes to render each block.
+
+    A callback is only ever run by one thread at a time, and the audio thread waits
+    for all its workers before the next block starts, so there's only a single writer.
+*/
+class AudioDeviceManager::CallbackTimer
+{
+public:
+    using Statistics = CallbackTimingStatistics;
+
+    /*  Call from the audio threads only. */
+    void record (double milliseconds, double load) noexcept
+    {
+        if (resetRequested.exchange (false))
+        {
+            totalMilliseconds.store (0.0, std::memory_order_relaxed);
+            totalLoad.store (0.0, std::memory_order_relaxed);
+            maximum.store (0.0, std::memory_order_relaxed);
+            numOverruns.store (0, std::memory_order_relaxed);
+            numMeasurements.store (0, std::memory_order_relaxed);
+        }
+
+        totalMilliseconds.store (totalMilliseconds.load (std::memory_order_relaxed) + milliseconds, std::memory_order_relaxed);
+        totalLoad.store (totalLoad.load (std::memory_order_relaxed) + load, std::memory_order_relaxed);
+        mostRecent.store (milliseconds, std::memory_order_relaxed);
+
+        if (milliseconds > maximum.load (std::memory_order_relaxed))
+            maximum.store (milliseconds, std::memory_order_relaxed);
+
+        if (load > 1.0)
+            numOverruns.store (numOverruns.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        numMeasurements.store (numMeasurements.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void reset() noexcept
+    {
+        resetRequested = true;
+    }
+
+    Statistics getStatistics() const
+    {
+        Statistics result;
+
+        if (resetRequested)
+            return result;
+
+        // The totals may already include a block or two more than this, which is
+        // close enough for statistics that are read while the device is running
+        result.numMeasurements = numMeasurements.load (std::memory_order_acquire);
+
+        if (result.numMeasurements == 0)
+            return result;
+
+        result.mean        = totalMilliseconds.load (std::memory_order_relaxed) / (double) result.numMeasurements;
+        result.maximum     = maximum.load (std::memory_order_relaxed);
+        result.mostRecent  = mostRecent.load (std::memory_order_relaxed);
+        result.meanLoad    = totalLoad.load (std::memory_order_relaxed) / (double) result.numMeasurements;
+        result.numOverruns = numOverruns.load (std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    std::atomic<double> totalMilliseconds { 0.0 }, totalLoad { 0.0 }, maximum { 0.0 }, mostRecent { 0.0 };
+    std::atomic<int> numMeasurements { 0 }, numOverruns { 0 };
+    std::atomic<bool> resetRequested { false };
+};
+
+//==============================================================================
+/*  A set of real-time worker threads that help the audio thread to run the callbacks.
+
+    The audio thread publishes a Job, wakes the workers, and then joins in with the
+    work itself. Jobs hand out their tasks using only atomic operations, so nobody
+    has to take a lock while a block is being rendered.
+*/
+class AudioDeviceManager::CallbackThreadPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        /*  Runs tasks until there are none left to claim. This will be called
+            concurrently from several threads.
+        */
+        virtual void runAvailableTasks() = 0;
+
+        /*  Returns true once every task in the job has finished. */
+        virtual bool isComplete() const = 0;
+    };
+
+    CallbackThreadPool (int numThreads, const Thread::RealtimeOptions& options)
+    {
+        for (int i = 0; i < numThreads; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this);
+
+            if (! worker->startRealtimeThread (options))
+                worker->startThread (Thread::Priority::highest);
+
+            workers.push_back (std::move (worker));
+        }
+    }
+
+    ~CallbackThreadPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto& worker : workers)
+            worker->stopThread (1000);
+    }
+
+    /*  Call from the audio thread only. Returns once every task in the job has finished. */
+    void perform (Job& job)
+    {
+        currentJob.store (&job);
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        job.runAvailableTasks();
+
+        while (! job.isComplete())
+            Thread::yield();
+
+        // Workers that are still inside the job must leave before it goes out of scope
+        currentJob.store (nullptr);
+
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+    }
+
+private:
+    class Worker : public Thread
+    {
+    public:
+        explicit Worker (CallbackThreadPool& p) : Thread ("Audio Callback Thread"), owner (p) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                ++owner.numActiveWorkers;
+
+                if (auto* job = owner.currentJob.load())
+                    job->runAvailableTasks();
+
+                --owner.numActiveWorkers;
+
+                wait (-1);
+            }
+        }
+
+    private:
+        CallbackThreadPool& owner;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackThreadPool)
+};
+
+//==============================================================================
+/*  The copy of the callback list that the audio thread reads. A new one is published
+    whenever the callbacks, the device or the number of threads change.
+*/
+struct AudioDeviceManager::RealtimeCallbacks
+{
+    struct Block
+    {
+        const float* const* inputs;
+        int numInputs;
+        float* const* outputs;
+        int numOutputs;
+        int numSamples;
+        const AudioIODeviceCallbackContext& context;
+    };
+
+    struct Entry
+    {
+        void render (const Block& block, float* const* outputs, double sampleRate) const
+        {
+            const auto start = Time::getHighResolutionTicks();
+
+            callback->audioDeviceIOCallbackWithContext (block.inputs,
+                                                        block.numInputs,
+                                                        outputs,
+                                                        block.numOutputs,
+                                                        block.numSamples,
+                                                        block.context);
+
+            const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+            timer->record (seconds * 1000.0, sampleRate > 0.0 ? seconds * sampleRate / (double) block.numSamples : 0.0);
+        }
+
+        AudioIODeviceCallback* callback = nullptr;
+        std::shared_ptr<CallbackTimer> timer;
+
+        // The callbacks after the first one render into these when they run in parallel
+        mutable AudioBuffer<float> buffer;
+    };
+
+    void render (const Block& block, AudioBuffer<float>& tempBuffer) const
+    {
+        const auto numEntries = (int) entries.size();
+
+        if (threadPool != nullptr
+            && numEntries > 1
+            && block.numOutputs <= maxNumOutputs
+            && block.numSamples <= maxNumSamples)
+        {
+            ParallelJob job (*this, block);
+            threadPool->perform (job);
+
+            for (int i = numEntries; --i > 0;)
+                addChannels (block, entries[(size_t) i].buffer.getArrayOfReadPointers());
+
+            return;
+        }
+
+        tempBuffer.setSize (jmax (1, block.numOutputs), jmax (1, block.numSamples), false, false, true);
+
+        entries.front().render (block, block.outputs, sampleRate);
+
+        auto* const* tempChans = tempBuffer.getArrayOfWritePointers();
+
+        for (int i = numEntries; --i > 0;)
+        {
+            entries[(size_t) i].render (block, tempChans, sampleRate);
+            addChannels (block, tempChans);
+        }
+    }
+
+    std::vector<Entry> entries;
+    std::shared_ptr<CallbackThreadPool> threadPool;
+    double sampleRate = 0.0;
+    int maxNumOutputs = 0, maxNumSamples = 0;
+
+private:
+    class ParallelJob : public CallbackThreadPool::Job
+    {
+    public:
+        ParallelJob (const RealtimeCallbacks& c, const Block& b) : callbacks (c), block (b) {}
+
+        void runAvailableTasks() override
+        {
+            for (;;)
+            {
+                const auto index = nextToClaim++;
+
+                if (index >= numTasks)
+                    return;
+
+                const auto& entry = callbacks.entries[(size_t) index];
+                entry.render (block,
+                              index == 0 ? block.outputs : entry.buffer.getArrayOfWritePointers(),
+                              callbacks.sampleRate);
+
+                ++numCompleted;
+            }
+        }
+
+        bool isComplete() const override  { return numCompleted.load() == numTasks; }
+
+    private:
+        const RealtimeCallbacks& callbacks;
+        const Block& block;
+        const int numTasks = (int) callbacks.entries.size();
+        std::atomic<int> nextToClaim { 0 }, numCompleted { 0 };
+    };
+
+    static void addChannels (const Block& block, const float* const* source)
+    {
+        for (int chan = 0; chan < block.numOutputs; ++chan)
+        {
+            if (auto* src = source [chan])
+                if (auto* dst = block.outputs [chan])
+                    for (int j = 0; j < block.numSamples; ++j)
+                        dst[j] += src[j];
+        }
+    }
+};
+
 //==============================================================================
 AudioDeviceManager::AudioDeviceManager()
 {
@@ -239,6 +535,7 @@ void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>&
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Bela());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_ALSA());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_JACK());
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_PipeWire());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Oboe());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_OpenSLES());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Android());
@@ -962,6 +1259,7 @@ void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
 
     const ScopedLock sl (audioCallbackLock);
     callbacks.add (newCallback);
+    publishCallbacks();
 }
 
 void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToRemove)
@@ -975,6 +1273,7 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
 
             needsDeinitialising = needsDeinitialising && callbacks.contains (callbackToRemove);
             callbacks.removeFirstMatchingValue (callbackToRemove);
+            publishCallbacks();
         }
 
         if (needsDeinitialising)
@@ -989,72 +1288,148 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChan
                                                    int numSamples,
                                                    const AudioIODeviceCallbackContext& context)
 {
-    const ScopedLock sl (audioCallbackLock);
+    const AudioDeviceTelemetry::ScopedCallback telemetryMeasurement (telemetry, numSamples, context);
+
+    // This never waits, even if another thread is changing the callbacks
+    const ReadCopyUpdatePointer<RealtimeCallbacks>::ScopedReader activeCallbacks (realtimeCallbacks);
 
     inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
 
-    if (callbacks.size() > 0)
+    if (activeCallbacks != nullptr && ! activeCallbacks->entries.empty())
     {
         AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer, numSamples);
 
-        tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
+        activeCallbacks->render ({ inputChannelData,
+                                   numInputChannels,
+                                   outputChannelData,
+                                   numOutputChannels,
+                                   numSamples,
+                                   context },
+                                 tempBuffer);
+    }
+    else
+    {
+        for (int i = 0; i < numOutputChannels; ++i)
+            zeromem (outputChannelData[i], (size_t) numSamples * sizeof (float));
+    }
 
-        callbacks.getUnchecked(0)->audioDeviceIOCallbackWithContext (inputChannelData,
-                                                                     numInputChannels,
-                                                                     outputChannelData,
-                                                                     numOutputChannels,
-                                                                     numSamples,
-                                                                     context);
+    const ReadCopyUpdatePointer<TestSound>::ScopedReader sound (testSound);
 
-        auto* const* tempChans = tempBuffer.getArrayOfWritePointers();
+    if (sound != nullptr)
+    {
+        const auto position = sound->position.load();
+        auto numSamps = jmin (numSamples, sound->buffer.getNumSamples() - position);
 
-        for (int i = callbacks.size(); --i > 0;)
+        if (numSamps > 0)
         {
-            callbacks.getUnchecked(i)->audioDeviceIOCallbackWithContext (inputChannelData,
-                                                                         numInputChannels,
-                                                                         tempChans,
-                                                                         numOutputChannels,
-                                                                         numSamples,
-                                                                         context);
+            auto* src = sound->buffer.getReadPointer (0, position);
 
-            for (int chan = 0; chan < numOutputChannels; ++chan)
-            {
-                if (auto* src = tempChans [chan])
-                    if (auto* dst = outputChannelData [chan])
-                        for (int j = 0; j < numSamples; ++j)
-                            dst[j] += src[j];
-            }
+            for (int i = 0; i < numOutputChannels; ++i)
+                if (auto* dst = outputChannelData [i])
+                    for (int j = 0; j < numSamps; ++j)
+                        dst[j] += src[j];
+
+            sound->position = position + numSamps;
         }
     }
-    else
+
+    outputLevelGetter->updateLevel (outputChannelData, numOutputChannels, numSamples);
+}
+
+void AudioDeviceManager::publishCallbacks()
+{
+    // Must be called with audioCallbackLock held. The audio thread reads its own copy
+    // of the list, which is replaced here without blocking it, and this returns once
+    // the audio thread has stopped using the old copy.
+    auto newCallbacks = std::make_unique<RealtimeCallbacks>();
+    newCallbacks->threadPool = callbackThreadPool;
+
+    if (currentAudioDevice != nullptr)
     {
-        for (int i = 0; i < numOutputChannels; ++i)
-            zeromem (outputChannelData[i], (size_t) numSamples * sizeof (float));
+        newCallbacks->sampleRate = currentAudioDevice->getCurrentSampleRate();
+
+        if (callbackThreadPool != nullptr)
+        {
+            newCallbacks->maxNumOutputs = currentAudioDevice->getActiveOutputChannels().countNumberOfSetBits();
+            newCallbacks->maxNumSamples = currentAudioDevice->getCurrentBufferSizeSamples();
+        }
     }
 
-    if (testSound != nullptr)
+    std::map<AudioIODeviceCallback*, std::shared_ptr<CallbackTimer>> timers;
+
+    for (auto* callback : callbacks)
     {
-        auto numSamps = jmin (numSamples, testSound->getNumSamples() - testSoundPosition);
-        auto* src = testSound->getReadPointer (0, testSoundPosition);
+        const auto it = callbackTimers.find (callback);
+        auto timer = it != callbackTimers.cend() ? it->second : std::make_shared<CallbackTimer>();
+        timers.emplace (callback, timer);
 
-        for (int i = 0; i < numOutputChannels; ++i)
-            if (auto* dst = outputChannelData [i])
-                for (int j = 0; j < numSamps; ++j)
-                    dst[j] += src[j];
+        RealtimeCallbacks::Entry entry { callback, std::move (timer), {} };
 
-        testSoundPosition += numSamps;
+        if (! newCallbacks->entries.empty())
+            entry.buffer.setSize (newCallbacks->maxNumOutputs, newCallbacks->maxNumSamples);
 
-        if (testSoundPosition >= testSound->getNumSamples())
-            testSound.reset();
+        newCallbacks->entries.push_back (std::move (entry));
     }
 
-    outputLevelGetter->updateLevel (outputChannelData, numOutputChannels, numSamples);
+    callbackTimers = std::move (timers);
+    realtimeCallbacks.reset (std::move (newCallbacks));
+}
+
+void AudioDeviceManager::setNumCallbackThreads (int numThreads)
+{
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == numCallbackThreads)
+        return;
+
+    Thread::RealtimeOptions options;
+
+    if (currentAudioDevice != nullptr)
+    {
+        const auto rate = currentAudioDevice->getCurrentSampleRate();
+
+        if (rate > 0.0)
+            options.workDurationMs = (uint32_t) jmax (1, roundToInt (1000.0 * currentAudioDevice->getCurrentBufferSizeSamples() / rate));
+    }
+
+    auto newPool = numThreads > 0 ? std::make_shared<CallbackThreadPool> (numThreads, options) : nullptr;
+
+    {
+        const ScopedLock sl (audioCallbackLock);
+
+        numCallbackThreads = numThreads;
+        std::swap (callbackThreadPool, newPool);
+        publishCallbacks();
+    }
+
+    // The old threads are stopped here, now that the audio thread can't be using them
+}
+
+Optional<AudioDeviceManager::CallbackTimingStatistics> AudioDeviceManager::getCallbackTimingStatistics (AudioIODeviceCallback* callback) const
+{
+    const ScopedLock sl (audioCallbackLock);
+
+    const auto it = callbackTimers.find (callback);
+
+    if (it == callbackTimers.cend())
+        return {};
+
+    return it->second->getStatistics();
+}
+
+void AudioDeviceManager::resetCallbackTimingStatistics()
+{
+    const ScopedLock sl (audioCallbackLock);
+
+    for (auto& pair : callbackTimers)
+        pair.second->reset();
 }
 
 void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device)
 {
     loadMeasurer.reset (device->getCurrentSampleRate(),
                         device->getCurrentBufferSizeSamples());
+    telemetry.prepare (device->getCurrentSampleRate());
 
     updateCurrentSetup();
 
@@ -1063,6 +1438,9 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
 
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked(i)->audioDeviceAboutToStart (device);
+
+        // The buffers for running the callbacks in parallel have to match the new settings
+        publishCallbacks();
     }
 
     sendChangeMessage();
@@ -1175,6 +1553,7 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
         {
             const ScopedLock sl (audioCallbackLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbacks();
         }
 
         if (currentAudioDevice != nullptr)
@@ -1198,6 +1577,7 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
         {
             const ScopedLock sl (audioCallbackLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbacks();
         }
 
         updateXml();
@@ -1252,16 +1632,7 @@ double AudioDeviceManager::LevelMeter::getCurrentLevel() const noexcept
 
 void AudioDeviceManager::playTestSound()
 {
-    { // cunningly nested to swap, unlock and delete in that order.
-        std::unique_ptr<AudioBuffer<float>> oldSound;
-
-        {
-            const ScopedLock sl (audioCallbackLock);
-            std::swap (oldSound, testSound);
-        }
-    }
-
-    testSoundPosition = 0;
+    testSound.reset();
 
     if (currentAudioDevice != nullptr)
     {
@@ -1273,18 +1644,16 @@ void AudioDeviceManager::playTestSound()
 
         auto phasePerSample = MathConstants<double>::twoPi / (sampleRate / frequency);
 
-        std::unique_ptr<AudioBuffer<float>> newSound (new AudioBuffer<float> (1, soundLength));
+        auto newSound = std::make_unique<TestSound>();
+        newSound->buffer.setSize (1, soundLength);
 
         for (int i = 0; i < soundLength; ++i)
-            newSound->setSample (0, i, amplitude * (float) std::sin (i * phasePerSample));
+            newSound->buffer.setSample (0, i, amplitude * (float) std::sin (i * phasePerSample));
 
-        newSound->applyGainRamp (0, 0, soundLength / 10, 0.0f, 1.0f);
-        newSound->applyGainRamp (0, soundLength - soundLength / 4, soundLength / 4, 1.0f, 0.0f);
+        newSound->buffer.applyGainRamp (0, 0, soundLength / 10, 0.0f, 1.0f);
+        newSound->buffer.applyGainRamp (0, soundLength - soundLength / 4, soundLength / 4, 1.0f, 0.0f);
 
-        {
-            const ScopedLock sl (audioCallbackLock);
-            std::swap (testSound, newSound);
-        }
+        testSound.reset (std::move (newSound));
     }
 }
 
@@ -1579,6 +1948,173 @@ public:
             ptr->restartDevices (newSr, newBs);
             expectEquals (numCalls, 1);
         }
+
+        beginTest ("Callbacks can be added and removed while the device is running, and aren't called once removed");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::make_unique<MockDeviceType> ("foo",
+                                                                          StringArray { "foo in a" },
+                                                                          StringArray { "foo out a" }));
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.inputDeviceName = "foo in a";
+            setup.outputDeviceName = "foo out a";
+            manager.setAudioDeviceSetup (setup, true);
+
+            auto* device = dynamic_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            std::atomic<bool> finished { false }, calledAfterRemoval { false };
+            std::atomic<int> numBlocks { 0 };
+
+            struct AudioThread  : public Thread
+            {
+                explicit AudioThread (std::function<void()> fn)
+                    : Thread ("AudioDeviceManager test"), body (std::move (fn)) { startThread(); }
+                ~AudioThread() override { waitForThreadToExit (-1); }
+                void run() override { body(); }
+
+                std::function<void()> body;
+            };
+
+            {
+                AudioThread audioThread ([&]
+                {
+                    while (! finished)
+                    {
+                        device->processBlock();
+                        ++numBlocks;
+                    }
+                });
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    std::atomic<bool> removed { false };
+                    std::atomic<int> numCalls { 0 };
+
+                    MockCallback callback;
+                    callback.callback = [&]
+                    {
+                        if (removed)
+                            calledAfterRemoval = true;
+
+                        ++numCalls;
+                    };
+
+                    manager.addAudioCallback (&callback);
+
+                    for (const auto blocksAtStart = numBlocks.load(); numBlocks.load() < blocksAtStart + 2;)
+                        Thread::yield();
+
+                    manager.removeAudioCallback (&callback);
+                    removed = true;
+
+                    expect (numCalls.load() > 0);
+                }
+
+                finished = true;
+            }
+
+            expect (! calledAfterRemoval.load());
+        }
+
+        beginTest ("Callbacks run in parallel produce the same output as when they're run in order, and are timed separately");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::make_unique<MockDeviceType> ("foo",
+                                                                          StringArray { "foo in a" },
+                                                                          StringArray { "foo out a" }));
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.inputDeviceName = "foo in a";
+            setup.outputDeviceName = "foo out a";
+            manager.setAudioDeviceSetup (setup, true);
+
+            auto* device = dynamic_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            struct ConstantCallback  : public AudioIODeviceCallback
+            {
+                explicit ConstantCallback (float v) : value (v) {}
+
+                void audioDeviceIOCallbackWithContext (const float* const*,
+                                                       int,
+                                                       float* const* outputs,
+                                                       int numOutputs,
+                                                       int numSamples,
+                                                       const AudioIODeviceCallbackContext&) override
+                {
+                    threadId = Thread::getCurrentThreadId();
+                    Thread::sleep (5);
+
+                    for (int i = 0; i < numOutputs; ++i)
+                        FloatVectorOperations::fill (outputs[i], value * (float) (i + 1), numSamples);
+                }
+
+                void audioDeviceAboutToStart (AudioIODevice*) override {}
+                void audioDeviceStopped() override {}
+
+                const float value;
+                std::atomic<Thread::ThreadID> threadId { nullptr };
+            };
+
+            std::vector<std::unique_ptr<ConstantCallback>> callbacks;
+
+            for (int i = 0; i < 6; ++i)
+            {
+                callbacks.push_back (std::make_unique<ConstantCallback> ((float) (1 << i)));
+                manager.addAudioCallback (callbacks.back().get());
+            }
+
+            const auto numOutputs = device->getActiveOutputChannels().countNumberOfSetBits();
+            const auto numSamples = device->getCurrentBufferSizeSamples();
+            expect (numOutputs > 0);
+
+            AudioBuffer<float> serial (numOutputs, numSamples), parallel (numOutputs, numSamples);
+            device->processBlock (serial);
+
+            manager.setNumCallbackThreads (3);
+            expectEquals (manager.getNumCallbackThreads(), 3);
+
+            std::set<Thread::ThreadID> threadsUsed;
+            constexpr auto numParallelBlocks = 5;
+
+            for (int block = 0; block < numParallelBlocks; ++block)
+            {
+                parallel.clear();
+                device->processBlock (parallel);
+
+                for (int chan = 0; chan < numOutputs; ++chan)
+                    for (int i = 0; i < numSamples; ++i)
+                        expectEquals (parallel.getSample (chan, i), serial.getSample (chan, i));
+
+                for (auto& callback : callbacks)
+                    threadsUsed.insert (callback->threadId.load());
+            }
+
+            expectEquals (serial.getSample (0, 0), 63.0f);
+            expect (threadsUsed.size() > 1);
+
+            for (auto& callback : callbacks)
+            {
+                const auto stats = manager.getCallbackTimingStatistics (callback.get());
+                expect (stats.hasValue());
+                expectEquals (stats->numMeasurements, numParallelBlocks + 1);
+                expect (stats->maximum >= 4.0);
+                expect (stats->meanLoad > 0.0);
+            }
+
+            manager.resetCallbackTimingStatistics();
+            expectEquals (manager.getCallbackTimingStatistics (callbacks.front().get())->numMeasurements, 0);
+
+            ConstantCallback unregistered { 0.0f };
+            expect (! manager.getCallbackTimingStatistics (&unregistered).hasValue());
+
+            manager.setNumCallbackThreads (0);
+
+            for (auto& callback : callbacks)
+                manager.removeAudioCallback (callback.get());
+        }
     }
 
 private:
@@ -1810,6 +2346,24 @@ private:
         int getOutputLatencyInSamples() override { return 0; }
         int getInputLatencyInSamples() override { return 0; }
 
+        // Call this to emulate the device asking for a block of audio.
+        void processBlock()
+        {
+            if (playing && callback != nullptr)
+                callback->audioDeviceIOCallbackWithContext (nullptr, 0, nullptr, 0, blockSize, {});
+        }
+
+        void processBlock (AudioBuffer<float>& outputs)
+        {
+            if (playing && callback != nullptr)
+                callback->audioDeviceIOCallbackWithContext (nullptr,
+                                                            0,
+                                                            outputs.getArrayOfWritePointers(),
+                                                            outputs.getNumChannels(),
+                                                            outputs.getNumSamples(),
+                                                            {});
+        }
+
     private:
         void restart (double newSr, int newBs) override
         {
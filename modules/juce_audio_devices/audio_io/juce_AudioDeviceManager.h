@@ -298,6 +298,11 @@ public:
         If necessary, this method will invoke audioDeviceStopped() on the callback
         object before returning.
 
+        The audio thread never waits for this method, so instead, this waits for the audio
+        thread to finish any callback that's already running. Once it returns, the callback
+        won't be called again and can safely be deleted. That means it mustn't be called
+        from inside an audio callback.
+
         @see addAudioCallback
     */
     void removeAudioCallback (AudioIODeviceCallback* callback);
@@ -309,6 +314,76 @@ public:
     */
     double getCpuUsage() const;
 
+    /** Returns the detailed timing measurements for the audio callbacks.
+
+        Unlike getCpuUsage() and getXRunCount(), this gives the distribution of callback
+        durations, deadline margins and wake-up latencies, and a log of the callbacks
+        that missed their deadlines. The measurements are kept when the device is
+        restarted; call AudioDeviceTelemetry::reset() to clear them.
+    */
+    AudioDeviceTelemetry& getTelemetry() noexcept               { return telemetry; }
+
+    /** Returns the detailed timing measurements for the audio callbacks. */
+    const AudioDeviceTelemetry& getTelemetry() const noexcept   { return telemetry; }
+
+    //==============================================================================
+    /** Sets the number of worker threads that may run the audio callbacks in parallel.
+
+        By default this is 0, and the callbacks are called one after another on the
+        device's audio thread. If you set a positive number of threads, the manager
+        starts that many real-time threads, and each block hands out the callbacks to
+        the workers and the audio thread, which all run them at the same time. Each
+        callback renders into a buffer of its own, and once they've all finished, the
+        audio thread mixes the results together in the usual order, and returns them
+        to the device within the same callback. This lets a device drive several
+        independent engines on different cores.
+
+        Only enable this if all your callbacks are happy to be called from different
+        threads, and to run at the same time as each other. Blocks that don't fit the
+        device's current buffer size are still rendered one callback at a time.
+
+        This must be called on the message thread.
+
+        @see getCallbackTimingStatistics
+    */
+    void setNumCallbackThreads (int numThreads);
+
+    /** Returns the number of threads set with setNumCallbackThreads(). */
+    int getNumCallbackThreads() const noexcept              { return numCallbackThreads; }
+
+    /** Timing statistics for one of the registered audio callbacks.
+
+        All the times are in milliseconds, and cover every block that the callback has
+        rendered since it was added, or since resetCallbackTimingStatistics() was called.
+
+        @see getCallbackTimingStatistics
+    */
+    struct CallbackTimingStatistics
+    {
+        /** The number of blocks that these statistics were calculated from. */
+        int numMeasurements = 0;
+
+        double mean = 0.0, maximum = 0.0, mostRecent = 0.0;
+
+        /** The mean proportion of each block's real-time duration that the callback took. */
+        double meanLoad = 0.0;
+
+        /** The number of blocks for which the callback took longer than the block's duration. */
+        int numOverruns = 0;
+    };
+
+    /** Returns timing statistics for one of the callbacks that has been registered with
+        addAudioCallback(), or an empty Optional if the callback isn't registered.
+
+        The manager measures each callback separately, whether or not they're running in
+        parallel, which can be useful for finding out which one is responsible when the
+        device overruns.
+    */
+    Optional<CallbackTimingStatistics> getCallbackTimingStatistics (AudioIODeviceCallback*) const;
+
+    /** Discards all the callback timing measurements that have been made so far. */
+    void resetCallbackTimingStatistics();
+
     //==============================================================================
     /** Enables or disables a midi input device.
 
@@ -449,10 +524,15 @@ public:
     LevelMeter::Ptr getOutputLevelGetter() noexcept         { return outputLevelGetter; }
 
     //==============================================================================
-    /** Returns the a lock that can be used to synchronise access to the audio callback.
-        Obviously while this is locked, you're blocking the audio thread from running, so
-        it must only be used for very brief periods when absolutely necessary.
+    /** Returns the lock that's held while the list of audio callbacks is changed, and
+        while they're told that the device is starting or stopping.
+
+        The audio callback itself no longer takes this lock, so that the audio thread can
+        never be held up by another thread, which means that holding it won't stop your
+        callbacks from being called. Use your own lock-free mechanism, or a lock of your
+        own, to share data with the audio thread.
     */
+    [[deprecated ("The audio callback no longer holds this lock, so it can't be used to synchronise with it.")]]
     CriticalSection& getAudioCallbackLock() noexcept        { return audioCallbackLock; }
 
     /** Returns the a lock that can be used to synchronise access to the midi callback.
@@ -493,7 +573,17 @@ private:
 
     AudioDeviceSetup currentSetup;
     std::unique_ptr<AudioIODevice> currentAudioDevice;
-    Array<AudioIODeviceCallback*> callbacks;
+    using CallbackList = Array<AudioIODeviceCallback*>;
+    CallbackList callbacks;
+
+    class CallbackTimer;
+    class CallbackThreadPool;
+    struct RealtimeCallbacks;
+    ReadCopyUpdatePointer<RealtimeCallbacks> realtimeCallbacks;
+    std::map<AudioIODeviceCallback*, std::shared_ptr<CallbackTimer>> callbackTimers;
+    std::shared_ptr<CallbackThreadPool> callbackThreadPool;
+    int numCallbackThreads = 0;
+
     int numInputChansNeeded = 0, numOutputChansNeeded = 2;
     String preferredDeviceName, currentDeviceType;
     std::unique_ptr<XmlElement> lastExplicitSettings;
@@ -514,10 +604,11 @@ private:
     std::unique_ptr<MidiOutput> defaultMidiOutput;
     CriticalSection audioCallbackLock, midiCallbackLock;
 
-    std::unique_ptr<AudioBuffer<float>> testSound;
-    int testSoundPosition = 0;
+    struct TestSound;
+    ReadCopyUpdatePointer<TestSound> testSound;
 
     AudioProcessLoadMeasurer loadMeasurer;
+    AudioDeviceTelemetry telemetry;
 
     LevelMeter::Ptr inputLevelGetter   { new LevelMeter() },
                     outputLevelGetter  { new LevelMeter() };
@@ -543,6 +634,7 @@ private:
     void stopDevice();
 
     void updateXml();
+    void publishCallbacks();
 
     void updateCurrentSetup();
     void createDeviceTypesIfNeeded();
@@ -0,0 +1,444 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  The histogram counters. Each one is only ever written by the audio thread, so it's
+    updated with a plain load and store rather than a read-modify-write.
+*/
+class AudioDeviceTelemetry::Counters
+{
+public:
+    Counters()  { clear(); }
+
+    // Times in microseconds are counted exactly below 16us, then in 8 buckets per octave,
+    // which keeps the resolution within 12.5% all the way up to several minutes
+    static constexpr int numExactTimeBuckets = 16, numSubBucketsPerOctave = 8, numOctaves = 24;
+    static constexpr int numTimeBuckets = numExactTimeBuckets + numOctaves * numSubBucketsPerOctave;
+
+    // The deadline margin runs from -1 to 1 in steps of 0.5%
+    static constexpr int numMarginBuckets = 400;
+
+    using Counter = std::atomic<int64>;
+
+    std::array<Counter, numTimeBuckets> durations, wakeUpLatencies;
+    std::array<Counter, numMarginBuckets> margins;
+    Counter numCallbacks, numOverruns, numLateWakeUps;
+
+    void clear() noexcept
+    {
+        for (auto* buckets : { durations.data(), wakeUpLatencies.data() })
+            for (int i = 0; i < numTimeBuckets; ++i)
+                buckets[i] = 0;
+
+        for (auto& c : margins)
+            c = 0;
+
+        numCallbacks = numOverruns = numLateWakeUps = 0;
+    }
+
+    static void increment (Counter& c) noexcept
+    {
+        c.store (c.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static int getTimeBucket (double milliseconds) noexcept
+    {
+        const auto micros = (uint64) jmax (0.0, milliseconds * 1000.0);
+
+        if (micros < (uint64) numExactTimeBuckets)
+            return (int) micros;
+
+        int octave = 4;
+
+        while ((micros >> (octave + 1)) != 0)
+            ++octave;
+
+        if (octave >= 4 + numOctaves)
+            return numTimeBuckets - 1;
+
+        const auto subBucket = (int) ((micros >> (octave - 3)) & (numSubBucketsPerOctave - 1));
+        return numExactTimeBuckets + (octave - 4) * numSubBucketsPerOctave + subBucket;
+    }
+
+    static Range<double> getTimeBucketRangeMs (int bucket) noexcept
+    {
+        if (bucket < numExactTimeBuckets)
+            return { bucket / 1000.0, (bucket + 1) / 1000.0 };
+
+        const auto octave = 4 + (bucket - numExactTimeBuckets) / numSubBucketsPerOctave;
+        const auto subBucket = (bucket - numExactTimeBuckets) % numSubBucketsPerOctave;
+        const auto width = (double) ((uint64) 1 << (octave - 3));
+        const auto start = (double) ((uint64) 1 << octave) + subBucket * width;
+
+        return { start / 1000.0, (start + width) / 1000.0 };
+    }
+
+    static int getMarginBucket (double margin) noexcept
+    {
+        return jlimit (0, numMarginBuckets - 1, (int) std::floor ((margin + 1.0) * (numMarginBuckets / 2)));
+    }
+
+    static Range<double> getMarginBucketRange (int bucket) noexcept
+    {
+        constexpr auto width = 2.0 / numMarginBuckets;
+        return { -1.0 + bucket * width, -1.0 + (bucket + 1) * width };
+    }
+
+    template <size_t numBuckets, typename RangeFunction>
+    static Histogram makeHistogram (const std::array<Counter, numBuckets>& counters, RangeFunction getRange)
+    {
+        Histogram h;
+        h.buckets.reserve (numBuckets);
+
+        for (size_t i = 0; i < numBuckets; ++i)
+        {
+            const auto range = getRange ((int) i);
+            h.buckets.push_back ({ range.getStart(), range.getEnd(), counters[i].load (std::memory_order_relaxed) });
+        }
+
+        return h;
+    }
+};
+
+//==============================================================================
+AudioDeviceTelemetry::AudioDeviceTelemetry()  : counters (std::make_unique<Counters>()) {}
+AudioDeviceTelemetry::~AudioDeviceTelemetry() = default;
+
+void AudioDeviceTelemetry::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    needsNewAnchor = true;
+}
+
+void AudioDeviceTelemetry::reset()
+{
+    counters->clear();
+    needsNewAnchor = true;
+
+    const ScopedLock sl (historyLock);
+    drainXRunFifo();
+    xrunHistory.clear();
+}
+
+//==============================================================================
+AudioDeviceTelemetry::ScopedCallback::ScopedCallback (AudioDeviceTelemetry& t, int numSamplesInBlock,
+                                                      const AudioIODeviceCallbackContext& context) noexcept
+    : owner (t),
+      startTicks (Time::getHighResolutionTicks()),
+      numSamples (numSamplesInBlock),
+      hostTimeNs (context.hostTimeNs != nullptr ? *context.hostTimeNs : 0)
+{
+}
+
+AudioDeviceTelemetry::ScopedCallback::~ScopedCallback()
+{
+    owner.registerCallback (startTicks, Time::getHighResolutionTicks(), numSamples,
+                            hostTimeNs != 0 ? &hostTimeNs : nullptr);
+}
+
+void AudioDeviceTelemetry::registerCallback (int64 startTicks, int64 endTicks, int numSamples,
+                                             const uint64* hostTimeNs) noexcept
+{
+    const auto rate = sampleRate.load (std::memory_order_relaxed);
+
+    if (rate <= 0.0 || numSamples <= 0)
+        return;
+
+    const auto ticksPerMs = (double) Time::getHighResolutionTicksPerSecond() / 1000.0;
+    const auto durationMs = (double) (endTicks - startTicks) / ticksPerMs;
+    const auto deadlineMs = 1000.0 * numSamples / rate;
+
+    // This callback should have started one block after the previous one was due. An
+    // early start means that the estimate was late, so it's moved to match. Otherwise it
+    // creeps towards the actual start times, so that a difference between the audio
+    // clock and the CPU clock doesn't build up into a false latency.
+    double wakeUpLatencyMs = 0.0;
+    auto expectedIntervalMs = deadlineMs;
+
+    if (needsNewAnchor.exchange (false, std::memory_order_relaxed))
+    {
+        expectedStartTicks = (double) startTicks;
+    }
+    else
+    {
+        expectedIntervalMs = (hostTimeNs != nullptr && lastHostTimeNs != 0 && *hostTimeNs > lastHostTimeNs)
+                                ? (double) (*hostTimeNs - lastHostTimeNs) / 1.0e6
+                                : 1000.0 * lastNumSamples / rate;
+
+        expectedStartTicks += expectedIntervalMs * ticksPerMs;
+        wakeUpLatencyMs = ((double) startTicks - expectedStartTicks) / ticksPerMs;
+
+        if (wakeUpLatencyMs < 0.0)
+        {
+            expectedStartTicks = (double) startTicks;
+            wakeUpLatencyMs = 0.0;
+        }
+        else
+        {
+            expectedStartTicks += wakeUpLatencyMs * ticksPerMs * 0.01;
+        }
+    }
+
+    lastNumSamples = numSamples;
+    lastHostTimeNs = hostTimeNs != nullptr ? *hostTimeNs : 0;
+
+    const auto margin = 1.0 - durationMs / deadlineMs;
+
+    auto& c = *counters;
+    Counters::increment (c.numCallbacks);
+    Counters::increment (c.durations[(size_t) Counters::getTimeBucket (durationMs)]);
+    Counters::increment (c.wakeUpLatencies[(size_t) Counters::getTimeBucket (wakeUpLatencyMs)]);
+    Counters::increment (c.margins[(size_t) Counters::getMarginBucket (margin)]);
+
+   #if JUCE_ENABLE_TRACING
+    TraceRecorder::addZone ("Audio device callback", startTicks, endTicks);
+   #endif
+
+    JUCE_TRACE_COUNTER ("Audio deadline margin (%)", margin * 100.0);
+    JUCE_TRACE_COUNTER ("Audio wake-up latency (ms)", wakeUpLatencyMs);
+
+    const auto makeEvent = [&] (XRunEvent::Kind kind)
+    {
+        return XRunEvent { kind,
+                           Time::getCurrentTime() - RelativeTime::milliseconds ((int64) durationMs),
+                           startTicks,
+                           numSamples,
+                           durationMs,
+                           deadlineMs,
+                           wakeUpLatencyMs };
+    };
+
+    if (durationMs > deadlineMs)
+    {
+        Counters::increment (c.numOverruns);
+        pushXRun (makeEvent (XRunEvent::Kind::overrun));
+        JUCE_TRACE_INSTANT ("Audio callback overrun");
+    }
+
+    if (wakeUpLatencyMs > expectedIntervalMs)
+    {
+        Counters::increment (c.numLateWakeUps);
+        pushXRun (makeEvent (XRunEvent::Kind::lateWakeUp));
+        JUCE_TRACE_INSTANT ("Audio callback woke late");
+    }
+}
+
+//==============================================================================
+void AudioDeviceTelemetry::pushXRun (const XRunEvent& event) noexcept
+{
+    // If nobody has read the history for a while and the FIFO is full, the event is dropped
+    const auto scope = xrunFifo.write (1);
+
+    if (scope.blockSize1 > 0)
+        xrunFifoEvents[(size_t) scope.startIndex1] = event;
+    else if (scope.blockSize2 > 0)
+        xrunFifoEvents[(size_t) scope.startIndex2] = event;
+}
+
+void AudioDeviceTelemetry::drainXRunFifo() const
+{
+    const auto scope = xrunFifo.read (xrunFifo.getNumReady());
+
+    const auto addEvents = [this] (int start, int num)
+    {
+        for (int i = 0; i < num; ++i)
+            xrunHistory.push_back (xrunFifoEvents[(size_t) (start + i)]);
+    };
+
+    addEvents (scope.startIndex1, scope.blockSize1);
+    addEvents (scope.startIndex2, scope.blockSize2);
+
+    while (xrunHistory.size() > (size_t) maxXRunHistory)
+        xrunHistory.pop_front();
+}
+
+std::vector<AudioDeviceTelemetry::XRunEvent> AudioDeviceTelemetry::getXRunHistory() const
+{
+    const ScopedLock sl (historyLock);
+    drainXRunFifo();
+    return { xrunHistory.begin(), xrunHistory.end() };
+}
+
+//==============================================================================
+AudioDeviceTelemetry::Histogram AudioDeviceTelemetry::getCallbackDurationHistogram() const
+{
+    return Counters::makeHistogram (counters->durations, Counters::getTimeBucketRangeMs);
+}
+
+AudioDeviceTelemetry::Histogram AudioDeviceTelemetry::getDeadlineMarginHistogram() const
+{
+    return Counters::makeHistogram (counters->margins, Counters::getMarginBucketRange);
+}
+
+AudioDeviceTelemetry::Histogram AudioDeviceTelemetry::getWakeUpLatencyHistogram() const
+{
+    return Counters::makeHistogram (counters->wakeUpLatencies, Counters::getTimeBucketRangeMs);
+}
+
+int64 AudioDeviceTelemetry::getNumCallbacks() const noexcept     { return counters->numCallbacks.load (std::memory_order_relaxed); }
+int64 AudioDeviceTelemetry::getNumOverruns() const noexcept      { return counters->numOverruns.load (std::memory_order_relaxed); }
+int64 AudioDeviceTelemetry::getNumLateWakeUps() const noexcept   { return counters->numLateWakeUps.load (std::memory_order_relaxed); }
+
+//==============================================================================
+int64 AudioDeviceTelemetry::Histogram::getTotalCount() const noexcept
+{
+    int64 total = 0;
+
+    for (auto& b : buckets)
+        total += b.count;
+
+    return total;
+}
+
+double AudioDeviceTelemetry::Histogram::getPercentile (double proportion) const noexcept
+{
+    const auto total = getTotalCount();
+
+    if (total == 0)
+        return 0.0;
+
+    const auto target = jlimit (0.0, 1.0, proportion) * (double) total;
+    double countSoFar = 0.0;
+
+    for (auto& b : buckets)
+    {
+        if (b.count > 0 && countSoFar + (double) b.count >= target)
+            return b.lowerBound + (b.upperBound - b.lowerBound) * (target - countSoFar) / (double) b.count;
+
+        countSoFar += (double) b.count;
+    }
+
+    return buckets.back().upperBound;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioDeviceTelemetryTests  : public UnitTest
+{
+public:
+    AudioDeviceTelemetryTests()
+        : UnitTest ("AudioDeviceTelemetry", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 480;  // a 10ms deadline
+
+        const auto ticksPerMs = (double) Time::getHighResolutionTicksPerSecond() / 1000.0;
+        const auto toTicks = [&] (double ms) { return (int64) (ms * ticksPerMs); };
+
+        beginTest ("Durations, margins and percentiles");
+        {
+            AudioDeviceTelemetry telemetry;
+            telemetry.prepare (sampleRate);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto start = toTicks (10.0 * i);
+                telemetry.registerCallback (start, start + toTicks (i < 90 ? 2.0 : 8.0), blockSize);
+            }
+
+            expectEquals (telemetry.getNumCallbacks(), (int64) 100);
+            expectEquals (telemetry.getNumOverruns(), (int64) 0);
+            expectEquals (telemetry.getNumLateWakeUps(), (int64) 0);
+
+            const auto durations = telemetry.getCallbackDurationHistogram();
+            expectEquals (durations.getTotalCount(), (int64) 100);
+            expectWithinAbsoluteError (durations.getPercentile (0.5), 2.0, 0.25);
+            expectWithinAbsoluteError (durations.getPercentile (0.95), 8.0, 1.0);
+
+            const auto margins = telemetry.getDeadlineMarginHistogram();
+            expectWithinAbsoluteError (margins.getPercentile (0.05), 0.2, 0.01);
+            expectWithinAbsoluteError (margins.getPercentile (0.5), 0.8, 0.01);
+        }
+
+        beginTest ("Overruns and late wake-ups are logged");
+        {
+            AudioDeviceTelemetry telemetry;
+            telemetry.prepare (sampleRate);
+
+            // The fourth callback wakes 15ms late, and the next one catches up straight after it
+            const double startTimesMs[] = { 0.0, 10.0, 20.0, 45.0, 46.0, 50.0, 60.0 };
+            const double durationsMs[]  = { 1.0, 12.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+            for (size_t i = 0; i < std::size (startTimesMs); ++i)
+                telemetry.registerCallback (toTicks (startTimesMs[i]),
+                                            toTicks (startTimesMs[i] + durationsMs[i]),
+                                            blockSize);
+
+            expectEquals (telemetry.getNumOverruns(), (int64) 1);
+            expectEquals (telemetry.getNumLateWakeUps(), (int64) 1);
+
+            const auto history = telemetry.getXRunHistory();
+            expectEquals ((int) history.size(), 2);
+
+            if (history.size() == 2)
+            {
+                expect (history[0].kind == XRunEvent::Kind::overrun);
+                expectWithinAbsoluteError (history[0].callbackDurationMs, 12.0, 0.01);
+                expectWithinAbsoluteError (history[0].deadlineMs, 10.0, 0.001);
+
+                expect (history[1].kind == XRunEvent::Kind::lateWakeUp);
+                expectWithinAbsoluteError (history[1].wakeUpLatencyMs, 15.0, 0.01);
+            }
+
+            // Once the device has caught up, the callbacks are back on schedule
+            const auto latencies = telemetry.getWakeUpLatencyHistogram();
+            expectEquals (latencies.getTotalCount(), (int64) 7);
+            expect (latencies.getPercentile (0.7) < 0.1);
+
+            telemetry.reset();
+            expectEquals (telemetry.getNumCallbacks(), (int64) 0);
+            expect (telemetry.getXRunHistory().empty());
+        }
+
+        beginTest ("Host times set the expected interval");
+        {
+            AudioDeviceTelemetry telemetry;
+            telemetry.prepare (sampleRate);
+
+            // The hardware delivered the second buffer 20ms after the first, so a callback
+            // 20ms later is on time
+            uint64 hostTimeNs = 1000000000;
+            telemetry.registerCallback (0, toTicks (1.0), blockSize, &hostTimeNs);
+            hostTimeNs += 20000000;
+            telemetry.registerCallback (toTicks (20.0), toTicks (21.0), blockSize, &hostTimeNs);
+
+            expectEquals (telemetry.getNumLateWakeUps(), (int64) 0);
+            expect (telemetry.getWakeUpLatencyHistogram().getPercentile (1.0) < 0.1);
+        }
+    }
+
+    using XRunEvent = AudioDeviceTelemetry::XRunEvent;
+};
+
+static AudioDeviceTelemetryTests audioDeviceTelemetryTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Gathers detailed timing measurements for an audio device's callbacks, to help
+    track down intermittent dropouts.
+
+    For every callback it records how long the callback took, how much of its deadline
+    (the duration of the block of audio) was left over, and how late the callback
+    started compared with when it was expected. Each of these goes into a histogram,
+    from which you can get percentiles. Whenever a callback overruns its deadline or
+    starts more than a whole block late, an XRunEvent is logged with the numbers for
+    that callback.
+
+    The audio thread never waits for anything here: the histograms are plain counters
+    that only the audio thread writes to, and the xrun events are passed through a
+    lock-free FIFO. The getter methods can be called from any thread.
+
+    When JUCE_ENABLE_TRACING is set and the TraceRecorder is running, each callback is
+    also recorded as a zone, the deadline margin as a counter, and each xrun as an
+    instant event, so they can be lined up with everything else on the timeline.
+
+    An AudioDeviceManager has one of these, which you can get with
+    AudioDeviceManager::getTelemetry().
+
+    @see AudioDeviceManager, AudioProcessLoadMeasurer, TraceRecorder
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioDeviceTelemetry
+{
+public:
+    //==============================================================================
+    AudioDeviceTelemetry();
+
+    /** Destructor. */
+    ~AudioDeviceTelemetry();
+
+    //==============================================================================
+    /** Tells the telemetry the sample rate of a device that's about to start.
+
+        The measurements gathered so far are kept, so that a device restart doesn't lose
+        the history leading up to it.
+    */
+    void prepare (double sampleRate);
+
+    /** Clears all the measurements and the xrun history. */
+    void reset();
+
+    //==============================================================================
+    /** Measures the time between its construction and destruction as one audio callback.
+
+        @code
+        void audioDeviceIOCallbackWithContext (..., int numSamples, const AudioIODeviceCallbackContext& context) override
+        {
+            const AudioDeviceTelemetry::ScopedCallback measurement (telemetry, numSamples, context);
+            ...
+        }
+        @endcode
+
+        @tags{Audio}
+    */
+    class JUCE_API  ScopedCallback
+    {
+    public:
+        ScopedCallback (AudioDeviceTelemetry&, int numSamples, const AudioIODeviceCallbackContext&) noexcept;
+        ~ScopedCallback();
+
+    private:
+        AudioDeviceTelemetry& owner;
+        const int64 startTicks;
+        const int numSamples;
+        const uint64 hostTimeNs;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCallback)
+    };
+
+    /** Adds the timing of a callback to the measurements.
+
+        The times are in the units returned by Time::getHighResolutionTicks(). If the
+        device supplied the host time of the callback's buffer, pass it in, as it's used
+        to work out when the callback should have started. Normally you'd use a
+        ScopedCallback rather than calling this directly.
+
+        This must only be called from one thread at a time - usually the audio thread.
+    */
+    void registerCallback (int64 startTicks, int64 endTicks, int numSamples,
+                           const uint64* hostTimeNs = nullptr) noexcept;
+
+    //==============================================================================
+    /** A snapshot of one of the histograms. */
+    struct Histogram
+    {
+        struct Bucket
+        {
+            double lowerBound, upperBound;
+            int64 count;
+        };
+
+        /** The buckets, in ascending order of value. */
+        std::vector<Bucket> buckets;
+
+        /** Returns the total number of values counted. */
+        int64 getTotalCount() const noexcept;
+
+        /** Returns an estimate of the value below which the given proportion (0 to 1) of
+            the values fall, interpolating within the bucket. Returns 0 if it's empty.
+        */
+        double getPercentile (double proportion) const noexcept;
+    };
+
+    /** Returns a histogram of how long each callback took, in milliseconds. */
+    Histogram getCallbackDurationHistogram() const;
+
+    /** Returns a histogram of the proportion of each callback's deadline that was left
+        when it finished.
+
+        A value of 1 means the callback took no time at all, and 0 means it used its whole
+        deadline. Negative values are overruns; anything below -1 is counted in the lowest
+        bucket.
+    */
+    Histogram getDeadlineMarginHistogram() const;
+
+    /** Returns a histogram of how late each callback started, in milliseconds.
+
+        A callback is expected to start one block's duration after the previous one did.
+        If the device supplies host times with its callbacks, the difference between those
+        is used instead, so that the measurement follows the hardware's clock. Callbacks
+        that start early count as 0.
+    */
+    Histogram getWakeUpLatencyHistogram() const;
+
+    //==============================================================================
+    /** The numbers for a callback that missed its deadline. */
+    struct XRunEvent
+    {
+        enum class Kind
+        {
+            overrun,        /**< The callback took longer than the duration of its block. */
+            lateWakeUp      /**< The callback started more than a whole block late. */
+        };
+
+        Kind kind;
+
+        /** The wall-clock time at which the callback started. */
+        Time time;
+
+        /** The callback's start time, as returned by Time::getHighResolutionTicks(), which
+            is the clock used by the TraceRecorder.
+        */
+        int64 startTicks;
+
+        int numSamples;
+        double callbackDurationMs, deadlineMs, wakeUpLatencyMs;
+    };
+
+    /** Returns the most recent xrun events, oldest first. Up to 256 are kept. */
+    std::vector<XRunEvent> getXRunHistory() const;
+
+    /** Returns the number of callbacks that have been measured. */
+    int64 getNumCallbacks() const noexcept;
+
+    /** Returns the number of callbacks that have overrun their deadlines. */
+    int64 getNumOverruns() const noexcept;
+
+    /** Returns the number of callbacks that started more than a block late. */
+    int64 getNumLateWakeUps() const noexcept;
+
+private:
+    //==============================================================================
+    class Counters;
+    std::unique_ptr<Counters> counters;
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> needsNewAnchor { true };
+
+    // only used on the audio thread
+    double expectedStartTicks = 0.0;
+    uint64 lastHostTimeNs = 0;
+    int lastNumSamples = 0;
+
+    static constexpr int maxXRunHistory = 256;
+    mutable AbstractFifo xrunFifo { maxXRunHistory };
+    std::array<XRunEvent, maxXRunHistory> xrunFifoEvents;
+
+    CriticalSection historyLock;
+    mutable std::deque<XRunEvent> xrunHistory;
+
+    void pushXRun (const XRunEvent&) noexcept;
+    void drainXRunFifo() const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioDeviceTelemetry)
+};
+
+} // namespace juce
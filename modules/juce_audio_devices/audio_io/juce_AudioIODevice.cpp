@@ -42,6 +42,7 @@ void AudioIODeviceCallback::audioDeviceError (const String&)    {}
 bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false; }
 bool AudioIODevice::hasControlPanel() const                     { return false; }
 int  AudioIODevice::getXRunCount() const noexcept               { return -1; }
+AudioWorkgroup AudioIODevice::getWorkgroup() const              { return {}; }
 
 bool AudioIODevice::showControlPanel()
 {
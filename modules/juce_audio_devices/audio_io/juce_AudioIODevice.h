@@ -322,6 +322,17 @@ public:
     */
     virtual int getXRunCount() const noexcept;
 
+    /** Returns the workgroup that the device's audio thread belongs to.
+
+        Any other real-time threads that help to render the device's buffers should
+        join this workgroup while the device is running, e.g. by creating a
+        WorkStealingThreadPool with AudioWorkgroup::makeThreadPoolOptions().
+
+        Workgroups are only available on macOS 11 and later; on other platforms, or if
+        the device isn't running, this returns an invalid workgroup.
+    */
+    virtual AudioWorkgroup getWorkgroup() const;
+
     //==============================================================================
 protected:
     /** Creates a device, setting its name and type member variables. */
@@ -49,7 +49,6 @@
 
 //==============================================================================
 #if JUCE_MAC || JUCE_IOS
- #include <juce_audio_basics/midi/ump/juce_UMP.h>
  #include "midi_io/ump/juce_UMPBytestreamInputHandler.h"
  #include "midi_io/ump/juce_UMPU32InputHandler.h"
 #endif
@@ -63,6 +62,10 @@
  #undef Point
  #undef Component
 
+ #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+  #include <os/workgroup.h>
+ #endif
+
  #include "native/juce_mac_CoreAudio.cpp"
  #include "native/juce_mac_CoreMidi.mm"
 
@@ -112,7 +115,6 @@
   JUCE_END_IGNORE_WARNINGS_MSVC
  #endif
 
- #include <juce_audio_basics/midi/juce_MidiDataConcatenator.h>
  #include "native/juce_win32_Midi.cpp"
 
  #if JUCE_ASIO
@@ -167,6 +169,21 @@
   #include "native/juce_linux_JackAudio.cpp"
  #endif
 
+ #if JUCE_PIPEWIRE
+  /* Got an include error here? If so, you've either not got the PipeWire development
+     headers installed, or you've not added the paths that "pkg-config --cflags libpipewire-0.3"
+     gives you to your header search paths.
+
+     The package you need to install to get PipeWire support is "libpipewire-0.3-dev".
+
+     The library itself is loaded when the device type is scanned, so if it's missing
+     at runtime, the PipeWire device type will just be empty.
+  */
+  #include <pipewire/pipewire.h>
+  #include <pipewire/filter.h>
+  #include "native/juce_linux_PipeWire.cpp"
+ #endif
+
  #if (JUCE_LINUX && JUCE_BELA)
   /* Got an include error here? If so, you've either not got the bela headers
      installed, or you've not got your paths set up correctly to find its header
@@ -174,14 +191,12 @@
   */
   #include <Bela.h>
   #include <Midi.h>
-  #include <juce_audio_basics/midi/juce_MidiDataConcatenator.h>
   #include "native/juce_linux_Bela.cpp"
  #endif
 
  #undef SIZEOF
 
  #if ! JUCE_BELA
-  #include <juce_audio_basics/midi/juce_MidiDataConcatenator.h>
   #include "native/juce_linux_Midi.cpp"
  #endif
 
@@ -196,7 +211,6 @@ namespace juce
 
 #include "native/juce_android_Audio.cpp"
 
- #include <juce_audio_basics/midi/juce_MidiDataConcatenator.h>
  #include "native/juce_android_Midi.cpp"
 
  #if JUCE_USE_ANDROID_OPENSLES || JUCE_USE_ANDROID_OBOE
@@ -245,9 +259,11 @@ namespace juce
 }
 #endif
 
+#include "audio_io/juce_AudioDeviceTelemetry.cpp"
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_AggregateAudioIODevice.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "midi_io/juce_MidiDevices.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
@@ -116,6 +116,14 @@
  #define JUCE_JACK 0
 #endif
 
+/** Config: JUCE_PIPEWIRE
+    Enables a native PipeWire device type (Linux only). The PipeWire library is loaded
+    at runtime, so you only need its headers to build with this enabled.
+*/
+#ifndef JUCE_PIPEWIRE
+ #define JUCE_PIPEWIRE 0
+#endif
+
 /** Config: JUCE_BELA
     Enables Bela audio devices on Bela boards.
 */
@@ -180,9 +188,11 @@ namespace juce
 
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
+#include "audio_io/juce_AggregateAudioIODevice.h"
 #include "audio_io/juce_SystemAudioVolume.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
+#include "audio_io/juce_AudioDeviceTelemetry.h"
 #include "audio_io/juce_AudioDeviceManager.h"
 
 #if JUCE_IOS
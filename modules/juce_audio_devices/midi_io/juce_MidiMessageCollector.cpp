@@ -34,22 +34,23 @@ MidiMessageCollector::~MidiMessageCollector()
 //==============================================================================
 void MidiMessageCollector::reset (const double newSampleRate)
 {
-    const ScopedLock sl (midiCallbackLock);
-
     jassert (newSampleRate > 0);
 
    #if JUCE_DEBUG
     hasCalledReset = true;
    #endif
     sampleRate = newSampleRate;
-    incomingMessages.clear();
+
+    // The audio thread clears incomingMessages itself at the end of each block
+    while (pendingMessages.popWith ([] (const MidiMessage&) {}))
+    {}
+
     lastCallbackTime = Time::getMillisecondCounterHiRes();
+    clockNeedsResync = true;
 }
 
 void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
@@ -58,35 +59,70 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (message.getTimeStamp() != 0);
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
-
-    incomingMessages.addEvent (message, sampleNumber);
-
-    // if the messages don't get used for over a second, we'd better
-    // get rid of any old ones to avoid the queue getting too big
-    if (sampleNumber > sampleRate)
-        incomingMessages.clear (0, sampleNumber - (int) sampleRate);
+    pendingMessages.push (message);
 }
 
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
                                                       const int numSamples)
 {
-    const ScopedLock sl (midiCallbackLock);
+    removeNextBlockOfMessages (destBuffer, numSamples, Time::getMillisecondCounterHiRes() * 0.001);
+}
 
+void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
+                                                      const int numSamples,
+                                                      const double blockStartTimeSeconds)
+{
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
 
     jassert (numSamples > 0);
 
-    auto timeNow = Time::getMillisecondCounterHiRes();
-    auto msElapsed = timeNow - lastCallbackTime;
+    const auto rate = sampleRate.load();
+
+    if (clockNeedsResync.exchange (false))
+    {
+        clock.isLocked = false;
+        incomingMessages.clear();
+    }
+
+    if (timingMode == TimingMode::sampleAccurate)
+    {
+        removeSampleAccurateBlock (destBuffer, numSamples, blockStartTimeSeconds, rate);
+        lastCallbackTime = blockStartTimeSeconds * 1000.0;
+        return;
+    }
+
+    // the clock will need to lock again if the mode is changed back
+    clock.isLocked = false;
+
+    const auto previousCallbackTime = lastCallbackTime.load();
+    auto latestSampleNumber = 0;
+
+    const auto addToIncomingMessages = [&] (const MidiMessage& message)
+    {
+        auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * previousCallbackTime) * rate);
+        incomingMessages.addEvent (message, sampleNumber);
+        latestSampleNumber = jmax (latestSampleNumber, sampleNumber);
+    };
+
+    // Limited to one queue's worth, so that a flood of messages can't hold up the callback
+    for (int i = 0; i < maxNumPendingMessages && pendingMessages.popWith (addToIncomingMessages); ++i)
+    {}
+
+    // if the messages don't get used for over a second, we'd better
+    // get rid of any old ones to avoid the queue getting too big
+    if (latestSampleNumber > rate)
+        incomingMessages.clear (0, latestSampleNumber - (int) rate);
+
+    auto timeNow = blockStartTimeSeconds * 1000.0;
+    auto msElapsed = timeNow - previousCallbackTime;
 
     lastCallbackTime = timeNow;
 
     if (! incomingMessages.isEmpty())
     {
-        int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * sampleRate));
+        int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * rate));
         int startSample = 0;
         int scale = 1 << 16;
 
@@ -128,9 +164,93 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
     }
 }
 
+void MidiMessageCollector::updateCallbackClock (double blockStartTimeSeconds, int numSamples, double rate) noexcept
+{
+    // This is a delay-locked loop, which follows the average rate and phase of the callbacks
+    // while filtering out their jitter. The bandwidth is low because the sample clock is
+    // very stable, so any sudden change in the callback times can only be jitter.
+    constexpr double bandwidthHz = 0.1;
+    constexpr double marginDecayTimeSeconds = 30.0;
+    constexpr double marginHeadroom = 1.5;
+    constexpr double maxErrorSeconds = 0.1;
+
+    const auto nominalSecondsPerSample = 1.0 / rate;
+
+    if (clock.isLocked)
+    {
+        const auto predictedTime = clock.blockStartTime + clock.lastNumSamples * clock.secondsPerSample;
+        const auto error = blockStartTimeSeconds - predictedTime;
+
+        if (std::abs (error) < maxErrorSeconds)
+        {
+            const auto blockDuration = clock.lastNumSamples * nominalSecondsPerSample;
+            const auto omega = MathConstants<double>::twoPi * bandwidthHz * blockDuration;
+
+            clock.blockStartTime = predictedTime + MathConstants<double>::sqrt2 * omega * error;
+            clock.secondsPerSample = jlimit (nominalSecondsPerSample * 0.99,
+                                             nominalSecondsPerSample * 1.01,
+                                             clock.secondsPerSample + omega * omega * error / clock.lastNumSamples);
+
+            // A callback that arrives early means that messages which came in just before the
+            // previous one could be placed before the start of their block, so the delay
+            // needs to cover the largest recent gap like this. Each change to the margin
+            // shifts the messages, so it's given some headroom to keep the changes rare.
+            clock.jitterMargin *= 1.0 - blockDuration / marginDecayTimeSeconds;
+
+            if (-error > clock.jitterMargin)
+                clock.jitterMargin = -error * marginHeadroom;
+            clock.lastNumSamples = numSamples;
+            return;
+        }
+    }
+
+    // either this is the first block, or the callbacks have stopped for a while
+    clock.blockStartTime = blockStartTimeSeconds;
+    clock.secondsPerSample = nominalSecondsPerSample;
+    clock.jitterMargin = 0;
+    clock.lastNumSamples = numSamples;
+    clock.isLocked = true;
+}
+
+void MidiMessageCollector::removeSampleAccurateBlock (MidiBuffer& destBuffer, int numSamples,
+                                                      double blockStartTimeSeconds, double rate)
+{
+    updateCallbackClock (blockStartTimeSeconds, numSamples, rate);
+
+    const auto latency = numSamples + (int) std::ceil (clock.jitterMargin / clock.secondsPerSample);
+    const auto maxSampleNumber = latency + (int) rate;
+
+    // Any messages held back from the last block are already in incomingMessages, relative
+    // to the start of this one
+    const auto addToIncomingMessages = [&] (const MidiMessage& message)
+    {
+        const auto offset = (message.getTimeStamp() - clock.blockStartTime) / clock.secondsPerSample;
+        incomingMessages.addEvent (message, jlimit (0, maxSampleNumber, latency + roundToInt (offset)));
+    };
+
+    for (int i = 0; i < maxNumPendingMessages && pendingMessages.popWith (addToIncomingMessages); ++i)
+    {}
+
+    if (incomingMessages.isEmpty())
+        return;
+
+    heldMessages.clear();
+
+    for (const auto metadata : incomingMessages)
+    {
+        if (metadata.samplePosition < numSamples)
+            destBuffer.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+        else
+            heldMessages.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition - numSamples);
+    }
+
+    incomingMessages.swapWith (heldMessages);
+}
+
 void MidiMessageCollector::ensureStorageAllocated (size_t bytes)
 {
     incomingMessages.ensureSize (bytes);
+    heldMessages.ensureSize (bytes);
 }
 
 //==============================================================================
@@ -155,4 +275,108 @@ void MidiMessageCollector::handleIncomingMidiMessage (MidiInput*, const MidiMess
     addMessageToQueue (message);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageCollectorTests  : public UnitTest
+{
+public:
+    MidiMessageCollectorTests()
+        : UnitTest ("MidiMessageCollector", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 256;
+        constexpr double startTime = 1000.0;
+        constexpr double messageInterval = 0.001;
+        constexpr double maxJitter = 0.003;
+
+        // Simulates callbacks that run up to maxJitter late, with a message arriving every millisecond,
+        // and returns the absolute sample position of each message
+        const auto collect = [&] (MidiMessageCollector::TimingMode mode, double durationSeconds)
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+            collector.setTimingMode (mode);
+            collector.ensureStorageAllocated (16384);
+
+            Random random (0x1234);
+            std::vector<int> positions;
+            MidiBuffer block;
+            int nextMessage = 0;
+            const auto numBlocks = (int) (durationSeconds * sampleRate / blockSize);
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                const auto callbackTime = startTime + i * blockSize / sampleRate + random.nextDouble() * maxJitter;
+
+                for (;; ++nextMessage)
+                {
+                    const auto time = startTime + nextMessage * messageInterval;
+
+                    if (time >= callbackTime)
+                        break;
+
+                    auto message = MidiMessage::controllerEvent (1, 1, nextMessage & 0x7f);
+                    message.setTimeStamp (time);
+                    collector.addMessageToQueue (message);
+                }
+
+                block.clear();
+                collector.removeNextBlockOfMessages (block, blockSize, callbackTime);
+
+                for (const auto metadata : block)
+                {
+                    expect (isPositiveAndBelow (metadata.samplePosition, blockSize));
+                    expectEquals (metadata.getMessage().getControllerValue(), (int) positions.size() & 0x7f);
+                    positions.push_back (i * blockSize + metadata.samplePosition);
+                }
+            }
+
+            return positions;
+        };
+
+        beginTest ("Sample-accurate timing keeps the spacing of messages");
+        {
+            const auto positions = collect (MidiMessageCollector::TimingMode::sampleAccurate, 6.0);
+            const auto expectedSpacing = roundToInt (messageInterval * sampleRate);
+
+            expect (positions.size() > 5900);
+
+            int maxDelay = 0;
+
+            // allow a couple of seconds for the clock to settle
+            for (size_t i = 2000; i < positions.size(); ++i)
+            {
+                expectWithinAbsoluteError (positions[i] - positions[i - 1], expectedSpacing, 2);
+
+                const auto messageTime = (double) i * messageInterval * sampleRate;
+                maxDelay = jmax (maxDelay, positions[i] - roundToInt (messageTime));
+            }
+
+            expect (maxDelay < blockSize + roundToInt (maxJitter * sampleRate) + 4);
+        }
+
+        beginTest ("Lowest-latency timing delivers every message in the next block");
+        {
+            const auto positions = collect (MidiMessageCollector::TimingMode::lowestLatency, 2.0);
+
+            // the first block is measured from the time when reset() was called
+            for (size_t i = 100; i < positions.size(); ++i)
+            {
+                expect (positions[i] >= positions[i - 1]);
+
+                const auto messageTime = (double) i * messageInterval * sampleRate;
+                expect (positions[i] - messageTime < 2 * blockSize + maxJitter * sampleRate);
+            }
+        }
+    }
+};
+
+static MidiMessageCollectorTests midiMessageCollectorTests;
+
+#endif
+
 } // namespace juce
@@ -54,13 +54,46 @@ public:
     */
     void reset (double sampleRate);
 
+    //==============================================================================
+    /** The ways in which removeNextBlockOfMessages() can position the messages.
+
+        @see setTimingMode
+    */
+    enum class TimingMode
+    {
+        /** Every message that has arrived is delivered in the next block, towards its
+            end. This has the lowest latency, but the positions of the messages within
+            a block depend on exactly when the audio callback happened to run.
+        */
+        lowestLatency,
+
+        /** The audio callback's timing is smoothed to follow the device's sample clock,
+            and each message is placed at the sample that matches its timestamp, after a
+            fixed delay of one block plus the amount of jitter seen in the callbacks.
+            The spacing between messages is kept to within a sample or so, however
+            unevenly the callbacks arrive. Messages that fall beyond the end of a block
+            are held back for the next one.
+        */
+        sampleAccurate
+    };
+
+    /** Chooses how the messages are positioned within each block.
+        The default is TimingMode::lowestLatency.
+    */
+    void setTimingMode (TimingMode newMode) noexcept        { timingMode = newMode; }
+
+    /** Returns the mode set by setTimingMode(). */
+    TimingMode getTimingMode() const noexcept               { return timingMode; }
+
     /** Takes an incoming real-time message and adds it to the queue.
 
         The message's timestamp is taken, and it will be ready for retrieval as part
         of the block returned by the next call to removeNextBlockOfMessages().
 
-        This method is fully thread-safe when overlapping calls are made with
-        removeNextBlockOfMessages().
+        This method is lock-free, and can be called from any number of threads at once,
+        including while removeNextBlockOfMessages() is running. Messages wait in a
+        fixed-size queue until the next block is removed, and if that fills up because
+        the audio callback has stopped, any further messages are dropped.
     */
     void addMessageToQueue (const MidiMessage& message);
 
@@ -73,18 +106,29 @@ public:
         callback, because the time that it happens is used in calculating the
         midi event positions.
 
-        This method is fully thread-safe when overlapping calls are made with
+        This method is lock-free and doesn't block the threads that call
         addMessageToQueue().
 
         Precondition: numSamples must be greater than 0.
     */
     void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples);
 
+    /** Removes the pending messages for a block whose callback began at a known time.
+
+        This does the same as the other version of removeNextBlockOfMessages(), but
+        rather than reading the clock itself, it uses the time you supply, which must be
+        in seconds on the same clock as the messages' timestamps (see MidiInput). Use
+        this if you can get a more accurate time for the start of the block from the
+        audio device than the moment when the callback runs.
+    */
+    void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples, double blockStartTimeSeconds);
+
     /** Preallocates storage for collected messages.
 
         This can be called before audio processing begins to ensure that there
         is sufficient space for the expected MIDI messages, in order to avoid
-        allocations within the audio callback.
+        allocations within the audio callback. It mustn't be called while
+        removeNextBlockOfMessages() is running.
     */
     void ensureStorageAllocated (size_t bytes);
 
@@ -99,12 +143,26 @@ public:
 
 private:
     //==============================================================================
-    double lastCallbackTime = 0;
-    CriticalSection midiCallbackLock;
-    MidiBuffer incomingMessages;
-    double sampleRate = 44100.0;
+    struct CallbackClock
+    {
+        double blockStartTime = 0, secondsPerSample = 0, jitterMargin = 0;
+        int lastNumSamples = 0;
+        bool isLocked = false;
+    };
+
+    void updateCallbackClock (double blockStartTimeSeconds, int numSamples, double rate) noexcept;
+    void removeSampleAccurateBlock (MidiBuffer&, int numSamples, double blockStartTimeSeconds, double rate);
+
+    static constexpr int maxNumPendingMessages = 2048;
+
+    std::atomic<double> lastCallbackTime { 0 }, sampleRate { 44100.0 };
+    std::atomic<TimingMode> timingMode { TimingMode::lowestLatency };
+    std::atomic<bool> clockNeedsResync { true };
+    MPMCQueue<MidiMessage> pendingMessages { maxNumPendingMessages };
+    MidiBuffer incomingMessages, heldMessages;
+    CallbackClock clock;
    #if JUCE_DEBUG
-    bool hasCalledReset = false;
+    std::atomic<bool> hasCalledReset { false };
    #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiMessageCollector)
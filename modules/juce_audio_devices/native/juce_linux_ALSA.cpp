@@ -48,6 +48,13 @@ namespace
 
 #define JUCE_ALSA_FAILED(x)  failed (x)
 
+/*  When this is enabled, the hardware devices are read and written through their
+    memory-mapped ring buffers, which saves a copy and a system call on every period.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 1
+#endif
+
 static void getDeviceSampleRates (snd_pcm_t* handle, Array<double>& rates)
 {
     snd_pcm_hw_params_t* hwParams;
@@ -208,11 +215,24 @@ public:
             return false;
         }
 
-        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
-            isInterleaved = true;
-        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
-            isInterleaved = false;
-        else
+        const auto trySetAccess = [&] (snd_pcm_access_t access, bool interleaved, bool mmap)
+        {
+            if (snd_pcm_hw_params_set_access (handle, hwParams, access) < 0)
+                return false;
+
+            isInterleaved = interleaved;
+            isMmap = mmap;
+            return true;
+        };
+
+        // The plug-in devices only emulate mmap access on top of their own buffers, so
+        // it's just used for the hardware, where it lets us convert straight into the DMA buffer
+        const auto canUseMmap = JUCE_ALSA_USE_MMAP && deviceID.startsWith ("hw:");
+
+        if (! ((canUseMmap && trySetAccess (SND_PCM_ACCESS_MMAP_INTERLEAVED, true, true))
+                || (canUseMmap && trySetAccess (SND_PCM_ACCESS_MMAP_NONINTERLEAVED, false, true))
+                || trySetAccess (SND_PCM_ACCESS_RW_INTERLEAVED, true, false) // works better for plughw..
+                || trySetAccess (SND_PCM_ACCESS_RW_NONINTERLEAVED, false, false)))
         {
             jassertfalse;
             return false;
@@ -288,6 +308,7 @@ public:
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_threshold (handle, swParams, 0))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_size (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_start_threshold (handle, swParams, samplesPerPeriod))
+            || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_avail_min (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_stop_threshold (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params (handle, swParams)))
         {
@@ -303,14 +324,24 @@ public:
        #endif
 
         numChannelsRunning = numChannels;
+        bytesPerSample = bitDepth / 8;
+        mmapChannels.malloc (numChannels);
+
+        JUCE_ALSA_LOG ("access: " << (isMmap ? "mmap" : "read/write") << ", " << (isInterleaved ? "interleaved" : "non-interleaved"));
 
         return true;
     }
 
+    bool usesMmap() const noexcept     { return isMmap; }
+
     //==============================================================================
     bool writeToOutputDevice (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= outputChannelBuffer.getNumChannels());
+
+        if (isMmap)
+            return writeToMmapBuffer (outputChannelBuffer, numSamples);
+
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
@@ -318,8 +349,7 @@ public:
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
 
-            for (int i = 0; i < numChannelsRunning; ++i)
-                converter->convertSamples (scratch.getData(), i, data[i], 0, numSamples);
+            converter->interleaveSamples (scratch.getData(), reinterpret_cast<const void* const*> (data), numChannelsRunning, numSamples);
 
             numDone = snd_pcm_writei (handle, scratch.getData(), (snd_pcm_uframes_t) numSamples);
         }
@@ -349,6 +379,10 @@ public:
     bool readFromInputDevice (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
+
+        if (isMmap)
+            return readFromMmapBuffer (inputChannelBuffer, numSamples);
+
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
         if (isInterleaved)
@@ -371,8 +405,7 @@ public:
             if (num < numSamples)
                 JUCE_ALSA_LOG ("Did not read all samples: num: " << num << ", numSamples: " << numSamples);
 
-            for (int i = 0; i < numChannelsRunning; ++i)
-                converter->convertSamples (data[i], 0, scratch.getData(), i, numSamples);
+            converter->deinterleaveSamples (reinterpret_cast<void* const*> (data), scratch.getData(), numChannelsRunning, numSamples);
         }
         else
         {
@@ -407,10 +440,168 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMmap = false;
+    int bytesPerSample = 0;
     MemoryBlock scratch;
+    HeapBlock<float*> mmapChannels;
     std::unique_ptr<AudioData::Converter> converter;
 
+    //==============================================================================
+    bool writeToMmapBuffer (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
+    {
+        for (int numDone = 0; numDone < numSamples;)
+        {
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0, frames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (! beginMmapTransfer (areas, offset, frames))
+                return false;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+                mmapChannels[i] = outputChannelBuffer.getWritePointer (i, numDone);
+
+            if (isInterleaved)
+            {
+                converter->interleaveSamples (getMmapAddress (areas[0], offset),
+                                              reinterpret_cast<const void* const*> (mmapChannels.getData()),
+                                              numChannelsRunning, (int) frames);
+            }
+            else
+            {
+                for (int i = 0; i < numChannelsRunning; ++i)
+                    converter->convertSamples (getMmapAddress (areas[i], offset), mmapChannels[i], (int) frames);
+            }
+
+            if (! commitMmapTransfer (offset, frames))
+                return false;
+
+            // Unlike snd_pcm_writei(), committing doesn't start the stream by itself
+            if (snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                 && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+
+            numDone += (int) frames;
+        }
+
+        return true;
+    }
+
+    bool readFromMmapBuffer (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
+    {
+        for (int numDone = 0; numDone < numSamples;)
+        {
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0, frames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (! beginMmapTransfer (areas, offset, frames))
+                return false;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+                mmapChannels[i] = inputChannelBuffer.getWritePointer (i, numDone);
+
+            if (isInterleaved)
+            {
+                converter->deinterleaveSamples (reinterpret_cast<void* const*> (mmapChannels.getData()),
+                                                getMmapAddress (areas[0], offset),
+                                                numChannelsRunning, (int) frames);
+            }
+            else
+            {
+                for (int i = 0; i < numChannelsRunning; ++i)
+                    converter->convertSamples (mmapChannels[i], getMmapAddress (areas[i], offset), (int) frames);
+            }
+
+            if (! commitMmapTransfer (offset, frames))
+                return false;
+
+            numDone += (int) frames;
+        }
+
+        return true;
+    }
+
+    /*  Waits until some of the ring buffer can be read or written, and then asks for up
+        to the requested number of frames of it. This only waits for short periods at a
+        time, so that the thread can notice when it's being asked to stop.
+    */
+    bool beginMmapTransfer (const snd_pcm_channel_area_t*& areas, snd_pcm_uframes_t& offset, snd_pcm_uframes_t& frames)
+    {
+        while (! Thread::currentThreadShouldExit())
+        {
+            const auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recoverFrom ((int) avail))
+                    return false;
+
+                continue;
+            }
+
+            if (avail == 0)
+            {
+                // A capture stream has to be started before there'll be anything to read
+                if (snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                     && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                    return false;
+
+                const auto result = snd_pcm_wait (handle, 100);
+
+                if (result < 0 && ! recoverFrom (result))
+                    return false;
+
+                continue;
+            }
+
+            frames = jmin (frames, (snd_pcm_uframes_t) avail);
+            const auto result = snd_pcm_mmap_begin (handle, &areas, &offset, &frames);
+
+            if (result < 0)
+            {
+                if (! recoverFrom (result))
+                    return false;
+
+                continue;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool commitMmapTransfer (snd_pcm_uframes_t offset, snd_pcm_uframes_t frames)
+    {
+        const auto committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+        if (committed >= 0 && (snd_pcm_uframes_t) committed == frames)
+            return true;
+
+        return recoverFrom (committed < 0 ? (int) committed : -EPIPE);
+    }
+
+    bool recoverFrom (int errorNum)
+    {
+        if (errorNum == -EPIPE)
+        {
+            if (isInput)
+                overrunCount++;
+            else
+                underrunCount++;
+        }
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, errorNum, 1 /* silent */));
+    }
+
+    void* getMmapAddress (const snd_pcm_channel_area_t& area, snd_pcm_uframes_t offset) const noexcept
+    {
+        // The converters expect the samples to be packed, either one channel after another,
+        // or all the channels for a frame followed by the next frame
+        jassert (area.step == (unsigned int) (bytesPerSample * 8 * (isInterleaved ? numChannelsRunning : 1)));
+
+        return addBytesToPointer (area.addr, (area.first + offset * area.step) / 8);
+    }
+
     //==============================================================================
     template <class SampleType>
     struct ConverterHelper
@@ -618,7 +809,13 @@ public:
         if (outputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
             return;
 
-        startThread (Priority::high);
+        // The thread only waits on the device, so it can run in the real-time class and
+        // keep short periods going without having to compete with the rest of the system
+        Thread::RealtimeOptions options;
+        options.workDurationMs = (uint32_t) jmax (1, roundToInt (1000.0 * bufferSize / sampleRate));
+
+        if (! startRealtimeThread (options))
+            startThread (Priority::high);
 
         int count = 1000;
 
@@ -678,7 +875,8 @@ public:
         {
             if (inputDevice != nullptr && inputDevice->handle != nullptr)
             {
-                if (outputDevice == nullptr || outputDevice->handle == nullptr)
+                // In mmap mode, the read starts the stream and does its own waiting
+                if ((outputDevice == nullptr || outputDevice->handle == nullptr) && ! inputDevice->usesMmap())
                 {
                     JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
 
@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+static void* juce_libpipewireHandle = nullptr;
+
+static void* juce_loadPipeWireFunction (const char* const name)
+{
+    if (juce_libpipewireHandle == nullptr)
+        return nullptr;
+
+    return dlsym (juce_libpipewireHandle, name);
+}
+
+#define JUCE_DECL_PIPEWIRE_FUNCTION(return_type, fn_name, argument_types, arguments)  \
+  return_type fn_name argument_types                                                  \
+  {                                                                                   \
+      using ReturnType = return_type;                                                 \
+      typedef return_type (*fn_type) argument_types;                                  \
+      static fn_type fn = (fn_type) juce_loadPipeWireFunction (#fn_name);             \
+      jassert (fn != nullptr);                                                        \
+      return (fn != nullptr) ? ((*fn) arguments) : ReturnType();                      \
+  }
+
+#define JUCE_DECL_VOID_PIPEWIRE_FUNCTION(fn_name, argument_types, arguments)          \
+  void fn_name argument_types                                                         \
+  {                                                                                   \
+      typedef void (*fn_type) argument_types;                                         \
+      static fn_type fn = (fn_type) juce_loadPipeWireFunction (#fn_name);             \
+      jassert (fn != nullptr);                                                        \
+      if (fn != nullptr) (*fn) arguments;                                             \
+  }
+
+//==============================================================================
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_init, (int* argc, char*** argv), (argc, argv))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_thread_loop*, pw_thread_loop_new, (const char* name, const spa_dict* props), (name, props))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_destroy, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_thread_loop_start, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_stop, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_lock, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_unlock, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_loop*, pw_thread_loop_get_loop, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_properties*, pw_properties_new, (const char* key, ...), (key, nullptr))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_properties_set, (pw_properties* properties, const char* key, const char* value), (properties, key, value))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_filter*, pw_filter_new_simple, (pw_loop* loop, const char* name, pw_properties* props, const pw_filter_events* events, void* data), (loop, name, props, events, data))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_filter_destroy, (pw_filter* filter), (filter))
+JUCE_DECL_PIPEWIRE_FUNCTION (void*, pw_filter_add_port, (pw_filter* filter, pw_direction direction, pw_filter_port_flags flags, size_t port_data_size, pw_properties* props, const spa_pod** params, uint32_t n_params), (filter, direction, flags, port_data_size, props, params, n_params))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_filter_connect, (pw_filter* filter, pw_filter_flags flags, const spa_pod** params, uint32_t n_params), (filter, flags, params, n_params))
+JUCE_DECL_PIPEWIRE_FUNCTION (void*, pw_filter_get_dsp_buffer, (void* port_data, uint32_t n_samples), (port_data, n_samples))
+
+//==============================================================================
+#ifndef JUCE_PIPEWIRE_CLIENT_NAME
+ #ifdef JucePlugin_Name
+  #define JUCE_PIPEWIRE_CLIENT_NAME JucePlugin_Name
+ #else
+  #define JUCE_PIPEWIRE_CLIENT_NAME "JUCE"
+ #endif
+#endif
+
+//==============================================================================
+/*  A device that takes part in the PipeWire graph as a filter node, with one DSP port
+    for each of the active channels.
+
+    The graph calls the filter from PipeWire's own real-time data thread, once per
+    cycle, so there's no extra buffering between the device and the rest of the graph.
+    The filter asks for the block size and sample rate that were passed to open(),
+    but the graph's quantum can change while it's running, so each cycle is rendered
+    in as many blocks as it takes to cover it without exceeding the block size.
+*/
+class PipeWireAudioIODevice   : public AudioIODevice
+{
+public:
+    explicit PipeWireAudioIODevice (const String& deviceName)
+        : AudioIODevice (deviceName, "PipeWire")
+    {
+        threadLoop = juce::pw_thread_loop_new ("JUCE PipeWire", nullptr);
+
+        if (threadLoop == nullptr || juce::pw_thread_loop_start (threadLoop) < 0)
+            lastError = "Couldn't start the PipeWire thread loop";
+    }
+
+    ~PipeWireAudioIODevice() override
+    {
+        close();
+
+        if (threadLoop != nullptr)
+        {
+            juce::pw_thread_loop_stop (threadLoop);
+            juce::pw_thread_loop_destroy (threadLoop);
+        }
+    }
+
+    StringArray getOutputChannelNames() override     { return getChannelNames(); }
+    StringArray getInputChannelNames() override      { return getChannelNames(); }
+
+    Array<double> getAvailableSampleRates() override { return { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 }; }
+    Array<int> getAvailableBufferSizes() override    { return { 16, 32, 64, 128, 256, 512, 1024, 2048 }; }
+    int getDefaultBufferSize() override              { return 256; }
+
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double newSampleRate, int newBufferSize) override
+    {
+        close();
+
+        if (threadLoop == nullptr)
+            return lastError;
+
+        lastError.clear();
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 48000.0;
+        bufferSize = newBufferSize > 0 ? newBufferSize : getDefaultBufferSize();
+
+        activeInputChannels.clear();
+        activeOutputChannels.clear();
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            activeInputChannels .setBit (i, inputChannels[i]);
+            activeOutputChannels.setBit (i, outputChannels[i]);
+        }
+
+        const auto numIns  = activeInputChannels .countNumberOfSetBits();
+        const auto numOuts = activeOutputChannels.countNumberOfSetBits();
+
+        if (numIns + numOuts == 0)
+        {
+            lastError = "No channels";
+            return lastError;
+        }
+
+        inputScratch.setSize (numIns, bufferSize);
+        inputScratch.clear();
+        outputScratch.setSize (numOuts, bufferSize);
+        inputPortData.clearQuick();
+        outputPortData.clearQuick();
+        inChans.calloc (numIns + 1);
+        outChans.calloc (numOuts + 1);
+
+        const auto latency  = String (bufferSize) + "/" + String (roundToInt (sampleRate));
+        const auto rate     = "1/" + String (roundToInt (sampleRate));
+        const auto category = numIns == 0 ? "Playback" : (numOuts == 0 ? "Capture" : "Duplex");
+
+        auto* props = juce::pw_properties_new (nullptr);
+        juce::pw_properties_set (props, PW_KEY_MEDIA_TYPE, "Audio");
+        juce::pw_properties_set (props, PW_KEY_MEDIA_CATEGORY, category);
+        juce::pw_properties_set (props, PW_KEY_MEDIA_ROLE, "Production");
+        juce::pw_properties_set (props, PW_KEY_NODE_LATENCY, latency.toRawUTF8());
+        juce::pw_properties_set (props, "node.rate", rate.toRawUTF8());
+        juce::pw_properties_set (props, PW_KEY_NODE_AUTOCONNECT, "true");
+
+        filterEvents = {};
+        filterEvents.version = PW_VERSION_FILTER_EVENTS;
+        filterEvents.state_changed = stateChangedCallback;
+        filterEvents.process = processCallback;
+
+        juce::pw_thread_loop_lock (threadLoop);
+
+        filter = juce::pw_filter_new_simple (juce::pw_thread_loop_get_loop (threadLoop),
+                                             JUCE_PIPEWIRE_CLIENT_NAME, props, &filterEvents, this);
+
+        if (filter != nullptr)
+        {
+            for (int i = 0; i < numChannels; ++i)
+            {
+                if (activeInputChannels[i])
+                    inputPortData.add (addPort (PW_DIRECTION_INPUT, i));
+
+                if (activeOutputChannels[i])
+                    outputPortData.add (addPort (PW_DIRECTION_OUTPUT, i));
+            }
+
+            if (inputPortData.contains (nullptr) || outputPortData.contains (nullptr)
+                 || juce::pw_filter_connect (filter, PW_FILTER_FLAG_RT_PROCESS, nullptr, 0) < 0)
+            {
+                lastError = "Couldn't connect to the PipeWire graph";
+            }
+        }
+        else
+        {
+            lastError = "Couldn't create a PipeWire filter - is the PipeWire server running?";
+        }
+
+        juce::pw_thread_loop_unlock (threadLoop);
+
+        if (lastError.isNotEmpty())
+            close();
+        else
+            deviceIsOpen = true;
+
+        return lastError;
+    }
+
+    void close() override
+    {
+        stop();
+
+        if (filter != nullptr)
+        {
+            juce::pw_thread_loop_lock (threadLoop);
+            juce::pw_filter_destroy (filter);
+            juce::pw_thread_loop_unlock (threadLoop);
+            filter = nullptr;
+        }
+
+        deviceIsOpen = false;
+    }
+
+    void start (AudioIODeviceCallback* newCallback) override
+    {
+        if (deviceIsOpen && newCallback != callback)
+        {
+            if (newCallback != nullptr)
+                newCallback->audioDeviceAboutToStart (this);
+
+            AudioIODeviceCallback* const oldCallback = callback;
+
+            {
+                const ScopedLock sl (callbackLock);
+                callback = newCallback;
+            }
+
+            if (oldCallback != nullptr)
+                oldCallback->audioDeviceStopped();
+        }
+    }
+
+    void stop() override
+    {
+        start (nullptr);
+    }
+
+    bool isOpen() override                           { return deviceIsOpen; }
+    bool isPlaying() override                        { return callback != nullptr; }
+    String getLastError() override                   { return lastError; }
+
+    int getCurrentBufferSizeSamples() override       { return bufferSize; }
+    double getCurrentSampleRate() override           { return sampleRate; }
+    int getCurrentBitDepth() override                { return 32; }
+
+    BigInteger getActiveOutputChannels() const override  { return activeOutputChannels; }
+    BigInteger getActiveInputChannels()  const override  { return activeInputChannels; }
+
+    int getOutputLatencyInSamples() override         { return bufferSize; }
+    int getInputLatencyInSamples() override          { return bufferSize; }
+
+private:
+    //==============================================================================
+    // The first few channels are given the usual positions, so that the session
+    // manager can link them to the matching channels of the default devices
+    static constexpr int numChannels = 8;
+
+    static StringArray getChannelNames()
+    {
+        StringArray names;
+
+        for (int i = 0; i < numChannels; ++i)
+            names.add ("Channel " + String (i + 1));
+
+        return names;
+    }
+
+    static String getChannelPosition (int index)
+    {
+        static constexpr const char* positions[] { "FL", "FR", "FC", "LFE", "RL", "RR", "SL", "SR" };
+        static_assert (numElementsInArray (positions) == numChannels, "Every channel needs a position");
+
+        return positions[index];
+    }
+
+    void* addPort (pw_direction direction, int channel)
+    {
+        const auto isInput = direction == PW_DIRECTION_INPUT;
+        const auto portName = String (isInput ? "in_" : "out_") + String (channel + 1);
+
+        auto* props = juce::pw_properties_new (nullptr);
+        juce::pw_properties_set (props, PW_KEY_FORMAT_DSP, "32 bit float mono audio");
+        juce::pw_properties_set (props, PW_KEY_PORT_NAME, portName.toRawUTF8());
+        juce::pw_properties_set (props, PW_KEY_AUDIO_CHANNEL, getChannelPosition (channel).toRawUTF8());
+
+        return juce::pw_filter_add_port (filter, direction, PW_FILTER_PORT_FLAG_MAP_BUFFERS,
+                                         sizeof (void*), props, nullptr, 0);
+    }
+
+    //==============================================================================
+    void process (spa_io_position* position)
+    {
+        const auto numSamplesInCycle = position != nullptr ? (int) position->clock.duration : bufferSize;
+        const auto numIns  = inputPortData.size();
+        const auto numOuts = outputPortData.size();
+
+        // A port that isn't linked to anything doesn't have a buffer, so these
+        // are replaced with silence, or somewhere to write that's thrown away
+        const auto getBuffer = [numSamplesInCycle] (void* port) -> float*
+        {
+            return static_cast<float*> (juce::pw_filter_get_dsp_buffer (port, (uint32_t) numSamplesInCycle));
+        };
+
+        for (int i = 0; i < numIns; ++i)
+            inChans[i] = getBuffer (inputPortData.getUnchecked (i));
+
+        for (int i = 0; i < numOuts; ++i)
+            outChans[i] = getBuffer (outputPortData.getUnchecked (i));
+
+        const ScopedLock sl (callbackLock);
+
+        for (int start = 0; start < numSamplesInCycle; start += bufferSize)
+        {
+            const auto numSamples = jmin (bufferSize, numSamplesInCycle - start);
+
+            for (int i = 0; i < numIns; ++i)
+                blockIns[i]  = inChans[i] != nullptr ? inChans[i] + start : inputScratch.getReadPointer (i);
+
+            for (int i = 0; i < numOuts; ++i)
+                blockOuts[i] = outChans[i] != nullptr ? outChans[i] + start : outputScratch.getWritePointer (i);
+
+            if (callback != nullptr)
+            {
+                callback->audioDeviceIOCallbackWithContext (blockIns.getData(), numIns,
+                                                            blockOuts.getData(), numOuts,
+                                                            numSamples, {});
+            }
+            else
+            {
+                for (int i = 0; i < numOuts; ++i)
+                    zeromem (blockOuts[i], (size_t) numSamples * sizeof (float));
+            }
+        }
+    }
+
+    static void processCallback (void* data, spa_io_position* position)
+    {
+        static_cast<PipeWireAudioIODevice*> (data)->process (position);
+    }
+
+    static void stateChangedCallback (void* data, pw_filter_state, pw_filter_state state, const char* error)
+    {
+        if (state != PW_FILTER_STATE_ERROR)
+            return;
+
+        auto& device = *static_cast<PipeWireAudioIODevice*> (data);
+        const auto message = String ("PipeWire error: ") + (error != nullptr ? error : "unknown");
+
+        const ScopedLock sl (device.callbackLock);
+
+        if (device.callback != nullptr)
+            device.callback->audioDeviceError (message);
+    }
+
+    //==============================================================================
+    pw_thread_loop* threadLoop = nullptr;
+    pw_filter* filter = nullptr;
+    pw_filter_events filterEvents {};
+
+    bool deviceIsOpen = false;
+    String lastError;
+    double sampleRate = 0.0;
+    int bufferSize = 0;
+    BigInteger activeInputChannels, activeOutputChannels;
+
+    AudioIODeviceCallback* callback = nullptr;
+    CriticalSection callbackLock;
+
+    Array<void*> inputPortData, outputPortData;
+    HeapBlock<float*> inChans, outChans;
+    HeapBlock<const float*> blockIns { (size_t) numChannels + 1 };
+    HeapBlock<float*> blockOuts { (size_t) numChannels + 1 };
+    AudioBuffer<float> inputScratch, outputScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PipeWireAudioIODevice)
+};
+
+//==============================================================================
+class PipeWireAudioIODeviceType  : public AudioIODeviceType
+{
+public:
+    PipeWireAudioIODeviceType()
+        : AudioIODeviceType ("PipeWire")
+    {}
+
+    void scanForDevices() override
+    {
+        hasScanned = true;
+        deviceNames.clear();
+
+        if (juce_libpipewireHandle == nullptr)
+        {
+            juce_libpipewireHandle = dlopen ("libpipewire-0.3.so.0", RTLD_LAZY);
+
+            if (juce_libpipewireHandle == nullptr)
+                return;
+
+            juce::pw_init (nullptr, nullptr);
+        }
+
+        // The filter joins the graph that the session manager has set up, so there's
+        // just the one device, whose ports get linked to the default sink and source
+        deviceNames.add (defaultDeviceName);
+    }
+
+    StringArray getDeviceNames (bool) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+        return deviceNames;
+    }
+
+    int getDefaultDeviceIndex (bool) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+        return 0;
+    }
+
+    bool hasSeparateInputsAndOutputs() const override    { return false; }
+
+    int getIndexOfDevice (AudioIODevice* device, bool) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+
+        if (auto* d = dynamic_cast<PipeWireAudioIODevice*> (device))
+            return deviceNames.indexOf (d->getName());
+
+        return -1;
+    }
+
+    AudioIODevice* createDevice (const String& outputDeviceName,
+                                 const String& inputDeviceName) override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+
+        if (deviceNames.contains (outputDeviceName) || deviceNames.contains (inputDeviceName))
+            return new PipeWireAudioIODevice (defaultDeviceName);
+
+        return nullptr;
+    }
+
+private:
+    static constexpr const char* defaultDeviceName = "PipeWire Graph";
+
+    StringArray deviceNames;
+    bool hasScanned = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PipeWireAudioIODeviceType)
+};
+
+} // namespace juce
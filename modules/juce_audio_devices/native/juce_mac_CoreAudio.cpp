@@ -444,6 +444,27 @@ public:
                                                                 juceAudioObjectPropertyElementMain }, err2log()).value_or (0) != 0;
     }
 
+    AudioWorkgroup getWorkgroup() const
+    {
+       #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+        if (@available (macOS 11.0, *))
+        {
+            // The property holds a retained reference, which we must release
+            if (auto workgroup = audioObjectGetProperty<os_workgroup_t> (deviceID, { kAudioDevicePropertyIOThreadOSWorkgroup,
+                                                                                     kAudioObjectPropertyScopeGlobal,
+                                                                                     juceAudioObjectPropertyElementMain });
+                workgroup.has_value() && *workgroup != nullptr)
+            {
+                auto result = AudioWorkgroup::fromNativeHandle ((void*) *workgroup);
+                os_release (*workgroup);
+                return result;
+            }
+        }
+       #endif
+
+        return {};
+    }
+
     bool updateDetailsFromDevice (const BigInteger& activeIns, const BigInteger& activeOuts)
     {
         stopTimer();
@@ -1228,6 +1249,7 @@ public:
     int getCurrentBitDepth() override                   { return internal->bitDepth; }
     int getCurrentBufferSizeSamples() override          { return internal->getBufferSize(); }
     int getXRunCount() const noexcept override          { return internal->xruns; }
+    AudioWorkgroup getWorkgroup() const override        { return internal->getWorkgroup(); }
 
     int getIndexOfDevice (bool asInput) const           { return asInput ? inputIndex : outputIndex; }
 
@@ -480,12 +480,25 @@ public:
                 if (channels[i])
                     channelMaps.add (i);
 
+            // When every device channel is used in order, whole blocks can be converted
+            // in one pass instead of one channel at a time
+            allChannelsInOrder = channelMaps.size() == actualNumChannels
+                                  && (channelMaps.isEmpty() || channelMaps.getLast() == channelMaps.size() - 1);
+            channelPointers.malloc ((size_t) channelMaps.size());
+
             REFERENCE_TIME latency;
 
             if (check (client->GetStreamLatency (&latency)))
                 latencySamples = refTimeToSamples (latency, sampleRate);
 
             (void) check (client->GetBufferSize (&actualBufferSize));
+
+           #if JUCE_WASAPI_LOGGING
+            Logger::writeToLog ("WASAPI: opened " + getDeviceID (device) + " with a period of " + String (periodSamples)
+                                  + " samples, a buffer of " + String ((int) actualBufferSize)
+                                  + " samples and a stream latency of " + String (latencySamples) + " samples");
+           #endif
+
             createSessionEventCallback();
             return check (client->SetEventHandle (clientEvent));
         }
@@ -536,14 +549,17 @@ public:
     double sampleRate = 0, defaultSampleRate = 0;
     int numChannels = 0, actualNumChannels = 0, maxNumChannels = 0, defaultNumChannels = 0;
     int minBufferSize = 0, defaultBufferSize = 0, latencySamples = 0;
-    int lowLatencyBufferSizeMultiple = 0, lowLatencyMaxBufferSize = 0;
+    int lowLatencyBufferSizeMultiple = 0, lowLatencyMaxBufferSize = 0, periodSamples = 0;
     DWORD defaultFormatChannelMask = 0;
     Array<double> rates;
     HANDLE clientEvent = {};
     BigInteger channels;
     Array<int> channelMaps;
+    bool allChannelsInOrder = false;
+    HeapBlock<void*> channelPointers;
     UINT32 actualBufferSize = 0;
     int bytesPerSample = 0, bytesPerFrame = 0;
+    std::atomic<int> xruns { 0 };
     std::atomic<bool> sampleRateHasChanged { false }, shouldShutdown { false }, isActive { true };
 
     virtual void updateFormat (bool isFloat) = 0;
@@ -834,13 +850,43 @@ private:
         return streamFlags;
     }
 
+    // The engine only accepts periods that are a multiple of its fundamental period, within
+    // the limits that it reported
+    int getNearestLowLatencyPeriod (int bufferSizeSamples) const noexcept
+    {
+        if (bufferSizeSamples <= 0)
+            bufferSizeSamples = defaultBufferSize;
+
+        if (lowLatencyBufferSizeMultiple <= 0)
+            return bufferSizeSamples;
+
+        const auto maxPeriod = jmax (minBufferSize, lowLatencyMaxBufferSize);
+        const auto requested = jlimit (minBufferSize, maxPeriod, bufferSizeSamples);
+        const auto numSteps = (requested - minBufferSize + lowLatencyBufferSizeMultiple - 1) / lowLatencyBufferSizeMultiple;
+
+        return jmin (maxPeriod, minBufferSize + numSteps * lowLatencyBufferSizeMultiple);
+    }
+
     bool initialiseLowLatencyClient (int bufferSizeSamples, WAVEFORMATEXTENSIBLE format)
     {
         if (auto audioClient3 = client.getInterface<IAudioClient3>())
-            return check (audioClient3->InitializeSharedAudioStream (getStreamFlags(),
-                                                                     (UINT32) bufferSizeSamples,
-                                                                     (WAVEFORMATEX*) &format,
-                                                                     nullptr));
+        {
+            if (check (audioClient3->InitializeSharedAudioStream (getStreamFlags(),
+                                                                  (UINT32) getNearestLowLatencyPeriod (bufferSizeSamples),
+                                                                  (WAVEFORMATEX*) &format,
+                                                                  nullptr)))
+            {
+                // Another stream may already have fixed the engine's period, so ask what we actually got
+                WAVEFORMATEX* currentFormat = nullptr;
+                UINT32 currentPeriod = 0;
+
+                if (check (audioClient3->GetCurrentSharedModeEnginePeriod (&currentFormat, &currentPeriod)))
+                    periodSamples = (int) currentPeriod;
+
+                CoTaskMemFree (currentFormat);
+                return true;
+            }
+        }
 
         return false;
     }
@@ -866,7 +912,10 @@ private:
                                           &session);
 
             if (check (hr))
+            {
+                periodSamples = isExclusiveMode (deviceMode) ? refTimeToSamples (defaultPeriod, format.Format.nSamplesPerSec) : 0;
                 return true;
+            }
 
             // Handle the "alignment dance" : http://msdn.microsoft.com/en-us/library/windows/desktop/dd370875(v=vs.85).aspx (see Remarks)
             if (hr != MAKE_HRESULT (1, 0x889, 0x19)) // AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED
@@ -889,10 +938,21 @@ private:
     bool tryInitialisingWithBufferSize (int bufferSizeSamples)
     {
 
+        periodSamples = 0;
+
         if (auto format = findSupportedFormat (client, numChannels, sampleRate))
         {
-            auto isInitialised = isLowLatencyMode (deviceMode) ? initialiseLowLatencyClient (bufferSizeSamples, *format)
-                                                               : initialiseStandardClient   (bufferSizeSamples, *format);
+            auto isInitialised = isLowLatencyMode (deviceMode) && initialiseLowLatencyClient (bufferSizeSamples, *format);
+
+            if (! isInitialised)
+            {
+                // Before Windows 10 there's no IAudioClient3, so the low-latency mode falls back to
+                // an ordinary shared stream
+                if (isLowLatencyMode (deviceMode))
+                    client = createClient();
+
+                isInitialised = client != nullptr && initialiseStandardClient (bufferSizeSamples, *format);
+            }
 
             if (isInitialised)
             {
@@ -963,7 +1023,6 @@ public:
 
         queue = SingleThreadedAbstractFifo (reservoirSize);
         reservoir.setSize ((size_t) (queue.getSize() * bytesPerFrame), true);
-        xruns = 0;
 
         if (! check (client->Start()))
             return false;
@@ -986,24 +1045,47 @@ public:
 
     int getNumSamplesInReservoir() const noexcept    { return queue.getNumReadable(); }
 
-    void handleDeviceBuffer()
+    // Collects the audio that the device has captured. If some destination buffers are supplied,
+    // the reservoir is empty, and the first packet holds exactly one block of audio, which is what
+    // happens in the event-driven modes, then that packet is converted straight into the destination
+    // rather than going through the reservoir, and this returns true.
+    bool handleDeviceBuffer (float* const* destBuffers = nullptr, int numDestBuffers = 0, int bufferSize = 0)
     {
         if (numChannels <= 0)
-            return;
+            return false;
 
         uint8* inputData = nullptr;
         UINT32 numSamplesAvailable = 0;
         DWORD flags = 0;
+        bool readDirectly = false;
 
         while (check (captureClient->GetBuffer (&inputData, &numSamplesAvailable, &flags, nullptr, nullptr)) && numSamplesAvailable > 0)
         {
             if ((flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) != 0)
                 xruns++;
 
+            if (destBuffers != nullptr && ! readDirectly
+                 && queue.getNumReadable() == 0 && (int) numSamplesAvailable == bufferSize)
+            {
+                if ((flags & AUDCLNT_BUFFERFLAGS_SILENT) != 0)
+                {
+                    for (int i = 0; i < numDestBuffers; ++i)
+                        zeromem (destBuffers[i], (size_t) bufferSize * sizeof (float));
+                }
+                else
+                {
+                    convertFromDevice (destBuffers, numDestBuffers, 0, inputData, bufferSize);
+                }
+
+                captureClient->ReleaseBuffer (numSamplesAvailable);
+                readDirectly = true;
+                continue;
+            }
+
             if (numSamplesAvailable > (UINT32) queue.getRemainingSpace())
             {
                 captureClient->ReleaseBuffer (0);
-                return;
+                return readDirectly;
             }
 
             auto offset = 0;
@@ -1024,6 +1106,8 @@ public:
 
             captureClient->ReleaseBuffer (numSamplesAvailable);
         }
+
+        return readDirectly;
     }
 
     void copyBuffersFromReservoir (float* const* destBuffers, const int numDestBuffers, const int bufferSize)
@@ -1038,22 +1122,39 @@ public:
                 zeromem (destBuffers[i], (size_t) offset * sizeof (float));
 
         for (const auto& block : queue.read (jmin (queue.getNumReadable(), bufferSize)))
+        {
+            convertFromDevice (destBuffers, numDestBuffers, offset,
+                               addBytesToPointer (reservoir.getData(), block.getStart() * bytesPerFrame),
+                               block.getLength());
+
+            offset += block.getLength();
+        }
+    }
+
+    void convertFromDevice (float* const* destBuffers, int numDestBuffers, int destOffset,
+                            const void* source, int numSamples)
+    {
+        if (allChannelsInOrder && numDestBuffers == actualNumChannels)
+        {
+            for (auto i = 0; i < numDestBuffers; ++i)
+                channelPointers[i] = destBuffers[i] + destOffset;
+
+            converter->deinterleaveSamples (channelPointers, source, numDestBuffers, numSamples);
+        }
+        else
         {
             for (auto i = 0; i < numDestBuffers; ++i)
-                converter->convertSamples (destBuffers[i] + offset,
+                converter->convertSamples (destBuffers[i] + destOffset,
                                            0,
-                                           addBytesToPointer (reservoir.getData(), block.getStart() * bytesPerFrame),
+                                           source,
                                            channelMaps.getUnchecked (i),
-                                           block.getLength());
-
-            offset += block.getLength();
+                                           numSamples);
         }
     }
 
     ComSmartPtr<IAudioCaptureClient> captureClient;
     MemoryBlock reservoir;
     SingleThreadedAbstractFifo queue;
-    int xruns = 0;
 
     std::unique_ptr<AudioData::Converter> converter;
 
@@ -1115,10 +1216,21 @@ public:
             return false;
 
         isActive = true;
+        hasWrittenBlock = false;
 
         return true;
     }
 
+    // In shared mode, the endpoint buffer can be several periods long. When the engine period is known,
+    // only two periods are kept queued, as filling the whole buffer would add all of it to the latency.
+    int getMaxNumQueuedSamples() const noexcept
+    {
+        if (! isExclusiveMode (deviceMode) && periodSamples > 0)
+            return jmin ((int) actualBufferSize, 2 * periodSamples);
+
+        return (int) actualBufferSize;
+    }
+
     int getNumSamplesAvailableToCopy() const
     {
         if (numChannels <= 0)
@@ -1129,7 +1241,7 @@ public:
             UINT32 padding = 0;
 
             if (check (client->GetCurrentPadding (&padding)))
-                return (int) actualBufferSize - (int) padding;
+                return jmax (0, getMaxNumQueuedSamples() - (int) padding);
         }
 
         return (int) actualBufferSize;
@@ -1150,7 +1262,14 @@ public:
                   && WaitForSingleObject (inputDevice->clientEvent, 0) == WAIT_OBJECT_0)
                 inputDevice->handleDeviceBuffer();
 
-            int samplesToDo = jmin (getNumSamplesAvailableToCopy(), bufferSize);
+            const auto numAvailable = getNumSamplesAvailableToCopy();
+            int samplesToDo = jmin (numAvailable, bufferSize);
+
+            // In shared mode, finding nothing left in the queue means that the engine ran out of audio,
+            // unless the queue is too short to hold more than one period or block anyway
+            if (! isExclusiveMode (deviceMode) && hasWrittenBlock && offset == 0
+                 && numAvailable == getMaxNumQueuedSamples() && getMaxNumQueuedSamples() > jmax (periodSamples, bufferSize))
+                ++xruns;
 
             if (samplesToDo == 0)
             {
@@ -1158,17 +1277,31 @@ public:
                 if (! thread.threadShouldExit() && WaitForSingleObject (clientEvent, 1000) == WAIT_OBJECT_0)
                     continue;
 
+                ++xruns;
                 break;
             }
 
             if (isExclusiveMode (deviceMode) && WaitForSingleObject (clientEvent, 1000) == WAIT_TIMEOUT)
+            {
+                ++xruns;
                 break;
+            }
 
             uint8* outputData = nullptr;
             if (check (renderClient->GetBuffer ((UINT32) samplesToDo, &outputData)))
             {
-                for (int i = 0; i < numSrcBuffers; ++i)
-                    converter->convertSamples (outputData, channelMaps.getUnchecked(i), srcBuffers[i] + offset, 0, samplesToDo);
+                if (allChannelsInOrder && numSrcBuffers == actualNumChannels)
+                {
+                    for (int i = 0; i < numSrcBuffers; ++i)
+                        channelPointers[i] = const_cast<float*> (srcBuffers[i] + offset);
+
+                    converter->interleaveSamples (outputData, channelPointers, numSrcBuffers, samplesToDo);
+                }
+                else
+                {
+                    for (int i = 0; i < numSrcBuffers; ++i)
+                        converter->convertSamples (outputData, channelMaps.getUnchecked(i), srcBuffers[i] + offset, 0, samplesToDo);
+                }
 
                 renderClient->ReleaseBuffer ((UINT32) samplesToDo, 0);
             }
@@ -1176,10 +1309,13 @@ public:
             bufferSize -= samplesToDo;
             offset += samplesToDo;
         }
+
+        hasWrittenBlock = true;
     }
 
     ComSmartPtr<IAudioRenderClient> renderClient;
     std::unique_ptr<AudioData::Converter> converter;
+    bool hasWrittenBlock = false;
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WASAPIOutputDevice)
@@ -1334,7 +1470,14 @@ public:
     BigInteger getActiveOutputChannels() const override     { return outputDevice != nullptr ? outputDevice->channels : BigInteger(); }
     BigInteger getActiveInputChannels() const override      { return inputDevice  != nullptr ? inputDevice->channels  : BigInteger(); }
     String getLastError() override                          { return lastError; }
-    int getXRunCount() const noexcept override              { return inputDevice != nullptr ? inputDevice->xruns : -1; }
+    int getXRunCount() const noexcept override
+    {
+        if (inputDevice == nullptr && outputDevice == nullptr)
+            return -1;
+
+        return (inputDevice  != nullptr ? inputDevice ->xruns.load() : 0)
+             + (outputDevice != nullptr ? outputDevice->xruns.load() : 0);
+    }
 
     String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
                  double sampleRate, int bufferSizeSamples) override
@@ -1379,6 +1522,16 @@ public:
             currentBufferSizeSamples = (int) (outputDevice != nullptr ? outputDevice->actualBufferSize
                                                                       : inputDevice->actualBufferSize);
         }
+        else if (isLowLatencyMode (deviceMode))
+        {
+            // Running the callback once per engine period is what keeps the latency down
+            const auto period = outputDevice != nullptr && outputDevice->periodSamples > 0 ? outputDevice->periodSamples
+                              : inputDevice  != nullptr && inputDevice ->periodSamples > 0 ? inputDevice ->periodSamples
+                                                                                           : 0;
+
+            if (period > 0)
+                currentBufferSizeSamples = period;
+        }
 
         if (inputDevice != nullptr)   ResetEvent (inputDevice->clientEvent);
         if (outputDevice != nullptr)  ResetEvent (outputDevice->clientEvent);
@@ -1403,7 +1556,9 @@ public:
 
         if (outputDevice != nullptr && outputDevice->client != nullptr)
         {
-            latencyOut = (int) (outputDevice->latencySamples + currentBufferSizeSamples);
+            // In shared mode the queue is kept topped up, so that's how much is waiting to be played
+            latencyOut = (int) (outputDevice->latencySamples + (isExclusiveMode (deviceMode) ? currentBufferSizeSamples
+                                                                                             : jmax (currentBufferSizeSamples, outputDevice->getMaxNumQueuedSamples())));
 
             if (! outputDevice->start())
             {
@@ -1471,24 +1626,48 @@ public:
         }
     }
 
-    void setMMThreadPriority()
+    // Registers the calling thread with MMCSS as a "Pro Audio" task for as long as this object
+    // exists. avrt.dll has to stay loaded until the registration has been reverted.
+    class MMCSSRegistration
     {
-        DynamicLibrary dll ("avrt.dll");
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
-
-        if (avSetMmThreadCharacteristics != nullptr && avSetMmThreadPriority != nullptr)
+    public:
+        explicit MMCSSRegistration (AVRT_PRIORITY priority)
         {
-            DWORD dummy = 0;
+            JUCE_LOAD_WINAPI_FUNCTION (avrt, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+            JUCE_LOAD_WINAPI_FUNCTION (avrt, AvSetMmThreadPriority, avSetMmThreadPriority, BOOL, (HANDLE, AVRT_PRIORITY))
+            avRevertMmThreadCharacteristics = (RevertFunction) avrt.getFunction ("AvRevertMmThreadCharacteristics");
+
+            if (avSetMmThreadCharacteristics == nullptr || avSetMmThreadPriority == nullptr)
+                return;
 
-            if (auto h = avSetMmThreadCharacteristics (L"Pro Audio", &dummy))
-                avSetMmThreadPriority (h, AVRT_PRIORITY_NORMAL);
+            DWORD taskIndex = 0;
+            handle = avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex);
+
+            if (handle != nullptr)
+                avSetMmThreadPriority (handle, priority);
+        }
+
+        ~MMCSSRegistration()
+        {
+            if (handle != nullptr && avRevertMmThreadCharacteristics != nullptr)
+                avRevertMmThreadCharacteristics (handle);
         }
-    }
+
+    private:
+        using RevertFunction = BOOL (WINAPI*) (HANDLE);
+
+        DynamicLibrary avrt { "avrt.dll" };
+        RevertFunction avRevertMmThreadCharacteristics = nullptr;
+        HANDLE handle = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (MMCSSRegistration)
+    };
 
     void run() override
     {
-        setMMThreadPriority();
+        // The event-driven modes have much less slack, so they get a higher priority within the task
+        const MMCSSRegistration mmcss (isExclusiveMode (deviceMode) || isLowLatencyMode (deviceMode) ? AVRT_PRIORITY_HIGH
+                                                                                                     : AVRT_PRIORITY_NORMAL);
 
         auto bufferSize        = currentBufferSizeSamples;
         auto numInputBuffers   = getActiveInputChannels().countNumberOfSetBits();
@@ -1520,23 +1699,26 @@ public:
 
             if (inputDeviceActive)
             {
+                auto inputWasReadDirectly = false;
+
                 if (outputDevice == nullptr)
                 {
                     if (WaitForSingleObject (inputDevice->clientEvent, 1000) == WAIT_TIMEOUT)
                         break;
 
-                    inputDevice->handleDeviceBuffer();
+                    inputWasReadDirectly = inputDevice->handleDeviceBuffer (inputBuffers, numInputBuffers, bufferSize);
 
-                    if (inputDevice->getNumSamplesInReservoir() < bufferSize)
+                    if (! inputWasReadDirectly && inputDevice->getNumSamplesInReservoir() < bufferSize)
                         continue;
                 }
                 else
                 {
                     if (isExclusiveMode (deviceMode) && WaitForSingleObject (inputDevice->clientEvent, 0) == WAIT_OBJECT_0)
-                        inputDevice->handleDeviceBuffer();
+                        inputWasReadDirectly = inputDevice->handleDeviceBuffer (inputBuffers, numInputBuffers, bufferSize);
                 }
 
-                inputDevice->copyBuffersFromReservoir (inputBuffers, numInputBuffers, bufferSize);
+                if (! inputWasReadDirectly)
+                    inputDevice->copyBuffersFromReservoir (inputBuffers, numInputBuffers, bufferSize);
 
                 if (inputDevice->sampleRateHasChanged)
                 {
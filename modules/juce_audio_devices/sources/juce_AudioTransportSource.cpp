@@ -36,6 +36,23 @@ AudioTransportSource::~AudioTransportSource()
 void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
                                       int readAheadSize, TimeSliceThread* readAheadThread,
                                       double sourceSampleRateToCorrectFor, int maxNumChannels)
+{
+    setSourceInternal (newSource, readAheadSize, readAheadThread, nullptr,
+                       sourceSampleRateToCorrectFor, maxNumChannels);
+}
+
+void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
+                                      AudioStreamingEngine& readAheadEngine,
+                                      double sourceSampleRateToCorrectFor, int maxNumChannels)
+{
+    setSourceInternal (newSource, 0, nullptr, &readAheadEngine,
+                       sourceSampleRateToCorrectFor, maxNumChannels);
+}
+
+void AudioTransportSource::setSourceInternal (PositionableAudioSource* const newSource,
+                                              int readAheadSize, TimeSliceThread* readAheadThread,
+                                              AudioStreamingEngine* readAheadEngine,
+                                              double sourceSampleRateToCorrectFor, int maxNumChannels)
 {
     if (source == newSource)
     {
@@ -58,7 +75,13 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     {
         newPositionableSource = newSource;
 
-        if (readAheadSize > 0)
+        if (readAheadEngine != nullptr)
+        {
+            newPositionableSource = newBufferingSource
+                = new BufferingAudioSource (newPositionableSource, *readAheadEngine,
+                                            false, maxNumChannels);
+        }
+        else if (readAheadSize > 0)
         {
             // If you want to use a read-ahead buffer, you must also provide a TimeSliceThread
             // for it to use!
@@ -81,6 +81,19 @@ public:
                     double sourceSampleRateToCorrectFor = 0.0,
                     int maxNumChannels = 2);
 
+    /** Sets the source, reading ahead from it with an AudioStreamingEngine.
+
+        This works like the other setSource() method, but the read-ahead buffer is managed
+        by the engine, which chooses its size. The engine must not be deleted while this
+        transport source is still using it.
+
+        @see AudioStreamingEngine
+    */
+    void setSource (PositionableAudioSource* newSource,
+                    AudioStreamingEngine& readAheadEngine,
+                    double sourceSampleRateToCorrectFor = 0.0,
+                    int maxNumChannels = 2);
+
     //==============================================================================
     /** Changes the current playback position in the source stream.
 
@@ -173,6 +186,8 @@ private:
     bool isPrepared = false;
 
     void releaseMasterResources();
+    void setSourceInternal (PositionableAudioSource*, int readAheadSize, TimeSliceThread*,
+                            AudioStreamingEngine*, double sourceSampleRateToCorrectFor, int maxNumChannels);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
 };
@@ -927,17 +927,12 @@ private:
     const bool littleEndian;
 
     template <typename SampleType>
-    void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const noexcept
+    void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const
     {
-        for (int i = 0; i < numChannelsToRead; ++i)
-            results[i] = scanMinAndMaxForChannel<SampleType> (i, startSampleInFile, numSamples);
-    }
-
-    template <typename SampleType>
-    Range<float> scanMinAndMaxForChannel (int channel, int64 startSampleInFile, int64 numSamples) const noexcept
-    {
-        return littleEndian ? scanMinAndMaxInterleaved<SampleType, AudioData::LittleEndian> (channel, startSampleInFile, numSamples)
-                            : scanMinAndMaxInterleaved<SampleType, AudioData::BigEndian>    (channel, startSampleInFile, numSamples);
+        if (littleEndian)
+            scanMinAndMaxInterleaved<SampleType, AudioData::LittleEndian> (startSampleInFile, numSamples, results, numChannelsToRead);
+        else
+            scanMinAndMaxInterleaved<SampleType, AudioData::BigEndian>    (startSampleInFile, numSamples, results, numChannelsToRead);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedAiffReader)
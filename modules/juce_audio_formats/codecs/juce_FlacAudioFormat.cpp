@@ -393,17 +393,7 @@ public:
           streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        configureEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
@@ -427,6 +417,22 @@ public:
         FlacNamespace::FLAC__stream_encoder_delete (encoder);
     }
 
+    //==============================================================================
+    static void configureEncoder (FlacNamespace::FLAC__StreamEncoder* encoderToConfigure,
+                                  uint32 numChans, uint32 bits, double rate, int qualityOptionIndex)
+    {
+        if (qualityOptionIndex > 0)
+            FLAC__stream_encoder_set_compression_level (encoderToConfigure, (uint32) jmin (8, qualityOptionIndex));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (encoderToConfigure, numChans == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (encoderToConfigure, numChans == 2);
+        FLAC__stream_encoder_set_channels (encoderToConfigure, numChans);
+        FLAC__stream_encoder_set_bits_per_sample (encoderToConfigure, jmin ((unsigned int) 24, bits));
+        FLAC__stream_encoder_set_sample_rate (encoderToConfigure, (unsigned int) rate);
+        FLAC__stream_encoder_set_blocksize (encoderToConfigure, 0);
+        FLAC__stream_encoder_set_do_escape_coding (encoderToConfigure, true);
+    }
+
     //==============================================================================
     bool write (const int** samplesToWrite, int numSamples) override
     {
@@ -477,9 +483,14 @@ public:
     }
 
     void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    {
+        writeStreamInfo (*output, streamStartPos, metadata->data.stream_info);
+    }
+
+    static void writeStreamInfo (OutputStream& output, int64 streamStartPos,
+                                 const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
 
         unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
@@ -496,14 +507,14 @@ public:
         packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
         memcpy (buffer + 18, info.md5sum, 16);
 
-        [[maybe_unused]] const bool seekOk = output->setPosition (streamStartPos + 4);
+        [[maybe_unused]] const bool seekOk = output.setPosition (streamStartPos + 4);
 
         // if this fails, you've given it an output stream that can't seek! It needs
         // to be able to seek back to write the header
         jassert (seekOk);
 
-        output->writeIntBigEndian (FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
-        output->write (buffer, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        output.writeIntBigEndian (FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        output.write (buffer, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
     }
 
     //==============================================================================
@@ -547,6 +558,532 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
+//==============================================================================
+/*  FLAC frames don't depend on each other, so a long stream can be cut into
+    segments that are each encoded by their own encoder on a separate thread.
+    The only thing that ties a frame to its position in the stream is the frame
+    number in its header, so when the segments are written out in order, each
+    frame header gets renumbered and its checksums are recalculated.
+*/
+struct FlacFrameRenumbering
+{
+    static uint8 crc8 (const uint8* data, size_t size) noexcept
+    {
+        static const auto table = makeTable<uint8> (0x07, 8);
+
+        uint8 crc = 0;
+
+        for (size_t i = 0; i < size; ++i)
+            crc = table[crc ^ data[i]];
+
+        return crc;
+    }
+
+    static uint16 crc16 (const uint8* data, size_t size) noexcept
+    {
+        static const auto table = makeTable<uint16> (0x8005, 16);
+
+        uint16 crc = 0;
+
+        for (size_t i = 0; i < size; ++i)
+            crc = (uint16) ((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+
+        return crc;
+    }
+
+    /** Appends a copy of a frame to dest, with its frame number replaced. */
+    static bool appendRenumberedFrame (const uint8* frame, size_t size, uint32 newFrameNumber, std::vector<uint8>& dest)
+    {
+        // The fixed part of the header is 4 bytes, followed by the coded frame number
+        if (size < 8 || frame[0] != 0xff || (frame[1] & 0xfe) != 0xf8)
+            return false;
+
+        const auto numberLength = getCodedNumberLength (frame[4]);
+
+        if (numberLength == 0)
+            return false;
+
+        const auto blockSizeCode = frame[2] >> 4;
+        const auto sampleRateCode = frame[2] & 0x0f;
+
+        const auto extraLength = (size_t) (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                               + (size_t) (sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0));
+
+        const auto oldHeaderLength = 4 + numberLength + extraLength;
+
+        if (oldHeaderLength + 3 > size)
+            return false;
+
+        const auto start = dest.size();
+        dest.insert (dest.end(), frame, frame + 4);
+        appendCodedNumber (newFrameNumber, dest);
+        dest.insert (dest.end(), frame + 4 + numberLength, frame + oldHeaderLength);
+        dest.push_back (crc8 (dest.data() + start, dest.size() - start));
+
+        // Everything after the old header's CRC-8, except the old CRC-16 at the end
+        dest.insert (dest.end(), frame + oldHeaderLength + 1, frame + size - 2);
+
+        const auto crc = crc16 (dest.data() + start, dest.size() - start);
+        dest.push_back ((uint8) (crc >> 8));
+        dest.push_back ((uint8) crc);
+        return true;
+    }
+
+private:
+    template <typename Type>
+    static std::array<Type, 256> makeTable (uint32 polynomial, int numBits)
+    {
+        std::array<Type, 256> table;
+        const auto topBit = (uint32) 1 << (numBits - 1);
+        const auto mask = (uint32) ((1 << numBits) - 1);
+
+        for (uint32 i = 0; i < 256; ++i)
+        {
+            auto value = i << (numBits - 8);
+
+            for (int bit = 0; bit < 8; ++bit)
+                value = ((value & topBit) != 0 ? (value << 1) ^ polynomial : value << 1) & mask;
+
+            table[i] = (Type) value;
+        }
+
+        return table;
+    }
+
+    static size_t getCodedNumberLength (uint8 firstByte) noexcept
+    {
+        if ((firstByte & 0x80) == 0)  return 1;
+
+        for (size_t length = 2; length <= 6; ++length)
+        {
+            const auto prefixMask = (uint8) (0xff << (7 - length));
+            const auto prefix = (uint8) (0xff << (8 - length));
+
+            if ((firstByte & prefixMask) == prefix)
+                return length;
+        }
+
+        return 0;
+    }
+
+    static void appendCodedNumber (uint32 value, std::vector<uint8>& dest)
+    {
+        if (value < 0x80)
+        {
+            dest.push_back ((uint8) value);
+            return;
+        }
+
+        size_t numContinuationBytes = 1;
+
+        while (numContinuationBytes < 5 && value >= ((uint32) 1 << (5 * numContinuationBytes + 6)))
+            ++numContinuationBytes;
+
+        const auto prefix = (uint8) (0xff << (7 - numContinuationBytes));
+        dest.push_back ((uint8) (prefix | (value >> (6 * numContinuationBytes))));
+
+        for (auto i = numContinuationBytes; i > 0; --i)
+            dest.push_back ((uint8) (0x80 | ((value >> (6 * (i - 1))) & 0x3f)));
+    }
+};
+
+//==============================================================================
+class ParallelFlacWriter  : public AudioFormatWriter
+{
+public:
+    ParallelFlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int quality, int numThreads)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          qualityOptionIndex (quality),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          maxSegmentsInFlight (2 * (size_t) jmax (1, numThreads)),
+          pool (jmax (1, numThreads))
+    {
+        // Initialise a throwaway encoder to check the settings and find out which
+        // block size the chosen compression level uses
+        auto* probe = FlacNamespace::FLAC__stream_encoder_new();
+        FlacWriter::configureEncoder (probe, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+
+        ok = FLAC__stream_encoder_init_stream (probe, discardCallback, nullptr, nullptr, nullptr, nullptr)
+                == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+        if (ok)
+        {
+            blockSize = (int) FLAC__stream_encoder_get_blocksize (probe);
+            FlacNamespace::FLAC__stream_encoder_finish (probe);
+        }
+
+        FlacNamespace::FLAC__stream_encoder_delete (probe);
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        FlacNamespace::FLAC__MD5Init (&md5);
+       #endif
+    }
+
+    ~ParallelFlacWriter() override
+    {
+        if (ok)
+        {
+            if (current != nullptr || (nextFrameNumber == 0 && pending.empty()))
+                startEncodingCurrentSegment();
+
+            writeFinishedSegments (true);
+
+            FlacNamespace::FLAC__StreamMetadata_StreamInfo info {};
+            info.min_blocksize = (uint32) blockSize;
+            info.max_blocksize = (uint32) blockSize;
+            info.min_framesize = minFrameSize;
+            info.max_framesize = maxFrameSize;
+            info.sample_rate = (uint32) sampleRate;
+            info.channels = numChannels;
+            info.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+            info.total_samples = (FlacNamespace::FLAC__uint64) totalSamples;
+
+           #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+            FlacNamespace::FLAC__MD5Final (info.md5sum, &md5);
+           #endif
+
+            if (! writeFailed)
+                FlacWriter::writeStreamInfo (*output, streamStartPos, info);
+
+            output->flush();
+        }
+        else
+        {
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+        }
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok || writeFailed)
+            return false;
+
+        const auto bitsToShift = 32 - (int) jmin ((unsigned int) 24, bitsPerSample);
+
+        for (int done = 0; done < numSamples;)
+        {
+            if (current == nullptr)
+                current = std::make_unique<Segment> ((int) numChannels, blockSize * framesPerSegment);
+
+            const auto numToCopy = jmin (numSamples - done, current->capacity - current->numSamples);
+
+            for (int ch = 0; ch < (int) numChannels; ++ch)
+            {
+                auto* dest = current->getChannel (ch) + current->numSamples;
+
+                if (auto* src = samplesToWrite[ch])
+                {
+                    for (int i = 0; i < numToCopy; ++i)
+                        dest[i] = src[done + i] >> bitsToShift;
+                }
+                else
+                {
+                    zeromem (dest, sizeof (int) * (size_t) numToCopy);
+                }
+            }
+
+           #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+            HeapBlock<const FlacNamespace::FLAC__int32*> channels (numChannels);
+
+            for (int ch = 0; ch < (int) numChannels; ++ch)
+                channels[ch] = current->getChannel (ch) + current->numSamples;
+
+            FlacNamespace::FLAC__MD5Accumulate (&md5, channels, numChannels, (uint32) numToCopy,
+                                                (jmin ((unsigned int) 24, bitsPerSample) + 7) / 8);
+           #endif
+
+            current->numSamples += numToCopy;
+            done += numToCopy;
+
+            if (current->numSamples == current->capacity)
+                startEncodingCurrentSegment();
+        }
+
+        return ! writeFailed;
+    }
+
+private:
+    //==============================================================================
+    struct Segment
+    {
+        Segment (int numChans, int maxSamples)
+            : samples ((size_t) (numChans * maxSamples)), capacity (maxSamples)
+        {}
+
+        int* getChannel (int channel) noexcept      { return samples.data() + (size_t) (channel * capacity); }
+
+        std::vector<int> samples;
+        int capacity, numSamples = 0;
+
+        std::vector<uint8> header, frames;
+        std::vector<size_t> frameSizes;
+        std::atomic<bool> finished { false };
+        bool failed = false;
+    };
+
+    void startEncodingCurrentSegment()
+    {
+        if (current == nullptr)
+            current = std::make_unique<Segment> ((int) numChannels, 0);
+
+        auto* segment = current.get();
+        pending.push_back (std::move (current));
+
+        pool.addJob ([this, segment]
+        {
+            encode (*segment);
+            segment->finished = true;
+            segmentFinished.signal();
+        });
+
+        writeFinishedSegments (false);
+
+        while (pending.size() > maxSegmentsInFlight)
+        {
+            segmentFinished.wait (100);
+            writeFinishedSegments (false);
+        }
+    }
+
+    void encode (Segment& segment) const
+    {
+        auto* encoder = FlacNamespace::FLAC__stream_encoder_new();
+        FlacWriter::configureEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+        FLAC__stream_encoder_set_blocksize (encoder, (uint32) blockSize);
+        FLAC__stream_encoder_set_do_md5 (encoder, false);
+
+        HeapBlock<const FlacNamespace::FLAC__int32*> channels (numChannels);
+
+        for (int ch = 0; ch < (int) numChannels; ++ch)
+            channels[ch] = segment.getChannel (ch);
+
+        segment.failed = FLAC__stream_encoder_init_stream (encoder, segmentWriteCallback, nullptr, nullptr, nullptr, &segment)
+                            != FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                      || (segment.numSamples > 0
+                            && ! FLAC__stream_encoder_process (encoder, channels, (uint32) segment.numSamples));
+
+        if (! FlacNamespace::FLAC__stream_encoder_finish (encoder))
+            segment.failed = true;
+
+        FlacNamespace::FLAC__stream_encoder_delete (encoder);
+
+        // The sample data isn't needed any more, so free it while the segment waits its turn
+        std::vector<int>().swap (segment.samples);
+    }
+
+    void writeFinishedSegments (bool waitForAll)
+    {
+        while (! pending.empty())
+        {
+            auto& segment = *pending.front();
+
+            if (! segment.finished)
+            {
+                if (! waitForAll)
+                    return;
+
+                segmentFinished.wait (100);
+                continue;
+            }
+
+            if (segment.failed)
+                writeFailed = true;
+
+            if (! writeFailed)
+            {
+                // Only the first segment's header goes into the stream, and the
+                // STREAMINFO in it gets rewritten once all the frames are known
+                if (nextFrameNumber == 0 && totalSamples == 0)
+                    writeFailed = ! output->write (segment.header.data(), segment.header.size());
+
+                std::vector<uint8> renumbered;
+                renumbered.reserve (segment.frames.size() + 16 * segment.frameSizes.size());
+                size_t offset = 0;
+
+                for (auto size : segment.frameSizes)
+                {
+                    const auto start = renumbered.size();
+
+                    if (! FlacFrameRenumbering::appendRenumberedFrame (segment.frames.data() + offset, size,
+                                                                       nextFrameNumber++, renumbered))
+                    {
+                        jassertfalse;
+                        writeFailed = true;
+                        break;
+                    }
+
+                    const auto newSize = (uint32) (renumbered.size() - start);
+                    minFrameSize = minFrameSize == 0 ? newSize : jmin (minFrameSize, newSize);
+                    maxFrameSize = jmax (maxFrameSize, newSize);
+                    offset += size;
+                }
+
+                totalSamples += segment.numSamples;
+
+                if (! writeFailed)
+                    writeFailed = ! output->write (renumbered.data(), renumbered.size());
+            }
+
+            pending.pop_front();
+        }
+    }
+
+    //==============================================================================
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus segmentWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                               const FlacNamespace::FLAC__byte buffer[],
+                                                                               size_t bytes,
+                                                                               unsigned int samples,
+                                                                               unsigned int /*current_frame*/,
+                                                                               void* client_data)
+    {
+        auto& segment = *static_cast<Segment*> (client_data);
+
+        // The encoder passes each frame to this callback in one go, flagged by a
+        // non-zero number of samples. Anything else is part of the stream header.
+        if (samples == 0)
+        {
+            segment.header.insert (segment.header.end(), buffer, buffer + bytes);
+        }
+        else
+        {
+            segment.frames.insert (segment.frames.end(), buffer, buffer + bytes);
+            segment.frameSizes.push_back (bytes);
+        }
+
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus discardCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                          const FlacNamespace::FLAC__byte[], size_t,
+                                                                          unsigned int, unsigned int, void*)
+    {
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+public:
+    bool ok = false;
+
+private:
+    static constexpr int framesPerSegment = 64;
+
+    const int qualityOptionIndex;
+    const int64 streamStartPos;
+    const size_t maxSegmentsInFlight;
+    int blockSize = 4096;
+
+    std::unique_ptr<Segment> current;
+    std::deque<std::unique_ptr<Segment>> pending;
+    WaitableEvent segmentFinished;
+
+    uint32 nextFrameNumber = 0, minFrameSize = 0, maxFrameSize = 0;
+    int64 totalSamples = 0;
+    bool writeFailed = false;
+
+   #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+    FlacNamespace::FLAC__MD5Context md5;
+   #endif
+
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacWriter)
+};
+
+//==============================================================================
+/*  Reads a FLAC file using a separate decoder for each thread. Reads that are
+    long enough get split into consecutive ranges, and each decoder seeks to its
+    own range; libFLAC uses the file's seek table for this if there is one.
+*/
+class ParallelFlacReader  : public AudioFormatReader
+{
+public:
+    ParallelFlacReader (const File& file, int numThreads)
+        : AudioFormatReader (nullptr, flacFormatName),
+          pool (jmax (1, numThreads - 1))
+    {
+        for (int i = 0; i < jmax (1, numThreads); ++i)
+        {
+            auto stream = file.createInputStream();
+
+            if (stream == nullptr)
+                break;
+
+            auto reader = std::make_unique<FlacReader> (stream.release());
+
+            if (reader->sampleRate <= 0)
+                break;
+
+            if (i == 0)
+            {
+                sampleRate = reader->sampleRate;
+                bitsPerSample = reader->bitsPerSample;
+                lengthInSamples = reader->lengthInSamples;
+                numChannels = reader->numChannels;
+                usesFloatingPointData = reader->usesFloatingPointData;
+            }
+
+            readers.push_back (std::move (reader));
+        }
+    }
+
+    ~ParallelFlacReader() override
+    {
+        pool.removeAllJobs (true, -1);
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        if (readers.empty())
+            return false;
+
+        const auto numParts = jlimit (1, (int) readers.size(), numSamples / minSamplesPerThread);
+
+        if (numParts == 1)
+            return readers.front()->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                                 startSampleInFile, numSamples);
+
+        std::atomic<int> numRemaining { numParts - 1 };
+        std::atomic<bool> allOk { true };
+        WaitableEvent partsFinished;
+
+        const auto readPart = [&, destSamples] (int part)
+        {
+            const auto start = (int) ((int64) numSamples * part / numParts);
+            const auto end   = (int) ((int64) numSamples * (part + 1) / numParts);
+
+            if (! readers[(size_t) part]->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer + start,
+                                                       startSampleInFile + start, end - start))
+                allOk = false;
+        };
+
+        for (int part = 1; part < numParts; ++part)
+        {
+            pool.addJob ([&, part]
+            {
+                readPart (part);
+
+                if (--numRemaining == 0)
+                    partsFinished.signal();
+            });
+        }
+
+        readPart (0);
+        partsFinished.wait();
+
+        return allOk;
+    }
+
+private:
+    static constexpr int minSamplesPerThread = 65536;
+
+    std::vector<std::unique_ptr<FlacReader>> readers;
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacReader)
+};
+
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
@@ -598,11 +1135,200 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+AudioFormatWriter* FlacAudioFormat::createParallelWriterFor (OutputStream* out,
+                                                             double sampleRate,
+                                                             unsigned int numberOfChannels,
+                                                             int bitsPerSample,
+                                                             int qualityOptionIndex,
+                                                             int numThreads)
+{
+    if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
+    {
+        std::unique_ptr<ParallelFlacWriter> w (new ParallelFlacWriter (out, sampleRate, numberOfChannels,
+                                                                       (uint32) bitsPerSample, qualityOptionIndex, numThreads));
+        if (w->ok)
+            return w.release();
+    }
+
+    return nullptr;
+}
+
+AudioFormatReader* FlacAudioFormat::createParallelReaderFor (const File& file, int numThreads)
+{
+    std::unique_ptr<ParallelFlacReader> r (new ParallelFlacReader (file, numThreads));
+
+    if (r->sampleRate > 0)
+        return r.release();
+
+    return nullptr;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlacAudioFormatTests  : public UnitTest
+{
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        FlacAudioFormat format;
+        const auto source = createTestSignal (getRandom());
+
+        MemoryBlock parallelBlock, serialBlock;
+
+        beginTest ("Parallel writer output can be decoded by the normal reader");
+        {
+            parallelBlock = writeToBlock (source, [&] (OutputStream* out)
+            {
+                return format.createParallelWriterFor (out, 44100.0, numChannels, 16, 5, 4);
+            });
+
+            const auto decoded = readAll (format.createReaderFor (new MemoryInputStream (parallelBlock, false), true));
+            expect (decoded == source);
+        }
+
+        beginTest ("Parallel writer handles short streams");
+        {
+            for (auto length : { 0, 1, 4095, 4097 })
+            {
+                std::vector<std::vector<int>> shortSource;
+
+                for (auto& channel : source)
+                    shortSource.emplace_back (channel.begin(), channel.begin() + length);
+
+                const auto block = writeToBlock (shortSource, [&] (OutputStream* out)
+                {
+                    return format.createParallelWriterFor (out, 44100.0, numChannels, 16, 5, 3);
+                });
+
+                const auto decoded = readAll (format.createReaderFor (new MemoryInputStream (block, false), true));
+                expect (decoded == shortSource);
+            }
+        }
+
+        beginTest ("Parallel reader matches the normal reader");
+        {
+            serialBlock = writeToBlock (source, [&] (OutputStream* out)
+            {
+                return format.createWriterFor (out, 44100.0, numChannels, 16, {}, 5);
+            });
+
+            // The stream parameters, length and MD5 signature should be identical to
+            // what the normal encoder writes; only the frame sizes may differ
+            const auto getStreamInfoEnd = [] (const MemoryBlock& b) { return MemoryBlock (addBytesToPointer (b.getData(), 18), 8 + 16); };
+            expect (getStreamInfoEnd (parallelBlock) == getStreamInfoEnd (serialBlock));
+
+            TemporaryFile temp (".flac");
+            expect (temp.getFile().replaceWithData (serialBlock.getData(), serialBlock.getSize()));
+
+            std::unique_ptr<AudioFormatReader> reader (format.createParallelReaderFor (temp.getFile(), 4));
+            expect (reader != nullptr);
+            expectEquals (reader->lengthInSamples, (int64) numSamples);
+            expect (readAll (reader.release()) == source);
+
+            reader.reset (format.createParallelReaderFor (temp.getFile(), 3));
+            const auto start = 123457, length = 300001;
+
+            std::vector<std::vector<int>> part (numChannels, std::vector<int> ((size_t) length));
+            std::vector<int*> dest;
+
+            for (auto& channel : part)
+                dest.push_back (channel.data());
+
+            expect (reader->read (dest.data(), (int) numChannels, start, length, false));
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                expect (std::equal (part[ch].begin(), part[ch].end(), source[ch].begin() + start));
+        }
+    }
+
+private:
+    static constexpr unsigned int numChannels = 2;
+    static constexpr int numSamples = 600000;
+
+    using Channels = std::vector<std::vector<int>>;
+
+    static Channels createTestSignal (Random random)
+    {
+        Channels result (numChannels, std::vector<int> ((size_t) numSamples));
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto value = 0.5 * std::sin ((double) i * 0.01 * (double) (ch + 1)) + 0.1 * (random.nextDouble() - 0.5);
+                result[ch][(size_t) i] = roundToInt (value * 32767.0) * 65536;
+            }
+        }
+
+        return result;
+    }
+
+    template <typename CreateWriter>
+    static MemoryBlock writeToBlock (const Channels& source, CreateWriter&& createWriter)
+    {
+        MemoryBlock block;
+
+        {
+            auto* out = new MemoryOutputStream (block, false);
+            std::unique_ptr<AudioFormatWriter> writer (createWriter (out));
+
+            if (writer == nullptr)
+            {
+                delete out;
+                jassertfalse;
+                return {};
+            }
+
+            const auto length = (int) source.front().size();
+
+            for (int pos = 0; pos < length; pos += 10000)
+            {
+                std::vector<const int*> channels;
+
+                for (auto& channel : source)
+                    channels.push_back (channel.data() + pos);
+
+                channels.push_back (nullptr);
+                writer->write (channels.data(), jmin (10000, length - pos));
+            }
+        }
+
+        return block;
+    }
+
+    static Channels readAll (AudioFormatReader* readerToUse)
+    {
+        std::unique_ptr<AudioFormatReader> reader (readerToUse);
+
+        if (reader == nullptr)
+            return {};
+
+        Channels result (reader->numChannels, std::vector<int> ((size_t) reader->lengthInSamples));
+        std::vector<int*> dest;
+
+        for (auto& channel : result)
+            dest.push_back (channel.data());
+
+        reader->read (dest.data(), (int) reader->numChannels, 0, (int) reader->lengthInSamples, false);
+        return result;
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
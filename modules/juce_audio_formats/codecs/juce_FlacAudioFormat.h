@@ -65,6 +65,36 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    //==============================================================================
+    /** Creates a writer that encodes the stream on several threads at once.
+
+        The audio is cut into segments of a few seconds, which are encoded
+        independently and then joined back together in order, so the resulting
+        file is a normal FLAC stream. This is much faster than createWriterFor()
+        for long recordings, but it needs to hold a few segments per thread in
+        memory, and the stream it writes to must be seekable.
+
+        The writer that is returned takes ownership of the stream in the same way
+        as createWriterFor(), and it must be deleted to finish the file.
+    */
+    AudioFormatWriter* createParallelWriterFor (OutputStream* streamToWriteTo,
+                                                double sampleRateToUse,
+                                                unsigned int numberOfChannels,
+                                                int bitsPerSample,
+                                                int qualityOptionIndex,
+                                                int numThreads);
+
+    /** Creates a reader that decodes large reads on several threads at once.
+
+        The reader opens the file once for each thread. Any read that's long enough
+        gets split into consecutive ranges, which are decoded at the same time.
+        Short reads use a single decoder, so there's no benefit over createReaderFor()
+        for small random-access reads.
+
+        Returns nullptr if the file can't be opened as a FLAC stream.
+    */
+    AudioFormatReader* createParallelReaderFor (const File& file, int numThreads);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
@@ -1383,6 +1383,80 @@ namespace DCT
     }
 }
 
+//==============================================================================
+// The dot products of the polyphase synthesis window, which is where most of the decoding time goes
+namespace SynthesisWindow
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    inline float sum (__m128 v) noexcept
+    {
+        v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_add_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+
+    inline __m128 load (const float* p) noexcept           { return _mm_loadu_ps (p); }
+    inline __m128 loadReversed (const float* p) noexcept   { auto v = _mm_loadu_ps (p); return _mm_shuffle_ps (v, v, _MM_SHUFFLE (0, 1, 2, 3)); }
+    inline __m128 mul (__m128 a, __m128 b) noexcept        { return _mm_mul_ps (a, b); }
+    inline __m128 add (__m128 a, __m128 b) noexcept        { return _mm_add_ps (a, b); }
+
+    inline __m128 negateOddLanes (__m128 v) noexcept
+    {
+        return _mm_xor_ps (v, _mm_castsi128_ps (_mm_set_epi32 ((int) 0x80000000, 0, (int) 0x80000000, 0)));
+    }
+   #elif JUCE_USE_ARM_NEON
+    inline float sum (float32x4_t v) noexcept
+    {
+        auto pair = vadd_f32 (vget_low_f32 (v), vget_high_f32 (v));
+        return vget_lane_f32 (vpadd_f32 (pair, pair), 0);
+    }
+
+    inline float32x4_t load (const float* p) noexcept              { return vld1q_f32 (p); }
+    inline float32x4_t loadReversed (const float* p) noexcept      { auto v = vrev64q_f32 (vld1q_f32 (p)); return vcombine_f32 (vget_high_f32 (v), vget_low_f32 (v)); }
+    inline float32x4_t mul (float32x4_t a, float32x4_t b) noexcept { return vmulq_f32 (a, b); }
+    inline float32x4_t add (float32x4_t a, float32x4_t b) noexcept { return vaddq_f32 (a, b); }
+
+    inline float32x4_t negateOddLanes (float32x4_t v) noexcept
+    {
+        static const float signs[] = { 1.0f, -1.0f, 1.0f, -1.0f };
+        return vmulq_f32 (v, vld1q_f32 (signs));
+    }
+   #endif
+
+    // window[0] * b[0] - window[1] * b[1] + window[2] * b[2] ... - window[15] * b[15]
+    inline float alternatingSum (const float* window, const float* b) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return sum (negateOddLanes (add (add (mul (load (window),     load (b)),     mul (load (window + 4),  load (b + 4))),
+                                         add (mul (load (window + 8), load (b + 8)), mul (load (window + 12), load (b + 12))))));
+       #else
+        float total = 0;
+
+        for (int i = 0; i < 16; i += 2)
+            total += window[i] * b[i] - window[i + 1] * b[i + 1];
+
+        return total;
+       #endif
+    }
+
+    // window[-1] * b[0] + window[-2] * b[1] ... + window[-15] * b[14] + window[0] * b[15]
+    inline float reversedSum (const float* window, const float* b) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return sum (add (add (mul (loadReversed (window - 4), load (b)),
+                              mul (loadReversed (window - 8), load (b + 4))),
+                         mul (loadReversed (window - 12), load (b + 8))))
+                + window[-13] * b[12] + window[-14] * b[13] + window[-15] * b[14] + window[0] * b[15];
+       #else
+        float total = window[0] * b[15];
+
+        for (int i = 0; i < 15; ++i)
+            total += window[-1 - i] * b[i];
+
+        return total;
+       #endif
+    }
+}
+
 //==============================================================================
 struct MP3Stream
 {
@@ -1558,17 +1632,11 @@ struct MP3Stream
     {
         frameIndex = jmax (0, frameIndex);
 
-        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
-        {
-            int dummy = 0;
-            auto result = decodeNextBlock (nullptr, nullptr, dummy);
-
-            if (result < 0)
-                return false;
+        if (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+            buildSeekIndex();
 
-            if (result > 0)
-                break;
-        }
+        if (frameStreamPositions.isEmpty())
+            return false;
 
         frameIndex = jmin (frameIndex & ~(storedStartPosInterval - 1),
                            (frameStreamPositions.size() - 1) * storedStartPosInterval);
@@ -1579,6 +1647,69 @@ struct MP3Stream
         return true;
     }
 
+    // Scans the rest of the stream, recording where its frames start, so that every
+    // seek after this one can go straight to the right frame.
+    void buildSeekIndex()
+    {
+        if (seekIndexComplete)
+            return;
+
+        if (! frameStreamPositions.isEmpty())
+        {
+            stream.setPosition (frameStreamPositions.getLast());
+            currentFrameIndex = (frameStreamPositions.size() - 1) * storedStartPosInterval;
+            reset();
+        }
+
+        for (;;)
+        {
+            const auto position = stream.getPosition();
+            int dummy = 0;
+            const auto result = decodeNextBlock (nullptr, nullptr, dummy);
+
+            if (result < 0 || stream.isExhausted() || (result > 0 && stream.getPosition() == position))
+                break;
+        }
+
+        seekIndexComplete = true;
+    }
+
+    MemoryBlock createSeekIndex()
+    {
+        buildSeekIndex();
+
+        MemoryOutputStream out;
+        out.writeInt (seekIndexMagic);
+        out.writeInt64 (stream.getTotalLength());
+        out.writeInt (frameStreamPositions.size());
+
+        for (auto position : frameStreamPositions)
+            out.writeInt64 (position);
+
+        return out.getMemoryBlock();
+    }
+
+    bool setSeekIndex (const MemoryBlock& data)
+    {
+        MemoryInputStream in (data, false);
+
+        if (in.readInt() != seekIndexMagic || in.readInt64() != stream.getTotalLength())
+            return false;
+
+        auto numPositions = in.readInt();
+
+        if (numPositions <= 0 || in.getNumBytesRemaining() != (int64) numPositions * 8)
+            return false;
+
+        frameStreamPositions.clearQuick();
+
+        for (int i = 0; i < numPositions; ++i)
+            frameStreamPositions.add (in.readInt64());
+
+        seekIndexComplete = true;
+        return true;
+    }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -1619,7 +1750,9 @@ private:
     }
 
     enum { storedStartPosInterval = 4 };
+    static constexpr int seekIndexMagic = (int) ByteOrder::makeInt ('M', '3', 'S', 'I');
     Array<int64> frameStreamPositions;
+    bool seekIndexComplete = false;
 
     struct SideInfoLayer1
     {
@@ -2909,17 +3042,7 @@ private:
         const float* window = constants.decodeWin + 16 - bo1;
 
         for (int j = 16; j != 0; --j, b0 += 16, window += 32)
-        {
-            auto sum = window[0] * b0[0];  sum -= window[1] * b0[1];
-            sum += window[2]  * b0[2];   sum -= window[3]  * b0[3];
-            sum += window[4]  * b0[4];   sum -= window[5]  * b0[5];
-            sum += window[6]  * b0[6];   sum -= window[7]  * b0[7];
-            sum += window[8]  * b0[8];   sum -= window[9]  * b0[9];
-            sum += window[10] * b0[10];  sum -= window[11] * b0[11];
-            sum += window[12] * b0[12];  sum -= window[13] * b0[13];
-            sum += window[14] * b0[14];  sum -= window[15] * b0[15];
-            *out++ = sum;
-        }
+            *out++ = SynthesisWindow::alternatingSum (window, b0);
 
         {
             auto sum = window[0] * b0[0];   sum += window[2] * b0[2];
@@ -2932,17 +3055,7 @@ private:
         }
 
         for (int j = 15; j != 0; --j, b0 -= 16, window -= 32)
-        {
-            auto sum = -window[-1] * b0[0];  sum -= window[-2] * b0[1];
-            sum -= window[-3]  * b0[2];   sum -= window[-4]  * b0[3];
-            sum -= window[-5]  * b0[4];   sum -= window[-6]  * b0[5];
-            sum -= window[-7]  * b0[6];   sum -= window[-8]  * b0[7];
-            sum -= window[-9]  * b0[8];   sum -= window[-10] * b0[9];
-            sum -= window[-11] * b0[10];  sum -= window[-12] * b0[11];
-            sum -= window[-13] * b0[12];  sum -= window[-14] * b0[13];
-            sum -= window[-15] * b0[14];  sum -= window[0]   * b0[15];
-            *out++ = sum;
-        }
+            *out++ = -SynthesisWindow::reversedSum (window, b0);
 
         samplesDone += 32;
     }
@@ -2971,10 +3084,30 @@ public:
             usesFloatingPointData = true;
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
+            samplesPerFrame = stream.frame.layer == 1 ? 384 : ((stream.frame.layer == 3 && stream.frame.lsf != 0) ? 576 : 1152);
+            firstAudioFrame = stream.currentFrameIndex - 1;
             lengthInSamples = findLength (streamPos);
+
+            // A frame's data can start up to 511 bytes back, in the frames before it, and its
+            // output overlaps the frame before, so a seek has to decode enough frames before
+            // its target to cover both.
+            const auto numFramesInStream = jmax ((int64) 1, lengthInSamples / samplesPerFrame);
+            const auto bytesPerFrame = jmax ((int64) 1, (stream.stream.getTotalLength() - streamPos) / numFramesInStream);
+            numPreRollFrames = 2 + (int) ((1024 + bytesPerFrame - 1) / bytesPerFrame);
         }
     }
 
+    MemoryBlock createSeekIndex()
+    {
+        currentPosition = -1;
+        return stream.createSeekIndex();
+    }
+
+    bool setSeekIndex (const MemoryBlock& data)
+    {
+        return stream.setSeekIndex (data);
+    }
+
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override
     {
@@ -2986,7 +3119,11 @@ public:
 
         if (currentPosition != startSampleInFile)
         {
-            if (! stream.seek ((int) (startSampleInFile / 1152 - 1)))
+            const auto targetFrame = firstAudioFrame + (int) (startSampleInFile / samplesPerFrame);
+
+            // The frames before the target are decoded and discarded, to fill in the bit
+            // reservoir and the overlap that the target frame depends on
+            if (! stream.seek (targetFrame - numPreRollFrames))
             {
                 currentPosition = -1;
                 createEmptyDecodedData();
@@ -2994,11 +3131,8 @@ public:
             else
             {
                 decodedStart = decodedEnd = 0;
-                const int64 streamPos = stream.currentFrameIndex * 1152;
-                int toSkip = (int) (startSampleInFile - streamPos);
-                jassert (toSkip >= 0);
 
-                while (toSkip > 0)
+                for (int previousFrame = -1;;)
                 {
                     if (! readNextBlock())
                     {
@@ -3006,15 +3140,17 @@ public:
                         break;
                     }
 
-                    const int numReady = decodedEnd - decodedStart;
+                    const auto decodedFrame = stream.currentFrameIndex - 1;
 
-                    if (numReady > toSkip)
+                    if (decodedFrame >= targetFrame || decodedFrame == previousFrame)
                     {
-                        decodedStart += toSkip;
+                        if (decodedFrame == targetFrame)
+                            decodedStart = jmin (decodedEnd, (int) (startSampleInFile % samplesPerFrame));
+
                         break;
                     }
 
-                    toSkip -= numReady;
+                    previousFrame = decodedFrame;
                 }
 
                 currentPosition = startSampleInFile;
@@ -3051,6 +3187,7 @@ public:
 private:
     MP3Stream stream;
     int64 currentPosition;
+    int samplesPerFrame = 1152, firstAudioFrame = 0, numPreRollFrames = 5;
     enum { decodedDataSize = 1152 };
     float decoded0[decodedDataSize], decoded1[decodedDataSize];
     int decodedStart, decodedEnd;
@@ -3132,7 +3269,7 @@ private:
             }
         }
 
-        return numFrames * 1152;
+        return numFrames * samplesPerFrame;
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MP3Reader)
@@ -3164,6 +3301,27 @@ AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, c
     return nullptr;
 }
 
+AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails,
+                                                    const MemoryBlock& seekIndex)
+{
+    auto* r = createReaderFor (sourceStream, deleteStreamIfOpeningFails);
+
+    if (r != nullptr)
+        static_cast<MP3Decoder::MP3Reader*> (r)->setSeekIndex (seekIndex);
+
+    return r;
+}
+
+MemoryBlock MP3AudioFormat::createSeekIndex (InputStream* sourceStream)
+{
+    std::unique_ptr<AudioFormatReader> r (createReaderFor (sourceStream, true));
+
+    if (r != nullptr)
+        return static_cast<MP3Decoder::MP3Reader*> (r.get())->createSeekIndex();
+
+    return {};
+}
+
 AudioFormatWriter* MP3AudioFormat::createWriterFor (OutputStream*, double /*sampleRateToUse*/,
                                                     unsigned int /*numberOfChannels*/, int /*bitsPerSample*/,
                                                     const StringPairArray& /*metadataValues*/, int /*qualityOptionIndex*/)
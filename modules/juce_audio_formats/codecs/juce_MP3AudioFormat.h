@@ -62,6 +62,22 @@ public:
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that uses a seek index made by createSeekIndex().
+
+        If the index doesn't belong to this stream, it's ignored, and the reader
+        builds its own index the first time it has to seek.
+    */
+    AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails, const MemoryBlock& seekIndex);
+
+    /** Scans a stream and returns an index of the positions of its frames.
+
+        A reader builds this index the first time it seeks, by reading through the whole
+        stream, so that later seeks can go straight to the right frame. If you store the
+        index, e.g. alongside the file, and pass it to createReaderFor(), new readers can
+        skip the scan. The stream is deleted before this returns.
+    */
+    MemoryBlock createSeekIndex (InputStream* sourceStream);
+
     AudioFormatWriter* createWriterFor (OutputStream*, double sampleRateToUse,
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
@@ -181,7 +181,7 @@ public:
             bufferedRange = Range<int64> { newStart, newStart + reservoir.getNumSamples() };
 
             if (bufferedRange.getStart() != ov_pcm_tell (&ovFile))
-                ov_pcm_seek (&ovFile, bufferedRange.getStart());
+                seekTo (bufferedRange.getStart());
 
             int bitStream = 0;
             int offset = 0;
@@ -251,12 +251,146 @@ public:
         return (long) static_cast<InputStream*> (datasource)->getPosition();
     }
 
+    //==============================================================================
+    bool setSeekIndex (const MemoryBlock& data)
+    {
+        MemoryInputStream in (data, false);
+
+        if (in.readInt() != seekIndexMagic || in.readInt64() != input->getTotalLength())
+            return false;
+
+        auto numPages = in.readInt();
+
+        if (numPages < 0 || in.getNumBytesRemaining() != (int64) numPages * 16)
+            return false;
+
+        seekIndex.resize ((size_t) numPages);
+
+        for (auto& page : seekIndex)
+        {
+            page.offset = in.readInt64();
+            page.granulePosition = in.readInt64();
+        }
+
+        seekIndexBuilt = true;
+        return true;
+    }
+
+    MemoryBlock createSeekIndex()
+    {
+        buildSeekIndex();
+
+        MemoryOutputStream out;
+        out.writeInt (seekIndexMagic);
+        out.writeInt64 (input->getTotalLength());
+        out.writeInt ((int) seekIndex.size());
+
+        for (auto& page : seekIndex)
+        {
+            out.writeInt64 (page.offset);
+            out.writeInt64 (page.granulePosition);
+        }
+
+        return out.getMemoryBlock();
+    }
+
 private:
     OggVorbisNamespace::OggVorbis_File ovFile;
     OggVorbisNamespace::ov_callbacks callbacks;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
 
+    struct IndexedPage
+    {
+        int64 offset, granulePosition;
+    };
+
+    static constexpr int seekIndexMagic = (int) ByteOrder::makeInt ('O', 'g', 'S', 'I');
+    std::vector<IndexedPage> seekIndex;
+    bool seekIndexBuilt = false;
+
+    // Records the position of every page in the stream that ends a packet. A seek can then go
+    // straight to the page before the target, instead of bisecting the file to look for it.
+    void buildSeekIndex()
+    {
+        if (seekIndexBuilt)
+            return;
+
+        seekIndexBuilt = true;
+
+        // Chained streams are left to vorbisfile's own search
+        if (ov_seekable (&ovFile) == 0 || ov_streams (&ovFile) != 1)
+            return;
+
+        const auto serialNumber = (uint32) ov_serialnumber (&ovFile, 0);
+        const auto originalPosition = input->getPosition();
+        const auto end = (int64) ovFile.offsets[1];
+        auto position = (int64) ovFile.dataoffsets[0];
+
+        while (position < end)
+        {
+            uint8 header[27 + 255];
+            input->setPosition (position);
+
+            if (input->read (header, 27) != 27 || memcmp (header, "OggS", 4) != 0)
+            {
+                seekIndex.clear();
+                break;
+            }
+
+            const int numSegments = header[26];
+
+            if (input->read (header + 27, numSegments) != numSegments)
+            {
+                seekIndex.clear();
+                break;
+            }
+
+            int bodySize = 0;
+
+            for (int i = 0; i < numSegments; ++i)
+                bodySize += header[27 + i];
+
+            const auto granulePosition = (int64) ByteOrder::littleEndianInt64 (header + 6);
+
+            if (granulePosition != -1 && ByteOrder::littleEndianInt (header + 14) == serialNumber)
+                seekIndex.push_back ({ position, granulePosition });
+
+            position += 27 + numSegments + bodySize;
+        }
+
+        input->setPosition (originalPosition);
+    }
+
+    void seekTo (int64 sampleIndex)
+    {
+       #if JUCE_INCLUDE_OGGVORBIS_CODE || ! defined (JUCE_INCLUDE_OGGVORBIS_CODE)
+        buildSeekIndex();
+
+        // Granule positions are offset by the granule position at the start of the stream
+        const auto startGranule = (int64) ovFile.pcmlengths[0];
+        const auto target = sampleIndex + startGranule;
+
+        auto next = std::lower_bound (seekIndex.begin(), seekIndex.end(), target,
+                                      [] (const IndexedPage& page, int64 t) { return page.granulePosition < t; });
+
+        if (next != seekIndex.begin())
+        {
+            const auto page = std::prev (next);
+            const auto isLast = (next == seekIndex.end());
+
+            if (ov_pcm_seek_bounded (&ovFile, sampleIndex,
+                                     page->offset,
+                                     isLast ? (int64) ovFile.offsets[1] : next->offset,
+                                     page == seekIndex.begin() ? startGranule : std::prev (page)->granulePosition,
+                                     isLast ? startGranule + (int64) ovFile.pcmlengths[1] : next->granulePosition) == 0)
+                return;
+        }
+       #endif
+
+        ov_pcm_seek (&ovFile, sampleIndex);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
 
@@ -450,6 +584,27 @@ AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool
     return nullptr;
 }
 
+AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails,
+                                                          const MemoryBlock& seekIndex)
+{
+    auto* r = createReaderFor (in, deleteStreamIfOpeningFails);
+
+    if (r != nullptr)
+        static_cast<OggReader*> (r)->setSeekIndex (seekIndex);
+
+    return r;
+}
+
+MemoryBlock OggVorbisAudioFormat::createSeekIndex (InputStream* in)
+{
+    std::unique_ptr<AudioFormatReader> r (createReaderFor (in, true));
+
+    if (r != nullptr)
+        return static_cast<OggReader*> (r.get())->createSeekIndex();
+
+    return {};
+}
+
 AudioFormatWriter* OggVorbisAudioFormat::createWriterFor (OutputStream* out,
                                                           double sampleRate,
                                                           unsigned int numChannels,
@@ -504,6 +659,101 @@ int OggVorbisAudioFormat::estimateOggFileQuality (const File& source)
     return 0;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OggVorbisAudioFormatTests  : public UnitTest
+{
+public:
+    OggVorbisAudioFormatTests()
+        : UnitTest ("OggVorbisAudioFormat", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        OggVorbisAudioFormat format;
+        const auto encoded = encode (format, 44100 * 4);
+        const auto reference = decode (format, encoded, {});
+
+        beginTest ("Random seeks return the same samples as a sequential read");
+        {
+            expectRandomReadsMatch (format, encoded, {}, reference);
+        }
+
+        beginTest ("A seek index can be saved and reused");
+        {
+            const auto index = format.createSeekIndex (new MemoryInputStream (encoded, false));
+            expectGreaterThan ((int) index.getSize(), 16);
+
+            expectRandomReadsMatch (format, encoded, index, reference);
+        }
+
+        beginTest ("A seek index for a different stream is ignored");
+        {
+            const auto otherIndex = format.createSeekIndex (new MemoryInputStream (encode (format, 44100), false));
+
+            expectRandomReadsMatch (format, encoded, otherIndex, reference);
+        }
+    }
+
+private:
+    static MemoryBlock encode (OggVorbisAudioFormat& format, int numSamples)
+    {
+        AudioBuffer<float> source (2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            source.setSample (0, i, 0.5f * std::sin ((float) i * 0.01f));
+            source.setSample (1, i, 0.3f * std::sin ((float) i * 0.037f));
+        }
+
+        MemoryBlock encoded;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (encoded, false),
+                                                                               44100.0, 2, 16, {}, 4));
+            writer->writeFromAudioSampleBuffer (source, 0, numSamples);
+        }
+
+        return encoded;
+    }
+
+    static AudioBuffer<float> decode (OggVorbisAudioFormat& format, const MemoryBlock& encoded, const MemoryBlock& seekIndex)
+    {
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (encoded, false), true, seekIndex));
+        AudioBuffer<float> result (2, (int) reader->lengthInSamples);
+        reader->read (&result, 0, result.getNumSamples(), 0, true, true);
+        return result;
+    }
+
+    void expectRandomReadsMatch (OggVorbisAudioFormat& format, const MemoryBlock& encoded,
+                                 const MemoryBlock& seekIndex, const AudioBuffer<float>& reference)
+    {
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (encoded, false), true, seekIndex));
+        expect (reader != nullptr);
+        expectEquals (reader->lengthInSamples, (int64) reference.getNumSamples());
+
+        auto random = getRandom();
+        AudioBuffer<float> result (2, 1000);
+
+        for (int i = 0; i < 40; ++i)
+        {
+            const auto start = random.nextInt (reference.getNumSamples() - result.getNumSamples());
+            reader->read (&result, 0, result.getNumSamples(), start, true, true);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int s = 0; s < result.getNumSamples(); ++s)
+                    if (std::abs (result.getSample (ch, s) - reference.getSample (ch, start + s)) > 1.0e-6f)
+                        return expect (false, "mismatch reading from sample " + String (start));
+        }
+    }
+};
+
+static OggVorbisAudioFormatTests oggVorbisAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
@@ -84,6 +84,24 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that uses a seek index made by createSeekIndex().
+
+        If the index doesn't belong to this stream, it's ignored, and the reader
+        builds its own index the first time it has to seek.
+    */
+    AudioFormatReader* createReaderFor (InputStream* sourceStream,
+                                        bool deleteStreamIfOpeningFails,
+                                        const MemoryBlock& seekIndex);
+
+    /** Scans a stream and returns an index of its pages.
+
+        A reader builds this index the first time it seeks, so that later seeks can go
+        straight to the right page instead of searching the file for it. If you store the
+        index, e.g. alongside the file, and pass it to createReaderFor(), new readers can
+        skip the scan. The stream is deleted before this returns.
+    */
+    MemoryBlock createSeekIndex (InputStream* sourceStream);
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
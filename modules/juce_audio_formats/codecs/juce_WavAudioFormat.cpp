@@ -1927,10 +1927,9 @@ public:
 
 private:
     template <typename SampleType>
-    void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const noexcept
+    void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const
     {
-        for (int i = 0; i < numChannelsToRead; ++i)
-            results[i] = scanMinAndMaxInterleaved<SampleType, AudioData::LittleEndian> (i, startSampleInFile, numSamples);
+        scanMinAndMaxInterleaved<SampleType, AudioData::LittleEndian> (startSampleInFile, numSamples, results, numChannelsToRead);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedWavReader)
@@ -1418,7 +1418,12 @@ int ov_raw_seek(OggVorbis_File *vf,ogg_int64_t pos){
    Seek to the last [granule marked] page preceding the specified pos
    location, such that decoding past the returned point will quickly
    arrive at the requested position. */
-int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
+// JUCE CHANGE STARTS HERE
+/* bounds, if not NULL, holds the byte range and the granule positions at each end of it,
+   within which the page we want is known to lie. This replaces the bisection, which
+   can then read a single page */
+static int _ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos,const ogg_int64_t *bounds){
+// JUCE CHANGE ENDS HERE
   int link=-1;
   ogg_int64_t result=0;
   ogg_int64_t total=ov_pcm_total(vf,-1);
@@ -1462,6 +1467,14 @@ int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
         begin = pos;
       
     ogg_int64_t initialBegin = begin;
+
+    if(bounds && link==0){
+      begin=bounds[0];
+      end=bounds[1];
+      begintime=bounds[2];
+      endtime=bounds[3];
+      initialBegin=begin;
+    }
     // JUCE CHANGE ENDS HERE
 
     /* if we have only one page, there will be no bisection.  Grab the page here */
@@ -1699,12 +1712,20 @@ int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
   return (int)result;
 }
 
+// JUCE CHANGE STARTS HERE
+int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
+  return _ov_pcm_seek_page(vf,pos,NULL);
+}
+// JUCE CHANGE ENDS HERE
+
 /* seek to a sample offset relative to the decompressed pcm stream
    returns zero on success, nonzero on failure */
 
-int ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos){
+// JUCE CHANGE STARTS HERE
+static int _ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos,const ogg_int64_t *bounds){
   int thisblock,lastblock=0;
-  int ret=ov_pcm_seek_page(vf,pos);
+  int ret=_ov_pcm_seek_page(vf,pos,bounds);
+// JUCE CHANGE ENDS HERE
   if(ret<0)return(ret);
   if((ret=_make_decode_ready(vf)))return ret;
 
@@ -1800,6 +1821,19 @@ int ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos){
   return 0;
 }
 
+// JUCE CHANGE STARTS HERE
+int ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos){
+  return _ov_pcm_seek(vf,pos,NULL);
+}
+
+int ov_pcm_seek_bounded(OggVorbis_File *vf,ogg_int64_t pos,
+                        ogg_int64_t begin,ogg_int64_t end,
+                        ogg_int64_t begintime,ogg_int64_t endtime){
+  const ogg_int64_t bounds[4]={begin,end,begintime,endtime};
+  return _ov_pcm_seek(vf,pos,bounds);
+}
+// JUCE CHANGE ENDS HERE
+
 /* seek to a playback time relative to the decompressed pcm stream
    returns zero on success, nonzero on failure */
 int ov_time_seek(OggVorbis_File *vf,double seconds){
@@ -169,6 +169,11 @@ extern double ov_time_total(OggVorbis_File *vf,int i);
 extern int ov_raw_seek(OggVorbis_File *vf,ogg_int64_t pos);
 extern int ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos);
 extern int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos);
+// JUCE CHANGE STARTS HERE
+extern int ov_pcm_seek_bounded(OggVorbis_File *vf,ogg_int64_t pos,
+                               ogg_int64_t begin,ogg_int64_t end,
+                               ogg_int64_t begintime,ogg_int64_t endtime);
+// JUCE CHANGE ENDS HERE
 extern int ov_time_seek(OggVorbis_File *vf,double pos);
 extern int ov_time_seek_page(OggVorbis_File *vf,double pos);
 
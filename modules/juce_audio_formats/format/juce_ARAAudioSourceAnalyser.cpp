@@ -0,0 +1,495 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ARAAudioSourceSampleCache::ARAAudioSourceSampleCache (ARAAudioSource& source, int chunkSize, int maxChunks)
+    : audioSource (source),
+      samplesPerChunk (chunkSize),
+      maxNumChunks (maxChunks),
+      numChannels (source.getChannelCount()),
+      lengthInSamples (source.getSampleCount()),
+      sampleAccessEnabled (source.isSampleAccessEnabled())
+{
+    jassert (samplesPerChunk > 0 && maxNumChunks > 0);
+
+    audioSource.addListener (this);
+}
+
+ARAAudioSourceSampleCache::~ARAAudioSourceSampleCache()
+{
+    if (sourceIsAlive)
+        audioSource.removeListener (this);
+}
+
+int64 ARAAudioSourceSampleCache::getNumChunks() const noexcept
+{
+    const ScopedLock sl (cacheLock);
+    return (lengthInSamples + samplesPerChunk - 1) / samplesPerChunk;
+}
+
+void ARAAudioSourceSampleCache::clear()
+{
+    const ScopedLock sl (cacheLock);
+    chunks.clear();
+    ++generation;
+}
+
+std::shared_ptr<const AudioBuffer<float>> ARAAudioSourceSampleCache::getChunk (int64 chunkIndex)
+{
+    int channelsToRead;
+    int64 startSample, endSample;
+    uint64 generationWhenRead;
+
+    {
+        const ScopedLock sl (cacheLock);
+
+        startSample = chunkIndex * samplesPerChunk;
+
+        if (chunkIndex < 0 || startSample >= lengthInSamples)
+            return nullptr;
+
+        for (auto& chunk : chunks)
+        {
+            if (chunk.index == chunkIndex)
+            {
+                chunk.lastUsed = ++useCounter;
+                return chunk.buffer;
+            }
+        }
+
+        channelsToRead = numChannels;
+        endSample = jmin (startSample + samplesPerChunk, lengthInSamples);
+        generationWhenRead = generation;
+    }
+
+    // Other threads can carry on using the cache while this one waits for the host
+    auto buffer = readFromHost (channelsToRead, startSample, (int) (endSample - startSample));
+
+    if (buffer == nullptr)
+        return nullptr;
+
+    const ScopedLock sl (cacheLock);
+
+    // The samples changed while they were being read, so they can't be trusted
+    if (generation != generationWhenRead)
+        return nullptr;
+
+    for (auto& chunk : chunks)
+    {
+        if (chunk.index == chunkIndex)
+        {
+            chunk.lastUsed = ++useCounter;
+            return chunk.buffer;
+        }
+    }
+
+    if ((int) chunks.size() >= maxNumChunks)
+        chunks.erase (std::min_element (chunks.begin(), chunks.end(),
+                                        [] (const auto& a, const auto& b) { return a.lastUsed < b.lastUsed; }));
+
+    chunks.push_back ({ chunkIndex, buffer, ++useCounter });
+    return buffer;
+}
+
+std::shared_ptr<const AudioBuffer<float>> ARAAudioSourceSampleCache::readFromHost (int channelsToRead, int64 startSample, int numSamples)
+{
+    const ScopedReadLock rl (readerLock);
+
+    if (! (sourceIsAlive && sampleAccessEnabled))
+        return nullptr;
+
+    std::unique_ptr<ARA::PlugIn::HostAudioReader> reader;
+
+    {
+        const ScopedLock sl (idleReadersLock);
+
+        if (! idleReaders.empty())
+        {
+            reader = std::move (idleReaders.back());
+            idleReaders.pop_back();
+        }
+    }
+
+    // A host reader mustn't be used by more than one thread at a time, so each thread
+    // that's reading borrows one of its own
+    if (reader == nullptr)
+        reader = std::make_unique<ARA::PlugIn::HostAudioReader> (&audioSource);
+
+    auto buffer = std::make_shared<AudioBuffer<float>> (channelsToRead, numSamples);
+    const auto ok = reader->readAudioSamples (startSample, numSamples,
+                                              reinterpret_cast<void* const*> (buffer->getArrayOfWritePointers()));
+
+    {
+        const ScopedLock sl (idleReadersLock);
+        idleReaders.push_back (std::move (reader));
+    }
+
+    return ok ? buffer : nullptr;
+}
+
+bool ARAAudioSourceSampleCache::readSamples (AudioBuffer<float>& destination, int destStartSample,
+                                             int64 sourceStartSample, int numSamples)
+{
+    jassert (sourceStartSample >= 0 && destStartSample + numSamples <= destination.getNumSamples());
+
+    bool ok = true;
+
+    while (numSamples > 0)
+    {
+        const auto chunkIndex = sourceStartSample / samplesPerChunk;
+        const auto offset = (int) (sourceStartSample % samplesPerChunk);
+        const auto numThisTime = jmin (numSamples, samplesPerChunk - offset);
+
+        if (auto chunk = getChunk (chunkIndex); chunk != nullptr && offset + numThisTime <= chunk->getNumSamples())
+        {
+            for (int channel = 0; channel < jmin (destination.getNumChannels(), chunk->getNumChannels()); ++channel)
+                destination.copyFrom (channel, destStartSample, *chunk, channel, offset, numThisTime);
+        }
+        else
+        {
+            for (int channel = 0; channel < destination.getNumChannels(); ++channel)
+                destination.clear (channel, destStartSample, numThisTime);
+
+            ok = false;
+        }
+
+        destStartSample += numThisTime;
+        sourceStartSample += numThisTime;
+        numSamples -= numThisTime;
+    }
+
+    return ok;
+}
+
+void ARAAudioSourceSampleCache::invalidate()
+{
+    clear();
+
+    // No reads can be in progress while the write lock is held, so every reader is idle
+    const ScopedWriteLock wl (readerLock);
+    const ScopedLock sl (idleReadersLock);
+    idleReaders.clear();
+}
+
+void ARAAudioSourceSampleCache::willUpdateAudioSourceProperties (ARAAudioSource* source,
+                                                                 ARAAudioSource::PropertiesPtr newProperties)
+{
+    jassertquiet (source == &audioSource);
+
+    if (source->getSampleCount() != newProperties->sampleCount
+        || source->getSampleRate() != newProperties->sampleRate
+        || source->getChannelCount() != newProperties->channelCount)
+    {
+        invalidate();
+
+        const ScopedLock sl (cacheLock);
+        numChannels = (int) newProperties->channelCount;
+        lengthInSamples = newProperties->sampleCount;
+    }
+}
+
+void ARAAudioSourceSampleCache::doUpdateAudioSourceContent (ARAAudioSource* source, ARAContentUpdateScopes scopeFlags)
+{
+    jassertquiet (source == &audioSource);
+
+    if (scopeFlags.affectSamples())
+        invalidate();
+}
+
+void ARAAudioSourceSampleCache::willEnableAudioSourceSamplesAccess (ARAAudioSource* source, bool enable)
+{
+    jassertquiet (source == &audioSource);
+
+    // The cached samples are still valid, but the host readers aren't
+    if (! enable)
+    {
+        const ScopedWriteLock wl (readerLock);
+        const ScopedLock sl (idleReadersLock);
+        sampleAccessEnabled = false;
+        idleReaders.clear();
+    }
+}
+
+void ARAAudioSourceSampleCache::didEnableAudioSourceSamplesAccess (ARAAudioSource* source, bool enable)
+{
+    jassertquiet (source == &audioSource);
+
+    if (enable)
+    {
+        const ScopedWriteLock wl (readerLock);
+        sampleAccessEnabled = true;
+    }
+}
+
+void ARAAudioSourceSampleCache::willDestroyAudioSource (ARAAudioSource* source)
+{
+    jassertquiet (source == &audioSource);
+
+    invalidate();
+
+    {
+        const ScopedWriteLock wl (readerLock);
+        sourceIsAlive = false;
+    }
+
+    audioSource.removeListener (this);
+}
+
+//==============================================================================
+struct ARAAudioSourceAnalyser::Analysis
+{
+    Analysis (std::unique_ptr<Task> t, int64 chunks)
+        : task (std::move (t)), numChunks (chunks)
+    {}
+
+    std::unique_ptr<Task> task;
+    const int64 numChunks;
+    std::atomic<int64> nextChunk { 0 }, numChunksDone { 0 };
+    std::atomic<bool> shouldStop { false };
+
+    // These are guarded by the analyser's analysisLock
+    int numJobsRunning = 0;
+    bool hasFinished = false;
+
+    CriticalSection progressLock;
+    float lastReportedProgress = 0.0f;
+};
+
+class ARAAudioSourceAnalyser::AnalysisJob  : public ThreadPoolJob
+{
+public:
+    AnalysisJob (ARAAudioSourceAnalyser& o, Analysis& a)
+        : ThreadPoolJob ("ARA audio source analysis"), owner (o), analysis (a)
+    {}
+
+    JobStatus runJob() override
+    {
+        const auto samplesPerChunk = owner.cache->getSamplesPerChunk();
+
+        while (! (shouldExit() || analysis.shouldStop))
+        {
+            const auto chunkIndex = analysis.nextChunk++;
+
+            if (chunkIndex >= analysis.numChunks)
+                break;
+
+            auto chunk = owner.cache->getChunk (chunkIndex);
+
+            if (chunk == nullptr || ! analysis.task->analyseChunk (*chunk, chunkIndex * samplesPerChunk))
+            {
+                analysis.shouldStop = true;
+                break;
+            }
+
+            owner.chunkAnalysed (analysis);
+        }
+
+        owner.jobFinished (analysis);
+        return jobHasFinished;
+    }
+
+    ARAAudioSourceAnalyser& owner;
+
+private:
+    Analysis& analysis;
+
+    JUCE_DECLARE_NON_COPYABLE (AnalysisJob)
+};
+
+//==============================================================================
+ARAAudioSourceAnalyser::ARAAudioSourceAnalyser (ARAAudioSource& source, ThreadPool& threadPool,
+                                                std::shared_ptr<ARAAudioSourceSampleCache> sampleCache)
+    : audioSource (&source),
+      pool (threadPool),
+      cache (sampleCache != nullptr ? std::move (sampleCache)
+                                    : std::make_shared<ARAAudioSourceSampleCache> (source))
+{
+    // The cache must be reading the same audio source!
+    jassert (&cache->getAudioSource() == audioSource);
+
+    audioSource->addListener (this);
+}
+
+ARAAudioSourceAnalyser::~ARAAudioSourceAnalyser()
+{
+    cancelAnalysis();
+
+    if (audioSource != nullptr)
+        audioSource->removeListener (this);
+}
+
+void ARAAudioSourceAnalyser::startAnalysis (std::unique_ptr<Task> task, int maxNumJobs)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (task != nullptr);
+
+    cancelAnalysis();
+
+    // You can't analyse an audio source that's been destroyed!
+    if (audioSource == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    const auto numChunks = cache->getNumChunks();
+    analysis = std::make_unique<Analysis> (std::move (task), numChunks);
+
+    progress = 0.0f;
+    running = true;
+    audioSource->notifyAnalysisProgressStarted();
+
+    if (numChunks == 0)
+    {
+        finishAnalysis (*analysis, false);
+        return;
+    }
+
+    const auto numJobs = (int) jmin ((int64) (maxNumJobs > 0 ? maxNumJobs : pool.getNumThreads()), numChunks);
+
+    {
+        const ScopedLock sl (analysisLock);
+        analysis->numJobsRunning = numJobs;
+    }
+
+    for (int i = 0; i < numJobs; ++i)
+        pool.addJob (new AnalysisJob (*this, *analysis), true);
+}
+
+void ARAAudioSourceAnalyser::cancelAnalysis()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (analysis == nullptr)
+        return;
+
+    analysis->shouldStop = true;
+
+    struct Selector  : public ThreadPool::JobSelector
+    {
+        explicit Selector (ARAAudioSourceAnalyser& o) : owner (o) {}
+
+        bool isJobSuitable (ThreadPoolJob* job) override
+        {
+            auto* analysisJob = dynamic_cast<AnalysisJob*> (job);
+            return analysisJob != nullptr && &analysisJob->owner == &owner;
+        }
+
+        ARAAudioSourceAnalyser& owner;
+    };
+
+    Selector selector (*this);
+    pool.removeAllJobs (true, -1, &selector);
+
+    // Any jobs that were removed before they started won't have reported back
+    finishAnalysis (*analysis, true);
+    analysis.reset();
+}
+
+void ARAAudioSourceAnalyser::chunkAnalysed (Analysis& a)
+{
+    const auto newProgress = (float) ((double) ++a.numChunksDone / (double) a.numChunks);
+    progress = newProgress;
+
+    // The host must be given its updates in ascending order, so an update is skipped
+    // if another thread has already reported a later one
+    const ScopedLock sl (a.progressLock);
+
+    if (newProgress >= a.lastReportedProgress + 0.01f || approximatelyEqual (newProgress, 1.0f))
+    {
+        a.lastReportedProgress = newProgress;
+        audioSource->notifyAnalysisProgressUpdated (newProgress);
+    }
+}
+
+void ARAAudioSourceAnalyser::jobFinished (Analysis& a)
+{
+    bool isLastJob;
+
+    {
+        const ScopedLock sl (analysisLock);
+        isLastJob = (--a.numJobsRunning == 0);
+    }
+
+    if (isLastJob)
+        finishAnalysis (a, a.numChunksDone != a.numChunks);
+}
+
+void ARAAudioSourceAnalyser::finishAnalysis (Analysis& a, bool wasCancelled)
+{
+    {
+        const ScopedLock sl (analysisLock);
+
+        if (std::exchange (a.hasFinished, true))
+            return;
+    }
+
+    a.task->analysisFinished (wasCancelled);
+    audioSource->notifyAnalysisProgressCompleted();
+    running = false;
+}
+
+void ARAAudioSourceAnalyser::willUpdateAudioSourceProperties (ARAAudioSource* source,
+                                                              ARAAudioSource::PropertiesPtr newProperties)
+{
+    jassertquiet (source == audioSource);
+
+    if (source->getSampleCount() != newProperties->sampleCount
+        || source->getSampleRate() != newProperties->sampleRate
+        || source->getChannelCount() != newProperties->channelCount)
+    {
+        cancelAnalysis();
+    }
+}
+
+void ARAAudioSourceAnalyser::doUpdateAudioSourceContent (ARAAudioSource* source, ARAContentUpdateScopes scopeFlags)
+{
+    jassertquiet (source == audioSource);
+
+    if (scopeFlags.affectSamples())
+        cancelAnalysis();
+}
+
+void ARAAudioSourceAnalyser::willEnableAudioSourceSamplesAccess (ARAAudioSource* source, bool enable)
+{
+    jassertquiet (source == audioSource);
+
+    if (! enable)
+        cancelAnalysis();
+}
+
+void ARAAudioSourceAnalyser::willDestroyAudioSource (ARAAudioSource* source)
+{
+    jassertquiet (source == audioSource);
+
+    cancelAnalysis();
+
+    audioSource->removeListener (this);
+    audioSource = nullptr;
+}
+
+} // namespace juce
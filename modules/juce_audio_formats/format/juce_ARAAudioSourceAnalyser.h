@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A cache of decoded samples from an ARAAudioSource, which can be shared between
+    any number of threads and analysis tasks.
+
+    The audio source is read in fixed-size chunks. Each chunk is read from the host
+    the first time it's needed, and is kept until the cache is full, at which point
+    the least recently used chunks are dropped. Reads for different chunks can happen
+    in parallel, because each thread borrows its own host audio reader.
+
+    The cache is emptied whenever the audio source's samples change, its sample
+    access is disabled, or it is destroyed. Chunks that were being read from the host
+    while this happened are discarded instead of being cached.
+
+    @see ARAAudioSourceAnalyser, ARAAudioSourceReader
+
+    @tags{ARA}
+*/
+class JUCE_API  ARAAudioSourceSampleCache  : private ARAAudioSource::Listener
+{
+public:
+    /** Creates a cache for an audio source. This must be called on the message thread.
+
+        @param audioSource      the source to read - this must outlive the cache, or the
+                                cache must be deleted when the source is destroyed
+        @param samplesPerChunk  the number of samples per channel in each chunk
+        @param maxNumChunks     the number of chunks to keep before dropping old ones
+    */
+    explicit ARAAudioSourceSampleCache (ARAAudioSource& audioSource,
+                                        int samplesPerChunk = 1 << 16,
+                                        int maxNumChunks = 64);
+
+    /** Destructor. This must be called on the message thread. */
+    ~ARAAudioSourceSampleCache() override;
+
+    //==============================================================================
+    /** Returns the chunk with the given index, reading it from the host if needed.
+
+        This can be called on any thread. It returns nullptr if the index is out of
+        range, or if the host couldn't provide the samples, e.g. because sample access
+        is currently disabled. The last chunk of a source may be shorter than the others.
+    */
+    std::shared_ptr<const AudioBuffer<float>> getChunk (int64 chunkIndex);
+
+    /** Copies samples from the source into a buffer, using the cached chunks.
+
+        This can be called on any thread. Any channels of the destination beyond the
+        source's channel count are left untouched. Returns false if any of the samples
+        couldn't be read, in which case those samples are cleared in all the channels.
+    */
+    bool readSamples (AudioBuffer<float>& destination, int destStartSample,
+                      int64 sourceStartSample, int numSamples);
+
+    /** Drops all the cached chunks. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the audio source that's being read. */
+    ARAAudioSource& getAudioSource() const noexcept         { return audioSource; }
+
+    /** Returns the number of samples per channel in each chunk. */
+    int getSamplesPerChunk() const noexcept                 { return samplesPerChunk; }
+
+    /** Returns the number of chunks needed to cover the whole audio source. */
+    int64 getNumChunks() const noexcept;
+
+private:
+    //==============================================================================
+    struct CachedChunk
+    {
+        int64 index;
+        std::shared_ptr<const AudioBuffer<float>> buffer;
+        uint64 lastUsed;
+    };
+
+    std::shared_ptr<const AudioBuffer<float>> readFromHost (int channelsToRead, int64 startSample, int numSamples);
+    void invalidate();
+
+    void willUpdateAudioSourceProperties (ARAAudioSource*, ARAAudioSource::PropertiesPtr) override;
+    void doUpdateAudioSourceContent (ARAAudioSource*, ARAContentUpdateScopes) override;
+    void willEnableAudioSourceSamplesAccess (ARAAudioSource*, bool enable) override;
+    void didEnableAudioSourceSamplesAccess (ARAAudioSource*, bool enable) override;
+    void willDestroyAudioSource (ARAAudioSource*) override;
+
+    //==============================================================================
+    ARAAudioSource& audioSource;
+    const int samplesPerChunk, maxNumChunks;
+
+    CriticalSection cacheLock;
+    int numChannels = 0;
+    int64 lengthInSamples = 0;
+    std::vector<CachedChunk> chunks;
+    uint64 useCounter = 0, generation = 0;
+
+    ReadWriteLock readerLock;
+    bool sampleAccessEnabled = false, sourceIsAlive = true;
+    CriticalSection idleReadersLock;
+    std::vector<std::unique_ptr<ARA::PlugIn::HostAudioReader>> idleReaders;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ARAAudioSourceSampleCache)
+};
+
+//==============================================================================
+/**
+    Runs an analysis of an ARAAudioSource on a ThreadPool, one chunk at a time.
+
+    The chunks are shared out between several jobs, so that an analysis can use all of
+    the pool's threads. The samples are read through an ARAAudioSourceSampleCache,
+    which can be shared with other analysers or readers of the same source.
+
+    The analyser reports its progress to the host through the audio source's
+    notifyAnalysisProgress methods. An analysis that's running is cancelled if the
+    audio source's samples change, its sample access is disabled, or it's destroyed.
+    It's up to the document controller to start a new analysis when that's appropriate.
+
+    @code
+    struct PeakAnalysis  : public ARAAudioSourceAnalyser::Task
+    {
+        bool analyseChunk (const AudioBuffer<float>& samples, int64) override
+        {
+            auto peak = samples.getMagnitude (0, samples.getNumSamples());
+            auto current = maxPeak.load();
+
+            while (peak > current && ! maxPeak.compare_exchange_weak (current, peak)) {}
+
+            return true;
+        }
+
+        void analysisFinished (bool wasCancelled) override  { ... }
+
+        std::atomic<float> maxPeak { 0.0f };
+    };
+
+    analyser.startAnalysis (std::make_unique<PeakAnalysis>());
+    @endcode
+
+    @tags{ARA}
+*/
+class JUCE_API  ARAAudioSourceAnalyser  : private ARAAudioSource::Listener
+{
+public:
+    //==============================================================================
+    /** An analysis algorithm that can be run by an ARAAudioSourceAnalyser. */
+    struct JUCE_API  Task
+    {
+        virtual ~Task() = default;
+
+        /** Analyses one chunk of the audio source.
+
+            This is called on the pool's threads, and may be called for several chunks
+            at the same time, in any order. Return false to abandon the analysis.
+        */
+        virtual bool analyseChunk (const AudioBuffer<float>& samples, int64 startSampleInSource) = 0;
+
+        /** Called once after the last chunk has been analysed, or after the analysis
+            was cancelled or abandoned. This is called on whichever thread ended the
+            analysis, with no chunks being analysed at the same time.
+        */
+        virtual void analysisFinished (bool wasCancelled) = 0;
+    };
+
+    //==============================================================================
+    /** Creates an analyser for an audio source. This must be called on the message thread.
+
+        @param audioSource  the source to analyse
+        @param pool         the pool to run the analysis jobs on
+        @param cache        the cache to read samples through, or nullptr to create one
+    */
+    ARAAudioSourceAnalyser (ARAAudioSource& audioSource,
+                            ThreadPool& pool,
+                            std::shared_ptr<ARAAudioSourceSampleCache> cache = nullptr);
+
+    /** Destructor. This cancels any analysis that's running, and waits for it to stop. */
+    ~ARAAudioSourceAnalyser() override;
+
+    //==============================================================================
+    /** Starts analysing the audio source, cancelling any analysis that's already running.
+
+        @param task         the algorithm to run
+        @param maxNumJobs   the number of chunks that may be analysed at the same time,
+                            or 0 to use all of the pool's threads
+    */
+    void startAnalysis (std::unique_ptr<Task> task, int maxNumJobs = 0);
+
+    /** Stops the current analysis, and waits until none of its chunks are being analysed. */
+    void cancelAnalysis();
+
+    /** Returns true if an analysis is running. */
+    bool isAnalysing() const noexcept                       { return running.load(); }
+
+    /** Returns the progress of the current analysis, from 0 to 1. */
+    float getProgress() const noexcept                      { return progress.load(); }
+
+    /** Returns the cache that the analyser reads samples from. */
+    std::shared_ptr<ARAAudioSourceSampleCache> getSampleCache() const noexcept   { return cache; }
+
+private:
+    //==============================================================================
+    class AnalysisJob;
+    struct Analysis;
+
+    void chunkAnalysed (Analysis&);
+    void jobFinished (Analysis&);
+    void finishAnalysis (Analysis&, bool wasCancelled);
+
+    void willUpdateAudioSourceProperties (ARAAudioSource*, ARAAudioSource::PropertiesPtr) override;
+    void doUpdateAudioSourceContent (ARAAudioSource*, ARAContentUpdateScopes) override;
+    void willEnableAudioSourceSamplesAccess (ARAAudioSource*, bool enable) override;
+    void willDestroyAudioSource (ARAAudioSource*) override;
+
+    //==============================================================================
+    ARAAudioSource* audioSource;
+    ThreadPool& pool;
+    std::shared_ptr<ARAAudioSourceSampleCache> cache;
+
+    std::unique_ptr<Analysis> analysis;
+    CriticalSection analysisLock;
+    std::atomic<bool> running { false };
+    std::atomic<float> progress { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ARAAudioSourceAnalyser)
+};
+
+} // namespace juce
@@ -0,0 +1,460 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class AudioFileConverter::ConversionJob  : public ThreadPoolJob
+{
+public:
+    ConversionJob (AudioFileConverter& c, const Job& j)
+        : ThreadPoolJob ("Audio file conversion"), owner (c), job (j)
+    {}
+
+    JobStatus runJob() override
+    {
+        finish (owner.convert (*this));
+        return jobHasFinished;
+    }
+
+    void finish (const Result& r)
+    {
+        {
+            const ScopedLock sl (owner.jobsLock);
+
+            if (finished)
+                return;
+
+            result = r;
+            finished = true;
+        }
+
+        // The callback has to happen before the job is counted as finished, so
+        // that it's complete by the time waitForCompletion() returns
+        if (owner.onJobFinished != nullptr)
+            owner.onJobFinished (index, r);
+
+        ++owner.numFinishedJobs;
+        owner.jobFinishedEvent.signal();
+    }
+
+    AudioFileConverter& owner;
+    const Job job;
+    int index = 0;
+    std::atomic<double> progress { 0.0 };
+    Result result { Result::fail ("The job hasn't finished yet") };
+    bool finished = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConversionJob)
+};
+
+//==============================================================================
+AudioFileConverter::AudioFileConverter (AudioFormatManager& manager, const Options& o)
+    : formatManager (manager),
+      options (o),
+      pool (jmax (1, o.numThreads))
+{
+    jassert (options.blockSize > 0);
+
+    for (int i = 0; i < jmax (1, options.numWriterThreads); ++i)
+        writerThreads.add (new TimeSliceThread ("Audio file writer " + String (i + 1)))->startThread();
+}
+
+AudioFileConverter::AudioFileConverter (AudioFormatManager& manager)
+    : AudioFileConverter (manager, Options())
+{
+}
+
+AudioFileConverter::~AudioFileConverter()
+{
+    cancelAllJobs();
+}
+
+//==============================================================================
+int AudioFileConverter::addJob (const Job& job)
+{
+    auto* conversion = new ConversionJob (*this, job);
+
+    {
+        const ScopedLock sl (jobsLock);
+        conversion->index = jobs.size();
+        jobs.add (conversion);
+    }
+
+    pool.addJob (conversion, false);
+    return conversion->index;
+}
+
+int AudioFileConverter::getNumJobs() const
+{
+    const ScopedLock sl (jobsLock);
+    return jobs.size();
+}
+
+double AudioFileConverter::getProgress() const
+{
+    const ScopedLock sl (jobsLock);
+
+    if (jobs.isEmpty())
+        return 1.0;
+
+    double total = 0.0;
+
+    for (auto* conversion : jobs)
+        total += conversion->progress.load();
+
+    return total / jobs.size();
+}
+
+double AudioFileConverter::getProgress (int jobIndex) const
+{
+    const ScopedLock sl (jobsLock);
+
+    if (auto* conversion = jobs[jobIndex])
+        return conversion->progress.load();
+
+    jassertfalse;
+    return 0.0;
+}
+
+Result AudioFileConverter::getResult (int jobIndex) const
+{
+    const ScopedLock sl (jobsLock);
+
+    if (auto* conversion = jobs[jobIndex])
+        return conversion->result;
+
+    jassertfalse;
+    return Result::fail ("There's no job with this index");
+}
+
+bool AudioFileConverter::waitForCompletion (int timeoutMilliseconds)
+{
+    const auto startTime = Time::getMillisecondCounter();
+
+    while (getNumFinishedJobs() < getNumJobs())
+    {
+        auto timeToWait = -1;
+
+        if (timeoutMilliseconds >= 0)
+        {
+            const auto elapsed = (int) (Time::getMillisecondCounter() - startTime);
+
+            if (elapsed >= timeoutMilliseconds)
+                return false;
+
+            timeToWait = timeoutMilliseconds - elapsed;
+        }
+
+        jobFinishedEvent.wait (timeToWait);
+    }
+
+    return true;
+}
+
+void AudioFileConverter::cancelAllJobs()
+{
+    pool.removeAllJobs (true, -1);
+
+    Array<ConversionJob*> unfinished;
+
+    {
+        const ScopedLock sl (jobsLock);
+
+        for (auto* conversion : jobs)
+            if (! conversion->finished)
+                unfinished.add (conversion);
+    }
+
+    // Jobs that never got the chance to start won't have reported a result
+    for (auto* conversion : unfinished)
+        conversion->finish (Result::fail ("The conversion was cancelled"));
+}
+
+//==============================================================================
+TimeSliceThread& AudioFileConverter::getNextWriterThread()
+{
+    return *writerThreads.getUnchecked (nextWriterThread++ % writerThreads.size());
+}
+
+Result AudioFileConverter::convert (ConversionJob& conversion)
+{
+    const auto& job = conversion.job;
+    const auto cancelled = Result::fail ("The conversion was cancelled");
+
+    std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (job.sourceFile));
+
+    if (reader == nullptr)
+        return Result::fail ("Couldn't open " + job.sourceFile.getFullPathName());
+
+    auto* format = job.destinationFormat != nullptr ? job.destinationFormat
+                                                    : formatManager.findFormatForFileExtension (job.destinationFile.getFileExtension());
+
+    if (format == nullptr)
+        return Result::fail ("No format was found for " + job.destinationFile.getFullPathName());
+
+    const auto numChannels = (int) reader->numChannels;
+    const auto sourceRate = reader->sampleRate;
+    const auto destRate = job.sampleRate > 0.0 ? job.sampleRate : sourceRate;
+
+    if (numChannels <= 0 || sourceRate <= 0.0)
+        return Result::fail ("The source file " + job.sourceFile.getFullPathName() + " has no audio");
+
+    TemporaryFile temp (job.destinationFile);
+    std::unique_ptr<OutputStream> stream (temp.getFile().createOutputStream());
+
+    if (stream == nullptr)
+        return Result::fail ("Couldn't write to " + job.destinationFile.getFullPathName());
+
+    std::unique_ptr<AudioFormatWriter> writer (format->createWriterFor (stream.get(), destRate, (unsigned int) numChannels,
+                                                                        job.bitsPerSample > 0 ? job.bitsPerSample : (int) reader->bitsPerSample,
+                                                                        job.metadata.size() > 0 ? job.metadata : reader->metadataValues,
+                                                                        job.qualityOptionIndex));
+
+    if (writer == nullptr)
+        return Result::fail ("The " + format->getFormatName() + " format can't write " + job.destinationFile.getFullPathName()
+                               + " with these settings");
+
+    stream.release();
+
+    // Split the memory budget between all the files that can be converted at once
+    const auto blockSize = options.blockSize;
+    const auto bytesPerFrame = sizeof (float) * (size_t) numChannels;
+    const auto budgetPerJob = options.memoryBudget / (size_t) jmax (1, options.numThreads);
+    const auto fifoSize = jmax (2 * blockSize + 1, (int) jmin (budgetPerJob / bytesPerFrame, (size_t) std::numeric_limits<int>::max()));
+
+    auto threadedWriter = std::make_unique<AudioFormatWriter::ThreadedWriter> (writer.release(), getNextWriterThread(), fifoSize);
+
+    const auto ratio = sourceRate / destRate;
+    const auto needsResampling = ! approximatelyEqual (ratio, 1.0);
+    const auto totalOutputSamples = needsResampling ? (int64) std::llround ((double) reader->lengthInSamples / ratio)
+                                                    : reader->lengthInSamples;
+
+    AudioBuffer<float> input (numChannels, blockSize), resampled;
+    PolyphaseResampler resampler;
+    int64 samplesToSkip = 0;
+
+    if (needsResampling)
+    {
+        resampler.prepare (numChannels, options.resamplingQuality, jmax (1.0, ratio));
+        resampled.setSize (numChannels, blockSize);
+
+        // Drop the resampler's latency from the start of the output, and feed it
+        // silence past the end of the source to flush out the tail
+        samplesToSkip = roundToInt (resampler.getLatencyInInputSamples (ratio) / ratio);
+    }
+
+    HeapBlock<const float*> channels ((size_t) numChannels);
+    int64 readPosition = 0;
+
+    for (int64 numWritten = 0; numWritten < totalOutputSamples;)
+    {
+        if (conversion.shouldExit())
+            return cancelled;
+
+        const AudioBuffer<float>* block = &input;
+        auto startInBlock = 0, numInBlock = blockSize;
+
+        if (needsResampling)
+        {
+            const auto numInputSamples = resampler.getNumInputSamplesNeeded (ratio, blockSize);
+            input.setSize (numChannels, numInputSamples, false, false, true);
+            reader->read (input.getArrayOfWritePointers(), numChannels, readPosition, numInputSamples);
+
+            readPosition += resampler.process (ratio, input.getArrayOfReadPointers(),
+                                               resampled.getArrayOfWritePointers(), blockSize);
+
+            startInBlock = (int) jmin ((int64) blockSize, samplesToSkip);
+            samplesToSkip -= startInBlock;
+            numInBlock -= startInBlock;
+            block = &resampled;
+        }
+        else
+        {
+            reader->read (input.getArrayOfWritePointers(), numChannels, readPosition, blockSize);
+            readPosition += blockSize;
+        }
+
+        numInBlock = (int) jmin ((int64) numInBlock, totalOutputSamples - numWritten);
+
+        if (numInBlock <= 0)
+            continue;
+
+        for (int i = 0; i < numChannels; ++i)
+            channels[i] = block->getReadPointer (i, startInBlock);
+
+        while (! threadedWriter->write (channels, numInBlock))
+        {
+            if (conversion.shouldExit())
+                return cancelled;
+
+            Thread::sleep (1);
+        }
+
+        numWritten += numInBlock;
+        conversion.progress = (double) numWritten / (double) totalOutputSamples;
+    }
+
+    // Deleting the ThreadedWriter flushes everything that's still queued
+    threadedWriter.reset();
+    conversion.progress = 1.0;
+
+    if (! temp.overwriteTargetFileWithTemporary())
+        return Result::fail ("Couldn't replace " + job.destinationFile.getFullPathName());
+
+    return Result::ok();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioFileConverterTests  : public UnitTest
+{
+public:
+    AudioFileConverterTests()
+        : UnitTest ("AudioFileConverter", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        const auto folder = File::getSpecialLocation (File::tempDirectory)
+                                .getChildFile ("AudioFileConverterTests_" + String::toHexString (Random::getSystemRandom().nextInt()));
+        folder.createDirectory();
+
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        constexpr int numChannels = 2, numSamples = 30000;
+        constexpr double sourceRate = 44100.0;
+
+        auto source = folder.getChildFile ("source.wav");
+        writeSine (source, numChannels, numSamples, sourceRate);
+
+        beginTest ("Converting at the same sample rate preserves the audio");
+        {
+            AudioFileConverter::Options options;
+            options.numThreads = 3;
+            options.blockSize = 1000;
+            options.memoryBudget = 64 * 1024;
+
+            AudioFileConverter converter (formatManager, options);
+
+            for (int i = 0; i < 6; ++i)
+                converter.addJob ({ source, folder.getChildFile ("copy" + String (i) + ".wav"), nullptr, 0.0, 32, 0, {} });
+
+            expect (converter.waitForCompletion (20000));
+            expectEquals (converter.getNumFinishedJobs(), 6);
+            expectWithinAbsoluteError (converter.getProgress(), 1.0, 1.0e-9);
+
+            const auto expected = readFile (formatManager, source);
+
+            for (int i = 0; i < 6; ++i)
+            {
+                expect (converter.getResult (i).wasOk());
+
+                const auto actual = readFile (formatManager, folder.getChildFile ("copy" + String (i) + ".wav"));
+                expectEquals (actual.getNumChannels(), numChannels);
+                expectEquals (actual.getNumSamples(), numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    for (int s = 0; s < numSamples; s += 7)
+                        expectEquals (actual.getSample (ch, s), expected.getSample (ch, s));
+            }
+        }
+
+        beginTest ("Resampling produces the right length and level");
+        {
+            AudioFileConverter converter (formatManager);
+
+            auto destination = folder.getChildFile ("resampled.wav");
+            converter.addJob ({ source, destination, nullptr, 48000.0, 24, 0, {} });
+
+            expect (converter.waitForCompletion (20000));
+            expect (converter.getResult (0).wasOk());
+
+            const auto actual = readFile (formatManager, destination);
+            expectEquals (actual.getNumSamples(), (int) std::llround (numSamples * 48000.0 / sourceRate));
+
+            // Ignore the edges, where the filter sees the silence around the file
+            const auto rms = actual.getRMSLevel (0, 1000, actual.getNumSamples() - 2000);
+            expectWithinAbsoluteError (rms, 0.5f * MathConstants<float>::sqrt2 * 0.5f, 1.0e-3f);
+        }
+
+        beginTest ("Failures are reported per job");
+        {
+            AudioFileConverter converter (formatManager);
+            std::atomic<int> numCallbacks { 0 };
+            converter.onJobFinished = [&] (int, const Result&) { ++numCallbacks; };
+
+            converter.addJob ({ folder.getChildFile ("missing.wav"), folder.getChildFile ("out1.wav"), nullptr, 0.0, 0, 0, {} });
+            converter.addJob ({ source, folder.getChildFile ("out2.unknown"), nullptr, 0.0, 0, 0, {} });
+            converter.addJob ({ source, folder.getChildFile ("out3.wav"), nullptr, 0.0, 0, 0, {} });
+
+            expect (converter.waitForCompletion (20000));
+            expect (converter.getResult (0).failed());
+            expect (converter.getResult (1).failed());
+            expect (converter.getResult (2).wasOk());
+            expectEquals (numCallbacks.load(), 3);
+            expect (! folder.getChildFile ("out1.wav").exists());
+        }
+
+        folder.deleteRecursively();
+    }
+
+private:
+    static void writeSine (const File& file, int numChannels, int numSamples, double sampleRate)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, 0.5f * (float) std::sin (MathConstants<double>::twoPi * 440.0 * (ch + 1) * i / sampleRate));
+
+        WavAudioFormat format;
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (file.createOutputStream().release(),
+                                                                           sampleRate, (unsigned int) numChannels, 32, {}, 0));
+        writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+    }
+
+    static AudioBuffer<float> readFile (AudioFormatManager& formatManager, const File& file)
+    {
+        std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+        if (reader == nullptr)
+            return {};
+
+        AudioBuffer<float> buffer ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+};
+
+static AudioFileConverterTests audioFileConverterTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Converts batches of audio files between formats and sample rates using a
+    pool of background threads.
+
+    Each job decodes its source file with a reader from the AudioFormatManager,
+    optionally resamples it with a PolyphaseResampler, and hands the result to
+    an AudioFormatWriter::ThreadedWriter, which encodes and writes it on one of
+    the converter's writer threads. Decoding and encoding therefore overlap, both
+    within a single file and across the several files being converted at once.
+
+    The FIFO of each ThreadedWriter is sized so that all the files being converted
+    at once stay within the memory budget given in the Options. When a writer
+    can't keep up, its decoder waits for it rather than buffering more audio.
+
+    The output is written to a temporary file next to the destination, which
+    only replaces the destination once the whole file has been written.
+
+    The AudioFormatManager must outlive the converter, and its formats must not
+    be changed while there are jobs running.
+
+    @see AudioFormatManager, AudioFormatWriter::ThreadedWriter, PolyphaseResampler
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioFileConverter
+{
+public:
+    //==============================================================================
+    /** The settings used to create an AudioFileConverter. */
+    struct Options
+    {
+        /** The number of files that can be decoded at the same time. */
+        int numThreads = 4;
+
+        /** The number of threads that run the encoders and write to disk. */
+        int numWriterThreads = 2;
+
+        /** The approximate amount of memory, in bytes, that can be used by the
+            queues of decoded audio waiting to be encoded.
+        */
+        size_t memoryBudget = 64 * 1024 * 1024;
+
+        /** The number of sample frames decoded from a source file at a time. */
+        int blockSize = 8192;
+
+        /** The quality used when a job needs resampling. */
+        PolyphaseResampler::Quality resamplingQuality = PolyphaseResampler::Quality::high;
+    };
+
+    /** Describes a file to convert. */
+    struct Job
+    {
+        /** The file to read. Its format is detected by the AudioFormatManager. */
+        File sourceFile;
+
+        /** The file to create. Any existing file will be replaced once the
+            conversion has succeeded.
+        */
+        File destinationFile;
+
+        /** The format to write. If this is null, the format is chosen from the
+            destination file's extension.
+        */
+        AudioFormat* destinationFormat = nullptr;
+
+        /** The sample rate to write, or 0 to keep the source's sample rate. */
+        double sampleRate = 0.0;
+
+        /** The bit depth to write, or 0 to keep the source's bit depth. */
+        int bitsPerSample = 0;
+
+        /** The quality option index to pass to AudioFormat::createWriterFor(). */
+        int qualityOptionIndex = 0;
+
+        /** The metadata to write. If this is empty, the source's metadata is used. */
+        StringPairArray metadata;
+    };
+
+    //==============================================================================
+    /** Creates a converter that reads files using the given format manager. */
+    AudioFileConverter (AudioFormatManager& formatManager, const Options& options);
+
+    /** Creates a converter using the default options. */
+    explicit AudioFileConverter (AudioFormatManager& formatManager);
+
+    /** Destructor.
+        This cancels any jobs that haven't finished yet.
+    */
+    ~AudioFileConverter();
+
+    //==============================================================================
+    /** Adds a job to the queue and returns its index.
+
+        The job will start as soon as one of the threads is free.
+    */
+    int addJob (const Job& job);
+
+    /** Returns the number of jobs that have been added. */
+    int getNumJobs() const;
+
+    /** Returns the number of jobs that have finished, whether they succeeded or not. */
+    int getNumFinishedJobs() const noexcept                 { return numFinishedJobs.load(); }
+
+    /** Returns the overall progress of all the jobs that have been added, from 0 to 1. */
+    double getProgress() const;
+
+    /** Returns the progress of one job, from 0 to 1. */
+    double getProgress (int jobIndex) const;
+
+    /** Returns the result of a finished job.
+
+        If the job hasn't finished yet, this returns a failed result.
+    */
+    Result getResult (int jobIndex) const;
+
+    /** Waits until all the jobs that have been added have finished.
+
+        @param timeoutMilliseconds      the maximum time to wait, or -1 to wait forever
+        @returns true if all the jobs finished in time
+    */
+    bool waitForCompletion (int timeoutMilliseconds = -1);
+
+    /** Stops all the jobs that haven't finished.
+
+        Jobs that get cancelled finish with a failed result, and their destination
+        files are left untouched.
+    */
+    void cancelAllJobs();
+
+    /** Called on a background thread each time a job finishes.
+
+        All the callbacks for the jobs that have been added will have returned by
+        the time waitForCompletion() returns true.
+    */
+    std::function<void (int jobIndex, const Result& result)> onJobFinished;
+
+private:
+    //==============================================================================
+    class ConversionJob;
+
+    Result convert (ConversionJob&);
+    TimeSliceThread& getNextWriterThread();
+
+    AudioFormatManager& formatManager;
+    Options options;
+
+    OwnedArray<TimeSliceThread> writerThreads;
+    ThreadPool pool;
+
+    mutable CriticalSection jobsLock;
+    OwnedArray<ConversionJob> jobs;
+    std::atomic<int> numFinishedJobs { 0 }, nextWriterThread { 0 };
+    WaitableEvent jobFinishedEvent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFileConverter)
+};
+
+} // namespace juce
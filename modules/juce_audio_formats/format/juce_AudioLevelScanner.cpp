@@ -0,0 +1,747 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace LevelScanHelpers
+{
+    //==============================================================================
+    // Each sample format is scanned as a raw value which sorts in the same order as
+    // the audio it represents, and is only normalised once the extremes are known.
+    struct UInt8Format
+    {
+        using Value = int;
+        static constexpr int bytesPerSample = 1;
+        static constexpr Value lowest = 0, highest = 255;
+
+        template <bool littleEndian>
+        static Value read (const char* p) noexcept      { return *reinterpret_cast<const uint8*> (p); }
+
+        static float toFloat (Value v) noexcept         { return (float) ((v - 128) * (1.0 / 128.0)); }
+    };
+
+    struct Int16Format
+    {
+        using Value = int;
+        static constexpr int bytesPerSample = 2;
+        static constexpr Value lowest = -32768, highest = 32767;
+
+        template <bool littleEndian>
+        static Value read (const char* p) noexcept      { return (int16) (littleEndian ? ByteOrder::littleEndianShort (p) : ByteOrder::bigEndianShort (p)); }
+
+        static float toFloat (Value v) noexcept         { return (float) ((1.0 / 32768.0) * v); }
+    };
+
+    struct Int24Format
+    {
+        using Value = int;
+        static constexpr int bytesPerSample = 3;
+        static constexpr Value lowest = -8388608, highest = 8388607;
+
+        template <bool littleEndian>
+        static Value read (const char* p) noexcept      { return littleEndian ? ByteOrder::littleEndian24Bit (p) : ByteOrder::bigEndian24Bit (p); }
+
+        static float toFloat (Value v) noexcept         { return (float) ((1.0 / 8388608.0) * v); }
+    };
+
+    struct Int32Format
+    {
+        using Value = int;
+        static constexpr int bytesPerSample = 4;
+        static constexpr Value lowest = std::numeric_limits<int>::min(), highest = std::numeric_limits<int>::max();
+
+        template <bool littleEndian>
+        static Value read (const char* p) noexcept      { return (int32) (littleEndian ? ByteOrder::littleEndianInt (p) : ByteOrder::bigEndianInt (p)); }
+
+        static float toFloat (Value v) noexcept         { return (float) ((1.0 / 2147483648.0) * v); }
+    };
+
+    struct Float32Format
+    {
+        using Value = float;
+        static constexpr int bytesPerSample = 4;
+        static constexpr Value lowest = std::numeric_limits<float>::lowest(), highest = std::numeric_limits<float>::max();
+
+        template <bool littleEndian>
+        static Value read (const char* p) noexcept
+        {
+            const auto bits = littleEndian ? ByteOrder::littleEndianInt (p) : ByteOrder::bigEndianInt (p);
+            float result;
+            memcpy (&result, &bits, sizeof (result));
+            return result;
+        }
+
+        static float toFloat (Value v) noexcept         { return v; }
+    };
+
+    //==============================================================================
+    // The vector operations for each format. A format without a specialisation is
+    // scanned with scalar code.
+    template <typename Format, bool littleEndian>
+    struct VectorOps
+    {
+        static constexpr bool isAvailable = false;
+    };
+
+   #if JUCE_LITTLE_ENDIAN && (JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON)
+    template <typename Format, typename LaneType, int lanes>
+    struct VectorOpsBase
+    {
+        static constexpr bool isAvailable = true;
+        static constexpr int numLanes = lanes;
+        using Lane = LaneType;
+        using Value = typename Format::Value;
+    };
+   #endif
+
+   #if JUCE_LITTLE_ENDIAN && JUCE_USE_SSE_INTRINSICS
+    static inline __m128i swapBytesIn16 (__m128i v) noexcept    { return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8)); }
+    static inline __m128i swapBytesIn32 (__m128i v) noexcept    { return swapBytesIn16 (_mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, 0xb1), 0xb1)); }
+    static inline __m128i loadInts (const char* p) noexcept     { return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p)); }
+
+    template <bool littleEndian>
+    struct VectorOps<UInt8Format, littleEndian>  : public VectorOpsBase<UInt8Format, uint8, 16>
+    {
+        using Vector = __m128i;
+
+        static Vector load (const char* p) noexcept                 { return loadInts (p); }
+        static Vector broadcast (Value v) noexcept                  { return _mm_set1_epi8 ((char) v); }
+        static Vector min (Vector a, Vector b) noexcept             { return _mm_min_epu8 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return _mm_max_epu8 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Int16Format, littleEndian>  : public VectorOpsBase<Int16Format, int16, 8>
+    {
+        using Vector = __m128i;
+
+        static Vector load (const char* p) noexcept                 { return littleEndian ? loadInts (p) : swapBytesIn16 (loadInts (p)); }
+        static Vector broadcast (Value v) noexcept                  { return _mm_set1_epi16 ((short) v); }
+        static Vector min (Vector a, Vector b) noexcept             { return _mm_min_epi16 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return _mm_max_epi16 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Int32Format, littleEndian>  : public VectorOpsBase<Int32Format, int32, 4>
+    {
+        using Vector = __m128i;
+
+        static Vector load (const char* p) noexcept                 { return littleEndian ? loadInts (p) : swapBytesIn32 (loadInts (p)); }
+        static Vector broadcast (Value v) noexcept                  { return _mm_set1_epi32 (v); }
+        // SSE2 has no 32-bit integer min or max, so these use a comparison mask instead
+        static Vector select (Vector mask, Vector a, Vector b) noexcept { return _mm_or_si128 (_mm_and_si128 (mask, a), _mm_andnot_si128 (mask, b)); }
+        static Vector min (Vector a, Vector b) noexcept             { return select (_mm_cmpgt_epi32 (a, b), b, a); }
+        static Vector max (Vector a, Vector b) noexcept             { return select (_mm_cmpgt_epi32 (a, b), a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Float32Format, littleEndian>  : public VectorOpsBase<Float32Format, float, 4>
+    {
+        using Vector = __m128;
+
+        static Vector load (const char* p) noexcept                 { return littleEndian ? _mm_loadu_ps (reinterpret_cast<const float*> (p)) : _mm_castsi128_ps (swapBytesIn32 (loadInts (p))); }
+        static Vector broadcast (Value v) noexcept                  { return _mm_set1_ps (v); }
+        static Vector min (Vector a, Vector b) noexcept             { return _mm_min_ps (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return _mm_max_ps (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { _mm_storeu_ps (dest, v); }
+    };
+
+   #elif JUCE_LITTLE_ENDIAN && JUCE_USE_ARM_NEON
+    static inline uint8x16_t loadBytes (const char* p) noexcept     { return vld1q_u8 (reinterpret_cast<const uint8*> (p)); }
+
+    template <bool littleEndian>
+    struct VectorOps<UInt8Format, littleEndian>  : public VectorOpsBase<UInt8Format, uint8, 16>
+    {
+        using Vector = uint8x16_t;
+
+        static Vector load (const char* p) noexcept                 { return loadBytes (p); }
+        static Vector broadcast (Value v) noexcept                  { return vdupq_n_u8 ((uint8) v); }
+        static Vector min (Vector a, Vector b) noexcept             { return vminq_u8 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return vmaxq_u8 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { vst1q_u8 (dest, v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Int16Format, littleEndian>  : public VectorOpsBase<Int16Format, int16, 8>
+    {
+        using Vector = int16x8_t;
+
+        static Vector load (const char* p) noexcept                 { return vreinterpretq_s16_u8 (littleEndian ? loadBytes (p) : vrev16q_u8 (loadBytes (p))); }
+        static Vector broadcast (Value v) noexcept                  { return vdupq_n_s16 ((int16) v); }
+        static Vector min (Vector a, Vector b) noexcept             { return vminq_s16 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return vmaxq_s16 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { vst1q_s16 (dest, v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Int32Format, littleEndian>  : public VectorOpsBase<Int32Format, int32, 4>
+    {
+        using Vector = int32x4_t;
+
+        static Vector load (const char* p) noexcept                 { return vreinterpretq_s32_u8 (littleEndian ? loadBytes (p) : vrev32q_u8 (loadBytes (p))); }
+        static Vector broadcast (Value v) noexcept                  { return vdupq_n_s32 (v); }
+        static Vector min (Vector a, Vector b) noexcept             { return vminq_s32 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return vmaxq_s32 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { vst1q_s32 (dest, v); }
+    };
+
+    template <bool littleEndian>
+    struct VectorOps<Float32Format, littleEndian>  : public VectorOpsBase<Float32Format, float, 4>
+    {
+        using Vector = float32x4_t;
+
+        static Vector load (const char* p) noexcept                 { return vreinterpretq_f32_u8 (littleEndian ? loadBytes (p) : vrev32q_u8 (loadBytes (p))); }
+        static Vector broadcast (Value v) noexcept                  { return vdupq_n_f32 (v); }
+        static Vector min (Vector a, Vector b) noexcept             { return vminq_f32 (a, b); }
+        static Vector max (Vector a, Vector b) noexcept             { return vmaxq_f32 (a, b); }
+        static void store (Lane* dest, Vector v) noexcept           { vst1q_f32 (dest, v); }
+    };
+   #endif
+
+    //==============================================================================
+    template <typename Format, bool littleEndian>
+    static void scanScalar (const char* src, int numChannels, int numChannelsToScan, int64 numFrames,
+                            typename Format::Value* mins, typename Format::Value* maxs) noexcept
+    {
+        const auto bytesPerFrame = Format::bytesPerSample * numChannels;
+
+        for (int ch = 0; ch < numChannelsToScan; ++ch)
+        {
+            auto low = mins[ch], high = maxs[ch];
+            const auto* p = src + ch * Format::bytesPerSample;
+
+            for (int64 i = 0; i < numFrames; ++i, p += bytesPerFrame)
+            {
+                const auto v = Format::template read<littleEndian> (p);
+                low = jmin (low, v);
+                high = jmax (high, v);
+            }
+
+            mins[ch] = low;
+            maxs[ch] = high;
+        }
+    }
+
+    // Vectors of interleaved data are loaded straight from memory. When the number of
+    // channels divides the vector size, every lane always holds the same channel, so one
+    // pair of accumulators is enough. Otherwise, the pattern of channels in the lanes
+    // repeats every numChannels vectors, so there's a pair of accumulators for each one.
+    // Returns the number of frames that were scanned.
+    static constexpr int maxChannelsForVectorScan = 16;
+
+    template <typename Format, bool littleEndian>
+    static int64 scanVectorised (const char* src, int numChannels, int64 numFrames,
+                                 typename Format::Value* mins, typename Format::Value* maxs) noexcept
+    {
+        using Ops = VectorOps<Format, littleEndian>;
+        using Vector = typename Ops::Vector;
+        constexpr int lanes = Ops::numLanes;
+        constexpr int bytesPerVector = lanes * Format::bytesPerSample;
+
+        typename Ops::Lane lowLanes[lanes], highLanes[lanes];
+
+        if (lanes % numChannels == 0)
+        {
+            const auto framesPerVector = lanes / numChannels;
+            const auto numVectors = numFrames / framesPerVector;
+
+            if (numVectors == 0)
+                return 0;
+
+            auto low0 = Ops::broadcast (Format::highest), high0 = Ops::broadcast (Format::lowest);
+            auto low1 = low0, high1 = high0;
+            int64 i = 0;
+
+            for (; i + 1 < numVectors; i += 2)
+            {
+                const auto v0 = Ops::load (src + i * bytesPerVector);
+                const auto v1 = Ops::load (src + (i + 1) * bytesPerVector);
+                low0 = Ops::min (low0, v0);  high0 = Ops::max (high0, v0);
+                low1 = Ops::min (low1, v1);  high1 = Ops::max (high1, v1);
+            }
+
+            if (i < numVectors)
+            {
+                const auto v = Ops::load (src + i * bytesPerVector);
+                low0 = Ops::min (low0, v);
+                high0 = Ops::max (high0, v);
+            }
+
+            Ops::store (lowLanes,  Ops::min (low0, low1));
+            Ops::store (highLanes, Ops::max (high0, high1));
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const auto ch = lane % numChannels;
+                mins[ch] = jmin (mins[ch], (typename Format::Value) lowLanes[lane]);
+                maxs[ch] = jmax (maxs[ch], (typename Format::Value) highLanes[lane]);
+            }
+
+            return numVectors * framesPerVector;
+        }
+
+        if (numChannels > maxChannelsForVectorScan)
+            return 0;
+
+        const auto numGroups = numFrames / lanes;
+
+        if (numGroups == 0)
+            return 0;
+
+        Vector low[maxChannelsForVectorScan], high[maxChannelsForVectorScan];
+
+        for (int j = 0; j < numChannels; ++j)
+        {
+            low[j]  = Ops::broadcast (Format::highest);
+            high[j] = Ops::broadcast (Format::lowest);
+        }
+
+        for (int64 g = 0; g < numGroups; ++g)
+        {
+            const auto* group = src + g * numChannels * bytesPerVector;
+
+            for (int j = 0; j < numChannels; ++j)
+            {
+                const auto v = Ops::load (group + j * bytesPerVector);
+                low[j] = Ops::min (low[j], v);
+                high[j] = Ops::max (high[j], v);
+            }
+        }
+
+        for (int j = 0; j < numChannels; ++j)
+        {
+            Ops::store (lowLanes, low[j]);
+            Ops::store (highLanes, high[j]);
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const auto ch = (j * lanes + lane) % numChannels;
+                mins[ch] = jmin (mins[ch], (typename Format::Value) lowLanes[lane]);
+                maxs[ch] = jmax (maxs[ch], (typename Format::Value) highLanes[lane]);
+            }
+        }
+
+        return numGroups * lanes;
+    }
+
+    template <typename Format, bool littleEndian>
+    static void scanSection (const char* src, int numChannels, int numChannelsToScan, int64 numFrames,
+                             typename Format::Value* mins, typename Format::Value* maxs) noexcept
+    {
+        int64 numDone = 0;
+
+        if constexpr (VectorOps<Format, littleEndian>::isAvailable)
+            numDone = scanVectorised<Format, littleEndian> (src, numChannels, numFrames, mins, maxs);
+
+        scanScalar<Format, littleEndian> (src + numDone * Format::bytesPerSample * numChannels,
+                                          numChannels, numChannelsToScan, numFrames - numDone, mins, maxs);
+    }
+
+    //==============================================================================
+    // Sections smaller than this aren't worth handing to another thread
+    static constexpr int64 minBytesPerTask = 1 << 20;
+
+    template <typename Format, bool littleEndian>
+    static void findMinAndMax (const char* src, int numChannels, int64 numFrames,
+                               Range<float>* results, int numChannelsToScan,
+                               WorkStealingThreadPool* pool)
+    {
+        using Value = typename Format::Value;
+
+        const auto bytesPerFrame = (int64) Format::bytesPerSample * numChannels;
+        const auto numTasks = pool != nullptr ? (int) jmin ((int64) pool->getNumThreads() * 4,
+                                                            numFrames * bytesPerFrame / minBytesPerTask)
+                                              : 1;
+
+        // Thumbnails scan lots of tiny sections, so the single-threaded case avoids the heap
+        Value localMins[maxChannelsForVectorScan], localMaxs[maxChannelsForVectorScan];
+        std::vector<Value> mins, maxs;
+        Value* lowest = localMins;
+        Value* highest = localMaxs;
+
+        if (numTasks > 1 || numChannels > maxChannelsForVectorScan)
+        {
+            mins.resize ((size_t) (jmax (1, numTasks) * numChannels));
+            maxs.resize (mins.size());
+            lowest = mins.data();
+            highest = maxs.data();
+        }
+
+        std::fill (lowest,  lowest  + jmax (1, numTasks) * numChannels, Format::highest);
+        std::fill (highest, highest + jmax (1, numTasks) * numChannels, Format::lowest);
+
+        if (numTasks > 1)
+        {
+            const auto framesPerTask = (numFrames + numTasks - 1) / numTasks;
+
+            pool->parallelFor (0, numTasks, [&] (int task)
+            {
+                const auto start = framesPerTask * task;
+                const auto offset = task * numChannels;
+
+                scanSection<Format, littleEndian> (src + start * bytesPerFrame, numChannels, numChannelsToScan,
+                                                   jmin (framesPerTask, numFrames - start),
+                                                   lowest + offset, highest + offset);
+            }, 1);
+
+            for (int task = 1; task < numTasks; ++task)
+            {
+                for (int ch = 0; ch < numChannelsToScan; ++ch)
+                {
+                    lowest[ch]  = jmin (lowest[ch],  lowest[task * numChannels + ch]);
+                    highest[ch] = jmax (highest[ch], highest[task * numChannels + ch]);
+                }
+            }
+        }
+        else
+        {
+            scanSection<Format, littleEndian> (src, numChannels, numChannelsToScan, numFrames, lowest, highest);
+        }
+
+        for (int ch = 0; ch < numChannelsToScan; ++ch)
+            results[ch] = Range<float> (Format::toFloat (lowest[ch]), Format::toFloat (highest[ch]));
+    }
+
+    template <typename Format>
+    static void findMinAndMax (const AudioLevelScanner::InterleavedData& source, int64 numFrames,
+                               Range<float>* results, int numChannelsToScan, WorkStealingThreadPool* pool)
+    {
+        const auto* src = static_cast<const char*> (source.data);
+
+        if (source.isLittleEndian)
+            findMinAndMax<Format, true>  (src, source.numChannels, numFrames, results, numChannelsToScan, pool);
+        else
+            findMinAndMax<Format, false> (src, source.numChannels, numFrames, results, numChannelsToScan, pool);
+    }
+}
+
+//==============================================================================
+int AudioLevelScanner::InterleavedData::getBytesPerSample() const noexcept
+{
+    switch (format)
+    {
+        case SampleFormat::unsigned8Bit:    return 1;
+        case SampleFormat::signed16Bit:     return 2;
+        case SampleFormat::signed24Bit:     return 3;
+        case SampleFormat::signed32Bit:
+        case SampleFormat::float32Bit:      return 4;
+        default:                            break;
+    }
+
+    jassertfalse;
+    return 0;
+}
+
+void AudioLevelScanner::findMinAndMax (const InterleavedData& source, int64 numFrames,
+                                       Range<float>* results, int numChannelsToScan,
+                                       WorkStealingThreadPool* pool)
+{
+    jassert (numChannelsToScan > 0 && numChannelsToScan <= source.numChannels);
+
+    if (numFrames <= 0 || source.data == nullptr)
+    {
+        for (int i = 0; i < numChannelsToScan; ++i)
+            results[i] = Range<float>();
+
+        return;
+    }
+
+    using namespace LevelScanHelpers;
+
+    switch (source.format)
+    {
+        case SampleFormat::unsigned8Bit:    LevelScanHelpers::findMinAndMax<UInt8Format>   (source, numFrames, results, numChannelsToScan, pool); break;
+        case SampleFormat::signed16Bit:     LevelScanHelpers::findMinAndMax<Int16Format>   (source, numFrames, results, numChannelsToScan, pool); break;
+        case SampleFormat::signed24Bit:     LevelScanHelpers::findMinAndMax<Int24Format>   (source, numFrames, results, numChannelsToScan, pool); break;
+        case SampleFormat::signed32Bit:     LevelScanHelpers::findMinAndMax<Int32Format>   (source, numFrames, results, numChannelsToScan, pool); break;
+        case SampleFormat::float32Bit:      LevelScanHelpers::findMinAndMax<Float32Format> (source, numFrames, results, numChannelsToScan, pool); break;
+        default:                            jassertfalse; break;
+    }
+}
+
+//==============================================================================
+bool AudioLevelScanner::measureLoudness (AudioFormatReader& reader, int64 startSample, int64 numSamples,
+                                         LoudnessAccumulator& loudness, Range<float>* levels)
+{
+    const auto numChannels = (int) reader.numChannels;
+    jassert (loudness.getNumChannels() == numChannels);
+
+    if (levels != nullptr)
+        for (int i = 0; i < numChannels; ++i)
+            levels[i] = Range<float>();
+
+    AudioBuffer<float> buffer (numChannels, (int) jlimit ((int64) 0, (int64) 16384, numSamples));
+    bool isFirstBlock = true;
+
+    while (numSamples > 0)
+    {
+        const auto numThisTime = (int) jmin (numSamples, (int64) buffer.getNumSamples());
+
+        if (! reader.read (&buffer, 0, numThisTime, startSample, true, true))
+            return false;
+
+        loudness.process (buffer.getArrayOfReadPointers(), numThisTime);
+
+        if (levels != nullptr)
+        {
+            for (int i = 0; i < numChannels; ++i)
+            {
+                const auto r = FloatVectorOperations::findMinAndMax (buffer.getReadPointer (i), numThisTime);
+                levels[i] = isFirstBlock ? r : levels[i].getUnionWith (r);
+            }
+        }
+
+        isFirstBlock = false;
+        startSample += numThisTime;
+        numSamples -= numThisTime;
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioLevelScannerTests  : public UnitTest
+{
+public:
+    AudioLevelScannerTests()
+        : UnitTest ("AudioLevelScanner", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        WorkStealingThreadPool pool (4);
+
+        beginTest ("Matches a scan of the converted data");
+        {
+            for (auto format : { AudioLevelScanner::SampleFormat::unsigned8Bit, AudioLevelScanner::SampleFormat::signed16Bit,
+                                 AudioLevelScanner::SampleFormat::signed24Bit,  AudioLevelScanner::SampleFormat::signed32Bit,
+                                 AudioLevelScanner::SampleFormat::float32Bit })
+            {
+                for (auto littleEndian : { true, false })
+                {
+                    for (auto numChannels : { 1, 2, 3, 6, 8, 20 })
+                    {
+                        for (auto numFrames : { 1, 7, 100, 4099 })
+                        {
+                            AudioLevelScanner::InterleavedData source;
+                            source.numChannels = numChannels;
+                            source.format = format;
+                            source.isLittleEndian = littleEndian;
+
+                            MemoryBlock data ((size_t) (source.getBytesPerFrame() * numFrames));
+                            fillWithNoise (random, data, format, littleEndian);
+                            source.data = data.getData();
+
+                            std::vector<Range<float>> expected ((size_t) numChannels), results ((size_t) numChannels);
+                            scanWithAudioData (source, numFrames, expected.data());
+
+                            const auto numToScan = jmax (1, numChannels - 1);
+                            AudioLevelScanner::findMinAndMax (source, numFrames, results.data(), numToScan);
+
+                            for (int ch = 0; ch < numToScan; ++ch)
+                                expect (results[(size_t) ch] == expected[(size_t) ch]);
+                        }
+                    }
+                }
+            }
+        }
+
+        beginTest ("Parallel scan");
+        {
+            for (auto numChannels : { 1, 2, 5 })
+            {
+                const auto numFrames = 700001;
+                AudioLevelScanner::InterleavedData source;
+                source.numChannels = numChannels;
+                source.format = AudioLevelScanner::SampleFormat::signed16Bit;
+
+                HeapBlock<int16> data ((size_t) (numFrames * numChannels), true);
+                source.data = data;
+
+                // Put each channel's extremes in a different section of the data
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    data[(numFrames - 1 - ch * 1000) * numChannels + ch] = (int16) (100 + ch);
+                    data[(ch * 150000) * numChannels + ch] = (int16) (-200 - ch);
+                }
+
+                std::vector<Range<float>> serial ((size_t) numChannels), parallel ((size_t) numChannels);
+                AudioLevelScanner::findMinAndMax (source, numFrames, serial.data(), numChannels);
+                AudioLevelScanner::findMinAndMax (source, numFrames, parallel.data(), numChannels, &pool);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    expect (serial[(size_t) ch] == parallel[(size_t) ch]);
+                    expect (parallel[(size_t) ch] == Range<float> ((float) (-200 - ch) / 32768.0f, (float) (100 + ch) / 32768.0f));
+                }
+            }
+        }
+
+        beginTest ("Memory-mapped readers");
+        {
+            const auto numFrames = 300000;
+            AudioBuffer<float> buffer (3, numFrames);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < numFrames; ++i)
+                    buffer.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f * (float) (ch + 1) / 3.0f);
+
+            WavAudioFormat wav;
+            AiffAudioFormat aiff;
+
+            for (auto* format : { (AudioFormat*) &wav, (AudioFormat*) &aiff })
+            {
+                for (auto bitDepth : format->getPossibleBitDepths())
+                {
+                    if (bitDepth < 16)
+                        continue;
+
+                    TemporaryFile tempFile (format->getFileExtensions()[0]);
+                    writeFile (*format, tempFile.getFile(), buffer, bitDepth);
+
+                    std::unique_ptr<AudioFormatReader> streamReader (format->createReaderFor (tempFile.getFile().createInputStream().release(), true));
+                    std::unique_ptr<MemoryMappedAudioFormatReader> mappedReader (format->createMemoryMappedReader (tempFile.getFile()));
+
+                    expect (streamReader != nullptr && mappedReader != nullptr);
+
+                    if (streamReader == nullptr || mappedReader == nullptr)
+                        continue;
+
+                    mappedReader->mapEntireFile();
+                    mappedReader->setLevelScanThreadPool (&pool);
+
+                    Range<float> expected[3], results[3];
+                    const auto start = 1234, length = numFrames - 2000;
+
+                    AudioBuffer<float> readBack (3, length);
+                    streamReader->read (&readBack, 0, length, start, true, true);
+
+                    for (int ch = 0; ch < 3; ++ch)
+                        expected[ch] = FloatVectorOperations::findMinAndMax (readBack.getReadPointer (ch), length);
+
+                    mappedReader->readMaxLevels (start, length, results, 3);
+
+                    // The stream reader goes via 32-bit integers, so its scaling can differ very slightly
+                    for (int ch = 0; ch < 3; ++ch)
+                    {
+                        expectWithinAbsoluteError (results[ch].getStart(), expected[ch].getStart(), 1.0e-6f);
+                        expectWithinAbsoluteError (results[ch].getEnd(),   expected[ch].getEnd(),   1.0e-6f);
+                    }
+
+                    LoudnessAccumulator loudness (streamReader->sampleRate, 3);
+                    Range<float> levels[3];
+                    expect (AudioLevelScanner::measureLoudness (*streamReader, start, length, loudness, levels));
+
+                    for (int ch = 0; ch < 3; ++ch)
+                        expect (levels[ch] == expected[ch]);
+
+                    expect (loudness.getIntegratedLoudness() > -20.0);
+                }
+            }
+        }
+    }
+
+private:
+    static void fillWithNoise (Random& random, MemoryBlock& data, AudioLevelScanner::SampleFormat format, bool littleEndian)
+    {
+        if (format != AudioLevelScanner::SampleFormat::float32Bit)
+        {
+            random.fillBitsRandomly (data.getData(), data.getSize());
+            return;
+        }
+
+        // Random bits would make lots of NaNs, which don't have a well-defined min or max
+        auto* floats = static_cast<float*> (data.getData());
+
+        for (size_t i = 0; i < data.getSize() / sizeof (float); ++i)
+        {
+            const auto value = random.nextFloat() * 4.0f - 2.0f;
+            uint32 bits;
+            memcpy (&bits, &value, sizeof (bits));
+            bits = littleEndian ? ByteOrder::swapIfBigEndian (bits) : ByteOrder::swapIfLittleEndian (bits);
+            memcpy (floats + i, &bits, sizeof (bits));
+        }
+    }
+
+    template <typename SampleType, typename Endianness>
+    static void scanChannels (const AudioLevelScanner::InterleavedData& source, int numFrames, Range<float>* results)
+    {
+        using Pointer = AudioData::Pointer<SampleType, Endianness, AudioData::Interleaved, AudioData::Const>;
+
+        for (int ch = 0; ch < source.numChannels; ++ch)
+            results[ch] = Pointer (addBytesToPointer (source.data, source.getBytesPerSample() * ch), source.numChannels)
+                            .findMinAndMax ((size_t) numFrames);
+    }
+
+    template <typename SampleType>
+    static void scanChannels (const AudioLevelScanner::InterleavedData& source, int numFrames, Range<float>* results)
+    {
+        if (source.isLittleEndian)
+            scanChannels<SampleType, AudioData::LittleEndian> (source, numFrames, results);
+        else
+            scanChannels<SampleType, AudioData::BigEndian> (source, numFrames, results);
+    }
+
+    static void scanWithAudioData (const AudioLevelScanner::InterleavedData& source, int numFrames, Range<float>* results)
+    {
+        switch (source.format)
+        {
+            case AudioLevelScanner::SampleFormat::unsigned8Bit:  scanChannels<AudioData::UInt8>   (source, numFrames, results); break;
+            case AudioLevelScanner::SampleFormat::signed16Bit:   scanChannels<AudioData::Int16>   (source, numFrames, results); break;
+            case AudioLevelScanner::SampleFormat::signed24Bit:   scanChannels<AudioData::Int24>   (source, numFrames, results); break;
+            case AudioLevelScanner::SampleFormat::signed32Bit:   scanChannels<AudioData::Int32>   (source, numFrames, results); break;
+            case AudioLevelScanner::SampleFormat::float32Bit:    scanChannels<AudioData::Float32> (source, numFrames, results); break;
+            default: break;
+        }
+    }
+
+    static void writeFile (AudioFormat& format, const File& file, const AudioBuffer<float>& buffer, int bitDepth)
+    {
+        auto stream = file.createOutputStream();
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (stream.get(), 44100.0,
+                                                                           (unsigned int) buffer.getNumChannels(),
+                                                                           bitDepth, {}, 0));
+
+        if (writer != nullptr)
+        {
+            stream.release();
+            writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+        }
+    }
+};
+
+static AudioLevelScannerTests audioLevelScannerTests;
+
+#endif
+
+} // namespace juce
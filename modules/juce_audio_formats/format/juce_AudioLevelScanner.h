@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Fast peak and loudness measurement for audio files.
+
+    findMinAndMax() scans raw interleaved PCM data, like the mapped region of a
+    MemoryMappedAudioFormatReader, without converting it to floating point. The
+    samples are compared in their stored format using SSE or NEON where they're
+    available, byte-swapping big-endian data on the fly, and only the final
+    extremes are normalised. Large sections can be split across the threads of a
+    WorkStealingThreadPool.
+
+    measureLoudness() reads a section of any AudioFormatReader and feeds it to a
+    LoudnessAccumulator, finding the peak levels at the same time, so that a file
+    only has to be decoded once to get both.
+
+    @see MemoryMappedAudioFormatReader::setLevelScanThreadPool, LoudnessAccumulator
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioLevelScanner
+{
+public:
+    //==============================================================================
+    /** The sample formats that findMinAndMax() understands. */
+    enum class SampleFormat
+    {
+        unsigned8Bit,   /**< 8-bit samples with an offset of 128, as used by WAV files. */
+        signed16Bit,
+        signed24Bit,    /**< Packed into 3 bytes. */
+        signed32Bit,
+        float32Bit
+    };
+
+    /** Describes a block of interleaved sample data. */
+    struct InterleavedData
+    {
+        const void* data = nullptr;
+        int numChannels = 0;
+        SampleFormat format = SampleFormat::signed16Bit;
+        bool isLittleEndian = true;
+
+        /** Returns the size of one sample in bytes. */
+        int getBytesPerSample() const noexcept;
+
+        /** Returns the size of a frame, i.e. one sample for every channel, in bytes. */
+        int getBytesPerFrame() const noexcept       { return getBytesPerSample() * numChannels; }
+    };
+
+    //==============================================================================
+    /** Finds the lowest and highest levels in each channel of some interleaved data.
+
+        The results are normalised in the same way as AudioData::Pointer does it, so
+        they'll exactly match the levels you'd get by converting the data to floats
+        and scanning that.
+
+        @param source               the data to scan, which must start at the beginning of a frame
+        @param numFrames            the number of frames to scan
+        @param results              an array of numChannelsToScan ranges to fill in
+        @param numChannelsToScan    the number of channels to return results for, starting
+                                    from the first. This mustn't be more than the number of
+                                    channels in the data
+        @param pool                 if this isn't nullptr, large scans will be split into
+                                    sections which are scanned in parallel on the pool's threads
+    */
+    static void findMinAndMax (const InterleavedData& source, int64 numFrames,
+                               Range<float>* results, int numChannelsToScan,
+                               WorkStealingThreadPool* pool = nullptr);
+
+    //==============================================================================
+    /** Reads a section of a file, adding it to a loudness measurement and finding its
+        peak levels at the same time.
+
+        The accumulator must have been prepared for the reader's sample rate and
+        number of channels.
+
+        @param reader           the reader to read from
+        @param startSample      the first sample to read
+        @param numSamples       the number of samples to read
+        @param loudness         the accumulator to add the audio to
+        @param levels           if this isn't nullptr, it must point to an array with a
+                                range for each of the reader's channels, which will be
+                                filled in with the lowest and highest levels that were read
+        @returns false if the reader failed to read some of the data
+    */
+    static bool measureLoudness (AudioFormatReader& reader, int64 startSample, int64 numSamples,
+                                 LoudnessAccumulator& loudness, Range<float>* levels = nullptr);
+
+private:
+    AudioLevelScanner() = delete;
+};
+
+} // namespace juce
@@ -0,0 +1,370 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioFormatReaderPageCache::Page::Page (int numChannels, int numSamplesToHold)
+    : samples ((size_t) (jmax (1, numChannels) * numSamplesToHold)),
+      numSamples (numSamplesToHold)
+{
+}
+
+//==============================================================================
+AudioFormatReaderPageCache::AudioFormatReaderPageCache (size_t maxBytesToUse, int numSamplesPerPage)
+    : samplesPerPage (jmax (256, numSamplesPerPage)),
+      budget (maxBytesToUse)
+{
+}
+
+AudioFormatReaderPageCache::~AudioFormatReaderPageCache() = default;
+
+void AudioFormatReaderPageCache::setMemoryBudget (size_t maxBytesToUse)
+{
+    const ScopedLock sl (lock);
+    budget = maxBytesToUse;
+    removeOldPages();
+}
+
+size_t AudioFormatReaderPageCache::getMemoryBudget() const noexcept
+{
+    const ScopedLock sl (lock);
+    return budget;
+}
+
+size_t AudioFormatReaderPageCache::getMemoryUsed() const noexcept
+{
+    const ScopedLock sl (lock);
+    return bytesUsed;
+}
+
+void AudioFormatReaderPageCache::clear()
+{
+    const ScopedLock sl (lock);
+    pages.clear();
+    leastRecentlyUsed.clear();
+    bytesUsed = 0;
+}
+
+void AudioFormatReaderPageCache::removeSource (const String& sourceIdentifier)
+{
+    const ScopedLock sl (lock);
+
+    for (auto i = pages.lower_bound ({ sourceIdentifier, std::numeric_limits<int64>::min() });
+         i != pages.end() && i->first.first == sourceIdentifier;)
+    {
+        bytesUsed -= i->second.page->getSizeInBytes();
+        leastRecentlyUsed.erase (i->second.positionInLRU);
+        i = pages.erase (i);
+    }
+}
+
+AudioFormatReaderPageCache::PagePtr AudioFormatReaderPageCache::findPage (const String& sourceIdentifier, int64 pageIndex)
+{
+    const ScopedLock sl (lock);
+    auto i = pages.find ({ sourceIdentifier, pageIndex });
+
+    if (i == pages.end())
+    {
+        ++numMisses;
+        return {};
+    }
+
+    ++numHits;
+    leastRecentlyUsed.splice (leastRecentlyUsed.end(), leastRecentlyUsed, i->second.positionInLRU);
+    return i->second.page;
+}
+
+void AudioFormatReaderPageCache::addPage (const String& sourceIdentifier, int64 pageIndex, PagePtr page)
+{
+    if (page == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    const ScopedLock sl (lock);
+    Key key { sourceIdentifier, pageIndex };
+    auto i = pages.find (key);
+
+    if (i != pages.end())
+    {
+        // Another reader decoded the same page at the same time, so just keep the first one
+        leastRecentlyUsed.splice (leastRecentlyUsed.end(), leastRecentlyUsed, i->second.positionInLRU);
+        return;
+    }
+
+    bytesUsed += page->getSizeInBytes();
+    auto position = leastRecentlyUsed.insert (leastRecentlyUsed.end(), key);
+    pages.emplace (std::move (key), Entry { std::move (page), position });
+
+    removeOldPages();
+}
+
+void AudioFormatReaderPageCache::removeOldPages()
+{
+    // Always keep the most recent page, even if it's bigger than the whole budget,
+    // so that the reader that just added it can still use it
+    while (bytesUsed > budget && leastRecentlyUsed.size() > 1)
+    {
+        auto i = pages.find (leastRecentlyUsed.front());
+        jassert (i != pages.end());
+
+        bytesUsed -= i->second.page->getSizeInBytes();
+        pages.erase (i);
+        leastRecentlyUsed.pop_front();
+    }
+}
+
+//==============================================================================
+CachingAudioFormatReader::CachingAudioFormatReader (AudioFormatReader* sourceReader,
+                                                    const String& sourceIdentifier,
+                                                    AudioFormatReaderPageCache& cache)
+    : AudioFormatReader (nullptr, sourceReader->getFormatName()),
+      source (sourceReader), identifier (sourceIdentifier), pageCache (cache)
+{
+    sampleRate            = source->sampleRate;
+    bitsPerSample         = source->bitsPerSample;
+    lengthInSamples       = source->lengthInSamples;
+    numChannels           = source->numChannels;
+    usesFloatingPointData = source->usesFloatingPointData;
+    metadataValues        = source->metadataValues;
+}
+
+CachingAudioFormatReader::CachingAudioFormatReader (AudioFormatReader* sourceReader,
+                                                    const File& sourceFile,
+                                                    AudioFormatReaderPageCache& cache)
+    : CachingAudioFormatReader (sourceReader, getSourceIdentifierFor (sourceFile), cache)
+{
+}
+
+CachingAudioFormatReader::~CachingAudioFormatReader() = default;
+
+String CachingAudioFormatReader::getSourceIdentifierFor (const File& file)
+{
+    return file.getFullPathName()
+            + "|" + String (file.getSize())
+            + "|" + String (file.getLastModificationTime().toMilliseconds());
+}
+
+bool CachingAudioFormatReader::readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                            int64 startSampleInFile, int numSamples)
+{
+    clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                       startSampleInFile, numSamples, lengthInSamples);
+
+    const auto samplesPerPage = pageCache.getSamplesPerPage();
+    bool allSamplesRead = true;
+
+    while (numSamples > 0)
+    {
+        const auto pageIndex = startSampleInFile / samplesPerPage;
+        const auto offset = (int) (startSampleInFile - pageIndex * samplesPerPage);
+        bool pageDecodedOk = true;
+        const auto page = getPage (pageIndex, pageDecodedOk);
+
+        if (page == nullptr)
+            return false;
+
+        allSamplesRead = allSamplesRead && pageDecodedOk;
+
+        const auto numToDo = jmin (numSamples, page->numSamples - offset);
+
+        if (numToDo <= 0)
+            return false;
+
+        for (int j = 0; j < numDestChannels; ++j)
+        {
+            if (auto* dest = destSamples[j])
+            {
+                dest += startOffsetInDestBuffer;
+
+                if (j < (int) numChannels)
+                    memcpy (dest, page->getChannel (j) + offset, sizeof (int) * (size_t) numToDo);
+                else
+                    zeromem (dest, sizeof (int) * (size_t) numToDo);
+            }
+        }
+
+        startOffsetInDestBuffer += numToDo;
+        startSampleInFile += numToDo;
+        numSamples -= numToDo;
+    }
+
+    return allSamplesRead;
+}
+
+AudioFormatReaderPageCache::PagePtr CachingAudioFormatReader::getPage (int64 pageIndex, bool& decodedOk)
+{
+    if (auto page = pageCache.findPage (identifier, pageIndex))
+        return page;
+
+    const auto samplesPerPage = pageCache.getSamplesPerPage();
+    const auto start = pageIndex * samplesPerPage;
+    const auto numSamplesInPage = (int) jmin ((int64) samplesPerPage, lengthInSamples - start);
+
+    if (numSamplesInPage <= 0)
+        return {};
+
+    auto page = std::make_shared<AudioFormatReaderPageCache::Page> ((int) numChannels, numSamplesInPage);
+
+    HeapBlock<int*> channels (numChannels + 1, true);
+
+    for (int i = 0; i < (int) numChannels; ++i)
+        channels[i] = page->getChannel (i);
+
+    // Pages that failed to decode aren't cached, so that they can be tried again later
+    decodedOk = source->readSamples (channels, (int) numChannels, 0, start, numSamplesInPage);
+
+    if (! decodedOk)
+        return page;
+
+    pageCache.addPage (identifier, pageIndex, page);
+    return page;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct CachingAudioFormatReaderTests  : public UnitTest
+{
+    CachingAudioFormatReaderTests()
+        : UnitTest ("CachingAudioFormatReader", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Reads return the same samples as the source");
+        {
+            AudioFormatReaderPageCache cache (1 << 20, 1000);
+            CachingAudioFormatReader reader (new CountingReader (30000), "a", cache);
+
+            for (auto [start, length] : { std::pair<int64, int> { 0, 100 }, { 950, 100 }, { 1000, 2500 },
+                                          { 29990, 100 }, { -50, 100 } })
+            {
+                AudioBuffer<int> buffer (2, length);
+                expect (reader.read (buffer.getArrayOfWritePointers(), 2, start, length, false));
+
+                for (int i = 0; i < length; ++i)
+                {
+                    const auto pos = start + i;
+                    const auto inRange = isPositiveAndBelow (pos, (int64) 30000);
+
+                    expectEquals (buffer.getSample (0, i), inRange ? CountingReader::getValue (0, pos) : 0);
+                    expectEquals (buffer.getSample (1, i), inRange ? CountingReader::getValue (1, pos) : 0);
+                }
+            }
+        }
+
+        beginTest ("Pages are shared between readers with the same identifier");
+        {
+            AudioFormatReaderPageCache cache (1 << 20, 1000);
+
+            auto* firstSource = new CountingReader (30000);
+            auto* secondSource = new CountingReader (30000);
+            CachingAudioFormatReader first (firstSource, "a", cache);
+            CachingAudioFormatReader second (secondSource, "a", cache);
+
+            AudioBuffer<int> buffer (2, 5000);
+            first.read (buffer.getArrayOfWritePointers(), 2, 2000, 5000, false);
+            expectEquals (firstSource->numSamplesDecoded, (int64) 5000);
+
+            second.read (buffer.getArrayOfWritePointers(), 2, 2500, 4000, false);
+            expectEquals (secondSource->numSamplesDecoded, (int64) 0);
+            expect (cache.getNumHits() > 0);
+
+            cache.removeSource ("a");
+            expectEquals (cache.getMemoryUsed(), (size_t) 0);
+
+            second.read (buffer.getArrayOfWritePointers(), 2, 2500, 1000, false);
+            expectEquals (secondSource->numSamplesDecoded, (int64) 2000);
+        }
+
+        beginTest ("The memory budget is respected");
+        {
+            const auto pageSize = AudioFormatReaderPageCache::Page (2, 1000).getSizeInBytes();
+            AudioFormatReaderPageCache cache (pageSize * 4, 1000);
+
+            auto* source = new CountingReader (30000);
+            CachingAudioFormatReader reader (source, "a", cache);
+
+            AudioBuffer<int> buffer (2, 1000);
+
+            for (int i = 0; i < 10; ++i)
+                reader.read (buffer.getArrayOfWritePointers(), 2, i * 1000, 1000, false);
+
+            expect (cache.getMemoryUsed() <= cache.getMemoryBudget());
+            expectEquals (source->numSamplesDecoded, (int64) 10000);
+
+            // The most recent pages should still be there, and the oldest ones gone
+            reader.read (buffer.getArrayOfWritePointers(), 2, 9000, 1000, false);
+            expectEquals (source->numSamplesDecoded, (int64) 10000);
+
+            reader.read (buffer.getArrayOfWritePointers(), 2, 0, 1000, false);
+            expectEquals (source->numSamplesDecoded, (int64) 11000);
+
+            cache.setMemoryBudget (pageSize);
+            expect (cache.getMemoryUsed() <= pageSize);
+        }
+    }
+
+private:
+    struct CountingReader  : public AudioFormatReader
+    {
+        explicit CountingReader (int64 length)
+            : AudioFormatReader (nullptr, "test")
+        {
+            sampleRate = 44100.0;
+            bitsPerSample = 32;
+            lengthInSamples = length;
+            numChannels = 2;
+        }
+
+        static int getValue (int channel, int64 pos)    { return (int) pos * 2 + channel; }
+
+        bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            numSamplesDecoded += numSamples;
+
+            for (int ch = 0; ch < numDestChannels; ++ch)
+                if (auto* dest = destSamples[ch])
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = getValue (ch, startSampleInFile + i);
+
+            return true;
+        }
+
+        int64 numSamplesDecoded = 0;
+    };
+};
+
+static CachingAudioFormatReaderTests cachingAudioFormatReaderTests;
+
+#endif
+
+} // namespace juce
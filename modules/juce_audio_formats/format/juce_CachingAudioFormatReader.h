@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A cache of decoded audio that can be shared between many readers.
+
+    Decoding compressed formats like FLAC or Ogg-Vorbis is expensive, and unlike
+    uncompressed WAV or AIFF files, they can't simply be memory-mapped. When the
+    same regions of a file are read over and over again (e.g. by thumbnails that
+    get redrawn, by scrubbing, or by several sampler voices playing the same sound),
+    wrapping the readers in a CachingAudioFormatReader that uses one of these
+    lets them share the decoded samples instead of decoding them again.
+
+    The audio is stored in fixed-size pages, which are identified by the source
+    they came from and their position in it. Once the total size of the pages
+    goes beyond the cache's memory budget, the least-recently-used pages are
+    thrown away.
+
+    All the methods of this class are thread-safe.
+
+    @see CachingAudioFormatReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioFormatReaderPageCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param maxBytesToUse    the total amount of memory that the decoded pages
+                                are allowed to use
+        @param samplesPerPage   the number of samples per channel in each page
+    */
+    explicit AudioFormatReaderPageCache (size_t maxBytesToUse = 64 * 1024 * 1024,
+                                         int samplesPerPage = 16384);
+
+    /** Destructor.
+
+        Make sure that any readers that use this cache have been deleted before
+        the cache itself is deleted.
+    */
+    ~AudioFormatReaderPageCache();
+
+    //==============================================================================
+    /** Changes the amount of memory that the cache may use.
+
+        If the new limit is smaller than the amount currently being used, old
+        pages are discarded straight away.
+    */
+    void setMemoryBudget (size_t maxBytesToUse);
+
+    /** Returns the amount of memory that the cache may use. */
+    size_t getMemoryBudget() const noexcept;
+
+    /** Returns the amount of memory currently used by the cached pages. */
+    size_t getMemoryUsed() const noexcept;
+
+    /** Returns the number of samples per channel in each page. */
+    int getSamplesPerPage() const noexcept          { return samplesPerPage; }
+
+    /** Discards all the cached pages. */
+    void clear();
+
+    /** Discards all the pages that belong to a particular source.
+
+        Call this if the file that a source identifier refers to has been changed.
+    */
+    void removeSource (const String& sourceIdentifier);
+
+    /** Returns the number of page requests that were found in the cache. */
+    int64 getNumHits() const noexcept               { return numHits; }
+
+    /** Returns the number of page requests that had to be decoded. */
+    int64 getNumMisses() const noexcept             { return numMisses; }
+
+    //==============================================================================
+    /** A block of decoded samples, as returned by AudioFormatReader::readSamples(). */
+    struct Page
+    {
+        Page (int numChannels, int numSamples);
+
+        const int* getChannel (int channel) const noexcept      { return samples.data() + (size_t) (channel * numSamples); }
+        int* getChannel (int channel) noexcept                  { return samples.data() + (size_t) (channel * numSamples); }
+
+        size_t getSizeInBytes() const noexcept                  { return sizeof (Page) + samples.size() * sizeof (int); }
+
+        std::vector<int> samples;
+        const int numSamples;
+    };
+
+    using PagePtr = std::shared_ptr<const Page>;
+
+    /** Returns a page if it's in the cache, or nullptr if it isn't. */
+    PagePtr findPage (const String& sourceIdentifier, int64 pageIndex);
+
+    /** Adds a page to the cache, discarding older ones if needed to stay within budget. */
+    void addPage (const String& sourceIdentifier, int64 pageIndex, PagePtr page);
+
+private:
+    //==============================================================================
+    using Key = std::pair<String, int64>;
+
+    struct Entry
+    {
+        PagePtr page;
+        std::list<Key>::iterator positionInLRU;
+    };
+
+    void removeOldPages();
+
+    const int samplesPerPage;
+    size_t budget, bytesUsed = 0;
+    std::atomic<int64> numHits { 0 }, numMisses { 0 };
+
+    CriticalSection lock;
+    std::map<Key, Entry> pages;
+    std::list<Key> leastRecentlyUsed;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatReaderPageCache)
+};
+
+//==============================================================================
+/**
+    An AudioFormatReader that keeps the audio it decodes from another reader in
+    an AudioFormatReaderPageCache.
+
+    Reads are split into whole pages. Any page that's already in the cache is
+    copied from there, and any other is decoded by the source reader and then
+    added to the cache, so that other readers with the same source identifier
+    can use it too.
+
+    Like other readers, a CachingAudioFormatReader must only be used by one thread
+    at a time, but different readers that share a cache can be used on different
+    threads.
+
+    @see AudioFormatReaderPageCache
+
+    @tags{Audio}
+*/
+class JUCE_API  CachingAudioFormatReader  : public AudioFormatReader
+{
+public:
+    /** Creates a reader.
+
+        @param sourceReader         the reader to decode samples from. This object takes
+                                    ownership of it and will delete it later when no
+                                    longer needed
+        @param sourceIdentifier     a string that uniquely identifies the audio that the
+                                    source reader produces. Every reader that reads the
+                                    same audio should use the same identifier
+        @param cache                the cache to use. This must stay alive for as long
+                                    as the reader exists
+    */
+    CachingAudioFormatReader (AudioFormatReader* sourceReader,
+                              const String& sourceIdentifier,
+                              AudioFormatReaderPageCache& cache);
+
+    /** Creates a reader for a file, using getSourceIdentifierFor() to identify it. */
+    CachingAudioFormatReader (AudioFormatReader* sourceReader,
+                              const File& sourceFile,
+                              AudioFormatReaderPageCache& cache);
+
+    /** Destructor. */
+    ~CachingAudioFormatReader() override;
+
+    /** Returns an identifier for a file that includes its size and modification time,
+        so that pages from an older version of the file won't be used after it has
+        been changed.
+    */
+    static String getSourceIdentifierFor (const File& file);
+
+    //==============================================================================
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override;
+
+private:
+    AudioFormatReaderPageCache::PagePtr getPage (int64 pageIndex, bool& decodedOk);
+
+    std::unique_ptr<AudioFormatReader> source;
+    const String identifier;
+    AudioFormatReaderPageCache& pageCache;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachingAudioFormatReader)
+};
+
+} // namespace juce
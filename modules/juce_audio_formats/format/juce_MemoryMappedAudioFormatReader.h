@@ -81,12 +81,20 @@ public:
     /** Returns the number of bytes currently being mapped */
     size_t getNumBytesUsed() const                          { return map != nullptr ? map->getSize() : 0; }
 
+    /** Lets readMaxLevels() split large sections of the file across the threads of a pool.
+
+        The pool must stay alive for as long as it's being used by the reader. Pass
+        nullptr to go back to scanning on the calling thread.
+    */
+    void setLevelScanThreadPool (WorkStealingThreadPool* pool) noexcept   { levelScanPool = pool; }
+
 protected:
     File file;
     Range<int64> mappedSection;
     std::unique_ptr<MemoryMappedFile> map;
     int64 dataChunkStart, dataLength;
     int bytesPerFrame;
+    WorkStealingThreadPool* levelScanPool = nullptr;
 
     /** Converts a sample index to a byte position in the file. */
     inline int64 sampleToFilePos (int64 sample) const noexcept       { return dataChunkStart + sample * bytesPerFrame; }
@@ -107,6 +115,37 @@ protected:
                 .findMinAndMax ((size_t) numSamples);
     }
 
+    /** Used by AudioFormatReader subclasses to scan for the min/max ranges of several
+        channels of interleaved data at once, using an AudioLevelScanner.
+    */
+    template <typename SampleType, typename Endianness>
+    void scanMinAndMaxInterleaved (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const
+    {
+        AudioLevelScanner::InterleavedData source;
+        source.data = sampleToPointer (startSampleInFile);
+        source.numChannels = (int) numChannels;
+        source.format = getLevelScannerFormat<SampleType>();
+        source.isLittleEndian = std::is_same<Endianness, AudioData::LittleEndian>::value;
+
+        AudioLevelScanner::findMinAndMax (source, numSamples, results, numChannelsToRead, levelScanPool);
+    }
+
+    /** Returns the AudioLevelScanner format that matches an AudioData sample type. */
+    template <typename SampleType>
+    static constexpr AudioLevelScanner::SampleFormat getLevelScannerFormat() noexcept
+    {
+        static_assert (std::is_same<SampleType, AudioData::UInt8>::value || std::is_same<SampleType, AudioData::Int16>::value
+                        || std::is_same<SampleType, AudioData::Int24>::value || std::is_same<SampleType, AudioData::Int32>::value
+                        || std::is_same<SampleType, AudioData::Float32>::value,
+                       "This sample type isn't supported by AudioLevelScanner");
+
+        return std::is_same<SampleType, AudioData::UInt8>::value ? AudioLevelScanner::SampleFormat::unsigned8Bit
+             : std::is_same<SampleType, AudioData::Int16>::value ? AudioLevelScanner::SampleFormat::signed16Bit
+             : std::is_same<SampleType, AudioData::Int24>::value ? AudioLevelScanner::SampleFormat::signed24Bit
+             : std::is_same<SampleType, AudioData::Int32>::value ? AudioLevelScanner::SampleFormat::signed32Bit
+                                                                 : AudioLevelScanner::SampleFormat::float32Bit;
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedAudioFormatReader)
 };
 
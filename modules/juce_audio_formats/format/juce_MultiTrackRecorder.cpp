@@ -0,0 +1,842 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct MultiTrackRecorder::Block
+{
+    Block (int numChannels, int numFrames)  : buffer (numChannels, numFrames) {}
+
+    AudioBuffer<float> buffer;
+    int numSamples = 0;
+    int64 queuedTicks = 0;
+};
+
+//==============================================================================
+struct MultiTrackRecorder::Track
+{
+    explicit Track (int numQueueSlots)  : queue (numQueueSlots), queuedBlocks ((size_t) numQueueSlots) {}
+
+    // Set while the track can be written to. Only the audio thread touches currentBlock.
+    std::atomic<bool> active { false };
+    int numChannels = 0;
+    Block* currentBlock = nullptr;
+
+    // Full blocks waiting for a background thread, written by the audio thread
+    AbstractFifo queue;
+    std::vector<Block*> queuedBlocks;
+
+    // Protects the writer and the receiver, which are used by the background thread
+    CriticalSection lock;
+    std::unique_ptr<AudioFormatWriter> writer;
+    AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* receiver = nullptr;
+    std::atomic<int64> numSamplesWritten { 0 };
+};
+
+//==============================================================================
+/*  An OutputStream that collects everything written to it in a large aligned buffer, and
+    writes the buffer at its position in the file once it's full. The writer moves back
+    to the start to update the header when it's done, so a seek just flushes the buffer.
+*/
+class MultiTrackRecorder::FileStream  : public OutputStream
+{
+public:
+    FileStream (MultiTrackRecorder& r, const File& f)
+        : owner (r), file (f),
+          bufferSize (roundUpToAlignment (jmax (r.options.writeSizeBytes, (int) alignment))),
+          storage ((size_t) (bufferSize + alignment)),
+          buffer (snapPointerToAlignment (storage.get(), alignment))
+    {
+        open (owner.options.useDirectIO);
+    }
+
+    ~FileStream() override
+    {
+        flush();
+        close();
+    }
+
+    bool openedOk() const noexcept
+    {
+       #if JUCE_WINDOWS
+        return handle != INVALID_HANDLE_VALUE;
+       #else
+        return fd >= 0;
+       #endif
+    }
+
+    void flush() override
+    {
+        writeBuffer();
+    }
+
+    bool setPosition (int64 newPosition) override
+    {
+        if (newPosition != getPosition())
+        {
+            writeBuffer();
+            bufferStart = newPosition;
+        }
+
+        return ! failed;
+    }
+
+    int64 getPosition() override
+    {
+        return bufferStart + (int64) numBuffered;
+    }
+
+    bool write (const void* data, size_t numBytes) override
+    {
+        auto* source = static_cast<const char*> (data);
+
+        while (numBytes > 0 && ! failed)
+        {
+            auto numToCopy = jmin (numBytes, (size_t) (bufferSize - numBuffered));
+            memcpy (buffer + numBuffered, source, numToCopy);
+
+            numBuffered += (int) numToCopy;
+            source += numToCopy;
+            numBytes -= numToCopy;
+
+            if (numBuffered == bufferSize)
+                writeBuffer();
+        }
+
+        return ! failed;
+    }
+
+private:
+    static constexpr int64 alignment = 4096;
+
+    MultiTrackRecorder& owner;
+    const File file;
+    const int bufferSize;
+    HeapBlock<char> storage;
+    char* const buffer;
+
+    int64 bufferStart = 0, preallocatedEnd = 0;
+    int numBuffered = 0;
+    bool usingDirectIO = false, failed = false;
+
+   #if JUCE_WINDOWS
+    HANDLE handle = INVALID_HANDLE_VALUE;
+   #else
+    int fd = -1;
+   #endif
+
+    static int roundUpToAlignment (int size) noexcept
+    {
+        return (int) ((size + alignment - 1) & ~(alignment - 1));
+    }
+
+    void writeBuffer()
+    {
+        if (numBuffered == 0 || failed)
+            return;
+
+        // Direct I/O needs the position and size to be aligned, which is only not
+        // the case for the header and the end of the file.
+        if (usingDirectIO && ((bufferStart % alignment) != 0 || (numBuffered % alignment) != 0))
+            stopUsingDirectIO();
+
+        preallocate (bufferStart + numBuffered);
+
+        auto ok = writeAt (bufferStart, buffer, numBuffered);
+
+        owner.addFileStatistics (1, ok ? numBuffered : 0, ok ? 0 : 1);
+
+        if (! ok)
+        {
+            failed = true;
+            return;
+        }
+
+        bufferStart += numBuffered;
+        numBuffered = 0;
+    }
+
+   #if JUCE_WINDOWS
+    void open (bool directIO)
+    {
+        handle = CreateFile (file.getFullPathName().toWideCharPointer(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | (directIO ? (DWORD) FILE_FLAG_NO_BUFFERING : 0), nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE && directIO)
+            return open (false);
+
+        usingDirectIO = directIO;
+    }
+
+    void close()
+    {
+        if (handle != INVALID_HANDLE_VALUE)
+            CloseHandle (handle);
+
+        handle = INVALID_HANDLE_VALUE;
+    }
+
+    void stopUsingDirectIO()
+    {
+        // The buffering mode of a handle is fixed, so the file has to be opened again
+        close();
+
+        handle = CreateFile (file.getFullPathName().toWideCharPointer(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        usingDirectIO = false;
+        failed = (handle == INVALID_HANDLE_VALUE);
+    }
+
+    void preallocate (int64 end)
+    {
+        if (end <= preallocatedEnd || owner.options.preallocationBytes <= 0)
+            return;
+
+        // This reserves clusters without changing the length of the file. SetFileValidData would
+        // also avoid zero-filling them, but it needs a privilege, and exposes stale disk contents.
+        FILE_ALLOCATION_INFO info;
+        info.AllocationSize.QuadPart = end + owner.options.preallocationBytes;
+
+        if (SetFileInformationByHandle (handle, FileAllocationInfo, &info, sizeof (info)))
+            preallocatedEnd = info.AllocationSize.QuadPart;
+        else
+            preallocatedEnd = std::numeric_limits<int64>::max();
+    }
+
+    bool writeAt (int64 position, const char* data, int numBytes)
+    {
+        while (numBytes > 0)
+        {
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = (DWORD) position;
+            overlapped.OffsetHigh = (DWORD) (position >> 32);
+
+            DWORD numWritten = 0;
+
+            if (! WriteFile (handle, data, (DWORD) numBytes, &numWritten, &overlapped) || numWritten == 0)
+                return false;
+
+            position += numWritten;
+            data += numWritten;
+            numBytes -= (int) numWritten;
+        }
+
+        return true;
+    }
+   #else
+    void open (bool directIO)
+    {
+        auto flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+       #if JUCE_LINUX
+        if (directIO)
+            flags |= O_DIRECT;
+       #endif
+
+        fd = ::open (file.getFullPathName().toUTF8(), flags, 0644);
+
+       #if JUCE_LINUX
+        // Some file systems, e.g. tmpfs, refuse O_DIRECT
+        if (fd < 0 && directIO && errno == EINVAL)
+            return open (false);
+       #endif
+
+       #if JUCE_MAC || JUCE_IOS
+        if (fd >= 0 && directIO)
+            directIO = (fcntl (fd, F_NOCACHE, 1) != -1);
+       #endif
+
+        usingDirectIO = directIO && fd >= 0;
+    }
+
+    void close()
+    {
+        if (fd >= 0)
+            ::close (fd);
+
+        fd = -1;
+    }
+
+    void stopUsingDirectIO()
+    {
+       #if JUCE_LINUX
+        fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) & ~O_DIRECT);
+       #endif
+
+        // F_NOCACHE doesn't need aligned writes, so it can be left on
+        usingDirectIO = false;
+    }
+
+    void preallocate (int64 end)
+    {
+        if (end <= preallocatedEnd || owner.options.preallocationBytes <= 0)
+            return;
+
+        auto newEnd = end + owner.options.preallocationBytes;
+
+       #if JUCE_LINUX
+        // Reserves the space without changing the length of the file
+        if (fallocate (fd, FALLOC_FL_KEEP_SIZE, preallocatedEnd, newEnd - preallocatedEnd) == 0)
+            preallocatedEnd = newEnd;
+        else
+            preallocatedEnd = std::numeric_limits<int64>::max();
+       #elif JUCE_MAC || JUCE_IOS
+        // F_PEOFPOSMODE allocates from the end of the space that's already been allocated
+        fstore_t store { F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t) (newEnd - preallocatedEnd), 0 };
+
+        auto ok = fcntl (fd, F_PREALLOCATE, &store) != -1;
+
+        if (! ok)
+        {
+            store.fst_flags = F_ALLOCATEALL;
+            ok = fcntl (fd, F_PREALLOCATE, &store) != -1;
+        }
+
+        preallocatedEnd = ok ? newEnd : std::numeric_limits<int64>::max();
+       #else
+        ignoreUnused (newEnd);
+        preallocatedEnd = std::numeric_limits<int64>::max();
+       #endif
+    }
+
+    bool writeAt (int64 position, const char* data, int numBytes)
+    {
+        while (numBytes > 0)
+        {
+            auto numWritten = pwrite (fd, data, (size_t) numBytes, (off_t) position);
+
+            if (numWritten < 0 && errno == EINTR)
+                continue;
+
+            if (numWritten <= 0)
+                return false;
+
+            position += numWritten;
+            data += numWritten;
+            numBytes -= (int) numWritten;
+        }
+
+        return true;
+    }
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (FileStream)
+};
+
+//==============================================================================
+class MultiTrackRecorder::Worker  : public Thread
+{
+public:
+    Worker (MultiTrackRecorder& r, int index)
+        : Thread ("Multitrack recorder " + String (index)), owner (r), workerIndex (index)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread (4000);
+    }
+
+    void run() override
+    {
+        // The audio thread doesn't wake this up, as that could block it, so it polls
+        // instead. A block usually holds a lot more audio than this interval.
+        while (! threadShouldExit())
+            if (! owner.serviceTracks (workerIndex))
+                wait (2);
+    }
+
+private:
+    MultiTrackRecorder& owner;
+    const int workerIndex;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+MultiTrackRecorder::MultiTrackRecorder()  : MultiTrackRecorder (Options{}) {}
+
+MultiTrackRecorder::MultiTrackRecorder (const Options& optionsToUse)
+    : options (optionsToUse),
+      freeFifo (optionsToUse.numPoolBlocks + 1)
+{
+    jassert (options.blockSize > 0 && options.numPoolBlocks > 0 && options.maxChannelsPerTrack > 0
+              && options.maxNumTracks > 0 && options.numThreads > 0 && options.writeSizeBytes > 0);
+
+    for (int i = 0; i < options.numPoolBlocks; ++i)
+        blocks.push_back (std::make_unique<Block> (options.maxChannelsPerTrack, options.blockSize));
+
+    freeBlocks.resize ((size_t) options.numPoolBlocks + 1);
+
+    for (auto& block : blocks)
+        returnBlock (block.get());
+
+    for (int i = 0; i < options.maxNumTracks; ++i)
+        tracks.push_back (std::make_unique<Track> (options.numPoolBlocks + 1));
+
+    for (int i = 0; i < options.numThreads; ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, i));
+        workers.back()->startThread (Thread::Priority::high);
+    }
+}
+
+MultiTrackRecorder::~MultiTrackRecorder()
+{
+    for (int i = 0; i < (int) tracks.size(); ++i)
+        removeTrack (i);
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    workers.clear();
+}
+
+//==============================================================================
+int MultiTrackRecorder::addTrack (const File& file, AudioFormat& format, int numChannels, double sampleRate,
+                                  int bitsPerSample, const StringPairArray& metadataValues, int qualityOptionIndex)
+{
+    // A track can't have more channels than the blocks in the pool
+    jassert (numChannels > 0 && numChannels <= options.maxChannelsPerTrack);
+
+    if (numChannels <= 0 || numChannels > options.maxChannelsPerTrack)
+        return -1;
+
+    const std::lock_guard<std::mutex> sl (tracksLock);
+
+    auto slot = std::find_if (tracks.begin(), tracks.end(), [] (const auto& t) { return ! t->active.load(); });
+
+    if (slot == tracks.end())
+        return -1;
+
+    auto stream = std::make_unique<FileStream> (*this, file);
+
+    if (! stream->openedOk())
+    {
+        addFileStatistics (0, 0, 1);
+        return -1;
+    }
+
+    std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (stream.get(), sampleRate, (unsigned int) numChannels,
+                                                                       bitsPerSample, metadataValues, qualityOptionIndex));
+
+    if (writer == nullptr)
+        return -1;
+
+    stream.release();
+
+    auto& track = **slot;
+
+    {
+        const ScopedLock sl2 (track.lock);
+        track.writer = std::move (writer);
+        track.receiver = nullptr;
+        track.numSamplesWritten = 0;
+    }
+
+    track.numChannels = numChannels;
+    track.currentBlock = nullptr;
+    track.active = true;
+
+    return (int) std::distance (tracks.begin(), slot);
+}
+
+void MultiTrackRecorder::removeTrack (int trackIndex)
+{
+    if (! isPositiveAndBelow (trackIndex, (int) tracks.size()))
+        return;
+
+    auto& track = *tracks[(size_t) trackIndex];
+
+    if (! track.active.exchange (false))
+        return;
+
+    if (auto* block = track.currentBlock)
+    {
+        if (block->numSamples > 0)
+            queueBlock (track);
+        else
+            returnBlock (block);
+
+        track.currentBlock = nullptr;
+    }
+
+    while (track.queue.getNumReady() > 0)
+        Thread::sleep (1);
+
+    std::unique_ptr<AudioFormatWriter> writer;
+
+    {
+        const ScopedLock sl (track.lock);
+        std::swap (writer, track.writer);
+        track.receiver = nullptr;
+    }
+
+    // Deleting the writer finishes the header and closes the file
+    writer.reset();
+}
+
+bool MultiTrackRecorder::write (int trackIndex, const float* const* data, int numSamples) noexcept
+{
+    jassert (isPositiveAndBelow (trackIndex, (int) tracks.size()));
+
+    auto& track = *tracks[(size_t) trackIndex];
+
+    if (! track.active.load (std::memory_order_acquire))
+        return false;
+
+    int offset = 0;
+
+    while (offset < numSamples)
+    {
+        if (track.currentBlock == nullptr)
+        {
+            track.currentBlock = popFreeBlock();
+
+            if (track.currentBlock == nullptr)
+            {
+                ++numUnderruns;
+                numSamplesDropped += numSamples - offset;
+                return false;
+            }
+        }
+
+        auto& block = *track.currentBlock;
+        auto numToCopy = jmin (numSamples - offset, options.blockSize - block.numSamples);
+
+        for (int i = 0; i < track.numChannels; ++i)
+            block.buffer.copyFrom (i, block.numSamples, data[i] + offset, numToCopy);
+
+        block.numSamples += numToCopy;
+        offset += numToCopy;
+
+        if (block.numSamples == options.blockSize)
+        {
+            queueBlock (track);
+            track.currentBlock = nullptr;
+        }
+    }
+
+    return true;
+}
+
+void MultiTrackRecorder::setDataReceiver (int trackIndex, AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* newReceiver)
+{
+    if (! isPositiveAndBelow (trackIndex, (int) tracks.size()))
+        return;
+
+    auto& track = *tracks[(size_t) trackIndex];
+    const ScopedLock sl (track.lock);
+
+    if (track.writer == nullptr)
+        return;
+
+    if (newReceiver != nullptr)
+        newReceiver->reset (track.numChannels, track.writer->getSampleRate(), 0);
+
+    track.receiver = newReceiver;
+}
+
+int64 MultiTrackRecorder::getNumSamplesWritten (int trackIndex) const noexcept
+{
+    if (isPositiveAndBelow (trackIndex, (int) tracks.size()))
+        return tracks[(size_t) trackIndex]->numSamplesWritten.load();
+
+    return 0;
+}
+
+//==============================================================================
+MultiTrackRecorder::Statistics MultiTrackRecorder::getStatistics() const
+{
+    Statistics s;
+    s.numUnderruns = numUnderruns.load();
+    s.numSamplesDropped = numSamplesDropped.load();
+    s.peakBlocksInUse = peakBlocksInUse.load();
+
+    const std::lock_guard<std::mutex> sl (statisticsLock);
+    s.averageLatencyMs = numLatencyMeasurements > 0 ? totalLatencyMs / (double) numLatencyMeasurements : 0.0;
+    s.maxLatencyMs = maxLatencyMs;
+    s.numFileWrites = numFileWrites;
+    s.numBytesWritten = numBytesWritten;
+    s.numWriteErrors = numWriteErrors;
+    return s;
+}
+
+void MultiTrackRecorder::resetStatistics()
+{
+    numUnderruns = 0;
+    numSamplesDropped = 0;
+    peakBlocksInUse = options.numPoolBlocks - freeFifo.getNumReady();
+
+    const std::lock_guard<std::mutex> sl (statisticsLock);
+    totalLatencyMs = maxLatencyMs = 0;
+    numLatencyMeasurements = numFileWrites = numBytesWritten = 0;
+    numWriteErrors = 0;
+}
+
+void MultiTrackRecorder::addFileStatistics (int64 numWrites, int64 numBytes, int numErrors)
+{
+    const std::lock_guard<std::mutex> sl (statisticsLock);
+    numFileWrites += numWrites;
+    numBytesWritten += numBytes;
+    numWriteErrors += numErrors;
+}
+
+//==============================================================================
+// Only called by the audio thread, so there's a single reader of the free list
+MultiTrackRecorder::Block* MultiTrackRecorder::popFreeBlock() noexcept
+{
+    const auto scope = freeFifo.read (1);
+
+    if (scope.blockSize1 == 0)
+        return nullptr;
+
+    auto* block = freeBlocks[(size_t) scope.startIndex1];
+    block->numSamples = 0;
+
+    auto numInUse = options.numPoolBlocks - freeFifo.getNumReady() + 1;
+    auto peak = peakBlocksInUse.load();
+
+    while (numInUse > peak && ! peakBlocksInUse.compare_exchange_weak (peak, numInUse)) {}
+
+    return block;
+}
+
+void MultiTrackRecorder::returnBlock (Block* block)
+{
+    // There can be several background threads, so they take turns to write to the free list
+    const std::lock_guard<std::mutex> sl (freeLock);
+    const auto scope = freeFifo.write (1);
+
+    jassert (scope.blockSize1 == 1);
+    freeBlocks[(size_t) scope.startIndex1] = block;
+}
+
+void MultiTrackRecorder::queueBlock (Track& track) noexcept
+{
+    track.currentBlock->queuedTicks = Time::getHighResolutionTicks();
+
+    const auto scope = track.queue.write (1);
+
+    // The queue has room for every block in the pool
+    jassert (scope.blockSize1 == 1);
+    track.queuedBlocks[(size_t) scope.startIndex1] = track.currentBlock;
+}
+
+bool MultiTrackRecorder::serviceTracks (int workerIndex)
+{
+    bool anythingDone = false;
+
+    for (auto i = (size_t) workerIndex; i < tracks.size(); i += (size_t) options.numThreads)
+        if (tracks[i]->queue.getNumReady() > 0)
+            anythingDone = serviceTrack (*tracks[i]) || anythingDone;
+
+    return anythingDone;
+}
+
+bool MultiTrackRecorder::serviceTrack (Track& track)
+{
+    const ScopedLock sl (track.lock);
+    bool anythingDone = false;
+
+    while (track.queue.getNumReady() > 0)
+    {
+        Block* block = nullptr;
+
+        {
+            const auto scope = track.queue.read (1);
+            block = track.queuedBlocks[(size_t) scope.startIndex1];
+        }
+
+        if (track.writer != nullptr)
+        {
+            const AudioBuffer<float> data (block->buffer.getArrayOfWritePointers(), track.numChannels, block->numSamples);
+
+            track.writer->writeFromAudioSampleBuffer (data, 0, block->numSamples);
+
+            if (track.receiver != nullptr)
+                track.receiver->addBlock (track.numSamplesWritten.load(), data, 0, block->numSamples);
+
+            track.numSamplesWritten += block->numSamples;
+        }
+
+        auto latencyMs = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - block->queuedTicks) * 1000.0;
+
+        {
+            const std::lock_guard<std::mutex> sl2 (statisticsLock);
+            totalLatencyMs += latencyMs;
+            maxLatencyMs = jmax (maxLatencyMs, latencyMs);
+            ++numLatencyMeasurements;
+        }
+
+        returnBlock (block);
+        anythingDone = true;
+    }
+
+    return anythingDone;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MultiTrackRecorderTests  : public UnitTest
+{
+public:
+    MultiTrackRecorderTests()
+        : UnitTest ("MultiTrackRecorder", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        MultiTrackRecorder::Options options;
+        options.blockSize = 512;
+        options.writeSizeBytes = 16384;
+        options.preallocationBytes = 65536;
+
+        beginTest ("Recorded tracks contain the data that was written");
+        {
+            options.numPoolBlocks = 64;
+            options.numThreads = 2;
+            expectTracksMatch (options, 8, 20000);
+        }
+
+        beginTest ("Recording works with direct I/O");
+        {
+            options.useDirectIO = true;
+            expectTracksMatch (options, 3, 30001);
+            options.useDirectIO = false;
+        }
+
+        beginTest ("An exhausted pool is reported as an underrun");
+        {
+            options.numPoolBlocks = 2;
+            options.numThreads = 1;
+
+            TemporaryFile temp (".wav");
+            WavAudioFormat wav;
+
+            {
+                MultiTrackRecorder recorder (options);
+                auto track = recorder.addTrack (temp.getFile(), wav, 1, 44100.0, 16);
+                expect (track >= 0);
+
+                AudioBuffer<float> buffer (1, options.blockSize * 4);
+                buffer.clear();
+
+                expect (! recorder.write (track, buffer.getArrayOfReadPointers(), buffer.getNumSamples()));
+
+                auto stats = recorder.getStatistics();
+                expectEquals (stats.numUnderruns, 1);
+                expectEquals (stats.numSamplesDropped, (int64) options.blockSize * 2);
+                expectEquals (stats.peakBlocksInUse, 2);
+
+                recorder.removeTrack (track);
+                expectEquals (recorder.getNumSamplesWritten (track), (int64) options.blockSize * 2);
+            }
+        }
+    }
+
+private:
+    static float getSample (int track, int channel, int index)
+    {
+        return (float) ((index * (track + 1) + channel * 100) % 2000 - 1000) / 1024.0f;
+    }
+
+    void expectTracksMatch (const MultiTrackRecorder::Options& options, int numTracks, int numSamples)
+    {
+        constexpr int numChannels = 2;
+        WavAudioFormat wav;
+        OwnedArray<TemporaryFile> files;
+
+        {
+            MultiTrackRecorder recorder (options);
+            Array<int> trackIndexes;
+
+            for (int t = 0; t < numTracks; ++t)
+            {
+                files.add (new TemporaryFile (".wav"));
+                trackIndexes.add (recorder.addTrack (files.getLast()->getFile(), wav, numChannels, 44100.0, 24));
+                expect (trackIndexes.getLast() >= 0);
+            }
+
+            AudioBuffer<float> buffer (numChannels, 300);
+
+            for (int start = 0; start < numSamples; start += buffer.getNumSamples())
+            {
+                auto num = jmin (buffer.getNumSamples(), numSamples - start);
+
+                for (int t = 0; t < numTracks; ++t)
+                {
+                    for (int c = 0; c < numChannels; ++c)
+                        for (int i = 0; i < num; ++i)
+                            buffer.setSample (c, i, getSample (t, c, start + i));
+
+                    while (! recorder.write (trackIndexes[t], buffer.getArrayOfReadPointers(), num))
+                        expect (false, "underrun");
+                }
+
+                Thread::sleep (1);
+            }
+
+            for (auto t : trackIndexes)
+                recorder.removeTrack (t);
+
+            auto stats = recorder.getStatistics();
+            expectEquals (stats.numUnderruns, 0);
+            expectEquals (stats.numWriteErrors, 0);
+            expect (stats.numFileWrites > 0);
+            expectGreaterOrEqual (stats.numBytesWritten, (int64) numTracks * numSamples * numChannels * 3);
+        }
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            std::unique_ptr<AudioFormatReader> reader (wav.createReaderFor (files[t]->getFile().createInputStream().release(), true));
+            expect (reader != nullptr);
+
+            if (reader == nullptr)
+                continue;
+
+            expectEquals (reader->lengthInSamples, (int64) numSamples);
+
+            AudioBuffer<float> result (numChannels, numSamples);
+            reader->read (&result, 0, numSamples, 0, true, true);
+
+            for (int c = 0; c < numChannels; ++c)
+                for (int i = 0; i < numSamples; ++i)
+                    if (std::abs (result.getSample (c, i) - getSample (t, c, i)) > 1.0e-5f)
+                        return expect (false, "sample mismatch in track " + String (t));
+        }
+    }
+};
+
+static MultiTrackRecorderTests multiTrackRecorderTests;
+
+#endif
+
+} // namespace juce
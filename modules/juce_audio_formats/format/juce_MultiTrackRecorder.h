@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records many tracks to disk at once, for example all the inputs of a large
+    multitrack session.
+
+    An AudioFormatWriter::ThreadedWriter per track gives each track its own FIFO and
+    its own TimeSliceClient, and flushes it through the writer in small pieces. With
+    many tracks, that means lots of clients competing for one background thread, and
+    files that grow a little at a time and end up fragmented.
+
+    A MultiTrackRecorder instead keeps one pool of fixed-size audio blocks that's shared
+    between all its tracks. The audio thread fills a block for each track and hands it
+    to a background thread once it's full. The background thread encodes it, and collects
+    the encoded data for each file in a large aligned buffer, which is only written out
+    once it's full. File space is reserved ahead of the data, so each file is laid out
+    in a few large extents, and the files can optionally be written with direct I/O,
+    bypassing the operating system's page cache.
+
+    The recorder keeps statistics about the pool and the write latency, which can be used
+    to tune the pool size for a particular disk and track count.
+
+    @see AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  MultiTrackRecorder
+{
+public:
+    //==============================================================================
+    /** The settings used to create a MultiTrackRecorder. */
+    struct Options
+    {
+        /** The number of sample frames in each pooled block. */
+        int blockSize = 8192;
+
+        /** The total number of blocks in the pool, shared between all the tracks. This,
+            together with the block size and the maximum number of channels, sets the
+            amount of memory used for buffering.
+        */
+        int numPoolBlocks = 1024;
+
+        /** The largest number of channels a track may have. */
+        int maxChannelsPerTrack = 2;
+
+        /** The largest number of tracks that can exist at the same time. */
+        int maxNumTracks = 256;
+
+        /** The number of background threads that write to disk. */
+        int numThreads = 1;
+
+        /** The amount of encoded data that's collected for each file before it's written.
+            This is rounded up to a multiple of the alignment needed for direct I/O.
+        */
+        int writeSizeBytes = 1 << 20;
+
+        /** The amount of disk space that's reserved at a time as each file grows, or 0
+            to leave it to the file system. The reservation doesn't change the length of
+            the file, so nothing needs trimming if recording stops early.
+        */
+        int64 preallocationBytes = 64 << 20;
+
+        /** If true, the files bypass the operating system's page cache where the platform
+            allows it (O_DIRECT on Linux, F_NOCACHE on macOS, FILE_FLAG_NO_BUFFERING on
+            Windows). If the file system doesn't support it, normal buffered I/O is used.
+        */
+        bool useDirectIO = false;
+    };
+
+    /** Creates a recorder and starts its background threads. */
+    explicit MultiTrackRecorder (const Options& options);
+
+    /** Creates a recorder using the default options. */
+    MultiTrackRecorder();
+
+    /** Destructor.
+        Any remaining tracks are removed, which writes out their data and closes their files.
+    */
+    ~MultiTrackRecorder();
+
+    //==============================================================================
+    /** Creates a new file and starts a track that records into it.
+
+        Any existing file is replaced. Returns the index of the new track, which is
+        passed to write() and removeTrack(), or -1 if the file or writer couldn't be
+        created, or the recorder already has its maximum number of tracks.
+
+        Call this on a thread other than the audio thread, as it opens the file.
+    */
+    int addTrack (const File& file,
+                  AudioFormat& format,
+                  int numChannels,
+                  double sampleRate,
+                  int bitsPerSample,
+                  const StringPairArray& metadataValues = {},
+                  int qualityOptionIndex = 0);
+
+    /** Finishes a track.
+
+        This waits until all the data written to the track has been handed to its writer,
+        and then deletes the writer, which finishes and closes its file. Make sure that
+        write() isn't being called for this track when you call this.
+    */
+    void removeTrack (int trackIndex);
+
+    /** Adds some samples to a track.
+
+        This is designed to be called on the audio thread. It doesn't block or allocate,
+        and only touches the disk indirectly, through the background threads. All the
+        tracks should be written from the same thread.
+
+        If the pool has run out of free blocks because the disk can't keep up, some
+        samples are dropped, the underrun counter is incremented and this returns false.
+    */
+    bool write (int trackIndex, const float* const* data, int numSamples) noexcept;
+
+    /** Sets a receiver that's passed the audio of a track as it's written, e.g. an
+        AudioThumbnail. The receiver is called on a background thread. Pass nullptr to
+        remove it. The receiver must stay valid until it's removed, or the track is.
+    */
+    void setDataReceiver (int trackIndex, AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* receiver);
+
+    /** Returns the number of samples written to a track so far. */
+    int64 getNumSamplesWritten (int trackIndex) const noexcept;
+
+    //==============================================================================
+    /** Returns the options that this recorder was created with. */
+    const Options& getOptions() const noexcept              { return options; }
+
+    /** Some statistics about the recorder's performance. */
+    struct Statistics
+    {
+        /** The number of times write() had to drop samples because there were no free blocks. */
+        int numUnderruns = 0;
+
+        /** The total number of samples dropped by underruns, summed over all the tracks. */
+        int64 numSamplesDropped = 0;
+
+        /** The largest number of blocks that have been in use at once. */
+        int peakBlocksInUse = 0;
+
+        /** The average and largest times between a block being filled by the audio thread,
+            and it being encoded and handed to its file, in milliseconds.
+        */
+        double averageLatencyMs = 0, maxLatencyMs = 0;
+
+        /** The number of write operations made to the files, and the total bytes written. */
+        int64 numFileWrites = 0, numBytesWritten = 0;
+
+        /** The number of file operations that have failed. */
+        int numWriteErrors = 0;
+    };
+
+    /** Returns a snapshot of the recorder's statistics. */
+    Statistics getStatistics() const;
+
+    /** Resets the statistics. */
+    void resetStatistics();
+
+private:
+    //==============================================================================
+    struct Block;
+    struct Track;
+    class FileStream;
+    class Worker;
+
+    Block* popFreeBlock() noexcept;
+    void returnBlock (Block*);
+    void queueBlock (Track&) noexcept;
+    bool serviceTracks (int workerIndex);
+    bool serviceTrack (Track&);
+    void addFileStatistics (int64 numWrites, int64 numBytes, int numErrors);
+
+    Options options;
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<Block*> freeBlocks;
+    AbstractFifo freeFifo;
+    std::mutex freeLock;
+
+    std::vector<std::unique_ptr<Track>> tracks;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex tracksLock;
+
+    std::atomic<int> numUnderruns { 0 }, peakBlocksInUse { 0 };
+    std::atomic<int64> numSamplesDropped { 0 };
+
+    mutable std::mutex statisticsLock;
+    double totalLatencyMs = 0, maxLatencyMs = 0;
+    int64 numLatencyMeasurements = 0, numFileWrites = 0, numBytesWritten = 0;
+    int numWriteErrors = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiTrackRecorder)
+};
+
+} // namespace juce
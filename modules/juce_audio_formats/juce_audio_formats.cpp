@@ -51,15 +51,26 @@
  #include <wmsdk.h>
 #endif
 
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
 //==============================================================================
 #include "format/juce_AudioFormat.cpp"
 #include "format/juce_AudioFormatManager.cpp"
 #include "format/juce_AudioFormatReader.cpp"
 #include "format/juce_AudioFormatReaderSource.cpp"
 #include "format/juce_AudioFormatWriter.cpp"
+#include "format/juce_AudioLevelScanner.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_CachingAudioFormatReader.cpp"
+#include "format/juce_AudioFileConverter.cpp"
+#include "format/juce_MultiTrackRecorder.cpp"
 #include "sampler/juce_Sampler.cpp"
+#include "sampler/juce_StreamingSampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
 #include "codecs/juce_FlacAudioFormat.cpp"
@@ -71,6 +82,7 @@
 #if JucePlugin_Enable_ARA
  #include "juce_audio_processors/utilities/ARA/juce_ARADocumentControllerCommon.cpp"
  #include "format/juce_ARAAudioReaders.cpp"
+ #include "format/juce_ARAAudioSourceAnalyser.cpp"
 #endif
 
 #if JUCE_WINDOWS && JUCE_USE_WINDOWS_MEDIA_FORMAT
@@ -113,12 +113,16 @@
 //==============================================================================
 #include "format/juce_AudioFormatReader.h"
 #include "format/juce_AudioFormatWriter.h"
+#include "format/juce_AudioLevelScanner.h"
 #include "format/juce_MemoryMappedAudioFormatReader.h"
 #include "format/juce_AudioFormat.h"
 #include "format/juce_AudioFormatManager.h"
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
 #include "format/juce_BufferingAudioFormatReader.h"
+#include "format/juce_CachingAudioFormatReader.h"
+#include "format/juce_AudioFileConverter.h"
+#include "format/juce_MultiTrackRecorder.h"
 #include "codecs/juce_AiffAudioFormat.h"
 #include "codecs/juce_CoreAudioFormat.h"
 #include "codecs/juce_FlacAudioFormat.h"
@@ -128,9 +132,11 @@
 #include "codecs/juce_WavAudioFormat.h"
 #include "codecs/juce_WindowsMediaAudioFormat.h"
 #include "sampler/juce_Sampler.h"
+#include "sampler/juce_StreamingSampler.h"
 
 #if JucePlugin_Enable_ARA
  #include <juce_audio_processors/juce_audio_processors.h>
 
  #include "format/juce_ARAAudioReaders.h"
+ #include "format/juce_ARAAudioSourceAnalyser.h"
 #endif
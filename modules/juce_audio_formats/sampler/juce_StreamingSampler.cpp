@@ -0,0 +1,777 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct SampleStreamer::Block
+{
+    explicit Block (int numFrames)  : data (2, numFrames) {}
+
+    AudioBuffer<float> data;
+
+    // These are protected by the cacheLock, and can only change while the block isn't pinned
+    StreamingSamplerSound* sound = nullptr;
+    int index = -1;
+    int numPins = 0;
+    uint32 lastUsed = 0;
+
+    std::atomic<bool> ready { false };
+};
+
+//==============================================================================
+struct SampleStreamer::Stream
+{
+    explicit Stream (int numSlotsToUse)
+        : numSlots (numSlotsToUse),
+          slots (new std::atomic<uint64>[(size_t) numSlotsToUse])
+    {
+        for (int i = 0; i < numSlots; ++i)
+            slots[(size_t) i].store (0);
+    }
+
+    // Written by the voice. Changing the generation tells the background threads that
+    // the voice has started or stopped a note, and invalidates all the published slots.
+    std::atomic<uint32> generation { 0 };
+    std::atomic<StreamingSamplerSound*> sound { nullptr };
+    std::atomic<int64> position { 0 };
+
+    // Written by the background threads: the slot for block n holds the generation it was
+    // published for in its top half, and the position of the block in the cache plus one
+    // in its bottom half.
+    const int numSlots;
+    std::unique_ptr<std::atomic<uint64>[]> slots;
+
+    // Only used by whichever background thread has claimed the stream
+    struct Pin
+    {
+        int cacheIndex;
+        bool published;
+    };
+
+    std::atomic<bool> claimed { false };
+    uint32 servicedGeneration = 0;
+    std::vector<Pin> pins;
+};
+
+//==============================================================================
+class SampleStreamer::Worker  : public Thread
+{
+public:
+    Worker (SampleStreamer& s, int workerIndex)
+        : Thread ("Sample streamer " + String (workerIndex)), owner (s)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread (4000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! owner.serviceStreams())
+                wait (1);
+    }
+
+private:
+    SampleStreamer& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+// Keeps the background threads out of the stream list while streams or sounds are
+// being added or removed.
+class SampleStreamer::ScopedPause
+{
+public:
+    explicit ScopedPause (SampleStreamer& s)  : owner (s)
+    {
+        ++owner.numPauseRequests;
+
+        while (owner.numBusyWorkers.load() > 0)
+            std::this_thread::yield();
+    }
+
+    ~ScopedPause()
+    {
+        --owner.numPauseRequests;
+    }
+
+private:
+    SampleStreamer& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedPause)
+};
+
+//==============================================================================
+SampleStreamer::SampleStreamer()  : SampleStreamer (Options{}) {}
+
+SampleStreamer::SampleStreamer (const Options& optionsToUse)
+    : options (optionsToUse)
+{
+    jassert (options.blockSize > 0 && options.numBlocksAhead > 0 && options.numThreads > 0);
+
+    // The cache must be able to hold the blocks that a voice is about to play
+    jassert (options.numCacheBlocks >= options.numBlocksAhead);
+
+    for (int i = 0; i < options.numCacheBlocks; ++i)
+        blocks.push_back (std::make_unique<Block> (options.blockSize));
+
+    for (int i = 0; i < options.numThreads; ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, i));
+        workers.back()->startThread (Thread::Priority::high);
+    }
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    // All the voices that use this streamer must be deleted before it is!
+    jassert (streams.empty());
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    workers.clear();
+}
+
+//==============================================================================
+void SampleStreamer::removeSound (StreamingSamplerSound& sound)
+{
+    const ScopedPause pause (*this);
+    const std::lock_guard<std::mutex> sl (cacheLock);
+
+    for (auto& stream : streams)
+    {
+        // A voice is still playing this sound!
+        jassert (stream->sound.load() != &sound);
+
+        unpinBlocks (*stream, [&sound] (const Block& b) { return b.sound == &sound; });
+    }
+
+    for (auto& block : blocks)
+    {
+        if (block->sound == &sound)
+        {
+            jassert (block->numPins == 0);
+
+            block->sound = nullptr;
+            block->index = -1;
+            block->lastUsed = 0;
+            block->ready = false;
+        }
+    }
+}
+
+SampleStreamer::Stream* SampleStreamer::addStream()
+{
+    auto stream = std::make_unique<Stream> (options.numBlocksAhead + 1);
+    auto* result = stream.get();
+
+    const ScopedPause pause (*this);
+    const std::lock_guard<std::mutex> sl (cacheLock);
+    streams.push_back (std::move (stream));
+
+    return result;
+}
+
+void SampleStreamer::removeStream (Stream* stream)
+{
+    const ScopedPause pause (*this);
+    const std::lock_guard<std::mutex> sl (cacheLock);
+
+    auto found = std::find_if (streams.begin(), streams.end(), [stream] (const auto& s) { return s.get() == stream; });
+
+    if (found != streams.end())
+    {
+        unpinBlocks (*stream, [] (const Block&) { return true; });
+        streams.erase (found);
+    }
+}
+
+//==============================================================================
+bool SampleStreamer::serviceStreams()
+{
+    ++numBusyWorkers;
+
+    if (numPauseRequests.load() > 0)
+    {
+        --numBusyWorkers;
+        return false;
+    }
+
+    bool anyBlocksRead = false;
+
+    for (auto& stream : streams)
+    {
+        bool wasClaimed = false;
+
+        if (! stream->claimed.compare_exchange_strong (wasClaimed, true))
+            continue;
+
+        if (serviceStream (*stream))
+            anyBlocksRead = true;
+
+        stream->claimed = false;
+
+        if (numPauseRequests.load() > 0)
+            break;
+    }
+
+    --numBusyWorkers;
+    return anyBlocksRead;
+}
+
+bool SampleStreamer::serviceStream (Stream& stream)
+{
+    const auto generation = stream.generation.load (std::memory_order_acquire);
+    auto* sound = stream.sound.load (std::memory_order_acquire);
+    const auto position = stream.position.load (std::memory_order_acquire);
+
+    std::vector<int> blocksToLoad;
+
+    {
+        const std::lock_guard<std::mutex> sl (cacheLock);
+
+        if (generation != stream.servicedGeneration)
+        {
+            unpinBlocks (stream, [] (const Block&) { return true; });
+            stream.servicedGeneration = generation;
+        }
+
+        if (sound == nullptr)
+            return false;
+
+        const auto firstBlock = (int) (jmax ((int64) 0, position - sound->preloadLength) / options.blockSize);
+        const auto endBlock = jmin (sound->getNumStreamedBlocks(), firstBlock + options.numBlocksAhead);
+
+        // The voice has moved past these, so they can go back into the pool
+        unpinBlocks (stream, [firstBlock] (const Block& b) { return b.index < firstBlock; });
+
+        for (auto index = firstBlock; index < endBlock; ++index)
+        {
+            const auto alreadyPinned = std::any_of (stream.pins.begin(), stream.pins.end(), [&] (const Stream::Pin& pin)
+            {
+                return blocks[(size_t) pin.cacheIndex]->index == index;
+            });
+
+            if (alreadyPinned)
+                continue;
+
+            bool needsLoading = false;
+            const auto cacheIndex = findOrAllocateBlock (*sound, index, needsLoading);
+
+            if (cacheIndex < 0)
+                break;
+
+            stream.pins.push_back ({ cacheIndex, false });
+
+            if (needsLoading)
+                blocksToLoad.push_back (cacheIndex);
+        }
+    }
+
+    for (auto cacheIndex : blocksToLoad)
+        loadBlock (*blocks[(size_t) cacheIndex]);
+
+    // Pinned blocks can't be recycled, so they can be published without holding the lock
+    for (auto& pin : stream.pins)
+    {
+        auto& block = *blocks[(size_t) pin.cacheIndex];
+
+        if (! pin.published && block.ready.load (std::memory_order_acquire))
+        {
+            stream.slots[(size_t) (block.index % stream.numSlots)].store (((uint64) generation << 32) | (uint64) (pin.cacheIndex + 1),
+                                                                          std::memory_order_release);
+            pin.published = true;
+        }
+    }
+
+    return ! blocksToLoad.empty();
+}
+
+void SampleStreamer::unpinBlocks (Stream& stream, std::function<bool (const Block&)> shouldUnpin)
+{
+    stream.pins.erase (std::remove_if (stream.pins.begin(), stream.pins.end(), [&] (const Stream::Pin& pin)
+                       {
+                           auto& block = *blocks[(size_t) pin.cacheIndex];
+
+                           if (! shouldUnpin (block))
+                               return false;
+
+                           --block.numPins;
+                           return true;
+                       }),
+                       stream.pins.end());
+}
+
+int SampleStreamer::findOrAllocateBlock (StreamingSamplerSound& sound, int blockIndex, bool& needsLoading)
+{
+    int leastRecentlyUsed = -1;
+
+    for (int i = 0; i < (int) blocks.size(); ++i)
+    {
+        auto& block = *blocks[(size_t) i];
+
+        if (block.sound == &sound && block.index == blockIndex)
+        {
+            ++block.numPins;
+            block.lastUsed = ++useCounter;
+            ++numCacheHits;
+            needsLoading = false;
+            return i;
+        }
+
+        // Blocks that some voice is about to play are never evicted
+        if (block.numPins == 0
+             && (leastRecentlyUsed < 0 || block.lastUsed < blocks[(size_t) leastRecentlyUsed]->lastUsed))
+            leastRecentlyUsed = i;
+    }
+
+    if (leastRecentlyUsed >= 0)
+    {
+        auto& block = *blocks[(size_t) leastRecentlyUsed];
+        block.sound = &sound;
+        block.index = blockIndex;
+        block.numPins = 1;
+        block.lastUsed = ++useCounter;
+        block.ready = false;
+        needsLoading = true;
+    }
+
+    return leastRecentlyUsed;
+}
+
+void SampleStreamer::loadBlock (Block& block)
+{
+    auto& sound = *block.sound;
+    const auto startSample = (int64) sound.preloadLength + (int64) block.index * options.blockSize;
+    const auto numSamples = (int) jmin ((int64) options.blockSize, sound.length - startSample);
+
+    {
+        const ScopedLock sl (sound.readerLock);
+        sound.reader->read (&block.data, 0, numSamples, startSample, true, true);
+    }
+
+    if (numSamples < options.blockSize)
+        block.data.clear (numSamples, options.blockSize - numSamples);
+
+    ++numBlocksRead;
+    block.ready.store (true, std::memory_order_release);
+}
+
+const SampleStreamer::Block* SampleStreamer::getBlockForVoice (const Stream& stream, uint32 generation, int blockIndex) const noexcept
+{
+    const auto slot = stream.slots[(size_t) (blockIndex % stream.numSlots)].load (std::memory_order_acquire);
+
+    if ((uint32) (slot >> 32) != generation)
+        return nullptr;
+
+    const auto cacheIndex = (int) (slot & 0xffffffff) - 1;
+
+    if (! isPositiveAndBelow (cacheIndex, (int) blocks.size()))
+        return nullptr;
+
+    auto* block = blocks[(size_t) cacheIndex].get();
+    return block->index == blockIndex ? block : nullptr;
+}
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (SampleStreamer& streamerToUse,
+                                              const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadTimeSecs)
+    : streamer (streamerToUse),
+      name (soundName),
+      reader (std::move (source)),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (reader != nullptr && reader->sampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        sourceSampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        preloadLength = (int) jlimit ((int64) 0, length, (int64) (preloadTimeSecs * sourceSampleRate));
+
+        preloaded.setSize (2, preloadLength);
+        reader->read (&preloaded, 0, preloadLength, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+    streamer.removeSound (*this);
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+int StreamingSamplerSound::getNumStreamedBlocks() const noexcept
+{
+    const auto blockSize = (int64) streamer.getOptions().blockSize;
+    return (int) ((length - preloadLength + blockSize - 1) / blockSize);
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SampleStreamer& streamerToUse)
+    : streamer (streamerToUse),
+      stream (streamerToUse.addStream())
+{
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    streamer.removeStream (stream);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        currentBlock = nullptr;
+        currentBlockIndex = -1;
+
+        stream->position.store (0, std::memory_order_relaxed);
+        stream->sound.store (sound, std::memory_order_relaxed);
+        stream->generation.store (++generation, std::memory_order_release);
+
+        adsr.noteOn();
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        releaseStream();
+        clearCurrentNote();
+        adsr.reset();
+    }
+}
+
+void StreamingSamplerVoice::releaseStream() noexcept
+{
+    currentBlock = nullptr;
+    currentBlockIndex = -1;
+
+    stream->sound.store (nullptr, std::memory_order_relaxed);
+    stream->generation.store (++generation, std::memory_order_release);
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+//==============================================================================
+bool StreamingSamplerVoice::getFrame (const StreamingSamplerSound& sound, int64 position, float& left, float& right) noexcept
+{
+    if (position >= sound.length)
+    {
+        left = right = 0.0f;
+        return true;
+    }
+
+    if (position < sound.preloadLength)
+    {
+        left  = sound.preloaded.getSample (0, (int) position);
+        right = sound.preloaded.getSample (1, (int) position);
+        return true;
+    }
+
+    const auto blockSize = streamer.options.blockSize;
+    const auto offset = position - sound.preloadLength;
+    const auto blockIndex = (int) (offset / blockSize);
+
+    if (blockIndex != currentBlockIndex || currentBlock == nullptr)
+    {
+        currentBlock = streamer.getBlockForVoice (*stream, generation, blockIndex);
+        currentBlockIndex = blockIndex;
+    }
+
+    if (currentBlock == nullptr)
+    {
+        left = right = 0.0f;
+        return false;
+    }
+
+    const auto frame = (int) (offset - (int64) blockIndex * blockSize);
+    left  = currentBlock->data.getSample (0, frame);
+    right = currentBlock->data.getSample (1, frame);
+    return true;
+}
+
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        // Lets the background threads know which blocks we've finished with
+        stream->position.store ((int64) sourceSamplePosition, std::memory_order_release);
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        bool hadUnderrun = false;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - (double) pos);
+            auto invAlpha = 1.0f - alpha;
+
+            float l0, r0, l1, r1;
+            const auto gotFirst  = getFrame (*playingSound, pos,     l0, r0);
+            const auto gotSecond = getFrame (*playingSound, pos + 1, l1, r1);
+
+            if (! (gotFirst && gotSecond))
+                hadUnderrun = true;
+
+            float l = l0 * invAlpha + l1 * alpha;
+            float r = r0 * invAlpha + r1 * alpha;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > (double) playingSound->length || ! adsr.isActive())
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+
+        if (hadUnderrun)
+            ++streamer.numUnderruns;
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StreamingSamplerTests  : public UnitTest
+{
+public:
+    StreamingSamplerTests()
+        : UnitTest ("StreamingSampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        constexpr int sampleLength = 3000;
+
+        SampleStreamer::Options options;
+        options.blockSize = 256;
+        options.numBlocksAhead = 4;
+
+        beginTest ("Streamed playback matches the source");
+        {
+            options.numCacheBlocks = 16;
+            SampleStreamer streamer (options);
+
+            {
+                Synthesiser synth;
+                auto* sound = addSound (synth, streamer, sampleLength);
+
+                expectEquals (sound->getLengthInSamples(), (int64) sampleLength);
+                expectEquals (sound->getPreloadLength(), 1024);
+
+                expectPlaybackMatchesSource (synth, sampleLength);
+                expectEquals (streamer.getNumUnderruns(), 0);
+                expectEquals (streamer.getNumBlocksRead(), 8);
+            }
+        }
+
+        beginTest ("Blocks are reused from the cache");
+        {
+            options.numCacheBlocks = 16;
+            SampleStreamer streamer (options);
+
+            {
+                Synthesiser synth;
+                addSound (synth, streamer, sampleLength);
+
+                expectPlaybackMatchesSource (synth, sampleLength);
+                expectPlaybackMatchesSource (synth, sampleLength);
+
+                expectEquals (streamer.getNumUnderruns(), 0);
+                expectEquals (streamer.getNumBlocksRead(), 8);
+                expectGreaterOrEqual (streamer.getNumCacheHits(), 8);
+            }
+        }
+
+        beginTest ("Playback still works when the cache is smaller than the sample");
+        {
+            options.numCacheBlocks = options.numBlocksAhead + 1;
+            SampleStreamer streamer (options);
+
+            {
+                Synthesiser synth;
+                addSound (synth, streamer, sampleLength);
+
+                expectPlaybackMatchesSource (synth, sampleLength);
+                expectPlaybackMatchesSource (synth, sampleLength);
+
+                expectEquals (streamer.getNumUnderruns(), 0);
+                expectEquals (streamer.getNumBlocksRead(), 16);
+            }
+        }
+    }
+
+private:
+    static float getSourceSample (int channel, int64 position)
+    {
+        const auto value = (float) (position % 1000) / 1000.0f;
+        return channel == 0 ? value : -value;
+    }
+
+    struct GeneratingReader  : public AudioFormatReader
+    {
+        explicit GeneratingReader (int64 length)
+            : AudioFormatReader (nullptr, {})
+        {
+            sampleRate            = 44100.0;
+            bitsPerSample         = 32;
+            usesFloatingPointData = true;
+            lengthInSamples       = length;
+            numChannels           = 2;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            clearSamplesBeyondAvailableLength (destChannels, numDestChannels, startOffsetInDestBuffer,
+                                               startSampleInFile, numSamples, lengthInSamples);
+
+            for (int channel = 0; channel < numDestChannels; ++channel)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[channel]))
+                    for (int i = 0; i < numSamples && startSampleInFile + i < lengthInSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = getSourceSample (channel, startSampleInFile + i);
+
+            return true;
+        }
+    };
+
+    static StreamingSamplerSound* addSound (Synthesiser& synth, SampleStreamer& streamer, int64 length)
+    {
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.addVoice (new StreamingSamplerVoice (streamer));
+
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        auto* sound = new StreamingSamplerSound (streamer, "test", std::make_unique<GeneratingReader> (length),
+                                                 notes, 60, 0.0, 0.0, 1024.0 / 44100.0);
+        synth.addSound (sound);
+        return sound;
+    }
+
+    void expectPlaybackMatchesSource (Synthesiser& synth, int length)
+    {
+        constexpr int blockSize = 128;
+
+        AudioBuffer<float> output (2, length + blockSize);
+        output.clear();
+
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            // Leaves the background threads plenty of time to keep up
+            Thread::sleep (10);
+
+            synth.renderNextBlock (output, midi, start, blockSize);
+            midi.clear();
+        }
+
+        auto maxError = 0.0f;
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < output.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (channel, i)
+                                                        - (i < length ? getSourceSample (channel, i) : 0.0f)));
+
+        expectLessThan (maxError, 1.0e-6f);
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
+} // namespace juce
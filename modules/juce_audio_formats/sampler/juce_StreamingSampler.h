@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingSamplerSound;
+class StreamingSamplerVoice;
+
+//==============================================================================
+/**
+    Streams the audio for a set of StreamingSamplerSounds from disk.
+
+    A SampleStreamer owns a fixed-size cache of audio blocks and a set of
+    background threads that fill it. Each StreamingSamplerVoice registers a
+    stream with the streamer; while the voice is playing, the background threads
+    keep the blocks just ahead of its play position loaded, so the audio thread
+    never has to touch the disk.
+
+    When the cache is full, the least recently used block that isn't needed by
+    any playing voice gets recycled. Blocks that a voice is about to play are
+    never evicted, and neither are the preloaded heads of the sounds, which stay
+    in memory for as long as the sound exists.
+
+    The streamer must outlive all of the sounds and voices that use it.
+
+    @see StreamingSamplerSound, StreamingSamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  SampleStreamer
+{
+public:
+    //==============================================================================
+    /** The settings used to create a SampleStreamer. */
+    struct Options
+    {
+        /** The number of sample frames in each streamed block. */
+        int blockSize = 16384;
+
+        /** The total number of blocks in the cache. This, together with the block
+            size, sets the amount of memory used for streaming.
+        */
+        int numCacheBlocks = 256;
+
+        /** The number of blocks that are kept loaded ahead of each playing voice. */
+        int numBlocksAhead = 3;
+
+        /** The number of background threads that read from disk. */
+        int numThreads = 2;
+    };
+
+    /** Creates a streamer and starts its background threads. */
+    explicit SampleStreamer (const Options& options);
+
+    /** Creates a streamer using the default options. */
+    SampleStreamer();
+
+    /** Destructor.
+        All the sounds and voices that use this streamer must have been deleted
+        before the streamer is destroyed.
+    */
+    ~SampleStreamer();
+
+    //==============================================================================
+    /** Returns the options that this streamer was created with. */
+    const Options& getOptions() const noexcept                  { return options; }
+
+    /** Returns the number of times a voice needed a block that wasn't ready yet.
+        Each time this happens the voice outputs silence, so a non-zero value
+        means the preload time or the number of blocks read ahead is too small for
+        the current disk and polyphony.
+    */
+    int getNumUnderruns() const noexcept                        { return numUnderruns.load(); }
+
+    /** Returns the number of blocks that have been read from disk so far. */
+    int getNumBlocksRead() const noexcept                       { return numBlocksRead.load(); }
+
+    /** Returns the number of block requests that were served from the cache
+        without needing to read from disk.
+    */
+    int getNumCacheHits() const noexcept                        { return numCacheHits.load(); }
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerSound;
+    friend class StreamingSamplerVoice;
+
+    struct Block;
+    struct Stream;
+    class Worker;
+
+    class ScopedPause;
+
+    void removeSound (StreamingSamplerSound&);
+    Stream* addStream();
+    void removeStream (Stream*);
+
+    bool serviceStreams();
+    bool serviceStream (Stream&);
+    void unpinBlocks (Stream&, std::function<bool (const Block&)>);
+    int findOrAllocateBlock (StreamingSamplerSound&, int blockIndex, bool& needsLoading);
+    void loadBlock (Block&);
+
+    const Block* getBlockForVoice (const Stream&, uint32 generation, int blockIndex) const noexcept;
+
+    Options options;
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex cacheLock;
+    std::atomic<int> numPauseRequests { 0 }, numBusyWorkers { 0 };
+    std::atomic<int> numUnderruns { 0 }, numBlocksRead { 0 }, numCacheHits { 0 };
+    uint32 useCounter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleStreamer)
+};
+
+//==============================================================================
+/**
+    A subclass of SynthesiserSound that plays a sampled audio clip straight from
+    disk.
+
+    Unlike SamplerSound, this only loads the start of the sample into memory.
+    The rest is read on demand by a SampleStreamer while a StreamingSamplerVoice
+    is playing it, which makes it possible to use sample libraries that are far
+    larger than the available RAM.
+
+    The preloaded head needs to be long enough to cover the time it takes the
+    streamer to read the first blocks after a note starts; a few hundred
+    milliseconds is usually plenty for a local drive.
+
+    @see StreamingSamplerVoice, SampleStreamer, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streamed sound from an audio reader.
+
+        The reader will be used by the streamer's background threads for as long
+        as the sound exists. A MemoryMappedAudioFormatReader that has had its whole
+        file mapped is a good choice here, as it lets the operating system's page
+        cache do the actual disk access.
+
+        @param streamer     the streamer that will read the audio for this sound
+        @param name         a name for the sample
+        @param source       the audio to play
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadTimeSecs  the length of audio at the start of the sample that will
+                                be kept in memory, in seconds
+    */
+    StreamingSamplerSound (SampleStreamer& streamer,
+                           const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadTimeSecs);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the total length of the sample, in samples. */
+    int64 getLengthInSamples() const noexcept               { return length; }
+
+    /** Returns the number of samples at the start of the sample that are held in memory. */
+    int getPreloadLength() const noexcept                   { return preloadLength; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class SampleStreamer;
+    friend class StreamingSamplerVoice;
+
+    int getNumStreamedBlocks() const noexcept;
+
+    SampleStreamer& streamer;
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preloaded;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    A subclass of SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice holds one stream in its SampleStreamer, so create these on the
+    message thread along with the rest of the synthesiser, not while rendering.
+
+    @see StreamingSamplerSound, SampleStreamer, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice that streams its audio using the given streamer. */
+    explicit StreamingSamplerVoice (SampleStreamer& streamer);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    bool getFrame (const StreamingSamplerSound&, int64 position, float& left, float& right) noexcept;
+    void releaseStream() noexcept;
+
+    SampleStreamer& streamer;
+    SampleStreamer::Stream* stream = nullptr;
+    uint32 generation = 0;
+
+    const SampleStreamer::Block* currentBlock = nullptr;
+    int currentBlockIndex = -1;
+
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+
+    ADSR adsr;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
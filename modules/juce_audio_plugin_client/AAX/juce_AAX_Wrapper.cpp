@@ -2523,6 +2523,8 @@ namespace AAXClasses
         const int numIns  = numInputBuses  > 0 ? numElementsInArray (aaxFormats) : 0;
         const int numOuts = numOutputBuses > 0 ? numElementsInArray (aaxFormats) : 0;
 
+        const AudioProcessor::ScopedBusesLayoutSupportCache layoutSupportCache (*plugin);
+
         for (int inIdx = 0; inIdx < jmax (numIns, 1); ++inIdx)
         {
             auto aaxInFormat = numIns > 0 ? aaxFormats[inIdx] : AAX_eStemFormat_None;
@@ -2337,6 +2337,8 @@ private:
 
         if (AudioProcessor::Bus* bus = juceFilter->getBus (isInput, busNum))
         {
+            const AudioProcessor::ScopedBusesLayoutSupportCache layoutSupportCache (*juceFilter);
+
            #ifndef JucePlugin_PreferredChannelConfigurations
             auto& knownTags = CoreAudioLayouts::getKnownCoreAudioTags();
 
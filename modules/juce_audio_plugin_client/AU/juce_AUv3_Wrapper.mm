@@ -56,10 +56,6 @@
 #include <juce_audio_processors/format_types/juce_LegacyAudioParameter.cpp>
 #include <juce_audio_processors/format_types/juce_AU_Shared.h>
 
-#if JUCE_AUV3_MIDI_EVENT_LIST_SUPPORTED
- #include <juce_audio_basics/midi/ump/juce_UMP.h>
-#endif
-
 #define JUCE_VIEWCONTROLLER_OBJC_NAME(x) JUCE_JOIN_MACRO (x, FactoryAUv3)
 
 #if JUCE_IOS
@@ -548,6 +544,11 @@ public:
         midiMessages.ensureSize (2048);
         midiMessages.clear();
 
+        usesSampleAccurateAutomation = processor.supportsSampleAccurateAutomation();
+
+        if (usesSampleAccurateAutomation)
+            parameterAutomation.prepare (processor);
+
         hostMusicalContextCallback = [au musicalContextBlock];
         hostTransportStateCallback = [au transportStateBlock];
 
@@ -1461,6 +1462,16 @@ private:
                     if (auto* p = getJuceParameterForAUAddress (paramEvent.parameterAddress))
                     {
                         auto normalisedValue = paramEvent.value / getMaximumParameterValue (*p);
+
+                        if (usesSampleAccurateAutomation)
+                        {
+                            const auto rampLength = event->head.eventType == AURenderEventParameterRamp
+                                                  ? static_cast<int> (paramEvent.rampDurationSampleFrames) : 0;
+
+                            addAutomationPoints (*p, jmax (0, static_cast<int> (paramEvent.eventSampleTime - startTime)),
+                                                 rampLength, normalisedValue);
+                        }
+
                         setAudioProcessorParameter (p, normalisedValue);
                     }
                 }
@@ -1473,6 +1484,16 @@ private:
         }
     }
 
+    void addAutomationPoints (AudioProcessorParameter& param, int sampleOffset, int rampLength, float newValue)
+    {
+        // Both steps and ramps start from wherever the parameter had got to
+        const auto* lane = parameterAutomation.getLaneFor (param);
+        const auto previousValue = lane != nullptr ? lane->getEndValue() : param.getValue();
+
+        parameterAutomation.addPoint (param, sampleOffset, previousValue);
+        parameterAutomation.addPoint (param, sampleOffset + rampLength, newValue);
+    }
+
     AUAudioUnitStatus renderCallback (AudioUnitRenderActionFlags* actionFlags, const AudioTimeStamp* timestamp, AUAudioFrameCount frameCount,
                                       NSInteger outputBusNumber, AudioBufferList* outputData, const AURenderEvent *__nullable realtimeEventListHead,
                                       AURenderPullInputBlock __nullable pullInputBlock)
@@ -1486,6 +1507,7 @@ private:
         {
             // process params and incoming midi (only once for a given timestamp)
             midiMessages.clear();
+            parameterAutomation.clear();
 
             const int numParams = juceParameters.getNumParameters();
             processEvents (realtimeEventListHead, numParams, static_cast<AUEventSampleTime> (timestamp->mSampleTime));
@@ -1604,12 +1626,16 @@ private:
         auto& processor = getAudioProcessor();
         const ScopedLock sl (processor.getCallbackLock());
 
+        processor.setParameterAutomation (usesSampleAccurateAutomation ? &parameterAutomation : nullptr);
+
         if (processor.isSuspended())
             buffer.clear();
         else if (bypassParam == nullptr && [au shouldBypassEffect])
             processor.processBlockBypassed (buffer, midiBuffer);
         else
             processor.processBlock (buffer, midiBuffer);
+
+        processor.setParameterAutomation (nullptr);
     }
 
     //==============================================================================
@@ -1772,6 +1798,8 @@ private:
 
     OwnedArray<BusBuffer> inBusBuffers, outBusBuffers;
     MidiBuffer midiMessages;
+    AudioProcessorParameterAutomation parameterAutomation;
+    bool usesSampleAccurateAutomation = false;
     AUMIDIOutputEventBlock midiOutputEventBlock = nullptr;
 
    #if JUCE_AUV3_MIDI_EVENT_LIST_SUPPORTED
@@ -134,7 +134,12 @@ public:
         return ttlSanitised;
     }
 
-    void setValueFromHost (LV2_URID urid, float value) noexcept
+    /*  If an automation object is supplied, the change is also recorded there as a step at
+        the given position in the block.
+    */
+    void setValueFromHost (LV2_URID urid, float value,
+                           AudioProcessorParameterAutomation* automation = nullptr,
+                           int sampleOffset = 0) noexcept
     {
         const auto it = uridToIndexMap.find (urid);
 
@@ -157,6 +162,12 @@ public:
 
             if (scaledValue != param->getValue())
             {
+                if (automation != nullptr)
+                {
+                    automation->addPoint (*param, sampleOffset, param->getValue());
+                    automation->addPoint (*param, sampleOffset, scaledValue);
+                }
+
                 ScopedValueSetter<bool> scope (ignoreCallbacks, true);
                 param->setValueNotifyingHost (scaledValue);
             }
@@ -521,6 +532,7 @@ public:
         jassert (static_cast<int> (numSteps) <= processor->getBlockSize());
 
         midi.clear();
+        parameterAutomation.clear();
         playHead.invalidate();
         audio.setSize (audio.getNumChannels(), static_cast<int> (numSteps), true, false, true);
 
@@ -528,20 +540,23 @@ public:
         {
             struct Callback
             {
-                explicit Callback (LV2PluginInstance& s) : self (s) {}
+                Callback (LV2PluginInstance& s, int offset) : self (s), sampleOffset (offset) {}
 
                 void setParameter (LV2_URID property, float value) const noexcept
                 {
-                    self.parameters.setValueFromHost (property, value);
+                    self.parameters.setValueFromHost (property, value,
+                                                      self.usesSampleAccurateAutomation ? &self.parameterAutomation : nullptr,
+                                                      sampleOffset);
                 }
 
                 // The host probably shouldn't send us 'touched' messages.
                 void gesture (LV2_URID, bool) const noexcept {}
 
                 LV2PluginInstance& self;
+                int sampleOffset;
             };
 
-            patchSetHelper.processPatchSet (event, Callback { *this });
+            patchSetHelper.processPatchSet (event, Callback { *this, static_cast<int> (event->time.frames) });
 
             playHead.readNewInfo (event);
 
@@ -559,6 +574,8 @@ public:
         {
             const ScopedLock lock { processor->getCallbackLock() };
 
+            processor->setParameterAutomation (usesSampleAccurateAutomation ? &parameterAutomation : nullptr);
+
             if (processor->isSuspended())
             {
                 for (auto i = 0, end = processor->getTotalNumOutputChannels(); i < end; ++i)
@@ -585,6 +602,8 @@ public:
                     processor->processBlockBypassed (audio, midi);
                 }
             }
+
+            processor->setParameterAutomation (nullptr);
         }
 
         for (auto i = 0, end = processor->getTotalNumOutputChannels(); i < end; ++i)
@@ -767,6 +786,12 @@ private:
                                        processor->getTotalNumOutputChannels());
 
         midi.ensureSize (8192);
+
+        usesSampleAccurateAutomation = processor->supportsSampleAccurateAutomation();
+
+        if (usesSampleAccurateAutomation)
+            parameterAutomation.prepare (*processor);
+
         audio.setSize (numChannels, maxBlockSize);
         audio.clear();
     }
@@ -788,6 +813,8 @@ private:
     lv2_shared::PatchSetHelper patchSetHelper { mapFeature, JucePlugin_LV2URI };
     PlayHead playHead;
     MidiBuffer midi;
+    AudioProcessorParameterAutomation parameterAutomation;
+    bool usesSampleAccurateAutomation = false;
     AudioBuffer<float> audio;
     std::atomic<bool> shouldSendStateChange { false };
 
@@ -3307,6 +3307,8 @@ public:
             return kResultFalse;
        #endif
 
+        const AudioProcessor::ScopedBusesLayoutSupportCache layoutSupportCache (*pluginInstance);
+
         if (pluginInstance->checkBusesLayoutSupported (requestedLayout))
         {
             if (! pluginInstance->setBusesLayoutWithoutEnabling (requestedLayout))
@@ -3442,7 +3444,18 @@ public:
                 if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                 {
                     if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    {
+                        if (usesSampleAccurateAutomation)
+                        {
+                            for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                            {
+                                if (const auto automationPoint = getPointFromQueue (paramQueue, point))
+                                    parameterAutomation.addPoint (*param, automationPoint->offsetSamples, (float) automationPoint->value);
+                            }
+                        }
+
                         setValueAndNotifyIfChanged (*param, (float) change->value);
+                    }
                 }
             }
         }
@@ -3455,6 +3468,22 @@ public:
 
         if (juceVST3EditController->getMidiControllerForParameter (id, channel, ctrlNumber))
         {
+            if (usesUniversalMidiPackets)
+            {
+                // Packets can carry the parameter's value at the full 32-bit resolution
+                const auto umpChannel = (uint8_t) jlimit (0, 15, channel - 1);
+                const auto data = (uint32_t) jlimit (0.0, (double) 0xffffffff, std::round (value * (double) 0xffffffff));
+
+                if (ctrlNumber == Vst::kAfterTouch)
+                    packetBuffer.add (ump::Factory::makeChannelPressureV2 (0, umpChannel, data), offsetSamples);
+                else if (ctrlNumber == Vst::kPitchBend)
+                    packetBuffer.add (ump::Factory::makePitchBendV2 (0, umpChannel, data), offsetSamples);
+                else
+                    packetBuffer.add (ump::Factory::makeControlChangeV2 (0, umpChannel, (uint8_t) jlimit (0, 127, ctrlNumber), data), offsetSamples);
+
+                return;
+            }
+
             if (ctrlNumber == Vst::kAfterTouch)
                 midiBuffer.addEvent (MidiMessage::channelPressureChange (channel,
                                                                          jlimit (0, 127, (int) (value * 128.0))), offsetSamples);
@@ -3492,13 +3521,20 @@ public:
         }
 
         midiBuffer.clear();
+        packetBuffer.clear();
+        parameterAutomation.clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
 
        #if JucePlugin_WantsMidiInput
         if (isMidiInputBusEnabled && data.inputEvents != nullptr)
-            MidiEventList::toMidiBuffer (midiBuffer, *data.inputEvents);
+        {
+            if (usesUniversalMidiPackets)
+                MidiEventList::toEventBuffer (packetBuffer, *data.inputEvents, packetConverter);
+            else
+                MidiEventList::toMidiBuffer (midiBuffer, *data.inputEvents);
+        }
        #endif
 
         if (getHostType().isWavelab())
@@ -3604,9 +3640,12 @@ private:
             pluginInstance->setNonRealtime (data.processMode == Vst::kOffline);
 
            #if JUCE_DEBUG && ! JucePlugin_ProducesMidiOutput
-            const int numMidiEventsComingIn = midiBuffer.getNumEvents();
+            const int numMidiEventsComingIn = usesUniversalMidiPackets ? packetBuffer.getNumEvents()
+                                                                       : midiBuffer.getNumEvents();
            #endif
 
+            pluginInstance->setParameterAutomation (usesSampleAccurateAutomation ? &parameterAutomation : nullptr);
+
             if (pluginInstance->isSuspended())
             {
                 buffer.clear();
@@ -3616,11 +3655,28 @@ private:
                 // processBlockBypassed should only ever be called if the AudioProcessor doesn't
                 // return a valid parameter from getBypassParameter
                 if (pluginInstance->getBypassParameter() == nullptr && comPluginInstance->getBypassParameter()->getValue() >= 0.5f)
+                {
+                    if (usesUniversalMidiPackets)
+                        packetConverter.toMidiBuffer (packetBuffer, midiBuffer);
+
                     pluginInstance->processBlockBypassed (buffer, midiBuffer);
+                }
+                else if (usesUniversalMidiPackets)
+                {
+                    pluginInstance->processPacketBlock (buffer, packetBuffer);
+
+                    // The host only deals in MIDI 1.0 events, so this is where any output is converted
+                    midiBuffer.clear();
+                    packetConverter.toMidiBuffer (packetBuffer, midiBuffer);
+                }
                 else
+                {
                     pluginInstance->processBlock (buffer, midiBuffer);
+                }
             }
 
+            pluginInstance->setParameterAutomation (nullptr);
+
            #if JUCE_DEBUG && (! JucePlugin_ProducesMidiOutput)
             /*  This assertion is caused when you've added some events to the
                 midiMessages array in your processBlock() method, which usually means
@@ -3669,6 +3725,16 @@ private:
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
 
+        usesUniversalMidiPackets = p.supportsUniversalMidiPackets();
+        packetBuffer.reserve (512);
+        packetBuffer.clear();
+        packetConverter.reset();
+
+        usesSampleAccurateAutomation = p.supportsSampleAccurateAutomation();
+
+        if (usesSampleAccurateAutomation)
+            parameterAutomation.prepare (p);
+
         bufferMapper.updateFromProcessor (p);
         bufferMapper.prepare (bufferSize);
     }
@@ -3747,6 +3813,11 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
+    ump::EventBuffer packetBuffer;
+    ump::EventBufferConverter packetConverter;
+    bool usesUniversalMidiPackets = false;
+    AudioProcessorParameterAutomation parameterAutomation;
+    bool usesSampleAccurateAutomation = false;
     ClientBufferMapper bufferMapper;
 
     bool active = false;
@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioPluginBatchLoader::Job
+{
+    enum class Stage { waiting, creating, created, finished };
+
+    Request request;
+    AudioPluginFormat* format = nullptr;
+    std::unique_ptr<AudioPluginInstance> instance;
+    String error;
+    Stage stage = Stage::waiting;
+};
+
+// Instances created on the background threads, or by asynchronous creation callbacks
+// which may arrive on any thread, are parked here until the next time slice picks
+// them up. This is reference-counted so that late arrivals are safe after the loader
+// has been deleted.
+struct AudioPluginBatchLoader::CompletedCreations  : public ReferenceCountedObject
+{
+    struct Result
+    {
+        size_t jobIndex;
+        std::unique_ptr<AudioPluginInstance> instance;
+        String error;
+        bool wasAsync;
+    };
+
+    void add (Result result)
+    {
+        const ScopedLock sl (lock);
+        results.push_back (std::move (result));
+    }
+
+    std::vector<Result> takeAll()
+    {
+        const ScopedLock sl (lock);
+        return std::exchange (results, {});
+    }
+
+    CriticalSection lock;
+    std::vector<Result> results;
+};
+
+//==============================================================================
+AudioPluginBatchLoader::AudioPluginBatchLoader (AudioPluginFormatManager& formatManager)
+    : AudioPluginBatchLoader (formatManager, Options())
+{
+}
+
+AudioPluginBatchLoader::AudioPluginBatchLoader (AudioPluginFormatManager& formatManager, Options optionsToUse)
+    : manager (formatManager),
+      options (optionsToUse),
+      completed (new CompletedCreations())
+{
+}
+
+AudioPluginBatchLoader::~AudioPluginBatchLoader()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    cancel();
+}
+
+//==============================================================================
+void AudioPluginBatchLoader::addRequest (Request request)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto jobIndex = jobs.size();
+    jobs.push_back (std::make_unique<Job>());
+
+    auto& job = *jobs.back();
+    job.request = std::move (request);
+    job.format = manager.findFormatForDescription (job.request.description, job.error);
+
+    if (job.format == nullptr)
+        job.stage = Job::Stage::created;
+    else if (job.format->canCreateInstancesOffMessageThread (job.request.description))
+        startCreation (job, jobIndex);
+
+    if (! isTimerRunning())
+        startTimer (jmax (1, options.millisecondsBetweenSlices));
+}
+
+void AudioPluginBatchLoader::cancel()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    stopTimer();
+
+    if (backgroundPool != nullptr)
+        backgroundPool->removeAllJobs (false, 0);
+
+    for (auto& job : jobs)
+    {
+        if (job->stage != Job::Stage::finished)
+        {
+            job->stage = Job::Stage::finished;
+            job->instance.reset();
+            job->request = {};
+            ++numFinished;
+        }
+    }
+
+    nextJobToStart = jobs.size();
+
+    // Destroying the pool waits for any plugins that are in the middle of being created
+    backgroundPool.reset();
+}
+
+double AudioPluginBatchLoader::getProgress() const noexcept
+{
+    return jobs.empty() ? 1.0 : numFinished / (double) jobs.size();
+}
+
+//==============================================================================
+void AudioPluginBatchLoader::startCreation (Job& job, size_t jobIndex)
+{
+    job.stage = Job::Stage::creating;
+
+    const auto& r = job.request;
+
+    if (job.format->canCreateInstancesOffMessageThread (r.description))
+    {
+        if (backgroundPool == nullptr)
+            backgroundPool = std::make_unique<ThreadPool> (jmax (1, options.numBackgroundThreads));
+
+        backgroundPool->addJob ([results = completed, format = job.format, desc = r.description,
+                                 rate = r.initialSampleRate, size = r.initialBufferSize, jobIndex]
+        {
+            String error;
+            auto instance = format->createInstanceFromDescription (desc, rate, size, error);
+            results->add ({ jobIndex, std::move (instance), error, false });
+        });
+    }
+    else
+    {
+        ++numAsyncCreationsInFlight;
+
+        job.format->createPluginInstanceAsync (r.description, r.initialSampleRate, r.initialBufferSize,
+                                               [results = completed, jobIndex] (std::unique_ptr<AudioPluginInstance> instance,
+                                                                                const String& error)
+                                               {
+                                                   results->add ({ jobIndex, std::move (instance), error, true });
+                                               });
+    }
+}
+
+void AudioPluginBatchLoader::collectCompletedCreations()
+{
+    for (auto& result : completed->takeAll())
+    {
+        if (result.wasAsync)
+            --numAsyncCreationsInFlight;
+
+        auto& job = *jobs[result.jobIndex];
+
+        // if the request was cancelled, the instance is just deleted here
+        if (job.stage == Job::Stage::creating)
+        {
+            job.instance = std::move (result.instance);
+            job.error = result.error;
+            job.stage = Job::Stage::created;
+        }
+    }
+}
+
+void AudioPluginBatchLoader::finishJob (Job& job)
+{
+    job.stage = Job::Stage::finished;
+    ++numFinished;
+
+    auto instance = std::move (job.instance);
+    auto request = std::exchange (job.request, {});
+
+    if (instance != nullptr)
+    {
+        if (request.prepareInstance != nullptr)
+            request.prepareInstance (*instance);
+
+        if (! request.state.isEmpty())
+            instance->setStateInformation (request.state.getData(), (int) request.state.getSize());
+    }
+
+    if (request.callback != nullptr)
+        request.callback (std::move (instance), job.error);
+}
+
+void AudioPluginBatchLoader::timerCallback()
+{
+    const auto sliceStart = Time::getMillisecondCounterHiRes();
+    const auto numPreviouslyFinished = numFinished;
+    bool hasDoneAnything = false;
+
+    auto hasTimeLeft = [&]
+    {
+        return ! hasDoneAnything
+            || Time::getMillisecondCounterHiRes() - sliceStart < options.maxMillisecondsPerSlice;
+    };
+
+    collectCompletedCreations();
+
+    // Restore the states of any plugins that now exist, and hand them over..
+    for (size_t i = 0; i < jobs.size() && hasTimeLeft(); ++i)
+    {
+        auto& job = *jobs[i];
+
+        if (job.stage == Job::Stage::created)
+        {
+            finishJob (job);
+            hasDoneAnything = true;
+        }
+    }
+
+    // ..then create some more of the plugins that have to be made on the message thread
+    while (nextJobToStart < jobs.size() && hasTimeLeft())
+    {
+        auto& job = *jobs[nextJobToStart];
+
+        if (job.stage == Job::Stage::waiting)
+        {
+            const auto& desc = job.request.description;
+
+            if (job.format->requiresUnblockedMessageThreadDuringCreation (desc))
+            {
+                if (numAsyncCreationsInFlight >= jmax (1, options.maxAsyncCreationsInFlight))
+                    break;
+
+                startCreation (job, nextJobToStart);
+            }
+            else
+            {
+                job.instance = job.format->createInstanceFromDescription (desc,
+                                                                          job.request.initialSampleRate,
+                                                                          job.request.initialBufferSize,
+                                                                          job.error);
+                job.stage = Job::Stage::created;
+                hasDoneAnything = true;
+            }
+        }
+
+        ++nextJobToStart;
+    }
+
+    if (numFinished == numPreviouslyFinished)
+        return;
+
+    if (onProgress != nullptr)
+        onProgress (numFinished, getNumRequests());
+
+    if (isFinished())
+    {
+        stopTimer();
+
+        if (onFinished != nullptr)
+        {
+            // this uses a copy, in case the callback deletes the loader
+            auto callback = onFinished;
+            callback();
+        }
+    }
+}
+
+} // namespace juce
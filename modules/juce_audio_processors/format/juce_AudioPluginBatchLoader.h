@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Creates a batch of plugin instances and restores their states without freezing
+    the message thread.
+
+    Use this when you need to load a lot of plugins at once, such as when opening a
+    session. Each request is handled in up to three steps:
+
+    - Plugins whose format returns true from AudioPluginFormat::canCreateInstancesOffMessageThread()
+      are instantiated in parallel on a pool of background threads.
+    - Plugins that have to be created on the message thread are created in short
+      time-sliced chunks, so that the UI stays responsive in between. Plugins that need
+      an unblocked message thread, such as AUv3s, are created asynchronously, with a
+      limit on how many can be in flight at once.
+    - Once a plugin exists, its state is restored with setStateInformation(), again in
+      time-sliced batches on the message thread.
+
+    Each request's callback is called on the message thread, in the order in which the
+    plugins finish loading rather than the order of the requests.
+
+    The AudioPluginFormatManager must outlive this object, and all its methods must be
+    called on the message thread. Deleting the loader cancels any requests that haven't
+    finished, without calling their callbacks.
+
+    @see AudioPluginFormatManager::createPluginInstanceAsync
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioPluginBatchLoader  : private Timer
+{
+public:
+    //==============================================================================
+    /** A plugin to be loaded. */
+    struct Request
+    {
+        /** The plugin to create. */
+        PluginDescription description;
+
+        /** The settings to pass to the plugin when it's created. */
+        double initialSampleRate = 44100.0;
+        int initialBufferSize = 512;
+
+        /** If this isn't empty, it's passed to the new instance's setStateInformation(). */
+        MemoryBlock state;
+
+        /** An optional function that's called on the message thread once the instance has
+            been created, but before its state is restored, e.g. to set its bus layout.
+        */
+        std::function<void (AudioPluginInstance&)> prepareInstance;
+
+        /** Called on the message thread when the plugin has been loaded, or with a nullptr
+            and an error message if it couldn't be created.
+        */
+        AudioPluginFormat::PluginCreationCallback callback;
+    };
+
+    /** Settings that control how the work is spread out. */
+    struct Options
+    {
+        /** The number of threads used for the plugins that can be created in the background. */
+        int numBackgroundThreads = jmax (1, SystemStats::getNumCpus() - 1);
+
+        /** Roughly how long each chunk of work on the message thread may take. At least
+            one step is always performed in each chunk, however long it takes.
+        */
+        double maxMillisecondsPerSlice = 15.0;
+
+        /** The number of milliseconds that the message thread is given back between chunks. */
+        int millisecondsBetweenSlices = 5;
+
+        /** The maximum number of asynchronous creations that can be in progress at once. */
+        int maxAsyncCreationsInFlight = 8;
+    };
+
+    //==============================================================================
+    /** Creates a loader that uses the given format manager to find and create plugins. */
+    explicit AudioPluginBatchLoader (AudioPluginFormatManager& formatManager);
+
+    /** Creates a loader with some custom settings. */
+    AudioPluginBatchLoader (AudioPluginFormatManager& formatManager, Options options);
+
+    /** Destructor. Any requests that haven't yet finished are cancelled. */
+    ~AudioPluginBatchLoader() override;
+
+    //==============================================================================
+    /** Adds a plugin to be loaded.
+
+        The work starts as soon as the message loop next runs. Requests can be added at
+        any time, including from inside another request's callback.
+    */
+    void addRequest (Request request);
+
+    /** Drops all the requests that haven't yet finished.
+
+        Their callbacks won't be called, and any instances that are still being created
+        will be deleted as soon as they arrive. onFinished isn't called for a cancelled batch.
+    */
+    void cancel();
+
+    //==============================================================================
+    /** Returns the total number of requests that have been added. */
+    int getNumRequests() const noexcept             { return (int) jobs.size(); }
+
+    /** Returns the number of requests that have finished, successfully or not. */
+    int getNumFinished() const noexcept             { return numFinished; }
+
+    /** Returns true if every request has finished or been cancelled. */
+    bool isFinished() const noexcept                { return numFinished == getNumRequests(); }
+
+    /** Returns the proportion of requests that have finished, between 0 and 1. */
+    double getProgress() const noexcept;
+
+    //==============================================================================
+    /** Called on the message thread after each chunk of work in which some plugins finished.
+        The arguments are the number of finished requests and the total number of requests.
+    */
+    std::function<void (int numFinished, int numRequests)> onProgress;
+
+    /** Called on the message thread when all the requests have finished.
+        It's safe to delete the loader from inside this callback.
+    */
+    std::function<void()> onFinished;
+
+private:
+    //==============================================================================
+    struct Job;
+    struct CompletedCreations;
+
+    void timerCallback() override;
+    void collectCompletedCreations();
+    void startCreation (Job&, size_t jobIndex);
+    void finishJob (Job&);
+
+    AudioPluginFormatManager& manager;
+    const Options options;
+
+    std::vector<std::unique_ptr<Job>> jobs;
+    ReferenceCountedObjectPtr<CompletedCreations> completed;
+    size_t nextJobToStart = 0;
+    int numFinished = 0, numAsyncCreationsInFlight = 0;
+
+    std::unique_ptr<ThreadPool> backgroundPool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginBatchLoader)
+};
+
+} // namespace juce
@@ -59,7 +59,8 @@ std::unique_ptr<AudioPluginInstance> AudioPluginFormat::createInstanceFromDescri
        finishedSignal.signal();
     };
 
-    if (! MessageManager::getInstance()->isThisTheMessageThread())
+    if (! MessageManager::getInstance()->isThisTheMessageThread()
+          && ! canCreateInstancesOffMessageThread (desc))
         createPluginInstanceAsync (desc, initialSampleRate, initialBufferSize, std::move (callback));
     else
         createPluginInstance (desc, initialSampleRate, initialBufferSize, std::move (callback));
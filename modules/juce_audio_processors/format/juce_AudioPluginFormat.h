@@ -140,6 +140,16 @@ public:
     /** Returns true if instantiation of this plugin type must be done from a non-message thread. */
     virtual bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const = 0;
 
+    /** Returns true if instances of this plugin type can safely be created on a thread
+        other than the message thread.
+
+        If this returns true, createPluginInstance() may be called on any thread, and
+        several instances may be created at the same time, which lets an
+        AudioPluginBatchLoader create them in parallel in the background. The default
+        implementation returns false.
+    */
+    virtual bool canCreateInstancesOffMessageThread (const PluginDescription&) const     { return false; }
+
     /** A callback lambda that is passed to getARAFactory() */
     using ARAFactoryCreationCallback = std::function<void (ARAFactoryResult)>;
 
@@ -159,7 +169,8 @@ protected:
     AudioPluginFormat();
 
     /** Implementors must override this function. This is guaranteed to be called on
-        the message thread. You may call the callback on any thread.
+        the message thread, unless canCreateInstancesOffMessageThread() returns true.
+        You may call the callback on any thread.
     */
     virtual void createPluginInstance (const PluginDescription&, double initialSampleRate,
                                        int initialBufferSize, PluginCreationCallback) = 0;
@@ -132,6 +132,8 @@ public:
 
 private:
     //==============================================================================
+    friend class AudioPluginBatchLoader;
+
     AudioPluginFormat* findFormatForDescription (const PluginDescription&, String& errorMessage) const;
 
     OwnedArray<AudioPluginFormat> formats;
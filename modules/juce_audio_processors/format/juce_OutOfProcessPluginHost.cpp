@@ -0,0 +1,1329 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace OutOfProcessPluginHostHelpers
+{
+    //==============================================================================
+    // Each MIDI event is stored as its sample position and size, followed by its data
+    constexpr int midiEventHeaderSize = 2 * (int) sizeof (int32);
+
+    static int packMidi (const MidiBuffer& source, int startSample, int numSamples, uint8* dest, int maxBytes)
+    {
+        int numBytes = 0;
+
+        for (auto it = source.findNextSamplePosition (startSample); it != source.cend(); ++it)
+        {
+            const auto metadata = *it;
+            const auto position = metadata.samplePosition - startSample;
+
+            if (position >= numSamples)
+                break;
+
+            const int32 header[] = { (int32) position, (int32) metadata.numBytes };
+
+            if (numBytes + midiEventHeaderSize + metadata.numBytes > maxBytes)
+            {
+                jassertfalse; // Too much MIDI for the shared memory! Increase Options::maxMidiBytesPerBlock
+                break;
+            }
+
+            memcpy (dest + numBytes, header, (size_t) midiEventHeaderSize);
+            memcpy (dest + numBytes + midiEventHeaderSize, metadata.data, (size_t) metadata.numBytes);
+            numBytes += midiEventHeaderSize + metadata.numBytes;
+        }
+
+        return numBytes;
+    }
+
+    static void unpackMidi (const uint8* source, int numBytes, MidiBuffer& dest, int sampleOffset, int numSamples)
+    {
+        for (int pos = 0; pos + midiEventHeaderSize <= numBytes;)
+        {
+            int32 header[2];
+            memcpy (header, source + pos, (size_t) midiEventHeaderSize);
+
+            const auto size = (int) header[1];
+
+            if (size <= 0 || size > numBytes - pos - midiEventHeaderSize)
+                break;
+
+            if (isPositiveAndBelow ((int) header[0], numSamples))
+                dest.addEvent (source + pos + midiEventHeaderSize, size, (int) header[0] + sampleOffset);
+
+            pos += midiEventHeaderSize + size;
+        }
+    }
+
+    //==============================================================================
+    // These are used on words in the shared memory, so the futexes mustn't be process-private
+    static_assert (sizeof (std::atomic<uint32>) == sizeof (uint32), "The shared atomics must be plain words");
+
+    static void wakeAll (std::atomic<uint32>& word) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        syscall (SYS_futex, reinterpret_cast<uint32*> (&word), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+       #else
+        ignoreUnused (word);
+       #endif
+    }
+
+    static void waitWhileEqual (std::atomic<uint32>& word, uint32 value, int timeoutMilliseconds) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        timespec timeout;
+        timeout.tv_sec = timeoutMilliseconds / 1000;
+        timeout.tv_nsec = (timeoutMilliseconds % 1000) * 1000000L;
+
+        if (word.load (std::memory_order_acquire) == value)
+            syscall (SYS_futex, reinterpret_cast<uint32*> (&word), FUTEX_WAIT, value, &timeout, nullptr, 0);
+       #else
+        const auto start = Time::getMillisecondCounter();
+
+        for (int i = 0; word.load (std::memory_order_acquire) == value; ++i)
+        {
+            if ((int) (Time::getMillisecondCounter() - start) >= timeoutMilliseconds)
+                return;
+
+            if (i < 64)
+                std::this_thread::yield();
+            else
+                Thread::sleep (1);
+        }
+       #endif
+    }
+
+    static File getSharedMemoryDirectory()
+    {
+        File shm ("/dev/shm");
+
+        if (shm.isDirectory())
+            return shm;
+
+        return File::getSpecialLocation (File::tempDirectory);
+    }
+
+    static ValueTree createErrorReply (const String& message)
+    {
+        ValueTree reply ("reply");
+        reply.setProperty ("error", message, nullptr);
+        return reply;
+    }
+}
+
+//==============================================================================
+// The block of memory that both processes map. It starts with a Header, followed by one
+// region for each slot, holding that slot's parameter changes, audio channels and MIDI.
+class OutOfProcessPluginHost::SharedMemory
+{
+public:
+    static constexpr uint32 magicNumber = 0x4a4f5050;
+
+    struct Header
+    {
+        uint32 magic;
+        int32 numSlots, maxNumChannels, maxBlockSize, maxMidiBytes, maxParameterChanges;
+
+        // incremented whenever any slot has a new block for the worker
+        alignas (64) std::atomic<uint32> doorbell { 0 };
+    };
+
+    struct SlotHeader
+    {
+        std::atomic<uint32> requestCount { 0 }, responseCount { 0 };
+        int32 numChannels = 0, numSamples = 0, numMidiBytes = 0, numParameterChanges = 0;
+    };
+
+    struct ParameterChange
+    {
+        int32 index;
+        float value;
+    };
+
+    struct Slot
+    {
+        SlotHeader* header;
+        ParameterChange* parameterChanges;
+        float* audio;
+        uint8* midi;
+    };
+
+    //==============================================================================
+    static std::unique_ptr<SharedMemory> create (const Options& options)
+    {
+        Header dimensions;
+        dimensions.magic               = magicNumber;
+        dimensions.numSlots            = jmax (1, options.maxNumPlugins);
+        dimensions.maxNumChannels      = jmax (1, options.maxNumChannels);
+        dimensions.maxBlockSize        = jmax (1, options.maxBlockSize);
+        dimensions.maxMidiBytes        = jmax (OutOfProcessPluginHostHelpers::midiEventHeaderSize + 3, options.maxMidiBytesPerBlock);
+        dimensions.maxParameterChanges = jmax (1, options.maxParameterChangesPerBlock);
+
+        const Layout layout (dimensions);
+        auto file = OutOfProcessPluginHostHelpers::getSharedMemoryDirectory()
+                      .getNonexistentChildFile ("juce_plugin_host", ".shm", false);
+
+        {
+            FileOutputStream out (file);
+
+            if (! out.openedOk() || ! out.writeRepeatedByte (0, layout.totalSize))
+            {
+                file.deleteFile();
+                return {};
+            }
+        }
+
+        auto mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readWrite);
+
+        if (mappedFile->getData() == nullptr || mappedFile->getSize() != layout.totalSize)
+        {
+            mappedFile.reset();
+            file.deleteFile();
+            return {};
+        }
+
+        auto* header = new (mappedFile->getData()) Header();
+        header->magic               = dimensions.magic;
+        header->numSlots            = dimensions.numSlots;
+        header->maxNumChannels      = dimensions.maxNumChannels;
+        header->maxBlockSize        = dimensions.maxBlockSize;
+        header->maxMidiBytes        = dimensions.maxMidiBytes;
+        header->maxParameterChanges = dimensions.maxParameterChanges;
+
+        std::unique_ptr<SharedMemory> memory (new SharedMemory (file, std::move (mappedFile), true));
+
+        for (int i = 0; i < header->numSlots; ++i)
+            new (memory->getSlot (i).header) SlotHeader();
+
+        return memory;
+    }
+
+    static std::unique_ptr<SharedMemory> open (const File& file)
+    {
+        auto mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readWrite);
+
+        if (mappedFile->getData() == nullptr || mappedFile->getSize() < sizeof (Header))
+            return {};
+
+        const auto& header = *static_cast<const Header*> (mappedFile->getData());
+
+        if (header.magic != magicNumber
+             || header.numSlots <= 0 || header.maxNumChannels <= 0 || header.maxBlockSize <= 0
+             || header.maxMidiBytes <= 0 || header.maxParameterChanges <= 0
+             || Layout (header).totalSize != mappedFile->getSize())
+            return {};
+
+        return std::unique_ptr<SharedMemory> (new SharedMemory (file, std::move (mappedFile), false));
+    }
+
+    ~SharedMemory()
+    {
+        mappedFile.reset();
+
+        if (ownsFile)
+            file.deleteFile();
+    }
+
+    //==============================================================================
+    Header& getHeader() const noexcept      { return *static_cast<Header*> (mappedFile->getData()); }
+    const File& getFile() const noexcept    { return file; }
+
+    Slot getSlot (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, getHeader().numSlots));
+
+        auto* base = static_cast<uint8*> (mappedFile->getData()) + layout.firstSlotOffset + layout.slotSize * (size_t) index;
+
+        return { reinterpret_cast<SlotHeader*> (base),
+                 reinterpret_cast<ParameterChange*> (base + layout.parameterChangesOffset),
+                 reinterpret_cast<float*> (base + layout.audioOffset),
+                 base + layout.midiOffset };
+    }
+
+private:
+    struct Layout
+    {
+        explicit Layout (const Header& header)
+        {
+            parameterChangesOffset = align (sizeof (SlotHeader));
+            audioOffset  = parameterChangesOffset + align (sizeof (ParameterChange) * (size_t) header.maxParameterChanges);
+            midiOffset   = audioOffset + align (sizeof (float) * (size_t) header.maxNumChannels * (size_t) header.maxBlockSize);
+            slotSize     = midiOffset + align ((size_t) header.maxMidiBytes);
+
+            firstSlotOffset = align (sizeof (Header));
+            totalSize = firstSlotOffset + slotSize * (size_t) header.numSlots;
+        }
+
+        static size_t align (size_t n) noexcept     { return (n + 63) & ~(size_t) 63; }
+
+        size_t parameterChangesOffset, audioOffset, midiOffset, slotSize, firstSlotOffset, totalSize;
+    };
+
+    SharedMemory (const File& f, std::unique_ptr<MemoryMappedFile> mapped, bool isOwner)
+        : file (f), mappedFile (std::move (mapped)), layout (getHeader()), ownsFile (isOwner)
+    {
+    }
+
+    File file;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const Layout layout;
+    const bool ownsFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemory)
+};
+
+//==============================================================================
+// The connection to the worker process. This is shared by the host and all the instances
+// that it has created, so that it stays alive until the last of them has gone.
+class OutOfProcessPluginHost::Process  : private ChildProcessCoordinator,
+                                         public std::enable_shared_from_this<Process>
+{
+public:
+    explicit Process (const Options& o)  : options (o) {}
+
+    ~Process() override
+    {
+        alive = false;
+        killWorkerProcess();
+    }
+
+    bool launch (const File& executable, const String& uniqueID)
+    {
+        memory = SharedMemory::create (options);
+
+        if (memory == nullptr || ! launchWorkerProcess (executable, uniqueID, 0, 0))
+            return false;
+
+        slotsInUse.resize ((size_t) memory->getHeader().numSlots, false);
+        alive = true;
+
+        ValueTree request ("attach");
+        request.setProperty ("file", memory->getFile().getFullPathName(), nullptr);
+
+        if (sendRequest (request, options.requestTimeoutMilliseconds)["ok"])
+            return true;
+
+        alive = false;
+        killWorkerProcess();
+        return false;
+    }
+
+    bool isAlive() const noexcept               { return alive; }
+    const Options& getOptions() const noexcept  { return options; }
+    SharedMemory& getMemory() const noexcept    { return *memory; }
+
+    //==============================================================================
+    int allocateSlot()
+    {
+        const ScopedLock sl (lock);
+
+        for (size_t i = 0; i < slotsInUse.size(); ++i)
+        {
+            if (! slotsInUse[i])
+            {
+                slotsInUse[i] = true;
+                return (int) i;
+            }
+        }
+
+        return -1;
+    }
+
+    void freeSlot (int index)
+    {
+        const ScopedLock sl (lock);
+        slotsInUse[(size_t) index] = false;
+    }
+
+    int getNumFreeSlots() const
+    {
+        const ScopedLock sl (lock);
+        return (int) std::count (slotsInUse.begin(), slotsInUse.end(), false);
+    }
+
+    //==============================================================================
+    // Returns an invalid tree if the worker didn't reply in time
+    ValueTree sendRequest (ValueTree request, int timeoutMilliseconds)
+    {
+        if (! alive)
+            return {};
+
+        auto pending = std::make_shared<PendingReply>();
+        int id;
+
+        {
+            const ScopedLock sl (lock);
+            id = ++lastRequestID;
+            pendingReplies[id] = pending;
+        }
+
+        request.setProperty ("id", id, nullptr);
+
+        MemoryBlock message;
+        ValueTreeBinaryFormat::write (request, message, ValueTreeBinaryFormat::Compression::none);
+
+        ValueTree reply;
+
+        if (sendMessageToWorker (message) && pending->event.wait ((double) timeoutMilliseconds))
+        {
+            const ScopedLock sl (lock);
+            reply = pending->reply;
+        }
+
+        const ScopedLock sl (lock);
+        pendingReplies.erase (id);
+        return reply;
+    }
+
+    // Sends a block that has been written into a slot's memory, and waits for the worker to finish it
+    bool processSlot (int index)
+    {
+        if (! alive)
+            return false;
+
+        auto& header = memory->getHeader();
+        auto& slot = *memory->getSlot (index).header;
+        const auto request = slot.requestCount.load (std::memory_order_relaxed) + 1;
+
+        slot.requestCount.store (request, std::memory_order_release);
+        header.doorbell.fetch_add (1, std::memory_order_release);
+        OutOfProcessPluginHostHelpers::wakeAll (header.doorbell);
+
+        // The worker is often finished very quickly, so it's worth spinning for a little first
+        for (int i = 0; i < 256; ++i)
+            if (slot.responseCount.load (std::memory_order_acquire) == request)
+                return true;
+
+        const auto start = Time::getMillisecondCounter();
+
+        while (slot.responseCount.load (std::memory_order_acquire) != request)
+        {
+            if (! alive)
+                return false;
+
+            if ((int) (Time::getMillisecondCounter() - start) > options.processTimeoutMilliseconds)
+            {
+                markLost();
+                return false;
+            }
+
+            OutOfProcessPluginHostHelpers::waitWhileEqual (slot.responseCount, request - 1, 5);
+        }
+
+        return true;
+    }
+
+    // Only ever set or called on the message thread
+    std::function<void()> onLost;
+
+private:
+    struct PendingReply
+    {
+        WaitableEvent event;
+        ValueTree reply;
+    };
+
+    void markLost()
+    {
+        if (! alive.exchange (false))
+            return;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& pending : pendingReplies)
+                pending.second->event.signal();
+        }
+
+        MessageManager::callAsync ([weak = weak_from_this()]
+        {
+            if (auto p = weak.lock())
+                NullCheckedInvocation::invoke (p->onLost);
+        });
+    }
+
+    void handleMessageFromWorker (const MemoryBlock& message) override
+    {
+        auto reply = ValueTreeBinaryFormat::read (message.getData(), message.getSize());
+
+        const ScopedLock sl (lock);
+        auto pending = pendingReplies.find ((int) reply["id"]);
+
+        if (pending != pendingReplies.end())
+        {
+            pending->second->reply = reply;
+            pending->second->event.signal();
+        }
+    }
+
+    void handleConnectionLost() override
+    {
+        markLost();
+    }
+
+    const Options options;
+    std::unique_ptr<SharedMemory> memory;
+    std::atomic<bool> alive { false };
+
+    CriticalSection lock;
+    std::map<int, std::shared_ptr<PendingReply>> pendingReplies;
+    int lastRequestID = 0;
+    std::vector<bool> slotsInUse;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Process)
+};
+
+//==============================================================================
+// The instance that the host sees, which passes everything on to the plugin in the worker
+class OutOfProcessPluginHost::Instance  : public AudioPluginInstance
+{
+public:
+    Instance (std::shared_ptr<Process> processToUse, int slotToUse,
+              const PluginDescription& desc, const ValueTree& info)
+        : AudioPluginInstance (createBuses (info)),
+          process (std::move (processToUse)),
+          slotIndex (slotToUse),
+          description (desc),
+          acceptsMidiInput (info["acceptsMidi"]),
+          producesMidiOutput (info["producesMidi"]),
+          midiEffect (info["isMidiEffect"]),
+          tailLengthSeconds (info["tail"]),
+          currentProgram (info["currentProgram"])
+    {
+        if (auto* programs = info["programs"].getArray())
+            for (auto& name : *programs)
+                programNames.add (name.toString());
+
+        setLatencySamples (info["latency"]);
+
+        AudioProcessorParameterGroup group;
+
+        for (const auto& child : info)
+        {
+            if (child.hasType ("PARAM"))
+            {
+                auto param = std::make_unique<BridgedParameter> (*this, (int) bridgedParameters.size(), child);
+                bridgedParameters.push_back (param.get());
+                group.addChild (std::move (param));
+            }
+        }
+
+        setHostedParameterTree (std::move (group));
+        changedParameters = FlagCache<1> (bridgedParameters.size());
+    }
+
+    ~Instance() override
+    {
+        ValueTree request ("destroy");
+        request.setProperty ("slot", slotIndex, nullptr);
+
+        // if the worker doesn't answer, it might still be using the slot
+        if (process->sendRequest (request, process->getOptions().requestTimeoutMilliseconds).isValid())
+            process->freeSlot (slotIndex);
+    }
+
+    //==============================================================================
+    void fillInPluginDescription (PluginDescription& desc) const override   { desc = description; }
+    const String getName() const override                                   { return description.name; }
+
+    void prepareToPlay (double sampleRate, int maximumBlockSize) override
+    {
+        auto request = createRequest ("prepare");
+        request.setProperty ("sampleRate", sampleRate, nullptr);
+        request.setProperty ("blockSize", jmin (maximumBlockSize, process->getOptions().maxBlockSize), nullptr);
+
+        auto reply = sendRequest (request);
+
+        if (reply["ok"])
+            setLatencySamples (reply["latency"]);
+
+        outputMidi.ensureSize ((size_t) process->getOptions().maxMidiBytesPerBlock);
+    }
+
+    void releaseResources() override
+    {
+        sendRequest (createRequest ("release"));
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midiMessages) override
+    {
+        if (! process->isAlive())
+        {
+            buffer.clear();
+            midiMessages.clear();
+            return;
+        }
+
+        auto& header = process->getMemory().getHeader();
+        auto slot = process->getMemory().getSlot (slotIndex);
+        const auto numSamples = buffer.getNumSamples();
+        const auto numChannels = jmin (buffer.getNumChannels(), (int) header.maxNumChannels);
+        int numParameterChanges = 0;
+
+        changedParameters.ifSet ([&] (size_t index, auto)
+        {
+            if (numParameterChanges < header.maxParameterChanges)
+                slot.parameterChanges[numParameterChanges++] = { (int32) index, bridgedParameters[index]->getValue() };
+            else
+                changedParameters.set (index, 1); // send it with the next block instead
+        });
+
+        outputMidi.clear();
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto num = jmin ((int) header.maxBlockSize, numSamples - start);
+
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::copy (slot.audio + i * header.maxBlockSize, buffer.getReadPointer (i, start), num);
+
+            slot.header->numChannels = numChannels;
+            slot.header->numSamples = num;
+            slot.header->numParameterChanges = start == 0 ? numParameterChanges : 0;
+            slot.header->numMidiBytes = OutOfProcessPluginHostHelpers::packMidi (midiMessages, start, num, slot.midi, header.maxMidiBytes);
+
+            if (! process->processSlot (slotIndex))
+            {
+                buffer.clear();
+                midiMessages.clear();
+                return;
+            }
+
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::copy (buffer.getWritePointer (i, start), slot.audio + i * header.maxBlockSize, num);
+
+            OutOfProcessPluginHostHelpers::unpackMidi (slot.midi, jlimit (0, (int) header.maxMidiBytes, (int) slot.header->numMidiBytes),
+                                                       outputMidi, start, num);
+            start += num;
+        }
+
+        for (int i = numChannels; i < buffer.getNumChannels(); ++i)
+            buffer.clear (i, 0, numSamples);
+
+        midiMessages.swapWith (outputMidi);
+    }
+
+    using AudioPluginInstance::processBlock;
+
+    //==============================================================================
+    double getTailLengthSeconds() const override                { return tailLengthSeconds; }
+    bool acceptsMidi() const override                           { return acceptsMidiInput; }
+    bool producesMidi() const override                          { return producesMidiOutput; }
+    bool isMidiEffect() const override                          { return midiEffect; }
+
+    bool hasEditor() const override                             { return false; }
+    AudioProcessorEditor* createEditor() override               { return nullptr; }
+
+    // The worker's plugin has already been given its layout, which can't be changed from here
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override
+    {
+        return layouts == getBusesLayout();
+    }
+
+    //==============================================================================
+    int getNumPrograms() override                               { return programNames.size(); }
+    int getCurrentProgram() override                            { return currentProgram; }
+    const String getProgramName (int index) override            { return programNames[index]; }
+
+    void setCurrentProgram (int index) override
+    {
+        auto request = createRequest ("setProgram");
+        request.setProperty ("index", index, nullptr);
+
+        if (sendRequest (request)["ok"])
+            currentProgram = index;
+    }
+
+    void changeProgramName (int index, const String& newName) override
+    {
+        auto request = createRequest ("renameProgram");
+        request.setProperty ("index", index, nullptr);
+        request.setProperty ("name", newName, nullptr);
+
+        if (sendRequest (request)["ok"] && isPositiveAndBelow (index, programNames.size()))
+            programNames.set (index, newName);
+    }
+
+    //==============================================================================
+    void getStateInformation (MemoryBlock& destData) override
+    {
+        auto reply = sendRequest (createRequest ("getState"));
+
+        if (auto* state = reply["state"].getBinaryData())
+            destData = *state;
+        else
+            destData.reset();
+    }
+
+    void setStateInformation (const void* data, int sizeInBytes) override
+    {
+        auto request = createRequest ("setState");
+        request.setProperty ("state", var (data, (size_t) sizeInBytes), nullptr);
+        sendRequest (request);
+    }
+
+private:
+    //==============================================================================
+    struct BridgedParameter  : public HostedParameter
+    {
+        BridgedParameter (Instance& o, int index, const ValueTree& info)
+            : owner (o),
+              parameterIndex (index),
+              name (info["name"].toString()),
+              label (info["label"].toString()),
+              parameterID (info["pid"].toString()),
+              defaultValue (info["default"]),
+              numSteps (info["numSteps"]),
+              discrete (info["discrete"]),
+              boolean (info["boolean"]),
+              value ((float) info["value"])
+        {
+        }
+
+        float getValue() const override             { return value; }
+
+        void setValue (float newValue) override
+        {
+            value = newValue;
+            owner.changedParameters.set ((size_t) parameterIndex, 1);
+        }
+
+        float getDefaultValue() const override                      { return defaultValue; }
+        String getName (int maximumStringLength) const override     { return name.substring (0, maximumStringLength); }
+        String getLabel() const override                            { return label; }
+        int getNumSteps() const override                            { return numSteps; }
+        bool isDiscrete() const override                            { return discrete; }
+        bool isBoolean() const override                             { return boolean; }
+        String getParameterID() const override                      { return parameterID; }
+
+        // The plugin's own text conversions would need a round trip to the worker
+        String getText (float v, int maximumStringLength) const override
+        {
+            return String (v, 3).substring (0, maximumStringLength);
+        }
+
+        float getValueForText (const String& text) const override   { return text.getFloatValue(); }
+
+        Instance& owner;
+        const int parameterIndex;
+        const String name, label, parameterID;
+        const float defaultValue;
+        const int numSteps;
+        const bool discrete, boolean;
+        std::atomic<float> value;
+    };
+
+    static BusesProperties createBuses (const ValueTree& info)
+    {
+        BusesProperties buses;
+
+        if (const int numInputs = info["numInputs"]; numInputs > 0)
+            buses = buses.withInput ("Input", AudioChannelSet::canonicalChannelSet (numInputs), true);
+
+        if (const int numOutputs = info["numOutputs"]; numOutputs > 0)
+            buses = buses.withOutput ("Output", AudioChannelSet::canonicalChannelSet (numOutputs), true);
+
+        return buses;
+    }
+
+    ValueTree createRequest (const Identifier& type) const
+    {
+        ValueTree request (type);
+        request.setProperty ("slot", slotIndex, nullptr);
+        return request;
+    }
+
+    ValueTree sendRequest (const ValueTree& request) const
+    {
+        return process->sendRequest (request, process->getOptions().requestTimeoutMilliseconds);
+    }
+
+    std::shared_ptr<Process> process;
+    const int slotIndex;
+    const PluginDescription description;
+    const bool acceptsMidiInput, producesMidiOutput, midiEffect;
+    const double tailLengthSeconds;
+
+    StringArray programNames;
+    int currentProgram = 0;
+
+    std::vector<BridgedParameter*> bridgedParameters;
+    FlagCache<1> changedParameters;
+    MidiBuffer outputMidi;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Instance)
+};
+
+//==============================================================================
+OutOfProcessPluginHost::OutOfProcessPluginHost()
+    : OutOfProcessPluginHost (Options())
+{
+}
+
+OutOfProcessPluginHost::OutOfProcessPluginHost (Options optionsToUse)
+    : options (optionsToUse)
+{
+}
+
+OutOfProcessPluginHost::~OutOfProcessPluginHost()
+{
+    if (process != nullptr)
+        process->onLost = nullptr;
+}
+
+bool OutOfProcessPluginHost::launch (const File& workerExecutable, const String& commandLineUniqueID)
+{
+    if (process != nullptr)
+    {
+        jassertfalse; // each host can only have one process
+        return false;
+    }
+
+    auto newProcess = std::make_shared<Process> (options);
+
+    if (! newProcess->launch (workerExecutable, commandLineUniqueID))
+        return false;
+
+    newProcess->onLost = [this] { NullCheckedInvocation::invoke (onProcessLost); };
+    process = std::move (newProcess);
+    return true;
+}
+
+bool OutOfProcessPluginHost::isRunning() const noexcept
+{
+    return process != nullptr && process->isAlive();
+}
+
+int OutOfProcessPluginHost::getNumFreeSlots() const
+{
+    return isRunning() ? process->getNumFreeSlots() : 0;
+}
+
+std::unique_ptr<AudioPluginInstance> OutOfProcessPluginHost::createPluginInstance (const PluginDescription& description,
+                                                                                  double initialSampleRate,
+                                                                                  int initialBufferSize,
+                                                                                  String& errorMessage)
+{
+    if (! isRunning())
+    {
+        errorMessage = TRANS ("The plug-in process isn't running");
+        return {};
+    }
+
+    const auto slot = process->allocateSlot();
+
+    if (slot < 0)
+    {
+        errorMessage = TRANS ("The plug-in process is full");
+        return {};
+    }
+
+    ValueTree request ("create");
+    request.setProperty ("slot", slot, nullptr);
+    request.setProperty ("description", description.createXml()->toString (XmlElement::TextFormat().singleLine().withoutHeader()), nullptr);
+    request.setProperty ("sampleRate", initialSampleRate, nullptr);
+    request.setProperty ("blockSize", initialBufferSize, nullptr);
+
+    auto reply = process->sendRequest (request, options.requestTimeoutMilliseconds);
+
+    if (! reply.isValid())
+    {
+        // the slot stays in use, in case the worker is still busy creating something in it
+        errorMessage = TRANS ("The plug-in process didn't respond");
+        return {};
+    }
+
+    if (! reply["ok"])
+    {
+        process->freeSlot (slot);
+        errorMessage = reply["error"].toString();
+        return {};
+    }
+
+    return std::make_unique<Instance> (process, slot, description, reply);
+}
+
+//==============================================================================
+struct OutOfProcessPluginHost::Worker::Slot
+{
+    CriticalSection lock;
+    std::unique_ptr<AudioPluginInstance> plugin;
+    HeapBlock<float*> channels;
+    MidiBuffer midi;
+    bool prepared = false;
+};
+
+// Serves the blocks for all the slots, waking up whenever the host rings the doorbell
+class OutOfProcessPluginHost::Worker::AudioThread  : public Thread
+{
+public:
+    explicit AudioThread (Worker& w)
+        : Thread ("Plugin host audio"), owner (w)
+    {
+        startThread (Priority::highest);
+    }
+
+    ~AudioThread() override
+    {
+        signalThreadShouldExit();
+        owner.memory->getHeader().doorbell.fetch_add (1);
+        OutOfProcessPluginHostHelpers::wakeAll (owner.memory->getHeader().doorbell);
+        stopThread (5000);
+    }
+
+private:
+    void run() override
+    {
+        const ScopedNoDenormals noDenormals;
+        auto& header = owner.memory->getHeader();
+
+        while (! threadShouldExit())
+        {
+            const auto doorbell = header.doorbell.load (std::memory_order_acquire);
+
+            for (int i = 0; i < header.numSlots; ++i)
+            {
+                auto& slot = *owner.memory->getSlot (i).header;
+                const auto request = slot.requestCount.load (std::memory_order_acquire);
+
+                if (request != slot.responseCount.load (std::memory_order_relaxed))
+                {
+                    owner.processSlot (i);
+                    slot.responseCount.store (request, std::memory_order_release);
+                    OutOfProcessPluginHostHelpers::wakeAll (slot.responseCount);
+                }
+            }
+
+            OutOfProcessPluginHostHelpers::waitWhileEqual (header.doorbell, doorbell, 50);
+        }
+    }
+
+    Worker& owner;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThread)
+};
+
+OutOfProcessPluginHost::Worker::Worker()
+{
+    formatManager.addDefaultFormats();
+}
+
+OutOfProcessPluginHost::Worker::~Worker()
+{
+    cancelPendingUpdate();
+    audioThread.reset();
+    slots.clear();
+    memory.reset();
+}
+
+bool OutOfProcessPluginHost::Worker::initialiseFromCommandLine (const String& commandLine,
+                                                                const String& commandLineUniqueID)
+{
+    return ChildProcessWorker::initialiseFromCommandLine (commandLine, commandLineUniqueID);
+}
+
+void OutOfProcessPluginHost::Worker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    {
+        const ScopedLock sl (pendingLock);
+        pendingRequests.add (mb);
+    }
+
+    // Many formats can only be created on the message thread, so all the requests are handled there
+    triggerAsyncUpdate();
+}
+
+void OutOfProcessPluginHost::Worker::handleConnectionLost()
+{
+    JUCEApplicationBase::quit();
+}
+
+void OutOfProcessPluginHost::Worker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        MemoryBlock message;
+
+        {
+            const ScopedLock sl (pendingLock);
+
+            if (pendingRequests.isEmpty())
+                return;
+
+            message = pendingRequests.removeAndReturn (0);
+        }
+
+        auto request = ValueTreeBinaryFormat::read (message.getData(), message.getSize());
+
+        if (! request.isValid())
+            continue;
+
+        ValueTree reply ("reply");
+        handleRequest (request, reply);
+        reply.setProperty ("id", request["id"], nullptr);
+        sendReply (reply);
+    }
+}
+
+void OutOfProcessPluginHost::Worker::sendReply (const ValueTree& reply)
+{
+    MemoryBlock message;
+    ValueTreeBinaryFormat::write (reply, message, ValueTreeBinaryFormat::Compression::none);
+    sendMessageToCoordinator (message);
+}
+
+void OutOfProcessPluginHost::Worker::handleRequest (const ValueTree& request, ValueTree& reply)
+{
+    using namespace OutOfProcessPluginHostHelpers;
+
+    if (request.hasType ("attach"))
+    {
+        if (memory != nullptr)
+        {
+            reply = createErrorReply ("Already attached");
+            return;
+        }
+
+        memory = SharedMemory::open (File (request["file"].toString()));
+
+        if (memory == nullptr)
+        {
+            reply = createErrorReply ("Couldn't open the shared memory");
+            return;
+        }
+
+        const auto& header = memory->getHeader();
+
+        for (int i = 0; i < header.numSlots; ++i)
+        {
+            auto slot = std::make_unique<Slot>();
+            auto audio = memory->getSlot (i).audio;
+            slot->channels.malloc (header.maxNumChannels);
+
+            for (int ch = 0; ch < header.maxNumChannels; ++ch)
+                slot->channels[ch] = audio + ch * header.maxBlockSize;
+
+            slot->midi.ensureSize ((size_t) header.maxMidiBytes);
+            slots.push_back (std::move (slot));
+        }
+
+        audioThread = std::make_unique<AudioThread> (*this);
+        reply.setProperty ("ok", true, nullptr);
+        return;
+    }
+
+    const auto slotIndex = (int) request["slot"];
+
+    if (memory == nullptr || ! isPositiveAndBelow (slotIndex, (int) slots.size()))
+    {
+        reply = createErrorReply ("Invalid slot");
+        return;
+    }
+
+    auto& slot = *slots[(size_t) slotIndex];
+
+    if (request.hasType ("create"))
+    {
+        PluginDescription desc;
+        String error;
+
+        if (auto xml = parseXML (request["description"].toString()))
+            desc.loadFromXml (*xml);
+
+        auto plugin = formatManager.createPluginInstance (desc, request["sampleRate"], request["blockSize"], error);
+
+        if (plugin == nullptr)
+        {
+            reply = createErrorReply (error);
+            return;
+        }
+
+        const auto numInputs = plugin->getTotalNumInputChannels();
+        const auto numOutputs = plugin->getTotalNumOutputChannels();
+
+        if (jmax (numInputs, numOutputs) > memory->getHeader().maxNumChannels)
+        {
+            reply = createErrorReply ("The plug-in has too many channels");
+            return;
+        }
+
+        reply.setProperty ("numInputs", numInputs, nullptr);
+        reply.setProperty ("numOutputs", numOutputs, nullptr);
+        reply.setProperty ("latency", plugin->getLatencySamples(), nullptr);
+        reply.setProperty ("tail", plugin->getTailLengthSeconds(), nullptr);
+        reply.setProperty ("acceptsMidi", plugin->acceptsMidi(), nullptr);
+        reply.setProperty ("producesMidi", plugin->producesMidi(), nullptr);
+        reply.setProperty ("isMidiEffect", plugin->isMidiEffect(), nullptr);
+        reply.setProperty ("currentProgram", plugin->getCurrentProgram(), nullptr);
+
+        Array<var> programs;
+
+        for (int i = 0; i < plugin->getNumPrograms(); ++i)
+            programs.add (plugin->getProgramName (i));
+
+        reply.setProperty ("programs", programs, nullptr);
+
+        for (auto* param : plugin->getParameters())
+        {
+            ValueTree p ("PARAM");
+            p.setProperty ("name", param->getName (1024), nullptr);
+            p.setProperty ("label", param->getLabel(), nullptr);
+            p.setProperty ("default", param->getDefaultValue(), nullptr);
+            p.setProperty ("value", param->getValue(), nullptr);
+            p.setProperty ("numSteps", param->getNumSteps(), nullptr);
+            p.setProperty ("discrete", param->isDiscrete(), nullptr);
+            p.setProperty ("boolean", param->isBoolean(), nullptr);
+
+            if (auto* hosted = dynamic_cast<HostedAudioProcessorParameter*> (param))
+                p.setProperty ("pid", hosted->getParameterID(), nullptr);
+            else
+                p.setProperty ("pid", String (param->getParameterIndex()), nullptr);
+
+            reply.appendChild (p, nullptr);
+        }
+
+        std::unique_ptr<AudioPluginInstance> oldPlugin;
+
+        {
+            const ScopedLock sl (slot.lock);
+            oldPlugin = std::exchange (slot.plugin, std::move (plugin));
+            slot.prepared = false;
+        }
+
+        reply.setProperty ("ok", true, nullptr);
+        return;
+    }
+
+    if (request.hasType ("destroy"))
+    {
+        std::unique_ptr<AudioPluginInstance> oldPlugin;
+        bool wasPrepared;
+
+        {
+            const ScopedLock sl (slot.lock);
+            std::swap (oldPlugin, slot.plugin);
+            wasPrepared = std::exchange (slot.prepared, false);
+        }
+
+        if (oldPlugin != nullptr && wasPrepared)
+            oldPlugin->releaseResources();
+
+        reply.setProperty ("ok", true, nullptr);
+        return;
+    }
+
+    auto* plugin = slot.plugin.get();
+
+    if (plugin == nullptr)
+    {
+        reply = createErrorReply ("There's no plug-in in this slot");
+        return;
+    }
+
+    if (request.hasType ("prepare"))
+    {
+        const double sampleRate = request["sampleRate"];
+        const auto blockSize = jlimit (1, (int) memory->getHeader().maxBlockSize, (int) request["blockSize"]);
+
+        const ScopedLock sl (slot.lock);
+        plugin->setRateAndBufferSizeDetails (sampleRate, blockSize);
+        plugin->prepareToPlay (sampleRate, blockSize);
+        slot.prepared = true;
+        reply.setProperty ("latency", plugin->getLatencySamples(), nullptr);
+    }
+    else if (request.hasType ("release"))
+    {
+        const ScopedLock sl (slot.lock);
+
+        if (std::exchange (slot.prepared, false))
+            plugin->releaseResources();
+    }
+    else if (request.hasType ("getState"))
+    {
+        // Like any host, this calls the plugin while it might be processing on the audio thread
+        MemoryBlock state;
+        plugin->getStateInformation (state);
+        reply.setProperty ("state", state, nullptr);
+    }
+    else if (request.hasType ("setState"))
+    {
+        if (auto* state = request["state"].getBinaryData())
+            plugin->setStateInformation (state->getData(), (int) state->getSize());
+    }
+    else if (request.hasType ("setProgram"))
+    {
+        plugin->setCurrentProgram (request["index"]);
+    }
+    else if (request.hasType ("renameProgram"))
+    {
+        plugin->changeProgramName (request["index"], request["name"].toString());
+    }
+    else
+    {
+        reply = createErrorReply ("Unknown request");
+        return;
+    }
+
+    reply.setProperty ("ok", true, nullptr);
+}
+
+void OutOfProcessPluginHost::Worker::processSlot (int slotIndex)
+{
+    using namespace OutOfProcessPluginHostHelpers;
+
+    const auto& header = memory->getHeader();
+    auto shared = memory->getSlot (slotIndex);
+    auto& slot = *slots[(size_t) slotIndex];
+
+    const auto numChannels = jlimit (0, (int) header.maxNumChannels, (int) shared.header->numChannels);
+    const auto numSamples = jlimit (0, (int) header.maxBlockSize, (int) shared.header->numSamples);
+
+    // If the message thread is busy with this plugin, skip the block rather than keep the host waiting
+    const ScopedTryLock sl (slot.lock);
+
+    if (! sl.isLocked() || slot.plugin == nullptr || ! slot.prepared)
+    {
+        for (int i = 0; i < numChannels; ++i)
+            FloatVectorOperations::clear (slot.channels[i], numSamples);
+
+        shared.header->numMidiBytes = 0;
+        return;
+    }
+
+    const auto& parameters = slot.plugin->getParameters();
+    const auto numParameterChanges = jlimit (0, (int) header.maxParameterChanges, (int) shared.header->numParameterChanges);
+
+    for (int i = 0; i < numParameterChanges; ++i)
+    {
+        const auto change = shared.parameterChanges[i];
+
+        if (isPositiveAndBelow (change.index, parameters.size()))
+            parameters.getUnchecked (change.index)->setValue (change.value);
+    }
+
+    slot.midi.clear();
+    unpackMidi (shared.midi, jlimit (0, (int) header.maxMidiBytes, (int) shared.header->numMidiBytes), slot.midi, 0, numSamples);
+
+    AudioBuffer<float> buffer (slot.channels.get(), numChannels, numSamples);
+    slot.plugin->processBlock (buffer, slot.midi);
+
+    shared.header->numMidiBytes = packMidi (slot.midi, 0, numSamples, shared.midi, header.maxMidiBytes);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OutOfProcessPluginHostTests  : public UnitTest
+{
+public:
+    OutOfProcessPluginHostTests()
+        : UnitTest ("OutOfProcessPluginHost", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        using namespace OutOfProcessPluginHostHelpers;
+
+        beginTest ("MIDI survives being packed and unpacked");
+        {
+            MidiBuffer source;
+            source.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 3);
+            source.addEvent (MidiMessage::noteOff (1, 60), 20);
+            source.addEvent (MidiMessage::createSysExMessage ("abcdef", 6), 40);
+
+            std::vector<uint8> packed (256);
+            const auto numBytes = packMidi (source, 16, 32, packed.data(), (int) packed.size());
+            expectEquals (numBytes, 2 * midiEventHeaderSize + 3 + 8);
+
+            MidiBuffer dest;
+            unpackMidi (packed.data(), numBytes, dest, 100, 32);
+            expectEquals (dest.getNumEvents(), 2);
+            expectEquals (dest.getFirstEventTime(), 104);
+            expectEquals (dest.getLastEventTime(), 124);
+
+            for (const auto metadata : dest)
+                expect (metadata.getMessage().isNoteOff() || metadata.getMessage().isSysEx());
+        }
+
+        beginTest ("Corrupt MIDI data is ignored");
+        {
+            const int32 header[] = { 0, 1000 };
+            std::vector<uint8> packed (64);
+            memcpy (packed.data(), header, sizeof (header));
+
+            MidiBuffer dest;
+            unpackMidi (packed.data(), (int) packed.size(), dest, 0, 32);
+            expect (dest.isEmpty());
+        }
+
+        beginTest ("Waiting threads are woken");
+        {
+            std::atomic<uint32> request { 0 }, response { 0 };
+
+            std::thread worker ([&]
+            {
+                for (int served = 0; served < 100;)
+                {
+                    const auto r = request.load();
+
+                    if (r != response.load())
+                    {
+                        response.store (r);
+                        wakeAll (response);
+                        ++served;
+                    }
+                    else
+                    {
+                        waitWhileEqual (request, r, 50);
+                    }
+                }
+            });
+
+            for (uint32 i = 1; i <= 100; ++i)
+            {
+                request.store (i);
+                wakeAll (request);
+
+                const auto start = Time::getMillisecondCounter();
+
+                while (response.load() != i && Time::getMillisecondCounter() - start < 5000)
+                    waitWhileEqual (response, i - 1, 5);
+
+                expectEquals ((int) response.load(), (int) i);
+            }
+
+            worker.join();
+        }
+    }
+};
+
+static OutOfProcessPluginHostTests outOfProcessPluginHostTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs plugins in a separate process, so that a plugin that crashes can't take the
+    host down with it.
+
+    Each OutOfProcessPluginHost launches one worker process, which can hold several
+    plugins at once, so you can choose between giving every plugin its own process
+    and amortising the cost of the process and its context switches over a group of
+    them. createPluginInstance() returns an ordinary AudioPluginInstance that forwards
+    everything to the real plugin in the worker.
+
+    Audio, MIDI and parameter changes are exchanged through a block of shared memory,
+    and each call to processBlock() waits for the worker to finish that block, so
+    running a plugin out of process doesn't add any latency. On Linux, the two sides
+    wake each other with futexes; on other platforms they fall back to polling the
+    shared memory, which costs a little more CPU. Everything else, such as preparing
+    the plugin and saving or restoring its state, goes through the
+    ChildProcessCoordinator's connection.
+
+    If the worker process crashes or stops responding, its plugins carry on existing
+    but just output silence, and onProcessLost is called.
+
+    The worker process is a copy of an executable that you supply, which is usually
+    your own app. It must create an OutOfProcessPluginHost::Worker at startup and call
+    its initialiseFromCommandLine() method, then carry on running its message loop:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginHost::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine, "myPluginSandbox"))
+        {
+            pluginWorker = std::move (worker);
+            return;
+        }
+
+        // ..carry on starting up the app as normal
+    }
+    @endcode
+
+    The plugins' editors aren't bridged, so the instances report that they don't
+    have one, and changes that a plugin makes to its own parameters aren't sent back to
+    the host.
+
+    @see OutOfProcessPluginScanner, ChildProcessCoordinator
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginHost
+{
+public:
+    //==============================================================================
+    /** The limits that decide how big the shared memory for the process is. */
+    struct Options
+    {
+        /** The largest number of plugins that can run in the process at once. */
+        int maxNumPlugins = 8;
+
+        /** The most channels that any of the plugins can have. */
+        int maxNumChannels = 32;
+
+        /** The largest block that's sent to the process in one go. Bigger blocks are
+            split into pieces of this size.
+        */
+        int maxBlockSize = 2048;
+
+        /** The most bytes of MIDI that can be sent either way in each block. Each
+            event takes 8 bytes plus its data.
+        */
+        int maxMidiBytesPerBlock = 32768;
+
+        /** The most parameter changes that can be sent to a plugin with each block. */
+        int maxParameterChangesPerBlock = 1024;
+
+        /** How long processBlock() waits for a block before deciding that the process
+            has hung, after which the process is treated as lost.
+        */
+        int processTimeoutMilliseconds = 500;
+
+        /** How long to wait for other requests, such as creating a plugin or restoring
+            its state, before giving up.
+        */
+        int requestTimeoutMilliseconds = 30000;
+    };
+
+    //==============================================================================
+    /** Creates a host with the default Options. Call launch() to start its process. */
+    OutOfProcessPluginHost();
+
+    /** Creates a host. Call launch() to start its process. */
+    explicit OutOfProcessPluginHost (Options options);
+
+    /** Destructor.
+
+        The process is kept running until all the instances that it created have been
+        deleted, so you don't need to delete them first.
+    */
+    ~OutOfProcessPluginHost();
+
+    //==============================================================================
+    /** Starts the worker process.
+
+        @param workerExecutable     the executable to launch
+        @param commandLineUniqueID  a short alphanumeric ID that must match the one passed to
+                                    Worker::initialiseFromCommandLine()
+
+        Returns true if the process was started and connected. Each host can only
+        launch one process.
+    */
+    bool launch (const File& workerExecutable, const String& commandLineUniqueID);
+
+    /** Returns true if the process has been launched and hasn't been lost. */
+    bool isRunning() const noexcept;
+
+    /** Returns the number of plugins that can still be created in this process. */
+    int getNumFreeSlots() const;
+
+    /** Creates a plugin inside the worker process, and returns an instance that forwards
+        everything to it.
+
+        This blocks until the worker has created the plugin, so you'll usually want to
+        call it from a background thread. If the plugin can't be created, or the process
+        is full, this returns nullptr and sets the error message.
+    */
+    std::unique_ptr<AudioPluginInstance> createPluginInstance (const PluginDescription& description,
+                                                               double initialSampleRate,
+                                                               int initialBufferSize,
+                                                               String& errorMessage);
+
+    /** Called on the message thread if the worker process crashes, hangs or quits. */
+    std::function<void()> onProcessLost;
+
+    //==============================================================================
+    class Worker;
+
+private:
+    //==============================================================================
+    class SharedMemory;
+    class Process;
+    class Instance;
+
+    const Options options;
+    std::shared_ptr<Process> process;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginHost)
+};
+
+//==============================================================================
+/**
+    The part of an OutOfProcessPluginHost that runs in the worker process.
+
+    The plugins are created on the worker's message thread, and their audio is
+    processed on a realtime thread that serves all the plugins in the process.
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginHost::Worker   : private ChildProcessWorker,
+                                                 private AsyncUpdater
+{
+public:
+    /** Creates a worker that can load any of the formats that
+        AudioPluginFormatManager::addDefaultFormats() provides.
+    */
+    Worker();
+
+    /** Destructor. */
+    ~Worker() override;
+
+    /** Returns the formats that can be loaded, so that you can add your own. */
+    AudioPluginFormatManager& getFormatManager() noexcept      { return formatManager; }
+
+    /** Checks whether the command line was made by an OutOfProcessPluginHost,
+        and if so, connects to it.
+
+        Returns true if this process is a worker and should stay running to host the
+        plugins. The process is quit when the host no longer needs it.
+    */
+    bool initialiseFromCommandLine (const String& commandLine, const String& commandLineUniqueID);
+
+private:
+    struct Slot;
+    class AudioThread;
+
+    void handleMessageFromCoordinator (const MemoryBlock&) override;
+    void handleConnectionLost() override;
+    void handleAsyncUpdate() override;
+    void handleRequest (const ValueTree& request, ValueTree& reply);
+    void sendReply (const ValueTree& reply);
+    void processSlot (int slotIndex);
+
+    AudioPluginFormatManager formatManager;
+    CriticalSection pendingLock;
+    Array<MemoryBlock> pendingRequests;
+
+    std::unique_ptr<SharedMemory> memory;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::unique_ptr<AudioThread> audioThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+} // namespace juce
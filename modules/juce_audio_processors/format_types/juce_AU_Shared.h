@@ -358,6 +358,8 @@ struct AudioUnitHelpers
             return { &info, 1 };
         }
 
+        const AudioProcessor::ScopedBusesLayoutSupportCache layoutSupportCache (processor);
+
         auto layout = processor.getBusesLayout();
         auto maxNumChanToCheckFor = 9;
 
@@ -5189,8 +5189,9 @@ class LV2PluginFormat::Pimpl
 public:
     Pimpl()
     {
-        loadAllPluginsFromPaths (getDefaultLocationsToSearch());
-
+        // Installed bundles aren't loaded here. Their manifests are read when plugins are first
+        // searched for or looked up, and a bundle is only loaded into the world when one of its
+        // plugins is described or instantiated.
         const auto tempFile = lv2ResourceFolder.getFile();
 
         if (tempFile.createDirectory())
@@ -5209,6 +5210,9 @@ public:
                 world->loadBundle (world->newFileUri (nullptr, pathString.toRawUTF8()));
             }
         }
+
+        world->loadSpecifications();
+        world->loadPluginClasses();
     }
 
     ~Pimpl()
@@ -5216,10 +5220,15 @@ public:
         lv2ResourceFolder.getFile().deleteRecursively();
     }
 
+    void setScanCache (PluginScanCache* cacheToUse)
+    {
+        scanCache = cacheToUse;
+    }
+
     void findAllTypesForFile (OwnedArray<PluginDescription>& result,
                               const String& identifier)
     {
-        auto desc = getDescription (findPluginByUri (identifier));
+        auto desc = findDescription (identifier);
 
         if (desc.fileOrIdentifier.isNotEmpty())
             result.add (std::make_unique<PluginDescription> (desc));
@@ -5249,17 +5258,17 @@ public:
 
     bool doesPluginStillExist (const PluginDescription& description)
     {
-        return findPluginByUri (description.fileOrIdentifier) != nullptr;
+        const auto bundle = findBundleForPlugin (description.fileOrIdentifier);
+        return bundle != File() && bundle.getChildFile ("manifest.ttl").existsAsFile();
     }
 
     StringArray searchPathsForPlugins (const FileSearchPath& paths, bool, bool)
     {
-        loadAllPluginsFromPaths (paths);
-
         StringArray result;
 
-        for (const auto* plugin : world->getAllPlugins())
-            result.add (lv2_host::Plugin { plugin }.getUri().getTyped());
+        for (const auto& bundle : discoverBundles (paths))
+            for (const auto& uri : manifests[bundle.getFullPathName()].pluginUris)
+                result.addIfNotAlreadyThere (uri);
 
         return result;
     }
@@ -5480,10 +5489,261 @@ public:
     }
 
 private:
-    void loadAllPluginsFromPaths (const FileSearchPath& path)
+    //==============================================================================
+    /*  The parts of a bundle's manifest that are needed to find its plugins, read
+        without building an RDF model.
+    */
+    struct BundleManifest
+    {
+        std::vector<String> pluginUris;
+
+        // The subjects of the manifest's statements, and the targets of any lv2:appliesTo
+        // statements. Bundles that only hold presets or UIs for plugins in other bundles
+        // refer to those plugins in one of these two ways.
+        std::vector<String> referencedUris;
+
+        bool isSpecification = false;
+    };
+
+    static BundleManifest readManifest (const File& bundle)
+    {
+        struct Reader
+        {
+            explicit Reader (const SerdNode* base)  : env (serd_env_new (base)) {}
+            ~Reader() { serd_env_free (env); }
+
+            static SerdStatus onBase (void* handle, const SerdNode* uri)
+            {
+                return serd_env_set_base_uri (static_cast<Reader*> (handle)->env, uri);
+            }
+
+            static SerdStatus onPrefix (void* handle, const SerdNode* name, const SerdNode* uri)
+            {
+                return serd_env_set_prefix (static_cast<Reader*> (handle)->env, name, uri);
+            }
+
+            static SerdStatus onStatement (void* handle, SerdStatementFlags, const SerdNode*,
+                                           const SerdNode* subject, const SerdNode* predicate, const SerdNode* object,
+                                           const SerdNode*, const SerdNode*)
+            {
+                auto& reader = *static_cast<Reader*> (handle);
+                const auto subjectUri = reader.expand (subject);
+                const auto predicateUri = reader.expand (predicate);
+
+                if (subjectUri.isNotEmpty())
+                    reader.manifest.referencedUris.push_back (subjectUri);
+
+                if (predicateUri == LILV_NS_RDF "type")
+                {
+                    const auto type = reader.expand (object);
+
+                    if (type == LV2_CORE__Plugin && subjectUri.isNotEmpty())
+                        reader.manifest.pluginUris.push_back (subjectUri);
+                    else if (type == LV2_CORE__Specification)
+                        reader.manifest.isSpecification = true;
+                }
+                else if (predicateUri == LV2_CORE__appliesTo)
+                {
+                    const auto target = reader.expand (object);
+
+                    if (target.isNotEmpty())
+                        reader.manifest.referencedUris.push_back (target);
+                }
+
+                return SERD_SUCCESS;
+            }
+
+            // Returns an empty string for blank nodes and literals
+            String expand (const SerdNode* node) const
+            {
+                if (node->type != SERD_URI && node->type != SERD_CURIE)
+                    return {};
+
+                auto expanded = serd_env_expand_node (env, node);
+                const auto result = String::fromUTF8 ((const char*) expanded.buf, (int) expanded.n_bytes);
+                serd_node_free (&expanded);
+                return result;
+            }
+
+            SerdEnv* env;
+            BundleManifest manifest;
+        };
+
+        const auto manifestFile = bundle.getChildFile ("manifest.ttl");
+        const auto contents = manifestFile.loadFileAsString();
+
+        if (contents.isEmpty())
+            return {};
+
+        auto base = serd_node_new_file_uri ((const uint8_t*) manifestFile.getFullPathName().toRawUTF8(), nullptr, nullptr, true);
+        Reader reader { &base };
+
+        auto* serdReader = serd_reader_new (SERD_TURTLE, &reader, nullptr,
+                                            Reader::onBase, Reader::onPrefix, Reader::onStatement, nullptr);
+        serd_reader_read_string (serdReader, (const uint8_t*) contents.toRawUTF8());
+        serd_reader_free (serdReader);
+        serd_node_free (&base);
+
+        return std::move (reader.manifest);
+    }
+
+    // Turns a search path into directories, expanding any %VARIABLES% the way lilv would.
+    static Array<File> getDirectories (const FileSearchPath& paths)
+    {
+        Array<File> result;
+
+        for (auto path : StringArray::fromTokens (paths.toStringWithSeparator ("\n"), "\n", {}))
+        {
+            for (int start; (start = path.indexOfChar ('%')) >= 0;)
+            {
+                const auto end = path.indexOfChar (start + 1, '%');
+
+                if (end < 0)
+                    break;
+
+                path = path.substring (0, start)
+                     + SystemStats::getEnvironmentVariable (path.substring (start + 1, end), {})
+                     + path.substring (end + 1);
+            }
+
+            if (File::isAbsolutePath (path))
+                result.add (File (path));
+        }
+
+        return result;
+    }
+
+    // Reads the manifests of all the bundles in some directories, and returns the bundles.
+    // Specification bundles are loaded straight away, as plugin descriptions depend on them.
+    Array<File> discoverBundles (const FileSearchPath& paths)
+    {
+        Array<File> bundles;
+
+        for (const auto& directory : getDirectories (paths))
+        {
+            for (const auto& entry : RangedDirectoryIterator (directory, false, "*", File::findDirectories))
+            {
+                const auto bundle = entry.getFile();
+                const auto key = bundle.getFullPathName();
+
+                if (manifests.find (key) == manifests.end())
+                {
+                    auto manifest = readManifest (bundle);
+
+                    if (manifest.pluginUris.empty() && manifest.referencedUris.empty() && ! manifest.isSpecification)
+                        continue;
+
+                    for (const auto& uri : manifest.pluginUris)
+                        bundlesForPlugins.emplace (uri, bundle);
+
+                    for (const auto& uri : manifest.referencedUris)
+                        bundlesReferringTo[uri].insert (key);
+
+                    if (manifest.isSpecification)
+                    {
+                        loadBundle (bundle);
+                        world->loadSpecifications();
+                    }
+
+                    manifests.emplace (key, std::move (manifest));
+                }
+
+                bundles.add (bundle);
+            }
+        }
+
+        return bundles;
+    }
+
+    File findBundleForPlugin (const String& uri)
     {
-        const auto joined = path.toStringWithSeparator (LILV_PATH_SEP);
-        world->loadAllFromPaths (world->newString (joined.toRawUTF8()));
+        auto iter = bundlesForPlugins.find (uri);
+
+        if (iter == bundlesForPlugins.end() && ! hasSearchedDefaultLocations)
+        {
+            hasSearchedDefaultLocations = true;
+            discoverBundles (getDefaultLocationsToSearch());
+            iter = bundlesForPlugins.find (uri);
+        }
+
+        return iter != bundlesForPlugins.end() ? iter->second : File();
+    }
+
+    void loadBundle (const File& bundle)
+    {
+        if (! loadedBundles.insert (bundle.getFullPathName()).second)
+            return;
+
+        const auto pathString = File::addTrailingSeparator (bundle.getFullPathName());
+        world->loadBundle (world->newFileUri (nullptr, pathString.toRawUTF8()));
+    }
+
+    // Loads the bundle holding a plugin, along with any other bundles that hold presets or UIs for it
+    void loadBundlesForPlugin (const String& uri)
+    {
+        const auto bundle = findBundleForPlugin (uri);
+
+        if (bundle == File())
+            return;
+
+        loadBundle (bundle);
+
+        const auto related = bundlesReferringTo.find (uri);
+
+        if (related != bundlesReferringTo.end())
+            for (const auto& path : related->second)
+                loadBundle (File (path));
+    }
+
+    // Describes a plugin, using the scan cache if the plugin's bundle hasn't changed since
+    // it was last described. Otherwise all the plugins in the bundle are described and cached.
+    PluginDescription findDescription (const String& uri)
+    {
+        const auto bundle = findBundleForPlugin (uri);
+
+        if (bundle == File())
+            return getDescription (findPluginByUri (uri));
+
+        const auto key = bundle.getFullPathName();
+
+        const auto findInTypes = [&uri] (const Array<PluginDescription>& types)
+        {
+            for (const auto& type : types)
+                if (type.fileOrIdentifier == uri)
+                    return type;
+
+            return PluginDescription();
+        };
+
+        if (scanCache != nullptr)
+        {
+            Array<PluginDescription> cachedTypes;
+
+            if (scanCache->getCachedTypes (LV2PluginFormat::getFormatName(), key, cachedTypes))
+            {
+                auto cached = findInTypes (cachedTypes);
+
+                if (cached.fileOrIdentifier.isNotEmpty())
+                    return cached;
+            }
+        }
+
+        const auto fingerprint = scanCache != nullptr ? PluginScanCache::createFingerprint (key)
+                                                      : PluginScanCache::Fingerprint();
+        Array<PluginDescription> types;
+
+        for (const auto& pluginUri : manifests[key].pluginUris)
+        {
+            auto desc = getDescription (findPluginByUri (pluginUri));
+
+            if (desc.fileOrIdentifier.isNotEmpty())
+                types.add (desc);
+        }
+
+        if (scanCache != nullptr)
+            scanCache->addResult (LV2PluginFormat::getFormatName(), key, fingerprint, types);
+
+        return findInTypes (types);
     }
 
     struct Free { void operator() (char* ptr) const noexcept { free (ptr); } };
@@ -5491,6 +5751,7 @@ private:
 
     const LilvPlugin* findPluginByUri (const String& s)
     {
+        loadBundlesForPlugin (s);
         return world->getAllPlugins().getByUri (world->newUri (s.toRawUTF8()));
     }
 
@@ -5578,6 +5839,13 @@ private:
     TemporaryFile lv2ResourceFolder;
     std::shared_ptr<lv2_host::World> world = std::make_shared<lv2_host::World>();
     lv2_host::UsefulUris uris { world->get() };
+
+    std::map<String, BundleManifest> manifests;
+    std::map<String, File> bundlesForPlugins;
+    std::map<String, std::set<String>> bundlesReferringTo;
+    std::set<String> loadedBundles;
+    bool hasSearchedDefaultLocations = false;
+    PluginScanCache* scanCache = nullptr;
 };
 
 //==============================================================================
@@ -5592,6 +5860,11 @@ void LV2PluginFormat::findAllTypesForFile (OwnedArray<PluginDescription>& result
     pimpl->findAllTypesForFile (results, fileOrIdentifier);
 }
 
+void LV2PluginFormat::setScanCache (PluginScanCache* cacheToUse)
+{
+    pimpl->setScanCache (cacheToUse);
+}
+
 bool LV2PluginFormat::fileMightContainThisPluginType (const String& fileOrIdentifier)
 {
     return pimpl->fileMightContainThisPluginType (fileOrIdentifier);
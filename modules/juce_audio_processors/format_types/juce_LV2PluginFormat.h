@@ -28,6 +28,8 @@ namespace juce
 
 #if (JUCE_PLUGINHOST_LV2 && (! (JUCE_ANDROID || JUCE_IOS))) || DOXYGEN
 
+class PluginScanCache;
+
 /**
     Implements a plugin format for LV2 plugins.
 
@@ -63,6 +65,18 @@ public:
 
     FileSearchPath getDefaultLocationsToSearch() override;
 
+    /** Gives the format a cache in which to keep the descriptions of the plugins it finds.
+
+        Plugins are found by reading only the manifest of each bundle, and a bundle's full
+        data is only loaded when one of its plugins is described or instantiated. With a
+        cache, findAllTypesForFile() can describe plugins from bundles that haven't changed
+        since they were last described without loading those bundles at all.
+
+        The cache isn't owned by the format, and must outlive it. Pass nullptr to stop
+        using a cache.
+    */
+    void setScanCache (PluginScanCache* cacheToUse);
+
 private:
     bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override;
     void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback) override;
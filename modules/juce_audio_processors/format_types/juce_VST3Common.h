@@ -643,6 +643,11 @@ static bool validateLayouts (Iterator first, Iterator last, const std::vector<Dy
     An instance of this class handles input and output remapping for a single data type (float or
     double), matching the FloatType template parameter.
 
+    Wherever possible, the JUCE buffer refers directly to the host's output channels, so that
+    in-place processing and plain reordering don't need any copying. A host channel is only used
+    in this way if it isn't shared with any other input or output channel; otherwise the
+    channel is processed in an internal scratch buffer, as usual.
+
     This is in VST3Common.h, rather than in the VST3_Wrapper.cpp, so that we can test it.
 
     @see ClientBufferMapper
@@ -654,7 +659,9 @@ public:
     void prepare (int numChannels, int blockSize)
     {
         scratchBuffer.setSize (numChannels, blockSize);
-        channels.reserve ((size_t) jmin (128, numChannels));
+
+        for (auto* v : { &channels, &hostInputs, &hostOutputs, &allHostInputs, &allHostOutputs })
+            v->reserve ((size_t) jmin (128, numChannels));
     }
 
     AudioBuffer<FloatType> getMappedBuffer (Steinberg::Vst::ProcessData& data,
@@ -672,8 +679,35 @@ public:
         if (! validateLayouts<FloatType> (data.inputs, data.inputs + vstInputs, inputMap))
             return getBlankBuffer (usedChannels, (int) data.numSamples);
 
-        setUpInputChannels (data, (size_t) vstInputs, scratchBuffer, inputMap,  channels);
-        setUpOutputChannels (scratchBuffer, outputMap, channels);
+        const auto vstOutputs = countValidBuses<FloatType> (data.outputs, data.numOutputs);
+
+        collectHostChannels (data.inputs, (size_t) vstInputs, inputMap, hostInputs, allHostInputs);
+
+        // If the output layout is unexpected, the outputs will be cleared rather than copied, so
+        // they can't be used for processing.
+        if (validateLayouts<FloatType> (data.outputs, data.outputs + vstOutputs, outputMap))
+            collectHostChannels (data.outputs, (size_t) vstOutputs, outputMap, hostOutputs, allHostOutputs);
+        else
+            collectHostChannels (data.outputs, 0, outputMap, hostOutputs, allHostOutputs);
+
+        for (size_t i = 0; i < (size_t) usedChannels; ++i)
+        {
+            auto* input  = i < hostInputs .size() ? hostInputs [i] : nullptr;
+            auto* output = i < hostOutputs.size() ? hostOutputs[i] : nullptr;
+
+            auto* channel = canProcessInPlace (output, input) ? output
+                                                              : scratchBuffer.getNextChannelBuffer();
+            channels.push_back (channel);
+
+            // Channels past the end of the inputs are output-only, so they may contain any data
+            if (i >= hostInputs.size())
+                continue;
+
+            if (input == nullptr)
+                FloatVectorOperations::clear (channel, (size_t) data.numSamples);
+            else if (input != channel)
+                FloatVectorOperations::copy (channel, input, (size_t) data.numSamples);
+        }
 
         const auto channelPtr = channels.empty() ? scratchBuffer.getArrayOfWritePointers()
                                                  : channels.data();
@@ -682,62 +716,53 @@ public:
     }
 
 private:
-    static void setUpInputChannels (Steinberg::Vst::ProcessData& data,
-                                    size_t vstInputs,
-                                    ScratchBuffer<FloatType>& scratchBuffer,
-                                    const std::vector<DynamicChannelMapping>& map,
-                                    std::vector<FloatType*>& channels)
+    /*  Fills 'mapped' with the host channel for each client channel in JUCE order, or nullptr
+        where the host doesn't supply that channel, and 'all' with every channel the host
+        provided on an active bus, whether or not the client is using it.
+    */
+    static void collectHostChannels (Steinberg::Vst::AudioBusBuffers* buses,
+                                     size_t numBuses,
+                                     const std::vector<DynamicChannelMapping>& map,
+                                     std::vector<FloatType*>& mapped,
+                                     std::vector<FloatType*>& all)
     {
+        mapped.clear();
+        all.clear();
+
         for (size_t busIndex = 0; busIndex < map.size(); ++busIndex)
         {
-            const auto mapping = map[busIndex];
+            const auto& mapping = map[busIndex];
+            const auto hostActive = mapping.isHostActive() && busIndex < numBuses;
+            auto** busPtr = hostActive ? getAudioBusPointer (detail::Tag<FloatType>{}, buses[busIndex]) : nullptr;
+
+            if (hostActive)
+                all.insert (all.end(), busPtr, busPtr + mapping.size());
 
             if (! mapping.isClientActive())
                 continue;
 
-            const auto originalSize = channels.size();
-
-            for (size_t channelIndex = 0; channelIndex < mapping.size(); ++channelIndex)
-                channels.push_back (scratchBuffer.getNextChannelBuffer());
-
-            if (mapping.isHostActive() && busIndex < vstInputs)
-            {
-                auto** busPtr = getAudioBusPointer (detail::Tag<FloatType>{}, data.inputs[busIndex]);
+            const auto originalSize = mapped.size();
+            mapped.resize (originalSize + mapping.size(), nullptr);
 
+            if (hostActive)
                 for (size_t channelIndex = 0; channelIndex < mapping.size(); ++channelIndex)
-                {
-                    FloatVectorOperations::copy (channels[(size_t) mapping.getJuceChannelForVst3Channel ((int) channelIndex) + originalSize],
-                                                 busPtr[channelIndex],
-                                                 (size_t) data.numSamples);
-                }
-            }
-            else
-            {
-                for (size_t channelIndex = 0; channelIndex < mapping.size(); ++channelIndex)
-                    FloatVectorOperations::clear (channels[originalSize + channelIndex], (size_t) data.numSamples);
-            }
+                    mapped[originalSize + (size_t) mapping.getJuceChannelForVst3Channel ((int) channelIndex)] = busPtr[channelIndex];
         }
     }
 
-    static void setUpOutputChannels (ScratchBuffer<FloatType>& scratchBuffer,
-                                     const std::vector<DynamicChannelMapping>& map,
-                                     std::vector<FloatType*>& channels)
+    /*  A host output can stand in for a client channel if writing to it can't clobber any other
+        channel: it mustn't appear anywhere else in the outputs, and the only input it may alias
+        is the one feeding the same client channel.
+    */
+    bool canProcessInPlace (FloatType* output, FloatType* input) const
     {
-        for (size_t i = 0, initialBusIndex = 0; i < (size_t) map.size(); ++i)
-        {
-            const auto& mapping = map[i];
+        if (output == nullptr)
+            return false;
 
-            if (mapping.isClientActive())
-            {
-                for (size_t j = 0; j < mapping.size(); ++j)
-                {
-                    if (channels.size() <= initialBusIndex + j)
-                        channels.push_back (scratchBuffer.getNextChannelBuffer());
-                }
+        const auto numOutputUses = std::count (allHostOutputs.begin(), allHostOutputs.end(), output);
+        const auto numInputUses  = std::count (allHostInputs .begin(), allHostInputs .end(), output);
 
-                initialBusIndex += mapping.size();
-            }
-        }
+        return numOutputUses == 1 && (numInputUses == 0 || (numInputUses == 1 && input == output));
     }
 
     AudioBuffer<FloatType> getBlankBuffer (int usedChannels, int usedSamples)
@@ -755,7 +780,7 @@ private:
         return { channels.data(), (int) channels.size(), usedSamples };
     }
 
-    std::vector<FloatType*> channels;
+    std::vector<FloatType*> channels, hostInputs, hostOutputs, allHostInputs, allHostOutputs;
     ScratchBuffer<FloatType> scratchBuffer;
 };
 
@@ -946,7 +971,10 @@ private:
                     {
                         auto* hostChannel = getAudioBusPointer (detail::Tag<FloatType>{}, bus)[j];
                         const auto juceChannel = juceBusOffset + (size_t) mapping.getJuceChannelForVst3Channel ((int) j);
-                        FloatVectorOperations::copy (hostChannel, buffer.getReadPointer ((int) juceChannel), (size_t) data.numSamples);
+                        const auto* clientChannel = buffer.getReadPointer ((int) juceChannel);
+
+                        if (hostChannel != clientChannel)
+                            FloatVectorOperations::copy (hostChannel, clientChannel, (size_t) data.numSamples);
                     }
                 }
                 else
@@ -1224,6 +1252,29 @@ public:
         }
     }
 
+    /*  Notes and poly pressure become MIDI 2.0 packets directly, so that they keep their full
+        resolution. Anything else is converted via its MIDI 1.0 equivalent.
+    */
+    static void toEventBuffer (ump::EventBuffer& result,
+                               Steinberg::Vst::IEventList& eventList,
+                               ump::EventBufferConverter& converter)
+    {
+        const auto numEvents = eventList.getEventCount();
+
+        for (Steinberg::int32 i = 0; i < numEvents; ++i)
+        {
+            Steinberg::Vst::Event e;
+
+            if (eventList.getEvent (i, e) != Steinberg::kResultOk)
+                continue;
+
+            if (const auto packet = toUniversalMidiPacket (e))
+                result.add (*packet, e.sampleOffset);
+            else if (const auto message = toMidiMessage (e))
+                converter.toEventBuffer (*message, e.sampleOffset, result);
+        }
+    }
+
     template <typename Callback>
     static void hostToPluginEventList (Steinberg::Vst::IEventList& result,
                                        MidiBuffer& midiBuffer,
@@ -1554,6 +1605,39 @@ private:
         return {};
     }
 
+    static std::optional<ump::PacketX2> toUniversalMidiPacket (const Steinberg::Vst::Event& e)
+    {
+        const auto toUMPChannel = [] (Steinberg::int16 channel) { return (uint8_t) jlimit (0, 15, (int) channel); };
+        const auto toUMPNote    = [] (Steinberg::int16 pitch)   { return (uint8_t) createSafeNote (pitch); };
+        const auto toUMP16      = [] (float value) { return (uint16_t) jlimit (0, 0xffff, roundToInt (value * (float) 0xffff)); };
+        const auto toUMP32      = [] (float value) { return (uint32_t) jlimit (0.0, (double) 0xffffffff, std::round (value * (double) 0xffffffff)); };
+
+        switch (e.type)
+        {
+            case Steinberg::Vst::Event::kNoteOnEvent:
+                // A MIDI 2.0 note-on with zero velocity is still a note-on, unlike a MIDI 1.0 one
+                if (e.noteOn.velocity <= 0.0f)
+                    return ump::Factory::makeNoteOffV2 (0, toUMPChannel (e.noteOn.channel), toUMPNote (e.noteOn.pitch),
+                                                        ump::Factory::NoteAttributeKind::none, 0, 0);
+
+                return ump::Factory::makeNoteOnV2 (0, toUMPChannel (e.noteOn.channel), toUMPNote (e.noteOn.pitch),
+                                                   ump::Factory::NoteAttributeKind::none, toUMP16 (e.noteOn.velocity), 0);
+
+            case Steinberg::Vst::Event::kNoteOffEvent:
+                return ump::Factory::makeNoteOffV2 (0, toUMPChannel (e.noteOff.channel), toUMPNote (e.noteOff.pitch),
+                                                    ump::Factory::NoteAttributeKind::none, toUMP16 (e.noteOff.velocity), 0);
+
+            case Steinberg::Vst::Event::kPolyPressureEvent:
+                return ump::Factory::makePolyPressureV2 (0, toUMPChannel (e.polyPressure.channel), toUMPNote (e.polyPressure.pitch),
+                                                         toUMP32 (e.polyPressure.pressure));
+
+            default:
+                break;
+        }
+
+        return {};
+    }
+
     //==============================================================================
     struct Vst3MidiControlEvent
     {
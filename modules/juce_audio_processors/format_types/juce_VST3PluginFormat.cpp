@@ -2008,13 +2008,23 @@ struct VST3ComponentHolder
 };
 
 //==============================================================================
-/*  A queue which can store up to one element.
+/*  A queue which can store a few points.
 
     This is more memory-efficient than storing large vectors of
-    parameter changes that we'll just throw away.
+    parameter changes that we'll just throw away. If more points
+    are added than will fit, the last one is replaced, so that the
+    parameter still ends up at the right value.
 */
 class ParamValueQueue : public Vst::IParamValueQueue
 {
+    struct Point
+    {
+        Steinberg::int32 sampleOffset;
+        float value;
+    };
+
+    static constexpr Steinberg::int32 maxNumPoints = 16;
+
 public:
     ParamValueQueue (Vst::ParamID idIn, Steinberg::int32 parameterIndexIn)
         : paramId (idIn), parameterIndex (parameterIndexIn) {}
@@ -2037,25 +2047,26 @@ public:
         if (! isPositiveAndBelow (index, size))
             return kResultFalse;
 
-        sampleOffset = 0;
-        value = cachedValue;
+        sampleOffset = points[(size_t) index].sampleOffset;
+        value = points[(size_t) index].value;
 
         return kResultTrue;
     }
 
-    tresult PLUGIN_API addPoint (Steinberg::int32,
+    tresult PLUGIN_API addPoint (Steinberg::int32 sampleOffset,
                                  Vst::ParamValue value,
                                  Steinberg::int32& index) override
     {
-        index = size++;
-        set ((float) value);
+        index = jmin (size, maxNumPoints - 1);
+        points[(size_t) index] = { sampleOffset, (float) value };
+        size = index + 1;
 
         return kResultTrue;
     }
 
     void set (float valueIn)
     {
-        cachedValue = valueIn;
+        points[0] = { 0, valueIn };
         size = 1;
     }
 
@@ -2064,13 +2075,13 @@ public:
     float get() const noexcept
     {
         jassert (size > 0);
-        return cachedValue;
+        return points[(size_t) size - 1].value;
     }
 
 private:
     const Vst::ParamID paramId;
     const Steinberg::int32 parameterIndex;
-    float cachedValue;
+    std::array<Point, (size_t) maxNumPoints> points;
     Steinberg::int32 size = 0;
     Atomic<int> refCount;
 };
@@ -2148,6 +2159,19 @@ public:
             queue->set (value);
     }
 
+    void set (Vst::ParamID id, const AudioProcessorParameterAutomation::Lane& lane)
+    {
+        Steinberg::int32 indexOut = notInVector;
+
+        if (auto* queue = addParameterData (id, indexOut))
+        {
+            queue->clear();
+
+            for (const auto& point : lane)
+                queue->addPoint (point.sampleOffset, point.value, indexOut);
+        }
+    }
+
     void clear()
     {
         for (auto* item : queues)
@@ -2681,6 +2705,15 @@ public:
             inputParameterChanges->set (cachedParamValues.getParamID (index), value);
         });
 
+        // Any sample-accurate changes replace the single values that were set above
+        if (auto* automation = getParameterAutomation())
+        {
+            for (const auto& lane : *automation)
+                if (auto* param = getParameters()[lane.getParameter().getParameterIndex()])
+                    if (param == &lane.getParameter())
+                        inputParameterChanges->set (static_cast<VST3Parameter*> (param)->getParamID(), lane);
+        }
+
         processor->process (data);
 
         outputParameterChanges->forEach ([&] (Steinberg::int32 index, float value)
@@ -2879,6 +2912,8 @@ public:
     bool acceptsMidi() const override    { return hasMidiInput; }
     bool producesMidi() const override   { return hasMidiOutput; }
 
+    bool supportsSampleAccurateAutomation() const override   { return true; }
+
     //==============================================================================
     AudioProcessorParameter* getBypassParameter() const override         { return bypassParam; }
 
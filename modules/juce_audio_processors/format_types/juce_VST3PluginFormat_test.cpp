@@ -490,6 +490,119 @@ public:
             expect (channelStartsWithValue (data.outputs[2], 3, 7.0f));
         }
 
+        beginTest ("Unshared host output channels are passed to the client directly, including in-place channels");
+        {
+            ClientBufferMapperData<float> remapper;
+            remapper.prepare (8, blockSize * 2);
+
+            const Config config { { DynamicChannelMapping { AudioChannelSet::stereo() } },
+                                  { DynamicChannelMapping { AudioChannelSet::create7point1() } } };
+            const auto& mapping = config.outs.front();
+
+            TestBuffers testBuffers { blockSize };
+
+            auto ins  = MultiBusBuffers{}.withBus (testBuffers, 2);
+            auto outs = MultiBusBuffers{}.withBus (testBuffers, 8);
+
+            auto data = makeProcessData (blockSize, ins, outs);
+
+            // The host processes the first two channels in-place
+            data.outputs[0].channelBuffers32[0] = data.inputs[0].channelBuffers32[0];
+            data.outputs[0].channelBuffers32[1] = data.inputs[0].channelBuffers32[1];
+
+            testBuffers.init();
+
+            {
+                ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data };
+                auto& remapped = scopedBuffer.buffer;
+
+                expect (remapped.getNumChannels() == 8);
+
+                for (auto i = 0; i < 8; ++i)
+                    expect (remapped.getReadPointer (mapping.getJuceChannelForVst3Channel (i)) == data.outputs[0].channelBuffers32[i]);
+
+                expect (allMatch (remapped, 0, 1.0f));
+                expect (allMatch (remapped, 1, 2.0f));
+
+                for (auto i = 0; i < remapped.getNumChannels(); ++i)
+                {
+                    auto* ptr = remapped.getWritePointer (i);
+                    std::fill (ptr, ptr + remapped.getNumSamples(), (float) i);
+                }
+            }
+
+            for (auto i = 0; i < 8; ++i)
+                expect (channelStartsWithValue (data.outputs[0], (size_t) i, (float) mapping.getJuceChannelForVst3Channel (i)));
+        }
+
+        beginTest ("Host output channels that alias other channels are processed in internal channels");
+        {
+            ClientBufferMapperData<float> remapper;
+            remapper.prepare (2, blockSize * 2);
+
+            const Config config { { DynamicChannelMapping { AudioChannelSet::stereo() } },
+                                  { DynamicChannelMapping { AudioChannelSet::stereo() } } };
+
+            TestBuffers testBuffers { blockSize };
+
+            auto ins  = MultiBusBuffers{}.withBus (testBuffers, 2);
+            auto outs = MultiBusBuffers{}.withBus (testBuffers, 2);
+
+            auto data = makeProcessData (blockSize, ins, outs);
+
+            const auto isHostChannel = [&] (const float* ptr)
+            {
+                return std::any_of (testBuffers.buffers.begin(), testBuffers.buffers.end(), [&] (const auto& b) { return b.data() == ptr; });
+            };
+
+            {
+                // Each output writes to the input of the other channel
+                data.outputs[0].channelBuffers32[0] = data.inputs[0].channelBuffers32[1];
+                data.outputs[0].channelBuffers32[1] = data.inputs[0].channelBuffers32[0];
+
+                testBuffers.init();
+
+                {
+                    ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data };
+                    auto& remapped = scopedBuffer.buffer;
+
+                    expect (! isHostChannel (remapped.getReadPointer (0)));
+                    expect (! isHostChannel (remapped.getReadPointer (1)));
+
+                    expect (allMatch (remapped, 0, 1.0f));
+                    expect (allMatch (remapped, 1, 2.0f));
+
+                    FloatVectorOperations::fill (remapped.getWritePointer (0), 10.0f, blockSize);
+                    FloatVectorOperations::fill (remapped.getWritePointer (1), 20.0f, blockSize);
+                }
+
+                expect (testBuffers.allMatch (1, 10.0f));
+                expect (testBuffers.allMatch (0, 20.0f));
+            }
+
+            {
+                // Both outputs share the same channel
+                data.outputs[0].channelBuffers32[0] = testBuffers.get (2);
+                data.outputs[0].channelBuffers32[1] = testBuffers.get (2);
+
+                testBuffers.init();
+
+                {
+                    ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data };
+                    auto& remapped = scopedBuffer.buffer;
+
+                    expect (! isHostChannel (remapped.getReadPointer (0)));
+                    expect (! isHostChannel (remapped.getReadPointer (1)));
+
+                    expect (allMatch (remapped, 0, 1.0f));
+                    expect (allMatch (remapped, 1, 2.0f));
+                }
+
+                expect (testBuffers.allMatch (0, 1.0f));
+                expect (testBuffers.allMatch (1, 2.0f));
+            }
+        }
+
         beginTest ("HostBufferMapper reorders channels correctly");
         {
             HostBufferMapper mapper;
@@ -58,6 +58,11 @@
  #include <AudioUnit/AudioUnit.h>
 #endif
 
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+#endif
+
 namespace juce
 {
 
@@ -193,6 +198,8 @@ private:
 #include "utilities/juce_FlagCache.h"
 #include "format/juce_AudioPluginFormat.cpp"
 #include "format/juce_AudioPluginFormatManager.cpp"
+#include "format/juce_AudioPluginBatchLoader.cpp"
+#include "format/juce_OutOfProcessPluginHost.cpp"
 #include "format_types/juce_LegacyAudioParameter.cpp"
 #include "processors/juce_AudioProcessor.cpp"
 #include "processors/juce_AudioPluginInstance.cpp"
@@ -208,8 +215,11 @@ private:
 #include "format_types/juce_ARAHosting.cpp"
 #include "scanning/juce_KnownPluginList.cpp"
 #include "scanning/juce_PluginDirectoryScanner.cpp"
+#include "scanning/juce_PluginScanCache.cpp"
+#include "scanning/juce_OutOfProcessPluginScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 #include "processors/juce_AudioProcessorParameterGroup.cpp"
+#include "processors/juce_AudioProcessorParameterAutomation.cpp"
 #include "utilities/juce_AudioProcessorParameterWithID.cpp"
 #include "utilities/juce_RangedAudioParameter.cpp"
 #include "utilities/juce_AudioParameterFloat.cpp"
@@ -210,13 +210,115 @@ bool AudioProcessor::enableAllBuses()
     return setBusesLayout (layouts);
 }
 
+//==============================================================================
+struct AudioProcessor::BusesLayoutSupport
+{
+    // The number of input buses, followed by the channels of every input and output bus
+    using Key = std::pair<size_t, std::vector<AudioChannelSet::ChannelMask>>;
+
+    static std::optional<Key> makeKey (const BusesLayout& layouts)
+    {
+        Key key;
+        key.first = (size_t) layouts.inputBuses.size();
+        key.second.reserve ((size_t) (layouts.inputBuses.size() + layouts.outputBuses.size()));
+
+        for (const auto* buses : { &layouts.inputBuses, &layouts.outputBuses })
+        {
+            for (const auto& set : *buses)
+            {
+                if (const auto mask = set.getChannelMask())
+                    key.second.push_back (*mask);
+                else
+                    return {};
+            }
+        }
+
+        return key;
+    }
+
+    std::vector<Key> declaredLayouts; // sorted, so that they can be binary-searched
+    std::map<Key, bool> cachedResults;
+    int cacheDepth = 0;
+};
+
+AudioProcessor::ScopedBusesLayoutSupportCache::ScopedBusesLayoutSupportCache (const AudioProcessor& p)
+    : processor (p)
+{
+    auto& support = processor.busesLayoutSupport;
+
+    if (support == nullptr)
+        support = std::make_unique<BusesLayoutSupport>();
+
+    ++support->cacheDepth;
+}
+
+AudioProcessor::ScopedBusesLayoutSupportCache::~ScopedBusesLayoutSupportCache()
+{
+    auto& support = *processor.busesLayoutSupport;
+
+    if (--support.cacheDepth == 0)
+        support.cachedResults.clear();
+}
+
 bool AudioProcessor::checkBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    if (layouts.inputBuses.size() == inputBuses.size()
-          && layouts.outputBuses.size() == outputBuses.size())
+    if (layouts.inputBuses.size() != inputBuses.size()
+          || layouts.outputBuses.size() != outputBuses.size())
+        return false;
+
+    if (busesLayoutSupport == nullptr || busesLayoutSupport->cacheDepth == 0)
         return isBusesLayoutSupported (layouts);
 
-    return false;
+    auto key = BusesLayoutSupport::makeKey (layouts);
+
+    if (! key.has_value())
+        return isBusesLayoutSupported (layouts);
+
+    auto& cache = busesLayoutSupport->cachedResults;
+    const auto existing = cache.find (*key);
+
+    if (existing != cache.end())
+        return existing->second;
+
+    const auto result = isBusesLayoutSupported (layouts);
+    cache.emplace (std::move (*key), result);
+    return result;
+}
+
+bool AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+    if (busesLayoutSupport == nullptr || busesLayoutSupport->declaredLayouts.empty())
+        return true;
+
+    const auto& declared = busesLayoutSupport->declaredLayouts;
+    const auto key = BusesLayoutSupport::makeKey (layouts);
+
+    return key.has_value() && std::binary_search (declared.begin(), declared.end(), *key);
+}
+
+void AudioProcessor::setSupportedBusesLayouts (const Array<BusesLayout>& supportedLayouts)
+{
+    if (busesLayoutSupport == nullptr)
+        busesLayoutSupport = std::make_unique<BusesLayoutSupport>();
+
+    auto& declared = busesLayoutSupport->declaredLayouts;
+    declared.clear();
+
+    for (const auto& layout : supportedLayouts)
+    {
+        // Each layout should have one channel set for each of the processor's buses
+        jassert (layout.inputBuses.size() == inputBuses.size() && layout.outputBuses.size() == outputBuses.size());
+
+        if (auto key = BusesLayoutSupport::makeKey (layout))
+            declared.push_back (std::move (*key));
+        else
+            jassertfalse; // This layout uses more discrete channels than can be declared
+    }
+
+    std::sort (declared.begin(), declared.end());
+    declared.erase (std::unique (declared.begin(), declared.end()), declared.end());
+
+    busesLayoutSupport->cachedResults.clear();
 }
 
 void AudioProcessor::getNextBestLayout (const BusesLayout& desiredLayout, BusesLayout& actualLayouts) const
@@ -561,6 +663,88 @@ void AudioProcessor::setParameterTree (AudioProcessorParameterGroup&& newTree)
 
 void AudioProcessor::refreshParameterList() {}
 
+//==============================================================================
+struct AudioProcessor::ParameterChangeBatch
+{
+    explicit ParameterChangeBatch (int numParameters)
+        : changed ((size_t) numParameters), size (numParameters)
+    {
+        changedIndices.ensureStorageAllocated (numParameters);
+        indicesForListener.ensureStorageAllocated (numParameters);
+    }
+
+    FlagCache<1> changed;
+    const int size;
+    std::atomic<int> depth { 0 };
+
+    Array<int> changedIndices, indicesForListener;
+    Array<AudioProcessorParameter::Listener*> listeners;
+};
+
+AudioProcessor::ScopedParameterChangeBatch::ScopedParameterChangeBatch (AudioProcessor& p)
+    : processor (p)
+{
+    auto& batch = processor.parameterChangeBatch;
+    const auto numParameters = processor.flatParameterList.size();
+
+    if (batch == nullptr || (batch->depth == 0 && batch->size != numParameters))
+        batch = std::make_unique<ParameterChangeBatch> (numParameters);
+
+    ++batch->depth;
+}
+
+AudioProcessor::ScopedParameterChangeBatch::~ScopedParameterChangeBatch()
+{
+    if (--processor.parameterChangeBatch->depth == 0)
+        processor.sendBatchedParameterChanges();
+}
+
+void AudioProcessor::sendBatchedParameterChanges()
+{
+    auto& batch = *parameterChangeBatch;
+
+    batch.changedIndices.clearQuick();
+    batch.changed.ifSet ([&batch] (size_t index, uint32_t) { batch.changedIndices.add ((int) index); });
+
+    if (batch.changedIndices.isEmpty())
+        return;
+
+    batch.listeners.clearQuick();
+
+    for (auto index : batch.changedIndices)
+    {
+        flatParameterList.getUnchecked (index)->listeners.call ([&batch] (AudioProcessorParameter::Listener& l)
+        {
+            batch.listeners.addIfNotAlreadyThere (&l);
+        });
+    }
+
+    for (auto* l : batch.listeners)
+    {
+        // The parameters are checked again here, in case an earlier callback has removed
+        // this listener
+        batch.indicesForListener.clearQuick();
+
+        for (auto index : batch.changedIndices)
+            if (flatParameterList.getUnchecked (index)->listeners.contains (l))
+                batch.indicesForListener.add (index);
+
+        if (! batch.indicesForListener.isEmpty())
+            l->parameterValuesChanged (*this, batch.indicesForListener);
+    }
+
+    // audioProcessorParameterChanged callbacks will shortly be deprecated and
+    // this code will be removed.
+    for (auto index : batch.changedIndices)
+    {
+        const auto value = flatParameterList.getUnchecked (index)->getValue();
+
+        for (int i = listeners.size(); --i >= 0;)
+            if (auto* l = listeners[i])
+                l->audioProcessorParameterChanged (this, index, value);
+    }
+}
+
 int AudioProcessor::getDefaultNumParameterSteps() noexcept
 {
     return 0x7fffffff;
@@ -591,6 +775,59 @@ void AudioProcessor::processBypassed (AudioBuffer<floatType>& buffer, MidiBuffer
 void AudioProcessor::processBlockBypassed (AudioBuffer<float>&  buffer, MidiBuffer& midi)    { processBypassed (buffer, midi); }
 void AudioProcessor::processBlockBypassed (AudioBuffer<double>& buffer, MidiBuffer& midi)    { processBypassed (buffer, midi); }
 
+//==============================================================================
+AudioProcessor::PacketBridge& AudioProcessor::getPacketBridge()
+{
+    // This is only created the first time that a block needs converting, which will be
+    // on the audio thread, but after that the buffers are reused.
+    if (packetBridge == nullptr)
+    {
+        packetBridge = std::make_unique<PacketBridge>();
+        packetBridge->midi.ensureSize (2048);
+        packetBridge->packets.reserve (512);
+    }
+
+    return *packetBridge;
+}
+
+template <typename FloatType>
+void AudioProcessor::processPacketsWithMidiBuffer (AudioBuffer<FloatType>& buffer, universal_midi_packets::EventBuffer& events)
+{
+    auto& bridge = getPacketBridge();
+
+    bridge.midi.clear();
+    bridge.converter.toMidiBuffer (events, bridge.midi);
+
+    processBlock (buffer, bridge.midi);
+
+    events.clear();
+    bridge.converter.toEventBuffer (bridge.midi, events);
+}
+
+template <typename FloatType>
+void AudioProcessor::processMidiBufferWithPackets (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages)
+{
+    // If you hit this, your processor calls processBlockAsPackets() without overriding
+    // processPacketBlock(), which would just call processBlock() again!
+    jassert (supportsUniversalMidiPackets());
+
+    auto& bridge = getPacketBridge();
+
+    bridge.packets.clear();
+    bridge.converter.toEventBuffer (midiMessages, bridge.packets);
+
+    processPacketBlock (buffer, bridge.packets);
+
+    midiMessages.clear();
+    bridge.converter.toMidiBuffer (bridge.packets, midiMessages);
+}
+
+void AudioProcessor::processPacketBlock (AudioBuffer<float>&  buffer, universal_midi_packets::EventBuffer& events)  { processPacketsWithMidiBuffer (buffer, events); }
+void AudioProcessor::processPacketBlock (AudioBuffer<double>& buffer, universal_midi_packets::EventBuffer& events)  { processPacketsWithMidiBuffer (buffer, events); }
+
+void AudioProcessor::processBlockAsPackets (AudioBuffer<float>&  buffer, MidiBuffer& midi)   { processMidiBufferWithPackets (buffer, midi); }
+void AudioProcessor::processBlockAsPackets (AudioBuffer<double>& buffer, MidiBuffer& midi)   { processMidiBufferWithPackets (buffer, midi); }
+
 void AudioProcessor::processBlock ([[maybe_unused]] AudioBuffer<double>& buffer,
                                    [[maybe_unused]] MidiBuffer& midiMessages)
 {
@@ -950,6 +1187,26 @@ std::unique_ptr<XmlElement> AudioProcessor::getXmlFromBinary (const void* data,
     return {};
 }
 
+void AudioProcessor::copyValueTreeToBinary (const ValueTree& tree, juce::MemoryBlock& destData,
+                                            ValueTreeBinaryFormat::Compression compression)
+{
+    ValueTreeBinaryFormat::write (tree, destData, compression);
+}
+
+ValueTree AudioProcessor::getValueTreeFromBinary (const void* data, const int sizeInBytes)
+{
+    if (sizeInBytes <= 0)
+        return {};
+
+    if (ValueTreeBinaryFormat::isBinaryFormat (data, (size_t) sizeInBytes))
+        return ValueTreeBinaryFormat::read (data, (size_t) sizeInBytes);
+
+    if (auto xml = getXmlFromBinary (data, sizeInBytes))
+        return ValueTree::fromXml (*xml);
+
+    return {};
+}
+
 bool AudioProcessor::canApplyBusCountChange (bool isInput, bool isAdding,
                                              AudioProcessor::BusProperties& outProperties)
 {
@@ -1052,6 +1309,8 @@ bool AudioProcessor::Bus::enable (bool shouldEnable)
 
 int AudioProcessor::Bus::getMaxSupportedChannels (int limit) const
 {
+    const ScopedBusesLayoutSupportCache cache (owner);
+
     for (int ch = limit; ch > 0; --ch)
         if (isNumberOfChannelsSupported (ch))
             return ch;
@@ -1524,11 +1783,7 @@ void AudioProcessorParameter::beginChangeGesture()
     isPerformingGesture = true;
    #endif
 
-    ScopedLock lock (listenerLock);
-
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners[i])
-            l->parameterGestureChanged (getParameterIndex(), true);
+    listeners.call ([this] (Listener& l) { l.parameterGestureChanged (getParameterIndex(), true); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
@@ -1553,11 +1808,7 @@ void AudioProcessorParameter::endChangeGesture()
     isPerformingGesture = false;
    #endif
 
-    ScopedLock lock (listenerLock);
-
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners[i])
-            l->parameterGestureChanged (getParameterIndex(), false);
+    listeners.call ([this] (Listener& l) { l.parameterGestureChanged (getParameterIndex(), false); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
@@ -1571,11 +1822,21 @@ void AudioProcessorParameter::endChangeGesture()
 
 void AudioProcessorParameter::sendValueChangedMessageToListeners (float newValue)
 {
-    ScopedLock lock (listenerLock);
+    if (processor != nullptr && parameterIndex >= 0)
+    {
+        if (auto* batch = processor->parameterChangeBatch.get())
+        {
+            if (batch->depth > 0 && parameterIndex < batch->size)
+            {
+                batch->changed.set ((size_t) parameterIndex, 1);
+                return;
+            }
+        }
+    }
 
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners [i])
-            l->parameterValueChanged (getParameterIndex(), newValue);
+    // This may be called on the audio thread, so the listeners are called without
+    // taking a lock or allocating
+    listeners.call ([this, newValue] (Listener& l) { l.parameterValueChanged (getParameterIndex(), newValue); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
@@ -1618,16 +1879,324 @@ StringArray AudioProcessorParameter::getAllValueStrings() const
     return valueStrings;
 }
 
+void AudioProcessorParameter::Listener::parameterValuesChanged (const AudioProcessor& processor, const Array<int>& parameterIndices)
+{
+    auto& parameters = processor.getParameters();
+
+    for (auto index : parameterIndices)
+        parameterValueChanged (index, parameters.getUnchecked (index)->getValue());
+}
+
 void AudioProcessorParameter::addListener (AudioProcessorParameter::Listener* newListener)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.addIfNotAlreadyThere (newListener);
+    listeners.add (newListener);
 }
 
 void AudioProcessorParameter::removeListener (AudioProcessorParameter::Listener* listenerToRemove)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.removeFirstMatchingValue (listenerToRemove);
+    listeners.remove (listenerToRemove);
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterChangeBatchTests  : public UnitTest
+{
+public:
+    ParameterChangeBatchTests()
+        : UnitTest ("ParameterChangeBatch", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("FlagCache reports each set item once, in order");
+        {
+            FlagCache<3> cache (5000);
+            Random random (getRandom());
+
+            for (int attempt = 0; attempt < 10; ++attempt)
+            {
+                std::map<size_t, uint32_t> expected;
+
+                for (int i = random.nextInt (200); --i >= 0;)
+                {
+                    const auto index = (size_t) random.nextInt (5000);
+                    const auto bits = (uint32_t) (1 << random.nextInt (3));
+                    cache.set (index, bits);
+                    expected[index] |= bits;
+                }
+
+                std::map<size_t, uint32_t> actual;
+                auto inOrder = true;
+
+                cache.ifSet ([&] (size_t index, uint32_t bits)
+                {
+                    inOrder = inOrder && (actual.empty() || actual.rbegin()->first < index);
+                    actual[index] = bits;
+                });
+
+                expect (inOrder);
+                expect (actual == expected);
+
+                auto anyLeft = false;
+                cache.ifSet ([&] (size_t, uint32_t) { anyLeft = true; });
+                expect (! anyLeft);
+            }
+        }
+
+        TestAudioProcessor processor;
+        auto& params = processor.getParameters();
+
+        TestListener listener;
+
+        for (auto* param : params)
+            param->addListener (&listener);
+
+        beginTest ("Changes outside a batch are delivered straight away");
+        {
+            params[0]->setValueNotifyingHost (0.5f);
+            expectEquals (listener.numSingleCallbacks, 1);
+            expectEquals (listener.numBatchCallbacks, 0);
+        }
+
+        beginTest ("Changes in a batch are delivered together when it ends");
+        {
+            listener.reset();
+
+            {
+                const AudioProcessor::ScopedParameterChangeBatch outer (processor);
+
+                params[3]->setValueNotifyingHost (0.1f);
+
+                {
+                    const AudioProcessor::ScopedParameterChangeBatch inner (processor);
+                    params[1]->setValueNotifyingHost (0.2f);
+                    params[3]->setValueNotifyingHost (0.3f);
+                }
+
+                expectEquals (listener.numBatchCallbacks, 0);
+                expectEquals (listener.numSingleCallbacks, 0);
+            }
+
+            expectEquals (listener.numBatchCallbacks, 1);
+            expectEquals (listener.numSingleCallbacks, 0);
+            expect (listener.lastBatch == Array<int> { 1, 3 });
+        }
+
+        beginTest ("Listeners only hear about the parameters they are registered with");
+        {
+            listener.reset();
+            params[2]->removeListener (&listener);
+
+            OtherListener other;
+            params[2]->addListener (&other);
+
+            {
+                const AudioProcessor::ScopedParameterChangeBatch batch (processor);
+                params[0]->setValueNotifyingHost (0.9f);
+                params[2]->setValueNotifyingHost (0.8f);
+            }
+
+            expect (listener.lastBatch == Array<int> { 0 });
+
+            // The default implementation of parameterValuesChanged() calls parameterValueChanged()
+            expectEquals (other.values.size(), 1);
+            expectWithinAbsoluteError (other.values[0], 0.8f, 1.0e-6f);
+
+            params[2]->removeListener (&other);
+        }
+
+        for (auto* param : params)
+            param->removeListener (&listener);
+    }
+
+private:
+    struct TestListener  : public AudioProcessorParameter::Listener
+    {
+        void parameterValueChanged (int, float) override    { ++numSingleCallbacks; }
+        void parameterGestureChanged (int, bool) override   {}
+
+        void parameterValuesChanged (const AudioProcessor&, const Array<int>& indices) override
+        {
+            ++numBatchCallbacks;
+            lastBatch = indices;
+        }
+
+        void reset()
+        {
+            numSingleCallbacks = numBatchCallbacks = 0;
+            lastBatch.clear();
+        }
+
+        int numSingleCallbacks = 0, numBatchCallbacks = 0;
+        Array<int> lastBatch;
+    };
+
+    struct OtherListener  : public AudioProcessorParameter::Listener
+    {
+        void parameterValueChanged (int, float newValue) override   { values.add (newValue); }
+        void parameterGestureChanged (int, bool) override           {}
+
+        Array<float> values;
+    };
+
+    struct TestAudioProcessor   : public AudioProcessor
+    {
+        TestAudioProcessor()
+        {
+            for (int i = 0; i < 4; ++i)
+                addParameter (new AudioParameterFloat (ParameterID { "p" + String (i), 1 }, "p" + String (i), 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override { return "ap"; }
+        void prepareToPlay (double, int) override {}
+        void releaseResources() override {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 0; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram (int) override {}
+        const String getProgramName (int) override { return {}; }
+        void changeProgramName (int, const String&) override {}
+        void getStateInformation (MemoryBlock&) override {}
+        void setStateInformation (const void*, int) override {}
+    };
+};
+
+static ParameterChangeBatchTests parameterChangeBatchTests;
+
+//==============================================================================
+class BusesLayoutSupportTests  : public UnitTest
+{
+public:
+    BusesLayoutSupportTests()
+        : UnitTest ("BusesLayoutSupport", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        const auto mono = AudioChannelSet::mono(), stereo = AudioChannelSet::stereo();
+
+        beginTest ("Declared layouts are the only ones supported");
+        {
+            TestAudioProcessor processor;
+            const auto quad = AudioChannelSet::discreteChannels (4);
+            processor.setSupportedBusesLayouts ({ makeLayout (stereo, stereo), makeLayout (mono, mono) });
+
+            expect (processor.checkBusesLayoutSupported (makeLayout (stereo, stereo)));
+            expect (processor.checkBusesLayoutSupported (makeLayout (mono, mono)));
+            expect (! processor.checkBusesLayoutSupported (makeLayout (quad, quad)));
+            expect (! processor.checkBusesLayoutSupported (makeLayout (AudioChannelSet::discreteChannels (200), stereo)));
+
+            expect (processor.getBus (true, 0)->isNumberOfChannelsSupported (1));
+            expect (! processor.getBus (true, 0)->isNumberOfChannelsSupported (3));
+            expectEquals (processor.getBus (true, 0)->getMaxSupportedChannels (8), 2);
+
+            processor.setSupportedBusesLayouts ({});
+            expect (processor.checkBusesLayoutSupported (makeLayout (quad, quad)));
+        }
+
+        beginTest ("A support cache only asks the processor about each layout once");
+        {
+            TestAudioProcessor processor;
+
+            for (int i = 0; i < 3; ++i)
+                processor.checkBusesLayoutSupported (makeLayout (stereo, stereo));
+
+            expectEquals (processor.numQueries, 3);
+
+            {
+                const AudioProcessor::ScopedBusesLayoutSupportCache outer (processor);
+
+                {
+                    const AudioProcessor::ScopedBusesLayoutSupportCache inner (processor);
+                    expect (processor.checkBusesLayoutSupported (makeLayout (stereo, stereo)));
+                    expect (! processor.checkBusesLayoutSupported (makeLayout (mono, stereo)));
+                }
+
+                expect (processor.checkBusesLayoutSupported (makeLayout (stereo, stereo)));
+                expect (! processor.checkBusesLayoutSupported (makeLayout (mono, stereo)));
+                expectEquals (processor.numQueries, 5);
+            }
+
+            processor.checkBusesLayoutSupported (makeLayout (stereo, stereo));
+            expectEquals (processor.numQueries, 6);
+        }
+
+        beginTest ("Probing the supported channel counts of a bus doesn't repeat queries");
+        {
+            TestAudioProcessor processor;
+            expectEquals (processor.getBus (false, 0)->getMaxSupportedChannels (16), 16);
+
+            std::set<std::pair<AudioChannelSet, AudioChannelSet>> distinct;
+
+            for (const auto& layout : processor.queried)
+                distinct.emplace (layout.getMainInputChannelSet(), layout.getMainOutputChannelSet());
+
+            expectEquals (processor.numQueries, (int) distinct.size());
+        }
+    }
+
+private:
+    static AudioProcessor::BusesLayout makeLayout (const AudioChannelSet& in, const AudioChannelSet& out)
+    {
+        AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (in);
+        layout.outputBuses.add (out);
+        return layout;
+    }
+
+    struct TestAudioProcessor   : public AudioProcessor
+    {
+        TestAudioProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::stereo())
+                                               .withOutput ("Output", AudioChannelSet::stereo()))
+        {}
+
+        using AudioProcessor::setSupportedBusesLayouts;
+
+        bool isBusesLayoutSupported (const BusesLayout& layouts) const override
+        {
+            ++numQueries;
+            queried.add (layouts);
+
+            // Use the declared layouts if there are any, otherwise only accept matching main buses
+            return AudioProcessor::isBusesLayoutSupported (layouts)
+                && layouts.getMainInputChannelSet() == layouts.getMainOutputChannelSet();
+        }
+
+        const String getName() const override { return "ap"; }
+        void prepareToPlay (double, int) override {}
+        void releaseResources() override {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 0; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram (int) override {}
+        const String getProgramName (int) override { return {}; }
+        void changeProgramName (int, const String&) override {}
+        void getStateInformation (MemoryBlock&) override {}
+        void setStateInformation (const void*, int) override {}
+
+        mutable int numQueries = 0;
+        mutable Array<BusesLayout> queried;
+    };
+};
+
+static BusesLayoutSupportTests busesLayoutSupportTests;
+
+#endif
+
 } // namespace juce
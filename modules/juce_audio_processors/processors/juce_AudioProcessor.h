@@ -302,6 +302,87 @@ public:
     virtual void processBlockBypassed (AudioBuffer<double>& buffer,
                                        MidiBuffer& midiMessages);
 
+    //==============================================================================
+    /** Returns true if the processor would rather deal with its MIDI as Universal MIDI Packets.
+
+        Hosts that can supply packets, such as the AudioProcessorGraph and the VST3 and AUv3
+        wrappers, will then call processPacketBlock() instead of processBlock(). This means
+        that MIDI 2.0 data reaches the processor at its full resolution, and the events that
+        pass between two such processors in a graph are never converted to MIDI 1.0.
+
+        If you return true, you still need to implement processBlock() for hosts that only
+        deal in MidiBuffers, which you can do by calling processBlockAsPackets().
+
+        @see processPacketBlock
+    */
+    virtual bool supportsUniversalMidiPackets() const           { return false; }
+
+    /** Renders the next block, with its MIDI held as Universal MIDI Packets.
+
+        This works in the same way as processBlock(): the events buffer holds the incoming
+        packets, and when the method returns it should hold the packets that the processor
+        produces. Packets that were converted from MIDI 1.0 messages use the MIDI 2.0
+        Protocol, but a processor should be prepared to receive packets in either protocol.
+
+        The default implementation converts the packets to a MidiBuffer and calls
+        processBlock(), so this can be called on any processor.
+
+        @see supportsUniversalMidiPackets, processBlockAsPackets
+    */
+    virtual void processPacketBlock (AudioBuffer<float>& buffer,
+                                     universal_midi_packets::EventBuffer& events);
+
+    /** Renders the next block, with its MIDI held as Universal MIDI Packets.
+
+        @see processPacketBlock
+    */
+    virtual void processPacketBlock (AudioBuffer<double>& buffer,
+                                     universal_midi_packets::EventBuffer& events);
+
+    /** Converts a MidiBuffer to packets, calls processPacketBlock(), and converts the
+        packets that it produces back into the MidiBuffer.
+
+        A processor that overrides processPacketBlock() can call this from processBlock().
+    */
+    void processBlockAsPackets (AudioBuffer<float>& buffer, MidiBuffer& midiMessages);
+
+    /** Converts a MidiBuffer to packets, calls processPacketBlock(), and converts the
+        packets that it produces back into the MidiBuffer.
+    */
+    void processBlockAsPackets (AudioBuffer<double>& buffer, MidiBuffer& midiMessages);
+
+    //==============================================================================
+    /** Returns true if the processor wants to know how its parameters change within each block.
+
+        If you return true, the plug-in wrappers and hosts that support it will fill in an
+        AudioProcessorParameterAutomation object with the points that their host sent for
+        each block, which you can get from getParameterAutomation() in your processBlock()
+        callback. You can then ramp your parameters smoothly, without having to split the
+        block up at each change.
+
+        @see getParameterAutomation
+    */
+    virtual bool supportsSampleAccurateAutomation() const       { return false; }
+
+    /** Returns the sample-accurate changes to the parameters in the block being processed.
+
+        You can ONLY call this from your processBlock() method, and the object that it
+        returns must not be used outside that callback. If the host didn't supply any
+        automation, this will return nullptr, and the parameters just have their current
+        values for the whole block.
+
+        @see supportsSampleAccurateAutomation, AudioProcessorParameterAutomation
+    */
+    const AudioProcessorParameterAutomation* getParameterAutomation() const noexcept   { return parameterAutomation; }
+
+    /** Hosts can call this to supply the automation for the next block.
+
+        The object must stay valid until the processBlock() call that uses it has
+        returned, after which the host should set it back to nullptr. Only processors that
+        return true from supportsSampleAccurateAutomation() will look at it.
+    */
+    void setParameterAutomation (const AudioProcessorParameterAutomation* newAutomation) noexcept   { parameterAutomation = newAutomation; }
+
 
     //==============================================================================
     /**
@@ -662,6 +743,31 @@ public:
     */
     bool checkBusesLayoutSupported (const BusesLayout&) const;
 
+    /** Remembers the answers given by checkBusesLayoutSupported() until it is deleted.
+
+        Create one of these around code that probes many combinations of layouts, such as
+        a plug-in wrapper building the list of channel configurations to report to the
+        host. While it exists, isBusesLayoutSupported() is only called once for each
+        distinct layout, so the processor's supported layouts mustn't change during that
+        time. The remembered answers are discarded when the outermost cache is deleted.
+
+        A cache should only be used on one thread at a time.
+    */
+    class JUCE_API  ScopedBusesLayoutSupportCache
+    {
+    public:
+        /** Starts remembering the layouts that the processor supports. */
+        explicit ScopedBusesLayoutSupportCache (const AudioProcessor&);
+
+        /** Stops remembering layouts if this was the outermost cache. */
+        ~ScopedBusesLayoutSupportCache();
+
+    private:
+        const AudioProcessor& processor;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBusesLayoutSupportCache)
+    };
+
     //==============================================================================
     /** Returns true if the Audio processor supports double precision floating point processing.
         The default implementation will always return false.
@@ -1057,6 +1163,38 @@ public:
     /** Returns a flat list of the parameters in the current tree. */
     const Array<AudioProcessorParameter*>& getParameters() const;
 
+    //==============================================================================
+    /** Holds back the notifications about parameter changes until it is deleted.
+
+        Create one of these around code that changes a lot of parameters at once, such as
+        loading a preset. While it exists, changing a parameter doesn't call its listeners.
+        When the outermost batch is deleted, each AudioProcessorParameter::Listener is told
+        about the parameters it listens to in a single call to parameterValuesChanged(),
+        and each AudioProcessorListener gets an audioProcessorParameterChanged() callback for
+        every parameter that changed. A parameter that changed several times is only
+        reported once, with its final value.
+
+        The time taken to deliver the notifications depends on how many parameters
+        changed, rather than on how many the processor has.
+
+        A batch should only be used on one thread at a time. Creating the first batch after
+        the parameters have been added allocates some memory.
+    */
+    class JUCE_API  ScopedParameterChangeBatch
+    {
+    public:
+        /** Starts a batch of changes to the processor's parameters. */
+        explicit ScopedParameterChangeBatch (AudioProcessor&);
+
+        /** Ends the batch, and delivers the notifications if it was the outermost one. */
+        ~ScopedParameterChangeBatch();
+
+    private:
+        AudioProcessor& processor;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedParameterChangeBatch)
+    };
+
     //==============================================================================
     /** Returns the number of preset programs the processor supports.
 
@@ -1088,7 +1226,8 @@ public:
         Note that there's also a getCurrentProgramStateInformation() method, which only
         stores the current program, not the state of the entire processor.
 
-        See also the helper function copyXmlToBinary() for storing settings as XML.
+        See also the helper functions copyValueTreeToBinary() for storing settings as a
+        ValueTree, and copyXmlToBinary() for storing them as XML.
 
         @see getCurrentProgramStateInformation
     */
@@ -1113,7 +1252,8 @@ public:
         Note that there's also a setCurrentProgramStateInformation() method, which tries
         to restore just the current program, not the state of the entire processor.
 
-        See also the helper function getXmlFromBinary() for loading settings as XML.
+        See also the helper functions getValueTreeFromBinary() and getXmlFromBinary() for
+        loading settings that were stored with copyValueTreeToBinary() or copyXmlToBinary().
 
         @see setCurrentProgramStateInformation
     */
@@ -1279,6 +1419,24 @@ public:
     */
     static std::unique_ptr<XmlElement> getXmlFromBinary (const void* data, int sizeInBytes);
 
+    /** Helper function that converts a ValueTree into a binary blob.
+
+        This uses ValueTreeBinaryFormat, which is much quicker to write and read than XML,
+        and writes the tree directly into the block without any intermediate copies.
+        Use getValueTreeFromBinary() to reverse this operation.
+    */
+    static void copyValueTreeToBinary (const ValueTree& tree,
+                                       juce::MemoryBlock& destData,
+                                       ValueTreeBinaryFormat::Compression compression = ValueTreeBinaryFormat::Compression::lz4);
+
+    /** Retrieves a ValueTree that was stored as binary with the copyValueTreeToBinary() method.
+
+        So that states saved by older versions of a plugin can still be loaded, this will
+        also read data that was stored as XML with copyXmlToBinary(). It returns an invalid
+        tree if the data's unsuitable or corrupted.
+    */
+    static ValueTree getValueTreeFromBinary (const void* data, int sizeInBytes);
+
     /** @internal */
     static void JUCE_CALLTYPE setTypeOfNextNewPlugin (WrapperType);
 
@@ -1288,13 +1446,28 @@ protected:
         This callback is called when the host probes the supported bus layouts via
         the checkBusesLayoutSupported method. You should override this callback if you
         would like to limit the layouts that your AudioProcessor supports. The default
-        implementation will accept any layout. JUCE does basic sanity checks so that
-        the provided layouts parameter will have the same number of buses as your
+        implementation will accept any layout, or only the layouts passed to
+        setSupportedBusesLayouts() if you've called it. JUCE does basic sanity checks so
+        that the provided layouts parameter will have the same number of buses as your
         AudioProcessor.
 
-        @see checkBusesLayoutSupported
+        @see checkBusesLayoutSupported, setSupportedBusesLayouts
+    */
+    virtual bool isBusesLayoutSupported (const BusesLayout&) const;
+
+    /** Declares the complete list of layouts that this AudioProcessor supports.
+
+        This is an alternative to overriding isBusesLayoutSupported() for processors that
+        support a fixed set of layouts: the default implementation of isBusesLayoutSupported()
+        will accept exactly the layouts in this list. Each layout should have the same number
+        of buses as your AudioProcessor. Passing an empty list goes back to accepting any
+        layout.
+
+        This is typically called from your constructor.
+
+        @see isBusesLayoutSupported
     */
-    virtual bool isBusesLayoutSupported (const BusesLayout&) const          { return true; }
+    void setSupportedBusesLayouts (const Array<BusesLayout>& supportedLayouts);
 
     /** Callback to check if a certain bus layout can now be applied.
 
@@ -1396,6 +1569,9 @@ protected:
     /** @internal */
     std::atomic<AudioPlayHead*> playHead { nullptr };
 
+    /** @internal */
+    const AudioProcessorParameterAutomation* parameterAutomation = nullptr;
+
     /** @internal */
     void sendParamChangeMessageToListeners (int parameterIndex, float newValue);
 
@@ -1507,6 +1683,14 @@ private:
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
 
+    struct ParameterChangeBatch;
+    std::unique_ptr<ParameterChangeBatch> parameterChangeBatch;
+
+    struct BusesLayoutSupport;
+    mutable std::unique_ptr<BusesLayoutSupport> busesLayoutSupport;
+
+    void sendBatchedParameterChanges();
+
     AudioProcessorParameter* getParamChecked (int) const;
 
   #if JUCE_DEBUG
@@ -1534,6 +1718,23 @@ private:
     template <typename floatType>
     void processBypassed (AudioBuffer<floatType>&, MidiBuffer&);
 
+    struct PacketBridge
+    {
+        MidiBuffer midi;
+        universal_midi_packets::EventBuffer packets;
+        universal_midi_packets::EventBufferConverter converter;
+    };
+
+    std::unique_ptr<PacketBridge> packetBridge;
+
+    PacketBridge& getPacketBridge();
+
+    template <typename FloatType>
+    void processPacketsWithMidiBuffer (AudioBuffer<FloatType>&, universal_midi_packets::EventBuffer&);
+
+    template <typename FloatType>
+    void processMidiBufferWithPackets (AudioBuffer<FloatType>&, MidiBuffer&);
+
     friend class AudioProcessorParameter;
     friend class LADSPAPluginInstance;
 
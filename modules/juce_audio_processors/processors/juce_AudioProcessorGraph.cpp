@@ -318,12 +318,198 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        // The map's own searches are logarithmic, whereas std::equal_range would have to step
+        // through the map's iterators one at a time
+        return { sourcesForDestination.lower_bound ({ destID, 0 }),
+                 sourcesForDestination.upper_bound ({ destID, std::numeric_limits<int>::max() }) };
     }
 
     Map sourcesForDestination;
 };
 
+//==============================================================================
+/*  The order in which the nodes are rendered, with each node after all of its sources,
+    apart from where there's a feedback loop.
+
+    This is kept up to date as the graph is edited, so that each change only has to move the
+    nodes that it affects, rather than the whole graph being sorted every time it's rebuilt.
+*/
+class NodeOrder
+{
+public:
+    using Node   = AudioProcessorGraph::Node;
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    void clear()
+    {
+        order.clear();
+        positions.clear();
+        isValid = true;
+    }
+
+    void addNode (Node* node)
+    {
+        // A node with no connections can go anywhere
+        positions[node->nodeID] = order.size();
+        order.add (node);
+    }
+
+    void removeNode (NodeID nodeID)
+    {
+        const auto iter = positions.find (nodeID);
+
+        if (iter == positions.end())
+            return;
+
+        const auto index = iter->second;
+        positions.erase (iter);
+        order.remove (index);
+
+        for (auto i = index; i < order.size(); ++i)
+            positions[order.getUnchecked (i)->nodeID] = i;
+    }
+
+    // Removing a connection never breaks the order, so only new connections need handling
+    void addConnection (const Connections& c, NodeID source, NodeID destination)
+    {
+        if (! isValid)
+            return;
+
+        const auto destinationPosition = positions[destination];
+        const auto sourcePosition = positions[source];
+
+        if (sourcePosition < destinationPosition)
+            return;
+
+        // Find the source's ancestors that are currently rendered after the destination..
+        std::set<NodeID> ancestors { source };
+        std::vector<NodeID> toVisit { source };
+
+        while (! toVisit.empty())
+        {
+            const auto nodeID = toVisit.back();
+            toVisit.pop_back();
+
+            for (const auto& parent : c.getSourceNodesForDestination (nodeID))
+            {
+                if (parent == destination)
+                {
+                    // this connection makes a feedback loop, so the next rebuild will sort everything
+                    isValid = false;
+                    return;
+                }
+
+                if (positions[parent] > destinationPosition && ancestors.insert (parent).second)
+                    toVisit.push_back (parent);
+            }
+        }
+
+        // ..and move them, in the same order, to just before it
+        Array<Node*> moved, others;
+
+        for (auto i = destinationPosition; i <= sourcePosition; ++i)
+        {
+            auto* node = order.getUnchecked (i);
+            (ancestors.count (node->nodeID) != 0 ? moved : others).add (node);
+        }
+
+        auto i = destinationPosition;
+
+        for (auto* list : { &moved, &others })
+        {
+            for (auto* node : *list)
+            {
+                order.set (i, node);
+                positions[node->nodeID] = i++;
+            }
+        }
+    }
+
+    const Array<Node*>& getOrder (const Nodes& n, const Connections& c)
+    {
+        if (! isValid)
+            isValid = sortFully (n, c);
+
+        jassert (order.size() == n.getNodes().size());
+        return order;
+    }
+
+private:
+    // Returns false if there were any feedback loops
+    bool sortFully (const Nodes& n, const Connections& c)
+    {
+        struct State
+        {
+            std::vector<Node*> destinations;
+            int numPendingSources = 0;
+            bool isPlaced = false;
+        };
+
+        std::map<NodeID, State> states;
+
+        for (auto* node : n.getNodes())
+        {
+            for (const auto& source : c.getSourceNodesForDestination (node->nodeID))
+            {
+                states[source].destinations.push_back (node);
+                ++states[node->nodeID].numPendingSources;
+            }
+        }
+
+        order.clearQuick();
+        positions.clear();
+
+        std::vector<Node*> ready;
+        auto isAcyclic = true;
+        auto nextUnplaced = 0;
+
+        const auto place = [&] (Node* node)
+        {
+            states[node->nodeID].isPlaced = true;
+            positions[node->nodeID] = order.size();
+            order.add (node);
+        };
+
+        for (auto* node : n.getNodes())
+            if (states[node->nodeID].numPendingSources == 0)
+                ready.push_back (node);
+
+        for (size_t next = 0; order.size() < n.getNodes().size();)
+        {
+            if (next == ready.size())
+            {
+                // Everything left is waiting on a feedback loop, so break into it at the first node
+                while (states[n.getNodes().getUnchecked (nextUnplaced)->nodeID].isPlaced)
+                    ++nextUnplaced;
+
+                ready.push_back (n.getNodes().getUnchecked (nextUnplaced));
+                isAcyclic = false;
+            }
+
+            auto* node = ready[next++];
+
+            if (states[node->nodeID].isPlaced)
+                continue;
+
+            place (node);
+
+            for (auto* destination : states[node->nodeID].destinations)
+            {
+                auto& state = states[destination->nodeID];
+
+                if (--state.numPendingSources == 0 && ! state.isPlaced)
+                    ready.push_back (destination);
+            }
+        }
+
+        return isAcyclic;
+    }
+
+    Array<Node*> order;
+    std::map<NodeID, int> positions;
+    bool isValid = true;
+};
+
 //==============================================================================
 /*  Settings used to prepare a node for playback. */
 struct PrepareSettings
@@ -436,6 +622,432 @@ private:
     Optional<PrepareSettings> current, next;
 };
 
+//==============================================================================
+/*  Records how long a node takes to process each block.
+
+    The render threads write each measurement into a ring buffer, and the message thread
+    reads the measurements back when it wants some statistics. A node is only ever
+    rendered by one thread at a time, so there's only a single writer.
+*/
+class NodeTimer
+{
+public:
+    using Statistics = AudioProcessorGraph::NodeTimingStatistics;
+
+    /*  Call from the render threads only. */
+    void record (double milliseconds, double load) noexcept
+    {
+        const auto index = numRecorded.load (std::memory_order_relaxed);
+        auto& slot = slots[(size_t) (index % numSlots)];
+        slot.milliseconds.store ((float) milliseconds, std::memory_order_relaxed);
+        slot.load.store ((float) load, std::memory_order_relaxed);
+        numRecorded.store (index + 1, std::memory_order_release);
+    }
+
+    void reset() noexcept
+    {
+        resetPoint = numRecorded.load (std::memory_order_acquire);
+    }
+
+    Statistics getStatistics() const
+    {
+        // Only look at the newer half of the ring, so that the writer can carry on
+        // for a while without overwriting the values that are being read
+        const auto end = numRecorded.load (std::memory_order_acquire);
+        const auto begin = jmax (resetPoint, end - jmin (end, numSlots / 2));
+
+        Statistics result;
+
+        if (begin == end)
+            return result;
+
+        std::vector<float> times;
+        times.reserve ((size_t) (end - begin));
+        double totalLoad = 0.0;
+
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& slot = slots[(size_t) (i % numSlots)];
+            times.push_back (slot.milliseconds.load (std::memory_order_relaxed));
+            totalLoad += slot.load.load (std::memory_order_relaxed);
+        }
+
+        std::sort (times.begin(), times.end());
+
+        const auto percentile = [&] (double p)
+        {
+            return (double) times[(size_t) ((double) (times.size() - 1) * p + 0.5)];
+        };
+
+        result.numMeasurements = (int) times.size();
+        result.minimum      = times.front();
+        result.maximum      = times.back();
+        result.mean         = std::accumulate (times.begin(), times.end(), 0.0) / (double) times.size();
+        result.median       = percentile (0.5);
+        result.percentile95 = percentile (0.95);
+        result.percentile99 = percentile (0.99);
+        result.meanLoad     = totalLoad / (double) times.size();
+        return result;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<float> milliseconds { 0.0f }, load { 0.0f };
+    };
+
+    static constexpr uint64 numSlots = 1024;
+    std::array<Slot, (size_t) numSlots> slots;
+    std::atomic<uint64> numRecorded { 0 };
+    uint64 resetPoint = 0;
+};
+
+//==============================================================================
+/*  Keeps a NodeTimer for each node while node timing is enabled, so that the
+    measurements survive the graph being rebuilt.
+*/
+class NodeTimers
+{
+public:
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    void update (const Nodes& n)
+    {
+        std::map<NodeID, std::shared_ptr<NodeTimer>> updated;
+
+        for (const auto& node : n.getNodes())
+        {
+            const auto it = timers.find (node->nodeID);
+            updated.emplace (node->nodeID, it != timers.cend() ? it->second : std::make_shared<NodeTimer>());
+        }
+
+        timers = std::move (updated);
+    }
+
+    void clear()
+    {
+        timers.clear();
+    }
+
+    void reset()
+    {
+        for (auto& pair : timers)
+            pair.second->reset();
+    }
+
+    std::shared_ptr<NodeTimer> get (NodeID nodeID) const
+    {
+        const auto it = timers.find (nodeID);
+        return it != timers.cend() ? it->second : nullptr;
+    }
+
+private:
+    std::map<NodeID, std::shared_ptr<NodeTimer>> timers;
+};
+
+//==============================================================================
+/*  A set of real-time worker threads that help the audio thread to render the
+    independent parts of a render sequence at the same time.
+
+    The audio thread publishes a Job, wakes the workers, and then joins in with the
+    work itself. Jobs hand out their tasks using only atomic operations, so nobody
+    has to take a lock while a block is being rendered.
+*/
+class RenderThreadPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        /*  Runs tasks until there are none left to claim. This will be called
+            concurrently from several threads.
+        */
+        virtual void runAvailableTasks() = 0;
+
+        /*  Returns true once every task in the job has finished. */
+        virtual bool isComplete() const = 0;
+    };
+
+    explicit RenderThreadPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this);
+
+            if (! worker->startRealtimeThread ({}))
+                worker->startThread (Thread::Priority::highest);
+
+            workers.push_back (std::move (worker));
+        }
+    }
+
+    ~RenderThreadPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto& worker : workers)
+            worker->stopThread (1000);
+    }
+
+    int getNumThreads() const noexcept  { return (int) workers.size(); }
+
+    /*  Call from the audio thread only. Returns once every task in the job has finished. */
+    void perform (Job& job)
+    {
+        currentJob.store (&job);
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        job.runAvailableTasks();
+
+        while (! job.isComplete())
+            Thread::yield();
+
+        // Workers that are still inside the job must leave before it can be reused
+        currentJob.store (nullptr);
+
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+    }
+
+private:
+    class Worker : public Thread
+    {
+    public:
+        explicit Worker (RenderThreadPool& p) : Thread ("Graph Render Thread"), owner (p) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                ++owner.numActiveWorkers;
+
+                if (auto* job = owner.currentJob.load())
+                    job->runAvailableTasks();
+
+                --owner.numActiveWorkers;
+
+                wait (-1);
+            }
+        }
+
+    private:
+        RenderThreadPool& owner;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderThreadPool)
+};
+
+//==============================================================================
+/*  The MIDI held in one of the render sequence's buffers.
+
+    Processors that support Universal MIDI Packets leave their output as packets, which are
+    only converted when they reach a processor that wants a MidiBuffer. A chain of processors
+    that all use packets never goes through MIDI 1.0, and neither does a chain of processors
+    that all use MidiBuffers.
+*/
+class GraphMidiBuffer
+{
+public:
+    void ensureSize (size_t numBytes)
+    {
+        midi.ensureSize (numBytes);
+        packets.reserve (numBytes / sizeof (uint32_t));
+    }
+
+    bool isEmpty() const noexcept       { return holdsPackets ? packets.isEmpty() : midi.isEmpty(); }
+
+    void clear() noexcept
+    {
+        midi.clear();
+        packets.clear();
+        holdsPackets = false;
+    }
+
+    void setContents (const MidiBuffer& source)
+    {
+        clear();
+        midi.addEvents (source, 0, -1, 0);
+    }
+
+    void setContents (const ump::EventBuffer& source)
+    {
+        clear();
+        packets.addEvents (source, 0, -1, 0);
+        holdsPackets = true;
+    }
+
+    void copyFrom (const GraphMidiBuffer& other)
+    {
+        if (other.holdsPackets)
+            setContents (other.packets);
+        else
+            setContents (other.midi);
+    }
+
+    void addFrom (const GraphMidiBuffer& other, int numSamples, ump::EventBufferConverter& converter)
+    {
+        if (other.isEmpty())
+            return;
+
+        if (isEmpty())
+            holdsPackets = other.holdsPackets;
+
+        if (holdsPackets)
+        {
+            if (other.holdsPackets)
+                packets.addEvents (other.packets, 0, numSamples, 0);
+            else
+                converter.toEventBuffer (other.midi, packets);
+        }
+        else
+        {
+            if (other.holdsPackets)
+                converter.toMidiBuffer (other.packets, midi);
+            else
+                midi.addEvents (other.midi, 0, numSamples, 0);
+        }
+    }
+
+    MidiBuffer& getMidiBuffer (ump::EventBufferConverter& converter)
+    {
+        if (holdsPackets)
+        {
+            midi.clear();
+            converter.toMidiBuffer (packets, midi);
+            packets.clear();
+            holdsPackets = false;
+        }
+
+        return midi;
+    }
+
+    ump::EventBuffer& getPackets (ump::EventBufferConverter& converter)
+    {
+        if (! holdsPackets)
+        {
+            packets.clear();
+            converter.toEventBuffer (midi, packets);
+            midi.clear();
+            holdsPackets = true;
+        }
+
+        return packets;
+    }
+
+private:
+    MidiBuffer midi;
+    ump::EventBuffer packets;
+    bool holdsPackets = false;
+};
+
+//==============================================================================
+/*  The delays that line up the inputs of nodes whose sources have different latencies.
+
+    The render sequence has a delay op wherever more than one source node feeds into a node,
+    even if the sources currently have the same latency, and each op reads its length from
+    one of these points. When a processor's latency changes, the graph works out the new
+    lengths on the message thread and the ops pick them up at the start of their next block,
+    so the sequence only needs rebuilding if a delay outgrows the space that was allocated
+    for it.
+*/
+class LatencyCompensation
+{
+public:
+    using Node   = AudioProcessorGraph::Node;
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    struct DelayPoint
+    {
+        DelayPoint (NodeID src, NodeID dst, int initialDelay, int maxBlockSize)
+            : source (src),
+              destination (dst),
+              capacity (nextPowerOfTwo (jmax (minimumCapacity, 2 * initialDelay) + maxBlockSize)),
+              delay (initialDelay)
+        {
+        }
+
+        const NodeID source, destination;
+        const int capacity;         // the size of each op's delay line, a power of two
+        std::atomic<int> delay;
+    };
+
+    explicit LatencyCompensation (int maxBlockSizeIn)  : maxBlockSize (jmax (1, maxBlockSizeIn)) {}
+
+    /*  Called by the RenderSequenceBuilder for each delay op that it adds. The float and
+        double sequences are built in the same way, so their ops share the same points.
+    */
+    DelayPoint& getDelayPoint (size_t index, NodeID source, NodeID destination, int initialDelay)
+    {
+        if (index == points.size())
+            points.emplace_back (source, destination, initialDelay, maxBlockSize);
+
+        auto& point = points[index];
+        jassert (point.source == source && point.destination == destination);
+        return point;
+    }
+
+    void setOrderedNodes (const Array<Node*>& nodes)
+    {
+        orderedNodes.assign (nodes.begin(), nodes.end());
+    }
+
+    /*  Recalculates the delays from the processors' current latencies, and returns the total
+        latency of the graph, or nullopt if one of the delays no longer fits in its delay line.
+    */
+    Optional<int> update (const Connections& c)
+    {
+        std::map<NodeID, int> inputLatencies, nodeDelays;
+        int totalLatency = 0;
+
+        for (const auto& node : orderedNodes)
+        {
+            int inputLatency = 0;
+
+            for (const auto& source : c.getSourceNodesForDestination (node->nodeID))
+                inputLatency = jmax (inputLatency, nodeDelays[source]);
+
+            inputLatencies[node->nodeID] = inputLatency;
+            nodeDelays[node->nodeID] = inputLatency + node->getProcessor()->getLatencySamples();
+
+            if (node->getProcessor()->getTotalNumOutputChannels() == 0)
+                totalLatency = inputLatency;
+        }
+
+        std::vector<int> newDelays;
+        newDelays.reserve (points.size());
+
+        for (const auto& point : points)
+        {
+            const auto newDelay = inputLatencies[point.destination] - nodeDelays[point.source];
+
+            if (newDelay > point.capacity - maxBlockSize)
+                return nullopt;
+
+            newDelays.push_back (jmax (0, newDelay));
+        }
+
+        for (size_t i = 0; i < points.size(); ++i)
+            points[i].delay.store (newDelays[i], std::memory_order_relaxed);
+
+        return totalLatency;
+    }
+
+private:
+    static constexpr int minimumCapacity = 8192;
+
+    const int maxBlockSize;
+    std::deque<DelayPoint> points;  // a deque, so that the ops' references stay valid as points are added
+    std::vector<Node::Ptr> orderedNodes;
+};
+
 //==============================================================================
 template <typename FloatType>
 struct GraphRenderSequence
@@ -448,13 +1060,27 @@ struct GraphRenderSequence
         int numSamples;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    /*  The MIDI passed into and out of the graph, which is read and written by its MIDI
+        input and output nodes.
+    */
+    struct GraphMidiIO
+    {
+        GraphMidiBuffer input, output;
+    };
+
+    template <typename Events>
+    void perform (AudioBuffer<FloatType>& buffer,
+                  Events& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  RenderThreadPool* threadPool)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
 
         if (numSamples > maxSamples)
         {
+            auto& midiChunk = std::get<Events> (midiChunks);
+
             // Being asked to render more samples than our buffers have, so divide the buffer into chunks
             int chunkStartSample = 0;
             while (chunkStartSample < numSamples)
@@ -467,7 +1093,7 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, threadPool);
 
                 chunkStartSample += maxSamples;
             }
@@ -475,27 +1101,62 @@ struct GraphRenderSequence
             return;
         }
 
+        // The silence flags only cover the samples that were rendered last time, so a longer
+        // block has to start out not knowing which channels are silent
+        if (numSamples > numSamplesKnownToBeSilent)
+            std::fill (silentChannels.get() + 1, silentChannels.get() + renderingBuffer.getNumChannels(), false);
+
+        numSamplesKnownToBeSilent = numSamples;
+
         currentAudioInputBuffer = &buffer;
         currentAudioOutputBuffer.setSize (jmax (1, buffer.getNumChannels()), numSamples);
         currentAudioOutputBuffer.clear();
-        currentMidiInputBuffer = &midiMessages;
-        currentMidiOutputBuffer.clear();
+        midiIO.input.setContents (midiMessages);
+        midiIO.output.clear();
 
         {
+            JUCE_TRACE_ZONE ("AudioProcessorGraph::render");
             const Context context { audioPlayHead, numSamples };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (threadPool != nullptr && threadPool->getNumThreads() > 0 && schedule.hasParallelism())
+            {
+                schedule.start (context);
+                threadPool->perform (schedule);
+            }
+            else
+            {
+                for (const auto& op : renderOps)
+                    op->process (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
             buffer.copyFrom (i, 0, currentAudioOutputBuffer, i, 0, numSamples);
 
         midiMessages.clear();
-        midiMessages.addEvents (currentMidiOutputBuffer, 0, buffer.getNumSamples(), 0);
+
+        if constexpr (std::is_same_v<Events, MidiBuffer>)
+            midiMessages.addEvents (midiIO.output.getMidiBuffer (midiOutputConverter), 0, numSamples, 0);
+        else
+            midiMessages.addEvents (midiIO.output.getPackets (midiOutputConverter), 0, numSamples, 0);
+
         currentAudioInputBuffer = nullptr;
     }
 
+    void attachNodeTimers (const NodeTimers& timers)
+    {
+        for (const auto& op : renderOps)
+            if (auto* processOp = dynamic_cast<ProcessOp*> (op.get()))
+                processOp->timer = timers.get (processOp->node->nodeID);
+    }
+
+    void setSilentNodesSkipped (bool shouldBeSkipped)
+    {
+        for (const auto& op : renderOps)
+            if (auto* processOp = dynamic_cast<ProcessOp*> (op.get()))
+                processOp->setSkippedWhenSilent (shouldBeSkipped);
+    }
+
     JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4661)
 
     void addClearChannelOp (int index)
@@ -504,21 +1165,27 @@ struct GraphRenderSequence
         {
             explicit ClearOp (int indexIn) : index (indexIn) {}
 
-            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            void prepare (FloatType* const* renderBuffer, bool* silence, GraphMidiBuffer*, GraphMidiIO&) override
             {
                 channelBuffer = renderBuffer[index];
+                isSilent = silence + index;
             }
 
             void process (const Context& c) override
             {
+                if (*isSilent)
+                    return;
+
                 FloatVectorOperations::clear (channelBuffer, c.numSamples);
+                *isSilent = true;
             }
 
             FloatType* channelBuffer = nullptr;
+            bool* isSilent = nullptr;
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { audioResource (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -527,23 +1194,32 @@ struct GraphRenderSequence
         {
             explicit CopyOp (int fromIn, int toIn) : from (fromIn), to (toIn) {}
 
-            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            void prepare (FloatType* const* renderBuffer, bool* silence, GraphMidiBuffer*, GraphMidiIO&) override
             {
                 fromBuffer = renderBuffer[from];
                 toBuffer = renderBuffer[to];
+                fromIsSilent = silence + from;
+                toIsSilent = silence + to;
             }
 
             void process (const Context& c) override
             {
-                FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+                if (! *fromIsSilent)
+                    FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+                else if (! *toIsSilent)
+                    FloatVectorOperations::clear (toBuffer, c.numSamples);
+
+                *toIsSilent = *fromIsSilent;
             }
 
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
+            bool* fromIsSilent = nullptr;
+            bool* toIsSilent = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { audioResource (srcIndex), audioResource (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -552,23 +1228,35 @@ struct GraphRenderSequence
         {
             explicit AddOp (int fromIn, int toIn) : from (fromIn), to (toIn) {}
 
-            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            void prepare (FloatType* const* renderBuffer, bool* silence, GraphMidiBuffer*, GraphMidiIO&) override
             {
                 fromBuffer = renderBuffer[from];
                 toBuffer = renderBuffer[to];
+                fromIsSilent = silence + from;
+                toIsSilent = silence + to;
             }
 
             void process (const Context& c) override
             {
-                FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
+                if (*fromIsSilent)
+                    return;
+
+                if (*toIsSilent)
+                    FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+                else
+                    FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
+
+                *toIsSilent = false;
             }
 
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
+            bool* fromIsSilent = nullptr;
+            bool* toIsSilent = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { audioResource (srcIndex), audioResource (dstIndex) });
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -579,7 +1267,7 @@ struct GraphRenderSequence
         {
             explicit ClearOp (int indexIn) : index (indexIn) {}
 
-            void prepare (FloatType* const*, MidiBuffer* buffers) override
+            void prepare (FloatType* const*, bool*, GraphMidiBuffer* buffers, GraphMidiIO&) override
             {
                 channelBuffer = buffers + index;
             }
@@ -589,11 +1277,11 @@ struct GraphRenderSequence
                 channelBuffer->clear();
             }
 
-            MidiBuffer* channelBuffer = nullptr;
+            GraphMidiBuffer* channelBuffer = nullptr;
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { midiResource (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -602,7 +1290,7 @@ struct GraphRenderSequence
         {
             explicit CopyOp (int fromIn, int toIn) : from (fromIn), to (toIn) {}
 
-            void prepare (FloatType* const*, MidiBuffer* buffers) override
+            void prepare (FloatType* const*, bool*, GraphMidiBuffer* buffers, GraphMidiIO&) override
             {
                 fromBuffer = buffers + from;
                 toBuffer = buffers + to;
@@ -610,15 +1298,15 @@ struct GraphRenderSequence
 
             void process (const Context&) override
             {
-                *toBuffer = *fromBuffer;
+                toBuffer->copyFrom (*fromBuffer);
             }
 
-            MidiBuffer* fromBuffer = nullptr;
-            MidiBuffer* toBuffer = nullptr;
+            GraphMidiBuffer* fromBuffer = nullptr;
+            GraphMidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { midiResource (srcIndex), midiResource (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -627,7 +1315,7 @@ struct GraphRenderSequence
         {
             explicit AddOp (int fromIn, int toIn) : from (fromIn), to (toIn) {}
 
-            void prepare (FloatType* const*, MidiBuffer* buffers) override
+            void prepare (FloatType* const*, bool*, GraphMidiBuffer* buffers, GraphMidiIO&) override
             {
                 fromBuffer = buffers + from;
                 toBuffer = buffers + to;
@@ -635,54 +1323,107 @@ struct GraphRenderSequence
 
             void process (const Context& c) override
             {
-                toBuffer->addEvents (*fromBuffer, 0, c.numSamples, 0);
+                toBuffer->addFrom (*fromBuffer, c.numSamples, converter);
             }
 
-            MidiBuffer* fromBuffer = nullptr;
-            MidiBuffer* toBuffer = nullptr;
+            GraphMidiBuffer* fromBuffer = nullptr;
+            GraphMidiBuffer* toBuffer = nullptr;
+            ump::EventBufferConverter converter;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { midiResource (srcIndex), midiResource (dstIndex) });
     }
 
-    void addDelayChannelOp (int chan, int delaySize)
+    void addDelayChannelOp (int chan, LatencyCompensation::DelayPoint& point)
     {
         struct DelayChannelOp : public RenderOp
         {
-            DelayChannelOp (int chan, int delaySize)
-                : buffer ((size_t) (delaySize + 1), (FloatType) 0),
+            DelayChannelOp (int chan, LatencyCompensation::DelayPoint& p)
+                : delayPoint (p),
+                  buffer ((size_t) p.capacity, (FloatType) 0),
                   channel (chan),
-                  writeIndex (delaySize)
+                  mask (p.capacity - 1),
+                  currentDelay (p.delay.load (std::memory_order_relaxed))
             {
             }
 
-            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            void prepare (FloatType* const* renderBuffer, bool* silence, GraphMidiBuffer*, GraphMidiIO&) override
             {
                 channelBuffer = renderBuffer[channel];
+                isSilent = silence + channel;
             }
 
             void process (const Context& c) override
             {
-                auto* data = channelBuffer;
+                const auto numSamples = c.numSamples;
+                const auto newDelay = delayPoint.delay.load (std::memory_order_relaxed);
+
+                // Once the whole delay line has filled up with silence, there's nothing to do
+                if (*isSilent && numSilentSamples == (int) buffer.size())
+                {
+                    currentDelay = newDelay;
+                    return;
+                }
 
-                for (int i = c.numSamples; --i >= 0;)
+                numSilentSamples = *isSilent ? jmin (numSilentSamples + numSamples, (int) buffer.size()) : 0;
+
+                // The output is silent if it only comes from the silent part of the input
+                const auto outputIsSilent = numSilentSamples >= jmax (currentDelay, newDelay) + numSamples;
+
+                // The delay line always keeps a history of the input, so that the delay can
+                // be lengthened without having to wait for it to fill up
+                copyIntoDelayLine (channelBuffer, writeIndex, numSamples);
+
+                if (newDelay != currentDelay)
                 {
-                    buffer[(size_t) writeIndex] = *data;
-                    *data++ = buffer[(size_t) readIndex];
+                    // crossfade from the old delay to the new one, to avoid a click
+                    const auto oldStart = writeIndex - currentDelay;
+                    const auto newStart = writeIndex - newDelay;
+                    const auto step = (FloatType) 1 / (FloatType) jmax (1, numSamples);
+
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        const auto oldSample = buffer[(size_t) ((oldStart + i) & mask)];
+                        const auto newSample = buffer[(size_t) ((newStart + i) & mask)];
+                        channelBuffer[i] = oldSample + (newSample - oldSample) * step * (FloatType) (i + 1);
+                    }
 
-                    if (++readIndex  >= (int) buffer.size()) readIndex = 0;
-                    if (++writeIndex >= (int) buffer.size()) writeIndex = 0;
+                    currentDelay = newDelay;
                 }
+                else if (currentDelay > 0)
+                {
+                    copyFromDelayLine (channelBuffer, writeIndex - currentDelay, numSamples);
+                }
+
+                writeIndex = (writeIndex + numSamples) & mask;
+                *isSilent = outputIsSilent;
             }
 
+            void copyIntoDelayLine (const FloatType* source, int start, int num)
+            {
+                const auto first = jmin (num, (int) buffer.size() - start);
+                FloatVectorOperations::copy (buffer.data() + start, source, first);
+                FloatVectorOperations::copy (buffer.data(), source + first, num - first);
+            }
+
+            void copyFromDelayLine (FloatType* dest, int start, int num) const
+            {
+                start &= mask;
+                const auto first = jmin (num, (int) buffer.size() - start);
+                FloatVectorOperations::copy (dest, buffer.data() + start, first);
+                FloatVectorOperations::copy (dest + first, buffer.data(), num - first);
+            }
+
+            LatencyCompensation::DelayPoint& delayPoint;
             std::vector<FloatType> buffer;
             FloatType* channelBuffer = nullptr;
-            const int channel;
-            int readIndex = 0, writeIndex;
+            bool* isSilent = nullptr;
+            const int channel, mask;
+            int currentDelay, writeIndex = 0, numSilentSamples = 0;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        addOp (std::make_unique<DelayChannelOp> (chan, point), { audioResource (chan) });
     }
 
     void addProcessOp (const Node::Ptr& node,
@@ -690,51 +1431,92 @@ struct GraphRenderSequence
                        int totalNumChans,
                        int midiBuffer)
     {
-        renderOps.push_back (std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer));
+        std::vector<int> resources { midiResource (midiBuffer) };
+
+        // The read-only empty buffer may be shared by any number of process ops, because
+        // processors should never write to channels that are only inputs
+        for (auto index : audioChannelsUsed)
+            if (index != readOnlyEmptyBufferIndex)
+                resources.push_back (audioResource (index));
+
+        // IO processors all read from or write to the graph's own input and output buffers
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()) != nullptr)
+            resources.push_back (graphIOResource);
+
+        addOp (std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer), std::move (resources));
     }
 
     void prepareBuffers (int blockSize)
     {
-        renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
+        // Each channel starts on its own cache line, so a node's channels never share a line
+        // with another node's, and the vector operations on them always start out aligned
+        constexpr auto samplesPerLine = (size_t) cacheLineSize / sizeof (FloatType);
+        const auto channelSize = ((size_t) blockSize + samplesPerLine - 1) / samplesPerLine * samplesPerLine;
+        const auto numChannels = (size_t) numBuffersNeeded + 1;
+
+        renderingData.malloc (numChannels * channelSize + samplesPerLine);
+        renderingChannels.resize (numChannels);
+
+        for (size_t i = 0; i < numChannels; ++i)
+            renderingChannels[i] = snapPointerToAlignment (renderingData.get(), cacheLineSize) + i * channelSize;
+
+        renderingBuffer = AudioBuffer<FloatType> (renderingChannels.data(), (int) numChannels, blockSize);
         renderingBuffer.clear();
+
+        silentChannels.calloc (numChannels);
+        std::fill (silentChannels.get(), silentChannels.get() + numChannels, true);
+        numSamplesKnownToBeSilent = blockSize;
         currentAudioOutputBuffer.setSize (numBuffersNeeded + 1, blockSize);
         currentAudioOutputBuffer.clear();
 
         currentAudioInputBuffer = nullptr;
-        currentMidiInputBuffer = nullptr;
-        currentMidiOutputBuffer.clear();
 
-        midiBuffers.clearQuick();
-        midiBuffers.resize (numMidiBuffersNeeded);
+        midiBuffers.clear();
+        midiBuffers.resize ((size_t) numMidiBuffersNeeded);
 
         const int defaultMIDIBufferSize = 512;
 
-        midiChunk.ensureSize (defaultMIDIBufferSize);
+        std::get<MidiBuffer> (midiChunks).ensureSize (defaultMIDIBufferSize);
+        std::get<ump::EventBuffer> (midiChunks).reserve (defaultMIDIBufferSize / sizeof (uint32_t));
+        midiIO.input.ensureSize (defaultMIDIBufferSize);
+        midiIO.output.ensureSize (defaultMIDIBufferSize);
 
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
 
         for (const auto& op : renderOps)
-            op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
+            op->prepare (renderingBuffer.getArrayOfWritePointers(), silentChannels.get(), midiBuffers.data(), midiIO);
+
+        schedule.build (renderOps, opResources);
     }
 
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
 
+    static constexpr int cacheLineSize = 64;
+
+    HeapBlock<FloatType> renderingData;
+    std::vector<FloatType*> renderingChannels;
+    HeapBlock<bool> silentChannels;
+    int numSamplesKnownToBeSilent = 0;
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
     AudioBuffer<FloatType>* currentAudioInputBuffer = nullptr;
 
-    MidiBuffer* currentMidiInputBuffer = nullptr;
-    MidiBuffer currentMidiOutputBuffer;
+    GraphMidiIO midiIO;
+    ump::EventBufferConverter midiOutputConverter;
 
-    Array<MidiBuffer> midiBuffers;
-    MidiBuffer midiChunk;
+    std::vector<GraphMidiBuffer> midiBuffers;
+    std::tuple<MidiBuffer, ump::EventBuffer> midiChunks;
 
 private:
     //==============================================================================
     struct RenderOp
     {
         virtual ~RenderOp() = default;
-        virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
+        /*  The silence flags say whether each of the channels is known to hold nothing but
+            zeros, which lets the ops skip work. A flag that's false is always safe, but one
+            that's true must never be set for a channel that might hold anything else.
+        */
+        virtual void prepare (FloatType* const*, bool*, GraphMidiBuffer*, GraphMidiIO&) = 0;
         virtual void process (const Context&) = 0;
     };
 
@@ -748,22 +1530,51 @@ private:
               processor (*n->getProcessor()),
               audioChannelsToUse (audioChannelsUsed),
               audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
-              midiBufferToUse (midiBufferIndex)
+              midiBufferToUse (midiBufferIndex),
+              usesPackets (processor.supportsUniversalMidiPackets())
         {
             while (audioChannelsToUse.size() < (int) audioChannels.size())
                 audioChannelsToUse.add (0);
+
+            if (auto* io = dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (&processor))
+                ioType = io->getType();
         }
 
-        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) override
+        void prepare (FloatType* const* renderBuffer, bool* silence, GraphMidiBuffer* buffers, GraphMidiIO& io) override
         {
             for (size_t i = 0; i < audioChannels.size(); ++i)
                 audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
 
+            silentChannels = silence;
             midiBuffer = buffers + midiBufferToUse;
+            midiIO = &io;
+        }
+
+        /*  Lets the node be skipped once its inputs have been silent for longer than its
+            latency and tail. Nodes without audio inputs can make a sound from nothing, so
+            they're never skipped, and neither are the graph's own IO nodes or nested graphs,
+            which don't report the tails of the nodes inside them.
+        */
+        void setSkippedWhenSilent (bool shouldBeSkipped)
+        {
+            const auto tail = processor.getTailLengthSeconds() * processor.getSampleRate();
+
+            skippedWhenSilent = shouldBeSkipped
+                             && ioType < 0
+                             && processor.getTotalNumInputChannels() > 0
+                             && dynamic_cast<AudioProcessorGraph*> (&processor) == nullptr
+                             && std::isfinite (tail);
+
+            tailSamples = skippedWhenSilent ? (int) jlimit (0.0, (double) (std::numeric_limits<int>::max() / 2), std::ceil (tail)) : 0;
+            numSilentSamples = 0;
         }
 
         void process (const Context& c) override
         {
+            if (skippedWhenSilent && skipIfSilent (c.numSamples))
+                return;
+
+            JUCE_TRACE_ZONE_WITH_ID ("AudioProcessorGraph::processNode", node->nodeID.uid);
             processor.setPlayHead (c.audioPlayHead);
 
             auto numAudioChannels = [this]
@@ -779,60 +1590,284 @@ private:
 
             const ScopedLock lock (processor.getCallbackLock());
 
+            // There's no telling what the processor will write into its channels
+            setChannelsSilent (processor.isSuspended());
+
             if (processor.isSuspended())
+            {
                 buffer.clear();
+            }
+            else if (timer != nullptr)
+            {
+                const auto startTicks = Time::getHighResolutionTicks();
+                callProcess (buffer, *midiBuffer);
+                const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+                const auto sampleRate = processor.getSampleRate();
+
+                timer->record (seconds * 1000.0,
+                               sampleRate > 0.0 ? seconds * sampleRate / (double) jmax (1, c.numSamples) : 0.0);
+            }
             else
+            {
                 callProcess (buffer, *midiBuffer);
+            }
+
+            // Silence that comes into the graph is only found by looking for it
+            if (ioType == AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode)
+            {
+                for (size_t i = 0; i < audioChannels.size(); ++i)
+                {
+                    const auto index = audioChannelsToUse.getUnchecked ((int) i);
+
+                    if (index != readOnlyEmptyBufferIndex)
+                        silentChannels[index] = FloatVectorOperations::findMinAndMax (audioChannels[i], c.numSamples) == Range<FloatType>();
+                }
+            }
         }
 
-        void callProcess (AudioBuffer<float>& buffer, MidiBuffer& midi)
+        void callProcess (AudioBuffer<float>& buffer, GraphMidiBuffer& midi)
         {
             if (processor.isUsingDoublePrecision())
             {
                 tempBufferDouble.makeCopyOf (buffer, true);
-                process (*node, tempBufferDouble, midi);
+                process (tempBufferDouble, midi);
                 buffer.makeCopyOf (tempBufferDouble, true);
             }
             else
             {
-                process (*node, buffer, midi);
+                process (buffer, midi);
             }
         }
 
-        void callProcess (AudioBuffer<double>& buffer, MidiBuffer& midi)
+        void callProcess (AudioBuffer<double>& buffer, GraphMidiBuffer& midi)
         {
             if (processor.isUsingDoublePrecision())
             {
-                process (*node, buffer, midi);
+                process (buffer, midi);
             }
             else
             {
                 tempBufferFloat.makeCopyOf (buffer, true);
-                process (*node, tempBufferFloat, midi);
+                process (tempBufferFloat, midi);
                 buffer.makeCopyOf (tempBufferFloat, true);
             }
         }
 
+        bool skipIfSilent (int numSamples)
+        {
+            const auto inputsAreSilent = (! processor.acceptsMidi() || midiBuffer->isEmpty())
+                && std::all_of (audioChannelsToUse.begin(),
+                                audioChannelsToUse.begin() + jmin (audioChannelsToUse.size(), processor.getTotalNumInputChannels()),
+                                [this] (int index) { return silentChannels[index]; });
+
+            if (! inputsAreSilent)
+            {
+                numSilentSamples = 0;
+                return false;
+            }
+
+            const auto shouldSkip = numSilentSamples >= tailSamples + processor.getLatencySamples();
+            numSilentSamples = jmin (numSilentSamples + numSamples, std::numeric_limits<int>::max() / 2);
+
+            if (shouldSkip)
+            {
+                // The inputs are silent already, so it's only the extra outputs that need clearing
+                for (size_t i = 0; i < audioChannels.size(); ++i)
+                {
+                    if (! silentChannels[audioChannelsToUse.getUnchecked ((int) i)])
+                    {
+                        FloatVectorOperations::clear (audioChannels[i], numSamples);
+                        silentChannels[audioChannelsToUse.getUnchecked ((int) i)] = true;
+                    }
+                }
+            }
+
+            return shouldSkip;
+        }
+
+        void setChannelsSilent (bool areSilent)
+        {
+            for (auto index : audioChannelsToUse)
+                if (index != readOnlyEmptyBufferIndex)
+                    silentChannels[index] = areSilent;
+        }
+
         template <typename Value>
-        static void process (const Node& node, AudioBuffer<Value>& audio, MidiBuffer& midi)
+        void process (AudioBuffer<Value>& audio, GraphMidiBuffer& midi)
         {
-            if (node.isBypassed() && node.getProcessor()->getBypassParameter() == nullptr)
-                node.getProcessor()->processBlockBypassed (audio, midi);
+            // The graph's MIDI nodes pass on the events in whichever form they arrive
+            if (ioType == AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode)
+                midi.addFrom (midiIO->input, audio.getNumSamples(), converter);
+            else if (ioType == AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode)
+                midiIO->output.addFrom (midi, audio.getNumSamples(), converter);
+            else if (node->isBypassed() && processor.getBypassParameter() == nullptr)
+                processor.processBlockBypassed (audio, midi.getMidiBuffer (converter));
+            else if (usesPackets)
+                processor.processPacketBlock (audio, midi.getPackets (converter));
             else
-                node.getProcessor()->processBlock (audio, midi);
+                processor.processBlock (audio, midi.getMidiBuffer (converter));
         }
 
         const Node::Ptr node;
         AudioProcessor& processor;
-        MidiBuffer* midiBuffer = nullptr;
+        GraphMidiBuffer* midiBuffer = nullptr;
+        GraphMidiIO* midiIO = nullptr;
+        ump::EventBufferConverter converter;
+        std::shared_ptr<NodeTimer> timer;
 
         Array<int> audioChannelsToUse;
         std::vector<FloatType*> audioChannels;
+        bool* silentChannels = nullptr;
         AudioBuffer<float> tempBufferFloat, tempBufferDouble;
         const int midiBufferToUse;
+        const bool usesPackets;
+        int ioType = -1;
+        bool skippedWhenSilent = false;
+        int tailSamples = 0, numSilentSamples = 0;
+    };
+
+    //==============================================================================
+    /*  Works out which render ops can run at the same time, and hands them out to any
+        threads that are helping to render the sequence.
+
+        Each op is given a list of the buffers that it touches. An op depends on the
+        most recent earlier op that touched each of its buffers, so buffers that are
+        reused by the RenderSequenceBuilder are still accessed in the original order.
+    */
+    class ParallelSchedule : public RenderThreadPool::Job
+    {
+    public:
+        void build (const std::vector<std::unique_ptr<RenderOp>>& opsIn,
+                    const std::vector<std::vector<int>>& resources)
+        {
+            ops = &opsIn;
+            const auto numOps = opsIn.size();
+
+            dependents.assign (numOps, {});
+            numDependencies.assign (numOps, 0);
+            pendingDependencies.reset (new std::atomic<int>[numOps]);
+            readyQueue.reset (new std::atomic<int>[numOps]);
+            counters = std::make_unique<Counters>();
+
+            std::map<int, size_t> lastUser;
+            size_t numRoots = 0;
+
+            for (size_t i = 0; i < numOps; ++i)
+            {
+                std::set<size_t> dependencies;
+
+                for (auto resource : resources[i])
+                {
+                    const auto it = lastUser.find (resource);
+
+                    if (it != lastUser.end())
+                        dependencies.insert (it->second);
+
+                    lastUser[resource] = i;
+                }
+
+                for (auto dependency : dependencies)
+                    dependents[dependency].push_back ((int) i);
+
+                numDependencies[i] = (int) dependencies.size();
+
+                if (dependencies.empty())
+                    ++numRoots;
+            }
+
+            parallel = numRoots > 1 || std::any_of (dependents.begin(), dependents.end(), [] (const auto& d) { return d.size() > 1; });
+        }
+
+        bool hasParallelism() const noexcept  { return parallel; }
+
+        void start (const Context& c)
+        {
+            context = &c;
+            const auto numOps = (int) numDependencies.size();
+
+            counters->nextToClaim = 0;
+            counters->nextToPush = 0;
+            counters->numCompleted = 0;
+
+            for (int i = 0; i < numOps; ++i)
+            {
+                pendingDependencies[(size_t) i] = numDependencies[(size_t) i];
+                readyQueue[(size_t) i] = -1;
+            }
+
+            for (int i = 0; i < numOps; ++i)
+                if (numDependencies[(size_t) i] == 0)
+                    push (i);
+        }
+
+        void runAvailableTasks() override
+        {
+            const auto numOps = (int) numDependencies.size();
+
+            for (;;)
+            {
+                const auto slot = counters->nextToClaim++;
+
+                if (slot >= numOps)
+                    return;
+
+                // Every slot is filled eventually, because the ops form a DAG
+                int opIndex;
+
+                while ((opIndex = readyQueue[(size_t) slot].load (std::memory_order_acquire)) < 0)
+                    Thread::yield();
+
+                (*ops)[(size_t) opIndex]->process (*context);
+
+                for (auto dependent : dependents[(size_t) opIndex])
+                    if (--pendingDependencies[(size_t) dependent] == 0)
+                        push (dependent);
+
+                ++counters->numCompleted;
+            }
+        }
+
+        bool isComplete() const override
+        {
+            return counters->numCompleted.load() == (int) numDependencies.size();
+        }
+
+    private:
+        void push (int opIndex)
+        {
+            readyQueue[(size_t) counters->nextToPush++].store (opIndex, std::memory_order_release);
+        }
+
+        const std::vector<std::unique_ptr<RenderOp>>* ops = nullptr;
+        const Context* context = nullptr;
+
+        std::vector<std::vector<int>> dependents;
+        std::vector<int> numDependencies;
+        // Kept on the heap so that the sequence stays movable until it's prepared
+        struct Counters
+        {
+            std::atomic<int> nextToClaim { 0 }, nextToPush { 0 }, numCompleted { 0 };
+        };
+
+        std::unique_ptr<std::atomic<int>[]> pendingDependencies, readyQueue;
+        std::unique_ptr<Counters> counters;
+        bool parallel = false;
     };
 
+    enum { readOnlyEmptyBufferIndex = 0, graphIOResource = -1 };
+
+    static int audioResource (int index) noexcept  { return 2 * index; }
+    static int midiResource  (int index) noexcept  { return 2 * index + 1; }
+
+    void addOp (std::unique_ptr<RenderOp> op, std::vector<int> resources)
+    {
+        renderOps.push_back (std::move (op));
+        opResources.push_back (std::move (resources));
+    }
+
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<std::vector<int>> opResources;
+    ParallelSchedule schedule;
 };
 
 //==============================================================================
@@ -847,10 +1882,10 @@ public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
     template <typename RenderSequence>
-    static auto build (const Nodes& n, const Connections& c)
+    static auto build (const Array<Node*>& orderedNodes, const Connections& c, LatencyCompensation& latencyCompensation)
     {
         RenderSequence sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (orderedNodes, c, sequence, latencyCompensation);
 
         struct SequenceAndLatency
         {
@@ -887,11 +1922,21 @@ private:
 
     Array<AssignedBuffer> audioBuffers, midiBuffers;
 
+    struct Use
+    {
+        int step, inputChannel;
+    };
+
+    std::map<NodeAndChannel, std::vector<Use>> usesOfOutputs;
+
     enum { readOnlyEmptyBufferIndex = 0 };
 
     HashMap<uint32, int> delays;
     int totalLatency = 0;
 
+    LatencyCompensation& latencyCompensation;
+    size_t numDelayPoints = 0;
+
     int getNodeDelay (NodeID nodeID) const noexcept
     {
         return delays[nodeID.uid];
@@ -906,56 +1951,15 @@ private:
         });
     }
 
-    //==============================================================================
-    void getAllParentsOfNode (const NodeID& child,
-                              std::set<NodeID>& parents,
-                              const std::map<NodeID, std::set<NodeID>>& otherParents,
-                              const Connections& c)
-    {
-        for (const auto& parentNode : c.getSourceNodesForDestination (child))
-        {
-            if (parentNode == child)
-                continue;
-
-            if (parents.insert (parentNode).second)
-            {
-                const auto parentParents = otherParents.find (parentNode);
-
-                if (parentParents != otherParents.end())
-                {
-                    parents.insert (parentParents->second.begin(), parentParents->second.end());
-                    continue;
-                }
-
-                getAllParentsOfNode (parentNode, parents, otherParents, c);
-            }
-        }
-    }
-
-    Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
+    /*  Nodes with more than one source can need their inputs lining up, so they always get
+        delay ops, which the LatencyCompensation can lengthen or shorten later.
+    */
+    template <typename RenderSequence>
+    void addDelayChannelOp (RenderSequence& sequence, int bufIndex, NodeID source, NodeID destination, int maxLatency)
     {
-        Array<Node*> result;
-
-        std::map<NodeID, std::set<NodeID>> nodeParents;
-
-        for (auto& node : n.getNodes())
-        {
-            const auto nodeID = node->nodeID;
-            int insertionIndex = 0;
-
-            for (; insertionIndex < result.size(); ++insertionIndex)
-            {
-                auto& parents = nodeParents[result.getUnchecked (insertionIndex)->nodeID];
-
-                if (parents.find (nodeID) != parents.end())
-                    break;
-            }
-
-            result.insert (insertionIndex, node);
-            getAllParentsOfNode (nodeID, nodeParents[node->nodeID], nodeParents, c);
-        }
-
-        return result;
+        auto& point = latencyCompensation.getDelayPoint (numDelayPoints++, source, destination,
+                                                         maxLatency - getNodeDelay (source));
+        sequence.addDelayChannelOp (bufIndex, point);
     }
 
     //==============================================================================
@@ -965,7 +1969,8 @@ private:
                                         Node& node,
                                         const int inputChan,
                                         const int ourRenderingIndex,
-                                        const int maxLatency)
+                                        const int maxLatency,
+                                        const bool compensateLatency)
     {
         auto& processor = *node.getProcessor();
         auto numOuts = processor.getTotalNumOutputChannels();
@@ -1007,10 +2012,8 @@ private:
                 bufIndex = newFreeBuffer;
             }
 
-            auto nodeDelay = getNodeDelay (src.nodeID);
-
-            if (nodeDelay < maxLatency)
-                sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
+            if (compensateLatency)
+                addDelayChannelOp (sequence, bufIndex, src.nodeID, node.nodeID, maxLatency);
 
             return bufIndex;
         }
@@ -1031,10 +2034,8 @@ private:
                     reusableInputIndex = i;
                     bufIndex = sourceBufIndex;
 
-                    auto nodeDelay = getNodeDelay (src.nodeID);
-
-                    if (nodeDelay < maxLatency)
-                        sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
+                    if (compensateLatency)
+                        addDelayChannelOp (sequence, bufIndex, src.nodeID, node.nodeID, maxLatency);
 
                     break;
                 }
@@ -1059,10 +2060,9 @@ private:
                 sequence.addCopyChannelOp (srcIndex, bufIndex);
 
             reusableInputIndex = 0;
-            auto nodeDelay = getNodeDelay (sources.begin()->nodeID);
 
-            if (nodeDelay < maxLatency)
-                sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
+            if (compensateLatency)
+                addDelayChannelOp (sequence, bufIndex, sources.begin()->nodeID, node.nodeID, maxLatency);
         }
 
         {
@@ -1075,19 +2075,17 @@ private:
 
                     if (srcIndex >= 0)
                     {
-                        auto nodeDelay = getNodeDelay (src.nodeID);
-
-                        if (nodeDelay < maxLatency)
+                        if (compensateLatency)
                         {
                             if (! isBufferNeededLater (c, ourRenderingIndex, inputChan, src))
                             {
-                                sequence.addDelayChannelOp (srcIndex, maxLatency - nodeDelay);
+                                addDelayChannelOp (sequence, srcIndex, src.nodeID, node.nodeID, maxLatency);
                             }
                             else // buffer is reused elsewhere, can't be delayed
                             {
                                 auto bufferToDelay = getFreeBuffer (audioBuffers);
                                 sequence.addCopyChannelOp (srcIndex, bufferToDelay);
-                                sequence.addDelayChannelOp (bufferToDelay, maxLatency - nodeDelay);
+                                addDelayChannelOp (sequence, bufferToDelay, src.nodeID, node.nodeID, maxLatency);
                                 srcIndex = bufferToDelay;
                             }
                         }
@@ -1220,6 +2218,7 @@ private:
 
         Array<int> audioChannelsToUse;
         auto maxLatency = getInputLatencyForNode (c, node.nodeID);
+        const auto compensateLatency = c.getSourceNodesForDestination (node.nodeID).size() > 1;
 
         for (int inputChan = 0; inputChan < numIns; ++inputChan)
         {
@@ -1229,7 +2228,8 @@ private:
                                                          node,
                                                          inputChan,
                                                          ourRenderingIndex,
-                                                         maxLatency);
+                                                         maxLatency,
+                                                         compensateLatency);
             jassert (index >= 0);
 
             audioChannelsToUse.add (index);
@@ -1295,52 +2295,131 @@ private:
                 b.setFree();
     }
 
-    bool isBufferNeededLater (const Connections& c,
+    /*  Returns true if the output is read by any node from the given step onwards, other than
+        by the input channel that's being ignored on the first of those nodes.
+    */
+    bool isBufferNeededLater (const Connections&,
                               int stepIndexToSearchFrom,
                               int inputChannelOfIndexToIgnore,
                               NodeAndChannel output) const
     {
-        while (stepIndexToSearchFrom < orderedNodes.size())
+        const auto iter = usesOfOutputs.find (output);
+
+        if (iter == usesOfOutputs.end())
+            return false;
+
+        const auto& uses = iter->second;
+
+        if (uses.back().step != stepIndexToSearchFrom)
+            return uses.back().step > stepIndexToSearchFrom;
+
+        return std::any_of (uses.rbegin(), uses.rend(), [&] (const auto& use)
         {
-            auto* node = orderedNodes.getUnchecked (stepIndexToSearchFrom);
+            return use.step == stepIndexToSearchFrom && use.inputChannel != inputChannelOfIndexToIgnore;
+        });
+    }
 
-            if (output.isMIDI())
-            {
-                if (inputChannelOfIndexToIgnore != midiChannelIndex
-                    && c.isConnected ({ { output.nodeID, midiChannelIndex },
-                                        { node->nodeID,  midiChannelIndex } }))
-                    return true;
-            }
-            else
+    /*  Returns a render order that keeps each node after the sources that it's given after,
+        but renders it as soon as possible after them, finishing each chain of nodes before
+        starting on the next. That way the buffers between the nodes are freed much sooner,
+        so fewer are needed, and the data in them is more likely to still be in the cache.
+
+        Connections that go backwards in the order that's given are feedback loops, and are
+        left going backwards.
+    */
+    static Array<Node*> shortenBufferLifetimes (const Array<Node*>& order, const Connections& c)
+    {
+        std::map<NodeID, int> positions;
+
+        for (int i = 0; i < order.size(); ++i)
+            positions[order.getUnchecked (i)->nodeID] = i;
+
+        std::vector<std::vector<int>> destinations ((size_t) order.size());
+        std::vector<int> numPendingSources ((size_t) order.size(), 0);
+
+        for (int i = 0; i < order.size(); ++i)
+        {
+            for (const auto& source : c.getSourceNodesForDestination (order.getUnchecked (i)->nodeID))
             {
-                for (int i = 0; i < node->getProcessor()->getTotalNumInputChannels(); ++i)
-                    if (i != inputChannelOfIndexToIgnore && c.isConnected ({ output, { node->nodeID, i } }))
-                        return true;
+                const auto sourcePosition = positions.find (source);
+
+                if (sourcePosition != positions.end() && sourcePosition->second < i)
+                {
+                    destinations[(size_t) sourcePosition->second].push_back (i);
+                    ++numPendingSources[(size_t) i];
+                }
             }
+        }
+
+        // The most recently readied node goes next, and ties go in the order that's given
+        std::vector<int> ready;
+
+        for (int i = order.size(); --i >= 0;)
+            if (numPendingSources[(size_t) i] == 0)
+                ready.push_back (i);
+
+        Array<Node*> result;
+        result.ensureStorageAllocated (order.size());
+
+        while (! ready.empty())
+        {
+            const auto next = ready.back();
+            ready.pop_back();
+            result.add (order.getUnchecked (next));
+
+            const auto& nextDestinations = destinations[(size_t) next];
 
-            inputChannelOfIndexToIgnore = -1;
-            ++stepIndexToSearchFrom;
+            for (auto d = nextDestinations.rbegin(); d != nextDestinations.rend(); ++d)
+                if (--numPendingSources[(size_t) *d] == 0)
+                    ready.push_back (*d);
         }
 
-        return false;
+        jassert (result.size() == order.size());
+        return result;
+    }
+
+    // Lists the steps at which each output is read, so that isBufferNeededLater() doesn't have
+    // to search through all the nodes after the current one
+    void findUsesOfOutputs (const Connections& c)
+    {
+        for (int step = 0; step < orderedNodes.size(); ++step)
+        {
+            const auto nodeID = orderedNodes.getUnchecked (step)->nodeID;
+            const auto numIns = orderedNodes.getUnchecked (step)->getProcessor()->getTotalNumInputChannels();
+
+            for (auto inputChannel = -1; inputChannel < numIns; ++inputChannel)
+            {
+                const auto channel = inputChannel < 0 ? midiChannelIndex : inputChannel;
+
+                for (const auto& source : c.getSourcesForDestination ({ nodeID, channel }))
+                    if (source.isMIDI() == (channel == midiChannelIndex))
+                        usesOfOutputs[source].push_back ({ step, channel });
+            }
+        }
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Array<Node*>& ordered, const Connections& c, RenderSequence& sequence, LatencyCompensation& lc)
+        : orderedNodes (shortenBufferLifetimes (ordered, c)),
+          latencyCompensation (lc)
     {
+        findUsesOfOutputs (c);
+
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (c, sequence, *orderedNodes.getUnchecked (i), i);
-            markAnyUnusedBuffersAsFree (c, audioBuffers, i);
-            markAnyUnusedBuffersAsFree (c, midiBuffers, i);
+
+            // Anything that this node was the last to read can be reused by the next one
+            markAnyUnusedBuffersAsFree (c, audioBuffers, i + 1);
+            markAnyUnusedBuffersAsFree (c, midiBuffers, i + 1);
         }
 
         sequence.numBuffersNeeded = audioBuffers.size();
         sequence.numMidiBuffersNeeded = midiBuffers.size();
+        latencyCompensation.setOrderedNodes (orderedNodes);
     }
 };
 
@@ -1354,23 +2433,34 @@ private:
 class RenderSequence
 {
 public:
+    using Node                  = AudioProcessorGraph::Node;
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s,
-                          RenderSequenceBuilder::build<GraphRenderSequence<float>>  (n, c),
-                          RenderSequenceBuilder::build<GraphRenderSequence<double>> (n, c))
+    RenderSequence (PrepareSettings s,
+                    const Array<Node*>& orderedNodes,
+                    const Connections& c,
+                    std::shared_ptr<RenderThreadPool> pool,
+                    const NodeTimers& timers,
+                    bool skipSilentNodes)
+        : RenderSequence (s, orderedNodes, c, std::make_shared<LatencyCompensation> (s.blockSize))
     {
+        threadPool = std::move (pool);
+        renderSequenceF.attachNodeTimers (timers);
+        renderSequenceD.attachNodeTimers (timers);
+        renderSequenceF.setSilentNodesSkipped (skipSilentNodes);
+        renderSequenceD.setSilentNodesSkipped (skipSilentNodes);
     }
 
-    void process (AudioBuffer<float>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    template <typename Events>
+    void process (AudioBuffer<float>& audio, Events& midi, AudioPlayHead* playHead)
     {
-        renderSequenceF.perform (audio, midi, playHead);
+        renderSequenceF.perform (audio, midi, playHead, threadPool.get());
     }
 
-    void process (AudioBuffer<double>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    template <typename Events>
+    void process (AudioBuffer<double>& audio, Events& midi, AudioPlayHead* playHead)
     {
-        renderSequenceD.perform (audio, midi, playHead);
+        renderSequenceD.perform (audio, midi, playHead, threadPool.get());
     }
 
     void processIO (AudioGraphIOProcessor& io, AudioBuffer<float>& audio, MidiBuffer& midi)
@@ -1385,13 +2475,16 @@ public:
 
     int getLatencySamples() const { return latencySamples; }
     PrepareSettings getSettings() const { return settings; }
+    std::shared_ptr<LatencyCompensation> getLatencyCompensation() const { return latencyCompensation; }
 
 private:
+    // The MIDI nodes are handled by the render sequence, so that they can pass on the events
+    // in whichever form they arrive
     template <typename FloatType, typename SequenceType>
     static void processIOBlock (AudioGraphIOProcessor& io,
                                 SequenceType& sequence,
                                 AudioBuffer<FloatType>& buffer,
-                                MidiBuffer& midiMessages)
+                                MidiBuffer&)
     {
         switch (io.getType())
         {
@@ -1415,22 +2508,26 @@ private:
                 break;
             }
 
-            case AudioGraphIOProcessor::midiOutputNode:
-                sequence.currentMidiOutputBuffer.addEvents (midiMessages, 0, buffer.getNumSamples(), 0);
-                break;
-
-            case AudioGraphIOProcessor::midiInputNode:
-                midiMessages.addEvents (*sequence.currentMidiInputBuffer, 0, buffer.getNumSamples(), 0);
-                break;
-
             default:
                 break;
         }
     }
 
+    RenderSequence (PrepareSettings s,
+                    const Array<Node*>& orderedNodes,
+                    const Connections& c,
+                    const std::shared_ptr<LatencyCompensation>& lc)
+        : RenderSequence (s,
+                          lc,
+                          RenderSequenceBuilder::build<GraphRenderSequence<float>>  (orderedNodes, c, *lc),
+                          RenderSequenceBuilder::build<GraphRenderSequence<double>> (orderedNodes, c, *lc))
+    {
+    }
+
     template <typename Float, typename Double>
-    RenderSequence (PrepareSettings s, Float f, Double d)
+    RenderSequence (PrepareSettings s, std::shared_ptr<LatencyCompensation> lc, Float f, Double d)
         : settings (s),
+          latencyCompensation (std::move (lc)),
           renderSequenceF (std::move (f.sequence)),
           renderSequenceD (std::move (d.sequence)),
           latencySamples (f.latencySamples)
@@ -1442,8 +2539,10 @@ private:
     }
 
     PrepareSettings settings;
+    std::shared_ptr<LatencyCompensation> latencyCompensation;   // declared first, as the ops refer to it
     GraphRenderSequence<float>  renderSequenceF;
     GraphRenderSequence<double> renderSequenceD;
+    std::shared_ptr<RenderThreadPool> threadPool;
     int latencySamples = 0;
 };
 
@@ -1451,15 +2550,22 @@ private:
 /*  Facilitates wait-free render-sequence updates.
 
     Topology updates always happen on the main thread (or synchronised with the main thread).
-    After updating the graph, the 'baked' graph is passed to RenderSequenceExchange::set.
-    At the top of the audio callback, RenderSequenceExchange::updateAudioThreadState will
-    attempt to install the most-recently-baked graph, if there's one waiting.
+    After updating the graph, the 'baked' graph is passed to RenderSequenceExchange::set,
+    which publishes it straight away. Each audio callback holds a ScopedAudioThreadState,
+    which pins the sequence that was current when the block started.
+
+    Sequences that have been replaced are retired rather than deleted, and are reclaimed
+    on the main thread once the audio thread can no longer be using them. That way, any
+    nodes that only a retired sequence still refers to are released on the main thread.
 */
 class RenderSequenceExchange : private Timer
 {
+    using SequencePointer = ReadCopyUpdatePointer<std::unique_ptr<RenderSequence>>;
+
 public:
     RenderSequenceExchange()
     {
+        sequence.setReclaimsOnBackgroundThread (false);
         startTimer (500);
     }
 
@@ -1470,39 +2576,54 @@ public:
 
     void set (std::unique_ptr<RenderSequence>&& next)
     {
-        const SpinLock::ScopedLockType lock (mutex);
-        mainThreadState = std::move (next);
-        isNew = true;
+        sequence.resetDeferred (next != nullptr ? std::make_unique<std::unique_ptr<RenderSequence>> (std::move (next))
+                                                : nullptr);
+        sequence.reclaimRetiredObjects();
     }
 
-    /** Call from the audio thread only. */
-    void updateAudioThreadState()
+    bool isEmpty() const
     {
-        const SpinLock::ScopedTryLockType lock (mutex);
+        const SequencePointer::ScopedReader reader (sequence);
+        return reader == nullptr;
+    }
+
+    /*  Pins the current sequence for the duration of an audio block.
+        Call from the audio thread only.
+    */
+    class ScopedAudioThreadState
+    {
+    public:
+        explicit ScopedAudioThreadState (RenderSequenceExchange& e)
+            : exchange (e), reader (e.sequence)
+        {
+            // The audio thread is the sequence's only reader, so it's allowed to change
+            // the sequence's render state
+            exchange.audioThreadState = reader != nullptr ? reader->get() : nullptr;
+        }
 
-        if (lock.isLocked() && isNew)
+        ~ScopedAudioThreadState()
         {
-            // Swap pointers rather than assigning to avoid calling delete here
-            std::swap (mainThreadState, audioThreadState);
-            isNew = false;
+            exchange.audioThreadState = nullptr;
         }
-    }
 
-    /** Call from the audio thread only. */
-    RenderSequence* getAudioThreadState() const { return audioThreadState.get(); }
+    private:
+        RenderSequenceExchange& exchange;
+        const SequencePointer::ScopedReader reader;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThreadState)
+    };
+
+    /** Call from the audio thread only, while it holds a ScopedAudioThreadState. */
+    RenderSequence* getAudioThreadState() const { return audioThreadState; }
 
 private:
     void timerCallback() override
     {
-        const SpinLock::ScopedLockType lock (mutex);
-
-        if (! isNew)
-            mainThreadState.reset();
+        sequence.reclaimRetiredObjects();
     }
 
-    SpinLock mutex;
-    std::unique_ptr<RenderSequence> mainThreadState, audioThreadState;
-    bool isNew = false;
+    SequencePointer sequence;
+    RenderSequence* audioThreadState = nullptr;
 };
 
 //==============================================================================
@@ -1534,7 +2655,8 @@ bool AudioProcessorGraph::Connection::operator< (const Connection& other) const
 }
 
 //==============================================================================
-class AudioProcessorGraph::Pimpl : public AsyncUpdater
+class AudioProcessorGraph::Pimpl : public AsyncUpdater,
+                                   private AudioProcessorListener
 {
 public:
     explicit Pimpl (AudioProcessorGraph& o) : owner (&o) {}
@@ -1552,8 +2674,12 @@ public:
         if (getNodes().isEmpty())
             return;
 
+        for (auto* node : getNodes())
+            node->getProcessor()->removeListener (this);
+
         nodes = Nodes{};
         connections = Connections{};
+        nodeOrder.clear();
         topologyChanged (updateKind);
     }
 
@@ -1583,6 +2709,8 @@ public:
             lastNodeID = idToUse;
 
         setParentGraph (added->getProcessor());
+        added->getProcessor()->addListener (this);
+        nodeOrder.addNode (added.get());
 
         topologyChanged (updateKind);
         return added;
@@ -1592,6 +2720,13 @@ public:
     {
         connections.disconnectNode (nodeID);
         auto result = nodes.removeNode (nodeID);
+
+        if (result != nullptr)
+        {
+            result->getProcessor()->removeListener (this);
+            nodeOrder.removeNode (nodeID);
+        }
+
         topologyChanged (updateKind);
         return result;
     }
@@ -1632,6 +2767,7 @@ public:
             return false;
 
         jassert (isConnected (c));
+        nodeOrder.addConnection (connections, c.source.nodeID, c.destination.nodeID);
         topologyChanged (updateKind);
         return true;
     }
@@ -1699,39 +2835,101 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
-    template <typename Value>
-    void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    template <typename Value, typename Events>
+    void processBlock (AudioBuffer<Value>& audio, Events& midi, AudioPlayHead* playHead)
     {
-        renderSequenceExchange.updateAudioThreadState();
-
-        if (renderSequenceExchange.getAudioThreadState() == nullptr && MessageManager::getInstance()->isThisTheMessageThread())
-            handleAsyncUpdate();
+        if (renderSequenceExchange.isEmpty() && MessageManager::getInstance()->isThisTheMessageThread())
+            rebuild();
 
         if (owner->isNonRealtime())
-        {
-            while (renderSequenceExchange.getAudioThreadState() == nullptr)
-            {
+            while (renderSequenceExchange.isEmpty())
                 Thread::sleep (1);
-                renderSequenceExchange.updateAudioThreadState();
-            }
-        }
 
+        const RenderSequenceExchange::ScopedAudioThreadState pinnedState (renderSequenceExchange);
         auto* state = renderSequenceExchange.getAudioThreadState();
 
-        // Only process if the graph has the correct blockSize, sampleRate etc.
-        if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
-        {
-            state->process (audio, midi, playHead);
-        }
-        else
-        {
-            audio.clear();
-            midi.clear();
-        }
+        // Only process if the graph has the correct blockSize, sampleRate etc.
+        if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
+        {
+            state->process (audio, midi, playHead);
+        }
+        else
+        {
+            audio.clear();
+            midi.clear();
+        }
+    }
+
+    /*  Call from the audio thread only. */
+    auto* getAudioThreadState() const { return renderSequenceExchange.getAudioThreadState(); }
+
+    void setNumRenderThreads (int numThreads)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumRenderThreads())
+            return;
+
+        // Any sequence that's still in use keeps its own reference to the old pool
+        renderThreadPool = numThreads > 0 ? std::make_shared<RenderThreadPool> (numThreads) : nullptr;
+        topologyChanged (UpdateKind::sync);
+    }
+
+    int getNumRenderThreads() const noexcept
+    {
+        return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+    }
+
+    void setNodeTimingEnabled (bool shouldBeEnabled)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (shouldBeEnabled == nodeTimingEnabled)
+            return;
+
+        nodeTimingEnabled = shouldBeEnabled;
+        nodeTimers.clear();
+        topologyChanged (UpdateKind::sync);
+    }
+
+    bool isNodeTimingEnabled() const noexcept
+    {
+        return nodeTimingEnabled;
+    }
+
+    Optional<NodeTimingStatistics> getNodeTimingStatistics (NodeID nodeID) const
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (const auto timer = nodeTimers.get (nodeID))
+            return timer->getStatistics();
+
+        return nullopt;
+    }
+
+    void resetNodeTimingStatistics()
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+        nodeTimers.reset();
+    }
+
+    void setSilentNodesSkipped (bool shouldBeSkipped)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (shouldBeSkipped == silentNodesSkipped)
+            return;
+
+        silentNodesSkipped = shouldBeSkipped;
+        topologyChanged (UpdateKind::sync);
     }
 
-    /*  Call from the audio thread only. */
-    auto* getAudioThreadState() const { return renderSequenceExchange.getAudioThreadState(); }
+    bool areSilentNodesSkipped() const noexcept
+    {
+        return silentNodesSkipped;
+    }
 
 private:
     void setParentGraph (AudioProcessor* p) const
@@ -1743,6 +2941,7 @@ private:
     void topologyChanged (UpdateKind updateKind)
     {
         owner->sendChangeMessage();
+        rebuildNeeded = true;
 
         if (updateKind == UpdateKind::sync && MessageManager::getInstance()->isThisTheMessageThread())
             handleAsyncUpdate();
@@ -1750,19 +2949,75 @@ private:
             triggerAsyncUpdate();
     }
 
+    // This may be called on any thread, including the audio thread
+    void audioProcessorChanged (AudioProcessor*, const ChangeDetails& details) override
+    {
+        if (! details.latencyChanged)
+            return;
+
+        latencyChanged = true;
+
+        // A change made on the message thread is applied straight away, as long as the
+        // render sequence is up to date and the delays still fit
+        if (! isRebuilding && ! rebuildNeeded && MessageManager::existsAndIsCurrentThread())
+            if (updateLatencyCompensation())
+                return;
+
+        triggerAsyncUpdate();
+    }
+
+    void audioProcessorParameterChanged (AudioProcessor*, int, float) override {}
+
     void handleAsyncUpdate() override
     {
+        if (isRebuilding)
+            triggerAsyncUpdate();
+        else if (rebuildNeeded || ! updateLatencyCompensation())
+            rebuild();
+    }
+
+    // Returns false if the render sequence has to be rebuilt to fit the new delays
+    bool updateLatencyCompensation()
+    {
+        if (! latencyChanged.exchange (false) || latencyCompensation == nullptr)
+            return true;
+
+        if (const auto totalLatency = latencyCompensation->update (connections))
+        {
+            owner->setLatencySamples (*totalLatency);
+            return true;
+        }
+
+        return false;
+    }
+
+    void rebuild()
+    {
+        const ScopedValueSetter<bool> svs (isRebuilding, true);
+        rebuildNeeded = false;
+        latencyChanged = false;
+
         if (const auto newSettings = nodeStates.applySettings (nodes))
         {
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+            if (nodeTimingEnabled)
+                nodeTimers.update (nodes);
+
+            auto sequence = std::make_unique<RenderSequence> (*newSettings,
+                                                              nodeOrder.getOrder (nodes, connections),
+                                                              connections,
+                                                              renderThreadPool,
+                                                              nodeTimers,
+                                                              silentNodesSkipped);
+            latencyCompensation = sequence->getLatencyCompensation();
             owner->setLatencySamples (sequence->getLatencySamples());
             renderSequenceExchange.set (std::move (sequence));
         }
         else
         {
+            latencyCompensation = nullptr;
             renderSequenceExchange.set (nullptr);
         }
     }
@@ -1770,8 +3025,15 @@ private:
     AudioProcessorGraph* owner = nullptr;
     Nodes nodes;
     Connections connections;
+    NodeOrder nodeOrder;
     NodeStates nodeStates;
     RenderSequenceExchange renderSequenceExchange;
+    std::shared_ptr<LatencyCompensation> latencyCompensation;
+    std::atomic<bool> rebuildNeeded { false }, latencyChanged { false };
+    bool isRebuilding = false;
+    std::shared_ptr<RenderThreadPool> renderThreadPool;
+    NodeTimers nodeTimers;
+    bool nodeTimingEnabled = false, silentNodesSkipped = false;
     NodeID lastNodeID;
 };
 
@@ -1784,11 +3046,14 @@ bool AudioProcessorGraph::supportsDoublePrecisionProcessing() const { return tru
 double AudioProcessorGraph::getTailLengthSeconds() const            { return 0; }
 bool AudioProcessorGraph::acceptsMidi() const                       { return true; }
 bool AudioProcessorGraph::producesMidi() const                      { return true; }
+bool AudioProcessorGraph::supportsUniversalMidiPackets() const      { return true; }
 void AudioProcessorGraph::getStateInformation (MemoryBlock&)        {}
 void AudioProcessorGraph::setStateInformation (const void*, int)    {}
 
 void AudioProcessorGraph::processBlock (AudioBuffer<float>&  audio, MidiBuffer& midi)                       { return pimpl->processBlock (audio, midi, getPlayHead()); }
 void AudioProcessorGraph::processBlock (AudioBuffer<double>& audio, MidiBuffer& midi)                       { return pimpl->processBlock (audio, midi, getPlayHead()); }
+void AudioProcessorGraph::processPacketBlock (AudioBuffer<float>&  audio, ump::EventBuffer& events)         { return pimpl->processBlock (audio, events, getPlayHead()); }
+void AudioProcessorGraph::processPacketBlock (AudioBuffer<double>& audio, ump::EventBuffer& events)         { return pimpl->processBlock (audio, events, getPlayHead()); }
 std::vector<AudioProcessorGraph::Connection> AudioProcessorGraph::getConnections() const                    { return pimpl->getConnections(); }
 bool AudioProcessorGraph::addConnection (const Connection& c, UpdateKind updateKind)                        { return pimpl->addConnection (c, updateKind); }
 bool AudioProcessorGraph::removeConnection (const Connection& c, UpdateKind updateKind)                     { return pimpl->removeConnection (c, updateKind); }
@@ -1800,6 +3065,19 @@ bool AudioProcessorGraph::disconnectNode (NodeID nodeID, UpdateKind updateKind)
 void AudioProcessorGraph::releaseResources()                                                                { return pimpl->releaseResources(); }
 bool AudioProcessorGraph::removeIllegalConnections (UpdateKind updateKind)                                  { return pimpl->removeIllegalConnections (updateKind); }
 void AudioProcessorGraph::reset()                                                                           { return pimpl->reset(); }
+void AudioProcessorGraph::setNumRenderThreads (int numThreads)                                              { return pimpl->setNumRenderThreads (numThreads); }
+int AudioProcessorGraph::getNumRenderThreads() const noexcept                                               { return pimpl->getNumRenderThreads(); }
+void AudioProcessorGraph::setNodeTimingEnabled (bool shouldBeEnabled)                                      { return pimpl->setNodeTimingEnabled (shouldBeEnabled); }
+bool AudioProcessorGraph::isNodeTimingEnabled() const noexcept                                              { return pimpl->isNodeTimingEnabled(); }
+void AudioProcessorGraph::resetNodeTimingStatistics()                                                       { return pimpl->resetNodeTimingStatistics(); }
+void AudioProcessorGraph::setSilentNodesSkipped (bool shouldBeSkipped)                                      { return pimpl->setSilentNodesSkipped (shouldBeSkipped); }
+bool AudioProcessorGraph::areSilentNodesSkipped() const noexcept                                            { return pimpl->areSilentNodesSkipped(); }
+
+Optional<AudioProcessorGraph::NodeTimingStatistics> AudioProcessorGraph::getNodeTimingStatistics (NodeID nodeID) const
+{
+    return pimpl->getNodeTimingStatistics (nodeID);
+}
+
 bool AudioProcessorGraph::canConnect (const Connection& c) const                                            { return pimpl->canConnect (c); }
 bool AudioProcessorGraph::isConnected (const Connection& c) const noexcept                                  { return pimpl->isConnected (c); }
 bool AudioProcessorGraph::isConnected (NodeID a, NodeID b) const noexcept                                   { return pimpl->isConnected (a, b); }
@@ -2058,6 +3336,456 @@ public:
                 expect (graph.isAnInputTo (*nodes[nodes.size() - 1], *node));
             }
         }
+
+        beginTest ("rendering with worker threads produces the same output as rendering serially");
+        {
+            const auto render = [this] (int numThreads)
+            {
+                AudioProcessorGraph graph;
+                graph.setNumRenderThreads (numThreads);
+
+                const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+
+                graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+                graph.prepareToPlay (44100.0, 64);
+
+                for (auto i = 0; i < 8; ++i)
+                {
+                    const auto first  = graph.addNode (std::make_unique<GainProcessor> ((float) (i + 1)))->nodeID;
+                    const auto second = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                    {
+                        graph.addConnection ({ { input,  channel }, { first,  channel } });
+                        graph.addConnection ({ { first,  channel }, { second, channel } });
+                        graph.addConnection ({ { second, channel }, { output, channel } });
+                    }
+                }
+
+                AudioBuffer<float> buffer (2, 64);
+                MidiBuffer midi;
+                std::vector<float> result;
+
+                for (auto block = 0; block < 4; ++block)
+                {
+                    for (auto channel = 0; channel < 2; ++channel)
+                        for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+                            buffer.setSample (channel, sample, (float) (block + sample + channel) / 100.0f);
+
+                    graph.processBlock (buffer, midi);
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        result.insert (result.end(), buffer.getReadPointer (channel), buffer.getReadPointer (channel) + buffer.getNumSamples());
+                }
+
+                expect (graph.getNumRenderThreads() == numThreads);
+                return result;
+            };
+
+            const auto serial = render (0);
+
+            expect (std::any_of (serial.begin(), serial.end(), [] (auto x) { return x != 0.0f; }));
+            expect (render (3) == serial);
+        }
+
+        beginTest ("latency changes are compensated without rebuilding the graph");
+        {
+            AudioProcessorGraph graph;
+
+            const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+
+            graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+            graph.prepareToPlay (44100.0, 64);
+
+            const auto latent = graph.addNode (std::make_unique<GainProcessor> (1.0f));
+            const auto direct = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { input,           channel }, { latent->nodeID, channel } });
+                graph.addConnection ({ { input,           channel }, { direct,         channel } });
+                graph.addConnection ({ { latent->nodeID,  channel }, { output,         channel } });
+                graph.addConnection ({ { direct,          channel }, { output,         channel } });
+            }
+
+            const auto renderImpulse = [&graph]
+            {
+                AudioBuffer<float> buffer (2, 64);
+                MidiBuffer midi;
+
+                // lets any crossfade between the old and new delays finish
+                buffer.clear();
+                graph.processBlock (buffer, midi);
+
+                buffer.clear();
+                buffer.setSample (0, 0, 1.0f);
+                buffer.setSample (1, 0, 1.0f);
+                graph.processBlock (buffer, midi);
+                return buffer;
+            };
+
+            expectEquals (renderImpulse().getSample (0, 0), 1.5f);
+
+            // The message loop isn't running, so the change must be applied immediately
+            latent->getProcessor()->setLatencySamples (10);
+            expectEquals (graph.getLatencySamples(), 10);
+
+            const auto delayed = renderImpulse();
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expectEquals (delayed.getSample (channel, 0), 1.0f);
+                expectEquals (delayed.getSample (channel, 10), 0.5f);
+                expectEquals (delayed.getMagnitude (channel, 1, 9), 0.0f);
+            }
+
+            latent->getProcessor()->setLatencySamples (0);
+            expectEquals (graph.getLatencySamples(), 0);
+            expectEquals (renderImpulse().getSample (1, 0), 1.5f);
+        }
+
+        beginTest ("nodes are rendered after their sources whatever order they're connected in");
+        {
+            AudioProcessorGraph graph;
+
+            const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+            const auto first  = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+            const auto second = graph.addNode (std::make_unique<GainProcessor> (4.0f))->nodeID;
+            const auto third  = graph.addNode (std::make_unique<GainProcessor> (0.25f))->nodeID;
+
+            graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+            graph.prepareToPlay (44100.0, 64);
+
+            // Each connection's source is placed after its destination, so every one of
+            // these has to move some nodes
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { third,  channel }, { output, channel } });
+                graph.addConnection ({ { second, channel }, { third,  channel } });
+                graph.addConnection ({ { first,  channel }, { second, channel } });
+                graph.addConnection ({ { input,  channel }, { first,  channel } });
+            }
+
+            const auto render = [&graph]
+            {
+                AudioBuffer<float> buffer (2, 64);
+                MidiBuffer midi;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    FloatVectorOperations::fill (buffer.getWritePointer (channel), 1.0f, buffer.getNumSamples());
+
+                graph.processBlock (buffer, midi);
+                return buffer.getSample (1, 32);
+            };
+
+            expectEquals (render(), 0.5f);
+
+            // A feedback loop means the whole order gets worked out again, both when it's made
+            // and once it's been removed
+            const AudioProcessorGraph::Connection feedback { { third, 0 }, { first, 0 } };
+            expect (graph.addConnection (feedback));
+            expect (graph.removeConnection (feedback));
+
+            expectEquals (render(), 0.5f);
+        }
+
+        beginTest ("chains of nodes are rendered one at a time in cache-aligned buffers");
+        {
+            AudioProcessorGraph graph;
+            std::vector<const AudioProcessor*> order;
+            std::vector<OrderRecordingProcessor*> firsts, seconds;
+
+            const auto input = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+
+            const auto addNodes = [&] (std::vector<OrderRecordingProcessor*>& processors)
+            {
+                std::vector<AudioProcessorGraph::NodeID> ids;
+
+                for (auto i = 0; i < 4; ++i)
+                {
+                    const auto node = graph.addNode (std::make_unique<OrderRecordingProcessor> (order));
+                    processors.push_back (static_cast<OrderRecordingProcessor*> (node->getProcessor()));
+                    ids.push_back (node->nodeID);
+                }
+
+                return ids;
+            };
+
+            // All the first nodes are created before any of the second ones
+            const auto firstIDs  = addNodes (firsts);
+            const auto secondIDs = addNodes (seconds);
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+
+            for (size_t i = 0; i < firstIDs.size(); ++i)
+            {
+                for (auto channel = 0; channel < 2; ++channel)
+                {
+                    graph.addConnection ({ { input,        channel }, { firstIDs[i],  channel } });
+                    graph.addConnection ({ { firstIDs[i],  channel }, { secondIDs[i], channel } });
+                    graph.addConnection ({ { secondIDs[i], channel }, { output,       channel } });
+                }
+            }
+
+            // An odd block size, so that packing the channels end to end would misalign them
+            graph.setPlayConfigDetails (2, 2, 44100.0, 441);
+            graph.prepareToPlay (44100.0, 441);
+
+            AudioBuffer<float> buffer (2, 441);
+            MidiBuffer midi;
+            buffer.clear();
+            graph.processBlock (buffer, midi);
+
+            std::vector<const AudioProcessor*> expectedOrder;
+
+            for (size_t i = 0; i < firsts.size(); ++i)
+            {
+                expectedOrder.push_back (firsts[i]);
+                expectedOrder.push_back (seconds[i]);
+            }
+
+            expect (order == expectedOrder);
+
+            for (auto* processor : firsts)
+                expect (processor->channelsAreAligned);
+
+            for (auto* processor : seconds)
+                expect (processor->channelsAreAligned);
+        }
+
+        beginTest ("silent nodes are skipped once their tails have finished");
+        {
+            AudioProcessorGraph graph;
+            std::vector<const AudioProcessor*> order;
+
+            const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+            const auto dry    = graph.addNode (std::make_unique<OrderRecordingProcessor> (order));
+            const auto tail   = graph.addNode (std::make_unique<OrderRecordingProcessor> (order, 100.5 / 44100.0));
+
+            graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+            graph.prepareToPlay (44100.0, 64);
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { input,        channel }, { dry->nodeID,  channel } });
+                graph.addConnection ({ { dry->nodeID,  channel }, { tail->nodeID, channel } });
+                graph.addConnection ({ { tail->nodeID, channel }, { output,       channel } });
+            }
+
+            expect (! graph.areSilentNodesSkipped());
+            graph.setSilentNodesSkipped (true);
+            expect (graph.areSilentNodesSkipped());
+
+            const auto render = [&] (float level)
+            {
+                AudioBuffer<float> buffer (2, 64);
+                MidiBuffer midi;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    FloatVectorOperations::fill (buffer.getWritePointer (channel), level, buffer.getNumSamples());
+
+                order.clear();
+                graph.processBlock (buffer, midi);
+                return buffer.getSample (0, 63);
+            };
+
+            using Order = std::vector<const AudioProcessor*>;
+
+            expectEquals (render (1.0f), 1.0f);
+            expect (order == Order { dry->getProcessor(), tail->getProcessor() });
+
+            // The node without a tail stops straight away, but the other one carries on
+            // until its 101 samples have been rendered
+            expectEquals (render (0.0f), 0.0f);
+            expect (order == Order { tail->getProcessor() });
+            expectEquals (render (0.0f), 0.0f);
+            expect (order == Order { tail->getProcessor() });
+            expectEquals (render (0.0f), 0.0f);
+            expect (order.empty());
+
+            expectEquals (render (0.5f), 0.5f);
+            expect (order == Order { dry->getProcessor(), tail->getProcessor() });
+
+            graph.setSilentNodesSkipped (false);
+
+            for (auto i = 0; i < 3; ++i)
+            {
+                expectEquals (render (0.0f), 0.0f);
+                expectEquals ((int) order.size(), 2);
+            }
+        }
+
+        beginTest ("editing a large graph only takes a little longer than editing a small one");
+        {
+            const auto timeEdits = [this] (int numChains, int chainLength)
+            {
+                AudioProcessorGraph graph;
+
+                const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+                std::vector<AudioProcessorGraph::NodeID> firstInChain, lastInChain;
+
+                for (auto chain = 0; chain < numChains; ++chain)
+                {
+                    auto previous = input;
+
+                    for (auto i = 0; i < chainLength; ++i)
+                    {
+                        const auto node = graph.addNode (std::make_unique<GainProcessor> (1.0f), {}, AudioProcessorGraph::UpdateKind::async)->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            graph.addConnection ({ { previous, channel }, { node, channel } }, AudioProcessorGraph::UpdateKind::async);
+
+                        if (i == 0)
+                            firstInChain.push_back (node);
+
+                        previous = node;
+                    }
+
+                    lastInChain.push_back (previous);
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        graph.addConnection ({ { previous, channel }, { output, channel } }, AudioProcessorGraph::UpdateKind::async);
+                }
+
+                graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+                graph.prepareToPlay (44100.0, 64);
+
+                // Patch the end of each chain into the start of the next one and back out again,
+                // rebuilding after every edit
+                constexpr auto numEdits = 20;
+                const auto start = Time::getHighResolutionTicks();
+
+                for (auto edit = 0; edit < numEdits; ++edit)
+                {
+                    const auto chain = edit % (numChains - 1);
+                    const AudioProcessorGraph::Connection connection { { lastInChain[(size_t) chain], 0 },
+                                                                       { firstInChain[(size_t) chain + 1], 0 } };
+                    expect (graph.addConnection (connection));
+                    expect (graph.removeConnection (connection));
+                }
+
+                const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+                const auto millisecondsPerEdit = seconds * 1000.0 / (2 * numEdits);
+
+                logMessage ("Graph with " + String (numChains * chainLength) + " nodes: "
+                              + String (millisecondsPerEdit, 2) + " ms per edit");
+
+                return millisecondsPerEdit;
+            };
+
+            const auto small = timeEdits (10, 20);
+            const auto large = timeEdits (100, 20);
+
+            // Ten times as many nodes shouldn't cost anywhere near a hundred times as much
+            expect (large < jmax (1.0, small) * 50.0);
+        }
+
+        beginTest ("node timing statistics are collected while timing is enabled");
+        {
+            AudioProcessorGraph graph;
+            const auto gain = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+
+            graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+            graph.prepareToPlay (44100.0, 64);
+
+            AudioBuffer<float> buffer (2, 64);
+            MidiBuffer midi;
+
+            const auto processBlocks = [&] (int numBlocks)
+            {
+                for (auto block = 0; block < numBlocks; ++block)
+                    graph.processBlock (buffer, midi);
+            };
+
+            processBlocks (4);
+            expect (! graph.isNodeTimingEnabled());
+            expect (! graph.getNodeTimingStatistics (gain).hasValue());
+
+            graph.setNodeTimingEnabled (true);
+            expect (graph.isNodeTimingEnabled());
+            processBlocks (10);
+
+            const auto statistics = graph.getNodeTimingStatistics (gain);
+            expect (statistics.hasValue());
+            expectEquals (statistics->numMeasurements, 10);
+            expect (statistics->minimum <= statistics->median);
+            expect (statistics->median <= statistics->percentile95);
+            expect (statistics->percentile95 <= statistics->maximum);
+            expect (statistics->minimum <= statistics->mean && statistics->mean <= statistics->maximum);
+            expect (! graph.getNodeTimingStatistics (AudioProcessorGraph::NodeID { 1234 }).hasValue());
+
+            graph.resetNodeTimingStatistics();
+            expectEquals (graph.getNodeTimingStatistics (gain)->numMeasurements, 0);
+
+            processBlocks (2000);
+            expectEquals (graph.getNodeTimingStatistics (gain)->numMeasurements, 512);
+
+            graph.setNodeTimingEnabled (false);
+            expect (! graph.getNodeTimingStatistics (gain).hasValue());
+        }
+
+        beginTest ("universal midi packets pass between processors without being converted to MIDI 1.0");
+        {
+            AudioProcessorGraph graph;
+
+            auto generatorProcessor = std::make_unique<PacketProcessor> (true);
+            auto receiverProcessor  = std::make_unique<PacketProcessor> (false);
+            auto midiProcessor      = std::make_unique<MidiRecorder>();
+
+            auto& generator = *generatorProcessor;
+            auto& receiver  = *receiverProcessor;
+            auto& recorder  = *midiProcessor;
+
+            const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode))->nodeID;
+            const auto nodeA  = graph.addNode (std::move (generatorProcessor))->nodeID;
+            const auto nodeB  = graph.addNode (std::move (receiverProcessor))->nodeID;
+            const auto nodeC  = graph.addNode (std::move (midiProcessor))->nodeID;
+
+            expect (graph.addConnection ({ { input, midiChannel }, { nodeA,  midiChannel } }));
+            expect (graph.addConnection ({ { nodeA, midiChannel }, { nodeB,  midiChannel } }));
+            expect (graph.addConnection ({ { nodeB, midiChannel }, { nodeC,  midiChannel } }));
+            expect (graph.addConnection ({ { nodeC, midiChannel }, { output, midiChannel } }));
+
+            graph.setPlayConfigDetails (0, 0, 44100.0, 64);
+            graph.prepareToPlay (44100.0, 64);
+
+            AudioBuffer<float> buffer (0, 64);
+
+            {
+                MidiBuffer midi;
+                midi.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 5);
+                graph.processBlock (buffer, midi);
+
+                expectEquals (generator.received.getNumEvents(), 1);
+                expect (Utils::getMessageType (generator.received.data()[0]) == 0x4);
+
+                // The high-resolution controller would lose its lower bits if it went through MIDI 1.0
+                expectEquals (receiver.received.getNumEvents(), 2);
+                expect (containsFullResolutionController (receiver.received));
+
+                expectEquals (recorder.received.getNumEvents(), 2);
+                expect (recorder.received.findNextSamplePosition (3) != recorder.received.cend());
+                expectEquals ((*recorder.received.findNextSamplePosition (3)).getMessage().getControllerValue(), (int) (PacketProcessor::controllerValue >> 25));
+
+                expectEquals (midi.getNumEvents(), 2);
+                expect ((*midi.cbegin()).getMessage().isController());
+            }
+
+            {
+                ump::EventBuffer events;
+                events.add (ump::Factory::makeControlChangeV2 (0, 0, 1, PacketProcessor::controllerValue), 10);
+                graph.processPacketBlock (buffer, events);
+
+                expectEquals (generator.received.getNumEvents(), 1);
+                expect (containsFullResolutionController (generator.received));
+                expectEquals (events.getNumEvents(), 2);
+            }
+        }
     }
 
 private:
@@ -2110,6 +3838,99 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class GainProcessor  : public BasicProcessor
+    {
+    public:
+        explicit GainProcessor (float gainIn)
+            : BasicProcessor (getStereoProperties(), MidiIn::no, MidiOut::no), gain (gainIn) {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override { buffer.applyGain (gain); }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        float gain;
+    };
+
+    class OrderRecordingProcessor  : public BasicProcessor
+    {
+    public:
+        explicit OrderRecordingProcessor (std::vector<const AudioProcessor*>& orderIn, double tailSecondsIn = 0.0)
+            : BasicProcessor (getStereoProperties(), MidiIn::no, MidiOut::no), order (orderIn), tailSeconds (tailSecondsIn) {}
+
+        double getTailLengthSeconds() const override { return tailSeconds; }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            order.push_back (this);
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                channelsAreAligned &= (reinterpret_cast<pointer_sized_uint> (buffer.getReadPointer (channel)) % 64) == 0;
+        }
+
+        using AudioProcessor::processBlock;
+
+        bool channelsAreAligned = true;
+
+    private:
+        std::vector<const AudioProcessor*>& order;
+        const double tailSeconds;
+    };
+
+    using Utils = ump::Utils;
+
+    static bool containsFullResolutionController (const ump::EventBuffer& events)
+    {
+        return std::any_of (events.begin(), events.end(), [] (const ump::EventBuffer::Event& event)
+        {
+            return Utils::getMessageType (event.packet[0]) == 0x4
+                && Utils::getStatus (event.packet[0]) == 0xb
+                && event.packet[1] == PacketProcessor::controllerValue;
+        });
+    }
+
+    class PacketProcessor  : public BasicProcessor
+    {
+    public:
+        static constexpr uint32_t controllerValue = 0x12345678;
+
+        explicit PacketProcessor (bool shouldGenerate)
+            : BasicProcessor (BusesProperties(), MidiIn::yes, MidiOut::yes), generate (shouldGenerate) {}
+
+        bool supportsUniversalMidiPackets() const override  { return true; }
+
+        void processPacketBlock (AudioBuffer<float>&, ump::EventBuffer& events) override
+        {
+            received = events;
+
+            if (generate)
+                events.add (ump::Factory::makeControlChangeV2 (0, 0, 1, controllerValue), 3);
+        }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override  { processBlockAsPackets (buffer, midi); }
+
+        using AudioProcessor::processBlock;
+        using AudioProcessor::processPacketBlock;
+
+        ump::EventBuffer received;
+
+    private:
+        bool generate;
+    };
+
+    class MidiRecorder  : public BasicProcessor
+    {
+    public:
+        MidiRecorder()
+            : BasicProcessor (BusesProperties(), MidiIn::yes, MidiOut::yes) {}
+
+        void processBlock (AudioBuffer<float>&, MidiBuffer& midi) override  { received = midi; }
+
+        using AudioProcessor::processBlock;
+
+        MidiBuffer received;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
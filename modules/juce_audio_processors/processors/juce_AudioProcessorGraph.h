@@ -1,433 +1,524 @@
-/*
-  ==============================================================================
-
-   This file is part of the JUCE library.
-   Copyright (c) 2022 - Raw Material Software Limited
-
-   JUCE is an open source library subject to commercial or open-source
-   licensing.
-
-   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
-   Agreement and JUCE Privacy Policy.
-
-   End User License Agreement: www.juce.com/juce-7-licence
-   Privacy Policy: www.juce.com/juce-privacy-policy
-
-   Or: You may also use this code under the terms of the GPL v3 (see
-   www.gnu.org/licenses).
-
-   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
-   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
-   DISCLAIMED.
-
-  ==============================================================================
-*/
-
-namespace juce
-{
-
-//==============================================================================
-/**
-    A type of AudioProcessor which plays back a graph of other AudioProcessors.
-
-    Use one of these objects if you want to wire-up a set of AudioProcessors
-    and play back the result.
-
-    Processors can be added to the graph as "nodes" using addNode(), and once
-    added, you can connect any of their input or output channels to other
-    nodes using addConnection().
-
-    To play back a graph through an audio device, you might want to use an
-    AudioProcessorPlayer object.
-
-    @tags{Audio}
-*/
-class JUCE_API  AudioProcessorGraph   : public AudioProcessor,
-                                        public ChangeBroadcaster
-{
-public:
-    //==============================================================================
-    /** Creates an empty graph. */
-    AudioProcessorGraph();
-
-    /** Destructor.
-        Any processor objects that have been added to the graph will also be deleted.
-    */
-    ~AudioProcessorGraph() override;
-
-    /** Each node in the graph has a UID of this type. */
-    struct NodeID
-    {
-        NodeID() {}
-        explicit NodeID (uint32 i) : uid (i) {}
-
-        uint32 uid = 0;
-
-        bool operator== (const NodeID& other) const noexcept    { return uid == other.uid; }
-        bool operator!= (const NodeID& other) const noexcept    { return uid != other.uid; }
-        bool operator<  (const NodeID& other) const noexcept    { return uid <  other.uid; }
-    };
-
-    //==============================================================================
-    /** A special index that represents the midi channel of a node.
-
-        This is used as a channel index value if you want to refer to the midi input
-        or output instead of an audio channel.
-    */
-    enum { midiChannelIndex = 0x1000 };
-
-    //==============================================================================
-    /**
-        Represents an input or output channel of a node in an AudioProcessorGraph.
-    */
-    class NodeAndChannel
-    {
-        auto tie() const { return std::tie (nodeID, channelIndex); }
-
-    public:
-        NodeID nodeID;
-        int channelIndex;
-
-        bool isMIDI() const noexcept                                    { return channelIndex == midiChannelIndex; }
-
-        bool operator== (const NodeAndChannel& other) const noexcept    { return tie() == other.tie(); }
-        bool operator!= (const NodeAndChannel& other) const noexcept    { return tie() != other.tie(); }
-        bool operator<  (const NodeAndChannel& other) const noexcept    { return tie() <  other.tie(); }
-    };
-
-    //==============================================================================
-    /** Represents one of the nodes, or processors, in an AudioProcessorGraph.
-
-        To create a node, call AudioProcessorGraph::addNode().
-    */
-    class JUCE_API  Node   : public ReferenceCountedObject
-    {
-    public:
-        //==============================================================================
-        /** The ID number assigned to this node.
-            This is assigned by the graph that owns it, and can't be changed.
-        */
-        const NodeID nodeID;
-
-        /** The actual processor object that this node represents. */
-        AudioProcessor* getProcessor() const noexcept           { return processor.get(); }
-
-        /** A set of user-definable properties that are associated with this node.
-
-            This can be used to attach values to the node for whatever purpose seems
-            useful. For example, you might store an x and y position if your application
-            is displaying the nodes on-screen.
-        */
-        NamedValueSet properties;
-
-        //==============================================================================
-        /** Returns if the node is bypassed or not. */
-        bool isBypassed() const noexcept
-        {
-            if (processor != nullptr)
-            {
-                if (auto* bypassParam = processor->getBypassParameter())
-                    return (bypassParam->getValue() != 0.0f);
-            }
-
-            return bypassed;
-        }
-
-        /** Tell this node to bypass processing. */
-        void setBypassed (bool shouldBeBypassed) noexcept
-        {
-            if (processor != nullptr)
-            {
-                if (auto* bypassParam = processor->getBypassParameter())
-                    bypassParam->setValueNotifyingHost (shouldBeBypassed ? 1.0f : 0.0f);
-            }
-
-            bypassed = shouldBeBypassed;
-        }
-
-        //==============================================================================
-        /** A convenient typedef for referring to a pointer to a node object. */
-        using Ptr = ReferenceCountedObjectPtr<Node>;
-
-        /** @internal
-
-            Returns true if setBypassed(true) was called on this node.
-            This behaviour is different from isBypassed(), which may additionally return true if
-            the node has a bypass parameter that is not set to 0.
-        */
-        bool userRequestedBypass() const { return bypassed; }
-
-        /** @internal
-
-            To create a new node, use AudioProcessorGraph::addNode.
-        */
-        Node (NodeID n, std::unique_ptr<AudioProcessor> p) noexcept
-            : nodeID (n), processor (std::move (p))
-        {
-            jassert (processor != nullptr);
-        }
-
-    private:
-        //==============================================================================
-        std::unique_ptr<AudioProcessor> processor;
-        std::atomic<bool> bypassed { false };
-
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
-    };
-
-    //==============================================================================
-    /** Represents a connection between two channels of two nodes in an AudioProcessorGraph.
-
-        To create a connection, use AudioProcessorGraph::addConnection().
-    */
-    struct JUCE_API  Connection
-    {
-        //==============================================================================
-        Connection() = default;
-        Connection (NodeAndChannel source, NodeAndChannel destination) noexcept;
-
-        Connection (const Connection&) = default;
-        Connection& operator= (const Connection&) = default;
-
-        bool operator== (const Connection&) const noexcept;
-        bool operator!= (const Connection&) const noexcept;
-        bool operator<  (const Connection&) const noexcept;
-
-        //==============================================================================
-        /** The channel and node which is the input source for this connection. */
-        NodeAndChannel source { {}, 0 };
-
-        /** The channel and node which is the input source for this connection. */
-        NodeAndChannel destination { {}, 0 };
-    };
-
-    //==============================================================================
-    /** Indicates how the graph should be updated after a change.
-
-        If you need to make lots of changes to a graph (e.g. lots of separate calls
-        to addNode, addConnection etc.) you can avoid rebuilding the graph on each
-        change by using the async update kind.
-    */
-    enum class UpdateKind
-    {
-        sync,   ///< Indicates that the graph should be rebuilt immediately after modification.
-        async   ///< Indicates that the graph rebuild should be deferred.
-    };
-
-    //==============================================================================
-    /** Deletes all nodes and connections from this graph.
-        Any processor objects in the graph will be deleted.
-    */
-    void clear (UpdateKind = UpdateKind::sync);
-
-    /** Returns the array of nodes in the graph. */
-    const ReferenceCountedArray<Node>& getNodes() const noexcept;
-
-    /** Returns the number of nodes in the graph. */
-    int getNumNodes() const noexcept                                { return getNodes().size(); }
-
-    /** Returns a pointer to one of the nodes in the graph.
-        This will return nullptr if the index is out of range.
-        @see getNodeForId
-    */
-    Node::Ptr getNode (int index) const noexcept                    { return getNodes()[index]; }
-
-    /** Searches the graph for a node with the given ID number and returns it.
-        If no such node was found, this returns nullptr.
-        @see getNode
-    */
-    Node* getNodeForId (NodeID) const;
-
-    /** Adds a node to the graph.
-
-        This creates a new node in the graph, for the specified processor. Once you have
-        added a processor to the graph, the graph owns it and will delete it later when
-        it is no longer needed.
-
-        The optional nodeId parameter lets you specify a unique ID to use for the node.
-        If the value is already in use, this method will fail and return an empty node.
-
-        If this succeeds, it returns a pointer to the newly-created node.
-    */
-    Node::Ptr addNode (std::unique_ptr<AudioProcessor> newProcessor, NodeID nodeId = {}, UpdateKind = UpdateKind::sync);
-
-    /** Deletes a node within the graph which has the specified ID.
-        This will also delete any connections that are attached to this node.
-    */
-    Node::Ptr removeNode (NodeID, UpdateKind = UpdateKind::sync);
-
-    /** Deletes a node within the graph.
-        This will also delete any connections that are attached to this node.
-    */
-    Node::Ptr removeNode (Node*, UpdateKind = UpdateKind::sync);
-
-    /** Returns the list of connections in the graph. */
-    std::vector<Connection> getConnections() const;
-
-    /** Returns true if the given connection exists. */
-    bool isConnected (const Connection&) const noexcept;
-
-    /** Returns true if there is a direct connection between any of the channels of
-        two specified nodes.
-    */
-    bool isConnected (NodeID possibleSourceNodeID, NodeID possibleDestNodeID) const noexcept;
-
-    /** Does a recursive check to see if there's a direct or indirect series of connections
-        between these two nodes.
-    */
-    bool isAnInputTo (const Node& source, const Node& destination) const noexcept;
-
-    /** Does a recursive check to see if there's a direct or indirect series of connections
-        between these two nodes.
-    */
-    bool isAnInputTo (NodeID source, NodeID destination) const noexcept;
-
-    /** Returns true if it would be legal to connect the specified points. */
-    bool canConnect (const Connection&) const;
-
-    /** Attempts to connect two specified channels of two nodes.
-
-        If this isn't allowed (e.g. because you're trying to connect a midi channel
-        to an audio one or other such nonsense), then it'll return false.
-    */
-    bool addConnection (const Connection&, UpdateKind = UpdateKind::sync);
-
-    /** Deletes the given connection. */
-    bool removeConnection (const Connection&, UpdateKind = UpdateKind::sync);
-
-    /** Removes all connections from the specified node. */
-    bool disconnectNode (NodeID, UpdateKind = UpdateKind::sync);
-
-    /** Returns true if the given connection's channel numbers map on to valid
-        channels at each end.
-        Even if a connection is valid when created, its status could change if
-        a node changes its channel config.
-    */
-    bool isConnectionLegal (const Connection&) const;
-
-    /** Performs a sanity checks of all the connections.
-
-        This might be useful if some of the processors are doing things like changing
-        their channel counts, which could render some connections obsolete.
-    */
-    bool removeIllegalConnections (UpdateKind = UpdateKind::sync);
-
-    //==============================================================================
-    /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
-        in order to use the audio that comes into and out of the graph itself.
-
-        If you create an AudioGraphIOProcessor in "input" mode, it will act as a
-        node in the graph which delivers the audio that is coming into the parent
-        graph. This allows you to stream the data to other nodes and process the
-        incoming audio.
-
-        Likewise, one of these in "output" mode can be sent data which it will add to
-        the sum of data being sent to the graph's output.
-
-        @see AudioProcessorGraph
-    */
-    class JUCE_API  AudioGraphIOProcessor     : public AudioPluginInstance
-    {
-    public:
-        /** Specifies the mode in which this processor will operate.
-        */
-        enum IODeviceType
-        {
-            audioInputNode,     /**< In this mode, the processor has output channels
-                                     representing all the audio input channels that are
-                                     coming into its parent audio graph. */
-            audioOutputNode,    /**< In this mode, the processor has input channels
-                                     representing all the audio output channels that are
-                                     going out of its parent audio graph. */
-            midiInputNode,      /**< In this mode, the processor has a midi output which
-                                     delivers the same midi data that is arriving at its
-                                     parent graph. */
-            midiOutputNode      /**< In this mode, the processor has a midi input and
-                                     any data sent to it will be passed out of the parent
-                                     graph. */
-        };
-
-        //==============================================================================
-        /** Returns the mode of this processor. */
-        IODeviceType getType() const noexcept                       { return type; }
-
-        /** Returns the parent graph to which this processor belongs, or nullptr if it
-            hasn't yet been added to one. */
-        AudioProcessorGraph* getParentGraph() const noexcept        { return graph; }
-
-        /** True if this is an audio or midi input. */
-        bool isInput() const noexcept;
-        /** True if this is an audio or midi output. */
-        bool isOutput() const noexcept;
-
-        //==============================================================================
-        AudioGraphIOProcessor (IODeviceType);
-        ~AudioGraphIOProcessor() override;
-
-        const String getName() const override;
-        void fillInPluginDescription (PluginDescription&) const override;
-        void prepareToPlay (double newSampleRate, int estimatedSamplesPerBlock) override;
-        void releaseResources() override;
-        void processBlock (AudioBuffer<float>& , MidiBuffer&) override;
-        void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
-        bool supportsDoublePrecisionProcessing() const override;
-
-        double getTailLengthSeconds() const override;
-        bool acceptsMidi() const override;
-        bool producesMidi() const override;
-
-        bool hasEditor() const override;
-        AudioProcessorEditor* createEditor() override;
-
-        int getNumPrograms() override;
-        int getCurrentProgram() override;
-        void setCurrentProgram (int) override;
-        const String getProgramName (int) override;
-        void changeProgramName (int, const String&) override;
-
-        void getStateInformation (juce::MemoryBlock& destData) override;
-        void setStateInformation (const void* data, int sizeInBytes) override;
-
-        /** @internal */
-        void setParentGraph (AudioProcessorGraph*);
-
-    private:
-        const IODeviceType type;
-        AudioProcessorGraph* graph = nullptr;
-
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioGraphIOProcessor)
-    };
-
-    //==============================================================================
-    const String getName() const override;
-    void prepareToPlay (double, int) override;
-    void releaseResources() override;
-    void processBlock (AudioBuffer<float>&,  MidiBuffer&) override;
-    void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
-    bool supportsDoublePrecisionProcessing() const override;
-
-    void reset() override;
-    void setNonRealtime (bool) noexcept override;
-
-    double getTailLengthSeconds() const override;
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-
-    bool hasEditor() const override                         { return false; }
-    AudioProcessorEditor* createEditor() override           { return nullptr; }
-    int getNumPrograms() override                           { return 0; }
-    int getCurrentProgram() override                        { return 0; }
-    void setCurrentProgram (int) override                   { }
-    const String getProgramName (int) override              { return {}; }
-    void changeProgramName (int, const String&) override    { }
-    void getStateInformation (juce::MemoryBlock&) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-private:
-    class Pimpl;
-    std::unique_ptr<Pimpl> pimpl;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorGraph)
-};
-
-} // namespace juce
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A type of AudioProcessor which plays back a graph of other AudioProcessors.
+
+    Use one of these objects if you want to wire-up a set of AudioProcessors
+    and play back the result.
+
+    Processors can be added to the graph as "nodes" using addNode(), and once
+    added, you can connect any of their input or output channels to other
+    nodes using addConnection().
+
+    To play back a graph through an audio device, you might want to use an
+    AudioProcessorPlayer object.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorGraph   : public AudioProcessor,
+                                        public ChangeBroadcaster
+{
+public:
+    //==============================================================================
+    /** Creates an empty graph. */
+    AudioProcessorGraph();
+
+    /** Destructor.
+        Any processor objects that have been added to the graph will also be deleted.
+    */
+    ~AudioProcessorGraph() override;
+
+    /** Each node in the graph has a UID of this type. */
+    struct NodeID
+    {
+        NodeID() {}
+        explicit NodeID (uint32 i) : uid (i) {}
+
+        uint32 uid = 0;
+
+        bool operator== (const NodeID& other) const noexcept    { return uid == other.uid; }
+        bool operator!= (const NodeID& other) const noexcept    { return uid != other.uid; }
+        bool operator<  (const NodeID& other) const noexcept    { return uid <  other.uid; }
+    };
+
+    //==============================================================================
+    /** A special index that represents the midi channel of a node.
+
+        This is used as a channel index value if you want to refer to the midi input
+        or output instead of an audio channel.
+    */
+    enum { midiChannelIndex = 0x1000 };
+
+    //==============================================================================
+    /**
+        Represents an input or output channel of a node in an AudioProcessorGraph.
+    */
+    class NodeAndChannel
+    {
+        auto tie() const { return std::tie (nodeID, channelIndex); }
+
+    public:
+        NodeID nodeID;
+        int channelIndex;
+
+        bool isMIDI() const noexcept                                    { return channelIndex == midiChannelIndex; }
+
+        bool operator== (const NodeAndChannel& other) const noexcept    { return tie() == other.tie(); }
+        bool operator!= (const NodeAndChannel& other) const noexcept    { return tie() != other.tie(); }
+        bool operator<  (const NodeAndChannel& other) const noexcept    { return tie() <  other.tie(); }
+    };
+
+    //==============================================================================
+    /** Represents one of the nodes, or processors, in an AudioProcessorGraph.
+
+        To create a node, call AudioProcessorGraph::addNode().
+    */
+    class JUCE_API  Node   : public ReferenceCountedObject
+    {
+    public:
+        //==============================================================================
+        /** The ID number assigned to this node.
+            This is assigned by the graph that owns it, and can't be changed.
+        */
+        const NodeID nodeID;
+
+        /** The actual processor object that this node represents. */
+        AudioProcessor* getProcessor() const noexcept           { return processor.get(); }
+
+        /** A set of user-definable properties that are associated with this node.
+
+            This can be used to attach values to the node for whatever purpose seems
+            useful. For example, you might store an x and y position if your application
+            is displaying the nodes on-screen.
+        */
+        NamedValueSet properties;
+
+        //==============================================================================
+        /** Returns if the node is bypassed or not. */
+        bool isBypassed() const noexcept
+        {
+            if (processor != nullptr)
+            {
+                if (auto* bypassParam = processor->getBypassParameter())
+                    return (bypassParam->getValue() != 0.0f);
+            }
+
+            return bypassed;
+        }
+
+        /** Tell this node to bypass processing. */
+        void setBypassed (bool shouldBeBypassed) noexcept
+        {
+            if (processor != nullptr)
+            {
+                if (auto* bypassParam = processor->getBypassParameter())
+                    bypassParam->setValueNotifyingHost (shouldBeBypassed ? 1.0f : 0.0f);
+            }
+
+            bypassed = shouldBeBypassed;
+        }
+
+        //==============================================================================
+        /** A convenient typedef for referring to a pointer to a node object. */
+        using Ptr = ReferenceCountedObjectPtr<Node>;
+
+        /** @internal
+
+            Returns true if setBypassed(true) was called on this node.
+            This behaviour is different from isBypassed(), which may additionally return true if
+            the node has a bypass parameter that is not set to 0.
+        */
+        bool userRequestedBypass() const { return bypassed; }
+
+        /** @internal
+
+            To create a new node, use AudioProcessorGraph::addNode.
+        */
+        Node (NodeID n, std::unique_ptr<AudioProcessor> p) noexcept
+            : nodeID (n), processor (std::move (p))
+        {
+            jassert (processor != nullptr);
+        }
+
+    private:
+        //==============================================================================
+        std::unique_ptr<AudioProcessor> processor;
+        std::atomic<bool> bypassed { false };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
+    };
+
+    //==============================================================================
+    /** Represents a connection between two channels of two nodes in an AudioProcessorGraph.
+
+        To create a connection, use AudioProcessorGraph::addConnection().
+    */
+    struct JUCE_API  Connection
+    {
+        //==============================================================================
+        Connection() = default;
+        Connection (NodeAndChannel source, NodeAndChannel destination) noexcept;
+
+        Connection (const Connection&) = default;
+        Connection& operator= (const Connection&) = default;
+
+        bool operator== (const Connection&) const noexcept;
+        bool operator!= (const Connection&) const noexcept;
+        bool operator<  (const Connection&) const noexcept;
+
+        //==============================================================================
+        /** The channel and node which is the input source for this connection. */
+        NodeAndChannel source { {}, 0 };
+
+        /** The channel and node which is the input source for this connection. */
+        NodeAndChannel destination { {}, 0 };
+    };
+
+    //==============================================================================
+    /** Indicates how the graph should be updated after a change.
+
+        If you need to make lots of changes to a graph (e.g. lots of separate calls
+        to addNode, addConnection etc.) you can avoid rebuilding the graph on each
+        change by using the async update kind.
+    */
+    enum class UpdateKind
+    {
+        sync,   ///< Indicates that the graph should be rebuilt immediately after modification.
+        async   ///< Indicates that the graph rebuild should be deferred.
+    };
+
+    //==============================================================================
+    /** Deletes all nodes and connections from this graph.
+        Any processor objects in the graph will be deleted.
+    */
+    void clear (UpdateKind = UpdateKind::sync);
+
+    /** Returns the array of nodes in the graph. */
+    const ReferenceCountedArray<Node>& getNodes() const noexcept;
+
+    /** Returns the number of nodes in the graph. */
+    int getNumNodes() const noexcept                                { return getNodes().size(); }
+
+    /** Returns a pointer to one of the nodes in the graph.
+        This will return nullptr if the index is out of range.
+        @see getNodeForId
+    */
+    Node::Ptr getNode (int index) const noexcept                    { return getNodes()[index]; }
+
+    /** Searches the graph for a node with the given ID number and returns it.
+        If no such node was found, this returns nullptr.
+        @see getNode
+    */
+    Node* getNodeForId (NodeID) const;
+
+    /** Adds a node to the graph.
+
+        This creates a new node in the graph, for the specified processor. Once you have
+        added a processor to the graph, the graph owns it and will delete it later when
+        it is no longer needed.
+
+        The optional nodeId parameter lets you specify a unique ID to use for the node.
+        If the value is already in use, this method will fail and return an empty node.
+
+        If this succeeds, it returns a pointer to the newly-created node.
+    */
+    Node::Ptr addNode (std::unique_ptr<AudioProcessor> newProcessor, NodeID nodeId = {}, UpdateKind = UpdateKind::sync);
+
+    /** Deletes a node within the graph which has the specified ID.
+        This will also delete any connections that are attached to this node.
+    */
+    Node::Ptr removeNode (NodeID, UpdateKind = UpdateKind::sync);
+
+    /** Deletes a node within the graph.
+        This will also delete any connections that are attached to this node.
+    */
+    Node::Ptr removeNode (Node*, UpdateKind = UpdateKind::sync);
+
+    /** Returns the list of connections in the graph. */
+    std::vector<Connection> getConnections() const;
+
+    /** Returns true if the given connection exists. */
+    bool isConnected (const Connection&) const noexcept;
+
+    /** Returns true if there is a direct connection between any of the channels of
+        two specified nodes.
+    */
+    bool isConnected (NodeID possibleSourceNodeID, NodeID possibleDestNodeID) const noexcept;
+
+    /** Does a recursive check to see if there's a direct or indirect series of connections
+        between these two nodes.
+    */
+    bool isAnInputTo (const Node& source, const Node& destination) const noexcept;
+
+    /** Does a recursive check to see if there's a direct or indirect series of connections
+        between these two nodes.
+    */
+    bool isAnInputTo (NodeID source, NodeID destination) const noexcept;
+
+    /** Returns true if it would be legal to connect the specified points. */
+    bool canConnect (const Connection&) const;
+
+    /** Attempts to connect two specified channels of two nodes.
+
+        If this isn't allowed (e.g. because you're trying to connect a midi channel
+        to an audio one or other such nonsense), then it'll return false.
+    */
+    bool addConnection (const Connection&, UpdateKind = UpdateKind::sync);
+
+    /** Deletes the given connection. */
+    bool removeConnection (const Connection&, UpdateKind = UpdateKind::sync);
+
+    /** Removes all connections from the specified node. */
+    bool disconnectNode (NodeID, UpdateKind = UpdateKind::sync);
+
+    /** Returns true if the given connection's channel numbers map on to valid
+        channels at each end.
+        Even if a connection is valid when created, its status could change if
+        a node changes its channel config.
+    */
+    bool isConnectionLegal (const Connection&) const;
+
+    /** Performs a sanity checks of all the connections.
+
+        This might be useful if some of the processors are doing things like changing
+        their channel counts, which could render some connections obsolete.
+    */
+    bool removeIllegalConnections (UpdateKind = UpdateKind::sync);
+
+    //==============================================================================
+    /** Sets the number of worker threads that may help to render the graph.
+
+        By default this is 0, and the whole graph is rendered in order on the thread
+        that calls processBlock(). If you set a positive number of threads, the graph
+        will work out which of its rendering steps don't share any buffers, and will let
+        the worker threads run those steps at the same time as the calling thread. This
+        can make a big difference for graphs with lots of parallel branches.
+
+        Only enable this if all the processors in the graph are happy to have their
+        processBlock() methods called from different threads, and to run at the same
+        time as the other processors in the graph.
+
+        This must be called on the message thread, and will cause the graph to be rebuilt.
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of render threads set with setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
+    //==============================================================================
+    /** Timing statistics for one of the nodes in the graph.
+
+        All the times are in milliseconds, and are based on the most recent blocks
+        that the node has processed.
+
+        @see getNodeTimingStatistics
+    */
+    struct NodeTimingStatistics
+    {
+        /** The number of blocks that these statistics were calculated from. */
+        int numMeasurements = 0;
+
+        double minimum = 0.0, mean = 0.0, maximum = 0.0;
+        double median = 0.0, percentile95 = 0.0, percentile99 = 0.0;
+
+        /** The mean proportion of each block's real-time duration that the node spent processing. */
+        double meanLoad = 0.0;
+    };
+
+    /** Enables or disables timing of each node's processBlock() call.
+
+        When this is enabled, the graph measures how long each node takes to process
+        every block, and keeps the most recent measurements in a lock-free ring buffer
+        so that they can be inspected with getNodeTimingStatistics() while the graph
+        is running. This can be useful for finding out which node is responsible when
+        the graph overruns its callback.
+
+        Timing is disabled by default, and costs nothing while it's disabled. This must
+        be called on the message thread, and will cause the graph to be rebuilt.
+    */
+    void setNodeTimingEnabled (bool shouldBeEnabled);
+
+    /** Returns true if node timing has been enabled with setNodeTimingEnabled(). */
+    bool isNodeTimingEnabled() const noexcept;
+
+    /** Returns timing statistics for a node, or an empty Optional if node timing
+        is disabled or the node doesn't exist.
+
+        This must be called on the message thread.
+    */
+    Optional<NodeTimingStatistics> getNodeTimingStatistics (NodeID) const;
+
+    /** Discards all the timing measurements that have been made so far. */
+    void resetNodeTimingStatistics();
+
+    //==============================================================================
+    /** Enables or disables skipping nodes whose inputs have gone quiet.
+
+        The graph always keeps track of which of its internal channels are silent, and
+        avoids clearing, copying or mixing channels that hold nothing but zeros. When
+        this is enabled, it also stops calling processBlock() on a node once all its
+        audio inputs, and its MIDI input if it accepts MIDI, have been silent for longer
+        than its latency plus the tail reported by getTailLengthSeconds(). The node's
+        outputs are treated as silent, so the nodes after it can be skipped in turn, and
+        a large graph in which most of the nodes are idle costs very little to render.
+
+        Nodes without audio inputs, nodes with an infinite tail, nested graphs and the
+        graph's own IO nodes are never skipped. Because a processor whose reported tail is
+        too short would be cut off, this is disabled by default. This must be called on
+        the message thread, and will cause the graph to be rebuilt. The tail lengths are
+        read whenever the graph is rebuilt.
+    */
+    void setSilentNodesSkipped (bool shouldBeSkipped);
+
+    /** Returns true if silent nodes are skipped, as set by setSilentNodesSkipped(). */
+    bool areSilentNodesSkipped() const noexcept;
+
+    //==============================================================================
+    /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
+        in order to use the audio that comes into and out of the graph itself.
+
+        If you create an AudioGraphIOProcessor in "input" mode, it will act as a
+        node in the graph which delivers the audio that is coming into the parent
+        graph. This allows you to stream the data to other nodes and process the
+        incoming audio.
+
+        Likewise, one of these in "output" mode can be sent data which it will add to
+        the sum of data being sent to the graph's output.
+
+        @see AudioProcessorGraph
+    */
+    class JUCE_API  AudioGraphIOProcessor     : public AudioPluginInstance
+    {
+    public:
+        /** Specifies the mode in which this processor will operate.
+        */
+        enum IODeviceType
+        {
+            audioInputNode,     /**< In this mode, the processor has output channels
+                                     representing all the audio input channels that are
+                                     coming into its parent audio graph. */
+            audioOutputNode,    /**< In this mode, the processor has input channels
+                                     representing all the audio output channels that are
+                                     going out of its parent audio graph. */
+            midiInputNode,      /**< In this mode, the processor has a midi output which
+                                     delivers the same midi data that is arriving at its
+                                     parent graph. */
+            midiOutputNode      /**< In this mode, the processor has a midi input and
+                                     any data sent to it will be passed out of the parent
+                                     graph. */
+        };
+
+        //==============================================================================
+        /** Returns the mode of this processor. */
+        IODeviceType getType() const noexcept                       { return type; }
+
+        /** Returns the parent graph to which this processor belongs, or nullptr if it
+            hasn't yet been added to one. */
+        AudioProcessorGraph* getParentGraph() const noexcept        { return graph; }
+
+        /** True if this is an audio or midi input. */
+        bool isInput() const noexcept;
+        /** True if this is an audio or midi output. */
+        bool isOutput() const noexcept;
+
+        //==============================================================================
+        AudioGraphIOProcessor (IODeviceType);
+        ~AudioGraphIOProcessor() override;
+
+        const String getName() const override;
+        void fillInPluginDescription (PluginDescription&) const override;
+        void prepareToPlay (double newSampleRate, int estimatedSamplesPerBlock) override;
+        void releaseResources() override;
+        void processBlock (AudioBuffer<float>& , MidiBuffer&) override;
+        void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
+        bool supportsDoublePrecisionProcessing() const override;
+
+        double getTailLengthSeconds() const override;
+        bool acceptsMidi() const override;
+        bool producesMidi() const override;
+
+        bool hasEditor() const override;
+        AudioProcessorEditor* createEditor() override;
+
+        int getNumPrograms() override;
+        int getCurrentProgram() override;
+        void setCurrentProgram (int) override;
+        const String getProgramName (int) override;
+        void changeProgramName (int, const String&) override;
+
+        void getStateInformation (juce::MemoryBlock& destData) override;
+        void setStateInformation (const void* data, int sizeInBytes) override;
+
+        /** @internal */
+        void setParentGraph (AudioProcessorGraph*);
+
+    private:
+        const IODeviceType type;
+        AudioProcessorGraph* graph = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioGraphIOProcessor)
+    };
+
+    //==============================================================================
+    const String getName() const override;
+    void prepareToPlay (double, int) override;
+    void releaseResources() override;
+    void processBlock (AudioBuffer<float>&,  MidiBuffer&) override;
+    void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
+    void processPacketBlock (AudioBuffer<float>&,  universal_midi_packets::EventBuffer&) override;
+    void processPacketBlock (AudioBuffer<double>&, universal_midi_packets::EventBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
+    bool supportsUniversalMidiPackets() const override;
+
+    void reset() override;
+    void setNonRealtime (bool) noexcept override;
+
+    double getTailLengthSeconds() const override;
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+
+    bool hasEditor() const override                         { return false; }
+    AudioProcessorEditor* createEditor() override           { return nullptr; }
+    int getNumPrograms() override                           { return 0; }
+    int getCurrentProgram() override                        { return 0; }
+    void setCurrentProgram (int) override                   { }
+    const String getProgramName (int) override              { return {}; }
+    void changeProgramName (int, const String&) override    { }
+    void getStateInformation (juce::MemoryBlock&) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+private:
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorGraph)
+};
+
+} // namespace juce
@@ -321,6 +321,18 @@ public:
             message thread.
         */
         virtual void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) = 0;
+
+        /** Receives a single callback for a group of parameters that were changed together.
+
+            Changes made while an AudioProcessor::ScopedParameterChangeBatch exists are
+            delivered here when the batch ends, instead of through parameterValueChanged().
+            The indices are those of the parameters that this listener is registered with,
+            each listed once however many times it changed, and their new values can be
+            read from the processor's parameters.
+
+            The default implementation calls parameterValueChanged() for each of them.
+        */
+        virtual void parameterValuesChanged (const AudioProcessor& processor, const Array<int>& parameterIndices);
     };
 
     /** Registers a listener to receive events when the parameter's state changes.
@@ -347,8 +359,7 @@ private:
     AudioProcessor* processor = nullptr;
     int parameterIndex = -1;
     int version = 0;
-    CriticalSection listenerLock;
-    Array<Listener*> listeners;
+    RealtimeListenerList<Listener, 32> listeners;
     mutable StringArray valueStrings;
 
    #if JUCE_DEBUG
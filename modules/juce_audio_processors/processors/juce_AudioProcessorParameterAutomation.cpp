@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+float AudioProcessorParameterAutomation::Lane::getValueAt (int sampleOffset) const noexcept
+{
+    auto previousValue = startValue;
+    auto previousOffset = 0;
+
+    for (auto& point : *this)
+    {
+        if (sampleOffset < point.sampleOffset)
+            return previousValue + (point.value - previousValue) * (float) (sampleOffset - previousOffset)
+                                                                 / (float) (point.sampleOffset - previousOffset);
+
+        previousValue = point.value;
+        previousOffset = point.sampleOffset;
+    }
+
+    return previousValue;
+}
+
+void AudioProcessorParameterAutomation::Lane::fillValues (float* destination, int startSample, int numSamples) const noexcept
+{
+    auto previousValue = startValue;
+    auto previousOffset = 0;
+    auto* point = begin();
+    const auto endSample = startSample + numSamples;
+
+    for (auto sample = startSample; sample < endSample;)
+    {
+        while (point != end() && point->sampleOffset <= sample)
+        {
+            previousValue = point->value;
+            previousOffset = point->sampleOffset;
+            ++point;
+        }
+
+        if (point == end())
+        {
+            FloatVectorOperations::fill (destination + (sample - startSample), previousValue, endSample - sample);
+            return;
+        }
+
+        const auto slope = (point->value - previousValue) / (float) (point->sampleOffset - previousOffset);
+        const auto segmentEnd = jmin (point->sampleOffset, endSample);
+
+        for (; sample < segmentEnd; ++sample)
+            destination[sample - startSample] = previousValue + slope * (float) (sample - previousOffset);
+    }
+}
+
+//==============================================================================
+void AudioProcessorParameterAutomation::prepare (int maxNumParameters, int maxNumPoints)
+{
+    lanes.clear();
+    lanes.reserve ((size_t) maxNumParameters);
+    points.clear();
+    points.reserve ((size_t) maxNumPoints);
+    laneIndexForParameter.assign ((size_t) maxNumParameters, -1);
+}
+
+void AudioProcessorParameterAutomation::prepare (const AudioProcessor& processor, int maxNumPointsPerParameter)
+{
+    const auto numParameters = processor.getParameters().size();
+    prepare (numParameters, numParameters * maxNumPointsPerParameter);
+}
+
+void AudioProcessorParameterAutomation::clear() noexcept
+{
+    for (auto& lane : lanes)
+        laneIndexForParameter[(size_t) lane.parameter->getParameterIndex()] = -1;
+
+    lanes.clear();
+    points.clear();
+}
+
+bool AudioProcessorParameterAutomation::addPoint (AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept
+{
+    const auto parameterIndex = parameter.getParameterIndex();
+
+    if (! isPositiveAndBelow (parameterIndex, laneIndexForParameter.size()) || points.size() == points.capacity())
+        return false;
+
+    auto& laneIndex = laneIndexForParameter[(size_t) parameterIndex];
+
+    if (laneIndex < 0)
+    {
+        laneIndex = (int) lanes.size();
+        lanes.push_back (Lane (points.data(), parameter, (int) points.size()));
+    }
+
+    auto& lane = lanes[(size_t) laneIndex];
+
+    // The points for each parameter have to be added in the order they occur
+    jassert (lane.numPoints == 0 || lane.end()[-1].sampleOffset <= sampleOffset);
+
+    // This won't reallocate, as there's still some capacity left
+    points.insert (points.begin() + lane.firstPoint + lane.numPoints, { sampleOffset, newValue });
+    ++lane.numPoints;
+
+    for (auto i = (size_t) laneIndex + 1; i < lanes.size(); ++i)
+        ++lanes[i].firstPoint;
+
+    return true;
+}
+
+const AudioProcessorParameterAutomation::Lane* AudioProcessorParameterAutomation::getLaneFor (const AudioProcessorParameter& parameter) const noexcept
+{
+    const auto parameterIndex = parameter.getParameterIndex();
+
+    if (! isPositiveAndBelow (parameterIndex, laneIndexForParameter.size()))
+        return nullptr;
+
+    const auto laneIndex = laneIndexForParameter[(size_t) parameterIndex];
+
+    if (laneIndex < 0 || lanes[(size_t) laneIndex].parameter != &parameter)
+        return nullptr;
+
+    return &lanes[(size_t) laneIndex];
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorParameterAutomationTests  : public UnitTest
+{
+public:
+    AudioProcessorParameterAutomationTests()
+        : UnitTest ("AudioProcessorParameterAutomation", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        TestAudioProcessor processor;
+        auto& params = processor.getParameters();
+
+        AudioProcessorParameterAutomation automation;
+        automation.prepare (params.size(), 8);
+
+        beginTest ("Values ramp linearly between the points");
+        {
+            params[0]->setValue (0.0f);
+            expect (automation.addPoint (*params[0], 10, 1.0f));
+            expect (automation.addPoint (*params[0], 20, 1.0f));
+            expect (automation.addPoint (*params[0], 20, 0.5f));
+
+            expectEquals (automation.getNumLanes(), 1);
+
+            auto* lane = automation.getLaneFor (*params[0]);
+            expect (lane != nullptr);
+            expect (automation.getLaneFor (*params[1]) == nullptr);
+
+            expectEquals (lane->getStartValue(), 0.0f);
+            expectEquals (lane->getEndValue(), 0.5f);
+            expectEquals (lane->getValueAt (0), 0.0f);
+            expectWithinAbsoluteError (lane->getValueAt (5), 0.5f, 1.0e-6f);
+            expectEquals (lane->getValueAt (10), 1.0f);
+            expectEquals (lane->getValueAt (19), 1.0f);
+            expectEquals (lane->getValueAt (20), 0.5f);
+            expectEquals (lane->getValueAt (100), 0.5f);
+
+            HeapBlock<float> values (32);
+            lane->fillValues (values, 0, 32);
+
+            auto allMatched = true;
+
+            for (int i = 0; i < 32; ++i)
+                allMatched = allMatched && std::abs (values[i] - lane->getValueAt (i)) < 1.0e-6f;
+
+            expect (allMatched);
+
+            lane->fillValues (values, 15, 2);
+            expectEquals (values[0], 1.0f);
+            expectEquals (values[1], 1.0f);
+        }
+
+        beginTest ("Interleaved points are kept in separate lanes");
+        {
+            automation.clear();
+            expectEquals (automation.getNumLanes(), 0);
+
+            params[1]->setValue (0.25f);
+            params[2]->setValue (0.75f);
+
+            expect (automation.addPoint (*params[1], 0, 0.1f));
+            expect (automation.addPoint (*params[2], 0, 0.2f));
+            expect (automation.addPoint (*params[1], 5, 0.3f));
+            expect (automation.addPoint (*params[2], 6, 0.4f));
+            expect (automation.addPoint (*params[1], 7, 0.5f));
+
+            expectEquals (automation.getNumLanes(), 2);
+
+            auto& first = *automation.getLaneFor (*params[1]);
+            auto& second = *automation.getLaneFor (*params[2]);
+
+            expectEquals (first.getStartValue(), 0.25f);
+            expectEquals (first.getNumPoints(), 3);
+            expectEquals (first.getPoint (1).sampleOffset, 5);
+            expectEquals (first.getEndValue(), 0.5f);
+
+            expectEquals (second.getStartValue(), 0.75f);
+            expectEquals (second.getNumPoints(), 2);
+            expectEquals (second.getPoint (1).value, 0.4f);
+        }
+
+        beginTest ("Points are refused once the space runs out");
+        {
+            automation.clear();
+
+            for (int i = 0; i < 8; ++i)
+                expect (automation.addPoint (*params[i % 2], i, 0.0f));
+
+            expect (! automation.addPoint (*params[2], 8, 0.0f));
+            expectEquals (automation.getNumLanes(), 2);
+        }
+    }
+
+private:
+    struct TestAudioProcessor   : public AudioProcessor
+    {
+        TestAudioProcessor()
+        {
+            for (int i = 0; i < 3; ++i)
+                addParameter (new AudioParameterFloat (ParameterID { "p" + String (i), 1 }, "p" + String (i), 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override { return "ap"; }
+        void prepareToPlay (double, int) override {}
+        void releaseResources() override {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 0; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram (int) override {}
+        const String getProgramName (int) override { return {}; }
+        void changeProgramName (int, const String&) override {}
+        void getStateInformation (MemoryBlock&) override {}
+        void setStateInformation (const void*, int) override {}
+    };
+};
+
+static AudioProcessorParameterAutomationTests audioProcessorParameterAutomationTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds the sample-accurate changes that a block's parameters went through.
+
+    Hosts normally set each parameter to a single value before calling processBlock(),
+    so a parameter that is being automated jumps from one value to the next at block
+    boundaries, unless the processor splits the block up itself. For a processor that
+    returns true from AudioProcessor::supportsSampleAccurateAutomation(), the plug-in
+    wrappers and hosts also fill one of these objects with the points that the host
+    sent, and make it available through AudioProcessor::getParameterAutomation() for
+    the duration of the callback.
+
+    Each parameter that changed has a Lane, holding the points in the order they
+    occur. A lane ramps linearly from the parameter's value at the start of the block to
+    its first point, and from each point to the next, which is how VST3 defines its
+    automation. Two points at the same position make a step. After the last point, the
+    value stays the same until the end of the block. Parameters without a lane kept
+    their value for the whole block.
+
+    All the values are normalised, in the same way as AudioProcessorParameter::getValue().
+    When the callback starts, each parameter has already been set to the value of the
+    last point in its lane.
+
+    Memory is allocated by prepare(), so that filling the object on the audio thread
+    doesn't allocate.
+
+    @see AudioProcessor::getParameterAutomation
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterAutomation
+{
+public:
+    //==============================================================================
+    /** Creates an empty object. Call prepare() before adding anything to it. */
+    AudioProcessorParameterAutomation() = default;
+
+    AudioProcessorParameterAutomation (AudioProcessorParameterAutomation&&) noexcept = default;
+    AudioProcessorParameterAutomation& operator= (AudioProcessorParameterAutomation&&) noexcept = default;
+
+    //==============================================================================
+    /** A normalised parameter value at a position in the block. */
+    struct Point
+    {
+        int sampleOffset;
+        float value;
+    };
+
+    //==============================================================================
+    /** The changes to a single parameter during the block. */
+    class JUCE_API  Lane
+    {
+    public:
+        /** Returns the parameter that this lane belongs to. */
+        AudioProcessorParameter& getParameter() const noexcept  { return *parameter; }
+
+        /** Returns the value that the parameter had at the start of the block. */
+        float getStartValue() const noexcept                    { return startValue; }
+
+        /** Returns the value that the parameter has at the end of the block. */
+        float getEndValue() const noexcept                      { return numPoints > 0 ? end()[-1].value : startValue; }
+
+        /** Returns the number of points in the lane. */
+        int getNumPoints() const noexcept                       { return numPoints; }
+
+        /** Returns one of the points in the lane. */
+        const Point& getPoint (int index) const noexcept        { jassert (isPositiveAndBelow (index, numPoints)); return begin()[index]; }
+
+        const Point* begin() const noexcept                     { return points + firstPoint; }
+        const Point* end() const noexcept                       { return begin() + numPoints; }
+
+        /** Returns the value that the parameter has at a position in the block. */
+        float getValueAt (int sampleOffset) const noexcept;
+
+        /** Fills an array with the parameter's value at each sample of part of the block.
+
+            This is quicker than calling getValueAt() for each sample.
+        */
+        void fillValues (float* destination, int startSample, int numSamples) const noexcept;
+
+    private:
+        friend class AudioProcessorParameterAutomation;
+
+        Lane (const Point* allPoints, AudioProcessorParameter& param, int first) noexcept
+            : points (allPoints), parameter (&param), startValue (param.getValue()), firstPoint (first)
+        {}
+
+        const Point* points;
+        AudioProcessorParameter* parameter;
+        float startValue;
+        int firstPoint, numPoints = 0;
+    };
+
+    //==============================================================================
+    /** Allocates space for the given number of parameters and points, and clears the object.
+
+        The parameters are looked up by AudioProcessorParameter::getParameterIndex(), so
+        maxNumParameters should be the number of parameters that the processor has.
+    */
+    void prepare (int maxNumParameters, int maxNumPoints);
+
+    /** Allocates space for all the parameters of a processor, with room for a number of
+        points per parameter, and clears the object.
+    */
+    void prepare (const AudioProcessor& processor, int maxNumPointsPerParameter = 16);
+
+    /** Removes all the lanes, ready for the next block. */
+    void clear() noexcept;
+
+    /** Adds a point to the lane of a parameter, creating the lane if necessary.
+
+        The points for any one parameter must be added in the order they occur, although
+        the points of different parameters can be interleaved. When a parameter gets its
+        first point, its current value is taken as the value at the start of the block,
+        so the points must be added before the parameter is set to its new value.
+
+        Returns false if there wasn't enough space for the point, or if the parameter
+        doesn't belong to the processor that the object was prepared for.
+    */
+    bool addPoint (AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept;
+
+    //==============================================================================
+    /** Returns the number of parameters that changed during the block. */
+    int getNumLanes() const noexcept                            { return (int) lanes.size(); }
+
+    /** Returns one of the lanes. */
+    const Lane& getLane (int index) const noexcept              { jassert (isPositiveAndBelow (index, lanes.size())); return lanes[(size_t) index]; }
+
+    /** Returns the lane of a parameter, or nullptr if it didn't change during the block. */
+    const Lane* getLaneFor (const AudioProcessorParameter& parameter) const noexcept;
+
+    const Lane* begin() const noexcept                          { return lanes.data(); }
+    const Lane* end() const noexcept                            { return lanes.data() + lanes.size(); }
+
+private:
+    //==============================================================================
+    std::vector<Point> points;
+    std::vector<Lane> lanes;
+    std::vector<int> laneIndexForParameter;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorParameterAutomation)
+};
+
+} // namespace juce
@@ -510,61 +510,79 @@ struct PluginTreeUtils
         }
     }
 
-    static bool containsDuplicateNames (const Array<PluginDescription>& plugins, const String& name)
+    // Shared between a menu and the lazily-created sub-menus for its folders
+    struct MenuContext
     {
-        int matches = 0;
+        MenuContext (std::unique_ptr<KnownPluginList::PluginTree> treeToUse,
+                     const Array<PluginDescription>& allPlugins,
+                     const String& currentlyTickedPluginID)
+            : tree (std::move (treeToUse)), tickedPluginID (currentlyTickedPluginID)
+        {
+            for (int i = 0; i < allPlugins.size(); ++i)
+                menuIds.emplace (getDuplicateKey (allPlugins.getReference (i)), i + menuIdBase);
+        }
+
+        // Matches the fields compared by PluginDescription::isDuplicateOf()
+        static std::tuple<String, int, int> getDuplicateKey (const PluginDescription& d)
+        {
+            return std::make_tuple (d.fileOrIdentifier, d.deprecatedUid, d.uniqueId);
+        }
+
+        int getPluginMenuIndex (const PluginDescription& d) const
+        {
+            auto found = menuIds.find (getDuplicateKey (d));
+            return found != menuIds.end() ? found->second : 0;
+        }
+
+        std::unique_ptr<KnownPluginList::PluginTree> tree;
+        String tickedPluginID;
+        std::map<std::tuple<String, int, int>, int> menuIds;
+    };
+
+    static bool containsTickedPlugin (const KnownPluginList::PluginTree& tree, const String& currentlyTickedPluginID)
+    {
+        for (auto& plugin : tree.plugins)
+            if (plugin.matchesIdentifierString (currentlyTickedPluginID))
+                return true;
 
-        for (auto& p : plugins)
-            if (p.name == name && ++matches > 1)
+        for (auto* sub : tree.subFolders)
+            if (containsTickedPlugin (*sub, currentlyTickedPluginID))
                 return true;
 
         return false;
     }
 
-    static bool addToMenu (const KnownPluginList::PluginTree& tree, PopupMenu& m,
-                           const Array<PluginDescription>& allPlugins,
-                           const String& currentlyTickedPluginID)
+    static void addToMenu (const KnownPluginList::PluginTree& tree, PopupMenu& m,
+                           const std::shared_ptr<const MenuContext>& context)
     {
-        bool isTicked = false;
-
         for (auto* sub : tree.subFolders)
         {
-            PopupMenu subMenu;
-            auto isItemTicked = addToMenu (*sub, subMenu, allPlugins, currentlyTickedPluginID);
-            isTicked = isTicked || isItemTicked;
-
-            m.addSubMenu (sub->folder, subMenu, true, nullptr, isItemTicked, 0);
+            m.addLazySubMenu (sub->folder,
+                              [sub, context]
+                              {
+                                  PopupMenu subMenu;
+                                  addToMenu (*sub, subMenu, context);
+                                  return subMenu;
+                              },
+                              true,
+                              containsTickedPlugin (*sub, context->tickedPluginID));
         }
 
-        auto getPluginMenuIndex = [&] (const PluginDescription& d)
-        {
-            int i = 0;
-
-            for (auto& p : allPlugins)
-            {
-                if (p.isDuplicateOf (d))
-                    return i + menuIdBase;
-
-                ++i;
-            }
+        std::map<String, int> nameCounts;
 
-            return 0;
-        };
+        for (auto& plugin : tree.plugins)
+            ++nameCounts[plugin.name];
 
         for (auto& plugin : tree.plugins)
         {
             auto name = plugin.name;
 
-            if (containsDuplicateNames (tree.plugins, name))
+            if (nameCounts[name] > 1)
                 name << " (" << plugin.pluginFormatName << ')';
 
-            auto isItemTicked = plugin.matchesIdentifierString (currentlyTickedPluginID);
-            isTicked = isTicked || isItemTicked;
-
-            m.addItem (getPluginMenuIndex (plugin), name, true, isItemTicked);
+            m.addItem (context->getPluginMenuIndex (plugin), name, true,
+                       plugin.matchesIdentifierString (context->tickedPluginID));
         }
-
-        return isTicked;
     }
 };
 
@@ -598,8 +616,9 @@ std::unique_ptr<KnownPluginList::PluginTree> KnownPluginList::createTree (const
 void KnownPluginList::addToMenu (PopupMenu& menu, const Array<PluginDescription>& types, SortMethod sortMethod,
                                  const String& currentlyTickedPluginID)
 {
-    auto tree = createTree (types, sortMethod);
-    PluginTreeUtils::addToMenu (*tree, menu, types, currentlyTickedPluginID);
+    auto context = std::make_shared<const PluginTreeUtils::MenuContext> (createTree (types, sortMethod),
+                                                                          types, currentlyTickedPluginID);
+    PluginTreeUtils::addToMenu (*context->tree, menu, context);
 }
 
 int KnownPluginList::getIndexChosenByMenu (const Array<PluginDescription>& types, int menuResultCode)
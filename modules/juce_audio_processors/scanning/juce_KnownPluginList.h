@@ -140,7 +140,8 @@ public:
     /** Adds the plug-in types to a popup menu so that the user can select one.
 
         Depending on the sort method, it may add sub-menus for categories,
-        manufacturers, etc.
+        manufacturers, etc. These are added with PopupMenu::addLazySubMenu(), so
+        their contents are only built when the user opens them.
 
         Use getIndexChosenByMenu() to find out the type that was chosen.
     */
@@ -0,0 +1,578 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+// One of the worker processes, along with the job that it's currently doing.
+// The results arrive on the connection's thread, and are picked up by the
+// scanner's thread.
+class OutOfProcessPluginScanner::Process  : private ChildProcessCoordinator
+{
+public:
+    explicit Process (OutOfProcessPluginScanner& o)  : owner (o) {}
+
+    ~Process() override
+    {
+        stop();
+    }
+
+    enum class State
+    {
+        idle,
+        scanning,
+        gotResult,
+        crashed
+    };
+
+    State getState() const
+    {
+        const ScopedLock sl (stateLock);
+        return state;
+    }
+
+    bool hasTimedOut() const
+    {
+        return Time::getMillisecondCounter() - startTime > (uint32) owner.timeoutMs.load();
+    }
+
+    bool start (const Job& job)
+    {
+        if (! isRunning)
+            isRunning = launchWorkerProcess (owner.executable, owner.uniqueID, 0, 0);
+
+        if (! isRunning)
+            return false;
+
+        setState (State::scanning);
+        currentJob = job;
+        startTime = Time::getMillisecondCounter();
+
+        MemoryOutputStream request;
+        request.writeString (job.format->getName());
+        request.writeString (job.fileOrIdentifier);
+        request.writeInt (owner.timeoutMs);
+
+        if (sendMessageToWorker (request.getMemoryBlock()))
+            return true;
+
+        stop();
+        return false;
+    }
+
+    void stop()
+    {
+        if (isRunning)
+        {
+            isRunning = false;
+            killWorkerProcess();
+        }
+
+        setState (State::idle);
+    }
+
+    Array<PluginDescription> takeResults()
+    {
+        Array<PluginDescription> results;
+        std::unique_ptr<XmlElement> xml;
+
+        {
+            const ScopedLock sl (stateLock);
+            std::swap (xml, resultXml);
+            state = State::idle;
+        }
+
+        if (xml != nullptr)
+        {
+            for (auto* e : xml->getChildIterator())
+            {
+                PluginDescription desc;
+
+                if (desc.loadFromXml (*e))
+                    results.add (desc);
+            }
+        }
+
+        return results;
+    }
+
+    Job currentJob;
+
+private:
+    void setState (State newState)
+    {
+        const ScopedLock sl (stateLock);
+        state = newState;
+        resultXml.reset();
+    }
+
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        {
+            const ScopedLock sl (stateLock);
+
+            if (state == State::scanning)
+            {
+                resultXml = parseXML (mb.toString());
+                state = State::gotResult;
+            }
+        }
+
+        owner.notify();
+    }
+
+    void handleConnectionLost() override
+    {
+        {
+            const ScopedLock sl (stateLock);
+
+            if (state == State::scanning)
+                state = State::crashed;
+        }
+
+        owner.notify();
+    }
+
+    OutOfProcessPluginScanner& owner;
+    CriticalSection stateLock;
+    State state = State::idle;
+    std::unique_ptr<XmlElement> resultXml;
+    bool isRunning = false;
+    uint32 startTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Process)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo,
+                                                      const File& workerExecutable,
+                                                      const String& commandLineUniqueID,
+                                                      int numProcesses,
+                                                      PluginScanCache* cacheToUse)
+    : Thread ("Plugin scanner"),
+      list (listToAddResultsTo),
+      cache (cacheToUse),
+      executable (workerExecutable),
+      uniqueID (commandLineUniqueID)
+{
+    for (int i = jmax (1, numProcesses); --i >= 0;)
+        processes.push_back (std::make_unique<Process> (*this));
+
+    finishedEvent.signal();
+    startThread();
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    cancel();
+    stopThread (10000);
+    processes.clear();
+
+    if (cache != nullptr)
+        cache->saveIfNeeded();
+}
+
+//==============================================================================
+void OutOfProcessPluginScanner::scan (AudioPluginFormat& format,
+                                      const StringArray& filesOrIdentifiersToScan,
+                                      bool dontRescanIfAlreadyInList)
+{
+    {
+        const ScopedLock sl (lock);
+
+        if (finishedEvent.wait (0))
+        {
+            numJobsQueued = numJobsFinished = 0;
+            failedFiles.clear();
+            crashedFiles.clear();
+        }
+
+        for (auto& f : filesOrIdentifiersToScan)
+        {
+            if (f.isNotEmpty())
+            {
+                pendingJobs.push_back ({ &format, f, dontRescanIfAlreadyInList, {} });
+                ++numJobsQueued;
+            }
+        }
+
+        if (! pendingJobs.empty())
+            finishedEvent.reset();
+    }
+
+    notify();
+}
+
+void OutOfProcessPluginScanner::cancel()
+{
+    {
+        const ScopedLock sl (lock);
+        numJobsFinished += (int) pendingJobs.size();
+        pendingJobs.clear();
+        cancelRequested = true;
+    }
+
+    notify();
+}
+
+bool OutOfProcessPluginScanner::isFinished() const
+{
+    return finishedEvent.wait (0);
+}
+
+bool OutOfProcessPluginScanner::waitUntilFinished (int timeOutMilliseconds) const
+{
+    return finishedEvent.wait ((double) timeOutMilliseconds);
+}
+
+float OutOfProcessPluginScanner::getProgress() const
+{
+    const ScopedLock sl (lock);
+    return numJobsQueued > 0 ? (float) numJobsFinished / (float) numJobsQueued : 1.0f;
+}
+
+void OutOfProcessPluginScanner::setTimeoutForEachPlugin (int milliseconds)
+{
+    timeoutMs = jmax (1, milliseconds);
+}
+
+StringArray OutOfProcessPluginScanner::getPluginsBeingScanned() const
+{
+    const ScopedLock sl (lock);
+    return pluginsBeingScanned;
+}
+
+StringArray OutOfProcessPluginScanner::getFailedFiles() const
+{
+    const ScopedLock sl (lock);
+    return failedFiles;
+}
+
+StringArray OutOfProcessPluginScanner::getCrashedFiles() const
+{
+    const ScopedLock sl (lock);
+    return crashedFiles;
+}
+
+//==============================================================================
+void OutOfProcessPluginScanner::run()
+{
+    while (! threadShouldExit())
+    {
+        const auto cancelling = [this]
+        {
+            const ScopedLock sl (lock);
+            return std::exchange (cancelRequested, false);
+        }();
+
+        for (auto& p : processes)
+        {
+            auto state = p->getState();
+
+            if (state == Process::State::scanning && cancelling)
+            {
+                p->stop();
+                finishJob (*p, JobResult::cancelled);
+            }
+            else if (state == Process::State::gotResult)
+            {
+                finishJob (*p, JobResult::scanned);
+            }
+            else if (state == Process::State::crashed
+                      || (state == Process::State::scanning && p->hasTimedOut()))
+            {
+                finishJob (*p, JobResult::crashed);
+            }
+        }
+
+        bool allIdle = true;
+
+        for (auto& p : processes)
+        {
+            if (p->getState() == Process::State::idle)
+                startNextJob (*p);
+
+            allIdle = allIdle && p->getState() == Process::State::idle;
+        }
+
+        bool nothingToDo;
+
+        {
+            const ScopedLock sl (lock);
+            nothingToDo = allIdle && pendingJobs.empty();
+            pluginsBeingScanned.clearQuick();
+
+            for (auto& p : processes)
+                if (p->getState() != Process::State::idle)
+                    pluginsBeingScanned.add (p->currentJob.format->getNameOfPluginFromIdentifier (p->currentJob.fileOrIdentifier));
+        }
+
+        if (nothingToDo)
+        {
+            // the workers aren't needed until something else is queued
+            for (auto& p : processes)
+                p->stop();
+
+            if (cache != nullptr)
+                cache->saveIfNeeded();
+
+            list.scanFinished();
+            finishedEvent.signal();
+        }
+
+        wait (nothingToDo ? -1 : 100);
+    }
+}
+
+bool OutOfProcessPluginScanner::isAlreadyUpToDate (Job& job)
+{
+    if (list.getBlacklistedFiles().contains (job.fileOrIdentifier))
+        return true;
+
+    if (cache != nullptr)
+        job.fingerprint = PluginScanCache::createFingerprint (job.fileOrIdentifier);
+
+    if (! job.dontRescanIfAlreadyInList)
+        return false;
+
+    if (cache != nullptr)
+    {
+        Array<PluginDescription> types;
+
+        if (cache->getCachedTypes (job.format->getName(), job.fileOrIdentifier, types))
+        {
+            for (auto& type : types)
+                list.addType (type);
+
+            if (types.isEmpty())
+            {
+                const ScopedLock sl (lock);
+                failedFiles.add (job.fileOrIdentifier);
+            }
+
+            return true;
+        }
+    }
+
+    return list.isListingUpToDate (job.fileOrIdentifier, *job.format);
+}
+
+void OutOfProcessPluginScanner::startNextJob (Process& process)
+{
+    for (;;)
+    {
+        Job job;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (pendingJobs.empty())
+                return;
+
+            job = std::move (pendingJobs.front());
+            pendingJobs.pop_front();
+        }
+
+        if (! isAlreadyUpToDate (job))
+        {
+            if (process.start (job))
+                return;
+
+            // the worker couldn't be launched
+            jassertfalse;
+
+            const ScopedLock sl (lock);
+            failedFiles.add (job.fileOrIdentifier);
+            ++numJobsFinished;
+            return;
+        }
+
+        const ScopedLock sl (lock);
+        ++numJobsFinished;
+    }
+}
+
+void OutOfProcessPluginScanner::finishJob (Process& process, JobResult result)
+{
+    auto& job = process.currentJob;
+    auto formatName = job.format->getName();
+
+    if (result == JobResult::scanned)
+    {
+        auto types = process.takeResults();
+
+        for (auto& type : types)
+            list.addType (type);
+
+        if (cache != nullptr)
+            cache->addResult (formatName, job.fileOrIdentifier, job.fingerprint, types);
+
+        if (types.isEmpty())
+        {
+            const ScopedLock sl (lock);
+            failedFiles.add (job.fileOrIdentifier);
+        }
+    }
+    else if (result == JobResult::crashed)
+    {
+        // it crashed or hung, so start a new process for the next file
+        process.stop();
+        list.addToBlacklist (job.fileOrIdentifier);
+
+        if (cache != nullptr)
+            cache->removeResult (formatName, job.fileOrIdentifier);
+
+        const ScopedLock sl (lock);
+        crashedFiles.add (job.fileOrIdentifier);
+    }
+
+    const ScopedLock sl (lock);
+    ++numJobsFinished;
+}
+
+//==============================================================================
+// A plugin that hangs also stops the message thread, which is where the worker
+// would normally hear that it should quit, so this thread watches the clock instead.
+class OutOfProcessPluginScanner::Worker::Watchdog  : public Thread
+{
+public:
+    explicit Watchdog (std::atomic<uint32>& deadline)
+        : Thread ("Plugin scan watchdog"), scanDeadline (deadline)
+    {
+        startThread (Priority::low);
+    }
+
+    ~Watchdog() override
+    {
+        stopThread (1000);
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            auto deadline = scanDeadline.load();
+
+            // the coordinator will already have given up on this plugin
+            if (deadline != 0 && (int32) (Time::getMillisecondCounter() - deadline) > 0)
+                juce::Process::terminate();
+
+            wait (250);
+        }
+    }
+
+    std::atomic<uint32>& scanDeadline;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Watchdog)
+};
+
+OutOfProcessPluginScanner::Worker::Worker()
+{
+    formatManager.addDefaultFormats();
+}
+
+OutOfProcessPluginScanner::Worker::~Worker()
+{
+    cancelPendingUpdate();
+    watchdog.reset();
+}
+
+bool OutOfProcessPluginScanner::Worker::initialiseFromCommandLine (const String& commandLine,
+                                                                   const String& commandLineUniqueID)
+{
+    if (! ChildProcessWorker::initialiseFromCommandLine (commandLine, commandLineUniqueID))
+        return false;
+
+    watchdog = std::make_unique<Watchdog> (scanDeadline);
+    return true;
+}
+
+void OutOfProcessPluginScanner::Worker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    {
+        const ScopedLock sl (pendingLock);
+        pendingRequests.add (mb);
+    }
+
+    // Many formats can only be loaded on the message thread, so everything is scanned there
+    triggerAsyncUpdate();
+}
+
+void OutOfProcessPluginScanner::Worker::handleConnectionLost()
+{
+    // If a plugin has hung, the message thread will never get the chance to quit
+    if (scanDeadline != 0)
+        juce::Process::terminate();
+
+    JUCEApplicationBase::quit();
+}
+
+void OutOfProcessPluginScanner::Worker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        MemoryBlock request;
+
+        {
+            const ScopedLock sl (pendingLock);
+
+            if (pendingRequests.isEmpty())
+                return;
+
+            request = pendingRequests.removeAndReturn (0);
+        }
+
+        MemoryInputStream in (request, false);
+        auto formatName = in.readString();
+        auto fileOrIdentifier = in.readString();
+        auto timeoutMs = jmax (1, in.readInt());
+
+        OwnedArray<PluginDescription> found;
+
+        for (auto* format : formatManager.getFormats())
+        {
+            if (format->getName() == formatName)
+            {
+                // allow a little extra time, so that the coordinator notices first
+                scanDeadline = jmax ((uint32) 1, Time::getMillisecondCounter() + (uint32) timeoutMs + 2000);
+                format->findAllTypesForFile (found, fileOrIdentifier);
+                scanDeadline = 0;
+                break;
+            }
+        }
+
+        XmlElement xml ("LIST");
+
+        for (auto* desc : found)
+            xml.addChildElement (desc->createXml().release());
+
+        auto text = xml.toString (XmlElement::TextFormat().singleLine().withoutHeader());
+        sendMessageToCoordinator ({ text.toRawUTF8(), text.getNumBytesAsUTF8() });
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Scans plugins in a set of child processes, several at a time.
+
+    Each plugin file is loaded by one of a number of worker processes, so a plugin
+    that crashes or hangs can't take the host down with it, and scanning goes as many
+    times faster as there are processes. Because each process has its own message
+    thread, this works even for formats that can only be scanned on the message thread.
+
+    The worker processes are copies of an executable that you supply, which is usually
+    your own app. It must create an OutOfProcessPluginScanner::Worker at startup and call
+    its initialiseFromCommandLine() method, then carry on running its message loop,
+    e.g.
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginScanner::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine, "myPluginScanner"))
+        {
+            scanWorker = std::move (worker);
+            return;
+        }
+
+        // ..carry on starting up the app as normal
+    }
+    @endcode
+
+    The types that are found are added to a KnownPluginList as soon as each file has
+    been scanned, so the list's change messages can be used to show the results as they
+    arrive. A plugin whose process crashes, or takes longer than the timeout, is added to
+    the list's blacklist instead. If you give the scanner a PluginScanCache, files that
+    haven't changed since the last scan are taken from the cache without being loaded.
+
+    @see PluginScanCache, PluginListComponent::setOutOfProcessScanning, ChildProcessCoordinator
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner   : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param listToAddResultsTo       the list that will have the types that are found added to it
+        @param workerExecutable         the executable to launch for each worker process
+        @param commandLineUniqueID      a short alphanumeric ID that must match the one passed to
+                                        Worker::initialiseFromCommandLine()
+        @param numProcesses             the maximum number of worker processes to run at once
+        @param cacheToUse               an optional cache of earlier results, which must outlive
+                                        the scanner
+    */
+    OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo,
+                               const File& workerExecutable,
+                               const String& commandLineUniqueID,
+                               int numProcesses = SystemStats::getNumCpus(),
+                               PluginScanCache* cacheToUse = nullptr);
+
+    /** Destructor. This stops any scan that's in progress and closes the worker processes. */
+    ~OutOfProcessPluginScanner() override;
+
+    //==============================================================================
+    /** Adds some plugin files to the queue of things to scan.
+
+        The scan starts straight away, in the background. The format object must stay
+        valid until the scan has finished. The worker processes look for a format with
+        the same name in their own AudioPluginFormatManager.
+
+        If dontRescanIfAlreadyInList is true, files that are already in the list and
+        haven't been modified, or that are in the cache and haven't changed, are skipped.
+        Files in the list's blacklist are always skipped.
+
+        @see AudioPluginFormat::searchPathsForPlugins
+    */
+    void scan (AudioPluginFormat& format,
+               const StringArray& filesOrIdentifiersToScan,
+               bool dontRescanIfAlreadyInList = true);
+
+    /** Abandons any files that haven't been scanned yet.
+        The processes that were scanning are stopped, and the plugins they were scanning
+        aren't blacklisted.
+    */
+    void cancel();
+
+    /** Returns true if there's nothing left to scan. */
+    bool isFinished() const;
+
+    /** Waits until there's nothing left to scan.
+        Returns false if the timeout expired first.
+    */
+    bool waitUntilFinished (int timeOutMilliseconds = -1) const;
+
+    /** Returns the proportion of the files queued since the scanner was last idle that
+        have been dealt with, between 0 and 1.
+    */
+    float getProgress() const;
+
+    /** Sets the longest time that a plugin can take to scan before its process is
+        stopped and the plugin is blacklisted. The default is 2 minutes.
+    */
+    void setTimeoutForEachPlugin (int milliseconds);
+
+    /** Returns the names of the plugins that are being scanned at the moment. */
+    StringArray getPluginsBeingScanned() const;
+
+    /** Returns the files that were scanned without finding any types in them. */
+    StringArray getFailedFiles() const;
+
+    /** Returns the files that crashed or timed out, which have been blacklisted. */
+    StringArray getCrashedFiles() const;
+
+    //==============================================================================
+    /**
+        The part of an OutOfProcessPluginScanner that runs in each of the worker processes.
+
+        The files are scanned on the message thread, one at a time. If a plugin takes
+        longer than the scanner's timeout, the process terminates itself.
+
+        @tags{Audio}
+    */
+    class JUCE_API  Worker   : private ChildProcessWorker,
+                               private AsyncUpdater
+    {
+    public:
+        /** Creates a worker that can scan any of the formats that
+            AudioPluginFormatManager::addDefaultFormats() provides.
+        */
+        Worker();
+
+        /** Destructor. */
+        ~Worker() override;
+
+        /** Returns the formats that can be scanned, so that you can add your own. */
+        AudioPluginFormatManager& getFormatManager() noexcept      { return formatManager; }
+
+        /** Checks whether the command line was made by an OutOfProcessPluginScanner,
+            and if so, connects to it.
+
+            Returns true if this process is a worker and should stay running to do the
+            scanning. The process is quit when the scanner no longer needs it.
+        */
+        bool initialiseFromCommandLine (const String& commandLine, const String& commandLineUniqueID);
+
+    private:
+        void handleMessageFromCoordinator (const MemoryBlock&) override;
+        void handleConnectionLost() override;
+        void handleAsyncUpdate() override;
+
+        AudioPluginFormatManager formatManager;
+        CriticalSection pendingLock;
+        Array<MemoryBlock> pendingRequests;
+        std::atomic<uint32> scanDeadline { 0 };
+
+        class Watchdog;
+        std::unique_ptr<Watchdog> watchdog;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        AudioPluginFormat* format = nullptr;
+        String fileOrIdentifier;
+        bool dontRescanIfAlreadyInList = true;
+        PluginScanCache::Fingerprint fingerprint;
+    };
+
+    enum class JobResult
+    {
+        cancelled,
+        scanned,
+        crashed
+    };
+
+    class Process;
+    friend class Process;
+
+    void run() override;
+    bool isAlreadyUpToDate (Job&);
+    void startNextJob (Process&);
+    void finishJob (Process&, JobResult);
+
+    KnownPluginList& list;
+    PluginScanCache* const cache;
+    const File executable;
+    const String uniqueID;
+    std::vector<std::unique_ptr<Process>> processes;
+
+    CriticalSection lock;
+    std::deque<Job> pendingJobs;
+    StringArray failedFiles, crashedFiles, pluginsBeingScanned;
+    int numJobsQueued = 0, numJobsFinished = 0;
+    bool cancelRequested = false;
+    std::atomic<int> timeoutMs { 120000 };
+    WaitableEvent finishedEvent { true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
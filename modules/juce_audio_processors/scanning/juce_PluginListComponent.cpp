@@ -208,6 +208,15 @@ void PluginListComponent::setNumberOfThreadsForScanning (int num)
     numThreads = num;
 }
 
+void PluginListComponent::setOutOfProcessScanning (const File& workerExecutable, const String& commandLineUniqueID,
+                                                   int numProcesses, PluginScanCache* cacheToUse)
+{
+    scanWorkerExecutable = workerExecutable;
+    scanWorkerID = commandLineUniqueID;
+    numScanProcesses = numProcesses;
+    scanCache = cacheToUse;
+}
+
 void PluginListComponent::resized()
 {
     auto r = getLocalBounds().reduced (2);
@@ -402,7 +411,7 @@ public:
         FileSearchPath path (formatToScan.getDefaultLocationsToSearch());
 
         // You need to use at least one thread when scanning plug-ins asynchronously
-        jassert (! allowAsync || (numThreads > 0));
+        jassert (! allowAsync || (numThreads > 0) || (owner.numScanProcesses > 0));
 
         // If the filesOrIdentifiersToScan argument isn't empty, we should only scan these
         // If the path is empty, then paths aren't used for this format.
@@ -446,6 +455,7 @@ private:
     StringArray filesOrIdentifiersToScan;
     PropertiesFile* propertiesToUse;
     std::unique_ptr<PluginDirectoryScanner> scanner;
+    std::unique_ptr<OutOfProcessPluginScanner> outOfProcessScanner;
     AlertWindow pathChooserWindow, progressWindow;
     FileSearchPathListComponent pathList;
     String pluginBeingScanned;
@@ -536,14 +546,26 @@ private:
     {
         pathChooserWindow.setVisible (false);
 
-        scanner.reset (new PluginDirectoryScanner (owner.list, formatToScan, pathList.getPath(),
-                                                   true, owner.deadMansPedalFile, allowAsync));
+        if (owner.numScanProcesses > 0)
+        {
+            outOfProcessScanner.reset (new OutOfProcessPluginScanner (owner.list, owner.scanWorkerExecutable,
+                                                                      owner.scanWorkerID, owner.numScanProcesses,
+                                                                      owner.scanCache));
 
-        if (! filesOrIdentifiersToScan.isEmpty())
+            outOfProcessScanner->scan (formatToScan, filesOrIdentifiersToScan.isEmpty()
+                                                        ? formatToScan.searchPathsForPlugins (pathList.getPath(), true, allowAsync)
+                                                        : filesOrIdentifiersToScan);
+        }
+        else
         {
-            scanner->setFilesOrIdentifiersToScan (filesOrIdentifiersToScan);
+            scanner.reset (new PluginDirectoryScanner (owner.list, formatToScan, pathList.getPath(),
+                                                       true, owner.deadMansPedalFile, allowAsync));
+
+            if (! filesOrIdentifiersToScan.isEmpty())
+                scanner->setFilesOrIdentifiersToScan (filesOrIdentifiersToScan);
         }
-        else if (propertiesToUse != nullptr)
+
+        if (filesOrIdentifiersToScan.isEmpty() && propertiesToUse != nullptr)
         {
             setLastSearchPath (*propertiesToUse, formatToScan, pathList.getPath());
             propertiesToUse->saveIfNeeded();
@@ -553,7 +575,7 @@ private:
         progressWindow.addProgressBarComponent (progress);
         progressWindow.enterModalState();
 
-        if (numThreads > 0)
+        if (numThreads > 0 && scanner != nullptr)
         {
             pool.reset (new ThreadPool (numThreads));
 
@@ -574,8 +596,10 @@ private:
                              initiallyBlacklistedFiles.begin(), initiallyBlacklistedFiles.end(),
                              std::back_inserter (newBlacklistedFiles));
 
-        owner.scanFinished (scanner != nullptr ? scanner->getFailedFiles() : StringArray(),
-                            newBlacklistedFiles);
+        auto failedFiles = outOfProcessScanner != nullptr ? outOfProcessScanner->getFailedFiles()
+                                                          : (scanner != nullptr ? scanner->getFailedFiles() : StringArray());
+
+        owner.scanFinished (failedFiles, newBlacklistedFiles);
     }
 
     void timerCallback() override
@@ -583,9 +607,20 @@ private:
         if (timerReentrancyCheck)
             return;
 
-        progress = scanner->getProgress();
+        if (outOfProcessScanner != nullptr)
+        {
+            progress = outOfProcessScanner->getProgress();
+            pluginBeingScanned = outOfProcessScanner->getPluginsBeingScanned().joinIntoString (", ");
+
+            if (outOfProcessScanner->isFinished())
+                finished = true;
+        }
+        else
+        {
+            progress = scanner->getProgress();
+        }
 
-        if (pool == nullptr)
+        if (pool == nullptr && scanner != nullptr)
         {
             const ScopedValueSetter<bool> setter (timerReentrancyCheck, true);
 
@@ -76,6 +76,18 @@ public:
      be zero (it is one by default). */
     void setNumberOfThreadsForScanning (int numThreads);
 
+    /** Makes scans load the plugins in a set of separate processes, using an
+        OutOfProcessPluginScanner, so that a plugin which crashes can't bring down the app.
+
+        The executable must create an OutOfProcessPluginScanner::Worker when it starts up,
+        using the same commandLineUniqueID. If a cache is given, it must outlive this
+        component. Passing 0 for numProcesses goes back to scanning inside this process.
+    */
+    void setOutOfProcessScanning (const File& workerExecutable,
+                                  const String& commandLineUniqueID,
+                                  int numProcesses,
+                                  PluginScanCache* cacheToUse = nullptr);
+
     /** Returns the last search path stored in a given properties file for the specified format. */
     static FileSearchPath getLastSearchPath (PropertiesFile&, AudioPluginFormat&);
 
@@ -123,6 +135,10 @@ private:
     String dialogTitle, dialogText;
     bool allowAsync;
     int numThreads;
+    File scanWorkerExecutable;
+    String scanWorkerID;
+    int numScanProcesses = 0;
+    PluginScanCache* scanCache = nullptr;
 
     class TableModel;
     std::unique_ptr<TableListBoxModel> tableModel;
@@ -0,0 +1,400 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace PluginScanCacheHelpers
+{
+    static uint64 hashBytes (uint64 hash, const void* data, size_t numBytes) noexcept
+    {
+        // FNV-1a
+        for (auto* p = static_cast<const uint8*> (data); numBytes > 0; --numBytes)
+            hash = (hash ^ *p++) * 0x100000001b3ULL;
+
+        return hash;
+    }
+
+    static uint64 hashString (uint64 hash, const String& s) noexcept
+    {
+        return hashBytes (hash, s.toRawUTF8(), s.getNumBytesAsUTF8());
+    }
+
+    static uint64 hashValue (uint64 hash, int64 value) noexcept
+    {
+        return hashBytes (hash, &value, sizeof (value));
+    }
+
+    static constexpr uint64 initialHash = 0xcbf29ce484222325ULL;
+
+    static uint64 hashStartAndEndOfFile (const File& file, int64 fileSize)
+    {
+        constexpr int64 chunkSize = 65536;
+        auto hash = initialHash;
+        FileInputStream in (file);
+
+        if (in.openedOk())
+        {
+            HeapBlock<char> buffer (chunkSize);
+
+            for (auto position : { (int64) 0, jmax (chunkSize, fileSize - chunkSize) })
+            {
+                if (position >= fileSize || ! in.setPosition (position))
+                    break;
+
+                auto numRead = in.read (buffer, (int) chunkSize);
+
+                if (numRead > 0)
+                    hash = hashBytes (hash, buffer, (size_t) numRead);
+            }
+        }
+
+        return hash;
+    }
+}
+
+//==============================================================================
+PluginScanCache::PluginScanCache() = default;
+
+PluginScanCache::PluginScanCache (const File& fileToStoreCacheIn)
+    : file (fileToStoreCacheIn)
+{
+    if (auto xml = parseXML (file))
+        restoreFromXml (*xml);
+
+    needsToBeSaved = false;
+}
+
+PluginScanCache::~PluginScanCache()
+{
+    saveIfNeeded();
+}
+
+//==============================================================================
+PluginScanCache::Fingerprint PluginScanCache::createFingerprint (const String& fileOrIdentifier)
+{
+    using namespace PluginScanCacheHelpers;
+
+    Fingerprint result;
+
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return result;
+
+    File f (fileOrIdentifier);
+
+    if (f.isDirectory())
+    {
+        result.modificationTime = f.getLastModificationTime().toMilliseconds();
+
+        // The files may be found in any order, so the hashes of each file are just added together
+        for (const auto& entry : RangedDirectoryIterator (f, true, "*", File::findFiles))
+        {
+            auto size = entry.getFileSize();
+            auto modTime = entry.getModificationTime().toMilliseconds();
+
+            result.size += size;
+            result.modificationTime = jmax (result.modificationTime, modTime);
+            result.hash += hashValue (hashValue (hashString (initialHash, entry.getFile().getRelativePathFrom (f)),
+                                                 size),
+                                      modTime);
+        }
+    }
+    else if (f.existsAsFile())
+    {
+        result.size = f.getSize();
+        result.modificationTime = f.getLastModificationTime().toMilliseconds();
+        result.hash = hashStartAndEndOfFile (f, result.size);
+    }
+
+    return result;
+}
+
+//==============================================================================
+String PluginScanCache::getKey (const String& formatName, const String& fileOrIdentifier)
+{
+    return formatName + ":" + fileOrIdentifier;
+}
+
+bool PluginScanCache::getCachedTypes (const String& formatName,
+                                      const String& fileOrIdentifier,
+                                      Array<PluginDescription>& typesFound) const
+{
+    Fingerprint storedFingerprint;
+
+    {
+        const ScopedLock sl (lock);
+        auto entry = entries.find (getKey (formatName, fileOrIdentifier));
+
+        if (entry == entries.end())
+            return false;
+
+        storedFingerprint = entry->second.fingerprint;
+        typesFound = entry->second.types;
+    }
+
+    // look at the file without holding the lock, as it can take a while
+    if (createFingerprint (fileOrIdentifier) == storedFingerprint)
+        return true;
+
+    typesFound.clearQuick();
+    return false;
+}
+
+void PluginScanCache::addResult (const String& formatName,
+                                 const String& fileOrIdentifier,
+                                 const Fingerprint& fingerprintBeforeScanning,
+                                 const Array<PluginDescription>& typesFound)
+{
+    if (! fingerprintBeforeScanning.isValid())
+        return;
+
+    const ScopedLock sl (lock);
+    entries[getKey (formatName, fileOrIdentifier)] = { fingerprintBeforeScanning, typesFound };
+    needsToBeSaved = true;
+}
+
+void PluginScanCache::removeResult (const String& formatName, const String& fileOrIdentifier)
+{
+    const ScopedLock sl (lock);
+
+    if (entries.erase (getKey (formatName, fileOrIdentifier)) > 0)
+        needsToBeSaved = true;
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+
+    if (! entries.empty())
+    {
+        entries.clear();
+        needsToBeSaved = true;
+    }
+}
+
+int PluginScanCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+std::unique_ptr<XmlElement> PluginScanCache::createXml() const
+{
+    auto xml = std::make_unique<XmlElement> ("PLUGINSCANCACHE");
+
+    const ScopedLock sl (lock);
+
+    for (auto& item : entries)
+    {
+        auto* e = xml->createNewChildElement ("FILE");
+        e->setAttribute ("key", item.first);
+        e->setAttribute ("size", String (item.second.fingerprint.size));
+        e->setAttribute ("modified", String (item.second.fingerprint.modificationTime));
+        e->setAttribute ("hash", String::toHexString ((int64) item.second.fingerprint.hash));
+
+        for (auto& type : item.second.types)
+            e->addChildElement (type.createXml().release());
+    }
+
+    return xml;
+}
+
+void PluginScanCache::restoreFromXml (const XmlElement& xml)
+{
+    const ScopedLock sl (lock);
+
+    entries.clear();
+    needsToBeSaved = true;
+
+    if (! xml.hasTagName ("PLUGINSCANCACHE"))
+        return;
+
+    for (auto* e : xml.getChildWithTagNameIterator ("FILE"))
+    {
+        Entry entry;
+        entry.fingerprint.size = e->getStringAttribute ("size").getLargeIntValue();
+        entry.fingerprint.modificationTime = e->getStringAttribute ("modified").getLargeIntValue();
+        entry.fingerprint.hash = (uint64) e->getStringAttribute ("hash").getHexValue64();
+
+        for (auto* typeXml : e->getChildIterator())
+        {
+            PluginDescription desc;
+
+            if (desc.loadFromXml (*typeXml))
+                entry.types.add (desc);
+        }
+
+        entries[e->getStringAttribute ("key")] = std::move (entry);
+    }
+}
+
+bool PluginScanCache::saveIfNeeded()
+{
+    {
+        const ScopedLock sl (lock);
+
+        if (! needsToBeSaved || file == File())
+            return true;
+
+        needsToBeSaved = false;
+    }
+
+    if (createXml()->writeTo (file))
+        return true;
+
+    const ScopedLock sl (lock);
+    needsToBeSaved = true;
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PluginScanCacheTests  : public UnitTest
+{
+public:
+    PluginScanCacheTests()
+        : UnitTest ("PluginScanCache", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        auto folder = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("PluginScanCacheTests", {});
+        folder.createDirectory();
+
+        auto pluginFile = folder.getChildFile ("Plugin.dll");
+        auto bundle = folder.getChildFile ("Plugin.vst3");
+        pluginFile.replaceWithText ("plugin binary");
+        auto bundleBinary = bundle.getChildFile ("Contents/x86_64-win/Plugin.vst3");
+        bundleBinary.getParentDirectory().createDirectory();
+        bundleBinary.replaceWithText ("bundle binary");
+
+        auto desc = makeDescription ("Test Plugin", pluginFile);
+
+        beginTest ("Fingerprints");
+        {
+            expect (! PluginScanCache::createFingerprint ("com.example.NotAFile").isValid());
+            expect (! PluginScanCache::createFingerprint (folder.getChildFile ("missing").getFullPathName()).isValid());
+
+            for (auto& f : { pluginFile, bundle })
+            {
+                auto fingerprint = PluginScanCache::createFingerprint (f.getFullPathName());
+                expect (fingerprint.isValid());
+                expect (fingerprint == PluginScanCache::createFingerprint (f.getFullPathName()));
+            }
+
+            auto before = PluginScanCache::createFingerprint (bundle.getFullPathName());
+            auto modTime = bundleBinary.getLastModificationTime();
+            bundleBinary.replaceWithText ("a new bundle binary");
+            bundleBinary.setLastModificationTime (modTime);
+            expect (before != PluginScanCache::createFingerprint (bundle.getFullPathName()));
+
+            // the same size and modification time, but different contents
+            before = PluginScanCache::createFingerprint (pluginFile.getFullPathName());
+            modTime = pluginFile.getLastModificationTime();
+            pluginFile.replaceWithText ("plugin BINARY");
+            pluginFile.setLastModificationTime (modTime);
+            expect (before != PluginScanCache::createFingerprint (pluginFile.getFullPathName()));
+        }
+
+        beginTest ("Cached results");
+        {
+            PluginScanCache cache;
+            Array<PluginDescription> found;
+
+            expect (! cache.getCachedTypes ("VST3", pluginFile.getFullPathName(), found));
+
+            cache.addResult ("VST3", pluginFile.getFullPathName(),
+                             PluginScanCache::createFingerprint (pluginFile.getFullPathName()), { desc });
+            cache.addResult ("VST3", bundle.getFullPathName(),
+                             PluginScanCache::createFingerprint (bundle.getFullPathName()), {});
+            cache.addResult ("AudioUnit", "com.example.NotAFile", PluginScanCache::createFingerprint ("com.example.NotAFile"), { desc });
+            expectEquals (cache.getNumEntries(), 2);
+
+            expect (cache.getCachedTypes ("VST3", pluginFile.getFullPathName(), found));
+            expectEquals (found.size(), 1);
+            expect (found.getReference (0).isDuplicateOf (desc));
+
+            expect (cache.getCachedTypes ("VST3", bundle.getFullPathName(), found));
+            expect (found.isEmpty());
+
+            expect (! cache.getCachedTypes ("VST", pluginFile.getFullPathName(), found));
+
+            pluginFile.replaceWithText ("an updated plugin binary");
+            expect (! cache.getCachedTypes ("VST3", pluginFile.getFullPathName(), found));
+            expect (found.isEmpty());
+
+            cache.removeResult ("VST3", bundle.getFullPathName());
+            expect (! cache.getCachedTypes ("VST3", bundle.getFullPathName(), found));
+        }
+
+        beginTest ("Saving and loading");
+        {
+            auto cacheFile = folder.getChildFile ("cache.xml");
+
+            {
+                PluginScanCache cache (cacheFile);
+                cache.addResult ("VST3", pluginFile.getFullPathName(),
+                                 PluginScanCache::createFingerprint (pluginFile.getFullPathName()), { desc });
+            }
+
+            expect (cacheFile.existsAsFile());
+
+            PluginScanCache cache (cacheFile);
+            Array<PluginDescription> found;
+            expectEquals (cache.getNumEntries(), 1);
+            expect (cache.getCachedTypes ("VST3", pluginFile.getFullPathName(), found));
+            expectEquals (found.size(), 1);
+            expect (found.getReference (0).name == desc.name);
+            expect (found.getReference (0).fileOrIdentifier == desc.fileOrIdentifier);
+
+            cacheFile.deleteFile();
+            expect (cache.saveIfNeeded());
+            expect (! cacheFile.exists());
+        }
+
+        folder.deleteRecursively();
+    }
+
+private:
+    static PluginDescription makeDescription (const String& name, const File& f)
+    {
+        PluginDescription desc;
+        desc.name = desc.descriptiveName = name;
+        desc.pluginFormatName = "VST3";
+        desc.fileOrIdentifier = f.getFullPathName();
+        desc.manufacturerName = "JUCE";
+        desc.uniqueId = desc.deprecatedUid = 1234;
+        return desc;
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
+} // namespace juce
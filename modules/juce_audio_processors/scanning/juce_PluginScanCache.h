@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Remembers the results of scanning plugin files, so that files which haven't
+    changed don't need to be scanned again.
+
+    Each entry records the plugin types that were found in a file, along with a
+    fingerprint of the file made from its size, its modification time and a hash of
+    some of its contents. While the fingerprint of a file still matches, its stored
+    types can be used instead of loading the plugin.
+
+    If you give it a file, the cache will be loaded from it when it's created and
+    saved back when it's deleted. All the methods are thread-safe.
+
+    @see OutOfProcessPluginScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Creates an empty cache that isn't stored anywhere. */
+    PluginScanCache();
+
+    /** Creates a cache that's loaded from and saved to the given file. */
+    explicit PluginScanCache (const File& fileToStoreCacheIn);
+
+    /** Destructor. If the cache has a file and has been changed, it's saved. */
+    ~PluginScanCache();
+
+    //==============================================================================
+    /** Identifies a particular version of a plugin file or bundle. */
+    struct Fingerprint
+    {
+        int64 size = 0;
+        int64 modificationTime = 0;
+        uint64 hash = 0;
+
+        /** Returns false if the file didn't exist when the fingerprint was made. */
+        bool isValid() const noexcept       { return modificationTime != 0; }
+
+        bool operator== (const Fingerprint& other) const noexcept
+        {
+            return size == other.size && modificationTime == other.modificationTime && hash == other.hash;
+        }
+
+        bool operator!= (const Fingerprint& other) const noexcept   { return ! operator== (other); }
+    };
+
+    /** Makes a fingerprint of a plugin's file.
+
+        For an ordinary file, this uses its size, modification time, and a hash of its
+        first and last 64KB. For a bundle, it uses the names, sizes and modification
+        times of all the files inside it, which doesn't involve reading any of them.
+        If the identifier isn't a file that exists, an invalid fingerprint is returned.
+    */
+    static Fingerprint createFingerprint (const String& fileOrIdentifier);
+
+    //==============================================================================
+    /** Looks for the types that were found in a file the last time it was scanned.
+
+        This returns true and fills in the array if there's an entry for the file and
+        its fingerprint still matches. The array may be empty if the file was scanned
+        but didn't contain any plugins that could be loaded.
+    */
+    bool getCachedTypes (const String& formatName,
+                         const String& fileOrIdentifier,
+                         Array<PluginDescription>& typesFound) const;
+
+    /** Records the types that were found by scanning a file.
+
+        The fingerprint should have been made before the file was scanned, so that if it
+        changes during the scan, it'll be scanned again next time. If the fingerprint
+        isn't valid, nothing is stored.
+    */
+    void addResult (const String& formatName,
+                    const String& fileOrIdentifier,
+                    const Fingerprint& fingerprintBeforeScanning,
+                    const Array<PluginDescription>& typesFound);
+
+    /** Removes the entry for a file, if there is one. */
+    void removeResult (const String& formatName, const String& fileOrIdentifier);
+
+    /** Removes all the entries. */
+    void clear();
+
+    /** Returns the number of files in the cache. */
+    int getNumEntries() const;
+
+    //==============================================================================
+    /** Creates some XML that holds the contents of the cache. */
+    std::unique_ptr<XmlElement> createXml() const;
+
+    /** Replaces the contents of the cache with some XML made by createXml(). */
+    void restoreFromXml (const XmlElement&);
+
+    /** Saves the cache to its file, if it has one and has been changed.
+        Returns false if it couldn't be written.
+    */
+    bool saveIfNeeded();
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        Fingerprint fingerprint;
+        Array<PluginDescription> types;
+    };
+
+    static String getKey (const String& formatName, const String& fileOrIdentifier);
+
+    File file;
+    std::map<String, Entry> entries;
+    bool needsToBeSaved = false;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
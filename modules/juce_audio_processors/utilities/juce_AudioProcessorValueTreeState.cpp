@@ -112,6 +112,12 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
+    void setChangeCallback (AudioProcessorValueTreeState& owner, size_t index)
+    {
+        changeCallbackOwner = &owner;
+        changeCallbackIndex = index;
+    }
+
     bool flushToTree (const Identifier& key, UndoManager* um)
     {
         auto needsUpdateTestValue = true;
@@ -151,6 +157,9 @@ private:
         listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
         needsUpdate = true;
+
+        if (changeCallbackOwner != nullptr)
+            changeCallbackOwner->parameterValueChanged (changeCallbackIndex);
     }
 
     float denormalise (float normalised) const
@@ -203,8 +212,52 @@ private:
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
     bool ignoreParameterChangedCallbacks { false };
+    AudioProcessorValueTreeState* changeCallbackOwner = nullptr;
+    size_t changeCallbackIndex = 0;
 };
 
+//==============================================================================
+void AudioProcessorValueTreeState::ChangedParameterFlags::setNumParameters (size_t numParameters)
+{
+    const auto newNumWords = (numParameters + 63) / 64;
+
+    if (newNumWords != numWords)
+    {
+        std::unique_ptr<std::atomic<uint64>[]> newWords (new std::atomic<uint64>[newNumWords]);
+
+        for (size_t i = 0; i < newNumWords; ++i)
+            newWords[i] = i < numWords ? words[i].load() : 0;
+
+        words = std::move (newWords);
+        numWords = newNumWords;
+    }
+
+    // Parameters start off flagged as changed, so that they get picked up the first time through
+    for (auto i = numFlags; i < numParameters; ++i)
+        markChanged (i);
+
+    numFlags = numParameters;
+}
+
+void AudioProcessorValueTreeState::ChangedParameterFlags::markChanged (size_t index) noexcept
+{
+    jassert (index / 64 < numWords);
+    words[index / 64].fetch_or ((uint64) 1 << (index % 64));
+}
+
+template <typename Callback>
+void AudioProcessorValueTreeState::ChangedParameterFlags::takeChanged (Callback&& callback) noexcept
+{
+    for (size_t i = 0; i < numWords; ++i)
+    {
+        if (words[i].load (std::memory_order_relaxed) == 0)
+            continue;
+
+        for (auto bits = words[i].exchange (0); bits != 0; bits &= bits - 1)
+            callback (i * 64 + (size_t) countNumberOfBits ((bits & (~bits + 1)) - 1));
+    }
+}
+
 //==============================================================================
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& processorToConnectTo,
                                                             UndoManager* undoManagerToUse,
@@ -327,7 +380,20 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    const auto inserted = adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+
+    if (! inserted.second)
+        return;
+
+    auto& adapter = *inserted.first->second;
+    const auto index = adapterList.size();
+
+    adapterList.push_back (&adapter);
+    snapshot.push_back (adapter.getDenormalisedValue());
+    parametersToFlushToTree.setNumParameters (adapterList.size());
+    parametersToCopyToSnapshot.setNumParameters (adapterList.size());
+
+    adapter.setChangeCallback (*this, index);
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -381,6 +447,30 @@ std::atomic<float>* AudioProcessorValueTreeState::getRawParameterValue (StringRe
     return nullptr;
 }
 
+int AudioProcessorValueTreeState::getParameterSnapshotIndex (StringRef paramID) const noexcept
+{
+    if (auto* p = getParameterAdapter (paramID))
+        return (int) std::distance (adapterList.begin(), std::find (adapterList.begin(), adapterList.end(), p));
+
+    return -1;
+}
+
+const float* AudioProcessorValueTreeState::updateParameterSnapshot() noexcept
+{
+    parametersToCopyToSnapshot.takeChanged ([this] (size_t index)
+    {
+        snapshot[index] = adapterList[index]->getDenormalisedValue();
+    });
+
+    return snapshot.data();
+}
+
+void AudioProcessorValueTreeState::parameterValueChanged (size_t adapterIndex) noexcept
+{
+    parametersToFlushToTree.markChanged (adapterIndex);
+    parametersToCopyToSnapshot.markChanged (adapterIndex);
+}
+
 ValueTree AudioProcessorValueTreeState::copyState()
 {
     ScopedLock lock (valueTreeChanging);
@@ -398,6 +488,24 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+void AudioProcessorValueTreeState::getStateInformation (MemoryBlock& destData)
+{
+    ScopedLock lock (valueTreeChanging);
+    flushParameterValuesToValueTree();
+    AudioProcessor::copyValueTreeToBinary (state, destData);
+}
+
+bool AudioProcessorValueTreeState::setStateInformation (const void* data, int sizeInBytes)
+{
+    auto newState = AudioProcessor::getValueTreeFromBinary (data, sizeInBytes);
+
+    if (! newState.isValid() || ! newState.hasType (state.getType()))
+        return false;
+
+    replaceState (newState);
+    return true;
+}
+
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -416,8 +524,14 @@ void AudioProcessorValueTreeState::updateParameterConnectionsToChildTrees()
     for (auto& p : adapterTable)
         p.second->tree = ValueTree();
 
-    for (const auto& child : state)
-        setNewState (child);
+    {
+        // A new state can change every parameter, so the hosts and listeners are told about
+        // them all at once
+        const AudioProcessor::ScopedParameterChangeBatch batch (processor);
+
+        for (const auto& child : state)
+            setNewState (child);
+    }
 
     for (auto& p : adapterTable)
     {
@@ -458,8 +572,11 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 
     bool anyUpdated = false;
 
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
+    // Only the parameters that have changed since the last flush need to be visited
+    parametersToFlushToTree.takeChanged ([&] (size_t index)
+    {
+        anyUpdated |= adapterList[index]->flushToTree (valuePropertyID, undoManager);
+    });
 
     return anyUpdated;
 }
@@ -834,6 +951,40 @@ public:
             expectEquals (proc.state.getRawParameterValue (key)->load(), value);
         }
 
+        beginTest ("The parameter snapshot contains default values in the order parameters were added");
+        {
+            TestAudioProcessor proc;
+            proc.state.createAndAddParameter (std::make_unique<Parameter> ("a", String(), NormalisableRange<float> (0.0f, 10.0f), 2.0f));
+            proc.state.createAndAddParameter (std::make_unique<Parameter> ("b", String(), NormalisableRange<float> (0.0f, 10.0f), 7.0f));
+
+            expectEquals (proc.state.getNumParametersInSnapshot(), 2);
+            expectEquals (proc.state.getParameterSnapshotIndex ("a"), 0);
+            expectEquals (proc.state.getParameterSnapshotIndex ("b"), 1);
+            expectEquals (proc.state.getParameterSnapshotIndex ("c"), -1);
+
+            const auto* snapshot = proc.state.updateParameterSnapshot();
+            expectEquals (snapshot[0], 2.0f);
+            expectEquals (snapshot[1], 7.0f);
+        }
+
+        beginTest ("After setting a parameter value, that value is reflected in the snapshot and the tree");
+        {
+            TestAudioProcessor proc;
+            proc.state.createAndAddParameter (std::make_unique<Parameter> ("a", String(), NormalisableRange<float> (0.0f, 10.0f), 2.0f));
+            const auto param = proc.state.createAndAddParameter (std::make_unique<Parameter> ("b", String(), NormalisableRange<float> (0.0f, 10.0f), 7.0f));
+            proc.state.state = ValueTree { "state" };
+
+            proc.state.updateParameterSnapshot();
+            param->setValueNotifyingHost (0.5f);
+
+            const auto* snapshot = proc.state.updateParameterSnapshot();
+            expectEquals (snapshot[0], 2.0f);
+            expectEquals (snapshot[1], 5.0f);
+
+            const auto tree = proc.state.copyState();
+            expectEquals ((float) tree.getChildWithProperty ("id", "b").getProperty ("value"), 5.0f);
+        }
+
         beginTest ("After adding an APVTS::Parameter, its value is the default value");
         {
             TestAudioProcessor proc;
@@ -981,6 +1132,45 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("A state stored with getStateInformation can be restored");
+        {
+            auto createLayout = []
+            {
+                ParameterLayout layout;
+                layout.add (std::make_unique<AudioParameterFloat> ("a", "a", NormalisableRange<float> (0.0f, 10.0f), 2.0f),
+                            std::make_unique<AudioParameterInt> ("b", "b", 0, 100, 50));
+                return layout;
+            };
+
+            TestAudioProcessor source (createLayout());
+            source.state.getParameter ("a")->setValueNotifyingHost (0.75f);
+            source.state.getParameter ("b")->setValueNotifyingHost (0.25f);
+            source.state.state.setProperty ("extra", "hello", nullptr);
+
+            MemoryBlock data;
+            source.state.getStateInformation (data);
+
+            TestAudioProcessor dest (createLayout());
+            expect (dest.state.setStateInformation (data.getData(), (int) data.getSize()));
+            expect (dest.state.state.isEquivalentTo (source.state.copyState()));
+            expectEquals (dest.state.getRawParameterValue ("a")->load(), 7.5f);
+            expectEquals (dest.state.getRawParameterValue ("b")->load(), 25.0f);
+
+            MemoryBlock xmlData;
+            AudioProcessor::copyXmlToBinary (*source.state.copyState().createXml(), xmlData);
+
+            TestAudioProcessor fromXml (createLayout());
+            expect (fromXml.state.setStateInformation (xmlData.getData(), (int) xmlData.getSize()));
+            expectEquals (fromXml.state.getRawParameterValue ("a")->load(), 7.5f);
+            expectEquals (fromXml.state.state.getProperty ("extra").toString(), String ("hello"));
+
+            MemoryBlock otherType;
+            AudioProcessor::copyValueTreeToBinary (ValueTree ("other"), otherType);
+            expect (! dest.state.setStateInformation (otherType.getData(), (int) otherType.getSize()));
+            expect (! dest.state.setStateInformation (data.getData(), 5));
+            expectEquals (dest.state.getRawParameterValue ("a")->load(), 7.5f);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
@@ -334,6 +334,31 @@ public:
     */
     std::atomic<float>* getRawParameterValue (StringRef parameterID) const noexcept;
 
+    //==============================================================================
+    /** Returns the position of a parameter in the array returned by updateParameterSnapshot(),
+        or -1 if there's no parameter with this ID.
+
+        Parameters are numbered in the order in which they were added. Look up the indices
+        you need once, e.g. in prepareToPlay(), rather than on every block.
+    */
+    int getParameterSnapshotIndex (StringRef parameterID) const noexcept;
+
+    /** Returns the number of values in the array returned by updateParameterSnapshot(). */
+    int getNumParametersInSnapshot() const noexcept     { return (int) adapterList.size(); }
+
+    /** Brings the parameter snapshot up to date and returns it.
+
+        The snapshot is a contiguous array holding the denormalised value of every
+        parameter, indexed by getParameterSnapshotIndex(). Only the parameters that have
+        changed since the previous call are copied into it, so it's cheap to call this
+        once at the start of each processBlock(), after which the values in the array
+        won't change for the rest of the block.
+
+        This is realtime-safe, but it must only ever be called by one thread at a time,
+        which will normally be the audio thread.
+    */
+    const float* updateParameterSnapshot() noexcept;
+
     //==============================================================================
     /** A listener class that can be attached to an AudioProcessorValueTreeState.
         Use AudioProcessorValueTreeState::addParameterListener() to register a callback.
@@ -392,6 +417,28 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    /** Stores the state in a block of memory.
+
+        This flushes any pending parameter updates, like copyState(), but then writes the
+        tree straight into the block with AudioProcessor::copyValueTreeToBinary() rather
+        than making a copy of it first. You can call this from your processor's
+        getStateInformation() method, and use setStateInformation() to restore it.
+
+        The same threading rules apply as for copyState().
+    */
+    void getStateInformation (MemoryBlock& destData);
+
+    /** Restores a state that was stored with getStateInformation().
+
+        This will also accept a state that was stored as XML using
+        AudioProcessor::copyXmlToBinary(). The state is only replaced if the data can be
+        read and its type matches the type of the current state, and the return value
+        indicates whether this happened.
+
+        The same threading rules apply as for replaceState().
+    */
+    bool setStateInformation (const void* data, int sizeInBytes);
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -648,7 +695,30 @@ private:
         bool operator() (StringRef a, StringRef b) const noexcept { return a.text.compare (b.text) < 0; }
     };
 
+    /*  One bit per parameter, which is set whenever the parameter changes. Setting and
+        taking the bits is lock-free, but the number of bits may only be changed while
+        the parameters are being created.
+    */
+    class ChangedParameterFlags
+    {
+    public:
+        void setNumParameters (size_t numParameters);
+        void markChanged (size_t index) noexcept;
+
+        template <typename Callback>
+        void takeChanged (Callback&& callback) noexcept;
+
+    private:
+        std::unique_ptr<std::atomic<uint64>[]> words;
+        size_t numWords = 0, numFlags = 0;
+    };
+
+    void parameterValueChanged (size_t adapterIndex) noexcept;
+
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
+    std::vector<ParameterAdapter*> adapterList;
+    ChangedParameterFlags parametersToFlushToTree, parametersToCopyToSnapshot;
+    std::vector<float> snapshot;
 
     CriticalSection valueTreeChanging;
 
@@ -28,6 +28,15 @@
 namespace juce
 {
 
+/*  Holds a few bits of flags for each of a number of items, which can be set from
+    any thread and collected from another.
+
+    As well as the flags themselves, there's a summary bit for each word of flags,
+    which is set whenever anything in that word is set. That means ifSet() only has
+    to look at the words that have changed, so collecting the changes costs
+    roughly the same for a plugin with thousands of parameters as for one with a
+    handful, as long as only a few of them change at a time.
+*/
 template <size_t requiredFlagBitsPerItem>
 class FlagCache
 {
@@ -37,9 +46,10 @@ public:
     FlagCache() = default;
 
     explicit FlagCache (size_t items)
-        : flags (divCeil (items, groupsPerWord))
+        : flags (divCeil (items, groupsPerWord)),
+          summary (divCeil (flags.size(), bitsPerWord))
     {
-        std::fill (flags.begin(), flags.end(), 0);
+        clear();
     }
 
     void set (size_t index, FlagType bits)
@@ -47,7 +57,16 @@ public:
         const auto flagIndex = index / groupsPerWord;
         jassert (flagIndex < flags.size());
         const auto groupIndex = index - (flagIndex * groupsPerWord);
-        flags[flagIndex].fetch_or (moveToGroupPosition (bits, groupIndex), std::memory_order_acq_rel);
+        const auto groupedBits = moveToGroupPosition (bits, groupIndex);
+
+        if (groupedBits == 0)
+            return;
+
+        flags[flagIndex].fetch_or (groupedBits, std::memory_order_acq_rel);
+
+        // This must come after the flags are set, so that a reader that sees the summary
+        // bit is guaranteed to find the flags
+        summary[flagIndex / bitsPerWord].fetch_or ((FlagType) 1 << (flagIndex % bitsPerWord), std::memory_order_acq_rel);
     }
 
     /*  Calls the supplied callback for any entries with non-zero flags, and
@@ -56,16 +75,21 @@ public:
     template <typename Callback>
     void ifSet (Callback&& callback)
     {
-        for (size_t flagIndex = 0; flagIndex < flags.size(); ++flagIndex)
+        for (size_t summaryIndex = 0; summaryIndex < summary.size(); ++summaryIndex)
         {
-            const auto prevFlags = flags[flagIndex].exchange (0, std::memory_order_acq_rel);
-
-            for (size_t group = 0; group < groupsPerWord; ++group)
+            for (auto changedWords = summary[summaryIndex].exchange (0, std::memory_order_acq_rel); changedWords != 0;)
             {
-                const auto masked = moveFromGroupPosition (prevFlags, group);
+                const auto flagIndex = summaryIndex * bitsPerWord + findLowestSetBit (changedWords);
+                changedWords &= changedWords - 1;
+
+                for (auto prevFlags = flags[flagIndex].exchange (0, std::memory_order_acq_rel); prevFlags != 0;)
+                {
+                    const auto group = findLowestSetBit (prevFlags) / bitsPerFlagGroup;
+                    const auto masked = moveFromGroupPosition (prevFlags, group);
+                    prevFlags &= ~moveToGroupPosition (groupMask, group);
 
-                if (masked != 0)
                     callback ((flagIndex * groupsPerWord) + group, masked);
+                }
             }
         }
     }
@@ -73,6 +97,7 @@ public:
     void clear()
     {
         std::fill (flags.begin(), flags.end(), 0);
+        std::fill (summary.begin(), summary.end(), 0);
     }
 
 private:
@@ -118,11 +143,18 @@ private:
         return (a / b) + ((a % b) != 0);
     }
 
+    static size_t findLowestSetBit (FlagType value) noexcept
+    {
+        jassert (value != 0);
+        return (size_t) findHighestSetBit (value & (~value + 1));
+    }
+
+    static constexpr size_t bitsPerWord = 8 * sizeof (FlagType);
     static constexpr size_t bitsPerFlagGroup = findNextPowerOfTwo (requiredFlagBitsPerItem);
-    static constexpr size_t groupsPerWord = (8 * sizeof (FlagType)) / bitsPerFlagGroup;
+    static constexpr size_t groupsPerWord = bitsPerWord / bitsPerFlagGroup;
     static constexpr FlagType groupMask = ((FlagType) 1 << requiredFlagBitsPerItem) - 1;
 
-    std::vector<std::atomic<FlagType>> flags;
+    std::vector<std::atomic<FlagType>> flags, summary;
 };
 
 template <size_t requiredFlagBitsPerItem>
@@ -160,6 +160,7 @@ public:
     ~LevelDataSource() override
     {
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        stopSegmentJobs();
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -185,7 +186,7 @@ public:
         }
     }
 
-    void getLevels (int64 startSample, int numSamples, Array<Range<float>>& levels)
+    bool readSamples (int64 startSample, int numSamples, AudioBuffer<float>& dest)
     {
         const ScopedLock sl (readerLock);
 
@@ -202,13 +203,13 @@ public:
 
         if (reader != nullptr)
         {
-            if (levels.size() < (int) reader->numChannels)
-                levels.insertMultiple (0, {}, (int) reader->numChannels - levels.size());
-
-            reader->readMaxLevels (startSample, numSamples, levels.getRawDataPointer(), (int) reader->numChannels);
-
+            dest.setSize ((int) reader->numChannels, numSamples, false, false, true);
             lastReaderUseTime = Time::getMillisecondCounter();
+
+            return reader->read (dest.getArrayOfWritePointers(), (int) reader->numChannels, startSample, numSamples);
         }
+
+        return false;
     }
 
     void releaseResources()
@@ -232,6 +233,34 @@ public:
             return -1;
         }
 
+        if (! segmentJobs.isEmpty())
+        {
+            if (numSegmentsRemaining > 0)
+                return 100;
+
+            stopSegmentJobs();
+
+            if (! segmentFailed)
+            {
+                {
+                    const ScopedLock sl (readerLock);
+                    numSamplesFinished = lengthInSamples;
+                }
+
+                owner.cache.storeThumb (owner, hashCode);
+                return 200;
+            }
+
+            // One of the segments couldn't open a reader of its own, so the rest of
+            // the source will be read in sequence instead.
+            segmentFailed = false;
+            canScanInSegments = false;
+        }
+        else if (startSegmentJobs())
+        {
+            return 100;
+        }
+
         bool justFinished = false;
 
         {
@@ -269,17 +298,65 @@ public:
     int64 hashCode = 0;
 
 private:
+    class SegmentJob;
+
     AudioThumbnail& owner;
     std::unique_ptr<InputSource> source;
     std::unique_ptr<AudioFormatReader> reader;
-    CriticalSection readerLock;
+    CriticalSection readerLock, sourceLock;
     std::atomic<uint32> lastReaderUseTime { 0 };
+    AudioBuffer<float> scanBuffer;
+
+    OwnedArray<SegmentJob> segmentJobs;
+    std::atomic<int> numSegmentsRemaining { 0 };
+    std::atomic<bool> segmentFailed { false };
+    bool canScanInSegments = true;
+
+    // The smallest stretch of the source, in thumbnail samples, that's worth giving a thread of its own
+    enum { minThumbSamplesPerSegment = 1024 };
+
+    std::unique_ptr<AudioFormatReader> createReaderForSource()
+    {
+        const ScopedLock sl (sourceLock);
+
+        if (auto* audioFileStream = source->createInputStream())
+            return std::unique_ptr<AudioFormatReader> (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+
+        return {};
+    }
 
     void createReader()
     {
         if (reader == nullptr && source != nullptr)
-            if (auto* audioFileStream = source->createInputStream())
-                reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+            reader = createReaderForSource();
+    }
+
+    // The whole block is read at once, and the range of each thumbnail sample is found with
+    // FloatVectorOperations, instead of a separate readMaxLevels() call for every one.
+    static void readLevels (AudioFormatReader& r, int samplesPerThumbSample, int firstThumbIndex, int numThumbSamps,
+                            AudioBuffer<float>& sampleBuffer, HeapBlock<MinMaxValue>& levelData, HeapBlock<MinMaxValue*>& levels)
+    {
+        const auto numChans = (int) r.numChannels;
+        const auto numSamples = numThumbSamps * samplesPerThumbSample;
+
+        levelData.malloc ((size_t) numThumbSamps * (size_t) numChans);
+        levels.malloc ((size_t) numChans);
+
+        for (int i = 0; i < numChans; ++i)
+            levels[i] = levelData + i * numThumbSamps;
+
+        sampleBuffer.setSize (numChans, numSamples, false, false, true);
+
+        if (! r.read (sampleBuffer.getArrayOfWritePointers(), numChans, firstThumbIndex * (int64) samplesPerThumbSample, numSamples))
+            sampleBuffer.clear();
+
+        for (int j = 0; j < numChans; ++j)
+        {
+            auto* samples = sampleBuffer.getReadPointer (j);
+
+            for (int i = 0; i < numThumbSamps; ++i)
+                levels[j][i].setFloat (FloatVectorOperations::findMinAndMax (samples + i * samplesPerThumbSample, samplesPerThumbSample));
+        }
     }
 
     bool readNextBlock()
@@ -298,22 +375,9 @@ private:
                 auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
                 auto numThumbSamps = lastThumbIndex - firstThumbIndex;
 
-                HeapBlock<MinMaxValue> levelData ((unsigned int) numThumbSamps * numChannels);
-                HeapBlock<MinMaxValue*> levels (numChannels);
-
-                for (int i = 0; i < (int) numChannels; ++i)
-                    levels[i] = levelData + i * numThumbSamps;
-
-                HeapBlock<Range<float>> levelsRead (numChannels);
-
-                for (int i = 0; i < numThumbSamps; ++i)
-                {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
-
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
-                }
+                HeapBlock<MinMaxValue> levelData;
+                HeapBlock<MinMaxValue*> levels;
+                readLevels (*reader, owner.samplesPerThumbSample, firstThumbIndex, numThumbSamps, scanBuffer, levelData, levels);
 
                 {
                     const ScopedUnlock su (readerLock);
@@ -327,45 +391,172 @@ private:
 
         return isFullyLoaded();
     }
+
+    class SegmentJob  : public ThreadPoolJob
+    {
+    public:
+        SegmentJob (LevelDataSource& s, int64 start, int64 end)
+            : ThreadPoolJob ("Thumbnail segment"), levelSource (s), position (start), endSample (end)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            if (auto segmentReader = levelSource.createReaderForSource())
+            {
+                auto& thumb = levelSource.owner;
+                const auto samplesPerThumb = (int64) thumb.samplesPerThumbSample;
+
+                AudioBuffer<float> sampleBuffer;
+                HeapBlock<MinMaxValue> levelData;
+                HeapBlock<MinMaxValue*> levels;
+
+                while (position < endSample && ! shouldExit())
+                {
+                    auto firstThumbIndex = (int) (position / samplesPerThumb);
+                    auto lastThumbIndex  = (int) (jmin (position + 256 * samplesPerThumb, endSample) / samplesPerThumb);
+                    auto numThumbSamps = lastThumbIndex - firstThumbIndex;
+
+                    if (numThumbSamps <= 0)
+                        break;
+
+                    readLevels (*segmentReader, thumb.samplesPerThumbSample, firstThumbIndex, numThumbSamps, sampleBuffer, levelData, levels);
+                    thumb.setLevels (levels, firstThumbIndex, (int) segmentReader->numChannels, numThumbSamps);
+
+                    position = lastThumbIndex * samplesPerThumb;
+                }
+            }
+            else
+            {
+                levelSource.segmentFailed = true;
+            }
+
+            --levelSource.numSegmentsRemaining;
+            return jobHasFinished;
+        }
+
+    private:
+        LevelDataSource& levelSource;
+        int64 position, endSample;
+
+        JUCE_DECLARE_NON_COPYABLE (SegmentJob)
+    };
+
+    // If the cache has a pool of scanning threads, a source that can open several readers
+    // is divided into segments which are read at the same time.
+    bool startSegmentJobs()
+    {
+        auto* pool = owner.cache.getScanningThreadPool();
+
+        if (pool == nullptr || source == nullptr || ! canScanInSegments)
+            return false;
+
+        const auto samplesPerThumb = (int64) owner.samplesPerThumbSample;
+        const auto firstSample = (numSamplesFinished / samplesPerThumb) * samplesPerThumb;
+        const auto numThumbSamples = (lengthInSamples - firstSample + samplesPerThumb - 1) / samplesPerThumb;
+        const auto numSegments = (int) jmin ((int64) pool->getNumThreads() * 4,
+                                             numThumbSamples / (int64) minThumbSamplesPerSegment);
+
+        if (numSegments < 2)
+            return false;
+
+        numSegmentsRemaining = numSegments;
+        segmentFailed = false;
+
+        for (int i = 0; i < numSegments; ++i)
+        {
+            const auto start = firstSample + (numThumbSamples * i / numSegments) * samplesPerThumb;
+            const auto end = i == numSegments - 1 ? lengthInSamples
+                                                  : firstSample + (numThumbSamples * (i + 1) / numSegments) * samplesPerThumb;
+
+            segmentJobs.add (new SegmentJob (*this, start, end));
+        }
+
+        for (auto* job : segmentJobs)
+            pool->addJob (job, false);
+
+        return true;
+    }
+
+    void stopSegmentJobs()
+    {
+        if (auto* pool = owner.cache.getScanningThreadPool())
+            for (auto* job : segmentJobs)
+                pool->removeJob (job, true, -1);
+
+        segmentJobs.clear();
+    }
 };
 
 //==============================================================================
+/*  The levels of each channel are kept as a pyramid. The first level holds a value for
+    each block of samplesPerThumbSample source samples, and each level above it holds a
+    value for every levelFactor values of the one below. Finding the range of any part
+    of the thumbnail only needs a few values from each level, so drawing a view costs
+    roughly the same however much of the source it covers.
+
+    The levels can also point into a memory-mapped peak file, in which case they're
+    copied into memory the first time anything is written to them.
+*/
 class AudioThumbnail::ThumbData
 {
 public:
+    static constexpr int levelFactor = 4;
+
+    // Peak files are memory-mapped and read as arrays of these
+    static_assert (sizeof (MinMaxValue) == 2, "MinMaxValue must be exactly two bytes");
+
     ThumbData (int numThumbSamples)
     {
         ensureSize (numThumbSamples);
     }
 
-    inline MinMaxValue* getData (int thumbSampleIndex) noexcept
-    {
-        jassert (thumbSampleIndex < data.size());
-        return data.getRawDataPointer() + thumbSampleIndex;
-    }
-
     int getSize() const noexcept
     {
-        return data.size();
+        return levels.empty() ? 0 : levels.front().size;
     }
 
+    int getNumLevels() const noexcept                           { return (int) levels.size(); }
+    int getLevelSize (int level) const noexcept                 { return levels[(size_t) level].size; }
+    const MinMaxValue* getLevelData (int level) const noexcept  { return levels[(size_t) level].data; }
+
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
         if (startSample >= 0)
         {
-            endSample = jmin (endSample, data.size() - 1);
+            auto start = startSample;
+            auto end = jmin (endSample, getSize() - 1) + 1;
 
             int8 mx = -128;
             int8 mn = 127;
 
-            while (startSample <= endSample)
+            auto include = [&] (const MinMaxValue& v)
             {
-                auto& v = data.getReference (startSample);
-
                 if (v.getMinValue() < mn)  mn = v.getMinValue();
                 if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+            };
+
+            for (size_t level = 0; start < end; ++level)
+            {
+                auto* values = levels[level].data;
 
-                ++startSample;
+                if (level + 1 == levels.size())
+                {
+                    while (start < end)
+                        include (values[start++]);
+
+                    break;
+                }
+
+                // Whatever doesn't fill a whole value of the next level up is read from this one
+                while (start < end && start % levelFactor != 0)
+                    include (values[start++]);
+
+                while (end > start && end % levelFactor != 0)
+                    include (values[--end]);
+
+                start /= levelFactor;
+                end /= levelFactor;
             }
 
             if (mn <= mx)
@@ -380,48 +571,140 @@ public:
 
     void write (const MinMaxValue* values, int startIndex, int numValues)
     {
-        resetPeak();
-
-        if (startIndex + numValues > data.size())
+        if (startIndex + numValues > getSize())
             ensureSize (startIndex + numValues);
+        else
+            makeWritable();
 
-        auto* dest = getData (startIndex);
+        std::copy (values, values + numValues, levels.front().storage.begin() + startIndex);
+        updateLevels (startIndex, startIndex + numValues);
+    }
 
-        for (int i = 0; i < numValues; ++i)
-            dest[i] = values[i];
+    int getPeak() const noexcept
+    {
+        // The top level covers everything below it
+        auto& top = levels.back();
+        int peak = 0;
+
+        for (int i = 0; i < top.size; ++i)
+            peak = jmax (peak, top.data[i].getPeak());
+
+        return peak;
     }
 
-    void resetPeak() noexcept
+    static bool isValidPyramid (const std::vector<int>& levelSizes)
     {
-        peakLevel = -1;
+        if (levelSizes.empty() || levelSizes.front() < 0 || levelSizes.back() > 1)
+            return false;
+
+        for (size_t i = 1; i < levelSizes.size(); ++i)
+            if (levelSizes[i - 1] <= 1 || levelSizes[i] != (levelSizes[i - 1] + levelFactor - 1) / levelFactor)
+                return false;
+
+        return true;
     }
 
-    int getPeak() noexcept
+    void useMappedLevels (std::shared_ptr<MemoryMappedFile> file, const MinMaxValue* firstValue,
+                          const std::vector<int>& levelSizes)
     {
-        if (peakLevel < 0)
-        {
-            for (auto& s : data)
-            {
-                auto peak = s.getPeak();
+        jassert (isValidPyramid (levelSizes));
 
-                if (peak > peakLevel)
-                    peakLevel = peak;
-            }
+        levels.clear();
+        levels.resize (levelSizes.size());
+
+        for (size_t i = 0; i < levelSizes.size(); ++i)
+        {
+            levels[i].data = firstValue;
+            levels[i].size = levelSizes[i];
+            firstValue += levelSizes[i];
         }
 
-        return peakLevel;
+        mappedFile = std::move (file);
     }
 
 private:
-    Array<MinMaxValue> data;
-    int peakLevel = -1;
+    struct Level
+    {
+        std::vector<MinMaxValue> storage;
+        const MinMaxValue* data = nullptr;
+        int size = 0;
+    };
+
+    std::vector<Level> levels;
+    std::shared_ptr<MemoryMappedFile> mappedFile;
+
+    void makeWritable()
+    {
+        if (mappedFile == nullptr)
+            return;
+
+        for (auto& level : levels)
+        {
+            level.storage.assign (level.data, level.data + level.size);
+            level.data = level.storage.data();
+        }
+
+        mappedFile = nullptr;
+    }
 
     void ensureSize (int thumbSamples)
     {
-        auto extraNeeded = thumbSamples - data.size();
+        makeWritable();
+
+        const auto oldSize = getSize();
+        const auto oldNumLevels = levels.size();
+
+        if (thumbSamples <= oldSize && oldNumLevels > 0)
+            return;
+
+        for (size_t level = 0;; ++level)
+        {
+            if (level == levels.size())
+                levels.emplace_back();
+
+            auto& l = levels[level];
+            l.size = level == 0 ? thumbSamples : (levels[level - 1].size + levelFactor - 1) / levelFactor;
+            l.storage.resize ((size_t) l.size);
+            l.data = l.storage.data();
+
+            if (l.size <= 1)
+                break;
+        }
 
-        if (extraNeeded > 0)
-            data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+        if (levels.size() != oldNumLevels)
+            updateLevels (0, getSize());
+        else
+            updateLevels (jmax (0, oldSize - 1), getSize());
+    }
+
+    // Recalculates the values above a range of the first level
+    void updateLevels (int start, int end)
+    {
+        for (size_t level = 1; level < levels.size() && start < end; ++level)
+        {
+            start /= levelFactor;
+            end = (end + levelFactor - 1) / levelFactor;
+
+            auto& below = levels[level - 1];
+            auto& dest = levels[level].storage;
+
+            for (int i = start; i < end; ++i)
+            {
+                const auto first = i * levelFactor;
+                const auto last = jmin (first + levelFactor, below.size);
+
+                int8 mx = -128;
+                int8 mn = 127;
+
+                for (int j = first; j < last; ++j)
+                {
+                    mn = jmin (mn, below.data[j].getMinValue());
+                    mx = jmax (mx, below.data[j].getMaxValue());
+                }
+
+                dest[(size_t) i].set (mn, mx);
+            }
+        }
     }
 };
 
@@ -450,42 +733,73 @@ public:
 
             if (! clip.isEmpty())
             {
-                auto topY = (float) area.getY();
-                auto bottomY = (float) area.getBottom();
-                auto midY = (topY + bottomY) * 0.5f;
-                auto vscale = verticalZoomFactor * (bottomY - topY) / 256.0f;
-
-                auto* cacheData = getData (channelNum, clip.getX() - area.getX());
-
-                RectangleList<float> waveform;
-                waveform.ensureStorageAllocated (clip.getWidth());
-
-                auto x = (float) clip.getX();
-
-                for (int w = clip.getWidth(); --w >= 0;)
-                {
-                    if (cacheData->isNonZero())
-                    {
-                        auto top    = jmax (midY - cacheData->getMaxValue() * vscale - 0.3f, topY);
-                        auto bottom = jmin (midY - cacheData->getMinValue() * vscale + 0.3f, bottomY);
-
-                        waveform.addWithoutMerging (Rectangle<float> (x, top, 1.0f, bottom - top));
-                    }
-
-                    x += 1.0f;
-                    ++cacheData;
-                }
+                // The geometry is kept relative to the area, so that repainting an unchanged
+                // view, or one that has only moved, fills the same list again.
+                auto& waveform = getWaveform (channelNum, area.getWidth(), area.getHeight(), verticalZoomFactor);
 
+                Graphics::ScopedSaveState sss (g);
+                g.setOrigin (area.getPosition());
                 g.fillRectList (waveform);
             }
         }
     }
 
 private:
+    struct Waveform
+    {
+        RectangleList<float> rectangles;
+        int width = 0, height = 0;
+        float verticalZoomFactor = 0;
+        bool isValid = false;
+    };
+
     Array<MinMaxValue> data;
+    std::vector<Waveform> waveforms;
+    AudioBuffer<float> sampleBuffer;
     double cachedStart = 0, cachedTimePerPixel = 0;
     int numChannelsCached = 0, numSamplesCached = 0;
-    bool cacheNeedsRefilling = true;
+    bool cacheNeedsRefilling = true, cacheIsFromSource = false;
+
+    const RectangleList<float>& getWaveform (int channelNum, int width, int height, float verticalZoomFactor)
+    {
+        auto& waveform = waveforms[(size_t) channelNum];
+
+        if (waveform.isValid && waveform.width == width && waveform.height == height
+             && waveform.verticalZoomFactor == verticalZoomFactor)
+            return waveform.rectangles;
+
+        waveform.width = width;
+        waveform.height = height;
+        waveform.verticalZoomFactor = verticalZoomFactor;
+        waveform.isValid = true;
+
+        auto& rectangles = waveform.rectangles;
+        rectangles.clear();
+
+        const auto numColumns = jmin (numSamplesCached, width);
+        rectangles.ensureStorageAllocated (numColumns);
+
+        auto bottomY = (float) height;
+        auto midY = bottomY * 0.5f;
+        auto vscale = verticalZoomFactor * bottomY / 256.0f;
+
+        auto* cacheData = getData (channelNum, 0);
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            if (cacheData->isNonZero())
+            {
+                auto top    = jmax (midY - cacheData->getMaxValue() * vscale - 0.3f, 0.0f);
+                auto bottom = jmin (midY - cacheData->getMinValue() * vscale + 0.3f, bottomY);
+
+                rectangles.addWithoutMerging (Rectangle<float> ((float) x, top, 1.0f, bottom - top));
+            }
+
+            ++cacheData;
+        }
+
+        return rectangles;
+    }
 
     bool refillCache (int numSamples, double startTime, double endTime,
                       double rate, int numChans, int sampsPerThumbSample,
@@ -508,76 +822,128 @@ private:
             return ! cacheNeedsRefilling;
         }
 
+        const auto readFromSource = timePerPixel * rate <= sampsPerThumbSample && levelData != nullptr;
+        auto firstColumnToFill = 0, endColumnToFill = numSamples;
+
+        // When a view scrolls by a whole number of pixels, only the columns that have
+        // come into view need to be worked out.
+        if (! cacheNeedsRefilling
+             && numSamples == numSamplesCached
+             && numChannelsCached == numChans
+             && timePerPixel == cachedTimePerPixel
+             && readFromSource == cacheIsFromSource)
+        {
+            auto shift = (startTime - cachedStart) / timePerPixel;
+
+            if (std::abs (shift) < numSamples)
+            {
+                auto wholeShift = roundToInt (shift);
+
+                if (std::abs (shift - wholeShift) < 1.0e-3)
+                {
+                    shiftColumns (wholeShift);
+                    startTime = cachedStart + wholeShift * timePerPixel;
+
+                    if (wholeShift > 0)
+                        firstColumnToFill = numSamples - wholeShift;
+                    else
+                        endColumnToFill = -wholeShift;
+                }
+            }
+        }
+
         numSamplesCached = numSamples;
         numChannelsCached = numChans;
         cachedStart = startTime;
         cachedTimePerPixel = timePerPixel;
         cacheNeedsRefilling = false;
+        cacheIsFromSource = readFromSource;
 
         ensureSize (numSamples);
 
-        if (timePerPixel * rate <= sampsPerThumbSample && levelData != nullptr)
-        {
-            auto sample = roundToInt (startTime * rate);
-            Array<Range<float>> levels;
+        if (readFromSource)
+            fillColumnsFromSource (firstColumnToFill, endColumnToFill, rate, *levelData);
+        else
+            fillColumnsFromThumbnail (firstColumnToFill, endColumnToFill, rate, sampsPerThumbSample, chans);
 
-            int i;
-            for (i = 0; i < numSamples; ++i)
-            {
-                auto nextSample = roundToInt ((startTime + timePerPixel) * rate);
+        if (firstColumnToFill < endColumnToFill)
+            for (auto& waveform : waveforms)
+                waveform.isValid = false;
 
-                if (sample >= 0)
-                {
-                    if (sample >= levelData->lengthInSamples)
-                    {
-                        for (int chan = 0; chan < numChannelsCached; ++chan)
-                            *getData (chan, i) = MinMaxValue();
-                    }
-                    else
-                    {
-                        levelData->getLevels (sample, jmax (1, nextSample - sample), levels);
+        return true;
+    }
 
-                        auto totalChans = jmin (levels.size(), numChannelsCached);
+    // The columns are worked out from their index rather than by stepping along, so that a
+    // column always covers the same samples however the view has scrolled to it.
+    double getColumnStart (int column) const noexcept
+    {
+        return cachedStart + column * cachedTimePerPixel;
+    }
 
-                        for (int chan = 0; chan < totalChans; ++chan)
-                            getData (chan, i)->setFloat (levels.getReference (chan));
-                    }
-                }
+    void fillColumnsFromSource (int firstColumn, int endColumn, double rate, LevelDataSource& levelData)
+    {
+        for (int i = firstColumn; i < endColumn; ++i)
+            for (int chan = 0; chan < numChannelsCached; ++chan)
+                *getData (chan, i) = MinMaxValue();
 
-                startTime += timePerPixel;
-                sample = nextSample;
-            }
+        const auto firstVisibleSample = jmax ((int64) 0, (int64) roundToInt (getColumnStart (firstColumn) * rate));
+        const auto endVisibleSample = jmin (levelData.lengthInSamples, (int64) roundToInt (getColumnStart (endColumn) * rate) + 1);
 
-            numSamplesCached = i;
-        }
-        else
+        if (endVisibleSample <= firstVisibleSample
+             || ! levelData.readSamples (firstVisibleSample, (int) (endVisibleSample - firstVisibleSample), sampleBuffer))
+            return;
+
+        const auto totalChans = jmin (sampleBuffer.getNumChannels(), numChannelsCached);
+
+        for (int i = firstColumn; i < endColumn; ++i)
         {
-            jassert (chans.size() == numChannelsCached);
+            auto sample = (int64) roundToInt (getColumnStart (i) * rate);
+            auto nextSample = (int64) roundToInt (getColumnStart (i + 1) * rate);
 
-            for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
-            {
-                ThumbData* channelData = chans.getUnchecked (channelNum);
-                MinMaxValue* cacheData = getData (channelNum, 0);
+            if (sample < firstVisibleSample || sample >= endVisibleSample)
+                continue;
 
-                auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+            const auto numToScan = (int) jmin (jmax ((int64) 1, nextSample - sample), endVisibleSample - sample);
 
-                startTime = cachedStart;
-                auto sample = roundToInt (startTime * timeToThumbSampleFactor);
+            for (int chan = 0; chan < totalChans; ++chan)
+                getData (chan, i)->setFloat (FloatVectorOperations::findMinAndMax (sampleBuffer.getReadPointer (chan, (int) (sample - firstVisibleSample)),
+                                                                                   numToScan));
+        }
+    }
 
-                for (int i = numSamples; --i >= 0;)
-                {
-                    auto nextSample = roundToInt ((startTime + timePerPixel) * timeToThumbSampleFactor);
+    void fillColumnsFromThumbnail (int firstColumn, int endColumn, double rate, int sampsPerThumbSample,
+                                   const OwnedArray<ThumbData>& chans)
+    {
+        jassert (chans.size() == numChannelsCached);
 
-                    channelData->getMinMax (sample, nextSample, *cacheData);
+        auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
 
-                    ++cacheData;
-                    startTime += timePerPixel;
-                    sample = nextSample;
-                }
+        for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
+        {
+            ThumbData* channelData = chans.getUnchecked (channelNum);
+
+            for (int i = firstColumn; i < endColumn; ++i)
+            {
+                auto sample = roundToInt (getColumnStart (i) * timeToThumbSampleFactor);
+                auto nextSample = roundToInt (getColumnStart (i + 1) * timeToThumbSampleFactor);
+
+                channelData->getMinMax (sample, nextSample, *getData (channelNum, i));
             }
         }
+    }
 
-        return true;
+    void shiftColumns (int numColumns)
+    {
+        for (int chan = 0; chan < numChannelsCached; ++chan)
+        {
+            auto* start = getData (chan, 0);
+            auto* end = start + numSamplesCached;
+
+            if (numColumns > 0)
+                std::copy (start + numColumns, end, start);
+            else if (numColumns < 0)
+                std::copy_backward (start, end + numColumns, end);
+        }
     }
 
     MinMaxValue* getData (const int channelNum, const int cacheIndex) noexcept
@@ -594,6 +960,9 @@ private:
 
         if (data.size() < itemsRequired)
             data.insertMultiple (-1, MinMaxValue(), itemsRequired - data.size());
+
+        if (waveforms.size() < (size_t) numChannelsCached)
+            waveforms.resize ((size_t) numChannelsCached);
     }
 };
 
@@ -624,6 +993,7 @@ void AudioThumbnail::clearChannelData()
 {
     window->invalidate();
     channels.clear();
+    finishedRanges.clear();
     totalSamples = numSamplesFinished = 0;
     numChannels = 0;
     sampleRate = 0;
@@ -670,9 +1040,17 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
 
     createChannels (numThumbnailSamples);
 
-    for (int i = 0; i < numThumbnailSamples; ++i)
+    finishedRanges.addRange ({ 0, numSamplesFinished });
+
+    const auto numValues = (size_t) jmax (0, numThumbnailSamples);
+    std::vector<MinMaxValue> values (numValues * (size_t) jmax (0, numChannels));
+
+    for (size_t i = 0; i < numValues; ++i)
         for (int chan = 0; chan < numChannels; ++chan)
-            channels.getUnchecked(chan)->getData(i)->read (input);
+            values[(size_t) chan * numValues + i].read (input);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        channels.getUnchecked (chan)->write (values.data() + (size_t) chan * numValues, 0, (int) numValues);
 
     return true;
 }
@@ -695,7 +1073,137 @@ void AudioThumbnail::saveTo (OutputStream& output) const
 
     for (int i = 0; i < numThumbnailSamples; ++i)
         for (int chan = 0; chan < numChannels; ++chan)
-            channels.getUnchecked(chan)->getData(i)->write (output);
+            MinMaxValue (channels.getUnchecked (chan)->getLevelData (0)[i]).write (output);
+}
+
+//==============================================================================
+static const char peakFileMagic[] = { 'j', 'p', 'k', 'f' };
+enum { peakFileVersion = 1 };
+
+bool AudioThumbnail::saveToPeakFile (const File& file) const
+{
+    const ScopedLock sl (lock);
+
+    TemporaryFile tempFile (file);
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (! out.openedOk())
+            return false;
+
+        const auto numChans = jmin ((int) numChannels, channels.size());
+
+        out.write (peakFileMagic, sizeof (peakFileMagic));
+        out.writeInt (peakFileVersion);
+        out.writeInt (ThumbData::levelFactor);
+        out.writeInt (samplesPerThumbSample);
+        out.writeInt64 (totalSamples);
+        out.writeInt64 (numSamplesFinished);
+        out.writeDouble (sampleRate);
+        out.writeInt (numChans);
+
+        for (int chan = 0; chan < numChans; ++chan)
+        {
+            auto* c = channels.getUnchecked (chan);
+            out.writeInt (c->getNumLevels());
+
+            for (int level = 0; level < c->getNumLevels(); ++level)
+                out.writeInt (c->getLevelSize (level));
+        }
+
+        for (int chan = 0; chan < numChans; ++chan)
+        {
+            auto* c = channels.getUnchecked (chan);
+
+            for (int level = 0; level < c->getNumLevels(); ++level)
+                out.write (c->getLevelData (level), (size_t) c->getLevelSize (level) * sizeof (MinMaxValue));
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+bool AudioThumbnail::loadFromPeakFile (const File& file)
+{
+    auto mappedFile = std::make_shared<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+    auto* fileData = static_cast<const char*> (mappedFile->getData());
+
+    if (fileData == nullptr)
+        return false;
+
+    const auto fileSize = mappedFile->getSize();
+    MemoryInputStream header (fileData, fileSize, false);
+
+    char magic[sizeof (peakFileMagic)] = {};
+
+    if (header.read (magic, (int) sizeof (magic)) != (int) sizeof (magic)
+         || std::memcmp (magic, peakFileMagic, sizeof (magic)) != 0
+         || header.readInt() != peakFileVersion
+         || header.readInt() != ThumbData::levelFactor)
+        return false;
+
+    const auto newSamplesPerThumbSample = header.readInt();
+    const auto newTotalSamples = header.readInt64();
+    const auto newNumSamplesFinished = header.readInt64();
+    const auto newSampleRate = header.readDouble();
+    const auto newNumChannels = header.readInt();
+
+    if (newSamplesPerThumbSample <= 0 || newNumChannels < 0 || newNumChannels > 1024)
+        return false;
+
+    std::vector<std::vector<int>> levelSizes ((size_t) newNumChannels);
+    size_t numValues = 0;
+
+    for (auto& sizes : levelSizes)
+    {
+        const auto numLevels = header.readInt();
+
+        if (numLevels <= 0 || numLevels > 32)
+            return false;
+
+        for (int level = 0; level < numLevels; ++level)
+            sizes.push_back (header.readInt());
+
+        if (! ThumbData::isValidPyramid (sizes))
+            return false;
+
+        for (auto size : sizes)
+            numValues += (size_t) size;
+    }
+
+    const auto dataStart = (size_t) header.getPosition();
+
+    if (dataStart + numValues * sizeof (MinMaxValue) != fileSize)
+        return false;
+
+    const ScopedLock sl (lock);
+    clearChannelData();
+
+    samplesPerThumbSample = newSamplesPerThumbSample;
+    totalSamples = newTotalSamples;
+    numSamplesFinished = newNumSamplesFinished;
+    sampleRate = newSampleRate;
+    numChannels = newNumChannels;
+    finishedRanges.addRange ({ 0, numSamplesFinished });
+
+    auto* values = reinterpret_cast<const MinMaxValue*> (fileData + dataStart);
+
+    for (auto& sizes : levelSizes)
+    {
+        auto* c = channels.add (new ThumbData (0));
+        c->useMappedLevels (mappedFile, values, sizes);
+
+        for (auto size : sizes)
+            values += size;
+    }
+
+    return true;
 }
 
 //==============================================================================
@@ -807,8 +1315,12 @@ void AudioThumbnail::setLevels (const MinMaxValue* const* values, int thumbIndex
     auto start = thumbIndex * (int64) samplesPerThumbSample;
     auto end   = (thumbIndex + numValues) * (int64) samplesPerThumbSample;
 
-    if (numSamplesFinished >= start && end > numSamplesFinished)
-        numSamplesFinished = end;
+    // Blocks can arrive in any order when a source is scanned in segments, so the
+    // finished count only moves past the ones that are joined up to the start.
+    finishedRanges.addRange ({ start, end });
+
+    if (finishedRanges.getNumRanges() > 0 && finishedRanges.getRange (0).getStart() <= numSamplesFinished)
+        numSamplesFinished = jmax (numSamplesFinished, finishedRanges.getRange (0).getEnd());
 
     totalSamples = jmax (numSamplesFinished, totalSamples);
     window->invalidate();
@@ -898,4 +1410,243 @@ void AudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area, doub
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioThumbnailTests  : public UnitTest
+{
+public:
+    AudioThumbnailTests()
+        : UnitTest ("AudioThumbnail", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        formatManager.registerBasicFormats();
+
+        const auto source = createTestSignal (2, 64 * 5000);
+
+        beginTest ("The range of any stretch of the thumbnail matches the samples it covers");
+        {
+            AudioThumbnailCache cache (1);
+            AudioThumbnail thumb (64, formatManager, cache);
+            fillThumbnail (thumb, source);
+
+            expect (thumb.isFullyLoaded());
+            expectWithinAbsoluteError (thumb.getApproximatePeak(), source.getMagnitude (0, source.getNumSamples()), 0.02f);
+
+            auto random = getRandom();
+
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto numThumbSamples = source.getNumSamples() / 64;
+                const auto first = random.nextInt (numThumbSamples);
+                const auto last = jmin (numThumbSamples - 1, first + random.nextInt (jmax (1, numThumbSamples >> random.nextInt (12))));
+                const auto channel = random.nextInt (2);
+
+                float minValue = 0, maxValue = 0;
+                thumb.getApproximateMinMax ((first * 64 + 32) / sampleRate, (last * 64) / sampleRate, channel, minValue, maxValue);
+
+                const auto expected = FloatVectorOperations::findMinAndMax (source.getReadPointer (channel, first * 64), (last + 1 - first) * 64);
+                expectWithinAbsoluteError (minValue, expected.getStart(), 0.02f);
+                expectWithinAbsoluteError (maxValue, expected.getEnd(), 0.02f);
+            }
+        }
+
+        beginTest ("A peak file reloads the same levels");
+        {
+            AudioThumbnailCache cache (1);
+            AudioThumbnail original (64, formatManager, cache);
+            fillThumbnail (original, source);
+
+            TemporaryFile peakFile (".jpk");
+            expect (original.saveToPeakFile (peakFile.getFile()));
+
+            AudioThumbnail reloaded (64, formatManager, cache);
+            expect (reloaded.loadFromPeakFile (peakFile.getFile()));
+            expectEquals (reloaded.getNumChannels(), 2);
+            expectEquals (reloaded.getTotalLength(), original.getTotalLength());
+            expect (reloaded.isFullyLoaded());
+            expectEquals (reloaded.getApproximatePeak(), original.getApproximatePeak());
+            expectSameLevels (original, reloaded);
+
+            // Adding data to a mapped thumbnail must leave the file untouched
+            AudioBuffer<float> silence (2, 64);
+            silence.clear();
+            reloaded.addBlock (0, silence, 0, silence.getNumSamples());
+
+            AudioThumbnail another (64, formatManager, cache);
+            expect (another.loadFromPeakFile (peakFile.getFile()));
+            expectSameLevels (original, another);
+
+            TemporaryFile badFile (".jpk");
+            badFile.getFile().replaceWithText ("not a peak file");
+            expect (! another.loadFromPeakFile (badFile.getFile()));
+            expectEquals (another.getNumChannels(), 2);
+        }
+
+        beginTest ("Scanning in parallel segments gives the same thumbnail");
+        {
+            TemporaryFile audioFile (".wav");
+            writeWavFile (audioFile.getFile(), createTestSignal (2, 64 * 1024 * 12));
+
+            AudioThumbnailCache sequentialCache (1);
+            AudioThumbnail sequential (64, formatManager, sequentialCache);
+            sequential.setSource (new FileInputSource (audioFile.getFile()));
+
+            TemporaryFile peakDirectory;
+
+            const auto parallel = std::make_unique<AudioThumbnailCache> (1, 4);
+            parallel->setPeakFileDirectory (peakDirectory.getFile());
+
+            {
+                AudioThumbnail scanned (64, formatManager, *parallel);
+                scanned.setSource (new FileInputSource (audioFile.getFile()));
+
+                expect (waitUntilLoaded (sequential) && waitUntilLoaded (scanned));
+                expectSameLevels (sequential, scanned);
+
+                // The peak file is written just after the thumbnail is marked as finished
+                for (int i = 0; i < 100 && ! parallel->getPeakFileFor (scanned.getHashCode()).existsAsFile(); ++i)
+                    Thread::sleep (20);
+
+                expect (parallel->getPeakFileFor (scanned.getHashCode()).existsAsFile());
+            }
+
+            AudioThumbnailCache reloadingCache (1);
+            reloadingCache.setPeakFileDirectory (peakDirectory.getFile());
+
+            AudioThumbnail reloaded (64, formatManager, reloadingCache);
+            reloaded.setSource (new FileInputSource (audioFile.getFile()));
+
+            expect (reloaded.isFullyLoaded());
+            expectSameLevels (sequential, reloaded);
+        }
+
+        beginTest ("A view that has scrolled draws the same as one drawn from scratch");
+        {
+            AudioThumbnailCache cache (1);
+            AudioThumbnail scrolled (64, formatManager, cache), fresh (64, formatManager, cache);
+            fillThumbnail (scrolled, source);
+            fillThumbnail (fresh, source);
+
+            // Times that are exact in binary, so that both views work out the same columns
+            const auto timePerPixel = 1.0 / 1024.0;
+            const auto width = 400;
+
+            const auto firstView = drawThumbnail (fresh, 1.0, 1.0 + width * timePerPixel, width);
+            expect (firstView != MemoryBlock (firstView.getSize(), true));
+
+            for (auto shift : { 37, -150, 0, 399, -12 })
+            {
+                const auto start = 1.0 + shift * timePerPixel;
+                const auto end = start + width * timePerPixel;
+
+                if (shift != 0)
+                    drawThumbnail (scrolled, 1.0, 1.0 + width * timePerPixel, width);
+
+                expect (drawThumbnail (scrolled, start, end, width) == drawThumbnail (fresh, start, end, width));
+
+                // Drawing the same view again reuses the cached waveform
+                expect (drawThumbnail (scrolled, start, end, width) == drawThumbnail (fresh, start, end, width));
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    AudioFormatManager formatManager;
+
+    AudioBuffer<float> createTestSignal (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        auto random = getRandom();
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto* data = buffer.getWritePointer (chan);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // A level that changes slowly, so that the coarser resolutions have something to show
+                const auto envelope = 0.5f + 0.45f * std::sin ((float) i * 0.0001f * (float) (chan + 1));
+                data[i] = envelope * (random.nextFloat() * 2.0f - 1.0f);
+            }
+        }
+
+        return buffer;
+    }
+
+    static void fillThumbnail (AudioThumbnail& thumb, const AudioBuffer<float>& buffer)
+    {
+        thumb.reset (buffer.getNumChannels(), sampleRate, buffer.getNumSamples());
+
+        for (int start = 0; start < buffer.getNumSamples(); start += 4096)
+            thumb.addBlock (start, buffer, start, jmin (4096, buffer.getNumSamples() - start));
+    }
+
+    void writeWavFile (const File& file, const AudioBuffer<float>& buffer)
+    {
+        WavAudioFormat format;
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new FileOutputStream (file), sampleRate,
+                                                                           (unsigned int) buffer.getNumChannels(), 16, {}, 0));
+        expect (writer != nullptr);
+        expect (writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples()));
+    }
+
+    static MemoryBlock drawThumbnail (AudioThumbnail& thumb, double start, double end, int width)
+    {
+        Image image (Image::RGB, width, 100, true, SoftwareImageType());
+
+        {
+            Graphics g (image);
+            g.setColour (Colours::white);
+            thumb.drawChannel (g, image.getBounds(), start, end, 1, 1.0f);
+        }
+
+        const Image::BitmapData bitmap (image, Image::BitmapData::readOnly);
+        return { bitmap.data, bitmap.size };
+    }
+
+    static bool waitUntilLoaded (AudioThumbnail& thumb)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (thumb.isFullyLoaded())
+                return true;
+
+            Thread::sleep (10);
+        }
+
+        return false;
+    }
+
+    void expectSameLevels (AudioThumbnail& a, AudioThumbnail& b)
+    {
+        const auto length = a.getTotalLength();
+        expectEquals (b.getTotalLength(), length);
+
+        for (int chan = 0; chan < a.getNumChannels(); ++chan)
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto start = length * i / 50.0;
+                const auto end = start + length / (double) (1 << (i % 10));
+
+                float minA = 0, maxA = 0, minB = 0, maxB = 0;
+                a.getApproximateMinMax (start, end, chan, minA, maxA);
+                b.getApproximateMinMax (start, end, chan, minB, maxB);
+
+                expectEquals (minB, minA);
+                expectEquals (maxB, maxA);
+            }
+        }
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+#endif
+
 } // namespace juce
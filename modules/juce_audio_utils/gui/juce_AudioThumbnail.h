@@ -41,7 +41,15 @@ namespace juce
     listeners should repaint themselves.
 
     The thumbnail stores an internal low-res version of the wave data, and this can
-    be loaded and saved to avoid having to scan the file again.
+    be loaded and saved to avoid having to scan the file again. The data is kept at
+    several resolutions, each a quarter of the one below it, so drawing a view takes
+    about the same time whether it shows a second of the file or several hours.
+
+    If the AudioThumbnailCache was created with some scanning threads, a source that
+    is read through an InputSource is divided into segments that are scanned at the
+    same time. The thumbnail can also be saved as a peak file with saveToPeakFile(),
+    and loadFromPeakFile() will memory-map it rather than reading it, so even very long
+    files can be shown again straight away.
 
     @see AudioThumbnailCache, AudioThumbnailBase
 
@@ -139,6 +147,26 @@ public:
     */
     void saveTo (OutputStream& output) const override;
 
+    /** Writes all the resolutions of the thumbnail to a file which can be memory-mapped
+        by loadFromPeakFile().
+
+        The data is written to a temporary file which then replaces the target, so an
+        existing peak file that another thumbnail has mapped is left alone.
+        @returns true if the file was written successfully
+        @see loadFromPeakFile, AudioThumbnailCache::setPeakFileDirectory
+    */
+    bool saveToPeakFile (const File& file) const;
+
+    /** Replaces the thumbnail's data with the contents of a file written by saveToPeakFile().
+
+        The file is memory-mapped, and is only copied into memory if more data is added to
+        the thumbnail afterwards, so this takes the same short time for any length of source.
+        @returns false if the file couldn't be opened or isn't a valid peak file, in which
+                 case the thumbnail is left unchanged
+        @see saveToPeakFile
+    */
+    bool loadFromPeakFile (const File& file);
+
     //==============================================================================
     /** Returns the number of channels in the file. */
     int getNumChannels() const noexcept override;
@@ -219,6 +247,7 @@ private:
     int32 samplesPerThumbSample = 0;
     int64 totalSamples { 0 };
     int64 numSamplesFinished = 0;
+    SparseSet<int64> finishedRanges;
     int32 numChannels = 0;
     double sampleRate = 0;
     CriticalSection lock;
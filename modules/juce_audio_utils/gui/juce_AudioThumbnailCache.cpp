@@ -59,12 +59,15 @@ private:
 };
 
 //==============================================================================
-AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numScanningThreads)
     : thread ("thumb cache"),
       maxNumThumbsToStore (maxNumThumbs)
 {
     jassert (maxNumThumbsToStore > 0);
     thread.startThread (Thread::Priority::low);
+
+    if (numScanningThreads > 0)
+        scanningThreadPool = std::make_unique<ThreadPool> (numScanningThreads, 0, Thread::Priority::low);
 }
 
 AudioThumbnailCache::~AudioThumbnailCache()
@@ -112,6 +115,14 @@ bool AudioThumbnailCache::loadThumb (AudioThumbnailBase& thumb, const int64 hash
         return true;
     }
 
+    if (auto* thumbnail = dynamic_cast<AudioThumbnail*> (&thumb))
+    {
+        auto peakFile = getPeakFileFor (hashCode);
+
+        if (peakFile.existsAsFile() && thumbnail->loadFromPeakFile (peakFile))
+            return true;
+    }
+
     return loadNewThumb (thumb, hashCode);
 }
 
@@ -136,6 +147,14 @@ void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
         thumb.saveTo (out);
     }
 
+    if (auto* thumbnail = dynamic_cast<const AudioThumbnail*> (&thumb))
+    {
+        auto peakFile = getPeakFileFor (hashCode);
+
+        if (peakFile != File() && peakFileDirectory.createDirectory())
+            thumbnail->saveToPeakFile (peakFile);
+    }
+
     saveNewlyFinishedThumbnail (thumb, hashCode);
 }
 
@@ -154,6 +173,28 @@ void AudioThumbnailCache::removeThumb (const int64 hashCode)
             thumbs.remove (i);
 }
 
+void AudioThumbnailCache::setPeakFileDirectory (const File& directory)
+{
+    const ScopedLock sl (lock);
+    peakFileDirectory = directory;
+}
+
+File AudioThumbnailCache::getPeakFileDirectory() const
+{
+    const ScopedLock sl (lock);
+    return peakFileDirectory;
+}
+
+File AudioThumbnailCache::getPeakFileFor (int64 hashCode) const
+{
+    const ScopedLock sl (lock);
+
+    if (peakFileDirectory == File())
+        return {};
+
+    return peakFileDirectory.getChildFile (String::toHexString (hashCode)).withFileExtension ("jpk");
+}
+
 static int getThumbnailCacheFileMagicHeader() noexcept
 {
     return (int) ByteOrder::littleEndianInt ("ThmC");
@@ -34,6 +34,10 @@ namespace juce
     that need it, and it maintains a set of low-res previews in memory, to avoid
     having to re-scan audio files too often.
 
+    It can also own a pool of threads that AudioThumbnails use to scan long files in
+    parallel, and can keep finished thumbnails as peak files in a folder, from which
+    they are memory-mapped the next time they are needed.
+
     @see AudioThumbnail
 
     @tags{Audio}
@@ -46,8 +50,13 @@ public:
 
         The maxNumThumbsToStore parameter lets you specify how many previews should
         be kept in memory at once.
+
+        If numScanningThreads is greater than zero, the cache also creates a ThreadPool
+        with that many threads, and thumbnails that read from an InputSource will divide
+        their source into segments which are scanned in parallel. The InputSource must
+        then be able to create several streams at once.
     */
-    explicit AudioThumbnailCache (int maxNumThumbsToStore);
+    explicit AudioThumbnailCache (int maxNumThumbsToStore, int numScanningThreads = 0);
 
     /** Destructor. */
     virtual ~AudioThumbnailCache();
@@ -89,6 +98,31 @@ public:
     /** Returns the thread that client thumbnails can use. */
     TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
 
+    /** Returns the pool that thumbnails can use to scan their sources in parallel, or
+        nullptr if the cache was created without any scanning threads.
+    */
+    ThreadPool* getScanningThreadPool() noexcept        { return scanningThreadPool.get(); }
+
+    //==============================================================================
+    /** Sets a folder in which finished thumbnails are kept as peak files.
+
+        When an AudioThumbnail finishes scanning its source, the cache writes it to a file
+        in this folder named after its hash code. When a thumbnail isn't in memory, the
+        cache looks for its file and memory-maps it with AudioThumbnail::loadFromPeakFile().
+        Pass File() to stop using peak files.
+
+        @see AudioThumbnail::saveToPeakFile
+    */
+    void setPeakFileDirectory (const File& directory);
+
+    /** Returns the folder set by setPeakFileDirectory(). */
+    File getPeakFileDirectory() const;
+
+    /** Returns the peak file that would be used for a hash code, or File() if there is no
+        peak file directory.
+    */
+    File getPeakFileFor (int64 hashCode) const;
+
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
@@ -103,6 +137,8 @@ protected:
 private:
     //==============================================================================
     TimeSliceThread thread;
+    std::unique_ptr<ThreadPool> scanningThreadPool;
+    File peakFileDirectory;
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
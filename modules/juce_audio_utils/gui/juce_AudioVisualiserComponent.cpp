@@ -26,6 +26,10 @@
 namespace juce
 {
 
+/*  The audio thread reduces each block of incoming samples to its minimum and maximum,
+    and passes the blocks to the message thread through a wait-free queue. Only the
+    message thread touches the history that gets painted.
+*/
 struct AudioVisualiserComponent::ChannelInfo
 {
     ChannelInfo (AudioVisualiserComponent& o, int bufferSize) : owner (o)
@@ -34,13 +38,15 @@ struct AudioVisualiserComponent::ChannelInfo
         clear();
     }
 
+    // Called on the message thread
     void clear() noexcept
     {
         levels.fill ({});
-        value = {};
-        subSample = 0;
+        blocks.popAll ([] (Range<float>) {});
+        clearPending = true;
     }
 
+    // Called on the audio thread
     void pushSamples (const float* inputSamples, int num) noexcept
     {
         for (int i = 0; i < num; ++i)
@@ -49,12 +55,16 @@ struct AudioVisualiserComponent::ChannelInfo
 
     void pushSample (float newSample) noexcept
     {
-        if (--subSample <= 0)
+        if (clearPending.exchange (false))
         {
-            if (++nextSample == levels.size())
-                nextSample = 0;
+            value = {};
+            subSample = 0;
+        }
 
-            levels.getReference (nextSample) = value;
+        if (--subSample <= 0)
+        {
+            // If the message thread has fallen behind, the newest blocks are dropped
+            blocks.push (value);
             subSample = owner.getSamplesPerBlock();
             value = Range<float> (newSample, newSample);
         }
@@ -64,6 +74,18 @@ struct AudioVisualiserComponent::ChannelInfo
         }
     }
 
+    // Called on the message thread. Returns true if any new blocks arrived.
+    bool collectBlocks() noexcept
+    {
+        return blocks.popAll ([this] (Range<float> block)
+        {
+            if (++nextSample == levels.size())
+                nextSample = 0;
+
+            levels.getReference (nextSample) = block;
+        }) > 0;
+    }
+
     void setBufferSize (int newSize)
     {
         levels.removeRange (newSize, levels.size());
@@ -74,9 +96,17 @@ struct AudioVisualiserComponent::ChannelInfo
     }
 
     AudioVisualiserComponent& owner;
-    Array<Range<float>> levels;
+
+    // Only used by the audio thread
     Range<float> value;
-    std::atomic<int> nextSample { 0 }, subSample { 0 };
+    int subSample = 0;
+
+    SPSCQueue<Range<float>> blocks { 4096 };
+    std::atomic<bool> clearPending { false };
+
+    // Only used by the message thread
+    Array<Range<float>> levels;
+    int nextSample = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelInfo)
 };
@@ -163,7 +193,13 @@ void AudioVisualiserComponent::setRepaintRate (int frequencyInHz)
 
 void AudioVisualiserComponent::timerCallback()
 {
-    repaint();
+    auto anyNewBlocks = false;
+
+    for (auto* c : channels)
+        anyNewBlocks = c->collectBlocks() || anyNewBlocks;
+
+    if (anyNewBlocks)
+        repaint();
 }
 
 void AudioVisualiserComponent::setColours (Colour bk, Colour fg) noexcept
@@ -211,12 +247,37 @@ void AudioVisualiserComponent::getChannelAsPath (Path& path, const Range<float>*
 void AudioVisualiserComponent::paintChannel (Graphics& g, Rectangle<float> area,
                                              const Range<float>* levels, int numLevels, int nextSample)
 {
-    Path p;
-    getChannelAsPath (p, levels, numLevels, nextSample);
+    // When there are more levels than physical pixels, neighbouring levels are merged so that
+    // the path only needs one point per pixel on each edge
+    const auto numColumns = roundToInt (area.getWidth() * g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    if (numColumns > 0 && numLevels > numColumns)
+    {
+        columnLevels.resize ((size_t) numColumns);
+
+        for (int column = 0; column < numColumns; ++column)
+        {
+            const auto start = (int) ((int64) column * numLevels / numColumns);
+            const auto end   = (int) ((int64) (column + 1) * numLevels / numColumns);
+            auto range = levels[(nextSample + start) % numLevels];
+
+            for (int i = start + 1; i < end; ++i)
+                range = range.getUnionWith (levels[(nextSample + i) % numLevels]);
+
+            columnLevels[(size_t) column] = range;
+        }
+
+        levels = columnLevels.data();
+        numLevels = numColumns;
+        nextSample = 0;
+    }
+
+    channelPath.clear();
+    getChannelAsPath (channelPath, levels, numLevels, nextSample);
 
-    g.fillPath (p, AffineTransform::fromTargetPoints (0.0f, -1.0f,               area.getX(), area.getY(),
-                                                      0.0f, 1.0f,                area.getX(), area.getBottom(),
-                                                      (float) numLevels, -1.0f,  area.getRight(), area.getY()));
+    g.fillPath (channelPath, AffineTransform::fromTargetPoints (0.0f, -1.0f,               area.getX(), area.getY(),
+                                                                0.0f, 1.0f,                area.getX(), area.getBottom(),
+                                                                (float) numLevels, -1.0f,  area.getRight(), area.getY()));
 }
 
 } // namespace juce
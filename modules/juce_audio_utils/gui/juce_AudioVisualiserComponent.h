@@ -52,7 +52,9 @@ public:
     /** Destructor. */
     ~AudioVisualiserComponent() override;
 
-    /** Changes the number of channels that the visualiser stores. */
+    /** Changes the number of channels that the visualiser stores.
+        This mustn't be called while another thread is pushing data into the visualiser.
+    */
     void setNumChannels (int numChannels);
 
     /** Changes the number of samples that the visualiser keeps in its history.
@@ -74,6 +76,10 @@ public:
     /** Pushes a buffer of channels data.
         The number of channels provided here is expected to match the number of channels
         that this AudioVisualiserComponent has been told to use.
+
+        The push methods are safe to call from the audio thread: they don't lock or
+        allocate, and the data is passed to the message thread through a wait-free queue.
+        The component only repaints when new data has arrived.
     */
     void pushBuffer (const AudioBuffer<float>& bufferToPush);
 
@@ -102,8 +108,9 @@ public:
     void setRepaintRate (int frequencyInHz);
 
     /** Draws a channel of audio data in the given bounds.
-        The default implementation just calls getChannelAsPath() and fits this into the given
-        area. You may want to override this to draw things differently.
+        The default implementation merges the levels down to one per physical pixel if there
+        are more than that, calls getChannelAsPath() and fits this into the given area. You
+        may want to override this to draw things differently.
     */
     virtual void paintChannel (Graphics&, Rectangle<float> bounds,
                                const Range<float>* levels, int numLevels, int nextSample);
@@ -122,9 +129,14 @@ private:
     struct ChannelInfo;
 
     OwnedArray<ChannelInfo> channels;
-    int numSamples, inputSamplesPerBlock;
+    int numSamples;
+    std::atomic<int> inputSamplesPerBlock;
     Colour backgroundColour, waveformColour;
 
+    // Reused by paintChannel() to avoid allocating on every repaint
+    Path channelPath;
+    std::vector<Range<float>> columnLevels;
+
     void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioVisualiserComponent)
@@ -239,9 +239,12 @@ void MidiKeyboardComponent::timerCallback()
     if (noPendingUpdates.exchange (true))
         return;
 
+    // A single snapshot of the state's atomic bitmaps is enough to find all the changed keys
+    const auto notesOn = state.getNotesOnForChannels (midiInChannelMask);
+
     for (auto i = getRangeStart(); i <= getRangeEnd(); ++i)
     {
-        const auto isOn = state.isNoteOnForChannels (midiInChannelMask, i);
+        const auto isOn = notesOn[i];
 
         if (keysCurrentlyDrawnDown[i] != isOn)
         {
@@ -121,6 +121,21 @@ static void initialiseIoBuffers (ChannelInfo<const float> ins,
     }
 }
 
+//==============================================================================
+/*  Everything that the audio callback needs, published as a whole whenever it changes. */
+struct AudioProcessorPlayer::RenderState
+{
+    AudioProcessor* processor = nullptr;
+    double sampleRate = 0;
+    int blockSize = 0;
+    NumChannels processorChannels;
+    MidiOutput* midiOutput = nullptr;
+
+    // Working space that only the audio thread touches
+    mutable std::vector<float*> channels;
+    mutable AudioBuffer<float> tempBuffer;
+};
+
 //==============================================================================
 AudioProcessorPlayer::AudioProcessorPlayer (bool doDoublePrecisionProcessing)
     : isDoublePrecision (doDoublePrecisionProcessing)
@@ -130,14 +145,19 @@ AudioProcessorPlayer::AudioProcessorPlayer (bool doDoublePrecisionProcessing)
 AudioProcessorPlayer::~AudioProcessorPlayer()
 {
     setProcessor (nullptr);
+
+    // Any swaps that are still queued have been cancelled, so don't need to run
+    backgroundThread = nullptr;
 }
 
 //==============================================================================
-AudioProcessorPlayer::NumChannels AudioProcessorPlayer::findMostSuitableLayout (const AudioProcessor& proc) const
+AudioProcessorPlayer::NumChannels AudioProcessorPlayer::findMostSuitableLayout (const AudioProcessor& proc,
+                                                                                NumChannels deviceChannels)
 {
     if (proc.isMidiEffect())
         return {};
 
+    const NumChannels defaultProcessorChannels { proc.getBusesLayout() };
     std::vector<NumChannels> layouts { deviceChannels };
 
     if (deviceChannels.ins == 0 || deviceChannels.ins == 1)
@@ -154,54 +174,167 @@ AudioProcessorPlayer::NumChannels AudioProcessorPlayer::findMostSuitableLayout (
     return it != std::end (layouts) ? *it : layouts[0];
 }
 
-void AudioProcessorPlayer::resizeChannels()
+void AudioProcessorPlayer::publishRenderState (bool includeProcessor)
 {
+    // Called with the lock held. The audio thread can carry on with the old state while
+    // this one is built, and it's been finished with by the time this returns.
     const auto maxChannels = jmax (deviceChannels.ins,
                                    deviceChannels.outs,
                                    actualProcessorChannels.ins,
                                    actualProcessorChannels.outs);
-    channels.resize ((size_t) maxChannels);
-    tempBuffer.setSize (maxChannels, blockSize);
+
+    auto state = std::make_unique<RenderState>();
+    state->processor = includeProcessor ? processor.load() : nullptr;
+    state->sampleRate = sampleRate;
+    state->blockSize = blockSize;
+    state->processorChannels = actualProcessorChannels;
+    state->midiOutput = midiOutput;
+    state->channels.resize ((size_t) maxChannels);
+    state->tempBuffer.setSize (maxChannels, blockSize);
+
+    renderState.reset (std::move (state));
+}
+
+AudioProcessorPlayer::NumChannels AudioProcessorPlayer::prepareProcessor (AudioProcessor& proc, const Settings& settings)
+{
+    const auto channels = findMostSuitableLayout (proc, settings.deviceChannels);
+
+    if (proc.isMidiEffect())
+        proc.setRateAndBufferSizeDetails (settings.sampleRate, settings.blockSize);
+    else
+        proc.setPlayConfigDetails (channels.ins, channels.outs, settings.sampleRate, settings.blockSize);
+
+    auto supportsDouble = proc.supportsDoublePrecisionProcessing() && settings.isDoublePrecision;
+
+    proc.setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
+                                                : AudioProcessor::singlePrecision);
+    proc.prepareToPlay (settings.sampleRate, settings.blockSize);
+    return channels;
+}
+
+AudioProcessorPlayer::Settings AudioProcessorPlayer::getSettings() const
+{
+    return { sampleRate, blockSize, deviceChannels, isDoublePrecision };
 }
 
 void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
 {
+    cancelBackgroundPreparation();
+
     const ScopedLock sl (lock);
+    setProcessorWithLockHeld (processorToPlay);
+}
 
+void AudioProcessorPlayer::setProcessorWithLockHeld (AudioProcessor* const processorToPlay)
+{
     if (processor == processorToPlay)
         return;
 
-    sampleCount = 0;
+    auto channels = actualProcessorChannels;
 
     if (processorToPlay != nullptr && sampleRate > 0 && blockSize > 0)
+        channels = prepareProcessor (*processorToPlay, getSettings());
+
+    installProcessor (processorToPlay, channels);
+}
+
+void AudioProcessorPlayer::installProcessor (AudioProcessor* const processorToPlay, NumChannels channels)
+{
+    // Called with the lock held, once the new processor has been prepared
+    auto* oldOne = isPrepared ? processor.load() : nullptr;
+
+    sampleCount = 0;
+    actualProcessorChannels = channels;
+    processor = processorToPlay;
+    isPrepared = true;
+    publishRenderState();
+
+    if (oldOne != nullptr && oldOne != processorToPlay)
+        oldOne->releaseResources();
+}
+
+void AudioProcessorPlayer::setProcessorAsync (AudioProcessor* const processorToPlay,
+                                              std::function<void (bool)> onFinished)
+{
+    const ScopedLock sl (lock);
+    const auto thisSwap = ++swapNumber;
+
+    if (backgroundThread == nullptr)
+        backgroundThread = std::make_unique<ThreadPool> (1);
+
+    backgroundThread->addJob ([this, processorToPlay, thisSwap, callback = std::move (onFinished)]
     {
-        defaultProcessorChannels = NumChannels { processorToPlay->getBusesLayout() };
-        actualProcessorChannels  = findMostSuitableLayout (*processorToPlay);
+        prepareInBackground (processorToPlay, thisSwap, std::move (callback));
+    });
+}
 
-        if (processorToPlay->isMidiEffect())
-            processorToPlay->setRateAndBufferSizeDetails (sampleRate, blockSize);
-        else
-            processorToPlay->setPlayConfigDetails (actualProcessorChannels.ins,
-                                                   actualProcessorChannels.outs,
-                                                   sampleRate,
-                                                   blockSize);
+void AudioProcessorPlayer::prepareInBackground (AudioProcessor* const processorToPlay,
+                                                const uint32 thisSwap,
+                                                std::function<void (bool)> onFinished)
+{
+    const auto finish = [&] (bool wasStarted)
+    {
+        if (onFinished != nullptr)
+            MessageManager::callAsync ([wasStarted, callback = std::move (onFinished)] { callback (wasStarted); });
+    };
+
+    for (;;)
+    {
+        Settings settings;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (thisSwap != swapNumber)
+                return finish (false);
+
+            // There's nothing to prepare until the device has started, or if the processor is already playing
+            if (processorToPlay == nullptr || processor == processorToPlay || sampleRate <= 0 || blockSize <= 0)
+            {
+                setProcessorWithLockHeld (processorToPlay);
+                return finish (true);
+            }
+
+            settings = getSettings();
+            isPreparingInBackground = true;
+        }
 
-        auto supportsDouble = processorToPlay->supportsDoublePrecisionProcessing() && isDoublePrecision;
+        // The lock isn't held here, so the audio callback and the message thread carry on as usual
+        const auto channels = prepareProcessor (*processorToPlay, settings);
 
-        processorToPlay->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
-                                                                : AudioProcessor::singlePrecision);
-        processorToPlay->prepareToPlay (sampleRate, blockSize);
+        const ScopedLock sl (lock);
+        isPreparingInBackground = false;
+        backgroundPreparationFinished.signal();
+
+        if (thisSwap == swapNumber && settings == getSettings())
+        {
+            installProcessor (processorToPlay, channels);
+            return finish (true);
+        }
+
+        processorToPlay->releaseResources();
+
+        if (thisSwap != swapNumber)
+            return finish (false);
+
+        // Otherwise the device was restarted while the processor was being prepared, so try again
     }
+}
 
-    AudioProcessor* oldOne = nullptr;
+void AudioProcessorPlayer::cancelBackgroundPreparation()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+            ++swapNumber;
 
-    oldOne = isPrepared ? processor : nullptr;
-    processor = processorToPlay;
-    isPrepared = true;
-    resizeChannels();
+            if (! isPreparingInBackground)
+                return;
+        }
 
-    if (oldOne != nullptr)
-        oldOne->releaseResources();
+        backgroundPreparationFinished.wait (-1);
+    }
 }
 
 void AudioProcessorPlayer::setDoublePrecisionProcessing (bool doublePrecision)
@@ -210,15 +343,20 @@ void AudioProcessorPlayer::setDoublePrecisionProcessing (bool doublePrecision)
     {
         const ScopedLock sl (lock);
 
-        if (processor != nullptr)
+        if (auto* proc = processor.load())
         {
-            processor->releaseResources();
+            // Take the processor away from the audio thread while it's being prepared again
+            publishRenderState (false);
+
+            proc->releaseResources();
+
+            auto supportsDouble = proc->supportsDoublePrecisionProcessing() && doublePrecision;
 
-            auto supportsDouble = processor->supportsDoublePrecisionProcessing() && doublePrecision;
+            proc->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
+                                                         : AudioProcessor::singlePrecision);
+            proc->prepareToPlay (sampleRate, blockSize);
 
-            processor->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
-                                                              : AudioProcessor::singlePrecision);
-            processor->prepareToPlay (sampleRate, blockSize);
+            publishRenderState();
         }
 
         isDoublePrecision = doublePrecision;
@@ -231,6 +369,7 @@ void AudioProcessorPlayer::setMidiOutput (MidiOutput* midiOutputToUse)
     {
         const ScopedLock sl (lock);
         midiOutput = midiOutputToUse;
+        publishRenderState();
     }
 }
 
@@ -242,32 +381,43 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
                                                              const int numSamples,
                                                              const AudioIODeviceCallbackContext& context)
 {
-    const ScopedLock sl (lock);
+    // This never waits, even if another thread is changing the processor or settings
+    const ReadCopyUpdatePointer<RenderState>::ScopedReader state (renderState);
+
+    if (state == nullptr)
+    {
+        for (int i = 0; i < numOutputChannels; ++i)
+            FloatVectorOperations::clear (outputChannelData[i], numSamples);
+
+        return;
+    }
 
     // These should have been prepared by audioDeviceAboutToStart()...
-    jassert (sampleRate > 0 && blockSize > 0);
+    jassert (state->sampleRate > 0 && state->blockSize > 0);
 
     incomingMidi.clear();
     messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
 
+    const auto processorChannels = state->processorChannels;
+
     initialiseIoBuffers ({ inputChannelData,  numInputChannels },
                          { outputChannelData, numOutputChannels },
                          numSamples,
-                         actualProcessorChannels.ins,
-                         actualProcessorChannels.outs,
-                         tempBuffer,
-                         channels);
+                         processorChannels.ins,
+                         processorChannels.outs,
+                         state->tempBuffer,
+                         state->channels);
 
-    const auto totalNumChannels = jmax (actualProcessorChannels.ins, actualProcessorChannels.outs);
-    AudioBuffer<float> buffer (channels.data(), (int) totalNumChannels, numSamples);
+    const auto totalNumChannels = jmax (processorChannels.ins, processorChannels.outs);
+    AudioBuffer<float> buffer (state->channels.data(), (int) totalNumChannels, numSamples);
 
-    if (processor != nullptr)
+    if (auto* processorToPlay = state->processor)
     {
         // The processor should be prepared to deal with the same number of output channels
         // as our output device.
-        jassert (processor->isMidiEffect() || numOutputChannels == actualProcessorChannels.outs);
+        jassert (processorToPlay->isMidiEffect() || numOutputChannels == processorChannels.outs);
 
-        const ScopedLock sl2 (processor->getCallbackLock());
+        const ScopedLock sl2 (processorToPlay->getCallbackLock());
 
         class PlayHead : private AudioPlayHead
         {
@@ -308,37 +458,35 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
             bool useThisPlayhead = processor.getPlayHead() == nullptr;
         };
 
-        PlayHead playHead { *processor,
+        PlayHead playHead { *processorToPlay,
                             context.hostTimeNs != nullptr ? makeOptional (*context.hostTimeNs) : nullopt,
-                            sampleCount,
-                            sampleRate };
-
-        sampleCount += (uint64_t) numSamples;
+                            sampleCount.fetch_add ((uint64_t) numSamples),
+                            state->sampleRate };
 
-        if (! processor->isSuspended())
+        if (! processorToPlay->isSuspended())
         {
-            if (processor->isUsingDoublePrecision())
+            if (processorToPlay->isUsingDoublePrecision())
             {
                 conversionBuffer.makeCopyOf (buffer, true);
-                processor->processBlock (conversionBuffer, incomingMidi);
+                processorToPlay->processBlock (conversionBuffer, incomingMidi);
                 buffer.makeCopyOf (conversionBuffer, true);
             }
             else
             {
-                processor->processBlock (buffer, incomingMidi);
+                processorToPlay->processBlock (buffer, incomingMidi);
             }
 
-            if (midiOutput != nullptr)
+            if (auto* output = state->midiOutput)
             {
-                if (midiOutput->isBackgroundThreadRunning())
+                if (output->isBackgroundThreadRunning())
                 {
-                    midiOutput->sendBlockOfMessages (incomingMidi,
-                                                     Time::getMillisecondCounterHiRes(),
-                                                     sampleRate);
+                    output->sendBlockOfMessages (incomingMidi,
+                                                 Time::getMillisecondCounterHiRes(),
+                                                 state->sampleRate);
                 }
                 else
                 {
-                    midiOutput->sendBlockOfMessagesNow (incomingMidi);
+                    output->sendBlockOfMessagesNow (incomingMidi);
                 }
             }
 
@@ -363,18 +511,19 @@ void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
     blockSize  = newBlockSize;
     deviceChannels = { numChansIn, numChansOut };
 
-    resizeChannels();
+    publishRenderState (false);
 
     messageCollector.reset (sampleRate);
 
-    if (processor != nullptr)
+    if (auto* oldProcessor = processor.load())
     {
         if (isPrepared)
-            processor->releaseResources();
+            oldProcessor->releaseResources();
 
-        auto* oldProcessor = processor;
-        setProcessor (nullptr);
-        setProcessor (oldProcessor);
+        // This can't wait for a swap that's being prepared in the background, as that needs
+        // the lock, but the swap will notice that the settings have changed
+        setProcessorWithLockHeld (nullptr);
+        setProcessorWithLockHeld (oldProcessor);
     }
 }
 
@@ -382,13 +531,15 @@ void AudioProcessorPlayer::audioDeviceStopped()
 {
     const ScopedLock sl (lock);
 
-    if (processor != nullptr && isPrepared)
-        processor->releaseResources();
+    const auto wasPrepared = isPrepared;
 
     sampleRate = 0.0;
     blockSize = 0;
     isPrepared = false;
-    tempBuffer.setSize (1, 1);
+    renderState.reset();
+
+    if (auto* proc = processor.load(); proc != nullptr && wasPrepared)
+        proc->releaseResources();
 }
 
 void AudioProcessorPlayer::handleIncomingMidiMessage (MidiInput*, const MidiMessage& message)
@@ -465,6 +616,49 @@ struct AudioProcessorPlayerTests  : public UnitTest
                 }
             }
         }
+
+        beginTest ("Processors passed to setProcessorAsync are prepared away from the calling thread");
+        {
+            MockDevice device;
+            CountingProcessor first, second, cancelled;
+
+            {
+                AudioProcessorPlayer player;
+                player.audioDeviceAboutToStart (&device);
+                player.setProcessor (&first);
+
+                expect (player.getCurrentProcessor() == &first);
+                expectEquals (first.numPrepares.load(), 1);
+
+                const auto callingThread = Thread::getCurrentThreadId();
+                second.prepareTimeMs = 50;
+                player.setProcessorAsync (&second);
+
+                // The old processor keeps playing until the new one is ready
+                expect (player.getCurrentProcessor() == &first);
+
+                for (int i = 0; i < 500 && player.getCurrentProcessor() != &second; ++i)
+                    Thread::sleep (10);
+
+                expect (player.getCurrentProcessor() == &second);
+                expectEquals (second.numPrepares.load(), 1);
+                expect (second.preparingThread != callingThread);
+                expectEquals (first.numReleases.load(), 1);
+
+                // A swap that's overtaken by a call to setProcessor never gets installed
+                cancelled.prepareTimeMs = 50;
+                player.setProcessorAsync (&cancelled);
+                player.setProcessor (&first);
+
+                expect (player.getCurrentProcessor() == &first);
+                expectEquals (second.numReleases.load(), 1);
+
+                player.audioDeviceStopped();
+            }
+
+            expectEquals (cancelled.numPrepares.load(), cancelled.numReleases.load());
+            expectEquals (first.numPrepares.load(), first.numReleases.load());
+        }
     }
 
     static AudioBuffer<float> getTestBuffer (int numChannels, int numSamples)
@@ -476,6 +670,70 @@ struct AudioProcessorPlayerTests  : public UnitTest
 
         return result;
     }
+
+    class MockDevice  : public AudioIODevice
+    {
+    public:
+        MockDevice() : AudioIODevice ("mock", "mock") {}
+
+        StringArray getOutputChannelNames() override                { return { "o1", "o2" }; }
+        StringArray getInputChannelNames() override                 { return { "i1", "i2" }; }
+        Array<double> getAvailableSampleRates() override            { return { 44100.0 }; }
+        Array<int> getAvailableBufferSizes() override               { return { 128 }; }
+        int getDefaultBufferSize() override                         { return 128; }
+        String open (const BigInteger&, const BigInteger&, double, int) override { return {}; }
+        void close() override                                       {}
+        bool isOpen() override                                      { return true; }
+        void start (AudioIODeviceCallback*) override                {}
+        void stop() override                                        {}
+        bool isPlaying() override                                   { return true; }
+        String getLastError() override                              { return {}; }
+        int getCurrentBufferSizeSamples() override                  { return 128; }
+        double getCurrentSampleRate() override                      { return 44100.0; }
+        int getCurrentBitDepth() override                           { return 16; }
+        BigInteger getActiveOutputChannels() const override         { return 3; }
+        BigInteger getActiveInputChannels() const override          { return 3; }
+        int getOutputLatencyInSamples() override                    { return 0; }
+        int getInputLatencyInSamples() override                     { return 0; }
+    };
+
+    class CountingProcessor  : public AudioProcessor
+    {
+    public:
+        CountingProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())) {}
+
+        const String getName() const override                         { return "Counting Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return {}; }
+        bool producesMidi() const override                            { return {}; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+
+        void prepareToPlay (double, int) override
+        {
+            preparingThread = Thread::getCurrentThreadId();
+            Thread::sleep (prepareTimeMs);
+            ++numPrepares;
+        }
+
+        void releaseResources() override                              { ++numReleases; }
+
+        using AudioProcessor::processBlock;
+
+        std::atomic<int> numPrepares { 0 }, numReleases { 0 };
+        std::atomic<Thread::ThreadID> preparingThread { nullptr };
+        int prepareTimeMs = 0;
+    };
 };
 
 static AudioProcessorPlayerTests audioProcessorPlayerTests;
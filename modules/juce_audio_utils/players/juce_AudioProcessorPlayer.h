@@ -56,9 +56,33 @@ public:
 
         The processor that is passed in will not be deleted or owned by this object.
         To stop anything playing, pass a nullptr to this method.
+
+        This calls the new processor's prepareToPlay() and the old one's releaseResources()
+        on the calling thread. If a processor is being prepared by setProcessorAsync(),
+        this waits for that to finish first, so once this returns, any processor that was
+        passed to setProcessorAsync() can safely be deleted.
     */
     void setProcessor (AudioProcessor* processorToPlay);
 
+    /** Prepares a processor on a background thread, and then starts playing it.
+
+        This does the same as setProcessor(), but returns straight away. The processor
+        that's currently playing carries on until the new one has been prepared, and then
+        the audio callback switches over between two blocks without ever having to wait.
+        The old processor's releaseResources() is called on the background thread too.
+
+        If the audio device is restarted while the processor is being prepared, it's
+        prepared again with the new settings. If setProcessor() or setProcessorAsync()
+        is called again before it's ready, it's released again without being played.
+
+        The callback is called on the message thread once this has finished, with true if
+        the processor was started, or false if it was replaced by a later call. The
+        processor mustn't be deleted before then, unless setProcessor() has been called
+        in the meantime.
+    */
+    void setProcessorAsync (AudioProcessor* processorToPlay,
+                            std::function<void (bool wasStarted)> onFinished = nullptr);
+
     /** Returns the current audio processor that is being played. */
     AudioProcessor* getCurrentProcessor() const noexcept            { return processor; }
 
@@ -115,29 +139,61 @@ private:
                      { AudioChannelSet::canonicalChannelSet (outs) } };
         }
 
+        auto tie() const { return std::tie (ins, outs); }
+        bool operator== (const NumChannels& other) const { return tie() == other.tie(); }
+
         int ins = 0, outs = 0;
     };
 
+    // Everything that a processor is prepared with
+    struct Settings
+    {
+        double sampleRate = 0;
+        int blockSize = 0;
+        NumChannels deviceChannels;
+        bool isDoublePrecision = false;
+
+        auto tie() const { return std::tie (sampleRate, blockSize, deviceChannels, isDoublePrecision); }
+        bool operator== (const Settings& other) const { return tie() == other.tie(); }
+    };
+
     //==============================================================================
-    NumChannels findMostSuitableLayout (const AudioProcessor&) const;
-    void resizeChannels();
+    static NumChannels findMostSuitableLayout (const AudioProcessor&, NumChannels deviceChannels);
+    static NumChannels prepareProcessor (AudioProcessor&, const Settings&);
+    Settings getSettings() const;
+    void setProcessorWithLockHeld (AudioProcessor*);
+    void installProcessor (AudioProcessor*, NumChannels);
+    void prepareInBackground (AudioProcessor*, uint32 swapNumber, std::function<void (bool)> onFinished);
+    void cancelBackgroundPreparation();
+    void publishRenderState (bool includeProcessor = true);
 
     //==============================================================================
-    AudioProcessor* processor = nullptr;
+    struct RenderState;
+
+    // These are changed with the lock held, and copied into a new RenderState for the
+    // audio thread, which never takes the lock
+    std::atomic<AudioProcessor*> processor { nullptr };
     CriticalSection lock;
     double sampleRate = 0;
     int blockSize = 0;
     bool isPrepared = false, isDoublePrecision = false;
 
-    NumChannels deviceChannels, defaultProcessorChannels, actualProcessorChannels;
-    std::vector<float*> channels;
-    AudioBuffer<float> tempBuffer;
-    AudioBuffer<double> conversionBuffer;
+    NumChannels deviceChannels, actualProcessorChannels;
+    MidiOutput* midiOutput = nullptr;
+    ReadCopyUpdatePointer<RenderState> renderState;
 
+    // Only used by the audio thread
+    AudioBuffer<double> conversionBuffer;
     MidiBuffer incomingMidi;
     MidiMessageCollector messageCollector;
-    MidiOutput* midiOutput = nullptr;
-    uint64_t sampleCount = 0;
+    std::atomic<uint64_t> sampleCount { 0 };
+
+    // Each call to setProcessor() or setProcessorAsync() cancels any earlier swap that's
+    // still being prepared in the background
+    uint32 swapNumber = 0;
+    bool isPreparingInBackground = false;
+    WaitableEvent backgroundPreparationFinished;
+    std::unique_ptr<ThreadPool> backgroundThread;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorPlayer)
 };
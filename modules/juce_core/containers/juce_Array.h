@@ -714,6 +714,35 @@ public:
         addSorted (comparator, newElement);
     }
 
+    /** Inserts a number of new elements into the array, assuming that the array is sorted.
+
+        This gives the same result as calling addSorted() for each of the new elements in
+        turn, but rather than shifting the existing elements along for each insertion, it
+        sorts the new elements and then merges them into the array in a single pass. If the
+        array isn't sorted, the behaviour of this method will be unpredictable.
+
+        @param comparator           the comparator to use to compare the elements - see the sort()
+                                    method for details about the form this object should take
+        @param elementsToAdd        the array of elements to add
+        @param numElementsToAdd     how many elements are in this other array
+        @see addSorted, sort
+    */
+    template <class ElementComparator>
+    void addSortedArray (ElementComparator& comparator, const ElementType* elementsToAdd, int numElementsToAdd)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (numElementsToAdd <= 0)
+            return;
+
+        const auto oldSize = values.size();
+        values.addArray (elementsToAdd, numElementsToAdd);
+
+        SortFunctionConverter<ElementComparator> converter (comparator);
+        std::stable_sort (values.begin() + oldSize, values.end(), converter);
+        std::inplace_merge (values.begin(), values.begin() + oldSize, values.end(), converter);
+    }
+
     /** Finds the index of an element in the array, assuming that the array is sorted.
 
         This will use a comparator to do a binary-chop to find the index of the given
@@ -1083,6 +1112,19 @@ public:
     template <class ElementComparator>
     void sort (ElementComparator& comparator, bool retainOrderOfEquivalentItems = false);
 
+    /** Sorts the elements in the array, using a WorkStealingThreadPool to sort
+        different parts of the array at the same time.
+
+        This works like the other sort() method, and is worth using for arrays of many
+        thousands of elements. The comparator's compareElements() method will be called
+        from several threads at once, so it mustn't modify any shared state.
+
+        @see parallelSortArray, WorkStealingThreadPool::parallelSort
+    */
+    template <class ElementComparator>
+    void sort (ElementComparator& comparator, WorkStealingThreadPool& pool,
+               bool retainOrderOfEquivalentItems = false);
+
     //==============================================================================
     /** Returns the CriticalSection that locks this array.
         To lock, you can call getLock().enter() and getLock().exit(), or preferably use
@@ -1157,4 +1199,15 @@ void Array<ElementType, TypeOfCriticalSectionToUse, minimumAllocatedSize>::sort
     sortArray (comparator, values.begin(), 0, size() - 1, retainOrderOfEquivalentItems);
 }
 
+template <typename ElementType, typename TypeOfCriticalSectionToUse, int minimumAllocatedSize>
+template <class ElementComparator>
+void Array<ElementType, TypeOfCriticalSectionToUse, minimumAllocatedSize>::sort (
+    ElementComparator& comparator,
+    WorkStealingThreadPool& pool,
+    bool retainOrderOfEquivalentItems)
+{
+    const ScopedLockType lock (getLock());
+    parallelSortArray (pool, comparator, values.begin(), 0, size() - 1, retainOrderOfEquivalentItems);
+}
+
 } // namespace juce
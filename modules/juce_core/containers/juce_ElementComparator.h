@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class WorkStealingThreadPool;
+
 #ifndef DOXYGEN
 
 /** This is an internal helper class which converts a juce ElementComparator style
@@ -97,6 +99,33 @@ static void sortArray (ElementComparator& comparator,
     }
 }
 
+/**
+    Sorts a range of elements in an array, using a WorkStealingThreadPool to sort
+    different parts of the range at the same time.
+
+    This takes the same arguments as sortArray(), and is worth using for arrays of
+    many thousands of elements. The comparator's compareElements() method will be
+    called from several threads at once, so it mustn't modify any shared state.
+
+    @see sortArray, WorkStealingThreadPool::parallelSort
+*/
+template <class ElementType, class ElementComparator, class ThreadPoolType = WorkStealingThreadPool>
+static void parallelSortArray (ThreadPoolType& pool,
+                               ElementComparator& comparator,
+                               ElementType* const array,
+                               int firstElement,
+                               int lastElement,
+                               const bool retainOrderOfEquivalentItems)
+{
+    jassert (firstElement >= 0);
+
+    if (lastElement > firstElement)
+    {
+        SortFunctionConverter<ElementComparator> converter (comparator);
+        pool.parallelSort (array + firstElement, array + lastElement + 1, converter, retainOrderOfEquivalentItems);
+    }
+}
+
 
 //==============================================================================
 /**
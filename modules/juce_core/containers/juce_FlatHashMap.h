@@ -0,0 +1,732 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Generates the hashes used by FlatHashMap and FlatHashSet.
+
+    Unlike DefaultHashFunctions, these return a full 64-bit hash rather than a slot
+    index, and the table mixes the bits itself. Strings are hashed from their
+    characters, so a table with String or Identifier keys can be searched with a
+    StringRef or a string literal without creating a String. Integers of different
+    types that compare equal also get the same hash.
+
+    @see FlatHashMap, FlatHashSet
+    @tags{Core}
+*/
+struct DefaultFlatHashFunctions
+{
+    /** Generates a hash from an integer. */
+    template <typename IntegerType, std::enable_if_t<std::is_integral_v<IntegerType>, int> = 0>
+    static uint64 generateHash (IntegerType key) noexcept           { return (uint64) key; }
+
+    /** Generates a hash from a string. */
+    static uint64 generateHash (StringRef key) noexcept
+    {
+        uint64 result = 0xcbf29ce484222325;
+
+        for (auto* c = key.text.getAddress(); *c != 0; ++c)
+            result = (result ^ (uint64) *c) * 0x100000001b3;
+
+        return result;
+    }
+
+    /** Generates a hash from an Identifier, using its characters so that it matches the hash of the string. */
+    template <typename IdentifierType, std::enable_if_t<std::is_same_v<IdentifierType, Identifier>, int> = 0>
+    static uint64 generateHash (const IdentifierType& key) noexcept { return generateHash (StringRef (key.getCharPointer())); }
+
+    /** Generates a hash from a UUID. */
+    template <typename UuidType, std::enable_if_t<std::is_same_v<UuidType, Uuid>, int> = 0>
+    static uint64 generateHash (const UuidType& key) noexcept       { return key.hash(); }
+
+    /** Generates a hash from a pointer. Character pointers are hashed as strings instead. */
+    template <typename ObjectType, std::enable_if_t<! (std::is_same_v<std::remove_cv_t<ObjectType>, char>
+                                                         || std::is_same_v<std::remove_cv_t<ObjectType>, wchar_t>), int> = 0>
+    static uint64 generateHash (ObjectType* key) noexcept           { return (uint64) (pointer_sized_uint) key; }
+};
+
+#ifndef JUCE_FLAT_HASH_USE_SSE2
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define JUCE_FLAT_HASH_USE_SSE2 1
+ #else
+  #define JUCE_FLAT_HASH_USE_SSE2 0
+ #endif
+#endif
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  Each slot has a control byte, which is either one of these values, or the low
+        7 bits of the hash of the item that it holds.
+    */
+    static constexpr int8 flatHashEmpty = -128;
+    static constexpr int8 flatHashDeleted = -2;
+
+    inline int countTrailingZeroBits (uint64 n) noexcept
+    {
+        jassert (n != 0);
+
+       #if JUCE_MSVC
+        unsigned long index;
+        #if JUCE_64BIT
+         _BitScanForward64 (&index, n);
+        #else
+         if (_BitScanForward (&index, (unsigned long) n))
+             return (int) index;
+
+         _BitScanForward (&index, (unsigned long) (n >> 32));
+         index += 32;
+        #endif
+        return (int) index;
+       #else
+        return __builtin_ctzll (n);
+       #endif
+    }
+
+   #if JUCE_FLAT_HASH_USE_SSE2
+    /*  Checks the control bytes of 16 slots at once, returning a mask with one bit per slot. */
+    struct FlatHashGroup
+    {
+        static constexpr size_t width = 16;
+
+        explicit FlatHashGroup (const int8* c) noexcept
+            : control (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (c))) {}
+
+        uint64 match (int8 h) const noexcept                { return toMask (_mm_cmpeq_epi8 (_mm_set1_epi8 (h), control)); }
+        uint64 matchEmpty() const noexcept                  { return match (flatHashEmpty); }
+        uint64 matchEmptyOrDeleted() const noexcept         { return toMask (_mm_cmpgt_epi8 (_mm_set1_epi8 (-1), control)); }
+
+        static size_t getIndex (uint64 mask) noexcept       { return (size_t) countTrailingZeroBits (mask); }
+
+    private:
+        static uint64 toMask (__m128i bytes) noexcept       { return (uint64) (uint32) _mm_movemask_epi8 (bytes); }
+
+        __m128i control;
+    };
+   #else
+    /*  Checks the control bytes of 8 slots at once using ordinary 64-bit arithmetic,
+        returning a mask with the top bit of each slot's byte set. The match() mask can
+        occasionally include a full slot that doesn't match, which is harmless because
+        the keys are compared afterwards.
+    */
+    struct FlatHashGroup
+    {
+        static constexpr size_t width = 8;
+
+        explicit FlatHashGroup (const int8* c) noexcept
+        {
+            std::memcpy (&control, c, sizeof (control));
+            control = ByteOrder::swapIfBigEndian (control);
+        }
+
+        uint64 match (int8 h) const noexcept
+        {
+            auto x = control ^ (lowBits * (uint8) h);
+            return (x - lowBits) & ~x & highBits;
+        }
+
+        uint64 matchEmpty() const noexcept                  { return control & ~(control << 6) & highBits; }
+        uint64 matchEmptyOrDeleted() const noexcept         { return control & ~(control << 7) & highBits; }
+
+        static size_t getIndex (uint64 mask) noexcept       { return (size_t) countTrailingZeroBits (mask) >> 3; }
+
+    private:
+        static constexpr uint64 lowBits = 0x0101010101010101, highBits = 0x8080808080808080;
+
+        uint64 control;
+    };
+   #endif
+
+    /*  An open-addressing hash table in the style of Google's SwissTable. The slots are
+        split into groups, and a lookup probes whole groups, using the control bytes to
+        find the few slots whose keys are worth comparing. The table grows when it's
+        7/8 full, counting the slots of removed items, which stay marked as deleted
+        unless their group still has an empty slot.
+    */
+    template <typename KeyType, typename ItemType, class HashFunctionType>
+    class FlatHashTable
+    {
+    public:
+        explicit FlatHashTable (HashFunctionType hashFunctionToUse)
+            : hashFunction (std::move (hashFunctionToUse)) {}
+
+        FlatHashTable (const FlatHashTable& other)
+            : hashFunction (other.hashFunction)
+        {
+            if (other.numItems == 0)
+                return;
+
+            allocate (other.capacity);
+            std::copy (other.control.get(), other.control.get() + capacity, control.get());
+
+            for (size_t i = 0; i < capacity; ++i)
+                if (control[i] >= 0)
+                    new (getSlot (i)) ItemType (other.getItem (i));
+
+            numItems = other.numItems;
+            growthLeft = other.growthLeft;
+        }
+
+        FlatHashTable (FlatHashTable&& other) noexcept
+            : hashFunction (other.hashFunction)
+        {
+            swapWith (other);
+        }
+
+        FlatHashTable& operator= (const FlatHashTable& other)
+        {
+            if (this != &other)
+            {
+                auto copy (other);
+                swapWith (copy);
+            }
+
+            return *this;
+        }
+
+        FlatHashTable& operator= (FlatHashTable&& other) noexcept
+        {
+            swapWith (other);
+            return *this;
+        }
+
+        ~FlatHashTable()
+        {
+            destroyItems();
+        }
+
+        void swapWith (FlatHashTable& other) noexcept
+        {
+            std::swap (hashFunction, other.hashFunction);
+            control.swapWith (other.control);
+            slots.swapWith (other.slots);
+            std::swap (capacity, other.capacity);
+            std::swap (numItems, other.numItems);
+            std::swap (growthLeft, other.growthLeft);
+        }
+
+        //==============================================================================
+        size_t size() const noexcept            { return numItems; }
+        size_t getCapacity() const noexcept     { return capacity; }
+
+        void clear() noexcept
+        {
+            destroyItems();
+            std::fill (control.get(), control.get() + capacity, flatHashEmpty);
+            numItems = 0;
+            growthLeft = getMaxLoad (capacity);
+        }
+
+        void reserve (size_t numItemsNeeded)
+        {
+            if (numItemsNeeded <= numItems + growthLeft)
+                return;
+
+            auto newCapacity = jmax (capacity, FlatHashGroup::width);
+
+            while (getMaxLoad (newCapacity) < numItemsNeeded)
+                newCapacity *= 2;
+
+            rehash (newCapacity);
+        }
+
+        //==============================================================================
+        template <typename OtherKeyType>
+        ItemType* find (const OtherKeyType& key) const
+        {
+            if (numItems == 0)
+                return nullptr;
+
+            auto index = findIndex (key, getHash (key));
+            return index != capacity ? &getItem (index) : nullptr;
+        }
+
+        /*  Returns the item with this key, and whether it was just added. If it's new,
+            createItem is called with the uninitialised memory that it must construct it in.
+        */
+        template <typename CreateItem>
+        std::pair<ItemType*, bool> findOrInsert (const KeyType& key, CreateItem&& createItem)
+        {
+            auto hash = getHash (key);
+
+            if (numItems > 0)
+            {
+                auto index = findIndex (key, hash);
+
+                if (index != capacity)
+                    return { &getItem (index), false };
+            }
+
+            if (growthLeft == 0)
+                grow();
+
+            auto index = findFreeSlot (control.get(), capacity, hash);
+            growthLeft -= (control[index] == flatHashEmpty ? 1u : 0u);
+            control[index] = getControlByte (hash);
+            createItem (getSlot (index));
+            ++numItems;
+
+            return { &getItem (index), true };
+        }
+
+        template <typename OtherKeyType>
+        bool remove (const OtherKeyType& key)
+        {
+            if (numItems == 0)
+                return false;
+
+            auto index = findIndex (key, getHash (key));
+
+            if (index == capacity)
+                return false;
+
+            getItem (index).~ItemType();
+            --numItems;
+
+            // If this slot's group has never been full, no probe has gone past it, so the
+            // slot can be made empty again rather than being left as a tombstone
+            if (FlatHashGroup (control.get() + (index & ~(FlatHashGroup::width - 1))).matchEmpty() != 0)
+            {
+                control[index] = flatHashEmpty;
+                ++growthLeft;
+            }
+            else
+            {
+                control[index] = flatHashDeleted;
+            }
+
+            return true;
+        }
+
+        //==============================================================================
+        template <bool isConst>
+        struct Iterator
+        {
+            using Table = std::conditional_t<isConst, const FlatHashTable, FlatHashTable>;
+            using Item  = std::conditional_t<isConst, const ItemType, ItemType>;
+
+            Iterator (Table& t, size_t startIndex) noexcept  : table (&t), index (startIndex)
+            {
+                skipUnusedSlots();
+            }
+
+            Item& operator*() const noexcept                    { return table->getItem (index); }
+            Item* operator->() const noexcept                   { return &table->getItem (index); }
+            Iterator& operator++() noexcept                     { ++index; skipUnusedSlots(); return *this; }
+            bool operator== (const Iterator& other) const noexcept  { return index == other.index; }
+            bool operator!= (const Iterator& other) const noexcept  { return index != other.index; }
+
+        private:
+            void skipUnusedSlots() noexcept
+            {
+                while (index < table->capacity && table->control[index] < 0)
+                    ++index;
+            }
+
+            Table* table;
+            size_t index;
+        };
+
+        Iterator<false> begin() noexcept            { return { *this, 0 }; }
+        Iterator<false> end() noexcept              { return { *this, capacity }; }
+        Iterator<true> begin() const noexcept       { return { *this, 0 }; }
+        Iterator<true> end() const noexcept         { return { *this, capacity }; }
+
+    private:
+        //==============================================================================
+        struct Slot
+        {
+            alignas (ItemType) char storage[sizeof (ItemType)];
+        };
+
+        HashFunctionType hashFunction;
+        HeapBlock<int8> control;
+        HeapBlock<Slot> slots;
+        size_t capacity = 0, numItems = 0, growthLeft = 0;
+
+        static const KeyType& getKey (const ItemType& item) noexcept
+        {
+            if constexpr (std::is_same_v<ItemType, KeyType>)
+                return item;
+            else
+                return item.first;
+        }
+
+        void* getSlot (size_t index) const noexcept         { return slots[index].storage; }
+        ItemType& getItem (size_t index) const noexcept     { return *std::launder (reinterpret_cast<ItemType*> (getSlot (index))); }
+
+        static constexpr size_t getMaxLoad (size_t numSlots) noexcept   { return numSlots - numSlots / 8; }
+        static constexpr int8 getControlByte (uint64 hash) noexcept    { return (int8) (hash & 0x7f); }
+
+        template <typename OtherKeyType>
+        uint64 getHash (const OtherKeyType& key) const
+        {
+            // The hash functions don't need to spread their bits, as they're mixed here
+            auto h = hashFunction.generateHash (key);
+            h = (h ^ (h >> 33)) * 0xff51afd7ed558ccd;
+            h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53;
+            return h ^ (h >> 33);
+        }
+
+        /*  Visits the groups in the order 0, 1, 3, 6, 10.. after the starting one, which
+            reaches every group because the number of groups is a power of two.
+        */
+        struct ProbeSequence
+        {
+            ProbeSequence (uint64 hash, size_t numSlots) noexcept
+                : groupMask (numSlots / FlatHashGroup::width - 1),
+                  group ((size_t) (hash >> 7) & groupMask) {}
+
+            size_t getOffset() const noexcept   { return group * FlatHashGroup::width; }
+            void next() noexcept                { group = (group + ++step) & groupMask; }
+
+            size_t groupMask, group, step = 0;
+        };
+
+        template <typename OtherKeyType>
+        size_t findIndex (const OtherKeyType& key, uint64 hash) const
+        {
+            const auto h = getControlByte (hash);
+
+            for (ProbeSequence probe (hash, capacity);; probe.next())
+            {
+                const auto offset = probe.getOffset();
+                const FlatHashGroup group (control.get() + offset);
+
+                for (auto mask = group.match (h); mask != 0; mask &= mask - 1)
+                {
+                    const auto index = offset + FlatHashGroup::getIndex (mask);
+
+                    if (getKey (getItem (index)) == key)
+                        return index;
+                }
+
+                if (group.matchEmpty() != 0)
+                    return capacity;
+            }
+        }
+
+        static size_t findFreeSlot (const int8* controlBytes, size_t numSlots, uint64 hash) noexcept
+        {
+            for (ProbeSequence probe (hash, numSlots);; probe.next())
+            {
+                const auto offset = probe.getOffset();
+                const auto mask = FlatHashGroup (controlBytes + offset).matchEmptyOrDeleted();
+
+                if (mask != 0)
+                    return offset + FlatHashGroup::getIndex (mask);
+            }
+        }
+
+        void allocate (size_t numSlots)
+        {
+            jassert (isPowerOfTwo (numSlots) && numSlots >= FlatHashGroup::width);
+
+            control.malloc (numSlots);
+            slots.malloc (numSlots);
+            std::fill (control.get(), control.get() + numSlots, flatHashEmpty);
+            capacity = numSlots;
+        }
+
+        void grow()
+        {
+            if (capacity == 0)
+                rehash (FlatHashGroup::width);
+            else if (numItems * 32 <= capacity * 25)
+                rehash (capacity);  // there are plenty of tombstones, so just clear them out
+            else
+                rehash (capacity * 2);
+        }
+
+        void rehash (size_t newCapacity)
+        {
+            FlatHashTable newTable (hashFunction);
+            newTable.allocate (newCapacity);
+
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                if (control[i] >= 0)
+                {
+                    auto& item = getItem (i);
+                    auto hash = getHash (getKey (item));
+                    auto index = findFreeSlot (newTable.control.get(), newCapacity, hash);
+
+                    newTable.control[index] = getControlByte (hash);
+                    new (newTable.getSlot (index)) ItemType (std::move (item));
+                    item.~ItemType();
+                    control[i] = flatHashEmpty;
+                }
+            }
+
+            newTable.numItems = numItems;
+            newTable.growthLeft = getMaxLoad (newCapacity) - numItems;
+            numItems = 0;
+            swapWith (newTable);
+        }
+
+        void destroyItems() noexcept
+        {
+            if constexpr (! std::is_trivially_destructible_v<ItemType>)
+                if (numItems > 0)
+                    for (size_t i = 0; i < capacity; ++i)
+                        if (control[i] >= 0)
+                            getItem (i).~ItemType();
+        }
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A hash map that stores its items in a single flat array, rather than in a
+    separately allocated node for each item like HashMap does.
+
+    Lookups probe groups of slots at once, comparing a byte of each slot's hash using
+    SIMD instructions where they're available, so a search usually only compares
+    the key of the item it's looking for. The table grows automatically as items are
+    added, so there's no need to choose a number of slots in advance.
+
+    Items are stored as std::pair<const KeyType, ValueType>, so you can iterate with:
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+    map.set ("two", 2);
+
+    DBG (map["two"]); // prints "2", and doesn't need to create a String for the key
+
+    for (auto& [key, value] : map)
+        DBG (key << " -> " << value);
+    @endcode
+
+    Lookups are templates, so they can take any type that the hash function accepts
+    and that can be compared with a key. With the DefaultFlatHashFunctions, that
+    means that a map with String or Identifier keys can be searched using a StringRef.
+    A custom hash function class must look like this, and must give equal hashes for
+    any two values that compare equal, even when they're different types:
+    @code
+    struct MyHashGenerator
+    {
+        uint64 generateHash (const MyKeyType& key) const    { return someFunctionOfMyKeyType (key); }
+    };
+    @endcode
+
+    Adding or removing items can move the others, so it invalidates any iterators,
+    references or pointers to items in the map. Unlike HashMap, there's no built-in
+    locking.
+
+    @see FlatHashSet, HashMap, DefaultFlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashMap
+{
+private:
+    using KeyTypeParameter   = typename TypeHelpers::ParameterType<KeyType>::type;
+    using ValueTypeParameter = typename TypeHelpers::ParameterType<ValueType>::type;
+    using ItemType           = std::pair<const KeyType, ValueType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty map. This doesn't allocate any memory until an item is added. */
+    explicit FlatHashMap (HashFunctionType hashFunction = HashFunctionType())
+        : table (std::move (hashFunction)) {}
+
+    //==============================================================================
+    /** Removes all items from the map, keeping the memory that was allocated for them. */
+    void clear() noexcept                                   { table.clear(); }
+
+    /** Returns the number of items in the map. */
+    int size() const noexcept                               { return (int) table.size(); }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                           { return table.size() == 0; }
+
+    /** Makes sure that the map can hold the given number of items without having to grow. */
+    void reserve (int numItemsNeeded)                       { table.reserve ((size_t) jmax (0, numItemsNeeded)); }
+
+    /** Returns the number of slots that have been allocated, which is always a power of two. */
+    int getNumSlots() const noexcept                        { return (int) table.getCapacity(); }
+
+    //==============================================================================
+    /** Returns the value corresponding to a given key, or a default-constructed value
+        if the key isn't in the map.
+    */
+    template <typename OtherKeyType>
+    ValueType operator[] (const OtherKeyType& key) const
+    {
+        if (auto* value = find (key))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns a pointer to the value for a given key, or nullptr if it's not in the map. */
+    template <typename OtherKeyType>
+    ValueType* find (const OtherKeyType& key)
+    {
+        auto* item = table.find (key);
+        return item != nullptr ? &item->second : nullptr;
+    }
+
+    /** Returns a pointer to the value for a given key, or nullptr if it's not in the map. */
+    template <typename OtherKeyType>
+    const ValueType* find (const OtherKeyType& key) const
+    {
+        auto* item = table.find (key);
+        return item != nullptr ? &item->second : nullptr;
+    }
+
+    /** Returns true if the map contains an item with the given key. */
+    template <typename OtherKeyType>
+    bool contains (const OtherKeyType& key) const           { return table.find (key) != nullptr; }
+
+    /** Returns a reference to the value for a given key, adding a default-constructed
+        value to the map first if the key isn't already there.
+    */
+    ValueType& getReference (KeyTypeParameter key)
+    {
+        return table.findOrInsert (key, [&] (void* slot) { new (slot) ItemType (key, ValueType()); }).first->second;
+    }
+
+    /** Adds or replaces the value for a given key. */
+    void set (KeyTypeParameter key, ValueTypeParameter value)
+    {
+        auto result = table.findOrInsert (key, [&] (void* slot) { new (slot) ItemType (key, value); });
+
+        if (! result.second)
+            result.first->second = value;
+    }
+
+    /** Removes the item with the given key, returning true if there was one. */
+    template <typename OtherKeyType>
+    bool remove (const OtherKeyType& key)                   { return table.remove (key); }
+
+    /** Efficiently swaps the contents of two maps. */
+    void swapWith (FlatHashMap& other) noexcept             { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Returns an iterator to the first item, which is a std::pair of the key and value. */
+    auto begin() noexcept                                   { return table.begin(); }
+    /** Returns the end iterator. */
+    auto end() noexcept                                     { return table.end(); }
+    /** Returns an iterator to the first item, which is a std::pair of the key and value. */
+    auto begin() const noexcept                             { return table.begin(); }
+    /** Returns the end iterator. */
+    auto end() const noexcept                               { return table.end(); }
+
+private:
+    //==============================================================================
+    detail::FlatHashTable<KeyType, ItemType, HashFunctionType> table;
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    A set of unique keys, stored using the same flat open-addressing table as
+    FlatHashMap.
+
+    As with FlatHashMap, lookups can use any type that the hash function accepts,
+    so a FlatHashSet<String> can be searched with a StringRef, and adding or removing
+    keys invalidates any iterators.
+
+    @code
+    FlatHashSet<Identifier> ids;
+    ids.add ("width");
+
+    jassert (ids.contains (StringRef ("width")));
+    @endcode
+
+    @see FlatHashMap, SortedSet
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashSet
+{
+private:
+    using KeyTypeParameter = typename TypeHelpers::ParameterType<KeyType>::type;
+
+public:
+    //==============================================================================
+    /** Creates an empty set. This doesn't allocate any memory until a key is added. */
+    explicit FlatHashSet (HashFunctionType hashFunction = HashFunctionType())
+        : table (std::move (hashFunction)) {}
+
+    //==============================================================================
+    /** Removes all keys from the set, keeping the memory that was allocated for them. */
+    void clear() noexcept                                   { table.clear(); }
+
+    /** Returns the number of keys in the set. */
+    int size() const noexcept                               { return (int) table.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                           { return table.size() == 0; }
+
+    /** Makes sure that the set can hold the given number of keys without having to grow. */
+    void reserve (int numItemsNeeded)                       { table.reserve ((size_t) jmax (0, numItemsNeeded)); }
+
+    /** Returns the number of slots that have been allocated, which is always a power of two. */
+    int getNumSlots() const noexcept                        { return (int) table.getCapacity(); }
+
+    //==============================================================================
+    /** Adds a key to the set, returning true if it wasn't already there. */
+    bool add (KeyTypeParameter key)
+    {
+        return table.findOrInsert (key, [&] (void* slot) { new (slot) KeyType (key); }).second;
+    }
+
+    /** Returns true if the set contains the given key. */
+    template <typename OtherKeyType>
+    bool contains (const OtherKeyType& key) const           { return table.find (key) != nullptr; }
+
+    /** Removes a key, returning true if it was in the set. */
+    template <typename OtherKeyType>
+    bool remove (const OtherKeyType& key)                   { return table.remove (key); }
+
+    /** Efficiently swaps the contents of two sets. */
+    void swapWith (FlatHashSet& other) noexcept             { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Returns an iterator to the first key. */
+    auto begin() const noexcept                             { return table.begin(); }
+    /** Returns the end iterator. */
+    auto end() const noexcept                               { return table.end(); }
+
+private:
+    //==============================================================================
+    detail::FlatHashTable<KeyType, KeyType, HashFunctionType> table;
+
+    JUCE_LEAK_DETECTOR (FlatHashSet)
+};
+
+} // namespace juce
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests  : public UnitTest
+{
+public:
+    FlatHashMapTests()
+        : UnitTest ("FlatHashMap", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Random operations match std::unordered_map");
+        {
+            auto r = getRandom();
+
+            testAgainstStdMap<int> (r, [] (Random& rand) { return rand.nextInt (2000) - 1000; });
+            testAgainstStdMap<String> (r, [] (Random& rand) { return String::toHexString (rand.nextInt (2000)); });
+        }
+
+        beginTest ("Heterogeneous lookup");
+        {
+            FlatHashMap<String, int> strings;
+            strings.set ("alpha", 1);
+            strings.set (String ("beta"), 2);
+
+            expect (strings.contains (StringRef ("alpha")));
+            expect (strings.contains ("beta"));
+            expect (! strings.contains (StringRef ("gamma")));
+            expectEquals (strings[StringRef ("beta")], 2);
+            expectEquals (*strings.find ("alpha"), 1);
+            expect (strings.remove (StringRef ("alpha")));
+            expect (! strings.contains (String ("alpha")));
+
+            FlatHashSet<Identifier> ids;
+            ids.add ("width");
+            ids.add (Identifier ("height"));
+
+            expect (ids.contains (Identifier ("width")));
+            expect (ids.contains (StringRef ("height")));
+            expect (! ids.contains (StringRef ("depth")));
+
+            FlatHashMap<int64, int> numbers;
+            numbers.set (-5, 1);
+            numbers.set ((int64) 1 << 40, 2);
+
+            expect (numbers.contains (-5));
+            expect (numbers.contains ((int8) -5));
+            expect (! numbers.contains ((uint32) -5));
+            expectEquals (numbers[(int64) 1 << 40], 2);
+        }
+
+        beginTest ("Growth and reuse of removed slots");
+        {
+            FlatHashMap<int, int> map;
+            expectEquals (map.getNumSlots(), 0);
+
+            for (int i = 0; i < 1000; ++i)
+                map.set (i, i * 2);
+
+            expectEquals (map.size(), 1000);
+            expect (isPowerOfTwo (map.getNumSlots()));
+            expect (map.getNumSlots() * 7 / 8 >= map.size());
+
+            for (int i = 0; i < 1000; ++i)
+                expectEquals (map[i], i * 2);
+
+            const auto numSlots = map.getNumSlots();
+
+            for (int round = 0; round < 50; ++round)
+            {
+                for (int i = 0; i < 1000; ++i)
+                    expect (map.remove (round * 1000 + i));
+
+                for (int i = 0; i < 1000; ++i)
+                    map.set ((round + 1) * 1000 + i, i);
+            }
+
+            expectEquals (map.size(), 1000);
+            expectEquals (map.getNumSlots(), numSlots);
+
+            map.clear();
+            expect (map.isEmpty());
+            expectEquals (map.getNumSlots(), numSlots);
+
+            FlatHashSet<int> set;
+            set.reserve (500);
+            const auto reservedSlots = set.getNumSlots();
+
+            for (int i = 0; i < 500; ++i)
+                expect (set.add (i));
+
+            expect (! set.add (10));
+            expectEquals (set.getNumSlots(), reservedSlots);
+        }
+
+        beginTest ("Items are copied, moved and destroyed");
+        {
+            auto tracker = std::make_shared<int>();
+            auto getNumLiveItems = [&] { return (int) tracker.use_count() - 1; };
+
+            {
+                FlatHashMap<int, std::shared_ptr<int>> map;
+
+                for (int i = 0; i < 100; ++i)
+                    map.set (i, tracker);
+
+                expectEquals (getNumLiveItems(), 100);
+
+                auto copy = map;
+                expectEquals (getNumLiveItems(), 200);
+
+                for (int i = 0; i < 50; ++i)
+                    copy.remove (i);
+
+                expectEquals (getNumLiveItems(), 150);
+
+                auto moved = std::move (copy);
+                expectEquals (getNumLiveItems(), 150);
+                expectEquals (moved.size(), 50);
+
+                moved.swapWith (map);
+                expectEquals (map.size(), 50);
+                expectEquals (moved.size(), 100);
+
+                moved.clear();
+                expectEquals (getNumLiveItems(), 50);
+
+                int total = 0;
+
+                for (auto& [key, value] : map)
+                {
+                    expect (key >= 50);
+                    expect (value == tracker);
+                    total += key;
+                }
+
+                expectEquals (total, (50 + 99) * 25);
+            }
+
+            expectEquals (getNumLiveItems(), 0);
+        }
+
+        beginTest ("Benchmarks");
+        {
+            constexpr int numItems = 100000, numLookups = 1000000;
+
+            Array<int> keys;
+
+            for (int i = 0; i < numItems; ++i)
+                keys.add (i * 7919);
+
+            benchmark<HashMap<int, int>> ("HashMap<int>", keys, numLookups, [] (auto& m, int k) { return m.contains (k); });
+            benchmark<std::unordered_map<int, int>> ("std::unordered_map<int>", keys, numLookups, [] (auto& m, int k) { return m.count (k) != 0; });
+            benchmark<FlatHashMap<int, int>> ("FlatHashMap<int>", keys, numLookups, [] (auto& m, int k) { return m.contains (k); });
+
+            StringArray stringKeys;
+
+            for (auto k : keys)
+                stringKeys.add ("id_" + String (k));
+
+            benchmark<HashMap<String, int>> ("HashMap<String>", stringKeys, numLookups, [] (auto& m, const String& k) { return m.contains (k); });
+            benchmark<std::unordered_map<String, int>> ("std::unordered_map<String>", stringKeys, numLookups, [] (auto& m, const String& k) { return m.count (k) != 0; });
+            benchmark<FlatHashMap<String, int>> ("FlatHashMap<String>", stringKeys, numLookups, [] (auto& m, const String& k) { return m.contains (k); });
+            benchmark<FlatHashMap<String, int>> ("FlatHashMap<String>, StringRef lookups", stringKeys, numLookups,
+                                                 [] (auto& m, const String& k) { return m.contains (StringRef (k.toRawUTF8())); });
+        }
+    }
+
+private:
+    //==============================================================================
+    template <typename KeyType, typename MakeKey>
+    void testAgainstStdMap (Random& r, MakeKey&& makeKey)
+    {
+        FlatHashMap<KeyType, int> map;
+        std::unordered_map<KeyType, int> expected;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto key = makeKey (r);
+            auto value = r.nextInt();
+
+            switch (r.nextInt (4))
+            {
+                case 0:
+                    map.set (key, value);
+                    expected[key] = value;
+                    break;
+
+                case 1:
+                    map.getReference (key) += value;
+                    expected[key] += value;
+                    break;
+
+                case 2:
+                    expectEquals ((int) map.remove (key), (int) expected.erase (key));
+                    break;
+
+                default:
+                {
+                    auto iter = expected.find (key);
+                    auto* found = map.find (key);
+                    expect ((found != nullptr) == (iter != expected.end()));
+
+                    if (found != nullptr && iter != expected.end())
+                        expectEquals (*found, iter->second);
+
+                    break;
+                }
+            }
+
+            expectEquals (map.size(), (int) expected.size());
+        }
+
+        int numIterated = 0;
+
+        for (const auto& [key, value] : map)
+        {
+            expectEquals (value, expected[key]);
+            ++numIterated;
+        }
+
+        expectEquals (numIterated, (int) expected.size());
+    }
+
+    template <typename KeyType>
+    static void setValue (std::unordered_map<KeyType, int>& map, const KeyType& key, int value)   { map[key] = value; }
+
+    template <typename MapType, typename KeyType>
+    static void setValue (MapType& map, const KeyType& key, int value)                            { map.set (key, value); }
+
+    template <typename MapType, typename KeyArray, typename Contains>
+    void benchmark (const String& mapName, const KeyArray& keys, int numLookups, Contains&& contains)
+    {
+        MapType map;
+        auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < keys.size(); ++i)
+            setValue (map, keys[i], i);
+
+        auto inserted = Time::getMillisecondCounterHiRes();
+        int numFound = 0;
+
+        for (int i = 0; i < numLookups; ++i)
+            numFound += contains (map, keys[(int) (((int64) i * 48271) % keys.size())]) ? 1 : 0;
+
+        auto finished = Time::getMillisecondCounterHiRes();
+        expectEquals (numFound, numLookups);
+
+        logMessage (mapName + ": insert " + String (inserted - start, 1) + " ms, lookup " + String (finished - inserted, 1) + " ms");
+    }
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+} // namespace juce
@@ -0,0 +1,570 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  The positions that are written by different threads are kept this many bytes
+        apart so that they never share a cache line. Padding is used rather than alignas
+        so that the queues don't need over-aligned allocations.
+    */
+    static constexpr size_t lockFreeQueueCacheLineSize = 64;
+
+    template <typename ElementType>
+    struct LockFreeQueueSlot
+    {
+        template <typename... Args>
+        void construct (Args&&... args)     { new (storage) ElementType (std::forward<Args> (args)...); }
+
+        ElementType& get() noexcept         { return *std::launder (reinterpret_cast<ElementType*> (storage)); }
+        void destroy() noexcept             { get().~ElementType(); }
+
+        alignas (ElementType) char storage[sizeof (ElementType)];
+    };
+
+    template <typename ElementType>
+    struct LockFreeQueueCell  : public LockFreeQueueSlot<ElementType>
+    {
+        std::atomic<size_t> sequence { 0 };
+    };
+
+    inline size_t getLockFreeQueueMask (int minimumCapacity) noexcept
+    {
+        jassert (minimumCapacity > 0);
+        return (size_t) nextPowerOfTwo (jmax (2, minimumCapacity)) - 1;
+    }
+
+    /*  The bounded queue described by Dmitry Vyukov, in which every cell has a sequence
+        number that tells producers and consumers whether it's ready for them. Producers
+        claim a cell by incrementing the write position with a compare-and-swap, and
+        consumers do the same with the read position when there's more than one of them.
+    */
+    template <typename ElementType, bool multipleConsumers>
+    class SequencedLockFreeQueue
+    {
+    public:
+        explicit SequencedLockFreeQueue (int minimumCapacity)
+            : mask (getLockFreeQueueMask (minimumCapacity)),
+              cells (new LockFreeQueueCell<ElementType>[mask + 1])
+        {
+            for (size_t i = 0; i <= mask; ++i)
+                cells[i].sequence.store (i, std::memory_order_relaxed);
+        }
+
+        ~SequencedLockFreeQueue()
+        {
+            for (auto pos = readPosition.load (std::memory_order_relaxed);; ++pos)
+            {
+                auto& cell = cells[pos & mask];
+
+                if (cell.sequence.load (std::memory_order_acquire) != pos + 1)
+                    break;
+
+                cell.destroy();
+            }
+        }
+
+        int getCapacity() const noexcept            { return (int) mask + 1; }
+
+        int getNumReady() const noexcept
+        {
+            const auto read  = readPosition.load (std::memory_order_acquire);
+            const auto write = writePosition.load (std::memory_order_acquire);
+            return write > read ? (int) jmin (write - read, mask + 1) : 0;
+        }
+
+        bool isEmpty() const noexcept               { return getNumReady() == 0; }
+
+        template <typename... Args>
+        bool emplace (Args&&... args)
+        {
+            auto pos = writePosition.load (std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& cell = cells[pos & mask];
+                const auto difference = (ptrdiff_t) (cell.sequence.load (std::memory_order_acquire) - pos);
+
+                if (difference == 0)
+                {
+                    if (writePosition.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.construct (std::forward<Args> (args)...);
+                        cell.sequence.store (pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = writePosition.load (std::memory_order_relaxed);
+                }
+            }
+        }
+
+        template <typename Fn>
+        bool popWith (Fn&& fn)
+        {
+            auto pos = readPosition.load (std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& cell = cells[pos & mask];
+                const auto difference = (ptrdiff_t) (cell.sequence.load (std::memory_order_acquire) - (pos + 1));
+
+                if (difference < 0)
+                    return false;
+
+                if (! multipleConsumers)
+                {
+                    // The only consumer can't have been overtaken, so the cell must be ours
+                    jassert (difference == 0);
+                    readPosition.store (pos + 1, std::memory_order_relaxed);
+                    consume (cell, pos, fn);
+                    return true;
+                }
+
+                if (difference == 0)
+                {
+                    if (readPosition.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        consume (cell, pos, fn);
+                        return true;
+                    }
+                }
+                else
+                {
+                    pos = readPosition.load (std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        template <typename Fn>
+        void consume (LockFreeQueueCell<ElementType>& cell, size_t pos, Fn& fn)
+        {
+            const ScopeGuard release { [&]
+            {
+                cell.destroy();
+                cell.sequence.store (pos + mask + 1, std::memory_order_release);
+            } };
+
+            fn (cell.get());
+        }
+
+        const size_t mask;
+        std::unique_ptr<LockFreeQueueCell<ElementType>[]> cells;
+        char padding1[lockFreeQueueCacheLineSize];
+        std::atomic<size_t> writePosition { 0 };
+        char padding2[lockFreeQueueCacheLineSize];
+        std::atomic<size_t> readPosition { 0 };
+        char padding3[lockFreeQueueCacheLineSize];
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A bounded, wait-free queue of objects for one producer thread and one consumer thread.
+
+    Unlike AbstractFifo, this holds the objects itself. They're constructed in place when
+    pushed and moved out when popped, so it can carry move-only types such as
+    std::unique_ptr, and nothing is allocated after the queue has been created.
+
+    One thread may push and one other thread may pop at the same time. If more than one
+    thread needs to push, use an MPSCQueue or an MPMCQueue instead.
+
+    @code
+    SPSCQueue<std::unique_ptr<Job>> queue { 64 };
+
+    // on the producer thread..
+    if (! queue.push (std::make_unique<Job>()))
+        handleFullQueue();
+
+    // on the consumer thread..
+    std::unique_ptr<Job> job;
+
+    while (queue.pop (job))
+        job->run();
+    @endcode
+
+    @see MPSCQueue, MPMCQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class SPSCQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold at least the given number of objects.
+
+        The capacity is rounded up to a power of two, so use getCapacity() if you need
+        to know the exact size.
+    */
+    explicit SPSCQueue (int minimumCapacity)
+        : mask (detail::getLockFreeQueueMask (minimumCapacity)),
+          slots (new detail::LockFreeQueueSlot<ElementType>[mask + 1])
+    {
+    }
+
+    /** Destructor. Any objects still in the queue are deleted. */
+    ~SPSCQueue()
+    {
+        const auto write = writePosition.load (std::memory_order_acquire);
+
+        for (auto pos = readPosition.load (std::memory_order_relaxed); pos != write; ++pos)
+            slots[pos & mask].destroy();
+    }
+
+    //==============================================================================
+    /** Returns the number of objects that the queue can hold. */
+    int getCapacity() const noexcept                { return (int) mask + 1; }
+
+    /** Returns the number of objects waiting to be popped.
+
+        When this is called by a thread other than the producer or consumer, the result
+        may already be out of date by the time it returns.
+    */
+    int getNumReady() const noexcept
+    {
+        return (int) (writePosition.load (std::memory_order_acquire) - readPosition.load (std::memory_order_acquire));
+    }
+
+    /** Returns the number of objects that could be pushed before the queue is full. */
+    int getFreeSpace() const noexcept               { return getCapacity() - getNumReady(); }
+
+    /** Returns true if there's nothing waiting to be popped. */
+    bool isEmpty() const noexcept                   { return getNumReady() == 0; }
+
+    //==============================================================================
+    /** Adds a copy of an object to the queue. Call this from the producer thread only.
+        @returns false if the queue was full
+    */
+    bool push (const ElementType& object)           { return emplace (object); }
+
+    /** Moves an object into the queue. Call this from the producer thread only.
+
+        If the queue is full, the object is left untouched, so you can try again later.
+        @returns false if the queue was full
+    */
+    bool push (ElementType&& object)                { return emplace (std::move (object)); }
+
+    /** Constructs an object in place at the back of the queue. Call this from the
+        producer thread only.
+        @returns false if the queue was full, in which case nothing is constructed
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)
+    {
+        const auto write = writePosition.load (std::memory_order_relaxed);
+
+        if (write - cachedReadPosition > mask)
+        {
+            cachedReadPosition = readPosition.load (std::memory_order_acquire);
+
+            if (write - cachedReadPosition > mask)
+                return false;
+        }
+
+        slots[write & mask].construct (std::forward<Args> (args)...);
+        writePosition.store (write + 1, std::memory_order_release);
+        return true;
+    }
+
+    //==============================================================================
+    /** Moves the object at the front of the queue into the one supplied. Call this from
+        the consumer thread only.
+        @returns false if the queue was empty
+    */
+    bool pop (ElementType& result)
+    {
+        return popWith ([&] (ElementType& e) { result = std::move (e); });
+    }
+
+    /** Removes the object at the front of the queue, passing it to a function first.
+
+        The function is called with a reference to the object while it's still in the
+        queue, and the object is destroyed afterwards. Call this from the consumer
+        thread only.
+        @returns false if the queue was empty
+    */
+    template <typename Fn>
+    bool popWith (Fn&& fn)
+    {
+        const auto read = readPosition.load (std::memory_order_relaxed);
+
+        if (read == cachedWritePosition)
+        {
+            cachedWritePosition = writePosition.load (std::memory_order_acquire);
+
+            if (read == cachedWritePosition)
+                return false;
+        }
+
+        auto& slot = slots[read & mask];
+
+        const ScopeGuard release { [&]
+        {
+            slot.destroy();
+            readPosition.store (read + 1, std::memory_order_release);
+        } };
+
+        fn (slot.get());
+        return true;
+    }
+
+    /** Removes everything from the queue, passing each object to a function in turn.
+
+        Objects that are pushed while this is running may or may not be included. Call
+        this from the consumer thread only.
+        @returns the number of objects that were removed
+    */
+    template <typename Fn>
+    int popAll (Fn&& fn)
+    {
+        int numPopped = 0;
+
+        for (auto numReady = getNumReady(); numPopped < numReady && popWith (fn);)
+            ++numPopped;
+
+        return numPopped;
+    }
+
+private:
+    //==============================================================================
+    const size_t mask;
+    std::unique_ptr<detail::LockFreeQueueSlot<ElementType>[]> slots;
+    char padding1[detail::lockFreeQueueCacheLineSize];
+    std::atomic<size_t> writePosition { 0 };
+    size_t cachedReadPosition = 0;
+    char padding2[detail::lockFreeQueueCacheLineSize];
+    std::atomic<size_t> readPosition { 0 };
+    size_t cachedWritePosition = 0;
+    char padding3[detail::lockFreeQueueCacheLineSize];
+
+    JUCE_DECLARE_NON_COPYABLE (SPSCQueue)
+};
+
+//==============================================================================
+/**
+    A bounded, lock-free queue of objects that any number of threads can push into, but
+    only one thread pops from.
+
+    This is useful for things like sending commands or messages to a single worker or
+    audio thread from several places at once. Pushing never waits for a lock, allocates
+    memory or blocks on the consumer, although a producer may have to retry if another
+    producer gets in first.
+
+    The objects are constructed in place when they're pushed, so their constructors
+    shouldn't throw. Objects pushed by any one thread are popped in the order that
+    that thread pushed them.
+
+    @see SPSCQueue, MPMCQueue
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class MPSCQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold at least the given number of objects.
+
+        The capacity is rounded up to a power of two, so use getCapacity() if you need
+        to know the exact size.
+    */
+    explicit MPSCQueue (int minimumCapacity)  : queue (minimumCapacity) {}
+
+    /** Destructor. Any objects still in the queue are deleted. */
+    ~MPSCQueue() = default;
+
+    //==============================================================================
+    /** Returns the number of objects that the queue can hold. */
+    int getCapacity() const noexcept                { return queue.getCapacity(); }
+
+    /** Returns the number of objects waiting to be popped.
+
+        As other threads may be pushing at the same time, this can only be a guide.
+    */
+    int getNumReady() const noexcept                { return queue.getNumReady(); }
+
+    /** Returns true if there's nothing waiting to be popped. */
+    bool isEmpty() const noexcept                   { return queue.isEmpty(); }
+
+    //==============================================================================
+    /** Adds a copy of an object to the queue. This can be called from any thread.
+        @returns false if the queue was full
+    */
+    bool push (const ElementType& object)           { return queue.emplace (object); }
+
+    /** Moves an object into the queue. This can be called from any thread.
+
+        If the queue is full, the object is left untouched, so you can try again later.
+        @returns false if the queue was full
+    */
+    bool push (ElementType&& object)                { return queue.emplace (std::move (object)); }
+
+    /** Constructs an object in place at the back of the queue. This can be called from
+        any thread.
+        @returns false if the queue was full, in which case nothing is constructed
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)                   { return queue.emplace (std::forward<Args> (args)...); }
+
+    //==============================================================================
+    /** Moves the object at the front of the queue into the one supplied. Call this from
+        the consumer thread only.
+
+        This can return false while a producer is still in the middle of pushing the next
+        object, even though getNumReady() includes it.
+
+        @returns false if there was nothing to pop
+    */
+    bool pop (ElementType& result)                  { return popWith ([&] (ElementType& e) { result = std::move (e); }); }
+
+    /** Removes the object at the front of the queue, passing it to a function first.
+
+        The function is called with a reference to the object while it's still in the
+        queue, and the object is destroyed afterwards. Call this from the consumer
+        thread only.
+        @returns false if there was nothing to pop
+    */
+    template <typename Fn>
+    bool popWith (Fn&& fn)                          { return queue.popWith (fn); }
+
+    /** Removes everything from the queue, passing each object to a function in turn.
+
+        Objects that are pushed while this is running may or may not be included. Call
+        this from the consumer thread only.
+        @returns the number of objects that were removed
+    */
+    template <typename Fn>
+    int popAll (Fn&& fn)
+    {
+        int numPopped = 0;
+
+        for (auto numReady = getNumReady(); numPopped < numReady && popWith (fn);)
+            ++numPopped;
+
+        return numPopped;
+    }
+
+private:
+    //==============================================================================
+    detail::SequencedLockFreeQueue<ElementType, false> queue;
+
+    JUCE_DECLARE_NON_COPYABLE (MPSCQueue)
+};
+
+//==============================================================================
+/**
+    A bounded, lock-free queue of objects that any number of threads can push into and
+    pop from at the same time.
+
+    This works in the same way as an MPSCQueue, but consumers must also compete for
+    each object, so if you only ever pop from one thread, an MPSCQueue is a bit quicker.
+    Each object is popped by exactly one consumer.
+
+    @see SPSCQueue, MPSCQueue
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class MPMCQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold at least the given number of objects.
+
+        The capacity is rounded up to a power of two, so use getCapacity() if you need
+        to know the exact size.
+    */
+    explicit MPMCQueue (int minimumCapacity)  : queue (minimumCapacity) {}
+
+    /** Destructor. Any objects still in the queue are deleted. */
+    ~MPMCQueue() = default;
+
+    //==============================================================================
+    /** Returns the number of objects that the queue can hold. */
+    int getCapacity() const noexcept                { return queue.getCapacity(); }
+
+    /** Returns the number of objects waiting to be popped.
+
+        As other threads may be pushing and popping at the same time, this can only be
+        a guide.
+    */
+    int getNumReady() const noexcept                { return queue.getNumReady(); }
+
+    /** Returns true if there's nothing waiting to be popped. */
+    bool isEmpty() const noexcept                   { return queue.isEmpty(); }
+
+    //==============================================================================
+    /** Adds a copy of an object to the queue. This can be called from any thread.
+        @returns false if the queue was full
+    */
+    bool push (const ElementType& object)           { return queue.emplace (object); }
+
+    /** Moves an object into the queue. This can be called from any thread.
+
+        If the queue is full, the object is left untouched, so you can try again later.
+        @returns false if the queue was full
+    */
+    bool push (ElementType&& object)                { return queue.emplace (std::move (object)); }
+
+    /** Constructs an object in place at the back of the queue. This can be called from
+        any thread.
+        @returns false if the queue was full, in which case nothing is constructed
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)                   { return queue.emplace (std::forward<Args> (args)...); }
+
+    //==============================================================================
+    /** Moves the object at the front of the queue into the one supplied. This can be
+        called from any thread.
+        @returns false if there was nothing to pop
+    */
+    bool pop (ElementType& result)                  { return popWith ([&] (ElementType& e) { result = std::move (e); }); }
+
+    /** Removes the object at the front of the queue, passing it to a function first.
+
+        The function is called with a reference to the object while it's still in the
+        queue, and the object is destroyed afterwards. This can be called from any thread.
+        @returns false if there was nothing to pop
+    */
+    template <typename Fn>
+    bool popWith (Fn&& fn)                          { return queue.popWith (fn); }
+
+private:
+    //==============================================================================
+    detail::SequencedLockFreeQueue<ElementType, true> queue;
+
+    JUCE_DECLARE_NON_COPYABLE (MPMCQueue)
+};
+
+} // namespace juce
@@ -0,0 +1,382 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class LockFreeQueuesTests  : public UnitTest
+{
+public:
+    LockFreeQueuesTests()
+        : UnitTest ("Lock-free Queues", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Capacity is rounded up to a power of two");
+        {
+            expectEquals (SPSCQueue<int> (1).getCapacity(), 2);
+            expectEquals (SPSCQueue<int> (5).getCapacity(), 8);
+            expectEquals (MPSCQueue<int> (64).getCapacity(), 64);
+            expectEquals (MPMCQueue<int> (100).getCapacity(), 128);
+        }
+
+        beginTest ("SPSCQueue");
+        {
+            SPSCQueue<int> queue (4);
+            testSingleThreaded (queue);
+
+            expectEquals (queue.getFreeSpace(), 4);
+            queue.push (1);
+            expectEquals (queue.getFreeSpace(), 3);
+        }
+
+        beginTest ("MPSCQueue");
+        {
+            MPSCQueue<int> queue (4);
+            testSingleThreaded (queue);
+        }
+
+        beginTest ("MPMCQueue");
+        {
+            MPMCQueue<int> queue (4);
+            testSingleThreaded (queue);
+        }
+
+        beginTest ("popAll removes everything in order");
+        {
+            SPSCQueue<int> spsc (8);
+            MPSCQueue<int> mpsc (8);
+
+            for (int i = 0; i < 6; ++i)
+            {
+                spsc.push (i);
+                mpsc.push (i);
+            }
+
+            Array<int> fromSpsc, fromMpsc;
+            expectEquals (spsc.popAll ([&] (int i) { fromSpsc.add (i); }), 6);
+            expectEquals (mpsc.popAll ([&] (int i) { fromMpsc.add (i); }), 6);
+
+            expect (fromSpsc == Array<int> { 0, 1, 2, 3, 4, 5 });
+            expect (fromMpsc == fromSpsc);
+            expect (spsc.isEmpty() && mpsc.isEmpty());
+        }
+
+        beginTest ("Move-only objects");
+        {
+            testMoveOnly<SPSCQueue<std::unique_ptr<int>>>();
+            testMoveOnly<MPSCQueue<std::unique_ptr<int>>>();
+            testMoveOnly<MPMCQueue<std::unique_ptr<int>>>();
+        }
+
+        beginTest ("Objects are destroyed when popped and when the queue is deleted");
+        {
+            testLifetimes<SPSCQueue<Counted>>();
+            testLifetimes<MPSCQueue<Counted>>();
+            testLifetimes<MPMCQueue<Counted>>();
+        }
+
+        beginTest ("One producer and one consumer");
+        {
+            SPSCQueue<Item> queue (64);
+            testThreaded (queue, 1, 1, 200000);
+        }
+
+        beginTest ("Many producers and one consumer");
+        {
+            MPSCQueue<Item> queue (64);
+            testThreaded (queue, 4, 1, 50000);
+        }
+
+        beginTest ("Many producers and many consumers");
+        {
+            MPMCQueue<Item> queue (64);
+            testThreaded (queue, 4, 4, 50000);
+
+            MPMCQueue<Item> tinyQueue (2);
+            testThreaded (tinyQueue, 3, 3, 20000);
+        }
+
+        beginTest ("Benchmarks");
+        {
+            constexpr int numItems = 1 << 20;
+
+            LockedQueue lockedSpsc (1024);
+            logMessage ("AbstractFifo with a lock, 1 -> 1: " + String (timeThreaded (lockedSpsc, 1, 1, numItems), 1) + " ms");
+
+            SPSCQueue<Item> spsc (1024);
+            logMessage ("SPSCQueue, 1 -> 1: " + String (timeThreaded (spsc, 1, 1, numItems), 1) + " ms");
+
+            LockedQueue lockedMpsc (1024);
+            logMessage ("AbstractFifo with a lock, 4 -> 1: " + String (timeThreaded (lockedMpsc, 4, 1, numItems / 4), 1) + " ms");
+
+            MPSCQueue<Item> mpsc (1024);
+            logMessage ("MPSCQueue, 4 -> 1: " + String (timeThreaded (mpsc, 4, 1, numItems / 4), 1) + " ms");
+
+            LockedQueue lockedMpmc (1024);
+            logMessage ("AbstractFifo with a lock, 4 -> 4: " + String (timeThreaded (lockedMpmc, 4, 4, numItems / 4), 1) + " ms");
+
+            MPMCQueue<Item> mpmc (1024);
+            logMessage ("MPMCQueue, 4 -> 4: " + String (timeThreaded (mpmc, 4, 4, numItems / 4), 1) + " ms");
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Item
+    {
+        int producer = 0, index = 0;
+    };
+
+    struct Counted
+    {
+        explicit Counted (std::atomic<int>& c) : count (&c)   { ++*count; }
+        Counted (const Counted& other) : count (other.count)  { ++*count; }
+        Counted& operator= (const Counted&) = default;
+        ~Counted()                                            { --*count; }
+
+        std::atomic<int>* count;
+    };
+
+    /*  The sort of queue that the lock-free ones replace, used as the benchmark baseline. */
+    struct LockedQueue
+    {
+        explicit LockedQueue (int capacity) : fifo (capacity), items ((size_t) capacity) {}
+
+        bool push (const Item& item)
+        {
+            const ScopedLock sl (lock);
+
+            if (fifo.getFreeSpace() == 0)
+                return false;
+
+            fifo.write (1).forEach ([&] (int index) { items[(size_t) index] = item; });
+            return true;
+        }
+
+        bool pop (Item& item)
+        {
+            const ScopedLock sl (lock);
+
+            if (fifo.getNumReady() == 0)
+                return false;
+
+            fifo.read (1).forEach ([&] (int index) { item = items[(size_t) index]; });
+            return true;
+        }
+
+        CriticalSection lock;
+        AbstractFifo fifo;
+        std::vector<Item> items;
+    };
+
+    struct FunctionThread  : public Thread
+    {
+        explicit FunctionThread (std::function<void()> f)
+            : Thread ("Queue test"), fn (std::move (f))
+        {
+            startThread();
+        }
+
+        ~FunctionThread() override
+        {
+            waitForThreadToExit (-1);
+        }
+
+        void run() override { fn(); }
+
+        std::function<void()> fn;
+    };
+
+    //==============================================================================
+    template <typename Queue>
+    void testSingleThreaded (Queue& queue)
+    {
+        int result = -1;
+        expect (queue.isEmpty());
+        expect (! queue.pop (result));
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < queue.getCapacity(); ++i)
+                expect (queue.push (i));
+
+            expect (! queue.push (100));
+            expect (! queue.emplace (100));
+            expectEquals (queue.getNumReady(), queue.getCapacity());
+
+            for (int i = 0; i < queue.getCapacity(); ++i)
+            {
+                expect (queue.pop (result));
+                expectEquals (result, i);
+            }
+
+            expect (! queue.pop (result));
+            expect (queue.isEmpty());
+
+            expect (queue.emplace (42));
+            expect (queue.popWith ([&] (int& i) { result = i; }));
+            expectEquals (result, 42);
+        }
+    }
+
+    template <typename Queue>
+    void testMoveOnly()
+    {
+        Queue queue (2);
+
+        expect (queue.push (std::make_unique<int> (1)));
+        expect (queue.emplace (new int (2)));
+
+        auto extra = std::make_unique<int> (3);
+        expect (! queue.push (std::move (extra)));
+        expect (extra != nullptr, "a failed push shouldn't move from the object");
+
+        std::unique_ptr<int> result;
+        expect (queue.pop (result) && *result == 1);
+        expect (queue.push (std::move (extra)));
+        expect (extra == nullptr);
+        expect (queue.pop (result) && *result == 2);
+        expect (queue.pop (result) && *result == 3);
+        expect (! queue.pop (result));
+    }
+
+    template <typename Queue>
+    void testLifetimes()
+    {
+        std::atomic<int> count { 0 };
+
+        {
+            Queue queue (8);
+
+            for (int i = 0; i < 5; ++i)
+                queue.emplace (count);
+
+            expectEquals (count.load(), 5);
+            expect (queue.popWith ([] (Counted&) {}));
+            expectEquals (count.load(), 4);
+        }
+
+        expectEquals (count.load(), 0);
+    }
+
+    template <typename Queue>
+    static void runThreaded (Queue& queue, int numProducers, int numConsumers, int itemsPerProducer,
+                             std::function<void (int consumer, const Item&)> itemReceived)
+    {
+        std::atomic<int> numReceived { 0 };
+        const auto total = numProducers * itemsPerProducer;
+        std::vector<std::unique_ptr<FunctionThread>> threads;
+
+        for (int c = 0; c < numConsumers; ++c)
+        {
+            threads.push_back (std::make_unique<FunctionThread> ([&, c]
+            {
+                Item item;
+
+                while (numReceived.load() < total)
+                {
+                    if (queue.pop (item))
+                    {
+                        ++numReceived;
+
+                        if (itemReceived != nullptr)
+                            itemReceived (c, item);
+                    }
+                    else
+                    {
+                        Thread::yield();
+                    }
+                }
+            }));
+        }
+
+        for (int p = 0; p < numProducers; ++p)
+        {
+            threads.push_back (std::make_unique<FunctionThread> ([&, p]
+            {
+                for (int i = 0; i < itemsPerProducer;)
+                {
+                    if (queue.push (Item { p, i }))
+                        ++i;
+                    else
+                        Thread::yield();
+                }
+            }));
+        }
+
+        threads.clear();
+    }
+
+    template <typename Queue>
+    void testThreaded (Queue& queue, int numProducers, int numConsumers, int itemsPerProducer)
+    {
+        // Each consumer only appends to its own lists, so they don't need locking
+        std::vector<std::vector<std::vector<int>>> received ((size_t) numConsumers);
+
+        for (auto& lists : received)
+        {
+            lists.resize ((size_t) numProducers);
+
+            for (auto& list : lists)
+                list.reserve ((size_t) itemsPerProducer);
+        }
+
+        runThreaded (queue, numProducers, numConsumers, itemsPerProducer, [&] (int consumer, const Item& item)
+        {
+            received[(size_t) consumer][(size_t) item.producer].push_back (item.index);
+        });
+
+        expect (queue.isEmpty());
+
+        for (int p = 0; p < numProducers; ++p)
+        {
+            std::vector<int> all;
+
+            for (auto& lists : received)
+            {
+                auto& list = lists[(size_t) p];
+                expect (std::is_sorted (list.begin(), list.end()), "items from one producer should arrive in order");
+                all.insert (all.end(), list.begin(), list.end());
+            }
+
+            std::sort (all.begin(), all.end());
+
+            std::vector<int> expected ((size_t) itemsPerProducer);
+            std::iota (expected.begin(), expected.end(), 0);
+            expect (all == expected, "every item should be received exactly once");
+        }
+    }
+
+    template <typename Queue>
+    static double timeThreaded (Queue& queue, int numProducers, int numConsumers, int itemsPerProducer)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        runThreaded (queue, numProducers, numConsumers, itemsPerProducer, nullptr);
+        return Time::getMillisecondCounterHiRes() - start;
+    }
+};
+
+static LockFreeQueuesTests lockFreeQueuesTests;
+
+} // namespace juce
@@ -54,36 +54,95 @@ NamedValueSet::NamedValue& NamedValueSet::NamedValue::operator= (NamedValue&& ot
 bool NamedValueSet::NamedValue::operator== (const NamedValue& other) const noexcept   { return name == other.name && value == other.value; }
 bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexcept   { return ! operator== (other); }
 
+//==============================================================================
+/*  Maps the pooled string address of each name to its position in the values array.
+    Identifiers with the same name always share the same address, so the pointer alone
+    is enough to find an item. This is only built once a set gets big enough for a
+    linear search to become the bottleneck.
+*/
+struct NamedValueSet::Index
+{
+    static constexpr int minNumValues = 16;
+
+    static const void* getKey (const Identifier& name) noexcept   { return name.getCharPointer().getAddress(); }
+
+    FlatHashMap<const void*, int> positions;
+};
+
 //==============================================================================
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values)
+{
+    rebuildIndex();
+}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)),
+     nameIndex (std::move (other.nameIndex))
+{}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    rebuildIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+    rebuildIndex();
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    std::swap (other.nameIndex, nameIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex.reset();
+}
+
+void NamedValueSet::rebuildIndex()
+{
+    if (values.size() <= Index::minNumValues)
+    {
+        nameIndex.reset();
+        return;
+    }
+
+    if (nameIndex == nullptr)
+        nameIndex = std::make_unique<Index>();
+    else
+        nameIndex->positions.clear();
+
+    nameIndex->positions.reserve (values.size());
+
+    for (int i = 0; i < values.size(); ++i)
+    {
+        auto key = Index::getKey (values.getReference (i).name);
+
+        // if a name appears more than once, the first one wins, as with a linear search
+        if (! nameIndex->positions.contains (key))
+            nameIndex->positions.set (key, i);
+    }
+}
+
+void NamedValueSet::addValue (NamedValue&& newValue)
+{
+    values.add (std::move (newValue));
+
+    if (nameIndex != nullptr)
+        nameIndex->positions.set (Index::getKey (values.getLast().name), values.size() - 1);
+    else if (values.size() > Index::minNumValues)
+        rebuildIndex();
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -149,20 +208,12 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return getVarPointerAt (indexOf (name));
 }
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return getVarPointerAt (indexOf (name));
 }
 
 bool NamedValueSet::set (const Identifier& name, var&& newValue)
@@ -176,7 +227,7 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
         return true;
     }
 
-    values.add ({ name, std::move (newValue) });
+    addValue ({ name, std::move (newValue) });
     return true;
 }
 
@@ -191,7 +242,7 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
         return true;
     }
 
-    values.add ({ name, newValue });
+    addValue ({ name, newValue });
     return true;
 }
 
@@ -202,6 +253,12 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* position = nameIndex->positions.find (Index::getKey (name));
+        return position != nullptr ? *position : -1;
+    }
+
     auto numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -213,18 +270,17 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    auto i = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference(i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (i < 0)
+        return false;
+
+    values.remove (i);
+
+    if (nameIndex != nullptr)
+        rebuildIndex();
 
-    return false;
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -264,6 +320,7 @@ const var* NamedValueSet::getVarPointerAt (int index) const noexcept
 void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 {
     values.clearQuick();
+    nameIndex.reset();
 
     for (auto* att = xml.attributes.get(); att != nullptr; att = att->nextListItem)
     {
@@ -280,6 +337,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    rebuildIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
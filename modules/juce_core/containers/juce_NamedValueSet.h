@@ -29,6 +29,11 @@ namespace juce
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    Items are kept in the order in which they were added. Small sets are searched
+    linearly, but once a set grows beyond a handful of items it also maintains a
+    hash index of its names, so that lookups in large sets (e.g. a DynamicObject or
+    ValueTree with many properties) stay fast.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -179,7 +184,13 @@ public:
 
 private:
     //==============================================================================
+    struct Index;
+
     Array<NamedValue> values;
+    std::unique_ptr<Index> nameIndex;
+
+    void addValue (NamedValue&&);
+    void rebuildIndex();
 };
 
 } // namespace juce
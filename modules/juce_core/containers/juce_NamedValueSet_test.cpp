@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class NamedValueSetTests  : public UnitTest
+{
+public:
+    NamedValueSetTests()
+        : UnitTest ("NamedValueSet", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Large sets keep their order and find every value");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+                expect (set.set (getName (i), i));
+
+            expectEquals (set.size(), 100);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                expectEquals (set.indexOf (getName (i)), i);
+                expect (set.getName (i) == getName (i));
+                expect (set[getName (i)] == var (i));
+            }
+
+            expect (! set.contains ("missing"));
+            expectEquals (set.indexOf ("missing"), -1);
+            expect (set.getVarPointer ("missing") == nullptr);
+
+            expect (! set.set (getName (10), 10));
+            expect (set.set (getName (10), "ten"));
+            expect (set[getName (10)] == var ("ten"));
+            expectEquals (set.size(), 100);
+        }
+
+        beginTest ("Removing values keeps lookups consistent");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 40; ++i)
+                set.set (getName (i), i);
+
+            for (int i = 0; i < 40; i += 2)
+                expect (set.remove (getName (i)));
+
+            expect (! set.remove (getName (0)));
+            expectEquals (set.size(), 20);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                expectEquals (set.indexOf (getName (i * 2 + 1)), i);
+                expect (! set.contains (getName (i * 2)));
+            }
+
+            while (set.size() > 2)
+                set.remove (set.getName (0));
+
+            expect (set[getName (39)] == var (39));
+            expectEquals (set.indexOf (getName (37)), 0);
+
+            set.set (getName (0), 0);
+            expectEquals (set.indexOf (getName (0)), 2);
+        }
+
+        beginTest ("Copies, moves and comparisons");
+        {
+            NamedValueSet a;
+
+            for (int i = 0; i < 50; ++i)
+                a.set (getName (i), i);
+
+            NamedValueSet b (a);
+            expect (a == b);
+
+            NamedValueSet reversed;
+
+            for (int i = 50; --i >= 0;)
+                reversed.set (getName (i), i);
+
+            expect (a == reversed);
+
+            reversed.set (getName (0), -1);
+            expect (a != reversed);
+
+            NamedValueSet c (std::move (b));
+            expect (c == a);
+            expectEquals (c.indexOf (getName (49)), 49);
+
+            b = c;
+            b.set ("extra", 1);
+            expectEquals (b.indexOf ("extra"), 50);
+            expect (! c.contains ("extra"));
+
+            c = std::move (b);
+            expectEquals (c.indexOf ("extra"), 50);
+
+            c.clear();
+            expect (c.isEmpty());
+            expect (! c.contains (getName (0)));
+
+            c.set (getName (3), 3);
+            expectEquals (c.indexOf (getName (3)), 0);
+        }
+
+        beginTest ("Duplicate names in an initialiser list resolve to the first item");
+        {
+            std::vector<NamedValueSet::NamedValue> items;
+
+            for (int i = 0; i < 30; ++i)
+                items.push_back ({ getName (i), i });
+
+            NamedValueSet set { { "dup", 1 }, { "dup", 2 } };
+            expect (set["dup"] == var (1));
+
+            for (auto& item : items)
+                set.set (item.name, item.value);
+
+            expect (set["dup"] == var (1));
+            expectEquals (set.indexOf ("dup"), 0);
+        }
+    }
+
+private:
+    static Identifier getName (int i)
+    {
+        return "property" + String (i);
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+} // namespace juce
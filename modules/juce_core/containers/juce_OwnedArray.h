@@ -783,6 +783,19 @@ public:
     template <class ElementComparator>
     void sort (ElementComparator& comparator, bool retainOrderOfEquivalentItems = false) noexcept;
 
+    /** Sorts the elements in the array, using a WorkStealingThreadPool to sort
+        different parts of the array at the same time.
+
+        This works like the other sort() method, and is worth using for arrays of many
+        thousands of objects. The comparator's compareElements() method will be called
+        from several threads at once, so it mustn't modify any shared state.
+
+        @see parallelSortArray, WorkStealingThreadPool::parallelSort
+    */
+    template <class ElementComparator>
+    void sort (ElementComparator& comparator, WorkStealingThreadPool& pool,
+               bool retainOrderOfEquivalentItems = false);
+
     //==============================================================================
     /** Returns the CriticalSection that locks this array.
         To lock, you can call getLock().enter() and getLock().exit(), or preferably use
@@ -875,4 +888,17 @@ void OwnedArray<ObjectClass, TypeOfCriticalSectionToUse>::sort (
         sortArray (comparator, values.begin(), 0, size() - 1, retainOrderOfEquivalentItems);
 }
 
+template <class ObjectClass, class TypeOfCriticalSectionToUse>
+template <typename ElementComparator>
+void OwnedArray<ObjectClass, TypeOfCriticalSectionToUse>::sort (
+    ElementComparator& comparator,
+    WorkStealingThreadPool& pool,
+    bool retainOrderOfEquivalentItems)
+{
+    const ScopedLockType lock (getLock());
+
+    if (size() > 1)
+        parallelSortArray (pool, comparator, values.begin(), 0, size() - 1, retainOrderOfEquivalentItems);
+}
+
 } // namespace juce
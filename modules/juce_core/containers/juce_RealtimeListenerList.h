@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  The RealtimeListenerList whose call() is running on the current thread, so that
+        a listener which removes itself from inside its own callback doesn't end up
+        waiting for that callback to finish.
+    */
+    inline const void*& getRealtimeListenerListBeingCalled() noexcept
+    {
+        static thread_local const void* list = nullptr;
+        return list;
+    }
+}
+#endif
+
+//==============================================================================
+/**
+    A fixed-size list of listeners that can be called from a realtime thread.
+
+    This does the same job as ListenerList, but calling the listeners never takes a lock
+    or allocates, so call() is safe to use on an audio thread, and takes a bounded amount
+    of time. The space for the listeners is allocated up-front, so adding a listener
+    doesn't allocate either, but the list can't hold more than maxNumListeners of them.
+
+    Adding and removing listeners is serialised with a lock, so it should be done on a
+    non-realtime thread. Once remove() has returned, any calls that might still have been
+    using the listener have finished, so it's safe to delete it. (The exception is when a
+    listener removes itself from inside its own callback: remove() doesn't wait then, as
+    it would be waiting for itself, so calls on other threads may still be running).
+
+    Listeners that are added or removed while a call is in progress may or may not be
+    called by it, but a listener will never be called after remove() has returned.
+
+    @code
+    class MyParameter
+    {
+    public:
+        void addListener (Listener* l)     { listeners.add (l); }
+        void removeListener (Listener* l)  { listeners.remove (l); }
+
+        // can be called on the audio thread..
+        void setValue (float v)
+        {
+            value = v;
+            listeners.call ([v] (Listener& l) { l.valueChanged (v); });
+        }
+
+    private:
+        RealtimeListenerList<Listener> listeners;
+    };
+    @endcode
+
+    @see ListenerList, ReadCopyUpdatePointer
+
+    @tags{Core}
+*/
+template <class ListenerClass, int maxNumListeners = 16>
+class RealtimeListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    RealtimeListenerList() = default;
+
+    /** Destructor. */
+    ~RealtimeListenerList()
+    {
+        // The list mustn't be deleted while it's being called!
+        jassert (numCalls[0].load() == 0 && numCalls[1].load() == 0);
+    }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+
+        If the listener is already in the list, it won't be added again.
+
+        @returns false if the listener couldn't be added because the list is full
+    */
+    bool add (ListenerClass* listenerToAdd)
+    {
+        if (listenerToAdd == nullptr)
+        {
+            jassertfalse; // Listeners can't be null pointers!
+            return false;
+        }
+
+        const ScopedLock sl (writeLock);
+
+        if (contains (listenerToAdd))
+            return true;
+
+        for (int i = 0; i < maxNumListeners; ++i)
+        {
+            if (slots[i].load() == nullptr)
+            {
+                slots[i].store (listenerToAdd);
+
+                if (i >= numSlotsUsed.load())
+                    numSlotsUsed.store (i + 1);
+
+                return true;
+            }
+        }
+
+        // This list only has room for maxNumListeners listeners. If you need more than
+        // that, increase the template argument where the list is declared.
+        jassertfalse;
+        return false;
+    }
+
+    /** Removes a listener from the list.
+
+        Unless this is called from inside one of this list's callbacks, it waits for any
+        calls that might be using the listener to finish before returning.
+    */
+    void remove (ListenerClass* listenerToRemove)
+    {
+        const ScopedLock sl (writeLock);
+
+        for (int i = numSlotsUsed.load(); --i >= 0;)
+        {
+            if (slots[i].load() == listenerToRemove)
+            {
+                slots[i].store (nullptr);
+                trimUnusedSlots();
+                waitForCallsToFinish();
+                return;
+            }
+        }
+    }
+
+    /** Removes all the listeners from the list, waiting for any calls to finish as
+        remove() does.
+    */
+    void clear()
+    {
+        const ScopedLock sl (writeLock);
+
+        for (auto& slot : slots)
+            slot.store (nullptr);
+
+        numSlotsUsed.store (0);
+        waitForCallsToFinish();
+    }
+
+    /** Returns true if the specified listener has been added to the list. */
+    bool contains (ListenerClass* listener) const noexcept
+    {
+        for (int i = numSlotsUsed.load(); --i >= 0;)
+            if (slots[i].load() == listener)
+                return true;
+
+        return false;
+    }
+
+    /** Returns the number of registered listeners. */
+    int size() const noexcept
+    {
+        int num = 0;
+
+        for (int i = numSlotsUsed.load(); --i >= 0;)
+            if (slots[i].load() != nullptr)
+                ++num;
+
+        return num;
+    }
+
+    /** Returns true if no listeners are registered, false otherwise. */
+    bool isEmpty() const noexcept                           { return numSlotsUsed.load() == 0; }
+
+    /** Returns the maximum number of listeners that the list can hold. */
+    static constexpr int getCapacity() noexcept             { return maxNumListeners; }
+
+    //==============================================================================
+    /** Calls a member function on each listener in the list.
+
+        This never blocks or allocates, so it can be called from a realtime thread, and
+        from several threads at once.
+    */
+    template <typename Callback>
+    void call (Callback&& callback) const
+    {
+        const ScopedCall scope (*this);
+
+        for (int i = numSlotsUsed.load(); --i >= 0;)
+            if (auto* l = slots[i].load())
+                callback (*l);
+    }
+
+    /** Calls a member function on each listener in the list, except the one specified. */
+    template <typename Callback>
+    void callExcluding (ListenerClass* listenerToExclude, Callback&& callback) const
+    {
+        const ScopedCall scope (*this);
+
+        for (int i = numSlotsUsed.load(); --i >= 0;)
+            if (auto* l = slots[i].load())
+                if (l != listenerToExclude)
+                    callback (*l);
+    }
+
+private:
+    //==============================================================================
+    // Each call is counted against the current epoch. To wait for the calls that might
+    // have seen a removed listener, a writer moves on to the next epoch, and then waits
+    // for the count of the previous one to drop to zero: calls that start after that
+    // are counted in the new epoch, and can't see the listener any more.
+    struct ScopedCall
+    {
+        explicit ScopedCall (const RealtimeListenerList& l) noexcept
+            : list (l),
+              epoch (l.currentEpoch.load() & 1),
+              previousList (std::exchange (detail::getRealtimeListenerListBeingCalled(), &l))
+        {
+            list.numCalls[epoch].fetch_add (1);
+        }
+
+        ~ScopedCall() noexcept
+        {
+            list.numCalls[epoch].fetch_sub (1);
+            detail::getRealtimeListenerListBeingCalled() = previousList;
+        }
+
+        const RealtimeListenerList& list;
+        const size_t epoch;
+        const void* const previousList;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCall)
+    };
+
+    void trimUnusedSlots() noexcept
+    {
+        auto num = numSlotsUsed.load();
+
+        while (num > 0 && slots[num - 1].load() == nullptr)
+            --num;
+
+        numSlotsUsed.store (num);
+    }
+
+    void waitForCallsToFinish() const
+    {
+        if (detail::getRealtimeListenerListBeingCalled() == this)
+            return;
+
+        const auto previousEpoch = (size_t) (currentEpoch.fetch_add (1) & 1);
+
+        for (int spins = 0; numCalls[previousEpoch].load() != 0; ++spins)
+        {
+            if (spins < 100)
+                Thread::yield();
+            else
+                Thread::sleep (1);
+        }
+    }
+
+    std::atomic<ListenerClass*> slots[maxNumListeners] {};
+    std::atomic<int> numSlotsUsed { 0 };
+    mutable std::atomic<int> numCalls[2] { { 0 }, { 0 } };
+    mutable std::atomic<size_t> currentEpoch { 0 };
+    CriticalSection writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeListenerList)
+};
+
+} // namespace juce
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RealtimeListenerListTests  : public UnitTest
+{
+public:
+    RealtimeListenerListTests()
+        : UnitTest ("RealtimeListenerList", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Listeners can be added, removed and called");
+        {
+            RealtimeListenerList<Counter, 4> list;
+            Counter a, b;
+
+            expect (list.isEmpty());
+            expect (list.add (&a));
+            expect (list.add (&b));
+            expect (list.add (&a));
+            expectEquals (list.size(), 2);
+
+            list.call ([] (Counter& c) { ++c.count; });
+            expectEquals (a.count.load(), 1);
+            expectEquals (b.count.load(), 1);
+
+            list.callExcluding (&a, [] (Counter& c) { ++c.count; });
+            expectEquals (a.count.load(), 1);
+            expectEquals (b.count.load(), 2);
+
+            list.remove (&a);
+            expect (! list.contains (&a));
+            expect (list.contains (&b));
+
+            list.call ([] (Counter& c) { ++c.count; });
+            expectEquals (a.count.load(), 1);
+            expectEquals (b.count.load(), 3);
+
+            list.clear();
+            expect (list.isEmpty());
+        }
+
+        beginTest ("A full list refuses new listeners");
+        {
+            RealtimeListenerList<Counter, 2> list;
+            Counter a, b, c;
+
+            expect (list.add (&a));
+            expect (list.add (&b));
+
+            expect (! list.add (&c));
+
+            list.remove (&a);
+            expect (list.add (&c));
+            expectEquals (list.size(), 2);
+        }
+
+        beginTest ("Listeners can remove themselves while being called");
+        {
+            RealtimeListenerList<Counter> list;
+            Counter a, b;
+
+            list.add (&a);
+            list.add (&b);
+
+            list.call ([&] (Counter& c)
+            {
+                ++c.count;
+                list.remove (&c);
+            });
+
+            expect (list.isEmpty());
+            expectEquals (a.count.load(), 1);
+            expectEquals (b.count.load(), 1);
+        }
+
+        beginTest ("Removed listeners are never called once remove() has returned");
+        {
+            RealtimeListenerList<Counter> list;
+            std::atomic<bool> stop { false };
+
+            std::thread caller ([&]
+            {
+                while (! stop)
+                    list.call ([] (Counter& c) { ++c.count; });
+            });
+
+            for (int i = 0; i < 200; ++i)
+            {
+                Counter c;
+                list.add (&c);
+
+                while (c.count.load() == 0)
+                    std::this_thread::yield();
+
+                list.remove (&c);
+                const auto countAfterRemoval = c.count.load();
+
+                Thread::sleep (0);
+                expectEquals (c.count.load(), countAfterRemoval);
+            }
+
+            stop = true;
+            caller.join();
+        }
+    }
+
+private:
+    struct Counter
+    {
+        std::atomic<int> count { 0 };
+    };
+};
+
+static RealtimeListenerListTests realtimeListenerListTests;
+
+} // namespace juce
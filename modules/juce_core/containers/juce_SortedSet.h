@@ -308,6 +308,11 @@ public:
 
     /** Adds elements from an array to this set.
 
+        The result is the same as calling add() for each element in turn, but rather than
+        inserting the elements one at a time, the new elements are sorted and de-duplicated
+        and then merged with the existing ones in a single pass, so adding a large array
+        doesn't take quadratic time.
+
         @param elementsToAdd        the array of elements to add
         @param numElementsToAdd     how many elements are in this other array
         @see add
@@ -317,8 +322,45 @@ public:
     {
         const ScopedLockType lock (getLock());
 
-        while (--numElementsToAdd >= 0)
-            add (*elementsToAdd++);
+        // For a handful of elements, shifting the existing ones is cheaper than merging
+        if (numElementsToAdd < 8)
+        {
+            while (--numElementsToAdd >= 0)
+                add (*elementsToAdd++);
+
+            return;
+        }
+
+        Array<ElementType> newElements (elementsToAdd, numElementsToAdd);
+        DefaultElementComparator<ElementType> comparator;
+        newElements.sort (comparator, true);
+        mergeSortedElements (newElements);
+    }
+
+    /** Adds elements from an array to this set, using a WorkStealingThreadPool to sort
+        the new elements before they're merged with the existing ones.
+
+        This gives the same result as the other version of addArray(), and is worth using
+        when building a set from hundreds of thousands of elements.
+
+        @param elementsToAdd        the array of elements to add
+        @param numElementsToAdd     how many elements are in this other array
+        @param pool                 the pool to use for sorting the new elements
+        @see add
+    */
+    void addArray (const ElementType* elementsToAdd,
+                   int numElementsToAdd,
+                   WorkStealingThreadPool& pool)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (numElementsToAdd <= 0)
+            return;
+
+        Array<ElementType> newElements (elementsToAdd, numElementsToAdd);
+        DefaultElementComparator<ElementType> comparator;
+        newElements.sort (comparator, pool, true);
+        mergeSortedElements (newElements);
     }
 
     /** Adds elements from another set to this one.
@@ -351,7 +393,11 @@ public:
                 numElementsToAdd = setToAddFrom.size() - startIndex;
 
             if (numElementsToAdd > 0)
-                addArray (&setToAddFrom.data.getReference (startIndex), numElementsToAdd);
+            {
+                // The other set is already sorted and free of duplicates, so it can be merged directly
+                Array<ElementType> newElements (&setToAddFrom.data.getReference (startIndex), numElementsToAdd);
+                mergeSortedElements (newElements);
+            }
         }
     }
 
@@ -481,6 +527,53 @@ public:
 
 private:
     //==============================================================================
+    // Merges a stably-sorted array into the set. Where several elements are equal, the last
+    // one wins, matching what happens when add() is called for each of them in turn.
+    void mergeSortedElements (Array<ElementType>& newElements)
+    {
+        int numUnique = 0;
+
+        for (auto& element : newElements)
+        {
+            if (numUnique > 0 && element == newElements.getReference (numUnique - 1))
+                newElements.getReference (numUnique - 1) = element;
+            else
+                newElements.getReference (numUnique++) = element;
+        }
+
+        decltype (data) merged;
+        merged.ensureStorageAllocated (data.size() + numUnique);
+
+        int existingIndex = 0, newIndex = 0;
+
+        while (existingIndex < data.size() && newIndex < numUnique)
+        {
+            auto& existing = data.getReference (existingIndex);
+            auto& newElement = newElements.getReference (newIndex);
+
+            if (newElement == existing)
+            {
+                merged.add (newElement);
+                ++existingIndex;
+                ++newIndex;
+            }
+            else if (newElement < existing)
+            {
+                merged.add (newElement);
+                ++newIndex;
+            }
+            else
+            {
+                merged.add (existing);
+                ++existingIndex;
+            }
+        }
+
+        merged.addArray (data.begin() + existingIndex, data.size() - existingIndex);
+        merged.addArray (newElements.begin() + newIndex, numUnique - newIndex);
+        data.swapWith (merged);
+    }
+
     Array<ElementType, TypeOfCriticalSectionToUse> data;
 };
 
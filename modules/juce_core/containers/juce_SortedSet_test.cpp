@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SortedSetTests  : public UnitTest
+{
+public:
+    SortedSetTests()
+        : UnitTest ("SortedSet", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        Random r (4321);
+
+        beginTest ("Adding an array gives the same result as adding each element");
+        {
+            for (auto numToAdd : { 0, 3, 8, 1000 })
+            {
+                SortedSet<int> bulk, individual;
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    const auto value = r.nextInt (500);
+                    bulk.add (value);
+                    individual.add (value);
+                }
+
+                Array<int> newElements;
+
+                for (int i = 0; i < numToAdd; ++i)
+                    newElements.add (r.nextInt (1000));
+
+                bulk.addArray (newElements.begin(), newElements.size());
+
+                for (auto value : newElements)
+                    individual.add (value);
+
+                expect (bulk == individual);
+            }
+        }
+
+        beginTest ("The most recently added of several equal elements is kept");
+        {
+            SortedSet<Tagged> set;
+            set.add ({ 5, 0 });
+
+            Array<Tagged> newElements;
+
+            for (int i = 1; i <= 20; ++i)
+                newElements.add ({ i % 10, i });
+
+            set.addArray (newElements.begin(), newElements.size());
+
+            expectEquals (set.size(), 10);
+            expectEquals (set[5].tag, 15);
+            expectEquals (set[0].tag, 20);
+        }
+
+        beginTest ("Adding a set merges the two");
+        {
+            SortedSet<int> a, b;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                a.add (i * 2);
+                b.add (i * 3);
+            }
+
+            a.addSet (b);
+            expectEquals (a.size(), 100 + 100 - 34);
+
+            for (int i = 1; i < a.size(); ++i)
+                expect (a[i - 1] < a[i]);
+        }
+
+        beginTest ("Adding an array using a thread pool");
+        {
+            WorkStealingThreadPool pool (4);
+            SortedSet<int> bulk, individual;
+            Array<int> newElements;
+
+            for (int i = 0; i < 100000; ++i)
+                newElements.add (r.nextInt (50000));
+
+            bulk.addArray (newElements.begin(), newElements.size(), pool);
+
+            for (auto value : newElements)
+                individual.add (value);
+
+            expect (bulk == individual);
+        }
+
+        beginTest ("Array::addSortedArray matches repeated calls to addSorted");
+        {
+            DefaultElementComparator<int> comparator;
+            Array<int> bulk, individual;
+
+            for (int i = 0; i < 100; ++i)
+                individual.addSorted (comparator, r.nextInt (100));
+
+            bulk = individual;
+
+            Array<int> newElements;
+
+            for (int i = 0; i < 500; ++i)
+                newElements.add (r.nextInt (200));
+
+            bulk.addSortedArray (comparator, newElements.begin(), newElements.size());
+
+            for (auto value : newElements)
+                individual.addSorted (comparator, value);
+
+            expect (bulk == individual);
+        }
+
+        beginTest ("Arrays can be sorted using a thread pool");
+        {
+            WorkStealingThreadPool pool (4);
+            DefaultElementComparator<int> comparator;
+            Array<int> values;
+
+            for (int i = 0; i < 100000; ++i)
+                values.add (r.nextInt());
+
+            auto expected = values;
+            expected.sort (comparator);
+            values.sort (comparator, pool);
+            expect (values == expected);
+
+            OwnedArray<int> objects;
+
+            for (int i = 0; i < 20000; ++i)
+                objects.add (new int (r.nextInt (1000)));
+
+            PointeeComparator pointeeComparator;
+            objects.sort (pointeeComparator, pool, true);
+
+            for (int i = 1; i < objects.size(); ++i)
+                expect (*objects[i - 1] <= *objects[i]);
+        }
+    }
+
+private:
+    struct Tagged
+    {
+        int value, tag;
+
+        bool operator== (const Tagged& other) const noexcept    { return value == other.value; }
+        bool operator<  (const Tagged& other) const noexcept    { return value < other.value; }
+    };
+
+    struct PointeeComparator
+    {
+        static int compareElements (const int* a, const int* b) noexcept    { return *a - *b; }
+    };
+};
+
+static SortedSetTests sortedSetTests;
+
+} // namespace juce
@@ -357,7 +357,8 @@ struct var::VariantType
 
     static Array<var>* arrayToArray (const ValueUnion& data) noexcept
     {
-        if (auto* a = dynamic_cast<RefCountedArray*> (data.objectValue))
+        // an array var always holds a RefCountedArray, so there's no need for a dynamic_cast
+        if (auto* a = static_cast<RefCountedArray*> (data.objectValue))
             return &(a->array);
 
         return nullptr;
@@ -524,7 +525,7 @@ var::var (const StringArray& v)       : type (&Instance::attributesArray)
     for (auto& i : v)
         strings.add (var (i));
 
-    value.objectValue = new VariantType::RefCountedArray (strings);
+    value.objectValue = new VariantType::RefCountedArray (std::move (strings));
 }
 
 var::var (ReferenceCountedObject* const object)  : type (&Instance::attributesObject)
@@ -618,6 +619,20 @@ var& var::operator= (String&& v)
     return *this;
 }
 
+var& var::operator= (MemoryBlock&& v)
+{
+    var v2 (std::move (v));
+    swapWith (v2);
+    return *this;
+}
+
+var& var::operator= (Array<var>&& v)
+{
+    var v2 (std::move (v));
+    swapWith (v2);
+    return *this;
+}
+
 //==============================================================================
 bool var::equals (const var& other) const noexcept
 {
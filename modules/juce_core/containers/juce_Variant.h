@@ -97,6 +97,8 @@ public:
     var (Array<var>&&);
     var& operator= (var&&) noexcept;
     var& operator= (String&&);
+    var& operator= (MemoryBlock&&);
+    var& operator= (Array<var>&&);
 
     void swapWith (var& other) noexcept;
 
@@ -0,0 +1,640 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_LINUX && __has_include (<linux/io_uring.h>)
+ #define JUCE_FILE_IO_SERVICE_USE_IO_URING 1
+#else
+ #define JUCE_FILE_IO_SERVICE_USE_IO_URING 0
+#endif
+
+namespace juce
+{
+
+//==============================================================================
+class FileIOService::Backend
+{
+public:
+    explicit Backend (FileIOService& s)  : service (s) {}
+    virtual ~Backend() = default;
+
+    virtual void submit (std::vector<Request>&) = 0;
+    virtual bool isKernelQueue() const noexcept = 0;
+
+protected:
+    FileIOService& service;
+};
+
+//==============================================================================
+/*  Runs each request as a blocking positional read or write on one of a set of threads,
+    so that as many requests as there are threads can be in progress at a time.
+*/
+class FileIOService::ThreadBackend  : public Backend
+{
+public:
+    ThreadBackend (FileIOService& s, int numThreads, const String& threadName)  : Backend (s)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.push_back (std::make_unique<Worker> (*this, threadName));
+    }
+
+    ~ThreadBackend() override
+    {
+        for (auto& w : workers)
+            w->signalThreadShouldExit();
+
+        queueCondition.notify_all();
+        workers.clear();
+    }
+
+    void submit (std::vector<Request>& requests) override
+    {
+        {
+            const std::scoped_lock sl (queueMutex);
+
+            for (auto& r : requests)
+                queue.push_back (std::move (r));
+        }
+
+        if (requests.size() == 1)
+            queueCondition.notify_one();
+        else
+            queueCondition.notify_all();
+    }
+
+    bool isKernelQueue() const noexcept override    { return false; }
+
+private:
+    class Worker  : public Thread
+    {
+    public:
+        Worker (ThreadBackend& b, const String& name)  : Thread (name), owner (b)
+        {
+            startThread();
+        }
+
+        ~Worker() override
+        {
+            stopThread (-1);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                Request request;
+
+                {
+                    std::unique_lock ul (owner.queueMutex);
+                    owner.queueCondition.wait (ul, [this] { return threadShouldExit() || ! owner.queue.empty(); });
+
+                    if (owner.queue.empty())
+                        continue;
+
+                    request = std::move (owner.queue.front());
+                    owner.queue.pop_front();
+                }
+
+                owner.service.requestFinished (request, perform (request));
+            }
+        }
+
+    private:
+        static int64 perform (const Request& request)
+        {
+           #if JUCE_WINDOWS
+            OVERLAPPED overlapped {};
+            overlapped.Offset     = (DWORD) (request.position & 0xffffffff);
+            overlapped.OffsetHigh = (DWORD) (request.position >> 32);
+
+            DWORD numBytesTransferred = 0;
+            const auto handle = (HANDLE) request.file->fileHandle;
+            const auto numBytes = (DWORD) jmin (request.numBytes, (size_t) std::numeric_limits<DWORD>::max());
+
+            const auto ok = request.isWrite ? WriteFile (handle, request.buffer, numBytes, &numBytesTransferred, &overlapped)
+                                            : ReadFile  (handle, request.buffer, numBytes, &numBytesTransferred, &overlapped);
+
+            if (! ok && GetLastError() != ERROR_HANDLE_EOF)
+                return -1;
+
+            return (int64) numBytesTransferred;
+           #else
+            const auto fd = (int) (pointer_sized_int) request.file->fileHandle;
+
+            for (;;)
+            {
+                const auto result = request.isWrite ? pwrite (fd, request.buffer, request.numBytes, (off_t) request.position)
+                                                    : pread  (fd, request.buffer, request.numBytes, (off_t) request.position);
+
+                if (result >= 0 || errno != EINTR)
+                    return (int64) result;
+            }
+           #endif
+        }
+
+        ThreadBackend& owner;
+    };
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<Request> queue;
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+//==============================================================================
+#if JUCE_FILE_IO_SERVICE_USE_IO_URING
+
+/*  Hands the requests to the kernel through an io_uring submission queue, and has a
+    single thread waiting for their completions.
+*/
+class FileIOService::IoUringBackend  : public Backend,
+                                      private Thread
+{
+public:
+    IoUringBackend (FileIOService& s, int maxRequestsInFlight, const String& name)
+        : Backend (s), Thread (name)
+    {
+        io_uring_params params {};
+        ringFd = (int) syscall (__NR_io_uring_setup, (unsigned) jmax (2, maxRequestsInFlight + 1), &params);
+
+        if (ringFd < 0 || ! mapRings (params))
+            return;
+
+        // One slot is kept free for the request that wakes the thread up when it's stopped
+        capacity = (int) params.sq_entries - 1;
+        startThread();
+    }
+
+    ~IoUringBackend() override
+    {
+        if (isThreadRunning())
+        {
+            signalThreadShouldExit();
+
+            {
+                const std::scoped_lock sl (lock);
+                auto& sqe = getNextSubmissionEntry();
+                sqe.opcode = IORING_OP_NOP;
+                sqe.user_data = 0;
+                submitEntries (1);
+            }
+
+            stopThread (-1);
+        }
+
+        if (sqes != nullptr)                                munmap (sqes, sqesSize);
+        if (cqRing != nullptr && cqRing != sqRing)          munmap (cqRing, cqRingSize);
+        if (sqRing != nullptr)                              munmap (sqRing, sqRingSize);
+        if (ringFd >= 0)                                    ::close (ringFd);
+    }
+
+    bool isReady() const noexcept                   { return isThreadRunning(); }
+    bool isKernelQueue() const noexcept override    { return true; }
+
+    void submit (std::vector<Request>& requests) override
+    {
+        const std::scoped_lock sl (lock);
+
+        for (auto& r : requests)
+            waiting.push_back (std::move (r));
+
+        submitWaitingRequests();
+    }
+
+private:
+    struct InFlight
+    {
+        Request request;
+        iovec vec;
+    };
+
+    template <typename Type>
+    static Type* offsetPointer (void* base, uint32 offset) noexcept
+    {
+        return reinterpret_cast<Type*> (static_cast<char*> (base) + offset);
+    }
+
+    bool mapRings (const io_uring_params& params)
+    {
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof (uint32);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+        const auto singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+        if (singleMapping)
+            sqRingSize = cqRingSize = jmax (sqRingSize, cqRingSize);
+
+        sqRing = mapRegion (sqRingSize, IORING_OFF_SQ_RING);
+        cqRing = singleMapping ? sqRing : mapRegion (cqRingSize, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof (io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*> (mapRegion (sqesSize, IORING_OFF_SQES));
+
+        if (sqRing == nullptr || cqRing == nullptr || sqes == nullptr)
+            return false;
+
+        sqTail  = offsetPointer<uint32> (sqRing, params.sq_off.tail);
+        sqMask  = *offsetPointer<uint32> (sqRing, params.sq_off.ring_mask);
+        sqArray = offsetPointer<uint32> (sqRing, params.sq_off.array);
+        cqHead  = offsetPointer<uint32> (cqRing, params.cq_off.head);
+        cqTail  = offsetPointer<uint32> (cqRing, params.cq_off.tail);
+        cqMask  = *offsetPointer<uint32> (cqRing, params.cq_off.ring_mask);
+        cqes    = offsetPointer<io_uring_cqe> (cqRing, params.cq_off.cqes);
+        return true;
+    }
+
+    void* mapRegion (size_t size, off_t offset) const
+    {
+        auto* result = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+        return result == MAP_FAILED ? nullptr : result;
+    }
+
+    // Called with the lock held. The kernel takes all the entries during io_uring_enter,
+    // so the submission queue is always empty when this starts filling it.
+    io_uring_sqe& getNextSubmissionEntry() noexcept
+    {
+        const auto tail = *sqTail + numUnsubmitted++;
+        const auto index = tail & sqMask;
+        sqArray[index] = index;
+
+        auto& sqe = sqes[index];
+        zerostruct (sqe);
+        return sqe;
+    }
+
+    void submitEntries (uint32 numEntries)
+    {
+        __atomic_store_n (sqTail, *sqTail + numEntries, __ATOMIC_RELEASE);
+        numUnsubmitted = 0;
+
+        while (numEntries > 0)
+        {
+            const auto result = (int) syscall (__NR_io_uring_enter, ringFd, numEntries, 0, 0, nullptr, 0);
+
+            if (result < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                    continue;
+
+                jassertfalse;
+                break;
+            }
+
+            numEntries -= (uint32) result;
+        }
+    }
+
+    void submitWaitingRequests()
+    {
+        uint32 numEntries = 0;
+
+        while (! waiting.empty() && numInFlight < capacity)
+        {
+            auto* item = new InFlight { std::move (waiting.front()), {} };
+            waiting.pop_front();
+
+            item->vec.iov_base = item->request.buffer;
+            item->vec.iov_len = item->request.numBytes;
+
+            auto& sqe = getNextSubmissionEntry();
+            sqe.opcode = (uint8) (item->request.isWrite ? IORING_OP_WRITEV : IORING_OP_READV);
+            sqe.fd = (int) (pointer_sized_int) item->request.file->fileHandle;
+            sqe.off = (uint64) item->request.position;
+            sqe.addr = (uint64) (pointer_sized_int) &item->vec;
+            sqe.len = 1;
+            sqe.user_data = (uint64) (pointer_sized_int) item;
+
+            ++numInFlight;
+            ++numEntries;
+        }
+
+        if (numEntries > 0)
+            submitEntries (numEntries);
+    }
+
+    void run() override
+    {
+        std::vector<std::pair<InFlight*, int>> finished;
+
+        while (! threadShouldExit())
+        {
+            if (syscall (__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+                break;
+
+            auto head = *cqHead;
+            const auto tail = __atomic_load_n (cqTail, __ATOMIC_ACQUIRE);
+
+            for (; head != tail; ++head)
+            {
+                const auto& cqe = cqes[head & cqMask];
+
+                if (cqe.user_data != 0)
+                    finished.emplace_back ((InFlight*) (pointer_sized_int) cqe.user_data, cqe.res);
+            }
+
+            __atomic_store_n (cqHead, head, __ATOMIC_RELEASE);
+
+            if (finished.empty())
+                continue;
+
+            {
+                const std::scoped_lock sl (lock);
+                numInFlight -= (int) finished.size();
+                submitWaitingRequests();
+            }
+
+            for (auto& [item, result] : finished)
+            {
+                service.requestFinished (item->request, result < 0 ? -1 : (int64) result);
+                delete item;
+            }
+
+            finished.clear();
+        }
+    }
+
+    int ringFd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+
+    uint32* sqTail = nullptr;
+    uint32* sqArray = nullptr;
+    uint32 sqMask = 0;
+    uint32* cqHead = nullptr;
+    uint32* cqTail = nullptr;
+    uint32 cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    std::mutex lock;
+    std::deque<Request> waiting;
+    int numInFlight = 0, capacity = 0;
+    uint32 numUnsubmitted = 0;
+};
+
+#endif
+
+//==============================================================================
+FileIOService::OpenFile::OpenFile (const File& f, Mode mode)  : file (f)
+{
+   #if JUCE_WINDOWS
+    auto h = CreateFile (file.getFullPathName().toWideCharPointer(),
+                         mode == Mode::write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                         FILE_SHARE_READ | (mode == Mode::write ? 0 : FILE_SHARE_WRITE),
+                         nullptr, mode == Mode::write ? OPEN_ALWAYS : OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (h != INVALID_HANDLE_VALUE)
+        fileHandle = (void*) h;
+   #else
+    const auto fd = open (file.getFullPathName().toUTF8(),
+                          mode == Mode::write ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC),
+                          00644);
+
+    if (fd >= 0)
+        fileHandle = (void*) (pointer_sized_int) fd;
+   #endif
+}
+
+FileIOService::OpenFile::~OpenFile()
+{
+    if (fileHandle == nullptr)
+        return;
+
+   #if JUCE_WINDOWS
+    CloseHandle ((HANDLE) fileHandle);
+   #else
+    ::close ((int) (pointer_sized_int) fileHandle);
+   #endif
+}
+
+//==============================================================================
+FileIOService::FileIOService (int maxRequestsInFlight, const String& threadName)
+{
+    maxRequestsInFlight = jmax (1, maxRequestsInFlight);
+
+   #if JUCE_FILE_IO_SERVICE_USE_IO_URING
+    auto ioUring = std::make_unique<IoUringBackend> (*this, maxRequestsInFlight, threadName);
+
+    if (ioUring->isReady())
+        backend = std::move (ioUring);
+   #endif
+
+    if (backend == nullptr)
+        backend = std::make_unique<ThreadBackend> (*this, jmin (maxRequestsInFlight, 16), threadName);
+}
+
+FileIOService::~FileIOService()
+{
+    waitUntilIdle();
+    backend.reset();
+}
+
+void FileIOService::asyncRead (OpenFile& file, int64 position, void* destBuffer, size_t numBytes, Callback callback)
+{
+    submit ({ Request { &file, position, destBuffer, numBytes, false, std::move (callback) } });
+}
+
+void FileIOService::asyncWrite (OpenFile& file, int64 position, const void* sourceData, size_t numBytes, Callback callback)
+{
+    submit ({ Request { &file, position, const_cast<void*> (sourceData), numBytes, true, std::move (callback) } });
+}
+
+void FileIOService::submit (std::vector<Request> requests)
+{
+    // All the requests need a file that has been opened!
+    requests.erase (std::remove_if (requests.begin(), requests.end(), [] (Request& r)
+                    {
+                        if (r.file != nullptr && r.file->openedOk())
+                            return false;
+
+                        jassertfalse;
+
+                        if (r.callback != nullptr)
+                            r.callback (-1);
+
+                        return true;
+                    }),
+                    requests.end());
+
+    if (requests.empty())
+        return;
+
+    numPendingRequests += (int) requests.size();
+    backend->submit (requests);
+}
+
+void FileIOService::requestFinished (Request& request, int64 result)
+{
+    if (request.callback != nullptr)
+        request.callback (result);
+
+    request.callback = nullptr;
+
+    if (--numPendingRequests == 0)
+    {
+        const std::scoped_lock sl (idleMutex);
+        idleCondition.notify_all();
+    }
+}
+
+bool FileIOService::waitUntilIdle (int timeoutMilliseconds)
+{
+    std::unique_lock ul (idleMutex);
+    const auto isIdle = [this] { return numPendingRequests == 0; };
+
+    if (timeoutMilliseconds < 0)
+    {
+        idleCondition.wait (ul, isIdle);
+        return true;
+    }
+
+    return idleCondition.wait_for (ul, std::chrono::milliseconds (timeoutMilliseconds), isIdle);
+}
+
+int FileIOService::getNumPendingRequests() const noexcept
+{
+    return numPendingRequests;
+}
+
+bool FileIOService::isUsingKernelQueue() const noexcept
+{
+    return backend->isKernelQueue();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FileIOServiceTests  : public UnitTest
+{
+public:
+    FileIOServiceTests()
+        : UnitTest ("FileIOService", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile temp;
+        constexpr int blockSize = 4096, numBlocks = 64;
+
+        std::vector<uint8> original ((size_t) (blockSize * numBlocks));
+        auto random = getRandom();
+
+        for (auto& b : original)
+            b = (uint8) random.nextInt (256);
+
+        temp.getFile().replaceWithData (original.data(), original.size());
+
+        FileIOService service (16);
+        logMessage (service.isUsingKernelQueue() ? "Using io_uring" : "Using threads");
+
+        beginTest ("Reads");
+        {
+            FileIOService::OpenFile file (temp.getFile(), FileIOService::OpenFile::Mode::read);
+            expect (file.openedOk());
+
+            std::vector<uint8> result (original.size());
+            std::atomic<int> numCorrectSizes { 0 };
+            std::vector<FileIOService::Request> requests;
+
+            // Read the blocks in reverse order, to check each one goes to the right place
+            for (int i = numBlocks; --i >= 0;)
+            {
+                requests.push_back ({ &file, (int64) i * blockSize, result.data() + i * blockSize, (size_t) blockSize, false,
+                                      [&] (int64 n) { if (n == blockSize) ++numCorrectSizes; } });
+            }
+
+            service.submit (std::move (requests));
+            expect (service.waitUntilIdle (10000));
+            expectEquals (numCorrectSizes.load(), numBlocks);
+            expect (result == original);
+        }
+
+        beginTest ("Reading past the end");
+        {
+            FileIOService::OpenFile file (temp.getFile(), FileIOService::OpenFile::Mode::read);
+            char buffer[100];
+            std::atomic<int64> endResult { -2 }, pastEndResult { -2 };
+
+            service.asyncRead (file, (int64) original.size() - 10, buffer, sizeof (buffer), [&] (int64 n) { endResult = n; });
+            service.asyncRead (file, (int64) original.size() + 10, buffer, sizeof (buffer), [&] (int64 n) { pastEndResult = n; });
+            expect (service.waitUntilIdle (10000));
+
+            expectEquals (endResult.load(), (int64) 10);
+            expectEquals (pastEndResult.load(), (int64) 0);
+        }
+
+        beginTest ("Writes");
+        {
+            const TemporaryFile output;
+
+            {
+                FileIOService::OpenFile file (output.getFile(), FileIOService::OpenFile::Mode::write);
+                expect (file.openedOk());
+
+                std::atomic<int> numWritten { 0 };
+
+                for (int i = 0; i < numBlocks; ++i)
+                    service.asyncWrite (file, (int64) i * blockSize, original.data() + i * blockSize, (size_t) blockSize,
+                                        [&] (int64 n) { if (n == blockSize) ++numWritten; });
+
+                expect (service.waitUntilIdle (10000));
+                expectEquals (numWritten.load(), numBlocks);
+            }
+
+            MemoryBlock written;
+            output.getFile().loadFileAsData (written);
+            expect (written.getSize() == original.size() && memcmp (written.getData(), original.data(), original.size()) == 0);
+        }
+
+        beginTest ("More requests than can be in flight");
+        {
+            FileIOService smallService (2);
+            FileIOService::OpenFile file (temp.getFile(), FileIOService::OpenFile::Mode::read);
+            std::vector<uint8> result (original.size());
+            std::atomic<int> numFinished { 0 };
+
+            for (int i = 0; i < numBlocks; ++i)
+                smallService.asyncRead (file, (int64) i * blockSize, result.data() + i * blockSize, (size_t) blockSize,
+                                        [&] (int64) { ++numFinished; });
+
+            expect (smallService.waitUntilIdle (10000));
+            expectEquals (numFinished.load(), numBlocks);
+            expect (result == original);
+        }
+
+        beginTest ("Missing files");
+        {
+            FileIOService::OpenFile file (temp.getFile().getSiblingFile ("doesNotExist"), FileIOService::OpenFile::Mode::read);
+            expect (! file.openedOk());
+        }
+    }
+};
+
+static FileIOServiceTests fileIOServiceTests;
+
+#endif
+
+} // namespace juce
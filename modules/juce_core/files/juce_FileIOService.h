@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads and writes blocks of files asynchronously, with many requests in progress at once.
+
+    Each request reads or writes a block of a file at a given position, and a function
+    is called when it has finished. Rather than having a thread wait for each read in
+    turn, requests are handed to the system in batches, so a fast drive can work on a
+    deep queue of them at the same time. This makes the service a good fit for things
+    like streaming a large number of samples from disk.
+
+    On Linux, the requests are queued with the kernel using io_uring when it's available.
+    Elsewhere, or if io_uring can't be used, they're shared out between a set of threads
+    which use positional reads and writes, so that several of them can be in progress at
+    a time.
+
+    The callbacks are called on one of the service's threads, and several may run at
+    the same time, so they should be thread-safe, and shouldn't take long to return.
+
+    @code
+    FileIOService service;
+    FileIOService::OpenFile file (sampleFile, FileIOService::OpenFile::Mode::read);
+    HeapBlock<char> buffer (65536);
+
+    service.asyncRead (file, 0, buffer, 65536, [&] (int64 numBytesRead)
+    {
+        if (numBytesRead > 0)
+            decodeBlock (buffer, numBytesRead);
+    });
+    @endcode
+
+    @see FileInputStream, FileOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  FileIOService
+{
+public:
+    //==============================================================================
+    /** Creates a service.
+
+        @param maxRequestsInFlight  the largest number of requests that will be given to
+                                    the system at the same time. Any others wait in a
+                                    queue until earlier ones have finished.
+        @param threadName           the name to give the service's threads
+    */
+    explicit FileIOService (int maxRequestsInFlight = 64, const String& threadName = "JUCE File IO");
+
+    /** Destructor.
+        This waits for all of the requests that have been made to finish, and for their
+        callbacks to return.
+    */
+    ~FileIOService();
+
+    //==============================================================================
+    /** A file that's been opened for use with a FileIOService.
+
+        The object must stay alive until all the requests that use it have finished.
+    */
+    class JUCE_API  OpenFile
+    {
+    public:
+        /** The ways in which a file can be opened. */
+        enum class Mode
+        {
+            read,   /**< The file can only be read. */
+            write   /**< The file can be read and written. It's created if it doesn't exist,
+                         but existing contents are kept. */
+        };
+
+        /** Opens a file. Use openedOk() to find out whether this succeeded. */
+        OpenFile (const File& file, Mode mode);
+
+        /** Destructor. */
+        ~OpenFile();
+
+        /** Returns true if the file was opened. */
+        bool openedOk() const noexcept                  { return fileHandle != nullptr; }
+
+        /** Returns the file that was opened. */
+        const File& getFile() const noexcept            { return file; }
+
+    private:
+        friend class FileIOService;
+
+        File file;
+        void* fileHandle = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenFile)
+    };
+
+    //==============================================================================
+    /** A function that's called when a request has finished.
+
+        It's given the number of bytes that were read or written, or -1 if there was an
+        error. A read that reaches the end of the file may return fewer bytes than were
+        asked for.
+    */
+    using Callback = std::function<void (int64 numBytesTransferred)>;
+
+    /** Describes a single read or write, for use with submit(). */
+    struct Request
+    {
+        OpenFile* file = nullptr;
+        int64 position = 0;
+        void* buffer = nullptr;
+        size_t numBytes = 0;
+        bool isWrite = false;
+        Callback callback;
+    };
+
+    /** Starts reading a block of a file into a buffer.
+        The buffer must stay valid until the callback has been called.
+    */
+    void asyncRead (OpenFile& file, int64 position, void* destBuffer, size_t numBytes, Callback callback);
+
+    /** Starts writing a block of data to a file.
+        The data must stay valid until the callback has been called.
+    */
+    void asyncWrite (OpenFile& file, int64 position, const void* sourceData, size_t numBytes, Callback callback);
+
+    /** Starts a set of requests.
+        This is cheaper than making the same requests one at a time, as they're handed
+        to the system together.
+    */
+    void submit (std::vector<Request> requests);
+
+    //==============================================================================
+    /** Waits until all the requests that have been made have finished, and their
+        callbacks have returned.
+
+        @returns false if the timeout expired before that happened
+    */
+    bool waitUntilIdle (int timeoutMilliseconds = -1);
+
+    /** Returns the number of requests that haven't finished yet. */
+    int getNumPendingRequests() const noexcept;
+
+    /** Returns true if the requests are being queued with the kernel, rather than being
+        run on a set of threads.
+    */
+    bool isUsingKernelQueue() const noexcept;
+
+private:
+    //==============================================================================
+    class Backend;
+    class ThreadBackend;
+    class IoUringBackend;
+
+    void requestFinished (Request&, int64 result);
+
+    std::unique_ptr<Backend> backend;
+    std::atomic<int> numPendingRequests { 0 };
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileIOService)
+};
+
+} // namespace juce
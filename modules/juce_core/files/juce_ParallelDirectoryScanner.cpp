@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  One of the items in a folder, as read by the platform-specific readDirectory().
+
+    Only items that match the wildcard, or that are folders which may need to be searched,
+    are passed on, so the others never have File objects created for them.
+*/
+struct ParallelDirectoryScanner::NativeEntry
+{
+    DirectoryEntry entry;
+    bool matchesWildcard = false;
+    bool isSymlink = false;
+};
+
+struct ParallelDirectoryScanner::ScanState
+{
+    ScanState (WorkStealingThreadPool& p, const Options& o, const Callback& c)
+        : options (o), callback (c), group (p)
+    {
+        wildcards.addTokens (options.wildCard, ";,", "\"'");
+        wildcards.trim();
+        wildcards.removeEmptyStrings();
+    }
+
+    const Options& options;
+    const Callback& callback;
+    StringArray wildcards;
+    WorkStealingThreadPool::TaskGroup group;
+    std::atomic<int64> numFound { 0 };
+
+    std::mutex knownPathsLock;
+    std::set<File> knownPaths;
+};
+
+//==============================================================================
+ParallelDirectoryScanner::ParallelDirectoryScanner (WorkStealingThreadPool& p)  : pool (p) {}
+ParallelDirectoryScanner::~ParallelDirectoryScanner() = default;
+
+int64 ParallelDirectoryScanner::scan (const File& directory, const Options& options, const Callback& callback)
+{
+    // you have to specify the type of files you're looking for!
+    jassert ((options.whatToLookFor & (File::findFiles | File::findDirectories)) != 0);
+    jassert (options.whatToLookFor > 0 && options.whatToLookFor <= 7);
+
+    shouldStop = false;
+
+    ScanState state (pool, options, callback);
+
+    if (options.followSymlinks == File::FollowSymlinks::noCycles)
+        state.knownPaths.insert (directory);
+
+    scanDirectory (state, directory);
+    state.group.wait();
+
+    return state.numFound;
+}
+
+std::vector<DirectoryEntry> ParallelDirectoryScanner::findEntries (const File& directory, const Options& options)
+{
+    std::mutex lock;
+    std::vector<DirectoryEntry> results;
+
+    scan (directory, options, [&] (const DirectoryEntry& entry)
+    {
+        const std::scoped_lock sl (lock);
+        results.push_back (entry);
+    });
+
+    std::sort (results.begin(), results.end(), [] (const DirectoryEntry& a, const DirectoryEntry& b)
+    {
+        return a.getFile() < b.getFile();
+    });
+
+    return results;
+}
+
+void ParallelDirectoryScanner::stop() noexcept
+{
+    shouldStop = true;
+}
+
+void ParallelDirectoryScanner::scanDirectory (ScanState& state, const File& directory)
+{
+    const auto& options = state.options;
+    const auto ignoreHidden = (options.whatToLookFor & File::ignoreHiddenFiles) != 0;
+
+    const auto mayRecurseInto = [&] (const NativeEntry& item)
+    {
+        if (! options.isRecursive || (ignoreHidden && item.entry.isHidden()))
+            return false;
+
+        if (options.followSymlinks == File::FollowSymlinks::yes)
+            return true;
+
+        if (item.isSymlink && options.followSymlinks == File::FollowSymlinks::no)
+            return false;
+
+        if (options.followSymlinks == File::FollowSymlinks::noCycles)
+        {
+            const std::scoped_lock sl (state.knownPathsLock);
+
+            if (item.isSymlink
+                 && state.knownPaths.find (item.entry.getFile().getLinkedTarget()) != state.knownPaths.end())
+                return false;
+
+            state.knownPaths.insert (item.entry.getFile());
+        }
+
+        return true;
+    };
+
+    readDirectory (directory, state.wildcards, options.readMetadata, [&] (NativeEntry& item)
+    {
+        if (shouldStop)
+            return false;
+
+        const auto& entry = item.entry;
+
+        if (entry.isDirectory() && mayRecurseInto (item))
+            state.group.run ([this, &state, subfolder = entry.getFile()] { scanDirectory (state, subfolder); });
+
+        const auto typeToFind = entry.isDirectory() ? File::findDirectories : File::findFiles;
+
+        if (item.matchesWildcard
+             && (options.whatToLookFor & typeToFind) != 0
+             && ! (ignoreHidden && entry.isHidden()))
+        {
+            ++state.numFound;
+            state.callback (entry);
+        }
+
+        return true;
+    });
+}
+
+bool ParallelDirectoryScanner::matchesWildcards (const StringArray& wildcards, const String& filename)
+{
+    for (auto& w : wildcards)
+        if (filename.matchesWildcard (w, ! File::areFileNamesCaseSensitive()))
+            return true;
+
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelDirectoryScannerTests  : public UnitTest
+{
+public:
+    ParallelDirectoryScannerTests()
+        : UnitTest ("ParallelDirectoryScanner", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile tempFolder;
+        const auto root = tempFolder.getFile();
+        root.createDirectory();
+
+        for (int i = 0; i < 5; ++i)
+        {
+            auto folder = root.getChildFile ("folder" + String (i));
+
+            for (int j = 0; j < 4; ++j)
+            {
+                auto subfolder = folder.getChildFile ("sub" + String (j));
+                subfolder.createDirectory();
+
+                for (int k = 0; k < 6; ++k)
+                    subfolder.getChildFile ("file" + String (k) + (k % 2 == 0 ? ".wav" : ".txt")).replaceWithText (String (k));
+            }
+        }
+
+        root.getChildFile (".hidden.wav").replaceWithText ("hidden");
+
+        WorkStealingThreadPool pool (4);
+        ParallelDirectoryScanner scanner (pool);
+
+        const auto check = [&] (const String& testName, const ParallelDirectoryScanner::Options& options)
+        {
+            beginTest (testName);
+
+            std::vector<DirectoryEntry> expected;
+
+            for (const auto& entry : RangedDirectoryIterator (root, options.isRecursive, options.wildCard, options.whatToLookFor))
+                expected.push_back (entry);
+
+            std::sort (expected.begin(), expected.end(), [] (const DirectoryEntry& a, const DirectoryEntry& b)
+            {
+                return a.getFile() < b.getFile();
+            });
+
+            const auto found = scanner.findEntries (root, options);
+            expectEquals ((int) found.size(), (int) expected.size());
+
+            for (size_t i = 0; i < jmin (found.size(), expected.size()); ++i)
+            {
+                expect (found[i].getFile() == expected[i].getFile());
+                expect (found[i].isDirectory() == expected[i].isDirectory());
+                expect (found[i].isHidden() == expected[i].isHidden());
+
+                if (options.readMetadata)
+                {
+                    expectEquals (found[i].getFileSize(), expected[i].getFileSize());
+                    expect (found[i].getModificationTime() == expected[i].getModificationTime());
+                    expect (found[i].isReadOnly() == expected[i].isReadOnly());
+                }
+            }
+        };
+
+        using Options = ParallelDirectoryScanner::Options;
+
+        check ("All files", Options{});
+        check ("Wildcards", Options{}.withWildCard ("*.wav"));
+        check ("Several wildcards", Options{}.withWildCard ("file1.*;*5.txt"));
+        check ("Files and folders", Options{}.withTypesToFind (File::findFilesAndDirectories));
+        check ("Folders", Options{}.withTypesToFind (File::findDirectories));
+        check ("Hidden files ignored", Options{}.withTypesToFind (File::findFiles | File::ignoreHiddenFiles));
+        check ("Not recursive", Options{}.withRecursion (false).withTypesToFind (File::findFilesAndDirectories));
+        check ("Without metadata", Options{}.withMetadata (false).withWildCard ("*.txt"));
+
+        beginTest ("Stopping");
+        {
+            std::atomic<int> numCalls { 0 };
+
+            scanner.scan (root, Options{}, [&] (const DirectoryEntry&)
+            {
+                if (++numCalls == 1)
+                    scanner.stop();
+            });
+
+            expect (numCalls < 121);
+            expectEquals ((int) scanner.scan (root, Options{}, [] (const DirectoryEntry&) {}), 121);
+        }
+    }
+};
+
+static ParallelDirectoryScannerTests parallelDirectoryScannerTests;
+
+#endif
+
+} // namespace juce
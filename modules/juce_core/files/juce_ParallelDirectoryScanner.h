@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Searches a directory tree for files and folders using several threads at once.
+
+    Each folder that's found becomes a separate task on a WorkStealingThreadPool, so
+    the folders of a large tree are read in parallel, with idle threads taking over
+    whole subtrees from busy ones. Each folder is read directly with the platform's
+    own calls, the wildcard is matched against the raw names before any File objects
+    are created, and the size and times of the files are only read if you ask for them.
+
+    Unlike RangedDirectoryIterator, the items aren't returned in any particular order,
+    and the callback is called from the pool's threads, possibly on several of them at
+    the same time.
+
+    @code
+    WorkStealingThreadPool pool;
+    ParallelDirectoryScanner scanner (pool);
+
+    std::mutex lock;
+    Array<File> samples;
+
+    scanner.scan (libraryFolder,
+                  ParallelDirectoryScanner::Options{}.withWildCard ("*.wav;*.aif"),
+                  [&] (const DirectoryEntry& entry)
+                  {
+                      const std::scoped_lock sl (lock);
+                      samples.add (entry.getFile());
+                  });
+    @endcode
+
+    @see RangedDirectoryIterator, WorkStealingThreadPool
+
+    @tags{Core}
+*/
+class JUCE_API  ParallelDirectoryScanner
+{
+public:
+    //==============================================================================
+    /** Specifies which items a scan should find. */
+    class Options
+    {
+    public:
+        String wildCard { "*" };
+        int whatToLookFor = File::findFiles;
+        bool isRecursive = true;
+        File::FollowSymlinks followSymlinks = File::FollowSymlinks::yes;
+        bool readMetadata = true;
+
+        /** The file pattern to match. This may contain multiple patterns separated by a
+            semi-colon or comma, e.g. "*.jpg;*.png".
+        */
+        [[nodiscard]] auto withWildCard (const String& value) const          { return with (&Options::wildCard, value); }
+
+        /** A value from the File::TypesOfFileToFind enum, specifying whether to look for
+            files, directories, or both, and whether to skip hidden items.
+        */
+        [[nodiscard]] auto withTypesToFind (int value) const                 { return with (&Options::whatToLookFor, value); }
+
+        /** Specifies whether the subfolders should also be searched. */
+        [[nodiscard]] auto withRecursion (bool value) const                  { return with (&Options::isRecursive, value); }
+
+        /** The policy to use when symlinks to folders are found. */
+        [[nodiscard]] auto withFollowSymlinks (File::FollowSymlinks value) const { return with (&Options::followSymlinks, value); }
+
+        /** Specifies whether the size, times and read-only flag of each item should be read.
+
+            On some platforms this needs an extra system call for every item, so if you
+            only need the names of the files, turning it off can make a scan much faster.
+            When it's off, DirectoryEntry::isDirectory() and DirectoryEntry::isHidden() are
+            still valid, but the other properties are left at their default values. (On
+            macOS, items that are hidden by a file flag rather than by a name starting with
+            a dot are only detected when the metadata is read).
+        */
+        [[nodiscard]] auto withMetadata (bool value) const                   { return with (&Options::readMetadata, value); }
+
+    private:
+        template <typename Member, typename Value>
+        [[nodiscard]] Options with (Member&& member, Value&& value) const
+        {
+            auto copy = *this;
+            copy.*member = std::forward<Value> (value);
+            return copy;
+        }
+    };
+
+    //==============================================================================
+    /** Creates a scanner which will run its scans on the given pool. */
+    explicit ParallelDirectoryScanner (WorkStealingThreadPool& pool);
+
+    /** Destructor. */
+    ~ParallelDirectoryScanner();
+
+    //==============================================================================
+    /** A function that's called for each item that a scan finds. */
+    using Callback = std::function<void (const DirectoryEntry&)>;
+
+    /** Searches a directory, calling a function for each item that matches the options.
+
+        This returns once the whole tree has been searched. While it's waiting, the calling
+        thread helps with the scan.
+
+        The callback is called on the pool's threads and the calling thread, possibly on
+        several of them at the same time, so it must be thread-safe.
+
+        @returns the number of items that were passed to the callback
+    */
+    int64 scan (const File& directory, const Options& options, const Callback& callback);
+
+    /** Searches a directory, and returns all the items that match the options, sorted by path. */
+    std::vector<DirectoryEntry> findEntries (const File& directory, const Options& options);
+
+    /** Makes any scan that's in progress finish as soon as possible.
+
+        This can be called from any thread, including from inside the callback. Items that
+        have already been found may still be passed to the callback while the scan winds down.
+    */
+    void stop() noexcept;
+
+private:
+    //==============================================================================
+    struct NativeEntry;
+    struct ScanState;
+
+    void scanDirectory (ScanState&, const File&);
+
+    static bool matchesWildcards (const StringArray&, const String& filename);
+    static void readDirectory (const File&, const StringArray& wildcards, bool readMetadata,
+                               const std::function<bool (NativeEntry&)>&);
+
+    WorkStealingThreadPool& pool;
+    std::atomic<bool> shouldStop { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelDirectoryScanner)
+};
+
+} // namespace juce
@@ -333,7 +333,8 @@ struct JSONFormatter
 
             if (juce_isfinite (d))
             {
-                out << serialiseDouble (d);
+                char buffer[NumberToStringConverters::charsNeededForDouble];
+                out.write (buffer, NumberToStringConverters::serialiseDouble (buffer, d));
             }
             else
             {
@@ -674,7 +675,7 @@ public:
             tests[0.0123] = "0.0123";
             tests[-3.7e-27] = "-3.7e-27";
             tests[1e+40] = "1.0e40";
-            tests[-12345678901234567.0] = "-1.234567890123457e16";
+            tests[-12345678901234567.0] = "-1.2345678901234568e16";
             tests[192000] = "192000.0";
             tests[1234567] = "1.234567e6";
             tests[0.00006] = "0.00006";
@@ -0,0 +1,679 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+JSONReader::JSONReader (InputStream& source, int size)
+    : input (source),
+      buffer ((size_t) jmax (16, size)),
+      bufferSize (jmax (16, size))
+{
+    text.reserve (256);
+}
+
+JSONReader::~JSONReader() = default;
+
+//==============================================================================
+bool JSONReader::refill()
+{
+    bufferPos = 0;
+    bufferEnd = jmax (0, input.read (buffer, bufferSize));
+    return bufferEnd > 0;
+}
+
+int JSONReader::peekByte()
+{
+    if (bufferPos >= bufferEnd && ! refill())
+        return -1;
+
+    return (uint8) buffer[bufferPos];
+}
+
+int JSONReader::readByte()
+{
+    auto c = peekByte();
+
+    if (c >= 0)
+    {
+        ++bufferPos;
+
+        if (c == '\n')
+        {
+            ++line;
+            column = 1;
+        }
+        else if ((c & 0xc0) != 0x80)
+        {
+            ++column; // continuation bytes are part of the same character
+        }
+    }
+
+    return c;
+}
+
+void JSONReader::skipWhitespace()
+{
+    for (;;)
+    {
+        auto c = peekByte();
+
+        if (c != ' ' && (c < 9 || c > 13))
+            return;
+
+        readByte();
+    }
+}
+
+void JSONReader::appendUTF8 (juce_wchar c)
+{
+    char bytes[8];
+    CharPointer_UTF8 dest (bytes);
+    dest.write (c);
+    text.insert (text.end(), bytes, bytes + CharPointer_UTF8::getBytesRequiredFor (c));
+}
+
+JSONReader::Event JSONReader::fail (const String& message)
+{
+    return fail (message, line, column);
+}
+
+JSONReader::Event JSONReader::fail (const String& message, int lineOfError, int columnOfError)
+{
+    errorResult = Result::fail (String (lineOfError) + ":" + String (columnOfError) + ": error: " + message);
+    stack.clear();
+    return currentEvent = Event::error;
+}
+
+//==============================================================================
+JSONReader::Event JSONReader::next()
+{
+    if (currentEvent == Event::error)
+        return currentEvent;
+
+    if (! hasStarted)
+    {
+        hasStarted = true;
+
+        // skip a UTF-8 byte-order mark
+        if (peekByte() == 0xef)
+        {
+            readByte();
+
+            if (readByte() != 0xbb || readByte() != 0xbf)
+                return fail ("Syntax error", 1, 1);
+
+            column = 1;
+        }
+    }
+
+    text.clear();
+    skipWhitespace();
+    startToken();
+
+    if (stack.empty())
+    {
+        if (peekByte() < 0)
+            return currentEvent = Event::endOfStream;
+
+        return currentEvent = readValueToken (readByte());
+    }
+
+    auto& frame = stack.back();
+
+    if (frame.isObject && expectingPropertyValue)
+    {
+        if (readByte() != ':')
+            return fail ("Expected ':'", tokenLine, tokenColumn);
+
+        expectingPropertyValue = false;
+        skipWhitespace();
+        startToken();
+
+        if (peekByte() < 0)
+            return fail ("Unexpected EOF in object declaration");
+
+        return currentEvent = readValueToken (readByte());
+    }
+
+    const auto closingChar = frame.isObject ? '}' : ']';
+    auto c = peekByte();
+
+    if (c == closingChar)
+        return closeContainer();
+
+    if (frame.hasItems)
+    {
+        if (c != ',')
+            return fail (frame.isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+
+        readByte();
+        skipWhitespace();
+        startToken();
+        c = peekByte();
+
+        if (c == closingChar)  // a trailing comma is allowed, as it is by JSON::parse()
+            return closeContainer();
+    }
+
+    if (c < 0)
+        return fail (frame.isObject ? "Unexpected EOF in object declaration"
+                                    : "Unexpected EOF in array declaration");
+
+    frame.hasItems = true;
+
+    if (! frame.isObject)
+        return currentEvent = readValueToken (readByte());
+
+    if (c != '"')
+        return fail ("Expected a property name in double-quotes");
+
+    readByte();
+
+    if (readString ('"', Event::propertyName) == Event::error)
+        return currentEvent;
+
+    if (text.size() <= 1)
+        return fail ("Invalid property name", tokenLine, tokenColumn + 1);
+
+    expectingPropertyValue = true;
+    return currentEvent;
+}
+
+JSONReader::Event JSONReader::closeContainer()
+{
+    readByte();
+    const auto wasObject = stack.back().isObject;
+    stack.pop_back();
+    return currentEvent = (wasObject ? Event::objectEnd : Event::arrayEnd);
+}
+
+JSONReader::Event JSONReader::readValueToken (int c)
+{
+    switch (c)
+    {
+        case '{':
+            stack.push_back ({ true, false });
+            expectingPropertyValue = false;
+            return currentEvent = Event::objectStart;
+
+        case '[':
+            stack.push_back ({ false, false });
+            return currentEvent = Event::arrayStart;
+
+        case '"':
+        case '\'':
+            return readString (c, Event::stringValue);
+
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return readNumber (c);
+
+        case 't':   return readLiteral ("rue",  Event::boolValue, true);
+        case 'f':   return readLiteral ("alse", Event::boolValue, false);
+        case 'n':   return readLiteral ("ull",  Event::nullValue, false);
+
+        default:
+            break;
+    }
+
+    return fail ("Syntax error", tokenLine, tokenColumn);
+}
+
+JSONReader::Event JSONReader::readLiteral (const char* rest, Event typeOfValue, bool value)
+{
+    while (*rest != 0)
+        if (readByte() != (uint8) *rest++)
+            return fail ("Syntax error", tokenLine, tokenColumn);
+
+    boolValue = value;
+    return currentEvent = typeOfValue;
+}
+
+JSONReader::Event JSONReader::readString (int quoteChar, Event typeOfString)
+{
+    juce_wchar pendingHighSurrogate = 0;
+
+    auto flushSurrogate = [&]
+    {
+        if (pendingHighSurrogate != 0)
+        {
+            appendUTF8 (0xfffd); // an unpaired surrogate can't be represented in UTF-8
+            pendingHighSurrogate = 0;
+        }
+    };
+
+    for (;;)
+    {
+        auto c = readByte();
+
+        if (c == quoteChar)
+            break;
+
+        if (c <= 0)
+            return fail ("Unexpected EOF in string constant");
+
+        if (c != '\\')
+        {
+            flushSurrogate();
+            text.push_back ((char) c);
+            continue;
+        }
+
+        auto errorLine = line, errorColumn = column;
+        c = readByte();
+        juce_wchar unescaped = 0;
+
+        switch (c)
+        {
+            case 'a':  unescaped = '\a'; break;
+            case 'b':  unescaped = '\b'; break;
+            case 'f':  unescaped = '\f'; break;
+            case 'n':  unescaped = '\n'; break;
+            case 'r':  unescaped = '\r'; break;
+            case 't':  unescaped = '\t'; break;
+
+            case 'u':
+            {
+                for (int i = 4; --i >= 0;)
+                {
+                    auto digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) jmax (0, readByte()));
+
+                    if (digitValue < 0)
+                        return fail ("Syntax error in unicode escape sequence", errorLine, errorColumn);
+
+                    unescaped = (juce_wchar) ((unescaped << 4) + static_cast<juce_wchar> (digitValue));
+                }
+
+                if (unescaped >= 0xdc00 && unescaped <= 0xdfff && pendingHighSurrogate != 0)
+                {
+                    unescaped = 0x10000 + ((pendingHighSurrogate - 0xd800) << 10) + (unescaped - 0xdc00);
+                    pendingHighSurrogate = 0;
+                }
+                else
+                {
+                    flushSurrogate();
+
+                    if (unescaped >= 0xd800 && unescaped <= 0xdbff)
+                    {
+                        pendingHighSurrogate = unescaped;
+                        continue;
+                    }
+
+                    if (unescaped >= 0xdc00 && unescaped <= 0xdfff)
+                        unescaped = 0xfffd;
+                }
+
+                break;
+            }
+
+            default:
+                // any other escaped character is used as it is
+                unescaped = (juce_wchar) jmax (0, c);
+                break;
+        }
+
+        if (unescaped == 0)
+            return fail ("Unexpected EOF in string constant");
+
+        flushSurrogate();
+        appendUTF8 (unescaped);
+    }
+
+    flushSurrogate();
+    text.push_back (0);
+    return currentEvent = typeOfString;
+}
+
+JSONReader::Event JSONReader::readNumber (int firstChar)
+{
+    text.push_back ((char) firstChar);
+
+    if (firstChar == '-')
+    {
+        skipWhitespace(); // JSON::parse() allows this
+
+        auto c = peekByte();
+
+        if (c < '0' || c > '9')
+            return fail ("Syntax error", tokenLine, tokenColumn);
+
+        text.push_back ((char) readByte());
+    }
+
+    bool isDouble = false, hasSign = false;
+
+    for (;;)
+    {
+        auto c = peekByte();
+
+        if (c >= '0' && c <= '9')
+        {
+            text.push_back ((char) readByte());
+        }
+        else if (c == '.' || c == 'e' || c == 'E')
+        {
+            isDouble = true;
+            text.push_back ((char) readByte());
+        }
+        else if (c == '+' || c == '-')
+        {
+            hasSign = true;
+            text.push_back ((char) readByte());
+        }
+        else
+        {
+            if (c >= 0 && c != ',' && c != '}' && c != ']' && c != ' ' && (c < 9 || c > 13))
+                return fail ("Syntax error in number");
+
+            break;
+        }
+    }
+
+    if (hasSign && ! isDouble)
+        return fail ("Syntax error in number", tokenLine, tokenColumn);
+
+    text.push_back (0);
+
+    if (! isDouble)
+    {
+        const auto isNegative = text[0] == '-';
+        uint64 value = 0;
+
+        for (auto* d = text.data() + (isNegative ? 1 : 0); *d != 0; ++d)
+        {
+            auto digit = (uint64) (*d - '0');
+
+            if (value > (std::numeric_limits<uint64>::max() - digit) / 10
+                 || value * 10 + digit > (uint64) std::numeric_limits<int64>::max())
+            {
+                isDouble = true; // too big for an int64
+                break;
+            }
+
+            value = value * 10 + digit;
+        }
+
+        if (! isDouble)
+        {
+            intValue = isNegative ? -(int64) value : (int64) value;
+            return currentEvent = Event::intValue;
+        }
+    }
+
+    CharPointer_ASCII numberText (text.data());
+    doubleValue = CharacterFunctions::readDoubleValue (numberText);
+    return currentEvent = Event::doubleValue;
+}
+
+//==============================================================================
+StringRef JSONReader::getText() const noexcept
+{
+    if (text.empty())
+        return {};
+
+    return CharPointer_UTF8 (text.data());
+}
+
+String JSONReader::getString() const
+{
+    if (text.size() <= 1)
+        return {};
+
+    return String::fromUTF8 (text.data(), (int) text.size() - 1);
+}
+
+int64 JSONReader::getInt() const noexcept
+{
+    return currentEvent == Event::doubleValue ? (int64) doubleValue : intValue;
+}
+
+double JSONReader::getDouble() const noexcept
+{
+    return currentEvent == Event::doubleValue ? doubleValue : (double) intValue;
+}
+
+var JSONReader::getValue() const
+{
+    switch (currentEvent)
+    {
+        case Event::propertyName:
+        case Event::stringValue:    return getString();
+        case Event::doubleValue:    return doubleValue;
+        case Event::boolValue:      return boolValue;
+
+        case Event::intValue:
+        {
+            // numbers are returned as an int if they fit, in the same way as JSON::parse()
+            auto magnitude = intValue < 0 ? -intValue : intValue;
+            return (magnitude >> 31) != 0 ? var (intValue) : var ((int) intValue);
+        }
+
+        case Event::objectStart:
+        case Event::objectEnd:
+        case Event::arrayStart:
+        case Event::arrayEnd:
+        case Event::nullValue:
+        case Event::endOfStream:
+        case Event::error:
+        default:                    break;
+    }
+
+    return {};
+}
+
+var JSONReader::readValue()
+{
+    if (currentEvent == Event::propertyName)
+        next();
+
+    if (currentEvent == Event::objectStart)
+    {
+        auto* object = new DynamicObject();
+        var result (object);
+
+        while (next() == Event::propertyName)
+        {
+            Identifier name (getString());
+            next();
+            auto value = readValue();
+
+            if (currentEvent == Event::error)
+                return {};
+
+            object->getProperties().set (name, std::move (value));
+        }
+
+        return currentEvent == Event::objectEnd ? result : var();
+    }
+
+    if (currentEvent == Event::arrayStart)
+    {
+        var result (Array<var>{});
+        auto& array = *result.getArray();
+
+        for (;;)
+        {
+            auto event = next();
+
+            if (event == Event::arrayEnd)
+                return result;
+
+            auto value = readValue();
+
+            if (currentEvent == Event::error)
+                return {};
+
+            array.add (std::move (value));
+        }
+    }
+
+    return getValue();
+}
+
+bool JSONReader::skipValue()
+{
+    if (currentEvent == Event::propertyName)
+        next();
+
+    if (currentEvent == Event::objectStart || currentEvent == Event::arrayStart)
+    {
+        const auto depth = getDepth();
+
+        while (getDepth() >= depth)
+            if (next() == Event::error)
+                return false;
+    }
+
+    return currentEvent != Event::error;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONReaderTests  : public UnitTest
+{
+public:
+    JSONReaderTests()
+        : UnitTest ("JSONReader", UnitTestCategories::json)
+    {}
+
+    struct TextStream  : public MemoryInputStream
+    {
+        explicit TextStream (const char* text)  : MemoryInputStream (text, strlen (text), false) {}
+    };
+
+    void runTest() override
+    {
+        using Event = JSONReader::Event;
+
+        beginTest ("Events");
+        {
+            TextStream stream ("\xef\xbb\xbf{ \"a\": [1, -2.5e1, \"x\\ty\", true, null], \"b\": {} }");
+            JSONReader reader (stream);
+
+            expect (reader.next() == Event::objectStart);
+            expect (reader.next() == Event::propertyName && reader.getText() == StringRef ("a"));
+            expect (reader.next() == Event::arrayStart && reader.getDepth() == 2);
+            expect (reader.next() == Event::intValue && reader.getInt() == 1);
+            expect (reader.next() == Event::doubleValue && reader.getDouble() < -24.9 && reader.getDouble() > -25.1);
+            expect (reader.next() == Event::stringValue && reader.getString() == "x\ty");
+            expect (reader.next() == Event::boolValue && reader.getBool());
+            expect (reader.next() == Event::nullValue);
+            expect (reader.next() == Event::arrayEnd && reader.getDepth() == 1);
+            expect (reader.next() == Event::propertyName && reader.getString() == "b");
+            expect (reader.next() == Event::objectStart);
+            expect (reader.next() == Event::objectEnd);
+            expect (reader.next() == Event::objectEnd && reader.getDepth() == 0);
+            expect (reader.next() == Event::endOfStream);
+            expect (reader.getError().wasOk());
+        }
+
+        beginTest ("Numbers");
+        {
+            TextStream stream ("[1234, 12345678901234, -12345678901234, 99999999999999999999, 1.5]");
+            JSONReader reader (stream);
+            expect (reader.next() == Event::arrayStart);
+
+            expect (reader.next() == Event::intValue && reader.getValue().isInt());
+            expect (reader.next() == Event::intValue && reader.getValue().isInt64());
+            expect (reader.next() == Event::intValue && reader.getInt() == -12345678901234);
+            expect (reader.next() == Event::doubleValue && reader.getDouble() > 9.9e19);
+            expect (reader.next() == Event::doubleValue && reader.getValue().isDouble());
+        }
+
+        beginTest ("Values match JSON::parse");
+        {
+            auto r = getRandom();
+
+            for (int i = 100; --i >= 0;)
+            {
+                const bool oneLine = r.nextBool();
+                auto text = JSON::toString (JSONTests::createRandomVar (r, 0), oneLine);
+
+                MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                JSONReader reader (stream, 16 + r.nextInt (100));
+                reader.next();
+                auto parsed = reader.readValue();
+
+                expect (reader.getError().wasOk());
+                expectEquals (JSON::toString (parsed, oneLine), text);
+            }
+        }
+
+        beginTest ("Unicode escapes");
+        {
+            TextStream stream ("\"\\u00e9\\ud83d\\ude00\\ud800x\"");
+            JSONReader reader (stream);
+            expect (reader.next() == Event::stringValue);
+
+            const juce_wchar expected[] = { 0xe9, 0x1f600, 0xfffd, 'x', 0 };
+            expectEquals (reader.getString(), String (CharPointer_UTF32 (expected)));
+        }
+
+        beginTest ("Skipping values and reading several documents");
+        {
+            TextStream stream ("{\"skip\": {\"a\": [1, {\"b\": 2}]}, \"keep\": 3}\n[4]\n5");
+            JSONReader reader (stream);
+
+            expect (reader.next() == Event::objectStart);
+            expect (reader.next() == Event::propertyName);
+            expect (reader.skipValue() && reader.getCurrentEvent() == Event::objectEnd && reader.getDepth() == 1);
+            expect (reader.next() == Event::propertyName);
+            expect (reader.readValue() == var (3));
+            expect (reader.next() == Event::objectEnd);
+
+            expect (reader.next() == Event::arrayStart);
+            expect (reader.readValue()[0] == var (4));
+            expect (reader.next() == Event::intValue && reader.getInt() == 5);
+            expect (reader.next() == Event::endOfStream);
+        }
+
+        beginTest ("Errors");
+        {
+            for (auto* text : { "{\"a\" 1}", "[tru]", "{\"a\":1 x}", "[1, 2", "{\n  \"a\": 1,\n  \"b\" 2\n}", "[\"abc", "[12a]" })
+            {
+                var unused;
+                auto expected = JSON::parse (text, unused);
+
+                TextStream stream (text);
+                JSONReader reader (stream);
+
+                while (reader.next() != Event::error)
+                    expect (reader.getCurrentEvent() != Event::endOfStream);
+
+                expect (reader.next() == Event::error);
+                expectEquals (reader.getError().getErrorMessage(), expected.getErrorMessage());
+            }
+        }
+    }
+};
+
+static JSONReaderTests jsonReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads JSON from a stream as a sequence of events, without building a var tree.
+
+    JSON::parse() needs the whole document in memory, both as text and as a tree of
+    var objects. This class instead reads through a stream piece by piece, so huge
+    documents can be processed in a fixed amount of memory. Each call to next()
+    moves on to the next token and tells you what it was, e.g.
+
+    @code
+    JSONReader reader (stream);
+
+    while (reader.next() == JSONReader::Event::propertyName)
+    {
+        if (reader.getText() == "name")
+        {
+            reader.next();
+            DBG (reader.getString());
+        }
+        else
+        {
+            reader.next();
+            reader.skipValue();
+        }
+    }
+    @endcode
+
+    The text of strings and property names is kept in a buffer that's reused, so
+    no memory is allocated for them unless you ask for a String. If you want to
+    load part of a document into a var, call readValue() when you reach it.
+
+    The reader accepts the same syntax as JSON::parse(), and reports errors with
+    the same line and column information. After a complete top-level value has
+    been read, it carries on with the next one if there's more in the stream, so
+    it can also be used for files containing one JSON value per line.
+
+    @see JSON, JSONWriter
+
+    @tags{Core}
+*/
+class JUCE_API  JSONReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader for a stream.
+
+        The stream must remain valid for the lifetime of the reader, which will read
+        from it in chunks of the given size.
+    */
+    explicit JSONReader (InputStream& source, int bufferSize = 8192);
+
+    /** Destructor. */
+    ~JSONReader();
+
+    //==============================================================================
+    /** The kinds of token that can be read. */
+    enum class Event
+    {
+        objectStart,        /**< A '{' was read. */
+        objectEnd,          /**< The '}' that ends an object was read. */
+        arrayStart,         /**< A '[' was read. */
+        arrayEnd,           /**< The ']' that ends an array was read. */
+        propertyName,       /**< The name of a property was read. Its value comes next. */
+        stringValue,        /**< A string was read. */
+        intValue,           /**< A number without a fractional part or exponent was read. */
+        doubleValue,        /**< A number with a fractional part or exponent was read. */
+        boolValue,          /**< true or false was read. */
+        nullValue,          /**< null was read. */
+        endOfStream,        /**< There's nothing more in the stream. */
+        error               /**< The text wasn't valid JSON. Call getError() for the details. */
+    };
+
+    /** Reads the next token.
+
+        Once an error or the end of the stream has been reached, this will keep
+        returning the same event.
+    */
+    Event next();
+
+    /** Returns the event that the last call to next() returned. */
+    Event getCurrentEvent() const noexcept          { return currentEvent; }
+
+    /** Returns the number of objects and arrays that enclose the current position.
+
+        After an objectStart or arrayStart event this includes the new container,
+        and after an objectEnd or arrayEnd it no longer does.
+    */
+    int getDepth() const noexcept                   { return (int) stack.size(); }
+
+    //==============================================================================
+    /** For a propertyName or stringValue event, returns the text.
+
+        The reference is only valid until next() is called again, but unlike
+        getString() this doesn't allocate any memory.
+    */
+    StringRef getText() const noexcept;
+
+    /** For a propertyName or stringValue event, returns the text as a String. */
+    String getString() const;
+
+    /** For an intValue event, returns the number. A doubleValue is truncated. */
+    int64 getInt() const noexcept;
+
+    /** For an intValue or doubleValue event, returns the number. */
+    double getDouble() const noexcept;
+
+    /** For a boolValue event, returns the value. */
+    bool getBool() const noexcept                   { return boolValue; }
+
+    /** Returns the current token as a var.
+
+        Numbers and strings are returned in the same form as JSON::parse() would
+        produce. For any of the start or end events, this returns an empty var - use
+        readValue() to read a whole object or array.
+    */
+    var getValue() const;
+
+    //==============================================================================
+    /** Reads the complete value that starts at the current event, and returns it.
+
+        If the current event is objectStart or arrayStart, this reads up to the end of
+        that container, and the reader is left at its objectEnd or arrayEnd event.
+        If it's propertyName, this reads the property's value. For other events it's
+        the same as getValue().
+
+        If an error happens, this returns an empty var, and the reader's current
+        event will be Event::error.
+    */
+    var readValue();
+
+    /** Skips over the value that starts at the current event, in the same way that
+        readValue() would read it, but without storing anything.
+
+        Returns false if an error was found.
+    */
+    bool skipValue();
+
+    //==============================================================================
+    /** Returns an error if an invalid token has been found, or Result::ok(). */
+    Result getError() const                         { return errorResult; }
+
+private:
+    //==============================================================================
+    struct Frame
+    {
+        bool isObject, hasItems;
+    };
+
+    int peekByte();
+    int readByte();
+    bool refill();
+    void skipWhitespace();
+    void startToken() noexcept                      { tokenLine = line; tokenColumn = column; }
+
+    Event readValueToken (int firstChar);
+    Event readString (int quoteChar, Event typeOfString);
+    Event readNumber (int firstChar);
+    Event readLiteral (const char* rest, Event typeOfValue, bool value);
+    Event closeContainer();
+    Event fail (const String& message);
+    Event fail (const String& message, int lineOfError, int columnOfError);
+
+    void appendUTF8 (juce_wchar);
+
+    InputStream& input;
+    HeapBlock<char> buffer;
+    int bufferSize, bufferPos = 0, bufferEnd = 0;
+
+    std::vector<Frame> stack;
+    std::vector<char> text;
+    Event currentEvent = Event::endOfStream;
+    bool expectingPropertyValue = false, boolValue = false, hasStarted = false;
+    int64 intValue = 0;
+    double doubleValue = 0;
+    int line = 1, column = 1, tokenLine = 1, tokenColumn = 1;
+    Result errorResult { Result::ok() };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONReader)
+};
+
+} // namespace juce
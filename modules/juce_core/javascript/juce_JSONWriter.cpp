@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+JSONWriter::JSONWriter (OutputStream& destination, bool oneLine, int decimalPlaces)
+    : out (destination), allOnOneLine (oneLine), maximumDecimalPlaces (decimalPlaces)
+{
+    stack.reserve (16);
+}
+
+JSONWriter::~JSONWriter()
+{
+    // All the objects and arrays should have been closed before the writer is deleted!
+    jassert (stack.empty());
+}
+
+//==============================================================================
+int JSONWriter::getIndent() const noexcept
+{
+    return (int) stack.size() * JSONFormatter::indentSize;
+}
+
+// The separators are written before each item rather than after it, but they come
+// out the same as the ones that JSONFormatter and DynamicObject::writeAsJSON() use.
+void JSONWriter::startItem()
+{
+    auto& frame = stack.back();
+
+    if (frame.hasItems)
+        out << (allOnOneLine ? ", " : ",");
+
+    if (! allOnOneLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, getIndent());
+    }
+
+    frame.hasItems = true;
+}
+
+void JSONWriter::startValue()
+{
+    if (stack.empty())
+    {
+        if (hasWrittenTopLevelValue)
+            out << newLine;
+
+        hasWrittenTopLevelValue = true;
+        return;
+    }
+
+    if (stack.back().isObject)
+    {
+        // Inside an object, you need to call writeName() before writing each value!
+        jassert (expectingPropertyValue);
+        expectingPropertyValue = false;
+        return;
+    }
+
+    startItem();
+}
+
+void JSONWriter::endContainer (bool isObject)
+{
+    // This doesn't match the object or array that's currently open!
+    jassert (! stack.empty() && stack.back().isObject == isObject && ! expectingPropertyValue);
+
+    if (stack.empty())
+        return;
+
+    const auto hasItems = stack.back().hasItems;
+    stack.pop_back();
+
+    // an empty object is written with a line break, as DynamicObject::writeAsJSON() does
+    if (! allOnOneLine && (hasItems || isObject))
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, getIndent());
+    }
+
+    out << (isObject ? '}' : ']');
+}
+
+//==============================================================================
+JSONWriter& JSONWriter::startObject()
+{
+    startValue();
+    out << '{';
+    stack.push_back ({ true, false });
+    return *this;
+}
+
+JSONWriter& JSONWriter::endObject()
+{
+    endContainer (true);
+    return *this;
+}
+
+JSONWriter& JSONWriter::startArray()
+{
+    startValue();
+    out << '[';
+    stack.push_back ({ false, false });
+    return *this;
+}
+
+JSONWriter& JSONWriter::endArray()
+{
+    endContainer (false);
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeName (StringRef propertyName)
+{
+    // Names can only be written inside an object, and only once for each value!
+    jassert (! stack.empty() && stack.back().isObject && ! expectingPropertyValue);
+
+    if (! stack.empty())
+        startItem();
+
+    out << '"';
+    JSONFormatter::writeString (out, propertyName.text);
+    out << "\": ";
+
+    expectingPropertyValue = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeValue (const var& value)
+{
+    startValue();
+    JSONFormatter::write (out, value, getIndent(), allOnOneLine, maximumDecimalPlaces);
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeProperty (StringRef propertyName, const var& value)
+{
+    return writeName (propertyName).writeValue (value);
+}
+
+JSONWriter& JSONWriter::writeString (StringRef text)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, text.text);
+    out << '"';
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeInt (int64 value)
+{
+    startValue();
+    out << String (value);
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeDouble (double value)
+{
+    startValue();
+
+    if (juce_isfinite (value))
+    {
+        char buffer[NumberToStringConverters::charsNeededForDouble];
+        out.write (buffer, NumberToStringConverters::serialiseDouble (buffer, value));
+    }
+    else
+    {
+        out << "null";
+    }
+
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeBool (bool value)
+{
+    startValue();
+    out << (value ? "true" : "false");
+    return *this;
+}
+
+JSONWriter& JSONWriter::writeNull()
+{
+    startValue();
+    out << "null";
+    return *this;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONWriterTests  : public UnitTest
+{
+public:
+    JSONWriterTests()
+        : UnitTest ("JSONWriter", UnitTestCategories::json)
+    {}
+
+    static void writeEvents (JSONWriter& writer, const var& v)
+    {
+        if (auto* array = v.getArray())
+        {
+            writer.startArray();
+
+            for (auto& item : *array)
+                writeEvents (writer, item);
+
+            writer.endArray();
+        }
+        else if (auto* object = v.getDynamicObject())
+        {
+            writer.startObject();
+
+            for (auto& property : object->getProperties())
+            {
+                writer.writeName (property.name.toString());
+                writeEvents (writer, property.value);
+            }
+
+            writer.endObject();
+        }
+        else if (v.isString())                  writer.writeString (v.toString());
+        else if (v.isInt() || v.isInt64())      writer.writeInt ((int64) v);
+        else if (v.isDouble())                  writer.writeDouble ((double) v);
+        else if (v.isBool())                    writer.writeBool ((bool) v);
+        else                                    writer.writeNull();
+    }
+
+    void runTest() override
+    {
+        beginTest ("Output matches JSON::toString");
+        {
+            auto r = getRandom();
+
+            for (int i = 100; --i >= 0;)
+            {
+                const bool oneLine = r.nextBool();
+                auto v = JSONTests::createRandomVar (r, 0);
+                auto expected = JSON::toString (v, oneLine);
+
+                MemoryOutputStream events, values;
+
+                {
+                    JSONWriter writer (events, oneLine);
+                    writeEvents (writer, v);
+                }
+
+                {
+                    JSONWriter writer (values, oneLine);
+                    writer.writeValue (v);
+                }
+
+                expectEquals (events.toString(), expected);
+                expectEquals (values.toString(), expected);
+            }
+        }
+
+        beginTest ("Properties and several documents");
+        {
+            MemoryOutputStream out;
+
+            {
+                JSONWriter writer (out, true);
+                writer.startObject().writeProperty ("a", 1).writeName ("b").startArray().writeValue ("x").endArray().endObject();
+                writer.startObject().endObject();
+                expectEquals (writer.getDepth(), 0);
+            }
+
+            expectEquals (out.toString(), String ("{\"a\": 1, \"b\": [\"x\"]}") + newLine + "{}");
+        }
+    }
+};
+
+static JSONWriterTests jsonWriterTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes JSON to a stream one value at a time, without needing a var tree.
+
+    The text that's produced is the same as JSON::writeToStream() would write for the
+    equivalent var, but the document never has to exist in memory, e.g.
+
+    @code
+    JSONWriter writer (stream);
+
+    writer.startObject();
+    writer.writeProperty ("name", "test");
+    writer.writeName ("values");
+    writer.startArray();
+
+    for (auto v : values)
+        writer.writeValue (v);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    Inside an object, each value must be preceded by a call to writeName(). If more
+    than one top-level value is written, each one starts on a new line.
+
+    @see JSON, JSONReader
+
+    @tags{Core}
+*/
+class JUCE_API  JSONWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer for a stream, which must outlive the writer.
+
+        The allOnOneLine and maximumDecimalPlaces parameters have the same meaning
+        as they do for JSON::writeToStream().
+    */
+    explicit JSONWriter (OutputStream& destination,
+                         bool allOnOneLine = false,
+                         int maximumDecimalPlaces = 15);
+
+    /** Destructor.
+        All the objects and arrays that were started should have been ended by now.
+    */
+    ~JSONWriter();
+
+    //==============================================================================
+    /** Writes the '{' that starts an object. */
+    JSONWriter& startObject();
+
+    /** Writes the '}' that ends the current object. */
+    JSONWriter& endObject();
+
+    /** Writes the '[' that starts an array. */
+    JSONWriter& startArray();
+
+    /** Writes the ']' that ends the current array. */
+    JSONWriter& endArray();
+
+    /** Writes the name of the next property of the current object. */
+    JSONWriter& writeName (StringRef propertyName);
+
+    /** Writes a value. This can be a primitive, or an array or DynamicObject, which
+        will be written out in full.
+    */
+    JSONWriter& writeValue (const var& value);
+
+    /** A shortcut that calls writeName() followed by writeValue(). */
+    JSONWriter& writeProperty (StringRef propertyName, const var& value);
+
+    /** Writes a string value. */
+    JSONWriter& writeString (StringRef text);
+
+    /** Writes an integer value. */
+    JSONWriter& writeInt (int64 value);
+
+    /** Writes a floating-point value. Values that aren't finite are written as null. */
+    JSONWriter& writeDouble (double value);
+
+    /** Writes true or false. */
+    JSONWriter& writeBool (bool value);
+
+    /** Writes null. */
+    JSONWriter& writeNull();
+
+    //==============================================================================
+    /** Returns the number of objects and arrays that have been started but not ended. */
+    int getDepth() const noexcept                   { return (int) stack.size(); }
+
+private:
+    //==============================================================================
+    struct Frame
+    {
+        bool isObject, hasItems;
+    };
+
+    void startItem();
+    void startValue();
+    void endContainer (bool isObject);
+    int getIndent() const noexcept;
+
+    OutputStream& out;
+    const bool allOnOneLine;
+    const int maximumDecimalPlaces;
+    std::vector<Frame> stack;
+    bool expectingPropertyValue = false, hasWrittenTopLevelValue = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONWriter)
+};
+
+} // namespace juce
@@ -71,6 +71,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     }
 
     Time timeout;
+    int numChecksUntilTimeOut = 0;
 
     using Args = const var::NativeFunctionArgs&;
     using TokenType = const char*;
@@ -102,6 +103,51 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     static Identifier getPrototypeIdentifier()                { static const Identifier i ("prototype"); return i; }
     static var* getPropertyPointer (DynamicObject& o, const Identifier& i) noexcept   { return o.getProperties().getVarPointer (i); }
 
+    //==============================================================================
+    /*  An inline cache for looking up a property by name.
+
+        Each place in the code that looks up a property remembers the slot in which it
+        last found it. The objects that are used at a given place nearly always have the
+        same layout (even the fresh scope that's created for each function call), so the
+        slot can be checked first, and the linear search is only needed if it's wrong.
+    */
+    struct PropertyCache
+    {
+        var* find (DynamicObject& o, const Identifier& name) const noexcept
+        {
+            auto& props = o.getProperties();
+            const auto* items = props.begin();
+            const int size = props.size();
+
+            if (slot < size && items[slot].name == name)
+                return props.getVarPointerAt (slot);
+
+            for (int i = 0; i < size; ++i)
+            {
+                if (items[i].name == name)
+                {
+                    slot = i;
+                    return props.getVarPointerAt (i);
+                }
+            }
+
+            return nullptr;
+        }
+
+        mutable int slot = 0;
+    };
+
+    /*  Looking up an unqualified name checks each level of the scope chain in turn, so
+        this keeps a separate slot for the innermost few levels.
+    */
+    struct ScopeChainCache
+    {
+        const PropertyCache& getLevel (int depth) const noexcept    { return levels[jmin (depth, numLevels - 1)]; }
+
+        static constexpr int numLevels = 4;
+        PropertyCache levels[numLevels];
+    };
+
     //==============================================================================
     struct CodeLocation
     {
@@ -136,11 +182,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         ReferenceCountedObjectPtr<RootObject> root;
         DynamicObject::Ptr scope;
 
-        var findFunctionCall (const CodeLocation& location, const var& targetObject, const Identifier& functionName) const
+        var findFunctionCall (const CodeLocation& location, const var& targetObject, const Identifier& functionName,
+                              const PropertyCache& cache) const
         {
             if (auto* o = targetObject.getDynamicObject())
             {
-                if (auto* prop = getPropertyPointer (*o, functionName))
+                if (auto* prop = cache.find (*o, functionName))
                     return *prop;
 
                 for (auto* p = o->getProperty (getPrototypeIdentifier()).getDynamicObject(); p != nullptr;
@@ -187,6 +234,17 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                                      : var::undefined();
         }
 
+        var findSymbolInParentScopes (const Identifier& name, const ScopeChainCache& cache) const
+        {
+            int depth = 0;
+
+            for (auto* s = this; s != nullptr; s = s->parent, ++depth)
+                if (auto v = cache.getLevel (depth).find (*s->scope, name))
+                    return *v;
+
+            return var::undefined();
+        }
+
         bool findAndInvokeMethod (const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
         {
             auto* target = args.thisObject.getDynamicObject();
@@ -234,6 +292,13 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         void checkTimeOut (const CodeLocation& location) const
         {
+            // reading the clock costs more than a simple loop iteration, so it's only done
+            // every few checks, but a call to stop() is always noticed straight away
+            if (--(root->numChecksUntilTimeOut) > 0 && root->timeout != Time())
+                return;
+
+            root->numChecksUntilTimeOut = 32;
+
             if (Time::getCurrentTime() > root->timeout)
                 location.throwError (root->timeout == Time() ? "Interrupted" : "Execution timed-out");
         }
@@ -301,12 +366,19 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ResultCode perform (const Scope& s, var*) const override
         {
-            s.scope->setProperty (name, initialiser->getResult (s));
+            auto value = initialiser->getResult (s);
+
+            if (auto* v = cache.find (*s.scope, name))
+                *v = std::move (value);
+            else
+                s.scope->setProperty (name, std::move (value));
+
             return ok;
         }
 
         Identifier name;
         ExpPtr initialiser;
+        PropertyCache cache;
     };
 
     struct LoopStatement  : public Statement
@@ -375,17 +447,18 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     {
         UnqualifiedName (const CodeLocation& l, const Identifier& n) noexcept : Expression (l), name (n) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name, cache); }
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (auto* v = getPropertyPointer (*s.scope, name))
+            if (auto* v = cache.getLevel (0).find (*s.scope, name))
                 *v = newValue;
             else
                 s.root->setProperty (name, newValue);
         }
 
         Identifier name;
+        ScopeChainCache cache;
     };
 
     struct DotOperator  : public Expression
@@ -404,7 +477,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             }
 
             if (auto* o = p.getDynamicObject())
-                if (auto* v = getPropertyPointer (*o, child))
+                if (auto* v = cache.find (*o, child))
                     return *v;
 
             return var::undefined();
@@ -420,6 +493,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ExpPtr parent;
         Identifier child;
+        PropertyCache cache;
     };
 
     struct ArraySubscript  : public Expression
@@ -500,6 +574,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         {
             var a (lhs->getResult (s)), b (rhs->getResult (s));
 
+            if (a.isInt() && b.isInt())
+                return getWithInts (a, b);
+
             if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
                 return getWithUndefinedArg();
 
@@ -726,7 +803,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
             {
                 auto thisObject = dot->parent->getResult (s);
-                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child), thisObject);
+                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child, dot->cache), thisObject);
             }
 
             auto function = object->getResult (s);
@@ -736,12 +813,25 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var invokeFunction (const Scope& s, const var& function, const var& thisObject) const
         {
             s.checkTimeOut (location);
+
+            // most calls have only a few arguments, so this avoids allocating an array for them
+            constexpr int numLocalArgs = 6;
+            var localArgs[numLocalArgs];
             Array<var> argVars;
+            const int numArgs = arguments.size();
 
-            for (auto* a : arguments)
-                argVars.add (a->getResult (s));
+            if (numArgs <= numLocalArgs)
+            {
+                for (int i = 0; i < numArgs; ++i)
+                    localArgs[i] = arguments.getUnchecked (i)->getResult (s);
+            }
+            else
+            {
+                for (auto* a : arguments)
+                    argVars.add (a->getResult (s));
+            }
 
-            const var::NativeFunctionArgs args (thisObject, argVars.begin(), argVars.size());
+            const var::NativeFunctionArgs args (thisObject, numArgs <= numLocalArgs ? localArgs : argVars.begin(), numArgs);
 
             if (var::NativeFunction nativeFunction = function.getNativeFunction())
                 return nativeFunction (args);
@@ -792,8 +882,10 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         {
             DynamicObject::Ptr newObject (new DynamicObject());
 
+            auto& properties = newObject->getProperties();
+
             for (int i = 0; i < names.size(); ++i)
-                newObject->setProperty (names.getUnchecked(i), initialisers.getUnchecked(i)->getResult (s));
+                properties.set (names.getUnchecked(i), initialisers.getUnchecked(i)->getResult (s));
 
             return newObject.get();
         }
@@ -809,6 +901,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var getResult (const Scope& s) const override
         {
             Array<var> a;
+            a.ensureStorageAllocated (values.size());
 
             for (int i = 0; i < values.size(); ++i)
                 a.add (values.getUnchecked(i)->getResult (s));
@@ -1618,7 +1711,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 itemsRemoved.ensureStorageAllocated (num);
 
                 for (int i = 0; i < num; ++i)
-                    itemsRemoved.add (array->getReference (start + i));
+                    itemsRemoved.add (std::move (array->getReference (start + i)));
 
                 array->removeRange (start, num);
 
@@ -1916,4 +2009,134 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptEngineTests  : public UnitTest
+{
+public:
+    JavascriptEngineTests()
+        : UnitTest ("JavascriptEngine", UnitTestCategories::javascript)
+    {}
+
+    var run (JavascriptEngine& engine, const String& code)
+    {
+        auto result = engine.execute (code);
+        expect (result.wasOk(), result.getErrorMessage());
+        return engine.evaluate ("result");
+    }
+
+    var run (const String& code)
+    {
+        JavascriptEngine engine;
+        return run (engine, code);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Property access on objects with different layouts");
+        {
+            expectEquals ((int) run ("function getX (o) { return o.x; }"
+                                     "var a = { x: 1, y: 2 }, b = { y: 3, z: 4, x: 5 }, c = { y: 6 };"
+                                     "var result = 0;"
+                                     "for (var i = 0; i < 10; ++i) result += getX (a) + getX (b) * 10 + (getX (c) === undefined ? 100 : 0);"),
+                          1510);
+
+            expectEquals ((int) run ("var o = { a: 1, b: 2 }; var result = 0;"
+                                     "for (var i = 0; i < 4; ++i) { result += o.b; o = (i % 2 == 0) ? { b: 10 } : { a: 1, c: 3, b: 100 }; }"),
+                          122);
+        }
+
+        beginTest ("Name lookup through scopes");
+        {
+            expectEquals (run ("var v = 'global';"
+                               "function local()  { var v = 'local'; return v; }"
+                               "function global() { return v; }"
+                               "function maybe (c) { if (c) var w = 'local'; return w; }"
+                               "var result = '';"
+                               "for (var i = 0; i < 3; ++i) result += local() + global() + maybe (i == 1) + ',';").toString(),
+                          String ("localglobalundefined,localgloballocal,localglobalundefined,"));
+
+            expectEquals ((int) run ("var counter = 0; function inc() { counter = counter + 1; }"
+                                     "for (var i = 0; i < 50; ++i) inc(); var result = counter;"),
+                          50);
+        }
+
+        beginTest ("Method calls");
+        {
+            expectEquals ((int) run ("var p = { v: 0, add: function (d) { this.v += d; } };"
+                                     "var q = { w: 0, v: 1000, add: function (d) { this.v -= d; } };"
+                                     "for (var i = 0; i < 10; ++i) { p.add (i); q.add (1); }"
+                                     "var result = p.v + q.v;"),
+                          45 + 990);
+
+            expectEquals ((int) run ("function sum (a, b, c, d, e, f, g, h) { return a + b + c + d + e + f + g + h; }"
+                                     "var result = sum (1, 2, 3, 4, 5, 6, 7, 8);"),
+                          36);
+
+            expectEquals (run ("function third (a, b, c) { return typeof c; } var result = third (1, 2);").toString(),
+                          String ("undefined"));
+        }
+
+        beginTest ("Arrays are shared by reference");
+        {
+            expectEquals ((int) run ("var a = [1, 2, 3]; var b = a; b.push (4); var result = a.length;"), 4);
+
+            expectEquals (run ("var a = [1, 2, 3, 4, 5]; var removed = a.splice (1, 2, \"x\");"
+                               "var result = removed.join (\",\") + \"|\" + a.join (\",\");").toString(),
+                          String ("2,3|1,x,4,5"));
+
+            expectEquals ((int) run ("var o = { list: [1, 2] }; var l = o.list; l.push (3); var result = o.list.length;"), 3);
+        }
+
+        beginTest ("Timeouts");
+        {
+            JavascriptEngine engine;
+            engine.maximumExecutionTime = RelativeTime::milliseconds (50);
+
+            auto result = engine.execute ("var i = 0; while (true) ++i;");
+            expect (result.failed());
+            expect (result.getErrorMessage().contains ("timed-out"));
+        }
+
+        beginTest ("Benchmarks");
+        {
+            struct Benchmark
+            {
+                const char* name;
+                const char* code;
+                double expectedResult;
+            };
+
+            const Benchmark benchmarks[] =
+            {
+                { "Loop",             "var result = 0; for (var i = 0; i < 200000; ++i) result += i % 7;",                                      599994 },
+                { "Function calls",   "function f (a, b) { return a + b; } var result = 0; for (var i = 0; i < 50000; ++i) result = f (result, 1);", 50000 },
+                { "Property access",  "var o = { x: 1, y: 2, z: 3 }; var result = 0; for (var i = 0; i < 50000; ++i) { o.x = o.y + o.z; result += o.x; }", 250000 },
+                { "Array access",     "var a = []; for (var i = 0; i < 1000; ++i) a.push (i); var result = 0;"
+                                      "for (var j = 0; j < 50; ++j) for (var i = 0; i < 1000; ++i) result += a[i];",                          24975000 },
+                { "Function locals",  "function g (n) { var s = 0; for (var i = 0; i < n; ++i) { var t = i * 2; s += t; } return s; }"
+                                      "var result = g (100000);",                                                                              9999900000.0 },
+                { "Method calls",     "var p = { v: 0, inc: function (d) { this.v += d; } }; for (var i = 0; i < 50000; ++i) p.inc (1); var result = p.v;", 50000 }
+            };
+
+            for (auto& b : benchmarks)
+            {
+                JavascriptEngine engine;
+                const auto start = Time::getMillisecondCounterHiRes();
+                const auto result = (double) run (engine, b.code);
+                const auto elapsed = Time::getMillisecondCounterHiRes() - start;
+
+                expectEquals (result, b.expectedResult);
+                logMessage (String (b.name).paddedRight (' ', 20) + String (elapsed, 1) + " ms");
+            }
+        }
+    }
+};
+
+static JavascriptEngineTests javascriptEngineTests;
+
+#endif
+
 } // namespace juce
@@ -142,19 +142,23 @@
 #include "maths/juce_Random.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "memory/juce_AllocationHooks.cpp"
+#include "memory/juce_ScratchArena.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
 #include "misc/juce_ConsoleApplication.cpp"
 #include "network/juce_MACAddress.cpp"
 #include "network/juce_NamedPipe.cpp"
+#include "network/juce_SharedMemoryPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketIOService.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
 #include "streams/juce_InputStream.cpp"
 #include "streams/juce_MemoryInputStream.cpp"
 #include "streams/juce_MemoryOutputStream.cpp"
+#include "streams/juce_SegmentedMemoryOutputStream.cpp"
 #include "streams/juce_SubregionStream.cpp"
 #include "system/juce_SystemStats.cpp"
 #include "text/juce_CharacterFunctions.cpp"
@@ -167,22 +171,37 @@
 #include "text/juce_StringPool.cpp"
 #include "text/juce_TextDiff.cpp"
 #include "text/juce_Base64.cpp"
+#include "text/juce_StringBuilder.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_WorkStealingThreadPool.cpp"
+#include "threads/juce_ReadCopyUpdatePointer.cpp"
+#include "threads/juce_RealtimeSafety.cpp"
+#include "files/juce_ParallelDirectoryScanner.cpp"
+#include "files/juce_FileIOService.cpp"
+#include "logging/juce_AsyncFileLogger.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
+#include "time/juce_TraceRecorder.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
+#include "javascript/juce_JSONReader.cpp"
+#include "javascript/juce_JSONWriter.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlPullParser.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
+#include "zip/juce_LZ4CompressorOutputStream.cpp"
+#include "zip/juce_LZ4DecompressorInputStream.cpp"
+#include "zip/juce_ZstdCompressorOutputStream.cpp"
+#include "zip/juce_ZstdDecompressorInputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
 #include "files/juce_FileFilter.cpp"
 #include "files/juce_WildcardFileFilter.cpp"
@@ -226,6 +245,7 @@
   #include "native/juce_intel_SharedCode.h"
  #endif
  #include "native/juce_linux_SystemStats.cpp"
+ #include "native/juce_linux_CpuTopology.cpp"
  #include "native/juce_linux_Threads.cpp"
 
 //==============================================================================
@@ -236,6 +256,7 @@
  #include "native/juce_android_Misc.cpp"
  #include "native/juce_android_Network.cpp"
  #include "native/juce_android_SystemStats.cpp"
+ #include "native/juce_linux_CpuTopology.cpp"
  #include "native/juce_android_Threads.cpp"
  #include "native/juce_android_RuntimePermissions.cpp"
 
@@ -253,7 +274,9 @@
 
 #if ! JUCE_WASM
  #include "threads/juce_ChildProcess.cpp"
+ #include "threads/juce_ChildProcessMonitor.cpp"
  #include "network/juce_WebInputStream.cpp"
+ #include "network/juce_HTTPClient.cpp"
  #include "streams/juce_URLInputSource.cpp"
 #endif
 
@@ -261,7 +284,19 @@
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
 
+ #include "containers/juce_FlatHashMap_test.cpp"
+
  #include "containers/juce_Optional_test.cpp"
+
+ #include "containers/juce_LockFreeQueues_test.cpp"
+
+ #include "threads/juce_ReadCopyUpdatePointer_test.cpp"
+
+ #include "containers/juce_RealtimeListenerList_test.cpp"
+
+ #include "containers/juce_NamedValueSet_test.cpp"
+
+ #include "containers/juce_SortedSet_test.cpp"
 #endif
 
 //==============================================================================
@@ -131,6 +131,22 @@
  #define JUCE_ZLIB_INCLUDE_PATH <zlib.h>
 #endif
 
+/** Config: JUCE_USE_ZSTD
+    Enables the ZstdCompressorOutputStream and ZstdDecompressorInputStream classes, and lets
+    ZipFile read and write zstd-compressed entries. The zstd library isn't included with JUCE,
+    so if you enable this, you'll need to make its headers available and link to libzstd.
+
+    If the header isn't on your include path, you can set JUCE_ZSTD_INCLUDE_PATH to
+    specify where it lives.
+*/
+#ifndef JUCE_USE_ZSTD
+ #define JUCE_USE_ZSTD 0
+#endif
+
+#ifndef JUCE_ZSTD_INCLUDE_PATH
+ #define JUCE_ZSTD_INCLUDE_PATH <zstd.h>
+#endif
+
 /** Config: JUCE_USE_CURL
     Enables http/https support via libcurl (Linux only). Enabling this will add an additional
     run-time dynamic dependency to libcurl.
@@ -186,6 +202,26 @@
  #define JUCE_ENABLE_ALLOCATION_HOOKS 0
 #endif
 
+/** Config: JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+    If enabled, calls to operator new and delete, CriticalSection::enter(), WaitableEvent::wait()
+    and Thread::sleep() that happen inside a RealtimeSafety::ScopedRealtimeSection will be
+    reported, along with a stack trace. This replaces the global allocation functions, so is
+    intended for debug builds.
+*/
+#ifndef JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+ #define JUCE_ENABLE_REALTIME_SAFETY_CHECKS 0
+#endif
+
+/** Config: JUCE_ENABLE_TRACING
+    If enabled, the JUCE_TRACE_ZONE, JUCE_TRACE_COUNTER and JUCE_TRACE_INSTANT macros will
+    record events with the TraceRecorder while it's running, including the ones that JUCE
+    places around painting, message dispatch, timer callbacks and audio graph rendering.
+    If disabled, the macros compile to nothing.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
 #endif
@@ -275,6 +311,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_TextDiff.h"
 #include "text/juce_LocalisedStrings.h"
 #include "text/juce_Base64.h"
+#include "text/juce_StringBuilder.h"
 #include "misc/juce_Functional.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
@@ -283,6 +320,8 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_NamedValueSet.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
+#include "containers/juce_LockFreeQueues.h"
 #include "time/juce_RelativeTime.h"
 #include "time/juce_Time.h"
 #include "streams/juce_InputStream.h"
@@ -290,6 +329,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "streams/juce_BufferedInputStream.h"
 #include "streams/juce_MemoryInputStream.h"
 #include "streams/juce_MemoryOutputStream.h"
+#include "streams/juce_SegmentedMemoryOutputStream.h"
 #include "streams/juce_SubregionStream.h"
 #include "streams/juce_InputSource.h"
 #include "files/juce_File.h"
@@ -305,6 +345,8 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
 #include "javascript/juce_JSON.h"
+#include "javascript/juce_JSONReader.h"
+#include "javascript/juce_JSONWriter.h"
 #include "javascript/juce_Javascript.h"
 #include "maths/juce_BigInteger.h"
 #include "maths/juce_Expression.h"
@@ -312,6 +354,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "misc/juce_RuntimePermissions.h"
 #include "misc/juce_WindowsRegistry.h"
 #include "threads/juce_ChildProcess.h"
+#include "threads/juce_ChildProcessMonitor.h"
 #include "threads/juce_DynamicLibrary.h"
 #include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_InterProcessLock.h"
@@ -321,28 +364,45 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_Thread.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_WorkStealingThreadPool.h"
+#include "files/juce_ParallelDirectoryScanner.h"
+#include "files/juce_FileIOService.h"
+#include "logging/juce_AsyncFileLogger.h"
 #include "threads/juce_TimeSliceThread.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
+#include "threads/juce_ReadCopyUpdatePointer.h"
+#include "threads/juce_RealtimeSafety.h"
+#include "containers/juce_RealtimeListenerList.h"
 #include "network/juce_IPAddress.h"
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
+#include "network/juce_SharedMemoryPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketIOService.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
+#include "network/juce_HTTPClient.h"
 #include "streams/juce_URLInputSource.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_TraceRecorder.h"
 #include "unit_tests/juce_UnitTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlPullParser.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
+#include "zip/juce_LZ4CompressorOutputStream.h"
+#include "zip/juce_LZ4DecompressorInputStream.h"
+#include "zip/juce_ZstdCompressorOutputStream.h"
+#include "zip/juce_ZstdDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
 #include "memory/juce_AllocationHooks.h"
 #include "memory/juce_Reservoir.h"
+#include "memory/juce_ScratchArena.h"
 #include "files/juce_AndroidDocument.h"
 #include "streams/juce_AndroidDocumentInputSource.h"
 
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AsyncFileLogger::AsyncFileLogger (const File& file, const Options& optionsToUse)
+    : Thread ("Log writer"),
+      logFile (file),
+      options (optionsToUse),
+      queue (jmax (2, optionsToUse.queueSize))
+{
+    if (! logFile.exists())
+        logFile.create();  // (to create the parent directories)
+
+    if (options.welcomeMessage.isNotEmpty())
+    {
+        String welcome;
+        welcome << newLine
+                << "**********************************************************" << newLine
+                << options.welcomeMessage << newLine
+                << "Log started: " << Time::getCurrentTime().toString (true, true);
+
+        logMessage (welcome);
+    }
+
+    startThread (Priority::low);
+}
+
+AsyncFileLogger::AsyncFileLogger (const File& file)
+    : AsyncFileLogger (file, Options{})
+{
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    stopThread (-1);
+    writePendingMessages();
+}
+
+File AsyncFileLogger::getRotatedLogFile (int index) const
+{
+    return logFile.getSiblingFile (logFile.getFileNameWithoutExtension() + "." + String (index) + logFile.getFileExtension());
+}
+
+//==============================================================================
+void AsyncFileLogger::logMessage (const String& message)
+{
+    const auto numBytes = message.getNumBytesAsUTF8();
+
+    const auto pushed = numBytes <= (size_t) maxRealtimeMessageLength
+                          ? pushRecord ([&] (char* dest, size_t)
+                                        {
+                                            memcpy (dest, message.toRawUTF8(), numBytes);
+                                            return (int) numBytes;
+                                        })
+                          : recordPushed (queue.emplace (message));
+
+    if (pushed && queue.getNumReady() > queue.getCapacity() / 2)
+        notify();
+}
+
+bool AsyncFileLogger::logRealtime (const char* message) noexcept
+{
+    return pushRecord ([message] (char* dest, size_t destSize)
+    {
+        size_t length = 0;
+
+        if (message != nullptr)
+        {
+            for (; length < destSize - 1 && message[length] != 0; ++length)
+                dest[length] = message[length];
+        }
+
+        return (int) length;
+    });
+}
+
+bool AsyncFileLogger::recordPushed (bool wasPushed) noexcept
+{
+    if (wasPushed)
+    {
+        ++numPushed;
+        return true;
+    }
+
+    ++numDroppedSinceLastWrite;
+    ++totalNumDropped;
+    return false;
+}
+
+void AsyncFileLogger::flush()
+{
+    const auto target = numPushed.load();
+
+    if (isThreadRunning())
+    {
+        notify();
+
+        std::unique_lock ul (flushMutex);
+        flushCondition.wait (ul, [&] { return numWritten >= target || ! isThreadRunning(); });
+    }
+}
+
+//==============================================================================
+void AsyncFileLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (options.flushIntervalMs);
+
+        if (writePendingMessages())
+        {
+            const std::scoped_lock sl (flushMutex);
+            flushCondition.notify_all();
+        }
+    }
+}
+
+bool AsyncFileLogger::writePendingMessages()
+{
+    int64 numPopped = 0;
+
+    for (;;)
+    {
+        const auto numInBatch = queue.popAll ([this] (Record& r)
+        {
+            if (r.longMessage.isNotEmpty())
+                batch << r.longMessage;
+            else
+                batch.write (r.text, r.length);
+
+            batch << newLine;
+        });
+
+        if (numInBatch == 0)
+            break;
+
+        numPopped += numInBatch;
+    }
+
+    if (const auto numDropped = numDroppedSinceLastWrite.exchange (0); numDropped > 0)
+        batch << "(" << numDropped << " log messages were dropped because the queue was full)" << newLine;
+
+    if (batch.getDataSize() > 0)
+    {
+        writeToFile (batch);
+        batch.reset();
+    }
+
+    numWritten += numPopped;
+    return numPopped > 0;
+}
+
+void AsyncFileLogger::writeToFile (const MemoryOutputStream& data)
+{
+    if (stream != nullptr && options.maxFileSize > 0
+         && stream->getPosition() > 0
+         && stream->getPosition() + (int64) data.getDataSize() > options.maxFileSize)
+    {
+        rotate();
+    }
+
+    if (stream == nullptr)
+    {
+        stream = std::make_unique<FileOutputStream> (logFile, 0);
+
+        if (stream->failedToOpen())
+        {
+            stream.reset();
+            return;
+        }
+    }
+
+    stream->write (data.getData(), data.getDataSize());
+    stream->flush();
+}
+
+void AsyncFileLogger::rotate()
+{
+    stream.reset();
+
+    if (options.maxNumRotatedFiles <= 0)
+    {
+        logFile.deleteFile();
+        return;
+    }
+
+    getRotatedLogFile (options.maxNumRotatedFiles).deleteFile();
+
+    for (int i = options.maxNumRotatedFiles; --i > 0;)
+        getRotatedLogFile (i).moveFileTo (getRotatedLogFile (i + 1));
+
+    logFile.moveFileTo (getRotatedLogFile (1));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncFileLoggerTests  : public UnitTest
+{
+public:
+    AsyncFileLoggerTests()
+        : UnitTest ("AsyncFileLogger", UnitTestCategories::files)
+    {}
+
+    static StringArray readLines (const File& file)
+    {
+        StringArray lines;
+        lines.addLines (file.loadFileAsString());
+        lines.removeEmptyStrings();
+        return lines;
+    }
+
+    void runTest() override
+    {
+        const TemporaryFile temp (".log");
+        const auto& file = temp.getFile();
+
+        beginTest ("Messages from several threads");
+        {
+            constexpr int numThreads = 4, numMessagesPerThread = 500;
+
+            {
+                AsyncFileLogger logger (file, AsyncFileLogger::Options{}.withQueueSize (numThreads * numMessagesPerThread));
+                std::vector<std::thread> threads;
+
+                for (int t = 0; t < numThreads; ++t)
+                {
+                    threads.emplace_back ([&logger, t]
+                    {
+                        for (int i = 0; i < numMessagesPerThread; ++i)
+                        {
+                            if ((i & 1) == 0)
+                                logger.logMessage ("thread " + String (t) + " message " + String (i));
+                            else
+                                logger.logRealtimeFormatted ("thread %d message %d", t, i);
+                        }
+                    });
+                }
+
+                for (auto& th : threads)
+                    th.join();
+
+                logger.flush();
+                expectEquals (readLines (file).size(), numThreads * numMessagesPerThread);
+                expectEquals (logger.getNumDroppedMessages(), (int64) 0);
+            }
+
+            const auto lines = readLines (file);
+            expectEquals (lines.size(), numThreads * numMessagesPerThread);
+
+            // Each thread's messages must be in the order it logged them
+            for (int t = 0; t < numThreads; ++t)
+            {
+                int next = 0;
+
+                for (auto& line : lines)
+                    if (line.startsWith ("thread " + String (t) + " "))
+                        expectEquals (line.fromLastOccurrenceOf (" ", false, false).getIntValue(), next++);
+
+                expectEquals (next, numMessagesPerThread);
+            }
+        }
+
+        beginTest ("Long and truncated messages");
+        {
+            file.deleteFile();
+            const auto longMessage = String::repeatedString ("abcdefghij", 100);
+
+            {
+                AsyncFileLogger logger (file);
+                logger.logMessage (longMessage);
+                logger.logRealtime (longMessage.toRawUTF8());
+            }
+
+            const auto lines = readLines (file);
+            expectEquals (lines.size(), 2);
+            expectEquals (lines[0], longMessage);
+            expectEquals (lines[1], longMessage.substring (0, AsyncFileLogger::maxRealtimeMessageLength));
+        }
+
+        beginTest ("Dropped messages");
+        {
+            file.deleteFile();
+
+            {
+                AsyncFileLogger logger (file, AsyncFileLogger::Options{}.withQueueSize (4).withFlushInterval (10000));
+
+                int numDropped = 0;
+
+                for (int i = 0; i < 10; ++i)
+                    if (! logger.logRealtime ("message"))
+                        ++numDropped;
+
+                expectEquals (logger.getNumDroppedMessages(), (int64) numDropped);
+                expect (numDropped > 0);
+            }
+
+            expect (file.loadFileAsString().contains ("log messages were dropped"));
+        }
+
+        beginTest ("Rotation");
+        {
+            file.deleteFile();
+
+            {
+                AsyncFileLogger logger (file, AsyncFileLogger::Options{}.withMaxFileSize (100).withMaxNumRotatedFiles (2));
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    logger.logMessage (String::repeatedString ("x", 40) + String (i));
+                    logger.flush();
+                }
+
+                expect (logger.getRotatedLogFile (1).existsAsFile());
+                expect (logger.getRotatedLogFile (2).existsAsFile());
+                expect (! logger.getRotatedLogFile (3).exists());
+
+                for (auto& f : { file, logger.getRotatedLogFile (1), logger.getRotatedLogFile (2) })
+                    expect (f.getSize() <= 100);
+
+                expect (file.loadFileAsString().contains ("x9"));
+                expect (logger.getRotatedLogFile (1).loadFileAsString().contains ("x7"));
+
+                logger.getRotatedLogFile (1).deleteFile();
+                logger.getRotatedLogFile (2).deleteFile();
+            }
+        }
+    }
+};
+
+static AsyncFileLoggerTests asyncFileLoggerTests;
+
+#endif
+
+} // namespace juce
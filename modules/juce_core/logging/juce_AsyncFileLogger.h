@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A Logger that writes to a file on a background thread.
+
+    A FileLogger opens and writes to its file on the thread that logs each message,
+    holding a lock while it does so. This logger instead copies each message into a
+    lock-free queue and returns straight away. A background thread takes messages from
+    the queue in batches and appends them to the file, so threads that log don't have
+    to wait for the disk or for each other.
+
+    The log can also be rotated: when the file grows beyond a given size, it's renamed
+    (e.g. "MyApp.1.log"), older files are shuffled along, and a new file is started.
+
+    As well as the usual logMessage(), there's a real-time-safe subset of methods that
+    can be called from an audio thread. These never allocate, lock or make system calls:
+    the text is copied into a fixed-size record that was allocated up front. If the
+    queue is full, the message is dropped, and a note of how many were lost is written
+    to the log later.
+
+    @code
+    AsyncFileLogger logger (logFile, AsyncFileLogger::Options{}.withMaxFileSize (1024 * 1024)
+                                                               .withMaxNumRotatedFiles (5));
+    Logger::setCurrentLogger (&logger);
+
+    // on the audio thread..
+    logger.logRealtimeFormatted ("buffer underrun at sample %lld", (long long) samplePosition);
+    @endcode
+
+    @see FileLogger, Logger
+
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileLogger  : public Logger,
+                                   private Thread
+{
+public:
+    //==============================================================================
+    /** The longest message, in bytes of UTF-8, that the real-time methods can log.
+        Longer messages are truncated.
+    */
+    static constexpr int maxRealtimeMessageLength = 240;
+
+    /** Settings for an AsyncFileLogger. */
+    struct JUCE_API  Options
+    {
+        /** The number of messages that can be waiting to be written at once. */
+        [[nodiscard]] auto withQueueSize (int x) const                      { return with (&Options::queueSize, x); }
+
+        /** If this is greater than zero, the file is rotated whenever writing to it would
+            make it larger than this number of bytes.
+        */
+        [[nodiscard]] auto withMaxFileSize (int64 x) const                  { return with (&Options::maxFileSize, x); }
+
+        /** The number of old log files to keep when the log is rotated. */
+        [[nodiscard]] auto withMaxNumRotatedFiles (int x) const             { return with (&Options::maxNumRotatedFiles, x); }
+
+        /** The longest time that a message can wait before being written to the file. */
+        [[nodiscard]] auto withFlushInterval (int milliseconds) const       { return with (&Options::flushIntervalMs, milliseconds); }
+
+        /** If this isn't empty, a header is written to the log with this message and the
+            current time when the logger is created, in the same way as a FileLogger.
+        */
+        [[nodiscard]] auto withWelcomeMessage (String x) const              { return with (&Options::welcomeMessage, std::move (x)); }
+
+        int queueSize = 4096;
+        int64 maxFileSize = -1;
+        int maxNumRotatedFiles = 3;
+        int flushIntervalMs = 100;
+        String welcomeMessage;
+
+    private:
+        template <typename Member, typename Item>
+        Options with (Member&& member, Item&& item) const
+        {
+            auto copy = *this;
+            copy.*member = std::forward<Item> (item);
+            return copy;
+        }
+    };
+
+    //==============================================================================
+    /** Creates a logger that appends to the given file.
+
+        The file and any parent directories that are needed will be created if they
+        don't exist.
+    */
+    AsyncFileLogger (const File& fileToWriteTo, const Options& options);
+
+    /** Creates a logger that appends to the given file, using the default Options. */
+    explicit AsyncFileLogger (const File& fileToWriteTo);
+
+    /** Destructor.
+        Any messages that are still waiting are written to the file before this returns.
+    */
+    ~AsyncFileLogger() override;
+
+    //==============================================================================
+    /** Returns the file that this logger is writing to. */
+    const File& getLogFile() const noexcept                 { return logFile; }
+
+    /** Returns the file that an older part of the log is moved to when it's rotated.
+        An index of 1 is the most recent.
+    */
+    File getRotatedLogFile (int index) const;
+
+    //==============================================================================
+    /** Adds a message to the log. This can be called from any thread.
+
+        It doesn't wait for any locks or for the file, but it may allocate memory for
+        a long message, so use logRealtime() on an audio thread.
+    */
+    void logMessage (const String& message) override;
+
+    /** Adds a message to the log without allocating, locking or making any system calls.
+
+        This is safe to call from a real-time thread. Messages longer than
+        maxRealtimeMessageLength are truncated.
+
+        @returns false if the queue was full, and the message was dropped
+    */
+    bool logRealtime (const char* message) noexcept;
+
+    /** Formats a message with snprintf and adds it to the log.
+
+        This is safe to call from a real-time thread, as long as the arguments are plain
+        numbers and C strings. Messages longer than maxRealtimeMessageLength are truncated.
+
+        @returns false if the queue was full, and the message was dropped
+    */
+    template <typename... Args>
+    bool logRealtimeFormatted (const char* format, Args... args) noexcept
+    {
+        return pushRecord ([&] (char* dest, size_t destSize)
+        {
+            return std::snprintf (dest, destSize, format, args...);
+        });
+    }
+
+    //==============================================================================
+    /** Waits until all the messages that have been logged so far have been written
+        to the file.
+    */
+    void flush();
+
+    /** Returns the total number of messages that have been dropped because the queue
+        was full.
+    */
+    int64 getNumDroppedMessages() const noexcept            { return totalNumDropped; }
+
+private:
+    //==============================================================================
+    /*  Short messages are written straight into the record while it's in the queue,
+        so that the real-time methods don't need to allocate anything.
+    */
+    struct Record
+    {
+        explicit Record (String message) noexcept  : longMessage (std::move (message)) {}
+
+        template <typename WriteFn>
+        Record (WriteFn&& writeFn, std::true_type) noexcept
+        {
+            const auto result = writeFn (text, sizeof (text));
+            length = result > 0 ? jmin ((size_t) result, sizeof (text) - 1) : 0;
+        }
+
+        String longMessage;
+        size_t length = 0;
+        char text[maxRealtimeMessageLength + 1];
+    };
+
+    template <typename WriteFn>
+    bool pushRecord (WriteFn&& writeFn) noexcept
+    {
+        return recordPushed (queue.emplace (writeFn, std::true_type()));
+    }
+
+    bool recordPushed (bool wasPushed) noexcept;
+
+    void run() override;
+    bool writePendingMessages();
+    void writeToFile (const MemoryOutputStream&);
+    void rotate();
+
+    File logFile;
+    const Options options;
+    MPSCQueue<Record> queue;
+    std::atomic<int64> numPushed { 0 }, numWritten { 0 }, totalNumDropped { 0 };
+    std::atomic<int> numDroppedSinceLastWrite { 0 };
+
+    std::unique_ptr<FileOutputStream> stream;
+    MemoryOutputStream batch;
+
+    std::mutex flushMutex;
+    std::condition_variable flushCondition;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileLogger)
+};
+
+} // namespace juce
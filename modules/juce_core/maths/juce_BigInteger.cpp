@@ -50,6 +50,494 @@ int findHighestSetBit (uint32 n) noexcept
   #endif
 }
 
+namespace BigIntegerHelpers
+{
+    //==============================================================================
+    // Arithmetic on little-endian arrays of 32-bit words
+
+    static uint32 addInPlace (uint32* dest, size_t numDest, const uint32* src, size_t numSrc) noexcept
+    {
+        jassert (numDest >= numSrc);
+        uint64 carry = 0;
+        size_t i = 0;
+
+        for (; i < numSrc; ++i)
+        {
+            carry += (uint64) dest[i] + src[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        for (; carry != 0 && i < numDest; ++i)
+        {
+            carry += dest[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        return (uint32) carry;
+    }
+
+    // dest must be at least as large as src
+    static void subtractInPlace (uint32* dest, size_t numDest, const uint32* src, size_t numSrc) noexcept
+    {
+        jassert (numDest >= numSrc);
+        uint64 borrow = 0;
+        size_t i = 0;
+
+        for (; i < numSrc; ++i)
+        {
+            auto diff = (uint64) dest[i] - src[i] - borrow;
+            dest[i] = (uint32) diff;
+            borrow = diff >> 63;
+        }
+
+        for (; borrow != 0 && i < numDest; ++i)
+        {
+            auto diff = (uint64) dest[i] - borrow;
+            dest[i] = (uint32) diff;
+            borrow = diff >> 63;
+        }
+
+        jassert (borrow == 0);
+    }
+
+    static void multiplySchoolbook (uint32* result, const uint32* a, size_t numA, const uint32* b, size_t numB) noexcept
+    {
+        std::fill (result, result + numA + numB, 0u);
+
+        for (size_t i = 0; i < numB; ++i)
+        {
+            uint64 carry = 0;
+            const auto bi = (uint64) b[i];
+
+            for (size_t j = 0; j < numA; ++j)
+            {
+                carry += result[i + j] + a[j] * bi;
+                result[i + j] = (uint32) carry;
+                carry >>= 32;
+            }
+
+            result[i + numA] = (uint32) carry;
+        }
+    }
+
+    // Below this many words, the schoolbook method beats Karatsuba's extra additions
+    constexpr size_t karatsubaThreshold = 32;
+
+    // result must have room for numA + numB words
+    static void multiply (uint32* result, const uint32* a, size_t numA, const uint32* b, size_t numB)
+    {
+        if (numA < numB)
+        {
+            std::swap (a, b);
+            std::swap (numA, numB);
+        }
+
+        if (numB < karatsubaThreshold)
+            return multiplySchoolbook (result, a, numA, b, numB);
+
+        if (numA >= 2 * numB)
+        {
+            // Very different sizes, so multiply b by one numB-sized piece of a at a time
+            std::fill (result, result + numA + numB, 0u);
+            std::vector<uint32> partial (2 * numB);
+
+            for (size_t offset = 0; offset < numA; offset += numB)
+            {
+                auto numInPiece = jmin (numB, numA - offset);
+                multiply (partial.data(), a + offset, numInPiece, b, numB);
+                addInPlace (result + offset, numA + numB - offset, partial.data(), numInPiece + numB);
+            }
+
+            return;
+        }
+
+        // Karatsuba: with a = a1.B + a0 and b = b1.B + b0,
+        // a.b = a1.b1.B^2 + ((a0 + a1)(b0 + b1) - a0.b0 - a1.b1).B + a0.b0
+        const auto half = numA / 2;
+        const auto numA1 = numA - half, numB1 = numB - half;
+
+        std::vector<uint32> low (2 * half), high (numA1 + numB1);
+        multiply (low.data(), a, half, b, half);
+        multiply (high.data(), a + half, numA1, b + half, numB1);
+
+        std::vector<uint32> sumA (numA1 + 1), sumB (jmax (half, numB1) + 1);
+        std::copy (a + half, a + numA, sumA.begin());
+        addInPlace (sumA.data(), sumA.size(), a, half);
+
+        if (numB1 >= half)
+        {
+            std::copy (b + half, b + numB, sumB.begin());
+            addInPlace (sumB.data(), sumB.size(), b, half);
+        }
+        else
+        {
+            std::copy (b, b + half, sumB.begin());
+            addInPlace (sumB.data(), sumB.size(), b + half, numB1);
+        }
+
+        std::vector<uint32> middle (sumA.size() + sumB.size());
+        multiply (middle.data(), sumA.data(), sumA.size(), sumB.data(), sumB.size());
+        subtractInPlace (middle.data(), middle.size(), low.data(), low.size());
+        subtractInPlace (middle.data(), middle.size(), high.data(), high.size());
+
+        auto numMiddle = middle.size();
+
+        while (numMiddle > 0 && middle[numMiddle - 1] == 0)
+            --numMiddle;
+
+        std::copy (low.begin(), low.end(), result);
+        std::copy (high.begin(), high.end(), result + low.size());
+        addInPlace (result + half, numA + numB - half, middle.data(), numMiddle);
+    }
+
+    //==============================================================================
+    // Knuth's algorithm D. The divisor's top word must be non-zero, and numU >= numV.
+    // The quotient needs room for numU - numV + 1 words, and the remainder for numV.
+    static void divide (const uint32* u, size_t numU, const uint32* v, size_t numV,
+                        uint32* quotient, uint32* remainder)
+    {
+        jassert (numV > 0 && numU >= numV && v[numV - 1] != 0);
+
+        if (numV == 1)
+        {
+            uint64 rem = 0;
+
+            for (auto i = numU; i-- > 0;)
+            {
+                auto current = (rem << 32) | u[i];
+                quotient[i] = (uint32) (current / v[0]);
+                rem = current % v[0];
+            }
+
+            remainder[0] = (uint32) rem;
+            return;
+        }
+
+        // Normalise, so that the divisor's top bit is set
+        const auto shift = 31 - findHighestSetBit (v[numV - 1]);
+        std::vector<uint32> vn (numV), un (numU + 1);
+
+        for (auto i = numV; --i > 0;)
+            vn[i] = (uint32) (((uint64) v[i] << shift) | ((uint64) v[i - 1] >> (32 - shift)));
+
+        vn[0] = v[0] << shift;
+        un[numU] = (uint32) ((uint64) u[numU - 1] >> (32 - shift));
+
+        for (auto i = numU; --i > 0;)
+            un[i] = (uint32) (((uint64) u[i] << shift) | ((uint64) u[i - 1] >> (32 - shift)));
+
+        un[0] = u[0] << shift;
+
+        const uint64 base = (uint64) 1 << 32;
+        const auto vTop = (uint64) vn[numV - 1];
+        const auto vNext = (uint64) vn[numV - 2];
+
+        for (auto j = numU - numV + 1; j-- > 0;)
+        {
+            // Estimate the next quotient word, which will be at most one too large
+            auto top = ((uint64) un[j + numV] << 32) | un[j + numV - 1];
+            auto qhat = top / vTop;
+            auto rhat = top % vTop;
+
+            while (qhat >= base || qhat * vNext > ((rhat << 32) | un[j + numV - 2]))
+            {
+                --qhat;
+                rhat += vTop;
+
+                if (rhat >= base)
+                    break;
+            }
+
+            uint64 carry = 0, borrow = 0;
+
+            for (size_t i = 0; i < numV; ++i)
+            {
+                auto product = qhat * vn[i] + carry;
+                carry = product >> 32;
+                auto diff = (uint64) un[i + j] - (uint32) product - borrow;
+                un[i + j] = (uint32) diff;
+                borrow = diff >> 63;
+            }
+
+            auto diff = (uint64) un[j + numV] - carry - borrow;
+            un[j + numV] = (uint32) diff;
+
+            if ((diff >> 63) != 0)
+            {
+                // The estimate was one too large, so add the divisor back
+                --qhat;
+                uint64 sum = 0;
+
+                for (size_t i = 0; i < numV; ++i)
+                {
+                    sum += (uint64) un[i + j] + vn[i];
+                    un[i + j] = (uint32) sum;
+                    sum >>= 32;
+                }
+
+                un[j + numV] += (uint32) sum;
+            }
+
+            quotient[j] = (uint32) qhat;
+        }
+
+        for (size_t i = 0; i < numV; ++i)
+            remainder[i] = (uint32) (((uint64) un[i] >> shift) | ((uint64) un[i + 1] << (32 - shift)));
+    }
+
+    //==============================================================================
+    // Modular exponentiation for odd moduli, using Montgomery multiplication on 64-bit words
+    static forcedinline uint64 multiplyAdd (uint64 a, uint64 b, uint64 c, uint64 d, uint64& high) noexcept
+    {
+       #if (JUCE_GCC || JUCE_CLANG) && defined (__SIZEOF_INT128__)
+        __extension__ using uint128 = unsigned __int128;
+        auto r = (uint128) a * b + c + d;
+        high = (uint64) (r >> 64);
+        return (uint64) r;
+       #else
+        #if JUCE_MSVC && JUCE_INTEL && JUCE_64BIT
+         uint64 hi;
+         auto lo = _umul128 (a, b, &hi);
+        #else
+         auto ll = (a & 0xffffffff) * (b & 0xffffffff);
+         auto lh = (a & 0xffffffff) * (b >> 32);
+         auto hl = (a >> 32) * (b & 0xffffffff);
+         auto mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+         auto lo = (mid << 32) | (ll & 0xffffffff);
+         auto hi = (a >> 32) * (b >> 32) + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        #endif
+
+        lo += c;
+        hi += lo < c ? 1 : 0;
+        lo += d;
+        hi += lo < d ? 1 : 0;
+        high = hi;
+        return lo;
+       #endif
+    }
+
+    class MontgomeryExponentiator
+    {
+    public:
+        explicit MontgomeryExponentiator (const BigInteger& mod)
+            : numWords ((size_t) (mod.getHighestBit() / 64 + 1)),
+              modulus (toWords (mod)),
+              temp (numWords + 2)
+        {
+            jassert (mod[0] && ! mod.isNegative());
+
+            // -modulus^-1 mod 2^64, using Newton's iteration (each step doubles the correct bits)
+            auto inverse = modulus[0];
+
+            for (int i = 0; i < 5; ++i)
+                inverse *= 2 - modulus[0] * inverse;
+
+            negativeInverse = (uint64) 0 - inverse;
+
+            BigInteger r2;
+            r2.setBit ((int) (128 * numWords));
+            r2 %= mod;
+            rSquared = toWords (r2);
+        }
+
+        BigInteger power (const BigInteger& base, const BigInteger& exponent, bool constantTime)
+        {
+            auto x = toWords (base);
+            multiply (x.data(), x.data(), rSquared.data());
+
+            std::vector<uint64> one (numWords), result (numWords);
+            one[0] = 1;
+            multiply (result.data(), one.data(), rSquared.data());
+
+            if (constantTime)
+                powerWithFixedWindow (result, x, exponent);
+            else
+                powerWithSlidingWindow (result, x, exponent);
+
+            multiply (result.data(), result.data(), one.data());
+            return fromWords (result);
+        }
+
+    private:
+        size_t numWords;
+        std::vector<uint64> modulus, rSquared, temp;
+        uint64 negativeInverse;
+
+        std::vector<uint64> toWords (const BigInteger& value) const
+        {
+            std::vector<uint64> words (numWords);
+
+            for (size_t i = 0; i < numWords; ++i)
+                words[i] = (uint64) value.getBitRangeAsInt ((int) i * 64, 32)
+                            | ((uint64) value.getBitRangeAsInt ((int) i * 64 + 32, 32) << 32);
+
+            return words;
+        }
+
+        static BigInteger fromWords (const std::vector<uint64>& words)
+        {
+            MemoryBlock block (words.size() * 8);
+
+            for (size_t i = 0; i < words.size(); ++i)
+                for (size_t j = 0; j < 8; ++j)
+                    block[i * 8 + j] = (char) (words[i] >> (8 * j));
+
+            BigInteger result;
+            result.loadFromMemoryBlock (block);
+            return result;
+        }
+
+        // result = a * b / R mod modulus, using the CIOS method. The result may alias a or b.
+        void multiply (uint64* result, const uint64* a, const uint64* b) noexcept
+        {
+            auto* t = temp.data();
+            std::fill (temp.begin(), temp.end(), (uint64) 0);
+
+            for (size_t i = 0; i < numWords; ++i)
+            {
+                uint64 carry = 0;
+
+                for (size_t j = 0; j < numWords; ++j)
+                    t[j] = multiplyAdd (a[j], b[i], t[j], carry, carry);
+
+                auto sum = t[numWords] + carry;
+                t[numWords + 1] = sum < carry ? 1 : 0;
+                t[numWords] = sum;
+
+                auto q = t[0] * negativeInverse;
+                multiplyAdd (q, modulus[0], t[0], 0, carry);
+
+                for (size_t j = 1; j < numWords; ++j)
+                    t[j - 1] = multiplyAdd (q, modulus[j], t[j], carry, carry);
+
+                sum = t[numWords] + carry;
+                t[numWords - 1] = sum;
+                t[numWords] = t[numWords + 1] + (sum < carry ? 1 : 0);
+            }
+
+            // t is now less than 2 * modulus, so subtract the modulus once if needed. Both
+            // results are calculated, so that the timing doesn't depend on which is used.
+            uint64 borrow = 0;
+
+            for (size_t j = 0; j < numWords; ++j)
+            {
+                auto diff = t[j] - modulus[j];
+                auto newBorrow = (t[j] < modulus[j] ? 1u : 0u) | (diff < borrow ? 1u : 0u);
+                result[j] = diff - borrow;
+                borrow = newBorrow;
+            }
+
+            const auto keepOriginal = (uint64) 0 - (uint64) (t[numWords] < borrow ? 1 : 0);
+
+            for (size_t j = 0; j < numWords; ++j)
+                result[j] = (t[j] & keepOriginal) | (result[j] & ~keepOriginal);
+        }
+
+        void square (std::vector<uint64>& x) noexcept
+        {
+            multiply (x.data(), x.data(), x.data());
+        }
+
+        uint64* getEntry (std::vector<uint64>& table, int index) noexcept
+        {
+            return table.data() + (size_t) index * numWords;
+        }
+
+        // Uses a table of the odd powers of x, and skips over runs of zero bits
+        void powerWithSlidingWindow (std::vector<uint64>& result, const std::vector<uint64>& x, const BigInteger& exponent)
+        {
+            const auto numBits = exponent.getHighestBit() + 1;
+            const auto windowBits = numBits > 512 ? 5 : (numBits > 128 ? 4 : (numBits > 24 ? 3 : 1));
+
+            std::vector<uint64> table (numWords << (windowBits - 1));
+            std::copy (x.begin(), x.end(), table.begin());
+
+            if (windowBits > 1)
+            {
+                auto xSquared = x;
+                square (xSquared);
+
+                for (int i = 1; i < (1 << (windowBits - 1)); ++i)
+                    multiply (getEntry (table, i), getEntry (table, i - 1), xSquared.data());
+            }
+
+            bool started = false;
+
+            for (int i = numBits - 1; i >= 0;)
+            {
+                if (! exponent[i])
+                {
+                    if (started)
+                        square (result);
+
+                    --i;
+                    continue;
+                }
+
+                auto low = jmax (0, i - windowBits + 1);
+
+                while (! exponent[low])
+                    ++low;
+
+                auto* entry = getEntry (table, (int) (exponent.getBitRangeAsInt (low, i - low + 1) >> 1));
+
+                if (started)
+                {
+                    for (int j = low; j <= i; ++j)
+                        square (result);
+
+                    multiply (result.data(), result.data(), entry);
+                }
+                else
+                {
+                    std::copy (entry, entry + numWords, result.begin());
+                    started = true;
+                }
+
+                i = low - 1;
+            }
+        }
+
+        // Processes the same number of bits in every step, and reads every table entry each
+        // time, so that neither the timing nor the memory accesses depend on the exponent's bits
+        void powerWithFixedWindow (std::vector<uint64>& result, const std::vector<uint64>& x, const BigInteger& exponent)
+        {
+            const auto numBits = exponent.getHighestBit() + 1;
+            const auto windowBits = numBits > 32 ? 4 : 1;
+            const auto tableSize = 1 << windowBits;
+
+            std::vector<uint64> table (numWords << windowBits), selected (numWords);
+            std::copy (result.begin(), result.end(), table.begin());
+            std::copy (x.begin(), x.end(), table.begin() + (std::ptrdiff_t) numWords);
+
+            for (int i = 2; i < tableSize; ++i)
+                multiply (getEntry (table, i), getEntry (table, i - 1), x.data());
+
+            for (auto window = (numBits + windowBits - 1) / windowBits; --window >= 0;)
+            {
+                for (int j = 0; j < windowBits; ++j)
+                    square (result);
+
+                const auto index = exponent.getBitRangeAsInt (window * windowBits, windowBits);
+                std::fill (selected.begin(), selected.end(), (uint64) 0);
+
+                for (int i = 0; i < tableSize; ++i)
+                {
+                    const auto mask = (uint64) 0 - (uint64) ((uint32) i == index ? 1 : 0);
+                    auto* entry = getEntry (table, i);
+
+                    for (size_t w = 0; w < numWords; ++w)
+                        selected[w] |= entry[w] & mask;
+                }
+
+                multiply (result.data(), result.data(), selected.data());
+            }
+        }
+    };
+}
+
 //==============================================================================
 BigInteger::BigInteger()
     : allocatedSize (numPreallocatedInts)
@@ -536,38 +1024,20 @@ BigInteger& BigInteger::operator*= (const BigInteger& other)
     auto n = getHighestBit();
     auto t = other.getHighestBit();
 
-    auto wasNegative = isNegative();
-    setNegative (false);
+    if (n < 0 || t < 0)
+        return clear();
+
+    auto numInts = sizeNeededToHold (n);
+    auto numOtherInts = sizeNeededToHold (t);
 
     BigInteger total;
     total.highestBit = n + t + 1;
-    auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
-
-    n >>= 5;
-    t >>= 5;
-
-    auto m = other;
-    m.setNegative (false);
-
-    auto* mValues = m.getValues();
-    auto* values = getValues();
-
-    for (int i = 0; i <= t; ++i)
-    {
-        uint32 c = 0;
-
-        for (int j = 0; j <= n; ++j)
-        {
-            auto uv = (uint64) totalValues[i + j] + (uint64) values[j] * (uint64) mValues[i] + (uint64) c;
-            totalValues[i + j] = (uint32) uv;
-            c = static_cast<uint32> (uv >> 32);
-        }
+    auto* totalValues = total.ensureSize (numInts + numOtherInts);
 
-        totalValues[i + n + 1] = c;
-    }
+    BigIntegerHelpers::multiply (totalValues, getValues(), numInts, other.getValues(), numOtherInts);
 
     total.highestBit = total.getHighestBit();
-    total.setNegative (wasNegative ^ other.isNegative());
+    total.setNegative (isNegative() ^ other.isNegative());
     swapWith (total);
 
     return *this;
@@ -592,27 +1062,28 @@ void BigInteger::divideBy (const BigInteger& divisor, BigInteger& remainder)
     else
     {
         auto wasNegative = isNegative();
+        auto numInts = sizeNeededToHold (ourHB);
+        auto numDivisorInts = sizeNeededToHold (divHB);
 
-        swapWith (remainder);
-        remainder.setNegative (false);
-        clear();
-
-        BigInteger temp (divisor);
-        temp.setNegative (false);
-
-        auto leftShift = ourHB - divHB;
-        temp <<= leftShift;
-
-        while (leftShift >= 0)
+        if (numInts < numDivisorInts)
         {
-            if (remainder.compareAbsolute (temp) >= 0)
-            {
-                remainder -= temp;
-                setBit (leftShift);
-            }
-
-            if (--leftShift >= 0)
-                temp >>= 1;
+            swapWith (remainder);
+            clear();
+        }
+        else
+        {
+            BigInteger quotient, rem;
+            quotient.highestBit = (int) (numInts - numDivisorInts + 1) * 32 - 1;
+            rem.highestBit = (int) numDivisorInts * 32 - 1;
+
+            BigIntegerHelpers::divide (getValues(), numInts, divisor.getValues(), numDivisorInts,
+                                       quotient.ensureSize (numInts - numDivisorInts + 1),
+                                       rem.ensureSize (numDivisorInts));
+
+            quotient.highestBit = quotient.getHighestBit();
+            rem.highestBit = rem.getHighestBit();
+            swapWith (quotient);
+            remainder.swapWith (rem);
         }
 
         negative = wasNegative ^ divisor.isNegative();
@@ -917,67 +1388,54 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
 void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
 {
     *this %= modulus;
-    auto exp = exponent;
-    exp %= modulus;
 
-    if (modulus.getHighestBit() <= 32 || modulus % 2 == 0)
+    if (modulus[0] && ! modulus.isNegative() && ! modulus.isOne())
     {
-        auto a = *this;
-        auto n = exp.getHighestBit();
+        if (isNegative())
+            *this += modulus;
 
-        for (int i = n; --i >= 0;)
-        {
-            *this *= *this;
-
-            if (exp[i])
-                *this *= a;
-
-            if (compareAbsolute (modulus) >= 0)
-                *this %= modulus;
-        }
+        BigIntegerHelpers::MontgomeryExponentiator exponentiator (modulus);
+        *this = exponentiator.power (*this, exponent, false);
+        return;
     }
-    else
+
+    if (exponent.isZero())
     {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
+        *this = modulus.isOne() ? 0 : 1;
+        return;
+    }
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+    auto a = *this;
+    auto n = exponent.getHighestBit();
 
-        if (! g.isOne())
-        {
-            BigInteger a (*this);
+    for (int i = n; --i >= 0;)
+    {
+        *this *= *this;
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                *this *= *this;
+        if (exponent[i])
+            *this *= a;
 
-                if (exp[i])
-                    *this *= a;
+        if (compareAbsolute (modulus) >= 0)
+            *this %= modulus;
+    }
+}
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
-            }
-        }
-        else
-        {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+void BigInteger::exponentModuloConstantTime (const BigInteger& exponent, const BigInteger& modulus)
+{
+    if (! modulus[0] || modulus.isNegative() || modulus.isOne())
+    {
+        jassertfalse; // the modulus must be odd, and greater than 1
+        exponentModulo (exponent, modulus);
+        return;
+    }
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+    *this %= modulus;
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
-            }
+    if (isNegative())
+        *this += modulus;
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
-        }
-    }
+    BigIntegerHelpers::MontgomeryExponentiator exponentiator (modulus);
+    *this = exponentiator.power (*this, exponent, true);
 }
 
 void BigInteger::montgomeryMultiplication (const BigInteger& other, const BigInteger& modulus,
@@ -1347,6 +1805,88 @@ public:
             }
         }
 
+        {
+            beginTest ("Large multiplication and division");
+
+            Random r = getRandom();
+
+            for (int j = 200; --j >= 0;)
+            {
+                BigInteger a, b, c;
+                r.fillBitsRandomly (a, 0, r.nextInt (6000) + 1);
+                r.fillBitsRandomly (b, 0, r.nextInt (6000) + 1);
+                r.fillBitsRandomly (c, 0, r.nextInt (6000) + 1);
+
+                if (b.isZero())
+                    continue;
+
+                auto product = a * b;
+                expect (product == b * a);
+                expect (product * c == a * (b * c));
+                expect (product * (a + c) == product * a + product * c);
+
+                c %= b;
+                BigInteger quotient (product + c), remainder;
+                quotient.divideBy (b, remainder);
+                expect (quotient == a);
+                expect (remainder == c);
+            }
+
+            for (size_t numA = 1; numA < 200; numA += 7)
+            {
+                for (size_t numB = 1; numB < 200; numB += 11)
+                {
+                    std::vector<uint32> a (numA), b (numB), expected (numA + numB), actual (numA + numB);
+
+                    for (auto& v : a)  v = (uint32) r.nextInt();
+                    for (auto& v : b)  v = (uint32) r.nextInt();
+
+                    BigIntegerHelpers::multiplySchoolbook (expected.data(), a.data(), numA, b.data(), numB);
+                    BigIntegerHelpers::multiply (actual.data(), a.data(), numA, b.data(), numB);
+                    expect (expected == actual);
+                }
+            }
+        }
+
+        {
+            beginTest ("Modular exponentiation");
+
+            Random r = getRandom();
+
+            for (int j = 100; --j >= 0;)
+            {
+                BigInteger base, exponent, modulus;
+                r.fillBitsRandomly (base, 0, r.nextInt (1100) + 1);
+                r.fillBitsRandomly (exponent, 0, r.nextInt (300) + 1);
+                r.fillBitsRandomly (modulus, 0, r.nextInt (1100) + 2);
+
+                if (modulus < 2)
+                    continue;
+
+                // a simple square-and-multiply to compare against
+                auto expected = BigInteger (1);
+
+                for (int i = exponent.getHighestBit(); i >= 0; --i)
+                {
+                    expected = (expected * expected) % modulus;
+
+                    if (exponent[i])
+                        expected = (expected * (base % modulus)) % modulus;
+                }
+
+                auto result = base;
+                result.exponentModulo (exponent, modulus);
+                expect (result == expected);
+
+                if (modulus[0])
+                {
+                    result = base;
+                    result.exponentModuloConstantTime (exponent, modulus);
+                    expect (result == expected);
+                }
+            }
+        }
+
         {
             beginTest ("Bit setting");
 
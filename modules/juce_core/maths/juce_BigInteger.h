@@ -264,6 +264,18 @@ public:
     */
     void exponentModulo (const BigInteger& exponent, const BigInteger& modulus);
 
+    /** Performs a combined exponent and modulo operation, in a way that doesn't reveal
+        the exponent through timing or memory access patterns.
+
+        This BigInteger's value becomes (this ^ exponent) % modulus, the same as with
+        exponentModulo(), but the operations performed depend only on the number of
+        bits in the exponent, not on their values. Use this when the exponent is a
+        secret, e.g. an RSA private key. It's a little slower than exponentModulo().
+
+        The modulus must be odd.
+    */
+    void exponentModuloConstantTime (const BigInteger& exponent, const BigInteger& modulus);
+
     /** Performs an inverse modulo on the value.
         i.e. the result is (this ^ -1) mod (modulus).
     */
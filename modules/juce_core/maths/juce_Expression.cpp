@@ -648,6 +648,195 @@ struct Expression::Helpers
         JUCE_DECLARE_NON_COPYABLE (SymbolListVisitor)
     };
 
+    //==============================================================================
+    class Compiler
+    {
+    public:
+        Compiler (Compiled& p, const StringArray& inputs)  : program (p), inputSymbols (inputs) {}
+
+        void compile (const Term& term, const Scope& scope, int recursionDepth)
+        {
+            checkRecursionDepth (recursionDepth);
+
+            switch (term.getType())
+            {
+                case constantType:  emitConstant (term.toDouble()); break;
+                case symbolType:    compileSymbol (term.getName(), scope, recursionDepth); break;
+                case functionType:  compileFunction (term, scope, recursionDepth); break;
+                case operatorType:  compileOperator (term, scope, recursionDepth); break;
+                default:            jassertfalse; break;
+            }
+        }
+
+    private:
+        using OpCode = Compiled::OpCode;
+
+        Compiled& program;
+        const StringArray& inputSymbols;
+        int stackDepth = 0;
+
+        void compileSymbol (const String& name, const Scope& scope, int recursionDepth)
+        {
+            auto inputIndex = inputSymbols.indexOf (name);
+
+            if (inputIndex >= 0)
+                emit (OpCode::pushInput, inputIndex);
+            else
+                compile (*scope.getSymbolValue (name).term, scope, recursionDepth + 1);
+        }
+
+        void compileFunction (const Term& term, const Scope& scope, int recursionDepth)
+        {
+            auto name = term.getName();
+            auto numParams = term.getNumInputs();
+
+            if (numParams > 0 && (name == "min" || name == "max"))
+            {
+                compile (*term.getInput (0), scope, recursionDepth + 1);
+
+                for (int i = 1; i < numParams; ++i)
+                {
+                    compile (*term.getInput (i), scope, recursionDepth + 1);
+                    emit (name == "min" ? OpCode::minimum : OpCode::maximum);
+                }
+
+                return;
+            }
+
+            if (numParams == 1)
+            {
+                auto op = name == "sin" ? OpCode::sine
+                        : name == "cos" ? OpCode::cosine
+                        : name == "tan" ? OpCode::tangent
+                        : name == "abs" ? OpCode::absolute
+                                        : OpCode::pushConstant;
+
+                if (op != OpCode::pushConstant)
+                {
+                    compile (*term.getInput (0), scope, recursionDepth + 1);
+                    emit (op);
+                    return;
+                }
+            }
+
+            throw EvaluationError ("Can't compile function: \"" + name + "\"");
+        }
+
+        void compileOperator (const Term& term, const Scope& scope, int recursionDepth)
+        {
+            if (term.getNumInputs() == 1)
+            {
+                compile (*term.getInput (0), scope, recursionDepth);
+                emit (OpCode::negate);
+                return;
+            }
+
+            auto name = term.getName();
+
+            if (name == ".")
+            {
+                auto inputIndex = inputSymbols.indexOf (term.toString());
+
+                if (inputIndex >= 0)
+                {
+                    emit (OpCode::pushInput, inputIndex);
+                    return;
+                }
+
+                RelativeScopeVisitor visitor (*this, *term.getInput (1), recursionDepth + 1);
+                scope.visitRelativeScope (term.getInput (0)->getName(), visitor);
+
+                if (! visitor.wasVisited)
+                    throw EvaluationError ("Unknown symbol: " + term.toString());
+
+                return;
+            }
+
+            compile (*term.getInput (0), scope, recursionDepth);
+            compile (*term.getInput (1), scope, recursionDepth);
+
+            emit (name == "+" ? OpCode::add
+                : name == "-" ? OpCode::subtract
+                : name == "*" ? OpCode::multiply
+                              : OpCode::divide);
+        }
+
+        void emitConstant (double value)
+        {
+            program.constants.add (value);
+            emit (OpCode::pushConstant, program.constants.size() - 1);
+        }
+
+        // Operations on constants are calculated here rather than being added to the program
+        void emit (OpCode op, int index = 0)
+        {
+            auto& instructions = program.instructions;
+            auto& constants = program.constants;
+            const auto numInstructions = instructions.size();
+
+            if (op == OpCode::pushConstant || op == OpCode::pushInput)
+            {
+                if (++stackDepth > Compiled::maxStackDepth)
+                    throw EvaluationError ("Expression is too deeply nested to compile");
+
+                instructions.add ({ op, index });
+                return;
+            }
+
+            const auto isUnary = op >= OpCode::negate;
+
+            if (! isUnary)
+                --stackDepth;
+
+            const auto numArgs = isUnary ? 1 : 2;
+
+            if (numInstructions >= numArgs
+                 && instructions.getReference (numInstructions - 1).op == OpCode::pushConstant
+                 && (isUnary || instructions.getReference (numInstructions - 2).op == OpCode::pushConstant))
+            {
+                if (isUnary)
+                {
+                    auto& value = constants.getReference (instructions.getReference (numInstructions - 1).index);
+                    value = Compiled::perform (op, value, 0);
+                }
+                else
+                {
+                    auto& lhs = constants.getReference (instructions.getReference (numInstructions - 2).index);
+                    lhs = Compiled::perform (op, lhs, constants.getLast());
+                    constants.removeLast();
+                    instructions.removeLast();
+                }
+
+                return;
+            }
+
+            instructions.add ({ op, index });
+        }
+
+        class RelativeScopeVisitor  : public Scope::Visitor
+        {
+        public:
+            RelativeScopeVisitor (Compiler& c, const Term& t, int recursion)
+                : compiler (c), term (t), recursionDepth (recursion) {}
+
+            void visit (const Scope& scope) override
+            {
+                compiler.compile (term, scope, recursionDepth);
+                wasVisited = true;
+            }
+
+            Compiler& compiler;
+            const Term& term;
+            const int recursionDepth;
+            bool wasVisited = false;
+
+        private:
+            JUCE_DECLARE_NON_COPYABLE (RelativeScopeVisitor)
+        };
+
+        JUCE_DECLARE_NON_COPYABLE (Compiler)
+    };
+
     //==============================================================================
     class Parser
     {
@@ -1086,6 +1275,27 @@ void Expression::findReferencedSymbols (Array<Symbol>& results, const Scope& sco
     {}
 }
 
+Expression::Compiled Expression::compile (const StringArray& inputSymbols, const Scope& scope, String& compileError) const
+{
+    Compiled result;
+    result.instructions.clearQuick();
+    result.constants.clearQuick();
+    result.numInputs = inputSymbols.size();
+
+    try
+    {
+        Helpers::Compiler compiler (result, inputSymbols);
+        compiler.compile (*term, scope, 0);
+        return result;
+    }
+    catch (Helpers::EvaluationError& e)
+    {
+        compileError = e.description;
+    }
+
+    return {};
+}
+
 String Expression::toString() const                     { return term->toString(); }
 bool Expression::usesAnySymbols() const                 { return Helpers::containsAnySymbols (*term); }
 Expression::Type Expression::getType() const noexcept   { return term->getType(); }
@@ -1115,6 +1325,123 @@ bool Expression::Symbol::operator!= (const Symbol& other) const noexcept
     return ! operator== (other);
 }
 
+//==============================================================================
+Expression::Compiled::Compiled()
+{
+    constants.add (0.0);
+    instructions.add ({ OpCode::pushConstant, 0 });
+}
+
+double Expression::Compiled::perform (OpCode op, double a, double b) noexcept
+{
+    switch (op)
+    {
+        case OpCode::add:           return a + b;
+        case OpCode::subtract:      return a - b;
+        case OpCode::multiply:      return a * b;
+        case OpCode::divide:        return a / b;
+        case OpCode::minimum:       return jmin (a, b);
+        case OpCode::maximum:       return jmax (a, b);
+        case OpCode::negate:        return -a;
+        case OpCode::sine:          return std::sin (a);
+        case OpCode::cosine:        return std::cos (a);
+        case OpCode::tangent:       return std::tan (a);
+        case OpCode::absolute:      return std::abs (a);
+        case OpCode::pushConstant:
+        case OpCode::pushInput:
+        default:                    break;
+    }
+
+    jassertfalse;
+    return 0;
+}
+
+double Expression::Compiled::evaluate (const double* inputs) const noexcept
+{
+    double stack[maxStackDepth];
+    int depth = 0;
+
+    for (auto& i : instructions)
+    {
+        switch (i.op)
+        {
+            case OpCode::pushConstant:  stack[depth++] = constants.getUnchecked (i.index); break;
+            case OpCode::pushInput:     stack[depth++] = inputs[i.index]; break;
+            case OpCode::add:           --depth; stack[depth - 1] += stack[depth]; break;
+            case OpCode::subtract:      --depth; stack[depth - 1] -= stack[depth]; break;
+            case OpCode::multiply:      --depth; stack[depth - 1] *= stack[depth]; break;
+            case OpCode::divide:        --depth; stack[depth - 1] /= stack[depth]; break;
+            case OpCode::minimum:       --depth; stack[depth - 1] = jmin (stack[depth - 1], stack[depth]); break;
+            case OpCode::maximum:       --depth; stack[depth - 1] = jmax (stack[depth - 1], stack[depth]); break;
+            case OpCode::negate:
+            case OpCode::sine:
+            case OpCode::cosine:
+            case OpCode::tangent:
+            case OpCode::absolute:
+            default:                    stack[depth - 1] = perform (i.op, stack[depth - 1], 0); break;
+        }
+    }
+
+    jassert (depth == 1);
+    return stack[0];
+}
+
+void Expression::Compiled::evaluate (const double* const* inputs, double* results, int numValues) const noexcept
+{
+    // The values are processed in blocks, so that each instruction is only decoded
+    // once per block, and the loops over each block can be vectorised
+    constexpr int blockSize = 16;
+    double stack[maxStackDepth][blockSize];
+
+    for (int start = 0; start < numValues; start += blockSize)
+    {
+        const auto num = jmin (blockSize, numValues - start);
+        int depth = 0;
+
+        const auto applyUnary = [&] (auto fn)
+        {
+            auto* a = stack[depth - 1];
+
+            for (int j = 0; j < num; ++j)
+                a[j] = fn (a[j]);
+        };
+
+        const auto applyBinary = [&] (auto fn)
+        {
+            --depth;
+            auto* a = stack[depth - 1];
+            auto* b = stack[depth];
+
+            for (int j = 0; j < num; ++j)
+                a[j] = fn (a[j], b[j]);
+        };
+
+        for (auto& i : instructions)
+        {
+            switch (i.op)
+            {
+                case OpCode::pushConstant:  std::fill (stack[depth], stack[depth] + num, constants.getUnchecked (i.index)); ++depth; break;
+                case OpCode::pushInput:     std::copy (inputs[i.index] + start, inputs[i.index] + start + num, stack[depth]); ++depth; break;
+                case OpCode::add:           applyBinary ([] (double a, double b) { return a + b; }); break;
+                case OpCode::subtract:      applyBinary ([] (double a, double b) { return a - b; }); break;
+                case OpCode::multiply:      applyBinary ([] (double a, double b) { return a * b; }); break;
+                case OpCode::divide:        applyBinary ([] (double a, double b) { return a / b; }); break;
+                case OpCode::minimum:       applyBinary ([] (double a, double b) { return jmin (a, b); }); break;
+                case OpCode::maximum:       applyBinary ([] (double a, double b) { return jmax (a, b); }); break;
+                case OpCode::negate:        applyUnary ([] (double a) { return -a; }); break;
+                case OpCode::sine:          applyUnary ([] (double a) { return std::sin (a); }); break;
+                case OpCode::cosine:        applyUnary ([] (double a) { return std::cos (a); }); break;
+                case OpCode::tangent:       applyUnary ([] (double a) { return std::tan (a); }); break;
+                case OpCode::absolute:      applyUnary ([] (double a) { return std::abs (a); }); break;
+                default:                    jassertfalse; break;
+            }
+        }
+
+        jassert (depth == 1);
+        std::copy (stack[0], stack[0] + num, results + start);
+    }
+}
+
 //==============================================================================
 Expression::Scope::Scope()  {}
 Expression::Scope::~Scope() {}
@@ -1171,4 +1498,141 @@ String Expression::Scope::getScopeUID() const
     return {};
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ExpressionTests  : public UnitTest
+{
+public:
+    ExpressionTests()
+        : UnitTest ("Expression", UnitTestCategories::maths)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Compiled expressions match the interpreted results");
+        {
+            const char* const expressions[] = { "x + y * 2", "-(x - y) / 3", "min (x, y, 0.5) + max (x * y, 1)",
+                                                "sin (x) * cos (y) - tan (x / 10)", "abs (x - scale) * scale",
+                                                "(x + 1) * (y - 1) / (x * x + 1)", "offsets.first + offsets.second * y" };
+
+            TestScope scope;
+            auto r = getRandom();
+
+            for (auto* text : expressions)
+            {
+                String error;
+                Expression e (text, error);
+                expect (error.isEmpty());
+
+                auto compiled = e.compile ({ "x", "y" }, scope, error);
+                expect (error.isEmpty(), error);
+                expectEquals (compiled.getNumInputs(), 2);
+
+                constexpr int numValues = 37;
+                double xs[numValues], ys[numValues], results[numValues];
+
+                for (int i = 0; i < numValues; ++i)
+                {
+                    xs[i] = r.nextDouble() * 10.0 - 5.0;
+                    ys[i] = r.nextDouble() * 10.0 - 5.0;
+                }
+
+                const double* inputs[] = { xs, ys };
+                compiled.evaluate (inputs, results, numValues);
+
+                for (int i = 0; i < numValues; ++i)
+                {
+                    scope.x = xs[i];
+                    scope.y = ys[i];
+                    const auto expected = e.evaluate (scope);
+
+                    const double values[] = { xs[i], ys[i] };
+                    expectWithinAbsoluteError (compiled.evaluate (values), expected, 1.0e-12);
+                    expectWithinAbsoluteError (results[i], expected, 1.0e-12);
+                }
+            }
+        }
+
+        beginTest ("Constants are folded");
+        {
+            TestScope scope;
+            String error;
+            auto compiled = Expression ("scale * 2 + max (1, 3) + x", error).compile ({ "x" }, scope, error);
+            expect (error.isEmpty());
+
+            const double input = 1.0;
+            expectEquals (compiled.evaluate (&input), 12.0);
+        }
+
+        beginTest ("Compile errors");
+        {
+            TestScope scope;
+            String error;
+
+            auto compiled = Expression ("x + unknown", error).compile ({ "x" }, scope, error);
+            expect (error.isNotEmpty());
+            expectEquals (compiled.evaluate (nullptr), 0.0);
+
+            error = {};
+            Expression ("foo (x)", error).compile ({ "x" }, scope, error);
+            expect (error.isNotEmpty());
+
+            error = {};
+            Expression ("loop + 1", error).compile ({}, scope, error);
+            expect (error.isNotEmpty());
+
+            auto deep = Expression (1.0);
+
+            for (int i = 0; i < Expression::Compiled::maxStackDepth; ++i)
+                deep = Expression::symbol ("x") + deep * Expression::symbol ("x");
+
+            error = {};
+            deep.compile ({ "x" }, scope, error);
+            expect (error.isNotEmpty());
+        }
+    }
+
+private:
+    struct TestScope  : public Expression::Scope
+    {
+        Expression getSymbolValue (const String& symbol) const override
+        {
+            if (symbol == "x")      return Expression (x);
+            if (symbol == "y")      return Expression (y);
+            if (symbol == "scale")  return Expression (4.0);
+            if (symbol == "loop")   return Expression::symbol ("loop");
+
+            return Expression::Scope::getSymbolValue (symbol);
+        }
+
+        void visitRelativeScope (const String& scopeName, Visitor& visitor) const override
+        {
+            if (scopeName != "offsets")
+                return Expression::Scope::visitRelativeScope (scopeName, visitor);
+
+            struct OffsetScope  : public Expression::Scope
+            {
+                Expression getSymbolValue (const String& symbol) const override
+                {
+                    if (symbol == "first")   return Expression (1.5);
+                    if (symbol == "second")  return Expression (-2.0);
+
+                    return Expression::Scope::getSymbolValue (symbol);
+                }
+            };
+
+            visitor.visit (OffsetScope());
+        }
+
+        double x = 0, y = 0;
+    };
+};
+
+static ExpressionTests expressionTests;
+
+#endif
+
 } // namespace juce
@@ -211,6 +211,78 @@ public:
     /** Returns a list of all symbols that may be needed to resolve this expression in the given scope. */
     void findReferencedSymbols (Array<Symbol>& results, const Scope& scope) const;
 
+    //==============================================================================
+    /** An expression that has been compiled into a flat list of stack-machine
+        instructions, so that it can be evaluated quickly and without allocating any
+        memory.
+
+        Use Expression::compile() to create one.
+    */
+    class JUCE_API  Compiled
+    {
+    public:
+        /** Creates a compiled expression that always evaluates to 0. */
+        Compiled();
+
+        /** Returns the number of input values that the evaluate() methods expect. */
+        int getNumInputs() const noexcept           { return numInputs; }
+
+        /** Evaluates the expression for a single set of inputs.
+            The array must contain getNumInputs() values, in the same order as the input
+            symbols that were passed to Expression::compile().
+        */
+        double evaluate (const double* inputs) const noexcept;
+
+        /** Evaluates the expression for many sets of inputs.
+            The inputs array must contain getNumInputs() pointers, in the same order as the
+            input symbols that were passed to Expression::compile(), and each one must point
+            to numValues values. The results array must also have space for numValues values.
+        */
+        void evaluate (const double* const* inputs, double* results, int numValues) const noexcept;
+
+        /** The maximum depth of the evaluation stack that a compiled expression can use. */
+        static constexpr int maxStackDepth = 32;
+
+    private:
+        enum class OpCode : uint8
+        {
+            pushConstant, pushInput,
+            add, subtract, multiply, divide, minimum, maximum,
+            negate, sine, cosine, tangent, absolute
+        };
+
+        struct Instruction
+        {
+            OpCode op;
+            int index;
+        };
+
+        Array<Instruction> instructions;
+        Array<double> constants;
+        int numInputs = 0;
+
+        static double perform (OpCode, double, double) noexcept;
+
+        friend class Expression;
+    };
+
+    /** Compiles this expression so that it can be evaluated many times with different
+        values for some of its symbols.
+
+        The symbols named in inputSymbols become inputs that are supplied each time the
+        compiled expression is evaluated. Any other symbols and relative scopes are
+        resolved through the scope during compilation, so later changes to their values
+        won't be seen until the expression is compiled again, and any parts of the
+        expression that don't depend on the inputs are calculated in advance.
+
+        Only the functions that the default Scope provides (min, max, sin, cos, tan and
+        abs) can be compiled, and these always use the built-in implementations.
+
+        If the expression can't be compiled, compileError is set to a description of the
+        problem, and the result will evaluate to 0.
+    */
+    Compiled compile (const StringArray& inputSymbols, const Scope& scope, String& compileError) const;
+
     //==============================================================================
     /** Expression type.
         @see Expression::getType()
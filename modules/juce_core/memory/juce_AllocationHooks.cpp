@@ -20,11 +20,12 @@
   ==============================================================================
 */
 
-#if JUCE_ENABLE_ALLOCATION_HOOKS
+#if JUCE_ENABLE_ALLOCATION_HOOKS || JUCE_ENABLE_REALTIME_SAFETY_CHECKS
 
 namespace juce
 {
 
+#if JUCE_ENABLE_ALLOCATION_HOOKS
 static AllocationHooks& getAllocationHooksForThread()
 {
     thread_local AllocationHooks hooks;
@@ -38,45 +39,59 @@ void notifyAllocationHooksForThread()
         l.newOrDeleteCalled();
     });
 }
+#endif
+
+static void notifyAllocationOrDeallocation ([[maybe_unused]] RealtimeSafety::Violation violation)
+{
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    notifyAllocationHooksForThread();
+   #endif
+
+    RealtimeSafety::check (violation);
+}
 
 }
 
 void* operator new (size_t s)
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::allocation);
     return std::malloc (s);
 }
 
 void* operator new[] (size_t s)
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::allocation);
     return std::malloc (s);
 }
 
 void operator delete (void* p) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::deallocation);
     std::free (p);
 }
 
 void operator delete[] (void* p) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::deallocation);
     std::free (p);
 }
 
 void operator delete (void* p, size_t) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::deallocation);
     std::free (p);
 }
 
 void operator delete[] (void* p, size_t) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::notifyAllocationOrDeallocation (juce::RealtimeSafety::Violation::deallocation);
     std::free (p);
 }
 
+#endif
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+
 namespace juce
 {
 
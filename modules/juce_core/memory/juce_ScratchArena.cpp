@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void ScratchArena::prepare (size_t numBytes)
+{
+    storage.malloc (numBytes);
+    capacity = numBytes;
+    numBytesUsed = peakNumBytesUsed = 0;
+}
+
+void* ScratchArena::allocateBytes (size_t numBytes, size_t alignment) noexcept
+{
+    jassert (isPowerOfTwo (alignment));
+
+    const auto base = (size_t) storage.get();
+    const auto start = ((base + numBytesUsed + alignment - 1) & ~(alignment - 1)) - base;
+
+    if (storage == nullptr || start + numBytes < start || start + numBytes > capacity)
+    {
+        // The arena is too small! Make sure that prepare() is given enough space for
+        // the largest block that you'll need.
+        jassertfalse;
+        return nullptr;
+    }
+
+    numBytesUsed = start + numBytes;
+    peakNumBytesUsed = jmax (peakNumBytesUsed, numBytesUsed);
+    return storage + start;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ScratchArenaTests  : public UnitTest
+{
+public:
+    ScratchArenaTests()
+        : UnitTest ("ScratchArena", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Allocations are aligned and don't overlap");
+        {
+            ScratchArena arena (1024);
+
+            auto* a = arena.allocate<char> (3);
+            auto* b = arena.allocate<double> (4);
+            auto* c = arena.allocateBytes (16, 64);
+
+            expect (a != nullptr && b != nullptr && c != nullptr);
+            expect (((size_t) b % alignof (double)) == 0);
+            expect (((size_t) c % 64) == 0);
+            expect ((char*) b >= a + 3);
+            expect ((char*) c >= (char*) (b + 4));
+        }
+
+        beginTest ("Scopes give back their allocations");
+        {
+            ScratchArena arena (256);
+
+            {
+                const ScratchArena::Scope outer (arena);
+                arena.allocate<float> (8);
+                const auto used = arena.getNumBytesUsed();
+
+                {
+                    const ScratchArena::Scope inner (arena);
+                    arena.allocate<float> (16);
+                    expectGreaterThan (arena.getNumBytesUsed(), used);
+                }
+
+                expectEquals (arena.getNumBytesUsed(), used);
+            }
+
+            expectEquals (arena.getNumBytesUsed(), (size_t) 0);
+            expectEquals (arena.getPeakNumBytesUsed(), (size_t) 96);
+        }
+
+        beginTest ("Channels fit in the space that's asked for");
+        {
+            ScratchArena arena (ScratchArena::getNumBytesForChannels<float> (3, 100));
+
+            auto** channels = arena.allocateChannels<float> (3, 100);
+            expect (channels != nullptr);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                expect (((size_t) channels[i] % 32) == 0);
+                std::fill (channels[i], channels[i] + 100, (float) i);
+            }
+
+            for (int i = 0; i < 3; ++i)
+                expect (std::all_of (channels[i], channels[i] + 100, [i] (float f) { return f == (float) i; }));
+        }
+    }
+};
+
+static ScratchArenaTests scratchArenaTests;
+
+#endif
+
+} // namespace juce
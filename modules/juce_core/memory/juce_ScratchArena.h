@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fixed-size block of memory which hands out temporary storage by bumping a
+    pointer, so it can be used on a real-time thread without allocating.
+
+    Give the arena enough space for the largest block you'll need somewhere it's
+    safe to allocate, e.g. in prepareToPlay(), then take what you need from it in
+    each callback inside a Scope, which gives the memory back when it ends.
+
+    @code
+    void prepareToPlay (double, int maxBlockSize) override
+    {
+        arena.prepare (ScratchArena::getNumBytesForChannels<float> (2, maxBlockSize));
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        const ScratchArena::Scope scope (arena);
+
+        if (auto** channels = arena.allocateChannels<float> (2, buffer.getNumSamples()))
+        {
+            AudioBuffer<float> temp (channels, 2, buffer.getNumSamples());
+            ...
+        }
+    }
+    @endcode
+
+    The arena doesn't construct or destroy the objects that it hands out space for,
+    so it should only be used for trivial types such as samples.
+
+    @see RealtimeSafety
+
+    @tags{Core}
+*/
+class JUCE_API  ScratchArena
+{
+public:
+    //==============================================================================
+    /** Creates an empty arena. Call prepare() before allocating anything from it. */
+    ScratchArena() = default;
+
+    /** Creates an arena with the given capacity. */
+    explicit ScratchArena (size_t numBytes)             { prepare (numBytes); }
+
+    /** Allocates the arena's storage. This will invalidate anything that was allocated
+        from it before, so shouldn't be called while it's in use.
+    */
+    void prepare (size_t numBytes);
+
+    /** Gives back everything that's been allocated from the arena. */
+    void reset() noexcept                               { numBytesUsed = 0; }
+
+    /** Returns the size of the arena. */
+    size_t getCapacity() const noexcept                 { return capacity; }
+
+    /** Returns the number of bytes that are currently allocated. */
+    size_t getNumBytesUsed() const noexcept             { return numBytesUsed; }
+
+    /** Returns the largest number of bytes that have been allocated at once since
+        prepare() was called. This can be useful when choosing how big to make the arena.
+    */
+    size_t getPeakNumBytesUsed() const noexcept         { return peakNumBytesUsed; }
+
+    //==============================================================================
+    /** Returns some uninitialised memory with the given alignment, or nullptr if the
+        arena doesn't have enough space left.
+    */
+    void* allocateBytes (size_t numBytes, size_t alignment = alignof (std::max_align_t)) noexcept;
+
+    /** Returns uninitialised space for a number of objects, or nullptr if the arena
+        doesn't have enough space left.
+    */
+    template <typename Type>
+    Type* allocate (size_t numElements, size_t alignment = alignof (Type)) noexcept
+    {
+        static_assert (std::is_trivially_destructible_v<Type>, "The arena won't call the destructors of these objects");
+        return static_cast<Type*> (allocateBytes (numElements * sizeof (Type), jmax (alignment, alignof (Type))));
+    }
+
+    /** Returns an array of channel pointers, each pointing to space for a number of
+        samples, which could be used to create an AudioBuffer or AudioBlock. Returns
+        nullptr if the arena doesn't have enough space left.
+    */
+    template <typename SampleType>
+    SampleType** allocateChannels (int numChannels, int numSamples) noexcept
+    {
+        const auto mark = numBytesUsed;
+        auto* channels = allocate<SampleType*> ((size_t) numChannels);
+
+        for (int i = 0; i < numChannels && channels != nullptr; ++i)
+            if ((channels[i] = allocate<SampleType> ((size_t) numSamples, channelAlignment)) == nullptr)
+                channels = nullptr;
+
+        if (channels == nullptr)
+            numBytesUsed = mark;
+
+        return channels;
+    }
+
+    /** Returns the number of bytes that allocateChannels() needs for a set of channels. */
+    template <typename SampleType>
+    static constexpr size_t getNumBytesForChannels (int numChannels, int numSamples) noexcept
+    {
+        return (size_t) numChannels * (sizeof (SampleType*) + sizeof (SampleType) * (size_t) numSamples + channelAlignment)
+                 + alignof (SampleType*);
+    }
+
+    //==============================================================================
+    /** Gives back everything that was allocated from an arena while this object existed.
+        Scopes can be nested.
+    */
+    class Scope
+    {
+    public:
+        explicit Scope (ScratchArena& a) noexcept  : arena (a), mark (a.numBytesUsed) {}
+        ~Scope() noexcept                          { arena.numBytesUsed = mark; }
+
+    private:
+        ScratchArena& arena;
+        const size_t mark;
+
+        JUCE_DECLARE_NON_COPYABLE (Scope)
+        JUCE_DECLARE_NON_MOVEABLE (Scope)
+    };
+
+private:
+    //==============================================================================
+    static constexpr size_t channelAlignment = 32;
+
+    HeapBlock<char> storage;
+    size_t capacity = 0, numBytesUsed = 0, peakNumBytesUsed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScratchArena)
+};
+
+} // namespace juce
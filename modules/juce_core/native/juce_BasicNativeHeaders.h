@@ -68,6 +68,9 @@
  #include <objc/objc.h>
  #include <objc/message.h>
  #include <poll.h>
+ #include <spawn.h>
+ #include <crt_externs.h>
+ #include <sys/event.h>
 
 //==============================================================================
 #elif JUCE_WINDOWS
@@ -211,6 +214,16 @@
  #include <sys/wait.h>
  #include <utime.h>
  #include <poll.h>
+ #include <spawn.h>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <sys/timerfd.h>
+ #include <sys/uio.h>
+ #include <linux/futex.h>
+
+ #if __has_include (<linux/io_uring.h>)
+  #include <linux/io_uring.h>
+ #endif
 
 //==============================================================================
 #elif JUCE_BSD
@@ -245,6 +258,8 @@
  #include <sys/wait.h>
  #include <utime.h>
  #include <poll.h>
+ #include <spawn.h>
+ #include <sys/event.h>
 
 //==============================================================================
 #elif JUCE_ANDROID
@@ -267,6 +282,10 @@
  #include <sys/wait.h>
  #include <android/api-level.h>
  #include <poll.h>
+ #include <spawn.h>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <sys/timerfd.h>
 
  // If you are getting include errors here, then you to re-build the Projucer
  // and re-save your .jucer file.
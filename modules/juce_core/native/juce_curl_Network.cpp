@@ -37,6 +37,8 @@ struct CURLSymbols
     CURLMcode (*curl_multi_perform) (CURLM *multi_handle, int *running_handles);
     CURLMcode (*curl_multi_remove_handle) (CURLM *multi_handle, CURL *curl_handle);
     CURLMcode (*curl_multi_timeout) (CURLM *multi_handle, long *milliseconds);
+    CURLMcode (*curl_multi_setopt) (CURLM *multi_handle, CURLMoption option, ...);
+    CURLMcode (*curl_multi_wait) (CURLM *multi_handle, struct curl_waitfd extra_fds[], unsigned int extra_nfds, int timeout_ms, int *ret);
     struct curl_slist* (*curl_slist_append) (struct curl_slist *, const char *);
     void (*curl_slist_free_all) (struct curl_slist *);
     curl_version_info_data* (*curl_version_info) (CURLversion);
@@ -64,6 +66,8 @@ struct CURLSymbols
         JUCE_INIT_CURL_SYMBOL (curl_multi_perform)
         JUCE_INIT_CURL_SYMBOL (curl_multi_remove_handle)
         JUCE_INIT_CURL_SYMBOL (curl_multi_timeout)
+        JUCE_INIT_CURL_SYMBOL (curl_multi_setopt)
+        JUCE_INIT_CURL_SYMBOL (curl_multi_wait)
         JUCE_INIT_CURL_SYMBOL (curl_slist_append)
         JUCE_INIT_CURL_SYMBOL (curl_slist_free_all)
         JUCE_INIT_CURL_SYMBOL (curl_version_info)
@@ -68,7 +68,8 @@ static void getCPUInfo (bool& hasMMX,
                         bool& hasAVX512BW,
                         bool& hasAVX512VL,
                         bool& hasAVX512VBMI,
-                        bool& hasAVX512VPOPCNTDQ)
+                        bool& hasAVX512VPOPCNTDQ,
+                        bool& hasSHA)
 {
     uint32 a = 0, b = 0, d = 0, c = 0;
     SystemStatsHelpers::doCPUID (a, b, c, d, 1);
@@ -99,6 +100,7 @@ static void getCPUInfo (bool& hasMMX,
     hasAVX512VL        = (b & (1u << 31)) != 0;
     hasAVX512VBMI      = (c & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = (c & (1u << 14)) != 0;
+    hasSHA             = (b & (1u << 29)) != 0;
 }
 
 } // namespace SystemStatsHelpers
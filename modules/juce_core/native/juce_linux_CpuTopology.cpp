@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+// Parses a sysfs CPU list such as "0-3,8,10-11"
+static Array<int> parseSysfsCpuList (const String& list)
+{
+    Array<int> cpus;
+
+    for (auto& range : StringArray::fromTokens (list.trim(), ",", {}))
+    {
+        const auto first = range.upToFirstOccurrenceOf ("-", false, false).getIntValue();
+        const auto last  = range.containsChar ('-') ? range.fromFirstOccurrenceOf ("-", false, false).getIntValue()
+                                                    : first;
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.add (cpu);
+    }
+
+    return cpus;
+}
+
+static String readSysfsValue (const File& file)
+{
+    return file.existsAsFile() ? file.loadFileAsString().trim() : String();
+}
+
+static int getFirstCpuInSysfsList (const File& file, int defaultValue)
+{
+    const auto cpus = parseSysfsCpuList (readSysfsValue (file));
+    return cpus.isEmpty() ? defaultValue : cpus.getFirst();
+}
+
+std::vector<SystemStats::LogicalCpu> juce_readCpuTopology()
+{
+    const File cpuRoot ("/sys/devices/system/cpu");
+    const auto onlineCpus = parseSysfsCpuList (readSysfsValue (cpuRoot.getChildFile ("online")));
+
+    std::vector<SystemStats::LogicalCpu> result;
+    std::vector<int> capacities;
+
+    for (auto index : onlineCpus)
+    {
+        const auto cpuDir = cpuRoot.getChildFile ("cpu" + String (index));
+        const auto topologyDir = cpuDir.getChildFile ("topology");
+
+        SystemStats::LogicalCpu cpu;
+        cpu.index = index;
+
+        // The first of a core's SMT siblings identifies the core; core_id alone isn't unique across packages
+        cpu.coreId = getFirstCpuInSysfsList (topologyDir.getChildFile ("thread_siblings_list"), index);
+        cpu.packageId = jmax (0, readSysfsValue (topologyDir.getChildFile ("physical_package_id")).getIntValue());
+
+        // Use the highest-level cache that this CPU has, and identify it by the first CPU sharing it
+        auto highestCacheLevel = 0;
+        cpu.cacheDomain = index;
+
+        for (auto& cacheDir : cpuDir.getChildFile ("cache").findChildFiles (File::findDirectories, false, "index*"))
+        {
+            const auto level = readSysfsValue (cacheDir.getChildFile ("level")).getIntValue();
+
+            if (level > highestCacheLevel)
+            {
+                highestCacheLevel = level;
+                cpu.cacheDomain = getFirstCpuInSysfsList (cacheDir.getChildFile ("shared_cpu_list"), index);
+            }
+        }
+
+        result.push_back (cpu);
+        capacities.push_back (readSysfsValue (cpuDir.getChildFile ("cpu_capacity")).getIntValue());
+    }
+
+    // Intel hybrid processors list their efficiency cores as a separate PMU
+    const auto atomCpus = parseSysfsCpuList (readSysfsValue (File ("/sys/devices/cpu_atom/cpus")));
+
+    if (! atomCpus.isEmpty())
+    {
+        for (auto& cpu : result)
+            if (atomCpus.contains (cpu.index))
+                cpu.coreType = SystemStats::CpuCoreType::efficiency;
+
+        return result;
+    }
+
+    // ARM big.LITTLE processors report a lower relative capacity for their efficiency cores
+    const auto maxCapacity = capacities.empty() ? 0 : *std::max_element (capacities.begin(), capacities.end());
+
+    for (size_t i = 0; i < result.size(); ++i)
+        if (capacities[i] > 0 && capacities[i] < maxCapacity)
+            result[i].coreType = SystemStats::CpuCoreType::efficiency;
+
+    return result;
+}
+
+} // namespace juce
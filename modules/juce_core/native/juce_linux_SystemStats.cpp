@@ -254,7 +254,8 @@ void CPUInformation::initialise() noexcept
                                     hasAVX512BW,
                                     hasAVX512VL,
                                     hasAVX512VBMI,
-                                    hasAVX512VPOPCNTDQ);
+                                    hasAVX512VPOPCNTDQ,
+                                    hasSHA);
    #endif
 
     numLogicalCPUs = numPhysicalCPUs = []
@@ -293,6 +294,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512VBMI      = flags.contains ("avx512vbmi");
     hasAVX512VL        = flags.contains ("avx512vl");
     hasAVX512VPOPCNTDQ = flags.contains ("avx512_vpopcntdq");
+    hasSHA             = flags.contains ("sha_ni");
 
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
@@ -68,7 +68,8 @@ void CPUInformation::initialise() noexcept
                                     hasAVX512BW,
                                     hasAVX512VL,
                                     hasAVX512VBMI,
-                                    hasAVX512VPOPCNTDQ);
+                                    hasAVX512VPOPCNTDQ,
+                                    hasSHA);
    #elif JUCE_ARM && __ARM_ARCH > 7
     hasNeon = true;
    #endif
@@ -85,6 +86,59 @@ void CPUInformation::initialise() noexcept
         numPhysicalCPUs = numLogicalCPUs;
 }
 
+std::vector<SystemStats::LogicalCpu> juce_readCpuTopology()
+{
+    const auto getValue = [] (const std::string& name)
+    {
+        int value = 0;
+        size_t len = sizeof (value);
+        return sysctlbyname (name.c_str(), &value, &len, nullptr, 0) >= 0 ? value : 0;
+    };
+
+    // The OS doesn't say which CPU indexes belong to which cluster, so list each
+    // performance level in turn, starting with the fastest.
+    std::vector<SystemStats::LogicalCpu> result;
+    int nextCoreId = 0, nextCacheDomain = 0;
+
+    for (int level = 0; level < jmax (1, getValue ("hw.nperflevels")); ++level)
+    {
+        const auto prefix = "hw.perflevel" + std::to_string (level) + ".";
+        auto numLogical   = getValue (prefix + "logicalcpu");
+        auto numPhysical  = getValue (prefix + "physicalcpu");
+        auto cpusPerCache = getValue (prefix + "cpusperl2");
+
+        if (numLogical <= 0)
+        {
+            // Intel Macs have no performance levels
+            numLogical   = getValue ("hw.logicalcpu");
+            numPhysical  = getValue ("hw.physicalcpu");
+            cpusPerCache = numLogical;
+        }
+
+        if (numLogical <= 0)
+            return {};
+
+        const auto threadsPerCore = jmax (1, numLogical / jmax (1, numPhysical));
+        cpusPerCache = cpusPerCache > 0 ? cpusPerCache : numLogical;
+
+        for (int i = 0; i < numLogical; ++i)
+        {
+            SystemStats::LogicalCpu cpu;
+            cpu.index = (int) result.size();
+            cpu.coreId = nextCoreId + i / threadsPerCore;
+            cpu.cacheDomain = nextCacheDomain + i / cpusPerCache;
+            cpu.coreType = level == 0 ? SystemStats::CpuCoreType::performance
+                                      : SystemStats::CpuCoreType::efficiency;
+            result.push_back (cpu);
+        }
+
+        nextCoreId += (numLogical + threadsPerCore - 1) / threadsPerCore;
+        nextCacheDomain += (numLogical + cpusPerCache - 1) / cpusPerCache;
+    }
+
+    return result;
+}
+
 //==============================================================================
 #if ! JUCE_IOS
 static String getOSXVersion()
@@ -20,6 +20,10 @@
   ==============================================================================
 */
 
+#if JUCE_BSD
+extern char** environ;
+#endif
+
 namespace juce
 {
 
@@ -36,13 +40,15 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { pthread_mutex_destroy (&lock); }
-void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock); }
+void CriticalSection::enter() const noexcept        { RealtimeSafety::check (RealtimeSafety::Violation::lock); pthread_mutex_lock (&lock); }
 bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
+    RealtimeSafety::check (RealtimeSafety::Violation::sleep);
+
     struct timespec time;
     time.tv_sec = millisecs / 1000;
     time.tv_nsec = (millisecs % 1000) * 1000000;
@@ -604,6 +610,102 @@ MemoryMappedFile::~MemoryMappedFile()
         close (fileHandle);
 }
 
+//==============================================================================
+void ParallelDirectoryScanner::readDirectory (const File& directory, const StringArray& wildcards, bool readMetadata,
+                                              const std::function<bool (NativeEntry&)>& callback)
+{
+   #if JUCE_LINUX
+    using StatStruct = struct stat64;
+    const auto statAt = [] (int fd, const char* name, StatStruct& info, int flags) { return fstatat64 (fd, name, &info, flags) == 0; };
+   #else
+    using StatStruct = struct stat;
+    const auto statAt = [] (int fd, const char* name, StatStruct& info, int flags) { return fstatat (fd, name, &info, flags) == 0; };
+   #endif
+
+    auto* dir = opendir (directory.getFullPathName().toUTF8());
+
+    if (dir == nullptr)
+        return;
+
+    // The items are looked up relative to the open folder, which saves the kernel from
+    // resolving the whole path again for each one
+    const auto fd = dirfd (dir);
+    const auto parentPath = File::addTrailingSeparator (directory.getFullPathName());
+    const auto matchFlags = File::areFileNamesCaseSensitive() ? 0 : FNM_CASEFOLD;
+
+    std::vector<const char*> wildcardsUTF8;
+
+    for (auto& w : wildcards)
+        wildcardsUTF8.push_back (w.toRawUTF8());
+
+    NativeEntry item;
+
+    while (auto* de = readdir (dir))
+    {
+        const char* name = de->d_name;
+
+        if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0)))
+            continue;
+
+        item.matchesWildcard = std::any_of (wildcardsUTF8.begin(), wildcardsUTF8.end(),
+                                            [&] (const char* w) { return fnmatch (w, name, matchFlags) == 0; });
+
+        // The type that readdir returns is enough to tell whether an item is a folder,
+        // except for symlinks, and filesystems that don't provide it
+        item.isSymlink = de->d_type == DT_LNK;
+        auto isDirectory = de->d_type == DT_DIR;
+
+        StatStruct info;
+        auto hasInfo = false;
+
+        if (de->d_type == DT_UNKNOWN && statAt (fd, name, info, AT_SYMLINK_NOFOLLOW))
+        {
+            item.isSymlink = S_ISLNK (info.st_mode);
+            isDirectory = S_ISDIR (info.st_mode);
+            hasInfo = ! item.isSymlink;
+        }
+
+        if (item.isSymlink || (readMetadata && ! hasInfo && (item.matchesWildcard || isDirectory)))
+        {
+            hasInfo = statAt (fd, name, info, 0);
+            isDirectory = hasInfo && S_ISDIR (info.st_mode);
+        }
+
+        if (! (item.matchesWildcard || isDirectory))
+            continue;
+
+        auto& entry = item.entry;
+        entry = {};
+
+       #if JUCE_MAC || JUCE_IOS
+        entry.file = File::createFileWithoutCheckingPath (parentPath + String (CharPointer_UTF8 (name)).convertToPrecomposedUnicode());
+        entry.hidden = name[0] == '.' || (hasInfo && (info.st_flags & UF_HIDDEN) != 0);
+       #else
+        entry.file = File::createFileWithoutCheckingPath (parentPath + String (CharPointer_UTF8 (name)));
+        entry.hidden = name[0] == '.';
+       #endif
+
+        entry.directory = isDirectory;
+
+        if (readMetadata && hasInfo)
+        {
+            entry.fileSize     = (int64) info.st_size;
+            entry.modTime      = Time ((int64) info.st_mtime * 1000);
+           #if JUCE_MAC || JUCE_IOS
+            entry.creationTime = Time ((int64) info.st_birthtime * 1000);
+           #else
+            entry.creationTime = Time ((int64) info.st_ctime * 1000);
+           #endif
+            entry.readOnly     = faccessat (fd, name, W_OK, 0) != 0;
+        }
+
+        if (! callback (item))
+            break;
+    }
+
+    closedir (dir);
+}
+
 //==============================================================================
 File juce_getExecutableFile();
 File juce_getExecutableFile()
@@ -1095,113 +1197,178 @@ public:
         jassert (File::getCurrentWorkingDirectory().getChildFile (exe).existsAsFile()
                   || ! exe.containsChar (File::getSeparatorChar()));
 
-        int pipeHandles[2] = {};
+        const auto wantsOut = (streamFlags & wantStdOut) != 0;
+        const auto wantsErr = (streamFlags & wantStdErr) != 0;
+        const auto separateErr = wantsErr && (streamFlags & separateStdErr) != 0;
 
-        if (pipe (pipeHandles) == 0)
-        {
-            auto result = fork();
+        // The child's ends of the pipes are closed when these go out of scope
+        Pipe outPipe, errPipe, inPipe;
 
-            if (result < 0)
-            {
-                close (pipeHandles[0]);
-                close (pipeHandles[1]);
-            }
-            else if (result == 0)
-            {
-                // we're the child process..
-                close (pipeHandles[0]);   // close the read handle
+        if (! outPipe.create()
+             || (separateErr && ! errPipe.create())
+             || ((streamFlags & wantStdIn) != 0 && ! inPipe.create()))
+            return;
 
-                if ((streamFlags & wantStdOut) != 0)
-                    dup2 (pipeHandles[1], STDOUT_FILENO); // turns the pipe into stdout
-                else
-                    dup2 (open ("/dev/null", O_WRONLY), STDOUT_FILENO);
+       #ifdef F_SETNOSIGPIPE
+        if (inPipe.handles[1] >= 0)
+            fcntl (inPipe.handles[1], F_SETNOSIGPIPE, 1);
+       #endif
 
-                if ((streamFlags & wantStdErr) != 0)
-                    dup2 (pipeHandles[1], STDERR_FILENO);
-                else
-                    dup2 (open ("/dev/null", O_WRONLY), STDERR_FILENO);
+        const int childOut = wantsOut ? outPipe.handles[1] : -1;
+        const int childErr = separateErr ? errPipe.handles[1] : (wantsErr ? outPipe.handles[1] : -1);
+        const int childIn  = inPipe.handles[0];
 
-                close (pipeHandles[1]);
+        Array<char*> argv;
 
-                Array<char*> argv;
+        for (auto& arg : arguments)
+            if (arg.isNotEmpty())
+                argv.add (const_cast<char*> (arg.toRawUTF8()));
 
-                for (auto& arg : arguments)
-                    if (arg.isNotEmpty())
-                        argv.add (const_cast<char*> (arg.toRawUTF8()));
+        argv.add (nullptr);
 
-                argv.add (nullptr);
+       #if JUCE_ANDROID && __ANDROID_API__ < 28
+        auto result = fork();
 
-                execvp (exe.toRawUTF8(), argv.getRawDataPointer());
-                _exit (-1);
-            }
-            else
+        if (result == 0)
+        {
+            // we're the child process..
+            auto redirect = [] (int handle, int target)
             {
-                // we're the parent process..
-                childPID = result;
-                pipeHandle = pipeHandles[0];
-                close (pipeHandles[1]); // close the write handle
-            }
+                dup2 (handle >= 0 ? handle : open ("/dev/null", O_WRONLY), target);
+            };
+
+            if (childIn >= 0)
+                dup2 (childIn, STDIN_FILENO);
+
+            redirect (childOut, STDOUT_FILENO);
+            redirect (childErr, STDERR_FILENO);
+
+            execvp (exe.toRawUTF8(), argv.getRawDataPointer());
+            _exit (-1);
+        }
+
+        if (result > 0)
+            childPID = result;
+       #else
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init (&actions);
+
+        auto redirect = [&actions] (int handle, int target)
+        {
+            if (handle >= 0)
+                posix_spawn_file_actions_adddup2 (&actions, handle, target);
+            else
+                posix_spawn_file_actions_addopen (&actions, target, "/dev/null", O_WRONLY, 0);
+        };
+
+        if (childIn >= 0)
+            posix_spawn_file_actions_adddup2 (&actions, childIn, STDIN_FILENO);
+
+        redirect (childOut, STDOUT_FILENO);
+        redirect (childErr, STDERR_FILENO);
+
+        // Don't pass on the calling thread's blocked signals, or an ignored SIGPIPE
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init (&attributes);
+
+        sigset_t noSignals, defaultSignals;
+        sigemptyset (&noSignals);
+        sigemptyset (&defaultSignals);
+        sigaddset (&defaultSignals, SIGPIPE);
+        posix_spawnattr_setsigmask (&attributes, &noSignals);
+        posix_spawnattr_setsigdefault (&attributes, &defaultSignals);
+
+        short spawnFlags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+
+       #ifdef POSIX_SPAWN_USEVFORK
+        spawnFlags |= POSIX_SPAWN_USEVFORK; // older glibc versions only avoid a full fork if asked
+       #endif
+
+        posix_spawnattr_setflags (&attributes, spawnFlags);
+
+        pid_t result = 0;
+
+        if (posix_spawnp (&result, exe.toRawUTF8(), &actions, &attributes,
+                          argv.getRawDataPointer(), getEnvironment()) == 0)
+            childPID = result;
+
+        posix_spawnattr_destroy (&attributes);
+        posix_spawn_file_actions_destroy (&actions);
+       #endif
+
+        if (childPID != 0)
+        {
+            // we're the parent process..
+            outputHandle = std::exchange (outPipe.handles[0], -1);
+            errorHandle  = std::exchange (errPipe.handles[0], -1);
+            inputHandle  = std::exchange (inPipe.handles[1], -1);
         }
     }
 
     ~ActiveProcess()
     {
-        if (readHandle != nullptr)
-            fclose (readHandle);
-
-        if (pipeHandle != 0)
-            close (pipeHandle);
+        for (auto handle : { outputHandle, errorHandle, inputHandle })
+            if (handle >= 0)
+                close (handle);
     }
 
     bool isRunning() noexcept
     {
-        if (childPID == 0)
-            return false;
+        return childPID != 0 && ! hasFinished && ! checkForExit();
+    }
 
-        int childState = 0;
-        auto pid = waitpid (childPID, &childState, WNOHANG);
+    int read (void* dest, int numBytes) noexcept         { return readFrom (outputHandle, dest, numBytes); }
+    int readError (void* dest, int numBytes) noexcept    { return readFrom (errorHandle, dest, numBytes); }
 
-        if (pid == 0)
-            return true;
+    static int readFrom (int handle, void* dest, int numBytes) noexcept
+    {
+        jassert (dest != nullptr && numBytes > 0);
+
+        if (handle < 0)
+            return 0;
 
-        if (WIFEXITED (childState))
+        for (;;)
         {
-            exitCode = WEXITSTATUS (childState);
-            return false;
-        }
+            auto numBytesRead = ::read (handle, dest, (size_t) numBytes);
+
+            if (numBytesRead >= 0)
+                return (int) numBytesRead;
 
-        return ! WIFSIGNALED (childState);
+            // signal occurred during read() so try again
+            if (errno != EINTR)
+                return 0;
+        }
     }
 
-    int read (void* dest, int numBytes) noexcept
+    int write (const void* source, int numBytes) noexcept
     {
-        jassert (dest != nullptr && numBytes > 0);
+        if (inputHandle < 0)
+            return -1;
 
-        #ifdef fdopen
-         #error // some crazy 3rd party headers (e.g. zlib) define this function as NULL!
-        #endif
+        int total = 0;
 
-        if (readHandle == nullptr && childPID != 0)
-            readHandle = fdopen (pipeHandle, "r");
-
-        if (readHandle != nullptr)
+        while (total < numBytes)
         {
-            for (;;)
-            {
-                auto numBytesRead = (int) fread (dest, 1, (size_t) numBytes, readHandle);
-
-                if (numBytesRead > 0 || feof (readHandle))
-                    return numBytesRead;
+            auto numWritten = writeWithoutSigPipe (inputHandle, addBytesToPointer (source, total), (size_t) (numBytes - total));
 
-                // signal occurred during fread() so try again
-                if (ferror (readHandle) && errno == EINTR)
+            if (numWritten < 0)
+            {
+                if (errno == EINTR)
                     continue;
 
-                break;
+                return -1;
             }
+
+            total += (int) numWritten;
         }
 
-        return 0;
+        return total;
+    }
+
+    void closeInput() noexcept
+    {
+        if (inputHandle >= 0)
+            close (std::exchange (inputHandle, -1));
     }
 
     bool killProcess() const noexcept
@@ -1211,28 +1378,115 @@ public:
 
     uint32 getExitCode() noexcept
     {
-        if (exitCode >= 0)
-            return (uint32) exitCode;
+        if (childPID != 0 && ! hasFinished)
+            checkForExit();
 
-        if (childPID != 0)
+        return exitCode >= 0 ? (uint32) exitCode : 0;
+    }
+
+    int childPID = 0;
+    int outputHandle = -1, errorHandle = -1, inputHandle = -1;
+
+private:
+    struct Pipe
+    {
+        Pipe() = default;
+
+        ~Pipe()
         {
-            int childState = 0;
-            auto pid = waitpid (childPID, &childState, WNOHANG);
+            for (auto handle : handles)
+                if (handle >= 0)
+                    close (handle);
+        }
+
+        bool create() noexcept
+        {
+            int newHandles[2];
+
+            if (pipe (newHandles) != 0)
+                return false;
 
-            if (pid >= 0 && WIFEXITED (childState))
+            for (int i = 0; i < 2; ++i)
             {
-                exitCode = WEXITSTATUS (childState);
-                return (uint32) exitCode;
+                // Keeps these handles out of any other children that are spawned at the
+                // same time. The ends that are handed to our own child are dup'ed onto its
+                // standard streams, which clears the flag.
+                fcntl (newHandles[i], F_SETFD, FD_CLOEXEC);
+                handles[i] = newHandles[i];
             }
+
+            return true;
         }
 
-        return 0;
+        int handles[2] = { -1, -1 };
+
+        JUCE_DECLARE_NON_COPYABLE (Pipe)
+    };
+
+    // Returns true once the child has finished, and records its exit status
+    bool checkForExit() noexcept
+    {
+        int childState = 0;
+        auto pid = waitpid (childPID, &childState, WNOHANG);
+
+        if (pid == 0 || (pid < 0 && errno == EINTR))
+            return false;
+
+        hasFinished = true;
+
+        if (pid > 0 && WIFEXITED (childState))
+            exitCode = WEXITSTATUS (childState);
+
+        return true;
+    }
+
+    static ssize_t writeWithoutSigPipe (int handle, const void* source, size_t numBytes) noexcept
+    {
+       #ifdef F_SETNOSIGPIPE
+        return ::write (handle, source, numBytes);
+       #else
+        // If the child has gone away, the write raises SIGPIPE, which would kill this
+        // process. So it's blocked for the duration, and any SIGPIPE that it caused is
+        // taken off the pending list before it's unblocked again.
+        sigset_t sigPipe, previousMask, pending;
+        sigemptyset (&sigPipe);
+        sigaddset (&sigPipe, SIGPIPE);
+        pthread_sigmask (SIG_BLOCK, &sigPipe, &previousMask);
+
+        sigpending (&pending);
+        const auto wasAlreadyPending = sigismember (&pending, SIGPIPE) == 1;
+
+        auto result = ::write (handle, source, numBytes);
+
+        if (result < 0 && errno == EPIPE && ! wasAlreadyPending)
+        {
+            sigpending (&pending);
+
+            if (sigismember (&pending, SIGPIPE) == 1)
+            {
+                int sig = 0;
+                sigwait (&sigPipe, &sig);
+            }
+
+            errno = EPIPE;
+        }
+
+        pthread_sigmask (SIG_SETMASK, &previousMask, nullptr);
+        return result;
+       #endif
+    }
+
+    static char** getEnvironment() noexcept
+    {
+       #if JUCE_MAC || JUCE_IOS
+        return *_NSGetEnviron();
+       #else
+        return environ;
+       #endif
     }
 
-    int childPID = 0;
-    int pipeHandle = 0;
     int exitCode = -1;
-    FILE* readHandle = {};
+    bool hasFinished = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
@@ -53,6 +53,11 @@ void CPUInformation::initialise() noexcept
     numPhysicalCPUs = 1;
 }
 
+std::vector<SystemStats::LogicalCpu> juce_readCpuTopology()
+{
+    return {};
+}
+
 //==============================================================================
 uint32 juce_millisecondsSinceStartup() noexcept
 {
@@ -70,6 +70,95 @@ static int findNumberOfPhysicalCores() noexcept
    #endif // JUCE_MINGW
 }
 
+std::vector<SystemStats::LogicalCpu> juce_readCpuTopology()
+{
+   #if JUCE_MINGW
+    // Not implemented in MinGW
+    return {};
+   #else
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformationEx (RelationAll, nullptr, &bufferSize);
+
+    if (bufferSize == 0)
+        return {};
+
+    HeapBlock<char> buffer (bufferSize);
+
+    if (! GetLogicalProcessorInformationEx (RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX> (buffer.get()), &bufferSize))
+        return {};
+
+    // Processors in groups other than the first are numbered after the 64 slots of each preceding group
+    const auto forEachCpu = [] (const GROUP_AFFINITY& affinity, auto&& fn)
+    {
+        for (int bit = 0; bit < 64; ++bit)
+            if ((affinity.Mask & ((KAFFINITY) 1 << bit)) != 0)
+                fn ((int) affinity.Group * 64 + bit);
+    };
+
+    std::map<int, SystemStats::LogicalCpu> cpus;
+    std::map<int, int> efficiencyClasses, cacheLevels;
+    int nextCoreId = 0, nextPackageId = 0, maxEfficiencyClass = 0;
+
+    for (DWORD offset = 0; offset < bufferSize;)
+    {
+        const auto& info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*> (buffer.get() + offset);
+        offset += info.Size;
+
+        if (info.Relationship == RelationProcessorCore)
+        {
+            const auto coreId = nextCoreId++;
+            maxEfficiencyClass = jmax (maxEfficiencyClass, (int) info.Processor.EfficiencyClass);
+
+            for (WORD i = 0; i < info.Processor.GroupCount; ++i)
+            {
+                forEachCpu (info.Processor.GroupMask[i], [&] (int index)
+                {
+                    cpus[index].coreId = coreId;
+                    efficiencyClasses[index] = (int) info.Processor.EfficiencyClass;
+                });
+            }
+        }
+        else if (info.Relationship == RelationProcessorPackage)
+        {
+            const auto packageId = nextPackageId++;
+
+            for (WORD i = 0; i < info.Processor.GroupCount; ++i)
+                forEachCpu (info.Processor.GroupMask[i], [&] (int index) { cpus[index].packageId = packageId; });
+        }
+        else if (info.Relationship == RelationCache)
+        {
+            // Identify the highest-level cache by the first CPU that shares it
+            int firstCpu = -1;
+            forEachCpu (info.Cache.GroupMask, [&] (int index) { firstCpu = firstCpu < 0 ? index : firstCpu; });
+
+            forEachCpu (info.Cache.GroupMask, [&] (int index)
+            {
+                if (info.Cache.Level > cacheLevels[index])
+                {
+                    cacheLevels[index] = info.Cache.Level;
+                    cpus[index].cacheDomain = firstCpu;
+                }
+            });
+        }
+    }
+
+    std::vector<SystemStats::LogicalCpu> result;
+
+    for (auto& [index, cpu] : cpus)
+    {
+        cpu.index = index;
+
+        // Higher efficiency classes are the faster cores
+        if (efficiencyClasses[index] < maxEfficiencyClass)
+            cpu.coreType = SystemStats::CpuCoreType::efficiency;
+
+        result.push_back (cpu);
+    }
+
+    return result;
+   #endif
+}
+
 //==============================================================================
 #if JUCE_INTEL
  #if JUCE_MSVC && ! defined (__INTEL_COMPILER)
@@ -175,6 +264,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512VL        = ((unsigned int) info[1] & (1u << 31)) != 0;
     hasAVX512VBMI      = ((unsigned int) info[2] & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = ((unsigned int) info[2] & (1u << 14)) != 0;
+    hasSHA             = ((unsigned int) info[1] & (1u << 29)) != 0;
 
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
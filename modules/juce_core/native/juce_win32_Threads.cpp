@@ -47,7 +47,7 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { DeleteCriticalSection ((CRITICAL_SECTION*) &lock); }
-void CriticalSection::enter() const noexcept        { EnterCriticalSection ((CRITICAL_SECTION*) &lock); }
+void CriticalSection::enter() const noexcept        { RealtimeSafety::check (RealtimeSafety::Violation::lock); EnterCriticalSection ((CRITICAL_SECTION*) &lock); }
 bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) != FALSE; }
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) &lock); }
 
@@ -197,6 +197,8 @@ static SleepEvent sleepEvent;
 
 void JUCE_CALLTYPE Thread::sleep (const int millisecs)
 {
+    RealtimeSafety::check (RealtimeSafety::Violation::sleep);
+
     jassert (millisecs >= 0);
 
     if (millisecs >= 10 || sleepEvent.handle == nullptr)
@@ -419,28 +421,64 @@ class ChildProcess::ActiveProcess
 {
 public:
     ActiveProcess (const String& command, int streamFlags)
-        : ok (false), readPipe (nullptr), writePipe (nullptr)
     {
-        SECURITY_ATTRIBUTES securityAtts = {};
-        securityAtts.nLength = sizeof (securityAtts);
-        securityAtts.bInheritHandle = TRUE;
+        const auto wantsOut = (streamFlags & wantStdOut) != 0;
+        const auto wantsErr = (streamFlags & wantStdErr) != 0;
+        const auto separateErr = wantsErr && (streamFlags & separateStdErr) != 0;
+
+        HANDLE childOut = nullptr, childErr = nullptr, childIn = nullptr;
 
-        if (CreatePipe (&readPipe, &writePipe, &securityAtts, 0)
-             && SetHandleInformation (readPipe, HANDLE_FLAG_INHERIT, 0))
+        if (createPipe (outputPipe, childOut, false)
+             && (! separateErr || createPipe (errorPipe, childErr, false))
+             && ((streamFlags & wantStdIn) == 0 || createPipe (inputPipe, childIn, true)))
         {
-            STARTUPINFOW startupInfo = {};
-            startupInfo.cb = sizeof (startupInfo);
-
-            startupInfo.hStdOutput = (streamFlags & wantStdOut) != 0 ? writePipe : nullptr;
-            startupInfo.hStdError  = (streamFlags & wantStdErr) != 0 ? writePipe : nullptr;
-            startupInfo.dwFlags = STARTF_USESTDHANDLES;
-
-            JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6335)
-            ok = CreateProcess (nullptr, const_cast<LPWSTR> (command.toWideCharPointer()),
-                                nullptr, nullptr, TRUE, CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT,
-                                nullptr, nullptr, &startupInfo, &processInfo) != FALSE;
-            JUCE_END_IGNORE_WARNINGS_MSVC
+            STARTUPINFOEXW startupInfo = {};
+            startupInfo.StartupInfo.cb = sizeof (startupInfo);
+
+            startupInfo.StartupInfo.hStdOutput = wantsOut ? childOut : nullptr;
+            startupInfo.StartupInfo.hStdError  = separateErr ? childErr : (wantsErr ? childOut : nullptr);
+            startupInfo.StartupInfo.hStdInput  = childIn;
+            startupInfo.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+
+            // Only let the child inherit its own pipes, so that when lots of processes are
+            // launched at once, none of them holds another one's pipes open
+            HANDLE handlesToInherit[3];
+            DWORD numHandlesToInherit = 0;
+
+            for (auto handle : { childOut, childErr, childIn })
+                if (handle != nullptr)
+                    handlesToInherit[numHandlesToInherit++] = handle;
+
+            SIZE_T attributeListSize = 0;
+            InitializeProcThreadAttributeList (nullptr, 1, 0, &attributeListSize);
+            HeapBlock<char> attributeListStorage (attributeListSize);
+            auto attributeList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST> (attributeListStorage.get());
+
+            if (InitializeProcThreadAttributeList (attributeList, 1, 0, &attributeListSize))
+            {
+                if (UpdateProcThreadAttribute (attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+                                               handlesToInherit, numHandlesToInherit * sizeof (HANDLE),
+                                               nullptr, nullptr))
+                {
+                    startupInfo.lpAttributeList = attributeList;
+
+                    JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6335)
+                    ok = CreateProcess (nullptr, const_cast<LPWSTR> (command.toWideCharPointer()),
+                                        nullptr, nullptr, TRUE,
+                                        CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT | EXTENDED_STARTUPINFO_PRESENT,
+                                        nullptr, nullptr, &startupInfo.StartupInfo, &processInfo) != FALSE;
+                    JUCE_END_IGNORE_WARNINGS_MSVC
+                }
+
+                DeleteProcThreadAttributeList (attributeList);
+            }
         }
+
+        // Now that the child has its own copies, closing ours means that the pipes break
+        // as soon as the child has finished with them
+        for (auto handle : { childOut, childErr, childIn })
+            if (handle != nullptr)
+                CloseHandle (handle);
     }
 
     ~ActiveProcess()
@@ -451,11 +489,9 @@ public:
             CloseHandle (processInfo.hProcess);
         }
 
-        if (readPipe != nullptr)
-            CloseHandle (readPipe);
-
-        if (writePipe != nullptr)
-            CloseHandle (writePipe);
+        for (auto handle : { outputPipe, errorPipe, inputPipe })
+            if (handle != nullptr)
+                CloseHandle (handle);
     }
 
     bool isRunning() const noexcept
@@ -463,15 +499,101 @@ public:
         return WaitForSingleObject (processInfo.hProcess, 0) != WAIT_OBJECT_0;
     }
 
-    int read (void* dest, int numNeeded) const noexcept
+    int read (void* dest, int numNeeded) const noexcept         { return readFrom (outputPipe, dest, numNeeded); }
+    int readError (void* dest, int numNeeded) const noexcept    { return readFrom (errorPipe, dest, numNeeded); }
+
+    /*  Reads whatever is waiting in one of the pipes without blocking. Returns the number of
+        bytes read, or -1 if the pipe has been closed.
+    */
+    int readAvailable (bool fromErrorPipe, void* dest, int maxBytes) const noexcept
+    {
+        auto pipe = fromErrorPipe ? errorPipe : outputPipe;
+        DWORD available = 0;
+
+        if (pipe == nullptr || ! PeekNamedPipe (pipe, nullptr, 0, nullptr, &available, nullptr))
+            return -1;
+
+        if (available == 0)
+            return 0;
+
+        DWORD numRead = 0;
+
+        if (! ReadFile (pipe, dest, (DWORD) jmin ((int) available, maxBytes), &numRead, nullptr))
+            return -1;
+
+        return (int) numRead;
+    }
+
+    int write (const void* source, int numBytes) const noexcept
+    {
+        if (inputPipe == nullptr)
+            return -1;
+
+        int total = 0;
+
+        while (total < numBytes)
+        {
+            DWORD numWritten = 0;
+
+            if (! WriteFile (inputPipe, addBytesToPointer (source, total), (DWORD) (numBytes - total), &numWritten, nullptr))
+                return -1;
+
+            total += (int) numWritten;
+        }
+
+        return total;
+    }
+
+    void closeInput() noexcept
+    {
+        if (inputPipe != nullptr)
+            CloseHandle (std::exchange (inputPipe, nullptr));
+    }
+
+    bool killProcess() const noexcept
+    {
+        return TerminateProcess (processInfo.hProcess, 0) != FALSE;
+    }
+
+    uint32 getExitCode() const noexcept
+    {
+        DWORD exitCode = 0;
+        GetExitCodeProcess (processInfo.hProcess, &exitCode);
+        return (uint32) exitCode;
+    }
+
+    bool ok = false;
+
+private:
+    HANDLE outputPipe = nullptr, errorPipe = nullptr, inputPipe = nullptr;
+    PROCESS_INFORMATION processInfo;
+
+    static bool createPipe (HANDLE& parentEnd, HANDLE& childEnd, bool childReads) noexcept
+    {
+        SECURITY_ATTRIBUTES securityAtts = {};
+        securityAtts.nLength = sizeof (securityAtts);
+        securityAtts.bInheritHandle = TRUE;
+
+        HANDLE readEnd = nullptr, writeEnd = nullptr;
+
+        if (! CreatePipe (&readEnd, &writeEnd, &securityAtts, 0))
+            return false;
+
+        parentEnd = childReads ? writeEnd : readEnd;
+        childEnd  = childReads ? readEnd : writeEnd;
+
+        return SetHandleInformation (parentEnd, HANDLE_FLAG_INHERIT, 0) != FALSE;
+    }
+
+    int readFrom (HANDLE pipe, void* dest, int numNeeded) const noexcept
     {
         int total = 0;
 
-        while (ok && numNeeded > 0)
+        while (ok && pipe != nullptr && numNeeded > 0)
         {
             DWORD available = 0;
 
-            if (! PeekNamedPipe ((HANDLE) readPipe, nullptr, 0, nullptr, &available, nullptr))
+            if (! PeekNamedPipe (pipe, nullptr, 0, nullptr, &available, nullptr))
                 break;
 
             const int numToDo = jmin ((int) available, numNeeded);
@@ -486,7 +608,7 @@ public:
             else
             {
                 DWORD numRead = 0;
-                if (! ReadFile ((HANDLE) readPipe, dest, (DWORD) numToDo, &numRead, nullptr))
+                if (! ReadFile (pipe, dest, (DWORD) numToDo, &numRead, nullptr))
                     break;
 
                 total += (int) numRead;
@@ -498,24 +620,6 @@ public:
         return total;
     }
 
-    bool killProcess() const noexcept
-    {
-        return TerminateProcess (processInfo.hProcess, 0) != FALSE;
-    }
-
-    uint32 getExitCode() const noexcept
-    {
-        DWORD exitCode = 0;
-        GetExitCodeProcess (processInfo.hProcess, &exitCode);
-        return (uint32) exitCode;
-    }
-
-    bool ok;
-
-private:
-    HANDLE readPipe, writePipe;
-    PROCESS_INFORMATION processInfo;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
 
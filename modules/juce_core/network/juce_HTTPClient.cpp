@@ -0,0 +1,1533 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct HTTPClient::Helpers
+{
+    struct Request  : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<Request>;
+
+        Request (HTTPClient::RequestID idToUse, const URL& urlToUse, const URL::InputStreamOptions& optionsToUse)
+            : id (idToUse),
+              url (urlToUse),
+              options (optionsToUse),
+              host (urlToUse.getDomain())
+        {
+        }
+
+        // Called when the headers of the reply have arrived. Returning false abandons the request.
+        virtual bool responseStarted (int statusCode, const StringPairArray& headers, int64 totalLength) = 0;
+
+        // Called as the body of the reply arrives. Returning false abandons the request.
+        virtual bool dataReceived (const void* data, size_t numBytes) = 0;
+
+        // Called exactly once, when the request has finished for whatever reason.
+        virtual void requestFinished (bool failed) = 0;
+
+        bool isCancelled() const noexcept      { return cancelled; }
+
+        void cancel()
+        {
+            cancelled = true;
+
+            // the callbacks are made with this lock held, so this waits for any that are running
+            const ScopedLock sl (callbackLock);
+        }
+
+        const HTTPClient::RequestID id;
+        const URL url;
+        const URL::InputStreamOptions options;
+        const String host;
+
+    protected:
+        std::atomic<bool> cancelled { false };
+        CriticalSection callbackLock;
+    };
+
+    //==============================================================================
+    struct FetchRequest  : public Request
+    {
+        FetchRequest (HTTPClient::RequestID idToUse, const URL& urlToUse,
+                      const URL::InputStreamOptions& optionsToUse, HTTPClient::Callback callbackToUse)
+            : Request (idToUse, urlToUse, optionsToUse),
+              callback (std::move (callbackToUse))
+        {
+        }
+
+        bool responseStarted (int statusCode, const StringPairArray& headers, int64 totalLength) override
+        {
+            response.statusCode = statusCode;
+            response.headers = headers;
+
+            if (totalLength > 0)
+                body.preallocate ((size_t) totalLength);
+
+            return true;
+        }
+
+        bool dataReceived (const void* data, size_t numBytes) override
+        {
+            return ! isCancelled() && body.write (data, numBytes);
+        }
+
+        void requestFinished (bool failed) override
+        {
+            body.flush();
+            response.failed = failed;
+
+            const ScopedLock sl (callbackLock);
+
+            if (! isCancelled() && callback != nullptr)
+                callback (response);
+        }
+
+        HTTPClient::Response response;
+        MemoryOutputStream body { response.data, false };
+        const HTTPClient::Callback callback;
+    };
+
+    //==============================================================================
+    struct DownloadRequest;
+
+    class ClientDownloadTask  : public URL::DownloadTask
+    {
+    public:
+        explicit ClientDownloadTask (DownloadRequest&);
+        ~ClientDownloadTask() override;
+
+        void setResponse (int statusCode, int64 numDownloaded, int64 totalLength) noexcept
+        {
+            httpCode = statusCode;
+            downloaded = numDownloaded;
+            contentLength = totalLength;
+        }
+
+        void setProgress (int64 numDownloaded) noexcept     { downloaded = numDownloaded; }
+
+        void setFinished (bool hadError) noexcept
+        {
+            error = hadError;
+            finished = true;
+        }
+
+    private:
+        ReferenceCountedObjectPtr<DownloadRequest> request;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ClientDownloadTask)
+    };
+
+    struct DownloadRequest  : public Request
+    {
+        DownloadRequest (HTTPClient::RequestID idToUse, const URL& urlToUse,
+                         const ResumableDownloadTarget& targetToUse,
+                         std::unique_ptr<FileOutputStream> streamToUse,
+                         const URL::DownloadTaskOptions& taskOptions)
+            : Request (idToUse, urlToUse, createOptions (targetToUse, taskOptions)),
+              target (targetToUse),
+              fileStream (std::move (streamToUse)),
+              listener (taskOptions.listener)
+        {
+            jassert (fileStream != nullptr);
+        }
+
+        static URL::InputStreamOptions createOptions (const ResumableDownloadTarget& target,
+                                                      const URL::DownloadTaskOptions& taskOptions)
+        {
+            return URL::InputStreamOptions (taskOptions.usePost ? URL::ParameterHandling::inPostData
+                                                                : URL::ParameterHandling::inAddress)
+                     .withExtraHeaders (target.addRangeHeader (taskOptions.extraHeaders));
+        }
+
+        bool responseStarted (int statusCode, const StringPairArray& headers, int64 totalLength) override
+        {
+            action = target.prepareForResponse (*fileStream, statusCode, headers);
+            downloaded = target.resumePosition;
+            contentLength = action == ResumableDownloadTarget::Action::alreadyComplete ? downloaded
+                                                                                      : target.getTotalLength (totalLength);
+
+            const ScopedLock sl (callbackLock);
+
+            if (task != nullptr)
+                task->setResponse (statusCode, downloaded, contentLength);
+
+            return action != ResumableDownloadTarget::Action::fail;
+        }
+
+        bool dataReceived (const void* data, size_t numBytes) override
+        {
+            if (action == ResumableDownloadTarget::Action::alreadyComplete)
+                return true;
+
+            if (isCancelled() || ! fileStream->write (data, numBytes))
+                return false;
+
+            downloaded += (int64) numBytes;
+
+            const ScopedLock sl (callbackLock);
+
+            if (task != nullptr)
+            {
+                task->setProgress (downloaded);
+
+                if (listener != nullptr && ! isCancelled())
+                    listener->progress (task, downloaded, contentLength);
+            }
+
+            return true;
+        }
+
+        void requestFinished (bool failed) override
+        {
+            fileStream.reset();
+
+            auto error = failed
+                           || isCancelled()
+                           || action == ResumableDownloadTarget::Action::fail
+                           || (contentLength > 0 && downloaded < contentLength);
+
+            const ScopedLock sl (callbackLock);
+
+            if (task != nullptr)
+            {
+                task->setFinished (error);
+
+                if (listener != nullptr && ! isCancelled())
+                    listener->finished (task, ! error);
+            }
+        }
+
+        void setTask (ClientDownloadTask* newTask)
+        {
+            if (newTask == nullptr)
+                cancelled = true;
+
+            const ScopedLock sl (callbackLock);
+            task = newTask;
+        }
+
+        ResumableDownloadTarget target;
+        std::unique_ptr<FileOutputStream> fileStream;
+        URL::DownloadTask::Listener* const listener;
+        ClientDownloadTask* task = nullptr;
+        ResumableDownloadTarget::Action action = ResumableDownloadTarget::Action::fail;
+        int64 downloaded = 0, contentLength = -1;
+    };
+
+    //==============================================================================
+    struct Backend
+    {
+        using FinishedCallback = std::function<void (Request&, bool failed)>;
+
+        explicit Backend (FinishedCallback callback)  : requestFinished (std::move (callback)) {}
+        virtual ~Backend() = default;
+
+        // Starts a request, or queues it up to be started later
+        virtual void start (Request::Ptr) = 0;
+
+        // Interrupts a request that has been cancelled, so that it finishes as soon as possible
+        virtual void abort (Request&) = 0;
+
+        const FinishedCallback requestFinished;
+    };
+
+    //==============================================================================
+    /*  Runs each request on a worker thread using an ordinary WebInputStream. */
+    class ThreadedBackend  : public Backend
+    {
+    public:
+        ThreadedBackend (const HTTPClient::Options& optionsToUse, FinishedCallback callback)
+            : Backend (std::move (callback)),
+              options (optionsToUse)
+        {
+        }
+
+        ~ThreadedBackend() override
+        {
+            {
+                const ScopedLock sl (lock);
+
+                for (auto* worker : workers)
+                    worker->signalThreadShouldExit();
+
+                for (auto& active : activeStreams)
+                    active.second->cancel();
+            }
+
+            for (auto* worker : workers)
+            {
+                worker->notify();
+                worker->waitForThreadToExit (-1);
+            }
+
+            for (auto& request : pending)
+                requestFinished (*request, true);
+        }
+
+        void start (Request::Ptr request) override
+        {
+            const ScopedLock sl (lock);
+            pending.add (request);
+
+            if (workers.size() < options.maxParallelRequests && workers.size() - numBusyWorkers < pending.size())
+                workers.add (new Worker (*this))->startThread();
+
+            notifyWorkers();
+        }
+
+        void abort (Request& request) override
+        {
+            Request::Ptr removed;
+
+            {
+                const ScopedLock sl (lock);
+
+                auto active = activeStreams.find (&request);
+
+                if (active != activeStreams.end())
+                    active->second->cancel();
+
+                auto index = pending.indexOf (&request);
+
+                if (index >= 0)
+                    removed = pending.removeAndReturn (index);
+            }
+
+            if (removed != nullptr)
+                requestFinished (*removed, true);
+        }
+
+    private:
+        //==============================================================================
+        struct Worker  : public Thread
+        {
+            explicit Worker (ThreadedBackend& b)  : Thread ("JUCE HTTP client"), backend (b) {}
+
+            void run() override
+            {
+                while (! threadShouldExit())
+                {
+                    if (auto request = backend.takeNextRequest())
+                        backend.perform (*request);
+                    else
+                        wait (-1);
+                }
+            }
+
+            ThreadedBackend& backend;
+        };
+
+        struct ProgressCallbackCaller  : public WebInputStream::Listener
+        {
+            explicit ProgressCallbackCaller (std::function<bool (int, int)> cb)  : callback (std::move (cb)) {}
+
+            bool postDataSendProgress (WebInputStream&, int bytesSent, int totalBytes) override
+            {
+                return callback (bytesSent, totalBytes);
+            }
+
+            std::function<bool (int, int)> callback;
+        };
+
+        Request::Ptr takeNextRequest()
+        {
+            const ScopedLock sl (lock);
+
+            for (int i = 0; i < pending.size(); ++i)
+            {
+                auto& numForHost = numRequestsPerHost[pending.getUnchecked (i)->host];
+
+                if (numForHost < options.maxConnectionsPerHost)
+                {
+                    ++numForHost;
+                    ++numBusyWorkers;
+                    return pending.removeAndReturn (i);
+                }
+            }
+
+            return nullptr;
+        }
+
+        void perform (Request& request)
+        {
+            auto failed = true;
+
+            if (! request.isCancelled())
+            {
+                auto stream = URLHelpers::createWebInputStream (request.url, request.options);
+
+                {
+                    const ScopedLock sl (lock);
+                    activeStreams[&request] = stream.get();
+                }
+
+                // this needs checking again, in case it was cancelled before the stream was registered
+                if (! request.isCancelled())
+                    failed = ! transfer (request, *stream);
+
+                const ScopedLock sl (lock);
+                activeStreams.erase (&request);
+            }
+
+            {
+                const ScopedLock sl (lock);
+
+                if (--numRequestsPerHost[request.host] <= 0)
+                    numRequestsPerHost.erase (request.host);
+
+                --numBusyWorkers;
+
+                // another request to the same host may now be able to start
+                notifyWorkers();
+            }
+
+            requestFinished (request, failed);
+        }
+
+        static bool transfer (Request& request, WebInputStream& stream)
+        {
+            std::unique_ptr<ProgressCallbackCaller> progressCaller;
+
+            if (auto progressCallback = request.options.getProgressCallback())
+                progressCaller = std::make_unique<ProgressCallbackCaller> (progressCallback);
+
+            if (! stream.connect (progressCaller.get()) || stream.isError() || request.isCancelled())
+                return false;
+
+            auto totalLength = stream.getTotalLength();
+
+            if (! request.responseStarted (stream.getStatusCode(), stream.getResponseHeaders(), totalLength))
+                return false;
+
+            constexpr int bufferSize = 0x8000;
+            HeapBlock<char> buffer (bufferSize);
+            int64 numReceived = 0;
+
+            while (! stream.isExhausted())
+            {
+                // don't ask for more than the reply holds, or the read will wait for data that never comes
+                auto numToRead = totalLength < 0 ? bufferSize
+                                                 : (int) jmin ((int64) bufferSize, totalLength - numReceived);
+
+                if (numToRead <= 0)
+                    break;
+
+                auto numRead = stream.read (buffer, numToRead);
+
+                if (request.isCancelled() || numRead < 0)
+                    return false;
+
+                if (numRead == 0)
+                    break;
+
+                if (! request.dataReceived (buffer, (size_t) numRead))
+                    return false;
+
+                numReceived += numRead;
+            }
+
+            return totalLength < 0 || numReceived >= totalLength;
+        }
+
+        void notifyWorkers()
+        {
+            for (auto* worker : workers)
+                worker->notify();
+        }
+
+        //==============================================================================
+        const HTTPClient::Options options;
+        CriticalSection lock;
+        OwnedArray<Worker> workers;
+        ReferenceCountedArray<Request> pending;
+        std::map<Request*, WebInputStream*> activeStreams;
+        std::map<String, int> numRequestsPerHost;
+        int numBusyWorkers = 0;
+    };
+
+   #if JUCE_USE_CURL && (JUCE_LINUX || JUCE_BSD)
+    //==============================================================================
+    /*  Runs all the requests on one thread using a curl multi handle, which keeps a pool
+        of connections that are reused between requests, and multiplexes requests over
+        HTTP/2 connections.
+    */
+    class CurlBackend  : public Backend,
+                         private Thread
+    {
+    public:
+        CurlBackend (const HTTPClient::Options& optionsToUse, FinishedCallback callback, std::unique_ptr<CURLSymbols> symbolsToUse)
+            : Backend (std::move (callback)),
+              Thread ("JUCE HTTP client"),
+              options (optionsToUse),
+              symbols (std::move (symbolsToUse))
+        {
+            {
+                const ScopedLock sl (CURLSymbols::getLibcurlLock());
+                multi = symbols->curl_multi_init();
+            }
+
+            if (multi != nullptr)
+            {
+                symbols->curl_multi_setopt (multi, CURLMOPT_PIPELINING, options.allowHTTP2 ? (long) CURLPIPE_MULTIPLEX : (long) CURLPIPE_NOTHING);
+                symbols->curl_multi_setopt (multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long) options.maxConnectionsPerHost);
+                symbols->curl_multi_setopt (multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long) options.maxParallelRequests);
+            }
+
+            if (pipe (wakeupPipe) == 0)
+            {
+                for (auto fd : wakeupPipe)
+                    fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) | O_NONBLOCK);
+            }
+            else
+            {
+                wakeupPipe[0] = wakeupPipe[1] = -1;
+            }
+        }
+
+        ~CurlBackend() override
+        {
+            signalThreadShouldExit();
+            wake();
+            waitForThreadToExit (-1);
+
+            // if the thread never ran, there may be some requests left
+            for (auto& request : pending)
+                requestFinished (*request, true);
+
+            if (multi != nullptr)
+            {
+                const ScopedLock sl (CURLSymbols::getLibcurlLock());
+                symbols->curl_multi_cleanup (multi);
+            }
+
+            for (auto fd : wakeupPipe)
+                if (fd >= 0)
+                    ::close (fd);
+        }
+
+        static std::unique_ptr<Backend> create (const HTTPClient::Options& options, FinishedCallback callback)
+        {
+            if (auto symbols = CURLSymbols::create())
+            {
+                auto backend = std::make_unique<CurlBackend> (options, std::move (callback), std::move (symbols));
+
+                if (backend->multi != nullptr && backend->wakeupPipe[0] >= 0)
+                    return backend;
+            }
+
+            return nullptr;
+        }
+
+        void start (Request::Ptr request) override
+        {
+            const ScopedLock sl (lock);
+            pending.add (request);
+
+            if (! isThreadRunning())
+                startThread();
+
+            wake();
+        }
+
+        void abort (Request& request) override
+        {
+            Request::Ptr removed;
+
+            {
+                const ScopedLock sl (lock);
+                auto index = pending.indexOf (&request);
+
+                if (index >= 0)
+                    removed = pending.removeAndReturn (index);
+            }
+
+            if (removed != nullptr)
+                requestFinished (*removed, true);
+            else
+                wake();
+        }
+
+    private:
+        //==============================================================================
+        struct Transfer
+        {
+            Transfer (CurlBackend& b, Request::Ptr r)  : backend (b), request (std::move (r)) {}
+
+            CurlBackend& backend;
+            Request::Ptr request;
+            CURL* handle = nullptr;
+            struct curl_slist* headerList = nullptr;
+            MemoryBlock postData;
+            String responseHeaders;
+            bool started = false, accepted = false;
+        };
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                startPendingTransfers();
+
+                int numRunning = 0;
+                symbols->curl_multi_perform (multi, &numRunning);
+
+                collectFinishedTransfers();
+                removeCancelledTransfers();
+                waitForActivity();
+            }
+
+            while (! transfers.empty())
+                removeTransfer (transfers.size() - 1, true);
+
+            const ScopedLock sl (lock);
+
+            for (auto& request : pending)
+                requestFinished (*request, true);
+
+            pending.clear();
+        }
+
+        void wake()
+        {
+            const char c = 0;
+            ignoreUnused (::write (wakeupPipe[1], &c, 1));
+        }
+
+        void waitForActivity()
+        {
+            struct curl_waitfd wakeup;
+            wakeup.fd = wakeupPipe[0];
+            wakeup.events = CURL_WAIT_POLLIN;
+            wakeup.revents = 0;
+
+            int numFds = 0;
+            symbols->curl_multi_wait (multi, &wakeup, 1, transfers.empty() ? 1000 : 100, &numFds);
+
+            if (wakeup.revents != 0)
+            {
+                char buffer[64];
+
+                while (::read (wakeupPipe[0], buffer, sizeof (buffer)) > 0)
+                {}
+            }
+        }
+
+        //==============================================================================
+        void startPendingTransfers()
+        {
+            for (;;)
+            {
+                Request::Ptr request;
+
+                {
+                    const ScopedLock sl (lock);
+
+                    if (pending.isEmpty() || (int) transfers.size() >= options.maxParallelRequests)
+                        return;
+
+                    request = pending.removeAndReturn (0);
+                }
+
+                auto transfer = std::make_unique<Transfer> (*this, request);
+
+                if (! request->isCancelled()
+                     && setUp (*transfer)
+                     && symbols->curl_multi_add_handle (multi, transfer->handle) == CURLM_OK)
+                {
+                    transfers.push_back (std::move (transfer));
+                }
+                else
+                {
+                    cleanUp (*transfer);
+                    requestFinished (*request, true);
+                }
+            }
+        }
+
+        bool setUp (Transfer& transfer)
+        {
+            transfer.handle = symbols->curl_easy_init();
+
+            if (transfer.handle == nullptr)
+                return false;
+
+            const auto& url = transfer.request->url;
+            const auto& requestOptions = transfer.request->options;
+            const auto addParametersToBody = requestOptions.getParameterHandling() == URL::ParameterHandling::inPostData;
+
+            auto headers = requestOptions.getExtraHeaders();
+
+            if (headers.isNotEmpty() && ! headers.endsWithChar ('\n'))
+                headers << "\r\n";
+
+            {
+                auto headersWithBody = headers;
+                MemoryBlock body;
+                WebInputStream::createHeadersAndPostData (url, headersWithBody, body, addParametersToBody);
+
+                if (addParametersToBody || ! body.isEmpty())
+                {
+                    headers = headersWithBody;
+                    transfer.postData = std::move (body);
+                }
+            }
+
+            const auto hasBody = addParametersToBody || ! transfer.postData.isEmpty();
+            const auto address = url.toString (! addParametersToBody);
+            const auto requestCmd = requestOptions.getHttpRequestCmd();
+            const auto maxRedirects = requestOptions.getNumRedirectsToFollow();
+            const auto timeOutMs = requestOptions.getConnectionTimeoutMs();
+
+            auto* versionInfo = symbols->curl_version_info (CURLVERSION_NOW);
+            const auto userAgent = String ("curl/") + (versionInfo != nullptr ? versionInfo->version : "");
+
+            auto* handle = transfer.handle;
+
+            if (symbols->curl_easy_setopt (handle, CURLOPT_URL, address.toRawUTF8()) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_WRITEDATA, &transfer) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, writeCallback) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_HEADERDATA, &transfer) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_HEADERFUNCTION, headerCallback) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_NOSIGNAL, 1L) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_MAXREDIRS, (long) maxRedirects) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_FOLLOWLOCATION, maxRedirects > 0 ? 1L : 0L) != CURLE_OK
+                || symbols->curl_easy_setopt (handle, CURLOPT_USERAGENT, userAgent.toRawUTF8()) != CURLE_OK)
+                return false;
+
+            if (options.allowHTTP2)
+            {
+                // ask to wait for an existing connection that can be multiplexed, rather than opening another one
+                if (symbols->curl_easy_setopt (handle, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS) != CURLE_OK
+                    || symbols->curl_easy_setopt (handle, CURLOPT_PIPEWAIT, 1L) != CURLE_OK)
+                    return false;
+            }
+
+            if (hasBody)
+            {
+                if (symbols->curl_easy_setopt (handle, CURLOPT_POST, 1L) != CURLE_OK
+                    || symbols->curl_easy_setopt (handle, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t) transfer.postData.getSize()) != CURLE_OK
+                    || symbols->curl_easy_setopt (handle, CURLOPT_POSTFIELDS, transfer.postData.getData()) != CURLE_OK)
+                    return false;
+            }
+
+            const auto hasSpecialRequestCmd = requestCmd.isNotEmpty() && requestCmd != (hasBody ? "POST" : "GET");
+
+            if (hasSpecialRequestCmd)
+                if (symbols->curl_easy_setopt (handle, CURLOPT_CUSTOMREQUEST, requestCmd.toRawUTF8()) != CURLE_OK)
+                    return false;
+
+            if (timeOutMs > 0)
+                if (symbols->curl_easy_setopt (handle, CURLOPT_CONNECTTIMEOUT_MS, (long) timeOutMs) != CURLE_OK)
+                    return false;
+
+            for (auto& line : StringArray::fromLines (headers))
+            {
+                if (line.isNotEmpty())
+                {
+                    transfer.headerList = symbols->curl_slist_append (transfer.headerList, line.toRawUTF8());
+
+                    if (transfer.headerList == nullptr)
+                        return false;
+                }
+            }
+
+            if (transfer.headerList != nullptr)
+                if (symbols->curl_easy_setopt (handle, CURLOPT_HTTPHEADER, transfer.headerList) != CURLE_OK)
+                    return false;
+
+            return true;
+        }
+
+        void cleanUp (Transfer& transfer)
+        {
+            if (transfer.handle != nullptr)
+                symbols->curl_easy_cleanup (transfer.handle);
+
+            if (transfer.headerList != nullptr)
+                symbols->curl_slist_free_all (transfer.headerList);
+
+            transfer.handle = nullptr;
+            transfer.headerList = nullptr;
+        }
+
+        void removeTransfer (size_t index, bool failed)
+        {
+            auto transfer = std::move (transfers[index]);
+            transfers.erase (transfers.begin() + (std::ptrdiff_t) index);
+
+            symbols->curl_multi_remove_handle (multi, transfer->handle);
+            cleanUp (*transfer);
+            requestFinished (*transfer->request, failed);
+        }
+
+        void collectFinishedTransfers()
+        {
+            int numMessagesLeft = 0;
+
+            while (auto* message = symbols->curl_multi_info_read (multi, &numMessagesLeft))
+            {
+                if (message->msg != CURLMSG_DONE)
+                    continue;
+
+                const auto result = message->data.result;
+                auto* handle = message->easy_handle;
+
+                for (size_t i = 0; i < transfers.size(); ++i)
+                {
+                    auto& transfer = *transfers[i];
+
+                    if (transfer.handle == handle)
+                    {
+                        // a reply with no body won't have been started by the write callback
+                        auto failed = result != CURLE_OK || ! startResponse (transfer);
+
+                        removeTransfer (i, failed);
+                        break;
+                    }
+                }
+            }
+        }
+
+        void removeCancelledTransfers()
+        {
+            for (auto i = (int) transfers.size(); --i >= 0;)
+                if (transfers[(size_t) i]->request->isCancelled())
+                    removeTransfer ((size_t) i, true);
+        }
+
+        //==============================================================================
+        bool startResponse (Transfer& transfer)
+        {
+            if (! transfer.started)
+            {
+                transfer.started = true;
+
+                long statusCode = 0;
+                symbols->curl_easy_getinfo (transfer.handle, CURLINFO_RESPONSE_CODE, &statusCode);
+
+               #if LIBCURL_VERSION_NUM >= 0x073700
+                curl_off_t length = -1;
+                symbols->curl_easy_getinfo (transfer.handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+               #else
+                double length = -1.0;
+                symbols->curl_easy_getinfo (transfer.handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &length);
+               #endif
+
+                transfer.accepted = transfer.request->responseStarted ((int) statusCode,
+                                                                       WebInputStream::parseHttpHeaders (transfer.responseHeaders),
+                                                                       length < 0 ? -1 : (int64) length);
+            }
+
+            return transfer.accepted;
+        }
+
+        static size_t writeCallback (char* data, size_t size, size_t numItems, void* userData)
+        {
+            auto& transfer = *static_cast<Transfer*> (userData);
+            const auto numBytes = size * numItems;
+
+            if (transfer.request->isCancelled()
+                 || ! transfer.backend.startResponse (transfer)
+                 || ! transfer.request->dataReceived (data, numBytes))
+                return 0;
+
+            return numBytes;
+        }
+
+        static size_t headerCallback (char* data, size_t size, size_t numItems, void* userData)
+        {
+            auto& transfer = *static_cast<Transfer*> (userData);
+            const auto numBytes = size * numItems;
+            const String header (data, numBytes);
+
+            // each response that we're redirected through starts with a new status line
+            if (! header.contains (":") && header.startsWithIgnoreCase ("HTTP/"))
+                transfer.responseHeaders = header;
+            else
+                transfer.responseHeaders += header;
+
+            return numBytes;
+        }
+
+        //==============================================================================
+        const HTTPClient::Options options;
+        std::unique_ptr<CURLSymbols> symbols;
+        CURLM* multi = nullptr;
+        int wakeupPipe[2] = { -1, -1 };
+
+        CriticalSection lock;
+        ReferenceCountedArray<Request> pending;
+        std::vector<std::unique_ptr<Transfer>> transfers;
+    };
+   #endif
+
+    static std::unique_ptr<Backend> createBackend (const HTTPClient::Options& options, Backend::FinishedCallback callback)
+    {
+       #if JUCE_USE_CURL && (JUCE_LINUX || JUCE_BSD)
+        if (auto backend = CurlBackend::create (options, callback))
+            return backend;
+       #endif
+
+        return std::make_unique<ThreadedBackend> (options, std::move (callback));
+    }
+};
+
+HTTPClient::Helpers::ClientDownloadTask::ClientDownloadTask (DownloadRequest& r)  : request (&r)
+{
+    targetLocation = r.target.target;
+    request->setTask (this);
+}
+
+HTTPClient::Helpers::ClientDownloadTask::~ClientDownloadTask()
+{
+    // the download carries on until the client notices that it has been cancelled
+    request->setTask (nullptr);
+}
+
+//==============================================================================
+class HTTPClient::Pimpl
+{
+public:
+    using Request = Helpers::Request;
+
+    explicit Pimpl (const Options& optionsToUse)
+        : options (sanitise (optionsToUse))
+    {
+        backend = Helpers::createBackend (options, [this] (Request& request, bool failed)
+        {
+            requestFinished (request, failed);
+        });
+
+        idle.signal();
+    }
+
+    ~Pimpl()
+    {
+        cancelAll();
+        backend.reset();
+    }
+
+    RequestID getNextID() noexcept
+    {
+        return ++lastID;
+    }
+
+    void start (Request::Ptr request)
+    {
+        {
+            const ScopedLock sl (lock);
+            requests.add (request);
+            idle.reset();
+        }
+
+        backend->start (request);
+    }
+
+    bool cancel (RequestID requestID)
+    {
+        Request::Ptr request;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto* r : requests)
+            {
+                if (r->id == requestID)
+                {
+                    request = r;
+                    break;
+                }
+            }
+        }
+
+        if (request == nullptr)
+            return false;
+
+        cancel (*request);
+        return true;
+    }
+
+    void cancelAll()
+    {
+        ReferenceCountedArray<Request> requestsToCancel;
+
+        {
+            const ScopedLock sl (lock);
+            requestsToCancel = requests;
+        }
+
+        for (auto* request : requestsToCancel)
+            cancel (*request);
+    }
+
+    int getNumRequestsInProgress() const
+    {
+        const ScopedLock sl (lock);
+        return requests.size();
+    }
+
+    bool waitUntilIdle (int timeoutMilliseconds) const
+    {
+        return idle.wait (timeoutMilliseconds);
+    }
+
+private:
+    static Options sanitise (Options o)
+    {
+        o.maxParallelRequests = jmax (1, o.maxParallelRequests);
+        o.maxConnectionsPerHost = jmax (1, o.maxConnectionsPerHost);
+        return o;
+    }
+
+    void cancel (Request& request)
+    {
+        request.cancel();
+        backend->abort (request);
+    }
+
+    void requestFinished (Request& request, bool failed)
+    {
+        request.requestFinished (failed);
+
+        const ScopedLock sl (lock);
+        requests.removeObject (&request);
+
+        if (requests.isEmpty())
+            idle.signal();
+    }
+
+    const Options options;
+    std::atomic<RequestID> lastID { 0 };
+    CriticalSection lock;
+    ReferenceCountedArray<Request> requests;
+    WaitableEvent idle { true };
+    std::unique_ptr<Helpers::Backend> backend;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+HTTPClient::HTTPClient()  : HTTPClient (Options()) {}
+HTTPClient::HTTPClient (const Options& options)  : pimpl (std::make_unique<Pimpl> (options)) {}
+HTTPClient::~HTTPClient() = default;
+
+HTTPClient::RequestID HTTPClient::fetch (const URL& url, Callback callback, const URL::InputStreamOptions& options)
+{
+    auto id = pimpl->getNextID();
+    pimpl->start (new Helpers::FetchRequest (id, url, options, std::move (callback)));
+    return id;
+}
+
+std::unique_ptr<URL::DownloadTask> HTTPClient::downloadToFile (const URL& url,
+                                                               const File& targetLocation,
+                                                               const URL::DownloadTaskOptions& options)
+{
+    ResumableDownloadTarget target (targetLocation, options.resumeExisting);
+    auto stream = target.createOutputStream (0x8000);
+
+    if (stream == nullptr)
+        return nullptr;
+
+    auto* request = new Helpers::DownloadRequest (pimpl->getNextID(), url, target, std::move (stream), options);
+    std::unique_ptr<URL::DownloadTask> task = std::make_unique<Helpers::ClientDownloadTask> (*request);
+    pimpl->start (request);
+    return task;
+}
+
+bool HTTPClient::cancel (RequestID requestID)                    { return pimpl->cancel (requestID); }
+void HTTPClient::cancelAll()                                     { pimpl->cancelAll(); }
+int HTTPClient::getNumRequestsInProgress() const                 { return pimpl->getNumRequestsInProgress(); }
+bool HTTPClient::waitUntilIdle (int timeoutMilliseconds) const   { return pimpl->waitUntilIdle (timeoutMilliseconds); }
+
+bool HTTPClient::sharesConnections() noexcept
+{
+   #if JUCE_USE_CURL && (JUCE_LINUX || JUCE_BSD)
+    return CURLSymbols::create() != nullptr;
+   #else
+    return false;
+   #endif
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct HTTPClientTests  : public UnitTest
+{
+    HTTPClientTests()
+        : UnitTest ("HTTPClient", UnitTestCategories::networking)
+    {
+    }
+
+    //==============================================================================
+    /*  A tiny HTTP/1.1 server that keeps its connections alive and understands range requests. */
+    class TestServer  : private Thread
+    {
+    public:
+        TestServer()  : Thread ("HTTPClient test server")
+        {
+            listener.createListener (0, "127.0.0.1");
+            startThread();
+        }
+
+        ~TestServer() override
+        {
+            signalThreadShouldExit();
+            listener.close();
+            stopThread (5000);
+
+            // the connections take the lock, so this mustn't hold it while they stop
+            connections.clear();
+        }
+
+        int getPort() const                     { return listener.getBoundPort(); }
+        int getNumConnections() const noexcept  { return numConnections; }
+        int getMaxSimultaneousRequests() const
+        {
+            const ScopedLock sl (lock);
+            return maxSimultaneousRequests;
+        }
+
+        static MemoryBlock getTestData()
+        {
+            MemoryBlock data (100000);
+
+            for (size_t i = 0; i < data.getSize(); ++i)
+                data[i] = (char) (i % 251);
+
+            return data;
+        }
+
+    private:
+        struct Connection  : public Thread
+        {
+            Connection (TestServer& s, StreamingSocket* socketToUse)
+                : Thread ("HTTPClient test connection"), server (s), socket (socketToUse)
+            {
+                startThread();
+            }
+
+            ~Connection() override
+            {
+                stopThread (5000);
+            }
+
+            void run() override
+            {
+                while (! threadShouldExit())
+                {
+                    auto request = readRequest();
+
+                    if (request.isEmpty() || ! respond (request))
+                        break;
+                }
+
+                socket->close();
+            }
+
+            String readRequest()
+            {
+                MemoryOutputStream request;
+
+                while (! threadShouldExit())
+                {
+                    auto ready = socket->waitUntilReady (true, 20);
+
+                    if (ready < 0)
+                        return {};
+
+                    if (ready == 0)
+                        continue;
+
+                    char c;
+
+                    if (socket->read (&c, 1, true) != 1)
+                        return {};
+
+                    // skip any blank lines that were left over from the previous request
+                    if (request.getDataSize() == 0 && (c == '\r' || c == '\n'))
+                        continue;
+
+                    request.writeByte (c);
+
+                    if (request.getDataSize() >= 4 && String (request.toString()).endsWith ("\r\n\r\n"))
+                        return request.toString();
+                }
+
+                return {};
+            }
+
+            bool respond (const String& request)
+            {
+                const auto path = request.fromFirstOccurrenceOf (" ", false, false).upToFirstOccurrenceOf (" ", false, false);
+                StringPairArray headers;
+
+                for (auto& line : StringArray::fromLines (request))
+                    if (line.contains (": "))
+                        headers.set (line.upToFirstOccurrenceOf (": ", false, false),
+                                     line.fromFirstOccurrenceOf (": ", false, false));
+
+                // the connection is left for the client to close, even if it asked for it to be closed,
+                // so that nothing it sent is left unread, which would make the socket reset
+                return sendResponse (path, headers);
+            }
+
+            bool sendResponse (const String& path, const StringPairArray& requestHeaders)
+            {
+                if (path == "/hello")
+                    return send (200, "OK", {}, "Hello", 5);
+
+                if (path == "/delay")
+                {
+                    {
+                        const ScopedLock sl (server.lock);
+                        server.maxSimultaneousRequests = jmax (server.maxSimultaneousRequests, ++server.numActiveRequests);
+                    }
+
+                    Thread::sleep (20);
+
+                    {
+                        // this is counted before the reply is sent, as the client may start another request as soon as it arrives
+                        const ScopedLock sl (server.lock);
+                        --server.numActiveRequests;
+                    }
+
+                    return send (200, "OK", {}, "Hello", 5);
+                }
+
+                if (path == "/slow")
+                {
+                    for (int i = 0; i < 500 && ! threadShouldExit(); ++i)
+                        Thread::sleep (10);
+
+                    return send (200, "OK", {}, "Hello", 5);
+                }
+
+                if (path == "/data")
+                {
+                    const auto data = getTestData();
+                    const auto size = (int64) data.getSize();
+                    const auto range = requestHeaders["Range"];
+
+                    if (range.startsWith ("bytes="))
+                    {
+                        const auto start = range.fromFirstOccurrenceOf ("=", false, false).getLargeIntValue();
+
+                        if (start >= size)
+                            return send (416, "Range Not Satisfiable", "Content-Range: bytes */" + String (size) + "\r\n", nullptr, 0);
+
+                        return send (206, "Partial Content",
+                                     "Content-Range: bytes " + String (start) + "-" + String (size - 1) + "/" + String (size) + "\r\n",
+                                     addBytesToPointer (data.getData(), start), (size_t) (size - start));
+                    }
+
+                    return send (200, "OK", {}, data.getData(), data.getSize());
+                }
+
+                return send (404, "Not Found", {}, "Not found", 9);
+            }
+
+            bool send (int status, const String& reason, const String& extraHeaders, const void* body, size_t bodySize)
+            {
+                MemoryOutputStream response;
+                response << "HTTP/1.1 " << status << " " << reason << "\r\n"
+                         << "Content-Length: " << (int64) bodySize << "\r\n"
+                         << "Connection: keep-alive\r\n"
+                         << extraHeaders
+                         << "\r\n";
+
+                if (bodySize > 0)
+                    response.write (body, bodySize);
+
+                for (size_t pos = 0; pos < response.getDataSize();)
+                {
+                    auto numWritten = socket->write (addBytesToPointer (response.getData(), pos), (int) (response.getDataSize() - pos));
+
+                    if (numWritten <= 0)
+                        return false;
+
+                    pos += (size_t) numWritten;
+                }
+
+                return true;
+            }
+
+            TestServer& server;
+            std::unique_ptr<StreamingSocket> socket;
+        };
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                std::unique_ptr<StreamingSocket> socket (listener.waitForNextConnection());
+
+                if (socket == nullptr || threadShouldExit())
+                    break;
+
+                ++numConnections;
+
+                const ScopedLock sl (lock);
+                connections.add (new Connection (*this, socket.release()));
+            }
+        }
+
+        StreamingSocket listener;
+        CriticalSection lock;
+        OwnedArray<Connection> connections;
+        std::atomic<int> numConnections { 0 };
+        int numActiveRequests = 0, maxSimultaneousRequests = 0;
+    };
+
+    //==============================================================================
+    struct DownloadListener  : public URL::DownloadTaskListener
+    {
+        void finished (URL::DownloadTask*, bool success) override
+        {
+            succeeded = success;
+            done.signal();
+        }
+
+        WaitableEvent done;
+        std::atomic<bool> succeeded { false };
+    };
+
+    static MemoryBlock loadFile (const File& file)
+    {
+        MemoryBlock data;
+        file.loadFileAsData (data);
+        return data;
+    }
+
+    //==============================================================================
+    void runTest() override
+    {
+        TestServer server;
+
+        const auto getURL = [&server] (const String& path)
+        {
+            return URL ("http://127.0.0.1:" + String (server.getPort()) + path);
+        };
+
+        beginTest ("Fetching");
+        {
+            HTTPClient client;
+            HTTPClient::Response response;
+            WaitableEvent done;
+
+            client.fetch (getURL ("/hello"), [&] (const HTTPClient::Response& r)
+            {
+                response = r;
+                done.signal();
+            });
+
+            expect (done.wait (10000));
+            expect (client.waitUntilIdle (10000));
+            expectEquals (client.getNumRequestsInProgress(), 0);
+
+            expect (response.wasSuccessful());
+            expectEquals (response.statusCode, 200);
+            expectEquals (response.getDataAsString(), String ("Hello"));
+            expectEquals (response.headers["Content-Length"], String ("5"));
+        }
+
+        beginTest ("Error responses");
+        {
+            HTTPClient client;
+            HTTPClient::Response response;
+
+            client.fetch (getURL ("/missing"), [&] (const HTTPClient::Response& r) { response = r; });
+
+            expect (client.waitUntilIdle (10000));
+            expect (! response.failed);
+            expect (! response.wasSuccessful());
+            expectEquals (response.statusCode, 404);
+            expectEquals (response.getDataAsString(), String ("Not found"));
+        }
+
+        beginTest ("Failed connections");
+        {
+            int closedPort;
+
+            {
+                StreamingSocket socket;
+                expect (socket.createListener (0, "127.0.0.1"));
+                closedPort = socket.getBoundPort();
+            }
+
+            HTTPClient client;
+            HTTPClient::Response response;
+
+            client.fetch (URL ("http://127.0.0.1:" + String (closedPort) + "/hello"),
+                          [&] (const HTTPClient::Response& r) { response = r; });
+
+            expect (client.waitUntilIdle (10000));
+            expect (response.failed);
+            expect (! response.wasSuccessful());
+        }
+
+        beginTest ("Many requests at once");
+        {
+            constexpr int numRequests = 40;
+            const auto numConnectionsBefore = server.getNumConnections();
+
+            HTTPClient client (HTTPClient::Options().withMaxParallelRequests (8)
+                                                    .withMaxConnectionsPerHost (2));
+            std::atomic<int> numSucceeded { 0 };
+
+            for (int i = 0; i < numRequests; ++i)
+            {
+                client.fetch (getURL ("/delay"), [&] (const HTTPClient::Response& r)
+                {
+                    if (r.wasSuccessful() && r.getDataAsString() == "Hello")
+                        ++numSucceeded;
+                });
+            }
+
+            expect (client.waitUntilIdle (30000));
+            expectEquals (numSucceeded.load(), numRequests);
+            expect (server.getMaxSimultaneousRequests() <= 2);
+
+            if (HTTPClient::sharesConnections())
+                expect (server.getNumConnections() - numConnectionsBefore <= 2);
+        }
+
+        beginTest ("Cancelling requests");
+        {
+            HTTPClient client;
+            std::atomic<bool> called { false };
+
+            auto id = client.fetch (getURL ("/slow"), [&] (const HTTPClient::Response&) { called = true; });
+
+            Thread::sleep (50);
+            expect (client.cancel (id));
+            expect (client.waitUntilIdle (2000));
+            expect (! called);
+            expect (! client.cancel (id));
+        }
+
+        beginTest ("Deleting a client cancels its requests");
+        {
+            std::atomic<bool> called { false };
+
+            {
+                HTTPClient client;
+
+                for (int i = 0; i < 4; ++i)
+                    client.fetch (getURL ("/slow"), [&] (const HTTPClient::Response&) { called = true; });
+
+                Thread::sleep (50);
+            }
+
+            expect (! called);
+        }
+
+        const auto testData = TestServer::getTestData();
+
+        beginTest ("Downloading to a file");
+        {
+            TemporaryFile temp;
+            expect (temp.getFile().replaceWithText ("some old contents"));
+
+            HTTPClient client;
+            DownloadListener listener;
+            auto task = client.downloadToFile (getURL ("/data"), temp.getFile(),
+                                               URL::DownloadTaskOptions().withListener (&listener));
+
+            expect (task != nullptr);
+            expect (listener.done.wait (10000));
+            expect (listener.succeeded);
+            expect (task->isFinished() && ! task->hadError());
+            expectEquals (task->statusCode(), 200);
+            expectEquals (task->getLengthDownloaded(), (int64) testData.getSize());
+            expect (loadFile (temp.getFile()) == testData);
+        }
+
+        beginTest ("Resuming downloads");
+        {
+            TemporaryFile temp;
+            expect (temp.getFile().replaceWithData (testData.getData(), 30000));
+
+            HTTPClient client;
+            const auto options = URL::DownloadTaskOptions().withResumeExisting (true);
+
+            {
+                DownloadListener listener;
+                auto task = client.downloadToFile (getURL ("/data"), temp.getFile(), options.withListener (&listener));
+
+                expect (listener.done.wait (10000));
+                expect (listener.succeeded);
+                expectEquals (task->statusCode(), 206);
+                expectEquals (task->getTotalLength(), (int64) testData.getSize());
+                expectEquals (task->getLengthDownloaded(), (int64) testData.getSize());
+                expect (loadFile (temp.getFile()) == testData);
+            }
+
+            {
+                DownloadListener listener;
+                auto task = client.downloadToFile (getURL ("/data"), temp.getFile(), options.withListener (&listener));
+
+                expect (listener.done.wait (10000));
+                expect (listener.succeeded);
+                expectEquals (task->statusCode(), 416);
+                expect (loadFile (temp.getFile()) == testData);
+            }
+
+            {
+                // a server that doesn't understand the range sends the whole file again
+                expect (temp.getFile().replaceWithData (testData.getData(), 30000));
+
+                DownloadListener listener;
+                auto task = client.downloadToFile (getURL ("/hello"), temp.getFile(), options.withListener (&listener));
+
+                expect (listener.done.wait (10000));
+                expect (listener.succeeded);
+                expectEquals (task->statusCode(), 200);
+                expectEquals (temp.getFile().loadFileAsString(), String ("Hello"));
+            }
+
+           #if ! JUCE_IOS
+            {
+                expect (temp.getFile().replaceWithData (testData.getData(), 30000));
+
+                DownloadListener listener;
+                auto task = getURL ("/data").downloadToFile (temp.getFile(), options.withListener (&listener));
+
+                expect (task != nullptr);
+                expect (listener.done.wait (10000));
+                expect (listener.succeeded);
+                expectEquals (task->statusCode(), 206);
+                expect (loadFile (temp.getFile()) == testData);
+            }
+           #endif
+        }
+    }
+};
+
+static HTTPClientTests httpClientTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs many HTTP requests at once on a small number of background threads.
+
+    Instead of creating a WebInputStream for each request and blocking until it has
+    finished, you hand the requests to a client, which queues them up and calls your
+    callback as each one completes. The client limits the number of requests that run
+    at the same time, as well as the number that run against any one host, so you can
+    queue thousands of small downloads without flooding a server.
+
+    On Linux and BSD builds that use libcurl (see JUCE_USE_CURL), all the requests share
+    a single connection pool. Connections are kept alive and reused between requests,
+    and requests to the same host are multiplexed over HTTP/2 where the server supports
+    it. On other platforms each request makes its own connection using the system's
+    normal HTTP code, so you still get the parallelism and the queueing, but not the
+    connection reuse.
+
+    @code
+    HTTPClient client;
+
+    for (auto& url : urls)
+    {
+        client.fetch (url, [] (const HTTPClient::Response& response)
+        {
+            if (response.wasSuccessful())
+                DBG (response.getDataAsString());
+        });
+    }
+
+    client.waitUntilIdle();
+    @endcode
+
+    @see URL, WebInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  HTTPClient
+{
+public:
+    //==============================================================================
+    /** Holds the settings that an HTTPClient is created with. */
+    class Options
+    {
+    public:
+        int maxParallelRequests = 8;
+        int maxConnectionsPerHost = 6;
+        bool allowHTTP2 = true;
+
+        /** Specifies the maximum number of requests that can be running at the same time.
+            Any others wait in a queue until one of the running requests has finished.
+        */
+        [[nodiscard]] auto withMaxParallelRequests (int value) const    { return with (&Options::maxParallelRequests, value); }
+
+        /** Specifies the maximum number of requests that can be running against one host
+            at the same time.
+        */
+        [[nodiscard]] auto withMaxConnectionsPerHost (int value) const  { return with (&Options::maxConnectionsPerHost, value); }
+
+        /** Specifies whether HTTP/2 may be used for https URLs, when the backend supports it. */
+        [[nodiscard]] auto withAllowHTTP2 (bool value) const            { return with (&Options::allowHTTP2, value); }
+
+    private:
+        template <typename Member, typename Value>
+        [[nodiscard]] Options with (Member&& member, Value&& value) const
+        {
+            auto copy = *this;
+            copy.*member = std::forward<Value> (value);
+            return copy;
+        }
+    };
+
+    //==============================================================================
+    /** Creates a client with the default options.
+
+        The client's threads are started when they're first needed.
+    */
+    HTTPClient();
+
+    /** Creates a client with some custom options. */
+    explicit HTTPClient (const Options& options);
+
+    /** Destructor.
+
+        Any requests that are still queued or running are cancelled, and their callbacks
+        won't be called. This waits for any callbacks that are running to return.
+    */
+    ~HTTPClient();
+
+    //==============================================================================
+    /** The result of a request that was started with fetch(). */
+    struct Response
+    {
+        /** The status code that the server replied with, or 0 if there was no reply. */
+        int statusCode = 0;
+
+        /** The headers that the server replied with. */
+        StringPairArray headers;
+
+        /** The body of the reply. */
+        MemoryBlock data;
+
+        /** True if the connection couldn't be made, or was lost before the whole reply
+            had arrived.
+        */
+        bool failed = false;
+
+        /** Returns true if the whole reply arrived and the status code is in the 2xx range. */
+        bool wasSuccessful() const noexcept     { return ! failed && statusCode >= 200 && statusCode < 300; }
+
+        /** Returns the body of the reply as a string. */
+        String getDataAsString() const          { return data.toString(); }
+    };
+
+    /** A number that identifies a request, which can be used to cancel it. */
+    using RequestID = int64;
+
+    /** The function that is called when a request started with fetch() has finished. */
+    using Callback = std::function<void (const Response&)>;
+
+    //==============================================================================
+    /** Queues a request and returns immediately.
+
+        When the reply has arrived, or the request has failed, the callback is called on
+        one of the client's threads.
+
+        The options are used in the same way as for URL::createInputStream(), except
+        that the response headers and status code are returned in the Response rather
+        than through the options. The progress callback is only used by the clients that
+        don't share a connection pool.
+
+        @see cancel
+    */
+    RequestID fetch (const URL& url,
+                     Callback callback,
+                     const URL::InputStreamOptions& options = URL::InputStreamOptions (URL::ParameterHandling::inAddress));
+
+    /** Queues a download to a file and returns immediately.
+
+        This works like URL::downloadToFile(), but the download is run by this client,
+        so it shares the client's limits and, where possible, its connections. The
+        listener in the options is called on one of the client's threads. Deleting the
+        task cancels the download.
+
+        If the options ask for an existing file to be resumed, only the missing part of
+        the file is requested from the server.
+
+        The task may outlive the client, in which case the download is cancelled when the
+        client is deleted.
+    */
+    std::unique_ptr<URL::DownloadTask> downloadToFile (const URL& url,
+                                                       const File& targetLocation,
+                                                       const URL::DownloadTaskOptions& options = {});
+
+    //==============================================================================
+    /** Cancels a request that was started with fetch().
+
+        Once this returns, the callback for the request won't be called. If the callback
+        is running on another thread, this waits for it to return.
+
+        Returns false if the request had already finished.
+    */
+    bool cancel (RequestID requestID);
+
+    /** Cancels all the requests and downloads that are queued or running. */
+    void cancelAll();
+
+    /** Returns the number of requests and downloads that are queued or running. */
+    int getNumRequestsInProgress() const;
+
+    /** Waits until all the requests and downloads have finished.
+
+        Returns false if the timeout expired first. A negative timeout waits forever.
+    */
+    bool waitUntilIdle (int timeoutMilliseconds = -1) const;
+
+    /** Returns true if the clients on this platform reuse connections between requests
+        and can multiplex requests over HTTP/2.
+    */
+    static bool sharesConnections() noexcept;
+
+private:
+    //==============================================================================
+    struct Helpers;
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HTTPClient)
+};
+
+} // namespace juce
@@ -0,0 +1,1124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if ! JUCE_WASM
+
+//==============================================================================
+namespace SharedMemoryPipeHelpers
+{
+    static constexpr uint32 headerMagic = 0x4a534d50, headerVersion = 1;
+
+    // Each message is stored as a record: an 8-byte header holding the size and some
+    // flags, followed by the data, padded to a multiple of 8 bytes. A record never
+    // wraps around the end of the buffer; if there isn't room, a wrap marker fills the
+    // end and the record starts again at the beginning.
+    enum RecordFlags : uint32
+    {
+        wholeMessage          = 0,
+        wrapMarker            = 1,
+        moreToFollow          = 2,  // the message continues in the next record
+        discardPartialMessage = 4   // the writer gave up half-way through a message
+    };
+
+    enum SignalType
+    {
+        dataAvailable  = 0,
+        spaceAvailable = 1
+    };
+
+    static constexpr size_t recordHeaderSize = 8;
+
+    static size_t getRecordSize (size_t payloadSize) noexcept
+    {
+        return recordHeaderSize + ((payloadSize + 7) & ~(size_t) 7);
+    }
+
+    // Each direction has a single writer and a single reader, which only ever move
+    // their own position forwards. The sequence numbers are what a waiting thread
+    // sleeps on, and the flags let the other side skip waking it when nobody's waiting.
+    struct Ring
+    {
+        alignas (64) std::atomic<uint64> writePosition;
+        alignas (64) std::atomic<uint64> readPosition;
+        alignas (64) std::atomic<uint32> dataSequence, readerIsWaiting;
+        alignas (64) std::atomic<uint32> spaceSequence, writerIsWaiting;
+    };
+
+    // The creator writes into ring 0 and the process that opens the pipe writes into ring 1
+    struct SharedHeader
+    {
+        std::atomic<uint32> magic, version;
+        uint64 capacity;
+        std::atomic<int64> processIDs[2];
+        std::atomic<uint32> closed[2];
+        Ring rings[2];
+    };
+
+    static_assert (std::atomic<uint32>::is_always_lock_free && std::atomic<uint64>::is_always_lock_free,
+                   "The shared memory needs atomics that work across processes");
+
+    static constexpr size_t dataOffset = (sizeof (SharedHeader) + 63) & ~(size_t) 63;
+
+    //==============================================================================
+   #if JUCE_WINDOWS
+    static int64 getCurrentProcessID()  { return (int64) GetCurrentProcessId(); }
+
+    static bool isProcessRunning (int64 processID)
+    {
+        auto h = OpenProcess (SYNCHRONIZE, FALSE, (DWORD) processID);
+
+        if (h == nullptr)
+            return GetLastError() == ERROR_ACCESS_DENIED;
+
+        auto running = WaitForSingleObject (h, 0) == WAIT_TIMEOUT;
+        CloseHandle (h);
+        return running;
+    }
+
+    static String getSharedName (const String& pipeName)
+    {
+        return "Local\\juce_shm_" + File::createLegalFileName (pipeName);
+    }
+
+    class SharedRegion
+    {
+    public:
+        SharedRegion() = default;
+
+        ~SharedRegion()
+        {
+            if (data != nullptr)     UnmapViewOfFile (data);
+            if (mapping != nullptr)  CloseHandle (mapping);
+        }
+
+        bool create (const String& pipeName, size_t numBytes, bool)
+        {
+            // a mapping only exists while a process has it open, so an existing one can't be replaced
+            mapping = CreateFileMappingW (INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                          (DWORD) ((uint64) numBytes >> 32), (DWORD) numBytes,
+                                          getSharedName (pipeName).toWideCharPointer());
+
+            return mapping != nullptr && GetLastError() != ERROR_ALREADY_EXISTS && map();
+        }
+
+        bool open (const String& pipeName)
+        {
+            mapping = OpenFileMappingW (FILE_MAP_ALL_ACCESS, FALSE, getSharedName (pipeName).toWideCharPointer());
+            return mapping != nullptr && map();
+        }
+
+        void* getData() const noexcept      { return data; }
+        size_t getSize() const noexcept     { return size; }
+
+    private:
+        HANDLE mapping = nullptr;
+        void* data = nullptr;
+        size_t size = 0;
+
+        bool map()
+        {
+            data = MapViewOfFile (mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+
+            if (data == nullptr)
+                return false;
+
+            MEMORY_BASIC_INFORMATION info;
+
+            if (VirtualQuery (data, &info, sizeof (info)) == 0)
+                return false;
+
+            size = (size_t) info.RegionSize;
+            return true;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (SharedRegion)
+    };
+
+    // a named auto-reset event for each direction and type of signal
+    class Signals
+    {
+    public:
+        Signals() = default;
+
+        ~Signals()
+        {
+            for (auto e : events)
+                if (e != nullptr)
+                    CloseHandle (e);
+        }
+
+        bool create (const String& pipeName, bool)
+        {
+            for (int i = 0; i < 4; ++i)
+                if ((events[i] = CreateEventW (nullptr, FALSE, FALSE, (getSharedName (pipeName) + "_" + String (i)).toWideCharPointer())) == nullptr)
+                    return false;
+
+            return true;
+        }
+
+        void wait (int ring, SignalType type, std::atomic<uint32>&, uint32, int timeoutMs)
+        {
+            WaitForSingleObject (events[ring * 2 + (int) type], (DWORD) timeoutMs);
+        }
+
+        void notify (int ring, SignalType type, std::atomic<uint32>&)
+        {
+            SetEvent (events[ring * 2 + (int) type]);
+        }
+
+    private:
+        HANDLE events[4] = {};
+
+        JUCE_DECLARE_NON_COPYABLE (Signals)
+    };
+
+    //==============================================================================
+   #else
+    static int64 getCurrentProcessID()  { return (int64) getpid(); }
+
+    static bool isProcessRunning (int64 processID)
+    {
+        return kill ((pid_t) processID, 0) == 0 || errno == EPERM;
+    }
+
+   #if JUCE_ANDROID
+    // Android doesn't provide POSIX shared memory
+    class SharedRegion
+    {
+    public:
+        bool create (const String&, size_t, bool)   { return false; }
+        bool open (const String&)                   { return false; }
+        void* getData() const noexcept              { return nullptr; }
+        size_t getSize() const noexcept             { return 0; }
+    };
+   #else
+    class SharedRegion
+    {
+    public:
+        SharedRegion() = default;
+
+        ~SharedRegion()
+        {
+            if (data != nullptr)
+                munmap (data, size);
+
+            if (fd >= 0)
+                ::close (fd);
+
+            // the memory stays mapped in the other process until it closes its end
+            if (isOwner)
+                shm_unlink (name.toRawUTF8());
+        }
+
+        bool create (const String& pipeName, size_t numBytes, bool mustNotExist)
+        {
+            name = "/" + File::createLegalFileName (pipeName);
+            fd = shm_open (name.toRawUTF8(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+            if (fd < 0 && errno == EEXIST && ! mustNotExist)
+            {
+                // probably left behind by a process that crashed
+                shm_unlink (name.toRawUTF8());
+                fd = shm_open (name.toRawUTF8(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            }
+
+            if (fd < 0)
+                return false;
+
+            isOwner = true;
+            return ftruncate (fd, (off_t) numBytes) == 0 && map (numBytes);
+        }
+
+        bool open (const String& pipeName)
+        {
+            name = "/" + File::createLegalFileName (pipeName);
+            fd = shm_open (name.toRawUTF8(), O_RDWR, 0600);
+
+            if (fd < 0)
+                return false;
+
+            struct stat info;
+            return fstat (fd, &info) == 0 && map ((size_t) info.st_size);
+        }
+
+        void* getData() const noexcept      { return data; }
+        size_t getSize() const noexcept     { return size; }
+
+    private:
+        String name;
+        int fd = -1;
+        void* data = nullptr;
+        size_t size = 0;
+        bool isOwner = false;
+
+        bool map (size_t numBytes)
+        {
+            if (numBytes < dataOffset)
+                return false;
+
+            auto* d = mmap (nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+            if (d == MAP_FAILED)
+                return false;
+
+            data = d;
+            size = numBytes;
+            return true;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (SharedRegion)
+    };
+   #endif
+
+   #if JUCE_LINUX
+    // a futex on the sequence number in the shared memory
+    class Signals
+    {
+    public:
+        bool create (const String&, bool)   { return true; }
+
+        void wait (int, SignalType, std::atomic<uint32>& word, uint32 expectedValue, int timeoutMs)
+        {
+            struct timespec timeout { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+            syscall (SYS_futex, reinterpret_cast<uint32*> (&word), FUTEX_WAIT, expectedValue, &timeout, nullptr, 0);
+        }
+
+        void notify (int, SignalType, std::atomic<uint32>& word)
+        {
+            syscall (SYS_futex, reinterpret_cast<uint32*> (&word), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+        }
+    };
+   #else
+    // Without a futex that works between processes, a byte is sent down a NamedPipe
+    // to wake up the other end. Each process only reads one kind of signal from each
+    // pipe, so the direction is implied.
+    class Signals
+    {
+    public:
+        bool create (const String& pipeName, bool isCreator)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                auto name = pipeName + "_" + String (i);
+
+                if (! (isCreator ? pipes[i].createNewPipe (name) : pipes[i].openExisting (name)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        void wait (int, SignalType type, std::atomic<uint32>&, uint32, int timeoutMs)
+        {
+            char byte;
+            pipes[(int) type].read (&byte, 1, timeoutMs);
+        }
+
+        void notify (int, SignalType type, std::atomic<uint32>&)
+        {
+            const char byte = 0;
+            pipes[(int) type].write (&byte, 1, 100);
+        }
+
+    private:
+        NamedPipe pipes[2];
+    };
+   #endif
+   #endif
+}
+
+//==============================================================================
+class SharedMemoryPipe::Pimpl
+{
+public:
+    explicit Pimpl (const std::atomic<bool>& closingFlag)  : isClosing (closingFlag) {}
+
+    ~Pimpl()
+    {
+        if (header != nullptr)
+            markClosed();
+    }
+
+    bool create (const String& pipeName, int bufferSize, bool mustNotExist)
+    {
+        side = 0;
+        capacity = (size_t) nextPowerOfTwo (jmax (4096, bufferSize));
+
+        if (! region.create (pipeName, SharedMemoryPipeHelpers::dataOffset + 2 * capacity, mustNotExist))
+            return false;
+
+        header = new (region.getData()) SharedMemoryPipeHelpers::SharedHeader();
+        header->capacity = capacity;
+        header->version = SharedMemoryPipeHelpers::headerVersion;
+        header->processIDs[0] = SharedMemoryPipeHelpers::getCurrentProcessID();
+
+        if (! signals.create (pipeName, true))
+            return false;
+
+        header->magic = SharedMemoryPipeHelpers::headerMagic;
+        return true;
+    }
+
+    bool open (const String& pipeName)
+    {
+        side = 1;
+
+        if (! region.open (pipeName))
+            return false;
+
+        auto* h = static_cast<SharedMemoryPipeHelpers::SharedHeader*> (region.getData());
+
+        if (h->magic != SharedMemoryPipeHelpers::headerMagic
+             || h->version != SharedMemoryPipeHelpers::headerVersion
+             || h->closed[0] != 0)
+            return false;
+
+        capacity = (size_t) h->capacity;
+
+        if (capacity < 4096 || ! isPowerOfTwo (capacity)
+             || region.getSize() < SharedMemoryPipeHelpers::dataOffset + 2 * capacity)
+            return false;
+
+        if (! signals.create (pipeName, false))
+            return false;
+
+        header = h;
+        header->processIDs[1] = SharedMemoryPipeHelpers::getCurrentProcessID();
+        return true;
+    }
+
+    bool isConnected() const
+    {
+        if (header == nullptr || header->closed[0] != 0 || header->closed[1] != 0)
+            return false;
+
+        if (! otherProcessHasStopped)
+        {
+            auto otherID = header->processIDs[1 - side].load();
+
+            if (otherID != 0 && ! SharedMemoryPipeHelpers::isProcessRunning (otherID))
+                otherProcessHasStopped = true;
+        }
+
+        return ! otherProcessHasStopped;
+    }
+
+    void markClosed()
+    {
+        header->closed[side] = 1;
+
+        // wake up anything that's waiting at either end
+        for (int ring = 0; ring < 2; ++ring)
+        {
+            auto& r = header->rings[ring];
+            ++r.dataSequence;
+            ++r.spaceSequence;
+            signals.notify (ring, SharedMemoryPipeHelpers::dataAvailable, r.dataSequence);
+            signals.notify (ring, SharedMemoryPipeHelpers::spaceAvailable, r.spaceSequence);
+        }
+    }
+
+    size_t getMaxMessageSize() const noexcept
+    {
+        return capacity / 2 - SharedMemoryPipeHelpers::recordHeaderSize;
+    }
+
+    //==============================================================================
+    bool write (const char* source, size_t numBytes, int timeOutMilliseconds)
+    {
+        const ScopedLock sl (writeLock);
+
+        if (! finishAbandonedMessage (timeOutMilliseconds))
+            return false;
+
+        for (bool isFirstPart = true;; isFirstPart = false)
+        {
+            auto numThisTime = jmin (numBytes, getMaxMessageSize());
+            auto* dest = reserve (numThisTime, timeOutMilliseconds);
+
+            if (dest == nullptr)
+            {
+                writerAbandonedMessage = ! isFirstPart;
+                return false;
+            }
+
+            memcpy (dest, source, numThisTime);
+            source += numThisTime;
+            numBytes -= numThisTime;
+
+            commit (numThisTime, numBytes > 0 ? SharedMemoryPipeHelpers::moreToFollow
+                                              : SharedMemoryPipeHelpers::wholeMessage);
+
+            if (numBytes == 0)
+                return true;
+        }
+    }
+
+    void* beginMessage (size_t numBytes, int timeOutMilliseconds)
+    {
+        writeLock.enter();
+
+        if (finishAbandonedMessage (timeOutMilliseconds))
+        {
+            if (auto* dest = reserve (numBytes, timeOutMilliseconds))
+            {
+                reservedPayloadSize = numBytes;
+                return dest;
+            }
+        }
+
+        writeLock.exit();
+        return nullptr;
+    }
+
+    void endMessage()
+    {
+        commit (reservedPayloadSize, SharedMemoryPipeHelpers::wholeMessage);
+        writeLock.exit();
+    }
+
+    //==============================================================================
+    bool read (MessageView& view, int timeOutMilliseconds)
+    {
+        for (;;)
+        {
+            auto* record = waitForRecord (timeOutMilliseconds);
+
+            if (record == nullptr)
+                return false;
+
+            auto* payload = record + SharedMemoryPipeHelpers::recordHeaderSize;
+
+            if ((currentRecordFlags & SharedMemoryPipeHelpers::discardPartialMessage) != 0)
+            {
+                partialMessage.reset();
+                releaseRecord();
+                continue;
+            }
+
+            if (currentRecordFlags == SharedMemoryPipeHelpers::wholeMessage && partialMessage.isEmpty())
+            {
+                view.data = payload;
+                view.size = currentRecordSize;
+                view.isInSharedMemory = true;
+                return true;
+            }
+
+            partialMessage.append (payload, currentRecordSize);
+            releaseRecord();
+
+            if ((currentRecordFlags & SharedMemoryPipeHelpers::moreToFollow) == 0)
+            {
+                view.reassembledMessage.swapWith (partialMessage);
+                partialMessage.reset();
+                view.data = view.reassembledMessage.getData();
+                view.size = view.reassembledMessage.getSize();
+                view.isInSharedMemory = false;
+                return true;
+            }
+        }
+    }
+
+    void releaseRecord()
+    {
+        auto& ring = header->rings[1 - side];
+        ring.readPosition = currentRecordPosition + SharedMemoryPipeHelpers::getRecordSize (currentRecordSize);
+        notify (1 - side, SharedMemoryPipeHelpers::spaceAvailable, ring.spaceSequence, ring.writerIsWaiting);
+    }
+
+    bool hasActiveView = false;
+
+private:
+    //==============================================================================
+    const std::atomic<bool>& isClosing;
+    SharedMemoryPipeHelpers::SharedRegion region;
+    SharedMemoryPipeHelpers::Signals signals;
+    SharedMemoryPipeHelpers::SharedHeader* header = nullptr;
+    size_t capacity = 0;
+    int side = 0;
+    mutable bool otherProcessHasStopped = false;
+
+    CriticalSection writeLock;
+    uint64 reservedPosition = 0;
+    char* reservedRecord = nullptr;
+    size_t reservedPayloadSize = 0;
+    bool writerAbandonedMessage = false;
+
+    uint64 currentRecordPosition = 0;
+    size_t currentRecordSize = 0;
+    uint32 currentRecordFlags = 0;
+    MemoryBlock partialMessage;
+
+    char* getRingData (int ring) const noexcept
+    {
+        return static_cast<char*> (region.getData()) + SharedMemoryPipeHelpers::dataOffset + (size_t) ring * capacity;
+    }
+
+    template <typename Condition>
+    bool waitFor (int ring, SharedMemoryPipeHelpers::SignalType type, std::atomic<uint32>& sequence,
+                  std::atomic<uint32>& waitingFlag, int timeOutMilliseconds, Condition&& isReady)
+    {
+        if (isReady())
+            return true;
+
+        auto endTime = Time::getMillisecondCounter() + (uint32) jmax (0, timeOutMilliseconds);
+
+        for (;;)
+        {
+            if (isClosing || ! isConnected())
+                return isReady();
+
+            // wake up now and then to check that the other process is still running
+            int waitTime = 100;
+
+            if (timeOutMilliseconds >= 0)
+            {
+                auto now = Time::getMillisecondCounter();
+
+                if (now >= endTime)
+                    return false;
+
+                waitTime = jmin (waitTime, (int) (endTime - now));
+            }
+
+            auto expectedSequence = sequence.load();
+            waitingFlag = 1;
+
+            if (isReady())
+            {
+                waitingFlag = 0;
+                return true;
+            }
+
+            signals.wait (ring, type, sequence, expectedSequence, waitTime);
+            waitingFlag = 0;
+
+            if (isReady())
+                return true;
+        }
+    }
+
+    void notify (int ring, SharedMemoryPipeHelpers::SignalType type,
+                 std::atomic<uint32>& sequence, std::atomic<uint32>& waitingFlag)
+    {
+        if (waitingFlag != 0)
+        {
+            ++sequence;
+            signals.notify (ring, type, sequence);
+        }
+    }
+
+    static void writeRecordHeader (char* dest, size_t payloadSize, uint32 flags) noexcept
+    {
+        const uint32 values[] = { (uint32) payloadSize, flags };
+        memcpy (dest, values, sizeof (values));
+    }
+
+    //==============================================================================
+    char* reserve (size_t payloadSize, int timeOutMilliseconds)
+    {
+        auto& ring = header->rings[side];
+        auto position = ring.writePosition.load (std::memory_order_relaxed);
+        auto index = (size_t) (position & (capacity - 1));
+        auto recordSize = SharedMemoryPipeHelpers::getRecordSize (payloadSize);
+        auto padding = index + recordSize > capacity ? capacity - index : (size_t) 0;
+
+        if (! waitFor (side, SharedMemoryPipeHelpers::spaceAvailable,
+                       ring.spaceSequence, ring.writerIsWaiting, timeOutMilliseconds,
+                       [&] { return capacity - (size_t) (position - ring.readPosition.load()) >= padding + recordSize; }))
+            return nullptr;
+
+        if (! isConnected())
+            return nullptr;
+
+        auto* data = getRingData (side);
+
+        if (padding > 0)
+        {
+            writeRecordHeader (data + index, 0, SharedMemoryPipeHelpers::wrapMarker);
+            position += padding;
+            index = 0;
+        }
+
+        reservedPosition = position;
+        reservedRecord = data + index;
+        return reservedRecord + SharedMemoryPipeHelpers::recordHeaderSize;
+    }
+
+    void commit (size_t payloadSize, uint32 flags)
+    {
+        auto& ring = header->rings[side];
+        writeRecordHeader (reservedRecord, payloadSize, flags);
+        ring.writePosition = reservedPosition + SharedMemoryPipeHelpers::getRecordSize (payloadSize);
+        notify (side, SharedMemoryPipeHelpers::dataAvailable, ring.dataSequence, ring.readerIsWaiting);
+    }
+
+    bool finishAbandonedMessage (int timeOutMilliseconds)
+    {
+        if (writerAbandonedMessage)
+        {
+            if (reserve (0, timeOutMilliseconds) == nullptr)
+                return false;
+
+            commit (0, SharedMemoryPipeHelpers::discardPartialMessage);
+            writerAbandonedMessage = false;
+        }
+
+        return true;
+    }
+
+    const char* waitForRecord (int timeOutMilliseconds)
+    {
+        auto& ring = header->rings[1 - side];
+        auto* data = getRingData (1 - side);
+
+        for (;;)
+        {
+            auto position = ring.readPosition.load (std::memory_order_relaxed);
+
+            if (! waitFor (1 - side, SharedMemoryPipeHelpers::dataAvailable,
+                           ring.dataSequence, ring.readerIsWaiting, timeOutMilliseconds,
+                           [&] { return ring.writePosition.load() != position; }))
+                return nullptr;
+
+            auto index = (size_t) (position & (capacity - 1));
+            uint32 values[2];
+            memcpy (values, data + index, sizeof (values));
+
+            if ((values[1] & SharedMemoryPipeHelpers::wrapMarker) != 0)
+            {
+                ring.readPosition = position + (capacity - index);
+                notify (1 - side, SharedMemoryPipeHelpers::spaceAvailable, ring.spaceSequence, ring.writerIsWaiting);
+                continue;
+            }
+
+            if (SharedMemoryPipeHelpers::getRecordSize (values[0]) > capacity - index)
+            {
+                // the other process has written rubbish, so there's no way to carry on
+                jassertfalse;
+                header->closed[side] = 1;
+                return nullptr;
+            }
+
+            currentRecordPosition = position;
+            currentRecordSize = values[0];
+            currentRecordFlags = values[1];
+            return data + index;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+SharedMemoryPipe::SharedMemoryPipe() {}
+
+SharedMemoryPipe::~SharedMemoryPipe()
+{
+    close();
+}
+
+bool SharedMemoryPipe::createNewPipe (const String& pipeName, int bufferSizeEachWay, bool mustNotExist)
+{
+    close();
+
+    const ScopedWriteLock sl (lock);
+    currentPipeName = pipeName;
+    return openInternal (pipeName, true, bufferSizeEachWay, mustNotExist);
+}
+
+bool SharedMemoryPipe::openExisting (const String& pipeName)
+{
+    close();
+
+    const ScopedWriteLock sl (lock);
+    currentPipeName = pipeName;
+    return openInternal (pipeName, false, 0, false);
+}
+
+bool SharedMemoryPipe::openInternal (const String& pipeName, bool createPipe, int bufferSize, bool mustNotExist)
+{
+    pimpl.reset (new Pimpl (isClosing));
+
+    if (createPipe ? pimpl->create (pipeName, bufferSize, mustNotExist)
+                   : pimpl->open (pipeName))
+        return true;
+
+    pimpl.reset();
+    return false;
+}
+
+void SharedMemoryPipe::close()
+{
+    {
+        const ScopedReadLock sl (lock);
+
+        if (pimpl == nullptr)
+            return;
+
+        // make any threads that are waiting give up, so that we can get the write lock
+        isClosing = true;
+        pimpl->markClosed();
+    }
+
+    {
+        const ScopedWriteLock sl (lock);
+
+        // any MessageView must be released before closing the pipe
+        jassert (pimpl == nullptr || ! pimpl->hasActiveView);
+
+        pimpl.reset();
+        isClosing = false;
+    }
+}
+
+bool SharedMemoryPipe::isOpen() const
+{
+    const ScopedReadLock sl (lock);
+    return pimpl != nullptr && pimpl->isConnected();
+}
+
+String SharedMemoryPipe::getName() const
+{
+    const ScopedReadLock sl (lock);
+    return currentPipeName;
+}
+
+int SharedMemoryPipe::getMaxMessageSize() const
+{
+    const ScopedReadLock sl (lock);
+    return pimpl != nullptr ? (int) jmin ((size_t) std::numeric_limits<int>::max(), pimpl->getMaxMessageSize()) : 0;
+}
+
+//==============================================================================
+bool SharedMemoryPipe::write (const void* sourceData, int numBytes, int timeOutMilliseconds)
+{
+    jassert (numBytes >= 0 && (sourceData != nullptr || numBytes == 0));
+
+    const ScopedReadLock sl (lock);
+    return pimpl != nullptr && numBytes >= 0
+            && pimpl->write (static_cast<const char*> (sourceData), (size_t) numBytes, timeOutMilliseconds);
+}
+
+void* SharedMemoryPipe::beginMessage (int numBytes, int timeOutMilliseconds)
+{
+    lock.enterRead();
+
+    if (pimpl != nullptr)
+    {
+        // use write() for messages bigger than this
+        jassert (isPositiveAndNotGreaterThan ((size_t) numBytes, pimpl->getMaxMessageSize()));
+
+        if (isPositiveAndNotGreaterThan ((size_t) numBytes, pimpl->getMaxMessageSize()))
+            if (auto* dest = pimpl->beginMessage ((size_t) numBytes, timeOutMilliseconds))
+                return dest;
+    }
+
+    lock.exitRead();
+    return nullptr;
+}
+
+void SharedMemoryPipe::endMessage()
+{
+    // this must follow a successful call to beginMessage()
+    jassert (pimpl != nullptr);
+
+    if (pimpl != nullptr)
+        pimpl->endMessage();
+
+    lock.exitRead();
+}
+
+//==============================================================================
+SharedMemoryPipe::MessageView SharedMemoryPipe::readMessage (int timeOutMilliseconds)
+{
+    MessageView view;
+    const ScopedReadLock sl (lock);
+
+    if (pimpl != nullptr)
+    {
+        // only one view can be active at a time, so release the last one first
+        jassert (! pimpl->hasActiveView);
+
+        if (! pimpl->hasActiveView && pimpl->read (view, timeOutMilliseconds))
+        {
+            view.owner = this;
+            pimpl->hasActiveView = true;
+        }
+    }
+
+    return view;
+}
+
+bool SharedMemoryPipe::readMessage (MemoryBlock& destData, int timeOutMilliseconds)
+{
+    auto view = readMessage (timeOutMilliseconds);
+
+    if (! view.isValid())
+        return false;
+
+    if (view.isInSharedMemory)
+        destData.replaceAll (view.getData(), view.getSize());
+    else
+        destData.swapWith (view.reassembledMessage);
+
+    return true;
+}
+
+//==============================================================================
+SharedMemoryPipe::MessageView::~MessageView()
+{
+    release();
+}
+
+SharedMemoryPipe::MessageView::MessageView (MessageView&& other) noexcept
+    : owner (std::exchange (other.owner, nullptr)),
+      data (std::exchange (other.data, nullptr)),
+      size (std::exchange (other.size, 0)),
+      isInSharedMemory (other.isInSharedMemory),
+      reassembledMessage (std::move (other.reassembledMessage))
+{
+    if (! isInSharedMemory && owner != nullptr)
+        data = reassembledMessage.getData();
+}
+
+SharedMemoryPipe::MessageView& SharedMemoryPipe::MessageView::operator= (MessageView&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        owner = std::exchange (other.owner, nullptr);
+        data = std::exchange (other.data, nullptr);
+        size = std::exchange (other.size, 0);
+        isInSharedMemory = other.isInSharedMemory;
+        reassembledMessage = std::move (other.reassembledMessage);
+
+        if (! isInSharedMemory && owner != nullptr)
+            data = reassembledMessage.getData();
+    }
+
+    return *this;
+}
+
+void SharedMemoryPipe::MessageView::release()
+{
+    if (owner != nullptr)
+    {
+        const ScopedReadLock sl (owner->lock);
+
+        if (auto* p = owner->pimpl.get())
+        {
+            if (isInSharedMemory)
+                p->releaseRecord();
+
+            p->hasActiveView = false;
+        }
+    }
+
+    owner = nullptr;
+    data = nullptr;
+    size = 0;
+    reassembledMessage.reset();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && ! JUCE_ANDROID
+
+class SharedMemoryPipeTests  : public UnitTest
+{
+public:
+    SharedMemoryPipeTests()
+        : UnitTest ("SharedMemoryPipe", UnitTestCategories::networking)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Opening and closing");
+        {
+            auto pipeName = getUniqueName();
+            SharedMemoryPipe creator, opener;
+
+            expect (! opener.openExisting (pipeName));
+            expect (creator.createNewPipe (pipeName, 4096));
+            expect (opener.openExisting (pipeName));
+            expect (creator.isOpen() && opener.isOpen());
+            expectEquals (creator.getMaxMessageSize(), 2048 - 8);
+            expectEquals (opener.getMaxMessageSize(), creator.getMaxMessageSize());
+            expect (! SharedMemoryPipe().createNewPipe (pipeName, 4096, true));
+
+            opener.close();
+            expect (! opener.isOpen());
+            expect (! creator.isOpen());
+        }
+
+        beginTest ("Messages both ways");
+        {
+            auto pipeName = getUniqueName();
+            SharedMemoryPipe creator, opener;
+            expect (creator.createNewPipe (pipeName, 8192));
+            expect (opener.openExisting (pipeName));
+
+            for (auto* p : { &creator, &opener })
+            {
+                auto& other = (p == &creator) ? opener : creator;
+
+                for (auto* text : { "hello", "", "a longer message than the first one" })
+                    expect (p->write (text, (int) strlen (text), 1000));
+
+                for (auto* text : { "hello", "", "a longer message than the first one" })
+                {
+                    MemoryBlock received;
+                    expect (other.readMessage (received, 1000));
+                    expect (received.toString() == text);
+                }
+
+                MemoryBlock received;
+                expect (! other.readMessage (received, 0));
+            }
+        }
+
+        beginTest ("Zero-copy messages");
+        {
+            auto pipeName = getUniqueName();
+            SharedMemoryPipe creator, opener;
+            expect (creator.createNewPipe (pipeName, 4096));
+            expect (opener.openExisting (pipeName));
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto size = 1 + (i * 37) % creator.getMaxMessageSize();
+
+                auto* dest = static_cast<uint8*> (creator.beginMessage (size, 1000));
+                expect (dest != nullptr);
+
+                for (int j = 0; j < size; ++j)
+                    dest[j] = (uint8) (i + j);
+
+                creator.endMessage();
+
+                auto view = opener.readMessage (1000);
+                expect (view.isValid());
+                expectEquals ((int) view.getSize(), size);
+
+                bool matches = true;
+
+                for (int j = 0; j < size; ++j)
+                    matches = matches && static_cast<const uint8*> (view.getData())[j] == (uint8) (i + j);
+
+                expect (matches);
+            }
+        }
+
+        beginTest ("Streaming between threads");
+        {
+            auto pipeName = getUniqueName();
+            SharedMemoryPipe creator, opener;
+            expect (creator.createNewPipe (pipeName, 4096));
+            expect (opener.openExisting (pipeName));
+
+            constexpr int numMessages = 3000;
+            auto seed = getRandom().nextInt64();
+            std::atomic<int> numCorrect { 0 };
+
+            Thread::launch ([&]
+            {
+                Random r (seed);
+                MemoryBlock received;
+
+                for (int i = 0; i < numMessages; ++i)
+                {
+                    if (! opener.readMessage (received, 5000))
+                        break;
+
+                    if (received == makeMessage (r))
+                        ++numCorrect;
+                }
+            });
+
+            Random r (seed);
+
+            // some of these are bigger than the whole buffer, so they have to be split up
+            for (int i = 0; i < numMessages; ++i)
+            {
+                auto message = makeMessage (r);
+                expect (creator.write (message.getData(), (int) message.getSize(), 5000));
+            }
+
+            for (int i = 0; i < 500 && numCorrect < numMessages; ++i)
+                Thread::sleep (10);
+
+            expectEquals (numCorrect.load(), numMessages);
+        }
+
+        beginTest ("Closing wakes up a waiting reader");
+        {
+            auto pipeName = getUniqueName();
+            SharedMemoryPipe creator, opener;
+            expect (creator.createNewPipe (pipeName, 4096));
+            expect (opener.openExisting (pipeName));
+
+            WaitableEvent finished;
+            std::atomic<bool> result { true };
+
+            Thread::launch ([&]
+            {
+                MemoryBlock received;
+                result = opener.readMessage (received, -1);
+                finished.signal();
+            });
+
+            Thread::sleep (50);
+            creator.close();
+            expect (finished.wait (2000));
+            expect (! result);
+            expect (! opener.isOpen());
+        }
+    }
+
+private:
+    String getUniqueName()
+    {
+        return "jt" + String::toHexString (getRandom().nextInt64());
+    }
+
+    static MemoryBlock makeMessage (Random& r)
+    {
+        MemoryBlock m ((size_t) (r.nextInt (10) == 0 ? r.nextInt (10000) : r.nextInt (300)));
+
+        for (auto& b : m)
+            b = (char) r.nextInt (256);
+
+        return m;
+    }
+};
+
+static SharedMemoryPipeTests sharedMemoryPipeTests;
+
+#endif
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A cross-process pipe that passes messages through shared memory.
+
+    Like a NamedPipe, one process creates the pipe, and another one opens it using
+    the same name. Each direction of the pipe is a ring buffer in a block of memory
+    that both processes can see, so a message is copied straight from the sender into
+    memory that the receiver can read, without the operating system copying it. When
+    a reader or writer has to wait, the other end wakes it up with a futex on Linux,
+    a named event on Windows, or a tiny NamedPipe message on other systems. Apart from
+    that, no system calls are needed, so the round-trip time is often a few microseconds.
+
+    Data is sent as whole messages rather than as a stream of bytes. Messages up to
+    getMaxMessageSize() bytes can be written into the buffer directly with
+    beginMessage() and read in place with readMessage(), so nothing needs to be copied
+    at all. Larger messages are split up when they're written and joined together
+    again when they're read.
+
+    Each direction is meant for a single reader. Several threads can write at once,
+    as each message is written in one go. The pipe also notices when the process at
+    the other end stops running, so isOpen() becomes false instead of the pipe
+    waiting forever.
+
+    This isn't available on Android.
+
+    @see NamedPipe, InterprocessConnection
+
+    @tags{Core}
+*/
+class JUCE_API  SharedMemoryPipe  final
+{
+public:
+    //==============================================================================
+    /** Creates a SharedMemoryPipe. */
+    SharedMemoryPipe();
+
+    /** Destructor. */
+    ~SharedMemoryPipe();
+
+    //==============================================================================
+    /** Tries to create a new pipe.
+
+        The bufferSizeEachWay is the number of bytes in each of the two ring buffers,
+        which is rounded up to a power of two. If mustNotExist is true, this fails if
+        a pipe with the same name already exists. Otherwise, a pipe that was left behind
+        by a process that crashed is replaced.
+
+        Keep the name short, as some systems only allow around 30 characters for a
+        shared memory name.
+
+        Returns true if it succeeds.
+    */
+    bool createNewPipe (const String& pipeName, int bufferSizeEachWay = 1024 * 1024, bool mustNotExist = false);
+
+    /** Tries to open a pipe that another process has created.
+        Returns true if it succeeds.
+    */
+    bool openExisting (const String& pipeName);
+
+    /** Closes the pipe, if it's open.
+
+        Any threads that are waiting to read from or write to the pipe return
+        straight away, and the other end of the pipe will see that it has been closed.
+        Any MessageView must be released before this is called.
+    */
+    void close();
+
+    /** True if the pipe is open, and the process at the other end hasn't closed it
+        or stopped running.
+    */
+    bool isOpen() const;
+
+    /** Returns the last name that was used to try to open this pipe. */
+    String getName() const;
+
+    /** Returns the size of the largest message that can be passed without being copied.
+
+        Larger messages can still be sent with write() and received with readMessage(),
+        but they'll be reassembled into a separate block of memory.
+    */
+    int getMaxMessageSize() const;
+
+    //==============================================================================
+    /** Sends a message.
+
+        This waits until there's room in the buffer and the message has been written.
+        If timeOutMilliseconds is less than zero, it will wait indefinitely, otherwise
+        this is the longest time it'll wait for space to become free.
+
+        Returns true if the whole message was sent.
+    */
+    bool write (const void* sourceData, int numBytes, int timeOutMilliseconds);
+
+    /** Starts a message that you fill in yourself, without copying it.
+
+        This waits until there's room in the buffer for the message, and returns a pointer
+        to the space in the shared memory that you should write it into. After filling it,
+        call endMessage() to send the message. No other thread can write to the pipe until
+        then, so be quick!
+
+        The size must not be more than getMaxMessageSize(). Returns nullptr if the pipe
+        isn't open, or if it timed out.
+    */
+    void* beginMessage (int numBytes, int timeOutMilliseconds);
+
+    /** Sends the message that was started with beginMessage(). */
+    void endMessage();
+
+    //==============================================================================
+    /** Gives access to a message that has been received, while it's still in the
+        shared memory.
+
+        Until the view is released or deleted, its space in the buffer can't be reused,
+        and no more messages can be read.
+
+        @see SharedMemoryPipe::readMessage
+    */
+    class JUCE_API  MessageView
+    {
+    public:
+        /** Creates an empty view. */
+        MessageView() = default;
+
+        /** Destructor. This releases the message. */
+        ~MessageView();
+
+        MessageView (MessageView&&) noexcept;
+        MessageView& operator= (MessageView&&) noexcept;
+
+        /** Returns a pointer to the message data, or nullptr if this view is empty. */
+        const void* getData() const noexcept            { return data; }
+
+        /** Returns the size of the message in bytes. */
+        size_t getSize() const noexcept                 { return size; }
+
+        /** Returns true if this view refers to a message. */
+        bool isValid() const noexcept                   { return owner != nullptr; }
+
+        /** Releases the message so that its space in the buffer can be reused. */
+        void release();
+
+    private:
+        friend class SharedMemoryPipe;
+
+        SharedMemoryPipe* owner = nullptr;
+        const void* data = nullptr;
+        size_t size = 0;
+        bool isInSharedMemory = false;
+        MemoryBlock reassembledMessage;
+
+        JUCE_DECLARE_NON_COPYABLE (MessageView)
+    };
+
+    /** Waits for the next message to arrive, and returns a view of it.
+
+        If timeOutMilliseconds is less than zero, it will wait indefinitely. If nothing
+        arrives in time, or the pipe is closed, the view that's returned is empty.
+        Only one view can be active at a time.
+    */
+    MessageView readMessage (int timeOutMilliseconds);
+
+    /** Waits for the next message to arrive, and copies it into a MemoryBlock.
+
+        Returns false if nothing arrived in time, or if the pipe was closed.
+    */
+    bool readMessage (MemoryBlock& destData, int timeOutMilliseconds);
+
+private:
+    //==============================================================================
+    JUCE_PUBLIC_IN_DLL_BUILD (class Pimpl)
+    std::unique_ptr<Pimpl> pimpl;
+    String currentPipeName;
+    ReadWriteLock lock;
+    std::atomic<bool> isClosing { false };
+
+    bool openInternal (const String& pipeName, bool createPipe, int bufferSize, bool mustNotExist);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryPipe)
+};
+
+} // namespace juce
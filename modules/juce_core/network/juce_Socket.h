@@ -183,6 +183,7 @@ private:
     std::atomic<bool> connected { false }, isListener { false };
     mutable CriticalSection readLock;
 
+    friend class SocketIOService;
     StreamingSocket (const String& hostname, int portNumber, int handle);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingSocket)
@@ -361,6 +362,8 @@ private:
     void* lastServerAddress = nullptr;
     mutable CriticalSection readLock;
 
+    friend class SocketIOService;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DatagramSocket)
 };
 
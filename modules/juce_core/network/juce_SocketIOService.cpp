@@ -0,0 +1,947 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if ! JUCE_WASM
+
+//==============================================================================
+namespace SocketIOHelpers
+{
+    enum EventFlags
+    {
+        readEvent  = 1,
+        writeEvent = 2
+    };
+
+    struct Event
+    {
+        int handle;
+        bool readable, writable;
+    };
+
+    static bool lastCallWouldHaveBlocked() noexcept
+    {
+       #if JUCE_WINDOWS
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+       #else
+        return errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR;
+       #endif
+    }
+
+   #if JUCE_WINDOWS || ! defined (MSG_NOSIGNAL)
+    static constexpr int sendFlags = 0;
+   #else
+    static constexpr int sendFlags = MSG_NOSIGNAL;
+   #endif
+
+    //==============================================================================
+   #if JUCE_LINUX || JUCE_ANDROID
+    class Poller
+    {
+    public:
+        Poller()   : fd (epoll_create1 (EPOLL_CLOEXEC)) { jassert (fd >= 0); }
+        ~Poller()  { if (fd >= 0) ::close (fd); }
+
+        static constexpr bool needsWakeUpAfterChanges = false;
+
+        void setEvents (int handle, int oldEvents, int newEvents)
+        {
+            epoll_event e {};
+            e.events = ((newEvents & readEvent)  != 0 ? (uint32) EPOLLIN  : 0u)
+                     | ((newEvents & writeEvent) != 0 ? (uint32) EPOLLOUT : 0u);
+            e.data.fd = handle;
+
+            epoll_ctl (fd, oldEvents == 0 ? EPOLL_CTL_ADD
+                                          : (newEvents == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD),
+                       handle, &e);
+        }
+
+        void wait (std::vector<Event>& results, int timeoutMs)
+        {
+            epoll_event events[64];
+            auto num = epoll_wait (fd, events, numElementsInArray (events), timeoutMs);
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto flags = events[i].events;
+                auto failed = (flags & (EPOLLERR | EPOLLHUP)) != 0;
+
+                results.push_back ({ events[i].data.fd,
+                                     failed || (flags & EPOLLIN) != 0,
+                                     failed || (flags & EPOLLOUT) != 0 });
+            }
+        }
+
+    private:
+        int fd;
+    };
+
+    //==============================================================================
+   #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+    class Poller
+    {
+    public:
+        Poller()   : fd (kqueue()) { jassert (fd >= 0); }
+        ~Poller()  { if (fd >= 0) ::close (fd); }
+
+        static constexpr bool needsWakeUpAfterChanges = false;
+
+        void setEvents (int handle, int oldEvents, int newEvents)
+        {
+            struct kevent changes[2];
+            int numChanges = 0;
+
+            for (auto [flag, filter] : { std::make_pair ((int) readEvent,  (int) EVFILT_READ),
+                                         std::make_pair ((int) writeEvent, (int) EVFILT_WRITE) })
+            {
+                if ((oldEvents & flag) != (newEvents & flag))
+                {
+                    auto* change = changes + numChanges++;
+                    EV_SET (change, (uintptr_t) handle, filter, (newEvents & flag) != 0 ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+                }
+            }
+
+            if (numChanges > 0)
+                kevent (fd, changes, numChanges, nullptr, 0, nullptr);
+        }
+
+        void wait (std::vector<Event>& results, int timeoutMs)
+        {
+            struct kevent events[64];
+            struct timespec timeout { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+            auto num = kevent (fd, nullptr, 0, events, numElementsInArray (events), timeoutMs >= 0 ? &timeout : nullptr);
+
+            for (int i = 0; i < num; ++i)
+                results.push_back ({ (int) events[i].ident,
+                                     events[i].filter == EVFILT_READ,
+                                     events[i].filter == EVFILT_WRITE });
+        }
+
+    private:
+        int fd;
+    };
+
+    //==============================================================================
+   #else
+    class Poller
+    {
+    public:
+        // the set of sockets is rebuilt on each pass, so changes have to interrupt the wait
+        static constexpr bool needsWakeUpAfterChanges = true;
+
+        void setEvents (int handle, int, int newEvents)
+        {
+            const ScopedLock sl (lock);
+
+            if (newEvents == 0)
+                handles.erase (handle);
+            else
+                handles[handle] = newEvents;
+        }
+
+        void wait (std::vector<Event>& results, int timeoutMs)
+        {
+            {
+                const ScopedLock sl (lock);
+                fds.clear();
+
+                for (auto& h : handles)
+                {
+                    auto events = (short) (((h.second & readEvent)  != 0 ? POLLIN  : 0)
+                                         | ((h.second & writeEvent) != 0 ? POLLOUT : 0));
+
+                   #if JUCE_WINDOWS
+                    fds.push_back ({ (SocketHandle) h.first, events, 0 });
+                   #else
+                    fds.push_back ({ h.first, events, 0 });
+                   #endif
+                }
+            }
+
+           #if JUCE_WINDOWS
+            auto num = WSAPoll (fds.data(), (ULONG) fds.size(), timeoutMs);
+           #else
+            auto num = poll (fds.data(), (nfds_t) fds.size(), timeoutMs);
+           #endif
+
+            if (num <= 0)
+                return;
+
+            for (auto& f : fds)
+            {
+                if (f.revents != 0)
+                {
+                    auto failed = (f.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+
+                    results.push_back ({ (int) f.fd,
+                                         failed || (f.revents & POLLIN) != 0,
+                                         failed || (f.revents & POLLOUT) != 0 });
+                }
+            }
+        }
+
+    private:
+        CriticalSection lock;
+        std::map<int, int> handles;
+
+       #if JUCE_WINDOWS
+        std::vector<WSAPOLLFD> fds;
+       #else
+        std::vector<pollfd> fds;
+       #endif
+    };
+   #endif
+}
+
+//==============================================================================
+class SocketIOService::Worker  : private Thread
+{
+public:
+    // An operation tries to make some progress on its socket. It returns nullptr if it's
+    // still waiting, or the completion callback to call once it has finished.
+    using Completion = std::function<void()>;
+    using Operation  = std::function<Completion()>;
+
+    explicit Worker (const String& name)  : Thread (name)
+    {
+        if (wakeUpSocket.bindToPort (0, "127.0.0.1"))
+        {
+            wakeUpHandle = wakeUpSocket.getRawSocketHandle();
+            SocketHelpers::setSocketBlockingState ((SocketHandle) wakeUpHandle, false);
+
+            zerostruct (wakeUpAddress);
+            wakeUpAddress.sin_family = AF_INET;
+            wakeUpAddress.sin_port = htons ((uint16) wakeUpSocket.getBoundPort());
+            wakeUpAddress.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+
+            poller.setEvents (wakeUpHandle, 0, SocketIOHelpers::readEvent);
+        }
+
+        startThread();
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wakeUp();
+        stopThread (10000);
+    }
+
+    bool isWorkerThread() const     { return getThreadId() == Thread::getCurrentThreadId(); }
+
+    //==============================================================================
+    bool startRead (int handle, Operation operation)
+    {
+        const ScopedLock sl (lock);
+        auto& entry = getEntry (handle);
+
+        if (entry.readOperation != nullptr)
+            return false;
+
+        entry.readOperation = std::move (operation);
+        updateEvents (handle, entry);
+        return true;
+    }
+
+    void startWrite (int handle, Operation operation)
+    {
+        std::shared_ptr<Entry> entry;
+
+        {
+            const ScopedLock sl (lock);
+            auto& e = getEntry (handle);
+
+            if (! e.writeOperations.empty() || e.isWriting)
+            {
+                e.writeOperations.push_back (std::move (operation));
+                updateEvents (handle, e);
+                return;
+            }
+
+            e.isWriting = true;
+            entry = entries[handle];
+        }
+
+        // Nothing else is queued, so try sending straight away rather than waiting for the
+        // thread to wake up. If one of the socket's callbacks is busy, leave it to the thread.
+        Completion completion;
+
+        {
+            const ScopedTryLock tl (entry->operationLock);
+
+            if (tl.isLocked())
+                completion = operation();
+        }
+
+        {
+            const ScopedLock sl (lock);
+            entry->isWriting = false;
+
+            if (completion == nullptr)
+            {
+                if (entry->cancelled)
+                    return;
+
+                entry->writeOperations.push_front (std::move (operation));
+                updateEvents (handle, *entry);
+            }
+        }
+
+        if (completion != nullptr)
+            completion();
+    }
+
+    void cancel (int handle)
+    {
+        std::shared_ptr<Entry> entry;
+
+        {
+            const ScopedLock sl (lock);
+            auto found = entries.find (handle);
+
+            if (found == entries.end())
+                return;
+
+            entry = found->second;
+            entry->cancelled = true;
+
+            if (entry->registeredEvents != 0)
+                poller.setEvents (handle, entry->registeredEvents, 0);
+
+            entries.erase (found);
+        }
+
+        // wait for any callback that's running on another thread to return
+        const ScopedLock opLock (entry->operationLock);
+        entry->readOperation = nullptr;
+        entry->writeOperations.clear();
+    }
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        Operation readOperation;
+        std::deque<Operation> writeOperations;
+        CriticalSection operationLock;
+        int registeredEvents = 0;
+        bool isWriting = false;
+        std::atomic<bool> cancelled { false };
+    };
+
+    Entry& getEntry (int handle)
+    {
+        auto& entry = entries[handle];
+
+        if (entry == nullptr)
+        {
+            entry = std::make_shared<Entry>();
+            SocketHelpers::setSocketBlockingState ((SocketHandle) handle, false);
+        }
+
+        return *entry;
+    }
+
+    void updateEvents (int handle, Entry& entry)
+    {
+        auto newEvents = (entry.readOperation != nullptr ? (int) SocketIOHelpers::readEvent : 0)
+                       | (entry.writeOperations.empty() ? 0 : (int) SocketIOHelpers::writeEvent);
+
+        if (newEvents != entry.registeredEvents)
+        {
+            poller.setEvents (handle, entry.registeredEvents, newEvents);
+            entry.registeredEvents = newEvents;
+
+            if (SocketIOHelpers::Poller::needsWakeUpAfterChanges && ! isWorkerThread())
+                wakeUp();
+        }
+    }
+
+    void wakeUp()
+    {
+        if (wakeUpHandle >= 0)
+        {
+            const char byte = 0;
+            ::sendto ((SocketHandle) wakeUpHandle, &byte, 1, 0, (const sockaddr*) &wakeUpAddress, sizeof (wakeUpAddress));
+        }
+    }
+
+    void drainWakeUpSocket()
+    {
+        char buffer[64];
+
+        while (::recv ((SocketHandle) wakeUpHandle, buffer, (juce_recvsend_size_t) sizeof (buffer), 0) > 0)
+        {}
+    }
+
+    //==============================================================================
+    void run() override
+    {
+        std::vector<SocketIOHelpers::Event> events;
+
+        while (! threadShouldExit())
+        {
+            events.clear();
+            poller.wait (events, 1000);
+
+            for (auto& e : events)
+            {
+                if (threadShouldExit())
+                    return;
+
+                if (e.handle == wakeUpHandle)
+                    drainWakeUpSocket();
+                else
+                    handleEvent (e);
+            }
+        }
+    }
+
+    void handleEvent (const SocketIOHelpers::Event& event)
+    {
+        std::shared_ptr<Entry> entry;
+
+        {
+            const ScopedLock sl (lock);
+            auto found = entries.find (event.handle);
+
+            if (found == entries.end())
+                return;
+
+            entry = found->second;
+        }
+
+        const ScopedLock opLock (entry->operationLock);
+
+        if (event.readable)
+        {
+            Completion completion;
+
+            if (entry->readOperation != nullptr && ! entry->cancelled)
+                completion = entry->readOperation();
+
+            if (completion != nullptr)
+            {
+                {
+                    const ScopedLock sl (lock);
+
+                    if (entry->cancelled)
+                        return;
+
+                    entry->readOperation = nullptr;
+                    updateEvents (event.handle, *entry);
+                }
+
+                completion();
+            }
+        }
+
+        if (event.writable)
+        {
+            for (;;)
+            {
+                Operation* operation = nullptr;
+
+                {
+                    const ScopedLock sl (lock);
+
+                    if (entry->cancelled || entry->isWriting || entry->writeOperations.empty())
+                        return;
+
+                    entry->isWriting = true;
+                    operation = &entry->writeOperations.front();
+                }
+
+                auto completion = (*operation)();
+
+                {
+                    const ScopedLock sl (lock);
+                    entry->isWriting = false;
+
+                    if (entry->cancelled)
+                        return;
+
+                    if (completion != nullptr)
+                    {
+                        entry->writeOperations.pop_front();
+                        updateEvents (event.handle, *entry);
+                    }
+                }
+
+                if (completion == nullptr)
+                    return;
+
+                completion();
+            }
+        }
+    }
+
+    //==============================================================================
+    SocketIOHelpers::Poller poller;
+    CriticalSection lock;
+    std::unordered_map<int, std::shared_ptr<Entry>> entries;
+
+    DatagramSocket wakeUpSocket;
+    int wakeUpHandle = -1;
+    sockaddr_in wakeUpAddress;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+SocketIOService::SocketIOService (int numThreads, const String& threadName)
+{
+    SocketHelpers::initSockets();
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        workers.push_back (std::make_unique<Worker> (threadName));
+}
+
+SocketIOService::~SocketIOService()
+{
+    workers.clear();
+}
+
+SocketIOService::Worker& SocketIOService::getWorkerFor (int socketHandle) const
+{
+    // Windows socket handles are multiples of 4, so the low bits are no use for this
+    auto hash = ((uint32) socketHandle * 2654435761u) >> 16;
+    return *workers[(size_t) (hash % (uint32) workers.size())];
+}
+
+int SocketIOService::getNumThreads() const noexcept
+{
+    return (int) workers.size();
+}
+
+bool SocketIOService::isCallingThreadAnIOThread() const
+{
+    for (auto& w : workers)
+        if (w->isWorkerThread())
+            return true;
+
+    return false;
+}
+
+//==============================================================================
+bool SocketIOService::asyncRead (StreamingSocket& socket, void* destBuffer, int maxBytesToRead,
+                                 std::function<void (int)> callback)
+{
+    jassert (destBuffer != nullptr && maxBytesToRead > 0);
+
+    if (! socket.connected || socket.isListener)
+        return false;
+
+    auto h = socket.handle.load();
+
+    return getWorkerFor (h).startRead (h, [h, destBuffer, maxBytesToRead, callback = std::move (callback)]() mutable -> Worker::Completion
+    {
+        auto bytesRead = (int) ::recv ((SocketHandle) h, static_cast<char*> (destBuffer),
+                                       (juce_recvsend_size_t) maxBytesToRead, 0);
+
+        if (bytesRead < 0 && SocketIOHelpers::lastCallWouldHaveBlocked())
+            return nullptr;
+
+        return [cb = std::move (callback), bytesRead = jmax (-1, bytesRead)]
+        {
+            if (cb != nullptr)
+                cb (bytesRead);
+        };
+    });
+}
+
+bool SocketIOService::asyncRead (DatagramSocket& socket, void* destBuffer, int maxBytesToRead,
+                                 std::function<void (int, const String&, int)> callback)
+{
+    jassert (destBuffer != nullptr && maxBytesToRead > 0);
+
+    if (socket.handle < 0 || ! socket.isBound)
+        return false;
+
+    auto h = socket.handle.load();
+
+    return getWorkerFor (h).startRead (h, [h, destBuffer, maxBytesToRead, callback = std::move (callback)]() mutable -> Worker::Completion
+    {
+        sockaddr_in sender;
+        juce_socklen_t senderLength = sizeof (sender);
+        zerostruct (sender);
+
+        auto bytesRead = (int) ::recvfrom ((SocketHandle) h, static_cast<char*> (destBuffer),
+                                           (juce_recvsend_size_t) maxBytesToRead, 0,
+                                           (sockaddr*) &sender, &senderLength);
+
+        if (bytesRead < 0 && SocketIOHelpers::lastCallWouldHaveBlocked())
+            return nullptr;
+
+        return [cb = std::move (callback), bytesRead = jmax (-1, bytesRead),
+                senderIP = String::fromUTF8 (inet_ntoa (sender.sin_addr)),
+                senderPort = (int) ntohs (sender.sin_port)]
+        {
+            if (cb != nullptr)
+                cb (bytesRead, senderIP, senderPort);
+        };
+    });
+}
+
+bool SocketIOService::asyncAccept (StreamingSocket& listener,
+                                   std::function<void (std::unique_ptr<StreamingSocket>)> callback)
+{
+    if (! listener.connected || ! listener.isListener)
+        return false;
+
+    auto h = listener.handle.load();
+    auto port = listener.portNumber.load();
+
+    return getWorkerFor (h).startRead (h, [h, port, callback = std::move (callback)]() mutable -> Worker::Completion
+    {
+        struct sockaddr_storage address;
+        juce_socklen_t len = sizeof (address);
+        auto newHandle = accept ((SocketHandle) h, (struct sockaddr*) &address, &len);
+        std::unique_ptr<StreamingSocket> newSocket;
+
+        if (newHandle == invalidSocket)
+        {
+            if (SocketIOHelpers::lastCallWouldHaveBlocked())
+                return nullptr;
+        }
+        else
+        {
+            // some systems pass the listener's non-blocking flag on to the new socket
+            SocketHelpers::setSocketBlockingState (newHandle, true);
+            newSocket.reset (new StreamingSocket (inet_ntoa (((struct sockaddr_in*) &address)->sin_addr),
+                                                  port, (int) newHandle));
+        }
+
+        return [cb = std::move (callback), s = std::make_shared<std::unique_ptr<StreamingSocket>> (std::move (newSocket))]
+        {
+            if (cb != nullptr)
+                cb (std::move (*s));
+        };
+    });
+}
+
+bool SocketIOService::asyncWrite (StreamingSocket& socket, const void* sourceBuffer, int numBytesToWrite,
+                                  std::function<void (bool)> callback)
+{
+    jassert (sourceBuffer != nullptr || numBytesToWrite == 0);
+
+    if (! socket.connected || socket.isListener)
+        return false;
+
+    auto h = socket.handle.load();
+
+    getWorkerFor (h).startWrite (h, [h, data = MemoryBlock (sourceBuffer, (size_t) jmax (0, numBytesToWrite)),
+                                     numBytesSent = (size_t) 0, callback = std::move (callback)]() mutable -> Worker::Completion
+    {
+        auto makeCompletion = [&callback] (bool succeeded) -> Worker::Completion
+        {
+            return [cb = std::move (callback), succeeded]
+            {
+                if (cb != nullptr)
+                    cb (succeeded);
+            };
+        };
+
+        while (numBytesSent < data.getSize())
+        {
+            auto bytesThisTime = (int) ::send ((SocketHandle) h, static_cast<const char*> (data.getData()) + numBytesSent,
+                                               (juce_recvsend_size_t) (data.getSize() - numBytesSent),
+                                               SocketIOHelpers::sendFlags);
+
+            if (bytesThisTime < 0)
+            {
+                if (SocketIOHelpers::lastCallWouldHaveBlocked())
+                    return nullptr;
+
+                return makeCompletion (false);
+            }
+
+            numBytesSent += (size_t) bytesThisTime;
+        }
+
+        return makeCompletion (true);
+    });
+
+    return true;
+}
+
+//==============================================================================
+void SocketIOService::cancel (StreamingSocket& socket)
+{
+    if (auto h = socket.handle.load(); h >= 0)
+        getWorkerFor (h).cancel (h);
+}
+
+void SocketIOService::cancel (DatagramSocket& socket)
+{
+    if (auto h = socket.handle.load(); h >= 0)
+        getWorkerFor (h).cancel (h);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SocketIOServiceTests  : public UnitTest
+{
+    SocketIOServiceTests()
+        : UnitTest ("SocketIOService", UnitTestCategories::networking)
+    {
+    }
+
+    void runTest() override
+    {
+        const String localHost ("127.0.0.1");
+
+        beginTest ("Accept, read and write");
+        {
+            SocketIOService service (2);
+            StreamingSocket listener, client;
+            std::unique_ptr<StreamingSocket> server;
+
+            expect (listener.createListener (0, localHost));
+
+            WaitableEvent accepted;
+            expect (service.asyncAccept (listener, [&] (std::unique_ptr<StreamingSocket> s)
+            {
+                server = std::move (s);
+                accepted.signal();
+            }));
+
+            expect (client.connect (localHost, listener.getBoundPort(), 1000));
+            expect (accepted.wait (5000));
+            expect (server != nullptr && server->isConnected());
+
+            // send enough that the writes can't all complete immediately
+            MemoryBlock dataToSend (4 * 1024 * 1024);
+            auto r = getRandom();
+
+            for (auto& b : dataToSend)
+                b = (char) r.nextInt (256);
+
+            MemoryBlock received;
+            HeapBlock<char> buffer (16384);
+            WaitableEvent allReceived;
+            std::function<void()> startReading;
+
+            startReading = [&]
+            {
+                service.asyncRead (*server, buffer, 16384, [&] (int numBytes)
+                {
+                    if (numBytes > 0)
+                        received.append (buffer, (size_t) numBytes);
+
+                    if (numBytes <= 0 || received.getSize() >= dataToSend.getSize())
+                        allReceived.signal();
+                    else
+                        startReading();
+                });
+            };
+
+            startReading();
+
+            std::atomic<int> numWritesSucceeded { 0 };
+            const int chunkSize = 65536;
+
+            for (size_t pos = 0; pos < dataToSend.getSize(); pos += chunkSize)
+                expect (service.asyncWrite (client, dataToSend.begin() + pos, chunkSize,
+                                            [&] (bool ok) { if (ok) ++numWritesSucceeded; }));
+
+            expect (allReceived.wait (10000));
+            expect (received == dataToSend);
+            expectEquals (numWritesSucceeded.load(), (int) (dataToSend.getSize() / chunkSize));
+
+            service.cancel (listener);
+            service.cancel (client);
+            service.cancel (*server);
+        }
+
+        beginTest ("Closed connections");
+        {
+            SocketIOService service;
+            StreamingSocket listener;
+            auto client = std::make_unique<StreamingSocket>();
+            std::unique_ptr<StreamingSocket> server;
+
+            expect (listener.createListener (0, localHost));
+
+            WaitableEvent accepted;
+            service.asyncAccept (listener, [&] (std::unique_ptr<StreamingSocket> s) { server = std::move (s); accepted.signal(); });
+            expect (client->connect (localHost, listener.getBoundPort(), 1000));
+            expect (accepted.wait (5000));
+
+            char buffer[16];
+            std::atomic<int> result { 1 };
+            WaitableEvent finished;
+            expect (service.asyncRead (*server, buffer, sizeof (buffer), [&] (int n) { result = n; finished.signal(); }));
+            expect (! service.asyncRead (*server, buffer, sizeof (buffer), nullptr));
+
+            client.reset();
+            expect (finished.wait (5000));
+            expectEquals (result.load(), 0);
+
+            service.cancel (listener);
+            service.cancel (*server);
+        }
+
+        beginTest ("Datagrams");
+        {
+            SocketIOService service;
+            DatagramSocket receiver, sender;
+            expect (receiver.bindToPort (0, localHost));
+            expect (sender.bindToPort (0, localHost));
+
+            char buffer[64];
+            WaitableEvent finished;
+            String receivedText;
+            int receivedFromPort = 0;
+
+            expect (service.asyncRead (receiver, buffer, sizeof (buffer), [&] (int n, const String&, int port)
+            {
+                receivedText = String (buffer, (size_t) jmax (0, n));
+                receivedFromPort = port;
+                finished.signal();
+            }));
+
+            expectEquals (sender.write (localHost, receiver.getBoundPort(), "hello", 5), 5);
+            expect (finished.wait (5000));
+            expectEquals (receivedText, String ("hello"));
+            expectEquals (receivedFromPort, sender.getBoundPort());
+
+            service.cancel (receiver);
+        }
+
+        beginTest ("Cancel");
+        {
+            SocketIOService service;
+            DatagramSocket receiver, sender;
+            expect (receiver.bindToPort (0, localHost));
+
+            char buffer[64];
+            std::atomic<bool> called { false };
+            expect (service.asyncRead (receiver, buffer, sizeof (buffer), [&] (int, const String&, int) { called = true; }));
+
+            service.cancel (receiver);
+            sender.write (localHost, receiver.getBoundPort(), "hello", 5);
+            Thread::sleep (100);
+            expect (! called);
+
+            // the socket can be used again after cancelling
+            WaitableEvent finished;
+            expect (service.asyncRead (receiver, buffer, sizeof (buffer), [&] (int, const String&, int) { finished.signal(); }));
+            sender.write (localHost, receiver.getBoundPort(), "hello", 5);
+            expect (finished.wait (5000));
+
+            service.cancel (receiver);
+        }
+
+        beginTest ("Many connections");
+        {
+            constexpr int numClients = 100, messageSize = 1000;
+
+            SocketIOService service (3);
+            StreamingSocket listener;
+            expect (listener.createListener (0, localHost));
+
+            struct Connection
+            {
+                std::unique_ptr<StreamingSocket> socket;
+                char buffer[256];
+                int numReceived = 0;
+            };
+
+            std::vector<std::unique_ptr<Connection>> connections;
+            CriticalSection connectionLock;
+            std::atomic<int> numComplete { 0 };
+            WaitableEvent allComplete;
+            std::function<void (Connection&)> startReading;
+
+            startReading = [&] (Connection& c)
+            {
+                service.asyncRead (*c.socket, c.buffer, sizeof (c.buffer), [&] (int n)
+                {
+                    c.numReceived += jmax (0, n);
+
+                    if (n > 0 && c.numReceived < messageSize)
+                        startReading (c);
+                    else if (++numComplete == numClients)
+                        allComplete.signal();
+                });
+            };
+
+            std::function<void (std::unique_ptr<StreamingSocket>)> onAccept;
+
+            onAccept = [&] (std::unique_ptr<StreamingSocket> s)
+            {
+                if (s == nullptr)
+                    return;
+
+                auto c = std::make_unique<Connection>();
+                c->socket = std::move (s);
+                startReading (*c);
+
+                const ScopedLock sl (connectionLock);
+                connections.push_back (std::move (c));
+                service.asyncAccept (listener, onAccept);
+            };
+
+            service.asyncAccept (listener, onAccept);
+
+            std::vector<std::unique_ptr<StreamingSocket>> clients;
+            HeapBlock<char> message (messageSize, true);
+
+            for (int i = 0; i < numClients; ++i)
+            {
+                clients.push_back (std::make_unique<StreamingSocket>());
+                expect (clients.back()->connect (localHost, listener.getBoundPort(), 1000));
+            }
+
+            for (auto& c : clients)
+                expect (service.asyncWrite (*c, message, messageSize));
+
+            expect (allComplete.wait (10000));
+
+            for (auto& c : clients)
+                service.cancel (*c);
+
+            service.cancel (listener);
+
+            const ScopedLock sl (connectionLock);
+
+            for (auto& c : connections)
+            {
+                expectEquals (c->numReceived, messageSize);
+                service.cancel (*c->socket);
+            }
+        }
+    }
+};
+
+static SocketIOServiceTests socketIOServiceTests;
+
+#endif
+
+#endif
+
+} // namespace juce
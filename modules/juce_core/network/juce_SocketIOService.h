@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Services asynchronous reads and writes on many sockets using a small number of threads.
+
+    Rather than dedicating a thread to each socket and blocking in read() or
+    waitUntilReady(), you start an operation on a socket with one of the async methods
+    and carry on. When the operation finishes, its callback is called on one of the
+    service's threads. To keep reading, start another read from inside the callback.
+
+    The threads wait using whatever the system does best: epoll on Linux and Android,
+    kqueue on macOS, iOS and BSD, and WSAPoll on Windows. All operations on a given
+    socket are handled in order by the same thread, so the callbacks for one socket
+    never run at the same time. Callbacks for different sockets may run at the same
+    time if the service has more than one thread.
+
+    Once a socket has been used with a SocketIOService, it is put into non-blocking
+    mode, so you shouldn't also use its blocking read() methods. You must call cancel()
+    before closing or deleting a socket that has operations pending.
+
+    @code
+    SocketIOService service;
+    StreamingSocket socket;
+    char buffer[1024];
+
+    if (socket.connect ("localhost", 1234))
+    {
+        service.asyncRead (socket, buffer, sizeof (buffer), [&] (int numBytesRead)
+        {
+            if (numBytesRead > 0)
+                DBG (String (buffer, (size_t) numBytesRead));
+        });
+    }
+    @endcode
+
+    @see StreamingSocket, DatagramSocket
+
+    @tags{Core}
+*/
+class JUCE_API  SocketIOService
+{
+public:
+    //==============================================================================
+    /** Creates a service which starts the given number of threads.
+
+        Each socket is assigned to one of the threads, so for a handful of sockets a
+        single thread is plenty. More threads help if you have many busy sockets and
+        the callbacks take a while to run.
+    */
+    explicit SocketIOService (int numThreads = 1, const String& threadName = "JUCE Socket IO");
+
+    /** Destructor.
+
+        This stops the threads, waiting for any callbacks that are running to return.
+        Operations that are still pending are abandoned without calling their callbacks.
+    */
+    ~SocketIOService();
+
+    //==============================================================================
+    /** Starts waiting for data to arrive on a connected socket.
+
+        When some data arrives, up to maxBytesToRead bytes of it are read into the
+        buffer and the callback is called with the number of bytes read. This is ready
+        as soon as any data arrives, so it may be less than the size of the buffer. The
+        callback gets 0 if the other end closed the connection, or -1 if there was an
+        error. The buffer must stay valid until the callback has been called, or until
+        cancel() has returned.
+
+        Only one read can be pending on a socket at a time. The method returns false if
+        the socket isn't connected, or if there's already a read pending.
+    */
+    bool asyncRead (StreamingSocket& socket, void* destBuffer, int maxBytesToRead,
+                    std::function<void (int numBytesRead)> callback);
+
+    /** Starts waiting for a packet to arrive on a bound datagram socket.
+
+        When a packet arrives, it's read into the buffer and the callback is called with
+        its size and the address and port that it came from, or with -1 if there was an
+        error. The buffer must stay valid until the callback has been called, or until
+        cancel() has returned.
+
+        Only one read can be pending on a socket at a time. The method returns false if
+        the socket isn't bound, or if there's already a read pending.
+    */
+    bool asyncRead (DatagramSocket& socket, void* destBuffer, int maxBytesToRead,
+                    std::function<void (int numBytesRead, const String& senderIPAddress, int senderPort)> callback);
+
+    /** Starts waiting for a client to connect to a listening socket.
+
+        When a client connects, the callback is given a new socket for the connection,
+        which it takes ownership of. If the listener is closed, the callback is given
+        nullptr. The new socket is in the usual blocking mode until you use it with a
+        SocketIOService.
+
+        Only one accept can be pending on a socket at a time. The method returns false
+        if the socket isn't a listener, or if there's already an accept pending.
+
+        @see StreamingSocket::createListener
+    */
+    bool asyncAccept (StreamingSocket& listener,
+                      std::function<void (std::unique_ptr<StreamingSocket> newConnection)> callback);
+
+    /** Sends some data on a connected socket.
+
+        The data is copied, so the buffer can be reused as soon as this returns. Writes
+        to the same socket are sent in the order in which they were made, and the data
+        from different writes is never interleaved, so this can be called from several
+        threads at once.
+
+        Once all the data has been sent, the callback is called with true; if the
+        connection fails first, it's called with false. If all the data can be sent
+        immediately, the callback is called before this method returns. The callback
+        may be nullptr.
+
+        Returns false if the socket isn't connected.
+    */
+    bool asyncWrite (StreamingSocket& socket, const void* sourceBuffer, int numBytesToWrite,
+                     std::function<void (bool succeeded)> callback = nullptr);
+
+    //==============================================================================
+    /** Abandons all of the pending operations on a socket.
+
+        If one of the socket's callbacks is running on another thread, this waits for it
+        to return. Callbacks for the abandoned operations aren't called. It's safe to
+        call this from inside one of the socket's own callbacks.
+
+        You must call this before closing or deleting a socket that you've started any
+        operations on.
+    */
+    void cancel (StreamingSocket& socket);
+
+    /** Abandons all of the pending operations on a socket.
+        @see cancel (StreamingSocket&)
+    */
+    void cancel (DatagramSocket& socket);
+
+    /** Returns the number of threads that this service is running. */
+    int getNumThreads() const noexcept;
+
+    /** Returns true if the calling thread is one of this service's threads. */
+    bool isCallingThreadAnIOThread() const;
+
+private:
+    //==============================================================================
+    class Worker;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    Worker& getWorkerFor (int socketHandle) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketIOService)
+};
+
+} // namespace juce
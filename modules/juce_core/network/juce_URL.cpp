@@ -23,25 +23,106 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Works out whether a download can carry on from a partially downloaded file, and
+    prepares the file once the server has replied to the range request.
+*/
+struct ResumableDownloadTarget
+{
+    enum class Action
+    {
+        writeBody,
+        alreadyComplete,
+        fail
+    };
+
+    ResumableDownloadTarget (const File& targetToUse, bool resumeExisting)
+        : target (targetToUse)
+    {
+        if (resumeExisting && target.existsAsFile())
+            resumePosition = target.getSize();
+        else
+            target.deleteFile();
+    }
+
+    std::unique_ptr<FileOutputStream> createOutputStream (size_t bufferSize) const
+    {
+        // FileOutputStream appends to an existing file, so a resumed download carries on from the end
+        return target.createOutputStream (bufferSize);
+    }
+
+    String addRangeHeader (const String& extraHeaders) const
+    {
+        if (resumePosition <= 0)
+            return extraHeaders;
+
+        auto headers = extraHeaders;
+
+        if (headers.isNotEmpty() && ! headers.endsWithChar ('\n'))
+            headers << "\r\n";
+
+        return headers + "Range: bytes=" + String (resumePosition) + "-\r\n";
+    }
+
+    Action prepareForResponse (FileOutputStream& stream, int statusCode, const StringPairArray& responseHeaders)
+    {
+        if (resumePosition > 0)
+        {
+            if (statusCode == 206)
+                return Action::writeBody;
+
+            if (statusCode == 416)
+            {
+                // the range started at the end of the file, so check that we really have all of it
+                auto contentRange = responseHeaders.getValue ("Content-Range", {});
+
+                if (contentRange.fromLastOccurrenceOf ("/", false, false).trim().getLargeIntValue() == resumePosition)
+                    return Action::alreadyComplete;
+
+                return Action::fail;
+            }
+
+            // the server has ignored the range, so start again from the beginning
+            resumePosition = 0;
+        }
+
+        return (stream.setPosition (0) && stream.truncate().wasOk()) ? Action::writeBody
+                                                                     : Action::fail;
+    }
+
+    int64 getTotalLength (int64 responseLength) const noexcept
+    {
+        return responseLength < 0 ? -1 : responseLength + resumePosition;
+    }
+
+    const File target;
+    int64 resumePosition = 0;
+};
+
+//==============================================================================
 struct FallbackDownloadTask  : public URL::DownloadTask,
                                public Thread
 {
     FallbackDownloadTask (std::unique_ptr<FileOutputStream> outputStreamToUse,
                           size_t bufferSizeToUse,
                           std::unique_ptr<WebInputStream> streamToUse,
-                          URL::DownloadTask::Listener* listenerToUse)
+                          URL::DownloadTask::Listener* listenerToUse,
+                          const ResumableDownloadTarget& resumableTarget,
+                          bool isAlreadyComplete)
         : Thread ("DownloadTask thread"),
           fileStream (std::move (outputStreamToUse)),
           stream (std::move (streamToUse)),
           bufferSize (bufferSizeToUse),
           buffer (bufferSize),
-          listener (listenerToUse)
+          listener (listenerToUse),
+          alreadyComplete (isAlreadyComplete)
     {
         jassert (fileStream != nullptr);
         jassert (stream != nullptr);
 
         targetLocation = fileStream->getFile();
-        contentLength  = stream->getTotalLength();
+        downloaded     = resumableTarget.resumePosition;
+        contentLength  = alreadyComplete ? downloaded : resumableTarget.getTotalLength (stream->getTotalLength());
         httpCode       = stream->getStatusCode();
 
         startThread();
@@ -57,7 +138,7 @@ struct FallbackDownloadTask  : public URL::DownloadTask,
     //==============================================================================
     void run() override
     {
-        while (! (stream->isExhausted() || stream->isError() || threadShouldExit()))
+        while (! (alreadyComplete || stream->isExhausted() || stream->isError() || threadShouldExit()))
         {
             if (listener != nullptr)
                 listener->progress (this, downloaded, contentLength);
@@ -84,7 +165,7 @@ struct FallbackDownloadTask  : public URL::DownloadTask,
 
         fileStream.reset();
 
-        if (threadShouldExit() || stream->isError())
+        if (threadShouldExit() || (stream->isError() && ! alreadyComplete))
             error = true;
 
         if (contentLength > 0 && downloaded < contentLength)
@@ -102,6 +183,7 @@ struct FallbackDownloadTask  : public URL::DownloadTask,
     const size_t bufferSize;
     HeapBlock<char> buffer;
     URL::DownloadTask::Listener* const listener;
+    const bool alreadyComplete;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FallbackDownloadTask)
 };
@@ -114,18 +196,25 @@ std::unique_ptr<URL::DownloadTask> URL::DownloadTask::createFallbackDownloader (
                                                                                 const DownloadTaskOptions& options)
 {
     const size_t bufferSize = 0x8000;
-    targetFileToUse.deleteFile();
+    ResumableDownloadTarget target (targetFileToUse, options.resumeExisting);
 
-    if (auto outputStream = targetFileToUse.createOutputStream (bufferSize))
+    if (auto outputStream = target.createOutputStream (bufferSize))
     {
         auto stream = std::make_unique<WebInputStream> (urlToUse, options.usePost);
-        stream->withExtraHeaders (options.extraHeaders);
+        stream->withExtraHeaders (target.addRangeHeader (options.extraHeaders));
 
         if (stream->connect (nullptr))
-            return std::make_unique<FallbackDownloadTask> (std::move (outputStream),
-                                                           bufferSize,
-                                                           std::move (stream),
-                                                           options.listener);
+        {
+            auto action = target.prepareForResponse (*outputStream, stream->getStatusCode(), stream->getResponseHeaders());
+
+            if (action != ResumableDownloadTarget::Action::fail)
+                return std::make_unique<FallbackDownloadTask> (std::move (outputStream),
+                                                               bufferSize,
+                                                               std::move (stream),
+                                                               options.listener,
+                                                               target,
+                                                               action == ResumableDownloadTarget::Action::alreadyComplete);
+        }
     }
 
     return nullptr;
@@ -732,22 +821,12 @@ URL::InputStreamOptions URL::InputStreamOptions::withHttpRequestCmd (const Strin
 }
 
 //==============================================================================
-std::unique_ptr<InputStream> URL::createInputStream (const InputStreamOptions& options) const
+namespace URLHelpers
 {
-    if (isLocalFile())
-    {
-       #if JUCE_IOS
-        // We may need to refresh the embedded bookmark.
-        return std::make_unique<iOSFileStreamWrapper<FileInputStream>> (const_cast<URL&> (*this));
-       #else
-        return getLocalFile().createInputStream();
-       #endif
-    }
-
-    auto webInputStream = [&]
+    static std::unique_ptr<WebInputStream> createWebInputStream (const URL& url, const URL::InputStreamOptions& options)
     {
-        const auto usePost = options.getParameterHandling() == ParameterHandling::inPostData;
-        auto stream = std::make_unique<WebInputStream> (*this, usePost);
+        const auto usePost = options.getParameterHandling() == URL::ParameterHandling::inPostData;
+        auto stream = std::make_unique<WebInputStream> (url, usePost);
 
         auto extraHeaders = options.getExtraHeaders();
 
@@ -767,7 +846,22 @@ std::unique_ptr<InputStream> URL::createInputStream (const InputStreamOptions& o
         stream->withNumRedirectsToFollow (options.getNumRedirectsToFollow());
 
         return stream;
-    }();
+    }
+}
+
+std::unique_ptr<InputStream> URL::createInputStream (const InputStreamOptions& options) const
+{
+    if (isLocalFile())
+    {
+       #if JUCE_IOS
+        // We may need to refresh the embedded bookmark.
+        return std::make_unique<iOSFileStreamWrapper<FileInputStream>> (const_cast<URL&> (*this));
+       #else
+        return getLocalFile().createInputStream();
+       #endif
+    }
+
+    auto webInputStream = URLHelpers::createWebInputStream (*this, options);
 
     struct ProgressCallbackCaller  : public WebInputStream::Listener
     {
@@ -463,6 +463,7 @@ public:
         String sharedContainer;
         DownloadTaskListener* listener = nullptr;
         bool usePost = false;
+        bool resumeExisting = false;
 
         /** Specifies headers to add to the request. */
         [[nodiscard]] auto withExtraHeaders (String value) const            { return with (&DownloadTaskOptions::extraHeaders, std::move (value)); }
@@ -482,6 +483,18 @@ public:
         /** Specifies whether a post command should be used. */
         [[nodiscard]] auto withUsePost (bool value) const                   { return with (&DownloadTaskOptions::usePost, value); }
 
+        /** Specifies whether a partially downloaded target file should be completed
+            rather than replaced.
+
+            If this is true and the target file already exists, the server is asked for
+            just the bytes that follow the end of the file, which are appended to it. If
+            the server doesn't support range requests, the file is replaced with the full
+            download as usual.
+
+            This is currently unused on iOS.
+        */
+        [[nodiscard]] auto withResumeExisting (bool value) const            { return with (&DownloadTaskOptions::resumeExisting, value); }
+
     private:
         template <typename Member, typename Value>
         [[nodiscard]] DownloadTaskOptions with (Member&& member, Value&& value) const
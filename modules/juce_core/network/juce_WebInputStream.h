@@ -223,6 +223,7 @@ class JUCE_API WebInputStream  : public InputStream
 
     class Pimpl;
     friend class Pimpl;
+    friend class HTTPClient;
 
     std::unique_ptr<Pimpl> pimpl;
     bool hasCalledConnect = false;
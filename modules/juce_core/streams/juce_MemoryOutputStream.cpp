@@ -145,6 +145,22 @@ MemoryBlock MemoryOutputStream::getMemoryBlock() const
     return MemoryBlock (getData(), getDataSize());
 }
 
+MemoryBlock MemoryOutputStream::releaseMemoryBlock()
+{
+    if (blockToUse != &internalBlock)
+    {
+        auto result = getMemoryBlock();
+        reset();
+        return result;
+    }
+
+    internalBlock.setSize (size, false);
+    auto result = std::move (internalBlock);
+    internalBlock.reset();
+    reset();
+    return result;
+}
+
 const void* MemoryOutputStream::getData() const noexcept
 {
     if (blockToUse == nullptr)
@@ -101,6 +101,16 @@ public:
     /** Returns a copy of the stream's data as a memory block. */
     MemoryBlock getMemoryBlock() const;
 
+    /** Moves the stream's data out into a memory block, and resets the stream.
+
+        When the stream owns its storage, the block is handed over without copying the
+        data, after its spare capacity has been trimmed off. If the stream is writing
+        into a user-supplied MemoryBlock or buffer, the data is copied instead.
+
+        @see getMemoryBlock, SegmentedMemoryOutputStream
+    */
+    MemoryBlock releaseMemoryBlock();
+
     //==============================================================================
     /** If the stream is writing to a user-supplied MemoryBlock, this will trim any excess
         capacity off the block, so that its length matches the amount of actual data that
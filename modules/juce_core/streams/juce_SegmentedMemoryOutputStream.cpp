@@ -0,0 +1,348 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SegmentedMemoryOutputStream::SegmentedMemoryOutputStream (size_t firstSize, size_t maxSize)
+    : firstSegmentSize (jmax ((size_t) 16, firstSize)),
+      maximumSegmentSize (jmax (firstSegmentSize, maxSize)),
+      nextSegmentSize (firstSegmentSize)
+{
+}
+
+SegmentedMemoryOutputStream::~SegmentedMemoryOutputStream() = default;
+
+void SegmentedMemoryOutputStream::flush() {}
+
+void SegmentedMemoryOutputStream::reset() noexcept
+{
+    position = 0;
+    size = 0;
+    currentSegment = 0;
+}
+
+size_t SegmentedMemoryOutputStream::findSegment (size_t pos) const noexcept
+{
+    auto next = std::upper_bound (segments.begin(), segments.end(), pos,
+                                  [] (size_t p, const Segment& s) { return p < s.start; });
+
+    return (size_t) std::distance (segments.begin(), next) - 1;
+}
+
+template <typename WriteFn>
+void SegmentedMemoryOutputStream::writeToSegments (size_t numBytes, WriteFn&& writeFn)
+{
+    while (numBytes > 0)
+    {
+        if (currentSegment == segments.size())
+        {
+            segments.push_back ({ MemoryBlock (nextSegmentSize), capacity });
+            capacity += nextSegmentSize;
+            nextSegmentSize = jmin (maximumSegmentSize, nextSegmentSize * 2);
+        }
+
+        auto& segment = segments[currentSegment];
+        const auto offset = position - segment.start;
+        const auto numToWrite = jmin (numBytes, segment.block.getSize() - offset);
+
+        writeFn (static_cast<char*> (segment.block.getData()) + offset, numToWrite);
+
+        numBytes -= numToWrite;
+        position += numToWrite;
+
+        if (offset + numToWrite == segment.block.getSize())
+            ++currentSegment;
+    }
+
+    size = jmax (size, position);
+}
+
+bool SegmentedMemoryOutputStream::write (const void* buffer, size_t howMany)
+{
+    jassert (buffer != nullptr || howMany == 0);
+    auto* source = static_cast<const char*> (buffer);
+
+    writeToSegments (howMany, [&] (char* dest, size_t num)
+    {
+        memcpy (dest, source, num);
+        source += num;
+    });
+
+    return true;
+}
+
+bool SegmentedMemoryOutputStream::writeRepeatedByte (uint8 byte, size_t howMany)
+{
+    writeToSegments (howMany, [byte] (char* dest, size_t num) { memset (dest, byte, num); });
+    return true;
+}
+
+bool SegmentedMemoryOutputStream::setPosition (int64 newPosition)
+{
+    // can't move beyond the end of the stream..
+    if (newPosition < 0 || newPosition > (int64) size)
+        return false;
+
+    position = (size_t) newPosition;
+
+    if (segments.empty())
+        return true;
+
+    currentSegment = findSegment (position);
+
+    const auto& segment = segments[currentSegment];
+
+    if (position == segment.start + segment.block.getSize())
+        ++currentSegment;
+
+    return true;
+}
+
+//==============================================================================
+int SegmentedMemoryOutputStream::getNumSegments() const noexcept
+{
+    return size == 0 ? 0 : (int) findSegment (size - 1) + 1;
+}
+
+const void* SegmentedMemoryOutputStream::getSegmentData (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumSegments()));
+    return segments[(size_t) index].block.getData();
+}
+
+size_t SegmentedMemoryOutputStream::getSegmentSize (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumSegments()));
+    const auto& segment = segments[(size_t) index];
+    return jmin (segment.block.getSize(), size - segment.start);
+}
+
+bool SegmentedMemoryOutputStream::writeTo (OutputStream& destStream) const
+{
+    for (int i = 0; i < getNumSegments(); ++i)
+        if (! destStream.write (getSegmentData (i), getSegmentSize (i)))
+            return false;
+
+    return true;
+}
+
+bool SegmentedMemoryOutputStream::writeTo (StreamingSocket& socket) const
+{
+    for (int i = 0; i < getNumSegments(); ++i)
+    {
+        auto* data = static_cast<const char*> (getSegmentData (i));
+
+        for (auto numLeft = getSegmentSize (i); numLeft > 0;)
+        {
+            const auto numSent = socket.write (data, (int) jmin (numLeft, (size_t) std::numeric_limits<int>::max()));
+
+            if (numSent <= 0)
+                return false;
+
+            data += numSent;
+            numLeft -= (size_t) numSent;
+        }
+    }
+
+    return true;
+}
+
+MemoryBlock SegmentedMemoryOutputStream::getMemoryBlock() const
+{
+    MemoryBlock result (size);
+    auto* dest = static_cast<char*> (result.getData());
+
+    for (int i = 0; i < getNumSegments(); ++i)
+    {
+        memcpy (dest, getSegmentData (i), getSegmentSize (i));
+        dest += getSegmentSize (i);
+    }
+
+    return result;
+}
+
+std::vector<MemoryBlock> SegmentedMemoryOutputStream::releaseSegments()
+{
+    std::vector<MemoryBlock> result;
+    const auto numSegments = getNumSegments();
+    result.reserve ((size_t) numSegments);
+
+    for (int i = 0; i < numSegments; ++i)
+    {
+        auto& block = segments[(size_t) i].block;
+        block.setSize (getSegmentSize (i));
+        result.push_back (std::move (block));
+    }
+
+    segments.clear();
+    capacity = 0;
+    nextSegmentSize = firstSegmentSize;
+    reset();
+    return result;
+}
+
+OutputStream& JUCE_CALLTYPE operator<< (OutputStream& stream, const SegmentedMemoryOutputStream& streamToRead)
+{
+    streamToRead.writeTo (stream);
+    return stream;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SegmentedMemoryOutputStreamTests  : public UnitTest
+{
+public:
+    SegmentedMemoryOutputStreamTests()
+        : UnitTest ("SegmentedMemoryOutputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Writing matches a MemoryOutputStream");
+        {
+            SegmentedMemoryOutputStream segmented (32, 1024);
+            MemoryOutputStream contiguous;
+
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto numBytes = (size_t) r.nextInt (300) + 1;
+                HeapBlock<char> data (numBytes);
+
+                for (size_t j = 0; j < numBytes; ++j)
+                    data[j] = (char) r.nextInt (256);
+
+                expect (segmented.write (data, numBytes));
+                contiguous.write (data, numBytes);
+
+                const auto byte = (uint8) r.nextInt (256);
+                const auto numRepeats = (size_t) r.nextInt (50);
+                expect (segmented.writeRepeatedByte (byte, numRepeats));
+                contiguous.writeRepeatedByte (byte, numRepeats);
+            }
+
+            expectEquals (segmented.getDataSize(), contiguous.getDataSize());
+            expectEquals (segmented.getPosition(), contiguous.getPosition());
+            expect (segmented.getMemoryBlock() == contiguous.getMemoryBlock());
+
+            size_t total = 0;
+
+            for (int i = 0; i < segmented.getNumSegments(); ++i)
+            {
+                expect (memcmp (segmented.getSegmentData (i), addBytesToPointer (contiguous.getData(), total), segmented.getSegmentSize (i)) == 0);
+                expect (segmented.getSegmentSize (i) <= 1024);
+                total += segmented.getSegmentSize (i);
+            }
+
+            expectEquals (total, contiguous.getDataSize());
+
+            MemoryOutputStream copy;
+            expect (segmented.writeTo (copy));
+            expect (copy.getMemoryBlock() == contiguous.getMemoryBlock());
+        }
+
+        beginTest ("Seeking and overwriting");
+        {
+            SegmentedMemoryOutputStream segmented (16, 64);
+            MemoryOutputStream contiguous;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                segmented.writeInt (i);
+                contiguous.writeInt (i);
+            }
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto pos = (int64) r.nextInt ((int) contiguous.getDataSize() + 1);
+                expect (segmented.setPosition (pos));
+                contiguous.setPosition (pos);
+
+                const auto value = r.nextInt64();
+                segmented.writeInt64 (value);
+                contiguous.writeInt64 (value);
+
+                expectEquals (segmented.getPosition(), contiguous.getPosition());
+            }
+
+            expect (! segmented.setPosition ((int64) segmented.getDataSize() + 1));
+            expect (segmented.getMemoryBlock() == contiguous.getMemoryBlock());
+        }
+
+        beginTest ("Releasing the segments");
+        {
+            SegmentedMemoryOutputStream segmented (64, 256);
+            MemoryOutputStream contiguous;
+
+            for (int i = 0; i < 300; ++i)
+            {
+                segmented << "line " << i << newLine;
+                contiguous << "line " << i << newLine;
+            }
+
+            const auto numSegments = segmented.getNumSegments();
+            const auto* firstSegmentData = segmented.getSegmentData (0);
+            const auto segments = segmented.releaseSegments();
+
+            expectEquals ((int) segments.size(), numSegments);
+            expect (segments.front().getData() == firstSegmentData);
+            expectEquals (segmented.getDataSize(), (size_t) 0);
+            expectEquals (segmented.getNumSegments(), 0);
+
+            MemoryBlock joined;
+
+            for (auto& s : segments)
+                joined.append (s.getData(), s.getSize());
+
+            expect (joined == contiguous.getMemoryBlock());
+
+            segmented << "again";
+            expect (segmented.getMemoryBlock() == MemoryBlock ("again", 5));
+        }
+
+        beginTest ("Releasing a MemoryOutputStream's block");
+        {
+            MemoryOutputStream mo;
+            mo << "some text";
+
+            auto block = mo.releaseMemoryBlock();
+            expect (block == MemoryBlock ("some text", 9));
+            expectEquals (mo.getDataSize(), (size_t) 0);
+
+            mo << "more";
+            expectEquals (mo.toString(), String ("more"));
+        }
+    }
+};
+
+static SegmentedMemoryOutputStreamTests segmentedMemoryOutputStreamTests;
+
+#endif
+
+} // namespace juce
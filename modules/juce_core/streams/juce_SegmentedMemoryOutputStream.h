@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingSocket;
+
+//==============================================================================
+/**
+    Writes data to a chain of memory blocks, adding more blocks as it grows.
+
+    Unlike a MemoryOutputStream, which keeps everything in one contiguous block that
+    has to be reallocated and copied as it grows, this stream never moves data that
+    has already been written. That keeps the cost of writing very large amounts of
+    data down, and avoids needing room for both the old and new copies of a block
+    while it's being resized.
+
+    Each new block is twice the size of the previous one, up to a limit. Once the data
+    has been written, it can be sent on to another stream or a socket a block at a time
+    without joining it up first, or the blocks can be taken out of the stream with
+    releaseSegments() without copying them.
+
+    @see MemoryOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  SegmentedMemoryOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates an empty stream.
+
+        @param firstSegmentSize     the size of the first block to be allocated
+        @param maxSegmentSize       the largest size that a block can grow to
+    */
+    explicit SegmentedMemoryOutputStream (size_t firstSegmentSize = 4096,
+                                          size_t maxSegmentSize = 4 * 1024 * 1024);
+
+    /** Destructor. */
+    ~SegmentedMemoryOutputStream() override;
+
+    //==============================================================================
+    /** Returns the number of bytes of data that have been written to the stream. */
+    size_t getDataSize() const noexcept                 { return size; }
+
+    /** Returns the number of blocks that contain the data written so far. */
+    int getNumSegments() const noexcept;
+
+    /** Returns a pointer to the start of one of the blocks of data.
+        @see getNumSegments, getSegmentSize
+    */
+    const void* getSegmentData (int index) const noexcept;
+
+    /** Returns the number of bytes of data in one of the blocks.
+        @see getNumSegments, getSegmentData
+    */
+    size_t getSegmentSize (int index) const noexcept;
+
+    /** Resets the stream, clearing any data that has been written to it so far.
+        The blocks that were allocated are kept, and will be reused.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Writes all the data to another stream, one block at a time.
+
+        Large blocks are passed straight through, so a FileOutputStream writes them to
+        the file without copying them into its buffer first.
+
+        @returns false if the destination stream failed to write any of the data
+    */
+    bool writeTo (OutputStream& destStream) const;
+
+    /** Sends all the data to a socket, one block at a time.
+        @returns false if the socket failed to send any of the data
+    */
+    bool writeTo (StreamingSocket& socket) const;
+
+    /** Returns a copy of all the data, joined into a single memory block. */
+    MemoryBlock getMemoryBlock() const;
+
+    /** Removes the blocks from the stream and returns them, without copying the data.
+
+        Each block is trimmed to the size of the data it contains, and together they
+        hold everything that was written, in order. The stream is left empty.
+    */
+    std::vector<MemoryBlock> releaseSegments();
+
+    //==============================================================================
+    /** Does nothing, as the data is already held in memory. */
+    void flush() override;
+
+    bool write (const void*, size_t) override;
+    int64 getPosition() override                        { return (int64) position; }
+    bool setPosition (int64) override;
+    bool writeRepeatedByte (uint8 byte, size_t numTimesToRepeat) override;
+
+private:
+    //==============================================================================
+    struct Segment
+    {
+        MemoryBlock block;
+        size_t start;
+    };
+
+    std::vector<Segment> segments;
+    size_t position = 0, size = 0, capacity = 0, currentSegment = 0;
+    const size_t firstSegmentSize, maximumSegmentSize;
+    size_t nextSegmentSize;
+
+    template <typename WriteFn>
+    void writeToSegments (size_t numBytes, WriteFn&&);
+
+    size_t findSegment (size_t pos) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SegmentedMemoryOutputStream)
+};
+
+/** Copies all the data that has been written to a SegmentedMemoryOutputStream into another stream. */
+OutputStream& JUCE_CALLTYPE operator<< (OutputStream& stream, const SegmentedMemoryOutputStream& streamToRead);
+
+} // namespace juce
@@ -67,6 +67,7 @@
 #include <queue>
 #include <set>
 #include <sstream>
+#include <string_view>
 #include <thread>
 #include <typeindex>
 #include <unordered_map>
@@ -85,6 +86,8 @@ JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4514 4245 4100)
 
 #if JUCE_MSVC
  #include <intrin.h>
+#elif JUCE_INTEL && defined (__SSE2__)
+ #include <emmintrin.h>
 #endif
 
 
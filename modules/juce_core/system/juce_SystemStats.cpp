@@ -96,7 +96,7 @@ struct CPUInformation
          hasAVX512F  = false, hasAVX512BW   = false, hasAVX512CD   = false,
          hasAVX512DQ = false, hasAVX512ER   = false, hasAVX512IFMA = false,
          hasAVX512PF = false, hasAVX512VBMI = false, hasAVX512VL   = false,
-         hasAVX512VPOPCNTDQ = false,
+         hasAVX512VPOPCNTDQ = false, hasSHA = false,
          hasNeon = false;
 };
 
@@ -108,6 +108,43 @@ static const CPUInformation& getCPUInformation() noexcept
 
 int SystemStats::getNumCpus() noexcept          { return getCPUInformation().numLogicalCPUs; }
 int SystemStats::getNumPhysicalCpus() noexcept  { return getCPUInformation().numPhysicalCPUs; }
+
+// Implemented in the platform-specific code. Returns an empty list if the OS provides no topology information.
+std::vector<SystemStats::LogicalCpu> juce_readCpuTopology();
+
+const std::vector<SystemStats::LogicalCpu>& SystemStats::getCpuTopology()
+{
+    static const auto topology = []
+    {
+        auto cpus = juce_readCpuTopology();
+
+        if (cpus.empty())
+        {
+            for (int i = 0; i < getNumCpus(); ++i)
+            {
+                LogicalCpu cpu;
+                cpu.index = cpu.coreId = cpu.cacheDomain = i;
+                cpus.push_back (cpu);
+            }
+        }
+
+        std::sort (cpus.begin(), cpus.end(), [] (const auto& a, const auto& b) { return a.index < b.index; });
+        return cpus;
+    }();
+
+    return topology;
+}
+
+int SystemStats::getNumPhysicalCpus (CpuCoreType type)
+{
+    std::set<std::pair<int, int>> cores;
+
+    for (auto& cpu : getCpuTopology())
+        if (cpu.coreType == type)
+            cores.emplace (cpu.packageId, cpu.coreId);
+
+    return (int) cores.size();
+}
 bool SystemStats::hasMMX() noexcept             { return getCPUInformation().hasMMX; }
 bool SystemStats::has3DNow() noexcept           { return getCPUInformation().has3DNow; }
 bool SystemStats::hasFMA3() noexcept            { return getCPUInformation().hasFMA3; }
@@ -130,6 +167,7 @@ bool SystemStats::hasAVX512PF() noexcept        { return getCPUInformation().has
 bool SystemStats::hasAVX512VBMI() noexcept      { return getCPUInformation().hasAVX512VBMI; }
 bool SystemStats::hasAVX512VL() noexcept        { return getCPUInformation().hasAVX512VL; }
 bool SystemStats::hasAVX512VPOPCNTDQ() noexcept { return getCPUInformation().hasAVX512VPOPCNTDQ; }
+bool SystemStats::hasSHA() noexcept             { return getCPUInformation().hasSHA; }
 bool SystemStats::hasNeon() noexcept            { return getCPUInformation().hasNeon; }
 
 
@@ -166,6 +166,53 @@ public:
     /** Returns the number of physical CPU cores. */
     static int getNumPhysicalCpus() noexcept;
 
+    /** The kinds of core found in processors that mix fast and power-efficient cores. */
+    enum class CpuCoreType
+    {
+        performance,    /**< A high-performance core. If all of the machine's cores are the same, they're all reported as this type. */
+        efficiency      /**< A lower-power core, such as an Apple or Intel E-core, or an ARM "LITTLE" core. */
+    };
+
+    /** Describes one of the machine's logical CPUs.
+        @see getCpuTopology
+    */
+    struct LogicalCpu
+    {
+        /** The index the OS uses for this CPU, i.e. its bit in a thread affinity mask. */
+        int index = 0;
+
+        /** Identifies the physical core that this CPU belongs to. Logical CPUs which are
+            SMT siblings (hyper-threads) of one another have the same coreId.
+        */
+        int coreId = 0;
+
+        /** Identifies the physical package (socket) that this CPU belongs to. */
+        int packageId = 0;
+
+        /** Identifies the largest cache that this CPU uses. CPUs with the same value share
+            that cache, e.g. the L2 cache of an Apple Silicon cluster or the L3 cache of
+            an AMD CCX.
+        */
+        int cacheDomain = 0;
+
+        /** The type of core that this CPU belongs to. */
+        CpuCoreType coreType = CpuCoreType::performance;
+    };
+
+    /** Returns a description of each of the machine's logical CPUs, ordered by index.
+
+        If the OS doesn't provide any topology information, each logical CPU is described
+        as a separate performance core.
+
+        On macOS and iOS, the OS doesn't reveal which CPU indexes belong to which cluster,
+        and threads can't be bound to particular cores, so the indexes are nominal: the
+        performance cores are listed first, followed by the efficiency cores.
+    */
+    static const std::vector<LogicalCpu>& getCpuTopology();
+
+    /** Returns the number of physical cores of a particular type. */
+    static int getNumPhysicalCpus (CpuCoreType);
+
     /** Returns the approximate CPU speed.
         @returns    the speed in megahertz, e.g. 1500, 2500, 32000 (depending on
                     what year you're reading this...)
@@ -204,6 +251,7 @@ public:
     static bool hasAVX512VBMI() noexcept;      /**< Returns true if Intel AVX-512 Vector Bit Manipulation instructions are available. */
     static bool hasAVX512VL() noexcept;        /**< Returns true if Intel AVX-512 Vector Length instructions are available. */
     static bool hasAVX512VPOPCNTDQ() noexcept; /**< Returns true if Intel AVX-512 Vector Population Count Double and Quad-word instructions are available. */
+    static bool hasSHA() noexcept;             /**< Returns true if Intel SHA extensions are available. */
     static bool hasNeon() noexcept;            /**< Returns true if ARM NEON instructions are available. */
 
     //==============================================================================
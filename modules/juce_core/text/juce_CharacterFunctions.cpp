@@ -174,6 +174,281 @@ juce_wchar CharacterFunctions::getUnicodeCharFromWindows1252Codepage (const uint
     return (juce_wchar) lookup[c - 0x80];
 }
 
+//==============================================================================
+/*  This is an implementation of Florian Loitsch's Grisu2 algorithm, from "Printing
+    Floating-Point Numbers Quickly and Accurately with Integers" (PLDI 2010).
+
+    The value and the two boundaries of its rounding interval are scaled by a cached power
+    of ten into a range where they can be handled with 64-bit integer arithmetic, and then
+    digits are generated until the result falls inside the (slightly narrowed) interval.
+    That makes the result always read back correctly, and it's the shortest possible result
+    in all but a tiny fraction of cases.
+*/
+namespace ShortestDoubleDigits
+{
+    struct DiyFp
+    {
+        uint64 f;
+        int e;
+    };
+
+    static DiyFp multiply (DiyFp x, DiyFp y) noexcept
+    {
+        const auto a = x.f >> 32, b = x.f & 0xffffffffu;
+        const auto c = y.f >> 32, d = y.f & 0xffffffffu;
+
+        const auto ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+        auto mid = (bd >> 32) + (ad & 0xffffffffu) + (bc & 0xffffffffu);
+        mid += (uint64) 1 << 31; // round to nearest
+
+        return { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+    }
+
+    static DiyFp normalise (DiyFp x) noexcept
+    {
+        while ((x.f >> 63) == 0)
+        {
+            x.f <<= 1;
+            --x.e;
+        }
+
+        return x;
+    }
+
+    struct CachedPower
+    {
+        uint64 f;
+        int e, k;
+    };
+
+    // Normalised approximations of 10^k, for k = -348 to 340 in steps of 8
+    static constexpr CachedPower cachedPowers[] =
+    {
+        { 0xfa8fd5a0081c0288ULL, -1220, -348 },
+        { 0xbaaee17fa23ebf76ULL, -1193, -340 },
+        { 0x8b16fb203055ac76ULL, -1166, -332 },
+        { 0xcf42894a5dce35eaULL, -1140, -324 },
+        { 0x9a6bb0aa55653b2dULL, -1113, -316 },
+        { 0xe61acf033d1a45dfULL, -1087, -308 },
+        { 0xab70fe17c79ac6caULL, -1060, -300 },
+        { 0xff77b1fcbebcdc4fULL, -1034, -292 },
+        { 0xbe5691ef416bd60cULL, -1007, -284 },
+        { 0x8dd01fad907ffc3cULL,  -980, -276 },
+        { 0xd3515c2831559a83ULL,  -954, -268 },
+        { 0x9d71ac8fada6c9b5ULL,  -927, -260 },
+        { 0xea9c227723ee8bcbULL,  -901, -252 },
+        { 0xaecc49914078536dULL,  -874, -244 },
+        { 0x823c12795db6ce57ULL,  -847, -236 },
+        { 0xc21094364dfb5637ULL,  -821, -228 },
+        { 0x9096ea6f3848984fULL,  -794, -220 },
+        { 0xd77485cb25823ac7ULL,  -768, -212 },
+        { 0xa086cfcd97bf97f4ULL,  -741, -204 },
+        { 0xef340a98172aace5ULL,  -715, -196 },
+        { 0xb23867fb2a35b28eULL,  -688, -188 },
+        { 0x84c8d4dfd2c63f3bULL,  -661, -180 },
+        { 0xc5dd44271ad3cdbaULL,  -635, -172 },
+        { 0x936b9fcebb25c996ULL,  -608, -164 },
+        { 0xdbac6c247d62a584ULL,  -582, -156 },
+        { 0xa3ab66580d5fdaf6ULL,  -555, -148 },
+        { 0xf3e2f893dec3f126ULL,  -529, -140 },
+        { 0xb5b5ada8aaff80b8ULL,  -502, -132 },
+        { 0x87625f056c7c4a8bULL,  -475, -124 },
+        { 0xc9bcff6034c13053ULL,  -449, -116 },
+        { 0x964e858c91ba2655ULL,  -422, -108 },
+        { 0xdff9772470297ebdULL,  -396, -100 },
+        { 0xa6dfbd9fb8e5b88fULL,  -369,  -92 },
+        { 0xf8a95fcf88747d94ULL,  -343,  -84 },
+        { 0xb94470938fa89bcfULL,  -316,  -76 },
+        { 0x8a08f0f8bf0f156bULL,  -289,  -68 },
+        { 0xcdb02555653131b6ULL,  -263,  -60 },
+        { 0x993fe2c6d07b7facULL,  -236,  -52 },
+        { 0xe45c10c42a2b3b06ULL,  -210,  -44 },
+        { 0xaa242499697392d3ULL,  -183,  -36 },
+        { 0xfd87b5f28300ca0eULL,  -157,  -28 },
+        { 0xbce5086492111aebULL,  -130,  -20 },
+        { 0x8cbccc096f5088ccULL,  -103,  -12 },
+        { 0xd1b71758e219652cULL,   -77,   -4 },
+        { 0x9c40000000000000ULL,   -50,    4 },
+        { 0xe8d4a51000000000ULL,   -24,   12 },
+        { 0xad78ebc5ac620000ULL,     3,   20 },
+        { 0x813f3978f8940984ULL,    30,   28 },
+        { 0xc097ce7bc90715b3ULL,    56,   36 },
+        { 0x8f7e32ce7bea5c70ULL,    83,   44 },
+        { 0xd5d238a4abe98068ULL,   109,   52 },
+        { 0x9f4f2726179a2245ULL,   136,   60 },
+        { 0xed63a231d4c4fb27ULL,   162,   68 },
+        { 0xb0de65388cc8ada8ULL,   189,   76 },
+        { 0x83c7088e1aab65dbULL,   216,   84 },
+        { 0xc45d1df942711d9aULL,   242,   92 },
+        { 0x924d692ca61be758ULL,   269,  100 },
+        { 0xda01ee641a708deaULL,   295,  108 },
+        { 0xa26da3999aef774aULL,   322,  116 },
+        { 0xf209787bb47d6b85ULL,   348,  124 },
+        { 0xb454e4a179dd1877ULL,   375,  132 },
+        { 0x865b86925b9bc5c2ULL,   402,  140 },
+        { 0xc83553c5c8965d3dULL,   428,  148 },
+        { 0x952ab45cfa97a0b3ULL,   455,  156 },
+        { 0xde469fbd99a05fe3ULL,   481,  164 },
+        { 0xa59bc234db398c25ULL,   508,  172 },
+        { 0xf6c69a72a3989f5cULL,   534,  180 },
+        { 0xb7dcbf5354e9beceULL,   561,  188 },
+        { 0x88fcf317f22241e2ULL,   588,  196 },
+        { 0xcc20ce9bd35c78a5ULL,   614,  204 },
+        { 0x98165af37b2153dfULL,   641,  212 },
+        { 0xe2a0b5dc971f303aULL,   667,  220 },
+        { 0xa8d9d1535ce3b396ULL,   694,  228 },
+        { 0xfb9b7cd9a4a7443cULL,   720,  236 },
+        { 0xbb764c4ca7a44410ULL,   747,  244 },
+        { 0x8bab8eefb6409c1aULL,   774,  252 },
+        { 0xd01fef10a657842cULL,   800,  260 },
+        { 0x9b10a4e5e9913129ULL,   827,  268 },
+        { 0xe7109bfba19c0c9dULL,   853,  276 },
+        { 0xac2820d9623bf429ULL,   880,  284 },
+        { 0x80444b5e7aa7cf85ULL,   907,  292 },
+        { 0xbf21e44003acdd2dULL,   933,  300 },
+        { 0x8e679c2f5e44ff8fULL,   960,  308 },
+        { 0xd433179d9c8cb841ULL,   986,  316 },
+        { 0x9e19db92b4e31ba9ULL,  1013,  324 },
+        { 0xeb96bf6ebadf77d9ULL,  1039,  332 },
+        { 0xaf87023b9bf0ee6bULL,  1066,  340 },
+    };
+
+    // The scaled values must have binary exponents in this range for the digit generation to work
+    static constexpr int minExponent = -60, maxExponent = -32;
+
+    static const CachedPower& getCachedPowerFor (int e) noexcept
+    {
+        // (log10 (2) is about 78913 / 2^18)
+        const auto wanted = minExponent - e - 1;
+        const auto k = (wanted * 78913) / (1 << 18) + (wanted > 0 ? 1 : 0);
+        auto index = jlimit (0, (int) numElementsInArray (cachedPowers) - 1, (348 + k + 7) / 8);
+
+        while (index > 0 && cachedPowers[index].e + e + 64 > maxExponent)
+            --index;
+
+        while (index < (int) numElementsInArray (cachedPowers) - 1 && cachedPowers[index].e + e + 64 < minExponent)
+            ++index;
+
+        jassert (cachedPowers[index].e + e + 64 >= minExponent && cachedPowers[index].e + e + 64 <= maxExponent);
+        return cachedPowers[index];
+    }
+
+    // Moves the last digit closer to the real value, while staying inside the interval
+    static void round (char* digits, int numDigits, uint64 distanceToUpper, uint64 delta, uint64 rest, uint64 tenKappa) noexcept
+    {
+        while (rest < distanceToUpper
+                && delta - rest >= tenKappa
+                && (rest + tenKappa < distanceToUpper || distanceToUpper - rest > rest + tenKappa - distanceToUpper))
+        {
+            --digits[numDigits - 1];
+            rest += tenKappa;
+        }
+    }
+
+    static int generateDigits (char* digits, int& decimalExponent, DiyFp lower, DiyFp w, DiyFp upper) noexcept
+    {
+        static constexpr uint32 powersOf10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                                 10000000, 100000000, 1000000000 };
+
+        const auto shift = -upper.e;
+        const auto one = (uint64) 1 << shift;
+        auto delta = upper.f - lower.f;
+        auto distanceToUpper = upper.f - w.f;
+
+        auto integral = (uint32) (upper.f >> shift);
+        auto fraction = upper.f & (one - 1);
+
+        int kappa = 10;
+
+        while (kappa > 0 && integral < powersOf10[kappa - 1])
+            --kappa;
+
+        int numDigits = 0;
+
+        while (kappa > 0)
+        {
+            const auto divisor = powersOf10[kappa - 1];
+            const auto digit = integral / divisor;
+            integral %= divisor;
+
+            if (digit != 0 || numDigits != 0)
+                digits[numDigits++] = (char) ('0' + digit);
+
+            --kappa;
+            const auto rest = ((uint64) integral << shift) + fraction;
+
+            if (rest <= delta)
+            {
+                decimalExponent += kappa;
+                round (digits, numDigits, distanceToUpper, delta, rest, (uint64) powersOf10[kappa] << shift);
+                return numDigits;
+            }
+        }
+
+        for (;;)
+        {
+            fraction *= 10;
+            delta *= 10;
+            distanceToUpper *= 10;
+
+            const auto digit = (char) (fraction >> shift);
+
+            if (digit != 0 || numDigits != 0)
+                digits[numDigits++] = (char) ('0' + digit);
+
+            fraction &= one - 1;
+            --kappa;
+
+            if (fraction <= delta)
+            {
+                decimalExponent += kappa;
+                round (digits, numDigits, distanceToUpper, delta, fraction, one);
+                return numDigits;
+            }
+        }
+    }
+}
+
+int CharacterFunctions::writeShortestDigits (double value, char* digits, int& decimalExponent) noexcept
+{
+    using namespace ShortestDoubleDigits;
+
+    jassert (std::isfinite (value) && value > 0);
+
+    uint64 bits;
+    memcpy (&bits, &value, sizeof (bits));
+
+    constexpr auto hiddenBit = (uint64) 1 << 52;
+    const auto significand = bits & (hiddenBit - 1);
+    const auto biasedExponent = (int) (bits >> 52);
+
+    const DiyFp v = biasedExponent != 0 ? DiyFp { significand + hiddenBit, biasedExponent - 1075 }
+                                        : DiyFp { significand, -1074 };
+
+    // The boundaries are half-way between this value and its neighbours. The lower neighbour
+    // is closer when the value is an exact power of two.
+    const auto upper = normalise ({ (v.f << 1) + 1, v.e - 1 });
+    const auto lowerIsCloser = significand == 0 && biasedExponent > 1;
+    auto lower = lowerIsCloser ? DiyFp { (v.f << 2) - 1, v.e - 2 }
+                               : DiyFp { (v.f << 1) - 1, v.e - 1 };
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    const auto& power = getCachedPowerFor (upper.e);
+    const DiyFp c { power.f, power.e };
+
+    auto w = multiply (normalise (v), c);
+    auto scaledLower = multiply (lower, c);
+    auto scaledUpper = multiply (upper, c);
+
+    // the products may be out by one unit, so narrow the interval to be safe
+    ++scaledLower.f;
+    --scaledUpper.f;
+
+    decimalExponent = -power.k;
+    return generateDigits (digits, decimalExponent, scaledLower, w, scaledUpper);
+}
+
 
 //==============================================================================
 //==============================================================================
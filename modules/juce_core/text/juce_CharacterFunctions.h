@@ -138,6 +138,22 @@ public:
     /** Converts a byte of Windows 1252 codepage to unicode. */
     static juce_wchar getUnicodeCharFromWindows1252Codepage (uint8 windows1252Char) noexcept;
 
+    //==============================================================================
+    /** Writes the decimal digits of the shortest number that reads back as exactly the
+        given value.
+
+        The value must be finite and greater than zero. The digits are written to the
+        buffer without a null terminator, and the function returns the number of digits,
+        which will be between 1 and 17. The number that they represent is the integer
+        formed by the digits multiplied by 10 to the power of decimalExponent.
+
+        Very occasionally, this may produce one more digit than is strictly necessary,
+        but the result will always read back as exactly the same value.
+
+        @see readDoubleValue
+    */
+    static int writeShortestDigits (double value, char* digits, int& decimalExponent) noexcept;
+
     //==============================================================================
     /** Parses a character string to read a floating-point number.
         Note that this will advance the pointer that is passed in, leaving it at
@@ -315,8 +331,9 @@ public:
 
        #else   // ! JUCE_MINGW
 
-        int numSigFigs = 0, extraExponent = 0;
-        bool decimalPointFound = false, leadingZeros = false;
+        int numSigFigs = 0, extraExponent = 0, numFractionDigits = 0;
+        bool decimalPointFound = false, leadingZeros = false, digitsDropped = false;
+        uint64 mantissa = 0;
 
         for (;;)
         {
@@ -327,12 +344,25 @@ public:
                 if (decimalPointFound)
                 {
                     if (numSigFigs >= maxSignificantDigits)
+                    {
+                        digitsDropped = true;
                         continue;
+                    }
+
+                    if (numSigFigs == 0 && digit == 0)
+                    {
+                        leadingZeros = true;
+                        --extraExponent;
+                        continue;
+                    }
+
+                    ++numFractionDigits;
                 }
                 else
                 {
                     if (numSigFigs >= maxSignificantDigits)
                     {
+                        digitsDropped = true;
                         ++extraExponent;
                         continue;
                     }
@@ -345,6 +375,7 @@ public:
                 }
 
                 *writePtr++ = (char) ('0' + (char) digit);
+                mantissa = mantissa * 10 + (uint64) digit;
                 numSigFigs++;
             }
             else if ((! decimalPointFound) && *text == '.')
@@ -365,6 +396,9 @@ public:
             return 0.0;
         }
 
+        if (numSigFigs == 0)
+            *writePtr++ = '0';
+
         auto writeExponentDigits = [] (int exponent, char* destination)
         {
             auto exponentDivisor = 100;
@@ -380,7 +414,12 @@ public:
             *destination++ = (char) ('0' + (char) exponent);
         };
 
+        // A number below 1e-324 is less than half the smallest denormal, so will be zero
+        const auto numIntegerDigits = numSigFigs - numFractionDigits;
+        constexpr int smallestExponent = -324;
+
         c = *text;
+        auto totalExponent = extraExponent;
 
         if (c == 'e' || c == 'E')
         {
@@ -415,10 +454,11 @@ public:
                 text = startOfExponent;
 
             exponent = extraExponent + (parsedExponentIsPositive ? exponent : -exponent);
+            totalExponent = exponent;
 
             if (exponent < 0)
             {
-                if (exponent < std::numeric_limits<double>::min_exponent10 - 1)
+                if (exponent + numIntegerDigits < smallestExponent)
                     return isNegative ? -0.0 : 0.0;
 
                 *writePtr++ = '-';
@@ -436,6 +476,34 @@ public:
             *writePtr++ = 'e';
             writeExponentDigits (extraExponent, writePtr);
         }
+        else if (extraExponent < 0)
+        {
+            if (extraExponent < smallestExponent)
+                return isNegative ? -0.0 : 0.0;
+
+            *writePtr++ = 'e';
+            *writePtr++ = '-';
+            writeExponentDigits (-extraExponent, writePtr);
+        }
+
+        // If the digits and the power of ten can both be held exactly in doubles, multiplying
+        // or dividing them involves only a single rounding step, which gives the correctly
+        // rounded result without needing the much slower general-purpose conversion.
+        if (! digitsDropped && mantissa != 0 && mantissa <= ((uint64) 1 << 53))
+        {
+            constexpr double exactPowersOf10[] = { 1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+                                                   1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+                                                   1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+
+            const auto decimalExponent = totalExponent - numFractionDigits;
+
+            if (decimalExponent >= -22 && decimalExponent <= 22)
+            {
+                const auto r = decimalExponent < 0 ? (double) mantissa / exactPowersOf10[-decimalExponent]
+                                                   : (double) mantissa * exactPowersOf10[decimalExponent];
+                return isNegative ? -r : r;
+            }
+        }
 
        #if JUCE_WINDOWS
         static _locale_t locale = _create_locale (LC_ALL, "C");
@@ -29,9 +29,10 @@ namespace juce
 
     Comparing two Identifier objects is very fast (an O(1) operation), but creating
     them can be slower than just using a String directly, so the optimal way to use them
-    is to keep some static Identifier objects for the things you use often.
+    is to keep some static Identifier objects for the things you use often, or to use the
+    JUCE_IDENTIFIER macro for names that are written as string literals.
 
-    @see NamedValueSet, ValueTree
+    @see NamedValueSet, ValueTree, JUCE_IDENTIFIER
 
     @tags{Core}
 */
@@ -130,3 +131,18 @@ private:
 };
 
 } // namespace juce
+
+//==============================================================================
+/** Returns an Identifier for a string literal, which is only looked up in the
+    StringPool the first time that this particular line of code is executed.
+
+    Each use of the macro keeps its own static Identifier, so after the first call it
+    costs no more than referring to an Identifier that you'd declared yourself, e.g.
+    @code
+    auto colour = tree.getProperty (JUCE_IDENTIFIER ("colour"));
+    @endcode
+
+    @see Identifier
+*/
+#define JUCE_IDENTIFIER(stringLiteral) \
+    ([]() -> const juce::Identifier& { static const juce::Identifier juceIdentifierFromLiteral (stringLiteral); return juceIdentifierFromLiteral; }())
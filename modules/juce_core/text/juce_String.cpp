@@ -466,8 +466,180 @@ namespace NumberToStringConverters
         }
     };
 
+    //==============================================================================
+    /*  For the common cases, the digits can be found by scaling the value by an exactly
+        representable power of ten and rounding it to an integer. The product is within
+        half an ulp of the real value, so unless it lands too close to a rounding tie to
+        be sure which way it should go, the result matches what the stream would print.
+    */
+    static constexpr double exactPowersOf10[] = { 1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+                                                  1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+                                                  1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+
+    static double scaleByPowerOf10 (double n, int exponent) noexcept
+    {
+        return exponent < 0 ? n / exactPowersOf10[-exponent]
+                            : n * exactPowersOf10[exponent];
+    }
+
+    static bool roundUnambiguously (double scaled, uint64& result) noexcept
+    {
+        const auto integral = std::floor (scaled);
+        const auto distanceFromTie = std::abs (scaled - integral - 0.5);
+
+        if (distanceFromTie <= scaled * (1.0 / (double) ((uint64) 1 << 50)))
+            return false;
+
+        result = (uint64) integral + (scaled - integral > 0.5 ? 1 : 0);
+        return true;
+    }
+
+    static char* writeDigits (char* t, uint64 n, int minNumDigits) noexcept
+    {
+        char digits[24];
+        auto* end = digits + numElementsInArray (digits);
+        auto* start = end;
+
+        while (n > 0 || end - start < minNumDigits)
+        {
+            *--start = (char) ('0' + (char) (n % 10));
+            n /= 10;
+        }
+
+        memcpy (t, start, (size_t) (end - start));
+        return t + (end - start);
+    }
+
+    static bool writeFixed (char* buffer, double n, int numDecPlaces, size_t& len) noexcept
+    {
+        if (numDecPlaces > 15)
+            return false;
+
+        const auto scaled = std::abs (n) * exactPowersOf10[numDecPlaces];
+        uint64 rounded;
+
+        if (! (scaled < 1.0e15) || ! roundUnambiguously (scaled, rounded))
+            return false;
+
+        auto* t = buffer;
+
+        if (std::signbit (n))
+            *t++ = '-';
+
+        t = writeDigits (t, rounded, numDecPlaces + 1);
+
+        // shuffle the fractional digits along to make room for the decimal point
+        memmove (t - numDecPlaces + 1, t - numDecPlaces, (size_t) numDecPlaces);
+        *(t - numDecPlaces) = '.';
+
+        len = (size_t) (t + 1 - buffer);
+        return true;
+    }
+
+    // Matches the stream's default format, which is the same as printf's "%g"
+    static bool writeGeneral (char* buffer, double n, size_t& len) noexcept
+    {
+        constexpr int precision = 6;
+        auto* t = buffer;
+
+        if (std::signbit (n))
+            *t++ = '-';
+
+        const auto a = std::abs (n);
+
+        if (a == 0)
+        {
+            *t++ = '0';
+            len = (size_t) (t - buffer);
+            return true;
+        }
+
+        if (! (a >= 1.0e-15 && a < 1.0e21))
+            return false;
+
+        auto exponent = (int) std::floor (std::log10 (a));
+        auto scaled = scaleByPowerOf10 (a, precision - 1 - exponent);
+
+        if (scaled < exactPowersOf10[precision - 1])
+            scaled = scaleByPowerOf10 (a, precision - 1 - --exponent);
+        else if (scaled >= exactPowersOf10[precision])
+            scaled = scaleByPowerOf10 (a, precision - 1 - ++exponent);
+
+        uint64 rounded;
+
+        if (! roundUnambiguously (scaled, rounded))
+            return false;
+
+        if (rounded >= (uint64) exactPowersOf10[precision])
+        {
+            rounded /= 10;
+            ++exponent;
+        }
+
+        char digits[precision];
+        writeDigits (digits, rounded, precision);
+
+        auto numDigits = precision;
+
+        while (numDigits > 1 && digits[numDigits - 1] == '0')
+            --numDigits;
+
+        if (exponent >= -4 && exponent < precision)
+        {
+            if (exponent < 0)
+            {
+                *t++ = '0';
+                *t++ = '.';
+
+                for (int i = -1; i > exponent; --i)
+                    *t++ = '0';
+
+                memcpy (t, digits, (size_t) numDigits);
+                t += numDigits;
+            }
+            else
+            {
+                const auto numIntegerDigits = exponent + 1;
+                memcpy (t, digits, (size_t) numIntegerDigits);
+                t += numIntegerDigits;
+
+                if (numDigits > numIntegerDigits)
+                {
+                    *t++ = '.';
+                    memcpy (t, digits + numIntegerDigits, (size_t) (numDigits - numIntegerDigits));
+                    t += numDigits - numIntegerDigits;
+                }
+            }
+        }
+        else
+        {
+            *t++ = digits[0];
+
+            if (numDigits > 1)
+            {
+                *t++ = '.';
+                memcpy (t, digits + 1, (size_t) (numDigits - 1));
+                t += numDigits - 1;
+            }
+
+            *t++ = 'e';
+            *t++ = exponent < 0 ? '-' : '+';
+            t = writeDigits (t, (uint64) std::abs (exponent), 2);
+        }
+
+        len = (size_t) (t - buffer);
+        return true;
+    }
+
     static char* doubleToString (char* buffer, double n, int numDecPlaces, bool useScientificNotation, size_t& len) noexcept
     {
+        if (! useScientificNotation && std::isfinite (n))
+        {
+            if (numDecPlaces > 0 ? writeFixed (buffer, n, numDecPlaces, len)
+                                 : writeGeneral (buffer, n, len))
+                return buffer;
+        }
+
         StackArrayStream strm (buffer);
         len = strm.writeDouble (n, numDecPlaces, useScientificNotation);
         jassert (len <= charsNeededForDouble);
@@ -2186,6 +2358,125 @@ StringRef::StringRef (const String& string) noexcept   : text (string.getCharPoi
 StringRef::StringRef (const std::string& string)       : StringRef (string.c_str()) {}
 
 //==============================================================================
+namespace NumberToStringConverters
+{
+    /*  Writes the shortest string that will read back as exactly the same value, using
+        scientific notation for very large and very small numbers, and always including a
+        decimal point so that the result can't be mistaken for an integer.
+    */
+    static size_t serialiseDouble (char* buffer, double input) noexcept
+    {
+        if (! std::isfinite (input) || input == 0)
+        {
+            size_t len;
+            doubleToString (buffer, input, input == 0 ? 1 : 0, false, len);
+            return len;
+        }
+
+        auto* t = buffer;
+
+        if (input < 0)
+            *t++ = '-';
+
+        const auto absInput = std::abs (input);
+
+        char digits[20];
+        int exponent;
+        auto numDigits = CharacterFunctions::writeShortestDigits (absInput, digits, exponent);
+
+        while (numDigits > 1 && digits[numDigits - 1] == '0')
+        {
+            --numDigits;
+            ++exponent;
+        }
+
+        if (absInput >= 1.0e6 || absInput <= 1.0e-5)
+        {
+            *t++ = digits[0];
+            *t++ = '.';
+
+            if (numDigits > 1)
+            {
+                memcpy (t, digits + 1, (size_t) (numDigits - 1));
+                t += numDigits - 1;
+            }
+            else
+            {
+                *t++ = '0';
+            }
+
+            *t++ = 'e';
+
+            char exponentDigits[charsNeededForInt];
+            auto* end = exponentDigits + numElementsInArray (exponentDigits);
+            auto* start = numberToString (end, exponent + numDigits - 1);
+            const auto numExponentChars = (size_t) (end - start - 1);
+            memcpy (t, start, numExponentChars);
+            return (size_t) (t - buffer) + numExponentChars;
+        }
+
+        const auto numIntegerDigits = numDigits + exponent;
+
+        if (numIntegerDigits <= 0)
+        {
+            *t++ = '0';
+            *t++ = '.';
+
+            for (int i = numIntegerDigits; i < 0; ++i)
+                *t++ = '0';
+
+            memcpy (t, digits, (size_t) numDigits);
+            t += numDigits;
+        }
+        else if (numIntegerDigits >= numDigits)
+        {
+            memcpy (t, digits, (size_t) numDigits);
+            t += numDigits;
+
+            for (int i = numDigits; i < numIntegerDigits; ++i)
+                *t++ = '0';
+
+            *t++ = '.';
+            *t++ = '0';
+        }
+        else
+        {
+            memcpy (t, digits, (size_t) numIntegerDigits);
+            t += numIntegerDigits;
+            *t++ = '.';
+            memcpy (t, digits + numIntegerDigits, (size_t) (numDigits - numIntegerDigits));
+            t += numDigits - numIntegerDigits;
+        }
+
+        return (size_t) (t - buffer);
+    }
+}
+
+static String serialiseDouble (double input)
+{
+    char buffer[NumberToStringConverters::charsNeededForDouble];
+    const auto len = NumberToStringConverters::serialiseDouble (buffer, input);
+    return String (buffer, len);
+}
+
+//==============================================================================
+#if JUCE_ALLOW_STATIC_NULL_VARIABLES
+
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
+JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
+
+const String String::empty;
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+JUCE_END_IGNORE_WARNINGS_MSVC
+
+#endif
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+// This is how serialiseDouble used to shorten its output, which the benchmark below compares against
 static String reduceLengthOfFloatString (const String& input)
 {
     const auto start = input.getCharPointer();
@@ -2257,65 +2548,6 @@ static String reduceLengthOfFloatString (const String& input)
     return input;
 }
 
-static String serialiseDouble (double input)
-{
-    auto absInput = std::abs (input);
-
-    if (absInput >= 1.0e6 || absInput <= 1.0e-5)
-        return reduceLengthOfFloatString ({ input, 15, true });
-
-    int intInput = (int) input;
-
-    if ((double) intInput == input)
-        return { input, 1 };
-
-    auto numberOfDecimalPlaces = [absInput]
-    {
-        if (absInput < 1.0)
-        {
-            if (absInput >= 1.0e-3)
-            {
-                if (absInput >= 1.0e-1) return 16;
-                if (absInput >= 1.0e-2) return 17;
-                return 18;
-            }
-
-            if (absInput >= 1.0e-4) return 19;
-            return 20;
-        }
-
-        if (absInput < 1.0e3)
-        {
-            if (absInput < 1.0e1) return 15;
-            if (absInput < 1.0e2) return 14;
-            return 13;
-        }
-
-        if (absInput < 1.0e4) return 12;
-        if (absInput < 1.0e5) return 11;
-        return 10;
-    }();
-
-    return reduceLengthOfFloatString (String (input, numberOfDecimalPlaces));
-}
-
-//==============================================================================
-#if JUCE_ALLOW_STATIC_NULL_VARIABLES
-
-JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
-JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
-
-const String String::empty;
-
-JUCE_END_IGNORE_WARNINGS_GCC_LIKE
-JUCE_END_IGNORE_WARNINGS_MSVC
-
-#endif
-
-//==============================================================================
-//==============================================================================
-#if JUCE_UNIT_TESTS
-
 #define STRINGIFY2(X) #X
 #define STRINGIFY(X) STRINGIFY2(X)
 
@@ -2372,6 +2604,37 @@ public:
         return CharPointer_UTF32 (buffer);
     }
 
+    static double createRandomDouble (Random& r)
+    {
+        switch (r.nextInt (3))
+        {
+            case 0:
+            {
+                uint64 bits;
+
+                do
+                {
+                    bits = (uint64) r.nextInt64();
+                }
+                while (((bits >> 52) & 0x7ff) == 0x7ff);
+
+                double result;
+                memcpy (&result, &bits, sizeof (result));
+                return result;
+            }
+
+            case 1:  return (r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt (40) - 20);
+            default: return r.nextInt (2000000) / std::pow (10.0, r.nextInt (8));
+        }
+    }
+
+    static String formatWithStream (double value, int numDecimalPlaces, bool useScientificNotation)
+    {
+        char buffer[NumberToStringConverters::charsNeededForDouble];
+        NumberToStringConverters::StackArrayStream stream (buffer);
+        return String (buffer, stream.writeDouble (value, numDecimalPlaces, useScientificNotation));
+    }
+
     void runTest() override
     {
         Random r = getRandom();
@@ -2923,28 +3186,123 @@ public:
             tests[1e7] = "1.0e7";
             tests[12345678901] = "1.2345678901e10";
 
-            tests[1234567890123456.7] = "1.234567890123457e15";
-            tests[12345678.901234567] = "1.234567890123457e7";
-            tests[1234567.8901234567] = "1.234567890123457e6";
-            tests[123456.78901234567] = "123456.7890123457";
-            tests[12345.678901234567] = "12345.67890123457";
-            tests[1234.5678901234567] = "1234.567890123457";
-            tests[123.45678901234567] = "123.4567890123457";
-            tests[12.345678901234567] = "12.34567890123457";
-            tests[1.2345678901234567] = "1.234567890123457";
-            tests[0.12345678901234567] = "0.1234567890123457";
-            tests[0.012345678901234567] = "0.01234567890123457";
-            tests[0.0012345678901234567] = "0.001234567890123457";
-            tests[0.00012345678901234567] = "0.0001234567890123457";
-            tests[0.000012345678901234567] = "0.00001234567890123457";
-            tests[0.0000012345678901234567] = "1.234567890123457e-6";
-            tests[0.00000012345678901234567] = "1.234567890123457e-7";
+            tests[1234567890123456.7] = "1.2345678901234567e15";
+            tests[12345678.901234567] = "1.2345678901234567e7";
+            tests[1234567.8901234567] = "1.2345678901234567e6";
+            tests[123456.78901234567] = "123456.78901234567";
+            tests[12345.678901234567] = "12345.678901234567";
+            tests[1234.5678901234567] = "1234.5678901234567";
+            tests[123.45678901234567] = "123.45678901234567";
+            tests[12.345678901234567] = "12.345678901234567";
+            tests[1.2345678901234567] = "1.2345678901234567";
+            tests[0.12345678901234567] = "0.12345678901234566";
+            tests[0.012345678901234567] = "0.012345678901234567";
+            tests[0.0012345678901234567] = "0.0012345678901234567";
+            tests[0.00012345678901234567] = "0.00012345678901234567";
+            tests[0.000012345678901234567] = "0.000012345678901234568";
+            tests[0.0000012345678901234567] = "1.2345678901234567e-6";
+            tests[0.00000012345678901234567] = "1.2345678901234566e-7";
+
+            tests[0.1] = "0.1";
+            tests[0.1 + 0.2] = "0.30000000000000004";
+            tests[100000.5] = "100000.5";
+            tests[123456789] = "1.23456789e8";
+            tests[1.0e-5] = "1.0e-5";
+            tests[4.9406564584124654e-324] = "5.0e-324";
+            tests[std::numeric_limits<double>::max()] = "1.7976931348623157e308";
 
             for (auto& test : tests)
             {
                 expectEquals (serialiseDouble (test.first), test.second);
                 expectEquals (serialiseDouble (-test.first), "-" + test.second);
             }
+
+            expectEquals (serialiseDouble (0.0), String ("0.0"));
+            expectEquals (serialiseDouble (-0.0), String ("-0.0"));
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto value = createRandomDouble (r);
+                const auto result = serialiseDouble (value).getDoubleValue();
+                expect (memcmp (&result, &value, sizeof (double)) == 0, serialiseDouble (value));
+            }
+        }
+
+        {
+            beginTest ("Number formatting");
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto value = createRandomDouble (r);
+                const auto numDecimalPlaces = r.nextInt (12);
+
+                expectEquals (String (value, numDecimalPlaces), formatWithStream (value, numDecimalPlaces, false));
+                expectEquals (String (value, numDecimalPlaces, true), formatWithStream (value, numDecimalPlaces, true));
+            }
+
+            expectEquals (String (0.125, 2), String ("0.12"));
+            expectEquals (String (0.375, 2), String ("0.38"));
+            expectEquals (String (-0.001, 2), String ("-0.00"));
+            expectEquals (String (999999.5), String ("1e+06"));
+            expectEquals (String (0.0001), String ("0.0001"));
+            expectEquals (String (0.00001), String ("1e-05"));
+            expectEquals (String (-0.0), String ("-0"));
+        }
+
+        {
+            beginTest ("Number parsing");
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto value = createRandomDouble (r);
+                const auto text = formatWithStream (value, 16, true);
+                const auto result = text.getDoubleValue();
+                expect (memcmp (&result, &value, sizeof (double)) == 0, text);
+            }
+
+            expectEquals (String ("0.000056898057344369590").getDoubleValue(), 0.00005689805734436959);
+            expectEquals (String ("5e-324").getDoubleValue(), 4.9406564584124654e-324);
+            expectEquals (String ("1e-325").getDoubleValue(), 0.0);
+            expectEquals (String ("100e-325").getDoubleValue(), 1.0e-323);
+            expectEquals (String ("-0.000").getDoubleValue(), 0.0);
+            expect (std::signbit (String ("-0.000").getDoubleValue()));
+            expectEquals (String ("9007199254740993").getDoubleValue(), 9007199254740992.0);
+            expectEquals (String ("123.456e5").getDoubleValue(), 12345600.0);
+        }
+
+        {
+            beginTest ("Number conversion performance");
+
+            std::vector<double> values;
+
+            for (int i = 0; i < 50000; ++i)
+                values.push_back (createRandomDouble (r));
+
+            auto timeFunction = [] (auto&& fn)
+            {
+                const auto start = Time::getHighResolutionTicks();
+                fn();
+                return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0;
+            };
+
+            StringArray oldStrings, newStrings;
+
+            const auto oldPrintTime = timeFunction ([&] { for (auto v : values) oldStrings.add (reduceLengthOfFloatString (String (v, 15, true))); });
+            const auto newPrintTime = timeFunction ([&] { for (auto v : values) newStrings.add (serialiseDouble (v)); });
+
+            double oldTotal = 0, newTotal = 0;
+
+            const auto oldParseTime = timeFunction ([&] { for (auto& s : oldStrings) oldTotal += std::strtod (s.toRawUTF8(), nullptr); });
+            const auto newParseTime = timeFunction ([&] { for (auto& s : newStrings) newTotal += s.getDoubleValue(); });
+
+            logMessage ("Printing " + String ((int) values.size()) + " doubles: "
+                          + String (oldPrintTime, 2) + " ms with 15 digits and trimming, "
+                          + String (newPrintTime, 2) + " ms with the shortest round-trip digits");
+
+            logMessage ("Parsing them: " + String (oldParseTime, 2) + " ms with strtod, "
+                          + String (newParseTime, 2) + " ms with String::getDoubleValue()");
+
+            expect (oldTotal != 0 && newTotal != 0);
         }
 
         {
@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+StringBuilder::StringBuilder (size_t initialCapacityInBytes)
+{
+    preallocateBytes (initialCapacityInBytes);
+}
+
+StringBuilder::StringBuilder (const StringBuilder& other)
+{
+    appendSameEncoding (other.data, other.numBytes);
+}
+
+StringBuilder& StringBuilder::operator= (const StringBuilder& other)
+{
+    if (this != &other)
+    {
+        clear();
+        appendSameEncoding (other.data, other.numBytes);
+    }
+
+    return *this;
+}
+
+//==============================================================================
+void StringBuilder::clear() noexcept
+{
+    numBytes = 0;
+    writeNull();
+}
+
+void StringBuilder::preallocateBytes (size_t numBytesNeeded)
+{
+    if (numBytesNeeded > numBytes)
+        ensureSpaceFor (numBytesNeeded - numBytes);
+}
+
+void StringBuilder::ensureSpaceFor (size_t extraBytes)
+{
+    const auto bytesNeeded = numBytes + extraBytes + sizeof (CharType);
+
+    if (bytesNeeded <= capacity)
+        return;
+
+    // Once the text outgrows the internal buffer, it's kept in a String's own storage,
+    // which String::preallocateBytes() copies across whenever it needs to grow.
+    const auto newCapacity = jmax (bytesNeeded, capacity + capacity / 2);
+    heapStorage.preallocateBytes (newCapacity - sizeof (CharType));
+    auto* newData = reinterpret_cast<char*> (heapStorage.getCharPointer().getAddress());
+
+    if (data == internalBuffer)
+        memcpy (newData, internalBuffer, numBytes + sizeof (CharType));
+
+    data = newData;
+    capacity = newCapacity;
+}
+
+void StringBuilder::writeNull() noexcept
+{
+    *unalignedPointerCast<CharType*> (data + numBytes) = 0;
+}
+
+String::CharPointerType StringBuilder::getCharPointer() const noexcept
+{
+    return String::CharPointerType (unalignedPointerCast<const CharType*> (data));
+}
+
+//==============================================================================
+void StringBuilder::appendSameEncoding (const void* text, size_t numBytesToAppend)
+{
+    if (numBytesToAppend > 0)
+    {
+        ensureSpaceFor (numBytesToAppend);
+        memcpy (data + numBytes, text, numBytesToAppend);
+        numBytes += numBytesToAppend;
+        writeNull();
+    }
+}
+
+StringBuilder& StringBuilder::appendASCII (const char* text, size_t numChars)
+{
+    if constexpr (sizeof (CharType) == 1)
+    {
+        appendSameEncoding (text, numChars);
+    }
+    else
+    {
+        ensureSpaceFor (numChars * sizeof (CharType));
+        auto* dest = unalignedPointerCast<CharType*> (data + numBytes);
+
+        for (size_t i = 0; i < numChars; ++i)
+            dest[i] = (CharType) text[i];
+
+        numBytes += numChars * sizeof (CharType);
+        writeNull();
+    }
+
+    return *this;
+}
+
+StringBuilder& StringBuilder::appendCharacter (juce_wchar character)
+{
+    const auto bytesNeeded = String::CharPointerType::getBytesRequiredFor (character);
+    ensureSpaceFor (bytesNeeded);
+
+    String::CharPointerType dest (unalignedPointerCast<CharType*> (data + numBytes));
+    dest.write (character);
+    numBytes += bytesNeeded;
+    writeNull();
+    return *this;
+}
+
+StringBuilder& StringBuilder::append (const char* utf8, size_t numBytesToAppend)
+{
+    if constexpr (std::is_same_v<String::CharPointerType, CharPointer_UTF8>)
+    {
+        appendSameEncoding (utf8, numBytesToAppend);
+    }
+    else
+    {
+        const CharPointer_UTF8 end (utf8 + numBytesToAppend);
+
+        for (CharPointer_UTF8 t (utf8); t < end && ! t.isEmpty();)
+            appendCharacter (t.getAndAdvance());
+    }
+
+    return *this;
+}
+
+//==============================================================================
+StringBuilder& StringBuilder::operator<< (StringRef text)
+{
+    appendSameEncoding (text.text.getAddress(), text.text.sizeInBytes() - sizeof (CharType));
+    return *this;
+}
+
+StringBuilder& StringBuilder::operator<< (const char* utf8)
+{
+    return append (utf8, strlen (utf8));
+}
+
+StringBuilder& StringBuilder::operator<< (const String& text)
+{
+    return operator<< (StringRef (text));
+}
+
+StringBuilder& StringBuilder::operator<< (char character)       { return append (&character, 1); }
+StringBuilder& StringBuilder::operator<< (wchar_t character)    { return appendCharacter ((juce_wchar) character); }
+
+template <typename IntegerType>
+StringBuilder& StringBuilder::appendInteger (IntegerType number)
+{
+    char buffer[NumberToStringConverters::charsNeededForInt];
+    auto* end = buffer + numElementsInArray (buffer);
+    auto* start = NumberToStringConverters::numberToString (end, number);
+    return appendASCII (start, (size_t) (end - start - 1));
+}
+
+StringBuilder& StringBuilder::operator<< (int number)                   { return appendInteger (number); }
+StringBuilder& StringBuilder::operator<< (unsigned int number)          { return appendInteger (number); }
+StringBuilder& StringBuilder::operator<< (short number)                 { return appendInteger ((int) number); }
+StringBuilder& StringBuilder::operator<< (unsigned short number)        { return appendInteger ((unsigned int) number); }
+StringBuilder& StringBuilder::operator<< (long number)                  { return appendInteger (number); }
+StringBuilder& StringBuilder::operator<< (unsigned long number)         { return appendInteger (number); }
+StringBuilder& StringBuilder::operator<< (long long number)             { return appendInteger ((int64) number); }
+StringBuilder& StringBuilder::operator<< (unsigned long long number)    { return appendInteger ((uint64) number); }
+
+StringBuilder& StringBuilder::operator<< (float number)     { return appendDouble ((double) number, 0); }
+StringBuilder& StringBuilder::operator<< (double number)    { return appendDouble (number, 0); }
+
+StringBuilder& StringBuilder::appendDouble (double number, int numberOfDecimalPlaces, bool useScientificNotation)
+{
+    char buffer[NumberToStringConverters::charsNeededForDouble];
+    size_t len;
+    auto* start = NumberToStringConverters::doubleToString (buffer, number, numberOfDecimalPlaces, useScientificNotation, len);
+    return appendASCII (start, len);
+}
+
+StringBuilder& StringBuilder::appendHex (uint64 number, int minimumNumberOfDigits)
+{
+    char buffer[32];
+    auto* end = buffer + numElementsInArray (buffer);
+    auto* t = end;
+
+    do
+    {
+        *--t = "0123456789abcdef"[(int) (number & 15)];
+        number >>= 4;
+    }
+    while (number != 0);
+
+    for (auto numDigits = (int) (end - t); numDigits < minimumNumberOfDigits; ++numDigits)
+        appendASCII ("0", 1);
+
+    return appendASCII (t, (size_t) (end - t));
+}
+
+StringBuilder& StringBuilder::appendPadded (int64 number, int minimumNumberOfDigits)
+{
+    if (number < 0)
+        appendASCII ("-", 1);
+
+    // (careful not to negate the smallest int64, which has undefined behaviour)
+    const auto magnitude = number < 0 ? static_cast<uint64> (-(number + 1)) + 1 : static_cast<uint64> (number);
+
+    char buffer[NumberToStringConverters::charsNeededForInt];
+    auto* end = buffer + numElementsInArray (buffer);
+    auto* start = NumberToStringConverters::numberToString (end, magnitude);
+    const auto numDigits = (int) (end - start - 1);
+
+    for (int i = numDigits; i < minimumNumberOfDigits; ++i)
+        appendASCII ("0", 1);
+
+    return appendASCII (start, (size_t) numDigits);
+}
+
+StringBuilder& StringBuilder::appendRepeated (juce_wchar character, int numberOfTimes)
+{
+    if (numberOfTimes > 0)
+    {
+        ensureSpaceFor ((size_t) numberOfTimes * String::CharPointerType::getBytesRequiredFor (character));
+
+        while (--numberOfTimes >= 0)
+            appendCharacter (character);
+    }
+
+    return *this;
+}
+
+//==============================================================================
+String StringBuilder::toString() const
+{
+    return String (getCharPointer());
+}
+
+String StringBuilder::release()
+{
+    if (numBytes == 0)
+        return {};
+
+    if (data == internalBuffer)
+    {
+        String result (getCharPointer());
+        clear();
+        return result;
+    }
+
+    auto result = std::move (heapStorage);
+    heapStorage = String();
+    data = internalBuffer;
+    numBytes = 0;
+    capacity = internalCapacity;
+    writeNull();
+    return result;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringBuilderTests  : public UnitTest
+{
+public:
+    StringBuilderTests()
+        : UnitTest ("StringBuilder", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Text and characters");
+        {
+            StringBuilder sb;
+            expect (sb.isEmpty());
+            expectEquals (sb.toString(), String());
+
+            sb << "abc" << String ("def") << ' ' << L'x' << StringRef ("yz");
+            expectEquals (sb.toString(), String ("abcdef xyz"));
+
+            sb << String (CharPointer_UTF8 ("\xc3\xa9\xe2\x82\xac"));
+            sb.appendRepeated ((juce_wchar) 0x1f600, 2);
+            expectEquals (sb.toString(), String ("abcdef xyz") + String (CharPointer_UTF8 ("\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\xf0\x9f\x98\x80")));
+
+            sb.clear();
+            expect (sb.isEmpty());
+            sb.append ("hello world", 5);
+            expectEquals (sb.release(), String ("hello"));
+            expect (sb.isEmpty());
+        }
+
+        beginTest ("Numbers match the String constructors");
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto i32 = (int) r.nextInt();
+                auto i64 = r.nextInt64();
+                auto d = (r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -10, 10 }));
+                auto places = r.nextInt (10);
+
+                StringBuilder sb;
+                sb << i32 << ' ' << (int64) i64 << ' ' << (uint64) i64 << ' ' << d << ' ' << (float) d << ' ';
+                sb.appendDouble (d, places);
+
+                expectEquals (sb.toString(), String (i32) + " " + String (i64) + " " + String ((uint64) i64) + " "
+                                               + String (d) + " " + String ((float) d) + " " + String (d, places));
+            }
+
+            StringBuilder sb;
+            sb << std::numeric_limits<int>::min() << ' ' << std::numeric_limits<int64>::min() << ' ' << (short) -5 << ' ' << (unsigned short) 7;
+            expectEquals (sb.toString(), String ("-2147483648 -9223372036854775808 -5 7"));
+
+            sb.clear();
+            sb.appendHex (0x1234abcd).appendHex (0, 1).appendHex (0xff, 4) << ' ';
+            sb.appendPadded (42, 5) << ' ';
+            sb.appendPadded (-7, 3) << ' ';
+            sb.appendPadded (123456, 2);
+            expectEquals (sb.toString(), String ("1234abcd000ff 00042 -007 123456"));
+        }
+
+        beginTest ("Growing beyond the internal buffer");
+        {
+            StringBuilder sb;
+            String expected;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                sb << "item " << i << ", ";
+                expected << "item " << i << ", ";
+
+                if (i % 97 == 0)
+                    expectEquals (sb.toString(), expected);
+            }
+
+            expectEquals ((int) sb.getNumBytes(), (int) expected.getNumBytesAsUTF8());
+            expect (sb.toStringRef() == expected);
+
+            auto copy = sb;
+            auto released = sb.release();
+            expectEquals (released, expected);
+            expect (sb.isEmpty());
+            expectEquals (copy.toString(), expected);
+
+            sb << "short";
+            expectEquals (sb.release(), String ("short"));
+            expectEquals (released, expected);
+        }
+    }
+};
+
+static StringBuilderTests stringBuilderTests;
+
+#endif
+
+} // namespace juce
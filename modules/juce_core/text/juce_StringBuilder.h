@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Builds up a String from pieces of text and numbers with as few allocations as possible.
+
+    A StringBuilder keeps its text in a buffer inside the object until it grows beyond
+    a couple of hundred bytes, and numbers are formatted straight into that buffer, so
+    building short strings such as log lines or labels doesn't touch the heap at all
+    until the result is turned into a String. Longer text spills over into a buffer
+    that has the same layout as a String's, so release() can hand it over without
+    copying.
+
+    @code
+    StringBuilder sb;
+    sb << "Voice " << voiceIndex << " started at " << startTime << "s";
+    Logger::writeToLog (sb.release());
+    @endcode
+
+    Numbers produce the same text as the String constructors that take them.
+
+    @see String, MemoryOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  StringBuilder  final
+{
+public:
+    //==============================================================================
+    /** Creates an empty builder. */
+    StringBuilder() noexcept = default;
+
+    /** Creates an empty builder with space for a given number of bytes of text. */
+    explicit StringBuilder (size_t initialCapacityInBytes);
+
+    /** Creates a copy of another builder. */
+    StringBuilder (const StringBuilder&);
+
+    /** Copies the content of another builder. */
+    StringBuilder& operator= (const StringBuilder&);
+
+    /** Destructor. */
+    ~StringBuilder() = default;
+
+    //==============================================================================
+    /** Appends some text. */
+    StringBuilder& operator<< (StringRef text);
+
+    /** Appends some null-terminated UTF-8 text. */
+    StringBuilder& operator<< (const char* utf8);
+
+    /** Appends a string. */
+    StringBuilder& operator<< (const String& text);
+
+    /** Appends a character. */
+    StringBuilder& operator<< (char character);
+
+    /** Appends a character. */
+    StringBuilder& operator<< (wchar_t character);
+
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (int number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned int number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (short number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned short number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (long number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned long number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (long long number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned long long number);
+
+    /** Appends a number, in the same format as String (float). */
+    StringBuilder& operator<< (float number);
+
+    /** Appends a number, in the same format as String (double). */
+    StringBuilder& operator<< (double number);
+
+    //==============================================================================
+    /** Appends some UTF-8 text with a known length in bytes. */
+    StringBuilder& append (const char* utf8, size_t numBytesToAppend);
+
+    /** Appends a number with a fixed number of decimal places, in the same format as
+        String (double, int, bool).
+    */
+    StringBuilder& appendDouble (double number, int numberOfDecimalPlaces, bool useScientificNotation = false);
+
+    /** Appends a number in hexadecimal, padded with leading zeros to a minimum number of digits. */
+    StringBuilder& appendHex (uint64 number, int minimumNumberOfDigits = 0);
+
+    /** Appends a decimal number, padded with leading zeros to a minimum number of digits. */
+    StringBuilder& appendPadded (int64 number, int minimumNumberOfDigits);
+
+    /** Appends a character a number of times. */
+    StringBuilder& appendRepeated (juce_wchar character, int numberOfTimes);
+
+    //==============================================================================
+    /** Returns the number of bytes of text in the builder, in the String class's encoding. */
+    size_t getNumBytes() const noexcept                 { return numBytes; }
+
+    /** Returns true if the builder is empty. */
+    bool isEmpty() const noexcept                       { return numBytes == 0; }
+
+    /** Removes all the text, but keeps the space that was allocated for it. */
+    void clear() noexcept;
+
+    /** Makes sure that there's enough space for a given number of bytes of text. */
+    void preallocateBytes (size_t numBytesNeeded);
+
+    /** Returns a pointer to the null-terminated text.
+        This is only valid until the builder is next modified.
+    */
+    String::CharPointerType getCharPointer() const noexcept;
+
+    /** Returns the text as a StringRef, which is only valid until the builder is next modified. */
+    StringRef toStringRef() const noexcept              { return StringRef (getCharPointer()); }
+
+    //==============================================================================
+    /** Returns a String containing a copy of the text. */
+    String toString() const;
+
+    /** Returns the text as a String, and leaves the builder empty.
+
+        If the text has outgrown the builder's internal buffer, the String takes over the
+        memory that it was built in, so nothing is allocated or copied.
+    */
+    String release();
+
+private:
+    //==============================================================================
+    using CharType = String::CharPointerType::CharType;
+    enum { internalCapacity = 232 };
+
+    void ensureSpaceFor (size_t extraBytes);
+    void appendSameEncoding (const void* text, size_t numBytesToAppend);
+    StringBuilder& appendASCII (const char* text, size_t numChars);
+    StringBuilder& appendCharacter (juce_wchar character);
+    template <typename IntegerType> StringBuilder& appendInteger (IntegerType);
+    void writeNull() noexcept;
+
+    String heapStorage;
+    char* data = internalBuffer;
+    size_t numBytes = 0, capacity = internalCapacity;
+    alignas (CharType) char internalBuffer[internalCapacity] {};
+
+    JUCE_LEAK_DETECTOR (StringBuilder)
+};
+
+} // namespace juce
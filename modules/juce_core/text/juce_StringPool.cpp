@@ -27,7 +27,7 @@ static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
 
 
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
+StringPool::StringPool() noexcept {}
 
 struct StartEndString
 {
@@ -57,44 +57,47 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+// The hash is calculated from the characters rather than the encoded bytes, so that it's
+// the same whichever of these types the string arrives as
+template <typename CharPointer>
+static uint32 hashCharacters (CharPointer s, CharPointer end) noexcept
 {
-    int start = 0;
-    int end = strings.size();
+    uint32 hash = 2166136261u;
 
-    while (start < end)
+    while (s < end)
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        auto c = s.getAndAdvance();
 
-        if (startComp == 0)
-            return startString;
+        if (c == 0)
+            break;
 
-        const int halfway = (start + end) / 2;
+        hash = (hash ^ (uint32) c) * 16777619u;
+    }
 
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
+    return hash;
+}
 
-            break;
-        }
+static uint32 hashString (const String& s) noexcept             { return hashCharacters (s.getCharPointer(), s.getCharPointer().findTerminatingNull()); }
+static uint32 hashString (CharPointer_UTF8 s) noexcept          { return hashCharacters (s, s.findTerminatingNull()); }
+static uint32 hashString (const StartEndString& s) noexcept     { return hashCharacters (s.start, s.end); }
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+template <typename NewStringType>
+String StringPool::addPooledString (const NewStringType& newString)
+{
+    garbageCollectIfNeeded();
 
-        if (halfwayComp == 0)
-            return halfwayString;
+    const auto hash = hashString (newString);
+    auto& shard = shards[hash % (uint32) numShards];
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
-    }
+    const ScopedLock sl (shard.lock);
+    const auto range = shard.strings.equal_range (hash);
+
+    for (auto i = range.first; i != range.second; ++i)
+        if (compareStrings (newString, i->second) == 0)
+            return i->second;
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    ++numStrings;
+    return shard.strings.emplace (hash, newString)->second;
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -102,9 +105,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (CharPointer_UTF8 (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -112,9 +113,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -122,9 +121,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (newString.text);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -132,25 +129,42 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
+    return addPooledString (newString);
 }
 
 void StringPool::garbageCollectIfNeeded()
 {
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    if (numStrings.load (std::memory_order_relaxed) > minNumberOfStringsForGarbageCollection)
+    {
+        auto lastTime = lastGarbageCollectionTime.load (std::memory_order_relaxed);
+        const auto now = Time::getApproximateMillisecondCounter();
+
+        // Only one of the threads that notices it's time for a collection actually does it
+        if (now > lastTime + garbageCollectionInterval
+             && lastGarbageCollectionTime.compare_exchange_strong (lastTime, now))
+            garbageCollect();
+    }
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
+    for (auto& shard : shards)
+    {
+        const ScopedLock sl (shard.lock);
 
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference(i).getReferenceCount() == 1)
-            strings.remove (i);
+        for (auto i = shard.strings.begin(); i != shard.strings.end();)
+        {
+            if (i->second.getReferenceCount() == 1)
+            {
+                i = shard.strings.erase (i);
+                --numStrings;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
 
     lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
 }
@@ -161,4 +175,94 @@ StringPool& StringPool::getGlobalPool() noexcept
     return pool;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringPoolTests  : public UnitTest
+{
+public:
+    StringPoolTests()
+        : UnitTest ("StringPool", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Matching strings share the same data");
+        {
+            StringPool pool;
+            const String original ("abc");
+            const auto pooled = pool.getPooledString (original);
+
+            expect (pooled == original);
+            expect (pool.getPooledString ("abc").getCharPointer() == pooled.getCharPointer());
+            expect (pool.getPooledString (StringRef ("abc")).getCharPointer() == pooled.getCharPointer());
+
+            const String longer ("abcdef");
+            expect (pool.getPooledString (longer.getCharPointer(), longer.getCharPointer() + 3).getCharPointer()
+                      == pooled.getCharPointer());
+
+            expect (pool.getPooledString ("abd").getCharPointer() != pooled.getCharPointer());
+            expect (pool.getPooledString (String()).isEmpty());
+        }
+
+        beginTest ("Unreferenced strings are garbage collected");
+        {
+            StringPool pool;
+            const auto kept = pool.getPooledString ("kept");
+            const auto* keptData = kept.getCharPointer().getAddress();
+
+            for (int i = 0; i < 1000; ++i)
+                pool.getPooledString ("temp" + String (i));
+
+            pool.garbageCollect();
+
+            expect (pool.getPooledString ("kept").getCharPointer().getAddress() == keptData);
+            expectEquals (pool.getPooledString ("temp1").getReferenceCount(), 2);
+        }
+
+        beginTest ("Pooling from several threads gives one copy of each string");
+        {
+            StringPool pool;
+            constexpr int numThreads = 4, numNames = 500;
+            std::vector<std::vector<String>> results (numThreads);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&pool, &results, t]
+                {
+                    for (int i = 0; i < numNames; ++i)
+                        results[(size_t) t].push_back (pool.getPooledString ("name" + String ((i * (t + 1)) % numNames)));
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            for (int t = 1; t < numThreads; ++t)
+            {
+                for (int i = 0; i < numNames; ++i)
+                {
+                    const auto& s = results[(size_t) t][(size_t) i];
+                    expect (pool.getPooledString (s).getCharPointer() == s.getCharPointer());
+                }
+            }
+        }
+
+        beginTest ("Identifier literals match Identifiers made from strings");
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                expect (JUCE_IDENTIFIER ("stringPoolTestName") == Identifier (String ("stringPoolTestName")));
+                expect (JUCE_IDENTIFIER ("stringPoolTestName") != Identifier ("stringPoolOtherName"));
+            }
+        }
+    }
+};
+
+static StringPoolTests stringPoolTests;
+
+#endif
+
 } // namespace juce
@@ -34,6 +34,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    The strings are spread across a number of separately locked hash tables, chosen
+    by the hash of the string, so threads that are pooling different strings at the
+    same time will rarely have to wait for each other.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -75,9 +79,20 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct Shard
+    {
+        std::unordered_multimap<uint32, String> strings;
+        CriticalSection lock;
+    };
+
+    static constexpr int numShards = 32;
+
+    Shard shards[numShards];
+    std::atomic<int> numStrings { 0 };
+    std::atomic<uint32> lastGarbageCollectionTime { 0 };
+
+    template <typename NewStringType>
+    String addPooledString (const NewStringType&);
 
     void garbageCollectIfNeeded();
 
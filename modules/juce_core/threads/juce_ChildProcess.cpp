@@ -36,6 +36,22 @@ int ChildProcess::readProcessOutput (void* dest, int numBytes)
     return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
 }
 
+int ChildProcess::readProcessErrorOutput (void* dest, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->readError (dest, numBytes) : 0;
+}
+
+int ChildProcess::writeProcessInput (const void* source, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->write (source, numBytes) : -1;
+}
+
+void ChildProcess::closeProcessInput()
+{
+    if (activeProcess != nullptr)
+        activeProcess->closeInput();
+}
+
 bool ChildProcess::kill()
 {
     return activeProcess == nullptr || activeProcess->killProcess();
@@ -108,6 +124,61 @@ public:
         auto output = p.readAllProcessOutput();
         expect (output.isNotEmpty());
       #endif
+
+      #if JUCE_MAC || JUCE_LINUX || JUCE_BSD
+        beginTest ("Separate stderr");
+        {
+            ChildProcess process;
+            expect (process.start (StringArray { "/bin/sh", "-c", "echo out; echo err >&2; exit 3" },
+                                   ChildProcess::wantStdOut | ChildProcess::wantStdErr | ChildProcess::separateStdErr));
+
+            expectEquals (process.readAllProcessOutput(), String ("out\n"));
+
+            char buffer[64] = {};
+            expectEquals (process.readProcessErrorOutput (buffer, (int) sizeof (buffer) - 1), 4);
+            expectEquals (String (buffer), String ("err\n"));
+
+            expect (process.waitForProcessToFinish (5000));
+            expectEquals ((int) process.getExitCode(), 3);
+            expectEquals ((int) process.getExitCode(), 3);
+        }
+
+        beginTest ("Writing to stdin");
+        {
+            ChildProcess process;
+            expect (process.start ("cat", ChildProcess::wantStdOut | ChildProcess::wantStdIn));
+
+            const String message ("line one\nline two\n");
+            expectEquals (process.writeProcessInput (message.toRawUTF8(), (int) message.getNumBytesAsUTF8()),
+                          (int) message.getNumBytesAsUTF8());
+            process.closeProcessInput();
+
+            expectEquals (process.readAllProcessOutput(), message);
+            expect (process.waitForProcessToFinish (5000));
+        }
+
+        beginTest ("Writing to a process that has exited");
+        {
+            ChildProcess process;
+            expect (process.start ("true", ChildProcess::wantStdIn));
+            expect (process.waitForProcessToFinish (5000));
+
+            const char data[] = "ignored";
+            expectEquals (process.writeProcessInput (data, (int) sizeof (data)), -1);
+        }
+
+        beginTest ("Launching a missing executable");
+        {
+            ChildProcess process;
+
+            if (process.start ("juce_this_executable_does_not_exist"))
+            {
+                // Some C libraries only report the failure once the child has exited
+                expect (process.waitForProcessToFinish (5000));
+                expect (process.getExitCode() != 0);
+            }
+        }
+      #endif
     }
 };
 
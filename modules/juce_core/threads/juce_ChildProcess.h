@@ -27,8 +27,17 @@ namespace juce
 /**
     Launches and monitors a child process.
 
-    This class lets you launch an executable, and read its output. You can also
-    use it to check whether the child process has finished.
+    This class lets you launch an executable, write to its input and read its output.
+    You can also use it to check whether the child process has finished.
+
+    On POSIX systems the child is launched with posix_spawn(), so starting a process
+    doesn't have to copy the page tables of a large host application the way fork()
+    would. The handles that the parent keeps are never inherited by other children.
+
+    The read methods block, so if you need to follow the output of several processes
+    without dedicating a thread to each one, hand them to a ChildProcessMonitor.
+
+    @see ChildProcessMonitor
 
     @tags{Core}
 */
@@ -49,8 +58,13 @@ public:
     /** These flags are used by the start() methods. */
     enum StreamFlags
     {
-        wantStdOut = 1,
-        wantStdErr = 2
+        wantStdOut      = 1,    /**< The child's stdout is read by readProcessOutput(). */
+        wantStdErr      = 2,    /**< The child's stderr is read too. Unless separateStdErr is also
+                                     given, it's mixed into the stdout stream. */
+        wantStdIn       = 4,    /**< Opens a pipe to the child's stdin for writeProcessInput().
+                                     Without this, the child inherits this process's stdin. */
+        separateStdErr  = 8     /**< Used with wantStdErr, this keeps stderr in a pipe of its own,
+                                     which is read by readProcessErrorOutput(). */
     };
 
     /** Attempts to launch a child process command.
@@ -84,6 +98,26 @@ public:
     */
     int readProcessOutput (void* destBuffer, int numBytesToRead);
 
+    /** Attempts to read some output from the child's stderr stream.
+
+        This only returns anything if the process was started with both wantStdErr and
+        separateStdErr. Bear in mind that a child can stall if one of its pipes fills up
+        while you're blocked reading the other, so if it may write a lot to both, read
+        them from different threads or use a ChildProcessMonitor.
+    */
+    int readProcessErrorOutput (void* destBuffer, int numBytesToRead);
+
+    /** Writes some data to the child's stdin.
+
+        The process must have been started with the wantStdIn flag. This blocks until all
+        the data has been written, and returns the number of bytes written, or -1 if the
+        child has closed its end of the pipe.
+    */
+    int writeProcessInput (const void* sourceBuffer, int numBytesToWrite);
+
+    /** Closes the pipe to the child's stdin, so that the child sees the end of its input. */
+    void closeProcessInput();
+
     /** Blocks until the process has finished, and then returns its complete output
         as a string.
     */
@@ -106,6 +140,8 @@ private:
     class ActiveProcess;
     std::unique_ptr<ActiveProcess> activeProcess;
 
+    friend class ChildProcessMonitor;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcess)
 };
 
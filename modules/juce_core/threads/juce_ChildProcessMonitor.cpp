@@ -0,0 +1,469 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ChildProcessMonitor::Pimpl  : private Thread
+{
+public:
+    explicit Pimpl (const String& name)  : Thread (name)
+    {
+       #if ! JUCE_WINDOWS
+        int handles[2];
+
+        if (pipe (handles) == 0)
+        {
+            for (auto handle : handles)
+            {
+                fcntl (handle, F_SETFD, FD_CLOEXEC);
+                fcntl (handle, F_SETFL, fcntl (handle, F_GETFL) | O_NONBLOCK);
+            }
+
+            wakeUpReadHandle  = handles[0];
+            wakeUpWriteHandle = handles[1];
+        }
+       #endif
+
+        startThread();
+    }
+
+    ~Pimpl() override
+    {
+        signalThreadShouldExit();
+        wakeUp();
+        stopThread (10000);
+
+       #if ! JUCE_WINDOWS
+        for (auto handle : { wakeUpReadHandle, wakeUpWriteHandle })
+            if (handle >= 0)
+                close (handle);
+       #endif
+    }
+
+    //==============================================================================
+    bool add (ChildProcess& process, Callbacks callbacks)
+    {
+        auto* active = process.activeProcess.get();
+
+        if (active == nullptr)
+            return false;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (findEntry (process) != entries.end())
+                return false;
+
+            auto entry = std::make_shared<Entry>();
+            entry->process = &process;
+            entry->callbacks = std::move (callbacks);
+
+           #if ! JUCE_WINDOWS
+            entry->outputOpen = active->outputHandle >= 0;
+            entry->errorOpen  = active->errorHandle >= 0;
+           #endif
+
+            entries.push_back (std::move (entry));
+        }
+
+        wakeUp();
+        return true;
+    }
+
+    void remove (ChildProcess& process)
+    {
+        {
+            const ScopedLock cl (callbackLock);
+            const ScopedLock sl (lock);
+            auto found = findEntry (process);
+
+            if (found == entries.end())
+                return;
+
+            (*found)->removed = true;
+            entries.erase (found);
+        }
+
+        wakeUp();
+    }
+
+    int getNumProcesses() const
+    {
+        const ScopedLock sl (lock);
+        return (int) entries.size();
+    }
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        ChildProcess* process = nullptr;
+        Callbacks callbacks;
+        bool outputOpen = true, errorOpen = true, removed = false;
+
+        bool isWaitingForExit() const noexcept     { return ! (outputOpen || errorOpen); }
+    };
+
+    static constexpr int bufferSize = 16384;
+
+    std::vector<std::shared_ptr<Entry>> entries;
+    CriticalSection lock, callbackLock;
+
+   #if JUCE_WINDOWS
+    WaitableEvent wakeUpEvent;
+   #else
+    int wakeUpReadHandle = -1, wakeUpWriteHandle = -1;
+   #endif
+
+    std::vector<std::shared_ptr<Entry>>::iterator findEntry (ChildProcess& process)
+    {
+        return std::find_if (entries.begin(), entries.end(),
+                             [&process] (const auto& e) { return e->process == &process; });
+    }
+
+    void wakeUp()
+    {
+       #if JUCE_WINDOWS
+        wakeUpEvent.signal();
+       #else
+        const char byte = 0;
+
+        if (wakeUpWriteHandle >= 0)
+            ignoreUnused (::write (wakeUpWriteHandle, &byte, 1));
+       #endif
+    }
+
+    //==============================================================================
+    // Passes on the result of reading one of a process's streams. This is called with
+    // the callbackLock held.
+    void handleRead (Entry& entry, bool isErrorStream, const char* data, int numBytes)
+    {
+        if (numBytes > 0)
+        {
+            auto& callback = isErrorStream ? entry.callbacks.onErrorOutput
+                                           : entry.callbacks.onOutput;
+
+            if (callback != nullptr)
+                callback (data, numBytes);
+        }
+        else
+        {
+            (isErrorStream ? entry.errorOpen : entry.outputOpen) = false;
+        }
+    }
+
+    void checkForExit (Entry& entry)
+    {
+        if (entry.removed || ! entry.isWaitingForExit() || entry.process->isRunning())
+            return;
+
+        auto exitCode = entry.process->getExitCode();
+
+        {
+            const ScopedLock sl (lock);
+            entry.removed = true;
+            entries.erase (std::find_if (entries.begin(), entries.end(),
+                                         [&entry] (const auto& e) { return e.get() == &entry; }));
+        }
+
+        if (entry.callbacks.onExit != nullptr)
+            entry.callbacks.onExit (exitCode);
+    }
+
+   #if JUCE_WINDOWS
+    //==============================================================================
+    void run() override
+    {
+        HeapBlock<char> buffer (bufferSize);
+        std::vector<std::shared_ptr<Entry>> current;
+
+        while (! threadShouldExit())
+        {
+            {
+                const ScopedLock sl (lock);
+                current = entries;
+            }
+
+            bool anyDataArrived = false;
+
+            {
+                const ScopedLock cl (callbackLock);
+
+                for (auto& entry : current)
+                {
+                    for (auto isErrorStream : { false, true })
+                    {
+                        if (entry->removed || ! (isErrorStream ? entry->errorOpen : entry->outputOpen))
+                            continue;
+
+                        auto numRead = entry->process->activeProcess->readAvailable (isErrorStream, buffer, bufferSize);
+
+                        if (numRead != 0)
+                        {
+                            anyDataArrived = anyDataArrived || numRead > 0;
+                            handleRead (*entry, isErrorStream, buffer, numRead);
+                        }
+                    }
+
+                    checkForExit (*entry);
+                }
+            }
+
+            current.clear();
+
+            if (! anyDataArrived)
+                wakeUpEvent.wait (pollIntervalMs);
+        }
+    }
+
+    static constexpr int pollIntervalMs = 5;
+
+   #else
+    //==============================================================================
+    void run() override
+    {
+        struct Source
+        {
+            std::shared_ptr<Entry> entry;
+            bool isErrorStream;
+        };
+
+        HeapBlock<char> buffer (bufferSize);
+        std::vector<pollfd> fds;
+        std::vector<Source> sources;
+        std::vector<std::shared_ptr<Entry>> waitingForExit;
+
+        while (! threadShouldExit())
+        {
+            fds.clear();
+            sources.clear();
+            waitingForExit.clear();
+
+            fds.push_back ({ wakeUpReadHandle, POLLIN, 0 });
+
+            {
+                const ScopedLock sl (lock);
+
+                for (auto& entry : entries)
+                {
+                    auto& active = *entry->process->activeProcess;
+
+                    if (entry->outputOpen)
+                    {
+                        fds.push_back ({ active.outputHandle, POLLIN, 0 });
+                        sources.push_back ({ entry, false });
+                    }
+
+                    if (entry->errorOpen)
+                    {
+                        fds.push_back ({ active.errorHandle, POLLIN, 0 });
+                        sources.push_back ({ entry, true });
+                    }
+
+                    if (entry->isWaitingForExit())
+                        waitingForExit.push_back (entry);
+                }
+            }
+
+            // A process can close its pipes a little before it exits, so while any are in
+            // that state, keep checking on them
+            if (poll (fds.data(), (nfds_t) fds.size(), waitingForExit.empty() ? -1 : exitCheckIntervalMs) < 0)
+                continue;
+
+            if (fds[0].revents != 0)
+            {
+                char discarded[64];
+                while (::read (wakeUpReadHandle, discarded, sizeof (discarded)) > 0) {}
+            }
+
+            const ScopedLock cl (callbackLock);
+
+            for (size_t i = 0; i < sources.size(); ++i)
+            {
+                auto& entry = *sources[i].entry;
+
+                // The callbacks for the earlier streams may have removed this process
+                if (fds[i + 1].revents == 0 || entry.removed)
+                    continue;
+
+                auto numRead = ChildProcess::ActiveProcess::readFrom (fds[i + 1].fd, buffer, bufferSize);
+                handleRead (entry, sources[i].isErrorStream, buffer, numRead);
+
+                if (entry.isWaitingForExit())
+                    waitingForExit.push_back (sources[i].entry);
+            }
+
+            for (auto& entry : waitingForExit)
+                checkForExit (*entry);
+        }
+    }
+
+    static constexpr int exitCheckIntervalMs = 10;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+ChildProcessMonitor::ChildProcessMonitor (const String& threadName)
+    : pimpl (std::make_unique<Pimpl> (threadName))
+{
+}
+
+ChildProcessMonitor::~ChildProcessMonitor() = default;
+
+bool ChildProcessMonitor::addProcess (ChildProcess& process, Callbacks callbacks)
+{
+    return pimpl->add (process, std::move (callbacks));
+}
+
+void ChildProcessMonitor::removeProcess (ChildProcess& process)
+{
+    pimpl->remove (process);
+}
+
+int ChildProcessMonitor::getNumProcesses() const
+{
+    return pimpl->getNumProcesses();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ChildProcessMonitorTests  : public UnitTest
+{
+public:
+    ChildProcessMonitorTests()
+        : UnitTest ("ChildProcessMonitor", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+      #if JUCE_MAC || JUCE_LINUX || JUCE_BSD
+        beginTest ("Output and exit codes from many processes");
+        {
+            constexpr int numProcesses = 32;
+
+            OwnedArray<ChildProcess> processes;
+            ChildProcessMonitor monitor;
+
+            CriticalSection resultsLock;
+            std::vector<String> outputs (numProcesses), errors (numProcesses);
+            std::vector<int> exitCodes (numProcesses, -1);
+            std::atomic<int> numFinished { 0 };
+            WaitableEvent allFinished;
+
+            for (int i = 0; i < numProcesses; ++i)
+            {
+                auto* process = processes.add (new ChildProcess());
+                auto script = "echo out" + String (i) + "; echo err" + String (i) + " >&2; exit " + String (i % 5);
+
+                expect (process->start (StringArray { "/bin/sh", "-c", script },
+                                        ChildProcess::wantStdOut | ChildProcess::wantStdErr | ChildProcess::separateStdErr));
+
+                auto append = [&resultsLock] (String& dest)
+                {
+                    return [&resultsLock, &dest] (const char* data, int numBytes)
+                    {
+                        const ScopedLock sl (resultsLock);
+                        dest += String (data, (size_t) numBytes);
+                    };
+                };
+
+                expect (monitor.addProcess (*process, { append (outputs[(size_t) i]),
+                                                        append (errors[(size_t) i]),
+                                                        [&, i] (uint32 exitCode)
+                                                        {
+                                                            {
+                                                                const ScopedLock sl (resultsLock);
+                                                                exitCodes[(size_t) i] = (int) exitCode;
+                                                            }
+
+                                                            if (++numFinished == numProcesses)
+                                                                allFinished.signal();
+                                                        } }));
+            }
+
+            expect (allFinished.wait (20000));
+            expectEquals (monitor.getNumProcesses(), 0);
+
+            const ScopedLock sl (resultsLock);
+
+            for (int i = 0; i < numProcesses; ++i)
+            {
+                expectEquals (outputs[(size_t) i], "out" + String (i) + "\n");
+                expectEquals (errors[(size_t) i], "err" + String (i) + "\n");
+                expectEquals (exitCodes[(size_t) i], i % 5);
+            }
+        }
+
+        beginTest ("Writing input to a monitored process");
+        {
+            ChildProcessMonitor monitor;
+            ChildProcess process;
+            String output;
+            WaitableEvent finished;
+
+            expect (process.start ("cat", ChildProcess::wantStdOut | ChildProcess::wantStdIn));
+            expect (monitor.addProcess (process, { [&output] (const char* data, int numBytes) { output += String (data, (size_t) numBytes); },
+                                                   nullptr,
+                                                   [&finished] (uint32) { finished.signal(); } }));
+
+            const String message ("hello from the parent");
+            expectEquals (process.writeProcessInput (message.toRawUTF8(), (int) message.getNumBytesAsUTF8()),
+                          (int) message.getNumBytesAsUTF8());
+            process.closeProcessInput();
+
+            expect (finished.wait (10000));
+            expectEquals (output, message);
+        }
+
+        beginTest ("Removing a process");
+        {
+            ChildProcessMonitor monitor;
+            ChildProcess process;
+            std::atomic<bool> exitCalled { false };
+
+            expect (process.start ("sleep 10", ChildProcess::wantStdOut));
+            expect (monitor.addProcess (process, { nullptr, nullptr, [&exitCalled] (uint32) { exitCalled = true; } }));
+            expect (! monitor.addProcess (process, {}));
+            expectEquals (monitor.getNumProcesses(), 1);
+
+            monitor.removeProcess (process);
+            expectEquals (monitor.getNumProcesses(), 0);
+
+            process.kill();
+            expect (process.waitForProcessToFinish (5000));
+            Thread::sleep (50);
+            expect (! exitCalled);
+        }
+      #endif
+    }
+};
+
+static ChildProcessMonitorTests childProcessMonitorTests;
+
+#endif
+
+} // namespace juce
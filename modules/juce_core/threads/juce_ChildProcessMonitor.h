@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Follows the output of many child processes using a single thread.
+
+    Rather than blocking a thread in ChildProcess::readProcessOutput() for each child,
+    you start the processes as usual and add them to a monitor. Its thread waits on all
+    of their pipes at once, and calls your callbacks with the data as it arrives, and
+    again when each process finishes. On POSIX systems it waits with poll(); Windows
+    can't wait on anonymous pipes, so there the thread checks them every few
+    milliseconds instead.
+
+    The callbacks are all called on the monitor's thread, one at a time. A process
+    counts as finished once it has exited and its output pipes have been closed, after
+    which the monitor forgets about it, so you may delete the ChildProcess from inside
+    its onExit callback. Otherwise, you must call removeProcess() before deleting or
+    restarting a ChildProcess that the monitor is watching.
+
+    You can still write to a monitored process with ChildProcess::writeProcessInput(),
+    but don't call its read methods.
+
+    @code
+    ChildProcessMonitor monitor;
+    ChildProcess process;
+
+    if (process.start ("ls -l", ChildProcess::wantStdOut))
+    {
+        monitor.addProcess (process, { [] (const char* data, int numBytes) { DBG (String (data, (size_t) numBytes)); },
+                                       nullptr,
+                                       [] (uint32 exitCode) { DBG ("Finished: " << (int) exitCode); } });
+    }
+    @endcode
+
+    @see ChildProcess
+
+    @tags{Core}
+*/
+class JUCE_API  ChildProcessMonitor
+{
+public:
+    //==============================================================================
+    /** The functions that the monitor calls for a process. Any of them may be nullptr. */
+    struct Callbacks
+    {
+        /** Called with each block of data that arrives on the child's stdout stream. */
+        std::function<void (const char* data, int numBytes)> onOutput;
+
+        /** Called with each block of data that arrives on the child's stderr stream, if
+            it was started with the separateStdErr flag.
+        */
+        std::function<void (const char* data, int numBytes)> onErrorOutput;
+
+        /** Called once the process has finished, with its exit code. */
+        std::function<void (uint32 exitCode)> onExit;
+    };
+
+    //==============================================================================
+    /** Creates a monitor and starts its thread. */
+    explicit ChildProcessMonitor (const String& threadName = "JUCE Child Processes");
+
+    /** Destructor.
+        This stops the thread, waiting for any callback that's running to return. The
+        processes themselves are left running.
+    */
+    ~ChildProcessMonitor();
+
+    //==============================================================================
+    /** Starts watching a process.
+
+        Returns false if the process hasn't been successfully started, or if it's already
+        being watched.
+    */
+    bool addProcess (ChildProcess& process, Callbacks callbacks);
+
+    /** Stops watching a process, without calling its onExit callback.
+
+        If one of the process's callbacks is running on the monitor's thread, this waits
+        for it to return. It's safe to call this from inside one of the callbacks.
+    */
+    void removeProcess (ChildProcess& process);
+
+    /** Returns the number of processes that are being watched. */
+    int getNumProcesses() const;
+
+private:
+    //==============================================================================
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessMonitor)
+};
+
+} // namespace juce
@@ -23,75 +23,379 @@
 namespace juce
 {
 
-class HighResolutionTimer::Pimpl : public Thread
+//==============================================================================
+namespace HighResolutionTimerHelpers
 {
-    using steady_clock = std::chrono::steady_clock;
-    using milliseconds = std::chrono::milliseconds;
+    using Clock = std::chrono::steady_clock;
 
-public:
-    explicit Pimpl (HighResolutionTimer& ownerRef)
-        : Thread ("HighResolutionTimerThread"),
-          owner (ownerRef)
+    // Sleeps until a deadline, or until another thread calls wakeUp()
+   #if JUCE_LINUX || JUCE_ANDROID
+    class Waiter
     {
-    }
+    public:
+        // steady_clock counts from the same epoch as CLOCK_MONOTONIC here, so its
+        // deadlines can be handed straight to the timerfd
+        Waiter()
+            : timerHandle (timerfd_create (CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK)),
+              wakeUpHandle (eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK))
+        {
+            jassert (timerHandle >= 0 && wakeUpHandle >= 0);
+        }
+
+        ~Waiter()
+        {
+            for (auto handle : { timerHandle, wakeUpHandle })
+                if (handle >= 0)
+                    close (handle);
+        }
+
+        void waitUntil (Clock::time_point deadline)
+        {
+            pollfd fds[] = { { wakeUpHandle, POLLIN, 0 }, { timerHandle, POLLIN, 0 } };
+            nfds_t numFds = 1;
+
+            if (deadline != Clock::time_point::max())
+            {
+                const auto nanos = jmax ((int64) 1, (int64) std::chrono::duration_cast<std::chrono::nanoseconds> (deadline.time_since_epoch()).count());
+
+                itimerspec spec {};
+                spec.it_value.tv_sec  = (time_t) (nanos / 1000000000);
+                spec.it_value.tv_nsec = (long) (nanos % 1000000000);
+
+                if (timerfd_settime (timerHandle, TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+                    numFds = 2;
+            }
+
+            if (poll (fds, numFds, -1) > 0)
+            {
+                uint64 count = 0;
+
+                for (auto& f : fds)
+                    if (f.revents != 0)
+                        ignoreUnused (::read (f.fd, &count, sizeof (count)));
+            }
+        }
+
+        void wakeUp()
+        {
+            const uint64 one = 1;
+            ignoreUnused (::write (wakeUpHandle, &one, sizeof (one)));
+        }
 
-    using Thread::isThreadRunning;
+    private:
+        int timerHandle, wakeUpHandle;
 
-    void start (int periodMs)
+        JUCE_DECLARE_NON_COPYABLE (Waiter)
+    };
+
+   #elif JUCE_WINDOWS
+    class Waiter
     {
+    public:
+        Waiter()
         {
-            const std::scoped_lock lk { mutex };
-            periodMillis = periodMs;
-            nextTickTime = steady_clock::now() + milliseconds (periodMillis);
+           #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+            constexpr DWORD CREATE_WAITABLE_TIMER_HIGH_RESOLUTION = 0x00000002;
+           #endif
+
+            // The high-resolution flag needs Windows 10 1803 or later
+            timer = CreateWaitableTimerExW (nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+            if (timer == nullptr)
+                timer = CreateWaitableTimerExW (nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+
+            jassert (timer != nullptr && wakeUpEvent != nullptr);
+        }
+
+        ~Waiter()
+        {
+            CloseHandle (timer);
+            CloseHandle (wakeUpEvent);
+        }
+
+        void waitUntil (Clock::time_point deadline)
+        {
+            if (deadline != Clock::time_point::max())
+            {
+                // a negative due time is relative, in units of 100ns
+                const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds> (deadline - Clock::now()).count();
+
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -jmax ((LONGLONG) 1, (LONGLONG) (remaining / 100));
+
+                if (SetWaitableTimer (timer, &dueTime, 0, nullptr, nullptr, FALSE))
+                {
+                    HANDLE handles[] = { wakeUpEvent, timer };
+                    WaitForMultipleObjects (2, handles, FALSE, INFINITE);
+                    return;
+                }
+            }
+
+            WaitForSingleObject (wakeUpEvent, INFINITE);
+        }
+
+        void wakeUp()
+        {
+            SetEvent (wakeUpEvent);
+        }
+
+    private:
+        HANDLE timer = nullptr, wakeUpEvent = CreateEvent (nullptr, FALSE, FALSE, nullptr);
+
+        JUCE_DECLARE_NON_COPYABLE (Waiter)
+    };
+
+   #else
+    class Waiter
+    {
+    public:
+        Waiter() = default;
+
+        void waitUntil (Clock::time_point deadline)
+        {
+           #if JUCE_MAC || JUCE_IOS
+            // A condition variable can oversleep by a fair amount, so it's only used to get
+            // close to the deadline. The last stretch uses mach_wait_until(), which can't be
+            // interrupted but is far more precise.
+            constexpr auto preciseWaitTime = std::chrono::milliseconds (2);
+           #else
+            constexpr auto preciseWaitTime = Clock::duration::zero();
+           #endif
+
+            {
+                std::unique_lock lk { mutex };
+                const auto wasWoken = [this] { return std::exchange (woken, false); };
+
+                if (deadline == Clock::time_point::max())
+                {
+                    condition.wait (lk, wasWoken);
+                    return;
+                }
+
+                if (condition.wait_until (lk, deadline - preciseWaitTime, wasWoken))
+                    return;
+            }
+
+           #if JUCE_MAC || JUCE_IOS
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds> (deadline - Clock::now()).count();
+
+            if (remaining > 0)
+            {
+                mach_timebase_info_data_t timebase;
+                mach_timebase_info (&timebase);
+                mach_wait_until (mach_absolute_time() + (uint64) remaining * timebase.denom / timebase.numer);
+            }
+           #endif
         }
 
-        waitEvent.notify_one();
+        void wakeUp()
+        {
+            {
+                const std::scoped_lock lk { mutex };
+                woken = true;
+            }
+
+            condition.notify_one();
+        }
 
-        if (! isThreadRunning())
-            startThread (Thread::Priority::high);
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool woken = false;
+
+        JUCE_DECLARE_NON_COPYABLE (Waiter)
+    };
+   #endif
+}
+
+//==============================================================================
+/*  The thread that makes the callbacks for all of the HighResolutionTimers. It keeps
+    a heap of their next deadlines, and sleeps until the earliest one.
+*/
+class HighResolutionTimerThread  : private Thread
+{
+public:
+    using Clock = HighResolutionTimerHelpers::Clock;
+
+    struct TimerState
+    {
+        explicit TimerState (HighResolutionTimer& t)  : owner (t) {}
+
+        HighResolutionTimer& owner;
+        std::atomic<int> periodMillis { 0 };
+
+        // these are guarded by the thread's mutex
+        int64 numCallbacks = 0, numMissedDeadlines = 0;
+        double totalLatenessMs = 0.0, totalSquaredLatenessMs = 0.0, maxLatenessMs = 0.0;
+    };
+
+    HighResolutionTimerThread()  : Thread ("HighResolutionTimerThread") {}
+
+    ~HighResolutionTimerThread() override
+    {
+        // All the timers should have been stopped before the last one was deleted
+        jassert (queue.empty());
+
+        signalThreadShouldExit();
+        waiter.wakeUp();
+        stopThread (-1);
     }
 
-    void stop()
+    void start (TimerState& timer, int periodMs)
     {
         {
             const std::scoped_lock lk { mutex };
-            periodMillis = 0;
+            removeFromQueue (timer);
+            timer.periodMillis = periodMs;
+            queue.push_back ({ Clock::now() + std::chrono::milliseconds (periodMs), &timer });
+            std::push_heap (queue.begin(), queue.end(), isLater);
+
+            if (! isThreadRunning())
+                startThread (Thread::Priority::high);
         }
 
-        waitEvent.notify_one();
+        waiter.wakeUp();
+    }
+
+    void stop (TimerState& timer)
+    {
+        std::unique_lock lk { mutex };
+        removeFromQueue (timer);
+        timer.periodMillis = 0;
 
+        // If this is the timer thread, the callback that's running can't be this timer's,
+        // unless it's stopping itself, in which case it doesn't need to wait
         if (Thread::getCurrentThreadId() != getThreadId())
-            stopThread (-1);
+            callbackFinished.wait (lk, [&] { return timerInCallback != &timer; });
+    }
+
+    HighResolutionTimer::TimingStatistics getStatistics (const TimerState& timer) const
+    {
+        const std::scoped_lock lk { mutex };
+
+        HighResolutionTimer::TimingStatistics stats;
+        stats.numCallbacks = timer.numCallbacks;
+        stats.numMissedDeadlines = timer.numMissedDeadlines;
+        stats.maxLatenessMs = timer.maxLatenessMs;
+
+        if (timer.numCallbacks > 0)
+        {
+            const auto n = (double) timer.numCallbacks;
+            stats.meanLatenessMs = timer.totalLatenessMs / n;
+            stats.jitterMs = std::sqrt (jmax (0.0, timer.totalSquaredLatenessMs / n - stats.meanLatenessMs * stats.meanLatenessMs));
+        }
+
+        return stats;
     }
 
-    int getPeriod() const
+    void resetStatistics (TimerState& timer)
     {
-        return periodMillis;
+        const std::scoped_lock lk { mutex };
+        timer.numCallbacks = timer.numMissedDeadlines = 0;
+        timer.totalLatenessMs = timer.totalSquaredLatenessMs = timer.maxLatenessMs = 0.0;
     }
 
 private:
+    struct Deadline
+    {
+        Clock::time_point time;
+        TimerState* timer;
+    };
+
+    static bool isLater (const Deadline& a, const Deadline& b) noexcept   { return a.time > b.time; }
+
+    void removeFromQueue (TimerState& timer)
+    {
+        auto found = std::find_if (queue.begin(), queue.end(), [&] (const Deadline& d) { return d.timer == &timer; });
+
+        if (found != queue.end())
+        {
+            queue.erase (found);
+            std::make_heap (queue.begin(), queue.end(), isLater);
+        }
+    }
+
     void run() override
     {
-        for (;;)
+        while (! threadShouldExit())
         {
+            TimerState* timer = nullptr;
+            auto nextDeadline = Clock::time_point::max();
+
             {
-                std::unique_lock lk { mutex };
+                const std::scoped_lock lk { mutex };
+                const auto now = Clock::now();
 
-                if (waitEvent.wait_until (lk, nextTickTime, [this] { return periodMillis == 0; }))
-                    break;
+                if (! queue.empty())
+                {
+                    nextDeadline = queue.front().time;
+
+                    if (nextDeadline <= now)
+                    {
+                        std::pop_heap (queue.begin(), queue.end(), isLater);
+                        auto due = queue.back();
+                        queue.pop_back();
+
+                        timer = due.timer;
+                        scheduleNextCallback (*timer, due.time, now);
+                        timerInCallback = timer;
+                    }
+                }
+            }
 
-                nextTickTime = steady_clock::now() + milliseconds (periodMillis);
+            if (timer == nullptr)
+            {
+                waiter.waitUntil (nextDeadline);
+                continue;
+            }
+
+            timer->owner.hiResTimerCallback();
+
+            {
+                const std::scoped_lock lk { mutex };
+                timerInCallback = nullptr;
             }
 
-            owner.hiResTimerCallback();
+            callbackFinished.notify_all();
         }
     }
 
-    HighResolutionTimer& owner;
-    std::atomic<int> periodMillis { 0 };
-    steady_clock::time_point nextTickTime;
-    std::mutex mutex;
-    std::condition_variable waitEvent;
+    void scheduleNextCallback (TimerState& timer, Clock::time_point deadline, Clock::time_point now)
+    {
+        const auto period = std::chrono::milliseconds (timer.periodMillis.load());
+        const auto lateness = now - deadline;
+        const auto latenessMs = std::chrono::duration<double, std::milli> (lateness).count();
+
+        // skip any deadlines that have already gone by, rather than making a burst of callbacks
+        const auto numMissed = (int64) (lateness / period);
+
+        ++timer.numCallbacks;
+        timer.numMissedDeadlines += numMissed;
+        timer.totalLatenessMs += latenessMs;
+        timer.totalSquaredLatenessMs += latenessMs * latenessMs;
+        timer.maxLatenessMs = jmax (timer.maxLatenessMs, latenessMs);
+
+        queue.push_back ({ deadline + period * (numMissed + 1), &timer });
+        std::push_heap (queue.begin(), queue.end(), isLater);
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable callbackFinished;
+    std::vector<Deadline> queue;
+    TimerState* timerInCallback = nullptr;
+    HighResolutionTimerHelpers::Waiter waiter;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighResolutionTimerThread)
+};
+
+//==============================================================================
+class HighResolutionTimer::Pimpl
+{
+public:
+    explicit Pimpl (HighResolutionTimer& ownerRef)  : state (ownerRef) {}
+
+    SharedResourcePointer<HighResolutionTimerThread> thread;
+    HighResolutionTimerThread::TimerState state;
 };
 
 HighResolutionTimer::HighResolutionTimer()
@@ -106,15 +410,149 @@ HighResolutionTimer::~HighResolutionTimer()
 
 void HighResolutionTimer::startTimer (int periodMs)
 {
-    pimpl->start (jmax (1, periodMs));
+    pimpl->thread->start (pimpl->state, jmax (1, periodMs));
 }
 
 void HighResolutionTimer::stopTimer()
 {
-    pimpl->stop();
+    pimpl->thread->stop (pimpl->state);
 }
 
 bool HighResolutionTimer::isTimerRunning() const noexcept     { return getTimerInterval() != 0; }
-int HighResolutionTimer::getTimerInterval() const noexcept    { return pimpl->getPeriod(); }
+int HighResolutionTimer::getTimerInterval() const noexcept    { return pimpl->state.periodMillis; }
+
+HighResolutionTimer::TimingStatistics HighResolutionTimer::getTimingStatistics() const
+{
+    return pimpl->thread->getStatistics (pimpl->state);
+}
+
+void HighResolutionTimer::resetTimingStatistics()
+{
+    pimpl->thread->resetStatistics (pimpl->state);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class HighResolutionTimerTests  : public UnitTest
+{
+public:
+    HighResolutionTimerTests()
+        : UnitTest ("HighResolutionTimer", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Many timers share one thread");
+        {
+            constexpr int numTimers = 24;
+            OwnedArray<CountingTimer> timers;
+
+            for (int i = 0; i < numTimers; ++i)
+                timers.add (new CountingTimer (1 + i % 4));
+
+            Thread::sleep (200);
+
+            for (auto* t : timers)
+            {
+                t->stopTimer();
+                expect (t->count > 0);
+                expect (! t->isTimerRunning());
+                expect (t->callbackThread.load() == timers.getFirst()->callbackThread.load());
+            }
+        }
+
+        beginTest ("No callbacks after stopTimer returns");
+        {
+            CountingTimer timer (1);
+            Thread::sleep (20);
+            timer.stopTimer();
+
+            const auto count = timer.count.load();
+            Thread::sleep (20);
+            expectEquals (timer.count.load(), count);
+        }
+
+        beginTest ("Stopping from the callback");
+        {
+            struct SelfStoppingTimer  : public HighResolutionTimer
+            {
+                void hiResTimerCallback() override
+                {
+                    ++count;
+                    stopTimer();
+                }
+
+                std::atomic<int> count { 0 };
+            };
+
+            SelfStoppingTimer timer;
+            timer.startTimer (1);
+            Thread::sleep (50);
+            expectEquals (timer.count.load(), 1);
+            expect (! timer.isTimerRunning());
+        }
+
+        beginTest ("Timing statistics");
+        {
+            CountingTimer timer (2);
+            Thread::sleep (100);
+            timer.stopTimer();
+
+            auto stats = timer.getTimingStatistics();
+            expectEquals (stats.numCallbacks, (int64) timer.count.load());
+            expect (stats.meanLatenessMs >= 0.0);
+            expect (stats.maxLatenessMs >= stats.meanLatenessMs);
+            expect (stats.jitterMs >= 0.0);
+
+            timer.resetTimingStatistics();
+            expectEquals (timer.getTimingStatistics().numCallbacks, (int64) 0);
+        }
+
+        beginTest ("Missed deadlines are skipped");
+        {
+            struct SlowTimer  : public HighResolutionTimer
+            {
+                void hiResTimerCallback() override
+                {
+                    if (++count == 1)
+                        Thread::sleep (25);
+                }
+
+                std::atomic<int> count { 0 };
+            };
+
+            SlowTimer timer;
+            timer.startTimer (5);
+            Thread::sleep (40);
+            timer.stopTimer();
+
+            auto stats = timer.getTimingStatistics();
+            expect (stats.numMissedDeadlines >= 3);
+            expect (timer.count.load() < 8);
+        }
+    }
+
+private:
+    struct CountingTimer  : public HighResolutionTimer
+    {
+        explicit CountingTimer (int intervalMs)   { startTimer (intervalMs); }
+        ~CountingTimer() override                 { stopTimer(); }
+
+        void hiResTimerCallback() override
+        {
+            callbackThread = Thread::getCurrentThreadId();
+            ++count;
+        }
+
+        std::atomic<int> count { 0 };
+        std::atomic<Thread::ThreadID> callbackThread { nullptr };
+    };
+};
+
+static HighResolutionTimerTests highResolutionTimerTests;
+
+#endif
 
 } // namespace juce
@@ -27,13 +27,20 @@ namespace juce
     A high-resolution periodic timer.
 
     This provides accurately-timed regular callbacks. Unlike the normal Timer
-    class, this one uses a dedicated thread, not the message thread, so is
-    far more stable and precise.
+    class, this one doesn't use the message thread, so is far more stable and
+    precise.
 
-    You should only use this class in situations where you really need accuracy,
-    because unlike the normal Timer class, which is very lightweight and cheap
-    to start/stop, the HighResolutionTimer will use far more resources, and
-    starting/stopping it may involve launching and killing threads.
+    All HighResolutionTimers share a single high-priority thread, which keeps a
+    queue of their deadlines and sleeps using the most precise timer that the
+    system has (a timerfd on Linux, a high-resolution waitable timer on Windows,
+    and mach_wait_until() for the last stretch on macOS). The callbacks are made
+    one at a time on that thread, so a slow callback will delay the others - keep
+    them short, and use getTimingStatistics() to check how late they're running.
+
+    Callbacks are scheduled at whole multiples of the interval from when the timer
+    was started, so they don't drift. If a callback is so late that one or more
+    later deadlines have already passed, those callbacks are skipped rather than
+    made in a burst, and counted as missed deadlines.
 
     @see Timer
 
@@ -92,6 +99,36 @@ public:
     */
     int getTimerInterval() const noexcept;
 
+    //==============================================================================
+    /** Measurements of how punctually a timer's callbacks have been made. */
+    struct TimingStatistics
+    {
+        /** The number of callbacks that have been made. */
+        int64 numCallbacks = 0;
+
+        /** The number of callbacks that were skipped because an earlier one was made
+            more than a whole interval late.
+        */
+        int64 numMissedDeadlines = 0;
+
+        /** The average time between a callback's deadline and the moment it was made. */
+        double meanLatenessMs = 0.0;
+
+        /** The longest time between a callback's deadline and the moment it was made. */
+        double maxLatenessMs = 0.0;
+
+        /** The standard deviation of the callbacks' lateness. */
+        double jitterMs = 0.0;
+    };
+
+    /** Returns the timing measurements gathered since the timer was created, or since
+        resetTimingStatistics() was last called.
+    */
+    TimingStatistics getTimingStatistics() const;
+
+    /** Clears the timing measurements. */
+    void resetTimingStatistics();
+
 private:
     class Pimpl;
     std::unique_ptr<Pimpl> pimpl;
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace detail
+{
+
+class ReadCopyUpdateReclaimerThread  : public ReadCopyUpdateReclaimer,
+                                       private Thread
+{
+public:
+    ReadCopyUpdateReclaimerThread()  : Thread ("ReadCopyUpdatePointer reclaimer")
+    {
+        startThread (Priority::background);
+    }
+
+    ~ReadCopyUpdateReclaimerThread() override
+    {
+        // Every client holds a reference to this object until it's been removed
+        jassert (clients.isEmpty());
+        stopThread (5000);
+    }
+
+    void add (Client& client) override
+    {
+        {
+            const ScopedLock sl (clientsLock);
+            clients.addIfNotAlreadyThere (&client);
+        }
+
+        notify();
+    }
+
+    void remove (Client& client) override
+    {
+        const ScopedLock sl (clientsLock);
+        clients.removeFirstMatchingValue (&client);
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            bool anyLeft = false;
+
+            {
+                const ScopedLock sl (clientsLock);
+
+                for (int i = clients.size(); --i >= 0;)
+                {
+                    if (clients.getUnchecked (i)->reclaimRetiredObjects())
+                        clients.remove (i);
+                    else
+                        anyLeft = true;
+                }
+            }
+
+            // Readers are expected to be brief, so check again soon if they held anything up
+            wait (anyLeft ? 5 : -1);
+        }
+    }
+
+    CriticalSection clientsLock;
+    Array<Client*> clients;
+};
+
+std::shared_ptr<ReadCopyUpdateReclaimer> ReadCopyUpdateReclaimer::getInstance()
+{
+    static std::mutex mutex;
+    static std::weak_ptr<ReadCopyUpdateReclaimer> weak;
+
+    const std::lock_guard<std::mutex> lock (mutex);
+
+    if (auto existing = weak.lock())
+        return existing;
+
+    std::shared_ptr<ReadCopyUpdateReclaimer> instance = std::make_shared<ReadCopyUpdateReclaimerThread>();
+    weak = instance;
+    return instance;
+}
+
+} // namespace detail
+} // namespace juce
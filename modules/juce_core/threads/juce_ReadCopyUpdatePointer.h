@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace detail
+{
+    /** Periodically reclaims the objects that ReadCopyUpdatePointers have retired.
+        @internal
+    */
+    class JUCE_API  ReadCopyUpdateReclaimer
+    {
+    public:
+        struct Client
+        {
+            virtual ~Client() = default;
+
+            /** Returns true once there's nothing left to reclaim. */
+            virtual bool reclaimRetiredObjects() = 0;
+        };
+
+        /** Returns the shared reclaimer, starting its thread if necessary. */
+        static std::shared_ptr<ReadCopyUpdateReclaimer> getInstance();
+
+        virtual ~ReadCopyUpdateReclaimer() = default;
+
+        /** Asks the reclaimer to keep calling this client until it has nothing left to reclaim. */
+        virtual void add (Client&) = 0;
+
+        /** Stops calling the client, waiting if it's being called right now. */
+        virtual void remove (Client&) = 0;
+    };
+}
+
+//==============================================================================
+/**
+    Holds a pointer to an object that realtime threads can read without ever waiting,
+    while other threads replace it.
+
+    This is a simple form of read-copy-update. Readers create a ScopedReader, which
+    gives them the current object and keeps it alive until the reader is destroyed.
+    Creating and destroying a reader is wait-free, doesn't allocate and never blocks
+    on a writer, so it's safe to do on an audio thread.
+
+    To change the object, a writer builds a complete replacement and passes it to
+    reset(). The new object is used by any readers created after that point, and the
+    old one is deleted once all the readers that might still be using it have gone.
+    reset() waits for that to happen before it returns, so once it has returned, no
+    reader can still see the old object. That makes it suitable for lists of callbacks,
+    where the caller needs to know that a removed callback won't be called again.
+
+    The objects are treated as immutable once they've been published, so readers must
+    only ever look at them. Writers are serialised with each other, and should usually
+    be on a non-realtime thread, because reset() may have to wait for a reader to finish.
+    A thread that's holding a ScopedReader mustn't call reset() on the same object, as it
+    would be waiting for itself.
+
+    Writers that mustn't wait can call resetDeferred() instead, which retires the old
+    object rather than deleting it. A shared background thread deletes retired objects
+    once no reader can still be using them, or you can reclaim them yourself by calling
+    reclaimRetiredObjects() from a thread of your choosing.
+
+    @code
+    ReadCopyUpdatePointer<std::vector<Voice*>> voices;
+
+    // on the audio thread..
+    const ReadCopyUpdatePointer<std::vector<Voice*>>::ScopedReader reader (voices);
+
+    if (reader != nullptr)
+        for (auto* v : *reader)
+            v->render (buffer);
+
+    // on the message thread..
+    voices.update ([&] (auto& list) { list.push_back (newVoice); });
+    @endcode
+
+    @see SpinLock, ReadWriteLock
+
+    @tags{Core}
+*/
+template <typename ObjectType>
+class ReadCopyUpdatePointer  : private detail::ReadCopyUpdateReclaimer::Client
+{
+public:
+    //==============================================================================
+    /** Creates a pointer that holds nothing. */
+    ReadCopyUpdatePointer() = default;
+
+    /** Creates a pointer that holds the given object. */
+    explicit ReadCopyUpdatePointer (std::unique_ptr<ObjectType> initialObject) noexcept
+        : current (initialObject.release())
+    {
+    }
+
+    /** Destructor. There mustn't be any readers still using the object. */
+    ~ReadCopyUpdatePointer() override
+    {
+        if (reclaimer != nullptr)
+            reclaimer->remove (*this);
+
+        jassert (readers[0].load() == 0 && readers[1].load() == 0);
+        delete current.load();
+    }
+
+    //==============================================================================
+    /** Gives a reader access to the current object.
+
+        The object stays valid for as long as the ScopedReader exists. Keep readers
+        short-lived, as writers have to wait for the ones that started before them.
+    */
+    class ScopedReader
+    {
+    public:
+        /** Starts reading. This is wait-free. */
+        explicit ScopedReader (const ReadCopyUpdatePointer& p) noexcept
+            : owner (p),
+              slot (p.epoch.load() & 1)
+        {
+            owner.readers[slot].fetch_add (1);
+            object = owner.current.load();
+        }
+
+        /** Stops reading. This is wait-free. */
+        ~ScopedReader() noexcept
+        {
+            owner.readers[slot].fetch_sub (1);
+        }
+
+        /** Returns the object, which may be nullptr. */
+        const ObjectType* get() const noexcept          { return object; }
+        const ObjectType& operator*() const noexcept    { return *object; }
+        const ObjectType* operator->() const noexcept   { return object; }
+
+        bool operator== (std::nullptr_t) const noexcept { return object == nullptr; }
+        bool operator!= (std::nullptr_t) const noexcept { return object != nullptr; }
+
+    private:
+        const ReadCopyUpdatePointer& owner;
+        const size_t slot;
+        const ObjectType* object = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedReader)
+    };
+
+    //==============================================================================
+    /** Replaces the object.
+
+        Readers that start after this call will see the new object. Before returning,
+        this waits until the readers that might be using the old one have finished, and
+        then deletes it.
+    */
+    void reset (std::unique_ptr<ObjectType> newObject = {})
+    {
+        const ScopedLock sl (writeLock);
+        std::unique_ptr<ObjectType> old (current.exchange (newObject.release()));
+        waitForReaders();
+    }
+
+    /** Replaces the object without waiting for any readers.
+
+        Readers that start after this call will see the new object. The old one is
+        retired, and deleted later once no reader can still be using it, either on a
+        shared background thread or by reclaimRetiredObjects().
+        Unlike reset(), this may be called by a thread that's holding a ScopedReader.
+    */
+    void resetDeferred (std::unique_ptr<ObjectType> newObject = {})
+    {
+        std::shared_ptr<detail::ReadCopyUpdateReclaimer> reclaimerToNotify;
+
+        {
+            const ScopedLock sl (writeLock);
+            retired.emplace_back (current.exchange (newObject.release()));
+
+            if (reclaimsOnBackgroundThread)
+            {
+                if (reclaimer == nullptr)
+                    reclaimer = detail::ReadCopyUpdateReclaimer::getInstance();
+
+                reclaimerToNotify = reclaimer;
+            }
+        }
+
+        // This must happen outside the write lock, as the reclaimer's thread takes the
+        // locks in the opposite order
+        if (reclaimerToNotify != nullptr)
+            reclaimerToNotify->add (*this);
+    }
+
+    /** Like update(), but publishes the copy with resetDeferred(). */
+    template <typename Fn>
+    void updateDeferred (Fn&& modify)
+    {
+        resetDeferred (makeModifiedCopy (std::forward<Fn> (modify)));
+    }
+
+    /** Deletes any retired objects that no reader can still be using.
+
+        This never waits for readers. Objects that might still be in use are left for a
+        later call, so it should be called periodically while there are objects left,
+        which is indicated by this returning false.
+    */
+    bool reclaimRetiredObjects() override
+    {
+        const ScopedLock sl (writeLock);
+
+        for (;;)
+        {
+            if (objectsInGracePeriod.empty())
+            {
+                if (retired.empty())
+                    return true;
+
+                std::swap (objectsInGracePeriod, retired);
+                gracePeriodPhase = 0;
+            }
+
+            if (gracePeriodPhase > 0 && readers[gracePeriodSlot].load() != 0)
+                return false;
+
+            if (gracePeriodPhase == 2)
+            {
+                objectsInGracePeriod.clear();
+                continue;
+            }
+
+            gracePeriodSlot = flipEpoch();
+            ++gracePeriodPhase;
+        }
+    }
+
+    /** Chooses whether objects retired by resetDeferred() are deleted by a shared
+        background thread, which is the default.
+
+        If this is disabled, retired objects are only deleted by reclaimRetiredObjects(),
+        which is useful when they have to be deleted on a particular thread.
+    */
+    void setReclaimsOnBackgroundThread (bool shouldReclaimOnBackgroundThread)
+    {
+        const ScopedLock sl (writeLock);
+        reclaimsOnBackgroundThread = shouldReclaimOnBackgroundThread;
+    }
+
+    /** Makes a copy of the current object, lets a function change it, and then publishes
+        the copy with reset().
+
+        If there's no object yet, the function is given a default-constructed one.
+    */
+    template <typename Fn>
+    void update (Fn&& modify)
+    {
+        const ScopedLock sl (writeLock);
+        reset (makeModifiedCopy (std::forward<Fn> (modify)));
+    }
+
+    /** Returns the current object, for use by writers.
+
+        This doesn't stop the object from being deleted, so it's only safe to use while no
+        other thread can be calling reset() or update().
+    */
+    const ObjectType* getForWriter() const noexcept     { return current.load(); }
+
+private:
+    //==============================================================================
+    template <typename Fn>
+    std::unique_ptr<ObjectType> makeModifiedCopy (Fn&& modify)
+    {
+        const ScopedLock sl (writeLock);
+
+        // Only writers ever replace the object, so it can't change while we copy it
+        auto* existing = current.load();
+        auto copy = existing != nullptr ? std::make_unique<ObjectType> (*existing)
+                                        : std::make_unique<ObjectType>();
+        modify (*copy);
+        return copy;
+    }
+
+    // Returns the slot that readers were using before the flip
+    size_t flipEpoch() noexcept
+    {
+        return (size_t) (epoch.fetch_add (1) & 1);
+    }
+
+    void waitForReaders()
+    {
+        // Readers that arrive after a flip count themselves in the other slot, and will
+        // already see the new object. But a reader that read the epoch just before an
+        // earlier flip may have counted itself in the other slot too, so both slots need
+        // to empty in turn.
+        for (int phase = 0; phase < 2; ++phase)
+        {
+            const auto oldSlot = flipEpoch();
+
+            for (int spins = 0; readers[oldSlot].load() != 0; ++spins)
+            {
+                if (spins < 100)
+                    Thread::yield();
+                else
+                    Thread::sleep (1);
+            }
+        }
+
+        // That also covers everything that was waiting to be reclaimed
+        retired.clear();
+        objectsInGracePeriod.clear();
+        gracePeriodPhase = 0;
+    }
+
+    std::atomic<ObjectType*> current { nullptr };
+    mutable std::atomic<int> readers[2] { { 0 }, { 0 } };
+    std::atomic<size_t> epoch { 0 };
+    CriticalSection writeLock;
+
+    std::vector<std::unique_ptr<ObjectType>> retired, objectsInGracePeriod;
+    int gracePeriodPhase = 0;
+    size_t gracePeriodSlot = 0;
+    bool reclaimsOnBackgroundThread = true;
+    std::shared_ptr<detail::ReadCopyUpdateReclaimer> reclaimer;
+
+    JUCE_DECLARE_NON_COPYABLE (ReadCopyUpdatePointer)
+};
+
+} // namespace juce
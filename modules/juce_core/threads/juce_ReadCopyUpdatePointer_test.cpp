@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ReadCopyUpdatePointerTests  : public UnitTest
+{
+public:
+    ReadCopyUpdatePointerTests()
+        : UnitTest ("ReadCopyUpdatePointer", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Readers see the most recent object");
+        {
+            ReadCopyUpdatePointer<int> p;
+
+            {
+                const ReadCopyUpdatePointer<int>::ScopedReader reader (p);
+                expect (reader == nullptr);
+            }
+
+            p.reset (std::make_unique<int> (1));
+
+            {
+                const ReadCopyUpdatePointer<int>::ScopedReader reader (p);
+                expect (reader != nullptr);
+                expectEquals (*reader, 1);
+            }
+
+            p.update ([] (int& i) { i += 10; });
+            expectEquals (*p.getForWriter(), 11);
+
+            p.reset();
+            expect (p.getForWriter() == nullptr);
+        }
+
+        beginTest ("update() starts from a default object when empty");
+        {
+            ReadCopyUpdatePointer<std::vector<int>> p;
+            p.update ([] (std::vector<int>& v) { v.push_back (3); });
+            p.update ([] (std::vector<int>& v) { v.push_back (4); });
+
+            const ReadCopyUpdatePointer<std::vector<int>>::ScopedReader reader (p);
+            expect (*reader == std::vector<int> { 3, 4 });
+        }
+
+        beginTest ("reset() waits for readers of the old object");
+        {
+            ReadCopyUpdatePointer<Tracked> p (std::make_unique<Tracked> (1));
+            WaitableEvent readerStarted, releaseReader;
+            std::atomic<bool> resetReturned { false };
+
+            FunctionThread reader ([&]
+            {
+                const ReadCopyUpdatePointer<Tracked>::ScopedReader r (p);
+                readerStarted.signal();
+                releaseReader.wait (5000);
+
+                // The writer mustn't have deleted the object while we still hold it
+                expectEquals (r->value.load(), 1);
+            });
+
+            readerStarted.wait (5000);
+
+            FunctionThread writer ([&]
+            {
+                p.reset (std::make_unique<Tracked> (2));
+                resetReturned = true;
+            });
+
+            Thread::sleep (50);
+            expect (! resetReturned.load(), "reset() should wait for the reader");
+
+            {
+                // New readers aren't held up by the waiting writer, and see the new object
+                const ReadCopyUpdatePointer<Tracked>::ScopedReader r (p);
+                expectEquals (r->value.load(), 2);
+            }
+
+            releaseReader.signal();
+            writer.waitForThreadToExit (-1);
+            expect (resetReturned.load());
+        }
+
+        beginTest ("Objects are never used after being deleted");
+        {
+            ReadCopyUpdatePointer<Tracked> p (std::make_unique<Tracked> (0));
+            std::atomic<bool> finished { false }, sawDeletedObject { false };
+            std::atomic<int> numReads { 0 };
+
+            FunctionThread reader ([&]
+            {
+                while (! finished.load())
+                {
+                    const ReadCopyUpdatePointer<Tracked>::ScopedReader r (p);
+
+                    if (r->value.load() < 0)
+                        sawDeletedObject = true;
+
+                    ++numReads;
+                }
+            });
+
+            while (numReads.load() == 0)
+                Thread::yield();
+
+            for (int i = 1; i <= 2000; ++i)
+                p.reset (std::make_unique<Tracked> (i));
+
+            finished = true;
+            reader.waitForThreadToExit (-1);
+
+            expect (! sawDeletedObject.load());
+        }
+
+        beginTest ("Deferred objects are only reclaimed once their readers have finished");
+        {
+            std::atomic<int> numDeleted { 0 };
+            ReadCopyUpdatePointer<Counted> p (std::make_unique<Counted> (&numDeleted));
+            p.setReclaimsOnBackgroundThread (false);
+
+            {
+                // A reader may replace the object that it's reading
+                const ReadCopyUpdatePointer<Counted>::ScopedReader reader (p);
+                p.resetDeferred (std::make_unique<Counted> (&numDeleted));
+
+                expect (! p.reclaimRetiredObjects());
+                expectEquals (numDeleted.load(), 0);
+            }
+
+            expect (p.reclaimRetiredObjects());
+            expectEquals (numDeleted.load(), 1);
+
+            p.updateDeferred ([] (Counted&) {});
+            p.resetDeferred();
+            expect (p.reclaimRetiredObjects());
+            expectEquals (numDeleted.load(), 3);
+        }
+
+        beginTest ("Deferred objects are reclaimed in the background");
+        {
+            std::atomic<int> numDeleted { 0 };
+            ReadCopyUpdatePointer<Counted> p (std::make_unique<Counted> (&numDeleted));
+
+            for (int i = 0; i < 10; ++i)
+                p.resetDeferred (std::make_unique<Counted> (&numDeleted));
+
+            for (int i = 0; i < 500 && numDeleted.load() < 10; ++i)
+                Thread::sleep (10);
+
+            expectEquals (numDeleted.load(), 10);
+        }
+
+        beginTest ("Deferred objects are never used after being deleted");
+        {
+            ReadCopyUpdatePointer<Tracked> p (std::make_unique<Tracked> (0));
+            std::atomic<bool> finished { false }, sawDeletedObject { false };
+
+            FunctionThread reader ([&]
+            {
+                while (! finished.load())
+                {
+                    const ReadCopyUpdatePointer<Tracked>::ScopedReader r (p);
+
+                    if (r->value.load() < 0)
+                        sawDeletedObject = true;
+                }
+            });
+
+            for (int i = 1; i <= 2000; ++i)
+                p.resetDeferred (std::make_unique<Tracked> (i));
+
+            finished = true;
+            reader.waitForThreadToExit (-1);
+
+            expect (! sawDeletedObject.load());
+        }
+    }
+
+private:
+    struct Tracked
+    {
+        explicit Tracked (int v) : value (v) {}
+        ~Tracked() { value = -1; }
+
+        std::atomic<int> value;
+    };
+
+    struct Counted
+    {
+        explicit Counted (std::atomic<int>* c = nullptr) : counter (c) {}
+        ~Counted() { if (counter != nullptr) ++*counter; }
+
+        std::atomic<int>* counter;
+    };
+
+    struct FunctionThread  : public Thread
+    {
+        explicit FunctionThread (std::function<void()> f)
+            : Thread ("ReadCopyUpdatePointer test"), fn (std::move (f))
+        {
+            startThread();
+        }
+
+        ~FunctionThread() override
+        {
+            waitForThreadToExit (-1);
+        }
+
+        void run() override { fn(); }
+
+        std::function<void()> fn;
+    };
+};
+
+static ReadCopyUpdatePointerTests readCopyUpdatePointerTests;
+
+} // namespace juce
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Plain thread_locals, because these are read from inside operator new
+static thread_local int realtimeSectionDepth = 0;
+static thread_local int allowBlockingDepth = 0;
+
+struct RealtimeSafetyHandlerHolder
+{
+    SpinLock lock;
+    RealtimeSafety::ViolationHandler handler;
+};
+
+static RealtimeSafetyHandlerHolder& getRealtimeSafetyHandlerHolder()
+{
+    static RealtimeSafetyHandlerHolder holder;
+    return holder;
+}
+
+const char* RealtimeSafety::getDescription (Violation violation) noexcept
+{
+    switch (violation)
+    {
+        case Violation::allocation:    return "allocation";
+        case Violation::deallocation:  return "deallocation";
+        case Violation::lock:          return "lock";
+        case Violation::wait:          return "wait";
+        case Violation::sleep:         return "sleep";
+    }
+
+    return "";
+}
+
+void RealtimeSafety::setViolationHandler (ViolationHandler newHandler)
+{
+    auto& holder = getRealtimeSafetyHandlerHolder();
+    const SpinLock::ScopedLockType sl (holder.lock);
+    std::swap (holder.handler, newHandler);
+}
+
+RealtimeSafety::ScopedRealtimeSection::ScopedRealtimeSection() noexcept   { ++realtimeSectionDepth; }
+RealtimeSafety::ScopedRealtimeSection::~ScopedRealtimeSection() noexcept  { --realtimeSectionDepth; }
+
+RealtimeSafety::ScopedAllowBlocking::ScopedAllowBlocking() noexcept       { ++allowBlockingDepth; }
+RealtimeSafety::ScopedAllowBlocking::~ScopedAllowBlocking() noexcept      { --allowBlockingDepth; }
+
+bool RealtimeSafety::isInRealtimeSection() noexcept
+{
+    return realtimeSectionDepth > 0 && allowBlockingDepth == 0;
+}
+
+void RealtimeSafety::reportViolation (Violation violation) noexcept
+{
+    // Reporting allocates, so stop checking this thread until we're done
+    const ScopedAllowBlocking allowBlocking;
+
+    ViolationHandler handler;
+
+    {
+        auto& holder = getRealtimeSafetyHandlerHolder();
+        const SpinLock::ScopedLockType sl (holder.lock);
+        handler = holder.handler;
+    }
+
+    const auto stackTrace = SystemStats::getStackBacktrace();
+
+    if (handler != nullptr)
+    {
+        handler (violation, stackTrace);
+        return;
+    }
+
+    DBG ("Real-time safety violation (" << getDescription (violation) << "):\n" << stackTrace);
+    jassertfalse;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeSafetyTests  : public UnitTest
+{
+public:
+    RealtimeSafetyTests()
+        : UnitTest ("RealtimeSafety", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Real-time sections nest, and can be suspended");
+        {
+            // Reporting a test result might allocate, so just record the states here
+            std::array<bool, 4> states {};
+
+            {
+                const RealtimeSafety::ScopedRealtimeSection outer;
+                states[0] = RealtimeSafety::isInRealtimeSection();
+
+                {
+                    const RealtimeSafety::ScopedRealtimeSection inner;
+                    states[1] = RealtimeSafety::isInRealtimeSection();
+
+                    const RealtimeSafety::ScopedAllowBlocking allowBlocking;
+                    states[2] = RealtimeSafety::isInRealtimeSection();
+                }
+
+                states[3] = RealtimeSafety::isInRealtimeSection();
+            }
+
+            expect (states == std::array<bool, 4> { true, true, false, true });
+            expect (! RealtimeSafety::isInRealtimeSection());
+        }
+
+       #if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+        beginTest ("Blocking calls in a real-time section are reported");
+        {
+            std::vector<RealtimeSafety::Violation> violations;
+            violations.reserve (16);
+
+            RealtimeSafety::setViolationHandler ([&] (RealtimeSafety::Violation v, const String& stackTrace)
+            {
+                jassert (stackTrace.isNotEmpty());
+                violations.push_back (v);
+            });
+
+            CriticalSection cs;
+            WaitableEvent event;
+
+            {
+                const RealtimeSafety::ScopedRealtimeSection realtime;
+
+                const ScopedLock sl (cs);
+                event.wait (0); // polling doesn't block, so shouldn't be reported
+                event.wait (1);
+                Thread::sleep (0);
+                delete new int (1);
+            }
+
+            RealtimeSafety::setViolationHandler (nullptr);
+
+            expect (violations == std::vector<RealtimeSafety::Violation> { RealtimeSafety::Violation::lock,
+                                                                           RealtimeSafety::Violation::wait,
+                                                                           RealtimeSafety::Violation::sleep,
+                                                                           RealtimeSafety::Violation::allocation,
+                                                                           RealtimeSafety::Violation::deallocation });
+        }
+       #endif
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+#endif
+
+} // namespace juce
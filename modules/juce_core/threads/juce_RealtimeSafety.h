@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Helps to catch code that might block a real-time thread, such as an audio callback.
+
+    Put a ScopedRealtimeSection at the top of the code that must never block. When
+    JUCE_ENABLE_REALTIME_SAFETY_CHECKS is enabled, any call made on that thread to
+    operator new or delete, CriticalSection::enter(), a WaitableEvent::wait() with a
+    timeout, or Thread::sleep() is then reported to the violation handler, along with
+    a stack trace. When the option is disabled, the checks compile to nothing.
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        const RealtimeSafety::ScopedRealtimeSection realtime;
+        ...
+    }
+    @endcode
+
+    @see ScratchArena
+
+    @tags{Core}
+*/
+struct JUCE_API  RealtimeSafety
+{
+    /** The kinds of operation that are reported. */
+    enum class Violation
+    {
+        allocation,     /**< operator new was called. */
+        deallocation,   /**< operator delete was called. */
+        lock,           /**< A CriticalSection was locked. */
+        wait,           /**< A WaitableEvent was waited on. */
+        sleep           /**< Thread::sleep() was called. */
+    };
+
+    /** Returns a short description of a violation, e.g. "allocation". */
+    static const char* getDescription (Violation) noexcept;
+
+    /** A function that's called with each violation and a stack trace of where it happened.
+        While it's running, the thread isn't checked, so the handler may allocate or lock.
+    */
+    using ViolationHandler = std::function<void (Violation, const String& stackTrace)>;
+
+    /** Sets the function that's called for each violation, or resets it to the default,
+        which prints the stack trace with DBG and triggers an assertion.
+        This should be set before any real-time sections are running.
+    */
+    static void setViolationHandler (ViolationHandler newHandler);
+
+    //==============================================================================
+    /** Marks the current thread as real-time for as long as this object exists.
+        These can be nested.
+    */
+    class JUCE_API  ScopedRealtimeSection
+    {
+    public:
+        ScopedRealtimeSection() noexcept;
+        ~ScopedRealtimeSection() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeSection)
+        JUCE_DECLARE_NON_MOVEABLE (ScopedRealtimeSection)
+    };
+
+    /** Temporarily allows the current thread to block inside a ScopedRealtimeSection,
+        e.g. for some logging that's known to be unsafe but wanted anyway.
+    */
+    class JUCE_API  ScopedAllowBlocking
+    {
+    public:
+        ScopedAllowBlocking() noexcept;
+        ~ScopedAllowBlocking() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAllowBlocking)
+        JUCE_DECLARE_NON_MOVEABLE (ScopedAllowBlocking)
+    };
+
+    /** Returns true if the current thread is inside a ScopedRealtimeSection, and
+        isn't inside a ScopedAllowBlocking.
+    */
+    static bool isInRealtimeSection() noexcept;
+
+    /** Reports a violation if the current thread is in a real-time section.
+        JUCE calls this from the operations listed above; you can call it from your own
+        blocking functions too.
+    */
+    static void check ([[maybe_unused]] Violation violation) noexcept
+    {
+       #if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+        if (isInRealtimeSection())
+            reportViolation (violation);
+       #endif
+    }
+
+private:
+    static void reportViolation (Violation) noexcept;
+};
+
+} // namespace juce
@@ -30,6 +30,9 @@ WaitableEvent::WaitableEvent (bool manualReset) noexcept
 
 bool WaitableEvent::wait (int timeOutMilliseconds) const
 {
+    if (timeOutMilliseconds != 0)
+        RealtimeSafety::check (RealtimeSafety::Violation::wait);
+
     std::unique_lock<std::mutex> lock (mutex);
 
     if (! triggered)
@@ -0,0 +1,570 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct WorkStealingThreadPool::Task
+{
+    std::function<void()> function;
+};
+
+//==============================================================================
+/*  A fixed-capacity Chase-Lev deque.
+
+    The owning worker pushes and pops tasks at the bottom, and any other thread may
+    steal tasks from the top. Only stealing, or popping the very last task, needs a
+    compare-and-swap.
+*/
+class WorkStealingThreadPool::TaskDeque
+{
+public:
+    bool push (Task* task) noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed);
+        const auto t = top.load (std::memory_order_acquire);
+
+        if (b - t >= (int64) capacity)
+            return false;
+
+        slots[(size_t) (b & mask)].store (task, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        bottom.store (b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Task* pop() noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed) - 1;
+        bottom.store (b, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto t = top.load (std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store (b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* task = slots[(size_t) (b & mask)].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // This is the last task, so we might be racing against a thief for it
+            if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return task;
+    }
+
+    Task* steal() noexcept
+    {
+        auto t = top.load (std::memory_order_acquire);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        const auto b = bottom.load (std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        auto* task = slots[(size_t) (t & mask)].load (std::memory_order_relaxed);
+
+        if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return task;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return bottom.load() <= top.load();
+    }
+
+private:
+    static constexpr size_t capacity = 4096, mask = capacity - 1;
+
+    std::atomic<int64> top { 0 }, bottom { 0 };
+    std::array<std::atomic<Task*>, capacity> slots {};
+};
+
+//==============================================================================
+class WorkStealingThreadPool::Worker  : public Thread
+{
+public:
+    Worker (WorkStealingThreadPool& p, int workerIndex, size_t stackSize)
+        : Thread ("Work Stealing Pool", stackSize), pool (p), index (workerIndex)
+    {
+    }
+
+    void run() override
+    {
+        if (pool.onThreadStart != nullptr)
+            pool.onThreadStart (index);
+
+        runTasks();
+
+        if (pool.onThreadStop != nullptr)
+            pool.onThreadStop (index);
+    }
+
+    void runTasks()
+    {
+        while (! threadShouldExit())
+        {
+            if (pool.runNextTask (this))
+                continue;
+
+            ++pool.numSleepingWorkers;
+            isSleeping = true;
+
+            // Check again in case a task arrived while we were deciding to sleep
+            if (! pool.runNextTask (this))
+                wait (10);
+
+            isSleeping = false;
+            --pool.numSleepingWorkers;
+        }
+    }
+
+    WorkStealingThreadPool& pool;
+    const int index;
+    TaskDeque tasks;
+    std::atomic<bool> isSleeping { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+WorkStealingThreadPool::WorkStealingThreadPool (int numThreads, size_t threadStackSize, Thread::Priority priority)
+    : WorkStealingThreadPool (Options{}.withNumThreads (numThreads)
+                                       .withThreadStackSize (threadStackSize)
+                                       .withPriority (priority))
+{
+    jassert (numThreads > 0); // not much point having a pool without any threads!
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+    : WorkStealingThreadPool (Options{})
+{
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool (const Options& options)
+    : onThreadStart (options.onThreadStart),
+      onThreadStop (options.onThreadStop)
+{
+    uint32 affinityMask = 0;
+    int numAllowedCpus = SystemStats::getNumCpus();
+
+    if (options.performanceCoresOnly)
+    {
+        numAllowedCpus = 0;
+
+        for (auto& cpu : SystemStats::getCpuTopology())
+        {
+            if (cpu.coreType == SystemStats::CpuCoreType::performance)
+            {
+                ++numAllowedCpus;
+
+                // Affinity masks can only describe the first 32 CPUs
+                if (cpu.index < 32)
+                    affinityMask |= (uint32) 1 << cpu.index;
+            }
+        }
+
+        // Only restrict the workers if some of the cores really are slower
+        if (numAllowedCpus == SystemStats::getNumCpus())
+            affinityMask = 0;
+    }
+
+    const auto numThreads = options.numThreads > 0 ? options.numThreads : jmax (1, numAllowedCpus);
+
+    for (int i = 0; i < numThreads; ++i)
+        workers.push_back (std::make_unique<Worker> (*this, i, options.threadStackSize));
+
+    for (auto& w : workers)
+    {
+       #if ! JUCE_MAC && ! JUCE_IOS
+        if (affinityMask != 0)
+            w->setAffinityMask (affinityMask);
+       #endif
+
+        if (options.realtimeOptions.hasValue())
+            w->startRealtimeThread (*options.realtimeOptions);
+        else
+            w->startThread (options.priority);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    // Let the workers finish anything that's still queued
+    while (runNextTask (getCurrentWorker()))
+    {}
+
+    for (auto& w : workers)
+        w->signalThreadShouldExit();
+
+    for (auto& w : workers)
+        w->stopThread (5000);
+
+    // Anything left was added by a task that was still running when we finished
+    while (auto* task = popInjectedTask())
+        delete task;
+}
+
+int WorkStealingThreadPool::getNumThreads() const noexcept
+{
+    return (int) workers.size();
+}
+
+void WorkStealingThreadPool::addTask (std::function<void()> task)
+{
+    jassert (task != nullptr);
+    addTask (new Task { std::move (task) });
+}
+
+void WorkStealingThreadPool::addTask (Task* task)
+{
+    auto* worker = getCurrentWorker();
+
+    if (worker == nullptr || ! worker->tasks.push (task))
+    {
+        const ScopedLock sl (injectedTasksLock);
+        injectedTasks.push_back (task);
+        ++numInjectedTasks;
+    }
+
+    wakeSleepingWorker();
+}
+
+WorkStealingThreadPool::Worker* WorkStealingThreadPool::getCurrentWorker() const noexcept
+{
+    if (auto* worker = dynamic_cast<Worker*> (Thread::getCurrentThread()))
+        if (&worker->pool == this)
+            return worker;
+
+    return nullptr;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::popInjectedTask()
+{
+    if (numInjectedTasks.load() == 0)
+        return nullptr;
+
+    const ScopedLock sl (injectedTasksLock);
+
+    if (injectedTasks.empty())
+        return nullptr;
+
+    auto* task = injectedTasks.front();
+    injectedTasks.pop_front();
+    --numInjectedTasks;
+    return task;
+}
+
+void WorkStealingThreadPool::wakeSleepingWorker()
+{
+    if (numSleepingWorkers.load() == 0)
+        return;
+
+    const auto numWorkers = (uint32) workers.size();
+    const auto start = nextWorkerToWake++;
+
+    for (uint32 i = 0; i < numWorkers; ++i)
+    {
+        auto& w = workers[(size_t) ((start + i) % numWorkers)];
+
+        if (w->isSleeping.load())
+        {
+            w->notify();
+            return;
+        }
+    }
+}
+
+bool WorkStealingThreadPool::runNextTask (Worker* worker)
+{
+    auto* task = worker != nullptr ? worker->tasks.pop() : nullptr;
+
+    if (task == nullptr)
+        task = popInjectedTask();
+
+    if (task == nullptr)
+    {
+        const auto numWorkers = workers.size();
+        const auto start = (size_t) Random::getSystemRandom().nextInt ((int) numWorkers);
+
+        for (size_t i = 0; i < numWorkers && task == nullptr; ++i)
+        {
+            auto& victim = workers[(start + i) % numWorkers];
+
+            if (victim.get() != worker)
+                task = victim->tasks.steal();
+        }
+    }
+
+    if (task == nullptr)
+        return false;
+
+    task->function();
+    delete task;
+    return true;
+}
+
+//==============================================================================
+WorkStealingThreadPool::TaskGroup::TaskGroup (WorkStealingThreadPool& pool)  : owner (pool)
+{
+}
+
+WorkStealingThreadPool::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void WorkStealingThreadPool::TaskGroup::run (std::function<void()> task)
+{
+    jassert (task != nullptr);
+
+    ++numUnfinishedTasks;
+
+    owner.addTask ([this, t = std::move (task)]
+    {
+        t();
+        taskFinished();
+    });
+}
+
+void WorkStealingThreadPool::TaskGroup::then (std::function<void()> continuation)
+{
+    jassert (continuation != nullptr);
+
+    ++numUnfinishedContinuations;
+
+    auto wrapped = [this, c = std::move (continuation)]
+    {
+        c();
+        --numUnfinishedContinuations;
+    };
+
+    {
+        const std::lock_guard<std::mutex> lock (continuationMutex);
+
+        if (numUnfinishedTasks.load() != 0)
+        {
+            pendingContinuations.push_back (std::move (wrapped));
+            return;
+        }
+    }
+
+    owner.addTask (std::move (wrapped));
+}
+
+void WorkStealingThreadPool::TaskGroup::taskFinished()
+{
+    if (--numUnfinishedTasks != 0)
+        return;
+
+    std::vector<std::function<void()>> continuations;
+
+    {
+        const std::lock_guard<std::mutex> lock (continuationMutex);
+        std::swap (continuations, pendingContinuations);
+    }
+
+    for (auto& c : continuations)
+        owner.addTask (std::move (c));
+}
+
+void WorkStealingThreadPool::TaskGroup::wait()
+{
+    auto* worker = owner.getCurrentWorker();
+
+    while (! isFinished())
+        if (! owner.runNextTask (worker))
+            Thread::yield();
+}
+
+bool WorkStealingThreadPool::TaskGroup::isFinished() const noexcept
+{
+    return numUnfinishedTasks.load() == 0 && numUnfinishedContinuations.load() == 0;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WorkStealingThreadPoolTests  : public UnitTest
+{
+public:
+    WorkStealingThreadPoolTests()
+        : UnitTest ("WorkStealingThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        WorkStealingThreadPool pool (4);
+
+        beginTest ("parallelFor visits every index exactly once");
+        {
+            std::vector<std::atomic<int>> visits (10000);
+
+            pool.parallelFor (0, (int) visits.size(), [&] (int i) { ++visits[(size_t) i]; });
+
+            expect (std::all_of (visits.begin(), visits.end(), [] (const auto& v) { return v.load() == 1; }));
+        }
+
+        beginTest ("parallelReduce combines partial results in order");
+        {
+            const auto sum = pool.parallelReduce (0, 100000, (int64) 0,
+                                                  [] (int i) { return (int64) i; },
+                                                  [] (int64 a, int64 b) { return a + b; });
+            expectEquals (sum, (int64) 100000 * 99999 / 2);
+
+            const auto text = pool.parallelReduce (0, 26, String(),
+                                                   [] (int i) { return String::charToString ((juce_wchar) ('a' + i)); },
+                                                   [] (const String& a, const String& b) { return a + b; },
+                                                   3);
+            expectEquals (text, String ("abcdefghijklmnopqrstuvwxyz"));
+        }
+
+        beginTest ("parallelSort sorts large ranges");
+        {
+            Random r (1234);
+            std::vector<int> values (100000);
+
+            for (auto& v : values)
+                v = r.nextInt (1000);
+
+            auto expected = values;
+            std::sort (expected.begin(), expected.end());
+
+            pool.parallelSort (values.begin(), values.end(), std::less<>(), false, 1000);
+            expect (values == expected);
+        }
+
+        beginTest ("parallelSort can keep the order of equivalent elements");
+        {
+            Random r (5678);
+            std::vector<std::pair<int, int>> values;
+
+            for (int i = 0; i < 50000; ++i)
+                values.emplace_back (r.nextInt (100), i);
+
+            auto expected = values;
+            const auto compareKeys = [] (const auto& a, const auto& b) { return a.first < b.first; };
+            std::stable_sort (expected.begin(), expected.end(), compareKeys);
+
+            pool.parallelSort (values.begin(), values.end(), compareKeys, true, 1000);
+            expect (values == expected);
+        }
+
+        beginTest ("Nested parallel loops don't deadlock");
+        {
+            std::atomic<int> count { 0 };
+
+            pool.parallelFor (0, 16, [&] (int)
+            {
+                pool.parallelFor (0, 100, [&] (int) { ++count; });
+            });
+
+            expectEquals (count.load(), 1600);
+        }
+
+        beginTest ("Continuations run after all the tasks in a group");
+        {
+            std::atomic<int> count { 0 };
+            std::atomic<int> countSeenByContinuation { -1 };
+
+            WorkStealingThreadPool::TaskGroup group (pool);
+
+            for (int i = 0; i < 100; ++i)
+                group.run ([&] { Thread::sleep (Random::getSystemRandom().nextInt (2)); ++count; });
+
+            group.then ([&] { countSeenByContinuation = count.load(); });
+            group.wait();
+
+            expectEquals (countSeenByContinuation.load(), 100);
+        }
+
+        beginTest ("A continuation on an empty group runs straight away");
+        {
+            std::atomic<bool> ran { false };
+
+            WorkStealingThreadPool::TaskGroup group (pool);
+            group.then ([&] { ran = true; });
+            group.wait();
+
+            expect (ran.load());
+        }
+
+        beginTest ("Thread start and stop callbacks are called once on each worker");
+        {
+            std::array<std::atomic<int>, 3> starts {}, stops {};
+
+            {
+                WorkStealingThreadPool callbackPool (WorkStealingThreadPool::Options{}.withNumThreads ((int) starts.size())
+                                                                                      .withPerformanceCoresOnly()
+                                                                                      .withThreadStartCallback ([&] (int i) { ++starts[(size_t) i]; })
+                                                                                      .withThreadStopCallback ([&] (int i) { ++stops[(size_t) i]; }));
+                expectEquals (callbackPool.getNumThreads(), (int) starts.size());
+
+                std::atomic<int> count { 0 };
+                callbackPool.parallelFor (0, 100, [&] (int) { ++count; });
+                expectEquals (count.load(), 100);
+            }
+
+            for (size_t i = 0; i < starts.size(); ++i)
+            {
+                expectEquals (starts[i].load(), 1);
+                expectEquals (stops[i].load(), 1);
+            }
+        }
+
+        beginTest ("CPU topology is consistent");
+        {
+            const auto& cpus = SystemStats::getCpuTopology();
+            expectEquals ((int) cpus.size(), SystemStats::getNumCpus());
+
+            std::set<int> indexes;
+
+            for (auto& cpu : cpus)
+                indexes.insert (cpu.index);
+
+            expectEquals ((int) indexes.size(), (int) cpus.size());
+            expect (SystemStats::getNumPhysicalCpus (SystemStats::CpuCoreType::performance) > 0);
+
+            for (auto& a : cpus)
+                for (auto& b : cpus)
+                    if (a.coreId == b.coreId && a.packageId == b.packageId)
+                        expect (a.coreType == b.coreType);
+        }
+    }
+};
+
+static WorkStealingThreadPoolTests workStealingThreadPoolTests;
+
+#endif
+
+} // namespace juce
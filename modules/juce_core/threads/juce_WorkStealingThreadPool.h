@@ -0,0 +1,383 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of threads which share out lots of small tasks using work-stealing.
+
+    Unlike ThreadPool, which keeps all of its jobs in a single locked list, each
+    worker thread here owns a lock-free deque of tasks. Workers push and pop tasks
+    at one end of their own deque, and idle workers steal tasks from the other end
+    of their neighbours' deques, so adding and running a task doesn't normally
+    need to take a lock at all.
+
+    This makes it a good fit for jobs that can be split into thousands of tiny
+    pieces, e.g. with parallelFor() or parallelReduce(). For long-running jobs
+    that need to be cancelled or monitored, ThreadPool is still a better choice.
+
+    @code
+    WorkStealingThreadPool pool;
+
+    pool.parallelFor (0, numFiles, [&] (int i) { processFile (files[i]); });
+
+    auto total = pool.parallelReduce (0, (int) data.size(), 0.0,
+                                      [&] (int i) { return data[(size_t) i]; },
+                                      [] (double a, double b) { return a + b; });
+    @endcode
+
+    @see ThreadPool, WorkStealingThreadPool::TaskGroup
+
+    @tags{Core}
+*/
+class JUCE_API  WorkStealingThreadPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool with the given number of worker threads.
+
+        @param numThreads       the number of worker threads to create
+        @param threadStackSize  the stack size for each thread, or 0 to use the default
+        @param priority         the priority of the worker threads
+    */
+    WorkStealingThreadPool (int numThreads,
+                            size_t threadStackSize = 0,
+                            Thread::Priority priority = Thread::Priority::normal);
+
+    /** Creates a pool with one worker thread for each CPU core. */
+    WorkStealingThreadPool();
+
+    //==============================================================================
+    /**
+        Options for creating a pool whose workers need more control over how and
+        where they run, e.g. real-time threads that help out an audio callback.
+
+        @code
+        WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withRealtimeOptions ({})
+                                                                      .withPerformanceCoresOnly());
+        @endcode
+    */
+    struct Options
+    {
+        /** Sets the number of worker threads. If this is zero, the pool will have one
+            thread for each logical CPU that it's allowed to run on.
+        */
+        [[nodiscard]] Options withNumThreads (int n) const                              { return withMember (*this, &Options::numThreads, n); }
+
+        /** Sets the stack size for each thread, or 0 to use the default. */
+        [[nodiscard]] Options withThreadStackSize (size_t size) const                   { return withMember (*this, &Options::threadStackSize, size); }
+
+        /** Sets the priority of the worker threads. This is ignored for real-time workers. */
+        [[nodiscard]] Options withPriority (Thread::Priority p) const                   { return withMember (*this, &Options::priority, p); }
+
+        /** Starts the workers as real-time threads using the given options. */
+        [[nodiscard]] Options withRealtimeOptions (Thread::RealtimeOptions o) const     { return withMember (*this, &Options::realtimeOptions, Optional<Thread::RealtimeOptions> (o)); }
+
+        /** Keeps the workers off the machine's efficiency cores.
+
+            On platforms that support thread affinity, the workers are bound to the
+            performance cores reported by SystemStats::getCpuTopology(). Elsewhere, the
+            OS chooses where the threads run, based on their priority or workgroup.
+        */
+        [[nodiscard]] Options withPerformanceCoresOnly (bool b = true) const            { return withMember (*this, &Options::performanceCoresOnly, b); }
+
+        /** Sets a function to be called on each worker thread when it starts, before it
+            runs any tasks. The argument is the index of the worker, from 0 to numThreads - 1.
+            This is a good place to join an audio workgroup.
+        */
+        [[nodiscard]] Options withThreadStartCallback (std::function<void (int)> f) const { return withMember (*this, &Options::onThreadStart, std::move (f)); }
+
+        /** Sets a function to be called on each worker thread just before it stops.
+            The argument is the index of the worker, from 0 to numThreads - 1.
+        */
+        [[nodiscard]] Options withThreadStopCallback (std::function<void (int)> f) const  { return withMember (*this, &Options::onThreadStop, std::move (f)); }
+
+        int numThreads = 0;
+        size_t threadStackSize = 0;
+        Thread::Priority priority = Thread::Priority::normal;
+        Optional<Thread::RealtimeOptions> realtimeOptions;
+        bool performanceCoresOnly = false;
+        std::function<void (int)> onThreadStart, onThreadStop;
+    };
+
+    /** Creates a pool using a set of Options. */
+    explicit WorkStealingThreadPool (const Options& options);
+
+    /** Destructor.
+        This will wait for any tasks that are still queued to be run before returning.
+    */
+    ~WorkStealingThreadPool();
+
+    //==============================================================================
+    /** Returns the number of worker threads in the pool. */
+    int getNumThreads() const noexcept;
+
+    /** Adds a task to be run by one of the worker threads.
+
+        If this is called from inside a task that's running on one of the pool's
+        threads, the new task is pushed onto that thread's own deque, which is very
+        cheap. Tasks added from other threads are shared out between the workers.
+    */
+    void addTask (std::function<void()> task);
+
+    //==============================================================================
+    /**
+        A set of tasks which can be waited on as a group, and which can schedule
+        continuations to run once the tasks have finished.
+
+        @code
+        WorkStealingThreadPool::TaskGroup group (pool);
+
+        for (auto& file : files)
+            group.run ([&file] { decode (file); });
+
+        group.then ([] { DBG ("All files decoded"); });
+        group.wait();
+        @endcode
+    */
+    class JUCE_API  TaskGroup
+    {
+    public:
+        /** Creates an empty group which will run its tasks on the given pool. */
+        explicit TaskGroup (WorkStealingThreadPool& pool);
+
+        /** Destructor. This will wait for any tasks in the group to finish. */
+        ~TaskGroup();
+
+        /** Adds a task to the group. */
+        void run (std::function<void()> task);
+
+        /** Schedules a continuation which will be run on the pool once all the tasks
+            that are currently in the group have finished.
+            If there aren't any tasks in the group, the continuation is scheduled
+            straight away.
+        */
+        void then (std::function<void()> continuation);
+
+        /** Waits until all the tasks and continuations in the group have finished.
+
+            Rather than just blocking, the calling thread helps out by running any
+            tasks that are waiting in the pool, so it's safe to call this from inside
+            a task that's running on the pool.
+        */
+        void wait();
+
+        /** Returns true if all the tasks and continuations in the group have finished. */
+        bool isFinished() const noexcept;
+
+    private:
+        void taskFinished();
+
+        WorkStealingThreadPool& owner;
+        std::atomic<int> numUnfinishedTasks { 0 }, numUnfinishedContinuations { 0 };
+        std::mutex continuationMutex;
+        std::vector<std::function<void()>> pendingContinuations;
+
+        JUCE_DECLARE_NON_COPYABLE (TaskGroup)
+    };
+
+    //==============================================================================
+    /** Calls a function for every index in the range [begin, end), spreading the
+        calls across the pool's threads, and returns once they've all finished.
+
+        The range is split recursively, so idle threads can steal large chunks of
+        work rather than lots of individual indices.
+
+        @param begin        the first index to process
+        @param end          one past the last index to process
+        @param function     a function taking an int, which will be called for each index
+        @param grainSize    the smallest number of indices that will be handed to one
+                            task. If this is zero or less, a suitable value is chosen
+                            based on the number of threads.
+    */
+    template <typename Function>
+    void parallelFor (int begin, int end, Function&& function, int grainSize = 0)
+    {
+        if (end <= begin)
+            return;
+
+        if (grainSize <= 0)
+            grainSize = jmax (1, (end - begin) / (getNumThreads() * 8 + 1));
+
+        TaskGroup group (*this);
+        splitRange (group, begin, end, grainSize, function);
+        group.wait();
+    }
+
+    /** Maps each index in the range [begin, end) to a value, and combines all the
+        values using a reduction function, spreading the work across the pool's threads.
+
+        Each chunk of the range is reduced separately, and the partial results are then
+        combined in order, so the reduction function must be associative but needn't
+        be commutative.
+
+        @param begin        the first index to process
+        @param end          one past the last index to process
+        @param identity     the value to start each reduction with
+        @param map          a function taking an int and returning a value of type Result
+        @param reduce       a function which combines two Result values into one
+        @param grainSize    the number of indices in each chunk, or zero or less to choose
+                            a suitable value automatically
+    */
+    template <typename Result, typename MapFunction, typename ReduceFunction>
+    Result parallelReduce (int begin, int end, Result identity,
+                           MapFunction&& map, ReduceFunction&& reduce, int grainSize = 0)
+    {
+        if (end <= begin)
+            return identity;
+
+        if (grainSize <= 0)
+            grainSize = jmax (1, (end - begin) / (getNumThreads() * 8 + 1));
+
+        const auto numChunks = (end - begin + grainSize - 1) / grainSize;
+        std::vector<Result> partialResults ((size_t) numChunks, identity);
+
+        parallelFor (0, numChunks, [&] (int chunk)
+        {
+            const auto chunkStart = begin + chunk * grainSize;
+            const auto chunkEnd = jmin (end, chunkStart + grainSize);
+            auto result = identity;
+
+            for (auto i = chunkStart; i < chunkEnd; ++i)
+                result = reduce (result, map (i));
+
+            partialResults[(size_t) chunk] = std::move (result);
+        }, 1);
+
+        auto result = identity;
+
+        for (auto& partial : partialResults)
+            result = reduce (result, partial);
+
+        return result;
+    }
+
+    /** Sorts a range of elements, spreading the work across the pool's threads.
+
+        The range is split in half recursively, each piece is sorted as a separate
+        task, and the sorted pieces are then merged back together. Because the
+        comparison function is called from several threads at once, it mustn't
+        modify any shared state.
+
+        @param begin                            an iterator to the first element to sort
+        @param end                              an iterator just past the last element to sort
+        @param lessThan                         a function taking two elements and returning true
+                                                if the first should be placed before the second
+        @param retainOrderOfEquivalentItems     if true, elements which compare as equal will keep
+                                                their original order
+        @param grainSize                        the largest number of elements that will be sorted
+                                                by a single task, or zero or less to choose a
+                                                suitable value automatically
+    */
+    template <typename RandomAccessIterator, typename LessThan>
+    void parallelSort (RandomAccessIterator begin, RandomAccessIterator end, LessThan&& lessThan,
+                       bool retainOrderOfEquivalentItems = false, int grainSize = 0)
+    {
+        const auto numElements = (int) std::distance (begin, end);
+
+        if (numElements < 2)
+            return;
+
+        if (grainSize <= 0)
+            grainSize = jmax (2048, numElements / (getNumThreads() * 4 + 1));
+
+        sortRange (begin, end, lessThan, retainOrderOfEquivalentItems, grainSize);
+    }
+
+private:
+    //==============================================================================
+    struct Task;
+    class TaskDeque;
+    class Worker;
+
+    template <typename Function>
+    void splitRange (TaskGroup& group, int begin, int end, int grainSize, Function& function)
+    {
+        while (end - begin > grainSize)
+        {
+            const auto middle = begin + (end - begin) / 2;
+            const auto upperEnd = end;
+
+            group.run ([this, &group, middle, upperEnd, grainSize, &function]
+            {
+                splitRange (group, middle, upperEnd, grainSize, function);
+            });
+
+            end = middle;
+        }
+
+        for (auto i = begin; i < end; ++i)
+            function (i);
+    }
+
+    template <typename RandomAccessIterator, typename LessThan>
+    void sortRange (RandomAccessIterator begin, RandomAccessIterator end, LessThan& lessThan,
+                    bool retainOrder, int grainSize)
+    {
+        const auto numElements = (int) std::distance (begin, end);
+
+        if (numElements <= grainSize)
+        {
+            if (retainOrder)
+                std::stable_sort (begin, end, lessThan);
+            else
+                std::sort (begin, end, lessThan);
+
+            return;
+        }
+
+        const auto middle = begin + numElements / 2;
+
+        {
+            TaskGroup group (*this);
+            group.run ([this, middle, end, &lessThan, retainOrder, grainSize]
+            {
+                sortRange (middle, end, lessThan, retainOrder, grainSize);
+            });
+
+            sortRange (begin, middle, lessThan, retainOrder, grainSize);
+            group.wait();
+        }
+
+        std::inplace_merge (begin, middle, end, lessThan);
+    }
+
+    void addTask (Task*);
+    bool runNextTask (Worker*);
+    Worker* getCurrentWorker() const noexcept;
+    Task* popInjectedTask();
+    void wakeSleepingWorker();
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::function<void (int)> onThreadStart, onThreadStop;
+    CriticalSection injectedTasksLock;
+    std::deque<Task*> injectedTasks;
+    std::atomic<int> numInjectedTasks { 0 }, numSleepingWorkers { 0 };
+    std::atomic<uint32> nextWorkerToWake { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkStealingThreadPool)
+};
+
+} // namespace juce
@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TraceRecorder::Event
+{
+    enum class Type : uint8 { zone, counter, instant };
+
+    const char* name;
+    int64 startTicks, endTicks, id;
+    double value;
+    Type type;
+};
+
+struct TraceRecorder::ThreadBuffer
+{
+    explicit ThreadBuffer (int capacityToUse)
+        : events ((size_t) capacityToUse), capacity (capacityToUse)
+    {
+        if (auto* thread = Thread::getCurrentThread())
+            threadName = thread->getThreadName();
+    }
+
+    HeapBlock<Event> events;
+    const int capacity;
+    std::atomic<int> numEvents { 0 }, numDropped { 0 };
+    std::atomic<bool> threadHasExited { false };
+    String threadName;
+};
+
+//==============================================================================
+/*  Owns the buffers of all the threads that have recorded anything. A buffer stays
+    alive after its thread exits, so that its events can still be written out, and is
+    only deleted by clear().
+*/
+class TraceRecorder::Registry
+{
+public:
+    static Registry& getInstance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadBuffer* getBufferForThisThread()
+    {
+        thread_local ThreadLink link;
+
+        if (link.buffer == nullptr)
+        {
+            const std::scoped_lock sl (lock);
+            buffers.push_back (std::make_unique<ThreadBuffer> (eventsPerThread));
+            link.buffer = buffers.back().get();
+        }
+
+        return link.buffer;
+    }
+
+    void setEventsPerThread (int numEvents)
+    {
+        const std::scoped_lock sl (lock);
+        eventsPerThread = jmax (16, numEvents);
+    }
+
+    void clear()
+    {
+        const std::scoped_lock sl (lock);
+
+        // Threads that are still running keep their buffers, as they may be about to use them
+        buffers.erase (std::remove_if (buffers.begin(), buffers.end(),
+                                       [] (const auto& b) { return b->threadHasExited.load(); }),
+                       buffers.end());
+
+        for (auto& b : buffers)
+        {
+            b->numEvents = 0;
+            b->numDropped = 0;
+        }
+    }
+
+    template <typename Fn>
+    void forEachBuffer (Fn&& fn)
+    {
+        const std::scoped_lock sl (lock);
+
+        for (auto& b : buffers)
+            fn (*b);
+    }
+
+private:
+    struct ThreadLink
+    {
+        ~ThreadLink()
+        {
+            if (buffer != nullptr)
+                buffer->threadHasExited = true;
+        }
+
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    std::mutex lock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    int eventsPerThread = 65536;
+};
+
+//==============================================================================
+std::atomic<bool> TraceRecorder::recording { false };
+
+void TraceRecorder::start (int maxEventsPerThread)
+{
+    Registry::getInstance().setEventsPerThread (maxEventsPerThread);
+    recording = true;
+}
+
+void TraceRecorder::stop()
+{
+    recording = false;
+}
+
+void TraceRecorder::clear()
+{
+    // Events can't be thrown away while they're being recorded!
+    jassert (! isRecording());
+
+    Registry::getInstance().clear();
+}
+
+void TraceRecorder::addEvent (const Event& event) noexcept
+{
+    auto& buffer = *Registry::getInstance().getBufferForThisThread();
+    const auto index = buffer.numEvents.load (std::memory_order_relaxed);
+
+    if (index >= buffer.capacity)
+    {
+        buffer.numDropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[index] = event;
+    buffer.numEvents.store (index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::addZone (const char* name, int64 startTicks, int64 endTicks, int64 id) noexcept
+{
+    if (isRecording())
+        addEvent ({ name, startTicks, endTicks, id, 0.0, Event::Type::zone });
+}
+
+void TraceRecorder::addCounter (const char* name, double value) noexcept
+{
+    if (isRecording())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, now, now, -1, value, Event::Type::counter });
+    }
+}
+
+void TraceRecorder::addInstant (const char* name) noexcept
+{
+    if (isRecording())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, now, now, -1, 0.0, Event::Type::instant });
+    }
+}
+
+//==============================================================================
+int TraceRecorder::getNumEvents()
+{
+    int total = 0;
+    Registry::getInstance().forEachBuffer ([&] (ThreadBuffer& b) { total += b.numEvents.load (std::memory_order_acquire); });
+    return total;
+}
+
+int TraceRecorder::getNumDroppedEvents()
+{
+    int total = 0;
+    Registry::getInstance().forEachBuffer ([&] (ThreadBuffer& b) { total += b.numDropped.load(); });
+    return total;
+}
+
+void TraceRecorder::writeChromeTrace (OutputStream& out)
+{
+    const auto ticksToMicroseconds = 1.0e6 / (double) Time::getHighResolutionTicksPerSecond();
+    auto firstTicks = std::numeric_limits<int64>::max();
+
+    Registry::getInstance().forEachBuffer ([&] (ThreadBuffer& b)
+    {
+        for (int i = 0, n = b.numEvents.load (std::memory_order_acquire); i < n; ++i)
+            firstTicks = jmin (firstTicks, b.events[i].startTicks);
+    });
+
+    const auto toMicroseconds = [&] (int64 ticks) { return String ((double) (ticks - firstTicks) * ticksToMicroseconds, 3); };
+    const auto quoted = [] (const char* text) { return "\"" + JSON::escapeString (text) + "\""; };
+
+    out << "{\"traceEvents\":[";
+
+    int threadIndex = 0;
+    auto isFirst = true;
+
+    const auto startEvent = [&]
+    {
+        out << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+    };
+
+    Registry::getInstance().forEachBuffer ([&] (ThreadBuffer& b)
+    {
+        const auto numEvents = b.numEvents.load (std::memory_order_acquire);
+        const auto tid = String (++threadIndex);
+
+        if (numEvents == 0)
+            return;
+
+        const auto threadName = b.threadName.isNotEmpty() ? b.threadName : "Thread " + tid;
+
+        startEvent();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"args\":{\"name\":" << quoted (threadName.toRawUTF8()) << "}}";
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto& e = b.events[i];
+
+            startEvent();
+            out << "{\"name\":" << quoted (e.name) << ",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << toMicroseconds (e.startTicks);
+
+            switch (e.type)
+            {
+                case Event::Type::zone:
+                    out << ",\"ph\":\"X\",\"dur\":" << String ((double) (e.endTicks - e.startTicks) * ticksToMicroseconds, 3);
+
+                    if (e.id >= 0)
+                        out << ",\"args\":{\"id\":" << e.id << "}";
+
+                    break;
+
+                case Event::Type::counter:
+                    out << ",\"ph\":\"C\",\"args\":{\"value\":" << e.value << "}";
+                    break;
+
+                case Event::Type::instant:
+                    out << ",\"ph\":\"i\",\"s\":\"t\"";
+                    break;
+            }
+
+            out << "}";
+        }
+    });
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool TraceRecorder::writeChromeTrace (const File& file)
+{
+    FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+    writeChromeTrace (out);
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TraceRecorderTests  : public UnitTest
+{
+public:
+    TraceRecorderTests()
+        : UnitTest ("TraceRecorder", UnitTestCategories::time)
+    {}
+
+    void runTest() override
+    {
+        TraceRecorder::stop();
+        TraceRecorder::clear();
+
+        beginTest ("Nothing is recorded while stopped");
+        {
+            { TraceZone zone ("stopped"); }
+            TraceRecorder::addCounter ("stopped", 1.0);
+            expectEquals (TraceRecorder::getNumEvents(), 0);
+        }
+
+        beginTest ("Recording from several threads");
+        {
+            TraceRecorder::start (1000);
+
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back ([]
+                {
+                    for (int i = 0; i < 100; ++i)
+                    {
+                        TraceZone zone ("work", i);
+                        TraceRecorder::addCounter ("count", i);
+                    }
+
+                    TraceRecorder::addInstant ("done");
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            TraceRecorder::stop();
+            expectEquals (TraceRecorder::getNumEvents(), 4 * 201);
+            expectEquals (TraceRecorder::getNumDroppedEvents(), 0);
+        }
+
+        beginTest ("Chrome trace export");
+        {
+            MemoryOutputStream out;
+            TraceRecorder::writeChromeTrace (out);
+
+            const auto parsed = JSON::parse (out.toString());
+            const auto* events = parsed["traceEvents"].getArray();
+            expect (events != nullptr);
+
+            int numZones = 0, numCounters = 0, numInstants = 0, numThreadNames = 0;
+
+            for (auto& e : *events)
+            {
+                const auto phase = e["ph"].toString();
+
+                if (phase == "X")
+                {
+                    ++numZones;
+                    expectEquals (e["name"].toString(), String ("work"));
+                    expect ((double) e["dur"] >= 0.0);
+                }
+
+                numCounters    += phase == "C" ? 1 : 0;
+                numInstants    += phase == "i" ? 1 : 0;
+                numThreadNames += phase == "M" ? 1 : 0;
+            }
+
+            expectEquals (numZones, 400);
+            expectEquals (numCounters, 400);
+            expectEquals (numInstants, 4);
+            expectEquals (numThreadNames, 4);
+        }
+
+        beginTest ("Full buffers drop events");
+        {
+            TraceRecorder::clear();
+            TraceRecorder::start (16);
+
+            std::thread ([]
+            {
+                for (int i = 0; i < 20; ++i)
+                    TraceRecorder::addInstant ("event");
+            }).join();
+
+            TraceRecorder::stop();
+            expectEquals (TraceRecorder::getNumEvents(), 16);
+            expectEquals (TraceRecorder::getNumDroppedEvents(), 4);
+
+            TraceRecorder::clear();
+            expectEquals (TraceRecorder::getNumEvents(), 0);
+        }
+    }
+};
+
+static TraceRecorderTests traceRecorderTests;
+
+#endif
+
+} // namespace juce
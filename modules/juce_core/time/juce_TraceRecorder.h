@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records a timeline of zones, counters and events from all threads, which can be
+    saved in the Chrome trace format.
+
+    Each thread records into its own fixed-size buffer, so recording never waits for
+    a lock or for other threads. The buffer is only allocated the first time a thread
+    records something, which takes a lock once. After that, adding an event costs about
+    the same as reading the high-resolution clock. When a thread's buffer is full, any
+    further events from it are dropped until clear() is called. When recording is
+    stopped, each call just checks a flag.
+
+    Rather than calling this class directly, you'll usually use the JUCE_TRACE_ZONE,
+    JUCE_TRACE_COUNTER and JUCE_TRACE_INSTANT macros. They compile to nothing unless
+    JUCE_ENABLE_TRACING is set. JUCE uses them itself around Component painting,
+    message dispatch, Timer callbacks and the nodes of an AudioProcessorGraph.
+
+    The names that are passed in must be string literals, or strings that stay alive
+    for as long as the trace does, because only the pointers are stored.
+
+    A trace written with writeChromeTrace() can be opened in Perfetto (ui.perfetto.dev)
+    or chrome://tracing, and converted for Tracy with its import-chrome tool.
+
+    @code
+    TraceRecorder::start();
+
+    {
+        JUCE_TRACE_ZONE ("loadPreset");
+        ...
+    }
+
+    TraceRecorder::stop();
+    TraceRecorder::writeChromeTrace (File ("~/trace.json"));
+    @endcode
+
+    @see TraceZone, PerformanceCounter
+
+    @tags{Core}
+*/
+class JUCE_API  TraceRecorder
+{
+public:
+    //==============================================================================
+    /** Starts recording.
+
+        @param maxEventsPerThread   the number of events that each thread's buffer can
+                                    hold. This only affects threads that haven't recorded
+                                    anything yet, as a thread keeps its buffer until it exits.
+    */
+    static void start (int maxEventsPerThread = 65536);
+
+    /** Stops recording. The events that were recorded are kept until clear() is called. */
+    static void stop();
+
+    /** Returns true if events are being recorded. */
+    static bool isRecording() noexcept          { return recording.load (std::memory_order_relaxed); }
+
+    /** Throws away all the events that have been recorded.
+        This should only be called while recording is stopped.
+    */
+    static void clear();
+
+    //==============================================================================
+    /** Records a zone that began and ended at the given times, as returned by
+        Time::getHighResolutionTicks(). If the id is zero or greater, it's saved with the zone.
+    */
+    static void addZone (const char* name, int64 startTicks, int64 endTicks, int64 id = -1) noexcept;
+
+    /** Records the value of a counter at the current time. */
+    static void addCounter (const char* name, double value) noexcept;
+
+    /** Records an event that happened at the current time. */
+    static void addInstant (const char* name) noexcept;
+
+    //==============================================================================
+    /** Returns the number of events that have been recorded. */
+    static int getNumEvents();
+
+    /** Returns the number of events that were dropped because a thread's buffer was full. */
+    static int getNumDroppedEvents();
+
+    /** Writes everything that has been recorded as a JSON trace in the Chrome trace
+        event format.
+    */
+    static void writeChromeTrace (OutputStream&);
+
+    /** Writes everything that has been recorded to a JSON file in the Chrome trace
+        event format, replacing the file if it already exists.
+        @returns false if the file couldn't be written
+    */
+    static bool writeChromeTrace (const File&);
+
+private:
+    //==============================================================================
+    struct Event;
+    struct ThreadBuffer;
+    class Registry;
+
+    static void addEvent (const Event&) noexcept;
+
+    static std::atomic<bool> recording;
+
+    TraceRecorder() = delete;
+};
+
+//==============================================================================
+/**
+    Records the time between its construction and destruction as a zone on the
+    TraceRecorder's timeline, if the recorder is running.
+
+    Rather than creating one of these directly, use the JUCE_TRACE_ZONE macro, which
+    compiles to nothing unless JUCE_ENABLE_TRACING is set.
+
+    @see TraceRecorder
+
+    @tags{Core}
+*/
+class JUCE_API  TraceZone
+{
+public:
+    /** Starts a zone. The name must outlive the trace, so it's usually a string literal. */
+    explicit TraceZone (const char* zoneName, int64 zoneId = -1) noexcept
+        : name (zoneName),
+          id (zoneId),
+          startTicks (TraceRecorder::isRecording() ? Time::getHighResolutionTicks() : 0)
+    {
+    }
+
+    /** Ends the zone. */
+    ~TraceZone()
+    {
+        if (startTicks != 0)
+            TraceRecorder::addZone (name, startTicks, Time::getHighResolutionTicks(), id);
+    }
+
+private:
+    const char* name;
+    int64 id, startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE (TraceZone)
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Records the rest of the enclosing scope as a zone on the TraceRecorder's timeline.
+     This compiles to nothing unless JUCE_ENABLE_TRACING is set.
+     @see TraceRecorder, TraceZone
+ */
+ #define JUCE_TRACE_ZONE(name)                  const juce::TraceZone JUCE_JOIN_MACRO (juceTraceZone_, __LINE__) (name)
+
+ /** Like JUCE_TRACE_ZONE, but also records a number that identifies the object involved. */
+ #define JUCE_TRACE_ZONE_WITH_ID(name, id)      const juce::TraceZone JUCE_JOIN_MACRO (juceTraceZone_, __LINE__) (name, (juce::int64) (id))
+
+ /** Records the value of a counter on the TraceRecorder's timeline.
+     This compiles to nothing unless JUCE_ENABLE_TRACING is set.
+ */
+ #define JUCE_TRACE_COUNTER(name, value)        juce::TraceRecorder::addCounter (name, (double) (value))
+
+ /** Records an instantaneous event on the TraceRecorder's timeline.
+     This compiles to nothing unless JUCE_ENABLE_TRACING is set.
+ */
+ #define JUCE_TRACE_INSTANT(name)               juce::TraceRecorder::addInstant (name)
+#else
+ #define JUCE_TRACE_ZONE(name)
+ #define JUCE_TRACE_ZONE_WITH_ID(name, id)
+ #define JUCE_TRACE_COUNTER(name, value)
+ #define JUCE_TRACE_INSTANT(name)
+#endif
+
+} // namespace juce
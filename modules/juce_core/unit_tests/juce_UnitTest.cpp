@@ -113,10 +113,55 @@ Random UnitTest::getRandom() const
     return runner->randomForTest;
 }
 
+//==============================================================================
+/*  Runs tests on one of the worker threads, collecting their results and log messages
+    and then handing them over to the owner when each test finishes.
+*/
+class UnitTestRunner::Worker  : public UnitTestRunner
+{
+public:
+    explicit Worker (UnitTestRunner& ownerToUse)  : owner (ownerToUse)
+    {
+        assertOnFailure = owner.assertOnFailure;
+        logPasses = owner.logPasses;
+        randomForTest = owner.randomForTest;
+    }
+
+    void run (UnitTest& test)
+    {
+        runSingleTest (test);
+        endTest();
+
+        const ScopedLock sl (owner.workerLock);
+
+        for (auto& message : messages)
+            owner.logMessage (message);
+
+        messages.clear();
+
+        while (! results.isEmpty())
+            owner.results.add (results.removeAndReturn (0));
+
+        owner.resultsUpdated();
+    }
+
+private:
+    void logMessage (const String& message) override    { messages.add (message); }
+    bool shouldAbortTests() override                     { return owner.abortRequested; }
+
+    UnitTestRunner& owner;
+    StringArray messages;
+};
+
 //==============================================================================
 UnitTestRunner::UnitTestRunner() {}
 UnitTestRunner::~UnitTestRunner() {}
 
+void UnitTestRunner::setNumThreads (int numThreadsToUse) noexcept
+{
+    numThreads = jmax (1, numThreadsToUse);
+}
+
 void UnitTestRunner::setAssertOnFailure (bool shouldAssert) noexcept
 {
     assertOnFailure = shouldAssert;
@@ -152,26 +197,68 @@ void UnitTestRunner::runTests (const Array<UnitTest*>& tests, int64 randomSeed)
     randomForTest = Random (randomSeed);
     logMessage ("Random seed: 0x" + String::toHexString (randomSeed));
 
+    abortRequested = false;
+    Array<UnitTest*> concurrentTests;
+
     for (auto* t : tests)
     {
         if (shouldAbortTests())
             break;
 
-       #if JUCE_EXCEPTIONS_DISABLED
-        t->performTest (this);
-       #else
-        try
-        {
-            t->performTest (this);
-        }
-        catch (...)
-        {
-            addFail ("An unhandled exception was thrown!");
-        }
-       #endif
+        if (numThreads > 1 && t->getIsolation() == UnitTest::Isolation::none)
+            concurrentTests.add (t);
+        else
+            runSingleTest (*t);
     }
 
     endTest();
+
+    if (! concurrentTests.isEmpty() && ! shouldAbortTests())
+        runTestsConcurrently (concurrentTests);
+}
+
+void UnitTestRunner::runSingleTest (UnitTest& test)
+{
+   #if JUCE_EXCEPTIONS_DISABLED
+    test.performTest (this);
+   #else
+    try
+    {
+        test.performTest (this);
+    }
+    catch (...)
+    {
+        addFail ("An unhandled exception was thrown!");
+    }
+   #endif
+}
+
+void UnitTestRunner::runTestsConcurrently (const Array<UnitTest*>& tests)
+{
+    const auto numWorkers = jmin (numThreads, tests.size());
+    std::atomic<int> nextTest { 0 }, numActiveWorkers { numWorkers };
+    WaitableEvent finished;
+
+    ThreadPool pool (numWorkers);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        pool.addJob ([&]
+        {
+            Worker worker (*this);
+
+            for (int index; ! abortRequested && (index = nextTest++) < tests.size();)
+                worker.run (*tests.getUnchecked (index));
+
+            if (--numActiveWorkers == 0)
+                finished.signal();
+        });
+    }
+
+    // shouldAbortTests() is only ever called on this thread, and its result passed on to the workers
+    while (! finished.wait (10))
+        if (shouldAbortTests())
+            abortRequested = true;
 }
 
 void UnitTestRunner::runAllTests (int64 randomSeed)
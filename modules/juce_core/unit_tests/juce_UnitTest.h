@@ -82,6 +82,30 @@ public:
     /** Returns the category of the test. */
     const String& getCategory() const noexcept   { return category; }
 
+    //==============================================================================
+    /** Describes how a test may be scheduled when a UnitTestRunner runs tests on
+        several threads.
+
+        @see setIsolation, UnitTestRunner::setNumThreads
+    */
+    enum class Isolation
+    {
+        none,           /**< The test may run on any thread, at the same time as other tests. */
+        exclusive,      /**< The test may run on any thread, but not at the same time as any other test. */
+        messageThread   /**< The test must run on the thread that called UnitTestRunner::runTests(),
+                             and not at the same time as any other test. */
+    };
+
+    /** Sets how this test may be scheduled when tests are run on several threads.
+
+        Tests that use the message thread, or that change global state, should call this
+        from their constructor. The default is Isolation::none.
+    */
+    void setIsolation (Isolation newIsolation) noexcept     { isolation = newIsolation; }
+
+    /** Returns how this test may be scheduled when tests are run on several threads. */
+    Isolation getIsolation() const noexcept                 { return isolation; }
+
     /** Runs the test, using the specified UnitTestRunner.
         You shouldn't need to call this method directly - use
         UnitTestRunner::runTests() instead.
@@ -302,6 +326,7 @@ private:
     //==============================================================================
     const String name, category;
     UnitTestRunner* runner = nullptr;
+    Isolation isolation = Isolation::none;
 
     JUCE_DECLARE_NON_COPYABLE (UnitTest)
 };
@@ -357,6 +382,25 @@ public:
     */
     void runTestsInCategory (const String& category, int64 randomSeed = 0);
 
+    /** Sets the number of threads that runTests() uses.
+
+        By default tests are run one after another on the calling thread. With more than
+        one thread, the tests that need isolation (see UnitTest::setIsolation()) are run
+        on the calling thread first, one at a time, and the rest are then shared between
+        a pool of worker threads.
+
+        When running on several threads, the results are added in the order that the tests
+        finish, and the log messages from each test are passed to logMessage() in one block
+        when that test finishes. logMessage() and resultsUpdated() may then be called from
+        the worker threads, although never concurrently.
+    */
+    void setNumThreads (int numThreadsToUse) noexcept;
+
+    /** Returns the number of threads that runTests() uses.
+        @see setNumThreads
+    */
+    int getNumThreads() const noexcept                      { return numThreads; }
+
     /** Sets a flag to indicate whether an assertion should be triggered if a test fails.
         This is true by default.
     */
@@ -434,12 +478,19 @@ private:
     //==============================================================================
     friend class UnitTest;
 
+    class Worker;
+
     UnitTest* currentTest = nullptr;
     String currentSubCategory;
     OwnedArray<TestResult, CriticalSection> results;
     bool assertOnFailure = true, logPasses = false;
     Random randomForTest;
+    int numThreads = 1;
+    std::atomic<bool> abortRequested { false };
+    CriticalSection workerLock;
 
+    void runSingleTest (UnitTest&);
+    void runTestsConcurrently (const Array<UnitTest*>&);
     void beginNewTest (UnitTest* test, const String& subCategory);
     void endTest();
 
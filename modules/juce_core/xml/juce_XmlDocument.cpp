@@ -68,6 +68,11 @@ void XmlDocument::setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept
     ignoreEmptyTextElements = shouldBeIgnored;
 }
 
+void XmlDocument::setLazyParsingEnabled (bool shouldParseLazily) noexcept
+{
+    parseLazily = shouldParseLazily;
+}
+
 namespace XmlIdentifierChars
 {
     static bool isIdentifierCharSlow (juce_wchar c) noexcept
@@ -115,13 +120,15 @@ std::unique_ptr<XmlElement> XmlDocument::getDocumentElement (const bool onlyRead
 
         if (in != nullptr)
         {
-            MemoryOutputStream data;
+            auto block = std::make_shared<MemoryBlock>();
+            MemoryOutputStream data (*block, false);
             data.writeFromInputStream (*in, onlyReadOuterDocumentElement ? 8192 : -1);
 
            #if JUCE_STRING_UTF_TYPE == 8
             if (data.getDataSize() > 2)
             {
                 data.writeByte (0);
+                data.flush(); // (this sets the block to its final size, so the data won't move after this)
                 auto* text = static_cast<const char*> (data.getData());
 
                 if (CharPointer_UTF16::isByteOrderMarkBigEndian (text)
@@ -134,6 +141,9 @@ std::unique_ptr<XmlElement> XmlDocument::getDocumentElement (const bool onlyRead
                     if (CharPointer_UTF8::isByteOrderMark (text))
                         text += 3;
 
+                    if (parseLazily)
+                        lazilyParsedText = block;
+
                     // parse the input buffer directly to avoid copying it all to a string..
                     return parseDocumentElement (String::CharPointerType (text), onlyReadOuterDocumentElement);
                 }
@@ -144,6 +154,9 @@ std::unique_ptr<XmlElement> XmlDocument::getDocumentElement (const bool onlyRead
         }
     }
 
+    if (parseLazily)
+        lazilyParsedText = std::make_shared<const String> (originalText);
+
     return parseDocumentElement (originalText.getCharPointer(), onlyReadOuterDocumentElement);
 }
 
@@ -215,13 +228,19 @@ std::unique_ptr<XmlElement> XmlDocument::parseDocumentElement (String::CharPoint
     }
     else
     {
+        // entities defined in a DTD would need to be expanded later on, so don't defer anything
+        if (dtdText.isNotEmpty())
+            lazilyParsedText.reset();
+
         lastError.clear();
         std::unique_ptr<XmlElement> result (readNextElement (! onlyReadOuterDocumentElement));
+        lazilyParsedText.reset();
 
         if (! errorOccurred)
             return result;
     }
 
+    lazilyParsedText.reset();
     return {};
 }
 
@@ -438,7 +457,12 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
                 ++input;
 
                 if (alsoParseSubElements)
-                    readChildElements (*node);
+                {
+                    if (lazilyParsedText != nullptr)
+                        deferChildElements (*node);
+                    else
+                        readChildElements (*node);
+                }
 
                 break;
             }
@@ -600,6 +624,7 @@ void XmlDocument::readChildElements (XmlElement& parent)
                     {
                         auto oldInput = input;
                         auto oldOutOfData = outOfData;
+                        auto oldLazilyParsedText = std::exchange (lazilyParsedText, nullptr);
 
                         input = entity.getCharPointer();
                         outOfData = false;
@@ -609,6 +634,7 @@ void XmlDocument::readChildElements (XmlElement& parent)
 
                         input = oldInput;
                         outOfData = oldOutOfData;
+                        lazilyParsedText = std::move (oldLazilyParsedText);
                     }
                     else
                     {
@@ -652,6 +678,135 @@ void XmlDocument::readChildElements (XmlElement& parent)
     }
 }
 
+//==============================================================================
+struct XmlElement::UnparsedChildren
+{
+    std::shared_ptr<const void> text;
+    String::CharPointerType start;
+    bool ignoreEmptyTextElements;
+};
+
+void XmlDocument::deferChildElements (XmlElement& parent)
+{
+    auto start = input;
+
+    if (skipChildElements() && ! (*start == '<' && start[1] == '/'))
+        parent.unparsedChildren.reset (new XmlElement::UnparsedChildren { lazilyParsedText, start, ignoreEmptyTextElements });
+}
+
+// Moves past the end tag of the current element, without creating anything
+bool XmlDocument::skipChildElements()
+{
+    auto skipPast = [this] (const char* terminator)
+    {
+        auto index = input.indexOf (CharPointer_ASCII (terminator));
+
+        if (index < 0)
+            return false;
+
+        input += index + (int) strlen (terminator);
+        return true;
+    };
+
+    for (int depth = 1;;)
+    {
+        auto c = *input;
+
+        if (c == 0)
+            break;
+
+        if (c != '<')
+        {
+            ++input;
+            continue;
+        }
+
+        auto c1 = input[1];
+
+        if (c1 == '/')
+        {
+            if (! skipPast (">"))
+                break;
+
+            if (--depth == 0)
+                return true;
+        }
+        else if (c1 == '!' && input[2] == '-' && input[3] == '-')
+        {
+            input += 4;
+
+            if (! skipPast ("-->"))
+                break;
+        }
+        else if (c1 == '!' && CharacterFunctions::compareUpTo (input + 2, CharPointer_ASCII ("[CDATA["), 7) == 0)
+        {
+            input += 9;
+
+            if (! skipPast ("]]>"))
+                break;
+        }
+        else if (c1 == '?')
+        {
+            if (! skipPast ("?>"))
+                break;
+        }
+        else
+        {
+            // a start tag, which may contain quoted attribute values with '>' characters in them
+            juce_wchar quote = 0, previous = 0;
+
+            for (++input;; ++input)
+            {
+                auto tagChar = *input;
+
+                if (tagChar == 0)
+                    break;
+
+                if (quote != 0)
+                {
+                    if (tagChar == quote)
+                        quote = 0;
+                }
+                else if (tagChar == '"' || tagChar == '\'')
+                {
+                    quote = tagChar;
+                }
+                else if (tagChar == '>')
+                {
+                    ++input;
+                    break;
+                }
+
+                previous = tagChar;
+            }
+
+            if (previous != '/')
+                ++depth;
+        }
+    }
+
+    setLastError ("unmatched tags", false);
+    outOfData = true;
+    return false;
+}
+
+void XmlElement::parseUnparsedChildren() const noexcept
+{
+    const std::unique_ptr<UnparsedChildren> unparsed (std::move (unparsedChildren));
+
+    XmlDocument document (String {});
+    document.lazilyParsedText = unparsed->text;
+    document.ignoreEmptyTextElements = unparsed->ignoreEmptyTextElements;
+    document.input = unparsed->start;
+
+    document.readChildElements (const_cast<XmlElement&> (*this));
+
+    // The tags were checked when the document was loaded, so this means that something
+    // else inside this element was malformed, e.g. one of the attributes.
+    jassert (! document.errorOccurred);
+}
+
+//==============================================================================
 void XmlDocument::readEntity (String& result)
 {
     // skip over the ampersand
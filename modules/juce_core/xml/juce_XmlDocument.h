@@ -131,6 +131,22 @@ public:
     */
     void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept;
 
+    /** Enables a mode in which each element's children are only parsed when they're first needed.
+
+        When this is enabled, getDocumentElement() still checks that the tags in the document
+        match up, but it only creates the outer element. The children of each element are then
+        parsed the first time that anything asks for them. If you only need to look at a small
+        part of a large document, this is much quicker and needs far less memory, although the
+        text of the document is kept in memory for as long as any of its elements exist.
+
+        Because the parsing happens when the elements are used, you mustn't access them from
+        more than one thread at a time, even if you're only reading them. Documents that contain
+        a DTD are always parsed fully.
+
+        @see XmlPullParser
+    */
+    void setLazyParsingEnabled (bool shouldParseLazily) noexcept;
+
     //==============================================================================
     /** A handy static method that parses a file.
         This is a shortcut for creating an XmlDocument object and calling getDocumentElement() on it.
@@ -152,8 +168,11 @@ private:
     bool outOfData = false, errorOccurred = false;
     String lastError, dtdText;
     StringArray tokenisedDTD;
-    bool needToLoadDTD = false, ignoreEmptyTextElements = true;
+    bool needToLoadDTD = false, ignoreEmptyTextElements = true, parseLazily = false;
     std::unique_ptr<InputSource> inputSource;
+    std::shared_ptr<const void> lazilyParsedText;
+
+    friend class XmlElement;
 
     std::unique_ptr<XmlElement> parseDocumentElement (String::CharPointerType, bool outer);
     void setLastError (const String&, bool carryOn);
@@ -163,6 +182,8 @@ private:
     juce_wchar readNextChar() noexcept;
     XmlElement* readNextElement (bool alsoParseSubElements);
     void readChildElements (XmlElement&);
+    void deferChildElements (XmlElement&);
+    bool skipChildElements();
     void readQuotedString (String&);
     void readEntity (String&);
 
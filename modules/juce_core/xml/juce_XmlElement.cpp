@@ -130,7 +130,8 @@ XmlElement::XmlElement (XmlElement&& other) noexcept
     : nextListItem      (std::move (other.nextListItem)),
       firstChildElement (std::move (other.firstChildElement)),
       attributes        (std::move (other.attributes)),
-      tagName           (std::move (other.tagName))
+      tagName           (std::move (other.tagName)),
+      unparsedChildren  (std::move (other.unparsedChildren))
 {
 }
 
@@ -145,6 +146,7 @@ XmlElement& XmlElement::operator= (XmlElement&& other) noexcept
     firstChildElement = std::move (other.firstChildElement);
     attributes        = std::move (other.attributes);
     tagName           = std::move (other.tagName);
+    unparsedChildren  = std::move (other.unparsedChildren);
 
     return *this;
 }
@@ -152,6 +154,7 @@ XmlElement& XmlElement::operator= (XmlElement&& other) noexcept
 void XmlElement::copyChildrenAndAttributesFrom (const XmlElement& other)
 {
     jassert (firstChildElement.get() == nullptr);
+    other.ensureChildrenParsed();
     firstChildElement.addCopyOfList (other.firstChildElement);
 
     jassert (attributes.get() == nullptr);
@@ -288,6 +291,8 @@ void XmlElement::writeElementAsText (OutputStream& outputStream,
             }
         }
 
+        ensureChildrenParsed();
+
         if (auto* child = firstChildElement.get())
         {
             outputStream.writeByte ('>');
@@ -667,17 +672,20 @@ void XmlElement::removeAllAttributes() noexcept
 //==============================================================================
 int XmlElement::getNumChildElements() const noexcept
 {
+    ensureChildrenParsed();
     return firstChildElement.size();
 }
 
 XmlElement* XmlElement::getChildElement (const int index) const noexcept
 {
+    ensureChildrenParsed();
     return firstChildElement[index].get();
 }
 
 XmlElement* XmlElement::getChildByName (StringRef childName) const noexcept
 {
     jassert (! childName.isEmpty());
+    ensureChildrenParsed();
 
     for (auto* child = firstChildElement.get(); child != nullptr; child = child->nextListItem)
         if (child->hasTagName (childName))
@@ -689,6 +697,7 @@ XmlElement* XmlElement::getChildByName (StringRef childName) const noexcept
 XmlElement* XmlElement::getChildByAttribute (StringRef attributeName, StringRef attributeValue) const noexcept
 {
     jassert (! attributeName.isEmpty());
+    ensureChildrenParsed();
 
     for (auto* child = firstChildElement.get(); child != nullptr; child = child->nextListItem)
         if (child->compareAttribute (attributeName, attributeValue))
@@ -704,6 +713,7 @@ void XmlElement::addChildElement (XmlElement* const newNode) noexcept
         // The element being added must not be a child of another node!
         jassert (newNode->nextListItem == nullptr);
 
+        ensureChildrenParsed();
         firstChildElement.append (newNode);
     }
 }
@@ -715,6 +725,7 @@ void XmlElement::insertChildElement (XmlElement* const newNode, int indexToInser
         // The element being added must not be a child of another node!
         jassert (newNode->nextListItem == nullptr);
 
+        ensureChildrenParsed();
         firstChildElement.insertAtIndex (indexToInsertAt, newNode);
     }
 }
@@ -726,6 +737,7 @@ void XmlElement::prependChildElement (XmlElement* newNode) noexcept
         // The element being added must not be a child of another node!
         jassert (newNode->nextListItem == nullptr);
 
+        ensureChildrenParsed();
         firstChildElement.insertNext (newNode);
     }
 }
@@ -742,6 +754,8 @@ bool XmlElement::replaceChildElement (XmlElement* const currentChildElement,
 {
     if (newNode != nullptr)
     {
+        ensureChildrenParsed();
+
         if (auto* p = firstChildElement.findPointerTo (currentChildElement))
         {
             if (currentChildElement != newNode)
@@ -761,6 +775,7 @@ void XmlElement::removeChildElement (XmlElement* const childToRemove,
     {
         jassert (containsChildElement (childToRemove));
 
+        ensureChildrenParsed();
         firstChildElement.remove (childToRemove);
 
         if (shouldDeleteTheChild)
@@ -817,6 +832,9 @@ bool XmlElement::isEquivalentTo (const XmlElement* const other,
             }
         }
 
+        ensureChildrenParsed();
+        other->ensureChildrenParsed();
+
         auto* thisChild = firstChildElement.get();
         auto* otherChild = other->firstChildElement.get();
 
@@ -843,11 +861,14 @@ bool XmlElement::isEquivalentTo (const XmlElement* const other,
 
 void XmlElement::deleteAllChildElements() noexcept
 {
+    unparsedChildren.reset();
     firstChildElement.deleteAll();
 }
 
 void XmlElement::deleteAllChildElementsWithTagName (StringRef name) noexcept
 {
+    ensureChildrenParsed();
+
     for (auto* child = firstChildElement.get(); child != nullptr;)
     {
         auto* nextChild = child->nextListItem.get();
@@ -861,6 +882,7 @@ void XmlElement::deleteAllChildElementsWithTagName (StringRef name) noexcept
 
 bool XmlElement::containsChildElement (const XmlElement* const possibleChild) const noexcept
 {
+    ensureChildrenParsed();
     return firstChildElement.contains (possibleChild);
 }
 
@@ -869,6 +891,8 @@ XmlElement* XmlElement::findParentElementOf (const XmlElement* const elementToLo
     if (this == elementToLookFor || elementToLookFor == nullptr)
         return nullptr;
 
+    ensureChildrenParsed();
+
     for (auto* child = firstChildElement.get(); child != nullptr; child = child->nextListItem)
     {
         if (elementToLookFor == child)
@@ -883,6 +907,7 @@ XmlElement* XmlElement::findParentElementOf (const XmlElement* const elementToLo
 
 void XmlElement::getChildElementsAsArray (XmlElement** elems) const noexcept
 {
+    ensureChildrenParsed();
     firstChildElement.copyToArray (elems);
 }
 
@@ -978,6 +1003,8 @@ void XmlElement::addTextElement (const String& text)
 
 void XmlElement::deleteAllTextElements() noexcept
 {
+    ensureChildrenParsed();
+
     for (auto* child = firstChildElement.get(); child != nullptr;)
     {
         auto* next = child->nextListItem.get();
@@ -1018,7 +1045,7 @@ public:
             tests[0.0123] = "0.0123";
             tests[-3.7e-27] = "-3.7e-27";
             tests[1e+40] = "1.0e40";
-            tests[-12345678901234567.0] = "-1.234567890123457e16";
+            tests[-12345678901234567.0] = "-1.2345678901234568e16";
             tests[192000] = "192000.0";
             tests[1234567] = "1.234567e6";
             tests[0.00006] = "0.00006";
@@ -1030,6 +1057,40 @@ public:
                 expectEquals (element->getStringAttribute (number), test.second);
             }
         }
+
+        {
+            beginTest ("Lazy parsing");
+
+            const String xml ("<ROOT a=\"1\"><A x='>'><B/><!-- </A> --><![CDATA[</A>]]></A>"
+                              "<C>text &amp; more</C><D/><D><E y=\"2\"/></D></ROOT>");
+
+            XmlDocument lazyDocument (xml);
+            lazyDocument.setLazyParsingEnabled (true);
+            auto lazy = lazyDocument.getDocumentElement();
+            auto expected = parseXML (xml);
+
+            expect (lazy != nullptr && expected != nullptr);
+            expectEquals (lazy->getIntAttribute ("a"), 1);
+            expect (lazy->isEquivalentTo (expected.get(), false));
+            expectEquals (lazy->toString(), expected->toString());
+            expectEquals (lazy->getChildByName ("C")->getAllSubText(), String ("text & more"));
+
+            // modifying or copying an element that hasn't been parsed yet
+            XmlDocument lazyDocument2 (xml);
+            lazyDocument2.setLazyParsingEnabled (true);
+            auto lazy2 = lazyDocument2.getDocumentElement();
+
+            XmlElement copy (*lazy2);
+            lazy2->createNewChildElement ("F");
+            expectEquals (lazy2->getNumChildElements(), 5);
+            expect (lazy2->getChildElement (4)->hasTagName ("F"));
+            expect (copy.isEquivalentTo (expected.get(), false));
+
+            XmlDocument badDocument ("<ROOT><A><B></A></ROOT>");
+            badDocument.setLazyParsingEnabled (true);
+            expect (badDocument.getDocumentElement() == nullptr);
+            expect (badDocument.getLastParseError().isNotEmpty());
+        }
     }
 };
 
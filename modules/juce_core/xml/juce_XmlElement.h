@@ -348,7 +348,7 @@ public:
 
         @see getChildIterator
     */
-    XmlElement* getFirstChildElement() const noexcept       { return firstChildElement; }
+    XmlElement* getFirstChildElement() const noexcept       { ensureChildrenParsed(); return firstChildElement; }
 
     /** Returns the next of this element's siblings.
 
@@ -779,9 +779,15 @@ private:
     friend class LinkedListPointer<XmlElement>::Appender;
     friend class NamedValueSet;
 
+    struct UnparsedChildren;
+
     LinkedListPointer<XmlElement> nextListItem, firstChildElement;
     LinkedListPointer<XmlAttributeNode> attributes;
     String tagName;
+    mutable std::unique_ptr<UnparsedChildren> unparsedChildren;
+
+    void ensureChildrenParsed() const noexcept      { if (unparsedChildren != nullptr) parseUnparsedChildren(); }
+    void parseUnparsedChildren() const noexcept;
 
     XmlElement (int) noexcept;
     void copyChildrenAndAttributesFrom (const XmlElement&);
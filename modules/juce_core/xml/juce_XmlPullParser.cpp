@@ -0,0 +1,898 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlPullParserHelpers
+{
+    static bool isWhitespace (char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool isNameChar (char c) noexcept
+    {
+        // any byte of a multi-byte UTF-8 sequence is allowed in a name
+        return (uint8) c >= 0x80 || XmlIdentifierChars::isIdentifierChar ((juce_wchar) (uint8) c);
+    }
+
+    static bool isWhitespaceOnly (std::string_view text) noexcept
+    {
+        return std::all_of (text.begin(), text.end(), isWhitespace);
+    }
+
+    static bool equalsIgnoreCase (std::string_view text, const char* lowerCaseName) noexcept
+    {
+        for (auto c : text)
+            if (*lowerCaseName == 0 || CharacterFunctions::toLowerCase ((juce_wchar) (uint8) c) != (juce_wchar) (uint8) *lowerCaseName++)
+                return false;
+
+        return *lowerCaseName == 0;
+    }
+
+    static juce_wchar decodeEntity (std::string_view entity) noexcept
+    {
+        if (equalsIgnoreCase (entity, "amp"))   return '&';
+        if (equalsIgnoreCase (entity, "quot"))  return '"';
+        if (equalsIgnoreCase (entity, "apos"))  return '\'';
+        if (equalsIgnoreCase (entity, "lt"))    return '<';
+        if (equalsIgnoreCase (entity, "gt"))    return '>';
+
+        if (entity.size() < 2 || entity[0] != '#')
+            return 0;
+
+        const auto isHex = entity[1] == 'x' || entity[1] == 'X';
+        auto digits = entity.substr (isHex ? 2 : 1);
+
+        if (digits.empty() || digits.size() > 8)
+            return 0;
+
+        uint32 charCode = 0;
+
+        for (auto c : digits)
+        {
+            const auto digit = isHex ? CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) c)
+                                     : (c >= '0' && c <= '9' ? c - '0' : -1);
+
+            if (digit < 0)
+                return 0;
+
+            charCode = charCode * (isHex ? 16u : 10u) + (uint32) digit;
+        }
+
+        return charCode <= 0x10ffff ? (juce_wchar) charCode : 0;
+    }
+}
+
+//==============================================================================
+XmlPullParser::XmlPullParser (InputStream& sourceToRead)  : source (sourceToRead) {}
+XmlPullParser::~XmlPullParser() = default;
+
+XmlPullParser::Event XmlPullParser::next()
+{
+    using namespace XmlPullParserHelpers;
+
+    if (currentEvent == Event::error || (hasStarted && currentEvent == Event::endOfDocument))
+        return currentEvent;
+
+    position += bytesToConsume;
+    bytesToConsume = 0;
+    text = {};
+    textIsCDATA = false;
+
+    if (pendingEndElement)
+    {
+        // the end of an empty element, like <FOO/>, which keeps the name from its start tag
+        pendingEndElement = false;
+        leavingElement = true;
+        attributes.clear();
+        return currentEvent = Event::endElement;
+    }
+
+    if (leavingElement)
+    {
+        leavingElement = false;
+
+        if (--depth == 0)
+        {
+            tagName = {};
+            return currentEvent = Event::endOfDocument;
+        }
+    }
+
+    tagName = {};
+    attributes.clear();
+
+    if (! hasStarted)
+    {
+        hasStarted = true;
+
+        if (matches ("\xef\xbb\xbf", 3))
+            position += 3;
+        else if (matches ("\xfe\xff", 2) || matches ("\xff\xfe", 2))
+            return setError ("UTF-16 documents are not supported");
+    }
+
+    for (;;)
+    {
+        if (! ensureAvailable (1))
+            return setError (depth > 0 ? "unmatched tags" : "not enough input");
+
+        if (buffer[position] != '<')
+        {
+            if (depth == 0)
+            {
+                if (! isWhitespace (buffer[position]))
+                    return setError ("expected an element");
+
+                ++position;
+                continue;
+            }
+
+            auto end = find (0, "<", 1);
+
+            if (end == std::string_view::npos)
+                return setError ("unmatched tags");
+
+            text = { buffer + position, end };
+
+            if (ignoreEmptyText && isWhitespaceOnly (text))
+            {
+                position += end;
+                text = {};
+                continue;
+            }
+
+            bytesToConsume = end;
+            return currentEvent = Event::text;
+        }
+
+        if (matches ("</", 2))
+            return readEndTag();
+
+        if (matches ("<?", 2))
+        {
+            if (! skipPast (2, "?>"))
+                return setError ("unterminated processing instruction");
+
+            continue;
+        }
+
+        if (matches ("<!--", 4))
+        {
+            if (! skipPast (4, "-->"))
+                return setError ("unterminated comment");
+
+            continue;
+        }
+
+        if (matches ("<![CDATA[", 9))
+        {
+            auto end = find (9, "]]>", 3);
+
+            if (end == std::string_view::npos)
+                return setError ("unterminated CDATA section");
+
+            if (depth == 0)
+                return setError ("expected an element");
+
+            text = { buffer + position + 9, end - 9 };
+            textIsCDATA = true;
+            bytesToConsume = end + 3;
+            return currentEvent = Event::text;
+        }
+
+        if (matches ("<!", 2))
+        {
+            if (! skipDeclaration())
+                return setError ("malformed DTD");
+
+            continue;
+        }
+
+        return readStartTag();
+    }
+}
+
+bool XmlPullParser::skipElement()
+{
+    // this can only be used straight after a startElement event!
+    jassert (currentEvent == Event::startElement);
+
+    if (currentEvent != Event::startElement)
+        return false;
+
+    if (pendingEndElement)
+        return next() == Event::endElement;
+
+    position += bytesToConsume;
+    bytesToConsume = 0;
+    tagName = {};
+    attributes.clear();
+
+    for (int nesting = 0;;)
+    {
+        auto start = find (0, "<", 1);
+
+        if (start == std::string_view::npos)
+        {
+            setError ("unmatched tags");
+            return false;
+        }
+
+        position += start;
+
+        if (matches ("</", 2))
+        {
+            if (nesting == 0)
+                return readEndTag() == Event::endElement;
+
+            auto end = find (2, ">", 1);
+
+            if (end == std::string_view::npos)
+                break;
+
+            position += end + 1;
+            --nesting;
+        }
+        else if (matches ("<!--", 4))
+        {
+            if (! skipPast (4, "-->"))
+                break;
+        }
+        else if (matches ("<![CDATA[", 9))
+        {
+            if (! skipPast (9, "]]>"))
+                break;
+        }
+        else if (matches ("<?", 2))
+        {
+            if (! skipPast (2, "?>"))
+                break;
+        }
+        else if (matches ("<!", 2))
+        {
+            if (! skipDeclaration())
+                break;
+        }
+        else
+        {
+            auto end = findEndOfTag (1);
+
+            if (end == std::string_view::npos)
+                break;
+
+            if (buffer[position + end - 1] != '/')
+                ++nesting;
+
+            position += end + 1;
+        }
+    }
+
+    setError ("unexpected end of input");
+    return false;
+}
+
+//==============================================================================
+std::string_view XmlPullParser::getAttributeName (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumAttributes()));
+    return isPositiveAndBelow (index, getNumAttributes()) ? attributes[(size_t) index].name : std::string_view();
+}
+
+std::string_view XmlPullParser::getRawAttributeValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumAttributes()));
+    return isPositiveAndBelow (index, getNumAttributes()) ? attributes[(size_t) index].value : std::string_view();
+}
+
+String XmlPullParser::getAttributeValue (int index) const
+{
+    return decodeEntities (getRawAttributeValue (index));
+}
+
+String XmlPullParser::getAttributeValue (std::string_view attributeName, const String& defaultReturnValue) const
+{
+    auto index = indexOfAttribute (attributeName);
+    return index >= 0 ? decodeEntities (attributes[(size_t) index].value) : defaultReturnValue;
+}
+
+int XmlPullParser::indexOfAttribute (std::string_view attributeName) const noexcept
+{
+    for (size_t i = 0; i < attributes.size(); ++i)
+        if (attributes[i].name == attributeName)
+            return (int) i;
+
+    return -1;
+}
+
+String XmlPullParser::getText() const
+{
+    if (textIsCDATA)
+        return String::fromUTF8 (text.data(), (int) text.size());
+
+    return decodeEntities (text, true);
+}
+
+String XmlPullParser::decodeEntities (std::string_view rawText, bool convertLineEndings)
+{
+    auto isSpecialChar = [convertLineEndings] (char c) { return c == '&' || (convertLineEndings && c == '\r'); };
+
+    auto* start = rawText.data();
+    auto* end = start + rawText.size();
+    auto* nextSpecial = std::find_if (start, end, isSpecialChar);
+
+    if (nextSpecial == end)
+        return String::fromUTF8 (start, (int) rawText.size());
+
+    MemoryOutputStream out (rawText.size());
+
+    for (;;)
+    {
+        out.write (start, (size_t) (nextSpecial - start));
+
+        if (nextSpecial == end)
+            break;
+
+        start = nextSpecial + 1;
+
+        if (*nextSpecial == '\r')
+        {
+            out.writeByte ('\n');
+
+            if (start != end && *start == '\n')
+                ++start;
+        }
+        else
+        {
+            auto* semiColon = std::find (start, end, ';');
+            juce_wchar decoded = 0;
+
+            if (semiColon != end)
+                decoded = XmlPullParserHelpers::decodeEntity ({ start, (size_t) (semiColon - start) });
+
+            if (decoded != 0)
+            {
+                out.appendUTF8Char (decoded);
+                start = semiColon + 1;
+            }
+            else
+            {
+                out.writeByte ('&');
+            }
+        }
+
+        nextSpecial = std::find_if (start, end, isSpecialChar);
+    }
+
+    return out.toUTF8();
+}
+
+//==============================================================================
+bool XmlPullParser::readMoreData()
+{
+    if (sourceExhausted)
+        return false;
+
+    if (position > 0)
+    {
+        dataEnd -= position;
+        memmove (buffer, buffer + position, dataEnd);
+        position = 0;
+    }
+
+    if ((bufferSize - dataEnd) * 2 <= bufferSize)
+    {
+        bufferSize = jmax ((size_t) 16384, bufferSize * 2);
+        buffer.realloc (bufferSize);
+    }
+
+    const auto numToRead = (int) jmin (bufferSize - dataEnd, (size_t) std::numeric_limits<int>::max());
+    const auto numRead = source.read (buffer + dataEnd, numToRead);
+
+    if (numRead <= 0)
+    {
+        sourceExhausted = true;
+        return false;
+    }
+
+    dataEnd += (size_t) numRead;
+    return true;
+}
+
+bool XmlPullParser::ensureAvailable (size_t numBytes)
+{
+    while (dataEnd - position < numBytes)
+        if (! readMoreData())
+            return false;
+
+    return true;
+}
+
+bool XmlPullParser::matches (const char* prefix, size_t length)
+{
+    return ensureAvailable (length) && memcmp (buffer + position, prefix, length) == 0;
+}
+
+// Returns the offset of the pattern from the current position, reading more data as needed
+size_t XmlPullParser::find (size_t start, const char* pattern, size_t patternLength)
+{
+    for (auto offset = start;;)
+    {
+        const auto available = dataEnd - position;
+
+        if (available >= offset + patternLength)
+        {
+            const auto* data = buffer + position;
+            const auto lastPossibleStart = available - patternLength;
+
+            for (auto i = offset; i <= lastPossibleStart;)
+            {
+                auto* found = static_cast<const char*> (memchr (data + i, pattern[0], lastPossibleStart + 1 - i));
+
+                if (found == nullptr)
+                    break;
+
+                i = (size_t) (found - data);
+
+                if (memcmp (found, pattern, patternLength) == 0)
+                    return i;
+
+                ++i;
+            }
+
+            offset = lastPossibleStart + 1;
+        }
+
+        if (! readMoreData())
+            return std::string_view::npos;
+    }
+}
+
+// Finds the '>' that closes a tag, ignoring any inside quoted attribute values
+size_t XmlPullParser::findEndOfTag (size_t start)
+{
+    char quote = 0;
+
+    for (auto i = start;; ++i)
+    {
+        while (position + i >= dataEnd)
+            if (! readMoreData())
+                return std::string_view::npos;
+
+        const auto c = buffer[position + i];
+
+        if (quote != 0)
+        {
+            if (c == quote)
+                quote = 0;
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote = c;
+        }
+        else if (c == '>')
+        {
+            return i;
+        }
+    }
+}
+
+bool XmlPullParser::skipPast (size_t start, const char* terminator)
+{
+    const auto terminatorLength = strlen (terminator);
+    const auto end = find (start, terminator, terminatorLength);
+
+    if (end == std::string_view::npos)
+        return false;
+
+    position += end + terminatorLength;
+    return true;
+}
+
+bool XmlPullParser::skipDeclaration()
+{
+    for (size_t i = 0, nesting = 0;; ++i)
+    {
+        while (position + i >= dataEnd)
+            if (! readMoreData())
+                return false;
+
+        const auto c = buffer[position + i];
+
+        if (c == '<')
+        {
+            ++nesting;
+        }
+        else if (c == '>' && --nesting == 0)
+        {
+            position += i + 1;
+            return true;
+        }
+    }
+}
+
+XmlPullParser::Event XmlPullParser::readStartTag()
+{
+    using namespace XmlPullParserHelpers;
+
+    auto end = findEndOfTag (1);
+
+    if (end == std::string_view::npos)
+        return setError ("unmatched quotes");
+
+    const auto* tag = buffer + position;
+    const auto isEmptyElement = tag[end - 1] == '/';
+    const auto limit = isEmptyElement ? end - 1 : end;
+
+    // (allow for a gap after the '<', as XmlDocument does)
+    size_t i = 1;
+
+    while (i < limit && isWhitespace (tag[i]))
+        ++i;
+
+    const auto nameStart = i;
+
+    while (i < limit && isNameChar (tag[i]))
+        ++i;
+
+    if (i == nameStart)
+        return setError ("tag name missing");
+
+    tagName = { tag + nameStart, i - nameStart };
+
+    for (;;)
+    {
+        while (i < limit && isWhitespace (tag[i]))
+            ++i;
+
+        if (i >= limit)
+            break;
+
+        const auto attributeNameStart = i;
+
+        while (i < limit && isNameChar (tag[i]))
+            ++i;
+
+        if (i == attributeNameStart)
+            return setError ("illegal character found in " + String::fromUTF8 (tagName.data(), (int) tagName.size())
+                               + ": '" + String::charToString ((juce_wchar) (uint8) tag[i]) + "'");
+
+        const std::string_view attributeName (tag + attributeNameStart, i - attributeNameStart);
+
+        while (i < limit && isWhitespace (tag[i]))
+            ++i;
+
+        if (i >= limit || tag[i] != '=')
+            return setError ("expected '=' after attribute '"
+                               + String::fromUTF8 (attributeName.data(), (int) attributeName.size()) + "'");
+
+        ++i;
+
+        while (i < limit && isWhitespace (tag[i]))
+            ++i;
+
+        if (i >= limit || (tag[i] != '"' && tag[i] != '\''))
+            return setError ("expected a quoted value for attribute '"
+                               + String::fromUTF8 (attributeName.data(), (int) attributeName.size()) + "'");
+
+        const auto quote = tag[i++];
+        const auto valueStart = i;
+
+        while (i < limit && tag[i] != quote)
+            ++i;
+
+        if (i >= limit)
+            return setError ("unmatched quotes");
+
+        attributes.push_back ({ attributeName, { tag + valueStart, i - valueStart } });
+        ++i;
+    }
+
+    ++depth;
+    bytesToConsume = end + 1;
+    pendingEndElement = isEmptyElement;
+    return currentEvent = Event::startElement;
+}
+
+XmlPullParser::Event XmlPullParser::readEndTag()
+{
+    using namespace XmlPullParserHelpers;
+
+    if (depth == 0)
+        return setError ("unexpected end tag");
+
+    auto end = find (2, ">", 1);
+
+    if (end == std::string_view::npos)
+        return setError ("unmatched tags");
+
+    const auto* tag = buffer + position;
+    size_t i = 2;
+
+    while (i < end && isWhitespace (tag[i]))
+        ++i;
+
+    const auto nameStart = i;
+
+    while (i < end && isNameChar (tag[i]))
+        ++i;
+
+    tagName = { tag + nameStart, i - nameStart };
+    attributes.clear();
+    bytesToConsume = end + 1;
+    leavingElement = true;
+    return currentEvent = Event::endElement;
+}
+
+XmlPullParser::Event XmlPullParser::setError (const String& message)
+{
+    lastError = message;
+    tagName = {};
+    text = {};
+    attributes.clear();
+    return currentEvent = Event::error;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlPullParserTests  : public UnitTest
+{
+public:
+    XmlPullParserTests()
+        : UnitTest ("XmlPullParser", UnitTestCategories::xml)
+    {}
+
+    // Returns the data a few bytes at a time, to make sure that nothing depends on where the buffer ends
+    struct TrickleInputStream  : public MemoryInputStream
+    {
+        TrickleInputStream (const String& text, Random& r)
+            : MemoryInputStream (text.toRawUTF8(), text.getNumBytesAsUTF8(), true), random (r)
+        {}
+
+        int read (void* destBuffer, int maxBytesToRead) override
+        {
+            return MemoryInputStream::read (destBuffer, jmin (maxBytesToRead, 1 + random.nextInt (7)));
+        }
+
+        Random& random;
+    };
+
+    static String toString (std::string_view text)
+    {
+        return String::fromUTF8 (text.data(), (int) text.size());
+    }
+
+    // Builds an XmlElement from the parser's events, so that it can be compared with XmlDocument's result
+    static std::unique_ptr<XmlElement> readElement (XmlPullParser& parser)
+    {
+        auto e = std::make_unique<XmlElement> (toString (parser.getTagName()));
+
+        for (int i = 0; i < parser.getNumAttributes(); ++i)
+            e->setAttribute (toString (parser.getAttributeName (i)), parser.getAttributeValue (i));
+
+        for (;;)
+        {
+            switch (parser.next())
+            {
+                case XmlPullParser::Event::startElement:
+                    if (auto child = readElement (parser))
+                        e->addChildElement (child.release());
+                    else
+                        return {};
+
+                    break;
+
+                case XmlPullParser::Event::text:            e->addTextElement (parser.getText()); break;
+                case XmlPullParser::Event::endElement:      return e;
+                case XmlPullParser::Event::endOfDocument:
+                case XmlPullParser::Event::error:           return {};
+            }
+        }
+    }
+
+    static String createRandomText (Random& r)
+    {
+        static const char* const pieces[] = { "abc", " ", "&", "<", ">", "\"", "'", "\xc3\xa9", "\xe2\x82\xac", "]]>", "--", "x" };
+        String s;
+
+        for (int i = r.nextInt (6); --i >= 0;)
+            s << String (CharPointer_UTF8 (pieces[r.nextInt (numElementsInArray (pieces))]));
+
+        return s;
+    }
+
+    static void addRandomContent (XmlElement& e, Random& r, int depth)
+    {
+        for (int i = r.nextInt (4); --i >= 0;)
+            e.setAttribute ("att" + String (i), createRandomText (r));
+
+        bool lastWasText = false;
+
+        for (int i = depth > 0 ? r.nextInt (5) : 0; --i >= 0;)
+        {
+            if (! lastWasText && r.nextInt (3) == 0)
+            {
+                e.addTextElement ("text" + createRandomText (r));
+                lastWasText = true;
+            }
+            else
+            {
+                addRandomContent (*e.createNewChildElement ("CHILD" + String (r.nextInt (3))), r, depth - 1);
+                lastWasText = false;
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Events");
+        {
+            const char* xml = "\xef\xbb\xbf<?xml version=\"1.0\"?>\n<!DOCTYPE foo [ <!ELEMENT foo ANY> ]>\n<!-- comment -->\n"
+                              "<ROOT a=\"1 &amp; 2\" b='x > y'>\n"
+                              "  <EMPTY/>\n"
+                              "  <ITEM name=\"two\">some &lt;text&gt; &#65;&#x42;<!-- c --><![CDATA[ & raw ]]></ITEM>\r\n"
+                              "  <?instruction?>\n"
+                              "</ROOT>\n<!-- anything after the outer element is ignored --> junk";
+
+            MemoryInputStream in (xml, strlen (xml), false);
+            XmlPullParser parser (in);
+
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "ROOT");
+            expectEquals (parser.getDepth(), 1);
+            expectEquals (parser.getNumAttributes(), 2);
+            expect (parser.getAttributeName (0) == "a");
+            expect (parser.getRawAttributeValue (0) == "1 &amp; 2");
+            expectEquals (parser.getAttributeValue (0), String ("1 & 2"));
+            expectEquals (parser.getAttributeValue ("b"), String ("x > y"));
+            expectEquals (parser.getAttributeValue ("c", "default"), String ("default"));
+            expectEquals (parser.indexOfAttribute ("b"), 1);
+
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "EMPTY");
+            expectEquals (parser.getDepth(), 2);
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.getTagName() == "EMPTY");
+            expectEquals (parser.getDepth(), 2);
+
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "ITEM");
+            expect (parser.next() == XmlPullParser::Event::text);
+            expect (parser.getRawText() == "some &lt;text&gt; &#65;&#x42;");
+            expectEquals (parser.getText(), String ("some <text> AB"));
+            expect (parser.next() == XmlPullParser::Event::text);
+            expectEquals (parser.getText(), String (" & raw "));
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.getTagName() == "ITEM");
+
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.getTagName() == "ROOT");
+            expectEquals (parser.getDepth(), 1);
+            expect (parser.next() == XmlPullParser::Event::endOfDocument);
+            expect (parser.next() == XmlPullParser::Event::endOfDocument);
+        }
+
+        beginTest ("Whitespace");
+        {
+            const String xml ("<A> <B>\r\n</B> x\r\ny </A>");
+
+            MemoryInputStream in (xml.toRawUTF8(), xml.getNumBytesAsUTF8(), false);
+            XmlPullParser parser (in);
+            parser.setEmptyTextIgnored (false);
+
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.next() == XmlPullParser::Event::text);
+            expect (parser.getRawText() == " ");
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.next() == XmlPullParser::Event::text);
+            expectEquals (parser.getText(), String ("\n"));
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.next() == XmlPullParser::Event::text);
+            expectEquals (parser.getText(), String (" x\ny "));
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.next() == XmlPullParser::Event::endOfDocument);
+        }
+
+        beginTest ("Skipping elements");
+        {
+            const String xml ("<A><B x='<C>'><C/><!-- </B> --><![CDATA[</B>]]><B><B/></B></B><D/><E/></A>");
+
+            MemoryInputStream in (xml.toRawUTF8(), xml.getNumBytesAsUTF8(), false);
+            XmlPullParser parser (in);
+
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "B");
+            expect (parser.skipElement());
+            expect (parser.getCurrentEvent() == XmlPullParser::Event::endElement);
+            expect (parser.getTagName() == "B");
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "D");
+            expect (parser.skipElement());
+            expect (parser.next() == XmlPullParser::Event::startElement);
+            expect (parser.getTagName() == "E");
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.next() == XmlPullParser::Event::endElement);
+            expect (parser.getTagName() == "A");
+            expect (parser.next() == XmlPullParser::Event::endOfDocument);
+        }
+
+        beginTest ("Errors");
+        {
+            for (auto* badXml : { "", "   ", "text", "<A>", "<A><B></B>", "<A b=\"1></A>", "<A b></A>",
+                                  "<A b=1></A>", "<A><!-- </A>", "<A><![CDATA[</A>", "< ></A>", "</A>" })
+            {
+                MemoryInputStream in (badXml, strlen (badXml), false);
+                XmlPullParser parser (in);
+                auto event = parser.next();
+
+                while (event == XmlPullParser::Event::startElement
+                        || event == XmlPullParser::Event::endElement
+                        || event == XmlPullParser::Event::text)
+                    event = parser.next();
+
+                expect (event == XmlPullParser::Event::error, badXml);
+                expect (parser.getLastError().isNotEmpty());
+                expect (parser.next() == XmlPullParser::Event::error);
+            }
+        }
+
+        beginTest ("Random documents");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                XmlElement original ("ROOT");
+                addRandomContent (original, r, 4);
+                auto xml = original.toString();
+
+                TrickleInputStream in (xml, r);
+                XmlPullParser parser (in);
+                expect (parser.next() == XmlPullParser::Event::startElement);
+
+                auto parsed = readElement (parser);
+                expect (parsed != nullptr);
+                expect (parser.next() == XmlPullParser::Event::endOfDocument);
+
+                auto expected = parseXML (xml);
+                expect (parsed != nullptr && parsed->isEquivalentTo (expected.get(), false), xml);
+
+                TrickleInputStream in2 (xml, r);
+                XmlPullParser skippingParser (in2);
+                expect (skippingParser.next() == XmlPullParser::Event::startElement);
+                expect (skippingParser.skipElement());
+                expect (skippingParser.next() == XmlPullParser::Event::endOfDocument);
+            }
+        }
+    }
+};
+
+static XmlPullParserTests xmlPullParserTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads an XML document from a stream, one piece at a time.
+
+    Unlike XmlDocument, which builds a complete tree of XmlElement objects, this
+    reads the stream in small chunks and hands back each start tag, end tag and
+    block of text as it gets to it. The names, attribute values and text that it
+    returns are views into its own buffer rather than copies, so reading very large
+    documents needs hardly any memory at all, and anything that you're not
+    interested in costs almost nothing to skip.
+
+    e.g.
+    @code
+    FileInputStream in (myFile);
+    XmlPullParser parser (in);
+
+    for (auto event = parser.next(); event != XmlPullParser::Event::endOfDocument; event = parser.next())
+    {
+        if (event == XmlPullParser::Event::error)
+        {
+            DBG (parser.getLastError());
+            break;
+        }
+
+        if (event == XmlPullParser::Event::startElement && parser.getTagName() == "TRACK")
+            addTrack (parser.getAttributeValue ("name"));
+    }
+    @endcode
+
+    The views into the buffer only stay valid until the next call to next() or
+    skipElement(), so if you need to keep any of them for longer, you'll need to
+    copy them, e.g. with getAttributeValue() or getText(), which will also replace
+    any entities like "&amp;" with the characters that they stand for.
+
+    The input must be UTF-8 encoded. Comments, processing instructions and any
+    DOCTYPE declaration are skipped, and entities defined by a DTD are not expanded.
+    Only the first element in the document is read; anything after it is ignored.
+
+    @see XmlDocument
+
+    @tags{Core}
+*/
+class JUCE_API  XmlPullParser
+{
+public:
+    //==============================================================================
+    /** Creates a parser that will read from the given stream.
+
+        The stream must remain valid for as long as the parser is being used. Nothing
+        is read until next() is called.
+    */
+    explicit XmlPullParser (InputStream& source);
+
+    /** Destructor. */
+    ~XmlPullParser();
+
+    //==============================================================================
+    /** The types of event that the parser produces. */
+    enum class Event
+    {
+        startElement,   /**< A start tag - use getTagName() and the attribute methods to find out about it. */
+        endElement,     /**< An end tag. An empty element like <FOO/> produces a startElement followed by an endElement. */
+        text,           /**< A block of text or a CDATA section inside an element. */
+        endOfDocument,  /**< The outer element has been closed, or the stream has run out. */
+        error           /**< The data was malformed - use getLastError() to find out why. */
+    };
+
+    /** Moves on to the next event in the document and returns its type.
+
+        Once the parser has returned endOfDocument or error, it will keep on returning
+        the same value.
+    */
+    Event next();
+
+    /** Returns the type of the event that next() last returned. */
+    Event getCurrentEvent() const noexcept                      { return currentEvent; }
+
+    /** After a startElement event, this skips forward past all the element's content,
+        so that the next event will be the one following its end tag.
+
+        This is much cheaper than calling next() repeatedly, because it doesn't need to
+        work out the details of the elements that it skips.
+
+        @returns true if the end of the element was found, or false if there was an error.
+    */
+    bool skipElement();
+
+    /** Returns the nesting level of the current element.
+
+        For the startElement and endElement events of the outer document element this is 1,
+        for its children it's 2, and so on. For a text event, it's the level of the element
+        that contains the text.
+    */
+    int getDepth() const noexcept                               { return depth; }
+
+    //==============================================================================
+    /** Returns the tag name of the current startElement or endElement event. */
+    std::string_view getTagName() const noexcept                { return tagName; }
+
+    /** Returns the number of attributes in the current start tag. */
+    int getNumAttributes() const noexcept                       { return (int) attributes.size(); }
+
+    /** Returns the name of one of the current start tag's attributes. */
+    std::string_view getAttributeName (int index) const noexcept;
+
+    /** Returns the value of one of the current start tag's attributes, exactly as it
+        appears in the document, i.e. without its entities being replaced.
+    */
+    std::string_view getRawAttributeValue (int index) const noexcept;
+
+    /** Returns the value of one of the current start tag's attributes. */
+    String getAttributeValue (int index) const;
+
+    /** Returns the value of the current start tag's attribute with the given name, or
+        the default value if there's no such attribute.
+    */
+    String getAttributeValue (std::string_view attributeName, const String& defaultReturnValue = {}) const;
+
+    /** Returns the index of the current start tag's attribute with the given name, or -1. */
+    int indexOfAttribute (std::string_view attributeName) const noexcept;
+
+    /** Returns the text of the current text event, exactly as it appears in the document. */
+    std::string_view getRawText() const noexcept                { return text; }
+
+    /** Returns the text of the current text event, with any entities replaced and
+        line-endings converted to "\n".
+    */
+    String getText() const;
+
+    //==============================================================================
+    /** Sets whether blocks of text that contain nothing but whitespace are skipped.
+        This is true by default, as it is for XmlDocument.
+    */
+    void setEmptyTextIgnored (bool shouldBeIgnored) noexcept    { ignoreEmptyText = shouldBeIgnored; }
+
+    /** Returns a description of the error, after next() has returned Event::error. */
+    const String& getLastError() const noexcept                 { return lastError; }
+
+    /** Replaces the standard and numeric character entities in some UTF-8 encoded text.
+        Any other entities are left as they are.
+    */
+    static String decodeEntities (std::string_view rawText, bool convertLineEndings = false);
+
+private:
+    //==============================================================================
+    struct Attribute
+    {
+        std::string_view name, value;
+    };
+
+    InputStream& source;
+    HeapBlock<char> buffer;
+    size_t bufferSize = 0, position = 0, dataEnd = 0, bytesToConsume = 0;
+    bool sourceExhausted = false, pendingEndElement = false, leavingElement = false;
+    bool hasStarted = false, ignoreEmptyText = true, textIsCDATA = false;
+    int depth = 0;
+    Event currentEvent = Event::endOfDocument;
+    std::string_view tagName, text;
+    std::vector<Attribute> attributes;
+    String lastError;
+
+    bool readMoreData();
+    bool ensureAvailable (size_t numBytes);
+    size_t find (size_t start, const char* pattern, size_t patternLength);
+    size_t findEndOfTag (size_t start);
+    bool skipPast (size_t start, const char* terminator);
+    bool skipDeclaration();
+    Event readStartTag();
+    Event readEndTag();
+    bool matches (const char* prefix, size_t length);
+    Event setError (const String&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlPullParser)
+};
+
+} // namespace juce
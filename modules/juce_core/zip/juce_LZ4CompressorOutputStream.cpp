@@ -0,0 +1,705 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace LZ4Helpers
+{
+    enum
+    {
+        frameMagicNumber            = 0x184D2204,
+        skippableFrameMagicNumber   = 0x184D2A50, // (the lowest 4 bits can have any value)
+        uncompressedBlockFlag       = (int) 0x80000000,
+        minimumMatchLength          = 4,
+        lastLiteralsLength          = 5,
+        matchFindLimit              = 12,
+        maximumOffset               = 65535,
+        hashBits                    = 12,
+        hashTableSize               = 1 << hashBits,
+        skipStrength                = 6
+    };
+
+    static uint32 read32 (const uint8* p) noexcept      { return readUnaligned<uint32> (p); }
+
+    static int getMaximumCompressedSize (int inputSize) noexcept
+    {
+        return inputSize + inputSize / 255 + 16;
+    }
+
+    //==============================================================================
+    /** An incremental implementation of the 32-bit xxHash, which LZ4 frames use for their checksums. */
+    struct XXHash32
+    {
+        explicit XXHash32 (uint32 seed = 0) noexcept
+            : v1 (seed + prime1 + prime2), v2 (seed + prime2), v3 (seed), v4 (seed - prime1)
+        {
+        }
+
+        void update (const void* data, size_t size) noexcept
+        {
+            auto* p = static_cast<const uint8*> (data);
+            totalLength += size;
+
+            if (bufferedBytes + size < 16)
+            {
+                memcpy (buffer + bufferedBytes, p, size);
+                bufferedBytes += size;
+                return;
+            }
+
+            if (bufferedBytes > 0)
+            {
+                auto numToFill = 16 - bufferedBytes;
+                memcpy (buffer + bufferedBytes, p, numToFill);
+                processStripe (buffer);
+                p += numToFill;
+                size -= numToFill;
+                bufferedBytes = 0;
+            }
+
+            for (; size >= 16; p += 16, size -= 16)
+                processStripe (p);
+
+            memcpy (buffer, p, size);
+            bufferedBytes = size;
+        }
+
+        uint32 getResult() const noexcept
+        {
+            auto h = totalLength >= 16 ? rotate (v1, 1) + rotate (v2, 7) + rotate (v3, 12) + rotate (v4, 18)
+                                       : v3 + prime5;
+
+            h += (uint32) totalLength;
+
+            auto* p = buffer;
+            auto* end = buffer + bufferedBytes;
+
+            for (; p + 4 <= end; p += 4)
+                h = rotate (h + ByteOrder::littleEndianInt (p) * prime3, 17) * prime4;
+
+            for (; p < end; ++p)
+                h = rotate (h + *p * prime5, 11) * prime1;
+
+            h ^= h >> 15;
+            h *= prime2;
+            h ^= h >> 13;
+            h *= prime3;
+            h ^= h >> 16;
+            return h;
+        }
+
+        static uint32 calculate (const void* data, size_t size) noexcept
+        {
+            XXHash32 hash;
+            hash.update (data, size);
+            return hash.getResult();
+        }
+
+    private:
+        static constexpr uint32 prime1 = 2654435761u, prime2 = 2246822519u, prime3 = 3266489917u,
+                                prime4 = 668265263u,  prime5 = 374761393u;
+
+        static uint32 rotate (uint32 x, int bits) noexcept      { return (x << bits) | (x >> (32 - bits)); }
+        static uint32 round (uint32 v, uint32 input) noexcept   { return rotate (v + input * prime2, 13) * prime1; }
+
+        void processStripe (const uint8* p) noexcept
+        {
+            v1 = round (v1, ByteOrder::littleEndianInt (p));
+            v2 = round (v2, ByteOrder::littleEndianInt (p + 4));
+            v3 = round (v3, ByteOrder::littleEndianInt (p + 8));
+            v4 = round (v4, ByteOrder::littleEndianInt (p + 12));
+        }
+
+        uint32 v1, v2, v3, v4;
+        uint64 totalLength = 0;
+        uint8 buffer[16] = {};
+        size_t bufferedBytes = 0;
+    };
+
+    //==============================================================================
+    static uint8* writeLength (uint8* op, size_t length) noexcept
+    {
+        for (; length >= 255; length -= 255)
+            *op++ = 255;
+
+        *op++ = (uint8) length;
+        return op;
+    }
+
+    static uint8* writeLiterals (uint8* op, const uint8* literals, size_t numLiterals, uint8*& token) noexcept
+    {
+        token = op++;
+
+        if (numLiterals >= 15)
+        {
+            *token = 15 << 4;
+            op = writeLength (op, numLiterals - 15);
+        }
+        else
+        {
+            *token = (uint8) (numLiterals << 4);
+        }
+
+        memcpy (op, literals, numLiterals);
+        return op + numLiterals;
+    }
+
+    static size_t countMatchingBytes (const uint8* p, const uint8* match, const uint8* limit) noexcept
+    {
+        auto* start = p;
+
+        while (p + sizeof (uint64) <= limit && readUnaligned<uint64> (p) == readUnaligned<uint64> (match))
+        {
+            p += sizeof (uint64);
+            match += sizeof (uint64);
+        }
+
+        while (p < limit && *p == *match)
+        {
+            ++p;
+            ++match;
+        }
+
+        return (size_t) (p - start);
+    }
+
+    /*  Compresses one independent block into dest, which must have space for at least
+        getMaximumCompressedSize (sourceSize) bytes, and returns the size of the result.
+        This is the usual greedy LZ4 match finder: a hash table remembers the last position
+        at which each 4-byte sequence was seen, and the search steps forward more quickly
+        the longer it goes without finding a match.
+    */
+    static int compressBlock (const uint8* source, int sourceSize, uint8* dest,
+                              uint32* hashTable, int acceleration) noexcept
+    {
+        auto* ip = source;
+        auto* anchor = source;
+        auto* end = source + sourceSize;
+        auto* op = dest;
+
+        auto hash = [] (const uint8* p) { return (read32 (p) * 2654435761u) >> (32 - hashBits); };
+
+        if (sourceSize > matchFindLimit)
+        {
+            auto* matchFindEnd = end - matchFindLimit + 1;
+            auto* matchLimit = end - lastLiteralsLength;
+
+            std::fill (hashTable, hashTable + hashTableSize, 0u);
+            hashTable[hash (ip)] = 0;
+            auto forwardHash = hash (++ip);
+
+            for (;;)
+            {
+                const uint8* match;
+
+                {
+                    auto* forwardIp = ip;
+                    auto step = 1;
+                    auto searchCount = acceleration << skipStrength;
+
+                    do
+                    {
+                        auto h = forwardHash;
+                        ip = forwardIp;
+                        forwardIp += step;
+                        step = searchCount++ >> skipStrength;
+
+                        if (forwardIp > matchFindEnd)
+                        {
+                            match = nullptr;
+                            break;
+                        }
+
+                        match = source + hashTable[h];
+                        forwardHash = hash (forwardIp);
+                        hashTable[h] = (uint32) (ip - source);
+                    }
+                    while (match + maximumOffset < ip || read32 (match) != read32 (ip));
+                }
+
+                if (match == nullptr)
+                    break;
+
+                // extend the match backwards over any identical bytes before it
+                while (ip > anchor && match > source && ip[-1] == match[-1])
+                {
+                    --ip;
+                    --match;
+                }
+
+                uint8* token;
+                op = writeLiterals (op, anchor, (size_t) (ip - anchor), token);
+
+                for (;;)
+                {
+                    writeUnaligned<uint16> (op, ByteOrder::swapIfBigEndian ((uint16) (ip - match)));
+                    op += 2;
+
+                    auto matchLength = countMatchingBytes (ip + minimumMatchLength, match + minimumMatchLength, matchLimit);
+                    ip += minimumMatchLength + matchLength;
+
+                    if (matchLength >= 15)
+                    {
+                        *token = (uint8) (*token + 15);
+                        op = writeLength (op, matchLength - 15);
+                    }
+                    else
+                    {
+                        *token = (uint8) (*token + matchLength);
+                    }
+
+                    anchor = ip;
+
+                    if (ip >= matchFindEnd)
+                        break;
+
+                    hashTable[hash (ip - 2)] = (uint32) (ip - 2 - source);
+
+                    // if there's another match straight away, it can follow on without any literals
+                    auto h = hash (ip);
+                    match = source + hashTable[h];
+                    hashTable[h] = (uint32) (ip - source);
+
+                    if (match + maximumOffset < ip || read32 (match) != read32 (ip))
+                        break;
+
+                    token = op++;
+                    *token = 0;
+                }
+
+                if (ip >= matchFindEnd)
+                    break;
+
+                forwardHash = hash (++ip);
+            }
+        }
+
+        uint8* token;
+        op = writeLiterals (op, anchor, (size_t) (end - anchor), token);
+        return (int) (op - dest);
+    }
+
+    /*  Decompresses one block, writing it to dest + destStart. Any bytes before destStart
+        are the end of the previous block, which linked blocks can refer back to.
+        Returns the number of bytes written, or -1 if the data is corrupted.
+    */
+    static int decompressBlock (const uint8* source, int sourceSize, uint8* dest,
+                                int destStart, int destCapacity) noexcept
+    {
+        auto* ip = source;
+        auto* end = source + sourceSize;
+        auto* op = dest + destStart;
+        auto* outputEnd = dest + destCapacity;
+
+        auto readLength = [&ip, end] (size_t& length)
+        {
+            for (;;)
+            {
+                if (ip >= end)
+                    return false;
+
+                auto b = *ip++;
+                length += b;
+
+                if (b != 255)
+                    return true;
+            }
+        };
+
+        for (;;)
+        {
+            if (ip >= end)
+                return -1;
+
+            auto token = *ip++;
+            auto numLiterals = (size_t) (token >> 4);
+
+            if (numLiterals == 15 && ! readLength (numLiterals))
+                return -1;
+
+            if ((size_t) (end - ip) < numLiterals || (size_t) (outputEnd - op) < numLiterals)
+                return -1;
+
+            memcpy (op, ip, numLiterals);
+            op += numLiterals;
+            ip += numLiterals;
+
+            // the last sequence has literals but no match
+            if (ip == end)
+                break;
+
+            if (end - ip < 2)
+                return -1;
+
+            auto offset = (size_t) (ip[0] | (ip[1] << 8));
+            ip += 2;
+
+            if (offset == 0 || offset > (size_t) (op - dest))
+                return -1;
+
+            auto matchLength = (size_t) (token & 15);
+
+            if (matchLength == 15 && ! readLength (matchLength))
+                return -1;
+
+            matchLength += minimumMatchLength;
+
+            if ((size_t) (outputEnd - op) < matchLength)
+                return -1;
+
+            auto* match = op - offset;
+
+            if (offset >= matchLength)
+            {
+                memcpy (op, match, matchLength);
+            }
+            else if (offset >= sizeof (uint64))
+            {
+                // (each 8-byte chunk is copied from data that has already been written)
+                size_t i = 0;
+
+                for (; i + sizeof (uint64) <= matchLength; i += sizeof (uint64))
+                    writeUnaligned<uint64> (op + i, readUnaligned<uint64> (match + i));
+
+                for (; i < matchLength; ++i)
+                    op[i] = match[i];
+            }
+            else
+            {
+                for (size_t i = 0; i < matchLength; ++i)
+                    op[i] = match[i];
+            }
+
+            op += matchLength;
+        }
+
+        return (int) (op - (dest + destStart));
+    }
+}
+
+//==============================================================================
+class LZ4CompressorOutputStream::LZ4CompressorHelper
+{
+public:
+    explicit LZ4CompressorHelper (int compressionLevel)
+        : acceleration ((compressionLevel < 1 || compressionLevel > 9) ? 1 : 10 - compressionLevel),
+          storeUncompressed (compressionLevel == 0),
+          compressedBlock ((size_t) LZ4Helpers::getMaximumCompressedSize (blockSize)),
+          hashTable ((size_t) LZ4Helpers::hashTableSize)
+    {
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on an LZ4 stream, the frame is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        if (finished || ! writeHeaderIfNeeded (out))
+            return false;
+
+        contentChecksum.update (data, dataSize);
+
+        while (dataSize > 0)
+        {
+            // whole blocks can be compressed straight from the caller's data
+            if (numBufferedBytes == 0 && dataSize >= (size_t) blockSize)
+            {
+                if (! writeBlock (data, blockSize, out))
+                    return false;
+
+                data += blockSize;
+                dataSize -= (size_t) blockSize;
+                continue;
+            }
+
+            auto numToCopy = jmin (dataSize, (size_t) (blockSize - numBufferedBytes));
+
+            if (inputBuffer.getData() == nullptr)
+                inputBuffer.malloc ((size_t) blockSize);
+
+            memcpy (inputBuffer + numBufferedBytes, data, numToCopy);
+            numBufferedBytes += (int) numToCopy;
+            data += numToCopy;
+            dataSize -= numToCopy;
+
+            if (numBufferedBytes == blockSize && ! writeBufferedBlock (out))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool finish (OutputStream& out)
+    {
+        if (finished)
+            return true;
+
+        finished = true;
+
+        return writeHeaderIfNeeded (out)
+                && writeBufferedBlock (out)
+                && out.writeInt (0) // end mark
+                && out.writeInt ((int) contentChecksum.getResult());
+    }
+
+private:
+    enum { blockSize = 256 * 1024 };
+
+    const int acceleration;
+    const bool storeUncompressed;
+    bool headerWritten = false, finished = false;
+    HeapBlock<uint8> inputBuffer, compressedBlock;
+    HeapBlock<uint32> hashTable;
+    int numBufferedBytes = 0;
+    LZ4Helpers::XXHash32 contentChecksum;
+
+    bool writeHeaderIfNeeded (OutputStream& out)
+    {
+        if (std::exchange (headerWritten, true))
+            return true;
+
+        // version 1, independent blocks, content checksum, 256KB blocks
+        const uint8 descriptor[] = { 0x64, 0x50 };
+        auto headerChecksum = (uint8) (LZ4Helpers::XXHash32::calculate (descriptor, sizeof (descriptor)) >> 8);
+
+        return out.writeInt (LZ4Helpers::frameMagicNumber)
+                && out.write (descriptor, sizeof (descriptor))
+                && out.writeByte ((char) headerChecksum);
+    }
+
+    bool writeBufferedBlock (OutputStream& out)
+    {
+        if (numBufferedBytes == 0)
+            return true;
+
+        auto size = std::exchange (numBufferedBytes, 0);
+        return writeBlock (inputBuffer, size, out);
+    }
+
+    bool writeBlock (const uint8* data, int size, OutputStream& out)
+    {
+        if (! storeUncompressed)
+        {
+            auto compressedSize = LZ4Helpers::compressBlock (data, size, compressedBlock, hashTable, acceleration);
+
+            if (compressedSize < size)
+                return out.writeInt (compressedSize)
+                        && out.write (compressedBlock, (size_t) compressedSize);
+        }
+
+        return out.writeInt (size | LZ4Helpers::uncompressedBlockFlag)
+                && out.write (data, (size_t) size);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4CompressorHelper)
+};
+
+//==============================================================================
+LZ4CompressorOutputStream::LZ4CompressorOutputStream (OutputStream& s, int compressionLevel)
+   : LZ4CompressorOutputStream (&s, compressionLevel, false)
+{
+}
+
+LZ4CompressorOutputStream::LZ4CompressorOutputStream (OutputStream* out, int compressionLevel, bool deleteDestStream)
+   : destStream (out, deleteDestStream),
+     helper (new LZ4CompressorHelper (compressionLevel))
+{
+    jassert (out != nullptr);
+}
+
+LZ4CompressorOutputStream::~LZ4CompressorOutputStream()
+{
+    flush();
+}
+
+void LZ4CompressorOutputStream::flush()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+bool LZ4CompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 LZ4CompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool LZ4CompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct LZ4Tests  : public UnitTest
+{
+    LZ4Tests()
+        : UnitTest ("LZ4", UnitTestCategories::compression)
+    {}
+
+    static MemoryBlock createTestData (Random& rng, int size)
+    {
+        MemoryBlock data ((size_t) size);
+
+        // a mixture of random bytes, runs and repeated phrases
+        for (int i = 0; i < size;)
+        {
+            auto length = jmin (size - i, rng.nextInt (300) + 1);
+
+            switch (rng.nextInt (3))
+            {
+                case 0:
+                    for (int j = 0; j < length; ++j)
+                        data[(size_t) (i + j)] = (char) rng.nextInt (256);
+                    break;
+
+                case 1:
+                    memset (data.begin() + i, rng.nextInt (256), (size_t) length);
+                    break;
+
+                default:
+                    for (int j = 0; j < length; ++j)
+                        data[(size_t) (i + j)] = "the quick brown fox "[j % 20];
+                    break;
+            }
+
+            i += length;
+        }
+
+        return data;
+    }
+
+    void runTest() override
+    {
+        beginTest ("xxHash32");
+
+        expectEquals ((int64) LZ4Helpers::XXHash32::calculate ("", 0), (int64) 0x02cc5d05);
+        expectEquals ((int64) LZ4Helpers::XXHash32::calculate ("abc", 3), (int64) 0x32d153ff);
+
+        {
+            const String text ("Nobody inspects the spammish repetition");
+            LZ4Helpers::XXHash32 incremental;
+
+            for (int i = 0; i < text.length(); ++i)
+                incremental.update (text.toRawUTF8() + i, 1);
+
+            expectEquals ((int64) incremental.getResult(), (int64) 0xe2293b2f);
+            expectEquals ((int64) LZ4Helpers::XXHash32::calculate (text.toRawUTF8(), (size_t) text.length()),
+                          (int64) 0xe2293b2f);
+        }
+
+        beginTest ("LZ4");
+        Random rng = getRandom();
+
+        for (int i = 100; --i >= 0;)
+        {
+            MemoryOutputStream original, compressed, uncompressed;
+
+            {
+                LZ4CompressorOutputStream compressor (compressed, rng.nextInt (11) - 1);
+
+                for (int j = rng.nextInt (100); --j >= 0;)
+                {
+                    auto data = createTestData (rng, rng.nextInt (i < 5 ? 300000 : 5000) + 1);
+
+                    original   << data;
+                    compressor << data;
+                }
+            }
+
+            {
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                LZ4DecompressorInputStream decompressor (compressedInput);
+
+                uncompressed << decompressor;
+                expect (! decompressor.hasError());
+            }
+
+            expectEquals ((int) uncompressed.getDataSize(),
+                          (int) original.getDataSize());
+
+            if (original.getDataSize() == uncompressed.getDataSize())
+                expect (memcmp (uncompressed.getData(),
+                                original.getData(),
+                                original.getDataSize()) == 0);
+        }
+
+        beginTest ("Compression ratio");
+        {
+            auto data = createTestData (rng, 1000000);
+            MemoryOutputStream compressed;
+
+            {
+                LZ4CompressorOutputStream compressor (compressed);
+                compressor << data;
+            }
+
+            expect (compressed.getDataSize() < data.getSize() * 3 / 4);
+        }
+
+        beginTest ("Corrupted data");
+        {
+            auto data = createTestData (rng, 100000);
+            MemoryOutputStream compressed;
+
+            {
+                LZ4CompressorOutputStream compressor (compressed);
+                compressor << data;
+            }
+
+            for (int i = 0; i < 200; ++i)
+            {
+                MemoryBlock corrupted (compressed.getData(), compressed.getDataSize());
+
+                for (int j = rng.nextInt (5) + 1; --j >= 0;)
+                    corrupted[(size_t) rng.nextInt ((int) corrupted.getSize())] = (char) rng.nextInt (256);
+
+                MemoryInputStream compressedInput (corrupted, false);
+                LZ4DecompressorInputStream decompressor (compressedInput);
+                MemoryOutputStream uncompressed;
+                uncompressed << decompressor;
+
+                // any damage must be noticed, thanks to the checksums
+                expect (decompressor.hasError() || corrupted == compressed.getMemoryBlock());
+            }
+        }
+    }
+};
+
+static LZ4Tests lz4Tests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A stream which compresses the data written into it using the LZ4 frame format.
+
+    LZ4 compresses much less tightly than zlib, but it's many times faster, both to
+    compress and to decompress, so it's a good choice for data that needs to be saved or
+    sent quickly, e.g. plugin state or messages between processes. The data that's
+    produced can be read by an LZ4DecompressorInputStream, or by any other program that
+    understands the standard LZ4 frame format.
+
+    The data is compressed in independent blocks of 256KB, and a checksum of the whole
+    content is added at the end.
+
+    Important note: When you call flush() on an LZ4CompressorOutputStream, the frame is
+    closed - this means that no more data can be written to it, and any subsequent
+    attempts to call write() will cause an assertion.
+
+    @see LZ4DecompressorInputStream, GZIPCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  LZ4CompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written
+        @param compressionLevel                 how much to compress the data, between 0 and 9, where
+                                                0 is non-compressed storage, 1 is the fastest/lowest compression,
+                                                and 9 is the slowest/highest compression. Any value outside this range
+                                                indicates that the highest compression level should be used.
+    */
+    LZ4CompressorOutputStream (OutputStream& destStream,
+                               int compressionLevel = -1);
+
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written.
+                                                Ownership of this object depends on the value of deleteDestStreamWhenDestroyed
+        @param compressionLevel                 how much to compress the data, between 0 and 9, where
+                                                0 is non-compressed storage, 1 is the fastest/lowest compression,
+                                                and 9 is the slowest/highest compression. Any value outside this range
+                                                indicates that the highest compression level should be used.
+        @param deleteDestStreamWhenDestroyed    whether or not the LZ4CompressorOutputStream will delete the
+                                                destStream object when it is destroyed
+    */
+    LZ4CompressorOutputStream (OutputStream* destStream,
+                               int compressionLevel = -1,
+                               bool deleteDestStreamWhenDestroyed = false);
+
+    /** Destructor. */
+    ~LZ4CompressorOutputStream() override;
+
+    //==============================================================================
+    /** Flushes and closes the stream.
+        Note that unlike most streams, when you call flush() on an LZ4CompressorOutputStream,
+        the stream is closed - this means that no more data can be written to it, and any
+        subsequent attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class LZ4CompressorHelper;
+    std::unique_ptr<LZ4CompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LZ4CompressorOutputStream)
+};
+
+} // namespace juce
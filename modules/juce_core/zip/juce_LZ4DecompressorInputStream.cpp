@@ -0,0 +1,519 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class LZ4DecompressorInputStream::LZ4DecompressHelper
+{
+public:
+    LZ4DecompressHelper() = default;
+
+    /*  Makes the next block of decompressed data available, reading the headers of any
+        new frames on the way. Returns false at the end of the data, or if there's an error.
+    */
+    bool decodeNextBlock (InputStream& source)
+    {
+        while (! error)
+        {
+            if (! isInsideFrame && ! readFrameHeader (source))
+                return false;
+
+            uint32 blockHeader;
+
+            if (! readFully (source, &blockHeader, sizeof (blockHeader)))
+                return setError();
+
+            blockHeader = ByteOrder::swapIfBigEndian (blockHeader);
+
+            if (blockHeader == 0)
+            {
+                if (! finishFrame (source))
+                    return false;
+
+                continue;
+            }
+
+            auto isUncompressed = (blockHeader & (uint32) LZ4Helpers::uncompressedBlockFlag) != 0;
+            auto size = (int) (blockHeader & ~(uint32) LZ4Helpers::uncompressedBlockFlag);
+
+            if (size > blockMaximumSize || ! readFully (source, compressedBlock, (size_t) size))
+                return setError();
+
+            if (hasBlockChecksums)
+            {
+                uint32 checksum;
+
+                if (! readFully (source, &checksum, sizeof (checksum))
+                     || ByteOrder::swapIfBigEndian (checksum) != LZ4Helpers::XXHash32::calculate (compressedBlock, (size_t) size))
+                    return setError();
+            }
+
+            // Linked blocks can refer back to the last 64KB of the previous block, so that's kept at the start of the buffer
+            auto historySize = 0;
+
+            if (! blocksAreIndependent)
+            {
+                historySize = jmin (decodedEnd, (int) historyLength);
+                memmove (decodedData, decodedData + decodedEnd - historySize, (size_t) historySize);
+            }
+
+            int numDecoded;
+
+            if (isUncompressed)
+            {
+                memcpy (decodedData + historySize, compressedBlock, (size_t) size);
+                numDecoded = size;
+            }
+            else
+            {
+                numDecoded = LZ4Helpers::decompressBlock (compressedBlock, size, decodedData,
+                                                          historySize, historySize + blockMaximumSize);
+
+                if (numDecoded < 0)
+                    return setError();
+            }
+
+            decodedPosition = historySize;
+            decodedEnd = historySize + numDecoded;
+
+            if (hasContentChecksum)
+                contentChecksum.update (decodedData + historySize, (size_t) numDecoded);
+
+            if (numDecoded > 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    int readDecodedData (uint8* dest, int howMany) noexcept
+    {
+        auto num = jmin (howMany, decodedEnd - decodedPosition);
+        memcpy (dest, decodedData + decodedPosition, (size_t) num);
+        decodedPosition += num;
+        return num;
+    }
+
+    bool hasDecodedData() const noexcept       { return decodedPosition < decodedEnd; }
+
+    bool error = false, finished = false;
+    bool isInsideFrame = false;
+
+private:
+    enum { historyLength = 65536 };
+
+    HeapBlock<uint8> compressedBlock, decodedData;
+    int blockMaximumSize = 0, decodedPosition = 0, decodedEnd = 0;
+    bool blocksAreIndependent = true, hasBlockChecksums = false, hasContentChecksum = false;
+    LZ4Helpers::XXHash32 contentChecksum;
+
+    bool setError() noexcept
+    {
+        error = true;
+        return false;
+    }
+
+    static bool readFully (InputStream& source, void* dest, size_t numBytes)
+    {
+        return source.read (dest, (int) numBytes) == (int) numBytes;
+    }
+
+    bool readFrameHeader (InputStream& source)
+    {
+        for (;;)
+        {
+            uint8 magic[4];
+            auto numRead = source.read (magic, 4);
+
+            // the data may end cleanly after any complete frame
+            if (numRead == 0 && finished)
+                return false;
+
+            if (numRead != 4)
+                return setError();
+
+            auto magicNumber = ByteOrder::littleEndianInt (magic);
+
+            if ((magicNumber & 0xfffffff0) == (uint32) LZ4Helpers::skippableFrameMagicNumber)
+            {
+                uint8 sizeBytes[4];
+
+                if (! readFully (source, sizeBytes, 4))
+                    return setError();
+
+                auto size = (int64) ByteOrder::littleEndianInt (sizeBytes);
+                auto start = source.getPosition();
+                source.skipNextBytes (size);
+
+                if (source.getPosition() != start + size)
+                    return setError();
+
+                continue;
+            }
+
+            if (magicNumber != (uint32) LZ4Helpers::frameMagicNumber)
+                return setError();
+
+            break;
+        }
+
+        uint8 descriptor[15];
+
+        if (! readFully (source, descriptor, 2))
+            return setError();
+
+        auto flags = descriptor[0];
+        auto blockSizeCode = (descriptor[1] >> 4) & 7;
+
+        // (only version 1 exists, and dictionaries aren't supported)
+        if ((flags >> 6) != 1 || (flags & 3) != 0 || (descriptor[1] & 0x8f) != 0 || blockSizeCode < 4)
+            return setError();
+
+        blocksAreIndependent = (flags & 0x20) != 0;
+        hasBlockChecksums    = (flags & 0x10) != 0;
+        hasContentChecksum   = (flags & 0x04) != 0;
+
+        auto descriptorSize = (flags & 0x08) != 0 ? 10 : 2;
+
+        if (descriptorSize > 2 && ! readFully (source, descriptor + 2, (size_t) descriptorSize - 2))
+            return setError();
+
+        uint8 headerChecksum;
+
+        if (! readFully (source, &headerChecksum, 1)
+             || headerChecksum != (uint8) (LZ4Helpers::XXHash32::calculate (descriptor, (size_t) descriptorSize) >> 8))
+            return setError();
+
+        auto newMaximumSize = 1 << (8 + 2 * blockSizeCode);
+
+        if (newMaximumSize > blockMaximumSize)
+        {
+            // the history at the start of the decoded buffer doesn't carry over between frames
+            blockMaximumSize = newMaximumSize;
+            compressedBlock.malloc ((size_t) blockMaximumSize);
+            decodedData.malloc ((size_t) (blockMaximumSize + historyLength));
+        }
+
+        decodedPosition = decodedEnd = 0;
+        contentChecksum = LZ4Helpers::XXHash32();
+        isInsideFrame = true;
+        return true;
+    }
+
+    bool finishFrame (InputStream& source)
+    {
+        if (hasContentChecksum)
+        {
+            uint32 checksum;
+
+            if (! readFully (source, &checksum, sizeof (checksum))
+                 || ByteOrder::swapIfBigEndian (checksum) != contentChecksum.getResult())
+                return setError();
+        }
+
+        isInsideFrame = false;
+        finished = true;
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4DecompressHelper)
+};
+
+//==============================================================================
+LZ4DecompressorInputStream::LZ4DecompressorInputStream (InputStream* source, bool deleteSourceWhenDestroyed,
+                                                        int64 uncompressedLength)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    uncompressedStreamLength (uncompressedLength),
+    originalSourcePos (source->getPosition()),
+    helper (new LZ4DecompressHelper())
+{
+}
+
+LZ4DecompressorInputStream::LZ4DecompressorInputStream (InputStream& source)
+  : sourceStream (&source, false),
+    uncompressedStreamLength (-1),
+    originalSourcePos (source.getPosition()),
+    helper (new LZ4DecompressHelper())
+{
+}
+
+LZ4DecompressorInputStream::~LZ4DecompressorInputStream()
+{
+}
+
+bool LZ4DecompressorInputStream::hasError() const noexcept
+{
+    return helper->error;
+}
+
+int64 LZ4DecompressorInputStream::getTotalLength()
+{
+    return uncompressedStreamLength;
+}
+
+int LZ4DecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    auto d = static_cast<uint8*> (destBuffer);
+    int numRead = 0;
+
+    while (numRead < howMany)
+    {
+        if (! helper->hasDecodedData() && ! helper->decodeNextBlock (*sourceStream))
+            break;
+
+        numRead += helper->readDecodedData (d + numRead, howMany - numRead);
+    }
+
+    currentPos += numRead;
+    return numRead;
+}
+
+bool LZ4DecompressorInputStream::isExhausted()
+{
+    if (helper->error)
+        return true;
+
+    return ! helper->hasDecodedData() && ! helper->isInsideFrame
+             && helper->finished && sourceStream->isExhausted();
+}
+
+int64 LZ4DecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool LZ4DecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again..
+        currentPos = 0;
+        helper.reset (new LZ4DecompressHelper());
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct LZ4DecompressorInputStreamTests   : public UnitTest
+{
+    LZ4DecompressorInputStreamTests()
+        : UnitTest ("LZ4DecompressorInputStreamTests", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        const MemoryBlock data ("abcdefghijklmnopqrstuvwxyz", 26);
+
+        MemoryOutputStream mo;
+        LZ4CompressorOutputStream lz4OutputStream (mo);
+        lz4OutputStream.write (data.getData(), data.getSize());
+        lz4OutputStream.flush();
+
+        MemoryInputStream mi (mo.getData(), mo.getDataSize(), false);
+        LZ4DecompressorInputStream stream (&mi, false, (int64) data.getSize());
+
+        beginTest ("Read");
+
+        expectEquals (stream.getPosition(), (int64) 0);
+        expectEquals (stream.getTotalLength(), (int64) data.getSize());
+        expectEquals (stream.getNumBytesRemaining(), stream.getTotalLength());
+        expect (! stream.isExhausted());
+
+        size_t numBytesRead = 0;
+        MemoryBlock readBuffer (data.getSize());
+
+        while (numBytesRead < data.getSize())
+        {
+            numBytesRead += (size_t) stream.read (&readBuffer[numBytesRead], 3);
+
+            expectEquals (stream.getPosition(), (int64) numBytesRead);
+            expectEquals (stream.getNumBytesRemaining(), (int64) (data.getSize() - numBytesRead));
+        }
+
+        expectEquals (stream.read (&readBuffer[0], 1), 0);
+        expectEquals (stream.getPosition(), (int64) data.getSize());
+        expectEquals (stream.getNumBytesRemaining(), (int64) 0);
+        expect (stream.isExhausted());
+        expect (! stream.hasError());
+
+        expect (readBuffer == data);
+
+        beginTest ("Skip");
+
+        stream.setPosition (0);
+        expectEquals (stream.getPosition(), (int64) 0);
+        expectEquals (stream.getTotalLength(), (int64) data.getSize());
+        expectEquals (stream.getNumBytesRemaining(), stream.getTotalLength());
+        expect (! stream.isExhausted());
+
+        numBytesRead = 0;
+        const int numBytesToSkip = 5;
+
+        while (numBytesRead < data.getSize())
+        {
+            stream.skipNextBytes (numBytesToSkip);
+            numBytesRead += numBytesToSkip;
+            numBytesRead = std::min (numBytesRead, data.getSize());
+
+            expectEquals (stream.getPosition(), (int64) numBytesRead);
+            expectEquals (stream.getNumBytesRemaining(), (int64) (data.getSize() - numBytesRead));
+        }
+
+        expectEquals (stream.getPosition(), (int64) data.getSize());
+        expectEquals (stream.getNumBytesRemaining(), (int64) 0);
+
+        beginTest ("Frames from other encoders");
+        {
+            // This is the output of the reference lz4 tool for 70 copies of a 1000-character
+            // string, using linked 64KB blocks, block checksums, the content size and a content
+            // checksum. It's followed by a skippable frame, and then a second frame containing "last".
+            const uint8 frame[] =
+            {
+                0x04, 0x22, 0x4d, 0x18, 0x5c, 0x40, 0x70, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe3, 0xf2,
+                0x04, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xdc, 0x71, 0x75, 0x7a, 0x7a, 0x70, 0x74, 0x69, 0x72,
+                0x77, 0x65, 0x74, 0x62, 0x6b, 0x65, 0x6c, 0x62, 0x68, 0x62, 0x64, 0x71, 0x6d, 0x75, 0x68, 0x70,
+                0x66, 0x79, 0x62, 0x78, 0x73, 0x65, 0x69, 0x72, 0x6b, 0x63, 0x64, 0x72, 0x6f, 0x6e, 0x72, 0x65,
+                0x6d, 0x65, 0x62, 0x6a, 0x7a, 0x79, 0x74, 0x76, 0x6d, 0x65, 0x78, 0x73, 0x73, 0x68, 0x6f, 0x61,
+                0x61, 0x66, 0x66, 0x64, 0x78, 0x66, 0x66, 0x63, 0x63, 0x72, 0x67, 0x6a, 0x64, 0x75, 0x6f, 0x63,
+                0x75, 0x6b, 0x6b, 0x6b, 0x71, 0x78, 0x6a, 0x6d, 0x74, 0x77, 0x6a, 0x77, 0x73, 0x64, 0x6c, 0x6e,
+                0x79, 0x6a, 0x69, 0x70, 0x66, 0x61, 0x62, 0x7a, 0x71, 0x64, 0x6f, 0x6a, 0x63, 0x74, 0x6f, 0x6c,
+                0x75, 0x64, 0x6b, 0x70, 0x63, 0x79, 0x7a, 0x65, 0x68, 0x75, 0x64, 0x73, 0x77, 0x61, 0x61, 0x7a,
+                0x71, 0x61, 0x67, 0x76, 0x74, 0x61, 0x62, 0x76, 0x77, 0x70, 0x78, 0x71, 0x6b, 0x69, 0x61, 0x7a,
+                0x65, 0x6b, 0x6e, 0x65, 0x78, 0x64, 0x64, 0x6a, 0x79, 0x66, 0x6f, 0x7a, 0x74, 0x62, 0x70, 0x68,
+                0x64, 0x6c, 0x64, 0x67, 0x74, 0x78, 0x6c, 0x76, 0x74, 0x74, 0x62, 0x6d, 0x77, 0x6a, 0x73, 0x6f,
+                0x79, 0x79, 0x6f, 0x6b, 0x6a, 0x70, 0x6a, 0x6c, 0x69, 0x6d, 0x6a, 0x72, 0x61, 0x73, 0x79, 0x6c,
+                0x68, 0x72, 0x7a, 0x6b, 0x68, 0x65, 0x74, 0x76, 0x79, 0x78, 0x68, 0x7a, 0x6c, 0x67, 0x76, 0x75,
+                0x62, 0x6d, 0x6d, 0x74, 0x7a, 0x6b, 0x6a, 0x73, 0x64, 0x64, 0x6f, 0x71, 0x6e, 0x6b, 0x61, 0x75,
+                0x65, 0x72, 0x64, 0x61, 0x73, 0x64, 0x73, 0x67, 0x77, 0x68, 0x63, 0x7a, 0x76, 0x68, 0x6f, 0x63,
+                0x6c, 0x75, 0x6f, 0x6b, 0x6c, 0x79, 0x64, 0x64, 0x74, 0x72, 0x67, 0x6b, 0x6d, 0x7a, 0x7a, 0x61,
+                0x61, 0x6f, 0x62, 0x73, 0x7a, 0x74, 0x72, 0x71, 0x65, 0x79, 0x74, 0x77, 0x70, 0x6e, 0x68, 0x6b,
+                0x6d, 0x6a, 0x67, 0x68, 0x7a, 0x64, 0x6c, 0x79, 0x6f, 0x6c, 0x65, 0x74, 0x67, 0x73, 0x72, 0x73,
+                0x6e, 0x70, 0x72, 0x6a, 0x6d, 0x73, 0x6e, 0x70, 0x76, 0x65, 0x6d, 0x6b, 0x76, 0x72, 0x68, 0x69,
+                0x74, 0x6c, 0x71, 0x64, 0x63, 0x76, 0x66, 0x69, 0x71, 0x67, 0x73, 0x6e, 0x68, 0x75, 0x7a, 0x63,
+                0x7a, 0x74, 0x73, 0x6a, 0x74, 0x62, 0x65, 0x78, 0x65, 0x71, 0x6a, 0x74, 0x62, 0x64, 0x65, 0x67,
+                0x76, 0x64, 0x70, 0x67, 0x62, 0x66, 0x62, 0x6b, 0x7a, 0x6e, 0x7a, 0x67, 0x6e, 0x77, 0x6f, 0x70,
+                0x6f, 0x7a, 0x6b, 0x6e, 0x6e, 0x76, 0x76, 0x71, 0x65, 0x63, 0x62, 0x79, 0x73, 0x73, 0x78, 0x75,
+                0x61, 0x6a, 0x73, 0x67, 0x61, 0x64, 0x77, 0x68, 0x78, 0x6e, 0x77, 0x62, 0x64, 0x6e, 0x67, 0x69,
+                0x67, 0x68, 0x77, 0x6d, 0x79, 0x76, 0x70, 0x6f, 0x63, 0x6a, 0x64, 0x65, 0x79, 0x79, 0x63, 0x79,
+                0x6f, 0x74, 0x63, 0x70, 0x66, 0x6b, 0x76, 0x71, 0x67, 0x70, 0x6a, 0x63, 0x72, 0x64, 0x62, 0x64,
+                0x70, 0x6b, 0x76, 0x76, 0x6d, 0x77, 0x71, 0x7a, 0x67, 0x63, 0x78, 0x6e, 0x64, 0x78, 0x61, 0x75,
+                0x70, 0x70, 0x62, 0x62, 0x77, 0x76, 0x6a, 0x62, 0x64, 0x6c, 0x64, 0x7a, 0x72, 0x6a, 0x69, 0x66,
+                0x76, 0x7a, 0x72, 0x66, 0x66, 0x6a, 0x6b, 0x6e, 0x79, 0x69, 0x75, 0x63, 0x74, 0x77, 0x63, 0x6e,
+                0x6e, 0x67, 0x77, 0x64, 0x6a, 0x77, 0x63, 0x76, 0x6a, 0x79, 0x68, 0x65, 0x67, 0x7a, 0x6c, 0x6f,
+                0x78, 0x70, 0x74, 0x67, 0x65, 0x68, 0x65, 0x63, 0x69, 0x61, 0x74, 0x6a, 0x78, 0x6b, 0x6f, 0x78,
+                0x75, 0x73, 0x69, 0x6d, 0x72, 0x74, 0x69, 0x6d, 0x67, 0x62, 0x7a, 0x62, 0x7a, 0x72, 0x6b, 0x74,
+                0x71, 0x66, 0x73, 0x64, 0x67, 0x75, 0x7a, 0x74, 0x64, 0x78, 0x62, 0x6f, 0x69, 0x64, 0x78, 0x7a,
+                0x71, 0x63, 0x66, 0x6b, 0x70, 0x75, 0x71, 0x78, 0x61, 0x74, 0x64, 0x75, 0x67, 0x73, 0x72, 0x79,
+                0x6f, 0x6d, 0x6a, 0x77, 0x69, 0x6e, 0x6d, 0x6d, 0x77, 0x75, 0x75, 0x68, 0x71, 0x69, 0x75, 0x72,
+                0x70, 0x6c, 0x73, 0x6d, 0x66, 0x6e, 0x68, 0x75, 0x71, 0x6c, 0x73, 0x78, 0x70, 0x74, 0x6a, 0x79,
+                0x68, 0x6c, 0x77, 0x6e, 0x7a, 0x6a, 0x68, 0x6e, 0x6c, 0x62, 0x71, 0x6c, 0x62, 0x74, 0x77, 0x71,
+                0x64, 0x70, 0x6e, 0x71, 0x72, 0x68, 0x61, 0x6d, 0x77, 0x6b, 0x6e, 0x6d, 0x6d, 0x6c, 0x6e, 0x75,
+                0x67, 0x76, 0x76, 0x77, 0x73, 0x6a, 0x64, 0x69, 0x61, 0x78, 0x6d, 0x67, 0x64, 0x69, 0x6a, 0x63,
+                0x6f, 0x79, 0x71, 0x69, 0x65, 0x6c, 0x6e, 0x6a, 0x63, 0x6e, 0x66, 0x70, 0x6a, 0x70, 0x68, 0x76,
+                0x70, 0x6a, 0x6c, 0x68, 0x63, 0x65, 0x76, 0x64, 0x78, 0x74, 0x78, 0x64, 0x62, 0x6f, 0x72, 0x6d,
+                0x67, 0x63, 0x75, 0x71, 0x73, 0x78, 0x61, 0x69, 0x6a, 0x63, 0x6d, 0x66, 0x72, 0x76, 0x75, 0x65,
+                0x6f, 0x76, 0x70, 0x63, 0x73, 0x70, 0x78, 0x66, 0x78, 0x71, 0x77, 0x64, 0x6b, 0x63, 0x6e, 0x79,
+                0x6a, 0x70, 0x76, 0x69, 0x6c, 0x77, 0x68, 0x72, 0x7a, 0x6b, 0x64, 0x61, 0x6e, 0x6c, 0x6e, 0x6e,
+                0x78, 0x63, 0x6f, 0x70, 0x70, 0x78, 0x77, 0x74, 0x78, 0x72, 0x76, 0x6f, 0x71, 0x70, 0x63, 0x78,
+                0x63, 0x61, 0x72, 0x61, 0x77, 0x6b, 0x77, 0x64, 0x6b, 0x76, 0x7a, 0x78, 0x7a, 0x69, 0x61, 0x66,
+                0x6e, 0x70, 0x63, 0x61, 0x74, 0x71, 0x67, 0x78, 0x62, 0x66, 0x6e, 0x6d, 0x78, 0x69, 0x79, 0x72,
+                0x79, 0x71, 0x73, 0x6a, 0x71, 0x70, 0x66, 0x79, 0x66, 0x61, 0x79, 0x7a, 0x64, 0x6f, 0x6d, 0x61,
+                0x64, 0x68, 0x78, 0x76, 0x65, 0x78, 0x68, 0x63, 0x78, 0x6c, 0x78, 0x6a, 0x6a, 0x78, 0x73, 0x6e,
+                0x71, 0x63, 0x78, 0x66, 0x6d, 0x70, 0x79, 0x62, 0x75, 0x6c, 0x6a, 0x64, 0x75, 0x67, 0x72, 0x63,
+                0x66, 0x72, 0x6e, 0x64, 0x66, 0x71, 0x67, 0x6b, 0x66, 0x64, 0x76, 0x76, 0x68, 0x71, 0x64, 0x62,
+                0x61, 0x73, 0x64, 0x6e, 0x67, 0x73, 0x66, 0x67, 0x75, 0x6e, 0x73, 0x63, 0x77, 0x72, 0x67, 0x63,
+                0x78, 0x64, 0x67, 0x61, 0x6d, 0x67, 0x78, 0x62, 0x6e, 0x71, 0x6c, 0x67, 0x68, 0x61, 0x71, 0x6a,
+                0x63, 0x68, 0x77, 0x6f, 0x77, 0x7a, 0x69, 0x6c, 0x74, 0x7a, 0x79, 0x65, 0x78, 0x68, 0x6f, 0x78,
+                0x78, 0x6f, 0x61, 0x67, 0x78, 0x72, 0x75, 0x6a, 0x67, 0x6b, 0x71, 0x75, 0x7a, 0x6a, 0x64, 0x62,
+                0x74, 0x6b, 0x74, 0x6f, 0x63, 0x6d, 0x65, 0x77, 0x64, 0x62, 0x66, 0x6b, 0x75, 0x61, 0x68, 0x71,
+                0x61, 0x61, 0x79, 0x68, 0x76, 0x79, 0x6a, 0x79, 0x68, 0x6a, 0x76, 0x73, 0x73, 0x61, 0x6f, 0x6c,
+                0x78, 0x69, 0x64, 0x6c, 0x71, 0x63, 0x71, 0x72, 0x6e, 0x67, 0x6d, 0x69, 0x72, 0x70, 0x77, 0x6d,
+                0x68, 0x75, 0x62, 0x66, 0x76, 0x6f, 0x78, 0x6f, 0x71, 0x65, 0x61, 0x75, 0x69, 0x67, 0x65, 0x65,
+                0x6d, 0x63, 0x65, 0x79, 0x66, 0x77, 0x6a, 0x62, 0x64, 0x6d, 0x6b, 0x77, 0x75, 0x6f, 0x70, 0x6e,
+                0x77, 0x61, 0x73, 0x75, 0x6e, 0x78, 0x76, 0x68, 0x76, 0x75, 0x61, 0x65, 0x6f, 0x6f, 0x6d, 0x62,
+                0x6c, 0x77, 0x66, 0x77, 0x6a, 0x63, 0x76, 0x64, 0x66, 0x61, 0x66, 0x6e, 0x71, 0x6d, 0x6a, 0x70,
+                0x72, 0x74, 0x6c, 0x6d, 0x6b, 0x73, 0x65, 0x67, 0x78, 0x78, 0x6d, 0x65, 0x6d, 0x66, 0x78, 0x77,
+                0xe8, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x50,
+                0x75, 0x67, 0x73, 0x72, 0x79, 0xad, 0x71, 0x21, 0xe0, 0x1b, 0x00, 0x00, 0x00, 0x0f, 0xe8, 0xfd,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0x69, 0x50, 0x65, 0x6d, 0x66, 0x78, 0x77, 0x4d, 0x80, 0xeb, 0x0f, 0x00, 0x00, 0x00, 0x00,
+                0xbe, 0x2e, 0xde, 0x29, 0x5f, 0x2a, 0x4d, 0x18, 0x03, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04,
+                0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x04, 0x00, 0x00, 0x80, 0x6c, 0x61, 0x73, 0x74, 0x00, 0x00,
+                0x00, 0x00, 0xf0, 0xa3, 0xbb, 0x59
+            };
+
+            String text, expected;
+            uint32 seed = 1;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                seed = seed * 1103515245u + 12345u;
+                text << (char) ('a' + (seed >> 16) % 26);
+            }
+
+            for (int i = 0; i < 70; ++i)
+                expected << text;
+
+            expected << "last";
+
+            MemoryInputStream input (frame, sizeof (frame), false);
+            LZ4DecompressorInputStream decompressor (input);
+
+            expectEquals (decompressor.readEntireStreamAsString(), expected);
+            expect (! decompressor.hasError());
+            expect (decompressor.isExhausted());
+        }
+    }
+};
+
+static LZ4DecompressorInputStreamTests lz4DecompressorInputStreamTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    This stream will decompress a source-stream that's in the LZ4 frame format.
+
+    It can read data written by an LZ4CompressorOutputStream, or by any other program
+    that writes standard LZ4 frames, using either independent or linked blocks. If the
+    frames contain block or content checksums, these are checked, and the stream stops
+    if they don't match. Concatenated frames are read one after the other, and skippable
+    frames are ignored, but frames that need an external dictionary can't be read.
+
+    Tip: if you're reading lots of small items from one of these streams, you
+         can increase the performance enormously by passing it through a
+         BufferedInputStream, so that it has to read larger blocks less often.
+
+    @see LZ4CompressorOutputStream, GZIPDecompressorInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  LZ4DecompressorInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decompressor stream.
+
+        @param sourceStream                 the stream to read from
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this object is destroyed
+        @param uncompressedStreamLength     if the creator knows the length that the
+                                            uncompressed stream will be, then it can supply this
+                                            value, which will be returned by getTotalLength()
+    */
+    LZ4DecompressorInputStream (InputStream* sourceStream,
+                                bool deleteSourceWhenDestroyed,
+                                int64 uncompressedStreamLength = -1);
+
+    /** Creates a decompressor stream.
+
+        @param sourceStream     the stream to read from - the source stream must not be
+                                deleted until this object has been destroyed
+    */
+    LZ4DecompressorInputStream (InputStream& sourceStream);
+
+    /** Destructor. */
+    ~LZ4DecompressorInputStream() override;
+
+    //==============================================================================
+    /** Returns true if the compressed data was found to be corrupted, or its checksum
+        didn't match.
+    */
+    bool hasError() const noexcept;
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> sourceStream;
+    const int64 uncompressedStreamLength;
+    int64 originalSourcePos, currentPos = 0;
+
+    class LZ4DecompressHelper;
+    std::unique_ptr<LZ4DecompressHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LZ4DecompressorInputStream)
+};
+
+} // namespace juce
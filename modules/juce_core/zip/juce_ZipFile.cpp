@@ -23,6 +23,16 @@
 namespace juce
 {
 
+namespace ZipCompressionMethod
+{
+    enum
+    {
+        stored  = 0,
+        deflate = 8,
+        zstd    = 93
+    };
+}
+
 inline uint16 readUnalignedLittleEndianShort (const void* buffer)
 {
     auto data = readUnaligned<uint16> (buffer);
@@ -39,7 +49,7 @@ struct ZipFile::ZipEntryHolder
 {
     ZipEntryHolder (const char* buffer, int fileNameLen)
     {
-        isCompressed           = readUnalignedLittleEndianShort (buffer + 10) != 0;
+        compressionMethod      = readUnalignedLittleEndianShort (buffer + 10);
         entry.fileTime         = parseFileTime (readUnalignedLittleEndianShort (buffer + 12),
                                                 readUnalignedLittleEndianShort (buffer + 14));
         compressedSize         = (int64) readUnalignedLittleEndianInt (buffer + 20);
@@ -67,7 +77,7 @@ struct ZipFile::ZipEntryHolder
 
     ZipEntry entry;
     int64 streamOffset, compressedSize;
-    bool isCompressed;
+    uint16 compressionMethod;
 };
 
 //==============================================================================
@@ -135,6 +145,15 @@ static bool hasSymbolicPart (const File& root, const File& f)
     return false;
 }
 
+static String getLocalPathForEntry (const String& entryFilename)
+{
+   #if JUCE_WINDOWS
+    return entryFilename;
+   #else
+    return entryFilename.replaceCharacter ('\\', '/');
+   #endif
+}
+
 //==============================================================================
 struct ZipFile::ZipInputStream  : public InputStream
 {
@@ -251,8 +270,15 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
     init();
 }
 
-ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
+ZipFile::ZipFile (const File& file)
+    : inputSource (new FileInputSource (file)),
+      mappedFile (std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly))
 {
+    // (if the file can't be mapped, e.g. because it's too big for a 32-bit address space,
+    // the entries are read through the input source instead)
+    if (mappedFile->getData() == nullptr)
+        mappedFile.reset();
+
     init();
 }
 
@@ -317,17 +343,51 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 
     if (auto* zei = entries[index])
     {
-        stream = new ZipInputStream (*this, *zei);
+        if (mappedFile != nullptr)
+        {
+            auto* data = static_cast<const char*> (mappedFile->getData());
+            auto dataSize = (int64) mappedFile->getSize();
+
+            if (zei->streamOffset + 30 > dataSize
+                 || readUnalignedLittleEndianInt (data + zei->streamOffset) != 0x04034b50)
+                return nullptr;
+
+            auto* header = data + zei->streamOffset;
+            auto dataStart = zei->streamOffset + 30 + readUnalignedLittleEndianShort (header + 26)
+                                                    + readUnalignedLittleEndianShort (header + 28);
 
-        if (zei->isCompressed)
+            if (dataStart + zei->compressedSize > dataSize)
+                return nullptr;
+
+            stream = new MemoryInputStream (data + dataStart, (size_t) zei->compressedSize, false);
+        }
+        else
+        {
+            stream = new ZipInputStream (*this, *zei);
+        }
+
+        if (zei->compressionMethod == ZipCompressionMethod::deflate)
         {
             stream = new GZIPDecompressorInputStream (stream, true,
                                                       GZIPDecompressorInputStream::deflateFormat,
                                                       zei->entry.uncompressedSize);
+        }
+       #if JUCE_USE_ZSTD
+        else if (zei->compressionMethod == ZipCompressionMethod::zstd)
+        {
+            stream = new ZstdDecompressorInputStream (stream, true, zei->entry.uncompressedSize);
+        }
+       #endif
+        else if (zei->compressionMethod != ZipCompressionMethod::stored)
+        {
+            // this entry uses a compression method that can't be read
+            delete stream;
+            return nullptr;
+        }
 
-            // (much faster to unzip in big blocks using a buffer..)
+        // (much faster to unzip in big blocks using a buffer..)
+        if (zei->compressionMethod != ZipCompressionMethod::stored)
             stream = new BufferedInputStream (stream, 32768, true);
-        }
     }
 
     return stream;
@@ -354,7 +414,12 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -423,12 +488,7 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool sh
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, OverwriteFiles overwriteFiles, FollowSymlinks followSymlinks)
 {
     auto* zei = entries.getUnchecked (index);
-
-   #if JUCE_WINDOWS
-    auto entryPath = zei->entry.filename;
-   #else
-    auto entryPath = zei->entry.filename.replaceCharacter ('\\', '/');
-   #endif
+    auto entryPath = getLocalPathForEntry (zei->entry.filename);
 
     if (entryPath.isEmpty())
         return Result::ok();
@@ -486,43 +546,198 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, Overwri
     return Result::ok();
 }
 
+//==============================================================================
+struct ZipExtractionTasks
+{
+    ZipExtractionTasks (ZipFile& zipFile, const File& target, std::vector<int> indexes,
+                        ZipFile::OverwriteFiles overwrite, ZipFile::FollowSymlinks symlinks)
+        : zip (zipFile), targetDirectory (target), entryIndexes (std::move (indexes)),
+          results (entryIndexes.size(), Result::ok()),
+          overwriteFiles (overwrite), followSymlinks (symlinks)
+    {
+    }
+
+    void run()
+    {
+        const auto numTasks = (int) entryIndexes.size();
+
+        for (;;)
+        {
+            auto index = nextTask++;
+
+            if (index >= numTasks)
+                return;
+
+            // once anything has failed, the remaining entries are skipped
+            if (! anyFailed)
+            {
+                auto& result = results[(size_t) index];
+                result = zip.uncompressEntry (entryIndexes[(size_t) index], targetDirectory,
+                                              overwriteFiles, followSymlinks);
+
+                if (result.failed())
+                    anyFailed = true;
+            }
+
+            if (++numTasksFinished == numTasks)
+                finished.signal();
+        }
+    }
+
+    ZipFile& zip;
+    const File targetDirectory;
+    const std::vector<int> entryIndexes;
+    std::vector<Result> results;
+    const ZipFile::OverwriteFiles overwriteFiles;
+    const ZipFile::FollowSymlinks followSymlinks;
+    std::atomic<int> nextTask { 0 }, numTasksFinished { 0 };
+    std::atomic<bool> anyFailed { false };
+    WaitableEvent finished;
+};
+
+Result ZipFile::uncompressTo (const File& targetDirectory, ThreadPool& threadPool,
+                              OverwriteFiles overwriteFiles, FollowSymlinks followSymlinks)
+{
+    std::vector<int> parallelEntries, deferredEntries;
+    std::set<String> targetPaths;
+
+    // The folders are all created here, so that the threads never race to create the same one
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        auto& entry = entries.getUnchecked (i)->entry;
+        auto entryPath = getLocalPathForEntry (entry.filename);
+
+        if (entryPath.isEmpty() || entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+        {
+            auto result = uncompressEntry (i, targetDirectory, overwriteFiles, followSymlinks);
+
+            if (result.failed())
+                return result;
+
+            continue;
+        }
+
+        auto targetFile = targetDirectory.getChildFile (entryPath);
+
+        // (paths are compared case-insensitively, in case the file system is)
+        if (entry.isSymbolicLink || ! targetPaths.insert (targetFile.getFullPathName().toLowerCase()).second)
+        {
+            deferredEntries.push_back (i);
+            continue;
+        }
+
+        if (targetFile.isAChildOf (targetDirectory))
+        {
+            auto parent = targetFile.getParentDirectory();
+
+            if (followSymlinks == FollowSymlinks::yes || ! hasSymbolicPart (targetDirectory, parent))
+                parent.createDirectory();
+        }
+
+        parallelEntries.push_back (i);
+    }
+
+    if (! parallelEntries.empty())
+    {
+        auto tasks = std::make_shared<ZipExtractionTasks> (*this, targetDirectory, std::move (parallelEntries),
+                                                           overwriteFiles, followSymlinks);
+
+        const auto numWorkers = jmin (threadPool.getNumThreads(), (int) tasks->entryIndexes.size() - 1);
+
+        for (int i = 0; i < numWorkers; ++i)
+            threadPool.addJob ([tasks] { tasks->run(); });
+
+        tasks->run();
+        tasks->finished.wait();
+
+        for (auto& result : tasks->results)
+            if (result.failed())
+                return result;
+    }
+
+    for (auto index : deferredEntries)
+    {
+        auto result = uncompressEntry (index, targetDirectory, overwriteFiles, followSymlinks);
+
+        if (result.failed())
+            return result;
+    }
+
+    return Result::ok();
+}
+
 
 //==============================================================================
 struct ZipFile::Builder::Item
 {
-    Item (const File& f, InputStream* s, int compression, const String& storedPath, Time time)
-        : file (f), stream (s), storedPathname (storedPath), fileTime (time), compressionLevel (compression)
+    Item (const File& f, InputStream* s, int compression, CompressionMethod methodToUse,
+          const String& storedPath, Time time)
+        : file (f), stream (s), storedPathname (storedPath), fileTime (time),
+          compressionLevel (compression), method (methodToUse)
     {
         symbolicLink = (file.exists() && file.isSymbolicLink());
     }
 
+    int64 getUncompressedSizeEstimate() const
+    {
+        if (symbolicLink)
+            return 0;
+
+        return stream != nullptr ? stream->getTotalLength() : file.getSize();
+    }
+
     bool writeData (OutputStream& target, const int64 overallStartPosition)
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        checksum = 0;
+        compressedSize = uncompressedSize = 0;
 
-        if (symbolicLink)
-        {
-            auto relativePath = file.getNativeLinkedTarget().replaceCharacter (File::getSeparatorChar(), L'/');
+        // If the target can't go back to fill in the header once the data has been written,
+        // the checksum and sizes have to follow the data in a data descriptor instead.
+        usesDataDescriptor = ! target.setPosition (target.getPosition());
+        headerStart = target.getPosition() - overallStartPosition;
 
-            uncompressedSize = relativePath.length();
+        target.writeInt (0x04034b50);
+        writeFlagsAndSizes (target);
+        target << storedPathname;
 
-            checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
-            compressedData << relativePath;
-        }
-        else if (compressionLevel > 0)
+        auto dataStart = target.getPosition();
+
+        if (! writeCompressedData (target))
+            return false;
+
+        auto dataEnd = target.getPosition();
+        compressedSize = dataEnd - dataStart;
+
+        if (usesDataDescriptor)
         {
-            GZIPCompressorOutputStream compressor (compressedData, compressionLevel,
-                                                   GZIPCompressorOutputStream::windowBitsRaw);
-            if (! writeSource (compressor))
-                return false;
+            target.writeInt (0x08074b50);
+            writeChecksumAndSizes (target);
+            return true;
         }
-        else
+
+        if (! target.setPosition (overallStartPosition + headerStart + 14))
+            return false;
+
+        writeChecksumAndSizes (target);
+        return target.setPosition (dataEnd);
+    }
+
+    bool compressIntoMemory()
+    {
+        bool ok;
+
         {
-            if (! writeSource (compressedData))
-                return false;
+            MemoryOutputStream out (compressedData, false);
+            ok = writeCompressedData (out);
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        compressedSize = (int64) compressedData.getSize();
+        return ok;
+    }
+
+    bool writeCompressedDataFromMemory (OutputStream& target, const int64 overallStartPosition)
+    {
+        usesDataDescriptor = false;
         headerStart = target.getPosition() - overallStartPosition;
 
         target.writeInt (0x04034b50);
@@ -530,9 +745,15 @@ struct ZipFile::Builder::Item
         target << storedPathname
                << compressedData;
 
+        releaseCompressedData();
         return true;
     }
 
+    void releaseCompressedData()
+    {
+        compressedData.reset();
+    }
+
     bool writeDirectoryEntry (OutputStream& target)
     {
         target.writeInt (0x02014b50);
@@ -553,10 +774,12 @@ private:
     std::unique_ptr<InputStream> stream;
     String storedPathname;
     Time fileTime;
+    MemoryBlock compressedData;
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
     int compressionLevel = 0;
+    CompressionMethod method;
     unsigned long checksum = 0;
-    bool symbolicLink = false;
+    bool symbolicLink = false, usesDataDescriptor = false;
 
     static void writeTimeAndDate (OutputStream& target, Time t)
     {
@@ -564,6 +787,37 @@ private:
         target.writeShort ((short) (t.getDayOfMonth() + ((t.getMonth() + 1) << 5) + ((t.getYear() - 1980) << 9)));
     }
 
+    bool writeCompressedData (OutputStream& target)
+    {
+        if (symbolicLink)
+        {
+            auto relativePath = file.getNativeLinkedTarget().replaceCharacter (File::getSeparatorChar(), L'/');
+
+            uncompressedSize = relativePath.length();
+
+            checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
+            target << relativePath;
+            return true;
+        }
+
+       #if JUCE_USE_ZSTD
+        if (compressionLevel > 0 && method == CompressionMethod::zstd)
+        {
+            ZstdCompressorOutputStream compressor (target, compressionLevel);
+            return writeSource (compressor);
+        }
+       #endif
+
+        if (compressionLevel > 0)
+        {
+            GZIPCompressorOutputStream compressor (target, compressionLevel,
+                                                   GZIPCompressorOutputStream::windowBitsRaw);
+            return writeSource (compressor);
+        }
+
+        return writeSource (target);
+    }
+
     bool writeSource (OutputStream& target)
     {
         if (stream == nullptr)
@@ -576,7 +830,7 @@ private:
 
         checksum = 0;
         uncompressedSize = 0;
-        const int bufferSize = 4096;
+        const int bufferSize = 65536;
         HeapBlock<unsigned char> buffer (bufferSize);
 
         while (! stream->isExhausted())
@@ -597,15 +851,36 @@ private:
 
     void writeFlagsAndSizes (OutputStream& target) const
     {
-        target.writeShort (10); // version needed
-        target.writeShort ((short) (1 << 11)); // this flag indicates UTF-8 filename encoding
-        target.writeShort ((! symbolicLink && compressionLevel > 0) ? (short) 8 : (short) 0); //symlink target path is not compressed
+        auto methodID = getStoredCompressionMethod();
+
+        target.writeShort (methodID == ZipCompressionMethod::zstd ? 63 : (usesDataDescriptor ? 20 : 10)); // version needed
+        target.writeShort ((short) ((1 << 11) // this flag indicates UTF-8 filename encoding
+                                     | (usesDataDescriptor ? 8 : 0)));
+        target.writeShort ((short) methodID);
         writeTimeAndDate (target, fileTime);
+        writeChecksumAndSizes (target);
+        target.writeShort (static_cast<short> (storedPathname.toUTF8().sizeInBytes() - 1));
+        target.writeShort (0); // extra field length
+    }
+
+    int getStoredCompressionMethod() const noexcept
+    {
+        if (symbolicLink || compressionLevel <= 0) //symlink target path is not compressed
+            return ZipCompressionMethod::stored;
+
+       #if JUCE_USE_ZSTD
+        if (method == CompressionMethod::zstd)
+            return ZipCompressionMethod::zstd;
+       #endif
+
+        return ZipCompressionMethod::deflate;
+    }
+
+    void writeChecksumAndSizes (OutputStream& target) const
+    {
         target.writeInt ((int) checksum);
         target.writeInt ((int) (uint32) compressedSize);
         target.writeInt ((int) (uint32) uncompressedSize);
-        target.writeShort (static_cast<short> (storedPathname.toUTF8().sizeInBytes() - 1));
-        target.writeShort (0); // extra field length
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Item)
@@ -617,7 +892,7 @@ ZipFile::Builder::~Builder() {}
 
 void ZipFile::Builder::addFile (const File& file, int compression, const String& path)
 {
-    items.add (new Item (file, nullptr, compression,
+    items.add (new Item (file, nullptr, compression, compressionMethod,
                          path.isEmpty() ? file.getFileName() : path,
                          file.getLastModificationTime()));
 }
@@ -626,7 +901,12 @@ void ZipFile::Builder::addEntry (InputStream* stream, int compression, const Str
 {
     jassert (stream != nullptr); // must not be null!
     jassert (path.isNotEmpty());
-    items.add (new Item ({}, stream, compression, path, time));
+    items.add (new Item ({}, stream, compression, compressionMethod, path, time));
+}
+
+void ZipFile::Builder::setCompressionMethod (CompressionMethod newMethod) noexcept
+{
+    compressionMethod = newMethod;
 }
 
 bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress) const
@@ -642,6 +922,124 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
             return false;
     }
 
+    if (! writeCentralDirectory (target, fileStart))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress,
+                                      ThreadPool& threadPool, int64 maxMemoryToUse) const
+{
+    struct CompressionJob
+    {
+        explicit CompressionJob (Item& itemToCompress)  : item (itemToCompress) {}
+
+        // This may be called by both a worker and the writing thread, but only the first call does anything
+        void run()
+        {
+            if (! started.exchange (true))
+            {
+                succeeded = item.compressIntoMemory();
+                finished.signal();
+            }
+        }
+
+        void cancel()
+        {
+            if (! started.exchange (true))
+                finished.signal();
+        }
+
+        Item& item;
+        std::atomic<bool> started { false };
+        bool succeeded = false;
+        WaitableEvent finished;
+    };
+
+    const auto numItems = items.size();
+    std::vector<std::shared_ptr<CompressionJob>> jobs ((size_t) numItems);
+    std::vector<int64> sizes;
+
+    for (auto* item : items)
+        sizes.push_back (item->getUncompressedSizeEstimate());
+
+    auto canBeCompressedIntoMemory = [&] (int index)
+    {
+        auto size = sizes[(size_t) index];
+        return size >= 0 && size <= maxMemoryToUse;
+    };
+
+    auto fileStart = target.getPosition();
+    int64 bytesInMemory = 0;
+    int nextJobToStart = 0;
+    bool ok = true;
+
+    for (int i = 0; i < numItems && ok; ++i)
+    {
+        // Start compressing as many of the following entries as will fit into memory..
+        for (; nextJobToStart < numItems; ++nextJobToStart)
+        {
+            if (! canBeCompressedIntoMemory (nextJobToStart))
+                continue;
+
+            auto size = sizes[(size_t) nextJobToStart];
+
+            if (bytesInMemory + size > maxMemoryToUse)
+                break;
+
+            bytesInMemory += size;
+
+            auto job = std::make_shared<CompressionJob> (*items.getUnchecked (nextJobToStart));
+            jobs[(size_t) nextJobToStart] = job;
+            threadPool.addJob ([job] { job->run(); });
+        }
+
+        if (progress != nullptr)
+            *progress = (i + 0.5) / numItems;
+
+        auto& item = *items.getUnchecked (i);
+
+        if (auto job = std::exchange (jobs[(size_t) i], nullptr))
+        {
+            // (if no worker has got around to this entry yet, it's compressed on this thread instead)
+            job->run();
+            job->finished.wait();
+            bytesInMemory -= sizes[(size_t) i];
+
+            ok = job->succeeded && item.writeCompressedDataFromMemory (target, fileStart);
+        }
+        else
+        {
+            ok = item.writeData (target, fileStart);
+        }
+    }
+
+    // The jobs refer to the items, so any that have been started must finish before this returns
+    for (auto& job : jobs)
+    {
+        if (job != nullptr)
+        {
+            job->cancel();
+            job->finished.wait();
+            job->item.releaseCompressedData();
+        }
+    }
+
+    if (! (ok && writeCentralDirectory (target, fileStart)))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeCentralDirectory (OutputStream& target, int64 fileStart) const
+{
     auto directoryStart = target.getPosition();
 
     for (auto* item : items)
@@ -659,9 +1057,6 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
     target.writeInt ((int) (directoryStart - fileStart));
     target.writeShort (0);
 
-    if (progress != nullptr)
-        *progress = 1.0;
-
     return true;
 }
 
@@ -741,8 +1136,235 @@ struct ZIPTests   : public UnitTest
         }
     }
 
+    struct NonSeekableOutputStream  : public OutputStream
+    {
+        explicit NonSeekableOutputStream (OutputStream& d)  : destination (d) {}
+
+        void flush() override                                 { destination.flush(); }
+        bool setPosition (int64) override                     { return false; }
+        int64 getPosition() override                          { return destination.getPosition(); }
+        bool write (const void* data, size_t size) override   { return destination.write (data, size); }
+
+        OutputStream& destination;
+    };
+
+    static std::vector<MemoryBlock> createRandomContents (Random& r, int numEntries, int maxSize)
+    {
+        std::vector<MemoryBlock> contents;
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            MemoryBlock block ((size_t) r.nextInt (maxSize + 1));
+
+            // (a small alphabet, so that the data is worth compressing)
+            for (size_t j = 0; j < block.getSize(); ++j)
+                block[j] = (char) ('a' + r.nextInt (4));
+
+            contents.push_back (std::move (block));
+        }
+
+        return contents;
+    }
+
+    static std::unique_ptr<ZipFile::Builder> createBuilder (const std::vector<MemoryBlock>& contents,
+                                                            const StringArray& names, int compressionLevel,
+                                                            ZipFile::Builder::CompressionMethod method = {})
+    {
+        auto builder = std::make_unique<ZipFile::Builder>();
+        builder->setCompressionMethod (method);
+
+        for (size_t i = 0; i < contents.size(); ++i)
+            builder->addEntry (new MemoryInputStream (contents[i], false), compressionLevel,
+                               names[(int) i], Time (2020, 5, 17, 12, 30, 10));
+
+        return builder;
+    }
+
+    static StringArray createNames (size_t numEntries)
+    {
+        StringArray names;
+
+        for (size_t i = 0; i < numEntries; ++i)
+            names.add ("folder" + String (i % 3) + "/entry" + String (i));
+
+        return names;
+    }
+
+    void expectEntriesMatch (ZipFile& zip, const std::vector<MemoryBlock>& contents)
+    {
+        expectEquals (zip.getNumEntries(), (int) contents.size());
+
+        for (int i = 0; i < zip.getNumEntries(); ++i)
+        {
+            std::unique_ptr<InputStream> input (zip.createStreamForEntry (i));
+            expect (input != nullptr);
+
+            if (input != nullptr)
+            {
+                MemoryBlock data;
+                input->readIntoMemoryBlock (data);
+                expect (data == contents[(size_t) i]);
+            }
+        }
+    }
+
+    void runStreamingTests (Random& r)
+    {
+        for (auto level : { 0, 9 })
+        {
+            auto contents = createRandomContents (r, 8, 20000);
+            auto names = createNames (contents.size());
+
+            MemoryBlock seekable, nonSeekable;
+
+            {
+                MemoryOutputStream out (seekable, false);
+                expect (createBuilder (contents, names, level)->writeToStream (out, nullptr));
+            }
+
+            {
+                MemoryOutputStream out (nonSeekable, false);
+                NonSeekableOutputStream wrapper (out);
+                expect (createBuilder (contents, names, level)->writeToStream (wrapper, nullptr));
+            }
+
+            // each data descriptor adds 16 bytes to an entry
+            expectEquals ((int) nonSeekable.getSize(), (int) seekable.getSize() + 16 * (int) contents.size());
+
+            for (auto* block : { &seekable, &nonSeekable })
+            {
+                MemoryInputStream mi (*block, false);
+                ZipFile zip (mi);
+                expectEntriesMatch (zip, contents);
+            }
+        }
+    }
+
+    void runParallelCompressionTests (Random& r)
+    {
+        ThreadPool pool (3);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            auto contents = createRandomContents (r, r.nextInt (30), 50000);
+            auto names = createNames (contents.size());
+            auto level = r.nextInt (10);
+
+            MemoryBlock serial, parallel;
+
+            {
+                MemoryOutputStream out (serial, false);
+                expect (createBuilder (contents, names, level)->writeToStream (out, nullptr));
+            }
+
+            {
+                // (with a small limit, some of the entries are too big to be compressed by the pool)
+                MemoryOutputStream out (parallel, false);
+                double progress = 0;
+                expect (createBuilder (contents, names, level)->writeToStream (out, &progress, pool, 40000));
+                expectEquals (progress, 1.0);
+            }
+
+            expect (serial == parallel);
+
+            MemoryInputStream mi (parallel, false);
+            ZipFile zip (mi);
+            expectEntriesMatch (zip, contents);
+        }
+    }
+
+    void runParallelExtractionTests (Random& r)
+    {
+        ThreadPool pool (3);
+
+        auto contents = createRandomContents (r, 40, 30000);
+        auto names = createNames (contents.size());
+
+        // a later entry with the same name should replace the earlier one
+        names.set (7, names[3]);
+
+        TemporaryFile zipFile;
+
+        {
+            FileOutputStream out (zipFile.getFile());
+            expect (createBuilder (contents, names, 6)->writeToStream (out, nullptr));
+        }
+
+        ZipFile zip (zipFile.getFile());
+        expectEntriesMatch (zip, contents);
+
+        TemporaryFile tmpDir;
+        expect (zip.uncompressTo (tmpDir.getFile(), pool).wasOk());
+
+        for (size_t i = 0; i < contents.size(); ++i)
+        {
+            if (i == 3)
+                continue;
+
+            MemoryBlock data;
+            expect (tmpDir.getFile().getChildFile (names[(int) i]).loadFileAsData (data));
+            expect (data == contents[i]);
+        }
+
+        tmpDir.getFile().deleteRecursively();
+
+        beginTest ("Memory-mapped entries");
+
+        TemporaryFile storedZipFile;
+
+        {
+            FileOutputStream out (storedZipFile.getFile());
+            expect (createBuilder (contents, names, 0)->writeToStream (out, nullptr));
+        }
+
+        ZipFile storedZip (storedZipFile.getFile());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto index = r.nextInt ((int) contents.size());
+            auto& expected = contents[(size_t) index];
+
+            if (expected.isEmpty())
+                continue;
+
+            std::unique_ptr<InputStream> input (storedZip.createStreamForEntry (index));
+            auto start = r.nextInt ((int) expected.getSize());
+            auto numBytes = jmin (100, (int) expected.getSize() - start);
+
+            expect (input->setPosition (start));
+
+            char buffer[100];
+            expectEquals (input->read (buffer, numBytes), numBytes);
+            expect (memcmp (buffer, expected.begin() + start, (size_t) numBytes) == 0);
+        }
+    }
+
+   #if JUCE_USE_ZSTD
+    void runZstdTests (Random& r)
+    {
+        auto contents = createRandomContents (r, 20, 50000);
+        auto names = createNames (contents.size());
+
+        for (auto level : { 0, 1, 19 })
+        {
+            MemoryBlock data;
+
+            {
+                MemoryOutputStream out (data, false);
+                expect (createBuilder (contents, names, level, ZipFile::Builder::CompressionMethod::zstd)->writeToStream (out, nullptr));
+            }
+
+            MemoryInputStream mi (data, false);
+            ZipFile zip (mi);
+            expectEntriesMatch (zip, contents);
+        }
+    }
+   #endif
+
     void runTest() override
     {
+        auto r = getRandom();
+
         beginTest ("ZIP");
 
         StringArray entryNames { "first", "second", "third" };
@@ -761,6 +1383,20 @@ struct ZIPTests   : public UnitTest
 
         beginTest ("ZipSlip");
         runZipSlipTest();
+
+        beginTest ("Streaming");
+        runStreamingTests (r);
+
+        beginTest ("Parallel compression");
+        runParallelCompressionTests (r);
+
+        beginTest ("Parallel extraction");
+        runParallelExtractionTests (r);
+
+       #if JUCE_USE_ZSTD
+        beginTest ("Zstd entries");
+        runZstdTests (r);
+       #endif
     }
 };
 
@@ -35,7 +35,13 @@ namespace juce
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile to read a specific file. */
+    /** Creates a ZipFile to read a specific file.
+
+        Where possible, the file is memory-mapped, so that the entries can be read
+        directly from the mapped memory without any locking, and streams for different
+        entries can be read on different threads at full speed. The file mustn't be
+        truncated or modified while the ZipFile exists.
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -133,6 +139,10 @@ public:
         then all the streams which are created by this method will by trying to share
         the same source stream, so cannot be safely used on  multiple threads! (But if
         you create the ZipFile from a File or InputSource, then it is safe to do this).
+
+        If the archive has been memory-mapped, the stream reads straight from the mapped
+        memory, so entries stored without compression can be read at random positions
+        very cheaply.
     */
     InputStream* createStreamForEntry (int index);
 
@@ -199,11 +209,42 @@ public:
                             OverwriteFiles overwriteFiles,
                             FollowSymlinks followSymlinks);
 
+    /** Uncompresses all of the files in the zip file, using a pool of threads.
+
+        This does the same job as the other uncompressTo() method, but the entries are
+        decompressed and written in parallel by the threads of the pool, with the calling
+        thread also taking part. The call returns once all the entries have been written.
+
+        All the folders are created before any files are written. Symbolic links, and any
+        entries which would overwrite an earlier entry's file, are written afterwards on
+        the calling thread, in the order in which they appear in the archive.
+
+        For the best performance, the ZipFile should have been created from a File or an
+        InputSource, as entries that share a user-supplied InputStream have to take turns
+        to read from it.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param threadPool           the pool whose threads should be used
+        @param overwriteFiles       whether to overwrite existing files with similarly-named ones
+        @param followSymlinks       whether to follow symlinks inside the target directory
+        @returns success if all the files are successfully unzipped, or the first error
+                 in the order of the archive's entries
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         ThreadPool& threadPool,
+                         OverwriteFiles overwriteFiles = OverwriteFiles::yes,
+                         FollowSymlinks followSymlinks = FollowSymlinks::no);
+
     //==============================================================================
     /** Used to create a new zip file.
 
         Create a ZipFile::Builder object, and call its addFile() method to add some files,
-        then you can write it to a stream with write().
+        then you can write it to a stream with writeToStream().
+
+        Each entry is compressed straight into the target stream, so the size of the
+        entries doesn't affect the amount of memory that's needed. If the target stream
+        can't seek backwards to fill in each entry's header afterwards, the sizes and
+        checksum are written in a data descriptor after the entry's data instead.
     */
     class JUCE_API  Builder
     {
@@ -240,16 +281,52 @@ public:
         void addEntry (InputStream* streamToRead, int compressionLevel,
                        const String& storedPathName, Time fileModificationTime);
 
+        /** The methods that can be used to compress the entries. */
+        enum class CompressionMethod
+        {
+            deflate,    /**< The standard zip compression, which any zip tool can read. */
+           #if JUCE_USE_ZSTD || DOXYGEN
+            zstd        /**< Much faster than deflate, at a similar ratio, but only newer zip
+                             tools can read it. This needs JUCE_USE_ZSTD to be enabled. */
+           #endif
+        };
+
+        /** Chooses the compression method for any entries that are added after this call.
+
+            The default is CompressionMethod::deflate. With the zstd method, the compression
+            levels of the entries are passed on to the ZstdCompressorOutputStream, so they
+            can range from 1 to 22, and 0 still means that an entry is stored uncompressed.
+        */
+        void setCompressionMethod (CompressionMethod newMethod) noexcept;
+
         /** Generates the zip file, writing it to the specified stream.
             If the progress parameter is non-null, it will be updated with an approximate
             progress status between 0 and 1.0
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, compressing the entries in parallel on a pool of threads.
+
+            While the calling thread writes each entry to the target in turn, the following
+            entries are compressed into memory by the threads of the pool. The total size
+            of the entries that are held in memory at once is limited to maxMemoryToUse,
+            and any entries that are larger than this are compressed by the calling thread
+            straight into the target, as they would be by the other writeToStream() method.
+
+            The archive that's produced is identical to the one that the other method
+            would write. If the progress parameter is non-null, it will be updated with an
+            approximate progress status between 0 and 1.0
+        */
+        bool writeToStream (OutputStream& target, double* progress,
+                            ThreadPool& threadPool, int64 maxMemoryToUse = 256 * 1024 * 1024) const;
+
         //==============================================================================
     private:
         struct Item;
         OwnedArray<Item> items;
+        CompressionMethod compressionMethod = CompressionMethod::deflate;
+
+        bool writeCentralDirectory (OutputStream&, int64 fileStart) const;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
@@ -264,6 +341,7 @@ private:
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -271,7 +349,7 @@ private:
         OpenStreamCounter() = default;
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        std::atomic<int> numOpenStreams { 0 };
     };
 
     OpenStreamCounter streamCounter;
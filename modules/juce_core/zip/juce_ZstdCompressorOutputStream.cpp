@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#if JUCE_USE_ZSTD
+
+#include JUCE_ZSTD_INCLUDE_PATH
+
+namespace juce
+{
+
+class ZstdCompressorOutputStream::ZstdCompressorHelper
+{
+public:
+    explicit ZstdCompressorHelper (int compressionLevel)
+        : context (ZSTD_createCCtx()),
+          buffer (ZSTD_CStreamOutSize())
+    {
+        if (context != nullptr)
+        {
+            if (compressionLevel >= 1 && compressionLevel <= ZSTD_maxCLevel())
+                ZSTD_CCtx_setParameter (context, ZSTD_c_compressionLevel, compressionLevel);
+
+            ZSTD_CCtx_setParameter (context, ZSTD_c_checksumFlag, 1);
+        }
+    }
+
+    ~ZstdCompressorHelper()
+    {
+        ZSTD_freeCCtx (context);
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a zstd stream, the frame is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        if (context == nullptr || finished)
+            return false;
+
+        ZSTD_inBuffer input { data, dataSize, 0 };
+
+        while (input.pos < input.size)
+            if (compress (input, out, ZSTD_e_continue) < 0)
+                return false;
+
+        return true;
+    }
+
+    bool finish (OutputStream& out)
+    {
+        if (context == nullptr || std::exchange (finished, true))
+            return false;
+
+        ZSTD_inBuffer input { nullptr, 0, 0 };
+
+        for (;;)
+        {
+            auto remaining = compress (input, out, ZSTD_e_end);
+
+            if (remaining <= 0)
+                return remaining == 0;
+        }
+    }
+
+private:
+    ZSTD_CCtx* context;
+    HeapBlock<uint8> buffer;
+    size_t bufferSize = ZSTD_CStreamOutSize();
+    bool finished = false;
+
+    // Returns the number of bytes that the library still has to flush, or -1 on error
+    int64 compress (ZSTD_inBuffer& input, OutputStream& out, ZSTD_EndDirective mode)
+    {
+        ZSTD_outBuffer output { buffer.getData(), bufferSize, 0 };
+        auto result = ZSTD_compressStream2 (context, &output, &input, mode);
+
+        if (ZSTD_isError (result) || (output.pos > 0 && ! out.write (buffer, output.pos)))
+            return -1;
+
+        return (int64) result;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdCompressorHelper)
+};
+
+//==============================================================================
+ZstdCompressorOutputStream::ZstdCompressorOutputStream (OutputStream& s, int compressionLevel)
+   : ZstdCompressorOutputStream (&s, compressionLevel, false)
+{
+}
+
+ZstdCompressorOutputStream::ZstdCompressorOutputStream (OutputStream* out, int compressionLevel, bool deleteDestStream)
+   : destStream (out, deleteDestStream),
+     helper (new ZstdCompressorHelper (compressionLevel))
+{
+    jassert (out != nullptr);
+}
+
+ZstdCompressorOutputStream::~ZstdCompressorOutputStream()
+{
+    flush();
+}
+
+void ZstdCompressorOutputStream::flush()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+bool ZstdCompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 ZstdCompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool ZstdCompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ZstdTests  : public UnitTest
+{
+    ZstdTests()
+        : UnitTest ("Zstd", UnitTestCategories::compression)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Zstd");
+        Random rng = getRandom();
+
+        for (int i = 100; --i >= 0;)
+        {
+            MemoryOutputStream original, compressed, uncompressed;
+
+            {
+                ZstdCompressorOutputStream compressor (compressed, rng.nextInt (20) - 1);
+
+                for (int j = rng.nextInt (100); --j >= 0;)
+                {
+                    MemoryBlock data ((unsigned int) (rng.nextInt (2000) + 1));
+
+                    for (int k = (int) data.getSize(); --k >= 0;)
+                        data[k] = (char) (rng.nextInt (3) == 0 ? 'x' : rng.nextInt (255));
+
+                    original   << data;
+                    compressor << data;
+                }
+            }
+
+            {
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                ZstdDecompressorInputStream decompressor (compressedInput);
+
+                uncompressed << decompressor;
+                expect (! decompressor.hasError());
+            }
+
+            expectEquals ((int) uncompressed.getDataSize(),
+                          (int) original.getDataSize());
+
+            if (original.getDataSize() == uncompressed.getDataSize())
+                expect (memcmp (uncompressed.getData(),
+                                original.getData(),
+                                original.getDataSize()) == 0);
+        }
+
+        beginTest ("Truncated data");
+        {
+            MemoryOutputStream compressed;
+
+            {
+                ZstdCompressorOutputStream compressor (compressed);
+
+                for (int i = 0; i < 1000; ++i)
+                    compressor << "line " << i << "\n";
+            }
+
+            MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize() - 5, false);
+            ZstdDecompressorInputStream decompressor (compressedInput);
+            decompressor.readEntireStreamAsString();
+
+            expect (decompressor.hasError());
+        }
+    }
+};
+
+static ZstdTests zstdTests;
+
+#endif
+
+} // namespace juce
+
+#endif
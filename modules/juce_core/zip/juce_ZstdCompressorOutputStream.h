@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD || DOXYGEN
+
+//==============================================================================
+/**
+    A stream which uses the zstd library to compress the data written into it.
+
+    Zstandard typically compresses about as tightly as zlib at several times the speed,
+    and its higher levels compress much more tightly. The data that's written is a
+    standard zstd frame, with a checksum of the content, which can be read by a
+    ZstdDecompressorInputStream or the zstd command-line tool.
+
+    To use this class, you need to enable JUCE_USE_ZSTD, and link your app to libzstd.
+
+    Important note: When you call flush() on a ZstdCompressorOutputStream, the frame is
+    closed - this means that no more data can be written to it, and any subsequent
+    attempts to call write() will cause an assertion.
+
+    @see ZstdDecompressorInputStream, GZIPCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ZstdCompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written
+        @param compressionLevel                 how much to compress the data, between 1 (the fastest) and
+                                                the library's maximum level, which is usually 22. Any value
+                                                outside this range indicates that the library's default
+                                                level should be used.
+    */
+    ZstdCompressorOutputStream (OutputStream& destStream,
+                                int compressionLevel = -1);
+
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written.
+                                                Ownership of this object depends on the value of deleteDestStreamWhenDestroyed
+        @param compressionLevel                 how much to compress the data, between 1 (the fastest) and
+                                                the library's maximum level, which is usually 22. Any value
+                                                outside this range indicates that the library's default
+                                                level should be used.
+        @param deleteDestStreamWhenDestroyed    whether or not the ZstdCompressorOutputStream will delete the
+                                                destStream object when it is destroyed
+    */
+    ZstdCompressorOutputStream (OutputStream* destStream,
+                                int compressionLevel = -1,
+                                bool deleteDestStreamWhenDestroyed = false);
+
+    /** Destructor. */
+    ~ZstdCompressorOutputStream() override;
+
+    //==============================================================================
+    /** Flushes and closes the stream.
+        Note that unlike most streams, when you call flush() on a ZstdCompressorOutputStream,
+        the stream is closed - this means that no more data can be written to it, and any
+        subsequent attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class ZstdCompressorHelper;
+    std::unique_ptr<ZstdCompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZstdCompressorOutputStream)
+};
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#if JUCE_USE_ZSTD
+
+namespace juce
+{
+
+class ZstdDecompressorInputStream::ZstdDecompressHelper
+{
+public:
+    ZstdDecompressHelper()
+        : context (ZSTD_createDCtx()),
+          buffer (bufferSize)
+    {
+        error = (context == nullptr);
+    }
+
+    ~ZstdDecompressHelper()
+    {
+        ZSTD_freeDCtx (context);
+    }
+
+    int read (uint8* dest, int howMany, InputStream& source)
+    {
+        ZSTD_outBuffer output { dest, (size_t) howMany, 0 };
+
+        while (output.pos < output.size && ! (error || endOfInput))
+        {
+            auto numWrittenBefore = output.pos;
+            auto numReadBefore = input.pos;
+            auto result = ZSTD_decompressStream (context, &output, &input);
+
+            if (ZSTD_isError (result))
+            {
+                error = true;
+                break;
+            }
+
+            // (the library may still be holding on to some output, even when all the input has gone)
+            if (output.pos > numWrittenBefore || input.pos > numReadBefore)
+            {
+                frameIsComplete = (result == 0);
+                continue;
+            }
+
+            auto numRead = source.read (buffer, (int) bufferSize);
+
+            if (numRead <= 0)
+            {
+                endOfInput = true;
+                error = ! frameIsComplete;
+                break;
+            }
+
+            input = { buffer.getData(), (size_t) numRead, 0 };
+        }
+
+        return (int) output.pos;
+    }
+
+    bool isFinished (InputStream& source) const
+    {
+        return error || endOfInput
+                || (frameIsComplete && input.pos == input.size && source.isExhausted());
+    }
+
+    bool error = false;
+
+private:
+    static constexpr size_t bufferSize = 32768;
+
+    ZSTD_DCtx* context;
+    HeapBlock<uint8> buffer;
+    ZSTD_inBuffer input { nullptr, 0, 0 };
+    bool endOfInput = false, frameIsComplete = true;
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdDecompressHelper)
+};
+
+//==============================================================================
+ZstdDecompressorInputStream::ZstdDecompressorInputStream (InputStream* source, bool deleteSourceWhenDestroyed,
+                                                          int64 uncompressedLength)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    uncompressedStreamLength (uncompressedLength),
+    originalSourcePos (source->getPosition()),
+    helper (new ZstdDecompressHelper())
+{
+}
+
+ZstdDecompressorInputStream::ZstdDecompressorInputStream (InputStream& source)
+  : sourceStream (&source, false),
+    uncompressedStreamLength (-1),
+    originalSourcePos (source.getPosition()),
+    helper (new ZstdDecompressHelper())
+{
+}
+
+ZstdDecompressorInputStream::~ZstdDecompressorInputStream()
+{
+}
+
+bool ZstdDecompressorInputStream::hasError() const noexcept
+{
+    return helper->error;
+}
+
+int64 ZstdDecompressorInputStream::getTotalLength()
+{
+    return uncompressedStreamLength;
+}
+
+int ZstdDecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    if (howMany <= 0)
+        return 0;
+
+    auto numRead = helper->read (static_cast<uint8*> (destBuffer), howMany, *sourceStream);
+    currentPos += numRead;
+    return numRead;
+}
+
+bool ZstdDecompressorInputStream::isExhausted()
+{
+    return helper->isFinished (*sourceStream);
+}
+
+int64 ZstdDecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool ZstdDecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again..
+        currentPos = 0;
+        helper.reset (new ZstdDecompressHelper());
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
+
+} // namespace juce
+
+#endif
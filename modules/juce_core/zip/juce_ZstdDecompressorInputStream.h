@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD || DOXYGEN
+
+//==============================================================================
+/**
+    This stream will decompress a source-stream using the zstd library.
+
+    It reads standard zstd frames, such as those written by a ZstdCompressorOutputStream
+    or the zstd command-line tool. Concatenated frames are read one after the other.
+
+    To use this class, you need to enable JUCE_USE_ZSTD, and link your app to libzstd.
+
+    Tip: if you're reading lots of small items from one of these streams, you
+         can increase the performance enormously by passing it through a
+         BufferedInputStream, so that it has to read larger blocks less often.
+
+    @see ZstdCompressorOutputStream, GZIPDecompressorInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ZstdDecompressorInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decompressor stream.
+
+        @param sourceStream                 the stream to read from
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this object is destroyed
+        @param uncompressedStreamLength     if the creator knows the length that the
+                                            uncompressed stream will be, then it can supply this
+                                            value, which will be returned by getTotalLength()
+    */
+    ZstdDecompressorInputStream (InputStream* sourceStream,
+                                 bool deleteSourceWhenDestroyed,
+                                 int64 uncompressedStreamLength = -1);
+
+    /** Creates a decompressor stream.
+
+        @param sourceStream     the stream to read from - the source stream must not be
+                                deleted until this object has been destroyed
+    */
+    ZstdDecompressorInputStream (InputStream& sourceStream);
+
+    /** Destructor. */
+    ~ZstdDecompressorInputStream() override;
+
+    //==============================================================================
+    /** Returns true if the compressed data was found to be corrupted or incomplete. */
+    bool hasError() const noexcept;
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> sourceStream;
+    const int64 uncompressedStreamLength;
+    int64 originalSourcePos, currentPos = 0;
+
+    class ZstdDecompressHelper;
+    std::unique_ptr<ZstdDecompressHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZstdDecompressorInputStream)
+};
+
+#endif
+
+} // namespace juce
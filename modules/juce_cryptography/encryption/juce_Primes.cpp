@@ -103,7 +103,7 @@ namespace PrimesHelpers
 
     static bool passesMillerRabin (const BigInteger& n, int iterations)
     {
-        const BigInteger one (1), two (2);
+        const BigInteger one (1);
         const BigInteger nMinusOne (n - one);
 
         BigInteger d (nMinusOne);
@@ -137,7 +137,8 @@ namespace PrimesHelpers
             {
                 for (int j = 0; j < s; ++j)
                 {
-                    r.exponentModulo (two, n);
+                    r *= r;
+                    r %= n;
 
                     if (r == nMinusOne)
                         break;
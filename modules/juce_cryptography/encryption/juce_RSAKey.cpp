@@ -82,7 +82,7 @@ bool RSAKey::applyToValue (BigInteger& value) const
         BigInteger remainder;
         value.divideBy (part2, remainder);
 
-        remainder.exponentModulo (part1, part2);
+        remainder.exponentModuloConstantTime (part1, part2);
 
         result += remainder;
     }
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+namespace FileHasherHelpers
+{
+    static String hashData (const void* data, size_t numBytes, FileHasher::Algorithm algorithm)
+    {
+        switch (algorithm)
+        {
+            case FileHasher::Algorithm::md5:      return MD5 (data, numBytes).toHexString();
+            case FileHasher::Algorithm::sha256:   return SHA256 (data, numBytes).toHexString();
+            case FileHasher::Algorithm::xxHash3:  return XXHash3::toHexString (XXHash3::hash (data, numBytes));
+        }
+
+        jassertfalse;
+        return {};
+    }
+
+    static String hashStream (InputStream& input, FileHasher::Algorithm algorithm)
+    {
+        switch (algorithm)
+        {
+            case FileHasher::Algorithm::md5:      return MD5 (input).toHexString();
+            case FileHasher::Algorithm::sha256:   return SHA256 (input).toHexString();
+            case FileHasher::Algorithm::xxHash3:  return XXHash3::toHexString (XXHash3::hash (input));
+        }
+
+        jassertfalse;
+        return {};
+    }
+}
+
+//==============================================================================
+FileHasher::FileHasher (WorkStealingThreadPool& p)  : pool (p) {}
+
+String FileHasher::hashFile (const File& file, Algorithm algorithm)
+{
+    {
+        MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() != nullptr)
+            return FileHasherHelpers::hashData (mappedFile.getData(), mappedFile.getSize(), algorithm);
+    }
+
+    // Empty files, and things like pipes, can't be mapped
+    FileInputStream fin (file);
+
+    if (fin.openedOk())
+        return FileHasherHelpers::hashStream (fin, algorithm);
+
+    return {};
+}
+
+std::vector<FileHasher::Result> FileHasher::hashFiles (const Array<File>& files, Algorithm algorithm)
+{
+    std::vector<Result> results ((size_t) files.size());
+
+    pool.parallelFor (0, files.size(), [&] (int i)
+    {
+        auto& result = results[(size_t) i];
+        result.file = files.getReference (i);
+        result.hash = hashFile (result.file, algorithm);
+    }, 1);
+
+    return results;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FileHasherTests  : public UnitTest
+{
+public:
+    FileHasherTests()
+        : UnitTest ("FileHasher", UnitTestCategories::cryptography)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFolder;
+        auto folder = tempFolder.getFile();
+        folder.createDirectory();
+
+        auto random = getRandom();
+        Array<File> files;
+        Array<MemoryBlock> contents;
+
+        for (auto size : { 0, 1, 63, 64, 65, 1000, 100000, 1 << 20 })
+        {
+            MemoryBlock data ((size_t) size);
+
+            for (size_t i = 0; i < data.getSize(); ++i)
+                data[i] = (char) random.nextInt (256);
+
+            auto file = folder.getChildFile ("file" + String (size));
+
+            if (data.isEmpty())
+                file.create();
+            else
+                file.replaceWithData (data.getData(), data.getSize());
+
+            files.add (file);
+            contents.add (data);
+        }
+
+        files.add (folder.getChildFile ("doesNotExist"));
+
+        WorkStealingThreadPool pool (4);
+        FileHasher hasher (pool);
+
+        beginTest ("Hashes match the in-memory hashes");
+        {
+            for (auto algorithm : { FileHasher::Algorithm::md5, FileHasher::Algorithm::sha256, FileHasher::Algorithm::xxHash3 })
+            {
+                auto results = hasher.hashFiles (files, algorithm);
+                expectEquals ((int) results.size(), files.size());
+
+                for (int i = 0; i < contents.size(); ++i)
+                {
+                    auto& data = contents.getReference (i);
+                    expect (results[(size_t) i].file == files[i]);
+                    expectEquals (results[(size_t) i].hash, FileHasherHelpers::hashData (data.getData(), data.getSize(), algorithm));
+                }
+
+                expect (results.back().hash.isEmpty());
+            }
+        }
+
+        beginTest ("File constructors use the same hashes");
+        {
+            auto& data = contents.getReference (contents.size() - 1);
+            auto& file = files.getReference (contents.size() - 1);
+
+            expect (SHA256 (file) == SHA256 (data));
+            expect (MD5 (file) == MD5 (data));
+            expectEquals (XXHash3::hash (file), XXHash3::hash (data));
+        }
+
+        folder.deleteRecursively();
+    }
+};
+
+static FileHasherTests fileHasherTests;
+
+#endif
+
+} // namespace juce
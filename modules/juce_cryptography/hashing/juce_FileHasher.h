@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    Calculates the hashes of files, spreading the work for a list of files across
+    the threads of a WorkStealingThreadPool.
+
+    Each file is memory-mapped where possible, so the data is hashed straight out of
+    the page cache without being copied into a buffer first. Files that can't be
+    mapped are read through a FileInputStream instead.
+
+    A single file is always hashed on one thread, because none of these algorithms
+    can be split up, so the speed-up comes from hashing several files at once.
+
+    @code
+    WorkStealingThreadPool pool;
+    FileHasher hasher (pool);
+
+    for (auto& result : hasher.hashFiles (downloads, FileHasher::Algorithm::sha256))
+        if (result.hash != expectedHashes[result.file.getFileName()])
+            DBG ("Corrupt download: " + result.file.getFullPathName());
+    @endcode
+
+    @see SHA256, MD5, XXHash3, WorkStealingThreadPool
+
+    @tags{Cryptography}
+*/
+class JUCE_API  FileHasher
+{
+public:
+    //==============================================================================
+    /** The hash functions that a FileHasher can use. */
+    enum class Algorithm
+    {
+        md5,        /**< A 32-digit MD5 checksum. */
+        sha256,     /**< A 64-digit SHA-256 hash. */
+        xxHash3     /**< A 16-digit XXH3 hash, which is much faster but not cryptographically secure. */
+    };
+
+    /** The hash of one file. */
+    struct Result
+    {
+        File file;
+
+        /** The hash as a lower-case hex string, or an empty string if the file couldn't be read. */
+        String hash;
+    };
+
+    //==============================================================================
+    /** Creates a hasher which will run its jobs on the given pool. */
+    explicit FileHasher (WorkStealingThreadPool& pool);
+
+    /** Hashes a list of files, and returns once they've all been done.
+
+        The results are in the same order as the files that were passed in. While it's
+        waiting, the calling thread helps with the work.
+    */
+    std::vector<Result> hashFiles (const Array<File>& files, Algorithm algorithm);
+
+    /** Hashes a single file on the calling thread.
+        @returns the hash as a lower-case hex string, or an empty string if the file
+                 couldn't be read
+    */
+    static String hashFile (const File& file, Algorithm algorithm);
+
+private:
+    //==============================================================================
+    WorkStealingThreadPool& pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileHasher)
+};
+
+} // namespace juce
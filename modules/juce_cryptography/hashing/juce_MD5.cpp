@@ -220,6 +220,16 @@ MD5::MD5 (InputStream& input, int64 numBytesToRead)
 
 MD5::MD5 (const File& file)
 {
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        MD5Generator generator;
+        generator.processBlock (mappedFile.getData(), mappedFile.getSize());
+        generator.finish (result);
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.openedOk())
@@ -233,10 +243,12 @@ void MD5::processStream (InputStream& input, int64 numBytesToRead)
     if (numBytesToRead < 0)
         numBytesToRead = std::numeric_limits<int64>::max();
 
+    constexpr int bufferSize = 65536;
+    HeapBlock<uint8_t> tempBuffer (bufferSize);
+
     while (numBytesToRead > 0)
     {
-        uint8_t tempBuffer[512];
-        auto bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) sizeof (tempBuffer)));
+        auto bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) bufferSize));
 
         if (bytesRead <= 0)
             break;
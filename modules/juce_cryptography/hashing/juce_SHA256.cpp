@@ -26,12 +26,11 @@
 namespace juce
 {
 
-struct SHA256Processor
+namespace SHA256Helpers
 {
-    // expects 64 bytes of data
-    void processFullBlock (const void* data) noexcept
+    static const uint32_t* getRoundConstants() noexcept
     {
-        const uint32_t constants[] =
+        alignas (16) static const uint32_t constants[] =
         {
             0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
             0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
@@ -43,34 +42,151 @@ struct SHA256Processor
             0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
         };
 
-        uint32_t block[16], s[8];
-        memcpy (s, state, sizeof (s));
+        return constants;
+    }
 
-        auto d = static_cast<const uint8_t*> (data);
+   #if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH
+    static bool canUseSHAExtensions() noexcept
+    {
+        return SystemStats::hasSHA() && SystemStats::hasSSE41();
+    }
 
-        for (auto& b : block)
+    JUCE_BEGIN_TARGET_INSTRUCTION_SET ("sha,sse4.1")
+    namespace IntelSHA
+    {
+        static forcedinline void fourRounds (__m128i& abef, __m128i& cdgh, __m128i w, const uint32_t* k) noexcept
         {
-            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
-            d += 4;
+            auto wk = _mm_add_epi32 (w, _mm_load_si128 (reinterpret_cast<const __m128i*> (k)));
+            cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, wk);
+            abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (wk, 0x0e));
         }
 
-        auto convolve = [&] (uint32_t i, uint32_t j)
+        static forcedinline __m128i loadWords (const uint8_t* data, __m128i byteSwap) noexcept
         {
-            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
-                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
-                                           : block[i]);
-            s[(3 - i) & 7] += s[(7 - i) & 7];
-            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
-        };
+            return _mm_shuffle_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (data)), byteSwap);
+        }
 
-        for (uint32_t j = 0; j < 64; j += 16)
-            for (uint32_t i = 0; i < 16; ++i)
-                convolve (i, j);
+        // Computes w[t + 16 .. t + 19] from w[t .. t + 15]
+        static forcedinline __m128i nextWords (__m128i w0, __m128i w1, __m128i w2, __m128i w3) noexcept
+        {
+            return _mm_sha256msg2_epu32 (_mm_add_epi32 (_mm_sha256msg1_epu32 (w0, w1),
+                                                        _mm_alignr_epi8 (w3, w2, 4)), w3);
+        }
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+        static void processBlocks (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+        {
+            auto k = getRoundConstants();
+            auto byteSwap = _mm_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+            // The SHA instructions work on the state rearranged into ABEF and CDGH halves
+            auto cdab = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state)), 0xb1);
+            auto efgh = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state + 4)), 0x1b);
+            auto abef = _mm_alignr_epi8 (cdab, efgh, 8);
+            auto cdgh = _mm_blend_epi16 (efgh, cdab, 0xf0);
+
+            for (; numBlocks > 0; --numBlocks, data += 64)
+            {
+                auto abefStart = abef, cdghStart = cdgh;
+                auto w0 = loadWords (data,      byteSwap);
+                auto w1 = loadWords (data + 16, byteSwap);
+                auto w2 = loadWords (data + 32, byteSwap);
+                auto w3 = loadWords (data + 48, byteSwap);
+
+                for (int i = 0; i < 64; i += 16)
+                {
+                    fourRounds (abef, cdgh, w0, k + i);
+                    fourRounds (abef, cdgh, w1, k + i + 4);
+                    fourRounds (abef, cdgh, w2, k + i + 8);
+                    fourRounds (abef, cdgh, w3, k + i + 12);
+
+                    if (i < 48)
+                    {
+                        w0 = nextWords (w0, w1, w2, w3);
+                        w1 = nextWords (w1, w2, w3, w0);
+                        w2 = nextWords (w2, w3, w0, w1);
+                        w3 = nextWords (w3, w0, w1, w2);
+                    }
+                }
+
+                abef = _mm_add_epi32 (abef, abefStart);
+                cdgh = _mm_add_epi32 (cdgh, cdghStart);
+            }
 
-        length += 64;
+            auto feba = _mm_shuffle_epi32 (abef, 0x1b);
+            auto dchg = _mm_shuffle_epi32 (cdgh, 0xb1);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (state),     _mm_blend_epi16 (feba, dchg, 0xf0));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (state + 4), _mm_alignr_epi8 (dchg, feba, 8));
+        }
+    }
+    JUCE_END_TARGET_INSTRUCTION_SET
+   #endif
+
+   #if JUCE_CRYPTOGRAPHY_USE_ARM_SHA2
+    namespace ArmSHA
+    {
+        static void processBlocks (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+        {
+            auto k = getRoundConstants();
+            auto abcd = vld1q_u32 (state);
+            auto efgh = vld1q_u32 (state + 4);
+
+            for (; numBlocks > 0; --numBlocks, data += 64)
+            {
+                auto abcdStart = abcd, efghStart = efgh;
+                uint32x4_t w[4];
+
+                for (int i = 0; i < 4; ++i)
+                    w[i] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * i)));
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    auto wk = vaddq_u32 (w[i & 3], vld1q_u32 (k + 4 * i));
+
+                    if (i < 12)
+                        w[i & 3] = vsha256su1q_u32 (vsha256su0q_u32 (w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+
+                    auto abcdPrevious = abcd;
+                    abcd = vsha256hq_u32 (abcd, efgh, wk);
+                    efgh = vsha256h2q_u32 (efgh, abcdPrevious, wk);
+                }
+
+                abcd = vaddq_u32 (abcd, abcdStart);
+                efgh = vaddq_u32 (efgh, efghStart);
+            }
+
+            vst1q_u32 (state, abcd);
+            vst1q_u32 (state + 4, efgh);
+        }
+    }
+   #endif
+}
+
+//==============================================================================
+struct SHA256Processor
+{
+    // expects a multiple of 64 bytes of data
+    void processFullBlocks (const void* data, size_t numBlocks) noexcept
+    {
+        auto d = static_cast<const uint8_t*> (data);
+
+        if (! processWithExtensions (d, numBlocks))
+            for (size_t i = 0; i < numBlocks; ++i)
+                processBlockScalar (d + 64 * i);
+
+        length += 64 * (uint64_t) numBlocks;
+    }
+
+    void processFullBlock (const void* data) noexcept
+    {
+        processFullBlocks (data, 1);
+    }
+
+    void processData (const void* data, size_t numBytes, uint8_t* result) noexcept
+    {
+        auto numBlocks = numBytes / 64;
+        processFullBlocks (data, numBlocks);
+        processFinalBlock (static_cast<const uint8_t*> (data) + numBlocks * 64, (uint32_t) (numBytes % 64));
+        copyResult (result);
     }
 
     void processFinalBlock (const void* data, uint32_t numBytes) noexcept
@@ -115,29 +231,92 @@ struct SHA256Processor
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64_t>::max();
 
+        constexpr int bufferSize = 65536;
+        HeapBlock<uint8_t> buffer (bufferSize);
+
         for (;;)
         {
-            uint8_t buffer[64];
-            auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64_t) sizeof (buffer)));
+            auto numToRead = (int) jmin (numBytesToRead, (int64_t) bufferSize);
+            int bytesRead = 0;
 
-            if (bytesRead < (int) sizeof (buffer))
+            while (bytesRead < numToRead)
             {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
-                break;
+                auto n = input.read (buffer + bytesRead, numToRead - bytesRead);
+
+                if (n <= 0)
+                    break;
+
+                bytesRead += n;
             }
 
-            numBytesToRead -= (int64_t) sizeof (buffer);
-            processFullBlock (buffer);
-        }
+            if (bytesRead < bufferSize)
+            {
+                processData (buffer, (size_t) bytesRead, result);
+                return;
+            }
 
-        copyResult (result);
+            numBytesToRead -= bytesRead;
+            processFullBlocks (buffer, bufferSize / 64);
+        }
     }
 
+    bool allowExtensions = true;
+
 private:
     uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
     uint64_t length = 0;
 
+    bool processWithExtensions (const uint8_t* data, size_t numBlocks) noexcept
+    {
+       #if JUCE_CRYPTOGRAPHY_USE_ARM_SHA2
+        if (allowExtensions)
+        {
+            SHA256Helpers::ArmSHA::processBlocks (state, data, numBlocks);
+            return true;
+        }
+       #elif JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH
+        if (allowExtensions && SHA256Helpers::canUseSHAExtensions())
+        {
+            SHA256Helpers::IntelSHA::processBlocks (state, data, numBlocks);
+            return true;
+        }
+       #else
+        ignoreUnused (data, numBlocks);
+       #endif
+
+        return false;
+    }
+
+    void processBlockScalar (const uint8_t* d) noexcept
+    {
+        auto constants = SHA256Helpers::getRoundConstants();
+        uint32_t block[16], s[8];
+        memcpy (s, state, sizeof (s));
+
+        for (auto& b : block)
+        {
+            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
+            d += 4;
+        }
+
+        auto convolve = [&] (uint32_t i, uint32_t j)
+        {
+            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
+                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
+                                           : block[i]);
+            s[(3 - i) & 7] += s[(7 - i) & 7];
+            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
+        };
+
+        for (uint32_t j = 0; j < 64; j += 16)
+            for (uint32_t i = 0; i < 16; ++i)
+                convolve (i, j);
+
+        for (int i = 0; i < 8; ++i)
+            state[i] += s[i];
+    }
+
     static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
     static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
     static uint32_t maj (uint32_t x, uint32_t y, uint32_t z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
@@ -172,6 +351,15 @@ SHA256::SHA256 (InputStream& input, int64 numBytesToRead)
 
 SHA256::SHA256 (const File& file)
 {
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        SHA256Processor processor;
+        processor.processData (mappedFile.getData(), mappedFile.getSize(), result);
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.getStatus().wasOk())
@@ -193,9 +381,8 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.processData (data, numBytes, result);
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -249,6 +436,32 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+
+        beginTest ("Hardware and portable implementations match");
+        {
+            auto random = getRandom();
+            MemoryBlock data (5000);
+
+            for (size_t i = 0; i < data.getSize(); ++i)
+                data[i] = (char) random.nextInt (256);
+
+            for (size_t numBytes : { (size_t) 0, (size_t) 55, (size_t) 56, (size_t) 64, (size_t) 119, (size_t) 1000, data.getSize() })
+            {
+                uint8_t portable[32], accelerated[32];
+
+                SHA256Processor portableProcessor;
+                portableProcessor.allowExtensions = false;
+                portableProcessor.processData (data.getData(), numBytes, portable);
+
+                SHA256Processor acceleratedProcessor;
+                acceleratedProcessor.processData (data.getData(), numBytes, accelerated);
+
+                expect (memcmp (portable, accelerated, sizeof (portable)) == 0);
+            }
+
+            MemoryInputStream m (data, false);
+            expect (SHA256 (m) == SHA256 (data));
+        }
     }
 };
 
@@ -73,8 +73,9 @@ public:
     SHA256 (InputStream& input, int64 maxBytesToRead = -1);
 
     /** Reads a file and generates the hash of its contents.
-        If the file can't be opened, the hash will be left uninitialised (i.e. full
-        of zeros).
+        The file is memory-mapped where possible, so it mustn't be truncated by another
+        process while it's being hashed. If the file can't be opened, the hash will be
+        left uninitialised (i.e. full of zeros).
     */
     explicit SHA256 (const File& file);
 
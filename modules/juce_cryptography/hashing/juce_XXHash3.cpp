@@ -0,0 +1,671 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+namespace XXHash3Helpers
+{
+    constexpr uint32 prime32_1 = 0x9e3779b1U;
+    constexpr uint32 prime32_2 = 0x85ebca77U;
+    constexpr uint32 prime32_3 = 0xc2b2ae3dU;
+    constexpr uint64 prime64_1 = 0x9e3779b185ebca87ULL;
+    constexpr uint64 prime64_2 = 0xc2b2ae3d27d4eb4fULL;
+    constexpr uint64 prime64_3 = 0x165667b19e3779f9ULL;
+    constexpr uint64 prime64_4 = 0x85ebca77c2b2ae63ULL;
+    constexpr uint64 prime64_5 = 0x27d4eb2f165667c5ULL;
+    constexpr uint64 primeMx1  = 0x165667919e3779f9ULL;
+    constexpr uint64 primeMx2  = 0x9fb21c651e98df25ULL;
+
+    constexpr size_t stripeLength = 64;
+    constexpr size_t secretSize = 192;
+    constexpr size_t secretLimit = secretSize - stripeLength;
+    constexpr size_t stripesPerBlock = secretLimit / 8;
+    constexpr size_t midSizeMax = 240;
+
+    alignas (64) static const uint8 defaultSecret[secretSize] =
+    {
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+    };
+
+    static forcedinline uint64 read64 (const uint8* p) noexcept    { return ByteOrder::littleEndianInt64 (p); }
+    static forcedinline uint32 read32 (const uint8* p) noexcept    { return ByteOrder::littleEndianInt (p); }
+    static forcedinline uint64 rotl64 (uint64 x, int r) noexcept   { return (x << r) | (x >> (64 - r)); }
+    static forcedinline uint64 xorShift (uint64 x, int s) noexcept { return x ^ (x >> s); }
+
+    static forcedinline uint64 multiplyAndFold (uint64 a, uint64 b) noexcept
+    {
+       #if (JUCE_GCC || JUCE_CLANG) && defined (__SIZEOF_INT128__)
+        __extension__ using uint128 = unsigned __int128;
+        auto product = (uint128) a * b;
+        return (uint64) product ^ (uint64) (product >> 64);
+       #elif JUCE_MSVC && JUCE_INTEL && JUCE_64BIT
+        uint64 high;
+        auto low = _umul128 (a, b, &high);
+        return low ^ high;
+       #else
+        auto lowLow   = (a & 0xffffffff) * (b & 0xffffffff);
+        auto highLow  = (a >> 32)        * (b & 0xffffffff);
+        auto lowHigh  = (a & 0xffffffff) * (b >> 32);
+        auto highHigh = (a >> 32)        * (b >> 32);
+        auto cross    = (lowLow >> 32) + (highLow & 0xffffffff) + lowHigh;
+        auto upper    = (highLow >> 32) + (cross >> 32) + highHigh;
+        auto lower    = (cross << 32) | (lowLow & 0xffffffff);
+        return lower ^ upper;
+       #endif
+    }
+
+    static uint64 avalanche (uint64 h) noexcept
+    {
+        return xorShift (xorShift (h, 37) * primeMx1, 32);
+    }
+
+    static uint64 avalancheXXH64 (uint64 h) noexcept
+    {
+        h = xorShift (h, 33) * prime64_2;
+        h = xorShift (h, 29) * prime64_3;
+        return xorShift (h, 32);
+    }
+
+    static uint64 rrmxmx (uint64 h, uint64 length) noexcept
+    {
+        h ^= rotl64 (h, 49) ^ rotl64 (h, 24);
+        h *= primeMx2;
+        h ^= (h >> 35) + length;
+        h *= primeMx2;
+        return xorShift (h, 28);
+    }
+
+    static forcedinline uint64 mix16 (const uint8* input, const uint8* sec, uint64 seed) noexcept
+    {
+        return multiplyAndFold (read64 (input)     ^ (read64 (sec)     + seed),
+                                read64 (input + 8) ^ (read64 (sec + 8) - seed));
+    }
+
+    //==============================================================================
+    static uint64 hashUpTo16 (const uint8* input, size_t length, const uint8* sec, uint64 seed) noexcept
+    {
+        if (length > 8)
+        {
+            auto low  = read64 (input)              ^ ((read64 (sec + 24) ^ read64 (sec + 32)) + seed);
+            auto high = read64 (input + length - 8) ^ ((read64 (sec + 40) ^ read64 (sec + 48)) - seed);
+            return avalanche (length + ByteOrder::swap (low) + high + multiplyAndFold (low, high));
+        }
+
+        if (length >= 4)
+        {
+            seed ^= (uint64) ByteOrder::swap ((uint32) seed) << 32;
+            auto combined = read32 (input + length - 4) + ((uint64) read32 (input) << 32);
+            return rrmxmx (combined ^ ((read64 (sec + 8) ^ read64 (sec + 16)) - seed), length);
+        }
+
+        if (length > 0)
+        {
+            auto combined = ((uint32) input[0] << 16) | ((uint32) input[length >> 1] << 24)
+                          | (uint32) input[length - 1] | ((uint32) length << 8);
+            return avalancheXXH64 ((uint64) combined ^ ((uint64) (read32 (sec) ^ read32 (sec + 4)) + seed));
+        }
+
+        return avalancheXXH64 (seed ^ (read64 (sec + 56) ^ read64 (sec + 64)));
+    }
+
+    static uint64 hashUpTo128 (const uint8* input, size_t length, const uint8* sec, uint64 seed) noexcept
+    {
+        auto acc = length * prime64_1;
+
+        if (length > 32)
+        {
+            if (length > 64)
+            {
+                if (length > 96)
+                {
+                    acc += mix16 (input + 48, sec + 96, seed);
+                    acc += mix16 (input + length - 64, sec + 112, seed);
+                }
+
+                acc += mix16 (input + 32, sec + 64, seed);
+                acc += mix16 (input + length - 48, sec + 80, seed);
+            }
+
+            acc += mix16 (input + 16, sec + 32, seed);
+            acc += mix16 (input + length - 32, sec + 48, seed);
+        }
+
+        acc += mix16 (input, sec, seed);
+        acc += mix16 (input + length - 16, sec + 16, seed);
+        return avalanche (acc);
+    }
+
+    static uint64 hashUpTo240 (const uint8* input, size_t length, const uint8* sec, uint64 seed) noexcept
+    {
+        auto acc = length * prime64_1;
+
+        for (size_t i = 0; i < 8; ++i)
+            acc += mix16 (input + 16 * i, sec + 16 * i, seed);
+
+        acc = avalanche (acc);
+        auto accEnd = mix16 (input + length - 16, sec + 136 - 17, seed);
+
+        for (size_t i = 8; i < length / 16; ++i)
+            accEnd += mix16 (input + 16 * i, sec + 16 * (i - 8) + 3, seed);
+
+        return avalanche (acc + accEnd);
+    }
+
+    static uint64 hashShort (const uint8* input, size_t length, uint64 seed) noexcept
+    {
+        jassert (length <= midSizeMax);
+
+        if (length <= 16)   return hashUpTo16  (input, length, defaultSecret, seed);
+        if (length <= 128)  return hashUpTo128 (input, length, defaultSecret, seed);
+
+        return hashUpTo240 (input, length, defaultSecret, seed);
+    }
+
+    //==============================================================================
+    // The long-input loop spends all its time in these two functions, which each
+    // have a scalar version and vectorised ones that are picked at runtime.
+    using AccumulateFn = void (*) (uint64* acc, const uint8* input, const uint8* sec, size_t numStripes);
+    using ScrambleFn   = void (*) (uint64* acc, const uint8* sec);
+
+    struct Scalar
+    {
+        static void accumulate (uint64* acc, const uint8* input, const uint8* sec, size_t numStripes) noexcept
+        {
+            for (size_t n = 0; n < numStripes; ++n, input += stripeLength, sec += 8)
+            {
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    auto value = read64 (input + 8 * i);
+                    auto key = value ^ read64 (sec + 8 * i);
+                    acc[i ^ 1] += value;
+                    acc[i] += (key & 0xffffffff) * (key >> 32);
+                }
+            }
+        }
+
+        static void scramble (uint64* acc, const uint8* sec) noexcept
+        {
+            for (size_t i = 0; i < 8; ++i)
+                acc[i] = (xorShift (acc[i], 47) ^ read64 (sec + 8 * i)) * prime32_1;
+        }
+    };
+
+   #if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH && JUCE_64BIT
+    struct SSE2
+    {
+        static void accumulate (uint64* acc, const uint8* input, const uint8* sec, size_t numStripes) noexcept
+        {
+            auto xacc = reinterpret_cast<__m128i*> (acc);
+            __m128i a[4] = { xacc[0], xacc[1], xacc[2], xacc[3] };
+
+            for (size_t n = 0; n < numStripes; ++n, input += stripeLength, sec += 8)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    auto value = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input) + i);
+                    auto key = _mm_xor_si128 (value, _mm_loadu_si128 (reinterpret_cast<const __m128i*> (sec) + i));
+                    auto product = _mm_mul_epu32 (key, _mm_srli_epi64 (key, 32));
+                    a[i] = _mm_add_epi64 (_mm_add_epi64 (a[i], _mm_shuffle_epi32 (value, _MM_SHUFFLE (1, 0, 3, 2))), product);
+                }
+            }
+
+            for (int i = 0; i < 4; ++i)
+                xacc[i] = a[i];
+        }
+
+        static void scramble (uint64* acc, const uint8* sec) noexcept
+        {
+            auto xacc = reinterpret_cast<__m128i*> (acc);
+            auto prime = _mm_set1_epi32 ((int) prime32_1);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                auto value = _mm_xor_si128 (xacc[i], _mm_srli_epi64 (xacc[i], 47));
+                auto key = _mm_xor_si128 (value, _mm_loadu_si128 (reinterpret_cast<const __m128i*> (sec) + i));
+                auto low  = _mm_mul_epu32 (key, prime);
+                auto high = _mm_mul_epu32 (_mm_srli_epi64 (key, 32), prime);
+                xacc[i] = _mm_add_epi64 (low, _mm_slli_epi64 (high, 32));
+            }
+        }
+    };
+   #endif
+
+   #if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH
+    JUCE_BEGIN_TARGET_INSTRUCTION_SET ("avx2")
+    struct AVX2
+    {
+        static void accumulate (uint64* acc, const uint8* input, const uint8* sec, size_t numStripes) noexcept
+        {
+            auto xacc = reinterpret_cast<__m256i*> (acc);
+            auto a0 = _mm256_load_si256 (xacc), a1 = _mm256_load_si256 (xacc + 1);
+
+            for (size_t n = 0; n < numStripes; ++n, input += stripeLength, sec += 8)
+            {
+                auto in = reinterpret_cast<const __m256i*> (input);
+                auto key = reinterpret_cast<const __m256i*> (sec);
+                a0 = accumulateLane (a0, _mm256_loadu_si256 (in),     _mm256_loadu_si256 (key));
+                a1 = accumulateLane (a1, _mm256_loadu_si256 (in + 1), _mm256_loadu_si256 (key + 1));
+            }
+
+            _mm256_store_si256 (xacc, a0);
+            _mm256_store_si256 (xacc + 1, a1);
+        }
+
+        static void scramble (uint64* acc, const uint8* sec) noexcept
+        {
+            auto xacc = reinterpret_cast<__m256i*> (acc);
+            auto prime = _mm256_set1_epi32 ((int) prime32_1);
+
+            for (int i = 0; i < 2; ++i)
+            {
+                auto a = _mm256_load_si256 (xacc + i);
+                auto value = _mm256_xor_si256 (a, _mm256_srli_epi64 (a, 47));
+                auto key = _mm256_xor_si256 (value, _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (sec) + i));
+                auto low  = _mm256_mul_epu32 (key, prime);
+                auto high = _mm256_mul_epu32 (_mm256_srli_epi64 (key, 32), prime);
+                _mm256_store_si256 (xacc + i, _mm256_add_epi64 (low, _mm256_slli_epi64 (high, 32)));
+            }
+        }
+
+        static forcedinline __m256i accumulateLane (__m256i a, __m256i value, __m256i secretKey) noexcept
+        {
+            auto key = _mm256_xor_si256 (value, secretKey);
+            auto product = _mm256_mul_epu32 (key, _mm256_srli_epi64 (key, 32));
+            return _mm256_add_epi64 (_mm256_add_epi64 (a, _mm256_shuffle_epi32 (value, _MM_SHUFFLE (1, 0, 3, 2))), product);
+        }
+    };
+    JUCE_END_TARGET_INSTRUCTION_SET
+   #endif
+
+    struct Kernels
+    {
+        AccumulateFn accumulate;
+        ScrambleFn scramble;
+    };
+
+    static Kernels getKernels() noexcept
+    {
+       #if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH
+        if (SystemStats::hasAVX2())
+            return { AVX2::accumulate, AVX2::scramble };
+       #endif
+
+       #if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH && JUCE_64BIT
+        return { SSE2::accumulate, SSE2::scramble };
+       #else
+        return { Scalar::accumulate, Scalar::scramble };
+       #endif
+    }
+
+    static const Kernels& getBestKernels() noexcept
+    {
+        static const Kernels kernels = getKernels();
+        return kernels;
+    }
+
+    //==============================================================================
+    static void initialiseAccumulators (uint64* acc) noexcept
+    {
+        acc[0] = prime32_3;  acc[1] = prime64_1;  acc[2] = prime64_2;  acc[3] = prime64_3;
+        acc[4] = prime64_4;  acc[5] = prime32_2;  acc[6] = prime64_5;  acc[7] = prime32_1;
+    }
+
+    static void createSecret (uint8* dest, uint64 seed) noexcept
+    {
+        for (size_t i = 0; i < secretSize; i += 16)
+        {
+            auto low  = ByteOrder::swapIfBigEndian (read64 (defaultSecret + i) + seed);
+            auto high = ByteOrder::swapIfBigEndian (read64 (defaultSecret + i + 8) - seed);
+            memcpy (dest + i, &low, 8);
+            memcpy (dest + i + 8, &high, 8);
+        }
+    }
+
+    static uint64 mergeAccumulators (const uint64* acc, const uint8* sec, uint64 start) noexcept
+    {
+        for (size_t i = 0; i < 4; ++i)
+            start += multiplyAndFold (acc[2 * i] ^ read64 (sec + 16 * i), acc[2 * i + 1] ^ read64 (sec + 16 * i + 8));
+
+        return avalanche (start);
+    }
+
+    // Feeds whole stripes into the accumulators, scrambling them each time the end of a
+    // block is reached. Returns a pointer to the first unused byte of input.
+    static const uint8* consumeStripes (const Kernels& kernels, uint64* acc, size_t& numStripesSoFar,
+                                        const uint8* input, size_t numStripes, const uint8* sec) noexcept
+    {
+        auto initialSecret = sec + numStripesSoFar * 8;
+
+        if (numStripes >= stripesPerBlock - numStripesSoFar)
+        {
+            auto numThisTime = stripesPerBlock - numStripesSoFar;
+
+            do
+            {
+                kernels.accumulate (acc, input, initialSecret, numThisTime);
+                kernels.scramble (acc, sec + secretLimit);
+                input += numThisTime * stripeLength;
+                numStripes -= numThisTime;
+                numThisTime = stripesPerBlock;
+                initialSecret = sec;
+            }
+            while (numStripes >= stripesPerBlock);
+
+            numStripesSoFar = 0;
+        }
+
+        if (numStripes > 0)
+        {
+            kernels.accumulate (acc, input, initialSecret, numStripes);
+            input += numStripes * stripeLength;
+            numStripesSoFar += numStripes;
+        }
+
+        return input;
+    }
+
+    static uint64 hashLong (const uint8* input, size_t length, uint64 seed) noexcept
+    {
+        alignas (64) uint8 customSecret[secretSize];
+        auto sec = defaultSecret;
+
+        if (seed != 0)
+        {
+            createSecret (customSecret, seed);
+            sec = customSecret;
+        }
+
+        auto& kernels = getBestKernels();
+        alignas (64) uint64 acc[8];
+        initialiseAccumulators (acc);
+
+        size_t numStripesSoFar = 0;
+        consumeStripes (kernels, acc, numStripesSoFar, input, (length - 1) / stripeLength, sec);
+        kernels.accumulate (acc, input + length - stripeLength, sec + secretLimit - 7, 1);
+
+        return mergeAccumulators (acc, sec + 11, length * prime64_1);
+    }
+}
+
+//==============================================================================
+XXHash3::XXHash3 (uint64 seedToUse) noexcept
+{
+    reset (seedToUse);
+}
+
+void XXHash3::reset (uint64 newSeed) noexcept
+{
+    XXHash3Helpers::initialiseAccumulators (accumulators);
+    XXHash3Helpers::createSecret (secret, newSeed);
+    numBufferedBytes = 0;
+    numStripesSoFar = 0;
+    totalLength = 0;
+    seed = newSeed;
+}
+
+void XXHash3::update (const void* data, size_t numBytes) noexcept
+{
+    using namespace XXHash3Helpers;
+
+    if (numBytes == 0)
+        return;
+
+    auto input = static_cast<const uint8*> (data);
+    auto end = input + numBytes;
+    totalLength += numBytes;
+
+    if (numBytes <= sizeof (buffer) - numBufferedBytes)
+    {
+        memcpy (buffer + numBufferedBytes, input, numBytes);
+        numBufferedBytes += numBytes;
+        return;
+    }
+
+    auto& kernels = getBestKernels();
+
+    if (numBufferedBytes > 0)
+    {
+        auto numToCopy = sizeof (buffer) - numBufferedBytes;
+        memcpy (buffer + numBufferedBytes, input, numToCopy);
+        input += numToCopy;
+        consumeStripes (kernels, accumulators, numStripesSoFar, buffer, sizeof (buffer) / stripeLength, secret);
+        numBufferedBytes = 0;
+    }
+
+    // Always leave some input in the buffer, because the final stripe is treated
+    // differently when the hash is calculated.
+    if ((size_t) (end - input) > sizeof (buffer))
+    {
+        auto numStripes = (size_t) (end - 1 - input) / stripeLength;
+        input = consumeStripes (kernels, accumulators, numStripesSoFar, input, numStripes, secret);
+        memcpy (buffer + sizeof (buffer) - stripeLength, input - stripeLength, stripeLength);
+    }
+
+    numBufferedBytes = (size_t) (end - input);
+    memcpy (buffer, input, numBufferedBytes);
+}
+
+uint64 XXHash3::getHash() const noexcept
+{
+    using namespace XXHash3Helpers;
+
+    if (totalLength <= midSizeMax)
+        return hashShort (buffer, (size_t) totalLength, seed);
+
+    alignas (64) uint64 acc[8];
+    memcpy (acc, accumulators, sizeof (acc));
+    auto& kernels = getBestKernels();
+    const uint8* lastStripe = nullptr;
+    uint8 wrappedStripe[stripeLength];
+
+    if (numBufferedBytes >= stripeLength)
+    {
+        auto stripesSoFar = numStripesSoFar;
+        consumeStripes (kernels, acc, stripesSoFar, buffer, (numBufferedBytes - 1) / stripeLength, secret);
+        lastStripe = buffer + numBufferedBytes - stripeLength;
+    }
+    else
+    {
+        // The last stripe straddles the end of the previous buffer-load
+        auto numFromPrevious = stripeLength - numBufferedBytes;
+        memcpy (wrappedStripe, buffer + sizeof (buffer) - numFromPrevious, numFromPrevious);
+        memcpy (wrappedStripe + numFromPrevious, buffer, numBufferedBytes);
+        lastStripe = wrappedStripe;
+    }
+
+    kernels.accumulate (acc, lastStripe, secret + secretLimit - 7, 1);
+    return mergeAccumulators (acc, secret + 11, totalLength * prime64_1);
+}
+
+//==============================================================================
+uint64 XXHash3::hash (const void* data, size_t numBytes, uint64 seed) noexcept
+{
+    auto input = static_cast<const uint8*> (data);
+
+    if (numBytes <= XXHash3Helpers::midSizeMax)
+        return XXHash3Helpers::hashShort (input, numBytes, seed);
+
+    return XXHash3Helpers::hashLong (input, numBytes, seed);
+}
+
+uint64 XXHash3::hash (const MemoryBlock& data, uint64 seed) noexcept
+{
+    return hash (data.getData(), data.getSize(), seed);
+}
+
+uint64 XXHash3::hash (InputStream& input, int64 maxBytesToRead, uint64 seed)
+{
+    if (maxBytesToRead < 0)
+        maxBytesToRead = std::numeric_limits<int64>::max();
+
+    constexpr int bufferSize = 65536;
+    HeapBlock<uint8> tempBuffer (bufferSize);
+    XXHash3 hasher (seed);
+
+    while (maxBytesToRead > 0)
+    {
+        auto bytesRead = input.read (tempBuffer, (int) jmin (maxBytesToRead, (int64) bufferSize));
+
+        if (bytesRead <= 0)
+            break;
+
+        maxBytesToRead -= bytesRead;
+        hasher.update (tempBuffer, (size_t) bytesRead);
+    }
+
+    return hasher.getHash();
+}
+
+uint64 XXHash3::hash (const File& file, uint64 seed)
+{
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+        return hash (mappedFile.getData(), mappedFile.getSize(), seed);
+
+    FileInputStream fin (file);
+
+    if (fin.openedOk())
+        return hash (fin, -1, seed);
+
+    return 0;
+}
+
+String XXHash3::toHexString (uint64 hashValue)
+{
+    return String::toHexString ((int64) hashValue).paddedLeft ('0', 16);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XXHash3Tests  : public UnitTest
+{
+public:
+    XXHash3Tests()
+        : UnitTest ("XXHash3", UnitTestCategories::cryptography)
+    {}
+
+    void runTest() override
+    {
+        HeapBlock<uint8> data (100000);
+
+        for (uint32 i = 0; i < 100000; ++i)
+            data[i] = (uint8) ((i * 2654435761u) >> 24);
+
+        const size_t lengths[] = { 0, 1, 3, 4, 8, 9, 16, 17, 128, 129, 240, 241, 1024, 1025, 2061, 100000 };
+        const uint64 seeds[] = { 0, 0x9e3779b97f4a7c15ULL };
+
+        // Generated with XXH3_64bits_withSeed() from the reference implementation
+        const uint64 expected[2][16] =
+        {
+            { 0x2d06800538d394c2ULL, 0xc44bdff4074eecdbULL, 0xe14090f554a5ea90ULL, 0x2e8d078a566e9749ULL,
+              0xcd1c7f88482fcaefULL, 0xbfe43def699fa9e3ULL, 0x81e9eb8634460bb9ULL, 0x9998430fd0a655beULL,
+              0x75eca5c5d5594884ULL, 0xa05da42e7a4e4667ULL, 0x5eb2467c8c9e3969ULL, 0x2d431e984c441f15ULL,
+              0xe99def1145f12936ULL, 0x83cba9b371e4e7f4ULL, 0xfad1df2483f40fc6ULL, 0x920056915640359fULL },
+            { 0x602b0e2cd6662c8bULL, 0x062b185e4e01441aULL, 0xf5abc7f9d1539843ULL, 0x80eb1fba34af62ccULL,
+              0x8813149e639da876ULL, 0x1d2c4851ecd580c9ULL, 0x7f7f704e06138a8aULL, 0x2d4b1d5b644b3fe6ULL,
+              0x27ef5b319b50ea46ULL, 0xb4f2c57c09e1e2e4ULL, 0x0329aa09c20d9cd6ULL, 0x67e2cf13c7452cbcULL,
+              0x709fa517cf5d6e00ULL, 0x18c39aa411c5deb2ULL, 0x15de93580c537e46ULL, 0xa3fd50c172acde38ULL }
+        };
+
+        beginTest ("Matches the reference implementation");
+        {
+            for (int s = 0; s < 2; ++s)
+                for (int i = 0; i < 16; ++i)
+                    expectEquals (XXHash3::hash (data, lengths[i], seeds[s]), expected[s][i]);
+
+            expectEquals (XXHash3::toHexString (XXHash3::hash (nullptr, 0)), String ("2d06800538d394c2"));
+        }
+
+        beginTest ("Incremental updates match the one-shot hash");
+        {
+            auto random = getRandom();
+
+            for (int s = 0; s < 2; ++s)
+            {
+                for (int i = 0; i < 16; ++i)
+                {
+                    for (int attempt = 0; attempt < 4; ++attempt)
+                    {
+                        XXHash3 hasher (seeds[s]);
+
+                        for (size_t pos = 0; pos < lengths[i];)
+                        {
+                            auto numToAdd = jmin (lengths[i] - pos, (size_t) random.nextInt (attempt == 0 ? 8 : 700));
+                            hasher.update (data + pos, numToAdd);
+                            pos += numToAdd;
+                        }
+
+                        expectEquals (hasher.getHash(), expected[s][i]);
+                    }
+                }
+            }
+
+            MemoryInputStream stream (data, 100000, false);
+            expectEquals (XXHash3::hash (stream, -1, seeds[1]), expected[1][15]);
+        }
+
+        beginTest ("Vectorised kernels match the scalar kernels");
+        {
+            using namespace XXHash3Helpers;
+
+            alignas (64) uint64 scalarAcc[8], vectorAcc[8];
+            initialiseAccumulators (scalarAcc);
+            initialiseAccumulators (vectorAcc);
+
+            auto& kernels = getBestKernels();
+
+            for (size_t offset = 0; offset + 16 * stripeLength < 100000; offset += 16 * stripeLength + 3)
+            {
+                Scalar::accumulate (scalarAcc, data + offset, defaultSecret, 16);
+                Scalar::scramble (scalarAcc, defaultSecret + secretLimit);
+                kernels.accumulate (vectorAcc, data + offset, defaultSecret, 16);
+                kernels.scramble (vectorAcc, defaultSecret + secretLimit);
+            }
+
+            for (int i = 0; i < 8; ++i)
+                expectEquals (vectorAcc[i], scalarAcc[i]);
+        }
+    }
+};
+
+static XXHash3Tests xxHash3Tests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast, non-cryptographic 64-bit hash using the XXH3 algorithm.
+
+    XXH3 runs at close to memory bandwidth, so it's a good choice for things like
+    verifying that a downloaded or copied file arrived intact, or spotting changes
+    to large blobs of data. It offers no protection against deliberate tampering,
+    so use SHA256 when the data may have been modified by an attacker.
+
+    The values produced are identical to XXH3_64bits_withSeed() from the reference
+    xxHash library, so they can be compared against hashes generated by other tools.
+
+    You can hash a complete block of data with one of the static hash() methods, or
+    create an XXHash3 object and feed it data a piece at a time with update():
+
+    @code
+    XXHash3 hasher;
+
+    while (auto numRead = stream.read (buffer, bufferSize))
+        hasher.update (buffer, (size_t) numRead);
+
+    auto result = hasher.getHash();
+    @endcode
+
+    @see SHA256, MD5, FileHasher
+
+    @tags{Cryptography}
+*/
+class JUCE_API  XXHash3
+{
+public:
+    //==============================================================================
+    /** Creates a hasher that has not yet been given any data. */
+    explicit XXHash3 (uint64 seed = 0) noexcept;
+
+    /** Discards any data that has been added, and starts again with a new seed. */
+    void reset (uint64 seed = 0) noexcept;
+
+    /** Adds a block of data to the hash. */
+    void update (const void* data, size_t numBytes) noexcept;
+
+    /** Returns the hash of all the data that has been added so far.
+        This doesn't change the state of the hasher, so you can carry on adding
+        more data afterwards.
+    */
+    uint64 getHash() const noexcept;
+
+    //==============================================================================
+    /** Returns the hash of a block of data. */
+    static uint64 hash (const void* data, size_t numBytes, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of a block of data. */
+    static uint64 hash (const MemoryBlock& data, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of the contents of a stream.
+
+        This will read from the stream until the stream is exhausted, or until
+        maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+        stream will be read.
+    */
+    static uint64 hash (InputStream& input, int64 maxBytesToRead = -1, uint64 seed = 0);
+
+    /** Returns the hash of a file's contents.
+
+        The file is memory-mapped where possible, so it mustn't be truncated by another
+        process while it's being hashed. If the file can't be opened, this returns 0.
+    */
+    static uint64 hash (const File& file, uint64 seed = 0);
+
+    /** Returns a hash value as a 16-digit hex string, in the same canonical form that
+        the reference xxHash tools print.
+    */
+    static String toHexString (uint64 hash);
+
+private:
+    //==============================================================================
+    alignas (64) uint64 accumulators[8];
+    alignas (64) uint8 secret[192];
+    alignas (64) uint8 buffer[256];
+    size_t numBufferedBytes = 0, numStripesSoFar = 0;
+    uint64 totalLength = 0, seed = 0;
+
+    JUCE_LEAK_DETECTOR (XXHash3)
+};
+
+} // namespace juce
@@ -34,9 +34,46 @@
 
 #include "juce_cryptography.h"
 
+// Lets the hash functions use the SHA and AVX2 instruction set extensions when the
+// CPU supports them, even if the rest of the code is built for baseline x86
+#if JUCE_INTEL && ! defined (JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH) \
+     && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5))
+ #define JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH 1
+#endif
+
+#if JUCE_CRYPTOGRAPHY_RUNTIME_DISPATCH
+ #include <immintrin.h>
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #endif
+
+ #define JUCE_TARGET_PRAGMA(...) _Pragma (#__VA_ARGS__)
+
+ #if JUCE_CLANG
+  #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(isa)  JUCE_TARGET_PRAGMA (clang attribute push (__attribute__ ((target (isa))), apply_to = function))
+  #define JUCE_END_TARGET_INSTRUCTION_SET         _Pragma ("clang attribute pop")
+ #elif JUCE_GCC
+  #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(isa)  _Pragma ("GCC push_options") JUCE_TARGET_PRAGMA (GCC target (isa))
+  #define JUCE_END_TARGET_INSTRUCTION_SET         _Pragma ("GCC pop_options")
+ #else
+  #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(isa)
+  #define JUCE_END_TARGET_INSTRUCTION_SET
+ #endif
+#endif
+
+// ARMv8 has no equivalent of cpuid that's usable from user space everywhere, so the
+// crypto extensions are only used when the compiler has been told they're available
+#if JUCE_ARM && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #define JUCE_CRYPTOGRAPHY_USE_ARM_SHA2 1
+ #include <arm_neon.h>
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
 #include "hashing/juce_MD5.cpp"
 #include "hashing/juce_SHA256.cpp"
 #include "hashing/juce_Whirlpool.cpp"
+#include "hashing/juce_XXHash3.cpp"
+#include "hashing/juce_FileHasher.cpp"
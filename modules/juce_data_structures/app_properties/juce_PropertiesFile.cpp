@@ -30,6 +30,16 @@ namespace PropertyFileConstants
 {
     constexpr static const int magicNumber            = (int) ByteOrder::makeInt ('P', 'R', 'O', 'P');
     constexpr static const int magicNumberCompressed  = (int) ByteOrder::makeInt ('C', 'P', 'R', 'P');
+    constexpr static const int magicNumberIncremental = (int) ByteOrder::makeInt ('P', 'R', 'L', 'G');
+
+    // Each record in an incremental file is a length, followed by one of these types,
+    // the key, and (for a setValueRecord) the value
+    constexpr static const char setValueRecord        = 1;
+    constexpr static const char removeValueRecord     = 2;
+
+    // An incremental file is compacted once its out-of-date records take up more space
+    // than the current ones, and this many bytes
+    constexpr static const int64 minBytesBeforeCompacting = 16384;
 
     constexpr static const char* const fileTag        = "PROPERTIES";
     constexpr static const char* const valueTag       = "VALUE";
@@ -44,7 +54,8 @@ PropertiesFile::Options::Options()
       doNotSave (false),
       millisecondsBeforeSaving (3000),
       storageFormat (PropertiesFile::storeAsXML),
-      processLock (nullptr)
+      processLock (nullptr),
+      backgroundThread (nullptr)
 {
 }
 
@@ -133,12 +144,24 @@ bool PropertiesFile::reload()
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
+    {
+        // Until an incremental file has been loaded or written, the next save has to rewrite it
+        const ScopedLock sl (writeLock);
+        canAppendToFile = false;
+    }
+
     loadedOk = (! file.exists()) || loadAsBinary() || loadAsXml();
     return loadedOk;
 }
 
 PropertiesFile::~PropertiesFile()
 {
+    if (options.backgroundThread != nullptr)
+    {
+        options.backgroundThread->removeTimeSliceClient (this);
+        writePendingSnapshot();
+    }
+
     saveIfNeeded();
 }
 
@@ -171,16 +194,101 @@ bool PropertiesFile::save()
 
     stopTimer();
 
+    {
+        // These values are newer than any that are still waiting to be written
+        const ScopedLock pl (pendingLock);
+        pendingSnapshot.reset();
+    }
+
+    if (writeValues (getAllProperties(), ++numSnapshots))
+    {
+        needsWriting = false;
+        return true;
+    }
+
+    return false;
+}
+
+void PropertiesFile::saveIfNeededInBackground()
+{
+    if (options.backgroundThread == nullptr)
+    {
+        saveIfNeeded();
+        return;
+    }
+
+    {
+        const ScopedLock sl (getLock());
+
+        stopTimer();
+
+        if (! needsWriting)
+            return;
+
+        // Only a copy of the values is taken here, and if the thread hasn't got round to
+        // writing an earlier copy yet, this one replaces it
+        auto snapshot = std::make_unique<Snapshot> (Snapshot { getAllProperties(), ++numSnapshots });
+        needsWriting = false;
+
+        const ScopedLock pl (pendingLock);
+        pendingSnapshot = std::move (snapshot);
+    }
+
+    options.backgroundThread->addTimeSliceClient (this);
+}
+
+int PropertiesFile::useTimeSlice()
+{
+    writePendingSnapshot();
+
+    const ScopedLock pl (pendingLock);
+    return pendingSnapshot != nullptr ? 0 : 1000;
+}
+
+void PropertiesFile::writePendingSnapshot()
+{
+    std::unique_ptr<Snapshot> snapshot;
+
+    {
+        const ScopedLock pl (pendingLock);
+        snapshot = std::move (pendingSnapshot);
+    }
+
+    if (snapshot != nullptr && ! writeValues (snapshot->values, snapshot->number))
+    {
+        // leave it to be tried again at the next save
+        const ScopedLock sl (getLock());
+        needsWriting = true;
+    }
+}
+
+bool PropertiesFile::writeValues (const StringPairArray& values, uint64 snapshotNumber)
+{
+    const ScopedLock sl (writeLock);
+
+    // a newer set of values has already been written
+    if (snapshotNumber < lastWrittenSnapshot)
+        return true;
+
     if (options.doNotSave
          || file == File()
          || file.isDirectory()
          || ! file.getParentDirectory().createDirectory())
         return false;
 
-    if (options.storageFormat == storeAsXML)
-        return saveAsXml();
+    ProcessScopedLock pl (createProcessLock());
+
+    if (pl != nullptr && ! pl->isLocked())
+        return false; // locking failure..
+
+    const auto ok = options.storageFormat == storeAsXML               ? saveAsXml (values)
+                  : options.storageFormat == storeAsIncrementalBinary ? saveIncrementally (values)
+                                                                      : saveAsBinary (values);
+
+    if (ok)
+        lastWrittenSnapshot = snapshotNumber;
 
-    return saveAsBinary();
+    return ok;
 }
 
 bool PropertiesFile::loadAsXml()
@@ -204,10 +312,9 @@ bool PropertiesFile::loadAsXml()
     return false;
 }
 
-bool PropertiesFile::saveAsXml()
+bool PropertiesFile::saveAsXml (const StringPairArray& props)
 {
     XmlElement doc (PropertyFileConstants::fileTag);
-    auto& props = getAllProperties();
 
     for (int i = 0; i < props.size(); ++i)
     {
@@ -221,18 +328,7 @@ bool PropertiesFile::saveAsXml()
             e->setAttribute (PropertyFileConstants::valueAttribute, props.getAllValues() [i]);
     }
 
-    ProcessScopedLock pl (createProcessLock());
-
-    if (pl != nullptr && ! pl->isLocked())
-        return false; // locking failure..
-
-    if (doc.writeTo (file, {}))
-    {
-        needsWriting = false;
-        return true;
-    }
-
-    return false;
+    return doc.writeTo (file, {});
 }
 
 bool PropertiesFile::loadAsBinary()
@@ -252,6 +348,9 @@ bool PropertiesFile::loadAsBinary()
 
         if (magicNumber == PropertyFileConstants::magicNumber)
             return loadAsBinary (fileStream);
+
+        if (magicNumber == PropertyFileConstants::magicNumberIncremental)
+            return loadIncrementalRecords (fileStream);
     }
 
     return false;
@@ -276,13 +375,8 @@ bool PropertiesFile::loadAsBinary (InputStream& input)
     return true;
 }
 
-bool PropertiesFile::saveAsBinary()
+bool PropertiesFile::saveAsBinary (const StringPairArray& props)
 {
-    ProcessScopedLock pl (createProcessLock());
-
-    if (pl != nullptr && ! pl->isLocked())
-        return false; // locking failure..
-
     TemporaryFile tempFile (file);
 
     {
@@ -298,7 +392,7 @@ bool PropertiesFile::saveAsBinary()
 
             GZIPCompressorOutputStream zipped (out, 9);
 
-            if (! writeToStream (zipped))
+            if (! writeToStream (zipped, props))
                 return false;
         }
         else
@@ -308,21 +402,16 @@ bool PropertiesFile::saveAsBinary()
 
             out.writeInt (PropertyFileConstants::magicNumber);
 
-            if (! writeToStream (out))
+            if (! writeToStream (out, props))
                 return false;
         }
     }
 
-    if (! tempFile.overwriteTargetFileWithTemporary())
-        return false;
-
-    needsWriting = false;
-    return true;
+    return tempFile.overwriteTargetFileWithTemporary();
 }
 
-bool PropertiesFile::writeToStream (OutputStream& out)
+bool PropertiesFile::writeToStream (OutputStream& out, const StringPairArray& props)
 {
-    auto& props  = getAllProperties();
     auto& keys   = props.getAllKeys();
     auto& values = props.getAllValues();
     auto numProperties = props.size();
@@ -339,20 +428,346 @@ bool PropertiesFile::writeToStream (OutputStream& out)
     return true;
 }
 
+//==============================================================================
+static int64 getIncrementalRecordSize (const String& key, const String* value)
+{
+    return 4 + 1 + (int64) key.getNumBytesAsUTF8() + 1
+             + (value != nullptr ? (int64) value->getNumBytesAsUTF8() + 1 : 0);
+}
+
+static bool writeIncrementalRecord (OutputStream& out, const String& key, const String* value)
+{
+    MemoryOutputStream record;
+    record.writeByte (value != nullptr ? PropertyFileConstants::setValueRecord
+                                       : PropertyFileConstants::removeValueRecord);
+    record.writeString (key);
+
+    if (value != nullptr)
+        record.writeString (*value);
+
+    return out.writeInt ((int) record.getDataSize())
+            && out.write (record.getData(), record.getDataSize());
+}
+
+bool PropertiesFile::loadIncrementalRecords (InputStream& input)
+{
+    BufferedInputStream in (input, 8192);
+
+    std::unordered_map<String, String> loadedValues;
+    auto endOfValidRecords = in.getPosition();
+    int64 liveSize = 0;
+
+    // A record that was only partly written (e.g. if the app crashed while saving) ends
+    // the file, and the next save will rewrite it
+    while (! in.isExhausted())
+    {
+        auto size = in.readInt();
+
+        if (size <= 0 || size > in.getNumBytesRemaining())
+            break;
+
+        MemoryBlock data;
+
+        if (in.readIntoMemoryBlock (data, size) != (size_t) size)
+            break;
+
+        MemoryInputStream record (data, false);
+        auto type = record.readByte();
+        auto key = record.readString();
+
+        if (key.isEmpty())
+            break;
+
+        auto existing = loadedValues.find (key);
+
+        if (existing != loadedValues.end())
+        {
+            liveSize -= getIncrementalRecordSize (key, &existing->second);
+            loadedValues.erase (existing);
+        }
+
+        if (type == PropertyFileConstants::setValueRecord)
+        {
+            auto value = record.readString();
+            getAllProperties().set (key, value);
+            liveSize += getIncrementalRecordSize (key, &value);
+            loadedValues.emplace (key, value);
+        }
+        else
+        {
+            getAllProperties().remove (StringRef (key));
+        }
+
+        endOfValidRecords = in.getPosition();
+    }
+
+    const ScopedLock sl (writeLock);
+    writtenValues = std::move (loadedValues);
+    writtenFileSize = endOfValidRecords;
+    writtenLiveSize = liveSize;
+    canAppendToFile = true;
+    return true;
+}
+
+bool PropertiesFile::saveIncrementally (const StringPairArray& props)
+{
+    std::unordered_map<String, String> newValues;
+    newValues.reserve ((size_t) props.size());
+
+    for (int i = 0; i < props.size(); ++i)
+        newValues[props.getAllKeys()[i]] = props.getAllValues()[i];
+
+    if (canAppendToFile && file.getSize() == writtenFileSize)
+    {
+        MemoryOutputStream changes;
+        auto liveSize = writtenLiveSize;
+
+        for (auto& [key, value] : newValues)
+        {
+            auto written = writtenValues.find (key);
+
+            if (written != writtenValues.end())
+            {
+                if (written->second == value)
+                    continue;
+
+                liveSize -= getIncrementalRecordSize (key, &written->second);
+            }
+
+            writeIncrementalRecord (changes, key, &value);
+            liveSize += getIncrementalRecordSize (key, &value);
+        }
+
+        for (auto& [key, value] : writtenValues)
+        {
+            if (newValues.find (key) == newValues.end())
+            {
+                writeIncrementalRecord (changes, key, nullptr);
+                liveSize -= getIncrementalRecordSize (key, &value);
+            }
+        }
+
+        if (changes.getDataSize() == 0)
+            return true;
+
+        auto newFileSize = writtenFileSize + (int64) changes.getDataSize();
+
+        if (newFileSize - 4 <= 2 * liveSize + PropertyFileConstants::minBytesBeforeCompacting)
+        {
+            FileOutputStream out (file);
+
+            if (out.openedOk()
+                 && out.getPosition() == writtenFileSize
+                 && out.write (changes.getData(), changes.getDataSize()))
+            {
+                out.flush();
+
+                if (out.getStatus().wasOk())
+                {
+                    writtenValues = std::move (newValues);
+                    writtenFileSize = newFileSize;
+                    writtenLiveSize = liveSize;
+                    return true;
+                }
+            }
+        }
+    }
+
+    return rewriteIncrementalFile (props, std::move (newValues));
+}
+
+bool PropertiesFile::rewriteIncrementalFile (const StringPairArray& props,
+                                             std::unordered_map<String, String>&& newValues)
+{
+    canAppendToFile = false;
+
+    TemporaryFile tempFile (file);
+    int64 liveSize = 0;
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (! out.openedOk() || ! out.writeInt (PropertyFileConstants::magicNumberIncremental))
+            return false;
+
+        for (int i = 0; i < props.size(); ++i)
+        {
+            auto& key = props.getAllKeys().getReference (i);
+            auto& value = props.getAllValues().getReference (i);
+
+            if (! writeIncrementalRecord (out, key, &value))
+                return false;
+
+            liveSize += getIncrementalRecordSize (key, &value);
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (! tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    writtenValues = std::move (newValues);
+    writtenFileSize = 4 + liveSize;
+    writtenLiveSize = liveSize;
+    canAppendToFile = true;
+    return true;
+}
+
+//==============================================================================
 void PropertiesFile::timerCallback()
 {
-    saveIfNeeded();
+    saveIfNeededInBackground();
 }
 
 void PropertiesFile::propertyChanged()
 {
     sendChangeMessage();
+
+    auto now = Time::getMillisecondCounter();
+
+    if (! needsWriting)
+        firstUnsavedChangeTime = now;
+
     needsWriting = true;
 
     if (options.millisecondsBeforeSaving > 0)
-        startTimer (options.millisecondsBeforeSaving);
+    {
+        // Each change puts the save off again, so that a burst of changes is written in one
+        // go, but a steady stream of them can't put it off for more than a few times the delay
+        auto deadline = firstUnsavedChangeTime + 4 * (uint32) options.millisecondsBeforeSaving;
+        startTimer (jlimit (1, options.millisecondsBeforeSaving, (int) (deadline - now)));
+    }
     else if (options.millisecondsBeforeSaving == 0)
         saveIfNeeded();
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertiesFileTests  : public UnitTest
+{
+public:
+    PropertiesFileTests()
+        : UnitTest ("PropertiesFile", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile temp (".settings");
+        const auto& file = temp.getFile();
+
+        PropertiesFile::Options options;
+        options.millisecondsBeforeSaving = -1;
+        options.storageFormat = PropertiesFile::storeAsIncrementalBinary;
+
+        const auto bigValue = String::repeatedString ("0123456789", 10000);
+
+        beginTest ("Incremental files only append the values that have changed");
+        {
+            PropertiesFile props (file, options);
+            props.setValue ("big", bigValue);
+            props.setValue ("small", 1);
+            expect (props.save());
+
+            auto sizeAfterFirstSave = file.getSize();
+            expect (sizeAfterFirstSave > bigValue.length());
+
+            props.setValue ("small", 2);
+            expect (props.save());
+            expect (file.getSize() - sizeAfterFirstSave < 100);
+
+            props.setValue ("other", "x");
+            props.removeValue ("small");
+            expect (props.save());
+        }
+
+        {
+            PropertiesFile props (file, options);
+            expect (props.isValidFile());
+            expectEquals (props.getValue ("big"), bigValue);
+            expectEquals (props.getValue ("other"), String ("x"));
+            expect (! props.containsKey ("small"));
+        }
+
+        beginTest ("Incremental files are compacted once they're mostly out of date");
+        {
+            PropertiesFile props (file, options);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                props.setValue ("big", bigValue + String (i));
+                expect (props.save());
+            }
+
+            expect (file.getSize() < 3 * bigValue.length());
+        }
+
+        {
+            PropertiesFile props (file, options);
+            expectEquals (props.getValue ("big"), bigValue + "19");
+        }
+
+        beginTest ("A partly-written record at the end of an incremental file is ignored");
+        {
+            {
+                FileOutputStream out (file);
+                out.writeInt (1000);
+                out.writeString ("trunc");
+            }
+
+            PropertiesFile props (file, options);
+            expect (props.isValidFile());
+            expectEquals (props.getValue ("other"), String ("x"));
+
+            props.setValue ("other", "y");
+            expect (props.save());
+        }
+
+        {
+            PropertiesFile props (file, options);
+            expectEquals (props.getValue ("other"), String ("y"));
+            expectEquals (props.getValue ("big"), bigValue + "19");
+        }
+
+        for (auto format : { PropertiesFile::storeAsXML, PropertiesFile::storeAsIncrementalBinary })
+        {
+            beginTest ("Background saves write the latest values");
+
+            file.deleteFile();
+
+            TimeSliceThread thread ("PropertiesFile test");
+            thread.startThread();
+
+            auto backgroundOptions = options;
+            backgroundOptions.storageFormat = format;
+            backgroundOptions.backgroundThread = &thread;
+
+            {
+                PropertiesFile props (file, backgroundOptions);
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    props.setValue ("count", i);
+                    props.setValue ("big", bigValue + String (i));
+                    props.saveIfNeededInBackground();
+                }
+
+                expect (! props.needsToBeSaved());
+            }
+
+            PropertiesFile props (file, options);
+            expectEquals (props.getIntValue ("count"), 99);
+            expectEquals (props.getValue ("big"), bigValue + "99");
+        }
+    }
+};
+
+static PropertiesFileTests propertiesFileTests;
+
+#endif
+
 } // namespace juce
@@ -44,7 +44,8 @@ namespace juce
 */
 class JUCE_API  PropertiesFile  : public PropertySet,
                                   public ChangeBroadcaster,
-                                  private Timer
+                                  private Timer,
+                                  private TimeSliceClient
 {
 public:
     //==============================================================================
@@ -52,7 +53,17 @@ public:
     {
         storeAsBinary,
         storeAsCompressedBinary,
-        storeAsXML
+        storeAsXML,
+
+        /** A binary format that's appended to rather than rewritten.
+
+            When the file is saved, only the values that have been added, changed or
+            removed since the last save are written to the end of the file, so a file
+            that holds a few large values doesn't have to be rewritten every time a
+            small one changes. Once the out-of-date entries take up more space than the
+            current ones, the whole file is rewritten to compact it.
+        */
+        storeAsIncrementalBinary
     };
 
     //==============================================================================
@@ -142,6 +153,21 @@ public:
         */
         InterProcessLock* processLock;
 
+        /** An optional thread on which the file will be written.
+
+            If this is set, then the saves that are triggered by millisecondsBeforeSaving
+            (and by saveIfNeededInBackground()) take a copy of the values, and then turn them
+            into XML or binary data and write the file on this thread, rather than blocking
+            the thread that changed them. If more changes arrive while a write is in
+            progress, they're combined into a single write of the latest values.
+
+            Calling save() or saveIfNeeded() still writes the file before returning. The
+            PropertiesFile will keep a pointer to the thread but will not take ownership of
+            it, so make sure it outlives the PropertiesFile, and that it has been started.
+            The default constructor initialises this value to nullptr.
+        */
+        TimeSliceThread* backgroundThread;
+
         /** This can be called to suggest a file that should be used, based on the values
             in this structure.
 
@@ -209,6 +235,17 @@ public:
     */
     bool save();
 
+    /** Flushes the values to disk on the Options::backgroundThread if they've changed since
+        the last time they were saved.
+
+        This returns straight away. If there isn't a background thread, it just calls
+        saveIfNeeded(). Any write that's still pending when the PropertiesFile is deleted
+        is finished by the destructor.
+
+        @see saveIfNeeded, Options::backgroundThread
+    */
+    void saveIfNeededInBackground();
+
     /** Returns true if the properties have been altered since the last time they were saved.
         The file is flagged as needing to be saved when you change a value, but you can
         explicitly set this flag with setNeedsToBeSaved().
@@ -237,17 +274,43 @@ private:
     File file;
     Options options;
     bool loadedOk = false, needsWriting = false;
+    uint32 firstUnsavedChangeTime = 0;
+
+    struct Snapshot
+    {
+        StringPairArray values;
+        uint64 number;
+    };
+
+    // Holds the latest values that are waiting to be written by the background thread
+    CriticalSection pendingLock;
+    std::unique_ptr<Snapshot> pendingSnapshot;
+    uint64 numSnapshots = 0;
+
+    // Describes what the file contains, so that incremental saves only need to append
+    // the values that have changed since
+    CriticalSection writeLock;
+    std::unordered_map<String, String> writtenValues;
+    int64 writtenFileSize = 0, writtenLiveSize = 0;
+    uint64 lastWrittenSnapshot = 0;
+    bool canAppendToFile = false;
 
     using ProcessScopedLock = const std::unique_ptr<InterProcessLock::ScopedLockType>;
     InterProcessLock::ScopedLockType* createProcessLock() const;
 
     void timerCallback() override;
-    bool saveAsXml();
-    bool saveAsBinary();
+    int useTimeSlice() override;
+    void writePendingSnapshot();
+    bool writeValues (const StringPairArray&, uint64 snapshotNumber);
+    bool saveAsXml (const StringPairArray&);
+    bool saveAsBinary (const StringPairArray&);
+    bool saveIncrementally (const StringPairArray&);
+    bool rewriteIncrementalFile (const StringPairArray&, std::unordered_map<String, String>&&);
     bool loadAsXml();
     bool loadAsBinary();
     bool loadAsBinary (InputStream&);
-    bool writeToStream (OutputStream&);
+    bool loadIncrementalRecords (InputStream&);
+    bool writeToStream (OutputStream&, const StringPairArray&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PropertiesFile)
 };
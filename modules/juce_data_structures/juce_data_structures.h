@@ -55,10 +55,23 @@
 //==============================================================================
 #include <juce_events/juce_events.h>
 
+//==============================================================================
+/** Config: JUCE_VALUETREE_POOLED_ALLOCATION
+    If enabled, the internal objects that hold each ValueTree's data are allocated from
+    a shared pool of fixed-size blocks, rather than individually on the heap. This makes
+    building and deleting very large trees quicker and avoids fragmenting the heap, but
+    the pool keeps hold of its memory for reuse, so it never shrinks below the largest
+    number of nodes that have existed at once.
+*/
+#ifndef JUCE_VALUETREE_POOLED_ALLOCATION
+ #define JUCE_VALUETREE_POOLED_ALLOCATION 0
+#endif
+
 #include "undomanager/juce_UndoableAction.h"
 #include "undomanager/juce_UndoManager.h"
 #include "values/juce_Value.h"
 #include "values/juce_ValueTree.h"
+#include "values/juce_ValueTreeBinaryFormat.h"
 #include "values/juce_ValueTreeSynchroniser.h"
 #include "values/juce_CachedValue.h"
 #include "values/juce_ValueTreePropertyWithDefault.h"
@@ -87,17 +87,14 @@ bool UndoManager::perform (UndoableAction* newAction)
         {
             auto* actionSet = getCurrentSet();
 
-            if (actionSet != nullptr && ! newTransaction)
+            if (actionSet != nullptr && newTransaction && canJoinPreviousTransaction()
+                 && coalesceWithExistingAction (*actionSet, action))
             {
-                if (auto* lastAction = actionSet->actions.getLast())
-                {
-                    if (auto coalescedAction = lastAction->createCoalescedAction (action.get()))
-                    {
-                        action.reset (coalescedAction);
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
-                    }
-                }
+                // the action has been merged into the previous transaction
+            }
+            else if (actionSet != nullptr && ! newTransaction)
+            {
+                coalesceWithExistingAction (*actionSet, action);
             }
             else
             {
@@ -106,8 +103,13 @@ bool UndoManager::perform (UndoableAction* newAction)
                 ++nextIndex;
             }
 
-            totalUnitsStored += action->getSizeInUnits();
-            actionSet->actions.add (std::move (action));
+            if (action != nullptr)
+            {
+                totalUnitsStored += action->getSizeInUnits();
+                actionSet->actions.add (std::move (action));
+            }
+
+            actionSet->timeOfLastAction = Time::getCurrentTime();
             newTransaction = false;
 
             moveFutureTransactionsToStash();
@@ -120,6 +122,48 @@ bool UndoManager::perform (UndoableAction* newAction)
     return false;
 }
 
+bool UndoManager::coalesceWithExistingAction (ActionSet& actionSet, std::unique_ptr<UndoableAction>& action)
+{
+    // Look for the last action that changed the same thing, stepping back over any actions
+    // that are known to change something else. If the coalesced action takes the place
+    // of an earlier one, the new action is consumed and this returns true.
+    const auto key = action->getCoalescingKey();
+
+    for (int i = actionSet.actions.size(); --i >= 0;)
+    {
+        auto* existing = actionSet.actions.getUnchecked (i);
+        const auto existingKey = existing->getCoalescingKey();
+
+        if (i == actionSet.actions.size() - 1 || (key.isValid() && existingKey == key))
+        {
+            if (auto* coalesced = existing->createCoalescedAction (action.get()))
+            {
+                totalUnitsStored += coalesced->getSizeInUnits() - existing->getSizeInUnits();
+                actionSet.actions.set (i, coalesced, true);
+                action.reset();
+                return true;
+            }
+        }
+
+        if (! (key.isValid() && existingKey.isValid() && existingKey != key))
+            break;
+    }
+
+    return false;
+}
+
+bool UndoManager::canJoinPreviousTransaction() const
+{
+    if (transactionCoalescingTime <= 0 || nextIndex < transactions.size())
+        return false;
+
+    auto* previous = getCurrentSet();
+
+    return previous != nullptr
+            && (newTransactionName.isEmpty() || previous->name == newTransactionName)
+            && Time::getCurrentTime() - previous->timeOfLastAction < RelativeTime::milliseconds (transactionCoalescingTime);
+}
+
 void UndoManager::moveFutureTransactionsToStash()
 {
     if (nextIndex < transactions.size())
@@ -210,6 +254,10 @@ bool UndoManager::undo()
     if (auto* s = getCurrentSet())
     {
         const ScopedValueSetter<bool> setter (isInsideUndoRedoCall, true);
+        std::optional<ValueTree::ScopedNotificationBatch> batch;
+
+        if (batchValueTreeNotifications)
+            batch.emplace();
 
         if (s->undo())
             --nextIndex;
@@ -229,6 +277,10 @@ bool UndoManager::redo()
     if (auto* s = getNextSet())
     {
         const ScopedValueSetter<bool> setter (isInsideUndoRedoCall, true);
+        std::optional<ValueTree::ScopedNotificationBatch> batch;
+
+        if (batchValueTreeNotifications)
+            batch.emplace();
 
         if (s->perform())
             ++nextIndex;
@@ -339,4 +391,132 @@ std::vector<ActionSet*> UndoManager::getTransactions() const
 	}
     return allTransactions;
 }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class UndoManagerTests  : public UnitTest
+{
+public:
+    UndoManagerTests()
+        : UnitTest ("UndoManager", UnitTestCategories::values)
+    {}
+
+    void runTest() override
+    {
+        const Identifier a ("a"), b ("b");
+
+        beginTest ("Property changes are coalesced with earlier changes to the same property");
+        {
+            ValueTree tree ("test");
+            tree.setProperty (a, 0, nullptr);
+            tree.setProperty (b, 0, nullptr);
+
+            UndoManager undoManager;
+            undoManager.beginNewTransaction();
+
+            for (int i = 1; i <= 100; ++i)
+            {
+                tree.setProperty (a, i, &undoManager);
+                tree.setProperty (b, -i, &undoManager);
+            }
+
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 2);
+
+            expect (undoManager.undo());
+            expectEquals ((int) tree[a], 0);
+            expectEquals ((int) tree[b], 0);
+
+            expect (undoManager.redo());
+            expectEquals ((int) tree[a], 100);
+            expectEquals ((int) tree[b], -100);
+        }
+
+        beginTest ("Actions without a key stop the search for one to coalesce with");
+        {
+            ValueTree tree ("test");
+            tree.setProperty (a, 0, nullptr);
+
+            UndoManager undoManager;
+            undoManager.beginNewTransaction();
+
+            int counter = 0;
+            tree.setProperty (a, 1, &undoManager);
+            undoManager.perform (new CounterAction (counter));
+            tree.setProperty (a, 2, &undoManager);
+
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 3);
+
+            expect (undoManager.undo());
+            expectEquals ((int) tree[a], 0);
+            expectEquals (counter, 0);
+        }
+
+        beginTest ("Transactions that follow on closely are merged");
+        {
+            ValueTree tree ("test");
+            tree.setProperty (a, 0, nullptr);
+
+            UndoManager undoManager;
+
+            for (int i = 1; i <= 50; ++i)
+            {
+                undoManager.beginNewTransaction();
+                tree.setProperty (a, i, &undoManager);
+            }
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 50);
+
+            undoManager.clearUndoHistory();
+            undoManager.setTransactionCoalescingTime (60000);
+
+            for (int i = 1; i <= 50; ++i)
+            {
+                undoManager.beginNewTransaction();
+                tree.setProperty (a, 50 + i, &undoManager);
+            }
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 1);
+
+            undoManager.beginNewTransaction();
+            tree.setProperty (b, 1, &undoManager);
+            expectEquals (undoManager.getUndoDescriptions().size(), 2);
+
+            expect (undoManager.undo());
+            expect (undoManager.undo());
+            expectEquals ((int) tree[a], 50);
+        }
+
+        beginTest ("Large values take up more of the budget");
+        {
+            ValueTree tree ("test");
+            tree.setProperty (a, String(), nullptr);
+            tree.setProperty (b, String(), nullptr);
+
+            UndoManager undoManager;
+            tree.setProperty (a, "x", &undoManager);
+            auto smallSize = undoManager.getNumberOfUnitsTakenUpByStoredCommands();
+
+            undoManager.beginNewTransaction();
+            tree.setProperty (b, String::repeatedString ("x", 10000), &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() - smallSize > 10000);
+        }
+    }
+
+private:
+    struct CounterAction  : public UndoableAction
+    {
+        explicit CounterAction (int& c) : counter (c) {}
+
+        bool perform() override    { ++counter; return true; }
+        bool undo() override       { --counter; return true; }
+
+        int& counter;
+    };
+};
+
+static UndoManagerTests undoManagerTests;
+
+#endif
+
 } // namespace juce
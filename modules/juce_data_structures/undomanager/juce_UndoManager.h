@@ -62,6 +62,7 @@ struct ActionSet
     OwnedArray<UndoableAction> actions;
     String name;
     Time time{ Time::getCurrentTime() };
+    Time timeOfLastAction{ time };
 };
 	
 //==============================================================================
@@ -287,6 +288,30 @@ public:
     /** Returns true if the caller code is in the middle of an undo or redo action. */
     bool isPerformingUndoRedo() const;
 
+    /** If enabled, the ValueTree notifications caused by each call to undo() or redo()
+        are batched with a ValueTree::ScopedNotificationBatch, so listeners get a single
+        merged set of callbacks once the whole transaction has been processed, rather than
+        one for every action in it.
+
+        This is off by default, because the listeners then see valueTreeStructureChanged()
+        instead of the individual child callbacks.
+    */
+    void setBatchValueTreeNotifications (bool shouldBatch) noexcept     { batchValueTreeNotifications = shouldBatch; }
+
+    /** Lets a new transaction be merged into the previous one if it follows on closely.
+
+        If this is greater than zero, and the first action of a new transaction is performed
+        within this many milliseconds of the last action in the previous transaction, has
+        the same transaction name (or no name), and can be coalesced with one of the previous
+        transaction's actions (see UndoableAction::getCoalescingKey()), then it's merged
+        into the previous transaction instead of starting a new one.
+
+        This stops things like slider drags, which may start a new transaction for every
+        change of value, from filling the undo history with thousands of tiny steps. It's
+        zero (turned off) by default.
+    */
+    void setTransactionCoalescingTime (int milliseconds) noexcept       { transactionCoalescingTime = jmax (0, milliseconds); }
+
     /** Returns true if the supplied transaction is the current active transaction. */
     bool isCurrentTransaction(const ActionSet* transaction) const;
 	
@@ -296,12 +321,15 @@ private:
     OwnedArray<ActionSet> transactions, stashedFutureTransactions;
     String newTransactionName;
     int totalUnitsStored = 0, maxNumUnitsToKeep = 0, minimumTransactionsToKeep = 0, nextIndex = 0;
-    bool newTransaction = true, isInsideUndoRedoCall = false;
+    int transactionCoalescingTime = 0;
+    bool newTransaction = true, isInsideUndoRedoCall = false, batchValueTreeNotifications = false;
     ActionSet* getNextSet() const;
     ActionSet* getCurrentSet() const;
     void moveFutureTransactionsToStash();
     void restoreStashedFutureTransactions();
     void dropOldTransactionsIfTooLarge();
+    bool coalesceWithExistingAction (ActionSet&, std::unique_ptr<UndoableAction>&);
+    bool canJoinPreviousTransaction() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoManager)
 };
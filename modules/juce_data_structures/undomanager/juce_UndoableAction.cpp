@@ -27,5 +27,6 @@ namespace juce
 {
 
 UndoableAction* UndoableAction::createCoalescedAction ([[maybe_unused]] UndoableAction* nextAction)  { return nullptr; }
+UndoableAction::CoalescingKey UndoableAction::getCoalescingKey() const                               { return {}; }
 
 } // namespace juce
@@ -93,8 +93,36 @@ public:
         this one followed by the supplied action.
 
         If it's not possible to merge the two actions, the method should return a nullptr.
+
+        @see getCoalescingKey
     */
     virtual UndoableAction* createCoalescedAction (UndoableAction* nextAction);
+
+    //==============================================================================
+    /** Identifies the thing that an action changes, e.g. a property of an object. */
+    struct CoalescingKey
+    {
+        const void* object = nullptr;
+        const void* property = nullptr;
+
+        bool isValid() const noexcept                                { return object != nullptr; }
+        bool operator== (const CoalescingKey& other) const noexcept  { return object == other.object && property == other.property; }
+        bool operator!= (const CoalescingKey& other) const noexcept  { return ! operator== (other); }
+    };
+
+    /** Can be overridden to let the UndoManager coalesce this action with one that was
+        performed earlier in the same transaction, even if other actions came in between.
+
+        Normally the UndoManager only calls createCoalescedAction() on the last action in
+        the transaction. If actions return a valid key here, it'll also look back past any
+        actions that have a different valid key, to find the last one with the same key.
+        So only return a key if your action is independent of any action that returns a
+        different key, e.g. if each one sets a single property of an object, and the
+        key is made from the object and the property.
+
+        The default implementation returns an invalid key.
+    */
+    virtual CoalescingKey getCoalescingKey() const;
 };
 
 } // namespace juce
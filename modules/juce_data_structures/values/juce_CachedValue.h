@@ -55,7 +55,7 @@ namespace juce
     @tags{DataStructures}
 */
 template <typename Type>
-class CachedValue   : private ValueTree::Listener
+class CachedValue   : private ValueTree::PropertyListener
 {
 public:
     //==============================================================================
@@ -91,6 +91,9 @@ public:
     CachedValue (ValueTree& tree, const Identifier& propertyID,
                  UndoManager* undoManager, const Type& defaultToUse);
 
+    /** Destructor. */
+    ~CachedValue() override;
+
     //==============================================================================
     /** Returns the current value of the property. If the property does not exist,
         returns the fallback default value.
@@ -167,8 +170,8 @@ public:
 
     /** Force an update in case the referenced property has been changed from elsewhere.
 
-        Note: The CachedValue is a ValueTree::Listener and therefore will be informed of
-        changes of the referenced property anyway (and update itself). But this may happen
+        Note: The CachedValue is a ValueTree::PropertyListener and therefore will be informed
+        of changes of the referenced property anyway (and update itself). But this may happen
         asynchronously. forceUpdateOfCachedValue() forces an update immediately.
     */
     void forceUpdateOfCachedValue();
@@ -195,7 +198,7 @@ private:
     void referToWithDefault (ValueTree&, const Identifier&, UndoManager*, const Type&);
     Type getTypedValue() const;
 
-    void valueTreePropertyChanged (ValueTree& changedTree, const Identifier& changedProperty) override;
+    void propertyChanged (ValueTree& changedTree, const Identifier& changedProperty) override;
 
     //==============================================================================
     JUCE_DECLARE_WEAK_REFERENCEABLE (CachedValue)
@@ -212,7 +215,7 @@ inline CachedValue<Type>::CachedValue (ValueTree& v, const Identifier& i, UndoMa
     : targetTree (v), targetProperty (i), undoManager (um),
       defaultValue(), cachedValue (getTypedValue())
 {
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -220,7 +223,13 @@ inline CachedValue<Type>::CachedValue (ValueTree& v, const Identifier& i, UndoMa
     : targetTree (v), targetProperty (i), undoManager (um),
       defaultValue (defaultToUse), cachedValue (getTypedValue())
 {
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
+}
+
+template <typename Type>
+inline CachedValue<Type>::~CachedValue()
+{
+    targetTree.removePropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -286,13 +295,13 @@ inline void CachedValue<Type>::forceUpdateOfCachedValue()
 template <typename Type>
 inline void CachedValue<Type>::referToWithDefault (ValueTree& v, const Identifier& i, UndoManager* um, const Type& defaultVal)
 {
-    targetTree.removeListener (this);
+    targetTree.removePropertyListener (targetProperty, this);
     targetTree = v;
     targetProperty = i;
     undoManager = um;
     defaultValue = defaultVal;
     cachedValue = getTypedValue();
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -305,10 +314,9 @@ inline Type CachedValue<Type>::getTypedValue() const
 }
 
 template <typename Type>
-inline void CachedValue<Type>::valueTreePropertyChanged (ValueTree& changedTree, const Identifier& changedProperty)
+inline void CachedValue<Type>::propertyChanged (ValueTree&, const Identifier&)
 {
-    if (changedProperty == targetProperty && targetTree == changedTree)
-        forceUpdateOfCachedValue();
+    forceUpdateOfCachedValue();
 }
 
 } // namespace juce
@@ -26,11 +26,138 @@
 namespace juce
 {
 
+#if JUCE_VALUETREE_POOLED_ALLOCATION
+/*  Hands out fixed-size slots, carved from blocks that each hold a few hundred of them.
+    Freed slots go onto a list to be reused.
+*/
+template <size_t slotSize>
+class ValueTreeNodePool
+{
+public:
+    static ValueTreeNodePool& getInstance()
+    {
+        // This is never deleted, as ValueTrees with static storage may still be
+        // destroyed after it would have been.
+        static auto* pool = new ValueTreeNodePool();
+        return *pool;
+    }
+
+    void* allocate()
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        if (freeList == nullptr)
+            addBlock();
+
+        auto* slot = freeList;
+        freeList = slot->next;
+        return slot->storage;
+    }
+
+    void release (void* p) noexcept
+    {
+        if (p != nullptr)
+        {
+            const SpinLock::ScopedLockType sl (lock);
+            auto* slot = static_cast<Slot*> (p);
+            slot->next = freeList;
+            freeList = slot;
+        }
+    }
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas (std::max_align_t) char storage[slotSize];
+    };
+
+    void addBlock()
+    {
+        enum { slotsPerBlock = 256 };
+
+        blocks.emplace_back (new Slot[slotsPerBlock]);
+        auto* block = blocks.back().get();
+
+        for (int i = 0; i < slotsPerBlock; ++i)
+        {
+            block[i].next = freeList;
+            freeList = block + i;
+        }
+    }
+
+    SpinLock lock;
+    Slot* freeList = nullptr;
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+};
+#endif
+
+//==============================================================================
+struct ValueTree::ScopedNotificationBatch::Queue
+{
+    static Queue*& getCurrent() noexcept
+    {
+        thread_local Queue* current = nullptr;
+        return current;
+    }
+
+    void addStructureChange (const ValueTree& tree)
+    {
+        if (treesWithStructureChanges.insert (tree.object.get()).second)
+            structureChanges.push_back (tree);
+    }
+
+    void addPropertyChange (const ValueTree& tree, const Identifier& property, Listener* listenerToExclude)
+    {
+        const auto key = std::make_pair (static_cast<const void*> (tree.object.get()),
+                                         static_cast<const void*> (property.getCharPointer().getAddress()));
+        const auto existing = propertyChangeIndexes.find (key);
+
+        if (existing == propertyChangeIndexes.end())
+        {
+            propertyChangeIndexes[key] = propertyChanges.size();
+            propertyChanges.push_back ({ tree, property, listenerToExclude });
+        }
+        else if (propertyChanges[existing->second].listenerToExclude != listenerToExclude)
+        {
+            propertyChanges[existing->second].listenerToExclude = nullptr;
+        }
+    }
+
+    void deliver();
+
+    struct PropertyChange
+    {
+        ValueTree tree;
+        Identifier property;
+        Listener* listenerToExclude;
+    };
+
+    std::vector<ValueTree> structureChanges;
+    std::set<const void*> treesWithStructureChanges;
+    std::vector<PropertyChange> propertyChanges;
+    std::map<std::pair<const void*, const void*>, size_t> propertyChangeIndexes;
+};
+
+//==============================================================================
 class ValueTree::SharedObject  : public ReferenceCountedObject
 {
 public:
     using Ptr = ReferenceCountedObjectPtr<SharedObject>;
 
+   #if JUCE_VALUETREE_POOLED_ALLOCATION
+    static void* operator new (size_t size)
+    {
+        jassertquiet (size == sizeof (SharedObject));
+        return ValueTreeNodePool<sizeof (SharedObject)>::getInstance().allocate();
+    }
+
+    static void operator delete (void* p) noexcept
+    {
+        ValueTreeNodePool<sizeof (SharedObject)>::getInstance().release (p);
+    }
+   #endif
+
     explicit SharedObject (const Identifier& t) noexcept  : type (t) {}
 
     SharedObject (const SharedObject& other)
@@ -50,6 +177,9 @@ public:
     {
         jassert (parent == nullptr); // this should never happen unless something isn't obeying the ref-counting!
 
+        if (propertySubscriptions != nullptr)
+            propertySubscriptions->notifier->removePendingChanges (*this);
+
         for (auto i = children.size(); --i >= 0;)
         {
             const Ptr c (children.getObjectPointerUnchecked (i));
@@ -97,33 +227,233 @@ public:
     	}
     }
 
+    static ScopedNotificationBatch::Queue* getBatch() noexcept
+    {
+        return ScopedNotificationBatch::Queue::getCurrent();
+    }
+
     void sendPropertyChangeMessage (const Identifier& property, ValueTree::Listener* listenerToExclude = nullptr)
     {
         ValueTree tree (*this);
+
+        if (auto* batch = getBatch())
+        {
+            batch->addPropertyChange (tree, property, listenerToExclude);
+            return;
+        }
+
         callListenersForAllParents (listenerToExclude, [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); });
+
+        if (notifyListeners.load() && propertySubscriptions != nullptr)
+        {
+            if (auto* subscribers = propertySubscriptions->find (property))
+            {
+                if (! subscribers->asynchronous.isEmpty())
+                    propertySubscriptions->notifier->addPendingChange (*this, property);
+
+                callPropertyListeners (property, false);
+            }
+        }
+    }
+
+    //==============================================================================
+    /*  Collects the property changes that need to be sent to asynchronous PropertyListeners,
+        and delivers all of them with a single message.
+    */
+    class AsyncPropertyNotifier  : private AsyncUpdater
+    {
+    public:
+        ~AsyncPropertyNotifier() override
+        {
+            cancelPendingUpdate();
+        }
+
+        void addPendingChange (SharedObject& object, const Identifier& property)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (! pendingKeys.insert (getKey (object, property)).second)
+                    return;
+
+                pendingChanges.push_back ({ &object, property });
+            }
+
+            triggerAsyncUpdate();
+        }
+
+        void removePendingChanges (SharedObject& object)
+        {
+            const ScopedLock sl (lock);
+
+            for (auto i = pendingChanges.begin(); i != pendingChanges.end();)
+            {
+                if (i->first == &object)
+                {
+                    pendingKeys.erase (getKey (object, i->second));
+                    i = pendingChanges.erase (i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+    private:
+        using Key = std::pair<const void*, const void*>;
+
+        static Key getKey (SharedObject& object, const Identifier& property) noexcept
+        {
+            return { &object, property.getCharPointer().getAddress() };
+        }
+
+        void handleAsyncUpdate() override
+        {
+            // The listeners may delete the last trees that are using this object
+            const SharedResourcePointer<AsyncPropertyNotifier> keepAlive;
+
+            for (;;)
+            {
+                ValueTree tree;
+                Identifier property;
+
+                {
+                    const ScopedLock sl (lock);
+
+                    if (pendingChanges.empty())
+                        break;
+
+                    tree = ValueTree (*pendingChanges.front().first);
+                    property = pendingChanges.front().second;
+                    pendingKeys.erase (getKey (*tree.object, property));
+                    pendingChanges.pop_front();
+                }
+
+                tree.object->callPropertyListeners (property, true);
+            }
+        }
+
+        CriticalSection lock;
+        std::deque<std::pair<SharedObject*, Identifier>> pendingChanges;
+        std::set<Key> pendingKeys;
+    };
+
+    struct PropertySubscribers
+    {
+        ListenerList<PropertyListener> synchronous, asynchronous;
+    };
+
+    struct PropertySubscriptions
+    {
+        PropertySubscribers* find (const Identifier& property)
+        {
+            auto found = subscribers.find (property.getCharPointer().getAddress());
+            return found != subscribers.end() ? &found->second : nullptr;
+        }
+
+        std::unordered_map<const void*, PropertySubscribers> subscribers;
+        SharedResourcePointer<AsyncPropertyNotifier> notifier;
+        int numCallbacksInProgress = 0;
+    };
+
+    void addPropertyListener (const Identifier& property, PropertyListener* listener, NotificationType notification)
+    {
+        if (propertySubscriptions == nullptr)
+            propertySubscriptions = std::make_unique<PropertySubscriptions>();
+
+        auto& subscribers = propertySubscriptions->subscribers[property.getCharPointer().getAddress()];
+
+        if (notification == sendNotificationAsync)
+            subscribers.asynchronous.add (listener);
+        else
+            subscribers.synchronous.add (listener);
+    }
+
+    void removePropertyListener (const Identifier& property, PropertyListener* listener)
+    {
+        if (propertySubscriptions == nullptr)
+            return;
+
+        auto found = propertySubscriptions->subscribers.find (property.getCharPointer().getAddress());
+
+        if (found == propertySubscriptions->subscribers.end())
+            return;
+
+        found->second.synchronous.remove (listener);
+        found->second.asynchronous.remove (listener);
+
+        // The lists can't be deleted while they might be in the middle of calling their listeners
+        if (found->second.synchronous.isEmpty() && found->second.asynchronous.isEmpty()
+             && propertySubscriptions->numCallbacksInProgress == 0)
+            propertySubscriptions->subscribers.erase (found);
+    }
+
+    void callPropertyListeners (const Identifier& property, bool asynchronous)
+    {
+        if (propertySubscriptions == nullptr)
+            return;
+
+        if (auto* subscribers = propertySubscriptions->find (property))
+        {
+            ValueTree tree (*this);
+            auto& list = asynchronous ? subscribers->asynchronous : subscribers->synchronous;
+
+            ++propertySubscriptions->numCallbacksInProgress;
+            list.call ([&] (PropertyListener& l) { l.propertyChanged (tree, property); });
+            --propertySubscriptions->numCallbacksInProgress;
+        }
     }
 
     void sendChildAddedMessage (ValueTree child)
     {
         ValueTree tree (*this);
+
+        if (auto* batch = getBatch())
+        {
+            batch->addStructureChange (tree);
+            return;
+        }
+
         callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreeChildAdded (tree, child); });
     }
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
         ValueTree tree (*this);
+
+        if (auto* batch = getBatch())
+        {
+            batch->addStructureChange (tree);
+            return;
+        }
+
         callListenersForAllParents (nullptr, [=, &tree, &child] (Listener& l) { l.valueTreeChildRemoved (tree, child, index); });
     }
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
         ValueTree tree (*this);
+
+        if (auto* batch = getBatch())
+        {
+            batch->addStructureChange (tree);
+            return;
+        }
+
         callListenersForAllParents (nullptr, [=, &tree] (Listener& l) { l.valueTreeChildOrderChanged (tree, oldIndex, newIndex); });
     }
 
     void sendStructureChangeMessage()
     {
         ValueTree tree(*this);
+
+        if (auto* batch = getBatch())
+        {
+            batch->addStructureChange (tree);
+            return;
+        }
+
         callListenersForAllParents(nullptr, [&](Listener& l) { l.valueTreeStructureChanged(tree); });
     }
 	
@@ -400,6 +730,86 @@ public:
         return true;
     }
 
+    // Builds a whole tree directly, without the listener callbacks that addChild() would make
+    static SharedObject* createFromXml (const XmlElement& xml)
+    {
+        auto* object = new SharedObject (xml.getTagName());
+        object->properties.setFromXmlAttributes (xml);
+        object->children.ensureStorageAllocated (xml.getNumChildElements());
+
+        for (auto* e : xml.getChildIterator())
+        {
+            if (e->isTextElement())
+            {
+                // ValueTrees don't have any equivalent to XML text elements!
+                jassertfalse;
+                continue;
+            }
+
+            auto* child = createFromXml (*e);
+            child->parent = object;
+            object->children.add (child);
+        }
+
+        return object;
+    }
+
+    static Ptr createFromXml (XmlPullParser& parser)
+    {
+        auto toString = [] (std::string_view text) { return String::fromUTF8 (text.data(), (int) text.size()); };
+
+        Ptr object (new SharedObject (toString (parser.getTagName())));
+
+        for (int i = 0; i < parser.getNumAttributes(); ++i)
+        {
+            auto name = toString (parser.getAttributeName (i));
+            auto value = parser.getAttributeValue (i);
+
+            if (name.startsWith ("base64:"))
+            {
+                MemoryBlock mb;
+
+                if (mb.fromBase64Encoding (value))
+                {
+                    object->properties.set (name.substring (7), var (mb));
+                    continue;
+                }
+            }
+
+            object->properties.set (name, var (value));
+        }
+
+        for (;;)
+        {
+            switch (parser.next())
+            {
+                case XmlPullParser::Event::startElement:
+                {
+                    auto child = createFromXml (parser);
+
+                    if (child == nullptr)
+                        return {};
+
+                    child->parent = object.get();
+                    object->children.add (child.get());
+                    break;
+                }
+
+                case XmlPullParser::Event::text:
+                    // ValueTrees don't have any equivalent to XML text elements!
+                    jassertfalse;
+                    break;
+
+                case XmlPullParser::Event::endElement:
+                    return object;
+
+                case XmlPullParser::Event::endOfDocument:
+                case XmlPullParser::Event::error:
+                    return {};
+            }
+        }
+    }
+
     XmlElement* createXml() const
     {
         auto* xml = new XmlElement (type);
@@ -522,7 +932,12 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) (sizeof (*this) + getSizeOfContent (newValue) + getSizeOfContent (oldValue));
+        }
+
+        CoalescingKey getCoalescingKey() const override
+        {
+            return { target.get(), name.getCharPointer().getAddress() };
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -546,6 +961,29 @@ public:
         const bool isAddingNewProperty : 1, isDeletingProperty : 1;
         ValueTree::Listener* excludeListener;
 
+        // The number of bytes a var holds on the heap, so that big values (e.g. long strings or
+        // blocks of binary data) count for more of the UndoManager's budget than small ones
+        static size_t getSizeOfContent (const var& v)
+        {
+            if (v.isString())
+                return v.toString().getNumBytesAsUTF8();
+
+            if (auto* block = v.getBinaryData())
+                return block->getSize();
+
+            if (auto* array = v.getArray())
+            {
+                size_t total = 0;
+
+                for (auto& element : *array)
+                    total += sizeof (var) + getSizeOfContent (element);
+
+                return total;
+            }
+
+            return 0;
+        }
+
         JUCE_DECLARE_NON_COPYABLE (SetPropertyAction)
     };
 
@@ -647,6 +1085,7 @@ public:
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
+    std::unique_ptr<PropertySubscriptions> propertySubscriptions;
     SharedObject* parent = nullptr;
 
 	// Added 10/09/2021
@@ -656,6 +1095,42 @@ public:
     JUCE_LEAK_DETECTOR (SharedObject)
 };
 
+//==============================================================================
+void ValueTree::ScopedNotificationBatch::Queue::deliver()
+{
+    for (auto& tree : structureChanges)
+        tree.object->sendStructureChangeMessage();
+
+    for (auto& change : propertyChanges)
+        change.tree.object->sendPropertyChangeMessage (change.property, change.listenerToExclude);
+}
+
+ValueTree::ScopedNotificationBatch::ScopedNotificationBatch()
+{
+    auto& current = Queue::getCurrent();
+
+    if (current == nullptr)
+    {
+        queue = std::make_unique<Queue>();
+        current = queue.get();
+    }
+}
+
+ValueTree::ScopedNotificationBatch::~ScopedNotificationBatch()
+{
+    if (queue != nullptr)
+    {
+        // anything that the listeners change while this is delivering gets sent immediately
+        Queue::getCurrent() = nullptr;
+        queue->deliver();
+    }
+}
+
+bool ValueTree::ScopedNotificationBatch::isActive() noexcept
+{
+    return Queue::getCurrent() != nullptr;
+}
+
 //==============================================================================
 ValueTree::ValueTree() noexcept
 {
@@ -892,17 +1367,19 @@ int ValueTree::getReferenceCount() const noexcept
 
 //==============================================================================
 struct ValueTreePropertyValueSource  : public Value::ValueSource,
-                                       private ValueTree::Listener
+                                       private ValueTree::PropertyListener
 {
     ValueTreePropertyValueSource (const ValueTree& vt, const Identifier& prop, UndoManager* um, bool sync)
-        : tree (vt), property (prop), undoManager (um), updateSynchronously (sync)
+        : tree (vt), property (prop), undoManager (um)
     {
-        tree.addListener (this);
+        // Asynchronous updates go through the tree's shared notifier rather than each
+        // source's own AsyncUpdater, so they're coalesced into a single message
+        tree.addPropertyListener (property, this, sync ? sendNotificationSync : sendNotificationAsync);
     }
 
     ~ValueTreePropertyValueSource() override
     {
-        tree.removeListener (this);
+        tree.removePropertyListener (property, this);
     }
 
     var getValue() const override                 { return tree[property]; }
@@ -912,19 +1389,12 @@ private:
     ValueTree tree;
     const Identifier property;
     UndoManager* const undoManager;
-    const bool updateSynchronously;
 
-    void valueTreePropertyChanged (ValueTree& changedTree, const Identifier& changedProperty) override
+    void propertyChanged (ValueTree&, const Identifier&) override
     {
-        if (tree == changedTree && property == changedProperty)
-            sendChangeMessage (updateSynchronously);
+        sendChangeMessage (true);
     }
 
-    void valueTreeChildAdded (ValueTree&, ValueTree&) override {}
-    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override {}
-    void valueTreeChildOrderChanged (ValueTree&, int, int) override {}
-    void valueTreeParentChanged (ValueTree&) override {}
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreePropertyValueSource)
 };
 
@@ -1067,6 +1537,21 @@ void ValueTree::removeListener (Listener* listener)
         object->valueTreesWithListeners.removeValue (this);
 }
 
+void ValueTree::addPropertyListener (const Identifier& property, PropertyListener* listener,
+                                     NotificationType notification)
+{
+    jassert (property.isValid());
+
+    if (listener != nullptr && object != nullptr && notification != dontSendNotification)
+        object->addPropertyListener (property, listener, notification);
+}
+
+void ValueTree::removePropertyListener (const Identifier& property, PropertyListener* listener)
+{
+    if (object != nullptr)
+        object->removePropertyListener (property, listener);
+}
+
 void ValueTree::sendPropertyChangeMessage (const Identifier& property)
 {
     if (object != nullptr)
@@ -1100,15 +1585,7 @@ std::unique_ptr<XmlElement> ValueTree::createXml() const
 ValueTree ValueTree::fromXml (const XmlElement& xml)
 {
     if (! xml.isTextElement())
-    {
-        ValueTree v (xml.getTagName());
-        v.object->properties.setFromXmlAttributes (xml);
-
-        for (auto* e : xml.getChildIterator())
-            v.appendChild (fromXml (*e), nullptr);
-
-        return v;
-    }
+        return ValueTree (*SharedObject::createFromXml (xml));
 
     // ValueTrees don't have any equivalent to XML text elements!
     jassertfalse;
@@ -1123,6 +1600,17 @@ ValueTree ValueTree::fromXml (const String& xmlText)
     return {};
 }
 
+ValueTree ValueTree::fromXml (InputStream& xmlSource)
+{
+    XmlPullParser parser (xmlSource);
+
+    if (parser.next() == XmlPullParser::Event::startElement)
+        if (auto tree = SharedObject::createFromXml (parser))
+            return ValueTree (std::move (tree));
+
+    return {};
+}
+
 String ValueTree::toXmlString (const XmlElement::TextFormat& format) const
 {
     if (auto xml = createXml())
@@ -1198,27 +1686,31 @@ void ValueTree::Listener::valueTreePropertyChanged   (ValueTree&, const Identifi
 void ValueTree::Listener::valueTreeChildAdded        (ValueTree&, ValueTree&)        {}
 void ValueTree::Listener::valueTreeChildRemoved      (ValueTree&, ValueTree&, int)   {}
 void ValueTree::Listener::valueTreeChildOrderChanged (ValueTree&, int, int)          {}
-void ValueTree::Listener::valueTreeParentChanged     (ValueTree&)                    {}void ValueTree::Listener::valueTreeRedirected(ValueTree&) {}
-void ValueTree::Listener::valueTreeStructureChanged  (ValueTree&)                    {}
-
-//==============================================================================
-#if JUCE_ALLOW_STATIC_NULL_VARIABLES
-
-JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
-JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
-
-const ValueTree ValueTree::invalid;
-
-JUCE_END_IGNORE_WARNINGS_GCC_LIKE
-JUCE_END_IGNORE_WARNINGS_MSVC
-
-#endif
+void ValueTree::Listener::valueTreeParentChanged     (ValueTree&)                    {}void ValueTree::Listener::valueTreeRedirected(ValueTree&) {}
+void ValueTree::Listener::valueTreeStructureChanged  (ValueTree&)                    {}
+
+//==============================================================================
+#if JUCE_ALLOW_STATIC_NULL_VARIABLES
+
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
+JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
+
+const ValueTree ValueTree::invalid;
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+JUCE_END_IGNORE_WARNINGS_MSVC
+
+#endif
 
 
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
+#if ! (JUCE_MAC || JUCE_IOS || JUCE_ANDROID)
+ bool dispatchNextMessageOnSystemQueue (bool returnIfNoPendingMessages);
+#endif
+
 class ValueTreeTests  : public UnitTest
 {
 public:
@@ -1313,6 +1805,22 @@ public:
 
                 auto v4 = v2.createCopy();
                 expect (v1.isEquivalentTo (v4));
+
+                auto v5 = ValueTree::fromXml (*xml1);
+                expect (v1.isEquivalentTo (v5));
+                expect (v5.getParent() == ValueTree());
+
+                for (auto child : v5)
+                    expect (child.getParent() == v5 && child.getRoot() == v5);
+
+                MemoryOutputStream xmlText;
+                xml1->writeTo (xmlText);
+                MemoryInputStream xmlIn (xmlText.getData(), xmlText.getDataSize(), false);
+                auto v6 = ValueTree::fromXml (xmlIn);
+                expect (v5.isEquivalentTo (v6));
+
+                for (auto child : v6)
+                    expect (child.getParent() == v6 && child.getRoot() == v6);
             }
         }
 
@@ -1332,7 +1840,7 @@ public:
             tests[0.0123] = "0.0123";
             tests[-3.7e-27] = "-3.7e-27";
             tests[1e+40] = "1.0e40";
-            tests[-12345678901234567.0] = "-1.234567890123457e16";
+            tests[-12345678901234567.0] = "-1.2345678901234568e16";
             tests[192000] = "192000.0";
             tests[1234567] = "1.234567e6";
             tests[0.00006] = "0.00006";
@@ -1348,6 +1856,261 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Notification batches");
+
+            struct CountingListener  : public ValueTree::Listener
+            {
+                void valueTreePropertyChanged (ValueTree&, const Identifier&) override  { ++numPropertyChanges; }
+                void valueTreeChildAdded (ValueTree&, ValueTree&) override              { ++numChildChanges; }
+                void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override       { ++numChildChanges; }
+                void valueTreeStructureChanged (ValueTree&) override                   { ++numStructureChanges; }
+
+                int numPropertyChanges = 0, numChildChanges = 0, numStructureChanges = 0;
+            };
+
+            const Identifier type ("Tree"), prop ("prop"), other ("other");
+
+            ValueTree tree (type);
+            CountingListener listener;
+            tree.addListener (&listener);
+
+            {
+                ValueTree::ScopedNotificationBatch batch;
+                expect (ValueTree::ScopedNotificationBatch::isActive());
+
+                {
+                    ValueTree::ScopedNotificationBatch nested;
+
+                    for (int i = 0; i < 100; ++i)
+                        tree.setProperty (prop, i, nullptr);
+                }
+
+                tree.setProperty (other, "x", nullptr);
+                tree.appendChild (ValueTree (type), nullptr);
+                tree.appendChild (ValueTree (type), nullptr);
+                tree.getChild (0).setProperty (prop, 1, nullptr);
+
+                expectEquals (listener.numPropertyChanges, 0);
+                expectEquals (listener.numStructureChanges, 0);
+                expectEquals ((int) tree[prop], 99);
+                expectEquals (tree.getNumChildren(), 2);
+            }
+
+            expect (! ValueTree::ScopedNotificationBatch::isActive());
+            expectEquals (listener.numPropertyChanges, 3);
+            expectEquals (listener.numStructureChanges, 1);
+            expectEquals (listener.numChildChanges, 0);
+
+            tree.setProperty (prop, 0, nullptr);
+            tree.removeChild (0, nullptr);
+            expectEquals (listener.numPropertyChanges, 4);
+            expectEquals (listener.numChildChanges, 1);
+
+            tree.removeListener (&listener);
+        }
+
+        {
+            beginTest ("Notification batches with a synchroniser");
+
+            struct DirectSynchroniser  : public ValueTreeSynchroniser
+            {
+                DirectSynchroniser (const ValueTree& source, ValueTree& dest)
+                    : ValueTreeSynchroniser (source), target (dest) {}
+
+                void stateChanged (const void* data, size_t size) override
+                {
+                    ValueTreeSynchroniser::applyChange (target, data, size, nullptr);
+                }
+
+                ValueTree& target;
+            };
+
+            auto r = getRandom();
+            auto source = createRandomTree (nullptr, 0, r);
+            ValueTree target;
+            DirectSynchroniser sync (source, target);
+            sync.sendFullSyncCallback();
+            expect (source.isEquivalentTo (target));
+
+            {
+                ValueTree::ScopedNotificationBatch batch;
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    auto node = source;
+
+                    while (node.getNumChildren() > 0 && r.nextBool())
+                        node = node.getChild (r.nextInt (node.getNumChildren()));
+
+                    if (r.nextBool())
+                        node.setProperty (createRandomIdentifier (r), createRandomWideCharString (r), nullptr);
+                    else if (node.getNumChildren() > 0 && r.nextBool())
+                        node.removeChild (r.nextInt (node.getNumChildren()), nullptr);
+                    else
+                        node.appendChild (createRandomTree (nullptr, 1, r), nullptr);
+                }
+            }
+
+            expect (source.isEquivalentTo (target));
+        }
+
+        {
+            beginTest ("Property listeners are only called for their own property");
+
+            struct CountingPropertyListener  : public ValueTree::PropertyListener
+            {
+                void propertyChanged (ValueTree&, const Identifier& property) override
+                {
+                    lastProperty = property;
+                    ++count;
+                }
+
+                Identifier lastProperty;
+                int count = 0;
+            };
+
+            ValueTree tree ("root"), child ("child");
+            tree.appendChild (child, nullptr);
+
+            const Identifier a ("a"), b ("b");
+            std::vector<CountingPropertyListener> listeners (100);
+
+            for (auto& l : listeners)
+                tree.addPropertyListener (&l == &listeners.front() ? b : a, &l);
+
+            tree.setProperty (b, 1, nullptr);
+            expectEquals (listeners.front().count, 1);
+            expect (std::all_of (listeners.begin() + 1, listeners.end(), [] (auto& l) { return l.count == 0; }));
+
+            child.setProperty (a, 1, nullptr);
+            tree.setProperty (a, 2, nullptr);
+            tree.setProperty (a, 2, nullptr);
+            tree.removeProperty (a, nullptr);
+            expect (std::all_of (listeners.begin() + 1, listeners.end(), [] (auto& l) { return l.count == 2; }));
+            expect (listeners.back().lastProperty == a);
+
+            {
+                // Listeners follow the shared object rather than the ValueTree they were added with
+                ValueTree otherReference (tree);
+                ValueTree::ScopedNotificationBatch batch;
+                otherReference.setProperty (b, 2, nullptr);
+                otherReference.setProperty (b, 3, nullptr);
+                expectEquals (listeners.front().count, 1);
+            }
+
+            expectEquals (listeners.front().count, 2);
+
+            for (auto& l : listeners)
+                tree.removePropertyListener (&l == &listeners.front() ? b : a, &l);
+
+            tree.setProperty (a, 3, nullptr);
+            expectEquals (listeners.back().count, 2);
+        }
+
+        {
+            beginTest ("Property listeners can remove themselves during a callback");
+
+            struct RemovingListener  : public ValueTree::PropertyListener
+            {
+                void propertyChanged (ValueTree& tree, const Identifier& property) override
+                {
+                    ++count;
+                    tree.removePropertyListener (property, this);
+                }
+
+                int count = 0;
+            };
+
+            ValueTree tree ("root");
+            RemovingListener first, second;
+            tree.addPropertyListener ("x", &first);
+            tree.addPropertyListener ("x", &second);
+
+            tree.setProperty ("x", 1, nullptr);
+            tree.setProperty ("x", 2, nullptr);
+            expectEquals (first.count, 1);
+            expectEquals (second.count, 1);
+        }
+
+        {
+            beginTest ("CachedValues use property listeners");
+
+            ValueTree tree ("root");
+            CachedValue<int> first (tree, "first", nullptr), second (tree, "second", nullptr);
+
+            tree.setProperty ("first", 10, nullptr);
+            expectEquals (first.get(), 10);
+            expectEquals (second.get(), 0);
+
+            second.referTo (tree, "first", nullptr);
+            tree.setProperty ("first", 20, nullptr);
+            expectEquals (second.get(), 20);
+        }
+
+       #if ! (JUCE_MAC || JUCE_IOS || JUCE_ANDROID)
+        if (MessageManager::getInstance()->isThisTheMessageThread())
+        {
+            beginTest ("Asynchronous property changes are coalesced");
+
+            const auto dispatchUntil = [] (std::function<bool()> condition)
+            {
+                for (auto end = Time::getMillisecondCounter() + 5000; Time::getMillisecondCounter() < end;)
+                {
+                    if (condition())
+                        return true;
+
+                    if (! dispatchNextMessageOnSystemQueue (true))
+                        Thread::sleep (1);
+                }
+
+                return condition();
+            };
+
+            struct CountingPropertyListener  : public ValueTree::PropertyListener
+            {
+                void propertyChanged (ValueTree&, const Identifier&) override    { ++count; }
+                int count = 0;
+            };
+
+            ValueTree tree ("root");
+            CountingPropertyListener listener, removedListener;
+            tree.addPropertyListener ("x", &listener, sendNotificationAsync);
+            tree.addPropertyListener ("x", &removedListener, sendNotificationAsync);
+
+            for (int i = 0; i < 100; ++i)
+                tree.setProperty ("x", i, nullptr);
+
+            tree.removePropertyListener ("x", &removedListener);
+            expectEquals (listener.count, 0);
+            expect (dispatchUntil ([&] { return listener.count > 0; }));
+            expectEquals (listener.count, 1);
+            expectEquals (removedListener.count, 0);
+
+            auto value = tree.getPropertyAsValue ("x", nullptr);
+            int numValueChanges = 0;
+
+            struct ValueCounter  : public Value::Listener
+            {
+                explicit ValueCounter (int& c) : counter (c) {}
+                void valueChanged (Value&) override    { ++counter; }
+                int& counter;
+            };
+
+            ValueCounter valueCounter (numValueChanges);
+            value.addListener (&valueCounter);
+
+            tree.setProperty ("x", 1000, nullptr);
+            tree.setProperty ("x", 1001, nullptr);
+            expect (dispatchUntil ([&] { return numValueChanges > 0 && listener.count > 1; }));
+            expectEquals (numValueChanges, 1);
+            expect (value.getValue() == var (1001));
+
+            value.removeListener (&valueCounter);
+            tree.removePropertyListener ("x", &listener);
+        }
+       #endif
     }
 };
 
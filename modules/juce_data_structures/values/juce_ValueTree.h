@@ -455,6 +455,17 @@ public:
     */
     static ValueTree fromXml (const String& xmlText);
 
+    /** Tries to recreate a tree by reading its XML representation from a stream.
+
+        Rather than building an XmlElement first, this reads the XML directly with an
+        XmlPullParser, so it's much quicker and uses far less memory for large documents.
+        Like the other fromXml() methods, it should only be fed XML that was created by the
+        createXml() method.
+
+        @see XmlPullParser
+    */
+    static ValueTree fromXml (InputStream& xmlSource);
+
     /** This returns a string containing an XML representation of the tree.
         This is quite handy for debugging purposes, as it provides a quick way to view a tree.
         @see createXml()
@@ -571,6 +582,47 @@ public:
     /** Removes a listener that was previously added with addListener(). */
     void removeListener (Listener* listener);
 
+    //==============================================================================
+    /** Receives callbacks when one particular property of a tree changes.
+
+        A Listener is told about every change to a tree and all of its sub-trees, and has
+        to filter out the ones it's interested in. A PropertyListener is registered for a
+        single property of a single tree instead, so when lots of objects are each watching
+        a different property, only the ones watching the property that changed are called.
+
+        @see addPropertyListener, CachedValue
+    */
+    class JUCE_API  PropertyListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~PropertyListener() = default;
+
+        /** Called when the property that this listener was registered for is changed. */
+        virtual void propertyChanged (ValueTree& treeWhosePropertyHasChanged,
+                                      const Identifier& property) = 0;
+    };
+
+    /** Registers a listener to be called when one particular property of this tree changes.
+
+        Unlike addListener(), the listener is attached to the shared object that this tree
+        refers to, so it keeps working if this ValueTree object is deleted or made to refer
+        to a different tree. The listener must be removed with removePropertyListener()
+        before it's deleted.
+
+        If the notification type is sendNotificationAsync, changes are delivered on the
+        message thread. All the asynchronous property changes, across every tree, are
+        delivered together by a single message, and if a property changes several times
+        before that message arrives, its listeners are only called once.
+
+        @see removePropertyListener
+    */
+    void addPropertyListener (const Identifier& property, PropertyListener* listener,
+                              NotificationType notification = sendNotificationSync);
+
+    /** Removes a listener that was previously added with addPropertyListener(). */
+    void removePropertyListener (const Identifier& property, PropertyListener* listener);
+
     /** Changes a named property of the tree, but will not notify a specified listener of the change.
         @see setProperty
     */
@@ -593,6 +645,52 @@ public:
 	/* Notify listeners that the structure of the tree has changed
 	 */
     void sendStructureChangeMessage();
+
+    //==============================================================================
+    /**
+        Holds back and merges the listener callbacks for changes to ValueTrees made on
+        the current thread.
+
+        While one of these exists, changes to any ValueTree on the thread that created it
+        don't call their listeners straight away. When the outermost batch is deleted,
+        the merged notifications are delivered:
+         - each tree that had children added, removed or moved gets a single
+           Listener::valueTreeStructureChanged() callback, instead of the individual
+           child callbacks;
+         - then Listener::valueTreePropertyChanged() is called once for each property
+           that changed, however many times it was set.
+
+        So a large edit such as pasting thousands of nodes or loading a preset makes a
+        few callbacks rather than millions. Listeners see the tree in its final state,
+        so anything that relies on seeing the individual child changes should handle
+        valueTreeStructureChanged() by re-reading the children. ValueTreeSynchroniser
+        does this.
+
+        Listener::valueTreeParentChanged() and Listener::valueTreeRedirected() are still
+        called immediately. Batches can be nested, in which case only the outermost one
+        delivers anything.
+
+        @see UndoManager::setBatchValueTreeNotifications
+    */
+    class JUCE_API  ScopedNotificationBatch
+    {
+    public:
+        /** Starts holding back notifications on the calling thread. */
+        ScopedNotificationBatch();
+
+        /** Delivers the notifications, if this is the outermost batch. */
+        ~ScopedNotificationBatch();
+
+        /** Returns true if a batch is active on the calling thread. */
+        static bool isActive() noexcept;
+
+    private:
+        friend class SharedObject;
+        struct Queue;
+        std::unique_ptr<Queue> queue;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedNotificationBatch)
+    };
 	
     //==============================================================================
     /** This method uses a comparator object to sort the tree's children into order.
@@ -643,6 +741,7 @@ public:
 private:
     //==============================================================================
     friend class SharedObject;
+    friend class ValueTreeBinaryFormat;
 
     ReferenceCountedObjectPtr<SharedObject> object;
     ListenerList<Listener> listeners;
@@ -0,0 +1,725 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The data starts with a fixed-size header:
+//   4 bytes   "JVTB"
+//   1 byte    format version
+//   1 byte    compression (0 = none, 1 = LZ4 frame)
+//   2 bytes   reserved, currently zero
+//
+// The (possibly compressed) body then holds a table of all the identifiers that the
+// tree uses, followed by the root node. All counts and lengths are unsigned LEB128
+// varints, and integers are zig-zag encoded so that small negative numbers stay small.
+static constexpr const char binaryFormatMagic[] = { 'J', 'V', 'T', 'B' };
+static constexpr uint8 binaryFormatVersion = 1;
+static constexpr size_t binaryFormatHeaderSize = 8;
+
+namespace ValueTreeBinaryFormatHelpers
+{
+    enum VarTag : uint8
+    {
+        voidTag = 0,
+        intTag,
+        int64Tag,
+        falseTag,
+        trueTag,
+        doubleTag,
+        stringTag,
+        arrayTag,
+        binaryTag,
+        otherTag    // anything else, stored as a length followed by var::writeToStream() data
+    };
+
+    static uint8 getCompressionByte (ValueTreeBinaryFormat::Compression c) noexcept
+    {
+        return c == ValueTreeBinaryFormat::Compression::lz4 ? 1 : 0;
+    }
+
+    static uint64 zigZagEncode (int64 v) noexcept    { return ((uint64) v << 1) ^ (uint64) (v >> 63); }
+    static int64 zigZagDecode (uint64 v) noexcept    { return (int64) (v >> 1) ^ -(int64) (v & 1); }
+}
+
+//==============================================================================
+struct ValueTreeBinaryFormat::Writer
+{
+    explicit Writer (OutputStream& o) : out (o) {}
+
+    void writeTree (const ValueTree& tree)
+    {
+        if (tree.object == nullptr)
+        {
+            writeVarint (0); // no identifiers
+            writeVarint (0); // a type index of 0 marks an invalid tree
+            return;
+        }
+
+        collectIdentifiers (*tree.object);
+
+        writeVarint (identifiers.size());
+
+        for (auto& id : identifiers)
+            writeString (id.toString());
+
+        writeNode (*tree.object);
+    }
+
+private:
+    using SharedObject = ValueTree::SharedObject;
+
+    void collectIdentifiers (const SharedObject& node)
+    {
+        addIdentifier (node.type);
+
+        for (auto& p : node.properties)
+            addIdentifier (p.name);
+
+        for (auto* c : node.children)
+            collectIdentifiers (*c);
+    }
+
+    void addIdentifier (const Identifier& id)
+    {
+        // Identifiers are pooled, so the address of the text is enough to tell them apart
+        if (indices.emplace (id.getCharPointer().getAddress(), (uint64) identifiers.size()).second)
+            identifiers.push_back (id);
+    }
+
+    uint64 getIndex (const Identifier& id) const
+    {
+        return indices.find (id.getCharPointer().getAddress())->second;
+    }
+
+    void writeNode (const SharedObject& node)
+    {
+        writeVarint (getIndex (node.type) + 1);
+        writeVarint ((uint64) node.properties.size());
+
+        for (auto& p : node.properties)
+        {
+            writeVarint (getIndex (p.name));
+            writeVar (p.value);
+        }
+
+        writeVarint ((uint64) node.children.size());
+
+        for (auto* c : node.children)
+            writeNode (*c);
+    }
+
+    void writeVar (const var& v)
+    {
+        using namespace ValueTreeBinaryFormatHelpers;
+
+        if (v.isVoid())
+        {
+            writeTag (voidTag);
+        }
+        else if (v.isInt())
+        {
+            writeTag (intTag);
+            writeVarint (zigZagEncode ((int) v));
+        }
+        else if (v.isInt64())
+        {
+            writeTag (int64Tag);
+            writeVarint (zigZagEncode ((int64) v));
+        }
+        else if (v.isBool())
+        {
+            writeTag ((bool) v ? trueTag : falseTag);
+        }
+        else if (v.isDouble())
+        {
+            writeTag (doubleTag);
+            out.writeDouble ((double) v);
+        }
+        else if (v.isString())
+        {
+            writeTag (stringTag);
+            writeString (v.toString());
+        }
+        else if (auto* array = v.getArray())
+        {
+            writeTag (arrayTag);
+            writeVarint ((uint64) array->size());
+
+            for (auto& element : *array)
+                writeVar (element);
+        }
+        else if (auto* block = v.getBinaryData())
+        {
+            writeTag (binaryTag);
+            writeVarint (block->getSize());
+            out.write (block->getData(), block->getSize());
+        }
+        else
+        {
+            MemoryOutputStream mo;
+            v.writeToStream (mo);
+
+            writeTag (otherTag);
+            writeVarint (mo.getDataSize());
+            out.write (mo.getData(), mo.getDataSize());
+        }
+    }
+
+    void writeTag (uint8 tag)
+    {
+        out.writeByte ((char) tag);
+    }
+
+    void writeVarint (uint64 v)
+    {
+        uint8 buffer[10];
+        size_t num = 0;
+
+        while (v >= 0x80)
+        {
+            buffer[num++] = (uint8) (v | 0x80);
+            v >>= 7;
+        }
+
+        buffer[num++] = (uint8) v;
+        out.write (buffer, num);
+    }
+
+    void writeString (const String& s)
+    {
+        auto numBytes = s.getNumBytesAsUTF8();
+        writeVarint (numBytes);
+        out.write (s.toRawUTF8(), numBytes);
+    }
+
+    OutputStream& out;
+    std::vector<Identifier> identifiers;
+    std::unordered_map<const void*, uint64> indices;
+};
+
+//==============================================================================
+struct ValueTreeBinaryFormat::Reader
+{
+    Reader (const void* data, size_t numBytes) noexcept
+        : pos (static_cast<const uint8*> (data)), end (pos + numBytes)
+    {
+    }
+
+    ValueTree readTree()
+    {
+        uint64 numIdentifiers;
+
+        if (! readLength (numIdentifiers))
+            return {};
+
+        identifiers.reserve ((size_t) numIdentifiers);
+
+        for (uint64 i = 0; i < numIdentifiers; ++i)
+        {
+            String name;
+
+            if (! readString (name) || name.isEmpty())
+                return {};
+
+            identifiers.emplace_back (name);
+        }
+
+        auto root = readNode (0);
+
+        if (failed || pos != end)
+            return {};
+
+        return root;
+    }
+
+private:
+    using SharedObject = ValueTree::SharedObject;
+
+    // Deeper trees than this are treated as corrupt rather than risking the stack
+    static constexpr int maxDepth = 1024;
+
+    ValueTree fail()
+    {
+        failed = true;
+        return {};
+    }
+
+    ValueTree readNode (int depth)
+    {
+        uint64 typeIndex;
+
+        if (depth > maxDepth || ! readVarint (typeIndex) || typeIndex > identifiers.size())
+            return fail();
+
+        if (typeIndex == 0)
+            return depth == 0 ? ValueTree() : fail();
+
+        ValueTree node (identifiers[(size_t) typeIndex - 1]);
+        auto& object = *node.object;
+
+        // each property needs at least two bytes, and each child at least three,
+        // so these checks stop a corrupt count from triggering a huge allocation
+        uint64 numProperties;
+
+        if (! readVarint (numProperties) || numProperties > remaining() / 2)
+            return fail();
+
+        for (uint64 i = 0; i < numProperties; ++i)
+        {
+            uint64 nameIndex;
+            var value;
+
+            if (! readVarint (nameIndex) || nameIndex >= identifiers.size() || ! readVar (value, depth))
+                return fail();
+
+            object.properties.set (identifiers[(size_t) nameIndex], std::move (value));
+        }
+
+        uint64 numChildren;
+
+        if (! readVarint (numChildren) || numChildren > remaining() / 3)
+            return fail();
+
+        object.children.ensureStorageAllocated ((int) numChildren);
+
+        for (uint64 i = 0; i < numChildren; ++i)
+        {
+            auto child = readNode (depth + 1);
+
+            if (failed)
+                return {};
+
+            object.children.add (child.object);
+            child.object->parent = &object;
+        }
+
+        return node;
+    }
+
+    bool readVar (var& result, int depth)
+    {
+        using namespace ValueTreeBinaryFormatHelpers;
+
+        if (pos == end)
+            return false;
+
+        switch (*pos++)
+        {
+            case voidTag:
+                result = var();
+                return true;
+
+            case intTag:
+            {
+                uint64 v;
+
+                if (! readVarint (v))
+                    return false;
+
+                result = (int) zigZagDecode (v);
+                return true;
+            }
+
+            case int64Tag:
+            {
+                uint64 v;
+
+                if (! readVarint (v))
+                    return false;
+
+                result = zigZagDecode (v);
+                return true;
+            }
+
+            case falseTag:
+                result = false;
+                return true;
+
+            case trueTag:
+                result = true;
+                return true;
+
+            case doubleTag:
+            {
+                if (remaining() < 8)
+                    return false;
+
+                auto bits = ByteOrder::littleEndianInt64 (pos);
+                double d;
+                std::memcpy (&d, &bits, sizeof (d));
+                pos += 8;
+
+                result = d;
+                return true;
+            }
+
+            case stringTag:
+            {
+                String s;
+
+                if (! readString (s))
+                    return false;
+
+                result = std::move (s);
+                return true;
+            }
+
+            case arrayTag:
+            {
+                uint64 numElements;
+
+                if (depth >= maxDepth || ! readLength (numElements))
+                    return false;
+
+                Array<var> elements;
+                elements.ensureStorageAllocated ((int) numElements);
+
+                for (uint64 i = 0; i < numElements; ++i)
+                {
+                    var element;
+
+                    if (! readVar (element, depth + 1))
+                        return false;
+
+                    elements.add (std::move (element));
+                }
+
+                result = std::move (elements);
+                return true;
+            }
+
+            case binaryTag:
+            {
+                uint64 numBytes;
+
+                if (! readLength (numBytes))
+                    return false;
+
+                result = var (pos, (size_t) numBytes);
+                pos += numBytes;
+                return true;
+            }
+
+            case otherTag:
+            {
+                uint64 numBytes;
+
+                if (! readLength (numBytes))
+                    return false;
+
+                MemoryInputStream mi (pos, (size_t) numBytes, false);
+                result = var::readFromStream (mi);
+                pos += numBytes;
+                return true;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    bool readVarint (uint64& result) noexcept
+    {
+        result = 0;
+
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos == end)
+                return false;
+
+            auto byte = *pos++;
+            result |= (uint64) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool readLength (uint64& result) noexcept
+    {
+        return readVarint (result) && result <= remaining();
+    }
+
+    bool readString (String& result)
+    {
+        uint64 numBytes;
+
+        if (! readLength (numBytes) || numBytes > (uint64) std::numeric_limits<int>::max())
+            return false;
+
+        if (numBytes > 0)
+        {
+            auto text = reinterpret_cast<const char*> (pos);
+
+            if (! CharPointer_UTF8::isValidString (text, (int) numBytes))
+                return false;
+
+            result = String::fromUTF8 (text, (int) numBytes);
+            pos += numBytes;
+        }
+
+        return true;
+    }
+
+    uint64 remaining() const noexcept    { return (uint64) (end - pos); }
+
+    const uint8* pos;
+    const uint8* const end;
+    std::vector<Identifier> identifiers;
+    bool failed = false;
+};
+
+//==============================================================================
+void ValueTreeBinaryFormat::write (const ValueTree& tree, OutputStream& output, Compression compression)
+{
+    const uint8 header[binaryFormatHeaderSize] = { (uint8) binaryFormatMagic[0], (uint8) binaryFormatMagic[1],
+                                                   (uint8) binaryFormatMagic[2], (uint8) binaryFormatMagic[3],
+                                                   binaryFormatVersion,
+                                                   ValueTreeBinaryFormatHelpers::getCompressionByte (compression),
+                                                   0, 0 };
+    output.write (header, sizeof (header));
+
+    if (compression == Compression::lz4)
+    {
+        LZ4CompressorOutputStream compressed (output, 1);
+        Writer (compressed).writeTree (tree);
+    }
+    else
+    {
+        Writer (output).writeTree (tree);
+    }
+}
+
+void ValueTreeBinaryFormat::write (const ValueTree& tree, MemoryBlock& destData, Compression compression)
+{
+    MemoryOutputStream out (destData, false);
+    write (tree, out, compression);
+}
+
+bool ValueTreeBinaryFormat::isBinaryFormat (const void* data, size_t numBytes) noexcept
+{
+    return data != nullptr
+        && numBytes >= binaryFormatHeaderSize
+        && std::memcmp (data, binaryFormatMagic, sizeof (binaryFormatMagic)) == 0
+        && static_cast<const uint8*> (data)[4] == binaryFormatVersion;
+}
+
+ValueTree ValueTreeBinaryFormat::read (const void* data, size_t numBytes)
+{
+    if (! isBinaryFormat (data, numBytes))
+        return {};
+
+    auto body = addBytesToPointer (data, binaryFormatHeaderSize);
+    auto bodySize = numBytes - binaryFormatHeaderSize;
+
+    switch (static_cast<const uint8*> (data)[5])
+    {
+        case 0:
+            return Reader (body, bodySize).readTree();
+
+        case 1:
+        {
+            MemoryInputStream source (body, bodySize, false);
+            LZ4DecompressorInputStream decompressor (source);
+            MemoryBlock decompressed;
+
+            // LZ4 can't expand data by more than about 255 times, so corrupt data can't
+            // make this allocate more than that
+            auto maxSize = jmin ((uint64) bodySize * 256 + 1024, (uint64) std::numeric_limits<int>::max());
+            decompressor.readIntoMemoryBlock (decompressed, (ssize_t) maxSize);
+
+            if (decompressor.hasError())
+                return {};
+
+            return Reader (decompressed.getData(), decompressed.getSize()).readTree();
+        }
+
+        default:
+            return {};
+    }
+}
+
+ValueTree ValueTreeBinaryFormat::read (InputStream& input)
+{
+    MemoryBlock data;
+    input.readIntoMemoryBlock (data);
+    return read (data.getData(), data.getSize());
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeBinaryFormatTests  : public UnitTest
+{
+public:
+    ValueTreeBinaryFormatTests()
+        : UnitTest ("ValueTreeBinaryFormat", UnitTestCategories::values)
+    {}
+
+    static ValueTree createTestTree()
+    {
+        const char binary[] = { 0, 1, 2, 3, 127, -128, -1 };
+
+        ValueTree root ("root");
+        root.setProperty ("int", -12345, nullptr)
+            .setProperty ("int64", (int64) 0x7123456789abcdefLL, nullptr)
+            .setProperty ("bool", true, nullptr)
+            .setProperty ("false", false, nullptr)
+            .setProperty ("double", -3.25e-100, nullptr)
+            .setProperty ("string", String (CharPointer_UTF8 ("text \xe2\x82\xac \xf0\x9f\x8e\xb9")), nullptr)
+            .setProperty ("empty", String(), nullptr)
+            .setProperty ("void", var(), nullptr)
+            .setProperty ("binary", var (binary, sizeof (binary)), nullptr)
+            .setProperty ("array", Array<var> { 1, "two", 3.0, Array<var> { false, (int64) -1 } }, nullptr);
+
+        for (int i = 0; i < 50; ++i)
+        {
+            ValueTree param ("PARAM");
+            param.setProperty ("id", "param" + String (i), nullptr)
+                 .setProperty ("value", i * 0.125, nullptr);
+
+            if (i % 10 == 0)
+                param.appendChild (ValueTree ("nested").setProperty ("index", i, nullptr), nullptr);
+
+            root.appendChild (param, nullptr);
+        }
+
+        root.appendChild (ValueTree ("emptyChild"), nullptr);
+        return root;
+    }
+
+    void runTest() override
+    {
+        using Compression = ValueTreeBinaryFormat::Compression;
+
+        beginTest ("Trees survive a round trip");
+        {
+            auto tree = createTestTree();
+
+            for (auto compression : { Compression::none, Compression::lz4 })
+            {
+                MemoryBlock data;
+                ValueTreeBinaryFormat::write (tree, data, compression);
+
+                expect (ValueTreeBinaryFormat::isBinaryFormat (data.getData(), data.getSize()));
+
+                auto result = ValueTreeBinaryFormat::read (data.getData(), data.getSize());
+                expect (result.isEquivalentTo (tree));
+                expectEquals (result.getChild (0).getParent().getType().toString(), String ("root"));
+
+                MemoryInputStream in (data, false);
+                expect (ValueTreeBinaryFormat::read (in).isEquivalentTo (tree));
+            }
+
+            MemoryBlock data;
+            ValueTreeBinaryFormat::write ({}, data);
+            expect (ValueTreeBinaryFormat::isBinaryFormat (data.getData(), data.getSize()));
+            expect (! ValueTreeBinaryFormat::read (data.getData(), data.getSize()).isValid());
+        }
+
+        beginTest ("Writing repeatedly into the same block replaces its contents");
+        {
+            auto tree = createTestTree();
+
+            MemoryBlock first, data;
+            ValueTreeBinaryFormat::write (tree, first, Compression::none);
+
+            ValueTreeBinaryFormat::write (tree, data, Compression::none);
+            ValueTreeBinaryFormat::write (tree, data, Compression::none);
+            expect (data == first);
+
+            ValueTreeBinaryFormat::write (ValueTree ("small"), data, Compression::none);
+            expect (data.getSize() < first.getSize());
+            expect (ValueTreeBinaryFormat::read (data.getData(), data.getSize()).isEquivalentTo (ValueTree ("small")));
+        }
+
+        beginTest ("The format is smaller than ValueTree::writeToStream");
+        {
+            auto tree = createTestTree();
+
+            MemoryOutputStream legacy;
+            tree.writeToStream (legacy);
+
+            MemoryBlock uncompressed, compressed;
+            ValueTreeBinaryFormat::write (tree, uncompressed, Compression::none);
+            ValueTreeBinaryFormat::write (tree, compressed, Compression::lz4);
+
+            expect (uncompressed.getSize() < legacy.getDataSize());
+            expect (compressed.getSize() < uncompressed.getSize());
+        }
+
+        beginTest ("Truncated or corrupt data is rejected");
+        {
+            auto tree = createTestTree();
+
+            for (auto compression : { Compression::none, Compression::lz4 })
+            {
+                MemoryBlock data;
+                ValueTreeBinaryFormat::write (tree, data, compression);
+
+                for (size_t size = 0; size < data.getSize(); size += (compression == Compression::none ? 1 : 7))
+                    expect (! ValueTreeBinaryFormat::read (data.getData(), size).isValid());
+            }
+
+            MemoryBlock data;
+            ValueTreeBinaryFormat::write (tree, data, Compression::none);
+
+            auto wrongMagic = data;
+            wrongMagic[0] = 'X';
+            expect (! ValueTreeBinaryFormat::read (wrongMagic.getData(), wrongMagic.getSize()).isValid());
+
+            auto wrongVersion = data;
+            wrongVersion[4] = 99;
+            expect (! ValueTreeBinaryFormat::read (wrongVersion.getData(), wrongVersion.getSize()).isValid());
+
+            auto trailingData = data;
+            trailingData.append ("x", 1);
+            expect (! ValueTreeBinaryFormat::read (trailingData.getData(), trailingData.getSize()).isValid());
+
+            Random r (0x1234);
+
+            for (int i = 0; i < 500; ++i)
+            {
+                auto damaged = data;
+
+                for (int j = 0; j < 4; ++j)
+                    damaged[(size_t) r.nextInt ((int) damaged.getSize() - (int) binaryFormatHeaderSize) + binaryFormatHeaderSize] = (char) r.nextInt (256);
+
+                // this just needs to not crash or read out of bounds
+                ValueTreeBinaryFormat::read (damaged.getData(), damaged.getSize());
+            }
+        }
+    }
+};
+
+static ValueTreeBinaryFormatTests valueTreeBinaryFormatTests;
+
+#endif
+
+} // namespace juce
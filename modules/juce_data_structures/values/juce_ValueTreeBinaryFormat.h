@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads and writes ValueTrees in a compact binary format built for speed.
+
+    This is intended for data that gets saved and restored often, such as a
+    plugin's state. Compared with ValueTree::writeToStream(), each property and type
+    name is only stored once in a table at the start of the data, numbers are stored as
+    variable-length integers, and the data can optionally be LZ4-compressed, which is
+    quick enough to use every time the host asks for the state.
+
+    When reading data in a block of memory, the tree is built directly from that
+    block, without copying it into a stream first. Any data that's truncated or
+    corrupt is rejected, and produces an invalid ValueTree.
+
+    @code
+    void getStateInformation (MemoryBlock& destData) override
+    {
+        ValueTreeBinaryFormat::write (state, destData);
+    }
+
+    void setStateInformation (const void* data, int size) override
+    {
+        auto newState = ValueTreeBinaryFormat::read (data, (size_t) size);
+
+        if (newState.isValid())
+            state = newState;
+    }
+    @endcode
+
+    @see ValueTree::writeToStream, AudioProcessor::copyValueTreeToBinary
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeBinaryFormat
+{
+public:
+    //==============================================================================
+    /** The ways in which the body of the data can be stored. */
+    enum class Compression
+    {
+        none,   /**< The tree is stored uncompressed, which is the quickest to read and write. */
+        lz4     /**< The tree is compressed with the fastest LZ4 compression level. */
+    };
+
+    //==============================================================================
+    /** Writes a tree (and all its children) to a stream. */
+    static void write (const ValueTree& tree, OutputStream& output, Compression compression = Compression::lz4);
+
+    /** Replaces the contents of a MemoryBlock with a tree (and all its children).
+
+        The block's existing allocation is reused if it's big enough, so when saving
+        the same tree repeatedly into the same block, this won't usually need to
+        allocate any memory for the data itself.
+    */
+    static void write (const ValueTree& tree, MemoryBlock& destData, Compression compression = Compression::lz4);
+
+    //==============================================================================
+    /** Returns true if the given data begins with the header written by write(). */
+    static bool isBinaryFormat (const void* data, size_t numBytes) noexcept;
+
+    /** Reads a tree from a block of data that was written with write().
+
+        This returns an invalid tree if the data isn't in this format or is corrupt.
+    */
+    static ValueTree read (const void* data, size_t numBytes);
+
+    /** Reads a tree from a stream that was written with write().
+
+        The rest of the stream is read into memory before being parsed. This returns an
+        invalid tree if the data isn't in this format or is corrupt.
+    */
+    static ValueTree read (InputStream& input);
+
+private:
+    //==============================================================================
+    struct Writer;
+    struct Reader;
+
+    ValueTreeBinaryFormat() = delete;
+};
+
+} // namespace juce
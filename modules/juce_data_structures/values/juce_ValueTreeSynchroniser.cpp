@@ -35,7 +35,11 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        subTreeSync      = 7,
+        deltaBatch       = 8,
+        snapshot         = 9,
+        propertyChangedCompressed = 10
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -71,6 +75,51 @@ namespace ValueTreeSynchroniserHelpers
             stream.writeCompressedInt (path.getUnchecked(i));
     }
 
+    static bool writeCompressed (MemoryOutputStream& stream, const MemoryOutputStream& data, int threshold)
+    {
+        if (threshold <= 0 || data.getDataSize() < (size_t) threshold)
+            return false;
+
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream gzip (compressed);
+            gzip.write (data.getData(), data.getDataSize());
+        }
+
+        if (compressed.getDataSize() >= data.getDataSize())
+            return false;
+
+        stream.writeCompressedInt ((int) data.getDataSize());
+        stream.writeCompressedInt ((int) compressed.getDataSize());
+        stream << compressed;
+        return true;
+    }
+
+    static var readCompressedVar (MemoryInputStream& input)
+    {
+        const int uncompressedSize = input.readCompressedInt();
+        const int compressedSize = input.readCompressedInt();
+
+        if (compressedSize <= 0 || (int64) compressedSize > input.getNumBytesRemaining())
+            return {};
+
+        MemoryBlock compressed;
+        input.readIntoMemoryBlock (compressed, compressedSize);
+
+        MemoryInputStream compressedStream (compressed, false);
+        GZIPDecompressorInputStream gzip (compressedStream);
+
+        MemoryBlock data;
+        gzip.readIntoMemoryBlock (data);
+
+        if ((int) data.getSize() != uncompressedSize)
+            return {};
+
+        MemoryInputStream dataStream (data, false);
+        return var::readFromStream (dataStream);
+    }
+
     static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
     {
         const int numLevels = input.readCompressedInt();
@@ -99,34 +148,155 @@ ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTre
 
 ValueTreeSynchroniser::~ValueTreeSynchroniser()
 {
+    cancelPendingUpdate();
     valueTree.removeListener (this);
 }
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    const ScopedLock sl (pendingLock);
     MemoryOutputStream m;
-    writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
+
+    if (batchingEnabled)
+    {
+        pendingChanges.clear();
+        pendingPropertyChanges.clear();
+
+        writeHeader (m, ValueTreeSynchroniserHelpers::snapshot);
+        m.writeCompressedInt ((int) sequenceNumber);
+    }
+    else
+    {
+        writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
+    }
+
     valueTree.writeToStream (m);
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::setDeltaBatchingEnabled (bool shouldBatchChanges)
+{
+    if (batchingEnabled != shouldBatchChanges)
+    {
+        if (! shouldBatchChanges)
+            flushPendingChanges();
+
+        const ScopedLock sl (pendingLock);
+        batchingEnabled = shouldBatchChanges;
+    }
+}
+
+void ValueTreeSynchroniser::setCompressionThreshold (int minimumNumBytesToCompress) noexcept
+{
+    compressionThreshold = jmax (0, minimumNumBytesToCompress);
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    const ScopedLock sl (pendingLock);
+
+    if (pendingChanges.empty())
+        return;
+
+    int numChanges = 0;
+
+    for (auto& change : pendingChanges)
+        if (! change.isEmpty())
+            ++numChanges;
+
+    MemoryOutputStream m;
+    writeHeader (m, ValueTreeSynchroniserHelpers::deltaBatch);
+    m.writeCompressedInt ((int) ++sequenceNumber);
+    m.writeCompressedInt (numChanges);
+
+    for (auto& change : pendingChanges)
+    {
+        if (! change.isEmpty())
+        {
+            m.writeCompressedInt ((int) change.getSize());
+            m << change;
+        }
+    }
+
+    pendingChanges.clear();
+    pendingPropertyChanges.clear();
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::handleAsyncUpdate()
+{
+    flushPendingChanges();
+}
+
+void ValueTreeSynchroniser::sendChange (const MemoryOutputStream& m)
+{
+    {
+        const ScopedLock sl (pendingLock);
+
+        if (batchingEnabled)
+        {
+            // the paths of any earlier property changes may not be valid after this one,
+            // so they mustn't be merged with later changes to the same properties
+            pendingPropertyChanges.clear();
+            pendingChanges.emplace_back (m.getData(), m.getDataSize());
+            triggerAsyncUpdate();
+            return;
+        }
+    }
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::sendChange (const MemoryOutputStream& m, size_t propertyKeySize)
+{
+    {
+        const ScopedLock sl (pendingLock);
+
+        if (batchingEnabled)
+        {
+            // the key skips the change type, so that setting and removing a property are merged too
+            const std::string key (static_cast<const char*> (m.getData()) + 1, propertyKeySize - 1);
+            const auto existing = pendingPropertyChanges.find (key);
+
+            if (existing != pendingPropertyChanges.end())
+                pendingChanges[existing->second].reset();
+
+            pendingPropertyChanges[key] = pendingChanges.size();
+            pendingChanges.emplace_back (m.getData(), m.getDataSize());
+            triggerAsyncUpdate();
+            return;
+        }
+    }
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
     {
-        ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyChanged, vt);
+        MemoryOutputStream valueData;
+        value->writeToStream (valueData);
+
+        MemoryOutputStream compressed;
+        const bool isCompressed = ValueTreeSynchroniserHelpers::writeCompressed (compressed, valueData, compressionThreshold);
+
+        ValueTreeSynchroniserHelpers::writeHeader (*this, m, isCompressed ? ValueTreeSynchroniserHelpers::propertyChangedCompressed
+                                                                          : ValueTreeSynchroniserHelpers::propertyChanged, vt);
         m.writeString (property.toString());
-        value->writeToStream (m);
+        const auto keySize = m.getDataSize();
+        m << (isCompressed ? compressed : valueData);
+        sendChange (m, keySize);
     }
     else
     {
         ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyRemoved, vt);
         m.writeString (property.toString());
+        sendChange (m, m.getDataSize());
     }
-
-    stateChanged (m.getData(), m.getDataSize());
 }
 
 void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
@@ -138,7 +308,7 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
     childTree.writeToStream (m);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
@@ -146,7 +316,7 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
@@ -155,7 +325,15 @@ void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int o
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
     m.writeCompressedInt (newIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
+}
+
+void ValueTreeSynchroniser::valueTreeStructureChanged (ValueTree& tree)
+{
+    MemoryOutputStream m;
+    ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::subTreeSync, tree);
+    tree.writeToStream (m);
+    sendChange (m);
 }
 
 bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
@@ -170,6 +348,32 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::snapshot)
+    {
+        input.readCompressedInt();
+        root = ValueTree::readFromStream (input);
+        return true;
+    }
+
+    if (type == ValueTreeSynchroniserHelpers::deltaBatch)
+    {
+        input.readCompressedInt();
+        bool ok = true;
+
+        for (int i = input.readCompressedInt(); --i >= 0;)
+        {
+            const int size = input.readCompressedInt();
+
+            if (size <= 0 || (int64) size > input.getNumBytesRemaining())
+                return false;
+
+            ok = applyChange (root, addBytesToPointer (data, input.getPosition()), (size_t) size, undoManager) && ok;
+            input.skipNextBytes (size);
+        }
+
+        return ok;
+    }
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
@@ -184,6 +388,21 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
             return true;
         }
 
+        case ValueTreeSynchroniserHelpers::propertyChangedCompressed:
+        {
+            Identifier property (input.readString());
+            auto value = ValueTreeSynchroniserHelpers::readCompressedVar (input);
+
+            if (! value.isVoid())
+            {
+                v.setProperty (property, value, undoManager);
+                return true;
+            }
+
+            jassertfalse; // Seem to have received some corrupt data?
+            break;
+        }
+
         case ValueTreeSynchroniserHelpers::propertyRemoved:
         {
             Identifier property (input.readString());
@@ -228,7 +447,23 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
             break;
         }
 
+        case ValueTreeSynchroniserHelpers::subTreeSync:
+        {
+            auto newState = ValueTree::readFromStream (input);
+
+            if (newState.hasType (v.getType()))
+            {
+                v.copyPropertiesAndChildrenFrom (newState, undoManager);
+                return true;
+            }
+
+            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+            break;
+        }
+
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::snapshot:
+        case ValueTreeSynchroniserHelpers::deltaBatch:
             break;
 
         default:
@@ -239,4 +474,235 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+ValueTreeSynchroniser::Receiver::Receiver (ValueTree& targetTree, UndoManager* undoManagerToUse)
+    : target (targetTree), undoManager (undoManagerToUse)
+{
+}
+
+bool ValueTreeSynchroniser::Receiver::applyChange (const void* data, size_t dataSize)
+{
+    if (dataSize == 0)
+        return false;
+
+    MemoryInputStream input (data, dataSize, false);
+    const auto type = (ValueTreeSynchroniserHelpers::ChangeType) input.readByte();
+
+    if (type == ValueTreeSynchroniserHelpers::snapshot)
+    {
+        const auto sequence = (uint32) input.readCompressedInt();
+        auto newState = ValueTree::readFromStream (input);
+
+        if (! newState.isValid())
+        {
+            resyncNeeded();
+            return false;
+        }
+
+        target = newState;
+        lastSequenceNumber = sequence;
+        inSync = true;
+        waitingForSnapshot = false;
+        return true;
+    }
+
+    if (type == ValueTreeSynchroniserHelpers::deltaBatch)
+    {
+        const auto sequence = (uint32) input.readCompressedInt();
+
+        if (! inSync || sequence != lastSequenceNumber + 1
+             || ! ValueTreeSynchroniser::applyChange (target, data, dataSize, undoManager))
+        {
+            resyncNeeded();
+            return false;
+        }
+
+        lastSequenceNumber = sequence;
+        return true;
+    }
+
+    return ValueTreeSynchroniser::applyChange (target, data, dataSize, undoManager);
+}
+
+void ValueTreeSynchroniser::Receiver::resyncNeeded()
+{
+    inSync = false;
+
+    if (! waitingForSnapshot)
+    {
+        waitingForSnapshot = true;
+
+        if (onResyncNeeded != nullptr)
+            onResyncNeeded();
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests  : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct RecordingSynchroniser  : public ValueTreeSynchroniser
+    {
+        using ValueTreeSynchroniser::ValueTreeSynchroniser;
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            messages.emplace_back (data, size);
+        }
+
+        std::vector<MemoryBlock> messages;
+    };
+
+    static void makeRandomChanges (ValueTree tree, int numChanges, Random& r)
+    {
+        for (int i = 0; i < numChanges; ++i)
+        {
+            auto node = tree;
+
+            while (node.getNumChildren() > 0 && r.nextBool())
+                node = node.getChild (r.nextInt (node.getNumChildren()));
+
+            switch (r.nextInt (5))
+            {
+                case 0:  node.setProperty (ValueTreeTests::createRandomIdentifier (r), ValueTreeTests::createRandomWideCharString (r), nullptr); break;
+                case 1:  node.setProperty ("value", r.nextInt(), nullptr); break;
+                case 2:  if (node.getNumChildren() > 0) node.removeChild (r.nextInt (node.getNumChildren()), nullptr); break;
+                case 3:  if (node.getNumChildren() > 1) node.moveChild (0, node.getNumChildren() - 1, nullptr); break;
+                default: node.appendChild (ValueTreeTests::createRandomTree (nullptr, 3, r), nullptr); break;
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Batched changes");
+        {
+            auto source = ValueTreeTests::createRandomTree (nullptr, 0, r);
+            ValueTree target;
+
+            RecordingSynchroniser sync (source);
+            sync.setDeltaBatchingEnabled (true);
+            ValueTreeSynchroniser::Receiver receiver (target);
+
+            sync.sendFullSyncCallback();
+            expect (receiver.applyChange (sync.messages.back().getData(), sync.messages.back().getSize()));
+            expect (receiver.isInSync());
+
+            for (int i = 0; i < 100; ++i)
+                source.setProperty ("counter", i, nullptr);
+
+            expectEquals ((int) sync.messages.size(), 1);
+
+            sync.flushPendingChanges();
+            sync.flushPendingChanges();
+            expectEquals ((int) sync.messages.size(), 2);
+            expectEquals ((int) sync.getLastSequenceNumber(), 1);
+
+            expect (receiver.applyChange (sync.messages.back().getData(), sync.messages.back().getSize()));
+            expect (source.isEquivalentTo (target));
+
+            for (int batch = 0; batch < 10; ++batch)
+            {
+                makeRandomChanges (source, 20, r);
+                sync.flushPendingChanges();
+
+                expect (receiver.applyChange (sync.messages.back().getData(), sync.messages.back().getSize()));
+                expect (source.isEquivalentTo (target));
+            }
+
+            expectEquals ((int) receiver.getLastSequenceNumber(), (int) sync.getLastSequenceNumber());
+
+            sync.setDeltaBatchingEnabled (false);
+            const auto numMessages = sync.messages.size();
+            source.setProperty ("counter", -1, nullptr);
+            expectEquals ((int) sync.messages.size(), (int) numMessages + 1);
+            expect (receiver.applyChange (sync.messages.back().getData(), sync.messages.back().getSize()));
+            expect (source.isEquivalentTo (target));
+        }
+
+        beginTest ("Compressed properties");
+        {
+            ValueTree source ("Root"), target;
+            source.appendChild (ValueTree ("Child"), nullptr);
+
+            RecordingSynchroniser sync (source);
+            sync.sendFullSyncCallback();
+            ValueTreeSynchroniser::applyChange (target, sync.messages.back().getData(), sync.messages.back().getSize(), nullptr);
+
+            sync.setCompressionThreshold (64);
+
+            const auto longText = String::repeatedString ("abcdefgh", 1000);
+            source.getChild (0).setProperty ("text", longText, nullptr);
+            expect (sync.messages.back().getSize() < 200);
+
+            source.setProperty ("short", "x", nullptr);
+            expect (ValueTreeSynchroniser::applyChange (target, sync.messages[1].getData(), sync.messages[1].getSize(), nullptr));
+            expect (ValueTreeSynchroniser::applyChange (target, sync.messages[2].getData(), sync.messages[2].getSize(), nullptr));
+
+            expectEquals (target.getChild (0)["text"].toString(), longText);
+            expect (source.isEquivalentTo (target));
+        }
+
+        beginTest ("Resync after a missing batch");
+        {
+            auto source = ValueTreeTests::createRandomTree (nullptr, 0, r);
+            ValueTree target;
+
+            RecordingSynchroniser sync (source);
+            sync.setDeltaBatchingEnabled (true);
+
+            int numResyncRequests = 0;
+            ValueTreeSynchroniser::Receiver receiver (target);
+            receiver.onResyncNeeded = [&] { ++numResyncRequests; };
+
+            auto sendBatch = [&]
+            {
+                makeRandomChanges (source, 10, r);
+                source.setProperty ("value", r.nextInt(), nullptr);
+                sync.flushPendingChanges();
+                return sync.messages.back();
+            };
+
+            auto apply = [&] (const MemoryBlock& m)  { return receiver.applyChange (m.getData(), m.getSize()); };
+
+            // a receiver that starts late needs a snapshot before it can apply anything
+            expect (! apply (sendBatch()));
+            expectEquals (numResyncRequests, 1);
+
+            sync.sendFullSyncCallback();
+            expect (apply (sync.messages.back()));
+            expect (source.isEquivalentTo (target));
+            expect (apply (sendBatch()));
+
+            sendBatch(); // lost in transit
+            expect (! apply (sendBatch()));
+            expect (! apply (sendBatch()));
+            expect (! receiver.isInSync());
+            expectEquals (numResyncRequests, 2);
+
+            makeRandomChanges (source, 10, r);
+            sync.sendFullSyncCallback();
+            expect (apply (sync.messages.back()));
+            expect (receiver.isInSync());
+            expect (source.isEquivalentTo (target));
+
+            expect (apply (sendBatch()));
+            expect (source.isEquivalentTo (target));
+            expectEquals (numResyncRequests, 2);
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
+
 } // namespace juce
@@ -40,9 +40,19 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    Changes made inside a ValueTree::ScopedNotificationBatch are sent as one message
+    with the new state of each sub-tree whose children changed, followed by one message
+    for each property that changed.
+
+    For trees that change very often, call setDeltaBatchingEnabled() so that the changes
+    are gathered up and sent together as numbered batches, and setCompressionThreshold()
+    so that large property values are compressed. A ValueTreeSynchroniser::Receiver at
+    the other end can then spot a lost or out-of-order batch and ask for a new snapshot.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private AsyncUpdater
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -67,9 +77,54 @@ public:
         encodes the entire ValueTree.
 
         This will internally invoke stateChanged() with the encoded version of the state.
+
+        If delta batching is enabled, this sends a snapshot that is stamped with the
+        number of the last batch that was sent, and any changes that are still waiting
+        to be sent are dropped, because the snapshot already contains them.
     */
     void sendFullSyncCallback();
 
+    //==============================================================================
+    /** Enables or disables the batching of changes.
+
+        When this is enabled, changes aren't sent to stateChanged() as they happen.
+        Instead, they're collected and sent as a single message the next time the message
+        thread gets round to it, or when you call flushPendingChanges(). Each batch carries
+        a sequence number, so a Receiver can tell if one went missing.
+
+        If a property changes several times before a batch is sent, only its final value
+        is sent.
+
+        Disabling batching sends any changes that were still pending.
+    */
+    void setDeltaBatchingEnabled (bool shouldBatchChanges);
+
+    /** Returns true if changes are being batched. */
+    bool isDeltaBatchingEnabled() const noexcept        { return batchingEnabled; }
+
+    /** Immediately sends any batched changes that haven't been sent yet.
+
+        If you're using batching on a thread that doesn't have a message loop, you'll
+        need to call this yourself, e.g. once per block or timer tick. It can be called
+        from any thread. Calling it when there's nothing pending does nothing, and
+        doesn't use up a sequence number.
+    */
+    void flushPendingChanges();
+
+    /** Returns the sequence number of the last batch that was sent. */
+    uint32 getLastSequenceNumber() const noexcept       { return sequenceNumber; }
+
+    /** Sets the size above which property values are compressed before sending.
+
+        Values whose encoded form is at least this number of bytes are sent gzipped, as
+        long as that actually makes them smaller. A threshold of 0 (the default) turns
+        compression off.
+    */
+    void setCompressionThreshold (int minimumNumBytesToCompress) noexcept;
+
+    //==============================================================================
+    class Receiver;
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -86,12 +141,79 @@ public:
 private:
     ValueTree valueTree;
 
+    CriticalSection pendingLock;
+    std::vector<MemoryBlock> pendingChanges;
+    std::map<std::string, size_t> pendingPropertyChanges;
+    uint32 sequenceNumber = 0;
+    int compressionThreshold = 0;
+    bool batchingEnabled = false;
+
+    void sendChange (const MemoryOutputStream&);
+    void sendChange (const MemoryOutputStream&, size_t propertyKeySize);
+    void handleAsyncUpdate() override;
+
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
     void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void valueTreeStructureChanged (ValueTree&) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSynchroniser)
 };
 
+//==============================================================================
+/**
+    Applies the changes sent by a ValueTreeSynchroniser to a tree, and keeps track
+    of whether it has missed any.
+
+    When the sender has delta batching enabled, each batch of changes is numbered. If
+    a batch arrives that doesn't directly follow the last one, the receiver stops
+    applying changes and calls onResyncNeeded, at which point you should get the sender
+    to call sendFullSyncCallback(). Once the resulting snapshot arrives, the target is
+    replaced with it and the batches that follow it are applied as normal.
+
+    Messages that aren't numbered, i.e. those sent while batching is disabled, are
+    always applied, just as ValueTreeSynchroniser::applyChange() would.
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSynchroniser::Receiver
+{
+public:
+    /** Creates a receiver that applies changes to the given tree.
+        The tree and undo manager must outlive the receiver.
+    */
+    Receiver (ValueTree& targetTree, UndoManager* undoManagerToUse = nullptr);
+
+    /** Applies a message that was sent to ValueTreeSynchroniser::stateChanged().
+
+        Returns false if the message couldn't be applied, either because it was corrupt
+        or because the receiver is waiting for a snapshot.
+    */
+    bool applyChange (const void* encodedChangeData, size_t encodedChangeDataSize);
+
+    /** Returns true if the target is known to match the sender's tree, as of the last
+        batch or snapshot that was received.
+    */
+    bool isInSync() const noexcept                      { return inSync; }
+
+    /** Returns the sequence number of the last batch or snapshot that was applied. */
+    uint32 getLastSequenceNumber() const noexcept       { return lastSequenceNumber; }
+
+    /** Called when a batch is missing or can't be applied, so a new snapshot is needed.
+        This is only called once each time the receiver loses sync.
+    */
+    std::function<void()> onResyncNeeded;
+
+private:
+    ValueTree& target;
+    UndoManager* undoManager;
+    uint32 lastSequenceNumber = 0;
+    bool inSync = false, waitingForSnapshot = false;
+
+    void resyncNeeded();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Receiver)
+};
+
 } // namespace juce
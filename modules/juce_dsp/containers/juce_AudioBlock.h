@@ -143,6 +143,35 @@ public:
         }
     }
 
+    /** Takes a suitable amount of space from a ScratchArena, and initialises this object
+        to point into it. This doesn't allocate, so can be used on the audio thread.
+
+        The space is given back when the arena's enclosing ScratchArena::Scope ends, so
+        this object mustn't be used after that. If the arena doesn't have enough space
+        left, this will be an empty block.
+    */
+    AudioBlock (ScratchArena& arenaToUseForAllocation,
+                size_t numberOfChannels, size_t numberOfSamples,
+                size_t alignmentInBytes = defaultAlignment) noexcept
+    {
+        auto roundedUpNumSamples = (numberOfSamples + elementMask) & ~elementMask;
+        auto* chanArray = arenaToUseForAllocation.allocate<SampleType*> (numberOfChannels);
+        auto* data = arenaToUseForAllocation.allocate<SampleType> (roundedUpNumSamples * numberOfChannels, alignmentInBytes);
+
+        if (chanArray == nullptr || data == nullptr)
+            return;
+
+        channels = chanArray;
+        numChannels = static_cast<ChannelCountType> (numberOfChannels);
+        numSamples = numberOfSamples;
+
+        for (ChannelCountType i = 0; i < numChannels; ++i)
+        {
+            chanArray[i] = data;
+            data += roundedUpNumSamples;
+        }
+    }
+
     /** Creates an AudioBlock that points to the data in an AudioBuffer.
         AudioBlock does not copy nor own the memory pointed to by dataToUse.
         Therefore it is the user's responsibility to ensure that the buffer is retained
@@ -766,6 +795,14 @@ private:
         {
             multiplyByInternal ((NumericType) value.getTargetValue());
         }
+        else if constexpr (std::is_same_v<OtherSampleType, NumericType>)
+        {
+            value.forEachRampChunk ((int) numSamples, [this] (const NumericType* ramp, int start, int num)
+            {
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    FloatVectorOperations::multiply (getDataPointer (ch) + start, ramp, num);
+            });
+        }
         else
         {
             for (size_t i = 0; i < numSamples; ++i)
@@ -787,6 +824,16 @@ private:
         {
             replaceWithProductOfInternal (src, (NumericType) value.getTargetValue());
         }
+        else if constexpr (std::is_same_v<SmootherSampleType, NumericType> && std::is_same_v<std::remove_const_t<BlockSampleType>, NumericType>)
+        {
+            auto n = jmin (numSamples, src.numSamples) * sizeFactor;
+
+            value.forEachRampChunk ((int) n, [this, &src] (const NumericType* ramp, int start, int num)
+            {
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    FloatVectorOperations::multiply (getDataPointer (ch) + start, src.getChannelPointer (ch) + start, ramp, num);
+            });
+        }
         else
         {
             auto n = jmin (numSamples, src.numSamples) * sizeFactor;
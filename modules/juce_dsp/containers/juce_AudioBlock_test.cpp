@@ -74,6 +74,24 @@ public:
             expect (block == AudioBlock<const SampleType> (block));
         }
 
+        beginTest ("Allocating from a ScratchArena");
+        {
+            ScratchArena arena (4096);
+
+            {
+                const ScratchArena::Scope scope (arena);
+
+                AudioBlock<SampleType> arenaBlock (arena, 2, (size_t) numSamples);
+                expectEquals ((int) arenaBlock.getNumChannels(), 2);
+                expectEquals ((int) arenaBlock.getNumSamples(), numSamples);
+
+                arenaBlock.fill ((NumericType) 1);
+                expect (arenaBlock.getSample (1, numSamples - 1) == (NumericType) 1);
+            }
+
+            expectEquals (arena.getNumBytesUsed(), (size_t) 0);
+        }
+
         beginTest ("Swap");
         {
             resetBlocks();
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+namespace detail
+{
+
+/*  Helpers for classes that keep their state in a Vector type which is either a
+    SIMDRegister or, when JUCE_USE_SIMD is disabled, a plain sample. They let the
+    same code read and write the individual lanes either way.
+*/
+template <typename SampleType>
+static SampleType getLane (SampleType v, size_t) noexcept                   { return v; }
+
+template <typename SampleType>
+static void setLane (SampleType& v, size_t, SampleType value) noexcept      { v = value; }
+
+template <typename SampleType>
+static SampleType truncate (SampleType v) noexcept                          { return std::trunc (v); }
+
+template <typename SampleType>
+static SampleType sum (SampleType v) noexcept                               { return v; }
+
+template <typename SampleType>
+static void store (SampleType v, SampleType* dest) noexcept                 { *dest = v; }
+
+#if JUCE_USE_SIMD
+template <typename SampleType>
+static SampleType getLane (SIMDRegister<SampleType> v, size_t i) noexcept   { return v.get (i); }
+
+template <typename SampleType>
+static void setLane (SIMDRegister<SampleType>& v, size_t i, SampleType value) noexcept  { v.set (i, value); }
+
+template <typename SampleType>
+static SIMDRegister<SampleType> truncate (SIMDRegister<SampleType> v) noexcept          { return SIMDRegister<SampleType>::truncate (v); }
+
+template <typename SampleType>
+static SampleType sum (SIMDRegister<SampleType> v) noexcept                 { return v.sum(); }
+
+template <typename SampleType>
+static void store (SIMDRegister<SampleType> v, SampleType* dest) noexcept   { v.copyToRawArray (dest); }
+#endif
+
+/*  Loads a Vector from an array that's aligned to the size of the Vector. */
+template <typename Vector, typename SampleType>
+static Vector load (const SampleType* v) noexcept
+{
+   #if JUCE_USE_SIMD
+    return Vector::fromRawArray (v);
+   #else
+    return *v;
+   #endif
+}
+
+} // namespace detail
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,382 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    A view of some sample data in which the channels and samples are a fixed
+    distance apart, such as an interleaved stream.
+
+    The sample for a given channel and index is found at:
+    @code
+    data[channel * channelStride + index * sampleStride]
+    @endcode
+
+    so an interleaved buffer has a channel stride of 1 and a sample stride equal to
+    the number of channels, and planar channels laid out one after the other in a
+    single buffer have a sample stride of 1. This means interleaved device or plugin
+    data can be processed in place, without converting it to separate channels first.
+
+    Where the layouts allow it, the arithmetic functions use FloatVectorOperations:
+    if the blocks are the same shape and cover an unbroken range of memory, the whole
+    block is processed as a single vector, and if each channel's samples are contiguous,
+    it's processed a channel at a time. Otherwise the samples are visited one by one.
+
+    Like AudioBlock, this class doesn't own any of the data that it points to.
+
+    @see AudioBlock
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class StridedAudioBlock
+{
+public:
+    //==============================================================================
+    using NumericType = std::remove_const_t<SampleType>;
+
+    static_assert (std::is_floating_point_v<NumericType>, "StridedAudioBlock only supports float and double samples");
+
+    //==============================================================================
+    /** Creates an empty block. */
+    StridedAudioBlock() noexcept = default;
+
+    /** Creates a block from a pointer to the first sample of the first channel and
+        the distances, in samples, between channels and between consecutive samples.
+    */
+    constexpr StridedAudioBlock (SampleType* firstSample,
+                                 size_t numberOfChannels, size_t numberOfSamples,
+                                 size_t distanceBetweenChannels, size_t distanceBetweenSamples) noexcept
+        : data (firstSample),
+          numChannels (numberOfChannels),
+          numSamples (numberOfSamples),
+          channelStride (distanceBetweenChannels),
+          sampleStride (distanceBetweenSamples)
+    {
+    }
+
+    /** Creates a block that refers to interleaved data, in which each frame holds one
+        sample for each channel.
+    */
+    static constexpr StridedAudioBlock fromInterleaved (SampleType* interleavedData,
+                                                        size_t numberOfChannels,
+                                                        size_t numberOfSamples) noexcept
+    {
+        return { interleavedData, numberOfChannels, numberOfSamples, 1, numberOfChannels };
+    }
+
+    /** Creates a block that refers to planar data, in which each channel's samples
+        follow on directly from the previous channel's.
+    */
+    static constexpr StridedAudioBlock fromPlanar (SampleType* planarData,
+                                                   size_t numberOfChannels,
+                                                   size_t numberOfSamples) noexcept
+    {
+        return { planarData, numberOfChannels, numberOfSamples, numberOfSamples, 1 };
+    }
+
+    /** Allows a block of non-const samples to be used as a block of const ones. */
+    template <typename OtherSampleType,
+              std::enable_if_t<std::is_same_v<SampleType, const OtherSampleType>, int> = 0>
+    constexpr StridedAudioBlock (const StridedAudioBlock<OtherSampleType>& other) noexcept
+        : StridedAudioBlock (other.getChannelPointer (0), other.getNumChannels(), other.getNumSamples(),
+                             other.getChannelStride(), other.getSampleStride())
+    {
+    }
+
+    //==============================================================================
+    /** Returns the number of channels referenced by this block. */
+    constexpr size_t getNumChannels() const noexcept    { return numChannels; }
+
+    /** Returns the number of samples referenced by this block. */
+    constexpr size_t getNumSamples() const noexcept     { return numSamples; }
+
+    /** Returns the distance, in samples, between the start of one channel and the next. */
+    constexpr size_t getChannelStride() const noexcept  { return channelStride; }
+
+    /** Returns the distance, in samples, between one sample of a channel and the next. */
+    constexpr size_t getSampleStride() const noexcept   { return sampleStride; }
+
+    /** Returns true if each channel's samples are next to each other in memory. */
+    constexpr bool hasContiguousChannels() const noexcept  { return sampleStride == 1 || numSamples <= 1; }
+
+    /** Returns a pointer to the first sample of a channel. The channel's later samples
+        are getSampleStride() apart.
+    */
+    constexpr SampleType* getChannelPointer (size_t channel) const noexcept
+    {
+        return data + channel * channelStride;
+    }
+
+    /** Returns a sample. The channel and index are expected to be in range. */
+    NumericType getSample (int channel, int sampleIndex) const noexcept
+    {
+        return *getSamplePointer ((size_t) channel, (size_t) sampleIndex);
+    }
+
+    /** Changes a sample. The channel and index are expected to be in range. */
+    void setSample (int channel, int sampleIndex, NumericType newValue) const noexcept
+    {
+        *getSamplePointer ((size_t) channel, (size_t) sampleIndex) = newValue;
+    }
+
+    /** Adds a value to a sample. The channel and index are expected to be in range. */
+    void addSample (int channel, int sampleIndex, NumericType valueToAdd) const noexcept
+    {
+        *getSamplePointer ((size_t) channel, (size_t) sampleIndex) += valueToAdd;
+    }
+
+    //==============================================================================
+    /** Returns a block that refers to one of this block's channels. */
+    StridedAudioBlock getSingleChannelBlock (size_t channel) const noexcept
+    {
+        jassert (channel < numChannels);
+        return { getChannelPointer (channel), 1, numSamples, channelStride, sampleStride };
+    }
+
+    /** Returns a block that refers to a range of this block's channels. */
+    StridedAudioBlock getSubsetChannelBlock (size_t channelStart, size_t numChannelsToUse) const noexcept
+    {
+        jassert (channelStart + numChannelsToUse <= numChannels);
+        return { getChannelPointer (channelStart), numChannelsToUse, numSamples, channelStride, sampleStride };
+    }
+
+    /** Returns a block that refers to a range of this block's samples. */
+    StridedAudioBlock getSubBlock (size_t startSample, size_t length) const noexcept
+    {
+        jassert (startSample + length <= numSamples);
+        return { data + startSample * sampleStride, numChannels, length, channelStride, sampleStride };
+    }
+
+    //==============================================================================
+    /** Clears all the samples. */
+    const StridedAudioBlock& clear() const noexcept
+    {
+        apply ([] (NumericType* d, int n) { FloatVectorOperations::clear (d, n); },
+               [] (NumericType& d) { d = {}; });
+        return *this;
+    }
+
+    /** Sets all the samples to a value. */
+    const StridedAudioBlock& JUCE_VECTOR_CALLTYPE fill (NumericType value) const noexcept
+    {
+        apply ([value] (NumericType* d, int n) { FloatVectorOperations::fill (d, value, n); },
+               [value] (NumericType& d) { d = value; });
+        return *this;
+    }
+
+    /** Adds a value to all the samples. */
+    const StridedAudioBlock& JUCE_VECTOR_CALLTYPE add (NumericType value) const noexcept
+    {
+        apply ([value] (NumericType* d, int n) { FloatVectorOperations::add (d, value, n); },
+               [value] (NumericType& d) { d += value; });
+        return *this;
+    }
+
+    /** Multiplies all the samples by a value. */
+    const StridedAudioBlock& JUCE_VECTOR_CALLTYPE multiplyBy (NumericType value) const noexcept
+    {
+        apply ([value] (NumericType* d, int n) { FloatVectorOperations::multiply (d, value, n); },
+               [value] (NumericType& d) { d *= value; });
+        return *this;
+    }
+
+    //==============================================================================
+    /** Copies the samples from another block, which may have a different layout.
+        If the blocks are different sizes, only the overlapping part is copied.
+    */
+    const StridedAudioBlock& copyFrom (const StridedAudioBlock<const NumericType>& src) const noexcept
+    {
+        apply (src,
+               [] (NumericType* d, const NumericType* s, int n) { FloatVectorOperations::copy (d, s, n); },
+               [] (NumericType& d, NumericType s) { d = s; });
+        return *this;
+    }
+
+    /** Copies the samples from an AudioBlock. */
+    const StridedAudioBlock& copyFrom (const AudioBlock<const NumericType>& src) const noexcept
+    {
+        for (size_t ch = 0; ch < jmin (numChannels, src.getNumChannels()); ++ch)
+            getSingleChannelBlock (ch).copyFrom (StridedAudioBlock<const NumericType>::fromAudioBlockChannel (src, ch));
+
+        return *this;
+    }
+
+    /** Copies this block's samples into an AudioBlock. */
+    void copyTo (const AudioBlock<NumericType>& dest) const noexcept
+    {
+        for (size_t ch = 0; ch < jmin (numChannels, dest.getNumChannels()); ++ch)
+            StridedAudioBlock<NumericType>::fromAudioBlockChannel (dest, ch).copyFrom (getSingleChannelBlock (ch));
+    }
+
+    /** Adds the samples from another block, which may have a different layout.
+        If the blocks are different sizes, only the overlapping part is processed.
+    */
+    const StridedAudioBlock& add (const StridedAudioBlock<const NumericType>& src) const noexcept
+    {
+        apply (src,
+               [] (NumericType* d, const NumericType* s, int n) { FloatVectorOperations::add (d, s, n); },
+               [] (NumericType& d, NumericType s) { d += s; });
+        return *this;
+    }
+
+    /** Multiplies the samples by those in another block, which may have a different layout.
+        If the blocks are different sizes, only the overlapping part is processed.
+    */
+    const StridedAudioBlock& multiplyBy (const StridedAudioBlock<const NumericType>& src) const noexcept
+    {
+        apply (src,
+               [] (NumericType* d, const NumericType* s, int n) { FloatVectorOperations::multiply (d, s, n); },
+               [] (NumericType& d, NumericType s) { d *= s; });
+        return *this;
+    }
+
+    /** Replaces the samples with those of another block plus a value. */
+    const StridedAudioBlock& JUCE_VECTOR_CALLTYPE replaceWithSumOf (const StridedAudioBlock<const NumericType>& src, NumericType value) const noexcept
+    {
+        apply (src,
+               [value] (NumericType* d, const NumericType* s, int n) { FloatVectorOperations::add (d, s, value, n); },
+               [value] (NumericType& d, NumericType s) { d = s + value; });
+        return *this;
+    }
+
+    /** Replaces the samples with the sum of two other blocks. */
+    const StridedAudioBlock& replaceWithSumOf (const StridedAudioBlock<const NumericType>& src1,
+                                               const StridedAudioBlock<const NumericType>& src2) const noexcept
+    {
+        const auto chans = jmin (numChannels, src1.getNumChannels(), src2.getNumChannels());
+        const auto n = jmin (numSamples, src1.getNumSamples(), src2.getNumSamples());
+
+        if (isSameShapeAs (src1, chans, n) && isSameShapeAs (src2, chans, n) && isDense())
+        {
+            FloatVectorOperations::add (data, src1.getChannelPointer (0), src2.getChannelPointer (0), (int) (chans * n));
+            return *this;
+        }
+
+        for (size_t ch = 0; ch < chans; ++ch)
+        {
+            auto* d = getChannelPointer (ch);
+            auto* s1 = src1.getChannelPointer (ch);
+            auto* s2 = src2.getChannelPointer (ch);
+
+            if (hasContiguousChannels() && src1.hasContiguousChannels() && src2.hasContiguousChannels())
+            {
+                FloatVectorOperations::add (d, s1, s2, (int) n);
+            }
+            else
+            {
+                for (size_t i = 0; i < n; ++i)
+                    d[i * sampleStride] = s1[i * src1.getSampleStride()] + s2[i * src2.getSampleStride()];
+            }
+        }
+
+        return *this;
+    }
+
+private:
+    //==============================================================================
+    template <typename> friend class StridedAudioBlock;
+
+    SampleType* getSamplePointer (size_t channel, size_t index) const noexcept
+    {
+        jassert (channel < numChannels && index < numSamples);
+        return data + channel * channelStride + index * sampleStride;
+    }
+
+    static StridedAudioBlock fromAudioBlockChannel (const AudioBlock<SampleType>& block, size_t channel) noexcept
+    {
+        return { block.getNumSamples() > 0 ? block.getChannelPointer (channel) : nullptr, 1, block.getNumSamples(), 0, 1 };
+    }
+
+    // True if the samples cover an unbroken range of memory with nothing else in it
+    bool isDense() const noexcept
+    {
+        return (hasContiguousChannels() && (numChannels <= 1 || channelStride == numSamples))
+            || (channelStride == 1 && sampleStride == numChannels);
+    }
+
+    // True if every sample of both blocks is at the same offset from the start
+    template <typename OtherSampleType>
+    bool isSameShapeAs (const StridedAudioBlock<OtherSampleType>& other, size_t chans, size_t n) const noexcept
+    {
+        return chans == numChannels && chans == other.numChannels
+            && n == numSamples && n == other.numSamples
+            && channelStride == other.channelStride && sampleStride == other.sampleStride;
+    }
+
+    template <typename VectorOp, typename ScalarOp>
+    void apply (VectorOp&& vectorOp, ScalarOp&& scalarOp) const noexcept
+    {
+        if (isDense())
+        {
+            vectorOp (data, (int) (numChannels * numSamples));
+            return;
+        }
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* d = getChannelPointer (ch);
+
+            if (hasContiguousChannels())
+                vectorOp (d, (int) numSamples);
+            else
+                for (size_t i = 0; i < numSamples; ++i)
+                    scalarOp (d[i * sampleStride]);
+        }
+    }
+
+    template <typename VectorOp, typename ScalarOp>
+    void apply (const StridedAudioBlock<const NumericType>& src, VectorOp&& vectorOp, ScalarOp&& scalarOp) const noexcept
+    {
+        const auto chans = jmin (numChannels, src.numChannels);
+        const auto n = jmin (numSamples, src.numSamples);
+
+        if (isSameShapeAs (src, chans, n) && isDense())
+        {
+            vectorOp (data, src.data, (int) (chans * n));
+            return;
+        }
+
+        for (size_t ch = 0; ch < chans; ++ch)
+        {
+            auto* d = getChannelPointer (ch);
+            auto* s = src.getChannelPointer (ch);
+
+            if (hasContiguousChannels() && src.hasContiguousChannels())
+                vectorOp (d, s, (int) n);
+            else
+                for (size_t i = 0; i < n; ++i)
+                    scalarOp (d[i * sampleStride], s[i * src.sampleStride]);
+        }
+    }
+
+    //==============================================================================
+    SampleType* data = nullptr;
+    size_t numChannels = 0, numSamples = 0, channelStride = 0, sampleStride = 1;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename SampleType>
+class StridedAudioBlockUnitTests   : public UnitTest
+{
+public:
+    StridedAudioBlockUnitTests()
+        : UnitTest ("StridedAudioBlock", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Interleaved and planar layouts address the same samples");
+        {
+            std::vector<SampleType> interleaved (numChannels * numSamples), planar (numChannels * numSamples);
+
+            auto a = StridedAudioBlock<SampleType>::fromInterleaved (interleaved.data(), numChannels, numSamples);
+            auto b = StridedAudioBlock<SampleType>::fromPlanar (planar.data(), numChannels, numSamples);
+
+            expect (a.getChannelStride() == 1 && a.getSampleStride() == numChannels);
+            expect (b.getChannelStride() == numSamples && b.getSampleStride() == 1);
+
+            fillWithIndices (a);
+            b.copyFrom (a);
+
+            for (size_t i = 0; i < interleaved.size(); ++i)
+                expectEquals (interleaved[i], (SampleType) ((i % numChannels) * 100 + i / numChannels));
+
+            for (size_t i = 0; i < planar.size(); ++i)
+                expectEquals (planar[i], (SampleType) ((i / numSamples) * 100 + i % numSamples));
+        }
+
+        beginTest ("Arithmetic gives the same results for every layout");
+        {
+            for (auto layoutA : { Layout::interleaved, Layout::planar, Layout::padded })
+            {
+                for (auto layoutB : { Layout::interleaved, Layout::planar, Layout::padded })
+                {
+                    Buffer dest (layoutA), src (layoutB), other (layoutB);
+                    fillWithIndices (dest.block);
+                    fillWithIndices (src.block);
+                    other.block.fill ((SampleType) 2);
+
+                    dest.block.add (src.block).multiplyBy ((SampleType) 0.5).add ((SampleType) 1);
+                    expectAll (dest.block, [] (SampleType x) { return x + 1; });
+
+                    dest.block.multiplyBy (other.block);
+                    expectAll (dest.block, [] (SampleType x) { return 2 * (x + 1); });
+
+                    dest.block.replaceWithSumOf (src.block, (SampleType) 3);
+                    expectAll (dest.block, [] (SampleType x) { return x + 3; });
+
+                    dest.block.replaceWithSumOf (src.block, other.block);
+                    expectAll (dest.block, [] (SampleType x) { return x + 2; });
+
+                    dest.block.clear();
+                    expectAll (dest.block, [] (SampleType) { return (SampleType) 0; });
+
+                    expect (std::all_of (dest.padding(), dest.storage.cend(), [] (SampleType x) { return x == guard; }));
+                }
+            }
+        }
+
+        beginTest ("Sub-blocks");
+        {
+            Buffer buffer (Layout::interleaved);
+            fillWithIndices (buffer.block);
+
+            buffer.block.getSubBlock (2, 3).getSingleChannelBlock (1).fill ((SampleType) -1);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectEquals (buffer.block.getSample ((int) ch, (int) i),
+                                  (ch == 1 && i >= 2 && i < 5) ? (SampleType) -1 : index (ch, i));
+
+            auto subset = buffer.block.getSubsetChannelBlock (1, 2);
+            expect (subset.getNumChannels() == 2);
+            expectEquals (subset.getSample (1, 0), index (2, 0));
+        }
+
+        beginTest ("Copying to and from an AudioBlock");
+        {
+            HeapBlock<char> heap;
+            AudioBlock<SampleType> planar (heap, numChannels, numSamples);
+            Buffer buffer (Layout::interleaved);
+            fillWithIndices (buffer.block);
+
+            buffer.block.copyTo (planar);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectEquals (planar.getSample ((int) ch, (int) i), index (ch, i));
+
+            buffer.block.clear();
+            buffer.block.copyFrom (planar);
+            expectAll (buffer.block, [] (SampleType x) { return x; });
+        }
+    }
+
+private:
+    enum class Layout { interleaved, planar, padded };
+
+    // A block with some spare samples at the end of the storage, and for the padded
+    // layout, between the channels, all of which should be left alone
+    struct Buffer
+    {
+        explicit Buffer (Layout layout)
+            : storage (numChannels * (numSamples + extra) + extra, guard),
+              block (layout == Layout::interleaved ? StridedAudioBlock<SampleType>::fromInterleaved (storage.data(), numChannels, numSamples)
+                   : layout == Layout::planar      ? StridedAudioBlock<SampleType>::fromPlanar (storage.data(), numChannels, numSamples)
+                                                   : StridedAudioBlock<SampleType> (storage.data(), numChannels, numSamples, numSamples + extra, 1))
+        {
+            if (layout != Layout::padded)
+                extraSpace = storage.size() - numChannels * numSamples;
+        }
+
+        auto padding() const    { return storage.end() - (std::ptrdiff_t) extraSpace; }
+
+        static constexpr size_t extra = 3;
+        std::vector<SampleType> storage;
+        StridedAudioBlock<SampleType> block;
+        size_t extraSpace = extra;
+    };
+
+    static SampleType index (size_t channel, size_t sample)     { return (SampleType) (channel * 100 + sample); }
+
+    static void fillWithIndices (const StridedAudioBlock<SampleType>& block)
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+                block.setSample ((int) ch, (int) i, index (ch, i));
+    }
+
+    template <typename Fn>
+    void expectAll (const StridedAudioBlock<SampleType>& block, Fn&& expected)
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+                expectEquals (block.getSample ((int) ch, (int) i), expected (index (ch, i)));
+    }
+
+    static constexpr SampleType guard = (SampleType) 12345;
+    static constexpr size_t numChannels = 3, numSamples = 7;
+};
+
+static StridedAudioBlockUnitTests<float> stridedAudioBlockFloatUnitTests;
+static StridedAudioBlockUnitTests<double> stridedAudioBlockDoubleUnitTests;
+
+} // namespace dsp
+} // namespace juce
@@ -189,6 +189,42 @@ struct FilterDesign
     static ReferenceCountedArray<IIRCoefficients> designIIRHighpassHighOrderButterworthMethod (FloatType frequency, double sampleRate,
                                                                                                int order);
 
+    /** This method returns the same low-pass filter as designIIRLowpassHighOrderButterworthMethod,
+        but as second order sections held by value for use with an IIR::CascadedFilter.
+
+        Nothing is allocated, so this can be used to redesign the filter on the audio
+        thread, for example when its cutoff frequency is being automated.
+
+        @param frequency                    the cutoff frequency of the low-pass filter
+        @param sampleRate                   the sample rate being used in the filter design
+        @tparam Order                       the order of the resulting IIR filter, providing
+                                            an attenuation of -6 dB times order / octave
+    */
+    template <int Order>
+    static IIR::SecondOrderSections<FloatType, (size_t) (Order + 1) / 2> designIIRLowpassHighOrderButterworthSections (FloatType frequency,
+                                                                                                             double sampleRate) noexcept
+    {
+        return designButterworthSections<Order> (frequency, sampleRate, true);
+    }
+
+    /** This method returns the same high-pass filter as designIIRHighpassHighOrderButterworthMethod,
+        but as second order sections held by value for use with an IIR::CascadedFilter.
+
+        Nothing is allocated, so this can be used to redesign the filter on the audio
+        thread, for example when its cutoff frequency is being automated.
+
+        @param frequency                    the cutoff frequency of the high-pass filter
+        @param sampleRate                   the sample rate being used in the filter design
+        @tparam Order                       the order of the resulting IIR filter, providing
+                                            an attenuation of -6 dB times order / octave
+    */
+    template <int Order>
+    static IIR::SecondOrderSections<FloatType, (size_t) (Order + 1) / 2> designIIRHighpassHighOrderButterworthSections (FloatType frequency,
+                                                                                                              double sampleRate) noexcept
+    {
+        return designButterworthSections<Order> (frequency, sampleRate, false);
+    }
+
     /** This method returns an array of IIR::Coefficients, made to be used in
         cascaded IIRFilters, providing a minimum phase low-pass filter without any
         ripple in the stop band only.
@@ -285,6 +321,36 @@ struct FilterDesign
                                                                                         FloatType stopbandAmplitudedB);
 
 private:
+    template <int Order>
+    static IIR::SecondOrderSections<FloatType, (size_t) (Order + 1) / 2> designButterworthSections (FloatType frequency, double sampleRate,
+                                                                                           bool isLowPass) noexcept
+    {
+        static_assert (Order > 0, "The order must be at least one");
+
+        jassert (sampleRate > 0);
+        jassert (frequency > 0 && frequency <= sampleRate * 0.5);
+
+        using ArrayCoeffs = IIR::ArrayCoefficients<FloatType>;
+        IIR::SecondOrderSections<FloatType, (size_t) (Order + 1) / 2> result;
+        size_t section = 0;
+
+        if constexpr (Order % 2 == 1)
+            result.setSection (section++, isLowPass ? ArrayCoeffs::makeFirstOrderLowPass  (sampleRate, frequency)
+                                                    : ArrayCoeffs::makeFirstOrderHighPass (sampleRate, frequency));
+
+        for (int i = 0; i < Order / 2; ++i)
+        {
+            const auto angle = Order % 2 == 1 ? (i + 1.0) * MathConstants<double>::pi / Order
+                                              : (2.0 * i + 1.0) * MathConstants<double>::pi / (Order * 2.0);
+            const auto Q = static_cast<FloatType> (1.0 / (2.0 * std::cos (angle)));
+
+            result.setSection (section++, isLowPass ? ArrayCoeffs::makeLowPass  (sampleRate, frequency, Q)
+                                                    : ArrayCoeffs::makeHighPass (sampleRate, frequency, Q));
+        }
+
+        return result;
+    }
+
     //==============================================================================
     static Array<double> getPartialImpulseResponseHn (int n, double kp);
 
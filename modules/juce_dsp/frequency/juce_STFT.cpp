@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+STFT::STFT (int fftOrder, int hopSizeToUse, WindowingFunction<float>::WindowingMethod windowType)
+    : fft (fftOrder),
+      fftSize ((size_t) fft.getSize()),
+      hopSize ((size_t) jlimit (1, fft.getSize(), hopSizeToUse)),
+      analysisWindow (fftSize),
+      synthesisWindow (fftSize)
+{
+    jassert (hopSizeToUse > 0 && hopSizeToUse <= fft.getSize());
+
+    // A periodic window, which is the first fftSize points of a symmetric window
+    // one point longer, overlaps evenly
+    std::vector<float> window (fftSize + 1);
+    WindowingFunction<float>::fillWindowingTables (window.data(), fftSize + 1, windowType, false);
+    std::copy (window.begin(), window.begin() + (std::ptrdiff_t) fftSize, analysisWindow.begin());
+
+    // Each output sample is the sum of the overlapping frames, each multiplied by the
+    // window twice, so divide by that sum to reconstruct the input
+    for (size_t i = 0; i < fftSize; ++i)
+    {
+        double sumOfSquares = 0.0;
+
+        for (auto j = i % hopSize; j < fftSize; j += hopSize)
+            sumOfSquares += (double) analysisWindow[j] * (double) analysisWindow[j];
+
+        // If this fails, the window is zero at some point in every frame that overlaps
+        // it, so the input can't be reconstructed: try a smaller hop size
+        jassert (sumOfSquares > 1.0e-6);
+
+        synthesisWindow[i] = sumOfSquares > 1.0e-6 ? (float) (analysisWindow[i] / sumOfSquares) : 0.0f;
+    }
+}
+
+//==============================================================================
+void STFT::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    numChannels = spec.numChannels;
+
+    inputFrames.setSize ((int) numChannels, (int) fftSize);
+    overlapAdd.setSize ((int) numChannels, (int) fftSize);
+    fftData.resize (numChannels * fftSize * 2);
+    spectra.resize (numChannels);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        spectra[channel] = reinterpret_cast<Complex<float>*> (fftData.data() + channel * fftSize * 2);
+
+    reset();
+}
+
+void STFT::reset() noexcept
+{
+    inputFrames.clear();
+    overlapAdd.clear();
+    hopPosition = 0;
+}
+
+//==============================================================================
+void STFT::processSamples (const AudioBlock<const float>& inputBlock, AudioBlock<float>& outputBlock) noexcept
+{
+    const auto numBlockChannels = outputBlock.getNumChannels();
+    const auto numSamples = outputBlock.getNumSamples();
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        const auto numToProcess = jmin (numSamples - start, hopSize - hopPosition);
+        const auto completesFrame = hopPosition + numToProcess == hopSize;
+
+        // The last sample of a hop is output after its frame has been added, which
+        // keeps the latency down to one sample less than a frame
+        const auto numBeforeFrame = completesFrame ? numToProcess - 1 : numToProcess;
+
+        for (size_t channel = 0; channel < numBlockChannels; ++channel)
+        {
+            FloatVectorOperations::copy (inputFrames.getWritePointer ((int) channel, (int) (fftSize - hopSize + hopPosition)),
+                                         inputBlock.getChannelPointer (channel) + start,
+                                         (int) numToProcess);
+
+            FloatVectorOperations::copy (outputBlock.getChannelPointer (channel) + start,
+                                         overlapAdd.getReadPointer ((int) channel) + hopPosition + 1,
+                                         (int) numBeforeFrame);
+        }
+
+        if (completesFrame)
+        {
+            processFrame (numBlockChannels);
+
+            for (size_t channel = 0; channel < numBlockChannels; ++channel)
+                outputBlock.getChannelPointer (channel)[start + numToProcess - 1] = overlapAdd.getSample ((int) channel, 0);
+        }
+
+        hopPosition = (hopPosition + numToProcess) % hopSize;
+        start += numToProcess;
+    }
+}
+
+void STFT::processFrame (size_t numChannelsToProcess) noexcept
+{
+    const auto stride = fftSize * 2;
+    const auto numToKeep = fftSize - hopSize;
+
+    for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+    {
+        auto* frame = inputFrames.getWritePointer ((int) channel);
+
+        FloatVectorOperations::multiply (fftData.data() + channel * stride, frame, analysisWindow.data(), (int) fftSize);
+        std::memmove (frame, frame + hopSize, numToKeep * sizeof (float));
+    }
+
+    fft.performRealOnlyForwardTransformBatch (fftData.data(), (int) numChannelsToProcess, stride, true);
+
+    if (spectralCallback != nullptr)
+        spectralCallback ({ spectra.data(), numChannelsToProcess, fftSize / 2 + 1 });
+
+    fft.performRealOnlyInverseTransformBatch (fftData.data(), (int) numChannelsToProcess, stride);
+
+    for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+    {
+        auto* output = overlapAdd.getWritePointer ((int) channel);
+
+        std::memmove (output, output + hopSize, numToKeep * sizeof (float));
+        FloatVectorOperations::clear (output + numToKeep, (int) hopSize);
+        FloatVectorOperations::addWithMultiply (output, fftData.data() + channel * stride, synthesisWindow.data(), (int) fftSize);
+    }
+}
+
+} // namespace dsp
+} // namespace juce
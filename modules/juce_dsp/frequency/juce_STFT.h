@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Runs a short-time Fourier transform over a signal, lets a function modify each
+    frame of the spectrum, and resynthesises the result with overlap-add.
+
+    This takes care of all the framing that spectral effects need around an FFT:
+    collecting overlapping frames of the input, applying the analysis window,
+    transforming the frames of all the channels in a single batch, and then
+    windowing and overlapping the inverse transforms back into a continuous output.
+    The output is normalised for the chosen window and hop size, so if the spectral
+    callback leaves the frames alone the output is the input delayed by
+    getLatencyInSamples().
+
+    @code
+    STFT stft (10, 256);    // 1024 point frames, every 256 samples
+    stft.setSpectralCallback ([] (const STFT::SpectralFrame& frame)
+    {
+        for (size_t channel = 0; channel < frame.numChannels; ++channel)
+            for (size_t bin = 0; bin < 20; ++bin)
+                frame.channels[channel][bin] = {};    // remove everything below ~900 Hz
+    });
+    @endcode
+
+    All the buffers are allocated in the constructor and in prepare(), so processing
+    doesn't allocate.
+
+    @see FFT, WindowingFunction
+
+    @tags{DSP}
+*/
+class JUCE_API  STFT
+{
+public:
+    //==============================================================================
+    /** The spectra of one frame of every channel. */
+    struct SpectralFrame
+    {
+        /** One array of numBins complex values for each channel, holding the
+            frequencies from DC up to and including the Nyquist frequency.
+        */
+        Complex<float>* const* channels;
+
+        /** The number of channels. */
+        size_t numChannels;
+
+        /** The number of bins in each channel, which is getFFTSize() / 2 + 1. */
+        size_t numBins;
+    };
+
+    /** A function which processes the spectra of a frame in place. */
+    using SpectralCallback = std::function<void (const SpectralFrame&)>;
+
+    //==============================================================================
+    /** Creates a short-time Fourier transform.
+
+        @param fftOrder         the size of each frame, which will be 2 ^ fftOrder samples
+        @param hopSize          the number of samples between the starts of consecutive
+                                frames. This must be no more than the frame size, and for
+                                most windows should be half of it or less.
+        @param windowType       the window applied to the frames both before the forward
+                                transform and after the inverse transform
+    */
+    STFT (int fftOrder, int hopSize,
+          WindowingFunction<float>::WindowingMethod windowType = WindowingFunction<float>::hann);
+
+    //==============================================================================
+    /** Sets the function which will be called with the spectra of each frame.
+
+        Calling this while the transform is processing isn't thread safe.
+    */
+    void setSpectralCallback (SpectralCallback newCallback)    { spectralCallback = std::move (newCallback); }
+
+    //==============================================================================
+    /** Returns the number of samples in each frame. */
+    int getFFTSize() const noexcept                             { return (int) fftSize; }
+
+    /** Returns the number of samples between the starts of consecutive frames. */
+    int getHopSize() const noexcept                             { return (int) hopSize; }
+
+    /** Returns the delay between the input and the output, in samples. */
+    int getLatencyInSamples() const noexcept                    { return (int) fftSize - 1; }
+
+    //==============================================================================
+    /** Initialises the transform. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Clears the frames that are being collected and overlapped. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, float>,
+                       "The sample-type of the STFT must be float");
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumChannels() <= numChannels);
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processSamples (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<const float>& inputBlock, AudioBlock<float>& outputBlock) noexcept;
+    void processFrame (size_t numChannelsToProcess) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    size_t fftSize, hopSize, numChannels = 0, hopPosition = 0;
+
+    std::vector<float> analysisWindow, synthesisWindow;
+    AudioBuffer<float> inputFrames, overlapAdd;
+    std::vector<float> fftData;
+    std::vector<Complex<float>*> spectra;
+
+    SpectralCallback spectralCallback;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFT)
+};
+
+} // namespace dsp
+} // namespace juce
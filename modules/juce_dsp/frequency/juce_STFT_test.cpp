@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class STFTTests  : public UnitTest
+{
+public:
+    STFTTests()
+        : UnitTest ("STFT", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Output is the input delayed by the latency");
+        {
+            checkReconstruction (10, 512, WindowingFunction<float>::hann);
+            checkReconstruction (10, 256, WindowingFunction<float>::hann);
+            checkReconstruction (10, 300, WindowingFunction<float>::hann);
+            checkReconstruction (9, 128, WindowingFunction<float>::blackmanHarris);
+            checkReconstruction (8, 256, WindowingFunction<float>::rectangular);
+        }
+
+        beginTest ("Callback receives the spectrum of each channel");
+        {
+            constexpr int fftOrder = 10, fftSize = 1 << fftOrder, numSamples = 8192;
+            STFT stft (fftOrder, fftSize / 4);
+            stft.prepare ({ 44100.0, 512, 2 });
+
+            const int expectedPeaks[] = { 40, 100 };
+            int numFrames = 0;
+
+            stft.setSpectralCallback ([&] (const STFT::SpectralFrame& frame)
+            {
+                expectEquals ((int) frame.numChannels, 2);
+                expectEquals ((int) frame.numBins, fftSize / 2 + 1);
+
+                // skip the first frames, which are mostly zero
+                if (++numFrames > 4)
+                {
+                    for (size_t channel = 0; channel < frame.numChannels; ++channel)
+                    {
+                        int peak = 0;
+
+                        for (int bin = 1; bin < (int) frame.numBins; ++bin)
+                            if (std::abs (frame.channels[channel][bin]) > std::abs (frame.channels[channel][peak]))
+                                peak = bin;
+
+                        expectEquals (peak, expectedPeaks[channel]);
+                    }
+                }
+            });
+
+            AudioBuffer<float> buffer (2, numSamples);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample (channel, i, std::sin (MathConstants<float>::twoPi * (float) expectedPeaks[channel] * (float) i / (float) fftSize));
+
+            processInBlocks (stft, buffer, 512);
+            expectEquals (numFrames, numSamples / (fftSize / 4));
+        }
+
+        beginTest ("Changes to the spectrum are resynthesised");
+        {
+            STFT stft (9, 128);
+            stft.prepare ({ 44100.0, 512, 1 });
+            stft.setSpectralCallback ([] (const STFT::SpectralFrame& frame)
+            {
+                for (size_t bin = 0; bin < frame.numBins; ++bin)
+                    frame.channels[0][bin] *= 0.25f;
+            });
+
+            auto buffer = makeNoise (1, 4096);
+            const AudioBuffer<float> input (buffer);
+            processInBlocks (stft, buffer, 100);
+
+            const auto latency = stft.getLatencyInSamples();
+
+            for (int i = latency; i < buffer.getNumSamples(); ++i)
+                expectWithinAbsoluteError (buffer.getSample (0, i), 0.25f * input.getSample (0, i - latency), 1.0e-5f);
+        }
+    }
+
+private:
+    static AudioBuffer<float> makeNoise (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        Random random (0x1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    static void processInBlocks (STFT& stft, AudioBuffer<float>& buffer, int maxBlockSize)
+    {
+        AudioBlock<float> block (buffer);
+        Random random (0x4321);
+
+        for (size_t start = 0; start < block.getNumSamples();)
+        {
+            const auto numSamples = jmin ((size_t) random.nextInt ({ 1, maxBlockSize + 1 }), block.getNumSamples() - start);
+            auto subBlock = block.getSubBlock (start, numSamples);
+            stft.process (ProcessContextReplacing<float> (subBlock));
+            start += numSamples;
+        }
+    }
+
+    void checkReconstruction (int fftOrder, int hopSize, WindowingFunction<float>::WindowingMethod window)
+    {
+        STFT stft (fftOrder, hopSize, window);
+        stft.prepare ({ 44100.0, 512, 3 });
+
+        auto buffer = makeNoise (3, 6000);
+        const AudioBuffer<float> input (buffer);
+        processInBlocks (stft, buffer, 512);
+
+        const auto latency = stft.getLatencyInSamples();
+        expectEquals (latency, (1 << fftOrder) - 1);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectWithinAbsoluteError (buffer.getSample (channel, i),
+                                           i < latency ? 0.0f : input.getSample (channel, i - latency),
+                                           1.0e-5f);
+    }
+};
+
+static STFTTests stftTests;
+
+} // namespace dsp
+} // namespace juce
@@ -54,29 +54,41 @@
  #define JUCE_IPP_AVAILABLE 1
 #endif
 
+#include "containers/juce_SIMDLanes.h"
+#include "widgets/juce_DynamicsProcessing.h"
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_IIRMultichannelFilter.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
+#include "processors/juce_MultibandSplitter.cpp"
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
+#include "processors/juce_MatrixMixer.cpp"
+#include "processors/juce_SpatialPanning.cpp"
+#include "processors/juce_Ambisonics.cpp"
 #include "processors/juce_StateVariableTPTFilter.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
+#include "maths/juce_RandomGenerator.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
 #include "widgets/juce_Compressor.cpp"
 #include "widgets/juce_NoiseGate.cpp"
 #include "widgets/juce_Limiter.cpp"
+#include "widgets/juce_LookAheadLimiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_OscillatorBank.cpp"
+#include "widgets/juce_FDNReverb.cpp"
 
 #if JUCE_USE_SIMD
  #if JUCE_INTEL
@@ -95,15 +107,37 @@
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_PolynomialApproximation_test.cpp"
+ #include "maths/juce_RandomGenerator_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
  #endif
 
  #include "containers/juce_AudioBlock_test.cpp"
+ #include "containers/juce_StridedAudioBlock_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_STFT_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_IIRFilter_test.cpp"
+ #include "processors/juce_IIRMultichannelFilter_test.cpp"
+ #include "processors/juce_MultibandSplitter_test.cpp"
+ #include "processors/juce_MatrixMixer_test.cpp"
+ #include "processors/juce_SpatialPanning_test.cpp"
+ #include "processors/juce_Ambisonics_test.cpp"
+
+ #if JUCE_USE_SIMD
+  #include "processors/juce_Oversampling_test.cpp"
+ #endif
+
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_StateVariableTPTFilter_test.cpp"
+ #include "widgets/juce_OscillatorBank_test.cpp"
+ #include "widgets/juce_FDNReverb_test.cpp"
+ #include "widgets/juce_Compressor_test.cpp"
+ #include "widgets/juce_LookAheadLimiter_test.cpp"
+ #include "widgets/juce_LadderFilter_test.cpp"
 #endif
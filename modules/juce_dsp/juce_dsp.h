@@ -244,14 +244,19 @@ namespace juce
 #include "maths/juce_Polynomial.h"
 #include "maths/juce_FastMathApproximations.h"
 #include "maths/juce_LookupTable.h"
+#include "maths/juce_PolynomialApproximation.h"
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
+#include "containers/juce_StridedAudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
+#include "maths/juce_RandomGenerator.h"
+#include "frequency/juce_FFT.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
+#include "processors/juce_IIRMultichannelFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
@@ -260,20 +265,27 @@ namespace juce
 #include "processors/juce_Oversampling.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
+#include "processors/juce_MultibandSplitter.h"
 #include "processors/juce_DryWetMixer.h"
+#include "processors/juce_MatrixMixer.h"
+#include "processors/juce_SpatialPanning.h"
+#include "processors/juce_Ambisonics.h"
 #include "processors/juce_StateVariableTPTFilter.h"
-#include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
+#include "widgets/juce_FDNReverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_OscillatorBank.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
 #include "widgets/juce_Limiter.h"
+#include "widgets/juce_LookAheadLimiter.h"
 #include "widgets/juce_Phaser.h"
 #include "widgets/juce_Chorus.h"
@@ -204,6 +204,45 @@ struct FastMathApproximations
             values[i] = FastMathApproximations::tan (values[i]);
     }
 
+    /** Provides a fast approximation of the function tan(x) for inputs from 0 up to
+        (but not including) pi/2, calculated sample by sample.
+
+        This is the range needed to prewarp the cutoff of a filter, tan (pi * f / sampleRate).
+        It divides polynomials for sin(x) and sin(pi/2 - x), so its relative error stays
+        within a few units in the last place for floats, and below 1e-11 for doubles,
+        right up to pi/2, where tan() above loses its accuracy. There are no branches,
+        so a loop of these calls can be vectorised by the compiler.
+    */
+    template <typename FloatType>
+    static FloatType tanBelowHalfPi (FloatType x) noexcept
+    {
+        const auto sine = [] (FloatType y)
+        {
+            const auto y2 = y * y;
+            return y * ((FloatType) 1 + y2 * ((FloatType) -1.6666666666666667e-1 + y2 * ((FloatType) 8.3333333333333333e-3
+                     + y2 * ((FloatType) -1.9841269841269841e-4 + y2 * ((FloatType) 2.7557319223985891e-6
+                     + y2 * ((FloatType) -2.5052108385441719e-8 + y2 * ((FloatType) 1.6059043836821615e-10
+                     + y2 * (FloatType) -7.6471637318198165e-13)))))));
+        };
+
+        // pi/2 is split in two so that pi/2 - x stays accurate as x approaches it
+        constexpr auto halfPiHigh = MathConstants<FloatType>::halfPi;
+        constexpr auto halfPiLow  = (FloatType) (3.141592653589793238L / 2 - (long double) halfPiHigh);
+
+        return sine (x) / sine ((halfPiHigh - x) + halfPiLow);
+    }
+
+    /** Provides a fast approximation of the function tan(x) for inputs from 0 up to
+        (but not including) pi/2, calculated on a whole buffer.
+        @see tanBelowHalfPi
+    */
+    template <typename FloatType>
+    static void tanBelowHalfPi (FloatType* values, size_t numValues) noexcept
+    {
+        for (size_t i = 0; i < numValues; ++i)
+            values[i] = FastMathApproximations::tanBelowHalfPi (values[i]);
+    }
+
     //==============================================================================
     /** Provides a fast approximation of the function exp(x) using a Pade approximant
         continued fraction, calculated sample by sample.
@@ -258,7 +297,101 @@ struct FastMathApproximations
         for (size_t i = 0; i < numValues; ++i)
             values[i] = FastMathApproximations::logNPlusOne (values[i]);
     }
+
+    //==============================================================================
+    /** Provides a fast approximation of the function log2(x), calculated sample by sample.
+
+        The exponent is read directly from the bits of the number, and the mantissa is
+        passed through a polynomial, so this works for any positive normal number, with
+        an absolute error below 3e-5. Zero returns a large negative number instead of
+        minus infinity, which makes it safe to use when converting levels to decibels.
+
+        There are no branches, so a loop of these calls can be vectorised by the compiler.
+    */
+    template <typename FloatType>
+    static FloatType log2 (FloatType x) noexcept
+    {
+        using Bits = typename BitsForType<FloatType>::Type;
+        constexpr auto mantissaBits = std::numeric_limits<FloatType>::digits - 1;
+        constexpr auto exponentBias = std::numeric_limits<FloatType>::max_exponent - 1;
+
+        Bits bits;
+        std::memcpy (&bits, &x, sizeof (x));
+
+        const auto exponent = (int) (bits >> mantissaBits) - exponentBias;
+        bits = (bits & (((Bits) 1 << mantissaBits) - 1)) | ((Bits) exponentBias << mantissaBits);
+
+        FloatType mantissa;
+        std::memcpy (&mantissa, &bits, sizeof (mantissa));
+
+        const auto t = mantissa - 1;
+        return (FloatType) exponent
+                 + t * ((FloatType) 1.4418798958 + t * ((FloatType) -0.7088652177 + t * ((FloatType) 0.4152455602
+                 + t * ((FloatType) -0.1935165244 + t * (FloatType) 0.0452682925))));
+    }
+
+    /** Provides a fast approximation of the function log2(x), calculated on a whole buffer.
+        @see log2
+    */
+    template <typename FloatType>
+    static void log2 (FloatType* values, size_t numValues) noexcept
+    {
+        for (size_t i = 0; i < numValues; ++i)
+            values[i] = FastMathApproximations::log2 (values[i]);
+    }
+
+    /** Provides a fast approximation of the function exp2(x), calculated sample by sample.
+
+        The integer part of the input is written directly into the exponent of the result,
+        and the fractional part is passed through a polynomial, giving a relative error
+        below 3e-7. The input must lie in the range of exponents of normal numbers, which
+        is -126 to 127 for floats and -1022 to 1023 for doubles.
+
+        There are no branches, so a loop of these calls can be vectorised by the compiler.
+    */
+    template <typename FloatType>
+    static FloatType exp2 (FloatType x) noexcept
+    {
+        using Bits = typename BitsForType<FloatType>::Type;
+        constexpr auto mantissaBits = std::numeric_limits<FloatType>::digits - 1;
+        constexpr auto exponentBias = std::numeric_limits<FloatType>::max_exponent - 1;
+
+        // The biased input is positive, so truncating it rounds it down
+        const auto whole = (int) (x + (FloatType) exponentBias) - exponentBias;
+        const auto t = x - (FloatType) whole;
+        const auto fraction = (FloatType) 1
+                                + t * ((FloatType) 0.6931525353 + t * ((FloatType) 0.2401524446 + t * ((FloatType) 0.0558365981
+                                + t * ((FloatType) 0.0089728993 + t * (FloatType) 0.0018854038))));
+
+        const auto bits = (Bits) (whole + exponentBias) << mantissaBits;
+        FloatType scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        return scale * fraction;
+    }
+
+    /** Provides a fast approximation of the function exp2(x), calculated on a whole buffer.
+        Unlike the single sample version, inputs outside the range of normal numbers are
+        clamped to it.
+        @see exp2
+    */
+    template <typename FloatType>
+    static void exp2 (FloatType* values, size_t numValues) noexcept
+    {
+        constexpr auto exponentBias = std::numeric_limits<FloatType>::max_exponent - 1;
+
+        FloatVectorOperations::clip (values, values, (FloatType) (1 - exponentBias), (FloatType) exponentBias, numValues);
+
+        for (size_t i = 0; i < numValues; ++i)
+            values[i] = FastMathApproximations::exp2 (values[i]);
+    }
+
+private:
+    template <typename FloatType> struct BitsForType;
 };
 
+template <> struct FastMathApproximations::BitsForType<float>   { using Type = uint32; };
+template <> struct FastMathApproximations::BitsForType<double>  { using Type = uint64; };
+
 } // namespace dsp
 } // namespace juce
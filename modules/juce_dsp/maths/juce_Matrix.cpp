@@ -112,32 +112,62 @@ Matrix<ElementType>& Matrix<ElementType>::swapRows (size_t rowOne, size_t rowTwo
 template <typename ElementType>
 Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
 {
-    auto n = getNumRows(), m = other.getNumColumns(), p = getNumColumns();
-    Matrix result (n, m);
+    Matrix result (getNumRows(), other.getNumColumns());
+    multiply (result, *this, other);
+    return result;
+}
 
-    jassert (p == other.getNumRows());
+template <typename ElementType>
+Matrix<ElementType>& Matrix<ElementType>::multiply (Matrix& result, const Matrix& a, const Matrix& b) noexcept
+{
+    const auto n = a.getNumRows(), m = b.getNumColumns(), p = a.getNumColumns();
 
-    size_t offsetMat = 0, offsetlhs = 0;
+    jassert (p == b.getNumRows());
+    jassert (result.getNumRows() == n && result.getNumColumns() == m);
+    jassert (&result != &a && &result != &b);
 
     auto* dst = result.getRawDataPointer();
-    auto* a = getRawDataPointer();
-    auto* b = other.getRawDataPointer();
+    auto* lhs = a.getRawDataPointer();
+    auto* rhs = b.getRawDataPointer();
 
-    for (size_t i = 0; i < n; ++i)
+    if (m == 1)
     {
-        size_t offsetrhs = 0;
-
-        for (size_t k = 0; k < p; ++k)
+        for (size_t i = 0; i < n; ++i)
         {
-            auto ak = a[offsetlhs++];
+            ElementType sum = 0;
 
-            for (size_t j = 0; j < m; ++j)
-                dst[offsetMat + j] += ak * b[offsetrhs + j];
+            for (size_t k = 0; k < p; ++k)
+                sum += lhs[i * p + k] * rhs[k];
 
-            offsetrhs += m;
+            dst[i] = sum;
         }
 
-        offsetMat += m;
+        return result;
+    }
+
+    result.clear();
+
+    // The right-hand matrix is processed in tiles small enough to stay in the cache
+    // while every row of the left-hand matrix is applied to them, and each row of a
+    // tile is accumulated into the result with a single vectorised call.
+    constexpr size_t tileSize = 64;
+
+    for (size_t kStart = 0; kStart < p; kStart += tileSize)
+    {
+        const auto kEnd = jmin (kStart + tileSize, p);
+
+        for (size_t jStart = 0; jStart < m; jStart += tileSize)
+        {
+            const auto numColumns = (int) jmin (tileSize, m - jStart);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto* dstRow = dst + i * m + jStart;
+
+                for (size_t k = kStart; k < kEnd; ++k)
+                    FloatVectorOperations::addWithMultiply (dstRow, rhs + k * m + jStart, lhs[i * p + k], numColumns);
+            }
+        }
     }
 
     return result;
@@ -160,6 +160,14 @@ public:
     /** Matrix multiplication */
     Matrix operator* (const Matrix& other) const;
 
+    /** Multiplies a by b and writes the product into an existing matrix, without
+        allocating any memory. This makes it suitable for use on the audio thread.
+
+        The result must already have as many rows as a and as many columns as b, and
+        it mustn't be the same object as either of the operands.
+    */
+    static Matrix& multiply (Matrix& result, const Matrix& a, const Matrix& b) noexcept;
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
     inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
 
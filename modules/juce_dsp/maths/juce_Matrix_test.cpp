@@ -118,6 +118,34 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    struct LargeMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            auto random = u.getRandom();
+
+            for (auto [n, p, m] : { std::tuple<size_t, size_t, size_t> { 70, 130, 90 }, { 65, 100, 1 }, { 1, 67, 129 } })
+            {
+                Matrix<ElementType> a (n, p), b (p, m), result (n, m), expected (n, m);
+
+                for (auto* mat : { &a, &b })
+                    for (auto& x : *mat)
+                        x = (ElementType) (random.nextFloat() * 2.0f - 1.0f);
+
+                for (size_t i = 0; i < n; ++i)
+                    for (size_t j = 0; j < m; ++j)
+                        for (size_t k = 0; k < p; ++k)
+                            expected (i, j) += a (i, k) * b (k, j);
+
+                result (0, 0) = 1000;
+
+                u.expect (Matrix<ElementType>::compare (Matrix<ElementType>::multiply (result, a, b), expected, (ElementType) 1e-3));
+                u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-3));
+            }
+        }
+    };
+
     struct IdentityMatrixTest
     {
         template <typename ElementType>
@@ -162,6 +190,7 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<ScalarMultiplicationTest> ("ScalarMultiplication");
         runTestForAllTypes<HadamardProductTest> ("HadamardProductTest");
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
     }
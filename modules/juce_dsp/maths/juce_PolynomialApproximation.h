@@ -0,0 +1,308 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Approximates a function over a range of inputs with a set of polynomials.
+
+    The range is split into NumSegments equal segments, and the function is fitted
+    over each one with a polynomial of the given order, by interpolating it at the
+    Chebyshev nodes of the segment. For smooth functions this is very close to the
+    best (minimax) polynomial of that order, and the error falls quickly as the
+    order or number of segments goes up, so it is usually far more accurate than
+    a LookupTableTransform of the same size.
+
+    The constructor is constexpr, so an approximation of a constexpr function can
+    be built at compile time:
+
+    @code
+    static constexpr auto softClip = PolynomialApproximation<float, 7, 4> ([] (float x) { return x / (1.0f + x * x); },
+                                                                          -4.0f, 4.0f);
+    @endcode
+
+    Otherwise it is built at run time, which takes (Order + 1) * NumSegments calls to
+    the function, plus the ones used to measure the error.
+
+    Inputs outside the range are clipped to it. The objects are small and copyable,
+    and can be used directly as the function of a WaveShaper, or to initialise an
+    Oscillator. As well as single samples, they can process SIMDRegisters and whole
+    arrays of samples.
+
+    @see LookupTableTransform, FastMathApproximations
+
+    @tags{DSP}
+*/
+template <typename FloatType, size_t Order, size_t NumSegments = 1>
+class PolynomialApproximation
+{
+public:
+    static_assert (std::is_floating_point_v<FloatType>, "PolynomialApproximation only works with float or double");
+    static_assert (NumSegments > 0, "There must be at least one segment");
+
+    //==============================================================================
+    /** Creates an approximation which always returns zero. */
+    constexpr PolynomialApproximation() = default;
+
+    /** Creates an approximation of a function over the given range.
+
+        @param functionToApproximate The function to approximate, mapping a FloatType
+                                     to a FloatType.
+        @param minInputValueToUse    The lowest input value. Lower inputs are clipped to it.
+        @param maxInputValueToUse    The highest input value. Higher inputs are clipped to it.
+        @param numTestPointsPerSegment
+                                     The number of evenly spaced points in each segment
+                                     at which the error is measured, see getMaximumError().
+    */
+    template <typename Function>
+    constexpr PolynomialApproximation (Function&& functionToApproximate,
+                                       FloatType minInputValueToUse,
+                                       FloatType maxInputValueToUse,
+                                       size_t numTestPointsPerSegment = 16 * (Order + 1))
+        : minInputValue (minInputValueToUse),
+          maxInputValue (maxInputValueToUse),
+          segmentScale ((FloatType) NumSegments / (maxInputValueToUse - minInputValueToUse))
+    {
+        constexpr auto numNodes = Order + 1;
+        const auto segmentWidth = ((double) maxInputValue - (double) minInputValue) / (double) NumSegments;
+
+        for (size_t segment = 0; segment < NumSegments; ++segment)
+        {
+            const auto segmentCentre = (double) minInputValue + segmentWidth * ((double) segment + 0.5);
+
+            // Chebyshev series coefficients of the function over the segment, from its values at the nodes
+            std::array<double, numNodes> series {};
+
+            for (size_t k = 0; k < numNodes; ++k)
+            {
+                const auto node = cosine (MathConstants<double>::pi * ((double) k + 0.5) / (double) numNodes);
+                const auto value = (double) functionToApproximate ((FloatType) (segmentCentre + 0.5 * segmentWidth * node));
+                double chebyshev = 1.0, previous = 0.0;
+
+                for (size_t j = 0; j < numNodes; ++j)
+                {
+                    series[j] += value * chebyshev * 2.0 / (double) numNodes;
+
+                    const auto next = (j == 0 ? 1.0 : 2.0) * node * chebyshev - previous;
+                    previous = chebyshev;
+                    chebyshev = next;
+                }
+            }
+
+            series[0] *= 0.5;
+
+            // Expand the series into powers of the position within the segment, from -1 to 1
+            std::array<double, numNodes> powers {}, chebyshev {}, previous {};
+            chebyshev[0] = 1.0;
+
+            for (size_t j = 0; j < numNodes; ++j)
+            {
+                std::array<double, numNodes> next {};
+
+                for (size_t i = 0; i < numNodes; ++i)
+                {
+                    powers[i] += series[j] * chebyshev[i];
+                    next[i] = (i > 0 ? (j == 0 ? 1.0 : 2.0) * chebyshev[i - 1] : 0.0) - previous[i];
+                }
+
+                previous = chebyshev;
+                chebyshev = next;
+            }
+
+            for (size_t i = 0; i < numNodes; ++i)
+                coefficients[segment][i] = (FloatType) powers[i];
+        }
+
+        const auto numTestPoints = jmax ((size_t) 2, numTestPointsPerSegment) * NumSegments;
+
+        for (size_t i = 0; i <= numTestPoints; ++i)
+        {
+            const auto input = (FloatType) ((double) minInputValue + ((double) maxInputValue - (double) minInputValue) * (double) i / (double) numTestPoints);
+            const auto error = (double) processSample (input) - (double) functionToApproximate (input);
+
+            maxError = jmax (maxError, error < 0 ? -error : error);
+        }
+    }
+
+    //==============================================================================
+    /** Calculates the approximated value for the given input value, clipping it to the
+        range given in the constructor.
+    */
+    constexpr FloatType processSample (FloatType value) const noexcept
+    {
+        const auto position = (jmin (jmax (value, minInputValue), maxInputValue) - minInputValue) * segmentScale;
+
+        if constexpr (NumSegments == 1)
+        {
+            return evaluate (coefficients[0], position * (FloatType) 2 - (FloatType) 1);
+        }
+        else
+        {
+            const auto segment = jmin ((size_t) position, NumSegments - 1);
+            return evaluate (coefficients[segment], (position - (FloatType) segment) * (FloatType) 2 - (FloatType) 1);
+        }
+    }
+
+    /** Calculates the approximated values for each element of a SIMDRegister, clipping
+        them to the range given in the constructor.
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSample (SIMDRegister<FloatType> value) const noexcept
+    {
+        using Register = SIMDRegister<FloatType>;
+
+        const auto clipped = Register::min (Register::max (value, Register (minInputValue)), Register (maxInputValue));
+        const auto position = (clipped - Register (minInputValue)) * Register (segmentScale);
+
+        if constexpr (NumSegments == 1)
+        {
+            return evaluate (coefficients[0], position * Register ((FloatType) 2) - Register ((FloatType) 1));
+        }
+        else
+        {
+            const auto segment = Register::min (Register::truncate (position), Register ((FloatType) (NumSegments - 1)));
+            const auto t = (position - segment) * Register ((FloatType) 2) - Register ((FloatType) 1);
+
+            // each element may be in a different segment, so gather their coefficients
+            alignas (Register::SIMDRegisterSize) FloatType lanes[Register::size()];
+            size_t segments[Register::size()];
+
+            for (size_t i = 0; i < Register::size(); ++i)
+                segments[i] = (size_t) segment.get (i);
+
+            auto result = Register ((FloatType) 0);
+
+            for (auto power = Order + 1; power-- > 0;)
+            {
+                for (size_t i = 0; i < Register::size(); ++i)
+                    lanes[i] = coefficients[segments[i]][power];
+
+                result = result * t + Register::fromRawArray (lanes);
+            }
+
+            return result;
+        }
+    }
+
+    /** @see processSample */
+    constexpr FloatType operator() (FloatType value) const noexcept                                   { return processSample (value); }
+
+    /** @see processSample */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator() (SIMDRegister<FloatType> value) const noexcept { return processSample (value); }
+
+    /** Processes an array of input values, clipping them to the range given in the
+        constructor. The input and output arrays may be the same.
+    */
+    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+    {
+        FloatVectorOperations::clip (output, input, minInputValue, maxInputValue, (int) numSamples);
+
+        if constexpr (NumSegments == 1)
+        {
+            // with only one segment, this loop is free of branches and lookups so it can be vectorised
+            const auto scale  = segmentScale * (FloatType) 2;
+            const auto offset = -minInputValue * scale - (FloatType) 1;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = evaluate (coefficients[0], output[i] * scale + offset);
+        }
+        else
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto position = (output[i] - minInputValue) * segmentScale;
+                const auto segment = jmin ((int) position, (int) NumSegments - 1);
+
+                output[i] = evaluate (coefficients[(size_t) segment], (position - (FloatType) segment) * (FloatType) 2 - (FloatType) 1);
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Returns the largest absolute error found between the approximation and the
+        function it approximates, measured at the test points given in the constructor.
+
+        This is measured rather than guaranteed, but for smooth functions and the default
+        number of test points it is a close estimate of the true maximum.
+    */
+    constexpr double getMaximumError() const noexcept           { return maxError; }
+
+    /** Returns the lowest input value of the approximation. */
+    constexpr FloatType getMinimumInputValue() const noexcept   { return minInputValue; }
+
+    /** Returns the highest input value of the approximation. */
+    constexpr FloatType getMaximumInputValue() const noexcept   { return maxInputValue; }
+
+    /** Returns the coefficients of the polynomial for a segment, lowest power first.
+
+        The polynomial takes the position within the segment, scaled so that it runs
+        from -1 at the start of the segment to 1 at the end.
+    */
+    constexpr const std::array<FloatType, Order + 1>& getCoefficients (size_t segment) const noexcept
+    {
+        return coefficients[segment];
+    }
+
+private:
+    //==============================================================================
+    template <typename ValueType>
+    static constexpr ValueType evaluate (const std::array<FloatType, Order + 1>& c, ValueType t) noexcept
+    {
+        auto result = ValueType (c[Order]);
+
+        for (auto power = Order; power-- > 0;)
+            result = result * t + ValueType (c[power]);
+
+        return result;
+    }
+
+    /** A constexpr cosine for the range 0 to pi, which is all that's needed for the nodes. */
+    static constexpr double cosine (double x) noexcept
+    {
+        if (x > MathConstants<double>::halfPi)
+            return -cosine (MathConstants<double>::pi - x);
+
+        const auto x2 = x * x;
+        double result = 1.0, term = 1.0;
+
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -x2 / (double) ((2 * n - 1) * (2 * n));
+            result += term;
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    std::array<std::array<FloatType, Order + 1>, NumSegments> coefficients {};
+    FloatType minInputValue = -1, maxInputValue = 1, segmentScale = (FloatType) NumSegments * (FloatType) 0.5;
+    double maxError = 0;
+};
+
+} // namespace dsp
+} // namespace juce
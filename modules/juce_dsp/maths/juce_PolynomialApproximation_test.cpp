@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class PolynomialApproximationTests  : public UnitTest
+{
+public:
+    PolynomialApproximationTests()
+        : UnitTest ("PolynomialApproximation", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Polynomials up to the order are reproduced exactly");
+        {
+            const auto cubic = [] (double x) { return 0.5 - 2.0 * x + 0.25 * x * x * x; };
+            const PolynomialApproximation<double, 3> approximation (cubic, -3.0, 2.0);
+
+            expectLessThan (approximation.getMaximumError(), 1.0e-12);
+
+            for (auto x : { -3.0, -1.5, 0.0, 0.7, 2.0 })
+                expectWithinAbsoluteError (approximation (x), cubic (x), 1.0e-12);
+        }
+
+        beginTest ("Approximations can be built at compile time");
+        {
+            static constexpr auto softClip = PolynomialApproximation<float, 7, 4> ([] (float x) { return x / (1.0f + x * x); },
+                                                                                   -4.0f, 4.0f);
+            static_assert (softClip (0.0f) > -1.0e-3f && softClip (0.0f) < 1.0e-3f);
+            static_assert (softClip.getMaximumError() < 1.0e-3);
+
+            expectWithinAbsoluteError (softClip (1.0f), 0.5f, 1.0e-3f);
+        }
+
+        beginTest ("Error falls with more segments and is measured accurately");
+        {
+            const auto tanh = [] (double x) { return std::tanh (x); };
+            const PolynomialApproximation<double, 7, 2> coarse (tanh, -5.0, 5.0);
+            const PolynomialApproximation<double, 7, 8> fine (tanh, -5.0, 5.0);
+
+            expectLessThan (fine.getMaximumError(), coarse.getMaximumError() / 100.0);
+            expectLessThan (fine.getMaximumError(), 2.0e-6);
+
+            double error = 0;
+
+            for (int i = 0; i <= 100000; ++i)
+            {
+                const auto x = -5.0 + 10.0 * i / 100000.0;
+                error = jmax (error, std::abs (fine (x) - std::tanh (x)));
+            }
+
+            expectLessThan (error, fine.getMaximumError() * 1.1);
+        }
+
+        beginTest ("Inputs outside the range are clipped");
+        {
+            const PolynomialApproximation<float, 5, 3> approximation ([] (float x) { return std::sin (x); }, -1.0f, 2.0f);
+
+            expectEquals (approximation (-10.0f), approximation (-1.0f));
+            expectEquals (approximation (10.0f),  approximation (2.0f));
+        }
+
+        beginTest ("SIMD and array processing match single samples");
+        {
+            checkProcessing (PolynomialApproximation<float, 9> ([] (float x) { return std::tanh (x); }, -3.0f, 3.0f));
+            checkProcessing (PolynomialApproximation<float, 5, 6> ([] (float x) { return std::tanh (x); }, -3.0f, 3.0f));
+            checkProcessing (PolynomialApproximation<double, 5, 6> ([] (double x) { return std::tanh (x); }, -3.0, 3.0));
+        }
+
+        beginTest ("WaveShaper processes blocks with the approximation");
+        {
+            using Approximation = PolynomialApproximation<float, 7, 4>;
+            WaveShaper<float, Approximation> shaper { Approximation ([] (float x) { return std::tanh (x); }, -4.0f, 4.0f) };
+
+            AudioBuffer<float> buffer (2, 100);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < 100; ++i)
+                    buffer.setSample (channel, i, (float) (i - 50) * 0.1f * (float) (channel + 1));
+
+            AudioBuffer<float> original (buffer);
+            AudioBlock<float> block (buffer);
+            shaper.process (ProcessContextReplacing<float> (block));
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < 100; ++i)
+                    expectWithinAbsoluteError (buffer.getSample (channel, i),
+                                               shaper.processSample (original.getSample (channel, i)),
+                                               1.0e-6f);
+        }
+
+        beginTest ("Oscillator can be initialised with an approximation");
+        {
+            const auto pi = MathConstants<float>::pi;
+            Oscillator<float> exact ([] (float x) { return std::sin (x); }), approximated;
+            approximated.initialise (PolynomialApproximation<float, 9, 4> ([] (float x) { return std::sin (x); }, -pi, pi));
+
+            AudioBuffer<float> expected (1, 256), output (1, 256);
+
+            for (auto* oscillator : { &exact, &approximated })
+            {
+                oscillator->prepare ({ 44100.0, 256, 1 });
+                oscillator->setFrequency (1000.0f, true);
+            }
+
+            AudioBlock<float> expectedBlock (expected), outputBlock (output);
+            expectedBlock.clear();
+            outputBlock.clear();
+            exact.process (ProcessContextReplacing<float> (expectedBlock));
+            approximated.process (ProcessContextReplacing<float> (outputBlock));
+
+            for (int i = 0; i < 256; ++i)
+                expectWithinAbsoluteError (output.getSample (0, i), expected.getSample (0, i), 1.0e-5f);
+        }
+    }
+
+private:
+    template <typename FloatType, size_t Order, size_t NumSegments>
+    void checkProcessing (const PolynomialApproximation<FloatType, Order, NumSegments>& approximation)
+    {
+        using Register = SIMDRegister<FloatType>;
+        constexpr size_t numValues = 64;
+        const auto tolerance = (FloatType) (std::is_same_v<FloatType, float> ? 1.0e-6 : 1.0e-14);
+
+        alignas (Register::SIMDRegisterSize) FloatType input[numValues], output[numValues];
+
+        for (size_t i = 0; i < numValues; ++i)
+            input[i] = (FloatType) -4 + (FloatType) 8 * (FloatType) i / (FloatType) (numValues - 1);
+
+        approximation.process (input, output, numValues);
+
+        for (size_t i = 0; i < numValues; ++i)
+            expectWithinAbsoluteError (output[i], approximation (input[i]), tolerance);
+
+        for (size_t i = 0; i < numValues; i += Register::size())
+            approximation (Register::fromRawArray (input + i)).copyToRawArray (output + i);
+
+        for (size_t i = 0; i < numValues; ++i)
+            expectWithinAbsoluteError (output[i], approximation (input[i]), tolerance);
+    }
+};
+
+static PolynomialApproximationTests polynomialApproximationTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace RandomGeneratorHelpers
+{
+    static uint64 splitMix64 (uint64& state) noexcept
+    {
+        auto z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint64 createUniqueSeed() noexcept
+    {
+        static std::atomic<uint64> counter { 0 };
+
+        return (uint64) Time::getHighResolutionTicks()
+             ^ ((uint64) (pointer_sized_uint) Thread::getCurrentThreadId() << 16)
+             ^ (++counter * 0x9e3779b97f4a7c15ULL);
+    }
+
+    template <typename FloatType>
+    static FloatType toUnitInterval (uint32 bits) noexcept
+    {
+        if constexpr (std::is_same_v<FloatType, float>)
+            return (float) (bits >> 8) * (1.0f / 16777216.0f);
+        else
+            return (double) bits * (1.0 / 4294967296.0);
+    }
+}
+
+//==============================================================================
+RandomGenerator::RandomGenerator()  : RandomGenerator (RandomGeneratorHelpers::createUniqueSeed()) {}
+
+RandomGenerator::RandomGenerator (uint64 seed) noexcept
+{
+    setSeed (seed);
+}
+
+void RandomGenerator::setSeed (uint64 newSeed) noexcept
+{
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        const auto a = RandomGeneratorHelpers::splitMix64 (newSeed);
+        const auto b = RandomGeneratorHelpers::splitMix64 (newSeed);
+
+        s0[lane] = (uint32) a;
+        s1[lane] = (uint32) (a >> 32);
+        s2[lane] = (uint32) b;
+        s3[lane] = (uint32) (b >> 32);
+
+        // xoshiro gets stuck if every word of its state is zero
+        if ((s0[lane] | s1[lane] | s2[lane] | s3[lane]) == 0)
+            s0[lane] = 1;
+    }
+
+    chunkPosition = valuesPerChunk;
+}
+
+RandomGenerator& RandomGenerator::getForCurrentThread()
+{
+    thread_local RandomGenerator generator;
+    return generator;
+}
+
+//==============================================================================
+void RandomGenerator::generateChunk() noexcept
+{
+    for (size_t i = 0; i < valuesPerChunk; i += numLanes)
+    {
+        // Each lane is an independent xoshiro128+ generator, so these loops vectorise
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            chunk[i + lane] = s0[lane] + s3[lane];
+
+            const auto t = s1[lane] << 9;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+        }
+    }
+
+    chunkPosition = 0;
+}
+
+uint32 RandomGenerator::nextUint32() noexcept
+{
+    if (chunkPosition == valuesPerChunk)
+        generateChunk();
+
+    return chunk[chunkPosition++];
+}
+
+float RandomGenerator::nextFloat() noexcept
+{
+    return RandomGeneratorHelpers::toUnitInterval<float> (nextUint32());
+}
+
+//==============================================================================
+template <typename FloatType, typename Convert>
+void RandomGenerator::fill (FloatType* dest, size_t numValues, Convert convert) noexcept
+{
+    while (numValues > 0)
+    {
+        if (chunkPosition == valuesPerChunk)
+            generateChunk();
+
+        const auto numThisTime = jmin (numValues, valuesPerChunk - chunkPosition);
+        const auto* bits = chunk + chunkPosition;
+
+        for (size_t i = 0; i < numThisTime; ++i)
+            dest[i] = convert (bits[i]);
+
+        chunkPosition += numThisTime;
+        dest += numThisTime;
+        numValues -= numThisTime;
+    }
+}
+
+void RandomGenerator::fillUniform (float* dest, size_t numValues, float minimum, float maximum) noexcept
+{
+    const auto range = maximum - minimum;
+    fill (dest, numValues, [=] (uint32 bits) { return minimum + range * RandomGeneratorHelpers::toUnitInterval<float> (bits); });
+}
+
+void RandomGenerator::fillUniform (double* dest, size_t numValues, double minimum, double maximum) noexcept
+{
+    const auto range = maximum - minimum;
+    fill (dest, numValues, [=] (uint32 bits) { return minimum + range * RandomGeneratorHelpers::toUnitInterval<double> (bits); });
+}
+
+void RandomGenerator::fillTPDF (float* dest, size_t numValues, float amplitude) noexcept
+{
+    // The difference of the two 16-bit halves of each value has a triangular distribution,
+    // so only one random word is needed per sample
+    const auto scale = amplitude / 65536.0f;
+    fill (dest, numValues, [=] (uint32 bits) { return scale * (float) ((int) (bits >> 16) - (int) (bits & 0xffff)); });
+}
+
+void RandomGenerator::fillTPDF (double* dest, size_t numValues, double amplitude) noexcept
+{
+    const auto scale = amplitude / 65536.0;
+    fill (dest, numValues, [=] (uint32 bits) { return scale * (double) ((int) (bits >> 16) - (int) (bits & 0xffff)); });
+}
+
+template <typename FloatType>
+void RandomGenerator::fillGaussianImpl (FloatType* dest, size_t numValues, FloatType mean, FloatType standardDeviation) noexcept
+{
+    // Box-Muller transform, which turns each pair of uniform values into a pair of normal values
+    fillUniform (dest, numValues, (FloatType) 0, (FloatType) 1);
+
+    const auto twoPi = MathConstants<FloatType>::twoPi;
+
+    const auto transform = [&] (FloatType u1, FloatType u2, FloatType& out1, FloatType& out2)
+    {
+        const auto radius = standardDeviation * std::sqrt ((FloatType) -2 * std::log ((FloatType) 1 - u1));
+        out1 = mean + radius * std::cos (twoPi * u2);
+        out2 = mean + radius * std::sin (twoPi * u2);
+    };
+
+    size_t i = 0;
+
+    for (; i + 1 < numValues; i += 2)
+        transform (dest[i], dest[i + 1], dest[i], dest[i + 1]);
+
+    if (i < numValues)
+    {
+        FloatType unused;
+        transform (dest[i], RandomGeneratorHelpers::toUnitInterval<FloatType> (nextUint32()), dest[i], unused);
+    }
+}
+
+void RandomGenerator::fillGaussian (float* dest, size_t numValues, float mean, float standardDeviation) noexcept
+{
+    fillGaussianImpl (dest, numValues, mean, standardDeviation);
+}
+
+void RandomGenerator::fillGaussian (double* dest, size_t numValues, double mean, double standardDeviation) noexcept
+{
+    fillGaussianImpl (dest, numValues, mean, standardDeviation);
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A fast pseudo-random number generator for filling blocks of audio with noise.
+
+    Unlike juce::Random, which produces one value per call from a single LCG, this
+    runs eight independent xoshiro128+ generators side by side. Their state is laid
+    out so that the compiler can vectorise the update, and each call produces a
+    whole block of values. That makes it cheap enough to generate noise or dither
+    for every sample of a buffer.
+
+    Each object must only be used by one thread at a time. Use getForCurrentThread()
+    to get a generator that belongs to the calling thread, so that nothing needs to
+    be locked on the audio thread.
+
+    This is not suitable for cryptographic purposes.
+
+    @see Random
+
+    @tags{DSP}
+*/
+class JUCE_API RandomGenerator
+{
+public:
+    //==============================================================================
+    /** Creates a generator with a seed that is different for every object. */
+    RandomGenerator();
+
+    /** Creates a generator with a given seed, so that it produces a repeatable
+        sequence of values.
+    */
+    explicit RandomGenerator (uint64 seed) noexcept;
+
+    /** Resets the generator with a new seed. */
+    void setSeed (uint64 newSeed) noexcept;
+
+    /** Returns a generator that belongs to the calling thread.
+
+        The generator is created and seeded the first time each thread calls this,
+        which may allocate, so call it once from your audio thread before you need
+        it in a time-critical context.
+    */
+    static RandomGenerator& getForCurrentThread();
+
+    //==============================================================================
+    /** Returns a random 32-bit value. */
+    uint32 nextUint32() noexcept;
+
+    /** Returns a random float in the range [0, 1). */
+    float nextFloat() noexcept;
+
+    //==============================================================================
+    /** Fills a buffer with evenly-distributed values in the range [minimum, maximum). */
+    void fillUniform (float* dest, size_t numValues, float minimum = -1.0f, float maximum = 1.0f) noexcept;
+
+    /** Fills a buffer with evenly-distributed values in the range [minimum, maximum).
+
+        The values have 32 bits of randomness, which is plenty for audio but less than
+        the full precision of a double.
+    */
+    void fillUniform (double* dest, size_t numValues, double minimum = -1.0, double maximum = 1.0) noexcept;
+
+    /** Fills a buffer with normally-distributed values. */
+    void fillGaussian (float* dest, size_t numValues, float mean = 0.0f, float standardDeviation = 1.0f) noexcept;
+
+    /** Fills a buffer with normally-distributed values. */
+    void fillGaussian (double* dest, size_t numValues, double mean = 0.0, double standardDeviation = 1.0) noexcept;
+
+    /** Fills a buffer with values that have a triangular probability density, as used
+        for dither.
+
+        The values lie in the range (-amplitude, amplitude), so for conventional TPDF
+        dither pass the size of one quantisation step of the target format.
+    */
+    void fillTPDF (float* dest, size_t numValues, float amplitude) noexcept;
+
+    /** Fills a buffer with values that have a triangular probability density, as used
+        for dither.
+
+        The values lie in the range (-amplitude, amplitude), so for conventional TPDF
+        dither pass the size of one quantisation step of the target format.
+    */
+    void fillTPDF (double* dest, size_t numValues, double amplitude) noexcept;
+
+    //==============================================================================
+    /** Fills every channel of a block with independent, evenly-distributed values. */
+    template <typename SampleType>
+    void fillUniform (const AudioBlock<SampleType>& block,
+                      SampleType minimum = (SampleType) -1, SampleType maximum = (SampleType) 1) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            fillUniform (block.getChannelPointer (ch), block.getNumSamples(), minimum, maximum);
+    }
+
+    /** Fills every channel of a block with independent, normally-distributed values. */
+    template <typename SampleType>
+    void fillGaussian (const AudioBlock<SampleType>& block,
+                       SampleType mean = (SampleType) 0, SampleType standardDeviation = (SampleType) 1) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            fillGaussian (block.getChannelPointer (ch), block.getNumSamples(), mean, standardDeviation);
+    }
+
+    /** Fills every channel of a block with independent TPDF dither values.
+        @see fillTPDF
+    */
+    template <typename SampleType>
+    void fillTPDF (const AudioBlock<SampleType>& block, SampleType amplitude) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            fillTPDF (block.getChannelPointer (ch), block.getNumSamples(), amplitude);
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t numLanes = 8, valuesPerChunk = 64;
+
+    void generateChunk() noexcept;
+
+    template <typename FloatType, typename Convert>
+    void fill (FloatType*, size_t, Convert) noexcept;
+
+    template <typename FloatType>
+    void fillGaussianImpl (FloatType*, size_t, FloatType, FloatType) noexcept;
+
+    uint32 s0[numLanes], s1[numLanes], s2[numLanes], s3[numLanes];
+    uint32 chunk[valuesPerChunk];
+    size_t chunkPosition = valuesPerChunk;
+
+    JUCE_DECLARE_NON_COPYABLE (RandomGenerator)
+    JUCE_LEAK_DETECTOR (RandomGenerator)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class RandomGeneratorTests  : public UnitTest
+{
+public:
+    RandomGeneratorTests()
+        : UnitTest ("RandomGenerator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Seeded generators are repeatable");
+        {
+            RandomGenerator a (1234), b (1234), c (4321);
+            std::vector<float> x (1000), y (1000), z (1000);
+
+            a.fillUniform (x.data(), x.size());
+            b.fillUniform (y.data(), 300);
+            b.fillUniform (y.data() + 300, 700);
+            c.fillUniform (z.data(), z.size());
+
+            expect (x == y);
+            expect (x != z);
+
+            a.setSeed (1234);
+            expectEquals (a.nextFloat(), (x[0] + 1.0f) * 0.5f);
+        }
+
+        beginTest ("Uniform values");
+        {
+            testUniform<float>();
+            testUniform<double>();
+        }
+
+        beginTest ("Gaussian values");
+        {
+            testGaussian<float>();
+            testGaussian<double>();
+        }
+
+        beginTest ("TPDF values");
+        {
+            testTPDF<float>();
+            testTPDF<double>();
+        }
+
+        beginTest ("AudioBlock channels are independent");
+        {
+            RandomGenerator generator (99);
+            HeapBlock<char> data;
+            AudioBlock<float> block (data, 3, 517);
+            block.clear();
+
+            generator.fillTPDF (block, 1.0f / 32768.0f);
+
+            for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            {
+                const auto range = FloatVectorOperations::findMinAndMax (block.getChannelPointer (ch), (int) block.getNumSamples());
+                expect (range.getStart() < 0.0f && range.getEnd() > 0.0f);
+                expect (range.getStart() > -1.0f / 32768.0f && range.getEnd() < 1.0f / 32768.0f);
+            }
+
+            expect (! std::equal (block.getChannelPointer (0), block.getChannelPointer (0) + block.getNumSamples(),
+                                  block.getChannelPointer (1)));
+        }
+
+        beginTest ("Each thread has its own generator");
+        {
+            auto* mainGenerator = &RandomGenerator::getForCurrentThread();
+            expect (mainGenerator == &RandomGenerator::getForCurrentThread());
+
+            RandomGenerator* otherGenerator = nullptr;
+            std::thread ([&] { otherGenerator = &RandomGenerator::getForCurrentThread(); }).join();
+            expect (otherGenerator != mainGenerator);
+        }
+    }
+
+private:
+    static constexpr size_t numValues = 100001;
+
+    template <typename FloatType>
+    static FloatType getMean (const std::vector<FloatType>& values)
+    {
+        return std::accumulate (values.begin(), values.end(), (FloatType) 0) / (FloatType) values.size();
+    }
+
+    template <typename FloatType>
+    static FloatType getVariance (const std::vector<FloatType>& values)
+    {
+        const auto mean = getMean (values);
+        FloatType sum = 0;
+
+        for (auto v : values)
+            sum += (v - mean) * (v - mean);
+
+        return sum / (FloatType) values.size();
+    }
+
+    template <typename FloatType>
+    void testUniform()
+    {
+        RandomGenerator generator (getRandom().nextInt64());
+        std::vector<FloatType> values (numValues);
+        generator.fillUniform (values.data(), values.size(), (FloatType) -2, (FloatType) 4);
+
+        expect (std::all_of (values.begin(), values.end(), [] (auto v) { return v >= -2 && v < 4; }));
+        expectWithinAbsoluteError (getMean (values), (FloatType) 1, (FloatType) 0.05);
+        expectWithinAbsoluteError (getVariance (values), (FloatType) 3, (FloatType) 0.1);
+
+        int histogram[10] = {};
+
+        for (auto v : values)
+            ++histogram[jlimit (0, 9, (int) ((v + 2) * 10 / 6))];
+
+        for (auto count : histogram)
+            expectWithinAbsoluteError (count, (int) numValues / 10, 500);
+    }
+
+    template <typename FloatType>
+    void testGaussian()
+    {
+        RandomGenerator generator (getRandom().nextInt64());
+        std::vector<FloatType> values (numValues);
+        generator.fillGaussian (values.data(), values.size(), (FloatType) 3, (FloatType) 2);
+
+        expect (std::all_of (values.begin(), values.end(), [] (auto v) { return std::isfinite (v); }));
+        expectWithinAbsoluteError (getMean (values), (FloatType) 3, (FloatType) 0.05);
+        expectWithinAbsoluteError (getVariance (values), (FloatType) 4, (FloatType) 0.15);
+
+        const auto numWithinOneDeviation = std::count_if (values.begin(), values.end(), [] (auto v) { return std::abs (v - 3) < 2; });
+        expectWithinAbsoluteError ((double) numWithinOneDeviation / (double) numValues, 0.6827, 0.01);
+    }
+
+    template <typename FloatType>
+    void testTPDF()
+    {
+        RandomGenerator generator (getRandom().nextInt64());
+        std::vector<FloatType> values (numValues);
+        const auto amplitude = (FloatType) 0.5;
+        generator.fillTPDF (values.data(), values.size(), amplitude);
+
+        expect (std::all_of (values.begin(), values.end(), [=] (auto v) { return std::abs (v) < amplitude; }));
+        expectWithinAbsoluteError (getMean (values), (FloatType) 0, (FloatType) 0.01);
+        expectWithinAbsoluteError (getVariance (values), amplitude * amplitude / 6, (FloatType) 0.002);
+
+        // A triangular density has half of its values within 29% of the peak
+        const auto numNearZero = std::count_if (values.begin(), values.end(), [=] (auto v) { return std::abs (v) < amplitude * (1 - MathConstants<FloatType>::sqrt2 / 2); });
+        expectWithinAbsoluteError ((double) numNearZero / (double) numValues, 0.5, 0.01);
+    }
+};
+
+static RandomGeneratorTests randomGeneratorTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,459 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+void SphericalHarmonics::compute (int order, SphericalDirection direction, double* coefficients) noexcept
+{
+    jassert (order >= 0);
+
+    const auto x = std::sin (direction.elevation);
+    const auto cosElevation = std::cos (direction.elevation);
+
+    // Associated Legendre functions without the Condon-Shortley phase, starting from
+    // P(m, m) and stepping up through the degrees with the usual recurrence
+    double pmm = 1.0;
+
+    for (int m = 0; m <= order; ++m)
+    {
+        if (m > 0)
+            pmm *= (2 * m - 1) * cosElevation;
+
+        const auto cosTerm = std::cos (m * direction.azimuth);
+        const auto sinTerm = std::sin (m * direction.azimuth);
+
+        double previous = 0.0, current = pmm;
+
+        for (int l = m; l <= order; ++l)
+        {
+            if (l > m)
+            {
+                const auto next = ((2 * l - 1) * x * current - (l + m - 1) * previous) / (l - m);
+                previous = std::exchange (current, next);
+            }
+
+            // SN3D normalisation: sqrt ((2 - delta (m)) * (l - m)! / (l + m)!)
+            double factorialRatio = 1.0;
+
+            for (int i = l - m + 1; i <= l + m; ++i)
+                factorialRatio /= i;
+
+            const auto value = std::sqrt ((m == 0 ? 1.0 : 2.0) * factorialRatio) * current;
+            const auto centre = l * l + l;
+
+            if (m == 0)
+            {
+                coefficients[centre] = value;
+            }
+            else
+            {
+                coefficients[centre + m] = value * cosTerm;
+                coefficients[centre - m] = value * sinTerm;
+            }
+        }
+    }
+}
+
+void SphericalHarmonics::computeMaxREWeights (int order, double* weights) noexcept
+{
+    const auto x = std::cos (degreesToRadians (137.9) / (order + 1.51));
+
+    // Legendre polynomials evaluated at x
+    double previous = 0.0, current = 1.0;
+
+    for (int l = 0; l <= order; ++l)
+    {
+        weights[l] = current;
+        const auto next = ((2 * l + 1) * x * current - l * previous) / (l + 1);
+        previous = std::exchange (current, next);
+    }
+}
+
+//==============================================================================
+namespace AmbisonicHelpers
+{
+    /*  Creates a grid of directions with Gauss-Legendre spacing in elevation and even
+        spacing in azimuth, whose weights integrate any spherical polynomial up to
+        degree min (2 * numRings - 1, numAzimuths - 1) exactly. The weights add up to
+        the area of the sphere.
+    */
+    static void createQuadratureGrid (int numRings, int numAzimuths,
+                                      std::vector<SphericalDirection>& directions,
+                                      std::vector<double>& weights)
+    {
+        directions.clear();
+        weights.clear();
+
+        for (int i = 0; i < numRings; ++i)
+        {
+            auto x = std::cos (MathConstants<double>::pi * (i + 0.75) / (numRings + 0.5));
+            double derivative = 1.0;
+
+            for (int iteration = 0; iteration < 100; ++iteration)
+            {
+                double previous = 1.0, current = x;
+
+                for (int k = 2; k <= numRings; ++k)
+                    previous = std::exchange (current, ((2 * k - 1) * x * current - (k - 1) * previous) / k);
+
+                derivative = numRings * (x * current - previous) / (x * x - 1.0);
+
+                const auto step = current / derivative;
+                x -= step;
+
+                if (std::abs (step) < 1.0e-15)
+                    break;
+            }
+
+            const auto ringWeight = 2.0 / ((1.0 - x * x) * derivative * derivative);
+
+            for (int j = 0; j < numAzimuths; ++j)
+            {
+                directions.push_back ({ MathConstants<double>::twoPi * j / numAzimuths, std::asin (x) });
+                weights.push_back (ringWeight * MathConstants<double>::twoPi / numAzimuths);
+            }
+        }
+    }
+
+    static int getOrderOfChannel (int channel) noexcept
+    {
+        return (int) std::sqrt ((double) channel);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+AmbisonicEncoder<SampleType>::AmbisonicEncoder()
+{
+    resizeGains();
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::setOrder (int newOrder)
+{
+    jassert (newOrder >= 0);
+
+    order = newOrder;
+    resizeGains();
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::setNumSources (int newNumSources)
+{
+    jassert (newNumSources >= 0);
+
+    sourceDirections.resize ((size_t) newNumSources);
+    resizeGains();
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::setSourceDirection (int sourceIndex, SphericalDirection newDirection) noexcept
+{
+    jassert (isPositiveAndBelow (sourceIndex, getNumSources()));
+
+    sourceDirections[(size_t) sourceIndex] = newDirection;
+    updateGains ((size_t) sourceIndex);
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::prepare (const ProcessSpec& spec)
+{
+    mixer.prepare (spec);
+    reset();
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::reset() noexcept
+{
+    if (std::exchange (gainsChanged, false))
+        mixer.setMatrix (gains);
+
+    mixer.reset();
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::updateGains (size_t sourceIndex) noexcept
+{
+    SphericalHarmonics::compute (order, sourceDirections[sourceIndex], coefficients.data());
+
+    for (size_t i = 0; i < coefficients.size(); ++i)
+        gains (i, sourceIndex) = (SampleType) coefficients[i];
+
+    gainsChanged = true;
+}
+
+template <typename SampleType>
+void AmbisonicEncoder<SampleType>::resizeGains()
+{
+    const auto numChannels = (size_t) SphericalHarmonics::getNumChannelsForOrder (order);
+
+    coefficients.resize (numChannels);
+    gains = Matrix<SampleType> (numChannels, sourceDirections.size());
+
+    for (size_t i = 0; i < sourceDirections.size(); ++i)
+        updateGains (i);
+
+    mixer.setMatrix (gains);
+    gainsChanged = false;
+}
+
+//==============================================================================
+template <typename SampleType>
+AmbisonicRotator<SampleType>::AmbisonicRotator()
+{
+    setOrder (order);
+}
+
+template <typename SampleType>
+void AmbisonicRotator<SampleType>::setOrder (int newOrder)
+{
+    jassert (newOrder >= 0);
+
+    order = newOrder;
+
+    const auto numChannels = (size_t) SphericalHarmonics::getNumChannelsForOrder (order);
+
+    // Each entry of the matrix integrates a product of two harmonics of the same order,
+    // which is a polynomial of degree 2 * order
+    AmbisonicHelpers::createQuadratureGrid (order + 1, 2 * order + 1, gridDirections, gridWeights);
+
+    gridCoefficients.resize (gridDirections.size() * numChannels);
+    rotatedCoefficients.resize (gridDirections.size() * numChannels);
+
+    for (size_t k = 0; k < gridDirections.size(); ++k)
+        SphericalHarmonics::compute (order, gridDirections[k], gridCoefficients.data() + k * numChannels);
+
+    rotation = Matrix<SampleType> (numChannels, numChannels);
+    setRotation (currentYaw, currentPitch, currentRoll);
+
+    mixer.setMatrix (rotation);
+    rotationChanged = false;
+}
+
+template <typename SampleType>
+void AmbisonicRotator<SampleType>::setRotation (double yaw, double pitch, double roll) noexcept
+{
+    currentYaw = yaw;
+    currentPitch = pitch;
+    currentRoll = roll;
+
+    const auto cy = std::cos (yaw),   sy = std::sin (yaw);
+    const auto cp = std::cos (pitch), sp = std::sin (pitch);
+    const auto cr = std::cos (roll),  sr = std::sin (roll);
+
+    // Rz (yaw) * Ry (pitch) * Rx (roll)
+    const double r[3][3] = { { cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr },
+                             { sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr },
+                             { -sp,     cp * sr,                cp * cr } };
+
+    const auto numChannels = rotation.getNumRows();
+
+    for (size_t k = 0; k < gridDirections.size(); ++k)
+    {
+        const auto v = gridDirections[k].toUnitVector();
+        const auto x = r[0][0] * v[0] + r[0][1] * v[1] + r[0][2] * v[2];
+        const auto y = r[1][0] * v[0] + r[1][1] * v[1] + r[1][2] * v[2];
+        const auto z = r[2][0] * v[0] + r[2][1] * v[1] + r[2][2] * v[2];
+
+        SphericalHarmonics::compute (order,
+                                     { std::atan2 (y, x), std::asin (jlimit (-1.0, 1.0, z)) },
+                                     rotatedCoefficients.data() + k * numChannels);
+    }
+
+    // By the addition theorem, each order maps onto itself, with
+    // entry (i, j) = (2l + 1) / 4pi * integral of Y_i (R d) * Y_j (d)
+    for (size_t i = 0; i < numChannels; ++i)
+    {
+        const auto l = AmbisonicHelpers::getOrderOfChannel ((int) i);
+        const auto first = (size_t) (l * l), last = (size_t) ((l + 1) * (l + 1));
+        const auto scale = (2 * l + 1) / (4.0 * MathConstants<double>::pi);
+
+        for (size_t j = 0; j < numChannels; ++j)
+        {
+            double sum = 0.0;
+
+            if (j >= first && j < last)
+                for (size_t k = 0; k < gridDirections.size(); ++k)
+                    sum += gridWeights[k] * rotatedCoefficients[k * numChannels + i] * gridCoefficients[k * numChannels + j];
+
+            rotation (i, j) = (SampleType) (sum * scale);
+        }
+    }
+
+    rotationChanged = true;
+}
+
+template <typename SampleType>
+void AmbisonicRotator<SampleType>::prepare (const ProcessSpec& spec)
+{
+    mixer.prepare (spec);
+    reset();
+}
+
+template <typename SampleType>
+void AmbisonicRotator<SampleType>::reset() noexcept
+{
+    if (std::exchange (rotationChanged, false))
+        mixer.setMatrix (rotation);
+
+    mixer.reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+AmbisonicDecoder<SampleType>::AmbisonicDecoder()
+{
+    updateMatrix();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::setOrder (int newOrder)
+{
+    jassert (newOrder >= 0);
+
+    order = newOrder;
+    updateMatrix();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::setSpeakerLayout (const AudioChannelSet& layout)
+{
+    setSpeakerLayout (SphericalDirection::fromChannelSet (layout));
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::setSpeakerLayout (const std::vector<std::optional<SphericalDirection>>& newSpeakerDirections)
+{
+    speakerDirections = newSpeakerDirections;
+    updateMatrix();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::setMethod (Method newMethod)
+{
+    method = newMethod;
+    updateMatrix();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::setWeighting (Weighting newWeighting)
+{
+    weighting = newWeighting;
+    updateMatrix();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::prepare (const ProcessSpec& spec)
+{
+    mixer.prepare (spec);
+    reset();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::reset() noexcept
+{
+    mixer.reset();
+}
+
+template <typename SampleType>
+void AmbisonicDecoder<SampleType>::updateMatrix()
+{
+    const auto numChannels = (size_t) SphericalHarmonics::getNumChannelsForOrder (order);
+    const auto numSpeakers = speakerDirections.size();
+
+    // The factor of (2l + 1) turns the SN3D harmonics into a panning function that
+    // peaks in the source direction
+    std::vector<double> orderWeights ((size_t) order + 1, 1.0);
+
+    if (weighting == Weighting::maxRE)
+        SphericalHarmonics::computeMaxREWeights (order, orderWeights.data());
+
+    for (int l = 0; l <= order; ++l)
+        orderWeights[(size_t) l] *= 2 * l + 1;
+
+    std::vector<double> coefficients (numChannels), rowScales (numChannels);
+
+    for (size_t i = 0; i < numChannels; ++i)
+        rowScales[i] = orderWeights[(size_t) AmbisonicHelpers::getOrderOfChannel ((int) i)];
+
+    std::vector<double> result (numSpeakers * numChannels, 0.0);
+
+    if (method == Method::sampling)
+    {
+        const auto numDirectional = std::count_if (speakerDirections.begin(), speakerDirections.end(),
+                                                   [] (const auto& d) { return d.has_value(); });
+
+        for (size_t s = 0; s < numSpeakers; ++s)
+        {
+            if (! speakerDirections[s].has_value())
+                continue;
+
+            SphericalHarmonics::compute (order, *speakerDirections[s], coefficients.data());
+
+            for (size_t i = 0; i < numChannels; ++i)
+                result[s * numChannels + i] = coefficients[i] * rowScales[i] / (double) numDirectional;
+        }
+    }
+    else
+    {
+        // Decode to a dense grid of virtual loudspeakers, then pan each of those to
+        // the real loudspeakers
+        std::vector<SphericalDirection> grid;
+        std::vector<double> weights, speakerGains (numSpeakers);
+        AmbisonicHelpers::createQuadratureGrid (2 * order + 6, 4 * order + 12, grid, weights);
+
+        const VectorBasePanning panning (speakerDirections);
+
+        for (size_t k = 0; k < grid.size(); ++k)
+        {
+            SphericalHarmonics::compute (order, grid[k], coefficients.data());
+            panning.computeGains (grid[k], speakerGains.data());
+
+            const auto weight = weights[k] / (4.0 * MathConstants<double>::pi);
+
+            for (size_t s = 0; s < numSpeakers; ++s)
+                if (speakerGains[s] != 0.0)
+                    for (size_t i = 0; i < numChannels; ++i)
+                        result[s * numChannels + i] += weight * speakerGains[s] * coefficients[i] * rowScales[i];
+        }
+    }
+
+    decodingMatrix = Matrix<SampleType> (numSpeakers, numChannels);
+    std::transform (result.begin(), result.end(), decodingMatrix.begin(), [] (double x) { return (SampleType) x; });
+
+    mixer.setMatrix (decodingMatrix);
+}
+
+//==============================================================================
+template class AmbisonicEncoder<float>;
+template class AmbisonicEncoder<double>;
+template class AmbisonicRotator<float>;
+template class AmbisonicRotator<double>;
+template class AmbisonicDecoder<float>;
+template class AmbisonicDecoder<double>;
+
+} // namespace dsp
+} // namespace juce
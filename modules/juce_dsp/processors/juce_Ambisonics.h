@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Functions for evaluating the real spherical harmonics used by ambisonics, with
+    ACN channel ordering and SN3D normalisation.
+
+    @tags{DSP}
+*/
+struct SphericalHarmonics
+{
+    /** Returns the number of ambisonic channels used by a given order. */
+    static constexpr int getNumChannelsForOrder (int order) noexcept   { return (order + 1) * (order + 1); }
+
+    /** Fills an array of getNumChannelsForOrder (order) values with the spherical
+        harmonics for a direction, in ACN order.
+    */
+    static void compute (int order, SphericalDirection direction, double* coefficients) noexcept;
+
+    /** Fills an array of order + 1 values with the max-rE weight for each order, which
+        narrows the spread of a decoded source in exchange for a small loss of level.
+    */
+    static void computeMaxREWeights (int order, double* weights) noexcept;
+};
+
+//==============================================================================
+/**
+    A processor that encodes a number of mono sources into an ambisonic sound field.
+
+    Each input channel is a source with its own direction, and the output block holds
+    the ACN/SN3D ambisonic channels. The encoding gains are applied with a MatrixMixer,
+    so moving a source is smoothed.
+
+    @see AmbisonicRotator, AmbisonicDecoder, AudioChannelSet::ambisonic
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class AmbisonicEncoder
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    AmbisonicEncoder();
+
+    //==============================================================================
+    /** Sets the ambisonic order. This may allocate. */
+    void setOrder (int newOrder);
+
+    /** Returns the ambisonic order. */
+    int getOrder() const noexcept                   { return order; }
+
+    /** Sets the number of sources, which is the number of input channels that will be
+        processed. New sources start out straight ahead. This may allocate.
+    */
+    void setNumSources (int newNumSources);
+
+    /** Returns the number of sources. */
+    int getNumSources() const noexcept              { return (int) sourceDirections.size(); }
+
+    /** Sets the direction of a source. This doesn't allocate, and the new gains are
+        passed to the mixer at the start of the next call to process().
+    */
+    void setSourceDirection (int sourceIndex, SphericalDirection newDirection) noexcept;
+
+    /** Sets the time it takes for the gains to reach their new values after a change. */
+    void setRampDurationSeconds (double newDurationSeconds) noexcept    { mixer.setRampDurationSeconds (newDurationSeconds); }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        if (std::exchange (gainsChanged, false))
+            mixer.setMatrix (gains);
+
+        mixer.process (context);
+    }
+
+private:
+    //==============================================================================
+    void updateGains (size_t sourceIndex) noexcept;
+    void resizeGains();
+
+    //==============================================================================
+    std::vector<SphericalDirection> sourceDirections;
+    std::vector<double> coefficients;
+    Matrix<SampleType> gains { 0, 0 };
+    MatrixMixer<SampleType> mixer;
+    int order = 1;
+    bool gainsChanged = false;
+};
+
+//==============================================================================
+/**
+    A processor that rotates an ambisonic sound field, for example to follow a
+    listener's head movements.
+
+    The rotation is applied as a roll around the x (forwards) axis, then a pitch
+    around the y (left) axis and finally a yaw around the z (up) axis, each of which is
+    anticlockwise when looking back along the axis towards the listener. So a positive
+    yaw moves sources to the left.
+
+    The matrix for each order is found by integrating the rotated spherical harmonics
+    against the original ones over a quadrature grid that is exact for the orders
+    involved, so every order can be rotated without a recursion or special cases.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class AmbisonicRotator
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    AmbisonicRotator();
+
+    //==============================================================================
+    /** Sets the ambisonic order. This may allocate. */
+    void setOrder (int newOrder);
+
+    /** Returns the ambisonic order. */
+    int getOrder() const noexcept                   { return order; }
+
+    /** Sets the rotation, in radians. This doesn't allocate, and the new matrix is
+        passed to the mixer at the start of the next call to process().
+    */
+    void setRotation (double yaw, double pitch, double roll) noexcept;
+
+    /** Returns the matrix that converts unrotated ambisonic channels into rotated ones. */
+    const Matrix<SampleType>& getRotationMatrix() const noexcept        { return rotation; }
+
+    /** Sets the time it takes for the rotation to reach its new value after a change. */
+    void setRampDurationSeconds (double newDurationSeconds) noexcept    { mixer.setRampDurationSeconds (newDurationSeconds); }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        if (std::exchange (rotationChanged, false))
+            mixer.setMatrix (rotation);
+
+        mixer.process (context);
+    }
+
+private:
+    //==============================================================================
+    std::vector<SphericalDirection> gridDirections;
+    std::vector<double> gridWeights, gridCoefficients, rotatedCoefficients;
+    Matrix<SampleType> rotation { 0, 0 };
+    MatrixMixer<SampleType> mixer;
+    double currentYaw = 0.0, currentPitch = 0.0, currentRoll = 0.0;
+    int order = 1;
+    bool rotationChanged = false;
+};
+
+//==============================================================================
+/**
+    A processor that decodes an ambisonic sound field to a loudspeaker layout.
+
+    The sampling decoder evaluates the sound field in the direction of each loudspeaker,
+    which works well for evenly spread layouts. The AllRAD decoder evaluates it in a
+    dense, evenly spread set of directions and pans each of those to the loudspeakers
+    with VBAP, which copes much better with irregular layouts such as 7.1.4.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class AmbisonicDecoder
+{
+public:
+    //==============================================================================
+    enum class Method
+    {
+        sampling,
+        allRAD
+    };
+
+    enum class Weighting
+    {
+        basic,
+        maxRE
+    };
+
+    //==============================================================================
+    /** Constructor. */
+    AmbisonicDecoder();
+
+    //==============================================================================
+    /** Sets the ambisonic order. This may allocate. */
+    void setOrder (int newOrder);
+
+    /** Returns the ambisonic order. */
+    int getOrder() const noexcept                   { return order; }
+
+    /** Sets the loudspeaker layout to decode to. This may allocate. */
+    void setSpeakerLayout (const AudioChannelSet& layout);
+
+    /** Sets the direction of each output channel. Channels without a direction, such as
+        LFE channels, don't receive any signal. This may allocate.
+    */
+    void setSpeakerLayout (const std::vector<std::optional<SphericalDirection>>& speakerDirections);
+
+    /** Sets the decoding method. This may allocate. */
+    void setMethod (Method newMethod);
+
+    /** Sets the weighting applied to each order. This may allocate. */
+    void setWeighting (Weighting newWeighting);
+
+    /** Returns the matrix that converts ambisonic channels into loudspeaker channels. */
+    const Matrix<SampleType>& getDecodingMatrix() const noexcept        { return decodingMatrix; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        mixer.process (context);
+    }
+
+private:
+    //==============================================================================
+    void updateMatrix();
+
+    //==============================================================================
+    std::vector<std::optional<SphericalDirection>> speakerDirections;
+    Matrix<SampleType> decodingMatrix { 0, 0 };
+    MatrixMixer<SampleType> mixer;
+    Method method = Method::allRAD;
+    Weighting weighting = Weighting::maxRE;
+    int order = 1;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class AmbisonicsTests  : public UnitTest
+{
+public:
+    AmbisonicsTests()
+        : UnitTest ("Ambisonics", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        const auto randomDirection = [&]
+        {
+            return SphericalDirection { (random.nextDouble() * 2.0 - 1.0) * MathConstants<double>::pi,
+                                        std::asin (random.nextDouble() * 2.0 - 1.0) };
+        };
+
+        beginTest ("Spherical harmonics");
+        {
+            constexpr int order = 5;
+            std::array<double, (size_t) SphericalHarmonics::getNumChannelsForOrder (order)> y;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                const auto d = randomDirection();
+                SphericalHarmonics::compute (order, d, y.data());
+
+                expectWithinAbsoluteError (y[0], 1.0, 1.0e-12);
+                expectWithinAbsoluteError (y[1], std::cos (d.elevation) * std::sin (d.azimuth), 1.0e-12);
+                expectWithinAbsoluteError (y[2], std::sin (d.elevation), 1.0e-12);
+                expectWithinAbsoluteError (y[3], std::cos (d.elevation) * std::cos (d.azimuth), 1.0e-12);
+
+                // With SN3D normalisation, the squares of each order's harmonics add up to 1
+                for (int l = 0; l <= order; ++l)
+                    expectWithinAbsoluteError (std::accumulate (y.begin() + l * l, y.begin() + (l + 1) * (l + 1), 0.0,
+                                                                [] (double sum, double x) { return sum + x * x; }),
+                                               1.0, 1.0e-9);
+            }
+        }
+
+        beginTest ("Encoding");
+        {
+            constexpr int order = 3, numChannels = SphericalHarmonics::getNumChannelsForOrder (order);
+
+            AmbisonicEncoder<float> encoder;
+            encoder.setOrder (order);
+            encoder.setNumSources (1);
+
+            const auto d = randomDirection();
+            encoder.setSourceDirection (0, d);
+            encoder.prepare ({ 48000.0, 16, numChannels });
+
+            AudioBuffer<float> in (1, 16), out (numChannels, 16);
+            in.clear();
+            in.setSample (0, 3, 1.0f);
+
+            AudioBlock<float> inBlock (in), outBlock (out);
+            encoder.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            std::array<double, numChannels> y;
+            SphericalHarmonics::compute (order, d, y.data());
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError (out.getSample (ch, 3), (float) y[(size_t) ch], 1.0e-6f);
+        }
+
+        beginTest ("Rotation");
+        {
+            for (int order = 0; order <= 6; ++order)
+            {
+                const auto numChannels = (size_t) SphericalHarmonics::getNumChannelsForOrder (order);
+
+                AmbisonicRotator<double> rotator;
+                rotator.setOrder (order);
+
+                const auto yaw = random.nextDouble() * 6.0, pitch = random.nextDouble() * 6.0, roll = random.nextDouble() * 6.0;
+                rotator.setRotation (yaw, pitch, roll);
+
+                const auto d = randomDirection();
+                Matrix<double> original (numChannels, 1), expected (numChannels, 1), rotated (numChannels, 1);
+                SphericalHarmonics::compute (order, d, original.getRawDataPointer());
+                SphericalHarmonics::compute (order, rotate (d, yaw, pitch, roll), expected.getRawDataPointer());
+
+                Matrix<double>::multiply (rotated, rotator.getRotationMatrix(), original);
+                expect (Matrix<double>::compare (rotated, expected, 1.0e-9));
+            }
+
+            AmbisonicRotator<double> rotator;
+            rotator.setRotation (MathConstants<double>::halfPi, 0.0, 0.0);
+            const auto moved = rotate ({}, MathConstants<double>::halfPi, 0.0, 0.0);
+            expectWithinAbsoluteError (moved.azimuth, MathConstants<double>::halfPi, 1.0e-12);
+            expectWithinAbsoluteError (rotator.getRotationMatrix() (1, 3), 1.0, 1.0e-9);
+        }
+
+        beginTest ("Decoding");
+        {
+            const auto layout = AudioChannelSet::create7point1point4();
+            const auto left = layout.getChannelIndexForType (AudioChannelSet::left);
+            const auto lfe = layout.getChannelIndexForType (AudioChannelSet::LFE);
+
+            for (auto method : { AmbisonicDecoder<float>::Method::sampling, AmbisonicDecoder<float>::Method::allRAD })
+            {
+                constexpr int order = 3, numChannels = SphericalHarmonics::getNumChannelsForOrder (order);
+
+                AmbisonicEncoder<float> encoder;
+                encoder.setOrder (order);
+                encoder.setNumSources (1);
+                encoder.setSourceDirection (0, *SphericalDirection::fromChannelType (AudioChannelSet::left));
+
+                AmbisonicDecoder<float> decoder;
+                decoder.setOrder (order);
+                decoder.setSpeakerLayout (layout);
+                decoder.setMethod (method);
+
+                encoder.prepare ({ 48000.0, 1, numChannels });
+                decoder.prepare ({ 48000.0, 1, (uint32) layout.size() });
+
+                AudioBuffer<float> source (1, 1), encoded (numChannels, 1), decoded (layout.size(), 1);
+                source.setSample (0, 0, 1.0f);
+
+                AudioBlock<float> sourceBlock (source), encodedBlock (encoded), decodedBlock (decoded);
+                encoder.process (ProcessContextNonReplacing<float> (sourceBlock, encodedBlock));
+                decoder.process (ProcessContextNonReplacing<float> (encodedBlock, decodedBlock));
+
+                expectEquals (decoded.getSample (lfe, 0), 0.0f);
+
+                for (int ch = 0; ch < layout.size(); ++ch)
+                    if (ch != left)
+                        expectGreaterThan (decoded.getSample (left, 0), decoded.getSample (ch, 0));
+            }
+        }
+    }
+
+private:
+    static SphericalDirection rotate (SphericalDirection d, double yaw, double pitch, double roll)
+    {
+        auto v = d.toUnitVector();
+
+        const auto turn = [&v] (size_t a, size_t b, double angle)
+        {
+            const auto x = v[a], y = v[b];
+            v[a] = x * std::cos (angle) - y * std::sin (angle);
+            v[b] = x * std::sin (angle) + y * std::cos (angle);
+        };
+
+        turn (1, 2, roll);
+        turn (2, 0, pitch);
+        turn (0, 1, yaw);
+
+        return { std::atan2 (v[1], v[0]), std::asin (jlimit (-1.0, 1.0, v[2])) };
+    }
+};
+
+static AmbisonicsTests ambisonicsTests;
+
+} // namespace dsp
+} // namespace juce
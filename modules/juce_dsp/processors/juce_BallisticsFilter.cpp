@@ -108,6 +108,86 @@ SampleType BallisticsFilter<SampleType>::processSample (int channel, SampleType
     return result;
 }
 
+template <typename SampleType>
+void BallisticsFilter<SampleType>::processBlock (const AudioBlock<const SampleType>& inputBlock,
+                                                 const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    const auto numChannels = outputBlock.getNumChannels();
+    const auto numSamples  = outputBlock.getNumSamples();
+
+    jassert (inputBlock.getNumChannels() == numChannels);
+    jassert (inputBlock.getNumSamples()  == numSamples);
+    jassert (numChannels <= yold.size());
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* input  = inputBlock .getChannelPointer (channel);
+        auto* output = outputBlock.getChannelPointer (channel);
+
+        if (levelType == LevelCalculationType::RMS)
+            FloatVectorOperations::multiply (output, input, input, numSamples);
+        else
+            FloatVectorOperations::abs (output, input, numSamples);
+    }
+
+    for (size_t channel = 0; channel < numChannels; channel += 4)
+    {
+        switch (numChannels - channel)
+        {
+            case 1:   filterChannels<1> (outputBlock, channel); break;
+            case 2:   filterChannels<2> (outputBlock, channel); break;
+            case 3:   filterChannels<3> (outputBlock, channel); break;
+            default:  filterChannels<4> (outputBlock, channel); break;
+        }
+    }
+
+    if (levelType == LevelCalculationType::RMS)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = outputBlock.getChannelPointer (channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = std::sqrt (output[i]);
+        }
+    }
+}
+
+template <typename SampleType>
+template <size_t numChannelsInGroup>
+void BallisticsFilter<SampleType>::filterChannels (const AudioBlock<SampleType>& block, size_t firstChannel) noexcept
+{
+    SampleType* data[numChannelsInGroup];
+    SampleType y[numChannelsInGroup];
+
+    for (size_t i = 0; i < numChannelsInGroup; ++i)
+    {
+        data[i] = block.getChannelPointer (firstChannel + i);
+        y[i] = yold[firstChannel + i];
+    }
+
+    // Both candidate outputs are worked out before the comparison, which keeps
+    // the chain of calculations that each sample waits on short
+    const auto attackInput  = static_cast<SampleType> (1.0) - cteAT;
+    const auto releaseInput = static_cast<SampleType> (1.0) - cteRL;
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        for (size_t channel = 0; channel < numChannelsInGroup; ++channel)
+        {
+            const auto x = data[channel][i];
+            const auto attack  = cteAT * y[channel] + attackInput  * x;
+            const auto release = cteRL * y[channel] + releaseInput * x;
+
+            y[channel] = x > y[channel] ? attack : release;
+            data[channel][i] = y[channel];
+        }
+    }
+
+    for (size_t i = 0; i < numChannelsInGroup; ++i)
+        yold[firstChannel + i] = y[i];
+}
+
 template <typename SampleType>
 void BallisticsFilter<SampleType>::snapToZero() noexcept
 {
@@ -99,12 +99,6 @@ public:
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
-        const auto numSamples  = outputBlock.getNumSamples();
-
-        jassert (inputBlock.getNumChannels() <= yold.size());
-        jassert (inputBlock.getNumChannels() == numChannels);
-        jassert (inputBlock.getNumSamples()  == numSamples);
 
         if (context.isBypassed)
         {
@@ -112,14 +106,7 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+        processBlock (inputBlock, outputBlock);
 
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
         snapToZero();
@@ -129,6 +116,17 @@ public:
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
 
+    /** Processes a block of samples on every channel.
+
+        This gives the same results as calling processSample() on each sample, to within
+        rounding, but it's much faster. The rectification is done with vector operations,
+        and as each channel's filter depends on its own previous output, the channels are
+        filtered side by side so that their calculations can overlap. The input and output
+        blocks may be the same.
+    */
+    void processBlock (const AudioBlock<const SampleType>& inputBlock,
+                       const AudioBlock<SampleType>& outputBlock) noexcept;
+
     /** Ensure that the state variables are rounded to zero if the state
         variables are denormals. This is only needed if you are doing
         sample by sample processing.
@@ -139,6 +137,9 @@ private:
     //==============================================================================
     SampleType calculateLimitedCte (SampleType) const noexcept;
 
+    template <size_t numChannelsInGroup>
+    void filterChannels (const AudioBlock<SampleType>&, size_t firstChannel) noexcept;
+
     //==============================================================================
     std::vector<SampleType> yold;
     double sampleRate = 44100.0, expFactor = -0.142;
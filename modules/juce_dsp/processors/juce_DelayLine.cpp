@@ -124,6 +124,127 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     return result;
 }
 
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushBlock (int channel, const SampleType* samples, int numSamples)
+{
+    jassert (numSamples >= 0);
+
+    auto* data = bufferData.getWritePointer (channel);
+    auto& pos = writePos[(size_t) channel];
+
+    // The write position moves backwards, so copy the block in reverse until
+    // reaching the start of the buffer, then carry on from the end
+    while (numSamples > 0)
+    {
+        const auto numToWrite = jmin (numSamples, pos + 1);
+        auto* dest = data + pos;
+
+        for (int i = 0; i < numToWrite; ++i)
+            dest[-i] = samples[i];
+
+        samples += numToWrite;
+        numSamples -= numToWrite;
+        pos -= numToWrite;
+
+        if (pos < 0)
+            pos += totalSize;
+    }
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::readTaps (int channel, const SampleType* delaysInSamples, SampleType* output,
+                                                         int numSamples, bool updateReadPointer)
+{
+    jassert (numSamples >= 0);
+
+    const auto* data = bufferData.getReadPointer (channel);
+    const auto size = totalSize;
+    const auto upperLimit = (SampleType) getMaximumDelayInSamples();
+    auto pos = readPos[(size_t) channel];
+
+    // A block can't be longer than the buffer, so every read index can be
+    // wrapped back into the buffer without a division
+    jassert (numSamples <= size);
+
+    const auto wrap = [size] (int index) noexcept
+    {
+        return index >= size ? index - size : index;
+    };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        jassert (isPositiveAndNotGreaterThan (delaysInSamples[i], upperLimit));
+
+        const auto d = jlimit ((SampleType) 0, upperLimit, delaysInSamples[i]);
+        auto dInt = static_cast<int> (d);
+        auto dFrac = d - (SampleType) dInt;
+
+        // pos - i + size is always within [1, 2 * size), so adding dInt keeps it below 3 * size
+        auto index1 = wrap (wrap (pos - i + size + dInt));
+
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
+        {
+            output[i] = data[index1];
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Linear>)
+        {
+            const auto value1 = data[index1];
+            const auto value2 = data[wrap (index1 + 1)];
+
+            output[i] = value1 + dFrac * (value2 - value1);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
+        {
+            if (dInt >= 1)
+            {
+                dFrac++;
+                index1 = (index1 == 0 ? size - 1 : index1 - 1);
+            }
+
+            const auto index2 = wrap (index1 + 1);
+            const auto index3 = wrap (index2 + 1);
+            const auto index4 = wrap (index3 + 1);
+
+            const auto value1 = data[index1];
+            const auto value2 = data[index2];
+            const auto value3 = data[index3];
+            const auto value4 = data[index4];
+
+            const auto d1 = dFrac - 1.f;
+            const auto d2 = dFrac - 2.f;
+            const auto d3 = dFrac - 3.f;
+
+            const auto c1 = -d1 * d2 * d3 / 6.f;
+            const auto c2 = d2 * d3 * 0.5f;
+            const auto c3 = -d1 * d3 * 0.5f;
+            const auto c4 = d1 * d2 / 6.f;
+
+            output[i] = value1 * c1 + dFrac * (value2 * c2 + value3 * c3 + value4 * c4);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+        {
+            if (dFrac < (SampleType) 0.618 && dInt >= 1)
+            {
+                dFrac++;
+                index1 = (index1 == 0 ? size - 1 : index1 - 1);
+            }
+
+            const auto tapAlpha = (1 - dFrac) / (1 + dFrac);
+            const auto value1 = data[index1];
+            const auto value2 = data[wrap (index1 + 1)];
+
+            auto& state = v[(size_t) channel];
+            state = dFrac == 0 ? value1 : value2 + tapAlpha * (value1 - state);
+            output[i] = state;
+        }
+    }
+
+    pos = (pos + size - numSamples) % size;
+
+    if (updateReadPointer)
+        readPos[(size_t) channel] = pos;
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
@@ -160,6 +160,53 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This is equivalent to calling pushSample once for each sample in the block,
+        but avoids the per-sample overhead.
+
+        @see pushSample, readTaps
+    */
+    void pushBlock (int channel, const SampleType* samples, int numSamples);
+
+    /** Reads a block of samples from one channel of the delay line, using a
+        separate fractional delay for each sample.
+
+        The output is the same as calling popSample for each sample with the
+        corresponding delay, so it's usually called after pushing the same number
+        of samples with pushBlock. The delay values don't have to go through
+        setDelay, and the delay previously set with setDelay is left unchanged.
+
+        Because the whole block has already been pushed when it's read, the delay
+        line needs room for the block on top of the longest delay, so make sure the
+        maximum delay is at least the longest delay used plus the block size (plus
+        two more samples for Lagrange interpolation).
+
+        As each output sample only depends on the delay line contents, it's also
+        possible to read a block before pushing it, as long as every delay in the
+        block is larger than the number of samples being read. This is useful when
+        implementing a feedback loop.
+
+        @param channel              the target channel for the delay line.
+
+        @param delaysInSamples      the fractional delay for each output sample. Each
+                                    value must be between 0 and getMaximumDelayInSamples().
+
+        @param output               the destination for the delayed samples.
+
+        @param numSamples           the number of samples to read, which must not be
+                                    more than getMaximumDelayInSamples() + 1.
+
+        @param updateReadPointer    should be set to true if this is the only read
+                                    for this block, or false for all but the last
+                                    of several taps reading the same block.
+
+        @see pushBlock, popSample
+    */
+    void readTaps (int channel, const SampleType* delaysInSamples, SampleType* output,
+                   int numSamples, bool updateReadPointer = true);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+namespace dsp
+{
+
+class DelayLineTest  : public UnitTest
+{
+public:
+    DelayLineTest()
+        : UnitTest ("Delay Line", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Block processing matches pushSample and popSample");
+        {
+            testBlockProcessing<float,  DelayLineInterpolationTypes::None>();
+            testBlockProcessing<float,  DelayLineInterpolationTypes::Linear>();
+            testBlockProcessing<float,  DelayLineInterpolationTypes::Lagrange3rd>();
+            testBlockProcessing<float,  DelayLineInterpolationTypes::Thiran>();
+            testBlockProcessing<double, DelayLineInterpolationTypes::Linear>();
+            testBlockProcessing<double, DelayLineInterpolationTypes::Lagrange3rd>();
+        }
+
+        beginTest ("Multiple taps can read the same block");
+        {
+            testMultipleTaps<float,  DelayLineInterpolationTypes::Linear>();
+            testMultipleTaps<double, DelayLineInterpolationTypes::Lagrange3rd>();
+        }
+
+        beginTest ("Reading a block before pushing it matches the per-sample feedback loop");
+        {
+            testFeedbackLoop<float,  DelayLineInterpolationTypes::Linear>();
+            testFeedbackLoop<double, DelayLineInterpolationTypes::Lagrange3rd>();
+        }
+    }
+
+private:
+    // The lines have room for a block of up to maxBlockSize on top of maxDelay
+    static constexpr int maxDelay = 100, maxBlockSize = 128, numSamples = 1000;
+
+    template <typename SampleType>
+    static std::vector<SampleType> makeRandomSignal (Random& random, int length, double low, double high)
+    {
+        std::vector<SampleType> result ((size_t) length);
+
+        for (auto& sample : result)
+            sample = (SampleType) (low + random.nextDouble() * (high - low));
+
+        return result;
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    static DelayLine<SampleType, InterpolationType> makeDelayLine (int numChannels)
+    {
+        DelayLine<SampleType, InterpolationType> line (maxDelay + maxBlockSize + 2);
+        line.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+        return line;
+    }
+
+    template <typename SampleType>
+    void expectSignalsMatch (const std::vector<SampleType>& a, const std::vector<SampleType>& b)
+    {
+        jassert (a.size() == b.size());
+
+        for (size_t i = 0; i < a.size(); ++i)
+            expectWithinAbsoluteError (a[i], b[i], (SampleType) 1.0e-6);
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    void testBlockProcessing()
+    {
+        Random random (0x1234);
+        const auto input  = makeRandomSignal<SampleType> (random, numSamples, -1.0, 1.0);
+        const auto delays = makeRandomSignal<SampleType> (random, numSamples, 0.0, (double) maxDelay);
+
+        auto reference = makeDelayLine<SampleType, InterpolationType> (2);
+        auto blockLine = makeDelayLine<SampleType, InterpolationType> (2);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            std::vector<SampleType> expected ((size_t) numSamples), actual ((size_t) numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                reference.pushSample (channel, input[(size_t) i]);
+                expected[(size_t) i] = reference.popSample (channel, delays[(size_t) i]);
+            }
+
+            // Use a range of block sizes, including ones longer than the delays
+            for (int start = 0, blockSize = 1; start < numSamples; start += blockSize, blockSize = jmin (blockSize * 3 + 1, maxBlockSize))
+            {
+                blockSize = jmin (blockSize, numSamples - start);
+                blockLine.pushBlock (channel, input.data() + start, blockSize);
+                blockLine.readTaps (channel, delays.data() + start, actual.data() + start, blockSize);
+            }
+
+            expectSignalsMatch (expected, actual);
+        }
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    void testMultipleTaps()
+    {
+        constexpr int blockSize = 64;
+
+        Random random (0x2345);
+        const auto input = makeRandomSignal<SampleType> (random, numSamples, -1.0, 1.0);
+        const auto delaysA = makeRandomSignal<SampleType> (random, numSamples, 0.0, (double) maxDelay);
+        const auto delaysB = makeRandomSignal<SampleType> (random, numSamples, 0.0, (double) maxDelay);
+
+        auto reference = makeDelayLine<SampleType, InterpolationType> (1);
+        auto blockLine = makeDelayLine<SampleType, InterpolationType> (1);
+
+        std::vector<SampleType> expectedA ((size_t) numSamples), expectedB ((size_t) numSamples),
+                                actualA ((size_t) numSamples), actualB ((size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            reference.pushSample (0, input[(size_t) i]);
+            expectedA[(size_t) i] = reference.popSample (0, delaysA[(size_t) i], false);
+            expectedB[(size_t) i] = reference.popSample (0, delaysB[(size_t) i], true);
+        }
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const auto numThisTime = jmin (blockSize, numSamples - start);
+
+            blockLine.pushBlock (0, input.data() + start, numThisTime);
+            blockLine.readTaps (0, delaysA.data() + start, actualA.data() + start, numThisTime, false);
+            blockLine.readTaps (0, delaysB.data() + start, actualB.data() + start, numThisTime, true);
+        }
+
+        expectSignalsMatch (expectedA, actualA);
+        expectSignalsMatch (expectedB, actualB);
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    void testFeedbackLoop()
+    {
+        constexpr int minDelay = 20;
+        const auto feedback = (SampleType) 0.7;
+
+        Random random (0x3456);
+        const auto input  = makeRandomSignal<SampleType> (random, numSamples, -1.0, 1.0);
+        const auto delays = makeRandomSignal<SampleType> (random, numSamples, (double) minDelay, (double) maxDelay - 1.0);
+
+        auto reference = makeDelayLine<SampleType, InterpolationType> (1);
+        auto blockLine = makeDelayLine<SampleType, InterpolationType> (1);
+
+        std::vector<SampleType> expected ((size_t) numSamples), actual ((size_t) numSamples);
+        SampleType last = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            reference.pushSample (0, input[(size_t) i] - last * feedback);
+            last = expected[(size_t) i] = reference.popSample (0, delays[(size_t) i]);
+        }
+
+        std::vector<SampleType> toPush ((size_t) minDelay);
+        last = 0;
+
+        for (int start = 0; start < numSamples; start += minDelay)
+        {
+            const auto numThisTime = jmin (minDelay, numSamples - start);
+
+            blockLine.readTaps (0, delays.data() + start, actual.data() + start, numThisTime);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                toPush[(size_t) i] = input[(size_t) (start + i)] - last * feedback;
+                last = actual[(size_t) (start + i)];
+            }
+
+            blockLine.pushBlock (0, toPush.data(), numThisTime);
+        }
+
+        expectSignalsMatch (expected, actual);
+    }
+};
+
+static DelayLineTest delayLineTest;
+
+} // namespace dsp
+} // namespace juce
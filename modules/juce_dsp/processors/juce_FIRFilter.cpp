@@ -1,161 +1,349 @@
-/*
-  ==============================================================================
-
-   This file is part of the JUCE library.
-   Copyright (c) 2022 - Raw Material Software Limited
-
-   JUCE is an open source library subject to commercial or open-source
-   licensing.
-
-   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
-   Agreement and JUCE Privacy Policy.
-
-   End User License Agreement: www.juce.com/juce-7-licence
-   Privacy Policy: www.juce.com/juce-privacy-policy
-
-   Or: You may also use this code under the terms of the GPL v3 (see
-   www.gnu.org/licenses).
-
-   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
-   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
-   DISCLAIMED.
-
-  ==============================================================================
-*/
-
-namespace juce
-{
-namespace dsp
-{
-
-template <typename NumericType>
-double FIR::Coefficients<NumericType>::Coefficients::getMagnitudeForFrequency (double frequency, double theSampleRate) const noexcept
-{
-    jassert (theSampleRate > 0.0);
-    jassert (frequency >= 0.0 && frequency <= theSampleRate * 0.5);
-
-    constexpr Complex<double> j (0, 1);
-    auto order = getFilterOrder();
-
-    Complex<double> numerator = 0.0, factor = 1.0;
-    Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequency * j / theSampleRate);
-
-    const auto* coefs = coefficients.begin();
-
-    for (size_t n = 0; n <= order; ++n)
-    {
-        numerator += static_cast<double> (coefs[n]) * factor;
-        factor *= jw;
-    }
-
-    return std::abs (numerator);
-}
-
-//==============================================================================
-template <typename NumericType>
-void FIR::Coefficients<NumericType>::Coefficients::getMagnitudeForFrequencyArray (double* frequencies, double* magnitudes,
-                                                                        size_t numSamples, double theSampleRate) const noexcept
-{
-    jassert (theSampleRate > 0.0);
-
-    constexpr Complex<double> j (0, 1);
-    const auto* coefs = coefficients.begin();
-    auto order = getFilterOrder();
-
-    for (size_t i = 0; i < numSamples; ++i)
-    {
-        jassert (frequencies[i] >= 0.0 && frequencies[i] <= theSampleRate * 0.5);
-
-        Complex<double> numerator = 0.0;
-        Complex<double> factor = 1.0;
-        Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequencies[i] * j / theSampleRate);
-
-        for (size_t n = 0; n <= order; ++n)
-        {
-            numerator += static_cast<double> (coefs[n]) * factor;
-            factor *= jw;
-        }
-
-        magnitudes[i] = std::abs (numerator);
-    }
-}
-
-//==============================================================================
-template <typename NumericType>
-double FIR::Coefficients<NumericType>::Coefficients::getPhaseForFrequency (double frequency, double theSampleRate) const noexcept
-{
-    jassert (theSampleRate > 0.0);
-    jassert (frequency >= 0.0 && frequency <= theSampleRate * 0.5);
-
-    constexpr Complex<double> j (0, 1);
-
-    Complex<double> numerator = 0.0;
-    Complex<double> factor = 1.0;
-    Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequency * j / theSampleRate);
-
-    const auto* coefs = coefficients.begin();
-    auto order = getFilterOrder();
-
-    for (size_t n = 0; n <= order; ++n)
-    {
-        numerator += static_cast<double> (coefs[n]) * factor;
-        factor *= jw;
-    }
-
-    return std::arg (numerator);
-}
-
-//==============================================================================
-template <typename NumericType>
-void FIR::Coefficients<NumericType>::Coefficients::getPhaseForFrequencyArray (double* frequencies, double* phases,
-                                                                    size_t numSamples, double theSampleRate) const noexcept
-{
-    jassert (theSampleRate > 0.0);
-
-    constexpr Complex<double> j (0, 1);
-    const auto* coefs = coefficients.begin();
-    auto order = getFilterOrder();
-
-    for (size_t i = 0; i < numSamples; ++i)
-    {
-        jassert (frequencies[i] >= 0.0 && frequencies[i] <= theSampleRate * 0.5);
-
-        Complex<double> numerator = 0.0, factor = 1.0;
-        Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequencies[i] * j / theSampleRate);
-
-        for (size_t n = 0; n <= order; ++n)
-        {
-            numerator += static_cast<double> (coefs[n]) * factor;
-            factor *= jw;
-        }
-
-        phases[i] = std::arg (numerator);
-    }
-}
-
-//==============================================================================
-template <typename NumericType>
-void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
-{
-    auto magnitude = static_cast<NumericType> (0);
-
-    auto* coefs = coefficients.getRawDataPointer();
-    auto n = static_cast<size_t> (coefficients.size());
-
-    for (size_t i = 0; i < n; ++i)
-    {
-        auto c = coefs[i];
-        magnitude += c * c;
-    }
-
-    auto magnitudeInv = 1 / (4 * std::sqrt (magnitude));
-
-    FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
-}
-
-//==============================================================================
-template struct FIR::Coefficients<float>;
-template struct FIR::Coefficients<double>;
-
-} // namespace dsp
-} // namespace juce
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename NumericType>
+double FIR::Coefficients<NumericType>::Coefficients::getMagnitudeForFrequency (double frequency, double theSampleRate) const noexcept
+{
+    jassert (theSampleRate > 0.0);
+    jassert (frequency >= 0.0 && frequency <= theSampleRate * 0.5);
+
+    constexpr Complex<double> j (0, 1);
+    auto order = getFilterOrder();
+
+    Complex<double> numerator = 0.0, factor = 1.0;
+    Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequency * j / theSampleRate);
+
+    const auto* coefs = coefficients.begin();
+
+    for (size_t n = 0; n <= order; ++n)
+    {
+        numerator += static_cast<double> (coefs[n]) * factor;
+        factor *= jw;
+    }
+
+    return std::abs (numerator);
+}
+
+//==============================================================================
+template <typename NumericType>
+void FIR::Coefficients<NumericType>::Coefficients::getMagnitudeForFrequencyArray (double* frequencies, double* magnitudes,
+                                                                        size_t numSamples, double theSampleRate) const noexcept
+{
+    jassert (theSampleRate > 0.0);
+
+    constexpr Complex<double> j (0, 1);
+    const auto* coefs = coefficients.begin();
+    auto order = getFilterOrder();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        jassert (frequencies[i] >= 0.0 && frequencies[i] <= theSampleRate * 0.5);
+
+        Complex<double> numerator = 0.0;
+        Complex<double> factor = 1.0;
+        Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequencies[i] * j / theSampleRate);
+
+        for (size_t n = 0; n <= order; ++n)
+        {
+            numerator += static_cast<double> (coefs[n]) * factor;
+            factor *= jw;
+        }
+
+        magnitudes[i] = std::abs (numerator);
+    }
+}
+
+//==============================================================================
+template <typename NumericType>
+double FIR::Coefficients<NumericType>::Coefficients::getPhaseForFrequency (double frequency, double theSampleRate) const noexcept
+{
+    jassert (theSampleRate > 0.0);
+    jassert (frequency >= 0.0 && frequency <= theSampleRate * 0.5);
+
+    constexpr Complex<double> j (0, 1);
+
+    Complex<double> numerator = 0.0;
+    Complex<double> factor = 1.0;
+    Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequency * j / theSampleRate);
+
+    const auto* coefs = coefficients.begin();
+    auto order = getFilterOrder();
+
+    for (size_t n = 0; n <= order; ++n)
+    {
+        numerator += static_cast<double> (coefs[n]) * factor;
+        factor *= jw;
+    }
+
+    return std::arg (numerator);
+}
+
+//==============================================================================
+template <typename NumericType>
+void FIR::Coefficients<NumericType>::Coefficients::getPhaseForFrequencyArray (double* frequencies, double* phases,
+                                                                    size_t numSamples, double theSampleRate) const noexcept
+{
+    jassert (theSampleRate > 0.0);
+
+    constexpr Complex<double> j (0, 1);
+    const auto* coefs = coefficients.begin();
+    auto order = getFilterOrder();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        jassert (frequencies[i] >= 0.0 && frequencies[i] <= theSampleRate * 0.5);
+
+        Complex<double> numerator = 0.0, factor = 1.0;
+        Complex<double> jw = std::exp (-MathConstants<double>::twoPi * frequencies[i] * j / theSampleRate);
+
+        for (size_t n = 0; n <= order; ++n)
+        {
+            numerator += static_cast<double> (coefs[n]) * factor;
+            factor *= jw;
+        }
+
+        phases[i] = std::arg (numerator);
+    }
+}
+
+//==============================================================================
+template <typename NumericType>
+void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
+{
+    auto magnitude = static_cast<NumericType> (0);
+
+    auto* coefs = coefficients.getRawDataPointer();
+    auto n = static_cast<size_t> (coefficients.size());
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto c = coefs[i];
+        magnitude += c * c;
+    }
+
+    auto magnitudeInv = 1 / (4 * std::sqrt (magnitude));
+
+    FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
+}
+
+//==============================================================================
+namespace FIR
+{
+namespace detail
+{
+
+PartitionedConvolution::PartitionedConvolution (const PartitionedConvolution& other)
+    : blockSize (other.blockSize),
+      numTailPartitions (other.numTailPartitions),
+      framePosition (other.framePosition),
+      newestSpectrum (other.newestSpectrum),
+      fft (other.fft != nullptr ? std::make_unique<FFT> (roundToInt (std::log2 ((double) (2 * other.blockSize)))) : nullptr),
+      kernel (other.kernel),
+      reversedHead (other.reversedHead),
+      inputFrames (other.inputFrames),
+      tailOutput (other.tailOutput),
+      fftBuffer (other.fftBuffer),
+      partitionSpectra (other.partitionSpectra),
+      inputSpectra (other.inputSpectra)
+{
+}
+
+PartitionedConvolution& PartitionedConvolution::operator= (const PartitionedConvolution& other)
+{
+    if (this != &other)
+    {
+        PartitionedConvolution copy (other);
+        *this = std::move (copy);
+    }
+
+    return *this;
+}
+
+void PartitionedConvolution::setKernel (const float* taps, size_t numTaps)
+{
+    jassert (numTaps > 0);
+
+    // Balances the cost of the direct head against the cost of the FFT partitions
+    const auto newBlockSize = (size_t) jlimit (32, 1024, nextPowerOfTwo (roundToInt (2.0 * std::sqrt ((double) numTaps))));
+    const auto newNumTailPartitions = numTaps > newBlockSize ? (numTaps - 1) / newBlockSize : 0;
+    const auto numBins = newBlockSize + 1;
+
+    if (newBlockSize != blockSize || newNumTailPartitions != numTailPartitions)
+    {
+        blockSize = newBlockSize;
+        numTailPartitions = newNumTailPartitions;
+
+        fft = std::make_unique<FFT> (roundToInt (std::log2 ((double) (2 * blockSize))));
+        reversedHead.resize (blockSize);
+        inputFrames.resize (2 * blockSize);
+        tailOutput.resize (blockSize);
+        fftBuffer.resize (4 * blockSize);
+        partitionSpectra.resize (numTailPartitions * numBins);
+        inputSpectra.resize (numTailPartitions * numBins);
+
+        reset();
+    }
+
+    kernel.assign (taps, taps + numTaps);
+
+    for (size_t i = 0; i < blockSize; ++i)
+        reversedHead[blockSize - 1 - i] = i < numTaps ? taps[i] : 0.0f;
+
+    for (size_t partition = 0; partition < numTailPartitions; ++partition)
+    {
+        const auto offset = (partition + 1) * blockSize;
+        const auto numPartitionTaps = jmin (blockSize, numTaps - offset);
+
+        std::fill (fftBuffer.begin(), fftBuffer.end(), 0.0f);
+        std::copy (taps + offset, taps + offset + numPartitionTaps, fftBuffer.begin());
+        fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+        const auto* bins = reinterpret_cast<const Complex<float>*> (fftBuffer.data());
+        std::copy (bins, bins + numBins, partitionSpectra.begin() + (std::ptrdiff_t) (partition * numBins));
+    }
+}
+
+bool PartitionedConvolution::hasKernel (const float* taps, size_t numTaps) const noexcept
+{
+    return kernel.size() == numTaps && std::equal (kernel.begin(), kernel.end(), taps);
+}
+
+void PartitionedConvolution::release()
+{
+    blockSize = numTailPartitions = framePosition = newestSpectrum = 0;
+    fft.reset();
+
+    for (auto* v : { &kernel, &reversedHead, &inputFrames, &tailOutput, &fftBuffer })
+        std::vector<float>().swap (*v);
+
+    std::vector<Complex<float>>().swap (partitionSpectra);
+    std::vector<Complex<float>>().swap (inputSpectra);
+}
+
+void PartitionedConvolution::reset() noexcept
+{
+    framePosition = 0;
+    newestSpectrum = 0;
+
+    std::fill (inputFrames.begin(), inputFrames.end(), 0.0f);
+    std::fill (tailOutput.begin(), tailOutput.end(), 0.0f);
+    std::fill (inputSpectra.begin(), inputSpectra.end(), Complex<float>());
+}
+
+void PartitionedConvolution::process (const float* input, float* output, size_t numSamples, bool bypassed) noexcept
+{
+    jassert (isActive());
+
+    auto* frames = inputFrames.data();
+    const auto* head = reversedHead.data();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto sample = input[i];
+        frames[blockSize + framePosition] = sample;
+
+        if (bypassed)
+        {
+            output[i] = sample;
+        }
+        else
+        {
+            // The head covers the most recent blockSize input samples
+            const auto* history = frames + framePosition + 1;
+            auto sum = tailOutput[framePosition];
+
+            for (size_t k = 0; k < blockSize; ++k)
+                sum += head[k] * history[k];
+
+            output[i] = sum;
+        }
+
+        if (++framePosition == blockSize)
+        {
+            framePosition = 0;
+            finishFrame();
+        }
+    }
+}
+
+void PartitionedConvolution::finishFrame() noexcept
+{
+    const auto numBins = blockSize + 1;
+
+    if (numTailPartitions > 0)
+    {
+        // Store the spectrum of the last two input frames for the overlap-save partitions
+        std::copy (inputFrames.begin(), inputFrames.end(), fftBuffer.begin());
+        std::fill (fftBuffer.begin() + (std::ptrdiff_t) (2 * blockSize), fftBuffer.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+        newestSpectrum = (newestSpectrum + 1) % numTailPartitions;
+        const auto* bins = reinterpret_cast<const Complex<float>*> (fftBuffer.data());
+        std::copy (bins, bins + numBins, inputSpectra.begin() + (std::ptrdiff_t) (newestSpectrum * numBins));
+    }
+
+    std::copy (inputFrames.begin() + (std::ptrdiff_t) blockSize, inputFrames.end(), inputFrames.begin());
+
+    if (numTailPartitions == 0)
+        return;
+
+    // Partition k (from 1) is applied to the spectrum computed k - 1 frames ago,
+    // so that its result lands in the frame that is about to start.
+    auto* accumulator = reinterpret_cast<Complex<float>*> (fftBuffer.data());
+    std::fill (fftBuffer.begin(), fftBuffer.end(), 0.0f);
+
+    auto spectrumIndex = newestSpectrum;
+
+    for (size_t partition = 0; partition < numTailPartitions; ++partition)
+    {
+        const auto* x = inputSpectra.data() + spectrumIndex * numBins;
+        const auto* h = partitionSpectra.data() + partition * numBins;
+
+        for (size_t bin = 0; bin < numBins; ++bin)
+            accumulator[bin] += x[bin] * h[bin];
+
+        spectrumIndex = (spectrumIndex == 0 ? numTailPartitions : spectrumIndex) - 1;
+    }
+
+    fft->performRealOnlyInverseTransform (fftBuffer.data());
+    std::copy (fftBuffer.begin() + (std::ptrdiff_t) blockSize,
+               fftBuffer.begin() + (std::ptrdiff_t) (2 * blockSize),
+               tailOutput.begin());
+}
+
+} // namespace detail
+} // namespace FIR
+
+//==============================================================================
+template struct FIR::Coefficients<float>;
+template struct FIR::Coefficients<double>;
+
+} // namespace dsp
+} // namespace juce
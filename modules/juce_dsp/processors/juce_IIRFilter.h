@@ -33,6 +33,44 @@ namespace dsp
 */
 namespace IIR
 {
+    /** A cascade of second order sections (biquads), held by value.
+
+        Each section holds six coefficients in the same order as the arrays returned by
+        ArrayCoefficients: b0, b1, b2, a0, a1, a2. First order sections have b2 and a2 set
+        to zero. As this is just a fixed size array, it can be designed, copied and handed
+        to a CascadedFilter on the audio thread without allocating, and can be built at
+        compile time from constant coefficients.
+
+        @see CascadedFilter, FilterDesign
+
+        @tags{DSP}
+    */
+    template <typename NumericType, size_t NumSections>
+    struct SecondOrderSections
+    {
+        /** Creates a cascade where every section passes the signal through unchanged. */
+        constexpr SecondOrderSections() noexcept
+        {
+            for (auto& section : sections)
+                section = {{ 1, 0, 0, 1, 0, 0 }};
+        }
+
+        /** Sets a section from the coefficients of a first order filter. */
+        constexpr void setSection (size_t index, const std::array<NumericType, 4>& values) noexcept
+        {
+            sections[index] = {{ values[0], values[1], 0, values[2], values[3], 0 }};
+        }
+
+        /** Sets a section from the coefficients of a second order filter. */
+        constexpr void setSection (size_t index, const std::array<NumericType, 6>& values) noexcept
+        {
+            sections[index] = values;
+        }
+
+        /** The raw coefficients of each section. */
+        std::array<std::array<NumericType, 6>, NumSections> sections {};
+    };
+
     /** A set of coefficients for use in an Filter object.
 
         @tags{DSP}
@@ -335,6 +373,22 @@ namespace IIR
         */
         CoefficientsPtr coefficients;
 
+        /** Replaces the values of the coefficients with an array like the ones returned
+            by ArrayCoefficients.
+
+            This reuses the storage of the current coefficients object, so for filters
+            of up to third order it doesn't allocate, and can be used on the audio thread.
+            It changes the coefficients of every filter sharing the object, like all the
+            instances in a ProcessorDuplicator. The state is reset at the next call to
+            process() only if the order of the filter has changed.
+        */
+        template <size_t Num>
+        void setCoefficients (const std::array<NumericType, Num>& values) noexcept
+        {
+            jassert (coefficients != nullptr);
+            *coefficients = values;
+        }
+
         //==============================================================================
         /** Resets the filter's processing pipeline, ready to start a new stream of data.
 
@@ -396,6 +450,162 @@ namespace IIR
 
         JUCE_LEAK_DETECTOR (Filter)
     };
+
+    //==============================================================================
+    /**
+        A processing class that filters each channel of an audio signal through a
+        cascade of second order sections, using the Transposed Direct Form II structure.
+
+        Unlike Filter, the coefficients are held by value in a SecondOrderSections
+        object, and setCoefficients() only copies them, so this can be redesigned on the
+        audio thread (for example with FilterDesign::designIIRLowpassHighOrderButterworthSections)
+        without allocating. Splitting high order filters into sections also keeps them
+        numerically stable.
+
+        @see SecondOrderSections, Filter
+
+        @tags{DSP}
+    */
+    template <typename SampleType, size_t NumSections>
+    class CascadedFilter
+    {
+    public:
+        /** The NumericType is the underlying primitive type used by the SampleType (which
+            could be either a primitive or vector)
+        */
+        using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
+
+        /** The type of the coefficients used by this filter. */
+        using Sections = SecondOrderSections<NumericType, NumSections>;
+
+        //==============================================================================
+        /** Creates a filter which passes the signal through unchanged. */
+        CascadedFilter() noexcept                                   { setCoefficients (Sections{}); }
+
+        /** Creates a filter with a given set of coefficients. */
+        explicit CascadedFilter (const Sections& sections) noexcept { setCoefficients (sections); }
+
+        //==============================================================================
+        /** Sets the coefficients of the filter.
+
+            This doesn't allocate or reset the state of the filter, so it can be called
+            from the audio thread whenever the filter's parameters change.
+        */
+        void setCoefficients (const Sections& newSections) noexcept
+        {
+            for (size_t i = 0; i < NumSections; ++i)
+            {
+                const auto& c = newSections.sections[i];
+                const auto a0Inv = c[3] != NumericType() ? static_cast<NumericType> (1) / c[3] : NumericType();
+
+                coefficients[i] = {{ c[0] * a0Inv, c[1] * a0Inv, c[2] * a0Inv, c[4] * a0Inv, c[5] * a0Inv }};
+            }
+        }
+
+        //==============================================================================
+        /** Called before processing starts. */
+        void prepare (const ProcessSpec& spec)
+        {
+            state.resize (spec.numChannels);
+            reset();
+        }
+
+        /** Resets the filter's processing state, ready to start a new stream of data. */
+        void reset() noexcept
+        {
+            for (auto& channelState : state)
+                for (auto& sectionState : channelState)
+                    sectionState = {};
+        }
+
+        /** Ensure that the state variables are rounded to zero if the state
+            variables are denormals. This is only needed if you are doing
+            sample by sample processing.
+        */
+        void snapToZero() noexcept
+        {
+            for (auto& channelState : state)
+                for (auto& sectionState : channelState)
+                    for (auto& value : sectionState)
+                        util::snapToZero (value);
+        }
+
+        //==============================================================================
+        /** Processes the input and output samples supplied in the processing context. */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            const auto& inputBlock = context.getInputBlock();
+            auto& outputBlock      = context.getOutputBlock();
+            const auto numChannels = outputBlock.getNumChannels();
+            const auto numSamples  = outputBlock.getNumSamples();
+
+            jassert (inputBlock.getNumChannels() <= state.size());
+            jassert (inputBlock.getNumChannels() == numChannels);
+            jassert (inputBlock.getNumSamples()  == numSamples);
+
+            if (context.isBypassed)
+            {
+                if (context.usesSeparateInputAndOutputBlocks())
+                    outputBlock.copyFrom (inputBlock);
+
+                return;
+            }
+
+            // Running each section over the whole channel keeps its coefficients and
+            // state in registers
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* input = inputBlock.getChannelPointer (channel);
+                auto* output = outputBlock.getChannelPointer (channel);
+
+                for (size_t section = 0; section < NumSections; ++section)
+                {
+                    processSection (coefficients[section], state[channel][section], input, output, numSamples);
+                    input = output;
+                }
+            }
+
+           #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            snapToZero();
+           #endif
+        }
+
+        /** Processes a single sample on a given channel. */
+        SampleType JUCE_VECTOR_CALLTYPE processSample (int channel, SampleType sample) noexcept
+        {
+            for (size_t section = 0; section < NumSections; ++section)
+                processSection (coefficients[section], state[(size_t) channel][section], &sample, &sample, 1);
+
+            return sample;
+        }
+
+    private:
+        //==============================================================================
+        static void processSection (const std::array<NumericType, 5>& c, std::array<SampleType, 2>& s,
+                                    const SampleType* input, SampleType* output, size_t numSamples) noexcept
+        {
+            const auto b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+            auto s1 = s[0], s2 = s[1];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto in = input[i];
+                const auto out = in * b0 + s1;
+
+                s1 = in * b1 - out * a1 + s2;
+                s2 = in * b2 - out * a2;
+                output[i] = out;
+            }
+
+            s[0] = s1;
+            s[1] = s2;
+        }
+
+        //==============================================================================
+        std::array<std::array<NumericType, 5>, NumSections> coefficients;
+        std::vector<std::array<std::array<SampleType, 2>, NumSections>> state;
+    };
 } // namespace IIR
 } // namespace dsp
 } // namespace juce
@@ -212,12 +212,12 @@ SampleType JUCE_VECTOR_CALLTYPE Filter<SampleType>::processSample (SampleType sa
     check();
     auto* c = coefficients->getRawCoefficients();
 
-    auto output = (c[0] * sample) + state[0];
+    auto output = (sample * c[0]) + state[0];
 
     for (size_t j = 0; j < order - 1; ++j)
-        state[j] = (c[j + 1] * sample) - (c[order + j + 1] * output) + state[j + 1];
+        state[j] = (sample * c[j + 1]) - (output * c[order + j + 1]) + state[j + 1];
 
-    state[order - 1] = (c[order] * sample) - (c[order * 2] * output);
+    state[order - 1] = (sample * c[order]) - (output * c[order * 2]);
 
     return output;
 }
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRFilterTests  : public UnitTest
+{
+public:
+    IIRFilterTests()
+        : UnitTest ("IIR Filter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Butterworth sections match the reference designs");
+        {
+            checkSectionsMatchReference<1>();
+            checkSectionsMatchReference<4>();
+            checkSectionsMatchReference<5>();
+        }
+
+        beginTest ("Cascaded filter matches a chain of filters");
+        {
+            checkCascadeMatchesFilters<4> (true);
+            checkCascadeMatchesFilters<5> (false);
+        }
+
+        beginTest ("Sections can be built at compile time");
+        {
+            static constexpr auto sections = []
+            {
+                IIR::SecondOrderSections<float, 2> result;
+                result.setSection (1, std::array<float, 4> {{ 0.5f, 0.5f, 1.0f, 0.0f }});
+                return result;
+            }();
+
+            static_assert (sections.sections[0][0] == 1.0f && sections.sections[0][1] == 0.0f);
+            static_assert (sections.sections[1][1] == 0.5f && sections.sections[1][2] == 0.0f);
+
+            IIR::CascadedFilter<float, 2> filter (sections);
+            filter.prepare ({ 44100.0, 16, 1 });
+
+            expectEquals (filter.processSample (0, 1.0f), 0.5f);
+            expectEquals (filter.processSample (0, 0.0f), 0.5f);
+            expectEquals (filter.processSample (0, 0.0f), 0.0f);
+        }
+
+        beginTest ("Setting coefficients from an array reuses their storage");
+        {
+            IIR::Filter<float> filter (IIR::Coefficients<float>::makeLowPass (44100.0, 1000.0f));
+            const auto* object = filter.coefficients.get();
+            const auto* raw = filter.coefficients->getRawCoefficients();
+
+            filter.setCoefficients (IIR::ArrayCoefficients<float>::makeHighPass (44100.0, 5000.0f));
+            expect (filter.coefficients.get() == object);
+            expect (filter.coefficients->getRawCoefficients() == raw);
+            expectEquals ((int) filter.coefficients->getFilterOrder(), 2);
+
+            filter.setCoefficients (IIR::ArrayCoefficients<float>::makeFirstOrderLowPass (44100.0, 5000.0f));
+            expect (filter.coefficients->getRawCoefficients() == raw);
+            expectEquals ((int) filter.coefficients->getFilterOrder(), 1);
+        }
+    }
+
+private:
+    template <int Order>
+    void checkSectionsMatchReference()
+    {
+        for (auto isLowPass : { true, false })
+        {
+            const auto sections = isLowPass ? FilterDesign<double>::designIIRLowpassHighOrderButterworthSections<Order> (1234.0, 48000.0)
+                                            : FilterDesign<double>::designIIRHighpassHighOrderButterworthSections<Order> (1234.0, 48000.0);
+            const auto reference = isLowPass ? FilterDesign<double>::designIIRLowpassHighOrderButterworthMethod (1234.0, 48000.0, Order)
+                                             : FilterDesign<double>::designIIRHighpassHighOrderButterworthMethod (1234.0, 48000.0, Order);
+
+            expectEquals (reference.size(), (int) sections.sections.size());
+
+            for (int i = 0; i < reference.size(); ++i)
+            {
+                const auto& section = sections.sections[(size_t) i];
+                const auto* expected = reference[i]->getRawCoefficients();
+
+                // the reference coefficients are normalised by a0, which is then dropped
+                if (reference[i]->getFilterOrder() == 1)
+                {
+                    for (auto [index, value] : { std::pair { 0, 0 }, std::pair { 1, 1 }, std::pair { 4, 2 } })
+                        expectWithinAbsoluteError (section[(size_t) index] / section[3], expected[value], 1.0e-12);
+
+                    expectEquals (section[2], 0.0);
+                    expectEquals (section[5], 0.0);
+                }
+                else
+                {
+                    for (auto [index, value] : { std::pair { 0, 0 }, std::pair { 1, 1 }, std::pair { 2, 2 }, std::pair { 4, 3 }, std::pair { 5, 4 } })
+                        expectWithinAbsoluteError (section[(size_t) index] / section[3], expected[value], 1.0e-12);
+                }
+            }
+        }
+    }
+
+    template <int Order>
+    void checkCascadeMatchesFilters (bool isLowPass)
+    {
+        constexpr int numChannels = 2, numSamples = 300;
+        const ProcessSpec spec { 44100.0, (uint32) numSamples, (uint32) numChannels };
+
+        const auto reference = isLowPass ? FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (3000.0f, spec.sampleRate, Order)
+                                         : FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod (3000.0f, spec.sampleRate, Order);
+
+        IIR::CascadedFilter<float, (size_t) (Order + 1) / 2> cascade (isLowPass ? FilterDesign<float>::designIIRLowpassHighOrderButterworthSections<Order> (3000.0f, spec.sampleRate)
+                                                                                : FilterDesign<float>::designIIRHighpassHighOrderButterworthSections<Order> (3000.0f, spec.sampleRate));
+        cascade.prepare (spec);
+
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        Random random (0x1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        AudioBuffer<float> expected (buffer);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (auto* stage : reference)
+            {
+                IIR::Filter<float> filter (stage);
+                filter.prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+
+                auto* samples = expected.getWritePointer (channel);
+
+                for (int i = 0; i < numSamples; ++i)
+                    samples[i] = filter.processSample (samples[i]);
+            }
+        }
+
+        auto block = AudioBlock<float> (buffer).getSubBlock (0, 100);
+        cascade.process (ProcessContextReplacing<float> (block));
+
+        for (int i = 100; i < numSamples; ++i)
+            for (int channel = 0; channel < numChannels; ++channel)
+                buffer.setSample (channel, i, cascade.processSample (channel, buffer.getSample (channel, i)));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (buffer.getSample (channel, i), expected.getSample (channel, i), 1.0e-5f);
+    }
+};
+
+static IIRFilterTests iirFilterTests;
+
+} // namespace dsp
+} // namespace juce
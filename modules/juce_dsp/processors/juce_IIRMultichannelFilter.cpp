@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+//==============================================================================
+template <typename SampleType>
+MultichannelFilter<SampleType>::MultichannelFilter (size_t numStages)
+    : numFilterStages (jmax ((size_t) 1, numStages)),
+      stageDefaults (numFilterStages)
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::setCoefficients (const Coefficients<SampleType>& newCoefficients)
+{
+    const auto converted = convert (newCoefficients);
+
+    std::fill (stageDefaults.begin(), stageDefaults.end(), converted);
+    std::fill (channelCoefficients.begin(), channelCoefficients.end(), converted);
+    updateGroups();
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::setCoefficients (size_t stage, const Coefficients<SampleType>& newCoefficients)
+{
+    jassert (stage < numFilterStages);
+
+    const auto converted = convert (newCoefficients);
+    stageDefaults[stage] = converted;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        channelCoefficients[channel * numFilterStages + stage] = converted;
+
+    updateGroups();
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::setCoefficients (size_t stage, size_t channel, const Coefficients<SampleType>& newCoefficients)
+{
+    jassert (stage < numFilterStages);
+    jassert (channel < numChannels);
+
+    if (stage < numFilterStages && channel < numChannels)
+    {
+        channelCoefficients[channel * numFilterStages + stage] = convert (newCoefficients);
+        updateGroups();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    numChannels = spec.numChannels;
+    channelCoefficients.resize (numChannels * numFilterStages);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        std::copy (stageDefaults.begin(), stageDefaults.end(),
+                   channelCoefficients.begin() + (std::ptrdiff_t) (channel * numFilterStages));
+
+    groups.assign ((numChannels + numLanes - 1) / numLanes, ChannelGroup (numFilterStages));
+    scratch.resize (jmax ((size_t) 1, (size_t) spec.maximumBlockSize));
+
+    updateGroups();
+    reset();
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::reset() noexcept
+{
+    for (auto& group : groups)
+    {
+        for (auto& stage : group)
+        {
+            stage.s1 = Vector();
+            stage.s2 = Vector();
+        }
+    }
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::snapToZero() noexcept
+{
+    for (auto& group : groups)
+    {
+        for (auto& stage : group)
+        {
+            util::snapToZero (stage.s1);
+            util::snapToZero (stage.s2);
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultichannelFilter<SampleType>::StageCoefficients
+    MultichannelFilter<SampleType>::convert (const Coefficients<SampleType>& c)
+{
+    const auto* raw = c.getRawCoefficients();
+    StageCoefficients result;
+
+    switch (c.getFilterOrder())
+    {
+        case 1:
+            result = { raw[0], raw[1], 0, raw[2], 0 };
+            break;
+
+        case 2:
+            result = { raw[0], raw[1], raw[2], raw[3], raw[4] };
+            break;
+
+        case 0:
+            // A null set of coefficients produces silence, as it does in IIR::Filter
+            result = { 0, 0, 0, 0, 0 };
+            break;
+
+        default:
+            // Only first and second order stages are supported: split higher
+            // order filters into a cascade of stages instead.
+            jassertfalse;
+            break;
+    }
+
+    return result;
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::updateGroups()
+{
+    for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+    {
+        for (size_t stageIndex = 0; stageIndex < numFilterStages; ++stageIndex)
+        {
+            alignas (sizeof (Vector)) SampleType b0[numLanes] {}, b1[numLanes] {}, b2[numLanes] {},
+                                                 a1[numLanes] {}, a2[numLanes] {};
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                const auto channel = groupIndex * numLanes + lane;
+
+                if (channel >= numChannels)
+                    break;
+
+                const auto& c = channelCoefficients[channel * numFilterStages + stageIndex];
+                b0[lane] = c.b0;
+                b1[lane] = c.b1;
+                b2[lane] = c.b2;
+                a1[lane] = c.a1;
+                a2[lane] = c.a2;
+            }
+
+            auto& stage = groups[groupIndex][stageIndex];
+
+           #if JUCE_USE_SIMD
+            stage.b0 = Vector::fromRawArray (b0);
+            stage.b1 = Vector::fromRawArray (b1);
+            stage.b2 = Vector::fromRawArray (b2);
+            stage.a1 = Vector::fromRawArray (a1);
+            stage.a2 = Vector::fromRawArray (a2);
+           #else
+            stage.b0 = b0[0];
+            stage.b1 = b1[0];
+            stage.b2 = b2[0];
+            stage.a1 = a1[0];
+            stage.a2 = a2[0];
+           #endif
+        }
+    }
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::processInterleaved (ChannelGroup& group, size_t numSamples) noexcept
+{
+    auto* data = scratch.data();
+
+    for (auto& stage : group)
+    {
+        const auto b0 = stage.b0, b1 = stage.b1, b2 = stage.b2, a1 = stage.a1, a2 = stage.a2;
+        auto s1 = stage.s1, s2 = stage.s2;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto input = data[i];
+            const auto output = (b0 * input) + s1;
+            s1 = (b1 * input) - (a1 * output) + s2;
+            s2 = (b2 * input) - (a2 * output);
+            data[i] = output;
+        }
+
+        stage.s1 = s1;
+        stage.s2 = s2;
+    }
+}
+
+//==============================================================================
+template class MultichannelFilter<float>;
+template class MultichannelFilter<double>;
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
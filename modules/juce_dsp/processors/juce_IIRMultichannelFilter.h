@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+//==============================================================================
+/**
+    A cascade of first and second order IIR filters which processes several
+    channels at once.
+
+    Rather than running one IIR::Filter per channel, this class interleaves
+    groups of channels into the lanes of a SIMDRegister so that a single pass
+    over the samples filters as many channels as the register can hold. Each
+    channel and each stage can have its own coefficients, so the class can be
+    used to run a whole bank of different filters as well as the same filter on
+    many channels.
+
+    Only first and second order coefficients are supported: higher order
+    designs should be decomposed into a cascade of stages.
+
+    If JUCE_USE_SIMD is disabled, the channels are processed one after the
+    other using the same transposed direct form II structure.
+
+    @see IIR::Filter, IIR::Coefficients
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultichannelFilter
+{
+public:
+    //==============================================================================
+    /** Creates a filter with the given number of cascaded stages.
+
+        All the stages will initially pass the signal through unchanged.
+    */
+    explicit MultichannelFilter (size_t numStages = 1);
+
+    //==============================================================================
+    /** Returns the number of cascaded stages. */
+    size_t getNumStages() const noexcept            { return numFilterStages; }
+
+    /** Returns the number of channels that the filter was prepared for. */
+    size_t getNumChannels() const noexcept          { return numChannels; }
+
+    //==============================================================================
+    /** Sets the same coefficients on every stage of every channel.
+
+        This can be called before or after prepare().
+    */
+    void setCoefficients (const Coefficients<SampleType>& newCoefficients);
+
+    /** Sets the coefficients of a single stage on every channel. */
+    void setCoefficients (size_t stage, const Coefficients<SampleType>& newCoefficients);
+
+    /** Sets the coefficients used by one stage of one channel.
+
+        The channel must be lower than the number of channels passed to prepare().
+    */
+    void setCoefficients (size_t stage, size_t channel, const Coefficients<SampleType>& newCoefficients);
+
+    //==============================================================================
+    /** Initialises the filter. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state of all the stages. */
+    void reset() noexcept;
+
+    /** Ensure that the state variables are rounded to zero if they are denormals. */
+    void snapToZero() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numBlockChannels = outputBlock.getNumChannels();
+        const auto numSamples       = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numBlockChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (numBlockChannels <= numChannels);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        const auto maxChunkSize = scratch.size();
+
+        for (size_t firstChannel = 0; firstChannel < numBlockChannels; firstChannel += numLanes)
+        {
+            const auto numGroupChannels = jmin (numLanes, numBlockChannels - firstChannel);
+            auto& group = groups[firstChannel / numLanes];
+
+            for (size_t start = 0; start < numSamples; start += maxChunkSize)
+            {
+                const auto chunkSize = jmin (maxChunkSize, numSamples - start);
+                auto* interleaved = reinterpret_cast<SampleType*> (scratch.data());
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    if (lane < numGroupChannels)
+                    {
+                        const auto* src = inputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                        for (size_t i = 0; i < chunkSize; ++i)
+                            interleaved[i * numLanes + lane] = src[i];
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < chunkSize; ++i)
+                            interleaved[i * numLanes + lane] = SampleType();
+                    }
+                }
+
+                processInterleaved (group, chunkSize);
+
+                for (size_t lane = 0; lane < numGroupChannels; ++lane)
+                {
+                    auto* dst = outputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                    for (size_t i = 0; i < chunkSize; ++i)
+                        dst[i] = interleaved[i * numLanes + lane];
+                }
+            }
+        }
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr size_t numLanes = 1;
+   #endif
+
+    struct Stage
+    {
+        Vector b0, b1, b2, a1, a2;
+        Vector s1, s2;
+    };
+
+    struct StageCoefficients
+    {
+        SampleType b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+    };
+
+    using ChannelGroup = std::vector<Stage>;
+
+    //==============================================================================
+    void processInterleaved (ChannelGroup&, size_t numSamples) noexcept;
+    void updateGroups();
+    static StageCoefficients convert (const Coefficients<SampleType>&);
+
+    //==============================================================================
+    size_t numFilterStages = 1, numChannels = 0;
+    std::vector<StageCoefficients> channelCoefficients; // indexed by [channel * numFilterStages + stage]
+    std::vector<ChannelGroup> groups;
+    std::vector<Vector> scratch;
+    std::vector<StageCoefficients> stageDefaults;
+
+    JUCE_LEAK_DETECTOR (MultichannelFilter)
+};
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+namespace dsp
+{
+
+class IIRMultichannelFilterTest  : public UnitTest
+{
+public:
+    IIRMultichannelFilterTest()
+        : UnitTest ("IIR Multichannel Filter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Multichannel filter matches a set of single channel filters");
+        {
+            testAgainstReference<float>  (1.0e-5);
+            testAgainstReference<double> (1.0e-10);
+        }
+
+        beginTest ("Bypassed multichannel filter passes the input through");
+        {
+            constexpr auto numChannels = 3;
+            constexpr auto numSamples = 64;
+
+            IIR::MultichannelFilter<float> filter;
+            filter.setCoefficients (*IIR::Coefficients<float>::makeLowPass (44100.0, 100.0f));
+            filter.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+
+            AudioBuffer<float> input (numChannels, numSamples), output (numChannels, numSamples);
+            fillRandom (input);
+
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output);
+            ProcessContextNonReplacing<float> context (inputBlock, outputBlock);
+            context.isBypassed = true;
+            filter.process (context);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (output.getSample (channel, i), input.getSample (channel, i));
+        }
+    }
+
+private:
+    template <typename SampleType>
+    static void fillRandom (AudioBuffer<SampleType>& buffer)
+    {
+        Random random (0x1234);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+    }
+
+    template <typename SampleType>
+    void testAgainstReference (double tolerance)
+    {
+        constexpr size_t numChannels = 7, numStages = 3;
+        constexpr int blockSize = 100, numSamples = 1000;
+        constexpr double sampleRate = 48000.0;
+
+        using Coeffs = IIR::Coefficients<SampleType>;
+
+        // Deliberately process blocks larger than the prepared size to exercise chunking
+        IIR::MultichannelFilter<SampleType> filter (numStages);
+        filter.prepare ({ sampleRate, (uint32) blockSize / 2, (uint32) numChannels });
+
+        std::vector<IIR::Filter<SampleType>> reference (numChannels * numStages);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            for (size_t stage = 0; stage < numStages; ++stage)
+            {
+                const auto frequency = (SampleType) (200.0 + 300.0 * (double) channel + 1000.0 * (double) stage);
+                auto coeffs = stage == 1 ? Coeffs::makeFirstOrderHighPass (sampleRate, frequency)
+                                         : Coeffs::makePeakFilter (sampleRate, frequency, (SampleType) 0.7, (SampleType) 2.0);
+
+                filter.setCoefficients (stage, channel, *coeffs);
+
+                auto& ref = reference[channel * numStages + stage];
+                ref.coefficients = coeffs;
+                ref.prepare ({ sampleRate, (uint32) blockSize, 1 });
+            }
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, numSamples), expected ((int) numChannels, numSamples);
+        fillRandom (input);
+        expected.makeCopyOf (input);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto sample = expected.getSample ((int) channel, i);
+
+                for (size_t stage = 0; stage < numStages; ++stage)
+                    sample = reference[channel * numStages + stage].processSample (sample);
+
+                expected.setSample ((int) channel, i, sample);
+            }
+        }
+
+        AudioBlock<SampleType> block (input);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) blockSize);
+            filter.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+
+        for (int channel = 0; channel < (int) numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (input.getSample (channel, i), expected.getSample (channel, i), (SampleType) tolerance);
+    }
+};
+
+static IIRMultichannelFilterTest iirMultichannelFilterTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+MatrixMixer<SampleType>::MatrixMixer() = default;
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::setMatrix (const Matrix<SampleType>& newGains)
+{
+    if (newGains.getNumRows() != targetGains.getNumRows() || newGains.getNumColumns() != targetGains.getNumColumns())
+    {
+        currentGains = targetGains = newGains;
+        gainIncrements = Matrix<SampleType> (newGains.getNumRows(), newGains.getNumColumns());
+        rampSamplesRemaining = 0;
+
+        if (maximumBlockSize > 0)
+            allocateMixBuffer();
+
+        return;
+    }
+
+    std::copy (newGains.begin(), newGains.end(), targetGains.begin());
+
+    if (rampLengthInSamples <= 0)
+    {
+        reset();
+        return;
+    }
+
+    const auto scale = (SampleType) 1 / (SampleType) rampLengthInSamples;
+    auto* current = currentGains.begin();
+    auto* target = targetGains.begin();
+
+    for (auto& increment : gainIncrements)
+        increment = (*target++ - *current++) * scale;
+
+    rampSamplesRemaining = rampLengthInSamples;
+}
+
+template <typename SampleType>
+void MatrixMixer<SampleType>::setRampDurationSeconds (double newDurationSeconds) noexcept
+{
+    jassert (newDurationSeconds >= 0);
+
+    rampDurationSeconds = newDurationSeconds;
+    rampLengthInSamples = (int) std::floor (rampDurationSeconds * sampleRate);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    maximumBlockSize = spec.maximumBlockSize;
+
+    setRampDurationSeconds (rampDurationSeconds);
+    allocateMixBuffer();
+    reset();
+}
+
+template <typename SampleType>
+void MatrixMixer<SampleType>::reset() noexcept
+{
+    std::copy (targetGains.begin(), targetGains.end(), currentGains.begin());
+    rampSamplesRemaining = 0;
+}
+
+template <typename SampleType>
+void MatrixMixer<SampleType>::allocateMixBuffer()
+{
+    mixBuffer = AudioBlock<SampleType> (mixBufferData, targetGains.getNumRows(), maximumBlockSize);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::processSamples (const AudioBlock<const SampleType>& input,
+                                              const AudioBlock<SampleType>& output) noexcept
+{
+    const auto numSamples = output.getNumSamples();
+    const auto numInputs  = jmin (input.getNumChannels(), targetGains.getNumColumns());
+    const auto numOutputs = jmin (output.getNumChannels(), targetGains.getNumRows());
+    const auto numRamped  = (int) jmin ((size_t) rampSamplesRemaining, numSamples);
+
+    // The outputs are built up in a separate buffer first, because the input and
+    // output blocks may share channels
+    jassert (numSamples <= mixBuffer.getNumSamples());
+    auto mix = mixBuffer.getSubsetChannelBlock (0, numOutputs).getSubBlock (0, numSamples);
+    mix.clear();
+
+    for (size_t out = 0; out < numOutputs; ++out)
+    {
+        auto* dest = mix.getChannelPointer (out);
+
+        for (size_t in = 0; in < numInputs; ++in)
+        {
+            const auto* src = input.getChannelPointer (in);
+            auto& gain = currentGains (out, in);
+            const auto increment = gainIncrements (out, in);
+
+            if (numRamped > 0 && increment != 0)
+            {
+                FloatVectorOperations::addWithMultiplyRamp (dest, src, gain + increment, increment, numRamped);
+
+                if (numRamped == rampSamplesRemaining)
+                    gain = targetGains (out, in);
+                else
+                    gain += increment * (SampleType) numRamped;
+
+                if (gain != 0)
+                    FloatVectorOperations::addWithMultiply (dest + numRamped, src + numRamped, gain, (int) numSamples - numRamped);
+            }
+            else if (gain != 0)
+            {
+                FloatVectorOperations::addWithMultiply (dest, src, gain, (int) numSamples);
+            }
+        }
+    }
+
+    if (numRamped > 0)
+    {
+        rampSamplesRemaining -= numRamped;
+
+        if (rampSamplesRemaining == 0)
+            reset();
+    }
+
+    output.getSubsetChannelBlock (0, numOutputs).copyFrom (mix);
+
+    if (output.getNumChannels() > numOutputs)
+        output.getSubsetChannelBlock (numOutputs, output.getNumChannels() - numOutputs).clear();
+}
+
+//==============================================================================
+template class MatrixMixer<float>;
+template class MatrixMixer<double>;
+
+} // namespace dsp
+} // namespace juce
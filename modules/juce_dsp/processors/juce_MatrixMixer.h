@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A processor that mixes a set of input channels into a set of output channels
+    using a matrix of gains, as used for ambisonic decoding, up/down-mixing and
+    routing matrices.
+
+    The gain matrix has one row per output channel and one column per input channel,
+    so output channel o receives the sum of every input channel i multiplied by the
+    gain at (o, i). Output channels without a row in the matrix are cleared.
+
+    When a new matrix of the same size is supplied, each gain moves linearly to its
+    new value over the ramp duration so that changes don't produce clicks. Gains that
+    aren't changing are applied with vectorised operations, and zero gains are skipped
+    entirely, so sparse routing matrices are cheap.
+
+    The input and output blocks may refer to the same channels.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MatrixMixer
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    MatrixMixer();
+
+    //==============================================================================
+    /** Sets the matrix of gains, with one row for each output channel and one column
+        for each input channel.
+
+        If the new matrix is the same size as the current one, the gains will ramp to
+        their new values and this function won't allocate, so it can be called from the
+        audio thread between calls to process(). If the size changes, the new gains are
+        applied immediately and memory may be allocated.
+    */
+    void setMatrix (const Matrix<SampleType>& newGains);
+
+    /** Returns the gains that the processor is currently moving towards. */
+    const Matrix<SampleType>& getMatrix() const noexcept    { return targetGains; }
+
+    /** Sets the length of the ramp that's used when the matrix changes. */
+    void setRampDurationSeconds (double newDurationSeconds) noexcept;
+
+    /** Returns the length of the ramp that's used when the matrix changes. */
+    double getRampDurationSeconds() const noexcept          { return rampDurationSeconds; }
+
+    /** Returns true if the gains are currently moving towards a new matrix. */
+    bool isSmoothing() const noexcept                       { return rampSamplesRemaining > 0; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor, jumping straight to
+        the most recent matrix.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processSamples (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<const SampleType>& input, const AudioBlock<SampleType>& output) noexcept;
+    void allocateMixBuffer();
+
+    //==============================================================================
+    Matrix<SampleType> currentGains { 0, 0 }, targetGains { 0, 0 }, gainIncrements { 0, 0 };
+    HeapBlock<char> mixBufferData;
+    AudioBlock<SampleType> mixBuffer;
+
+    double sampleRate = 44100.0, rampDurationSeconds = 0.05;
+    uint32 maximumBlockSize = 0;
+    int rampLengthInSamples = 0, rampSamplesRemaining = 0;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class MatrixMixerTests  : public UnitTest
+{
+public:
+    MatrixMixerTests()
+        : UnitTest ("MatrixMixer", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Mixes in place using a fixed matrix");
+        {
+            const float gains[] = { 1.0f, 0.5f, 0.0f,
+                                    0.0f, 2.0f, -1.0f };
+
+            MatrixMixer<float> mixer;
+            mixer.setMatrix ({ 2, 3, gains });
+            mixer.prepare ({ 44100.0, (uint32) numSamples, 3 });
+
+            AudioBuffer<float> buffer (3, numSamples);
+            fillInputs (buffer);
+
+            AudioBlock<float> block (buffer);
+            mixer.process (ProcessContextReplacing<float> (block));
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                expectWithinAbsoluteError (buffer.getSample (0, i), input (0, i) + 0.5f * input (1, i), 1.0e-6f);
+                expectWithinAbsoluteError (buffer.getSample (1, i), 2.0f * input (1, i) - input (2, i), 1.0e-6f);
+                expectEquals (buffer.getSample (2, i), 0.0f);
+            }
+        }
+
+        beginTest ("Ramps between matrices");
+        {
+            constexpr int rampLength = 100;
+
+            MatrixMixer<double> mixer;
+            mixer.setMatrix ({ 1, 2 });
+            mixer.setRampDurationSeconds (rampLength / 1000.0);
+            mixer.prepare ({ 1000.0, (uint32) numSamples, 2 });
+
+            const double gains[] = { 1.0, -2.0 };
+            mixer.setMatrix ({ 1, 2, gains });
+            expect (mixer.isSmoothing());
+
+            AudioBuffer<double> in (2, numSamples), out (1, numSamples);
+            fillInputs (in);
+
+            for (int start = 0; start < numSamples; start += 64)
+            {
+                const auto length = jmin (64, numSamples - start);
+
+                AudioBlock<const double> inBlock (in.getArrayOfReadPointers(), 2, (size_t) start, (size_t) length);
+                AudioBlock<double> outBlock (out.getArrayOfWritePointers(), 1, (size_t) start, (size_t) length);
+                mixer.process (ProcessContextNonReplacing<double> (inBlock, outBlock));
+            }
+
+            expect (! mixer.isSmoothing());
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto proportion = jmin (1.0, (i + 1) / (double) rampLength);
+                const auto expected = proportion * (input (0, i) - 2.0 * input (1, i));
+                expectWithinAbsoluteError (out.getSample (0, i), expected, 1.0e-9);
+            }
+        }
+    }
+
+private:
+    static constexpr int numSamples = 300;
+
+    static float input (int channel, int sample)    { return std::sin ((float) (sample + 1) * 0.01f * (float) (channel + 1)); }
+
+    template <typename SampleType>
+    static void fillInputs (AudioBuffer<SampleType>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (SampleType) input (ch, i));
+    }
+};
+
+static MatrixMixerTests matrixMixerTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,321 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+MultibandSplitter<SampleType>::MultibandSplitter (size_t numBandsToUse)
+    : numBands (jmax ((size_t) 1, numBandsToUse)),
+      numCrossovers (numBands - 1),
+      numGroups ((numBands + numLanes - 1) / numLanes),
+      frequencies (numCrossovers),
+      g (numCrossovers),
+      h (numCrossovers)
+{
+    for (size_t i = 0; i < numCrossovers; ++i)
+    {
+        const auto position = numCrossovers > 1 ? (double) i / (double) (numCrossovers - 1) : 0.5;
+        frequencies[i] = (SampleType) (200.0 * std::pow (25.0, position));
+        updateCoefficients (i);
+    }
+
+    updateMixes();
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandSplitter<SampleType>::setCrossoverFrequency (size_t index, SampleType newFrequencyHz)
+{
+    jassert (index < numCrossovers);
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    if (index < numCrossovers)
+    {
+        frequencies[index] = newFrequencyHz;
+        updateCoefficients (index);
+    }
+}
+
+template <typename SampleType>
+SampleType MultibandSplitter<SampleType>::getCrossoverFrequency (size_t index) const noexcept
+{
+    jassert (index < numCrossovers);
+    return frequencies[index];
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandSplitter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = spec.numChannels;
+    maximumBlockSize = jmax ((size_t) 1, (size_t) spec.maximumBlockSize);
+    numSplitSamples = 0;
+
+    for (size_t i = 0; i < numCrossovers; ++i)
+        updateCoefficients (i);
+
+    state.resize (numChannels * numGroups * numCrossovers);
+    scratch.resize (maximumBlockSize * 2);
+    bands.setSize ((int) (numBands * numChannels), (int) maximumBlockSize);
+
+    reset();
+}
+
+template <typename SampleType>
+void MultibandSplitter<SampleType>::reset() noexcept
+{
+    std::fill (state.begin(), state.end(), StageState{});
+}
+
+template <typename SampleType>
+void MultibandSplitter<SampleType>::snapToZero() noexcept
+{
+    for (auto& stage : state)
+        for (auto* value : { &stage.s1, &stage.s2, &stage.s3, &stage.s4 })
+            util::snapToZero (*value);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandSplitter<SampleType>::split (const AudioBlock<const SampleType>& inputBlock) noexcept
+{
+    const auto numSamples = inputBlock.getNumSamples();
+
+    jassert (inputBlock.getNumChannels() == numChannels);
+    jassert (numSamples <= maximumBlockSize);
+
+    numSplitSamples = jmin (numSamples, maximumBlockSize);
+
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        size_t channel = 0;
+
+        for (; channel + 2 <= numChannels; channel += 2)
+            processGroup<2> (inputBlock, group, channel, numSplitSamples);
+
+        if (channel < numChannels)
+            processGroup<1> (inputBlock, group, channel, numSplitSamples);
+    }
+}
+
+template <typename SampleType>
+AudioBlock<SampleType> MultibandSplitter<SampleType>::getBand (size_t band) noexcept
+{
+    jassert (band < numBands);
+
+    return AudioBlock<SampleType> (bands).getSubsetChannelBlock (band * numChannels, numChannels)
+                                         .getSubBlock (0, numSplitSamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+template <size_t NumChannels>
+void MultibandSplitter<SampleType>::processGroup (const AudioBlock<const SampleType>& inputBlock, size_t group,
+                                                 size_t firstChannel, size_t numSamples) noexcept
+{
+    Vector* data[NumChannels];
+
+    for (size_t c = 0; c < NumChannels; ++c)
+    {
+        data[c] = scratch.data() + c * maximumBlockSize;
+        const auto* input = inputBlock.getChannelPointer (firstChannel + c);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            data[c][i] = Vector (input[i]);
+    }
+
+    // Each band runs the same crossovers in its own lane, and only differs in which
+    // outputs of the filters it keeps, so all the lanes share g and h. Running a few
+    // channels side by side hides the latency of the filters' feedback.
+    const auto R2 = Vector (MathConstants<SampleType>::sqrt2);
+
+    for (size_t stage = 0; stage < numCrossovers; ++stage)
+    {
+        const auto mix = mixes[group * numCrossovers + stage];
+        const auto gain = Vector (g[stage]), damping = Vector (g[stage]) + R2, scale = Vector (h[stage]);
+
+        StageState* stageStates[NumChannels];
+        Vector s1[NumChannels], s2[NumChannels], s3[NumChannels], s4[NumChannels];
+
+        for (size_t c = 0; c < NumChannels; ++c)
+        {
+            stageStates[c] = &state[((firstChannel + c) * numGroups + group) * numCrossovers + stage];
+            s1[c] = stageStates[c]->s1;
+            s2[c] = stageStates[c]->s2;
+            s3[c] = stageStates[c]->s3;
+            s4[c] = stageStates[c]->s4;
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t c = 0; c < NumChannels; ++c)
+            {
+                const auto yH = (data[c][i] - damping * s1[c] - s2[c]) * scale;
+                const auto yB = gain * yH + s1[c];
+                s1[c] = gain * yH + yB;
+                const auto yL = gain * yB + s2[c];
+                s2[c] = gain * yB + yL;
+
+                const auto x2 = mix.low1 * yL + mix.band1 * yB + mix.high1 * yH;
+
+                const auto yH2 = (x2 - damping * s3[c] - s4[c]) * scale;
+                const auto yB2 = gain * yH2 + s3[c];
+                s3[c] = gain * yH2 + yB2;
+                const auto yL2 = gain * yB2 + s4[c];
+                s4[c] = gain * yB2 + yL2;
+
+                data[c][i] = mix.direct2 * x2 + mix.low2 * yL2 + mix.high2 * yH2;
+            }
+        }
+
+        for (size_t c = 0; c < NumChannels; ++c)
+            *stageStates[c] = { s1[c], s2[c], s3[c], s4[c] };
+    }
+
+    for (size_t c = 0; c < NumChannels; ++c)
+    {
+        const auto* interleaved = reinterpret_cast<const SampleType*> (data[c]);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto band = group * numLanes + lane;
+
+            if (band >= numBands)
+                break;
+
+            auto* dst = bands.getWritePointer ((int) (band * numChannels + firstChannel + c));
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = interleaved[i * numLanes + lane];
+        }
+    }
+}
+
+template <typename SampleType>
+void MultibandSplitter<SampleType>::processBands() noexcept
+{
+    if (bandProcessor == nullptr)
+        return;
+
+    const auto processBand = [this] (int band)
+    {
+        auto block = getBand ((size_t) band);
+        bandProcessor ((size_t) band, ProcessContextReplacing<SampleType> (block));
+    };
+
+    if (processingPool != nullptr && numBands > 1)
+    {
+        processingPool->parallelFor (0, (int) numBands, processBand, 1);
+    }
+    else
+    {
+        for (int band = 0; band < (int) numBands; ++band)
+            processBand (band);
+    }
+}
+
+template <typename SampleType>
+void MultibandSplitter<SampleType>::sumBands (AudioBlock<SampleType> outputBlock) noexcept
+{
+    outputBlock.copyFrom (getBand (0));
+
+    for (size_t band = 1; band < numBands; ++band)
+        outputBlock.add (getBand (band));
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandSplitter<SampleType>::updateCoefficients (size_t index) noexcept
+{
+    const auto gain = std::tan (MathConstants<double>::pi * (double) frequencies[index] / sampleRate);
+
+    g[index] = (SampleType) gain;
+    h[index] = (SampleType) (1.0 / (1.0 + MathConstants<double>::sqrt2 * gain + gain * gain));
+}
+
+template <typename SampleType>
+void MultibandSplitter<SampleType>::updateMixes()
+{
+    mixes.resize (numGroups * numCrossovers);
+
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        for (size_t stage = 0; stage < numCrossovers; ++stage)
+        {
+            alignas (sizeof (Vector)) SampleType low1[numLanes] {}, band1[numLanes] {}, high1[numLanes] {},
+                                                 direct2[numLanes] {}, low2[numLanes] {}, high2[numLanes] {};
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                const auto band = group * numLanes + lane;
+
+                if (stage < band)
+                {
+                    // a crossover below the band: high-pass
+                    high1[lane] = 1;
+                    high2[lane] = 1;
+                }
+                else if (stage == band)
+                {
+                    // the crossover at the top of the band: low-pass
+                    low1[lane] = 1;
+                    low2[lane] = 1;
+                }
+                else
+                {
+                    // a crossover above the band: all-pass, to keep the bands in phase
+                    low1[lane] = 1;
+                    band1[lane] = -MathConstants<SampleType>::sqrt2;
+                    high1[lane] = 1;
+                    direct2[lane] = 1;
+                }
+            }
+
+            auto& mix = mixes[group * numCrossovers + stage];
+
+           #if JUCE_USE_SIMD
+            mix = { Vector::fromRawArray (low1), Vector::fromRawArray (band1), Vector::fromRawArray (high1),
+                    Vector::fromRawArray (direct2), Vector::fromRawArray (low2), Vector::fromRawArray (high2) };
+           #else
+            mix = { low1[0], band1[0], high1[0], direct2[0], low2[0], high2[0] };
+           #endif
+        }
+    }
+}
+
+//==============================================================================
+template class MultibandSplitter<float>;
+template class MultibandSplitter<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Splits a signal into several frequency bands with a Linkwitz-Riley crossover,
+    and optionally processes each band before summing them back together.
+
+    Each crossover has a -24 dB/octave (LR 4th order) slope, and the bands are
+    phase-compensated with all-pass filters so that they sum back to a signal with a
+    flat magnitude response, just like a chain of LinkwitzRileyFilter objects with
+    all-pass filters on the lower bands.
+
+    Rather than running that chain one filter at a time, each band gets its own lane
+    of a SIMDRegister and the whole set of crossovers is run for all the bands in the
+    same pass, so splitting into as many bands as the register has lanes costs about
+    the same as filtering a single band.
+
+    The bands can be used directly after calling split(), or a function can be given
+    to setBandProcessor() which process() will call on each band before summing them.
+    For heavy per-band processing, e.g. multiband dynamics, the bands can be handed to
+    the threads of a WorkStealingThreadPool with enableParallelProcessing().
+
+    @see LinkwitzRileyFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultibandSplitter
+{
+public:
+    //==============================================================================
+    /** A function which processes one band, given its index and a context for its samples. */
+    using BandProcessor = std::function<void (size_t band, const ProcessContextReplacing<SampleType>& context)>;
+
+    //==============================================================================
+    /** Creates a splitter with the given number of bands.
+
+        The crossover frequencies are initially spaced evenly on a logarithmic scale
+        between 200 Hz and 5 kHz.
+    */
+    explicit MultibandSplitter (size_t numBands = 3);
+
+    //==============================================================================
+    /** Returns the number of bands. */
+    size_t getNumBands() const noexcept                         { return numBands; }
+
+    /** Sets the frequency in Hz of one of the crossovers.
+
+        The crossover at index i separates band i from band i + 1, and the crossover
+        frequencies should be kept in ascending order. This doesn't allocate, so it
+        can be called from the audio thread.
+    */
+    void setCrossoverFrequency (size_t index, SampleType newFrequencyHz);
+
+    /** Returns the frequency in Hz of one of the crossovers. */
+    SampleType getCrossoverFrequency (size_t index) const noexcept;
+
+    //==============================================================================
+    /** Sets a function which process() will call on each band before summing them.
+
+        Calling this while the splitter is processing isn't thread safe.
+    */
+    void setBandProcessor (BandProcessor newBandProcessor)      { bandProcessor = std::move (newBandProcessor); }
+
+    /** Lets process() call the band processor for several bands at once, on the
+        threads of a pool as well as the thread calling process().
+
+        Only use this if the band processor is happy to be called for different bands
+        at the same time on different threads. Note that a WorkStealingThreadPool may
+        allocate memory when work is handed to it, so this will only pay off when the
+        processing of each band is heavy.
+
+        @param pool     the pool to use. This must stay alive until
+                        disableParallelProcessing() is called, or the splitter is deleted
+    */
+    void enableParallelProcessing (WorkStealingThreadPool& pool) noexcept   { processingPool = &pool; }
+
+    /** Goes back to processing all the bands on the thread that calls process(). */
+    void disableParallelProcessing() noexcept                               { processingPool = nullptr; }
+
+    //==============================================================================
+    /** Initialises the splitter. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state of the crossovers. */
+    void reset() noexcept;
+
+    /** Ensure that the state variables are rounded to zero if they are denormals. */
+    void snapToZero() noexcept;
+
+    //==============================================================================
+    /** Splits a block of samples into bands, which can then be used with getBand().
+
+        The block must have the number of channels given to prepare(), and no more
+        samples than the maximum block size.
+    */
+    void split (const AudioBlock<const SampleType>& inputBlock) noexcept;
+
+    /** Returns the samples of one band from the last call to split() or process().
+
+        The block stays valid until the next call to split(), process() or prepare().
+    */
+    AudioBlock<SampleType> getBand (size_t band) noexcept;
+
+    /** Splits the input into bands, calls the band processor on each one, and writes
+        the sum of the bands to the output.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        for (size_t start = 0; start < numSamples; start += maximumBlockSize)
+        {
+            const auto chunkSize = jmin (maximumBlockSize, numSamples - start);
+
+            split (inputBlock.getSubBlock (start, chunkSize));
+            processBands();
+            sumBands (outputBlock.getSubBlock (start, chunkSize));
+        }
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr size_t numLanes = 1;
+   #endif
+
+    /** Selects the outputs of the two filters of a crossover for each band:
+        low-pass, high-pass or all-pass.
+    */
+    struct StageMix
+    {
+        Vector low1, band1, high1, direct2, low2, high2;
+    };
+
+    struct StageState
+    {
+        Vector s1, s2, s3, s4;
+    };
+
+    //==============================================================================
+    template <size_t NumChannels>
+    void processGroup (const AudioBlock<const SampleType>& inputBlock, size_t group,
+                       size_t firstChannel, size_t numSamples) noexcept;
+    void processBands() noexcept;
+    void sumBands (AudioBlock<SampleType> outputBlock) noexcept;
+    void updateCoefficients (size_t index) noexcept;
+    void updateMixes();
+
+    //==============================================================================
+    size_t numBands, numCrossovers, numGroups, numChannels = 0, maximumBlockSize = 0, numSplitSamples = 0;
+    double sampleRate = 44100.0;
+
+    std::vector<SampleType> frequencies, g, h;
+    std::vector<StageMix> mixes;    // indexed by [group * numCrossovers + stage]
+    std::vector<StageState> state;  // indexed by [(channel * numGroups + group) * numCrossovers + stage]
+    std::vector<Vector> scratch;
+    AudioBuffer<SampleType> bands;
+
+    BandProcessor bandProcessor;
+    WorkStealingThreadPool* processingPool = nullptr;
+
+    JUCE_LEAK_DETECTOR (MultibandSplitter)
+};
+
+} // namespace dsp
+} // namespace juce
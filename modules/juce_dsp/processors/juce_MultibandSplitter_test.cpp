@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class MultibandSplitterTests  : public UnitTest
+{
+public:
+    MultibandSplitterTests()
+        : UnitTest ("MultibandSplitter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Bands match a chain of Linkwitz-Riley filters");
+        {
+            checkBandsMatchFilters<float>  (2, { 1000.0f }, 1.0e-5);
+            checkBandsMatchFilters<float>  (4, { 150.0f, 1200.0f, 6000.0f }, 1.0e-5);
+            checkBandsMatchFilters<float>  (6, { 100.0f, 400.0f, 1500.0f, 5000.0f, 12000.0f }, 1.0e-5);
+            checkBandsMatchFilters<double> (3, { 300.0, 3000.0 }, 1.0e-12);
+        }
+
+        beginTest ("Bands sum to an all-pass response");
+        {
+            constexpr int numSamples = 4096;
+            MultibandSplitter<float> splitter (4);
+            splitter.prepare ({ 44100.0, (uint32) numSamples, 1 });
+
+            AudioBuffer<float> buffer (1, numSamples);
+            buffer.clear();
+            buffer.setSample (0, 0, 1.0f);
+
+            AudioBlock<float> block (buffer);
+            splitter.process (ProcessContextReplacing<float> (block));
+
+            dsp::FFT fft (12);
+            std::vector<float> spectrum ((size_t) numSamples * 2);
+            std::copy (buffer.getReadPointer (0), buffer.getReadPointer (0) + numSamples, spectrum.begin());
+            fft.performFrequencyOnlyForwardTransform (spectrum.data());
+
+            for (int i = 1; i < numSamples / 2; ++i)
+                expectWithinAbsoluteError (spectrum[(size_t) i], 1.0f, 1.0e-3f);
+        }
+
+        beginTest ("Bands can be processed in parallel");
+        {
+            constexpr int numSamples = 1000;
+            const ProcessSpec spec { 48000.0, 256, 2 };
+
+            const auto bandProcessor = [] (size_t band, const ProcessContextReplacing<float>& context)
+            {
+                context.getOutputBlock().multiplyBy ((float) (band + 1) * 0.5f);
+            };
+
+            MultibandSplitter<float> serial (5), parallel (5);
+            WorkStealingThreadPool pool (3);
+
+            for (auto* splitter : { &serial, &parallel })
+            {
+                splitter->prepare (spec);
+                splitter->setBandProcessor (bandProcessor);
+            }
+
+            parallel.enableParallelProcessing (pool);
+
+            auto expected = makeNoise ((int) spec.numChannels, numSamples);
+            AudioBuffer<float> output (expected);
+
+            AudioBlock<float> expectedBlock (expected), outputBlock (output);
+            serial.process (ProcessContextReplacing<float> (expectedBlock));
+            parallel.process (ProcessContextReplacing<float> (outputBlock));
+
+            for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+        }
+    }
+
+private:
+    static AudioBuffer<float> makeNoise (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        Random random (0x4321);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    template <typename SampleType>
+    void checkBandsMatchFilters (size_t numBands, std::vector<SampleType> crossovers, double tolerance)
+    {
+        constexpr int numChannels = 2, numSamples = 700, blockSize = 256;
+        const ProcessSpec spec { 44100.0, (uint32) blockSize, (uint32) numChannels };
+
+        MultibandSplitter<SampleType> splitter (numBands);
+        splitter.prepare (spec);
+
+        for (size_t i = 0; i < crossovers.size(); ++i)
+            splitter.setCrossoverFrequency (i, crossovers[i]);
+
+        // The reference chain for each band: high-passes below it, a low-pass above
+        // it, and all-passes for the higher crossovers
+        std::vector<std::vector<LinkwitzRileyFilter<SampleType>>> references (numBands);
+
+        for (size_t band = 0; band < numBands; ++band)
+        {
+            for (size_t i = 0; i < crossovers.size(); ++i)
+            {
+                LinkwitzRileyFilter<SampleType> filter;
+                filter.prepare (spec);
+                filter.setCutoffFrequency (crossovers[i]);
+                filter.setType (i < band ? LinkwitzRileyFilterType::highpass
+                                         : (i == band ? LinkwitzRileyFilterType::lowpass
+                                                      : LinkwitzRileyFilterType::allpass));
+                references[band].push_back (filter);
+            }
+        }
+
+        AudioBuffer<SampleType> input (numChannels, numSamples);
+        Random random (0x1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const auto numBlockSamples = jmin (blockSize, numSamples - start);
+            splitter.split (AudioBlock<const SampleType> (input).getSubBlock ((size_t) start, (size_t) numBlockSamples));
+
+            for (size_t band = 0; band < numBands; ++band)
+            {
+                const auto bandBlock = splitter.getBand (band);
+                expectEquals ((int) bandBlock.getNumSamples(), numBlockSamples);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    for (int i = 0; i < numBlockSamples; ++i)
+                    {
+                        auto expected = input.getSample (channel, start + i);
+
+                        for (auto& filter : references[band])
+                            expected = filter.processSample (channel, expected);
+
+                        expectWithinAbsoluteError ((double) bandBlock.getSample (channel, i), (double) expected, tolerance);
+                    }
+                }
+            }
+        }
+    }
+};
+
+static MultibandSplitterTests multibandSplitterTests;
+
+} // namespace dsp
+} // namespace juce
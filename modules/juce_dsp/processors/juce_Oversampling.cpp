@@ -245,9 +245,11 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
 
     }
 
-private:
+protected:
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
+
+private:
     AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
     Array<size_t> position;
 
@@ -516,8 +518,11 @@ private:
         return coeffs;
     }
 
+protected:
     //==============================================================================
     Array<SampleType> coefficientsUp, coefficientsDown;
+
+private:
     SampleType latency;
 
     AudioBuffer<SampleType> v1Up, v1Down;
@@ -528,6 +533,417 @@ private:
 };
 
 
+#if JUCE_USE_SIMD
+
+//==============================================================================
+/** Helpers for the SIMD oversampling stages, which process several channels at
+    once by giving each channel of a group its own lane in a SIMDRegister.
+*/
+template <typename SampleType>
+struct OversamplingChannelGroups
+{
+    using Vec = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vec::size();
+
+    static size_t getNumGroups (size_t numChannels) noexcept
+    {
+        return (numChannels + numLanes - 1) / numLanes;
+    }
+
+    static size_t getNumChannelsInGroup (size_t numChannels, size_t group) noexcept
+    {
+        return jmin (numLanes, numChannels - group * numLanes);
+    }
+
+    static Vec load (const SampleType* const* channels, size_t numChannelsInGroup, size_t index) noexcept
+    {
+        alignas (sizeof (Vec)) SampleType lanes[numLanes] = {};
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            lanes[lane] = channels[lane][index];
+
+        return Vec::fromRawArray (lanes);
+    }
+
+    static void store (Vec value, SampleType* const* channels, size_t numChannelsInGroup, size_t index) noexcept
+    {
+        alignas (sizeof (Vec)) SampleType lanes[numLanes];
+        value.copyToRawArray (lanes);
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            channels[lane][index] = lanes[lane];
+    }
+
+    static void snapToZero (Vec* values, size_t numValues) noexcept
+    {
+        alignas (sizeof (Vec)) SampleType lanes[numLanes];
+
+        for (size_t i = 0; i < numValues; ++i)
+        {
+            values[i].copyToRawArray (lanes);
+
+            for (auto& lane : lanes)
+                util::snapToZero (lane);
+
+            values[i] = Vec::fromRawArray (lanes);
+        }
+    }
+};
+
+//==============================================================================
+/** A version of Oversampling2TimesEquirippleFIR which filters several channels
+    at once using SIMD registers.
+
+    Only the even taps and the centre tap of a half-band filter are non-zero, so
+    each direction keeps a history of the even-phase samples in a ring buffer that
+    is written twice, which lets the convolution read a contiguous window without
+    ever shifting the filter state.
+*/
+template <typename SampleType>
+struct Oversampling2TimesEquirippleFIRSIMD  : public Oversampling2TimesEquirippleFIR<SampleType>
+{
+    using BaseType   = Oversampling2TimesEquirippleFIR<SampleType>;
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups     = OversamplingChannelGroups<SampleType>;
+    using Vec        = typename Groups::Vec;
+
+    Oversampling2TimesEquirippleFIRSIMD (size_t numChans,
+                                         SampleType normalisedTransitionWidthUp,
+                                         SampleType stopbandAmplitudedBUp,
+                                         SampleType normalisedTransitionWidthDown,
+                                         SampleType stopbandAmplitudedBDown)
+        : BaseType (numChans,
+                    normalisedTransitionWidthUp, stopbandAmplitudedBUp,
+                    normalisedTransitionWidthDown, stopbandAmplitudedBDown),
+          numGroups (Groups::getNumGroups (numChans))
+    {
+        up.initialise (this->coefficientsUp, numGroups);
+        down.initialise (this->coefficientsDown, numGroups);
+
+        const auto Ndiv4 = (this->coefficientsDown.getFilterOrder() + 1) / 4;
+        oddDelayLength = Ndiv4 + 1;
+        oddDelay.resize (numGroups * oddDelayLength);
+        oddDelayPosition.resize (numGroups);
+    }
+
+    //==============================================================================
+    void reset() override
+    {
+        ParentType::reset();
+
+        up.reset();
+        down.reset();
+
+        std::fill (oddDelay.begin(), oddDelay.end(), Vec());
+        std::fill (oddDelayPosition.begin(), oddDelayPosition.end(), (size_t) 0);
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numUsedChannels = inputBlock.getNumChannels();
+        const auto numSamples = inputBlock.getNumSamples();
+        const auto M = up.historySize;
+        const auto two = static_cast<SampleType> (2);
+
+        for (size_t group = 0; group < Groups::getNumGroups (numUsedChannels); ++group)
+        {
+            const auto numInGroup = Groups::getNumChannelsInGroup (numUsedChannels, group);
+            const SampleType* inputs[Groups::numLanes] {};
+            SampleType* outputs[Groups::numLanes] {};
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                inputs[lane]  = inputBlock.getChannelPointer (group * Groups::numLanes + lane);
+                outputs[lane] = ParentType::buffer.getWritePointer (static_cast<int> (group * Groups::numLanes + lane));
+            }
+
+            auto* history = up.getHistory (group);
+            auto writeIndex = up.writeIndex[group];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto* window = up.push (history, writeIndex, Groups::load (inputs, numInGroup, i) * two);
+
+                Groups::store (up.convolve (window), outputs, numInGroup, i << 1);
+                Groups::store (window[M / 2] * up.centreTap, outputs, numInGroup, (i << 1) + 1);
+            }
+
+            up.writeIndex[group] = writeIndex;
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numUsedChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        for (size_t group = 0; group < Groups::getNumGroups (numUsedChannels); ++group)
+        {
+            const auto numInGroup = Groups::getNumChannelsInGroup (numUsedChannels, group);
+            const SampleType* inputs[Groups::numLanes] {};
+            SampleType* outputs[Groups::numLanes] {};
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                inputs[lane]  = ParentType::buffer.getReadPointer (static_cast<int> (group * Groups::numLanes + lane));
+                outputs[lane] = outputBlock.getChannelPointer (group * Groups::numLanes + lane);
+            }
+
+            auto* history = down.getHistory (group);
+            auto writeIndex = down.writeIndex[group];
+            auto* delayed = oddDelay.data() + group * oddDelayLength;
+            auto pos = oddDelayPosition[group];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto* window = down.push (history, writeIndex, Groups::load (inputs, numInGroup, i << 1));
+                auto out = Vec::multiplyAdd (down.convolve (window), delayed[pos], Vec::expand (down.centreTap));
+
+                delayed[pos] = Groups::load (inputs, numInGroup, (i << 1) + 1);
+                pos = (pos == 0 ? oddDelayLength - 1 : pos - 1);
+
+                Groups::store (out, outputs, numInGroup, i);
+            }
+
+            down.writeIndex[group] = writeIndex;
+            oddDelayPosition[group] = pos;
+        }
+    }
+
+private:
+    //==============================================================================
+    struct HalfBandFilter
+    {
+        void initialise (const FIR::Coefficients<SampleType>& coefficients, size_t numGroupsToUse)
+        {
+            const auto N = coefficients.getFilterOrder() + 1;
+
+            // The stage relies on the half-band structure having an odd centre tap index
+            jassert (N % 4 == 3);
+
+            historySize = (N + 1) / 2;
+
+            const auto* fir = coefficients.getRawCoefficients();
+
+            outerTaps.clear();
+
+            for (size_t k = 0; k < N / 2; k += 2)
+                outerTaps.push_back (Vec::expand (fir[k]));
+
+            centreTap = fir[N / 2];
+
+            history.resize (numGroupsToUse * historySize * 2);
+            writeIndex.resize (numGroupsToUse);
+        }
+
+        void reset()
+        {
+            std::fill (history.begin(), history.end(), Vec());
+            std::fill (writeIndex.begin(), writeIndex.end(), (size_t) 0);
+        }
+
+        Vec* getHistory (size_t group) noexcept
+        {
+            return history.data() + group * historySize * 2;
+        }
+
+        // Returns the window of the last historySize samples, oldest first
+        const Vec* push (Vec* data, size_t& index, Vec value) const noexcept
+        {
+            data[index] = value;
+            data[index + historySize] = value;
+
+            const auto* window = data + index + 1;
+            index = (index + 1 == historySize ? 0 : index + 1);
+            return window;
+        }
+
+        Vec convolve (const Vec* window) const noexcept
+        {
+            Vec out {};
+            const auto* last = window + historySize - 1;
+
+            for (size_t j = 0; j < outerTaps.size(); ++j)
+                out = Vec::multiplyAdd (out, window[j] + last[-(ptrdiff_t) j], outerTaps[j]);
+
+            return out;
+        }
+
+        std::vector<Vec> outerTaps, history;
+        std::vector<size_t> writeIndex;
+        SampleType centreTap = 0;
+        size_t historySize = 0;
+    };
+
+    size_t numGroups;
+    HalfBandFilter up, down;
+    std::vector<Vec> oddDelay;
+    std::vector<size_t> oddDelayPosition;
+    size_t oddDelayLength = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIRSIMD)
+};
+
+//==============================================================================
+/** A version of Oversampling2TimesPolyphaseIIR which filters several channels
+    at once using SIMD registers.
+*/
+template <typename SampleType>
+struct Oversampling2TimesPolyphaseIIRSIMD  : public Oversampling2TimesPolyphaseIIR<SampleType>
+{
+    using BaseType   = Oversampling2TimesPolyphaseIIR<SampleType>;
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups     = OversamplingChannelGroups<SampleType>;
+    using Vec        = typename Groups::Vec;
+
+    Oversampling2TimesPolyphaseIIRSIMD (size_t numChans,
+                                        SampleType normalisedTransitionWidthUp,
+                                        SampleType stopbandAmplitudedBUp,
+                                        SampleType normalisedTransitionWidthDown,
+                                        SampleType stopbandAmplitudedBDown)
+        : BaseType (numChans,
+                    normalisedTransitionWidthUp, stopbandAmplitudedBUp,
+                    normalisedTransitionWidthDown, stopbandAmplitudedBDown),
+          numGroups (Groups::getNumGroups (numChans))
+    {
+        for (auto c : this->coefficientsUp)
+            alphasUp.push_back (Vec::expand (c));
+
+        for (auto c : this->coefficientsDown)
+            alphasDown.push_back (Vec::expand (c));
+
+        statesUp.resize (numGroups * alphasUp.size());
+        statesDown.resize (numGroups * alphasDown.size());
+        delayDown.resize (numGroups);
+    }
+
+    //==============================================================================
+    void reset() override
+    {
+        ParentType::reset();
+
+        std::fill (statesUp.begin(), statesUp.end(), Vec());
+        std::fill (statesDown.begin(), statesDown.end(), Vec());
+        std::fill (delayDown.begin(), delayDown.end(), Vec());
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numUsedChannels = inputBlock.getNumChannels();
+        const auto numSamples = inputBlock.getNumSamples();
+        const auto numStages = alphasUp.size();
+        const auto directStages = numStages - numStages / 2;
+
+        for (size_t group = 0; group < Groups::getNumGroups (numUsedChannels); ++group)
+        {
+            const auto numInGroup = Groups::getNumChannelsInGroup (numUsedChannels, group);
+            const SampleType* inputs[Groups::numLanes] {};
+            SampleType* outputs[Groups::numLanes] {};
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                inputs[lane]  = inputBlock.getChannelPointer (group * Groups::numLanes + lane);
+                outputs[lane] = ParentType::buffer.getWritePointer (static_cast<int> (group * Groups::numLanes + lane));
+            }
+
+            auto* states = statesUp.data() + group * numStages;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto input = Groups::load (inputs, numInGroup, i);
+
+                Groups::store (processAllpasses (input, alphasUp.data(), states, 0, directStages),
+                               outputs, numInGroup, i << 1);
+
+                Groups::store (processAllpasses (input, alphasUp.data(), states, directStages, numStages),
+                               outputs, numInGroup, (i << 1) + 1);
+            }
+
+           #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            Groups::snapToZero (states, numStages);
+           #endif
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numUsedChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto numStages = alphasDown.size();
+        const auto directStages = numStages - numStages / 2;
+        const auto half = Vec::expand (static_cast<SampleType> (0.5));
+
+        for (size_t group = 0; group < Groups::getNumGroups (numUsedChannels); ++group)
+        {
+            const auto numInGroup = Groups::getNumChannelsInGroup (numUsedChannels, group);
+            const SampleType* inputs[Groups::numLanes] {};
+            SampleType* outputs[Groups::numLanes] {};
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                inputs[lane]  = ParentType::buffer.getReadPointer (static_cast<int> (group * Groups::numLanes + lane));
+                outputs[lane] = outputBlock.getChannelPointer (group * Groups::numLanes + lane);
+            }
+
+            auto* states = statesDown.data() + group * numStages;
+            auto delay = delayDown[group];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto directOut = processAllpasses (Groups::load (inputs, numInGroup, i << 1),
+                                                         alphasDown.data(), states, 0, directStages);
+
+                const auto delayedOut = processAllpasses (Groups::load (inputs, numInGroup, (i << 1) + 1),
+                                                          alphasDown.data(), states, directStages, numStages);
+
+                Groups::store ((delay + directOut) * half, outputs, numInGroup, i);
+                delay = delayedOut;
+            }
+
+            delayDown[group] = delay;
+
+           #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            Groups::snapToZero (states, numStages);
+           #endif
+        }
+    }
+
+private:
+    //==============================================================================
+    static Vec processAllpasses (Vec input, const Vec* alphas, Vec* states, size_t firstStage, size_t endStage) noexcept
+    {
+        for (auto n = firstStage; n < endStage; ++n)
+        {
+            const auto output = Vec::multiplyAdd (states[n], alphas[n], input);
+            states[n] = input - alphas[n] * output;
+            input = output;
+        }
+
+        return input;
+    }
+
+    size_t numGroups;
+    std::vector<Vec> alphasUp, alphasDown, statesUp, statesDown, delayDown;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIRSIMD)
+};
+
+#endif
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -606,6 +1022,20 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                      float normalisedTransitionWidthDown,
                                                      float stopbandAmplitudedBDown)
 {
+   #if JUCE_USE_SIMD
+    if (type == FilterType::filterHalfBandPolyphaseIIR)
+    {
+        stages.add (new Oversampling2TimesPolyphaseIIRSIMD<SampleType> (numChannels,
+                                                                        normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                        normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+    }
+    else
+    {
+        stages.add (new Oversampling2TimesEquirippleFIRSIMD<SampleType> (numChannels,
+                                                                         normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                         normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+    }
+   #else
     if (type == FilterType::filterHalfBandPolyphaseIIR)
     {
         stages.add (new Oversampling2TimesPolyphaseIIR<SampleType> (numChannels,
@@ -618,6 +1048,7 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                      normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                      normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
+   #endif
 
     factorOversampling *= 2;
 }
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class OversamplingSIMDTest  : public UnitTest
+{
+public:
+    OversamplingSIMDTest()
+        : UnitTest ("Oversampling SIMD stages", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("SIMD FIR stage matches the scalar FIR stage");
+        {
+            testStages<float,  Oversampling2TimesEquirippleFIR, Oversampling2TimesEquirippleFIRSIMD> (1.0e-5);
+            testStages<double, Oversampling2TimesEquirippleFIR, Oversampling2TimesEquirippleFIRSIMD> (1.0e-12);
+        }
+
+        beginTest ("SIMD IIR stage matches the scalar IIR stage");
+        {
+            testStages<float,  Oversampling2TimesPolyphaseIIR, Oversampling2TimesPolyphaseIIRSIMD> (1.0e-5);
+            testStages<double, Oversampling2TimesPolyphaseIIR, Oversampling2TimesPolyphaseIIRSIMD> (1.0e-12);
+        }
+
+        beginTest ("Multi-stage oversampling round trip is delayed but preserved");
+        {
+            for (auto type : { Oversampling<float>::filterHalfBandFIREquiripple,
+                               Oversampling<float>::filterHalfBandPolyphaseIIR })
+            {
+                constexpr size_t numChannels = 3, blockSize = 64;
+
+                Oversampling<float> oversampling (numChannels, 3, type, true, true);
+                oversampling.initProcessing (blockSize);
+
+                const auto latency = (int) oversampling.getLatencyInSamples();
+
+                AudioBuffer<float> buffer ((int) numChannels, (int) blockSize);
+                float lastSamples[numChannels] {};
+
+                // A DC input should settle to DC at the output of the round trip
+                for (int block = 0; block < 32; ++block)
+                {
+                    for (int channel = 0; channel < (int) numChannels; ++channel)
+                        FloatVectorOperations::fill (buffer.getWritePointer (channel), 0.25f * (float) (channel + 1), (int) blockSize);
+
+                    AudioBlock<float> audioBlock (buffer);
+                    oversampling.processSamplesUp (audioBlock);
+                    oversampling.processSamplesDown (audioBlock);
+
+                    for (size_t channel = 0; channel < numChannels; ++channel)
+                        lastSamples[channel] = buffer.getSample ((int) channel, (int) blockSize - 1);
+                }
+
+                expect (latency > 0);
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    expectWithinAbsoluteError (lastSamples[channel], 0.25f * (float) (channel + 1), 1.0e-2f);
+            }
+        }
+    }
+
+private:
+    template <typename SampleType>
+    static void fillRandom (AudioBuffer<SampleType>& buffer, Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+    }
+
+    template <typename SampleType>
+    void expectBuffersMatch (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b,
+                             int numChannels, int numSamples, double tolerance)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (a.getSample (channel, i), b.getSample (channel, i), (SampleType) tolerance);
+    }
+
+    template <typename SampleType, template <typename> class ScalarStage, template <typename> class SIMDStage>
+    void testStages (double tolerance)
+    {
+        constexpr int blockSize = 96, numBlocks = 8;
+        Random random (0x5678);
+
+        for (auto numChannels : { 1, 2, 3, 5, 8 })
+        {
+            const auto twUp = (SampleType) 0.05, gainUp = (SampleType) -90.0;
+            const auto twDown = (SampleType) 0.06, gainDown = (SampleType) -75.0;
+
+            ScalarStage<SampleType> scalar ((size_t) numChannels, twUp, gainUp, twDown, gainDown);
+            SIMDStage<SampleType> simd ((size_t) numChannels, twUp, gainUp, twDown, gainDown);
+
+            scalar.initProcessing (blockSize);
+            simd.initProcessing (blockSize);
+            scalar.reset();
+            simd.reset();
+
+            AudioBuffer<SampleType> input (numChannels, blockSize), output (numChannels, blockSize);
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                // Vary the block length to check that the state carries across calls
+                const auto numSamples = blockSize - (block % 3) * 17;
+
+                fillRandom (input, random);
+                AudioBlock<const SampleType> inputBlock (input.getArrayOfReadPointers(), (size_t) numChannels, (size_t) numSamples);
+
+                scalar.processSamplesUp (inputBlock);
+                simd.processSamplesUp (inputBlock);
+
+                expectBuffersMatch (scalar.buffer, simd.buffer, numChannels, numSamples * 2, tolerance);
+
+                fillRandom (scalar.buffer, random);
+                simd.buffer.makeCopyOf (scalar.buffer);
+
+                AudioBlock<SampleType> scalarOut (input.getArrayOfWritePointers(), (size_t) numChannels, (size_t) numSamples);
+                AudioBlock<SampleType> simdOut (output.getArrayOfWritePointers(), (size_t) numChannels, (size_t) numSamples);
+
+                scalar.processSamplesDown (scalarOut);
+                simd.processSamplesDown (simdOut);
+
+                expectBuffersMatch (input, output, numChannels, numSamples, tolerance);
+            }
+        }
+    }
+};
+
+static OversamplingSIMDTest oversamplingSIMDTest;
+
+} // namespace dsp
+} // namespace juce
@@ -52,6 +52,35 @@ namespace detail
 
     template <typename Context, size_t Ix>
     inline constexpr auto useContextDirectly = ! Context::usesSeparateInputAndOutputBlocks() || Ix == 0;
+
+    template <typename Proc, typename SampleType, typename = void>
+    inline constexpr auto hasChannelProcessSample = false;
+
+    template <typename Proc, typename SampleType>
+    inline constexpr auto hasChannelProcessSample<Proc, SampleType, std::enable_if_t<std::is_convertible_v<decltype (std::declval<Proc&>().processSample (0, std::declval<SampleType>())), SampleType>>> = true;
+
+    template <typename Proc, typename SampleType, typename = void>
+    inline constexpr auto hasMonoProcessSample = false;
+
+    template <typename Proc, typename SampleType>
+    inline constexpr auto hasMonoProcessSample<Proc, SampleType, std::enable_if_t<std::is_convertible_v<decltype (std::declval<Proc&>().processSample (std::declval<SampleType>())), SampleType>>> = true;
+
+    template <typename SampleType, typename... Processors>
+    inline constexpr auto canProcessEachSample = ((hasChannelProcessSample<Processors, SampleType> || hasMonoProcessSample<Processors, SampleType>) && ...);
+
+    template <typename Proc, typename SampleType>
+    SampleType processSampleWith (Proc& proc, int channel, SampleType sample) noexcept
+    {
+        if constexpr (hasChannelProcessSample<Proc, SampleType>)
+        {
+            return proc.processSample (channel, sample);
+        }
+        else
+        {
+            ignoreUnused (channel);
+            return proc.processSample (sample);
+        }
+    }
 }
 #endif
 
@@ -98,7 +127,137 @@ public:
                                 processors);
     }
 
+    /** Passes a single sample through all of the inner processors that aren't bypassed.
+
+        This is only available when every processor has a processSample function, taking
+        either a channel and a sample, or just a sample. Processors that take only a sample
+        are called for every channel, so they shouldn't hold state that moves on with each
+        sample (like a Gain that is still ramping) unless there's only one channel.
+    */
+    template <typename SampleType, std::enable_if_t<detail::canProcessEachSample<SampleType, Processors...>, int> = 0>
+    SampleType processSample (int channel, SampleType sample) noexcept
+    {
+        detail::forEachInTuple ([this, channel, &sample] (auto& proc, auto index) noexcept
+                                {
+                                    if (! bypassed[index])
+                                        sample = detail::processSampleWith (proc, channel, sample);
+                                },
+                                processors);
+
+        return sample;
+    }
+
+    /** Processes `context` one sample at a time, passing each sample through the whole
+        chain before moving on to the next.
+
+        This gives the same result as process() for processors whose process() just calls
+        processSample(), but only makes one pass over the block rather than one for each
+        processor, keeping each sample in a register until it comes out of the end of the
+        chain. See processSample() for which processors can be used.
+
+        If the processors work on SIMDRegisters of the context's sample type instead, for
+        example IIR::Filter<SIMDRegister<float>>, the channels are loaded into the lanes of
+        registers a short tile at a time, so that each call to processSample() handles
+        SIMDRegister::size() channels at once. The group of channels in a register is passed
+        as the channel index, so in this case the chain should be prepared with one channel
+        for each group, and processors with state should take a channel index (wrapping them
+        in a ProcessorDuplicator if needed) when there are more channels than lanes.
+    */
+    template <typename ProcessContext>
+    void processSampleBySample (const ProcessContext& context) noexcept
+    {
+        using SampleType = typename ProcessContext::SampleType;
+
+        const auto& inputBlock = context.getInputBlock();
+        auto outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        if constexpr (detail::canProcessEachSample<SampleType, Processors...>)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* input  = inputBlock.getChannelPointer (channel);
+                auto* output = outputBlock.getChannelPointer (channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    output[i] = processSample ((int) channel, input[i]);
+            }
+        }
+        else
+        {
+            static_assert (std::is_floating_point_v<SampleType>,
+                           "Every processor in the chain needs a processSample function for this sample type");
+
+            processLanes<SIMDRegister<SampleType>> (inputBlock, outputBlock);
+        }
+    }
+
 private:
+    template <typename Register, typename SampleType>
+    void processLanes (const AudioBlock<const SampleType>& inputBlock, const AudioBlock<SampleType>& outputBlock) noexcept
+    {
+        static_assert (detail::canProcessEachSample<Register, Processors...>,
+                       "Every processor in the chain needs a processSample function for this sample type or its SIMDRegister");
+
+        constexpr auto numLanes = Register::size();
+        constexpr size_t tileSize = 64;
+
+        alignas (Register::SIMDRegisterSize) SampleType tile[tileSize * numLanes];
+
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        for (size_t firstChannel = 0; firstChannel < numChannels; firstChannel += numLanes)
+        {
+            const auto group = (int) (firstChannel / numLanes);
+            const auto numUsed = jmin (numLanes, numChannels - firstChannel);
+
+            for (size_t start = 0; start < numSamples; start += tileSize)
+            {
+                const auto num = jmin (tileSize, numSamples - start);
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    if (lane < numUsed)
+                    {
+                        auto* input = inputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                        for (size_t i = 0; i < num; ++i)
+                            tile[i * numLanes + lane] = input[i];
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < num; ++i)
+                            tile[i * numLanes + lane] = SampleType();
+                    }
+                }
+
+                for (size_t i = 0; i < num; ++i)
+                    processSample (group, Register::fromRawArray (tile + i * numLanes)).copyToRawArray (tile + i * numLanes);
+
+                for (size_t lane = 0; lane < numUsed; ++lane)
+                {
+                    auto* output = outputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        output[i] = tile[i * numLanes + lane];
+                }
+            }
+        }
+    }
+
     template <typename Context, typename Proc, size_t Ix>
     void processOne (const Context& context, Proc& proc, std::integral_constant<size_t, Ix>) noexcept
     {
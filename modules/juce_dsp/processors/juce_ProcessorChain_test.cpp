@@ -30,6 +30,25 @@ namespace dsp
 
 class ProcessorChainTest : public UnitTest
 {
+    static AudioBuffer<float> makeNoise (const ProcessSpec& spec)
+    {
+        AudioBuffer<float> buffer ((int) spec.numChannels, (int) spec.maximumBlockSize);
+        Random random (0x1234);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    void expectBuffersMatch (const AudioBuffer<float>& actual, const AudioBuffer<float>& expected)
+    {
+        for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                expectWithinAbsoluteError (actual.getSample (channel, i), expected.getSample (channel, i), 1.0e-6f);
+    }
+
     template <int AddValue>
     struct MockProcessor
     {
@@ -158,6 +177,67 @@ public:
                 expectEquals (outBuf.getSample (0, 0), 4.0f);
             }
         }
+
+        beginTest ("Processing sample by sample matches processing block by block");
+        {
+            using Chain = ProcessorChain<Gain<float>,
+                                         Bias<float>,
+                                         WaveShaper<float>,
+                                         FirstOrderTPTFilter<float>,
+                                         ProcessorDuplicator<IIR::Filter<float>, IIR::Coefficients<float>>>;
+
+            const ProcessSpec spec { 44100.0, 300, 3 };
+            Chain blockChain, sampleChain;
+
+            for (auto* chain : { &blockChain, &sampleChain })
+            {
+                get<0> (*chain).setGainLinear (0.5f);
+                get<1> (*chain).setBias (0.1f);
+                get<2> (*chain).functionToUse = [] (float x) { return std::tanh (x); };
+                get<3> (*chain).setCutoffFrequency (2000.0f);
+                *get<4> (*chain).state = *IIR::Coefficients<float>::makeHighPass (spec.sampleRate, 100.0f);
+                chain->prepare (spec);
+            }
+
+            const auto input = makeNoise (spec);
+            AudioBuffer<float> expected (input), output ((int) spec.numChannels, (int) spec.maximumBlockSize);
+
+            for (auto bypassed : { false, true })
+            {
+                setBypassed<3> (blockChain, bypassed);
+                setBypassed<3> (sampleChain, bypassed);
+
+                AudioBlock<float> expectedBlock (expected), outputBlock (output);
+                expectedBlock.copyFrom (input);
+
+                blockChain.process (ProcessContextReplacing<float> (expectedBlock));
+                sampleChain.processSampleBySample (ProcessContextNonReplacing<float> (AudioBlock<const float> (input), outputBlock));
+
+                expectBuffersMatch (output, expected);
+            }
+        }
+
+        beginTest ("Channels are processed in the lanes of SIMDRegisters");
+        {
+            const ProcessSpec spec { 44100.0, 200, 5 };
+            const auto coefficients = IIR::Coefficients<float>::makeLowPass (spec.sampleRate, 1000.0f);
+
+            ProcessorDuplicator<IIR::Filter<float>, IIR::Coefficients<float>> duplicator (coefficients);
+            ProcessorChain<ProcessorDuplicator<IIR::Filter<SIMDRegister<float>>, IIR::Coefficients<float>>> chain;
+            get<0> (chain).state = coefficients;
+
+            duplicator.prepare (spec);
+            chain.prepare ({ spec.sampleRate, spec.maximumBlockSize,
+                             (uint32) ((spec.numChannels + SIMDRegister<float>::size() - 1) / SIMDRegister<float>::size()) });
+
+            AudioBuffer<float> expected (makeNoise (spec)), output (expected);
+            AudioBlock<float> expectedBlock (expected), outputBlock (output);
+
+            duplicator.process (ProcessContextReplacing<float> (expectedBlock));
+            chain.processSampleBySample (ProcessContextReplacing<float> (outputBlock));
+
+            expectBuffersMatch (output, expected);
+        }
     }
 };
 
@@ -76,6 +76,17 @@ struct ProcessorDuplicator
             processors[(int) chan]->process (MonoProcessContext<ProcessContext> (context, chan));
     }
 
+    /** Processes a single sample with the instance for the given channel.
+
+        This is only available when the mono processor has a processSample function.
+    */
+    template <typename SampleType>
+    auto processSample (int channel, SampleType sample) noexcept -> decltype (std::declval<MonoProcessorType&>().processSample (sample))
+    {
+        jassert (isPositiveAndBelow (channel, processors.size()));
+        return processors.getUnchecked (channel)->processSample (sample);
+    }
+
     typename StateType::Ptr state;
 
 private:
@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+std::array<double, 3> SphericalDirection::toUnitVector() const noexcept
+{
+    return { std::cos (elevation) * std::cos (azimuth),
+             std::cos (elevation) * std::sin (azimuth),
+             std::sin (elevation) };
+}
+
+std::optional<SphericalDirection> SphericalDirection::fromChannelType (AudioChannelSet::ChannelType type) noexcept
+{
+    const auto degrees = [] (double azimuth, double elevation)
+    {
+        return SphericalDirection { degreesToRadians (azimuth), degreesToRadians (elevation) };
+    };
+
+    switch (type)
+    {
+        case AudioChannelSet::left:                 return degrees (30.0, 0.0);
+        case AudioChannelSet::right:                return degrees (-30.0, 0.0);
+        case AudioChannelSet::centre:               return degrees (0.0, 0.0);
+        case AudioChannelSet::leftCentre:           return degrees (15.0, 0.0);
+        case AudioChannelSet::rightCentre:          return degrees (-15.0, 0.0);
+        case AudioChannelSet::wideLeft:             return degrees (60.0, 0.0);
+        case AudioChannelSet::wideRight:            return degrees (-60.0, 0.0);
+        case AudioChannelSet::leftSurroundSide:     return degrees (90.0, 0.0);
+        case AudioChannelSet::rightSurroundSide:    return degrees (-90.0, 0.0);
+        case AudioChannelSet::leftSurround:         return degrees (110.0, 0.0);
+        case AudioChannelSet::rightSurround:        return degrees (-110.0, 0.0);
+        case AudioChannelSet::leftSurroundRear:     return degrees (150.0, 0.0);
+        case AudioChannelSet::rightSurroundRear:    return degrees (-150.0, 0.0);
+        case AudioChannelSet::centreSurround:       return degrees (180.0, 0.0);
+        case AudioChannelSet::topMiddle:            return degrees (0.0, 90.0);
+        case AudioChannelSet::topFrontLeft:         return degrees (45.0, 45.0);
+        case AudioChannelSet::topFrontCentre:       return degrees (0.0, 45.0);
+        case AudioChannelSet::topFrontRight:        return degrees (-45.0, 45.0);
+        case AudioChannelSet::topSideLeft:          return degrees (90.0, 45.0);
+        case AudioChannelSet::topSideRight:         return degrees (-90.0, 45.0);
+        case AudioChannelSet::topRearLeft:          return degrees (135.0, 45.0);
+        case AudioChannelSet::topRearCentre:        return degrees (180.0, 45.0);
+        case AudioChannelSet::topRearRight:         return degrees (-135.0, 45.0);
+        case AudioChannelSet::bottomFrontLeft:      return degrees (45.0, -30.0);
+        case AudioChannelSet::bottomFrontCentre:    return degrees (0.0, -30.0);
+        case AudioChannelSet::bottomFrontRight:     return degrees (-45.0, -30.0);
+        case AudioChannelSet::bottomSideLeft:       return degrees (90.0, -30.0);
+        case AudioChannelSet::bottomSideRight:      return degrees (-90.0, -30.0);
+        case AudioChannelSet::bottomRearLeft:       return degrees (135.0, -30.0);
+        case AudioChannelSet::bottomRearCentre:     return degrees (180.0, -30.0);
+        case AudioChannelSet::bottomRearRight:      return degrees (-135.0, -30.0);
+        default:                                    break;
+    }
+
+    return {};
+}
+
+std::vector<std::optional<SphericalDirection>> SphericalDirection::fromChannelSet (const AudioChannelSet& layout)
+{
+    std::vector<std::optional<SphericalDirection>> result;
+
+    for (auto type : layout.getChannelTypes())
+        result.push_back (fromChannelType (type));
+
+    return result;
+}
+
+//==============================================================================
+namespace SpatialPanningHelpers
+{
+    using Vector = std::array<double, 3>;
+
+    static double dot (const Vector& a, const Vector& b) noexcept
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    static Vector cross (const Vector& a, const Vector& b) noexcept
+    {
+        return { a[1] * b[2] - a[2] * b[1],
+                 a[2] * b[0] - a[0] * b[2],
+                 a[0] * b[1] - a[1] * b[0] };
+    }
+
+    static double angleBetween (const Vector& a, const Vector& b) noexcept
+    {
+        return std::acos (jlimit (-1.0, 1.0, dot (a, b)));
+    }
+
+    static Vector multiply (const std::array<double, 9>& m, const Vector& v) noexcept
+    {
+        return { m[0] * v[0] + m[1] * v[1] + m[2] * v[2],
+                 m[3] * v[0] + m[4] * v[1] + m[5] * v[2],
+                 m[6] * v[0] + m[7] * v[1] + m[8] * v[2] };
+    }
+
+    static void normalisePower (double* gains, size_t numGains) noexcept
+    {
+        double sumOfSquares = 0.0;
+
+        for (size_t i = 0; i < numGains; ++i)
+            sumOfSquares += gains[i] * gains[i];
+
+        if (sumOfSquares > 0.0)
+            FloatVectorOperations::multiply (gains, 1.0 / std::sqrt (sumOfSquares), (int) numGains);
+    }
+
+    static constexpr double tolerance = 1.0e-6;
+}
+
+VectorBasePanning::VectorBasePanning (const std::vector<std::optional<SphericalDirection>>& speakerDirections)
+    : numSpeakers (speakerDirections.size())
+{
+    std::vector<std::pair<size_t, std::array<double, 3>>> speakers;
+
+    for (size_t i = 0; i < speakerDirections.size(); ++i)
+        if (speakerDirections[i].has_value())
+            speakers.emplace_back (i, speakerDirections[i]->toUnitVector());
+
+    if (speakers.size() == 1)
+        onlySpeaker = speakers.front().first;
+
+    addTriangles (speakers);
+
+    if (groups.empty())
+        addPairs (speakers);
+}
+
+void VectorBasePanning::addTriangles (const std::vector<std::pair<size_t, std::array<double, 3>>>& speakers)
+{
+    using namespace SpatialPanningHelpers;
+
+    std::vector<std::pair<double, Group>> candidates;
+
+    for (size_t i = 0; i < speakers.size(); ++i)
+    {
+        for (size_t j = i + 1; j < speakers.size(); ++j)
+        {
+            for (size_t k = j + 1; k < speakers.size(); ++k)
+            {
+                const auto& a = speakers[i].second;
+                const auto& b = speakers[j].second;
+                const auto& c = speakers[k].second;
+
+                // Loudspeakers on a plane through the listener can't form a triangle
+                const auto determinant = dot (a, cross (b, c));
+
+                if (std::abs (determinant) < 1.0e-3)
+                    continue;
+
+                // The rows of the inverse are the cross products of the other two columns
+                const auto bc = cross (b, c), ca = cross (c, a), ab = cross (a, b);
+                Group group { { speakers[i].first, speakers[j].first, speakers[k].first }, 3,
+                              { bc[0], bc[1], bc[2], ca[0], ca[1], ca[2], ab[0], ab[1], ab[2] } };
+
+                for (auto& x : group.inverse)
+                    x /= determinant;
+
+                // A triangle with another loudspeaker inside it would skip over that loudspeaker
+                const auto containsOtherSpeaker = std::any_of (speakers.begin(), speakers.end(), [&] (const auto& other)
+                {
+                    if (other.first == group.speakers[0] || other.first == group.speakers[1] || other.first == group.speakers[2])
+                        return false;
+
+                    const auto g = multiply (group.inverse, other.second);
+                    return g[0] > -tolerance && g[1] > -tolerance && g[2] > -tolerance;
+                });
+
+                if (! containsOtherSpeaker)
+                    candidates.emplace_back (angleBetween (a, b) + angleBetween (b, c) + angleBetween (c, a), group);
+            }
+        }
+    }
+
+    std::stable_sort (candidates.begin(), candidates.end(), [] (const auto& x, const auto& y) { return x.first < y.first; });
+
+    for (auto& candidate : candidates)
+        groups.push_back (candidate.second);
+}
+
+void VectorBasePanning::addPairs (const std::vector<std::pair<size_t, std::array<double, 3>>>& speakers)
+{
+    std::vector<std::pair<double, size_t>> byAzimuth;
+
+    for (auto& [index, position] : speakers)
+        byAzimuth.emplace_back (std::atan2 (position[1], position[0]), index);
+
+    std::sort (byAzimuth.begin(), byAzimuth.end());
+
+    if (byAzimuth.size() < 2)
+        return;
+
+    for (size_t i = 0; i < byAzimuth.size(); ++i)
+    {
+        const auto& [azimuthA, a] = byAzimuth[i];
+        const auto& [azimuthB, b] = byAzimuth[(i + 1) % byAzimuth.size()];
+
+        const auto ax = std::cos (azimuthA), ay = std::sin (azimuthA);
+        const auto bx = std::cos (azimuthB), by = std::sin (azimuthB);
+        const auto determinant = ax * by - ay * bx;
+
+        // Pairs that are opposite each other or more than half a circle apart can't be
+        // used, because the directions between them don't lie between the loudspeakers
+        if (determinant < 1.0e-3)
+            continue;
+
+        groups.push_back ({ { a, b, 0 }, 2, { by / determinant, -bx / determinant, 0.0,
+                                              -ay / determinant, ax / determinant, 0.0,
+                                              0.0, 0.0, 0.0 } });
+    }
+}
+
+void VectorBasePanning::computeGains (SphericalDirection direction, double* gains) const noexcept
+{
+    using namespace SpatialPanningHelpers;
+
+    std::fill (gains, gains + numSpeakers, 0.0);
+
+    if (onlySpeaker.has_value())
+    {
+        gains[*onlySpeaker] = 1.0;
+        return;
+    }
+
+    if (groups.empty())
+        return;
+
+    auto target = direction.toUnitVector();
+
+    if (groups.front().size == 2)
+        target = SphericalDirection { direction.azimuth, 0.0 }.toUnitVector();
+
+    // Groups are sorted from smallest to largest, so the first one that surrounds the
+    // direction is used. Failing that, the closest one is used with its negative gains
+    // removed.
+    const Group* best = nullptr;
+    Vector bestGains {};
+    auto bestMinimum = std::numeric_limits<double>::lowest();
+
+    for (auto& group : groups)
+    {
+        auto g = multiply (group.inverse, target);
+        const auto minimum = *std::min_element (g.begin(), g.begin() + (std::ptrdiff_t) group.size);
+
+        if (minimum > bestMinimum)
+        {
+            best = &group;
+            bestGains = g;
+            bestMinimum = minimum;
+        }
+
+        if (minimum > -tolerance)
+            break;
+    }
+
+    for (size_t i = 0; i < best->size; ++i)
+        gains[best->speakers[i]] = jmax (0.0, bestGains[i]);
+
+    normalisePower (gains, numSpeakers);
+}
+
+//==============================================================================
+template <typename SampleType>
+ObjectPanner<SampleType>::ObjectPanner() = default;
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setSpeakerLayout (const AudioChannelSet& layout)
+{
+    setSpeakerLayout (SphericalDirection::fromChannelSet (layout));
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setSpeakerLayout (const std::vector<std::optional<SphericalDirection>>& newSpeakerDirections)
+{
+    speakerDirections = newSpeakerDirections;
+    vectorBasePanning = VectorBasePanning (speakerDirections);
+    scratchGains.resize (speakerDirections.size());
+    resizeGains();
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setNumObjects (int newNumObjects)
+{
+    jassert (newNumObjects >= 0);
+
+    objectDirections.resize ((size_t) newNumObjects);
+    resizeGains();
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setObjectDirection (int objectIndex, SphericalDirection newDirection) noexcept
+{
+    jassert (isPositiveAndBelow (objectIndex, getNumObjects()));
+
+    objectDirections[(size_t) objectIndex] = newDirection;
+    updateGains ((size_t) objectIndex);
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setMethod (Method newMethod) noexcept
+{
+    if (std::exchange (method, newMethod) != newMethod)
+        updateAllGains();
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::setDistanceRolloffDecibels (double newRolloff) noexcept
+{
+    jassert (newRolloff > 0.0);
+
+    // Gains are proportional to distance ^ -exponent, and 6.02 dB is a factor of 2
+    rolloffExponent = newRolloff / Decibels::gainToDecibels (2.0);
+    updateAllGains();
+}
+
+//==============================================================================
+template <typename SampleType>
+void ObjectPanner<SampleType>::prepare (const ProcessSpec& spec)
+{
+    mixer.prepare (spec);
+    updateMixer();
+    mixer.reset();
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::reset() noexcept
+{
+    updateMixer();
+    mixer.reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void ObjectPanner<SampleType>::updateGains (size_t objectIndex) noexcept
+{
+    using namespace SpatialPanningHelpers;
+
+    const auto numSpeakers = speakerDirections.size();
+    auto* speakerGains = scratchGains.data();
+
+    if (method == Method::vectorBase)
+    {
+        vectorBasePanning.computeGains (objectDirections[objectIndex], speakerGains);
+    }
+    else
+    {
+        // A small blur keeps the gains finite when an object is on top of a loudspeaker
+        constexpr double blurSquared = 0.01;
+        const auto position = objectDirections[objectIndex].toUnitVector();
+
+        for (size_t i = 0; i < numSpeakers; ++i)
+        {
+            speakerGains[i] = 0.0;
+
+            if (const auto& speaker = speakerDirections[i])
+            {
+                const auto speakerPosition = speaker->toUnitVector();
+                const Vector difference { position[0] - speakerPosition[0],
+                                          position[1] - speakerPosition[1],
+                                          position[2] - speakerPosition[2] };
+
+                speakerGains[i] = std::pow (dot (difference, difference) + blurSquared, -0.5 * rolloffExponent);
+            }
+        }
+
+        normalisePower (speakerGains, numSpeakers);
+    }
+
+    for (size_t i = 0; i < numSpeakers; ++i)
+        gains (i, objectIndex) = (SampleType) speakerGains[i];
+
+    gainsChanged = true;
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::updateAllGains() noexcept
+{
+    for (size_t i = 0; i < objectDirections.size(); ++i)
+        updateGains (i);
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::updateMixer() noexcept
+{
+    if (std::exchange (gainsChanged, false))
+        mixer.setMatrix (gains);
+}
+
+template <typename SampleType>
+void ObjectPanner<SampleType>::resizeGains()
+{
+    gains = Matrix<SampleType> (speakerDirections.size(), objectDirections.size());
+    updateAllGains();
+
+    mixer.setMatrix (gains);
+    gainsChanged = false;
+}
+
+//==============================================================================
+template class ObjectPanner<float>;
+template class ObjectPanner<double>;
+
+} // namespace dsp
+} // namespace juce
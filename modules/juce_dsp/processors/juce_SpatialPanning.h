@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A direction on the unit sphere, in radians.
+
+    The azimuth is measured anticlockwise from straight ahead when seen from above,
+    so positive values are to the listener's left, and the elevation is measured
+    upwards from the horizontal plane. This matches the convention used by
+    ACN/SN3D ambisonics.
+
+    @tags{DSP}
+*/
+struct SphericalDirection
+{
+    double azimuth = 0.0, elevation = 0.0;
+
+    /** Returns the position of the direction on the unit sphere as { x, y, z }, with
+        x pointing forwards, y to the left and z upwards.
+    */
+    std::array<double, 3> toUnitVector() const noexcept;
+
+    /** Returns the nominal direction of a loudspeaker channel, based on the
+        ITU-R BS.2051 and Dolby Atmos layouts, or an empty optional for channels such as
+        LFE that don't have a direction.
+    */
+    static std::optional<SphericalDirection> fromChannelType (AudioChannelSet::ChannelType type) noexcept;
+
+    /** Returns the nominal direction of each channel in a loudspeaker layout. */
+    static std::vector<std::optional<SphericalDirection>> fromChannelSet (const AudioChannelSet& layout);
+};
+
+//==============================================================================
+/**
+    Calculates vector base amplitude panning (VBAP) gains for a set of loudspeakers.
+
+    When it's created, the loudspeakers are grouped into triangles, or into adjacent
+    pairs if they're all on the same plane, and the inverse of each group's basis is
+    stored, so finding the gains for a direction only needs a few small matrix-vector
+    products. A direction is panned using the smallest group that surrounds it.
+    Directions that aren't surrounded by any group, such as those below a layout
+    with no lower loudspeakers, are panned to the group they're closest to.
+
+    @see ObjectPanner
+
+    @tags{DSP}
+*/
+class VectorBasePanning
+{
+public:
+    //==============================================================================
+    /** Creates an object with no loudspeakers. */
+    VectorBasePanning() = default;
+
+    /** Creates an object for a set of loudspeakers. Entries without a direction,
+        such as LFE channels, always receive a gain of zero.
+    */
+    explicit VectorBasePanning (const std::vector<std::optional<SphericalDirection>>& speakerDirections);
+
+    /** Returns the number of loudspeakers, including those without a direction. */
+    size_t getNumSpeakers() const noexcept      { return numSpeakers; }
+
+    /** Fills an array of getNumSpeakers() values with the gains for a direction.
+        The gains are normalised so that the total power is 1.
+    */
+    void computeGains (SphericalDirection direction, double* gains) const noexcept;
+
+private:
+    //==============================================================================
+    struct Group
+    {
+        std::array<size_t, 3> speakers;
+        size_t size;
+        std::array<double, 9> inverse;
+    };
+
+    void addTriangles (const std::vector<std::pair<size_t, std::array<double, 3>>>&);
+    void addPairs (const std::vector<std::pair<size_t, std::array<double, 3>>>&);
+
+    std::vector<Group> groups;
+    size_t numSpeakers = 0;
+    std::optional<size_t> onlySpeaker;
+};
+
+//==============================================================================
+/**
+    A processor that pans a number of mono objects to a loudspeaker layout.
+
+    Each input channel is an object with its own direction, and each output channel
+    is a loudspeaker. The objects can be panned with VBAP, which uses at most three
+    loudspeakers per object, or with distance-based amplitude panning (DBAP), which
+    spreads each object across every loudspeaker with gains that fall off with the
+    distance between the object and the loudspeaker.
+
+    The gains for every object and loudspeaker are kept in a single matrix and applied
+    with a MatrixMixer, so changes of direction are smoothed and the silent routes that
+    VBAP produces cost nothing.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class ObjectPanner
+{
+public:
+    //==============================================================================
+    enum class Method
+    {
+        vectorBase,     // VBAP
+        distanceBased   // DBAP
+    };
+
+    //==============================================================================
+    /** Constructor. */
+    ObjectPanner();
+
+    //==============================================================================
+    /** Sets the loudspeaker layout that the objects are panned to. This may allocate. */
+    void setSpeakerLayout (const AudioChannelSet& layout);
+
+    /** Sets the direction of each output channel. Channels without a direction, such as
+        LFE channels, don't receive any signal. This may allocate.
+    */
+    void setSpeakerLayout (const std::vector<std::optional<SphericalDirection>>& speakerDirections);
+
+    /** Sets the number of objects, which is the number of input channels that will be
+        processed. New objects start out straight ahead. This may allocate.
+    */
+    void setNumObjects (int newNumObjects);
+
+    /** Returns the number of objects. */
+    int getNumObjects() const noexcept                          { return (int) objectDirections.size(); }
+
+    /** Sets the direction of an object. This doesn't allocate, and the new gains are
+        passed to the mixer at the start of the next call to process().
+    */
+    void setObjectDirection (int objectIndex, SphericalDirection newDirection) noexcept;
+
+    /** Sets the panning method. */
+    void setMethod (Method newMethod) noexcept;
+
+    /** Sets the rolloff used by distance-based panning, in decibels per doubling of
+        distance. The default is 6 dB.
+    */
+    void setDistanceRolloffDecibels (double newRolloff) noexcept;
+
+    /** Sets the time it takes for the gains to reach their new values after a change. */
+    void setRampDurationSeconds (double newDurationSeconds) noexcept    { mixer.setRampDurationSeconds (newDurationSeconds); }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context.
+        The input block holds one channel for each object, and the output block one
+        channel for each loudspeaker.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        updateMixer();
+        mixer.process (context);
+    }
+
+private:
+    //==============================================================================
+    void updateGains (size_t objectIndex) noexcept;
+    void updateAllGains() noexcept;
+    void updateMixer() noexcept;
+    void resizeGains();
+
+    //==============================================================================
+    std::vector<std::optional<SphericalDirection>> speakerDirections;
+    std::vector<SphericalDirection> objectDirections;
+    std::vector<double> scratchGains;
+    VectorBasePanning vectorBasePanning;
+    Matrix<SampleType> gains { 0, 0 };
+    MatrixMixer<SampleType> mixer;
+    Method method = Method::vectorBase;
+    double rolloffExponent = 1.0;
+    bool gainsChanged = false;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SpatialPanningTests  : public UnitTest
+{
+public:
+    SpatialPanningTests()
+        : UnitTest ("SpatialPanning", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        const auto layout = AudioChannelSet::create7point1point4();
+        const auto speakers = SphericalDirection::fromChannelSet (layout);
+        const auto numSpeakers = (size_t) layout.size();
+        const auto indexOf = [&] (AudioChannelSet::ChannelType type) { return (size_t) layout.getChannelIndexForType (type); };
+
+        beginTest ("Loudspeaker directions");
+        {
+            expect (speakers.size() == numSpeakers);
+            expect (! speakers[indexOf (AudioChannelSet::LFE)].has_value());
+            expectWithinAbsoluteError (speakers[indexOf (AudioChannelSet::left)]->azimuth, degreesToRadians (30.0), 1.0e-12);
+            expectWithinAbsoluteError (speakers[indexOf (AudioChannelSet::topRearRight)]->elevation, degreesToRadians (45.0), 1.0e-12);
+        }
+
+        beginTest ("VBAP uses the loudspeakers surrounding a direction");
+        {
+            const VectorBasePanning panning (speakers);
+            std::vector<double> gains (numSpeakers);
+
+            for (size_t s = 0; s < numSpeakers; ++s)
+            {
+                if (! speakers[s].has_value())
+                    continue;
+
+                panning.computeGains (*speakers[s], gains.data());
+
+                for (size_t i = 0; i < numSpeakers; ++i)
+                    expectWithinAbsoluteError (gains[i], i == s ? 1.0 : 0.0, 1.0e-9);
+            }
+
+            panning.computeGains ({ degreesToRadians (15.0), 0.0 }, gains.data());
+            expectWithinAbsoluteError (gains[indexOf (AudioChannelSet::left)], std::sqrt (0.5), 1.0e-9);
+            expectWithinAbsoluteError (gains[indexOf (AudioChannelSet::centre)], std::sqrt (0.5), 1.0e-9);
+            expectWithinAbsoluteError (getPower (gains), 1.0, 1.0e-9);
+
+            panning.computeGains ({ 0.0, MathConstants<double>::halfPi }, gains.data());
+
+            for (size_t i = 0; i < numSpeakers; ++i)
+                if (gains[i] != 0.0)
+                    expectWithinAbsoluteError (speakers[i]->elevation, degreesToRadians (45.0), 1.0e-12);
+
+            panning.computeGains ({ 1.0, -0.5 }, gains.data());
+            expectWithinAbsoluteError (getPower (gains), 1.0, 1.0e-9);
+            expect (std::all_of (gains.begin(), gains.end(), [] (double g) { return g >= 0.0; }));
+        }
+
+        beginTest ("VBAP with a horizontal layout");
+        {
+            const auto surround = AudioChannelSet::create5point0();
+            const VectorBasePanning panning (SphericalDirection::fromChannelSet (surround));
+            std::vector<double> gains ((size_t) surround.size());
+
+            panning.computeGains ({ degreesToRadians (70.0), 0.3 }, gains.data());
+
+            for (auto type : surround.getChannelTypes())
+            {
+                const auto gain = gains[(size_t) surround.getChannelIndexForType (type)];
+                const auto expectNonZero = type == AudioChannelSet::left || type == AudioChannelSet::leftSurround;
+                expect ((gain > 0.0) == expectNonZero);
+            }
+
+            expectWithinAbsoluteError (getPower (gains), 1.0, 1.0e-9);
+        }
+
+        beginTest ("ObjectPanner routes objects to loudspeakers");
+        {
+            constexpr int numSamples = 64;
+
+            ObjectPanner<float> panner;
+            panner.setSpeakerLayout (layout);
+            panner.setNumObjects (2);
+            panner.setObjectDirection (0, *speakers[indexOf (AudioChannelSet::left)]);
+            panner.setObjectDirection (1, *speakers[indexOf (AudioChannelSet::topRearRight)]);
+            panner.prepare ({ 48000.0, (uint32) numSamples, (uint32) numSpeakers });
+
+            AudioBuffer<float> in (2, numSamples), out ((int) numSpeakers, numSamples);
+            in.clear();
+            in.setSample (0, 0, 1.0f);
+            in.setSample (1, 1, 1.0f);
+
+            AudioBlock<float> inBlock (in), outBlock (out);
+            panner.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            for (size_t s = 0; s < numSpeakers; ++s)
+            {
+                expectWithinAbsoluteError (out.getSample ((int) s, 0), s == indexOf (AudioChannelSet::left) ? 1.0f : 0.0f, 1.0e-6f);
+                expectWithinAbsoluteError (out.getSample ((int) s, 1), s == indexOf (AudioChannelSet::topRearRight) ? 1.0f : 0.0f, 1.0e-6f);
+            }
+
+            panner.setMethod (ObjectPanner<float>::Method::distanceBased);
+            panner.reset();
+            panner.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            std::vector<double> gains;
+
+            for (size_t s = 0; s < numSpeakers; ++s)
+                gains.push_back (out.getSample ((int) s, 0));
+
+            expectEquals (out.getSample ((int) indexOf (AudioChannelSet::LFE), 0), 0.0f);
+            expectWithinAbsoluteError (getPower (gains), 1.0, 1.0e-5);
+            expect ((size_t) std::distance (gains.begin(), std::max_element (gains.begin(), gains.end())) == indexOf (AudioChannelSet::left));
+        }
+    }
+
+private:
+    static double getPower (const std::vector<double>& gains)
+    {
+        return std::inner_product (gains.begin(), gains.end(), gains.begin(), 0.0);
+    }
+};
+
+static SpatialPanningTests spatialPanningTests;
+
+} // namespace dsp
+} // namespace juce
@@ -120,6 +120,99 @@ SampleType StateVariableTPTFilter<SampleType>::processSample (int channel, Sampl
     }
 }
 
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::calculateCoefficients (const SampleType* cutoffs, SampleType* gValues,
+                                                                 SampleType* hValues, size_t numSamples) const noexcept
+{
+    FloatVectorOperations::clip (gValues, cutoffs, static_cast<SampleType> (0), maximumCutoff(), (int) numSamples);
+    FloatVectorOperations::multiply (gValues, static_cast<SampleType> (MathConstants<double>::pi / sampleRate), (int) numSamples);
+    FastMathApproximations::tanBelowHalfPi (gValues, numSamples);
+
+    for (size_t i = 0; i < numSamples; ++i)
+        hValues[i] = static_cast<SampleType> (1) / (static_cast<SampleType> (1) + R2 * gValues[i] + gValues[i] * gValues[i]);
+}
+
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::processModulated (const AudioBlock<const SampleType>& inputBlock,
+                                                           const AudioBlock<SampleType>& outputBlock,
+                                                           const SampleType* gValues, const SampleType* hValues) noexcept
+{
+    // Filtering a few channels together hides the latency of each one's feedback loop
+    const auto numChannels = outputBlock.getNumChannels();
+    size_t channel = 0;
+
+    for (; channel + 4 <= numChannels; channel += 4)
+        processModulatedChannels<4> (inputBlock, outputBlock, channel, gValues, hValues);
+
+    if (channel + 2 <= numChannels)
+    {
+        processModulatedChannels<2> (inputBlock, outputBlock, channel, gValues, hValues);
+        channel += 2;
+    }
+
+    if (channel < numChannels)
+        processModulatedChannels<1> (inputBlock, outputBlock, channel, gValues, hValues);
+}
+
+template <typename SampleType>
+template <size_t NumChannels>
+void StateVariableTPTFilter<SampleType>::processModulatedChannels (const AudioBlock<const SampleType>& inputBlock,
+                                                                   const AudioBlock<SampleType>& outputBlock,
+                                                                   size_t firstChannel,
+                                                                   const SampleType* gValues,
+                                                                   const SampleType* hValues) noexcept
+{
+    const auto numSamples = outputBlock.getNumSamples();
+
+    const SampleType* inputs[NumChannels];
+    SampleType* outputs[NumChannels];
+    SampleType ls1[NumChannels], ls2[NumChannels];
+
+    for (size_t c = 0; c < NumChannels; ++c)
+    {
+        inputs[c]  = inputBlock .getChannelPointer (firstChannel + c);
+        outputs[c] = outputBlock.getChannelPointer (firstChannel + c);
+        ls1[c] = s1[firstChannel + c];
+        ls2[c] = s2[firstChannel + c];
+    }
+
+    const auto run = [&] (auto selectOutput)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto lg = gValues[i];
+            const auto lh = hValues[i];
+
+            for (size_t c = 0; c < NumChannels; ++c)
+            {
+                auto yHP = lh * (inputs[c][i] - ls1[c] * (lg + R2) - ls2[c]);
+
+                auto yBP = yHP * lg + ls1[c];
+                ls1[c]   = yHP * lg + yBP;
+
+                auto yLP = yBP * lg + ls2[c];
+                ls2[c]   = yBP * lg + yLP;
+
+                outputs[c][i] = selectOutput (yLP, yBP, yHP);
+            }
+        }
+    };
+
+    switch (filterType)
+    {
+        case Type::bandpass:  run ([] (SampleType, SampleType bp, SampleType)    { return bp; }); break;
+        case Type::highpass:  run ([] (SampleType, SampleType, SampleType hp)    { return hp; }); break;
+        case Type::lowpass:
+        default:              run ([] (SampleType lp, SampleType, SampleType)    { return lp; }); break;
+    }
+
+    for (size_t c = 0; c < NumChannels; ++c)
+    {
+        s1[firstChannel + c] = ls1[c];
+        s2[firstChannel + c] = ls2[c];
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::update()
@@ -144,6 +144,57 @@ public:
        #endif
     }
 
+    /** Processes the input and output samples supplied in the processing context, with
+        a cutoff frequency for every sample, for modulating the filter at audio rate.
+
+        The array must hold one frequency in Hz for each sample in the block, which is
+        shared by all the channels. Frequencies are clipped to just below half the sample
+        rate. The coefficients are calculated for a short run of samples at a time, using
+        FastMathApproximations::tanBelowHalfPi, and then the run is filtered with them, so
+        nothing is allocated and there's no call to std::tan for each sample.
+
+        Afterwards the cutoff frequency is left at the last one in the array.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const SampleType* cutoffFrequencies) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= s1.size());
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (numSamples == 0)
+            return;
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+        }
+        else
+        {
+            constexpr size_t runLength = 64;
+            SampleType gValues[runLength], hValues[runLength];
+
+            for (size_t start = 0; start < numSamples; start += runLength)
+            {
+                const auto num = jmin (runLength, numSamples - start);
+                calculateCoefficients (cutoffFrequencies + start, gValues, hValues, num);
+
+                processModulated (inputBlock.getSubBlock (start, num), outputBlock.getSubBlock (start, num), gValues, hValues);
+            }
+
+           #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            snapToZero();
+           #endif
+        }
+
+        cutoffFrequency = jlimit (static_cast<SampleType> (0), maximumCutoff(), cutoffFrequencies[numSamples - 1]);
+        update();
+    }
+
     //==============================================================================
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
@@ -151,6 +202,14 @@ public:
 private:
     //==============================================================================
     void update();
+    SampleType maximumCutoff() const noexcept   { return static_cast<SampleType> (sampleRate * 0.499); }
+    void calculateCoefficients (const SampleType* cutoffs, SampleType* gValues, SampleType* hValues, size_t numSamples) const noexcept;
+    void processModulated (const AudioBlock<const SampleType>& inputBlock, const AudioBlock<SampleType>& outputBlock,
+                           const SampleType* gValues, const SampleType* hValues) noexcept;
+
+    template <size_t NumChannels>
+    void processModulatedChannels (const AudioBlock<const SampleType>& inputBlock, const AudioBlock<SampleType>& outputBlock,
+                                   size_t firstChannel, const SampleType* gValues, const SampleType* hValues) noexcept;
 
     //==============================================================================
     SampleType g, h, R2;
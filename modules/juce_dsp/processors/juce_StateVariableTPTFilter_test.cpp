@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class StateVariableTPTFilterTests  : public UnitTest
+{
+public:
+    StateVariableTPTFilterTests()
+        : UnitTest ("StateVariableTPTFilter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        for (auto type : { StateVariableTPTFilterType::lowpass,
+                           StateVariableTPTFilterType::bandpass,
+                           StateVariableTPTFilterType::highpass })
+        {
+            beginTest ("Audio rate cutoff matches setting the cutoff for every sample, type " + String ((int) type));
+            {
+                const ProcessSpec spec { 44100.0, 512, 2 };
+                StateVariableTPTFilter<float> modulated, reference;
+
+                for (auto* filter : { &modulated, &reference })
+                {
+                    filter->setType (type);
+                    filter->setResonance (2.0f);
+                    filter->prepare (spec);
+                }
+
+                AudioBuffer<float> output ((int) spec.numChannels, (int) spec.maximumBlockSize);
+                std::vector<float> cutoffs (spec.maximumBlockSize);
+                Random random (0x5678);
+
+                for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                    for (int i = 0; i < output.getNumSamples(); ++i)
+                        output.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+                for (size_t i = 0; i < cutoffs.size(); ++i)
+                    cutoffs[i] = 2000.0f + 1900.0f * std::sin ((float) i * 0.05f);
+
+                AudioBuffer<float> expected (output);
+
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                {
+                    reference.setCutoffFrequency (cutoffs[(size_t) i]);
+
+                    for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+                        expected.setSample (channel, i, reference.processSample (channel, expected.getSample (channel, i)));
+                }
+
+                AudioBlock<float> block (output);
+                modulated.process (ProcessContextReplacing<float> (block), cutoffs.data());
+
+                for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                    for (int i = 0; i < output.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), 1.0e-5f);
+
+                expectEquals (modulated.getCutoffFrequency(), cutoffs.back());
+            }
+        }
+
+        beginTest ("Cutoffs above half the sample rate are clipped");
+        {
+            StateVariableTPTFilter<double> filter;
+            filter.prepare ({ 48000.0, 16, 1 });
+
+            AudioBuffer<double> buffer (1, 16);
+            buffer.clear();
+            buffer.setSample (0, 0, 1.0);
+
+            std::vector<double> cutoffs (16, 30000.0);
+            AudioBlock<double> block (buffer);
+            filter.process (ProcessContextReplacing<double> (block), cutoffs.data());
+
+            for (int i = 0; i < 16; ++i)
+                expect (std::isfinite (buffer.getSample (0, i)));
+
+            expectLessThan (filter.getCutoffFrequency(), 24000.0);
+        }
+    }
+};
+
+static StateVariableTPTFilterTests stateVariableTPTFilterTests;
+
+} // namespace dsp
+} // namespace juce
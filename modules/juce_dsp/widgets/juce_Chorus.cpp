@@ -102,6 +102,7 @@ void Chorus<SampleType>::prepare (const ProcessSpec& spec)
 
     osc.prepare (spec);
     bufferDelayTimes.setSize (1, (int) spec.maximumBlockSize, false, false, true);
+    bufferTaps.setSize (1, (int) spec.maximumBlockSize, false, false, true);
 
     update();
     reset();
@@ -120,22 +120,34 @@ public:
 
         dryWet.pushDrySamples (inputBlock);
 
+        // The modulated delay never drops below 1 ms, so a chunk of up to that many
+        // samples can be read from the delay line before its own input (which
+        // depends on the feedback from those reads) is pushed
+        const auto chunkSize = (size_t) jmax (1, (int) (sampleRate / 1000.0));
+        auto* taps = bufferTaps.getWritePointer (0);
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             auto* inputSamples  = inputBlock .getChannelPointer (channel);
             auto* outputSamples = outputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples; start += chunkSize)
             {
-                auto input = inputSamples[i];
-                auto output = input - lastOutput[channel];
+                const auto numThisTime = jmin (chunkSize, numSamples - start);
+
+                delay.readTaps ((int) channel, delaySamples + start, taps, (int) numThisTime);
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                {
+                    auto input = inputSamples[start + i] - lastOutput[channel];
+                    auto output = taps[i];
 
-                delay.pushSample ((int) channel, output);
-                delay.setDelay (delaySamples[i]);
-                output = delay.popSample ((int) channel);
+                    taps[i] = input;
+                    outputSamples[start + i] = output;
+                    lastOutput[channel] = output * feedbackVolume[channel].getNextValue();
+                }
 
-                outputSamples[i] = output;
-                lastOutput[channel] = output * feedbackVolume[channel].getNextValue();
+                delay.pushBlock ((int) channel, taps, (int) numThisTime);
             }
         }
 
@@ -153,7 +165,7 @@ private:
     std::vector<SmoothedValue<SampleType, ValueSmoothingTypes::Linear>> feedbackVolume { 2 };
     DryWetMixer<SampleType> dryWet;
     std::vector<SampleType> lastOutput { 2 };
-    AudioBuffer<SampleType> bufferDelayTimes;
+    AudioBuffer<SampleType> bufferDelayTimes, bufferTaps;
 
     double sampleRate = 44100.0;
     SampleType rate = 1.0, depth = 0.25, feedback = 0.0, mix = 0.5,
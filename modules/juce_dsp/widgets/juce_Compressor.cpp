@@ -66,6 +66,12 @@ void Compressor<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::setChannelsLinked (bool shouldBeLinked)
+{
+    channelsLinked = shouldBeLinked;
+}
+
 //==============================================================================
 template <typename SampleType>
 void Compressor<SampleType>::prepare (const ProcessSpec& spec)
@@ -77,6 +83,8 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
 
     envelopeFilter.prepare (spec);
 
+    gains.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+
     update();
     reset();
 }
@@ -102,12 +110,27 @@ SampleType Compressor<SampleType>::processSample (int channel, SampleType inputV
     return gain * inputValue;
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::processBlock (const AudioBlock<const SampleType>& inputBlock,
+                                           const AudioBlock<SampleType>& outputBlock,
+                                           const AudioBlock<const SampleType>& sidechainBlock) noexcept
+{
+    detail::processDynamics (inputBlock, outputBlock, sidechainBlock, gains, channelsLinked,
+                             [this] (const AudioBlock<const SampleType>& sidechain, const AudioBlock<SampleType>& gainBlock)
+    {
+        envelopeFilter.processBlock (sidechain, gainBlock);
+        detail::applyGainCurve (gainBlock, thresholdLog2, gainSlope);
+    });
+}
+
 template <typename SampleType>
 void Compressor<SampleType>::update()
 {
     threshold = Decibels::decibelsToGain (thresholddB, static_cast<SampleType> (-200.0));
     thresholdInverse = static_cast<SampleType> (1.0) / threshold;
     ratioInverse     = static_cast<SampleType> (1.0) / ratio;
+    thresholdLog2    = std::log2 (threshold);
+    gainSlope        = ratioInverse - static_cast<SampleType> (1.0);
 
     envelopeFilter.setAttackTime (attackTime);
     envelopeFilter.setReleaseTime (releaseTime);
@@ -55,6 +55,14 @@ public:
     /** Sets the release time in milliseconds of the compressor.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets whether all the channels are driven by a single envelope.
+
+        When the channels are linked, the envelope follows the loudest channel and the
+        same gain is applied to every channel, which keeps the stereo image steady.
+        Otherwise each channel has its own envelope. This is only used by process().
+    */
+    void setChannelsLinked (bool shouldBeLinked);
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -63,17 +71,35 @@ public:
     void reset();
 
     //==============================================================================
-    /** Processes the input and output samples supplied in the processing context. */
+    /** Processes the input and output samples supplied in the processing context.
+
+        The gains are calculated a block at a time using fast approximations of the
+        logarithm and exponential, so the result can differ very slightly from the
+        one given by processSample().
+    */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
+    {
+        process (context, context.getInputBlock());
+    }
+
+    /** Processes the samples supplied in the processing context, with the envelope
+        taken from a separate sidechain signal.
+
+        The sidechain must have as many samples as the context, but can have any number
+        of channels. When the channels are linked, the loudest sidechain channel drives
+        them all. Otherwise, output channel n is driven by sidechain channel n, wrapping
+        around if there are fewer sidechain channels, so a mono sidechain drives every
+        channel independently.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& sidechainBlock) noexcept
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
-        const auto numSamples  = outputBlock.getNumSamples();
 
-        jassert (inputBlock.getNumChannels() == numChannels);
-        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
 
         if (context.isBypassed)
         {
@@ -81,14 +107,7 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+        processBlock (inputBlock, outputBlock, sidechainBlock);
     }
 
     /** Performs the processing operation on a single sample at a time. */
@@ -97,10 +116,14 @@ public:
 private:
     //==============================================================================
     void update();
+    void processBlock (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&,
+                       const AudioBlock<const SampleType>&) noexcept;
 
     //==============================================================================
-    SampleType threshold, thresholdInverse, ratioInverse;
+    SampleType threshold, thresholdInverse, ratioInverse, thresholdLog2, gainSlope;
     BallisticsFilter<SampleType> envelopeFilter;
+    AudioBuffer<SampleType> gains;
+    bool channelsLinked = false;
 
     double sampleRate = 44100.0;
     SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
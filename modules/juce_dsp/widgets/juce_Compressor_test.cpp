@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class CompressorTest  : public UnitTest
+{
+public:
+    CompressorTest()
+        : UnitTest ("Compressor", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Block processing matches processSample");
+        {
+            testBlockMatchesSamples<Compressor<float>>();
+            testBlockMatchesSamples<Compressor<double>>();
+            testBlockMatchesSamples<NoiseGate<float>>();
+            testBlockMatchesSamples<NoiseGate<double>>();
+        }
+
+        beginTest ("Linked channels share the gain of the loudest one");
+        {
+            auto compressor = makeCompressor();
+            compressor.setChannelsLinked (true);
+
+            AudioBuffer<float> buffer (2, 4096);
+            fill (buffer, { 0.5f, 0.01f });
+            process (compressor, buffer);
+
+            const auto end = buffer.getNumSamples() - 1;
+            expectLessThan (buffer.getSample (0, end), 0.5f);
+            expectWithinAbsoluteError (buffer.getSample (1, end) / buffer.getSample (0, end), 0.02f, 1.0e-4f);
+        }
+
+        beginTest ("A sidechain drives the gain");
+        {
+            auto compressor = makeCompressor();
+
+            AudioBuffer<float> buffer (2, 4096), sidechain (1, 4096);
+            fill (buffer, { 0.01f, 0.01f });
+            fill (sidechain, { 0.5f });
+            process (compressor, buffer, &sidechain);
+
+            const auto end = buffer.getNumSamples() - 1;
+            expectLessThan (buffer.getSample (0, end), 0.005f);
+            expectEquals (buffer.getSample (1, end), buffer.getSample (0, end));
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr uint32 blockSize = 256;
+
+    static Compressor<float> makeCompressor()
+    {
+        Compressor<float> compressor;
+        compressor.setThreshold (-20.0f);
+        compressor.setRatio (4.0f);
+        compressor.prepare ({ sampleRate, blockSize, 2 });
+        return compressor;
+    }
+
+    template <typename SampleType>
+    static void fill (AudioBuffer<SampleType>& buffer, std::initializer_list<SampleType> levels)
+    {
+        auto channel = 0;
+
+        for (auto level : levels)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (i % 2 == 0) ? level : -level);
+
+            ++channel;
+        }
+    }
+
+    template <typename Processor, typename SampleType>
+    static void process (Processor& processor, AudioBuffer<SampleType>& buffer,
+                         const AudioBuffer<SampleType>* sidechain = nullptr)
+    {
+        AudioBlock<SampleType> block (buffer);
+
+        for (size_t i = 0; i < block.getNumSamples(); i += blockSize)
+        {
+            const auto num = jmin ((size_t) blockSize, block.getNumSamples() - i);
+            auto subBlock = block.getSubBlock (i, num);
+            ProcessContextReplacing<SampleType> context (subBlock);
+
+            if (sidechain != nullptr)
+                processor.process (context, AudioBlock<const SampleType> (*sidechain).getSubBlock (i, num));
+            else
+                processor.process (context);
+        }
+    }
+
+    template <typename Processor>
+    void testBlockMatchesSamples()
+    {
+        using SampleType = decltype (std::declval<Processor>().processSample (0, 0));
+
+        Processor block, samples;
+
+        for (auto* processor : { &block, &samples })
+        {
+            processor->setThreshold ((SampleType) -20.0);
+            processor->setRatio ((SampleType) 4.0);
+            processor->setAttack ((SampleType) 5.0);
+            processor->setRelease ((SampleType) 50.0);
+            processor->prepare ({ sampleRate, blockSize, 2 });
+        }
+
+        AudioBuffer<SampleType> input (2, 44100);
+        Random random (0x1357);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                input.setSample (channel, i, (SampleType) ((random.nextFloat() * 2.0f - 1.0f)
+                                                             * std::sin ((float) i * 0.0005f)));
+
+        AudioBuffer<SampleType> output (input);
+        process (block, output);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < input.getNumSamples(); ++i)
+            {
+                const auto expected = samples.processSample (channel, input.getSample (channel, i));
+                expectWithinAbsoluteError (output.getSample (channel, i), expected,
+                                           (SampleType) 1.0e-4 * std::abs (input.getSample (channel, i)));
+            }
+        }
+    }
+};
+
+static CompressorTest compressorTest;
+
+} // namespace dsp
+} // namespace juce
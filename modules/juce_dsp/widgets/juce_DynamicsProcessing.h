@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace detail
+{
+
+/*  The block processing shared by Compressor and NoiseGate.
+
+    The block is split into runs that fit in the scratch buffer. For each run, the
+    computeGains callback turns a block of sidechain samples into a block of gains,
+    which is then applied to the input. When the channels are linked, the callback
+    is given a single channel holding the loudest of the sidechain channels, and its
+    gains are applied to every channel. Otherwise output channel n is driven by
+    sidechain channel n, wrapping around if there are fewer sidechain channels than
+    outputs.
+*/
+template <typename SampleType, typename ComputeGains>
+static void processDynamics (const AudioBlock<const SampleType>& inputBlock,
+                             const AudioBlock<SampleType>& outputBlock,
+                             const AudioBlock<const SampleType>& sidechainBlock,
+                             AudioBuffer<SampleType>& scratch,
+                             bool channelsLinked,
+                             ComputeGains&& computeGains) noexcept
+{
+    const auto numChannels          = outputBlock.getNumChannels();
+    const auto numSidechainChannels = sidechainBlock.getNumChannels();
+    const auto numSamples           = outputBlock.getNumSamples();
+    const auto maxRunLength         = (size_t) scratch.getNumSamples();
+
+    jassert (numSidechainChannels > 0);
+    jassert (sidechainBlock.getNumSamples() == numSamples);
+    jassert (numChannels <= (size_t) scratch.getNumChannels());
+    jassert (maxRunLength > 0); // Make sure you call prepare() before processing!
+
+    for (size_t start = 0; start < numSamples; start += maxRunLength)
+    {
+        const auto num = jmin (maxRunLength, numSamples - start);
+        const auto sidechain = sidechainBlock.getSubBlock (start, num);
+
+        if (channelsLinked)
+        {
+            auto gains = AudioBlock<SampleType> (scratch).getSubsetChannelBlock (0, 1).getSubBlock (0, num);
+            auto* loudest = gains.getChannelPointer (0);
+
+            FloatVectorOperations::abs (loudest, sidechain.getChannelPointer (0), num);
+
+            for (size_t channel = 1; channel < numSidechainChannels; ++channel)
+            {
+                const auto* samples = sidechain.getChannelPointer (channel);
+
+                for (size_t i = 0; i < num; ++i)
+                    loudest[i] = jmax (loudest[i], std::abs (samples[i]));
+            }
+
+            computeGains (AudioBlock<const SampleType> (gains), gains);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::multiply (outputBlock.getChannelPointer (channel) + start,
+                                                 inputBlock.getChannelPointer (channel) + start, loudest, num);
+        }
+        else
+        {
+            auto gains = AudioBlock<SampleType> (scratch).getSubsetChannelBlock (0, numChannels).getSubBlock (0, num);
+
+            if (numSidechainChannels == numChannels)
+            {
+                computeGains (sidechain, gains);
+            }
+            else
+            {
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    FloatVectorOperations::copy (gains.getChannelPointer (channel),
+                                                 sidechain.getChannelPointer (channel % numSidechainChannels), num);
+
+                computeGains (AudioBlock<const SampleType> (gains), gains);
+            }
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::multiply (outputBlock.getChannelPointer (channel) + start,
+                                                 inputBlock.getChannelPointer (channel) + start,
+                                                 gains.getChannelPointer (channel), num);
+        }
+    }
+}
+
+/*  Turns a block of envelope levels into gains, using a gain curve that is a straight
+    line in the log domain, below or above the threshold depending on its slope. This
+    is done in separate passes over the block so that each one can be vectorised.
+*/
+template <typename SampleType>
+static void applyGainCurve (const AudioBlock<SampleType>& block, SampleType thresholdLog2, SampleType slope) noexcept
+{
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer (channel);
+
+        FastMathApproximations::log2 (samples, numSamples);
+        FloatVectorOperations::add (samples, -thresholdLog2, numSamples);
+        FloatVectorOperations::multiply (samples, slope, numSamples);
+        FloatVectorOperations::min (samples, samples, static_cast<SampleType> (0.0), numSamples);
+        FastMathApproximations::exp2 (samples, numSamples);
+    }
+}
+
+} // namespace detail
+} // namespace dsp
+} // namespace juce
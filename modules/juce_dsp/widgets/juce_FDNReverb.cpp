@@ -0,0 +1,353 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FDNReverbHelpers
+{
+    static int getNextPrime (int n) noexcept
+    {
+        const auto isPrime = [] (int x)
+        {
+            for (int divisor = 2; divisor * divisor <= x; ++divisor)
+                if (x % divisor == 0)
+                    return false;
+
+            return true;
+        };
+
+        while (! isPrime (n))
+            ++n;
+
+        return n;
+    }
+
+    // Rows of a Hadamard matrix are orthogonal, so using a different row for each input and
+    // output keeps the two channels decorrelated
+    static float getHadamardSign (size_t row, size_t column) noexcept
+    {
+        return (countNumberOfBits ((uint32) (row & column)) & 1) != 0 ? -1.0f : 1.0f;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+FDNReverb<SampleType>::FDNReverb()
+{
+    setParameters (parameters);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::setParameters (const Parameters& newParams)
+{
+    const auto wetScaleFactor = (SampleType) 3;
+    const auto dryScaleFactor = (SampleType) 2;
+
+    const auto wet = (SampleType) newParams.wetLevel * wetScaleFactor;
+    dryGain.setTargetValue ((SampleType) newParams.dryLevel * dryScaleFactor);
+    wetGain1.setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 + (SampleType) newParams.width));
+    wetGain2.setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 - (SampleType) newParams.width));
+
+    parameters = newParams;
+    updateTargets();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::updateTargets() noexcept
+{
+    if (parameters.freezeMode >= 0.5f)
+    {
+        decayPerSample.setTargetValue (0);
+        filterCoefficient.setTargetValue (0);
+        inputGain.setTargetValue (0);
+        return;
+    }
+
+    // The gain of each line is set so that the signal drops by 60 dB over the decay time
+    const auto decayTime = 0.2 * std::pow (100.0, (double) parameters.roomSize);
+
+    // The filters' poles move from 0, where they have no effect, to a cutoff of 200 Hz
+    const auto lowestPole = std::exp (-MathConstants<double>::twoPi * 200.0 / (double) sampleRate);
+    const auto pole = 1.0 - std::pow (1.0 - lowestPole, (double) parameters.damping);
+
+    decayPerSample.setTargetValue ((SampleType) (3.0 / (decayTime * sampleRate)));
+    filterCoefficient.setTargetValue ((SampleType) pole);
+    inputGain.setTargetValue ((SampleType) (1.0 / std::sqrt ((double) numDelayLines)));
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::prepare (const ProcessSpec& spec)
+{
+    using namespace detail;
+
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = (SampleType) spec.sampleRate;
+    modulationDepth = (SampleType) (0.0003 * spec.sampleRate);
+
+    const auto outputScale = (float) (1.0 / std::sqrt ((double) numDelayLines));
+    int longestDelay = 0;
+
+    for (size_t line = 0; line < numDelayLines; ++line)
+    {
+        auto& group = groups[line / numLanes];
+        const auto lane = line % numLanes;
+
+        // The delay times are spread exponentially between 15 and 60 ms, rounded to primes
+        // so that the lines' echoes don't line up with each other
+        const auto delayMs = 15.0 * std::pow (4.0, (double) line / (double) (numDelayLines - 1));
+        const auto delaySamples = FDNReverbHelpers::getNextPrime (roundToInt (delayMs * spec.sampleRate / 1000.0));
+        longestDelay = jmax (longestDelay, delaySamples);
+
+        // Each sub-block reads its input before writing anything, which only works if
+        // all the delays are longer than a sub-block
+        jassert ((size_t) delaySamples > subBlockSize);
+        setLane (group.delay, lane, (SampleType) delaySamples);
+
+        // Each line's delay drifts at a different rate, between 0.1 and 0.5 Hz
+        const auto lfoRate = 0.1 + 0.4 * (double) line / (double) (numDelayLines - 1);
+        const auto lfoStep = MathConstants<double>::twoPi * lfoRate * (double) subBlockSize / spec.sampleRate;
+        setLane (group.lfoCosStep, lane, (SampleType) std::cos (lfoStep));
+        setLane (group.lfoSinStep, lane, (SampleType) std::sin (lfoStep));
+
+        setLane (group.inputLeft,   lane, (SampleType) FDNReverbHelpers::getHadamardSign (3,  line));
+        setLane (group.inputRight,  lane, (SampleType) FDNReverbHelpers::getHadamardSign (6,  line));
+        setLane (group.outputLeft,  lane, (SampleType) (FDNReverbHelpers::getHadamardSign (5,  line) * outputScale));
+        setLane (group.outputRight, lane, (SampleType) (FDNReverbHelpers::getHadamardSign (10, line) * outputScale));
+    }
+
+    // Leave room for the modulation, and for the sample after the oldest one read
+    bufferLength = (size_t) longestDelay + (size_t) std::ceil (2 * modulationDepth) + 3;
+    delayBuffer.assign (bufferLength * numGroups, Vector());
+
+    const auto smoothTime = 0.01;
+
+    for (auto* value : { &decayPerSample, &filterCoefficient, &inputGain, &dryGain, &wetGain1, &wetGain2 })
+        value->reset (spec.sampleRate, smoothTime);
+
+    updateTargets();
+    reset();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::reset() noexcept
+{
+    using namespace detail;
+
+    std::fill (delayBuffer.begin(), delayBuffer.end(), Vector());
+    writeFrame = 0;
+
+    for (size_t line = 0; line < numDelayLines; ++line)
+    {
+        auto& group = groups[line / numLanes];
+        const auto lane = line % numLanes;
+        const auto lfoPhase = MathConstants<double>::twoPi * (double) line / (double) numDelayLines;
+
+        setLane (group.filterState, lane, SampleType());
+        setLane (group.interpolatorState, lane, SampleType());
+        setLane (group.olderSample, lane, SampleType());
+        setLane (group.lfoCos, lane, (SampleType) std::cos (lfoPhase));
+        setLane (group.lfoSin, lane, (SampleType) std::sin (lfoPhase));
+    }
+
+    for (auto* value : { &decayPerSample, &filterCoefficient, &inputGain, &dryGain, &wetGain1, &wetGain2 })
+        value->setCurrentAndTargetValue (value->getTargetValue());
+
+    updateLoopGains();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::updateLoopGains() noexcept
+{
+    using namespace detail;
+
+    const auto decay = (double) decayPerSample.getCurrentValue();
+
+    for (auto& group : groups)
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            setLane (group.loopGain, lane, (SampleType) std::pow (10.0, -decay * (double) getLane (group.delay, lane)));
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::readSubBlock (size_t numSamples) noexcept
+{
+    using namespace detail;
+
+    // The shortest delay is much longer than a sub-block, so everything that the sub-block
+    // will read has already been written, and can be copied out before it starts
+    jassert (numSamples <= subBlockSize);
+
+    const auto* delayed = reinterpret_cast<const SampleType*> (delayBuffer.data());
+    auto* inputs = reinterpret_cast<SampleType*> (lineInputs.data());
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+        auto& group = groups[g];
+        alignas (sizeof (Vector)) SampleType delayTimes[numLanes], coefficients[numLanes], older[numLanes];
+
+        store (group.delay + (group.lfoSin + (SampleType) 1) * modulationDepth, delayTimes);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            // Reading the sample that's wholeDelay frames old, and the one before it, in between
+            // which the exact delay falls
+            const auto wholeDelay = (size_t) delayTimes[lane];
+            const auto fraction = (SampleType) 1 - (delayTimes[lane] - (SampleType) wholeDelay);
+            const auto line = g * numLanes + lane;
+
+            auto frame = writeFrame + bufferLength - wholeDelay - 1;
+
+            if (frame >= bufferLength)
+                frame -= bufferLength;
+
+            older[lane] = delayed[frame * numDelayLines + line];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                if (++frame == bufferLength)
+                    frame = 0;
+
+                inputs[i * numDelayLines + line] = delayed[frame * numDelayLines + line];
+            }
+
+            // A first-order all-pass interpolator doesn't lose any high frequencies when the
+            // delays move, unlike linear interpolation, which would shorten the decay
+            coefficients[lane] = fraction / ((SampleType) 2 - fraction);
+        }
+
+        group.allpassCoefficient = load<Vector> (coefficients);
+        group.olderSample = load<Vector> (older);
+
+        // The LFO steps are a whole sub-block long
+        const auto lfoCos = (group.lfoCos * group.lfoCosStep) - (group.lfoSin * group.lfoSinStep);
+        const auto lfoSin = (group.lfoSin * group.lfoCosStep) + (group.lfoCos * group.lfoSinStep);
+
+        // Rounding errors make the LFOs' phasors drift, so pull them back towards 1
+        const auto lfoGain = ((lfoCos * lfoCos) + (lfoSin * lfoSin)) * (SampleType) -0.5 + (SampleType) 1.5;
+        group.lfoCos = lfoCos * lfoGain;
+        group.lfoSin = lfoSin * lfoGain;
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::processSamples (SampleType* left, SampleType* right, size_t numSamples) noexcept
+{
+    using namespace detail;
+
+    // You must call prepare() before processing!
+    jassert (! delayBuffer.empty());
+
+    if (delayBuffer.empty())
+        return;
+
+    const auto householderScale = (SampleType) 2 / (SampleType) numDelayLines;
+
+    // The modulated delays and the loop gains are only updated between sub-blocks,
+    // as they change slowly
+    for (size_t start = 0; start < numSamples; start += subBlockSize)
+    {
+        const auto end = jmin (numSamples, start + subBlockSize);
+
+        if (decayPerSample.isSmoothing() || filterCoefficient.isSmoothing())
+        {
+            decayPerSample.skip ((int) (end - start));
+            filterCoefficient.skip ((int) (end - start));
+            updateLoopGains();
+        }
+
+        readSubBlock (end - start);
+
+        const Vector coefficient (filterCoefficient.getCurrentValue());
+
+        for (size_t i = start; i < end; ++i)
+        {
+            const auto inL = left[i];
+            const auto inR = right != nullptr ? right[i] : inL;
+            const auto gain = inputGain.getNextValue();
+
+            const auto* newerSamples = lineInputs.data() + (i - start) * numGroups;
+            Vector lineOutputs[numGroups];
+            Vector total {}, outputLeft {}, outputRight {};
+
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                auto& group = groups[g];
+
+                // Each read is one frame on from the last, so the older sample is the one
+                // that was the newer sample last time
+                const auto newerSample = newerSamples[g];
+                const auto input = group.olderSample + group.allpassCoefficient * (newerSample - group.interpolatorState);
+                group.olderSample = newerSample;
+                group.interpolatorState = input;
+
+                group.filterState = input + (group.filterState - input) * coefficient;
+
+                const auto output = group.filterState * group.loopGain;
+                lineOutputs[g] = output;
+                total += output;
+                outputLeft  += output * group.outputLeft;
+                outputRight += output * group.outputRight;
+            }
+
+            // The Householder matrix reflects the lines' outputs about the vector of all ones
+            const auto feedback = sum (total) * householderScale;
+            auto* frameData = delayBuffer.data() + writeFrame * numGroups;
+
+            for (size_t g = 0; g < numGroups; ++g)
+                frameData[g] = (lineOutputs[g] - feedback) + groups[g].inputLeft * (gain * inL) + groups[g].inputRight * (gain * inR);
+
+            writeFrame = writeFrame + 1 == bufferLength ? 0 : writeFrame + 1;
+
+            const auto wetL = sum (outputLeft), wetR = sum (outputRight);
+            const auto dry  = dryGain.getNextValue();
+            const auto wet1 = wetGain1.getNextValue();
+            const auto wet2 = wetGain2.getNextValue();
+
+            if (right != nullptr)
+            {
+                left[i]  = wetL * wet1 + wetR * wet2 + inL * dry;
+                right[i] = wetR * wet1 + wetL * wet2 + inR * dry;
+            }
+            else
+            {
+                left[i] = wetL * wet1 + inL * dry;
+            }
+        }
+    }
+}
+
+//==============================================================================
+template class FDNReverb<float>;
+template class FDNReverb<double>;
+
+} // namespace dsp
+} // namespace juce
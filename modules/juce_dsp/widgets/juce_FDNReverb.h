@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A reverb built from a feedback delay network.
+
+    The reverb feeds sixteen delay lines back into each other through a Householder
+    matrix, which mixes every line into every other one while keeping the energy in
+    the loop constant. Each line has a one-pole low-pass filter to damp the high
+    frequencies, and its delay time is slowly modulated to break up metallic
+    resonances. The lines are processed in the lanes of SIMDRegisters, so the cost
+    of the reverb is close to that of a handful of scalar delay lines.
+
+    The reverb takes the same Parameters as dsp::Reverb and juce::Reverb, so it can
+    be used in place of either of them:
+    - roomSize sets the decay time, from 0.2 seconds at 0 to 20 seconds at 1
+    - damping lowers the cutoff of the filters in the loop, from no filtering at 0
+      to 200 Hz at 1
+    - wetLevel, dryLevel, width and freezeMode behave as they do in juce::Reverb
+
+    Unlike juce::Reverb, the delay times and filters take the sample rate into
+    account, so the reverb sounds the same at any sample rate.
+
+    @see Reverb
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class FDNReverb
+{
+public:
+    //==============================================================================
+    /** Creates an uninitialised reverb. Call prepare() before first use. */
+    FDNReverb();
+
+    //==============================================================================
+    using Parameters = juce::Reverb::Parameters;
+
+    /** Returns the reverb's current parameters. */
+    const Parameters& getParameters() const noexcept    { return parameters; }
+
+    /** Applies a new set of parameters to the reverb.
+        Note that this doesn't attempt to lock the reverb, so if you call this in parallel with
+        the process method, you may get artifacts.
+    */
+    void setParameters (const Parameters& newParams);
+
+    /** Returns true if the reverb is enabled. */
+    bool isEnabled() const noexcept                     { return enabled; }
+
+    /** Enables/disables the reverb. */
+    void setEnabled (bool newValue) noexcept            { enabled = newValue; }
+
+    //==============================================================================
+    /** Initialises the reverb. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the reverb's internal state. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Applies the reverb to a mono or stereo buffer. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numInChannels = inputBlock.getNumChannels();
+        const auto numOutChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumSamples() == numSamples);
+
+        outputBlock.copyFrom (inputBlock);
+
+        if (! enabled || context.isBypassed)
+            return;
+
+        if (numInChannels == 1 && numOutChannels == 1)
+        {
+            processSamples (outputBlock.getChannelPointer (0), nullptr, numSamples);
+        }
+        else if (numInChannels == 2 && numOutChannels == 2)
+        {
+            processSamples (outputBlock.getChannelPointer (0),
+                            outputBlock.getChannelPointer (1),
+                            numSamples);
+        }
+        else
+        {
+            jassertfalse;   // invalid channel configuration
+        }
+    }
+
+    //==============================================================================
+    /** The number of delay lines in the network. */
+    static constexpr size_t numDelayLines = 16;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr size_t numLanes = 1;
+   #endif
+
+    static constexpr size_t numGroups = numDelayLines / numLanes;
+    static_assert (numDelayLines % numLanes == 0, "The delay lines must fill a whole number of registers");
+
+    // The state of numLanes delay lines, held in the lanes of each register
+    struct Group
+    {
+        Vector delay, loopGain, filterState;
+        Vector allpassCoefficient, olderSample, interpolatorState;
+        Vector lfoCos, lfoSin, lfoCosStep, lfoSinStep;
+        Vector inputLeft, inputRight, outputLeft, outputRight;
+    };
+
+    static constexpr size_t subBlockSize = 32;
+
+    //==============================================================================
+    void processSamples (SampleType* left, SampleType* right, size_t numSamples) noexcept;
+    void updateLoopGains() noexcept;
+    void readSubBlock (size_t numSamples) noexcept;
+    void updateTargets() noexcept;
+
+    //==============================================================================
+    std::array<Group, numGroups> groups;
+    std::vector<Vector> delayBuffer;    // indexed by [frame * numGroups + group]
+    std::array<Vector, subBlockSize * numGroups> lineInputs;
+    size_t bufferLength = 0, writeFrame = 0;
+
+    Parameters parameters;
+    SmoothedValue<SampleType> decayPerSample, filterCoefficient, inputGain, dryGain, wetGain1, wetGain2;
+    SampleType sampleRate = 44100, modulationDepth = 0;
+    bool enabled = true;
+
+    JUCE_LEAK_DETECTOR (FDNReverb)
+};
+
+} // namespace dsp
+} // namespace juce
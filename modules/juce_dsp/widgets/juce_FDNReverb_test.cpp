@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class FDNReverbTest  : public UnitTest
+{
+public:
+    FDNReverbTest()
+        : UnitTest ("FDN Reverb", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The tail decays at the rate set by the room size");
+        {
+            testDecayRate<float>();
+            testDecayRate<double>();
+        }
+
+        beginTest ("The left and right outputs are decorrelated");
+        {
+            FDNReverb<float> reverb;
+            reverb.setParameters (getWetParameters());
+            reverb.prepare ({ sampleRate, blockSize, 2 });
+
+            const auto output = renderImpulseResponse (reverb, 2, seconds (1.0));
+            auto sumLR = 0.0, sumLL = 0.0, sumRR = 0.0;
+
+            for (auto i = seconds (0.1); i < output.getNumSamples(); ++i)
+            {
+                const auto l = (double) output.getSample (0, i);
+                const auto r = (double) output.getSample (1, i);
+                sumLR += l * r;
+                sumLL += l * l;
+                sumRR += r * r;
+            }
+
+            expectGreaterThan (sumLL, 0.0);
+            expectLessThan (std::abs (sumLR) / std::sqrt (sumLL * sumRR), 0.2);
+        }
+
+        beginTest ("Freeze mode holds the tail");
+        {
+            FDNReverb<float> reverb;
+            reverb.setParameters (getWetParameters());
+            reverb.prepare ({ sampleRate, blockSize, 1 });
+
+            AudioBuffer<float> buffer (1, seconds (1.5));
+            Random random (0x1234);
+
+            for (int i = 0; i < seconds (0.5); ++i)
+                buffer.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+            for (int i = seconds (0.5); i < buffer.getNumSamples(); ++i)
+                buffer.setSample (0, i, 0.0f);
+
+            process (reverb, buffer, 0, seconds (0.5));
+
+            auto frozen = getWetParameters();
+            frozen.freezeMode = 1.0f;
+            reverb.setParameters (frozen);
+            process (reverb, buffer, seconds (0.5), buffer.getNumSamples());
+
+            const auto early = getLevelInDecibels (buffer, 0, seconds (0.6), seconds (0.7));
+            const auto late  = getLevelInDecibels (buffer, 0, seconds (1.4), seconds (1.5));
+            expectWithinAbsoluteError (late, early, 1.0);
+            expectGreaterThan (late, -40.0);
+        }
+
+        beginTest ("A disabled reverb passes the input through");
+        {
+            FDNReverb<float> reverb;
+            reverb.prepare ({ sampleRate, blockSize, 2 });
+            reverb.setEnabled (false);
+
+            const auto output = renderImpulseResponse (reverb, 2, (int) blockSize);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < output.getNumSamples(); ++i)
+                    expectEquals (output.getSample (channel, i), i == 0 ? 1.0f : 0.0f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr uint32 blockSize = 256;
+
+    static int seconds (double time)     { return roundToInt (time * sampleRate); }
+
+    static FDNReverb<float>::Parameters getWetParameters()
+    {
+        FDNReverb<float>::Parameters params;
+        params.roomSize = 0.5f;     // a decay time of 2 seconds
+        params.damping = 0.0f;
+        params.wetLevel = 1.0f / 3.0f;
+        params.dryLevel = 0.0f;
+        params.width = 1.0f;
+        return params;
+    }
+
+    template <typename SampleType>
+    static void process (FDNReverb<SampleType>& reverb, AudioBuffer<SampleType>& buffer, int start, int end)
+    {
+        AudioBlock<SampleType> block (buffer);
+
+        for (auto i = start; i < end; i += (int) blockSize)
+        {
+            auto subBlock = block.getSubBlock ((size_t) i, (size_t) jmin ((int) blockSize, end - i));
+            reverb.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+    }
+
+    template <typename SampleType>
+    static AudioBuffer<SampleType> renderImpulseResponse (FDNReverb<SampleType>& reverb, int numChannels, int numSamples)
+    {
+        AudioBuffer<SampleType> buffer (numChannels, numSamples);
+        buffer.clear();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.setSample (channel, 0, (SampleType) 1);
+
+        process (reverb, buffer, 0, numSamples);
+        return buffer;
+    }
+
+    template <typename SampleType>
+    static double getLevelInDecibels (const AudioBuffer<SampleType>& buffer, int channel, int start, int end)
+    {
+        return Decibels::gainToDecibels ((double) buffer.getRMSLevel (channel, start, end - start), -200.0);
+    }
+
+    template <typename SampleType>
+    void testDecayRate()
+    {
+        FDNReverb<SampleType> reverb;
+        reverb.setParameters (getWetParameters());
+        reverb.prepare ({ sampleRate, blockSize, 2 });
+
+        const auto output = renderImpulseResponse (reverb, 2, seconds (1.5));
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            // Over one second of a two second decay time, the level should drop by 30 dB
+            const auto early = getLevelInDecibels (output, channel, seconds (0.2), seconds (0.4));
+            const auto late  = getLevelInDecibels (output, channel, seconds (1.2), seconds (1.4));
+            expectWithinAbsoluteError (early - late, 30.0, 3.0);
+        }
+    }
+};
+
+static FDNReverbTest fdnReverbTest;
+
+} // namespace dsp
+} // namespace juce
@@ -101,8 +101,7 @@ public:
         jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
         jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
 
-        auto len         = inBlock.getNumSamples();
-        auto numChannels = inBlock.getNumChannels();
+        auto len = inBlock.getNumSamples();
 
         if (context.isBypassed)
         {
@@ -114,28 +113,7 @@ public:
             return;
         }
 
-        if (numChannels == 1)
-        {
-            auto* src = inBlock.getChannelPointer (0);
-            auto* dst = outBlock.getChannelPointer (0);
-
-            for (size_t i = 0; i < len; ++i)
-                dst[i] = src[i] * gain.getNextValue();
-        }
-        else
-        {
-            JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255 6386)
-            auto* gains = static_cast<FloatType*> (alloca (sizeof (FloatType) * len));
-
-            for (size_t i = 0; i < len; ++i)
-                gains[i] = gain.getNextValue();
-            JUCE_END_IGNORE_WARNINGS_MSVC
-
-            for (size_t chan = 0; chan < numChannels; ++chan)
-                FloatVectorOperations::multiply (outBlock.getChannelPointer (chan),
-                                                 inBlock.getChannelPointer (chan),
-                                                 gains, static_cast<int> (len));
-        }
+        outBlock.replaceWithProductOf (inBlock, gain);
     }
 
 private:
@@ -154,6 +154,17 @@ void LadderFilter<SampleType>::updateSmoothers() noexcept
     scaledResonanceValue = scaledResonanceSmoother.getNextValue();
 }
 
+//==============================================================================
+template <typename SampleType>
+void LadderFilter<SampleType>::calculateCutoffTransforms (const SampleType* cutoffs, SampleType* transforms, size_t numSamples) const noexcept
+{
+    // exp (cutoff * cutoffFreqScaler), done as a power of two so that it can be vectorised
+    constexpr auto log2OfE = SampleType (1.4426950408889634);
+
+    FloatVectorOperations::multiply (transforms, cutoffs, cutoffFreqScaler * log2OfE, (int) numSamples);
+    FastMathApproximations::exp2 (transforms, numSamples);
+}
+
 //==============================================================================
 template <typename SampleType>
 void LadderFilter<SampleType>::setSampleRate (SampleType newValue) noexcept
@@ -115,6 +115,62 @@ public:
         }
     }
 
+    /** Processes the input and output samples supplied in the processing context, with
+        a cutoff frequency for every sample, for modulating the filter at audio rate.
+
+        The array must hold one frequency in Hz for each sample in the block, which is
+        shared by all the channels, and replaces the smoothing of the cutoff. The filter
+        coefficients are calculated for a short run of samples at a time using
+        FastMathApproximations::exp2, and then the run is filtered with them, so nothing
+        is allocated and there's no call to std::exp for each sample.
+
+        Afterwards the cutoff frequency is left at the last one in the array.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const SampleType* cutoffFrequencies) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= getNumChannels());
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (numSamples == 0)
+            return;
+
+        if (! enabled || context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+        }
+        else
+        {
+            constexpr size_t runLength = 64;
+            SampleType cutoffTransforms[runLength];
+
+            for (size_t start = 0; start < numSamples; start += runLength)
+            {
+                const auto num = jmin (runLength, numSamples - start);
+                calculateCutoffTransforms (cutoffFrequencies + start, cutoffTransforms, num);
+
+                for (size_t n = 0; n < num; ++n)
+                {
+                    cutoffTransformValue = cutoffTransforms[n];
+                    scaledResonanceValue = scaledResonanceSmoother.getNextValue();
+
+                    for (size_t ch = 0; ch < numChannels; ++ch)
+                        outputBlock.getChannelPointer (ch)[start + n] = processSample (inputBlock.getChannelPointer (ch)[start + n], ch);
+                }
+            }
+        }
+
+        cutoffFreqHz = cutoffFrequencies[numSamples - 1];
+        updateCutoffFreq();
+        cutoffTransformSmoother.setCurrentAndTargetValue (cutoffTransformSmoother.getTargetValue());
+    }
+
 protected:
     //==============================================================================
     SampleType processSample (SampleType inputValue, size_t channelToUse) noexcept;
@@ -126,6 +182,7 @@ private:
     void setNumChannels (size_t newValue)   { state.resize (newValue); }
     void updateCutoffFreq() noexcept        { cutoffTransformSmoother.setTargetValue (std::exp (cutoffFreqHz * cutoffFreqScaler)); }
     void updateResonance() noexcept         { scaledResonanceSmoother.setTargetValue (jmap (resonance, SampleType (0.1), SampleType (1.0))); }
+    void calculateCutoffTransforms (const SampleType* cutoffs, SampleType* transforms, size_t numSamples) const noexcept;
 
     //==============================================================================
     SampleType drive, drive2, gain, gain2, comp;
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class LadderFilterTests  : public UnitTest
+{
+public:
+    LadderFilterTests()
+        : UnitTest ("LadderFilter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        for (auto mode : { LadderFilterMode::LPF12, LadderFilterMode::HPF24, LadderFilterMode::BPF24 })
+        {
+            beginTest ("A constant audio rate cutoff matches a fixed cutoff, mode " + String ((int) mode));
+            {
+                const ProcessSpec spec { 44100.0, 300, 2 };
+                LadderFilter<float> modulated, reference;
+
+                for (auto* filter : { &modulated, &reference })
+                {
+                    filter->setMode (mode);
+                    filter->setResonance (0.7f);
+                    filter->setDrive (2.0f);
+                    filter->setCutoffFrequencyHz (1500.0f);
+                    filter->prepare (spec);
+                }
+
+                AudioBuffer<float> output ((int) spec.numChannels, (int) spec.maximumBlockSize);
+                Random random (0x9abc);
+
+                for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                    for (int i = 0; i < output.getNumSamples(); ++i)
+                        output.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+                AudioBuffer<float> expected (output);
+                AudioBlock<float> outputBlock (output), expectedBlock (expected);
+                const std::vector<float> cutoffs (spec.maximumBlockSize, 1500.0f);
+
+                reference.process (ProcessContextReplacing<float> (expectedBlock));
+                modulated.process (ProcessContextReplacing<float> (outputBlock), cutoffs.data());
+
+                for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                    for (int i = 0; i < output.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), 1.0e-4f);
+            }
+        }
+
+        beginTest ("Audio rate cutoff leaves the filter at the last cutoff");
+        {
+            const ProcessSpec spec { 44100.0, 256, 1 };
+            LadderFilter<float> modulated, reference;
+
+            for (auto* filter : { &modulated, &reference })
+                filter->prepare (spec);
+
+            AudioBuffer<float> output (1, 256);
+            output.clear();
+            AudioBlock<float> block (output);
+
+            std::vector<float> cutoffs (256);
+
+            for (size_t i = 0; i < cutoffs.size(); ++i)
+                cutoffs[i] = 200.0f + 10.0f * (float) i;
+
+            modulated.process (ProcessContextReplacing<float> (block), cutoffs.data());
+            reference.setCutoffFrequencyHz (cutoffs.back());
+            reference.reset();
+
+            output.setSample (0, 0, 1.0f);
+            AudioBuffer<float> expected (output);
+            AudioBlock<float> expectedBlock (expected);
+
+            modulated.reset();
+            modulated.process (ProcessContextReplacing<float> (block));
+            reference.process (ProcessContextReplacing<float> (expectedBlock));
+
+            for (int i = 0; i < 256; ++i)
+                expectWithinAbsoluteError (output.getSample (0, i), expected.getSample (0, i), 1.0e-6f);
+        }
+    }
+};
+
+static LadderFilterTests ladderFilterTests;
+
+} // namespace dsp
+} // namespace juce
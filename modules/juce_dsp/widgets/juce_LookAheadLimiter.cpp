@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+LookAheadLimiter<SampleType>::LookAheadLimiter()
+{
+    update();
+}
+
+//==============================================================================
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::setThreshold (SampleType newThreshold)
+{
+    thresholddB = newThreshold;
+    update();
+}
+
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::setRelease (SampleType newRelease)
+{
+    releaseTime = newRelease;
+    update();
+}
+
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::setLookAhead (SampleType newLookAhead)
+{
+    jassert (newLookAhead >= static_cast<SampleType> (0.0));
+
+    lookAheadTime = newLookAhead;
+    update();
+
+    if (numChannels > 0)
+    {
+        resizeBuffers();
+        reset();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = (int) spec.numChannels;
+
+    peaks.resize ((size_t) spec.maximumBlockSize);
+
+    update();
+    resizeBuffers();
+    reset();
+}
+
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::reset()
+{
+    delayBuffer.clear();
+    std::fill (gainHistory.begin(), gainHistory.end(), static_cast<SampleType> (1.0));
+
+    gainSum = (double) windowLength;
+    gain = static_cast<SampleType> (1.0);
+    time = 0;
+    position = queueStart = queueSize = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType LookAheadLimiter<SampleType>::processPeak (SampleType peak) noexcept
+{
+    // Sliding maximum over the window, kept as a queue of the peaks that are
+    // louder than every peak after them
+    if (queueSize > 0 && queuedPeakTimes[(size_t) queueStart] <= time - windowLength)
+    {
+        queueStart = (queueStart + 1) % windowLength;
+        --queueSize;
+    }
+
+    while (queueSize > 0)
+    {
+        const auto last = (queueStart + queueSize - 1) % windowLength;
+
+        if (queuedPeaks[(size_t) last] > peak)
+            break;
+
+        --queueSize;
+    }
+
+    const auto next = (queueStart + queueSize) % windowLength;
+    queuedPeaks[(size_t) next] = peak;
+    queuedPeakTimes[(size_t) next] = time;
+    ++queueSize;
+    ++time;
+
+    const auto windowPeak = queuedPeaks[(size_t) queueStart];
+    const auto target = windowPeak > threshold ? threshold / windowPeak : static_cast<SampleType> (1.0);
+
+    // Moving average of the held gain, so that it has reached the target by the
+    // time the peak comes out of the delay
+    gainSum += (double) target - (double) gainHistory[(size_t) position];
+    gainHistory[(size_t) position] = target;
+
+    if (++position == windowLength)
+    {
+        position = 0;
+        gainSum = std::accumulate (gainHistory.begin(), gainHistory.end(), 0.0);
+    }
+
+    const auto smoothed = static_cast<SampleType> (gainSum / windowLength);
+
+    // Release
+    gain = smoothed < gain ? smoothed : smoothed + releaseCoefficient * (gain - smoothed);
+    return gain;
+}
+
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::processBlock (const AudioBlock<const SampleType>& inputBlock,
+                                                 const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    const auto numBlockChannels = outputBlock.getNumChannels();
+    const auto numSamples       = outputBlock.getNumSamples();
+    const auto maxRunLength     = peaks.size();
+
+    jassert (maxRunLength > 0); // Make sure you call prepare() before processing!
+    jassert (numBlockChannels <= (size_t) numChannels);
+
+    for (size_t start = 0; start < numSamples; start += maxRunLength)
+    {
+        const auto num = jmin (maxRunLength, numSamples - start);
+        auto* runPeaks = peaks.data();
+
+        FloatVectorOperations::abs (runPeaks, inputBlock.getChannelPointer (0) + start, num);
+
+        for (size_t channel = 1; channel < numBlockChannels; ++channel)
+        {
+            const auto* input = inputBlock.getChannelPointer (channel) + start;
+
+            for (size_t i = 0; i < num; ++i)
+                runPeaks[i] = jmax (runPeaks[i], std::abs (input[i]));
+        }
+
+        const auto runStart = position;
+
+        for (size_t i = 0; i < num; ++i)
+            runPeaks[i] = processPeak (runPeaks[i]);
+
+        for (size_t channel = 0; channel < numBlockChannels; ++channel)
+        {
+            const auto* input = inputBlock.getChannelPointer (channel) + start;
+            auto* output = outputBlock.getChannelPointer (channel) + start;
+            auto* delay = delayBuffer.getWritePointer ((int) channel);
+            auto writePosition = runStart;
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                delay[writePosition] = input[i];
+
+                if (++writePosition == windowLength)
+                    writePosition = 0;
+
+                output[i] = delay[writePosition] * runPeaks[i];
+            }
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::update()
+{
+    threshold = Decibels::decibelsToGain (thresholddB, static_cast<SampleType> (-200.0));
+    windowLength = roundToInt (lookAheadTime * sampleRate / 1000.0) + 1;
+
+    releaseCoefficient = releaseTime < static_cast<SampleType> (1.0e-3)
+                           ? static_cast<SampleType> (0.0)
+                           : static_cast<SampleType> (std::exp (-2.0 * MathConstants<double>::pi * 1000.0 / (sampleRate * releaseTime)));
+}
+
+template <typename SampleType>
+void LookAheadLimiter<SampleType>::resizeBuffers()
+{
+    delayBuffer.setSize (numChannels, windowLength);
+    gainHistory.resize ((size_t) windowLength);
+    queuedPeaks.resize ((size_t) windowLength);
+    queuedPeakTimes.resize ((size_t) windowLength);
+}
+
+//==============================================================================
+template class LookAheadLimiter<float>;
+template class LookAheadLimiter<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A brickwall limiter that looks ahead at the signal, so that it can turn the gain
+    down smoothly before a peak arrives rather than clipping it.
+
+    The signal is delayed by the look-ahead time, and the gain needed to keep each
+    sample under the threshold is held over the look-ahead window with a sliding
+    maximum, then ramped in with a moving average of the same length. Both of these
+    take constant time per sample however long the window is. After a peak has
+    passed the gain recovers at the release rate.
+
+    The same gain is applied to every channel, so the stereo image doesn't shift.
+    The output is delayed by getLatencyInSamples() samples.
+
+    @see Limiter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class LookAheadLimiter
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    LookAheadLimiter();
+
+    //==============================================================================
+    /** Sets the threshold in dB of the limiter. The output never goes above it. */
+    void setThreshold (SampleType newThreshold);
+
+    /** Sets the release time in milliseconds of the limiter. */
+    void setRelease (SampleType newRelease);
+
+    /** Sets the look-ahead time in milliseconds of the limiter.
+
+        This changes the latency of the limiter, and if it's called after prepare()
+        it allocates memory and resets the limiter, so don't call it while processing.
+    */
+    void setLookAhead (SampleType newLookAhead);
+
+    /** Returns the delay that the limiter adds to the signal, in samples. */
+    int getLatencyInSamples() const noexcept        { return windowLength - 1; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset();
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void update();
+    void resizeBuffers();
+    void processBlock (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&) noexcept;
+    SampleType processPeak (SampleType peak) noexcept;
+
+    //==============================================================================
+    AudioBuffer<SampleType> delayBuffer;
+    std::vector<SampleType> peaks, gainHistory, queuedPeaks;
+    std::vector<int64> queuedPeakTimes;
+    double gainSum = 0.0;
+    int64 time = 0;
+    int windowLength = 1, position = 0, queueStart = 0, queueSize = 0;
+    SampleType threshold = 1.0, releaseCoefficient = 0.0, gain = 1.0;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    SampleType thresholddB = 0.0, releaseTime = 100.0, lookAheadTime = 5.0;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class LookAheadLimiterTest  : public UnitTest
+{
+public:
+    LookAheadLimiterTest()
+        : UnitTest ("LookAheadLimiter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The output never goes above the threshold");
+        {
+            testCeiling<float>();
+            testCeiling<double>();
+        }
+
+        beginTest ("Quiet signals are only delayed");
+        {
+            LookAheadLimiter<float> limiter;
+            limiter.setThreshold (-6.0f);
+            limiter.prepare ({ sampleRate, blockSize, 1 });
+
+            const auto latency = limiter.getLatencyInSamples();
+            expectEquals (latency, roundToInt (0.005 * sampleRate));
+
+            AudioBuffer<float> buffer (1, 1000);
+            buffer.clear();
+            buffer.setSample (0, 10, 0.25f);
+            process (limiter, buffer);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectEquals (buffer.getSample (0, i), i == 10 + latency ? 0.25f : 0.0f);
+        }
+
+        beginTest ("The gain is ramped down before a peak arrives");
+        {
+            LookAheadLimiter<float> limiter;
+            limiter.prepare ({ sampleRate, blockSize, 1 });
+
+            const auto latency = limiter.getLatencyInSamples();
+            const auto peakPosition = 2000;
+
+            AudioBuffer<float> buffer (1, 4000);
+            buffer.clear();
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (0, i, i == peakPosition ? 4.0f : 0.5f);
+
+            process (limiter, buffer);
+
+            expectWithinAbsoluteError (buffer.getSample (0, peakPosition + latency), 1.0f, 1.0e-5f);
+
+            // The gain should fall steadily across the look-ahead window, rather than jump
+            for (int i = peakPosition + 1; i < peakPosition + latency; ++i)
+            {
+                expectLessOrEqual (buffer.getSample (0, i), buffer.getSample (0, i - 1));
+                expectGreaterThan (buffer.getSample (0, i), 0.12f);
+            }
+        }
+
+        beginTest ("The channels share one gain");
+        {
+            LookAheadLimiter<float> limiter;
+            limiter.prepare ({ sampleRate, blockSize, 2 });
+
+            AudioBuffer<float> buffer (2, 2000);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                buffer.setSample (0, i, 2.0f);
+                buffer.setSample (1, i, 0.5f);
+            }
+
+            process (limiter, buffer);
+
+            const auto end = buffer.getNumSamples() - 1;
+            expectWithinAbsoluteError (buffer.getSample (0, end), 1.0f, 1.0e-5f);
+            expectWithinAbsoluteError (buffer.getSample (1, end), 0.25f, 1.0e-5f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr uint32 blockSize = 256;
+
+    template <typename SampleType>
+    static void process (LookAheadLimiter<SampleType>& limiter, AudioBuffer<SampleType>& buffer)
+    {
+        AudioBlock<SampleType> block (buffer);
+
+        for (size_t i = 0; i < block.getNumSamples(); i += blockSize)
+        {
+            auto subBlock = block.getSubBlock (i, jmin ((size_t) blockSize, block.getNumSamples() - i));
+            limiter.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+    }
+
+    template <typename SampleType>
+    void testCeiling()
+    {
+        LookAheadLimiter<SampleType> limiter;
+        limiter.setThreshold ((SampleType) -3.0);
+        limiter.setRelease ((SampleType) 50.0);
+        limiter.setLookAhead ((SampleType) 2.0);
+        limiter.prepare ({ sampleRate, blockSize, 2 });
+
+        AudioBuffer<SampleType> buffer (2, 44100);
+        Random random (0x4321);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                // Bursts of loud noise, with sparse spikes in between
+                const auto loud = (i / 4000) % 2 == 0;
+                const auto level = loud ? 4.0f : (random.nextInt (500) == 0 ? 8.0f : 0.1f);
+                buffer.setSample (channel, i, (SampleType) (level * (random.nextFloat() * 2.0f - 1.0f)));
+            }
+        }
+
+        process (limiter, buffer);
+
+        const auto ceiling = Decibels::decibelsToGain ((SampleType) -3.0) * (SampleType) 1.0001;
+        expectLessOrEqual (buffer.getMagnitude (0, buffer.getNumSamples()), ceiling);
+        expectGreaterThan (buffer.getMagnitude (0, buffer.getNumSamples()), ceiling * (SampleType) 0.9);
+    }
+};
+
+static LookAheadLimiterTest lookAheadLimiterTest;
+
+} // namespace dsp
+} // namespace juce
@@ -69,6 +69,12 @@ void NoiseGate<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void NoiseGate<SampleType>::setChannelsLinked (bool shouldBeLinked)
+{
+    channelsLinked = shouldBeLinked;
+}
+
 //==============================================================================
 template <typename SampleType>
 void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
@@ -81,6 +87,8 @@ void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
     RMSFilter.prepare (spec);
     envelopeFilter.prepare (spec);
 
+    gains.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+
     update();
     reset();
 }
@@ -110,12 +118,28 @@ SampleType NoiseGate<SampleType>::processSample (int channel, SampleType sample)
     return gain * sample;
 }
 
+template <typename SampleType>
+void NoiseGate<SampleType>::processBlock (const AudioBlock<const SampleType>& inputBlock,
+                                          const AudioBlock<SampleType>& outputBlock,
+                                          const AudioBlock<const SampleType>& sidechainBlock) noexcept
+{
+    detail::processDynamics (inputBlock, outputBlock, sidechainBlock, gains, channelsLinked,
+                             [this] (const AudioBlock<const SampleType>& sidechain, const AudioBlock<SampleType>& gainBlock)
+    {
+        RMSFilter.processBlock (sidechain, gainBlock);
+        envelopeFilter.processBlock (gainBlock, gainBlock);
+        detail::applyGainCurve (gainBlock, thresholdLog2, gainSlope);
+    });
+}
+
 template <typename SampleType>
 void NoiseGate<SampleType>::update()
 {
     threshold = Decibels::decibelsToGain (thresholddB, static_cast<SampleType> (-200.0));
     thresholdInverse = static_cast<SampleType> (1.0) / threshold;
     currentRatio = ratio;
+    thresholdLog2 = std::log2 (threshold);
+    gainSlope = currentRatio - static_cast<SampleType> (1.0);
 
     envelopeFilter.setAttackTime  (attackTime);
     envelopeFilter.setReleaseTime (releaseTime);
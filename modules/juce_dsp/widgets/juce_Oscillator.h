@@ -79,6 +79,23 @@ public:
         }
     }
 
+    /** Initialises the oscillator with an approximation of a waveform.
+
+        The approximation should cover the inputs from -pi to pi, which it will then
+        be evaluated over without needing a lookup table.
+
+        @see PolynomialApproximation
+    */
+    template <size_t Order, size_t NumSegments>
+    void initialise (const PolynomialApproximation<NumericType, Order, NumSegments>& approximation)
+    {
+        jassert (approximation.getMinimumInputValue() <= -MathConstants<NumericType>::pi
+                  && approximation.getMaximumInputValue() >= MathConstants<NumericType>::pi);
+
+        lookupTable.reset();
+        generator = approximation;
+    }
+
     //==============================================================================
     /** Sets the frequency of the oscillator. */
     void setFrequency (NumericType newFrequency, bool force = false) noexcept
@@ -0,0 +1,367 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace OscillatorBankHelpers
+{
+    // Each table keeps the harmonics up to this number, halving with every octave
+    static size_t getNumHarmonicsForLevel (size_t tableSize, size_t level) noexcept
+    {
+        return level == 0 ? tableSize / 2 - 1 : (tableSize / 2) >> level;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+OscillatorBank<SampleType>::OscillatorBank (size_t numOscillators)
+    : silence (tableSize + 1)
+{
+    setNumOscillators (numOscillators);
+    prepare ({ sampleRate, 512, 1 });
+}
+
+//==============================================================================
+template <typename SampleType>
+void OscillatorBank<SampleType>::setNumOscillators (size_t newNumOscillators)
+{
+    oscillators.resize (newNumOscillators);
+    groups.resize ((newNumOscillators + numLanes - 1) / numLanes);
+    parametersChanged = true;
+
+    for (auto& group : groups)
+        for (auto& table : group.laneTables)
+            if (table == nullptr)
+                table = silence.data();
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::setMode (Mode newMode) noexcept
+{
+    if (mode == newMode)
+        return;
+
+    // Carry the phases over into the other mode's representation
+    for (auto& group : groups)
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            setLanePhase (group, lane, getLanePhase (group, lane));
+
+    mode = newMode;
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::setWavetable (const std::function<SampleType (SampleType)>& function)
+{
+    const auto size = (int) tableSize;
+    std::vector<Complex<float>> timeDomain (tableSize), spectrum (tableSize), levelSpectrum (tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+    {
+        const auto x = MathConstants<SampleType>::twoPi * (SampleType) i / (SampleType) tableSize
+                         - MathConstants<SampleType>::pi;
+        timeDomain[i] = (float) function (x);
+    }
+
+    FFT fft (tableOrder);
+    fft.perform (timeDomain.data(), spectrum.data(), false);
+
+    // Each level has an extra sample at the end, so that interpolation doesn't need to wrap
+    tables.assign (numTableLevels * (tableSize + 1), SampleType());
+
+    for (size_t level = 0; level < numTableLevels; ++level)
+    {
+        const auto numHarmonics = (int) OscillatorBankHelpers::getNumHarmonicsForLevel (tableSize, level);
+
+        for (int bin = 0; bin < size; ++bin)
+            levelSpectrum[(size_t) bin] = (bin <= numHarmonics || bin >= size - numHarmonics) ? spectrum[(size_t) bin]
+                                                                                            : Complex<float>();
+
+        fft.perform (levelSpectrum.data(), timeDomain.data(), true);
+
+        auto* table = tables.data() + level * (tableSize + 1);
+
+        for (size_t i = 0; i < tableSize; ++i)
+            table[i] = (SampleType) timeDomain[i].real();
+
+        table[tableSize] = table[0];
+    }
+
+    for (auto& osc : oscillators)
+        osc.changed = true;
+
+    parametersChanged = true;
+}
+
+//==============================================================================
+template <typename SampleType>
+void OscillatorBank<SampleType>::setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept
+{
+    // Frequencies can't be negative!
+    jassert (newFrequency >= 0);
+
+    auto& osc = oscillators[oscillatorIndex];
+    osc.frequency = jmax (SampleType(), newFrequency);
+    osc.changed = true;
+    parametersChanged = true;
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept
+{
+    auto& osc = oscillators[oscillatorIndex];
+    osc.phase = newPhase;
+    osc.changed = osc.phaseChanged = true;
+    parametersChanged = true;
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::setAmplitude (size_t oscillatorIndex, SampleType newAmplitude) noexcept
+{
+    auto& osc = oscillators[oscillatorIndex];
+    osc.amplitude = newAmplitude;
+    osc.changed = true;
+    parametersChanged = true;
+}
+
+//==============================================================================
+template <typename SampleType>
+void OscillatorBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    sampleRate = (SampleType) spec.sampleRate;
+
+    const auto maxBlockSize = jmax ((size_t) 1, (size_t) spec.maximumBlockSize);
+    accumulator.resize (maxBlockSize);
+    mix.resize (maxBlockSize);
+
+    for (auto& osc : oscillators)
+        osc.changed = true;
+
+    reset();
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::reset() noexcept
+{
+    for (auto& osc : oscillators)
+        osc.changed = osc.phaseChanged = true;
+
+    parametersChanged = true;
+}
+
+//==============================================================================
+template <typename SampleType>
+const SampleType* OscillatorBank<SampleType>::getTableForIncrement (SampleType cyclesPerSample) const noexcept
+{
+    if (tables.empty() || cyclesPerSample >= (SampleType) 0.5)
+        return silence.data();
+
+    // Find the first table whose highest harmonic stays below the Nyquist frequency
+    for (size_t level = 0; level < numTableLevels; ++level)
+        if ((SampleType) OscillatorBankHelpers::getNumHarmonicsForLevel (tableSize, level) * cyclesPerSample < (SampleType) 0.5)
+            return tables.data() + level * (tableSize + 1);
+
+    return silence.data();
+}
+
+template <typename SampleType>
+SampleType OscillatorBank<SampleType>::getLanePhase (const Group& group, size_t lane) const noexcept
+{
+    using namespace detail;
+
+    if (mode == Mode::wavetable)
+        return getLane (group.phase, lane);
+
+    // In sine mode, the phasor holds the angle passed to the waveform, which runs from -pi to pi
+    const auto angle = std::atan2 (getLane (group.sine, lane), getLane (group.cosine, lane));
+    const auto cycles = (angle + MathConstants<SampleType>::pi) / MathConstants<SampleType>::twoPi;
+    return cycles - std::floor (cycles);
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::setLanePhase (Group& group, size_t lane, SampleType cycles) noexcept
+{
+    using namespace detail;
+
+    cycles -= std::floor (cycles);
+    const auto angle = MathConstants<SampleType>::twoPi * cycles - MathConstants<SampleType>::pi;
+
+    setLane (group.phase, lane, cycles);
+    setLane (group.cosine, lane, std::cos (angle));
+    setLane (group.sine, lane, std::sin (angle));
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::updateGroups() noexcept
+{
+    using namespace detail;
+
+    for (size_t index = 0; index < groups.size() * numLanes; ++index)
+    {
+        auto& group = groups[index / numLanes];
+        const auto lane = index % numLanes;
+
+        if (index >= oscillators.size())
+        {
+            // Unused lanes in the last group stay silent
+            setLane (group.amplitude, lane, SampleType());
+            setLane (group.increment, lane, SampleType());
+            setLane (group.cosStep, lane, (SampleType) 1);
+            setLane (group.sinStep, lane, SampleType());
+            setLanePhase (group, lane, SampleType());
+            group.laneTables[lane] = silence.data();
+            continue;
+        }
+
+        auto& osc = oscillators[index];
+
+        if (! osc.changed)
+            continue;
+
+        const auto increment = osc.frequency / sampleRate;
+        const auto isAudible = increment < (SampleType) 0.5;
+
+        setLane (group.amplitude, lane, isAudible ? osc.amplitude : SampleType());
+        setLane (group.increment, lane, isAudible ? increment : SampleType());
+        setLane (group.cosStep, lane, isAudible ? std::cos (MathConstants<SampleType>::twoPi * increment) : (SampleType) 1);
+        setLane (group.sinStep, lane, isAudible ? std::sin (MathConstants<SampleType>::twoPi * increment) : SampleType());
+        group.laneTables[lane] = getTableForIncrement (increment);
+
+        if (osc.phaseChanged)
+            setLanePhase (group, lane, osc.phase / MathConstants<SampleType>::twoPi);
+
+        osc.changed = osc.phaseChanged = false;
+    }
+
+    parametersChanged = false;
+}
+
+//==============================================================================
+template <typename SampleType>
+void OscillatorBank<SampleType>::render (size_t numSamples) noexcept
+{
+    jassert (numSamples <= accumulator.size());
+
+    if (parametersChanged)
+        updateGroups();
+
+    std::fill (accumulator.begin(), accumulator.begin() + (std::ptrdiff_t) numSamples, Vector());
+
+    for (auto& group : groups)
+    {
+        if (mode == Mode::sine)
+            renderSines (group, numSamples);
+        else
+            renderWavetables (group, numSamples);
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+        mix[i] = detail::sum (accumulator[i]);
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::renderSines (Group& group, size_t numSamples) noexcept
+{
+    const auto amplitude = group.amplitude, cosStep = group.cosStep, sinStep = group.sinStep;
+    auto cosine = group.cosine, sine = group.sine;
+    auto* acc = accumulator.data();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        acc[i] += amplitude * sine;
+
+        const auto nextCosine = (cosine * cosStep) - (sine * sinStep);
+        sine = (sine * cosStep) + (cosine * sinStep);
+        cosine = nextCosine;
+    }
+
+    // Rounding errors make the phasor's length drift, so pull it back towards 1
+    const auto gain = ((cosine * cosine) + (sine * sine)) * (SampleType) -0.5 + (SampleType) 1.5;
+    group.cosine = cosine * gain;
+    group.sine = sine * gain;
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::renderWavetables (Group& group, size_t numSamples) noexcept
+{
+    using namespace detail;
+
+    const auto amplitude = group.amplitude, increment = group.increment;
+    auto phase = group.phase;
+    auto* acc = accumulator.data();
+
+    alignas (sizeof (Vector)) SampleType positions[numLanes], fractions[numLanes], first[numLanes], second[numLanes];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        store (phase * (SampleType) tableSize, positions);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto index = (size_t) positions[lane];
+            const auto* table = group.laneTables[lane] + index;
+
+            fractions[lane] = positions[lane] - (SampleType) index;
+            first[lane]  = table[0];
+            second[lane] = table[1];
+        }
+
+        const auto a = load<Vector> (first), b = load<Vector> (second);
+        acc[i] += amplitude * (a + load<Vector> (fractions) * (b - a));
+
+        phase += increment;
+        phase -= truncate (phase);
+    }
+
+    group.phase = phase;
+}
+
+template <typename SampleType>
+void OscillatorBank<SampleType>::skip (size_t numSamples) noexcept
+{
+    using namespace detail;
+
+    if (parametersChanged)
+        updateGroups();
+
+    for (auto& group : groups)
+    {
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto cycles = getLane (group.increment, lane) * (SampleType) numSamples;
+            setLanePhase (group, lane, getLanePhase (group, lane) + cycles - std::floor (cycles));
+        }
+    }
+}
+
+//==============================================================================
+template class OscillatorBank<float>;
+template class OscillatorBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Generates the sum of a large number of oscillators, each with its own frequency,
+    phase and amplitude.
+
+    Unlike running many Oscillator objects, the bank processes its oscillators in
+    groups that fill the lanes of a SIMDRegister, and never calls through a
+    std::function while rendering. This makes it suitable for additive synthesis
+    with thousands of partials.
+
+    The bank has two modes:
+    - In sine mode, each oscillator is a sine wave generated by rotating a phasor
+      by a fixed angle every sample, so no tables or trigonometric functions are
+      needed.
+    - In wavetable mode, each oscillator reads from a band-limited, mip-mapped copy
+      of the waveform passed to setWavetable(). The table that's used depends on the
+      oscillator's frequency, so that none of its harmonics are above the Nyquist
+      frequency.
+
+    In both modes, oscillators whose frequency is at or above the Nyquist frequency
+    are silent.
+
+    The generated signal is added to every channel of the input, in the same way
+    as the Oscillator class.
+
+    Changes to the frequency, phase and amplitude of the oscillators take effect
+    at the start of the next call to process(). None of the setter methods are
+    thread-safe, so they should be called on the same thread as process().
+
+    @see Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class OscillatorBank
+{
+public:
+    //==============================================================================
+    /** The ways in which the bank can generate its oscillators. */
+    enum class Mode
+    {
+        sine,       /**< Each oscillator is a sine wave, generated with a recursive rotation. */
+        wavetable   /**< Each oscillator plays a band-limited version of the wavetable. */
+    };
+
+    //==============================================================================
+    /** Creates a bank of sine oscillators.
+
+        All the oscillators initially have a frequency and amplitude of zero.
+    */
+    explicit OscillatorBank (size_t numOscillators = 0);
+
+    //==============================================================================
+    /** Changes the number of oscillators.
+
+        Any new oscillators have a frequency and amplitude of zero. This allocates,
+        so it shouldn't be called on the audio thread.
+    */
+    void setNumOscillators (size_t newNumOscillators);
+
+    /** Returns the number of oscillators in the bank. */
+    size_t getNumOscillators() const noexcept               { return oscillators.size(); }
+
+    //==============================================================================
+    /** Changes the way in which the oscillators are generated.
+
+        The oscillators carry on from their current phases.
+    */
+    void setMode (Mode newMode) noexcept;
+
+    /** Returns the mode that the bank is using. */
+    Mode getMode() const noexcept                           { return mode; }
+
+    /** Sets the waveform used in wavetable mode.
+
+        The function should return one cycle of the waveform for inputs from -pi to
+        pi, in the same way as the function passed to an Oscillator. It's sampled
+        once to create a table for each octave, each containing only the harmonics
+        that can be played in that octave without aliasing.
+
+        This allocates and runs several FFTs, so it shouldn't be called on the audio
+        thread.
+    */
+    void setWavetable (const std::function<SampleType (SampleType)>& function);
+
+    /** Returns true if setWavetable() has been called. */
+    bool hasWavetable() const noexcept                      { return ! tables.empty(); }
+
+    //==============================================================================
+    /** Sets the frequency of one of the oscillators, in Hz. */
+    void setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept;
+
+    /** Sets the phase of one of the oscillators, in radians. */
+    void setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept;
+
+    /** Sets the gain of one of the oscillators. */
+    void setAmplitude (size_t oscillatorIndex, SampleType newAmplitude) noexcept;
+
+    /** Returns the frequency of one of the oscillators. */
+    SampleType getFrequency (size_t oscillatorIndex) const noexcept     { return oscillators[oscillatorIndex].frequency; }
+
+    /** Returns the gain of one of the oscillators. */
+    SampleType getAmplitude (size_t oscillatorIndex) const noexcept     { return oscillators[oscillatorIndex].amplitude; }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Moves all the oscillators back to the phases last passed to setPhase(). */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels      = outputBlock.getNumChannels();
+        const auto numInputChannels = inputBlock.getNumChannels();
+        const auto numSamples       = outputBlock.getNumSamples();
+
+        if (context.isBypassed)
+        {
+            outputBlock.clear();
+            skip (numSamples);
+            return;
+        }
+
+        const auto maxChunkSize = mix.size();
+
+        for (size_t start = 0; start < numSamples; start += maxChunkSize)
+        {
+            const auto chunkSize = jmin (maxChunkSize, numSamples - start);
+            render (chunkSize);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* dst = outputBlock.getChannelPointer (channel) + start;
+
+                if (channel < numInputChannels)
+                {
+                    const auto* src = inputBlock.getChannelPointer (channel) + start;
+
+                    for (size_t i = 0; i < chunkSize; ++i)
+                        dst[i] = src[i] + mix[i];
+                }
+                else
+                {
+                    std::copy (mix.begin(), mix.begin() + (std::ptrdiff_t) chunkSize, dst);
+                }
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr size_t numLanes = 1;
+   #endif
+
+    static constexpr int tableOrder = 11;
+    static constexpr size_t tableSize = (size_t) 1 << tableOrder;
+    static constexpr size_t numTableLevels = (size_t) tableOrder;
+
+    struct OscillatorParameters
+    {
+        SampleType frequency = 0, amplitude = 0, phase = 0;
+        bool changed = true, phaseChanged = true;
+    };
+
+    // The state of numLanes oscillators, held in the lanes of each register
+    struct Group
+    {
+        Vector amplitude, phase, increment;     // wavetable mode, with the phase in cycles
+        Vector cosine, sine, cosStep, sinStep;  // sine mode
+        const SampleType* laneTables[numLanes] {};
+    };
+
+    //==============================================================================
+    void render (size_t numSamples) noexcept;
+    void skip (size_t numSamples) noexcept;
+    void renderSines (Group&, size_t numSamples) noexcept;
+    void renderWavetables (Group&, size_t numSamples) noexcept;
+    void updateGroups() noexcept;
+    const SampleType* getTableForIncrement (SampleType cyclesPerSample) const noexcept;
+    SampleType getLanePhase (const Group&, size_t lane) const noexcept;
+    static void setLanePhase (Group&, size_t lane, SampleType cycles) noexcept;
+
+    //==============================================================================
+    std::vector<OscillatorParameters> oscillators;
+    std::vector<Group> groups;
+    std::vector<Vector> accumulator;
+    std::vector<SampleType> mix, tables, silence;
+    SampleType sampleRate = 44100;
+    Mode mode = Mode::sine;
+    bool parametersChanged = true;
+
+    JUCE_LEAK_DETECTOR (OscillatorBank)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class OscillatorBankTest  : public UnitTest
+{
+public:
+    OscillatorBankTest()
+        : UnitTest ("Oscillator Bank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Sine mode matches a sum of sine waves");
+        {
+            testAgainstReference<float>  (OscillatorBank<float>::Mode::sine, 1.0e-3);
+            testAgainstReference<double> (OscillatorBank<double>::Mode::sine, 1.0e-8);
+        }
+
+        beginTest ("Wavetable mode with a sine table matches a sum of sine waves");
+        {
+            testAgainstReference<float>  (OscillatorBank<float>::Mode::wavetable, 1.0e-3);
+            testAgainstReference<double> (OscillatorBank<double>::Mode::wavetable, 1.0e-5);
+        }
+
+        beginTest ("Wavetables only contain the harmonics that fit below the Nyquist frequency");
+        {
+            OscillatorBank<float> bank (2);
+            bank.setWavetable ([] (float x) { return x / MathConstants<float>::pi; });
+            bank.setMode (OscillatorBank<float>::Mode::wavetable);
+            bank.prepare ({ sampleRate, 256, 1 });
+
+            // At this frequency only the fundamental of the sawtooth can be played
+            bank.setFrequency (0, 15000.0f);
+            bank.setAmplitude (0, 1.0f);
+
+            // ...and this oscillator is above the Nyquist frequency, so should be silent
+            bank.setFrequency (1, 30000.0f);
+            bank.setAmplitude (1, 1.0f);
+
+            const auto output = render (bank, 1024);
+            const auto fundamentalGain = 2.0 / MathConstants<double>::pi;
+            auto maxError = 0.0;
+
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                const auto expected = fundamentalGain * std::sin (getAngle (15000.0, 0.0, i));
+                maxError = jmax (maxError, std::abs ((double) output[i] - expected));
+            }
+
+            expectLessThan (maxError, 5.0e-3);
+        }
+
+        beginTest ("Oscillators carry on from the same phase when the mode changes");
+        {
+            OscillatorBank<double> bank (3);
+            bank.setWavetable ([] (double x) { return std::sin (x); });
+            bank.prepare ({ sampleRate, 64, 1 });
+
+            const double frequencies[] { 100.0, 1234.5, 5000.0 };
+
+            for (size_t i = 0; i < 3; ++i)
+            {
+                bank.setFrequency (i, frequencies[i]);
+                bank.setAmplitude (i, 0.5);
+            }
+
+            auto output = render (bank, 300);
+            bank.setMode (OscillatorBank<double>::Mode::wavetable);
+            const auto second = render (bank, 300);
+            output.insert (output.end(), second.begin(), second.end());
+
+            auto maxError = 0.0;
+
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                auto expected = 0.0;
+
+                for (const auto frequency : frequencies)
+                    expected += 0.5 * std::sin (getAngle (frequency, 0.0, i));
+
+                maxError = jmax (maxError, std::abs (output[i] - expected));
+            }
+
+            expectLessThan (maxError, 1.0e-5);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+
+    // The bank passes the same angles to its waveform as an Oscillator does, running from -pi to pi
+    static double getAngle (double frequency, double phase, size_t sample)
+    {
+        return MathConstants<double>::twoPi * frequency * (double) sample / sampleRate + phase - MathConstants<double>::pi;
+    }
+
+    template <typename SampleType>
+    static std::vector<SampleType> render (OscillatorBank<SampleType>& bank, size_t numSamples, size_t blockSize = 64)
+    {
+        AudioBuffer<SampleType> buffer (1, (int) numSamples);
+        buffer.clear();
+
+        AudioBlock<SampleType> block (buffer);
+
+        for (size_t start = 0; start < numSamples; start += blockSize)
+        {
+            auto subBlock = block.getSubBlock (start, jmin (blockSize, numSamples - start));
+            bank.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+
+        return { buffer.getReadPointer (0), buffer.getReadPointer (0) + numSamples };
+    }
+
+    template <typename SampleType>
+    void testAgainstReference (typename OscillatorBank<SampleType>::Mode mode, double tolerance)
+    {
+        // More oscillators than fit in a register, so that the last group is partly used
+        constexpr size_t numOscillators = 11;
+        constexpr size_t numSamples = 4096;
+
+        OscillatorBank<SampleType> bank (numOscillators);
+        bank.setWavetable ([] (SampleType x) { return std::sin (x); });
+        bank.setMode (mode);
+        bank.prepare ({ sampleRate, 256, 2 });
+
+        Random random (0x1234);
+        std::vector<double> frequencies, phases, amplitudes;
+
+        for (size_t i = 0; i < numOscillators; ++i)
+        {
+            frequencies.push_back (20.0 + random.nextDouble() * 15000.0);
+            phases.push_back (random.nextDouble() * MathConstants<double>::twoPi);
+            amplitudes.push_back (random.nextDouble() * 0.2);
+
+            bank.setFrequency (i, (SampleType) frequencies.back());
+            bank.setPhase (i, (SampleType) phases.back());
+            bank.setAmplitude (i, (SampleType) amplitudes.back());
+        }
+
+        AudioBuffer<SampleType> buffer (2, (int) numSamples);
+        buffer.clear();
+        AudioBlock<SampleType> block (buffer);
+
+        for (size_t start = 0; start < numSamples; start += 256)
+        {
+            auto subBlock = block.getSubBlock (start, 256);
+            bank.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+
+        auto maxError = 0.0;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto expected = 0.0;
+
+            for (size_t osc = 0; osc < numOscillators; ++osc)
+                expected += amplitudes[osc] * std::sin (getAngle (frequencies[osc], phases[osc], i));
+
+            for (int channel = 0; channel < 2; ++channel)
+                maxError = jmax (maxError, std::abs ((double) buffer.getSample (channel, (int) i) - expected));
+        }
+
+        expectLessThan (maxError, tolerance);
+    }
+};
+
+static OscillatorBankTest oscillatorBankTest;
+
+} // namespace dsp
+} // namespace juce
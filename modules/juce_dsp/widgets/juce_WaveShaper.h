@@ -28,9 +28,25 @@ namespace juce
 namespace dsp
 {
 
+#ifndef DOXYGEN
+namespace detail
+{
+    template <typename Fn, typename FloatType, typename = void>
+    inline constexpr auto hasArrayProcess = false;
+
+    template <typename Fn, typename FloatType>
+    inline constexpr auto hasArrayProcess<Fn, FloatType, std::void_t<decltype (std::declval<const Fn&>().process (std::declval<const FloatType*>(),
+                                                                                                                  std::declval<FloatType*>(),
+                                                                                                                  size_t()))>> = true;
+}
+#endif
+
 /**
     Applies waveshaping to audio samples as single samples or AudioBlocks.
 
+    If the function can also process whole arrays of samples, like a
+    PolynomialApproximation, process() passes it a channel at a time.
+
     @tags{DSP}
 */
 template <typename FloatType, typename Function = FloatType (*) (FloatType)>
@@ -59,6 +75,19 @@ struct WaveShaper
             if (context.usesSeparateInputAndOutputBlocks())
                 context.getOutputBlock().copyFrom (context.getInputBlock());
         }
+        else if constexpr (detail::hasArrayProcess<Function, FloatType>)
+        {
+            auto&& inputBlock  = context.getInputBlock();
+            auto&& outputBlock = context.getOutputBlock();
+
+            jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+            jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+            for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+                functionToUse.process (inputBlock.getChannelPointer (channel),
+                                       outputBlock.getChannelPointer (channel),
+                                       outputBlock.getNumSamples());
+        }
         else
         {
             AudioBlock<FloatType>::process (context.getInputBlock(),
@@ -23,27 +23,199 @@
 namespace juce
 {
 
-class AsyncUpdater::AsyncUpdaterMessage  : public CallbackMessage
+class AsyncUpdater::AsyncUpdaterMessage  : public ReferenceCountedObject
 {
 public:
     AsyncUpdaterMessage (AsyncUpdater& au)  : owner (au) {}
 
-    void messageCallback() override
+    void deliver()
     {
         if (shouldDeliver.compareAndSetBool (0, 1))
+        {
+            lastCallbackTime = Time::getMillisecondCounter();
             owner.handleAsyncUpdate();
+        }
+    }
+
+    bool isRateLimited (uint32 now) const noexcept
+    {
+        auto interval = minimumInterval.load (std::memory_order_relaxed);
+        return interval > 0 && lastCallbackTime != 0 && now - lastCallbackTime < (uint32) interval;
+    }
+
+    uint32 getTimeWhenDue() const noexcept
+    {
+        return lastCallbackTime + (uint32) minimumInterval.load (std::memory_order_relaxed);
     }
 
     AsyncUpdater& owner;
     Atomic<int> shouldDeliver;
 
+    // These are used by the Dispatcher
+    std::atomic<bool> isQueued { false };
+    std::atomic<int> minimumInterval { 0 };
+    AsyncUpdaterMessage* nextPending = nullptr;
+    uint32 lastCallbackTime = 0;
+
     JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage)
 };
 
+//==============================================================================
+/*  Collects the updaters that have been triggered and services them all from a single
+    message. Triggered updaters are pushed onto a lock-free stack, and only the push that
+    finds the stack empty needs to post anything to the message queue.
+
+    Updaters with a minimum interval that get triggered too soon after their last
+    callback are held back, and a timer picks them up when they're due.
+*/
+class AsyncUpdater::Dispatcher  : private DeletedAtShutdown,
+                                  private Timer
+{
+public:
+    Dispatcher() = default;
+
+    ~Dispatcher() override
+    {
+        stopTimer();
+
+        for (auto* message = pending.exchange (nullptr); message != nullptr;)
+        {
+            auto* next = message->nextPending;
+            release (*message);
+            message->decReferenceCount();
+            message = next;
+        }
+
+        for (auto& message : deferred)
+            release (*message);
+
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (Dispatcher, false)
+
+    bool add (AsyncUpdaterMessage& message)
+    {
+        if (message.isQueued.exchange (true))
+            return true;
+
+        message.incReferenceCount();
+
+        auto* head = pending.load (std::memory_order_relaxed);
+
+        do
+        {
+            message.nextPending = head;
+        }
+        while (! pending.compare_exchange_weak (head, &message, std::memory_order_release, std::memory_order_relaxed));
+
+        return head != nullptr || dispatchMessage->post();
+    }
+
+private:
+    using MessagePtr = ReferenceCountedObjectPtr<AsyncUpdaterMessage>;
+
+    struct DispatchMessage  : public CallbackMessage
+    {
+        void messageCallback() override
+        {
+            if (auto* d = Dispatcher::getInstanceWithoutCreating())
+                d->dispatchPending();
+        }
+    };
+
+    // Once an updater has been taken off the queue, it can be triggered again, but
+    // this has to happen before checking whether to deliver it, so that a trigger
+    // that arrives in between can't get lost.
+    static void release (AsyncUpdaterMessage& message)
+    {
+        message.isQueued = false;
+        message.shouldDeliver.set (0);
+    }
+
+    static void deliver (AsyncUpdaterMessage& message)
+    {
+        message.isQueued = false;
+        message.deliver();
+    }
+
+    void dispatchPending()
+    {
+        // The stack holds the most recently triggered updater first, so this reverses it
+        // to make the callbacks in the order that the updaters were triggered.
+        std::vector<MessagePtr> messages;
+
+        for (auto* message = pending.exchange (nullptr, std::memory_order_acquire); message != nullptr;)
+        {
+            auto* next = message->nextPending;
+            messages.emplace_back (message);
+            message->decReferenceCountWithoutDeleting();
+            message = next;
+        }
+
+        const auto now = Time::getMillisecondCounter();
+
+        for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+        {
+            auto& message = **it;
+
+            if (message.isRateLimited (now))
+                deferred.push_back (*it);
+            else
+                deliver (message);
+        }
+
+        if (! deferred.empty() && ! isTimerRunning())
+            startTimerForDeferredUpdaters();
+    }
+
+    void timerCallback() override
+    {
+        stopTimer();
+
+        auto messages = std::exchange (deferred, {});
+        const auto now = Time::getMillisecondCounter();
+
+        for (auto& message : messages)
+        {
+            if (message->shouldDeliver.get() != 0 && message->isRateLimited (now))
+                deferred.push_back (message);
+            else
+                deliver (*message);
+        }
+
+        if (! deferred.empty())
+            startTimerForDeferredUpdaters();
+    }
+
+    void startTimerForDeferredUpdaters()
+    {
+        const auto now = Time::getMillisecondCounter();
+        auto delay = std::numeric_limits<int>::max();
+
+        for (auto& message : deferred)
+            delay = jmin (delay, (int) (message->getTimeWhenDue() - now));
+
+        startTimer (jmax (1, delay));
+    }
+
+    std::atomic<AsyncUpdaterMessage*> pending { nullptr };
+    std::vector<MessagePtr> deferred;
+    MessageManager::MessageBase::Ptr dispatchMessage { new DispatchMessage() };
+
+    JUCE_DECLARE_NON_COPYABLE (Dispatcher)
+};
+
+JUCE_IMPLEMENT_SINGLETON (AsyncUpdater::Dispatcher)
+
 //==============================================================================
 AsyncUpdater::AsyncUpdater()
 {
     activeMessage = *new AsyncUpdaterMessage (*this);
+
+    // Creating this here means that the first trigger, which may come from the audio
+    // thread, doesn't have to.
+    Dispatcher::getInstance();
 }
 
 AsyncUpdater::~AsyncUpdater()
@@ -66,7 +238,7 @@ void AsyncUpdater::triggerAsyncUpdate()
     JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
 
     if (activeMessage->shouldDeliver.compareAndSetBool (1, 0))
-        if (! activeMessage->post())
+        if (! Dispatcher::getInstance()->add (*activeMessage))
             cancelPendingUpdate(); // if the message queue fails, this avoids getting
                                    // trapped waiting for the message to arrive
 }
@@ -82,7 +254,10 @@ void AsyncUpdater::handleUpdateNowIfNeeded()
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
     if (activeMessage->shouldDeliver.exchange (0) != 0)
+    {
+        activeMessage->lastCallbackTime = Time::getMillisecondCounter();
         handleAsyncUpdate();
+    }
 }
 
 bool AsyncUpdater::isUpdatePending() const noexcept
@@ -90,4 +265,172 @@ bool AsyncUpdater::isUpdatePending() const noexcept
     return activeMessage->shouldDeliver.value != 0;
 }
 
+void AsyncUpdater::setMinimumUpdateInterval (int milliseconds) noexcept
+{
+    activeMessage->minimumInterval = jmax (0, milliseconds);
+}
+
+int AsyncUpdater::getMinimumUpdateInterval() const noexcept
+{
+    return activeMessage->minimumInterval;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && ! (JUCE_MAC || JUCE_IOS || JUCE_ANDROID)
+
+bool dispatchNextMessageOnSystemQueue (bool returnIfNoPendingMessages);
+
+class AsyncUpdaterTests  : public UnitTest
+{
+public:
+    AsyncUpdaterTests()
+        : UnitTest ("AsyncUpdater", UnitTestCategories::threads)
+    {
+        setIsolation (Isolation::messageThread);
+    }
+
+    struct CountingUpdater  : public AsyncUpdater
+    {
+        void handleAsyncUpdate() override
+        {
+            ++count;
+            callbackTimes.push_back (Time::getMillisecondCounter());
+        }
+
+        int count = 0;
+        std::vector<uint32> callbackTimes;
+    };
+
+    static bool dispatchUntil (std::function<bool()> condition, int timeoutMs = 5000)
+    {
+        for (auto end = Time::getMillisecondCounter() + (uint32) timeoutMs; Time::getMillisecondCounter() < end;)
+        {
+            if (condition())
+                return true;
+
+            if (! dispatchNextMessageOnSystemQueue (true))
+                Thread::sleep (1);
+        }
+
+        return condition();
+    }
+
+    void runTest() override
+    {
+        auto* mm = MessageManager::getInstance();
+
+        if (! mm->isThisTheMessageThread())
+            return;
+
+        beginTest ("Triggering, cancelling and flushing");
+        {
+            CountingUpdater updater;
+
+            updater.triggerAsyncUpdate();
+            updater.triggerAsyncUpdate();
+            expect (updater.isUpdatePending());
+            expect (dispatchUntil ([&] { return updater.count == 1; }));
+            expect (! updater.isUpdatePending());
+
+            updater.triggerAsyncUpdate();
+            updater.cancelPendingUpdate();
+            dispatchUntil ([] { return false; }, 50);
+            expectEquals (updater.count, 1);
+
+            updater.triggerAsyncUpdate();
+            updater.cancelPendingUpdate();
+            updater.triggerAsyncUpdate();
+            expect (dispatchUntil ([&] { return updater.count == 2; }));
+
+            updater.triggerAsyncUpdate();
+            updater.handleUpdateNowIfNeeded();
+            expectEquals (updater.count, 3);
+            dispatchUntil ([] { return false; }, 50);
+            expectEquals (updater.count, 3);
+        }
+
+        beginTest ("Many updaters triggered from another thread share a message");
+        {
+            constexpr int numUpdaters = 5000;
+            std::vector<std::unique_ptr<CountingUpdater>> updaters;
+
+            for (int i = 0; i < numUpdaters; ++i)
+                updaters.push_back (std::make_unique<CountingUpdater>());
+
+            // let anything that's already in the queue get delivered first
+            dispatchUntil ([] { return false; }, 20);
+            mm->resetQueueStatistics();
+
+            std::thread ([&]
+            {
+                for (auto& u : updaters)
+                    u->triggerAsyncUpdate();
+            }).join();
+
+            expect (dispatchUntil ([&]
+            {
+                return std::all_of (updaters.begin(), updaters.end(), [] (auto& u) { return u->count == 1; });
+            }));
+
+            expect (mm->getQueueStatistics (MessageManager::Priority::normal).numMessagesDelivered < 100);
+        }
+
+        beginTest ("Updaters deleted while pending aren't called");
+        {
+            int count = 0;
+
+            struct Updater  : public AsyncUpdater
+            {
+                explicit Updater (int& c) : counter (c) {}
+                void handleAsyncUpdate() override  { ++counter; }
+                int& counter;
+            };
+
+            {
+                Updater u1 (count), u2 (count);
+                u1.triggerAsyncUpdate();
+                u2.triggerAsyncUpdate();
+                u1.cancelPendingUpdate();
+                u2.cancelPendingUpdate();
+            }
+
+            Updater u3 (count);
+            u3.triggerAsyncUpdate();
+            expect (dispatchUntil ([&] { return count > 0; }));
+            dispatchUntil ([] { return false; }, 20);
+            expectEquals (count, 1);
+        }
+
+        beginTest ("Minimum update interval");
+        {
+            CountingUpdater updater;
+            updater.setMinimumUpdateInterval (100);
+            expectEquals (updater.getMinimumUpdateInterval(), 100);
+
+            updater.triggerAsyncUpdate();
+            expect (dispatchUntil ([&] { return updater.count == 1; }));
+
+            for (int i = 0; i < 20; ++i)
+            {
+                updater.triggerAsyncUpdate();
+                dispatchUntil ([] { return false; }, 5);
+            }
+
+            expect (dispatchUntil ([&] { return updater.count >= 2; }));
+            expect (updater.callbackTimes.size() >= 2
+                     && updater.callbackTimes[1] - updater.callbackTimes[0] >= 90);
+
+            updater.triggerAsyncUpdate();
+            updater.cancelPendingUpdate();
+            dispatchUntil ([] { return false; }, 250);
+            expectEquals (updater.count, 2);
+        }
+    }
+};
+
+static AsyncUpdaterTests asyncUpdaterTests;
+
+#endif
+
 } // namespace juce
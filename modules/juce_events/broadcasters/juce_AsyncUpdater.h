@@ -33,6 +33,10 @@ namespace juce
     Basically, one or more calls to the triggerAsyncUpdate() will result in the
     message thread calling handleAsyncUpdate() as soon as it can.
 
+    All the AsyncUpdaters in the application share a single dispatcher, so if lots of
+    them are triggered at around the same time, they only post one message between
+    them, and all their callbacks are made from that one message.
+
     @tags{Events}
 */
 class JUCE_API  AsyncUpdater
@@ -57,10 +61,11 @@ public:
         If an update callback is already pending but hasn't happened yet, calling
         this method will have no effect.
 
-        It's thread-safe to call this method from any thread, BUT beware of calling
-        it from a real-time (e.g. audio) thread, because it involves posting a message
-        to the system queue, which means it may block (and in general will do on
-        most OSes).
+        It's thread-safe to call this method from any thread. Triggering an updater is
+        lock-free, and only the first updater to be triggered in each batch needs to post
+        a message, so it's inexpensive to call this from the audio thread. Posting that
+        message can still allocate or block on some OSes, so if that matters to you, you
+        may prefer to poll a flag with a Timer instead.
     */
     void triggerAsyncUpdate();
 
@@ -90,6 +95,22 @@ public:
     /** Returns true if there's an update callback in the pipeline. */
     bool isUpdatePending() const noexcept;
 
+    //==============================================================================
+    /** Sets a minimum time between calls to handleAsyncUpdate().
+
+        If an update is triggered less than this many milliseconds after the previous
+        callback, the next callback is delayed until the interval has passed. This lets
+        an object that gets triggered very often (e.g. by the audio thread) update at a
+        steady rate, rather than once for every message loop cycle.
+
+        The default is 0, which means that callbacks are made as soon as possible.
+        handleUpdateNowIfNeeded() isn't affected by this setting.
+    */
+    void setMinimumUpdateInterval (int milliseconds) noexcept;
+
+    /** Returns the interval set by setMinimumUpdateInterval(). */
+    int getMinimumUpdateInterval() const noexcept;
+
     //==============================================================================
     /** Called back to do whatever your class needs to do.
 
@@ -101,6 +122,7 @@ public:
 private:
     //==============================================================================
     class AsyncUpdaterMessage;
+    class Dispatcher;
     friend class ReferenceCountedObjectPtr<AsyncUpdaterMessage>;
     ReferenceCountedObjectPtr<AsyncUpdaterMessage> activeMessage;
 
@@ -40,6 +40,14 @@ static String getCommandLinePrefix (const String& commandLineUniqueID)
     return "--" + commandLineUniqueID + ":";
 }
 
+// The first character of the pipe name tells the worker which kind of pipe to open
+static constexpr juce_wchar sharedMemoryPipePrefix = 'm';
+
+static bool usesSharedMemory (const String& pipeName)
+{
+    return pipeName[0] == sharedMemoryPipePrefix;
+}
+
 //==============================================================================
 // This thread sends and receives ping messages every second, so that it
 // can find out if the other process has stopped running.
@@ -94,7 +102,10 @@ struct ChildProcessCoordinator::Connection  : public InterprocessConnection,
           ChildProcessPingThread (timeout),
           owner (m)
     {
-        createPipe (pipeName, timeoutMs);
+        if (usesSharedMemory (pipeName))
+            createSharedMemoryPipe (pipeName, timeoutMs);
+        else
+            createPipe (pipeName, timeoutMs);
     }
 
     ~Connection() override
@@ -154,21 +165,31 @@ bool ChildProcessCoordinator::sendMessageToWorker (const MemoryBlock& mb)
 }
 
 bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const String& commandLineUniqueID,
-                                                   int timeoutMs, int streamFlags)
+                                                   int timeoutMs, int streamFlags, Transport transport)
 {
     killWorkerProcess();
 
-    auto pipeName = "p" + String::toHexString (Random().nextInt64());
+    const auto sharedMemory = transport == Transport::sharedMemory;
+    auto pipeName = String::charToString (sharedMemory ? sharedMemoryPipePrefix : 'p')
+                      + String::toHexString (Random().nextInt64());
 
     StringArray args;
     args.add (executable.getFullPathName());
     args.add (getCommandLinePrefix (commandLineUniqueID) + pipeName);
 
+    timeoutMs = timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs;
+
+    // The shared memory has to exist before the worker starts up and tries to open it.
+    // Until then, any messages that are sent just wait in the buffer.
+    if (sharedMemory)
+        connection.reset (new Connection (*this, pipeName, timeoutMs));
+
     childProcess.reset (new ChildProcess());
 
     if (childProcess->start (args, streamFlags))
     {
-        connection.reset (new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs));
+        if (! sharedMemory)
+            connection.reset (new Connection (*this, pipeName, timeoutMs));
 
         if (connection->isConnected())
         {
@@ -176,10 +197,12 @@ bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const
             sendMessageToWorker ({ startMessage, specialMessageSize });
             return true;
         }
-
-        connection.reset();
     }
 
+    if (connection != nullptr)
+        connection->disconnect (-1, InterprocessConnection::Notify::no);
+
+    connection.reset();
     return false;
 }
 
@@ -204,7 +227,10 @@ struct ChildProcessWorker::Connection  : public InterprocessConnection,
           ChildProcessPingThread (timeout),
           owner (p)
     {
-        connectToPipe (pipeName, timeoutMs);
+        if (usesSharedMemory (pipeName))
+            connectToSharedMemoryPipe (pipeName, timeoutMs);
+        else
+            connectToPipe (pipeName, timeoutMs);
     }
 
     ~Connection() override
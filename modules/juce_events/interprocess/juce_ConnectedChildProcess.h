@@ -151,6 +151,14 @@ public:
     */
     virtual ~ChildProcessCoordinator();
 
+    /** The ways in which messages can be passed between the two processes. */
+    enum class Transport
+    {
+        namedPipe,      /**< Messages are sent through a NamedPipe. */
+        sharedMemory    /**< Messages are passed through a SharedMemoryPipe, which is much
+                             quicker, but isn't available on Android. */
+    };
+
     /** Attempts to launch and connect to a worker process.
         This will start the given executable, passing it a special command-line
         parameter based around the commandLineUniqueID string, which must be a
@@ -168,11 +176,15 @@ public:
 
         If a child process is already running, this will call killWorkerProcess() and
         start a new one.
+
+        The transport chooses how the messages are passed. The worker process finds
+        out which one to use from its command line, so it doesn't need to be told.
     */
     bool launchWorkerProcess (const File& executableToLaunch,
                               const String& commandLineUniqueID,
                               int timeoutMs = 0,
-                              int streamFlags = ChildProcess::wantStdOut | ChildProcess::wantStdErr);
+                              int streamFlags = ChildProcess::wantStdOut | ChildProcess::wantStdErr,
+                              Transport transport = Transport::namedPipe);
 
     [[deprecated ("Replaced by launchWorkerProcess.")]]
     bool launchSlaveProcess (const File& executableToLaunch,
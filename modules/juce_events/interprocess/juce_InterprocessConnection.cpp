@@ -79,6 +79,13 @@ InterprocessConnection::InterprocessConnection (bool callbacksOnMessageThread, u
     thread.reset (new ConnectionThread (*this));
 }
 
+InterprocessConnection::InterprocessConnection (SocketIOService& serviceToUse, bool callbacksOnMessageThread,
+                                                uint32 magicMessageHeaderNumber)
+    : InterprocessConnection (callbacksOnMessageThread, magicMessageHeaderNumber)
+{
+    ioService = &serviceToUse;
+}
+
 InterprocessConnection::~InterprocessConnection()
 {
     // You *must* call `disconnect` in the destructor of your derived class to ensure
@@ -145,14 +152,60 @@ bool InterprocessConnection::createPipe (const String& pipeName, int timeoutMs,
     return false;
 }
 
+bool InterprocessConnection::createSharedMemoryPipe (const String& pipeName, int timeoutMs,
+                                                     int bufferSizeEachWay, bool mustNotExist)
+{
+    disconnect();
+
+    auto newPipe = std::make_unique<SharedMemoryPipe>();
+
+    if (newPipe->createNewPipe (pipeName, bufferSizeEachWay, mustNotExist))
+    {
+        const ScopedWriteLock sl (pipeAndSocketLock);
+        pipeReceiveMessageTimeout = timeoutMs;
+        initialiseWithSharedMemoryPipe (std::move (newPipe));
+        return true;
+    }
+
+    return false;
+}
+
+bool InterprocessConnection::connectToSharedMemoryPipe (const String& pipeName, int timeoutMs)
+{
+    disconnect();
+
+    auto newPipe = std::make_unique<SharedMemoryPipe>();
+
+    if (newPipe->openExisting (pipeName))
+    {
+        const ScopedWriteLock sl (pipeAndSocketLock);
+        pipeReceiveMessageTimeout = timeoutMs;
+        initialiseWithSharedMemoryPipe (std::move (newPipe));
+        return true;
+    }
+
+    return false;
+}
+
 void InterprocessConnection::disconnect (int timeoutMs, Notify notify)
 {
     thread->signalThreadShouldExit();
 
     {
         const ScopedReadLock sl (pipeAndSocketLock);
+
+        if (socket != nullptr && ioService != nullptr)
+        {
+            // this waits for any read callback that's in progress
+            ioService->cancel (*socket);
+            threadIsRunning = false;
+        }
+
         if (socket != nullptr)  socket->close();
         if (pipe != nullptr)    pipe->close();
+
+        if (sharedMemoryPipe != nullptr)
+            sharedMemoryPipe->close();
     }
 
     thread->stopThread (timeoutMs);
@@ -170,6 +223,7 @@ void InterprocessConnection::deletePipeAndSocket()
     const ScopedWriteLock sl (pipeAndSocketLock);
     socket.reset();
     pipe.reset();
+    sharedMemoryPipe.reset();
 }
 
 bool InterprocessConnection::isConnected() const
@@ -177,7 +231,8 @@ bool InterprocessConnection::isConnected() const
     const ScopedReadLock sl (pipeAndSocketLock);
 
     return ((socket != nullptr && socket->isConnected())
-              || (pipe != nullptr && pipe->isOpen()))
+              || (pipe != nullptr && pipe->isOpen())
+              || (sharedMemoryPipe != nullptr && sharedMemoryPipe->isOpen()))
             && threadIsRunning;
 }
 
@@ -186,7 +241,7 @@ String InterprocessConnection::getConnectedHostName() const
     {
         const ScopedReadLock sl (pipeAndSocketLock);
 
-        if (pipe == nullptr && socket == nullptr)
+        if (pipe == nullptr && socket == nullptr && sharedMemoryPipe == nullptr)
             return {};
 
         if (socket != nullptr && ! socket->isLocal())
@@ -199,6 +254,14 @@ String InterprocessConnection::getConnectedHostName() const
 //==============================================================================
 bool InterprocessConnection::sendMessage (const MemoryBlock& message)
 {
+    {
+        const ScopedReadLock sl (pipeAndSocketLock);
+
+        // a SharedMemoryPipe keeps the messages separate, so they don't need a header
+        if (sharedMemoryPipe != nullptr)
+            return sharedMemoryPipe->write (message.getData(), (int) message.getSize(), pipeReceiveMessageTimeout);
+    }
+
     uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
                                 ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
 
@@ -214,7 +277,12 @@ int InterprocessConnection::writeData (void* data, int dataSize)
     const ScopedReadLock sl (pipeAndSocketLock);
 
     if (socket != nullptr)
+    {
+        if (ioService != nullptr)
+            return ioService->asyncWrite (*socket, data, dataSize) ? dataSize : -1;
+
         return socket->write (data, dataSize);
+    }
 
     if (pipe != nullptr)
         return pipe->write (data, dataSize, pipeReceiveMessageTimeout);
@@ -228,23 +296,37 @@ void InterprocessConnection::initialise()
     safeAction->setSafe (true);
     threadIsRunning = true;
     connectionMadeInt();
-    thread->startThread();
+
+    if (socket != nullptr && ioService != nullptr)
+    {
+        asyncReceivedData.reset();
+        startAsyncRead();
+    }
+    else
+        thread->startThread();
 }
 
 void InterprocessConnection::initialiseWithSocket (std::unique_ptr<StreamingSocket> newSocket)
 {
-    jassert (socket == nullptr && pipe == nullptr);
+    jassert (socket == nullptr && pipe == nullptr && sharedMemoryPipe == nullptr);
     socket = std::move (newSocket);
     initialise();
 }
 
 void InterprocessConnection::initialiseWithPipe (std::unique_ptr<NamedPipe> newPipe)
 {
-    jassert (socket == nullptr && pipe == nullptr);
+    jassert (socket == nullptr && pipe == nullptr && sharedMemoryPipe == nullptr);
     pipe = std::move (newPipe);
     initialise();
 }
 
+void InterprocessConnection::initialiseWithSharedMemoryPipe (std::unique_ptr<SharedMemoryPipe> newPipe)
+{
+    jassert (socket == nullptr && pipe == nullptr && sharedMemoryPipe == nullptr);
+    sharedMemoryPipe = std::move (newPipe);
+    initialise();
+}
+
 //==============================================================================
 struct ConnectionStateMessage  : public MessageManager::MessageBase
 {
@@ -386,6 +468,27 @@ bool InterprocessConnection::readNextMessage()
     return false;
 }
 
+bool InterprocessConnection::readNextSharedMemoryMessage()
+{
+    MemoryBlock messageData;
+    bool received;
+
+    {
+        const ScopedReadLock sl (pipeAndSocketLock);
+
+        if (! sharedMemoryPipe->isOpen())
+            return false;
+
+        // a short timeout, so that the thread can check whether it should stop
+        received = sharedMemoryPipe->readMessage (messageData, 100);
+    }
+
+    if (received && ! thread->threadShouldExit())
+        deliverDataInt (messageData);
+
+    return true;
+}
+
 void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
@@ -416,6 +519,17 @@ void InterprocessConnection::runThread()
                 break;
             }
         }
+        else if (sharedMemoryPipe != nullptr)
+        {
+            if (! readNextSharedMemoryMessage())
+            {
+                deletePipeAndSocket();
+                connectionLostInt();
+                break;
+            }
+
+            continue;
+        }
         else
         {
             break;
@@ -428,4 +542,71 @@ void InterprocessConnection::runThread()
     threadIsRunning = false;
 }
 
+//==============================================================================
+static constexpr int asyncReadBufferSize = 65536;
+
+void InterprocessConnection::startAsyncRead()
+{
+    if (asyncReadBuffer == nullptr)
+        asyncReadBuffer.malloc (asyncReadBufferSize);
+
+    if (! ioService->asyncRead (*socket, asyncReadBuffer, asyncReadBufferSize,
+                                [this] (int numBytesRead) { handleAsyncRead (numBytesRead); }))
+    {
+        threadIsRunning = false;
+        connectionLostInt();
+    }
+}
+
+void InterprocessConnection::handleAsyncRead (int numBytesRead)
+{
+    // Unlike the connection thread, this leaves the socket in place when the connection
+    // is lost, because disconnect() may be waiting for this callback while it holds
+    // the lock. The socket gets deleted by the next call to disconnect().
+    if (numBytesRead <= 0)
+    {
+        threadIsRunning = false;
+        connectionLostInt();
+        return;
+    }
+
+    asyncReceivedData.append (asyncReadBuffer, (size_t) numBytesRead);
+
+    size_t bytesUsed = 0;
+    auto* data = static_cast<const char*> (asyncReceivedData.getData());
+    const auto headerSize = sizeof (uint32) * 2;
+
+    while (asyncReceivedData.getSize() - bytesUsed >= headerSize)
+    {
+        auto magic = ByteOrder::littleEndianInt (data + bytesUsed);
+        auto bytesInMessage = (size_t) ByteOrder::littleEndianInt (data + bytesUsed + sizeof (uint32));
+
+        if (magic != magicMessageHeader)
+        {
+            // the data isn't in sync with our message headers, so give up, in the
+            // same way that the connection thread does
+            asyncReceivedData.reset();
+            threadIsRunning = false;
+            return;
+        }
+
+        if (asyncReceivedData.getSize() - bytesUsed - headerSize < bytesInMessage)
+            break;
+
+        if (bytesInMessage > 0)
+        {
+            deliverDataInt (MemoryBlock (data + bytesUsed + headerSize, bytesInMessage));
+
+            // the callback may have disconnected us
+            if (socket == nullptr || ! threadIsRunning)
+                return;
+        }
+
+        bytesUsed += headerSize + bytesInMessage;
+    }
+
+    asyncReceivedData.removeSection (0, bytesUsed);
+    startAsyncRead();
+}
+
 } // namespace juce
@@ -49,15 +49,39 @@ bool InterprocessConnectionServer::beginWaitingForSocket (const int portNumber,
     return false;
 }
 
+bool InterprocessConnectionServer::beginWaitingForSocket (SocketIOService& serviceToUse, int portNumber,
+                                                          const String& bindAddress)
+{
+    stop();
+
+    socket.reset (new StreamingSocket());
+
+    if (socket->createListener (portNumber, bindAddress))
+    {
+        ioService = &serviceToUse;
+        acceptNextConnection();
+        return true;
+    }
+
+    socket.reset();
+    return false;
+}
+
 void InterprocessConnectionServer::stop()
 {
     signalThreadShouldExit();
 
     if (socket != nullptr)
+    {
+        if (ioService != nullptr)
+            ioService->cancel (*socket);
+
         socket->close();
+    }
 
     stopThread (4000);
     socket.reset();
+    ioService = nullptr;
 }
 
 int InterprocessConnectionServer::getBoundPort() const noexcept
@@ -77,4 +101,18 @@ void InterprocessConnectionServer::run()
     }
 }
 
+void InterprocessConnectionServer::acceptNextConnection()
+{
+    ioService->asyncAccept (*socket, [this] (std::unique_ptr<StreamingSocket> clientSocket)
+    {
+        if (clientSocket == nullptr)
+            return;
+
+        if (auto* newConnection = createConnectionObject())
+            newConnection->initialiseWithSocket (std::move (clientSocket));
+
+        acceptNextConnection();
+    });
+}
+
 } // namespace juce
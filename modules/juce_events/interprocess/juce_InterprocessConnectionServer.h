@@ -67,6 +67,22 @@ public:
     */
     bool beginWaitingForSocket (int portNumber, const String& bindAddress = String());
 
+    /** Starts listening on the given port number, using a SocketIOService rather than
+        a thread of its own.
+
+        This works like the other version of beginWaitingForSocket(), except that new
+        clients are accepted on one of the service's threads, and createConnectionObject()
+        is called there. For a server with many clients, you'll probably also want the
+        connection objects that it returns to use the same service, so that they don't
+        each need a thread.
+
+        The service must outlive this object, or at least stay alive until stop() is called.
+
+        @see InterprocessConnection::InterprocessConnection (SocketIOService&, bool, uint32)
+    */
+    bool beginWaitingForSocket (SocketIOService& serviceToUse, int portNumber,
+                                const String& bindAddress = String());
+
     /** Terminates the listener thread, if it's active.
 
         @see beginWaitingForSocket
@@ -97,8 +113,10 @@ protected:
 private:
     //==============================================================================
     std::unique_ptr<StreamingSocket> socket;
+    SocketIOService* ioService = nullptr;
 
     void run() override;
+    void acceptNextConnection();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnectionServer)
 };
@@ -23,8 +23,272 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Messages are posted to a set of lock-free queues, one for each priority, rather than
+    going straight to the OS. Only the first message posted after a batch has started
+    needs to wake up the native event loop, and when it does, the message thread delivers
+    everything that has been posted so far in one go, so a storm of messages costs one
+    native wakeup per batch instead of one per message.
+
+    Each batch delivers the messages that were waiting when it started, highest priority
+    first, but stops after a few milliseconds and posts another wakeup so that the native
+    loop can get on with handling input and window events in between.
+*/
+class MessageManager::PostQueue
+{
+public:
+    PostQueue() = default;
+
+    ~PostQueue()
+    {
+        for (auto& lane : lanes)
+        {
+            lane.collectIncoming();
+
+            while (auto* message = lane.pop())
+                message->decReferenceCount();
+        }
+    }
+
+    bool post (MessageBase* message, Priority priority)
+    {
+        message->incReferenceCount();
+        message->timePosted = Time::getHighResolutionTicks();
+
+        auto& lane = getLane (priority);
+        lane.push (message);
+
+        const auto numPending = ++lane.numPending;
+        auto maxPending = lane.maxNumPending.load (std::memory_order_relaxed);
+
+        while (numPending > maxPending
+                && ! lane.maxNumPending.compare_exchange_weak (maxPending, numPending, std::memory_order_relaxed))
+        {}
+
+        return wakeUpMessageThread();
+    }
+
+    QueueStatistics getStatistics (Priority priority) const noexcept
+    {
+        auto& lane = getLane (priority);
+
+        QueueStatistics stats;
+        stats.numPendingMessages    = lane.numPending.load (std::memory_order_relaxed);
+        stats.maxNumPendingMessages = lane.maxNumPending.load (std::memory_order_relaxed);
+        stats.numMessagesDelivered  = lane.numDelivered.load (std::memory_order_relaxed);
+
+        if (stats.numMessagesDelivered > 0)
+            stats.averageLatencyMs = Time::highResolutionTicksToSeconds (lane.totalLatency.load (std::memory_order_relaxed))
+                                        * 1000.0 / (double) stats.numMessagesDelivered;
+
+        stats.maxLatencyMs = Time::highResolutionTicksToSeconds (lane.maxLatency.load (std::memory_order_relaxed)) * 1000.0;
+        return stats;
+    }
+
+    void resetStatistics() noexcept
+    {
+        for (auto& lane : lanes)
+        {
+            lane.maxNumPending = lane.numPending.load();
+            lane.numDelivered = 0;
+            lane.totalLatency = 0;
+            lane.maxLatency = 0;
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Lane
+    {
+        // Called by any thread. This is a Treiber stack, so the messages come out newest first.
+        void push (MessageBase* message) noexcept
+        {
+            auto* head = incoming.load (std::memory_order_relaxed);
+
+            do
+            {
+                message->nextInQueue = head;
+            }
+            while (! incoming.compare_exchange_weak (head, message, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Called by the message thread, to move everything that's been pushed onto the end of
+        // the list of messages that are ready to be delivered, in the order they were posted.
+        void collectIncoming() noexcept
+        {
+            auto* message = incoming.exchange (nullptr, std::memory_order_acquire);
+
+            MessageBase* reversed = nullptr;
+            MessageBase* last = message;
+            int num = 0;
+
+            while (message != nullptr)
+            {
+                auto* next = message->nextInQueue;
+                message->nextInQueue = reversed;
+                reversed = message;
+                message = next;
+                ++num;
+            }
+
+            if (reversed != nullptr)
+            {
+                if (readyTail != nullptr)
+                    readyTail->nextInQueue = reversed;
+                else
+                    readyHead = reversed;
+
+                readyTail = last;
+                numReady += num;
+            }
+        }
+
+        MessageBase* pop() noexcept
+        {
+            auto* message = readyHead;
+
+            if (message != nullptr)
+            {
+                readyHead = message->nextInQueue;
+                message->nextInQueue = nullptr;
+                --numReady;
+
+                if (readyHead == nullptr)
+                    readyTail = nullptr;
+            }
+
+            return message;
+        }
+
+        bool hasMessages() const noexcept
+        {
+            return readyHead != nullptr || incoming.load (std::memory_order_relaxed) != nullptr;
+        }
+
+        void recordDelivery (int64 latency) noexcept
+        {
+            --numPending;
+            numDelivered.fetch_add (1, std::memory_order_relaxed);
+            totalLatency.fetch_add (latency, std::memory_order_relaxed);
+
+            if (latency > maxLatency.load (std::memory_order_relaxed))
+                maxLatency.store (latency, std::memory_order_relaxed);
+        }
+
+        std::atomic<MessageBase*> incoming { nullptr };
+        MessageBase* readyHead = nullptr;
+        MessageBase* readyTail = nullptr;
+        int numReady = 0;
+
+        std::atomic<int> numPending { 0 }, maxNumPending { 0 };
+        std::atomic<int64> numDelivered { 0 }, totalLatency { 0 }, maxLatency { 0 };
+    };
+
+    //==============================================================================
+    struct WakeUpMessage  : public MessageBase
+    {
+        void messageCallback() override
+        {
+            if (auto* mm = MessageManager::instance)
+                if (auto* queue = mm->postQueue.get())
+                    queue->deliverBatch();
+        }
+    };
+
+    bool wakeUpMessageThread()
+    {
+        if (wakeUpPending.load() || wakeUpPending.exchange (true))
+            return true;
+
+        if (postMessageToSystemQueue (wakeUpMessage.get()))
+            return true;
+
+        wakeUpPending = false;
+        return false;
+    }
+
+    bool hasMessages() const noexcept
+    {
+        for (auto& lane : lanes)
+            if (lane.hasMessages())
+                return true;
+
+        return false;
+    }
+
+    void deliverBatch()
+    {
+        // This must be cleared before collecting, so that anything posted from now on
+        // is sure to trigger another batch.
+        wakeUpPending = false;
+
+        // Only the messages that are ready now are delivered in this batch - anything posted
+        // by their callbacks has to wait for the next one.
+        int numToDeliver[numPriorities];
+
+        for (size_t i = 0; i < numPriorities; ++i)
+        {
+            lanes[i].collectIncoming();
+            numToDeliver[i] = lanes[i].numReady;
+        }
+
+        const auto startTime = Time::getHighResolutionTicks();
+        const auto maxDuration = Time::secondsToHighResolutionTicks (maxBatchDurationSeconds);
+
+        for (size_t i = 0; i < numPriorities; ++i)
+        {
+            auto& lane = lanes[i];
+
+            for (auto num = numToDeliver[i]; num > 0; --num)
+            {
+                MessageBase::Ptr message (lane.pop());
+
+                if (message == nullptr)
+                    break;
+
+                message->decReferenceCountWithoutDeleting();
+
+                // If a callback runs a modal loop, another batch has to be on its way
+                // for the remaining messages to be delivered inside it.
+                if (hasMessages())
+                    wakeUpMessageThread();
+
+                const auto now = Time::getHighResolutionTicks();
+                lane.recordDelivery (now - message->timePosted);
+
+                JUCE_TRY
+                {
+                    JUCE_TRACE_ZONE ("MessageManager::dispatch");
+                    message->messageCallback();
+                }
+                JUCE_CATCH_EXCEPTION
+
+                if (Time::getHighResolutionTicks() - startTime > maxDuration)
+                    break;
+            }
+        }
+
+        if (hasMessages())
+            wakeUpMessageThread();
+    }
+
+    Lane& getLane (Priority priority) noexcept                  { return lanes[(size_t) priority]; }
+    const Lane& getLane (Priority priority) const noexcept      { return lanes[(size_t) priority]; }
+
+    static constexpr size_t numPriorities = (size_t) Priority::background + 1;
+    static constexpr double maxBatchDurationSeconds = 0.005;
+
+    Lane lanes[numPriorities];
+    std::atomic<bool> wakeUpPending { false };
+    MessageBase::Ptr wakeUpMessage { new WakeUpMessage() };
+
+    JUCE_DECLARE_NON_COPYABLE (PostQueue)
+};
+
+//==============================================================================
 MessageManager::MessageManager() noexcept
-  : messageThreadId (Thread::getCurrentThreadId())
+  : postQueue (std::make_unique<PostQueue>()),
+    messageThreadId (Thread::getCurrentThreadId())
 {
     JUCE_VERSION_ID
 
@@ -35,6 +299,7 @@ MessageManager::MessageManager() noexcept
 MessageManager::~MessageManager() noexcept
 {
     broadcaster.reset();
+    postQueue.reset();
 
     doPlatformSpecificShutdown();
 
@@ -67,10 +332,16 @@ void MessageManager::deleteInstance()
 
 //==============================================================================
 bool MessageManager::MessageBase::post()
+{
+    return post (Priority::normal);
+}
+
+bool MessageManager::MessageBase::post (Priority priority)
 {
     auto* mm = MessageManager::instance;
 
-    if (mm == nullptr || mm->quitMessagePosted.get() != 0 || ! postMessageToSystemQueue (this))
+    if (mm == nullptr || mm->quitMessagePosted.get() != 0
+         || mm->postQueue == nullptr || ! mm->postQueue->post (this, priority))
     {
         Ptr deleter (this); // (this will delete messages that were just created with a 0 ref count)
         return false;
@@ -190,6 +461,11 @@ void* MessageManager::callFunctionOnMessageThread (MessageCallbackFunction* func
 }
 
 bool MessageManager::callAsync (std::function<void()> fn)
+{
+    return callAsync (std::move (fn), Priority::normal);
+}
+
+bool MessageManager::callAsync (std::function<void()> fn, Priority priority)
 {
     struct AsyncCallInvoker  : public MessageBase
     {
@@ -198,7 +474,19 @@ bool MessageManager::callAsync (std::function<void()> fn)
         std::function<void()> callback;
     };
 
-    return (new AsyncCallInvoker (std::move (fn)))->post();
+    return (new AsyncCallInvoker (std::move (fn)))->post (priority);
+}
+
+//==============================================================================
+MessageManager::QueueStatistics MessageManager::getQueueStatistics (Priority priority) const noexcept
+{
+    return postQueue != nullptr ? postQueue->getStatistics (priority) : QueueStatistics();
+}
+
+void MessageManager::resetQueueStatistics() noexcept
+{
+    if (postQueue != nullptr)
+        postQueue->resetStatistics();
 }
 
 //==============================================================================
@@ -484,4 +772,146 @@ static int numScopedInitInstances = 0;
 ScopedJuceInitialiser_GUI::ScopedJuceInitialiser_GUI()  { if (numScopedInitInstances++ == 0) initialiseJuce_GUI(); }
 ScopedJuceInitialiser_GUI::~ScopedJuceInitialiser_GUI() { if (--numScopedInitInstances == 0) shutdownJuce_GUI(); }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && ! (JUCE_MAC || JUCE_IOS || JUCE_ANDROID)
+
+class MessageQueueTests  : public UnitTest
+{
+public:
+    MessageQueueTests()
+        : UnitTest ("MessageManager queue", UnitTestCategories::threads)
+    {
+        setIsolation (Isolation::messageThread);
+    }
+
+    static bool dispatchUntil (std::function<bool()> condition, int timeoutMs = 5000)
+    {
+        for (auto end = Time::getMillisecondCounter() + (uint32) timeoutMs; Time::getMillisecondCounter() < end;)
+        {
+            if (condition())
+                return true;
+
+            if (! dispatchNextMessageOnSystemQueue (true))
+                Thread::sleep (1);
+        }
+
+        return condition();
+    }
+
+    void runTest() override
+    {
+        auto* mm = MessageManager::getInstance();
+
+        if (! mm->isThisTheMessageThread())
+            return;
+
+        using Priority = MessageManager::Priority;
+
+        beginTest ("Messages with the same priority arrive in order");
+        {
+            std::vector<int> received;
+
+            for (int i = 0; i < 1000; ++i)
+                expect (MessageManager::callAsync ([&received, i] { received.push_back (i); }));
+
+            expect (dispatchUntil ([&] { return received.size() == 1000; }));
+
+            bool inOrder = true;
+
+            for (int i = 0; i < (int) received.size(); ++i)
+                inOrder = inOrder && received[(size_t) i] == i;
+
+            expect (inOrder);
+        }
+
+        beginTest ("Higher priorities are delivered first");
+        {
+            std::vector<Priority> received;
+
+            for (auto p : { Priority::background, Priority::repaint, Priority::normal, Priority::input })
+                MessageManager::callAsync ([&received, p] { received.push_back (p); }, p);
+
+            expect (dispatchUntil ([&] { return received.size() == 4; }));
+            expect (received == std::vector<Priority> { Priority::input, Priority::normal, Priority::repaint, Priority::background });
+        }
+
+        beginTest ("Messages posted during a batch wait for the next one");
+        {
+            int numNested = 0;
+            bool nestedCallRanEarly = false;
+
+            MessageManager::callAsync ([&]
+            {
+                MessageManager::callAsync ([&] { ++numNested; }, Priority::input);
+            }, Priority::background);
+
+            MessageManager::callAsync ([&] { nestedCallRanEarly = numNested > 0; }, Priority::background);
+
+            expect (dispatchUntil ([&] { return numNested > 0; }));
+            expect (! nestedCallRanEarly);
+        }
+
+        beginTest ("Many threads posting at once");
+        {
+            mm->resetQueueStatistics();
+
+            constexpr int numThreads = 4, numMessagesPerThread = 2000;
+            std::atomic<int> numReceived { 0 };
+            std::vector<std::unique_ptr<std::thread>> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+                threads.push_back (std::make_unique<std::thread> ([&numReceived]
+                {
+                    for (int i = 0; i < numMessagesPerThread; ++i)
+                        MessageManager::callAsync ([&numReceived] { ++numReceived; }, Priority::background);
+                }));
+
+            expect (dispatchUntil ([&] { return numReceived == numThreads * numMessagesPerThread; }, 20000));
+
+            for (auto& t : threads)
+                t->join();
+
+            dispatchUntil ([&] { return mm->getQueueStatistics (Priority::background).numPendingMessages == 0; });
+
+            auto stats = mm->getQueueStatistics (Priority::background);
+            expectEquals (stats.numPendingMessages, 0);
+            expectEquals (stats.numMessagesDelivered, (int64) (numThreads * numMessagesPerThread));
+            expect (stats.maxNumPendingMessages > 0);
+            expect (stats.maxLatencyMs >= stats.averageLatencyMs);
+        }
+
+        beginTest ("A storm of messages doesn't hold up other priorities");
+        {
+            std::atomic<bool> keepPosting { true };
+            std::atomic<int> numReceived { 0 };
+
+            std::thread flooder ([&]
+            {
+                while (keepPosting)
+                {
+                    MessageManager::callAsync ([&numReceived] { ++numReceived; });
+                    Thread::yield();
+                }
+            });
+
+            expect (dispatchUntil ([&] { return numReceived > 1000; }));
+
+            bool inputDelivered = false;
+            MessageManager::callAsync ([&] { inputDelivered = true; }, Priority::input);
+
+            expect (dispatchUntil ([&] { return inputDelivered; }, 1000));
+
+            keepPosting = false;
+            flooder.join();
+
+            expect (dispatchUntil ([&] { return mm->getQueueStatistics (Priority::normal).numPendingMessages == 0; }));
+        }
+    }
+};
+
+static MessageQueueTests messageQueueTests;
+
+#endif
+
 } // namespace juce
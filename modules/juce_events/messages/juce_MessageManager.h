@@ -88,6 +88,28 @@ public:
     bool runDispatchLoopUntil (int millisecondsToRunFor);
    #endif
 
+    //==============================================================================
+    /** The priorities that can be given to messages when they're posted.
+
+        Posted messages are held in a queue and delivered in batches, each time the
+        native event loop wakes the message thread. Within a batch, messages with a higher
+        priority are delivered first, and messages with the same priority are delivered in
+        the order in which they were posted. Each batch is limited to a few milliseconds
+        of work, after which the native event loop gets a chance to handle its own events
+        (mouse, keyboard, window events, etc.) before the next batch starts. Every non-empty
+        priority gets at least one message delivered per batch, so a flood of messages at
+        one priority can't stop the others from being delivered.
+
+        @see MessageBase::post, callAsync
+    */
+    enum class Priority
+    {
+        input,          /**< For messages that respond to the user, which should be delivered as soon as possible. */
+        normal,         /**< The priority used for messages unless another one is specified. */
+        repaint,        /**< For messages that only update the display. */
+        background      /**< For messages that can wait, such as frequent updates from other threads. */
+    };
+
     //==============================================================================
     /** Asynchronously invokes a function or C++11 lambda on the message thread.
 
@@ -96,6 +118,19 @@ public:
     */
     static bool callAsync (std::function<void()> functionToCall);
 
+    /** Asynchronously invokes a function or C++11 lambda on the message thread, with a
+        given priority.
+
+        If you're calling this at a high rate from another thread (e.g. to update a level
+        meter from the audio thread), using Priority::background will make sure that the
+        calls don't delay the handling of other messages.
+
+        @returns  true if the message was successfully posted to the message queue,
+                  or false otherwise.
+        @see Priority
+    */
+    static bool callAsync (std::function<void()> functionToCall, Priority priority);
+
     /** Calls a function using the message-thread.
 
         This can be used by any thread to cause this function to be called-back
@@ -152,6 +187,39 @@ public:
     */
     static bool existsAndIsCurrentThread() noexcept;
 
+    //==============================================================================
+    /** Some statistics about the messages posted with one of the priorities.
+        @see getQueueStatistics
+    */
+    struct QueueStatistics
+    {
+        /** The number of messages that are currently waiting to be delivered. */
+        int numPendingMessages = 0;
+
+        /** The largest number of messages that have been waiting at the same time. */
+        int maxNumPendingMessages = 0;
+
+        /** The number of messages that have been delivered. */
+        int64 numMessagesDelivered = 0;
+
+        /** The average time between a message being posted and being delivered. */
+        double averageLatencyMs = 0.0;
+
+        /** The longest time between a message being posted and being delivered. */
+        double maxLatencyMs = 0.0;
+    };
+
+    /** Returns the statistics for the messages posted with a given priority.
+
+        All the values except numPendingMessages are counted from when the MessageManager
+        was created, or since resetQueueStatistics() was last called. This can be called
+        from any thread.
+    */
+    QueueStatistics getQueueStatistics (Priority priority) const noexcept;
+
+    /** Resets the counters returned by getQueueStatistics(). */
+    void resetQueueStatistics() noexcept;
+
     //==============================================================================
     /** Sends a message to all other JUCE applications that are running.
 
@@ -187,8 +255,19 @@ public:
         virtual void messageCallback() = 0;
         bool post();
 
+        /** Posts the message so that it'll be delivered with the given priority.
+            @see MessageManager::Priority
+        */
+        bool post (Priority priority);
+
         using Ptr = ReferenceCountedObjectPtr<MessageBase>;
 
+    private:
+        friend class MessageManager;
+
+        MessageBase* nextInQueue = nullptr;
+        int64 timePosted = 0;
+
         JUCE_DECLARE_NON_COPYABLE (MessageBase)
     };
 
@@ -323,8 +402,10 @@ private:
     class QuitMessage;
     friend class QuitMessage;
     friend class MessageManagerLock;
+    class PostQueue;
 
     std::unique_ptr<ActionBroadcaster> broadcaster;
+    std::unique_ptr<PostQueue> postQueue;
     Atomic<int> quitMessagePosted { 0 }, quitMessageReceived { 0 };
     Thread::ThreadID messageThreadId;
     Atomic<Thread::ThreadID> threadWithLock;
@@ -101,6 +101,7 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_ZONE ("MessageManager::dispatch");
             message->messageCallback();
         }
     }
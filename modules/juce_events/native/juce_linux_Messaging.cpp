@@ -39,6 +39,7 @@ public:
                                                 {
                                                     JUCE_TRY
                                                     {
+                                                        JUCE_TRACE_ZONE ("MessageManager::dispatch");
                                                         msg->messageCallback();
                                                     }
                                                     JUCE_CATCH_EXCEPTION
@@ -78,6 +78,7 @@ private:
         {
             JUCE_TRY
             {
+                JUCE_TRACE_ZONE ("MessageManager::dispatch");
                 nextMessage->messageCallback();
             }
             JUCE_CATCH_EXCEPTION
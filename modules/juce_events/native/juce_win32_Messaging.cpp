@@ -195,6 +195,7 @@ private:
     {
         JUCE_TRY
         {
+            JUCE_TRACE_ZONE ("MessageManager::dispatch");
             message->messageCallback();
         }
         JUCE_CATCH_EXCEPTION
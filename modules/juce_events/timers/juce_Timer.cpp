@@ -23,6 +23,61 @@
 namespace juce
 {
 
+//==============================================================================
+struct Timer::TimerList
+{
+    void append (Timer* t) noexcept
+    {
+        jassert (t->list == nullptr);
+
+        t->list = this;
+        t->previousInList = tail;
+        t->nextInList = nullptr;
+
+        if (tail != nullptr)
+            tail->nextInList = t;
+        else
+            head = t;
+
+        tail = t;
+    }
+
+    void remove (Timer* t) noexcept
+    {
+        jassert (t->list == this);
+
+        if (t->previousInList != nullptr)
+            t->previousInList->nextInList = t->nextInList;
+        else
+            head = t->nextInList;
+
+        if (t->nextInList != nullptr)
+            t->nextInList->previousInList = t->previousInList;
+        else
+            tail = t->previousInList;
+
+        t->previousInList = nullptr;
+        t->nextInList = nullptr;
+        t->list = nullptr;
+    }
+
+    Timer* popFront() noexcept
+    {
+        auto* t = head;
+
+        if (t != nullptr)
+            remove (t);
+
+        return t;
+    }
+
+    bool isEmpty() const noexcept       { return head == nullptr; }
+
+    Timer* head = nullptr;
+    Timer* tail = nullptr;
+};
+
+//==============================================================================
 class Timer::TimerThread  : private Thread,
                             private DeletedAtShutdown,
                             private AsyncUpdater
@@ -30,9 +85,9 @@ class Timer::TimerThread  : private Thread,
 public:
     using LockType = CriticalSection; // (mysteriously, using a SpinLock here causes problems on some XP machines..)
 
-    TimerThread()  : Thread ("JUCE Timer")
+    TimerThread()  : Thread ("JUCE Timer"),
+                     lastCounterMs (Time::getMillisecondCounter())
     {
-        timers.reserve (32);
         triggerAsyncUpdate();
     }
 
@@ -50,43 +105,49 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
+        auto messagePostTime = Time::getMillisecondCounter();
+        bool messageInFlight = false;
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
+            {
+                const LockType::ScopedLockType sl (lock);
+                advanceWheels();
+            }
+
+            callBackgroundTimers();
 
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            if (callbackArrived.wait (0))
+                messageInFlight = false;
 
-            if (timeUntilFirstTimer <= 0)
+            const LockType::ScopedLockType sl (lock);
+
+            if (messageWheel.hasDueTimers())
             {
-                if (callbackArrived.wait (0))
-                {
-                    // already a message in flight - do nothing..
-                }
-                else
+                auto now = Time::getMillisecondCounter();
+
+                // Sometimes our message can get discarded by the OS (e.g. when running as an RTAS
+                // when the app has a modal loop), so if it hasn't arrived after a while, we assume
+                // that it's been lost and try again.
+                if (! messageInFlight || now - messagePostTime >= 300)
                 {
                     messageToSend->post();
-
-                    if (! callbackArrived.wait (300))
-                    {
-                        // Sometimes our message can get discarded by the OS (e.g. when running as an RTAS
-                        // when the app has a modal loop), so this is how long to wait before assuming the
-                        // message has been lost and trying again.
-                        messageToSend->post();
-                    }
-
-                    continue;
+                    messageInFlight = true;
+                    messagePostTime = now;
                 }
             }
 
+            auto timeToWait = backgroundWheel.getMillisecondsUntilNextTimer (100);
+
+            if (! messageInFlight)
+                timeToWait = jmin (timeToWait, messageWheel.getMillisecondsUntilNextTimer (100));
+
+            const LockType::ScopedUnlockType ul (lock);
+
             // don't wait for too long because running this loop also helps keep the
             // Time::getApproximateMillisecondTimer value stay up-to-date
-            wait (jlimit (1, 100, timeUntilFirstTimer));
+            wait (jlimit (1, 100, timeToWait));
         }
     }
 
@@ -95,23 +156,17 @@ public:
         auto timeout = Time::getMillisecondCounter() + 100;
 
         const LockType::ScopedLockType sl (lock);
+        advanceWheels();
 
-        while (! timers.empty())
+        while (auto* timer = messageWheel.popDueTimer())
         {
-            auto& first = timers.front();
-
-            if (first.countdownMs > 0)
-                break;
-
-            auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
-            notify();
+            reschedule (messageWheel, timer);
 
             const LockType::ScopedUnlockType ul (lock);
 
             JUCE_TRY
             {
+                JUCE_TRACE_ZONE ("Timer::timerCallback");
                 timer->timerCallback();
             }
             JUCE_CATCH_EXCEPTION
@@ -122,6 +177,7 @@ public:
         }
 
         callbackArrived.signal();
+        notify();
     }
 
     void callTimersSynchronously()
@@ -154,151 +210,259 @@ public:
     static void resetCounter (Timer* tim) noexcept
     {
         if (instance != nullptr)
-            instance->resetTimerCounter (tim);
+        {
+            instance->removeTimer (tim);
+            instance->addTimer (tim);
+        }
+    }
+
+    // must be called with the lock held
+    static void waitForBackgroundCallback (Timer* tim) noexcept
+    {
+        while (instance != nullptr
+                && instance->currentBackgroundTimer == tim
+                && Thread::getCurrentThreadId() != instance->getThreadId())
+        {
+            const LockType::ScopedUnlockType ul (lock);
+            Thread::yield();
+        }
     }
 
     static TimerThread* instance;
     static LockType lock;
 
 private:
-    struct TimerCountdown
-    {
-        Timer* timer;
-        int countdownMs;
-    };
-
-    std::vector<TimerCountdown> timers;
-
-    WaitableEvent callbackArrived;
-
-    struct CallTimersMessage  : public MessageManager::MessageBase
+    //==============================================================================
+    /*  A hierarchical timing wheel, with one tick per millisecond.
+
+        Timers that are due within the next 256 ticks go into the first level, which has
+        a slot for each tick. Timers that are due further ahead go into one of the coarser
+        levels, and are moved down a level each time the level below it wraps round, so
+        adding or removing a timer never has to touch any others.
+    */
+    struct Wheel
     {
-        CallTimersMessage() {}
+        static constexpr int numLevels = 5, firstLevelBits = 8, levelBits = 6;
+        static constexpr int firstLevelSize = 1 << firstLevelBits, levelSize = 1 << levelBits;
 
-        void messageCallback() override
+        void add (Timer* t) noexcept
         {
-            if (instance != nullptr)
-                instance->callTimers();
+            ++numTimers;
+            schedule (t);
         }
-    };
 
-    //==============================================================================
-    void addTimer (Timer* t)
-    {
-        // Trying to add a timer that's already here - shouldn't get to this point,
-        // so if you get this assertion, let me know!
-        jassert (std::none_of (timers.begin(), timers.end(),
-                               [t] (TimerCountdown i) { return i.timer == t; }));
+        void remove (Timer* t) noexcept
+        {
+            if (t->list != nullptr)
+            {
+                t->list->remove (t);
+                --numTimers;
+            }
+        }
 
-        auto pos = timers.size();
+        Timer* popDueTimer() noexcept
+        {
+            auto* t = dueTimers.popFront();
 
-        timers.push_back ({ t, t->timerPeriodMs });
-        t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
-        notify();
-    }
+            if (t != nullptr)
+                --numTimers;
 
-    void removeTimer (Timer* t)
-    {
-        auto pos = t->positionInQueue;
-        auto lastIndex = timers.size() - 1;
+            return t;
+        }
 
-        jassert (pos <= lastIndex);
-        jassert (timers[pos].timer == t);
+        bool hasDueTimers() const noexcept      { return ! dueTimers.isEmpty(); }
 
-        for (auto i = pos; i < lastIndex; ++i)
+        // moves all the timers that are due at or before the given tick into the due list
+        void advanceTo (uint64 tick) noexcept
         {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
-        }
+            if (numTimers == 0)
+            {
+                nextTick = jmax (nextTick, tick + 1);
+                return;
+            }
 
-        timers.pop_back();
-    }
+            while (nextTick <= tick)
+            {
+                auto index = (int) (nextTick & (firstLevelSize - 1));
 
-    void resetTimerCounter (Timer* t) noexcept
-    {
-        auto pos = t->positionInQueue;
+                if (index == 0)
+                    cascade();
 
-        jassert (pos < timers.size());
-        jassert (timers[pos].timer == t);
+                auto& slot = firstLevel[index];
 
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
+                while (auto* t = slot.popFront())
+                    dueTimers.append (t);
 
-        if (newCountdown != lastCountdown)
+                ++nextTick;
+            }
+        }
+
+        int getMillisecondsUntilNextTimer (int maximum) const noexcept
         {
-            timers[pos].countdownMs = newCountdown;
+            if (! dueTimers.isEmpty())
+                return 0;
+
+            if (numTimers == 0)
+                return maximum;
 
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
+            for (int i = 0; i < maximum; ++i)
+            {
+                auto index = (int) ((nextTick + (uint64) i) & (firstLevelSize - 1));
 
-            notify();
+                // (a coarser level may need to be moved down when the first level wraps round)
+                if (index == 0 || ! firstLevel[index].isEmpty())
+                    return i + 1;
+            }
+
+            return maximum;
         }
-    }
 
-    void shuffleTimerBackInQueue (size_t pos)
-    {
-        auto numTimers = timers.size();
+        uint64 nextTick = 0;
 
-        if (pos < numTimers - 1)
+    private:
+        void schedule (Timer* t) noexcept
         {
-            auto t = timers[pos];
-
-            for (;;)
+            if (t->dueTime < nextTick)
             {
-                auto next = pos + 1;
+                dueTimers.append (t);
+                return;
+            }
 
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
-                    break;
+            auto delta = t->dueTime - nextTick;
 
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
+            if (delta < (uint64) firstLevelSize)
+            {
+                firstLevel[t->dueTime & (firstLevelSize - 1)].append (t);
+                return;
+            }
 
-                ++pos;
+            int level = 1, shift = firstLevelBits;
+
+            while (level < numLevels - 1 && delta >= ((uint64) 1 << (shift + levelBits)))
+            {
+                ++level;
+                shift += levelBits;
             }
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            upperLevels[level - 1][(t->dueTime >> shift) & (levelSize - 1)].append (t);
         }
-    }
 
-    void shuffleTimerForwardInQueue (size_t pos)
-    {
-        if (pos > 0)
+        void cascade() noexcept
         {
-            auto t = timers[pos];
-
-            while (pos > 0)
+            for (int level = 1, shift = firstLevelBits; level < numLevels; ++level, shift += levelBits)
             {
-                auto& prev = timers[(size_t) pos - 1];
+                auto index = (int) ((nextTick >> shift) & (levelSize - 1));
+                auto& slot = upperLevels[level - 1][index];
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
+                TimerList timersToMove;
+
+                while (auto* t = slot.popFront())
+                    timersToMove.append (t);
 
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+                while (auto* t = timersToMove.popFront())
+                    schedule (t);
 
-                --pos;
+                if (index != 0)
+                    break;
             }
+        }
+
+        TimerList firstLevel[firstLevelSize];
+        TimerList upperLevels[numLevels - 1][levelSize];
+        TimerList dueTimers;
+        int numTimers = 0;
+    };
+
+    Wheel messageWheel, backgroundWheel;
+    uint64 currentTick = 0;
+    uint32 lastCounterMs;
+    Timer* currentBackgroundTimer = nullptr;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+    WaitableEvent callbackArrived;
+
+    struct CallTimersMessage  : public MessageManager::MessageBase
+    {
+        CallTimersMessage() {}
+
+        void messageCallback() override
+        {
+            if (instance != nullptr)
+                instance->callTimers();
         }
+    };
+
+    //==============================================================================
+    Wheel& getWheel (const Timer& t) noexcept
+    {
+        return t.affinity == Affinity::backgroundThread ? backgroundWheel : messageWheel;
+    }
+
+    uint64 getCurrentTick() const noexcept
+    {
+        return currentTick + (uint32) (Time::getMillisecondCounter() - lastCounterMs);
+    }
+
+    void advanceWheels() noexcept
+    {
+        auto now = Time::getMillisecondCounter();
+        currentTick += (uint32) (now - lastCounterMs);
+        lastCounterMs = now;
+
+        messageWheel.advanceTo (currentTick);
+        backgroundWheel.advanceTo (currentTick);
+    }
+
+    void reschedule (Wheel& wheel, Timer* t) noexcept
+    {
+        t->dueTime = getCurrentTick() + (uint64) t->timerPeriodMs;
+        wheel.add (t);
+    }
+
+    void addTimer (Timer* t) noexcept
+    {
+        // Trying to add a timer that's already here - shouldn't get to this point,
+        // so if you get this assertion, let me know!
+        jassert (t->list == nullptr);
+
+        reschedule (getWheel (*t), t);
+
+        // background timers mustn't depend on the message thread to get going
+        if (t->affinity == Affinity::backgroundThread && ! isThreadRunning())
+            startThread (Priority::high);
+
+        notify();
+    }
+
+    void removeTimer (Timer* t) noexcept
+    {
+        getWheel (*t).remove (t);
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    void callBackgroundTimers()
     {
         const LockType::ScopedLockType sl (lock);
 
-        if (timers.empty())
-            return 1000;
+        while (auto* timer = backgroundWheel.popDueTimer())
+        {
+            reschedule (backgroundWheel, timer);
+            currentBackgroundTimer = timer;
+
+            {
+                const LockType::ScopedUnlockType ul (lock);
+
+                JUCE_TRY
+                {
+                    JUCE_TRACE_ZONE ("Timer::timerCallback");
+                    timer->timerCallback();
+                }
+                JUCE_CATCH_EXCEPTION
+            }
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
+            currentBackgroundTimer = nullptr;
 
-        return timers.front().countdownMs;
+            if (threadShouldExit())
+                break;
+        }
     }
 
     void handleAsyncUpdate() override
@@ -363,6 +527,27 @@ void Timer::stopTimer() noexcept
         TimerThread::remove (this);
         timerPeriodMs = 0;
     }
+
+    if (affinity == Affinity::backgroundThread)
+        TimerThread::waitForBackgroundCallback (this);
+}
+
+void Timer::setTimerAffinity (Affinity newAffinity) noexcept
+{
+    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
+
+    if (affinity != newAffinity)
+    {
+        const bool wasRunning = isTimerRunning();
+
+        if (wasRunning)
+            TimerThread::remove (this);
+
+        affinity = newAffinity;
+
+        if (wasRunning)
+            TimerThread::add (this);
+    }
 }
 
 void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
@@ -395,4 +580,140 @@ void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, std::function<void()
     new LambdaInvoker (milliseconds, f);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TimerTests  : public UnitTest
+{
+public:
+    TimerTests()
+        : UnitTest ("Timer", UnitTestCategories::threads)
+    {
+        setIsolation (Isolation::messageThread);
+    }
+
+    struct CountingTimer  : public Timer
+    {
+        explicit CountingTimer (Affinity a = Affinity::backgroundThread)
+        {
+            setTimerAffinity (a);
+        }
+
+        ~CountingTimer() override
+        {
+            stopTimer();
+        }
+
+        void timerCallback() override
+        {
+            ++count;
+
+            if (callbackDuration > 0)
+            {
+                isInCallback = true;
+                Thread::sleep (callbackDuration);
+                isInCallback = false;
+            }
+        }
+
+        std::atomic<int> count { 0 };
+        std::atomic<bool> isInCallback { false };
+        int callbackDuration = 0;
+    };
+
+    static bool waitFor (std::function<bool()> condition, int timeoutMs = 5000)
+    {
+        for (auto end = Time::getMillisecondCounter() + (uint32) timeoutMs; Time::getMillisecondCounter() < end;)
+        {
+            if (condition())
+                return true;
+
+            Thread::sleep (1);
+        }
+
+        return condition();
+    }
+
+    void runTest() override
+    {
+        beginTest ("Background timers");
+        {
+            CountingTimer timer;
+            expect (timer.getTimerAffinity() == Timer::Affinity::backgroundThread);
+
+            timer.startTimer (5);
+            expect (waitFor ([&] { return timer.count >= 5; }));
+
+            timer.stopTimer();
+            auto countAfterStopping = timer.count.load();
+            Thread::sleep (50);
+            expectEquals (timer.count.load(), countAfterStopping);
+        }
+
+        beginTest ("Intervals are respected");
+        {
+            CountingTimer fast, slow;
+            slow.startTimer (100);
+            fast.startTimer (1);
+
+            expect (waitFor ([&] { return fast.count >= 50; }));
+            expectEquals (slow.count.load(), 0);
+
+            expect (waitFor ([&] { return slow.count >= 2; }));
+        }
+
+        beginTest ("Many timers");
+        {
+            Random r = getRandom();
+            OwnedArray<CountingTimer> timers;
+
+            for (int i = 0; i < 2000; ++i)
+                timers.add (new CountingTimer())->startTimer (1 + r.nextInt (300));
+
+            // stopping and restarting shouldn't disturb the others
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto* t = timers[r.nextInt (timers.size())];
+                t->stopTimer();
+                t->startTimer (1 + r.nextInt (300));
+            }
+
+            expect (waitFor ([&] { return std::all_of (timers.begin(), timers.end(), [] (CountingTimer* t) { return t->count > 0; }); }));
+
+            for (auto* t : timers)
+                t->stopTimer();
+        }
+
+        beginTest ("Stopping a background timer waits for its callback");
+        {
+            CountingTimer timer;
+            timer.callbackDuration = 50;
+            timer.startTimer (1);
+
+            expect (waitFor ([&] { return timer.isInCallback.load(); }));
+            timer.stopTimer();
+            expect (! timer.isInCallback);
+        }
+
+        beginTest ("Message thread timers");
+        {
+            CountingTimer timer (Timer::Affinity::messageThread);
+            timer.startTimer (1);
+
+            expect (waitFor ([&]
+            {
+                Timer::callPendingTimersSynchronously();
+                return timer.count > 0;
+            }));
+
+            timer.stopTimer();
+        }
+    }
+};
+
+static TimerTests timerTests;
+
+#endif
+
 } // namespace juce
@@ -39,6 +39,10 @@ namespace juce
     anything that blocks the message queue for a period of time will also prevent
     any timers from running until it can carry on.
 
+    Timers that don't need to touch the GUI can be given backgroundThread affinity
+    with setTimerAffinity(), so that their callbacks are made on the shared timer
+    thread instead, and aren't held up by a busy message thread.
+
     If you need to have a single callback that is shared by multiple timers with
     different frequencies, then the MultiTimer class allows you to do that - its
     structure is very similar to the Timer class, but contains multiple timers
@@ -103,9 +107,35 @@ public:
         future timer callbacks, but it will return without waiting for the current one
         to finish. The current callback will continue, possibly still running some of
         your timer code after this method has returned.
+
+        For a timer with backgroundThread affinity it's the other way round: if the
+        callback is running, this waits for it to finish (unless it's being called from
+        inside the callback itself), so that it's safe to delete the timer afterwards.
+        Make sure the callback can't be blocked by whatever thread calls stopTimer().
     */
     void stopTimer() noexcept;
 
+    //==============================================================================
+    /** The threads on which a timer's callbacks can be made. */
+    enum class Affinity
+    {
+        messageThread,      /**< The callbacks are made on the message thread (the default). */
+        backgroundThread    /**< The callbacks are made on the shared timer thread. */
+    };
+
+    /** Chooses the thread on which the timer's callbacks are made.
+
+        A backgroundThread timer keeps running while the message thread is busy, but
+        its callback mustn't do anything that needs the message thread, and it shares
+        the timer thread with all the other background timers, so it should be quick.
+
+        If the timer is running, it's restarted with its current interval.
+    */
+    void setTimerAffinity (Affinity newAffinity) noexcept;
+
+    /** Returns the thread on which the timer's callbacks are made. */
+    Affinity getTimerAffinity() const noexcept              { return affinity; }
+
     //==============================================================================
     /** Returns true if the timer is currently running. */
     bool isTimerRunning() const noexcept                    { return timerPeriodMs > 0; }
@@ -128,8 +158,14 @@ public:
 private:
     class TimerThread;
     friend class TimerThread;
-    size_t positionInQueue = (size_t) -1;
+    struct TimerList;
+
+    Timer* previousInList = nullptr;
+    Timer* nextInList = nullptr;
+    TimerList* list = nullptr;
+    uint64 dueTime = 0;
     int timerPeriodMs = 0;
+    Affinity affinity = Affinity::messageThread;
 
     Timer& operator= (const Timer&) = delete;
 };
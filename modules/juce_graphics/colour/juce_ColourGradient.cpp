@@ -226,14 +226,19 @@ void ColourGradient::createLookupTable (PixelARGB* const lookupTable, const int
         lookupTable [index++] = pix1;
 }
 
+int ColourGradient::getLookupTableSize (const AffineTransform& transform) const noexcept
+{
+    return jlimit (1, jmax (1, (colours.size() - 1) << 8),
+                   3 * (int) point1.transformedBy (transform)
+                                   .getDistanceFrom (point2.transformedBy (transform)));
+}
+
 int ColourGradient::createLookupTable (const AffineTransform& transform, HeapBlock<PixelARGB>& lookupTable) const
 {
     JUCE_COLOURGRADIENT_CHECK_COORDS_INITIALISED // Trying to use this object without setting its coordinates?
     jassert (colours.size() >= 2);
 
-    auto numEntries = jlimit (1, jmax (1, (colours.size() - 1) << 8),
-                              3 * (int) point1.transformedBy (transform)
-                                              .getDistanceFrom (point2.transformedBy (transform)));
+    auto numEntries = getLookupTableSize (transform);
     lookupTable.malloc (numEntries);
     createLookupTable (lookupTable, numEntries);
     return numEntries;
@@ -178,6 +178,11 @@ public:
     */
     int createLookupTable (const AffineTransform& transform, HeapBlock<PixelARGB>& resultLookupTable) const;
 
+    /** Returns the number of colours that createLookupTable() will create when it's
+        called with this transform.
+    */
+    int getLookupTableSize (const AffineTransform& transform) const noexcept;
+
     /** Creates a set of interpolated premultiplied ARGB values.
         This will fill an array of a user-specified size with the gradient, interpolating to fit.
         The numEntries argument specifies the size of the array, and this size must be greater than zero.
@@ -568,13 +568,129 @@ void Graphics::fillPath (const Path& path, const AffineTransform& transform) con
         context.fillPath (path, transform);
 }
 
+//==============================================================================
+// Keeps the outlines of recently stroked paths, so that a path which is redrawn without
+// changing doesn't need to be re-stroked every time. A stroke is only stored the second
+// time it's seen, so paths that are rebuilt for every paint don't pollute the cache.
+struct StrokedPathCache final : public DeletedAtShutdown
+{
+    StrokedPathCache() = default;
+
+    ~StrokedPathCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    void strokePath (const Graphics& g, const Path& path, const PathStrokeType& strokeType,
+                     const AffineTransform& transform, float extraAccuracy)
+    {
+        // Moving a path doesn't change the shape of its stroke, so the translation is left
+        // out of the key and applied to the cached outline instead.
+        const Key key { path.getContentID(),
+                        transform.mat00, transform.mat01, transform.mat10, transform.mat11,
+                        extraAccuracy, strokeType.getStrokeThickness(),
+                        (int) strokeType.getJointStyle(), (int) strokeType.getEndStyle() };
+
+        const Point<float> offset (transform.getTranslationX(), transform.getTranslationY());
+        std::shared_ptr<const Path> cached;
+        Point<float> cachedOffset;
+        auto shouldStore = false;
+
+        {
+            const ScopedTryLock stl (lock);
+
+            if (stl.isLocked())
+            {
+                auto iter = cache.find (key);
+
+                if (iter != cache.end())
+                {
+                    if (iter->second.cachePosition != cacheOrder.begin())
+                        cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second.cachePosition);
+
+                    cached = iter->second.stroke;
+                    cachedOffset = iter->second.offset;
+                    shouldStore = (cached == nullptr);
+                }
+                else
+                {
+                    iter = cache.emplace (key, CachedStroke()).first;
+                    cacheOrder.push_front (iter);
+                    iter->second.cachePosition = cacheOrder.begin();
+
+                    while (cache.size() > cacheSize)
+                    {
+                        cache.erase (cacheOrder.back());
+                        cacheOrder.pop_back();
+                    }
+                }
+            }
+        }
+
+        if (cached != nullptr)
+        {
+            if (offset == cachedOffset)
+                g.fillPath (*cached);
+            else
+                g.fillPath (*cached, AffineTransform::translation (offset - cachedOffset));
+
+            return;
+        }
+
+        if (! shouldStore)
+        {
+            Path stroke;
+            strokeType.createStrokedPath (stroke, path, transform, extraAccuracy);
+            g.fillPath (stroke);
+            return;
+        }
+
+        auto stroke = std::make_shared<Path>();
+        strokeType.createStrokedPath (*stroke, path, transform, extraAccuracy);
+        g.fillPath (*stroke);
+
+        const ScopedTryLock stl (lock);
+
+        if (stl.isLocked())
+        {
+            auto iter = cache.find (key);
+
+            if (iter != cache.end())
+            {
+                iter->second.stroke = std::move (stroke);
+                iter->second.offset = offset;
+            }
+        }
+    }
+
+    JUCE_DECLARE_SINGLETON (StrokedPathCache, false)
+
+private:
+    using Key = std::tuple<uint64, float, float, float, float, float, float, int, int>;
+
+    struct CachedStroke
+    {
+        std::shared_ptr<const Path> stroke;
+        Point<float> offset;
+        std::list<std::map<Key, CachedStroke>::iterator>::iterator cachePosition;
+    };
+
+    static constexpr size_t cacheSize = 32;
+    std::map<Key, CachedStroke> cache;
+    std::list<std::map<Key, CachedStroke>::iterator> cacheOrder;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (StrokedPathCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (StrokedPathCache)
+
 void Graphics::strokePath (const Path& path,
                            const PathStrokeType& strokeType,
                            const AffineTransform& transform) const
 {
-    Path stroke;
-    strokeType.createStrokedPath (stroke, path, transform, context.getPhysicalPixelScaleFactor());
-    fillPath (stroke);
+    StrokedPathCache::getInstance()->strokePath (*this, path, strokeType, transform,
+                                                 context.getPhysicalPixelScaleFactor());
 }
 
 //==============================================================================
@@ -864,4 +980,102 @@ Graphics::ScopedSaveState::~ScopedSaveState()
     context.restoreState();
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StrokedPathCacheTests  : public UnitTest
+{
+public:
+    StrokedPathCacheTests()
+        : UnitTest ("StrokedPathCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        const PathStrokeType stroke (3.0f, PathStrokeType::curved, PathStrokeType::rounded);
+
+        Path path;
+        path.startNewSubPath (10.0f, 50.0f);
+        path.cubicTo (30.0f, 0.0f, 60.0f, 100.0f, 90.0f, 20.0f);
+
+        beginTest ("Cached strokes match stroking directly");
+        {
+            for (int i = 0; i < 3; ++i)
+                expect (imagesMatch (strokeWithCache (path, stroke, {}),
+                                     strokeDirectly (path, stroke, {})));
+        }
+
+        beginTest ("Cached strokes can be reused at a different position");
+        {
+            const auto moved = AffineTransform::translation (7.0f, -4.0f);
+
+            expect (imagesMatch (strokeWithCache (path, stroke, moved),
+                                 strokeDirectly (path, stroke, moved)));
+        }
+
+        beginTest ("Changing a path or the stroke invalidates the cached outline");
+        {
+            auto copy = path;
+            copy.lineTo (95.0f, 90.0f);
+
+            expect (imagesMatch (strokeWithCache (copy, stroke, {}),
+                                 strokeDirectly (copy, stroke, {})));
+
+            expect (imagesMatch (strokeWithCache (path, stroke, {}),
+                                 strokeDirectly (path, stroke, {})));
+
+            const PathStrokeType thicker (8.0f);
+
+            expect (imagesMatch (strokeWithCache (path, thicker, {}),
+                                 strokeDirectly (path, thicker, {})));
+
+            const auto scaled = AffineTransform::scale (0.5f);
+
+            expect (imagesMatch (strokeWithCache (path, stroke, scaled),
+                                 strokeDirectly (path, stroke, scaled)));
+        }
+    }
+
+private:
+    static Image strokeWithCache (const Path& path, const PathStrokeType& stroke, const AffineTransform& transform)
+    {
+        Image image (Image::ARGB, 100, 100, true, SoftwareImageType());
+        Graphics g (image);
+        g.setColour (Colours::white);
+        g.strokePath (path, stroke, transform);
+        return image;
+    }
+
+    static Image strokeDirectly (const Path& path, const PathStrokeType& stroke, const AffineTransform& transform)
+    {
+        Image image (Image::ARGB, 100, 100, true, SoftwareImageType());
+        Graphics g (image);
+        g.setColour (Colours::white);
+
+        Path outline;
+        stroke.createStrokedPath (outline, path, transform);
+        g.fillPath (outline);
+        return image;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b)
+    {
+        const Image::BitmapData da (a, Image::BitmapData::readOnly);
+        const Image::BitmapData db (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (std::abs ((int) da.getPixelColour (x, y).getAlpha() - (int) db.getPixelColour (x, y).getAlpha()) > 2)
+                    return false;
+
+        return true;
+    }
+};
+
+static StrokedPathCacheTests strokedPathCacheTests;
+
+#endif
+
 } // namespace juce
@@ -0,0 +1,442 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+void GraphicsDisplayList::replay (LowLevelGraphicsContext& target) const
+{
+    if (numDrawingCommands == 0 || target.isClipEmpty())
+        return;
+
+    // The command bounds are in the recorder's original coordinate space, which
+    // is the same as the target's current user space
+    const auto visibleArea = target.getClipBounds();
+
+    target.saveState();
+
+    for (auto& command : commands)
+        if (! command.isDrawing || command.bounds.intersects (visibleArea))
+            command.apply (target);
+
+    target.restoreState();
+}
+
+void GraphicsDisplayList::draw (Graphics& g, const AffineTransform& transform) const
+{
+    Graphics::ScopedSaveState state (g);
+    g.addTransform (transform);
+    replay (g.getInternalContext());
+}
+
+void GraphicsDisplayList::clear() noexcept
+{
+    commands.clear();
+    numDrawingCommands = 0;
+}
+
+void GraphicsDisplayList::removeDrawingCommands()
+{
+    commands.erase (std::remove_if (commands.begin(), commands.end(), [] (const Command& c) { return c.isDrawing; }),
+                    commands.end());
+    numDrawingCommands = 0;
+}
+
+//==============================================================================
+/*  Follows the transform and clip while commands are being recorded, so that queries
+    can be answered straight away and each drawing command can be given its bounds.
+    Nothing is ever drawn with it.
+*/
+class GraphicsDisplayList::Recorder::StateTracker  : public LowLevelGraphicsSoftwareRenderer
+{
+public:
+    using LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer;
+
+    Rectangle<int> getDeviceSpaceClipBounds() const
+    {
+        return stack->clip != nullptr ? stack->clip->getClipBounds() : Rectangle<int>();
+    }
+
+    AffineTransform getTransform() const
+    {
+        return stack->transform.getTransform();
+    }
+};
+
+//==============================================================================
+GraphicsDisplayList::Recorder::Recorder (GraphicsDisplayList& listToRecordInto, Rectangle<int> area)
+    : Recorder (listToRecordInto, {}, area)
+{
+}
+
+GraphicsDisplayList::Recorder::Recorder (GraphicsDisplayList& listToRecordInto,
+                                         Point<int> origin,
+                                         const RectangleList<int>& initialClip)
+    : list (listToRecordInto),
+      initialOrigin (origin),
+      stateTracker (std::make_unique<StateTracker> (Image(), origin, initialClip))
+{
+}
+
+GraphicsDisplayList::Recorder::~Recorder() = default;
+
+//==============================================================================
+void GraphicsDisplayList::Recorder::recordState (std::function<void (LowLevelGraphicsContext&)> command)
+{
+    list.commands.push_back ({ std::move (command), {}, false });
+}
+
+void GraphicsDisplayList::Recorder::recordDrawing (Rectangle<float> userSpaceBounds,
+                                                   std::function<void (LowLevelGraphicsContext&)> command)
+{
+    // allow a pixel of slack for anti-aliased edges
+    addDrawing (userSpaceBounds.transformedBy (stateTracker->getTransform())
+                               .expanded (1.0f)
+                               .getIntersection (stateTracker->getDeviceSpaceClipBounds().toFloat())
+                               .getSmallestIntegerContainer(),
+                std::move (command));
+}
+
+void GraphicsDisplayList::Recorder::recordDrawingWithinClip (std::function<void (LowLevelGraphicsContext&)> command)
+{
+    addDrawing (stateTracker->getDeviceSpaceClipBounds(), std::move (command));
+}
+
+void GraphicsDisplayList::Recorder::addDrawing (Rectangle<int> deviceSpaceBounds,
+                                                std::function<void (LowLevelGraphicsContext&)> command)
+{
+    if (deviceSpaceBounds.isEmpty())
+        return;
+
+    list.commands.push_back ({ std::move (command), deviceSpaceBounds - initialOrigin, true });
+    ++list.numDrawingCommands;
+}
+
+//==============================================================================
+bool GraphicsDisplayList::Recorder::isVectorDevice() const                          { return false; }
+float GraphicsDisplayList::Recorder::getPhysicalPixelScaleFactor()                  { return stateTracker->getPhysicalPixelScaleFactor(); }
+bool GraphicsDisplayList::Recorder::clipRegionIntersects (const Rectangle<int>& r)  { return stateTracker->clipRegionIntersects (r); }
+Rectangle<int> GraphicsDisplayList::Recorder::getClipBounds() const                 { return stateTracker->getClipBounds(); }
+bool GraphicsDisplayList::Recorder::isClipEmpty() const                             { return stateTracker->isClipEmpty(); }
+const Font& GraphicsDisplayList::Recorder::getFont()                                { return stateTracker->getFont(); }
+
+void GraphicsDisplayList::Recorder::setOrigin (Point<int> o)
+{
+    stateTracker->setOrigin (o);
+    recordState ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+}
+
+void GraphicsDisplayList::Recorder::addTransform (const AffineTransform& t)
+{
+    stateTracker->addTransform (t);
+    recordState ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+}
+
+bool GraphicsDisplayList::Recorder::clipToRectangle (const Rectangle<int>& r)
+{
+    recordState ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+    return stateTracker->clipToRectangle (r);
+}
+
+bool GraphicsDisplayList::Recorder::clipToRectangleList (const RectangleList<int>& r)
+{
+    recordState ([r] (LowLevelGraphicsContext& g) { g.clipToRectangleList (r); });
+    return stateTracker->clipToRectangleList (r);
+}
+
+void GraphicsDisplayList::Recorder::excludeClipRectangle (const Rectangle<int>& r)
+{
+    stateTracker->excludeClipRectangle (r);
+    recordState ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+}
+
+void GraphicsDisplayList::Recorder::clipToPath (const Path& path, const AffineTransform& t)
+{
+    stateTracker->clipToPath (path, t);
+    recordState ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+}
+
+void GraphicsDisplayList::Recorder::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    stateTracker->clipToImageAlpha (im, t);
+    recordState ([im, t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (im, t); });
+}
+
+void GraphicsDisplayList::Recorder::saveState()
+{
+    stateTracker->saveState();
+    recordState ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+}
+
+void GraphicsDisplayList::Recorder::restoreState()
+{
+    stateTracker->restoreState();
+    recordState ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+}
+
+void GraphicsDisplayList::Recorder::beginTransparencyLayer (float opacity)
+{
+    // The layer itself isn't needed to answer queries, so the tracker just saves its state
+    stateTracker->saveState();
+    ++transparencyLayerDepth;
+    recordState ([opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); });
+}
+
+void GraphicsDisplayList::Recorder::endTransparencyLayer()
+{
+    jassert (transparencyLayerDepth > 0);
+
+    stateTracker->restoreState();
+    --transparencyLayerDepth;
+    recordState ([] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); });
+}
+
+void GraphicsDisplayList::Recorder::setFill (const FillType& fillType)
+{
+    recordState ([fillType] (LowLevelGraphicsContext& g) { g.setFill (fillType); });
+}
+
+void GraphicsDisplayList::Recorder::setOpacity (float newOpacity)
+{
+    recordState ([newOpacity] (LowLevelGraphicsContext& g) { g.setOpacity (newOpacity); });
+}
+
+void GraphicsDisplayList::Recorder::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    recordState ([quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); });
+}
+
+void GraphicsDisplayList::Recorder::setFont (const Font& newFont)
+{
+    stateTracker->setFont (newFont);
+    recordState ([newFont] (LowLevelGraphicsContext& g) { g.setFont (newFont); });
+}
+
+void GraphicsDisplayList::Recorder::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    recordDrawing (r.toFloat(), [r, replaceExistingContents] (LowLevelGraphicsContext& g) { g.fillRect (r, replaceExistingContents); });
+}
+
+void GraphicsDisplayList::Recorder::fillRect (const Rectangle<float>& r)
+{
+    recordDrawing (r, [r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+}
+
+void GraphicsDisplayList::Recorder::fillRectList (const RectangleList<float>& rects)
+{
+    recordDrawing (rects.getBounds(), [rects] (LowLevelGraphicsContext& g) { g.fillRectList (rects); });
+}
+
+void GraphicsDisplayList::Recorder::fillPath (const Path& path, const AffineTransform& t)
+{
+    recordDrawing (path.getBoundsTransformed (t), [path, t] (LowLevelGraphicsContext& g) { g.fillPath (path, t); });
+}
+
+void GraphicsDisplayList::Recorder::drawImage (const Image& im, const AffineTransform& t)
+{
+    recordDrawing (im.getBounds().toFloat().transformedBy (t), [im, t] (LowLevelGraphicsContext& g) { g.drawImage (im, t); });
+}
+
+void GraphicsDisplayList::Recorder::drawLine (const Line<float>& line)
+{
+    recordDrawing (Rectangle<float> (line.getStart(), line.getEnd()), [line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+}
+
+void GraphicsDisplayList::Recorder::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    recordDrawingWithinClip ([glyphNumber, t] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); });
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class GraphicsDisplayListTests  : public UnitTest
+{
+public:
+    GraphicsDisplayListTests()
+        : UnitTest ("GraphicsDisplayList", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Replaying a display list matches drawing directly");
+        {
+            GraphicsDisplayList list;
+
+            {
+                GraphicsDisplayList::Recorder recorder (list, { width, height });
+                Graphics g (recorder);
+                drawScene (g);
+            }
+
+            expect (! list.isEmpty());
+
+            Image expected (Image::ARGB, width, height, true, SoftwareImageType());
+            Image actual (Image::ARGB, width, height, true, SoftwareImageType());
+
+            {
+                Graphics g (expected);
+                drawScene (g);
+            }
+
+            {
+                Graphics g (actual);
+                list.draw (g);
+            }
+
+            expect (imagesAreIdentical (expected, actual));
+        }
+
+        beginTest ("Replaying into a clipped and transformed context matches drawing directly");
+        {
+            GraphicsDisplayList list;
+
+            {
+                GraphicsDisplayList::Recorder recorder (list, { width, height });
+                Graphics g (recorder);
+                drawScene (g);
+            }
+
+            const auto transform = AffineTransform::scale (1.5f).translated (-40.0f, -25.0f);
+            RectangleList<int> clip;
+            clip.add ({ 10, 10, 80, 60 });
+            clip.add ({ 150, 90, 100, 80 });
+
+            Image expected (Image::RGB, width, height, true, SoftwareImageType());
+            Image actual (Image::RGB, width, height, true, SoftwareImageType());
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected, {}, clip);
+                Graphics g (context);
+                g.addTransform (transform);
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (actual, {}, clip);
+                Graphics g (context);
+                list.draw (g, transform);
+
+                g.setColour (Colours::black);
+                g.fillRect (12, 12, 5, 5);
+                expect (g.getClipBounds() == clip.getBounds());
+            }
+
+            {
+                Graphics g (expected);
+                g.reduceClipRegion (clip);
+                g.setColour (Colours::black);
+                g.fillRect (12, 12, 5, 5);
+            }
+
+            expect (imagesAreIdentical (expected, actual));
+        }
+
+        beginTest ("The recorder answers queries like a real context");
+        {
+            GraphicsDisplayList list;
+            GraphicsDisplayList::Recorder recorder (list, { width, height });
+            Graphics g (recorder);
+
+            g.setOrigin ({ 10, 20 });
+            g.reduceClipRegion (0, 0, 50, 40);
+
+            expect (g.getClipBounds() == Rectangle<int> (0, 0, 50, 40));
+            expect (! g.clipRegionIntersects ({ 60, 0, 10, 10 }));
+
+            g.setColour (Colours::red);
+            g.fillRect (100, 100, 10, 10);
+            expect (list.isEmpty());
+
+            g.fillRect (10, 10, 10, 10);
+            expect (! list.isEmpty());
+
+            const auto numStateCommands = list.getNumCommands() - 1;
+            list.removeDrawingCommands();
+            expect (list.isEmpty());
+            expectEquals (list.getNumCommands(), numStateCommands);
+
+            list.clear();
+            expectEquals (list.getNumCommands(), 0);
+        }
+    }
+
+private:
+    static constexpr int width = 300, height = 200;
+
+    static void drawScene (Graphics& g)
+    {
+        g.fillAll (Colours::white);
+
+        g.setGradientFill (ColourGradient (Colours::red, 0.0f, 0.0f, Colours::blue, 300.0f, 200.0f, false));
+        g.fillRoundedRectangle (10.5f, 12.25f, 200.0f, 120.0f, 15.0f);
+
+        {
+            Graphics::ScopedSaveState state (g);
+            g.addTransform (AffineTransform::rotation (0.3f, 150.0f, 100.0f));
+            g.setColour (Colours::green.withAlpha (0.6f));
+            g.fillEllipse (60.0f, 40.0f, 180.0f, 90.0f);
+        }
+
+        Random random (4321);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            g.setColour (Colour (random.nextInt()).withAlpha (0.4f));
+            g.fillRect (random.nextFloat() * (float) width, random.nextFloat() * (float) height,
+                        random.nextFloat() * 30.0f, random.nextFloat() * 30.0f);
+        }
+
+        g.reduceClipRegion (20, 20, 250, 160);
+
+        g.beginTransparencyLayer (0.5f);
+        g.setColour (Colours::black);
+        g.drawLine (0.0f, 0.0f, 300.0f, 200.0f, 3.0f);
+        g.setFont (30.0f);
+        g.drawText ("Display list", 40, 100, 220, 50, Justification::centred);
+        g.endTransparencyLayer();
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < dataA.height; ++y)
+            if (memcmp (dataA.getLinePointer (y), dataB.getLinePointer (y), (size_t) (dataA.width * dataA.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+};
+
+static GraphicsDisplayListTests graphicsDisplayListTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A recorded sequence of drawing operations that can be replayed into any context.
+
+    To fill a list, create a GraphicsDisplayList::Recorder and draw into it with a
+    Graphics object. The list can then be replayed as many times as you like, into
+    any LowLevelGraphicsContext and with any transform, which is much quicker than
+    repeating a complicated paint routine. Because the operations stay as vectors,
+    replaying at a different scale doesn't lose any quality, unlike a cached image.
+
+    Each drawing operation remembers the area that it can affect, so when the list
+    is replayed, any operations that fall outside the target's clip region are
+    skipped.
+
+    The list holds on to copies of the Images, Paths and Fonts that were used, so it
+    stays valid after the objects that were drawn have been deleted.
+
+    @see DisplayListCachedComponentImage
+
+    @tags{Graphics}
+*/
+class JUCE_API  GraphicsDisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    GraphicsDisplayList() = default;
+
+    GraphicsDisplayList (const GraphicsDisplayList&) = default;
+    GraphicsDisplayList (GraphicsDisplayList&&) noexcept = default;
+    GraphicsDisplayList& operator= (const GraphicsDisplayList&) = default;
+    GraphicsDisplayList& operator= (GraphicsDisplayList&&) noexcept = default;
+
+    //==============================================================================
+    /** Replays the recorded operations into a context.
+
+        The operations are drawn relative to the target's current origin, transform and
+        clip, just as if the code that was recorded had been run directly on it. The
+        target's state is restored afterwards.
+    */
+    void replay (LowLevelGraphicsContext& target) const;
+
+    /** Replays the recorded operations into a Graphics context with an extra transform. */
+    void draw (Graphics& g, const AffineTransform& transform = {}) const;
+
+    /** Returns true if the list contains no drawing operations. */
+    bool isEmpty() const noexcept                       { return numDrawingCommands == 0; }
+
+    /** Returns the total number of recorded operations, including state changes. */
+    int getNumCommands() const noexcept                 { return (int) commands.size(); }
+
+    /** Removes all the recorded operations. */
+    void clear() noexcept;
+
+    /** Removes the drawing operations but keeps the changes to the transform, clip and
+        fill, so that anything recorded afterwards will use the same state.
+    */
+    void removeDrawingCommands();
+
+    //==============================================================================
+    class Recorder;
+
+private:
+    //==============================================================================
+    struct Command
+    {
+        std::function<void (LowLevelGraphicsContext&)> apply;
+        Rectangle<int> bounds;
+        bool isDrawing;
+    };
+
+    std::vector<Command> commands;
+    int numDrawingCommands = 0;
+
+    JUCE_LEAK_DETECTOR (GraphicsDisplayList)
+};
+
+//==============================================================================
+/**
+    A LowLevelGraphicsContext that records everything drawn into it in a
+    GraphicsDisplayList.
+
+    The recorder keeps track of the transform and clip as it goes, so that queries such
+    as getClipBounds() and clipRegionIntersects() give the same answers that a real
+    context of the same size would, and paint routines that skip hidden areas behave
+    normally.
+
+    @tags{Graphics}
+*/
+class JUCE_API  GraphicsDisplayList::Recorder   : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a recorder that adds to the given list.
+
+        The area is the region that can be drawn into, in the same way as the size of the
+        image for an ordinary context. The list must outlive the recorder.
+    */
+    Recorder (GraphicsDisplayList& listToRecordInto, Rectangle<int> area);
+
+    /** Creates a recorder with an origin and a clip region. */
+    Recorder (GraphicsDisplayList& listToRecordInto, Point<int> origin, const RectangleList<int>& initialClip);
+
+    /** Destructor. */
+    ~Recorder() override;
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+protected:
+    /** Returns true if a transparency layer has been started and not yet ended. */
+    bool isInsideTransparencyLayer() const noexcept     { return transparencyLayerDepth > 0; }
+
+private:
+    //==============================================================================
+    class StateTracker;
+
+    void recordState (std::function<void (LowLevelGraphicsContext&)>);
+    void recordDrawing (Rectangle<float> userSpaceBounds, std::function<void (LowLevelGraphicsContext&)>);
+    void recordDrawingWithinClip (std::function<void (LowLevelGraphicsContext&)>);
+    void addDrawing (Rectangle<int> deviceSpaceBounds, std::function<void (LowLevelGraphicsContext&)>);
+
+    GraphicsDisplayList& list;
+    Point<int> initialOrigin;
+    std::unique_ptr<StateTracker> stateTracker;
+    int transparencyLayerDepth = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+};
+
+} // namespace juce
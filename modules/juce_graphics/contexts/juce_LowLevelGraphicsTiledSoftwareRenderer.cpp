@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Gives the tile renderers access to the target image's pixels through a single
+    BitmapData, so that the worker threads never touch the target's listener list.
+*/
+class LowLevelGraphicsTiledSoftwareRenderer::TilePixelData  : public ImagePixelData
+{
+public:
+    explicit TilePixelData (const Image& target)
+        : ImagePixelData (target.getFormat(), target.getWidth(), target.getHeight()),
+          targetData (target, Image::BitmapData::readWrite)
+    {
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        const auto offset = (size_t) x * (size_t) targetData.pixelStride + (size_t) y * (size_t) targetData.lineStride;
+        bitmap.data = targetData.data + offset;
+        bitmap.size = targetData.size - offset;
+        bitmap.pixelFormat = targetData.pixelFormat;
+        bitmap.lineStride = targetData.lineStride;
+        bitmap.pixelStride = targetData.pixelStride;
+    }
+
+    ImagePixelData::Ptr clone() override
+    {
+        Image newImage (SoftwareImageType().create (pixelFormat, width, height, false));
+        const Image::BitmapData dest (newImage, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            memcpy (dest.getLinePointer (y), targetData.getLinePointer (y), (size_t) (width * targetData.pixelStride));
+
+        return newImage.getPixelData();
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    const Image::BitmapData targetData;
+
+    JUCE_LEAK_DETECTOR (TilePixelData)
+};
+
+//==============================================================================
+/*  The state shared between the threads while a set of tiles is being rendered.
+    Workers that start after all the tiles have been claimed only touch the counters.
+*/
+struct LowLevelGraphicsTiledSoftwareRenderer::Frame
+{
+    void renderTiles()
+    {
+        const auto numTiles = (int) tileClips.size();
+
+        for (;;)
+        {
+            const auto index = nextTile++;
+
+            if (index >= numTiles)
+                return;
+
+            renderTile ((size_t) index);
+
+            if (++numTilesFinished == numTiles)
+                finished.signal();
+        }
+    }
+
+    void renderTile (size_t index)
+    {
+        LowLevelGraphicsSoftwareRenderer context (image, origin, tileClips[index]);
+        displayList->replay (context);
+    }
+
+    Image image;
+    Point<int> origin;
+    const GraphicsDisplayList* displayList = nullptr;
+    std::vector<RectangleList<int>> tileClips;
+    std::atomic<int> nextTile { 0 }, numTilesFinished { 0 };
+    WaitableEvent finished;
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                                                              ThreadPool& threadPoolToUse,
+                                                                              int tileHeightToUse)
+    : LowLevelGraphicsTiledSoftwareRenderer (imageToRenderOnto, {}, imageToRenderOnto.getBounds(),
+                                             threadPoolToUse, tileHeightToUse)
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                                                              Point<int> origin,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              ThreadPool& threadPoolToUse,
+                                                                              int tileHeightToUse)
+    : Recorder (displayList, origin, initialClip),
+      image (imageToRenderOnto),
+      initialOrigin (origin),
+      initialClipRegion (initialClip),
+      threadPool (threadPoolToUse),
+      tileHeight (jmax (1, tileHeightToUse))
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    renderRecordedCommands();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    // The contents of a transparency layer can't be drawn until the layer has been ended!
+    jassert (! isInsideTransparencyLayer());
+
+    if (isInsideTransparencyLayer())
+        return;
+
+    renderRecordedCommands();
+
+    // Only the state changes need to be replayed for the next flush
+    displayList.removeDrawingCommands();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderRecordedCommands()
+{
+    if (displayList.isEmpty() || ! image.isValid())
+        return;
+
+    auto frame = std::make_shared<Frame>();
+    frame->origin = initialOrigin;
+    frame->displayList = &displayList;
+
+    const auto area = initialClipRegion.getBounds().getIntersection (image.getBounds());
+
+    for (int y = area.getY(); y < area.getBottom(); y += tileHeight)
+    {
+        auto tileClip = initialClipRegion;
+        tileClip.clipTo (area.withY (y).withHeight (jmin (tileHeight, area.getBottom() - y)));
+
+        if (! tileClip.isEmpty())
+            frame->tileClips.push_back (std::move (tileClip));
+    }
+
+    if (frame->tileClips.empty())
+        return;
+
+    frame->image = Image (*new TilePixelData (image));
+
+    const auto numWorkers = jmin (threadPool.getNumThreads(), (int) frame->tileClips.size() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+        threadPool.addJob ([frame] { frame->renderTiles(); });
+
+    frame->renderTiles();
+    frame->finished.wait();
+
+    // release the target's BitmapData on this thread, rather than whichever thread drops the frame last
+    frame->image = {};
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LowLevelGraphicsTiledSoftwareRendererTests  : public UnitTest
+{
+public:
+    LowLevelGraphicsTiledSoftwareRendererTests()
+        : UnitTest ("LowLevelGraphicsTiledSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+
+        beginTest ("Rendering into a whole image matches the software renderer");
+        {
+            Image expected (Image::ARGB, width, height, true, SoftwareImageType());
+            Image actual (Image::ARGB, width, height, true, SoftwareImageType());
+
+            {
+                Graphics g (expected);
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, pool, 7);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            expectLessOrEqual (getMaximumDifference (expected, actual), 2);
+        }
+
+        beginTest ("Rendering into a clipped region with an origin matches the software renderer");
+        {
+            const Point<int> origin (-17, 9);
+            RectangleList<int> clip;
+            clip.add ({ 3, 5, 150, 90 });
+            clip.add ({ 120, 70, 170, 120 });
+
+            Image expected (Image::RGB, width, height, true, SoftwareImageType());
+            Image actual (Image::RGB, width, height, true, SoftwareImageType());
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected, origin, clip);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, origin, clip, pool, 16);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            expectLessOrEqual (getMaximumDifference (expected, actual), 2);
+        }
+
+        beginTest ("Drawing can continue after a flush");
+        {
+            Image expected (Image::ARGB, width, height, true, SoftwareImageType());
+            Image actual (Image::ARGB, width, height, true, SoftwareImageType());
+
+            {
+                Graphics g (expected);
+                drawScene (g);
+                g.setColour (Colours::purple.withAlpha (0.5f));
+                g.fillEllipse (40.0f, 30.0f, 120.0f, 150.0f);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, pool, 30);
+                Graphics g (context);
+                drawScene (g);
+                context.flush();
+
+                expectGreaterThan (getMaximumDifference (Image (Image::ARGB, width, height, true, SoftwareImageType()), actual), 0);
+
+                g.setColour (Colours::purple.withAlpha (0.5f));
+                g.fillEllipse (40.0f, 30.0f, 120.0f, 150.0f);
+            }
+
+            expectLessOrEqual (getMaximumDifference (expected, actual), 2);
+        }
+
+        beginTest ("Queries reflect the recorded state immediately");
+        {
+            Image image (Image::ARGB, width, height, true, SoftwareImageType());
+            LowLevelGraphicsTiledSoftwareRenderer context (image, pool);
+            Graphics g (context);
+
+            g.setOrigin ({ 10, 20 });
+            g.reduceClipRegion (0, 0, 50, 40);
+
+            expect (g.getClipBounds() == Rectangle<int> (0, 0, 50, 40));
+            expect (! g.clipRegionIntersects ({ 60, 0, 10, 10 }));
+
+            g.excludeClipRegion ({ 0, 0, 50, 40 });
+            expect (g.isClipEmpty());
+
+            g.setFont (23.0f);
+            expectEquals (g.getCurrentFont().getHeight(), 23.0f);
+        }
+    }
+
+private:
+    static constexpr int width = 300, height = 200;
+
+    static void drawScene (Graphics& g)
+    {
+        g.fillAll (Colours::white);
+
+        g.setGradientFill (ColourGradient (Colours::red, 0.0f, 0.0f, Colours::blue, 300.0f, 200.0f, false));
+        g.fillRoundedRectangle (10.5f, 12.25f, 200.0f, 120.0f, 15.0f);
+
+        Image sprite (Image::ARGB, 20, 20, true, SoftwareImageType());
+
+        {
+            Graphics sg (sprite);
+            sg.setColour (Colours::yellow);
+            sg.fillEllipse (2.0f, 2.0f, 16.0f, 16.0f);
+        }
+
+        {
+            Graphics::ScopedSaveState state (g);
+            g.addTransform (AffineTransform::rotation (0.3f, 150.0f, 100.0f));
+            g.setColour (Colours::green.withAlpha (0.6f));
+            g.fillEllipse (60.0f, 40.0f, 180.0f, 90.0f);
+            g.setImageResamplingQuality (Graphics::highResamplingQuality);
+            g.drawImageTransformed (sprite, AffineTransform::scale (1.7f).translated (30.0f, 20.0f));
+        }
+
+        Random random (1234);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            g.setColour (Colour (random.nextInt()).withAlpha (0.4f));
+            g.fillRect (random.nextFloat() * (float) width, random.nextFloat() * (float) height,
+                        random.nextFloat() * 30.0f, random.nextFloat() * 30.0f);
+        }
+
+        g.reduceClipRegion (20, 20, 250, 160);
+        g.excludeClipRegion ({ 100, 60, 30, 30 });
+
+        g.beginTransparencyLayer (0.5f);
+        g.setColour (Colours::black);
+        g.drawLine (0.0f, 0.0f, 300.0f, 200.0f, 3.0f);
+        g.setFont (30.0f);
+        g.drawText ("Tiles", 40, 100, 200, 50, Justification::centred);
+        g.drawImageAt (sprite, 250, 150);
+        g.endTransparencyLayer();
+
+        g.setColour (Colours::orange);
+        g.drawRect (5, 5, 290, 190, 2);
+    }
+
+    static int getMaximumDifference (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+        int maxDifference = 0;
+
+        for (int y = 0; y < dataA.height; ++y)
+        {
+            const auto* lineA = dataA.getLinePointer (y);
+            const auto* lineB = dataB.getLinePointer (y);
+
+            for (int i = 0; i < dataA.width * dataA.pixelStride; ++i)
+                maxDifference = jmax (maxDifference, std::abs ((int) lineA[i] - (int) lineB[i]));
+        }
+
+        return maxDifference;
+    }
+};
+
+static LowLevelGraphicsTiledSoftwareRendererTests lowLevelGraphicsTiledSoftwareRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer that defers its drawing and rasterises it on several threads.
+
+    Instead of drawing immediately, this context records each drawing operation along
+    with the area of the image that it can affect. When flush() is called (or the
+    context is deleted), the image is divided into tiles, and each tile replays the
+    operations that touch it using a LowLevelGraphicsSoftwareRenderer clipped to that
+    tile. Tiles are rendered in parallel on the ThreadPool that you supply, with the
+    calling thread also taking part, and the call returns once the image is complete.
+
+    The tiles are horizontal strips that span the whole width of the clip region, as
+    the software renderer works along rows of pixels. The results match those of a
+    LowLevelGraphicsSoftwareRenderer, except that an anti-aliased edge which falls
+    across the boundary between two tiles may occasionally differ by a level or two.
+
+    Queries such as getClipBounds() and clipRegionIntersects() are answered immediately,
+    so this can be used anywhere that a LowLevelGraphicsContext is expected. For example,
+    to speed up the painting of large windows, you could return one of these from your
+    LookAndFeel::createGraphicsContext() override.
+
+    Because painting happens later and on other threads, any Images or Fonts used while
+    drawing must stay unmodified until flush() has returned.
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public GraphicsDisplayList::Recorder
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image.
+
+        The ThreadPool must outlive this context. The tileHeight is the number of rows
+        of pixels in each of the tiles that are handed to the threads.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                           ThreadPool& threadPoolToUse,
+                                           int tileHeight = 64);
+
+    /** Creates a context to render into a clipped subsection of an image. */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                           Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool& threadPoolToUse,
+                                           int tileHeight = 64);
+
+    /** Destructor. Any drawing that hasn't yet been flushed is rendered before this returns. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Renders all the drawing operations recorded so far into the target image.
+
+        The current transform, clip and fill settings are kept, so you can carry on
+        drawing afterwards.
+    */
+    void flush();
+
+private:
+    //==============================================================================
+    class TilePixelData;
+    struct Frame;
+
+    void renderRecordedCommands();
+
+    GraphicsDisplayList displayList;
+    Image image;
+    Point<int> initialOrigin;
+    RectangleList<int> initialClipRegion;
+    ThreadPool& threadPool;
+    const int tileHeight;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
@@ -23,47 +23,242 @@
   ==============================================================================
 */
 
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #include <emmintrin.h>
+ #define JUCE_SHADOW_BLUR_USE_SSE2 1
+#elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (_M_ARM64))
+ #include <arm_neon.h>
+ #define JUCE_SHADOW_BLUR_USE_NEON 1
+#endif
+
 namespace juce
 {
 
-static void blurDataTriplets (uint8* d, int num, const int delta) noexcept
+/*  A separable gaussian blur for single-channel images, which is shared by DropShadow
+    and GlowEffect.
+
+    The kernel weights are 8-bit fixed-point values that add up to 256, so a weighted
+    sum of pixels always fits into 16 bits. The vertical pass works along whole rows,
+    so it's done 16 pixels at a time with SIMD where that's available, and gives the
+    same results as the plain version.
+*/
+namespace ShadowBlur
 {
-    uint32 last = d[0];
-    d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-    d += delta;
+    struct Kernel
+    {
+        std::vector<uint16> weights;
+        int centre = 0;
+    };
+
+    static Kernel createGaussianKernel (int size, int centre, double sigma)
+    {
+        Kernel k;
+        k.centre = jlimit (0, jmax (0, size - 1), centre);
+
+        if (size <= 1 || sigma <= 0)
+        {
+            k.weights = { 256 };
+            k.centre = 0;
+            return k;
+        }
+
+        std::vector<double> values ((size_t) size);
+        double total = 0;
+
+        for (int i = 0; i < size; ++i)
+        {
+            auto d = (double) (i - k.centre);
+            values[(size_t) i] = std::exp (-d * d / (2.0 * sigma * sigma));
+            total += values[(size_t) i];
+        }
+
+        int sum = 0;
+
+        for (auto v : values)
+        {
+            k.weights.push_back ((uint16) roundToInt (256.0 * v / total));
+            sum += k.weights.back();
+        }
 
-    num -= 2;
+        // make sure the weights add up to exactly 256, so that flat areas don't change
+        k.weights[(size_t) k.centre] = (uint16) (k.weights[(size_t) k.centre] + 256 - sum);
+        return k;
+    }
 
-    do
+    /*  The old blur used 2 * radius passes of a 3-tap box filter, which is very close to a
+        gaussian with a variance of 4 * radius / 3, so shadows keep the same look.
+    */
+    static Kernel createKernelForShadowRadius (int radius)
     {
-        const uint32 newLast = d[0];
-        d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-        d += delta;
-        last = newLast;
+        auto sigma = std::sqrt (4.0 * jmax (0, radius) / 3.0);
+        auto halfWidth = (int) std::ceil (3.0 * sigma);
+        return createGaussianKernel (halfWidth * 2 + 1, halfWidth, sigma);
     }
-    while (--num > 0);
 
-    d[0] = (uint8) ((last + d[0] + 1) / 3);
-}
+    static void blurRow (const uint8* src, uint8* dest, int width, const Kernel& kernel) noexcept
+    {
+        auto numTaps = (int) kernel.weights.size();
+        auto* weights = kernel.weights.data();
 
-static void blurSingleChannelImage (uint8* const data, const int width, const int height,
-                                    const int lineStride, const int repetitions) noexcept
-{
-    jassert (width > 2 && height > 2);
+        for (int x = 0; x < width; ++x)
+        {
+            auto first = jmax (0, kernel.centre - x);
+            auto last  = jmin (numTaps, width - x + kernel.centre);
+            auto* s = src + x - kernel.centre;
+            uint32 sum = 128;
 
-    for (int y = 0; y < height; ++y)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + lineStride * y, width, 1);
+            for (int i = first; i < last; ++i)
+                sum += (uint32) weights[i] * s[i];
 
-    for (int x = 0; x < width; ++x)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + x, height, lineStride);
-}
+            dest[x] = (uint8) (sum >> 8);
+        }
+    }
 
-static void blurSingleChannelImage (Image& image, int radius)
-{
-    const Image::BitmapData bm (image, Image::BitmapData::readWrite);
-    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, 2 * radius);
+    static void addWeightedRow (uint16* acc, const uint8* src, int width, uint16 weight) noexcept
+    {
+        int x = 0;
+
+       #if JUCE_SHADOW_BLUR_USE_SSE2
+        auto w = _mm_set1_epi16 ((short) weight);
+        auto zero = _mm_setzero_si128();
+
+        for (; x + 16 <= width; x += 16)
+        {
+            auto s = _mm_loadu_si128 ((const __m128i*) (src + x));
+            auto* a = (__m128i*) (acc + x);
+            _mm_storeu_si128 (a,     _mm_add_epi16 (_mm_loadu_si128 (a),     _mm_mullo_epi16 (_mm_unpacklo_epi8 (s, zero), w)));
+            _mm_storeu_si128 (a + 1, _mm_add_epi16 (_mm_loadu_si128 (a + 1), _mm_mullo_epi16 (_mm_unpackhi_epi8 (s, zero), w)));
+        }
+       #elif JUCE_SHADOW_BLUR_USE_NEON
+        for (; x + 16 <= width; x += 16)
+        {
+            auto s = vld1q_u8 (src + x);
+            vst1q_u16 (acc + x,     vmlaq_n_u16 (vld1q_u16 (acc + x),     vmovl_u8 (vget_low_u8 (s)),  weight));
+            vst1q_u16 (acc + x + 8, vmlaq_n_u16 (vld1q_u16 (acc + x + 8), vmovl_u8 (vget_high_u8 (s)), weight));
+        }
+       #endif
+
+        for (; x < width; ++x)
+            acc[x] = (uint16) (acc[x] + weight * src[x]);
+    }
+
+    static void storeRow (uint8* dest, const uint16* acc, int width) noexcept
+    {
+        int x = 0;
+
+       #if JUCE_SHADOW_BLUR_USE_SSE2
+        auto half = _mm_set1_epi16 (128);
+
+        for (; x + 16 <= width; x += 16)
+        {
+            auto lo = _mm_srli_epi16 (_mm_add_epi16 (_mm_loadu_si128 ((const __m128i*) (acc + x)),     half), 8);
+            auto hi = _mm_srli_epi16 (_mm_add_epi16 (_mm_loadu_si128 ((const __m128i*) (acc + x + 8)), half), 8);
+            _mm_storeu_si128 ((__m128i*) (dest + x), _mm_packus_epi16 (lo, hi));
+        }
+       #elif JUCE_SHADOW_BLUR_USE_NEON
+        for (; x + 16 <= width; x += 16)
+            vst1q_u8 (dest + x, vcombine_u8 (vrshrn_n_u16 (vld1q_u16 (acc + x), 8),
+                                             vrshrn_n_u16 (vld1q_u16 (acc + x + 8), 8)));
+       #endif
+
+        for (; x < width; ++x)
+            dest[x] = (uint8) ((acc[x] + 128) >> 8);
+    }
+
+    static void storeRowWithGain (uint8* dest, const uint16* acc, int width, uint32 gain) noexcept
+    {
+        for (int x = 0; x < width; ++x)
+            dest[x] = (uint8) jmin ((uint32) 255, (acc[x] * gain + 32768) >> 16);
+    }
+
+    /*  Blurs a single-channel image in place, treating everything outside it as empty.
+        The result can be multiplied by a gain, and is then clipped to 255.
+    */
+    static void blur (Image& image, const Kernel& kernel, float gain = 1.0f)
+    {
+        jassert (image.getFormat() == Image::SingleChannel);
+
+        const Image::BitmapData bm (image, Image::BitmapData::readWrite);
+        const auto width = bm.width, height = bm.height;
+
+        if (width <= 0 || height <= 0)
+            return;
+
+        HeapBlock<uint8> rows ((size_t) width * (size_t) height);
+
+        for (int y = 0; y < height; ++y)
+            blurRow (bm.getLinePointer (y), rows + (size_t) width * (size_t) y, width, kernel);
+
+        HeapBlock<uint16> acc ((size_t) width);
+        auto numTaps = (int) kernel.weights.size();
+        auto gain16 = (uint32) jlimit (0, 0xffff, roundToInt (gain * 256.0f));
+
+        for (int y = 0; y < height; ++y)
+        {
+            zeromem (acc, sizeof (uint16) * (size_t) width);
+
+            auto first = jmax (0, kernel.centre - y);
+            auto last  = jmin (numTaps, height - y + kernel.centre);
+
+            for (int i = first; i < last; ++i)
+                addWeightedRow (acc, rows + (size_t) width * (size_t) (y + i - kernel.centre),
+                                width, kernel.weights[(size_t) i]);
+
+            if (gain16 == 256)
+                storeRow (bm.getLinePointer (y), acc, width);
+            else
+                storeRowWithGain (bm.getLinePointer (y), acc, width, gain16);
+        }
+    }
+
+    //==============================================================================
+    /*  Shadows for paths are kept in the ImageCache. The key depends on the shape of the
+        path relative to the integer position of its bounds, so a shadow that's drawn
+        again, or moved by whole pixels, is found again and only needs to be blitted.
+    */
+    static int64 getCacheKey (const Path& path, Point<float> origin, int radius) noexcept
+    {
+        uint64 hash = 0xcbf29ce484222325ull;
+
+        auto add = [&hash] (uint32 value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                hash = (hash ^ (value & 0xff)) * 0x100000001b3ull;
+                value >>= 8;
+            }
+        };
+
+        auto addPoint = [&] (float x, float y)
+        {
+            const float relative[] = { x - origin.x, y - origin.y };
+            add (readUnaligned<uint32> (relative));
+            add (readUnaligned<uint32> (relative + 1));
+        };
+
+        add (0x5ad0c4c7);
+        add ((uint32) radius);
+        add (path.isUsingNonZeroWinding() ? 1u : 0u);
+
+        for (Path::Iterator i (path); i.next();)
+        {
+            add ((uint32) i.elementType);
+
+            switch (i.elementType)
+            {
+                case Path::Iterator::cubicTo:         addPoint (i.x3, i.y3); JUCE_FALLTHROUGH
+                case Path::Iterator::quadraticTo:     addPoint (i.x2, i.y2); JUCE_FALLTHROUGH
+                case Path::Iterator::startNewSubPath:
+                case Path::Iterator::lineTo:          addPoint (i.x1, i.y1); break;
+                case Path::Iterator::closePath:
+                default:                              break;
+            }
+        }
+
+        return (int64) hash;
+    }
+
+    static constexpr int maxCachedShadowPixels = 512 * 512;
 }
 
 //==============================================================================
@@ -82,7 +277,7 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
         Image shadowImage (srcImage.convertedToFormat (Image::SingleChannel));
         shadowImage.duplicateIfShared();
 
-        blurSingleChannelImage (shadowImage, radius);
+        ShadowBlur::blur (shadowImage, ShadowBlur::createKernelForShadowRadius (radius));
 
         g.setColour (colour);
         g.drawImageAt (shadowImage, offset.x, offset.y, true);
@@ -93,26 +288,47 @@ void DropShadow::drawForPath (Graphics& g, const Path& path) const
 {
     jassert (radius > 0);
 
-    auto area = (path.getBounds().getSmallestIntegerContainer() + offset)
-                  .expanded (radius + 1)
-                  .getIntersection (g.getClipBounds().expanded (radius + 1));
+    auto pathBounds = path.getBounds().getSmallestIntegerContainer();
+    auto shadowArea = pathBounds.expanded (radius + 1);
 
-    if (area.getWidth() > 2 && area.getHeight() > 2)
+    auto renderShadow = [&] (Rectangle<int> area)
     {
         Image renderedPath (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
 
         {
             Graphics g2 (renderedPath);
             g2.setColour (Colours::white);
-            g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
-                                                             (float) (offset.y - area.getY())));
+            g2.fillPath (path, AffineTransform::translation ((float) -area.getX(), (float) -area.getY()));
         }
 
-        blurSingleChannelImage (renderedPath, radius);
+        ShadowBlur::blur (renderedPath, ShadowBlur::createKernelForShadowRadius (radius));
+        return renderedPath;
+    };
 
-        g.setColour (colour);
-        g.drawImageAt (renderedPath, area.getX(), area.getY(), true);
+    g.setColour (colour);
+
+    if (shadowArea.getWidth() > 2 && shadowArea.getHeight() > 2
+         && shadowArea.getWidth() * shadowArea.getHeight() <= ShadowBlur::maxCachedShadowPixels)
+    {
+        auto key = ShadowBlur::getCacheKey (path, pathBounds.getPosition().toFloat(), radius);
+        auto shadowImage = ImageCache::getFromHashCode (key);
+
+        if (shadowImage.isNull())
+        {
+            shadowImage = renderShadow (shadowArea);
+            ImageCache::addImageToCache (shadowImage, key);
+        }
+
+        auto position = shadowArea.getPosition() + offset;
+        g.drawImageAt (shadowImage, position.x, position.y, true);
+        return;
     }
+
+    // Large shadows aren't worth caching, so only the visible part is rendered
+    auto area = (shadowArea + offset).getIntersection (g.getClipBounds().expanded (radius + 1));
+
+    if (area.getWidth() > 2 && area.getHeight() > 2)
+        g.drawImageAt (renderShadow (area - offset), area.getX(), area.getY(), true);
 }
 
 static void drawShadowSection (Graphics& g, ColourGradient& cg, Rectangle<float> area,
@@ -180,4 +396,115 @@ void DropShadowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor
     g.drawImageAt (image, 0, 0);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DropShadowTests  : public UnitTest
+{
+public:
+    DropShadowTests()
+        : UnitTest ("DropShadow", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Blur matches a reference gaussian");
+        {
+            Random r (getRandom());
+
+            for (auto radius : { 1, 4, 12 })
+            {
+                for (auto size : { Point<int> (3, 3), Point<int> (37, 21), Point<int> (70, 45) })
+                {
+                    Image image (Image::SingleChannel, size.x, size.y, true);
+
+                    for (int y = 0; y < size.y; ++y)
+                        for (int x = 0; x < size.x; ++x)
+                            image.setPixelAt (x, y, Colours::white.withAlpha ((uint8) r.nextInt (256)));
+
+                    auto expected = referenceBlur (image, ShadowBlur::createKernelForShadowRadius (radius));
+                    ShadowBlur::blur (image, ShadowBlur::createKernelForShadowRadius (radius));
+
+                    const Image::BitmapData bm (image, Image::BitmapData::readOnly);
+                    int maxError = 0;
+
+                    for (int y = 0; y < size.y; ++y)
+                        for (int x = 0; x < size.x; ++x)
+                            maxError = jmax (maxError, std::abs ((int) *bm.getPixelPointer (x, y) - expected[(size_t) (y * size.x + x)]));
+
+                    expectLessOrEqual (maxError, 1);
+                }
+            }
+        }
+
+        beginTest ("Blur keeps flat areas unchanged");
+        {
+            Image image (Image::SingleChannel, 40, 40, false);
+            image.clear (image.getBounds(), Colours::white.withAlpha ((uint8) 200));
+            ShadowBlur::blur (image, ShadowBlur::createKernelForShadowRadius (3));
+
+            expectEquals ((int) image.getPixelAt (20, 20).getAlpha(), 200);
+            expectLessThan ((int) image.getPixelAt (0, 0).getAlpha(), 200);
+        }
+
+        beginTest ("Path shadows are cached by shape");
+        {
+            Image target (Image::ARGB, 100, 100, true);
+            Graphics g (target);
+            DropShadow shadow (Colours::black, 5, { 2, 3 });
+
+            Path p;
+            p.addRectangle (10.25f, 10.0f, 30.0f, 20.0f);
+
+            auto key = ShadowBlur::getCacheKey (p, { 10.0f, 10.0f }, 5);
+            shadow.drawForPath (g, p);
+            auto cached = ImageCache::getFromHashCode (key);
+            expect (cached.isValid());
+
+            auto moved = p;
+            moved.applyTransform (AffineTransform::translation (20.0f, 30.0f));
+            expectEquals (ShadowBlur::getCacheKey (moved, { 30.0f, 40.0f }, 5), key);
+            expectNotEquals (ShadowBlur::getCacheKey (p, { 10.0f, 10.0f }, 6), key);
+
+            shadow.drawForPath (g, moved);
+            expect (ImageCache::getFromHashCode (key) == cached);
+            expect (target.getPixelAt (32 + 15, 43 + 10).getAlpha() > 0);
+        }
+    }
+
+    static std::vector<int> referenceBlur (const Image& image, const ShadowBlur::Kernel& kernel)
+    {
+        const auto w = image.getWidth(), h = image.getHeight();
+        std::vector<double> horizontal ((size_t) (w * h)), result ((size_t) (w * h));
+
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                for (size_t i = 0; i < kernel.weights.size(); ++i)
+                    if (isPositiveAndBelow (x + (int) i - kernel.centre, w))
+                        horizontal[(size_t) (y * w + x)] += kernel.weights[i] / 256.0
+                                                             * image.getPixelAt (x + (int) i - kernel.centre, y).getAlpha();
+
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                for (size_t i = 0; i < kernel.weights.size(); ++i)
+                    if (isPositiveAndBelow (y + (int) i - kernel.centre, h))
+                        result[(size_t) (y * w + x)] += kernel.weights[i] / 256.0 * horizontal[(size_t) ((y + (int) i - kernel.centre) * w + x)];
+
+        std::vector<int> rounded;
+
+        for (auto v : result)
+            rounded.push_back (roundToInt (v));
+
+        return rounded;
+    }
+};
+
+static DropShadowTests dropShadowTests;
+
+#endif
+
 } // namespace juce
+
+#undef JUCE_SHADOW_BLUR_USE_SSE2
+#undef JUCE_SHADOW_BLUR_USE_NEON
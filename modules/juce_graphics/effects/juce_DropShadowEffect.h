@@ -43,7 +43,12 @@ struct JUCE_API  DropShadow
     /** Renders a drop-shadow based on the alpha-channel of the given image. */
     void drawForImage (Graphics& g, const Image& srcImage) const;
 
-    /** Renders a drop-shadow based on the shape of a path. */
+    /** Renders a drop-shadow based on the shape of a path.
+
+        Shadows for paths of a moderate size are kept in the ImageCache, so drawing
+        the same shape again, or moving it by a whole number of pixels, just draws
+        the cached image rather than blurring it again.
+    */
     void drawForPath (Graphics& g, const Path& path) const;
 
     /** Renders a drop-shadow for a rectangle.
@@ -74,9 +79,8 @@ struct JUCE_API  DropShadow
     shadow based on what gets drawn inside it. The shadow will also
     be applied to the component's children.
 
-    For speed, this doesn't use a proper gaussian blur, but cheats by
-    using a simple bilinear filter. If you need a really high-quality
-    shadow, check out ImageConvolutionKernel::createGaussianBlur()
+    The shadow is drawn with a fast separable gaussian blur. If you need other
+    kinds of blur, check out ImageConvolutionKernel::createGaussianBlur()
 
     @see Component::setComponentEffect
 
@@ -38,14 +38,13 @@ void GlowEffect::setGlowProperties (float newRadius, Colour newColour, Point<int
 
 void GlowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor, float alpha)
 {
-    Image temp (image.getFormat(), image.getWidth(), image.getHeight(), true);
+    // Only the alpha channel of the blurred image is used, so just that is blurred. The
+    // kernel is the same truncated gaussian, scaled up by the radius, as before.
+    Image temp (image.convertedToFormat (Image::SingleChannel));
+    temp.duplicateIfShared();
 
-    ImageConvolutionKernel blurKernel (roundToInt (radius * scaleFactor * 2.0f));
-
-    blurKernel.createGaussianBlur (radius);
-    blurKernel.rescaleAllValues (radius);
-
-    blurKernel.applyToImage (temp, image, image.getBounds());
+    auto kernelSize = jmax (1, roundToInt (radius * scaleFactor * 2.0f));
+    ShadowBlur::blur (temp, ShadowBlur::createGaussianKernel (kernelSize, kernelSize >> 1, radius), radius);
 
     g.setColour (colour.withMultipliedAlpha (alpha));
     g.drawImageAt (temp, offset.x, offset.y, true);
@@ -156,6 +156,7 @@ void CustomTypeface::clear()
     style = "Regular";
     zeromem (lookupTable, sizeof (lookupTable));
     glyphs.clear();
+    clearCachedGlyphPositions();
 }
 
 void CustomTypeface::setCharacteristics (const String& newName, float newAscent, bool isBold,
@@ -185,6 +186,7 @@ void CustomTypeface::addGlyph (juce_wchar character, const Path& path, float wid
         lookupTable [character] = (short) glyphs.size();
 
     glyphs.add (new GlyphInfo (character, path, width));
+    clearCachedGlyphPositions();
 }
 
 void CustomTypeface::addKerningPair (juce_wchar char1, juce_wchar char2, float extraAmount) noexcept
@@ -195,6 +197,8 @@ void CustomTypeface::addKerningPair (juce_wchar char1, juce_wchar char2, float e
             g->addKerningPair (char2, extraAmount);
         else
             jassertfalse; // can only add kerning pairs for characters that exist!
+
+        clearCachedGlyphPositions();
     }
 }
 
@@ -170,11 +170,197 @@ void Typeface::setTypefaceCacheSize (int numFontsToCache)
     TypefaceCache::getInstance()->setSize (numFontsToCache);
 }
 
+//==============================================================================
+/*  Remembers the results of Typeface::getGlyphPositions() for recently used strings,
+    so that text which is laid out repeatedly only needs to be shaped once.
+*/
+class GlyphPositionCache  : private DeletedAtShutdown
+{
+public:
+    GlyphPositionCache() = default;
+
+    ~GlyphPositionCache()
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (GlyphPositionCache, false)
+
+    void getGlyphPositions (Typeface& typeface, const String& text, Array<int>& glyphs, Array<float>& xOffsets)
+    {
+        // Very long strings are unlikely to be repeated, and would push out lots of shorter ones
+        if (text.getNumBytesAsUTF8() > maxTextLength)
+        {
+            typeface.getGlyphPositions (text, glyphs, xOffsets);
+            return;
+        }
+
+        Key key { &typeface, text };
+
+        {
+            const ScopedLock sl (lock);
+
+            if (maxNumEntries > 0)
+            {
+                const auto iter = entries.find (key);
+
+                if (iter != entries.end())
+                {
+                    ++statistics.numHits;
+
+                    if (iter->second.usagePosition != usageOrder.begin())
+                        usageOrder.splice (usageOrder.begin(), usageOrder, iter->second.usagePosition);
+
+                    glyphs.addArray (iter->second.glyphs);
+                    xOffsets.addArray (iter->second.xOffsets);
+                    return;
+                }
+
+                ++statistics.numMisses;
+            }
+        }
+
+        // The lock isn't held while shaping, as a typeface may call clearCachedGlyphPositions()
+        // when it loads a glyph
+        Array<int> newGlyphs;
+        Array<float> newOffsets;
+        typeface.getGlyphPositions (text, newGlyphs, newOffsets);
+
+        glyphs.addArray (newGlyphs);
+        xOffsets.addArray (newOffsets);
+
+        const ScopedLock sl (lock);
+
+        if (maxNumEntries <= 0)
+            return;
+
+        const auto result = entries.emplace (std::move (key), Entry { &typeface, std::move (newGlyphs), std::move (newOffsets), {} });
+
+        if (result.second)
+        {
+            usageOrder.push_front (result.first);
+            result.first->second.usagePosition = usageOrder.begin();
+            removeLeastRecentlyUsed();
+        }
+    }
+
+    void setMaximumNumEntries (int newMaximum)
+    {
+        const ScopedLock sl (lock);
+        maxNumEntries = jmax (0, newMaximum);
+        removeLeastRecentlyUsed();
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        entries.clear();
+        usageOrder.clear();
+    }
+
+    void removeEntriesFor (const Typeface& typeface)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto i = usageOrder.begin(); i != usageOrder.end();)
+        {
+            if ((*i)->first.typeface == &typeface)
+            {
+                entries.erase (*i);
+                i = usageOrder.erase (i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    Typeface::GlyphPositionCacheStatistics getStatistics() const
+    {
+        const ScopedLock sl (lock);
+        auto result = statistics;
+        result.numEntries = (int) entries.size();
+        return result;
+    }
+
+    void resetStatistics()
+    {
+        const ScopedLock sl (lock);
+        statistics = {};
+    }
+
+private:
+    struct Key
+    {
+        bool operator< (const Key& other) const noexcept
+        {
+            return typeface != other.typeface ? typeface < other.typeface
+                                              : text < other.text;
+        }
+
+        const Typeface* typeface;
+        String text;
+    };
+
+    struct Entry
+    {
+        Typeface::Ptr typeface; // keeps the key's typeface pointer valid
+        Array<int> glyphs;
+        Array<float> xOffsets;
+        std::list<std::map<Key, Entry>::iterator>::iterator usagePosition;
+    };
+
+    void removeLeastRecentlyUsed()
+    {
+        while (entries.size() > (size_t) maxNumEntries)
+        {
+            entries.erase (usageOrder.back());
+            usageOrder.pop_back();
+        }
+    }
+
+    static constexpr int maxTextLength = 512;
+
+    std::map<Key, Entry> entries;
+    std::list<std::map<Key, Entry>::iterator> usageOrder;
+    Typeface::GlyphPositionCacheStatistics statistics;
+    int maxNumEntries = 1024;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphPositionCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (GlyphPositionCache)
+
+void Typeface::setGlyphPositionCacheSize (int maxNumStrings)
+{
+    GlyphPositionCache::getInstance()->setMaximumNumEntries (maxNumStrings);
+}
+
+Typeface::GlyphPositionCacheStatistics Typeface::getGlyphPositionCacheStatistics()
+{
+    return GlyphPositionCache::getInstance()->getStatistics();
+}
+
+void Typeface::resetGlyphPositionCacheStatistics()
+{
+    GlyphPositionCache::getInstance()->resetStatistics();
+}
+
+void Typeface::clearCachedGlyphPositions()
+{
+    if (auto* cache = GlyphPositionCache::getInstanceWithoutCreating())
+        cache->removeEntriesFor (*this);
+}
+
+//==============================================================================
 void (*clearOpenGLGlyphCache)() = nullptr;
 
 void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
+    GlyphPositionCache::getInstance()->clear();
 
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
@@ -525,6 +711,7 @@ const String& Font::getFallbackFontName()
 void Font::setFallbackFontName (const String& name)
 {
     FontValues::fallbackFont = name;
+    GlyphPositionCache::getInstance()->clear();
 
    #if JUCE_MAC || JUCE_IOS
     jassertfalse; // Note that use of a fallback font isn't currently implemented in OSX..
@@ -539,6 +726,7 @@ const String& Font::getFallbackFontStyle()
 void Font::setFallbackFontStyle (const String& style)
 {
     FontValues::fallbackFontStyle = style;
+    GlyphPositionCache::getInstance()->clear();
 
    #if JUCE_MAC || JUCE_IOS
     jassertfalse; // Note that use of a fallback font isn't currently implemented in OSX..
@@ -756,7 +944,8 @@ float Font::getStringWidthFloat (const String& text) const
 
 void Font::getGlyphPositions (const String& text, Array<int>& glyphs, Array<float>& xOffsets) const
 {
-    getTypefacePtr()->getGlyphPositions (text, glyphs, xOffsets);
+    auto typeface = getTypefacePtr();
+    GlyphPositionCache::getInstance()->getGlyphPositions (*typeface, text, glyphs, xOffsets);
 
     if (auto num = xOffsets.size())
     {
@@ -829,4 +1018,110 @@ Font Font::fromString (const String& fontDescription)
     return Font (name, style, height);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class GlyphPositionCacheTests  : public UnitTest
+{
+public:
+    GlyphPositionCacheTests()
+        : UnitTest ("GlyphPositionCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto typeface = createTypeface();
+        const Font font (Typeface::Ptr (typeface.get()));
+
+        beginTest ("Repeated strings are only shaped once");
+        {
+            Typeface::resetGlyphPositionCacheStatistics();
+
+            Array<int> glyphs1, glyphs2;
+            Array<float> offsets1, offsets2;
+            font.getGlyphPositions ("abba", glyphs1, offsets1);
+            font.getGlyphPositions ("abba", glyphs2, offsets2);
+
+            expect (glyphs1 == glyphs2);
+            expect (offsets1 == offsets2);
+            expectEquals (offsets1.getLast(), 4.0f * font.getHeight());
+
+            const auto stats = Typeface::getGlyphPositionCacheStatistics();
+            expectEquals (stats.numMisses, (int64) 1);
+            expectEquals (stats.numHits, (int64) 1);
+            expectGreaterThan (stats.numEntries, 0);
+        }
+
+        beginTest ("Text layouts share the cache");
+        {
+            Typeface::resetGlyphPositionCacheStatistics();
+
+            GlyphArrangement arrangement;
+            arrangement.addLineOfText (font, "ab", 0.0f, 0.0f);
+
+            AttributedString attributedString ("ab");
+            attributedString.setFont (font);
+            TextLayout layout;
+            layout.createLayout (attributedString, 100.0f);
+
+            expectEquals (Typeface::getGlyphPositionCacheStatistics().numHits, (int64) 1);
+        }
+
+        beginTest ("Changing a typeface discards its cached positions");
+        {
+            Array<int> glyphs;
+            Array<float> offsets;
+            font.getGlyphPositions ("abc", glyphs, offsets);
+
+            Path path;
+            path.addRectangle (0.0f, 0.0f, 1.0f, 1.0f);
+            typeface->addGlyph ('c', path, 2.0f);
+
+            glyphs.clearQuick();
+            offsets.clearQuick();
+            font.getGlyphPositions ("abc", glyphs, offsets);
+
+            expectEquals (glyphs.getLast(), (int) 'c');
+            expectEquals (offsets.getLast(), 4.0f * font.getHeight());
+        }
+
+        beginTest ("The cache size is limited");
+        {
+            Typeface::setGlyphPositionCacheSize (2);
+
+            for (auto text : { "a", "b", "ab", "ba" })
+            {
+                Array<int> glyphs;
+                Array<float> offsets;
+                font.getGlyphPositions (text, glyphs, offsets);
+            }
+
+            expectEquals (Typeface::getGlyphPositionCacheStatistics().numEntries, 2);
+
+            Typeface::setGlyphPositionCacheSize (0);
+            expectEquals (Typeface::getGlyphPositionCacheStatistics().numEntries, 0);
+
+            Typeface::setGlyphPositionCacheSize (1024);
+        }
+    }
+
+private:
+    static ReferenceCountedObjectPtr<CustomTypeface> createTypeface()
+    {
+        ReferenceCountedObjectPtr<CustomTypeface> typeface (new CustomTypeface());
+        typeface->setCharacteristics ("GlyphPositionCacheTests", 0.8f, false, false, 'a');
+
+        Path path;
+        path.addRectangle (0.0f, 0.0f, 1.0f, 1.0f);
+        typeface->addGlyph ('a', path, 1.0f);
+        typeface->addGlyph ('b', path, 1.0f);
+        return typeface;
+    }
+};
+
+static GlyphPositionCacheTests glyphPositionCacheTests;
+
+#endif
+
 } // namespace juce
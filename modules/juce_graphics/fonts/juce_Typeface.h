@@ -128,9 +128,39 @@ public:
     /** Changes the number of fonts that are cached in memory. */
     static void setTypefaceCacheSize (int numFontsToCache);
 
-    /** Clears any fonts that are currently cached in memory. */
+    /** Clears any fonts that are currently cached in memory.
+        This also empties the cache of glyph positions.
+    */
     static void clearTypefaceCache();
 
+    //==============================================================================
+    /** Usage counts for the cache that's used by Font::getGlyphPositions().
+        @see getGlyphPositionCacheStatistics
+    */
+    struct GlyphPositionCacheStatistics
+    {
+        int64 numHits = 0, numMisses = 0;
+        int numEntries = 0;
+    };
+
+    /** Changes the maximum number of strings whose glyph positions are cached.
+
+        Converting a string into glyphs can be slow on some platforms, so the results are
+        kept in a process-wide cache that's shared by everything which lays out text, such
+        as GlyphArrangement, TextLayout, AttributedString and the Graphics text methods.
+        The least recently used strings are discarded when the cache is full. Setting the
+        size to zero turns the cache off. The default size is 1024.
+    */
+    static void setGlyphPositionCacheSize (int maxNumStrings);
+
+    /** Returns the number of hits and misses in the glyph position cache since it was
+        created or since resetGlyphPositionCacheStatistics() was last called.
+    */
+    static GlyphPositionCacheStatistics getGlyphPositionCacheStatistics();
+
+    /** Resets the counts returned by getGlyphPositionCacheStatistics(). */
+    static void resetGlyphPositionCacheStatistics();
+
     /** On some platforms, this allows a specific path to be scanned.
         On macOS you can load .ttf and .otf files, otherwise this is only available when using FreeType.
     */
@@ -150,6 +180,11 @@ protected:
 
     static Ptr getFallbackTypeface();
 
+    /** Subclasses whose glyph positions can change after they've been used must call
+        this whenever they do, so that any cached results for this typeface are discarded.
+    */
+    void clearCachedGlyphPositions();
+
 private:
     struct HintingParams;
     std::unique_ptr<HintingParams> hintingParams;
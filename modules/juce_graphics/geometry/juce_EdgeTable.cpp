@@ -107,8 +107,8 @@ EdgeTable::EdgeTable (Rectangle<int> area, const Path& path, const AffineTransfo
 
 EdgeTable::EdgeTable (Rectangle<int> rectangleToAdd)
    : bounds (rectangleToAdd),
-     maxEdgesPerLine (defaultEdgesPerLine),
-     lineStrideElements (defaultEdgesPerLine * 2 + 1)
+     maxEdgesPerLine (edgesPerRectangleLine),
+     lineStrideElements (edgesPerRectangleLine * 2 + 1)
 {
     allocate();
     table[0] = 0;
@@ -130,8 +130,8 @@ EdgeTable::EdgeTable (Rectangle<int> rectangleToAdd)
 
 EdgeTable::EdgeTable (const RectangleList<int>& rectanglesToAdd)
    : bounds (rectanglesToAdd.getBounds()),
-     maxEdgesPerLine (defaultEdgesPerLine),
-     lineStrideElements (defaultEdgesPerLine * 2 + 1),
+     maxEdgesPerLine (jlimit (edgesPerRectangleLine, defaultEdgesPerLine, rectanglesToAdd.getNumRectangles() * 2)),
+     lineStrideElements (maxEdgesPerLine * 2 + 1),
      needToCheckEmptiness (true)
 {
     allocate();
@@ -197,8 +197,8 @@ EdgeTable::EdgeTable (Rectangle<float> rectangleToAdd)
              roundToInt (rectangleToAdd.getY() * 256.0f) / scale,
              2 + (int) rectangleToAdd.getWidth(),
              2 + (int) rectangleToAdd.getHeight()),
-     maxEdgesPerLine (defaultEdgesPerLine),
-     lineStrideElements ((defaultEdgesPerLine * 2) + 1)
+     maxEdgesPerLine (edgesPerRectangleLine),
+     lineStrideElements ((edgesPerRectangleLine * 2) + 1)
 {
     jassert (! rectangleToAdd.isEmpty());
     allocate();
@@ -276,12 +276,19 @@ EdgeTable::EdgeTable (const EdgeTable& other)
 EdgeTable& EdgeTable::operator= (const EdgeTable& other)
 {
     bounds = other.bounds;
-    maxEdgesPerLine = other.maxEdgesPerLine;
-    lineStrideElements = other.lineStrideElements;
     needToCheckEmptiness = other.needToCheckEmptiness;
 
+    // The copy only gets as much space per line as the source is actually using, which
+    // keeps copies of simple clip regions small. It'll grow again if anything is added.
+    maxEdgesPerLine = edgesPerRectangleLine;
+
+    for (int i = bounds.getHeight(); --i >= 0;)
+        maxEdgesPerLine = jmax (maxEdgesPerLine, other.table[i * other.lineStrideElements]);
+
+    lineStrideElements = maxEdgesPerLine * 2 + 1;
+
     allocate();
-    copyEdgeTableData (table, lineStrideElements, other.table, lineStrideElements, bounds.getHeight());
+    copyEdgeTableData (table, lineStrideElements, other.table, other.lineStrideElements, bounds.getHeight());
     return *this;
 }
 
@@ -588,7 +595,7 @@ void EdgeTable::intersectWithEdgeTableLine (const int y, const int* const otherL
                         auto oldTemp = static_cast<int*> (alloca (tempSize));
                         memcpy (oldTemp, src1, tempSize);
 
-                        remapTableForNumEdges (jmax (256, destTotal * 2));
+                        remapTableForNumEdges (jmax (defaultEdgesPerLine, destTotal * 2));
                         srcLine = table + lineStrideElements * y;
 
                         auto* newTemp = table + lineStrideElements * bounds.getHeight();
@@ -597,7 +604,7 @@ void EdgeTable::intersectWithEdgeTableLine (const int y, const int* const otherL
                     }
                     else
                     {
-                        remapTableForNumEdges (jmax (256, destTotal * 2));
+                        remapTableForNumEdges (jmax (defaultEdgesPerLine, destTotal * 2));
                         srcLine = table + lineStrideElements * y;
                     }
                 }
@@ -624,7 +631,7 @@ void EdgeTable::intersectWithEdgeTableLine (const int y, const int* const otherL
         if (destTotal >= maxEdgesPerLine)
         {
             srcLine[0] = destTotal;
-            remapTableForNumEdges (jmax (256, destTotal * 2));
+            remapTableForNumEdges (jmax (defaultEdgesPerLine, destTotal * 2));
             srcLine = table + lineStrideElements * y;
         }
 
@@ -839,4 +846,135 @@ bool EdgeTable::isEmpty() noexcept
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class EdgeTableTests  : public UnitTest
+{
+public:
+    EdgeTableTests()
+        : UnitTest ("EdgeTable", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        Path ellipse;
+        ellipse.addEllipse (3.5f, 2.25f, 60.0f, 40.0f);
+
+        Path star;
+        star.addStar ({ 35.0f, 25.0f }, 7, 8.0f, 24.0f);
+        const Rectangle<int> area (0, 0, 70, 50);
+
+        beginTest ("Copies contain the same spans, and can still be clipped");
+        {
+            const EdgeTable original (area, ellipse, {});
+            EdgeTable copy (original);
+            expect (getSpans (copy) == getSpans (original));
+
+            const EdgeTable other (area, star, {});
+            EdgeTable clippedOriginal (original);
+            clippedOriginal.clipToEdgeTable (other);
+            copy.clipToEdgeTable (other);
+            expect (getSpans (copy) == getSpans (clippedOriginal));
+        }
+
+        beginTest ("Clipping a rectangle table to a path matches limiting the path to the rectangle");
+        {
+            const Rectangle<int> r (10, 5, 30, 20);
+
+            EdgeTable rectangle (r);
+            rectangle.clipToEdgeTable (EdgeTable (r, ellipse, {}));
+
+            EdgeTable path (r, ellipse, {});
+
+            expect (getSpans (rectangle) == getSpans (path));
+        }
+
+        beginTest ("Pixel-aligned fills match integer rectangle fills");
+        {
+            const auto draw = [] (auto&& fill)
+            {
+                Image image (Image::ARGB, 60, 40, true, SoftwareImageType());
+                Graphics g (image);
+                g.setGradientFill (ColourGradient (Colours::red, 0, 0, Colours::blue, 60, 40, false));
+                fill (g);
+                return image;
+            };
+
+            RectangleList<float> list;
+            list.add ({ 2.0f, 3.0f, 20.0f, 10.0f });
+            list.add ({ 30.0f, 20.0f, 15.0f, 15.0f });
+
+            const auto expected = draw ([] (Graphics& g)
+            {
+                g.fillRect (Rectangle<int> (2, 3, 20, 10));
+                g.fillRect (Rectangle<int> (30, 20, 15, 15));
+            });
+
+            expect (imagesAreIdentical (draw ([&] (Graphics& g) { g.fillRectList (list); }), expected));
+
+            expect (imagesAreIdentical (draw ([&] (Graphics& g)
+            {
+                g.fillRect (list.getRectangle (0));
+                g.fillRect (list.getRectangle (1));
+            }), expected));
+        }
+
+        beginTest ("Path clips inside a single rectangle match clips inside a rectangle list");
+        {
+            const auto draw = [&] (const RectangleList<int>& clip)
+            {
+                Image image (Image::ARGB, 70, 50, true, SoftwareImageType());
+                Graphics g (image);
+                g.reduceClipRegion (clip);
+                g.reduceClipRegion (ellipse);
+                g.fillAll (Colours::white);
+                return image;
+            };
+
+            RectangleList<int> split;
+            split.add ({ 5, 5, 30, 40 });
+            split.add ({ 35, 5, 30, 40 });
+
+            expect (imagesAreIdentical (draw (RectangleList<int> ({ 5, 5, 60, 40 })), draw (split)));
+        }
+    }
+
+private:
+    struct SpanCollector
+    {
+        void setEdgeTableYPos (int newY)                          { y = newY; }
+        void handleEdgeTablePixel (int x, int alpha)              { spans.push_back ({ x, y, 1, alpha }); }
+        void handleEdgeTablePixelFull (int x)                     { spans.push_back ({ x, y, 1, 255 }); }
+        void handleEdgeTableLine (int x, int width, int alpha)    { spans.push_back ({ x, y, width, alpha }); }
+        void handleEdgeTableLineFull (int x, int width)           { spans.push_back ({ x, y, width, 255 }); }
+
+        int y = 0;
+        std::vector<std::array<int, 4>> spans;
+    };
+
+    static std::vector<std::array<int, 4>> getSpans (const EdgeTable& table)
+    {
+        SpanCollector collector;
+        table.iterate (collector);
+        return collector.spans;
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static EdgeTableTests edgeTableTests;
+
+#endif
+
 } // namespace juce
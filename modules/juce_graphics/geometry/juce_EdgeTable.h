@@ -193,6 +193,7 @@ public:
 private:
     //==============================================================================
     static constexpr auto defaultEdgesPerLine = 32;
+    static constexpr auto edgesPerRectangleLine = 2;
     static constexpr auto scale = 256;
 
     //==============================================================================
@@ -114,7 +114,8 @@ Path::~Path()
 Path::Path (const Path& other)
     : data (other.data),
       bounds (other.bounds),
-      useNonZeroWinding (other.useNonZeroWinding)
+      useNonZeroWinding (other.useNonZeroWinding),
+      contentID (other.contentID.load (std::memory_order_relaxed))
 {
 }
 
@@ -125,6 +126,7 @@ Path& Path::operator= (const Path& other)
         data = other.data;
         bounds = other.bounds;
         useNonZeroWinding = other.useNonZeroWinding;
+        contentID.store (other.contentID.load (std::memory_order_relaxed), std::memory_order_relaxed);
     }
 
     return *this;
@@ -133,7 +135,8 @@ Path& Path::operator= (const Path& other)
 Path::Path (Path&& other) noexcept
     : data (std::move (other.data)),
       bounds (other.bounds),
-      useNonZeroWinding (other.useNonZeroWinding)
+      useNonZeroWinding (other.useNonZeroWinding),
+      contentID (other.contentID.exchange (0, std::memory_order_relaxed))
 {
 }
 
@@ -142,9 +145,24 @@ Path& Path::operator= (Path&& other) noexcept
     data = std::move (other.data);
     bounds = other.bounds;
     useNonZeroWinding = other.useNonZeroWinding;
+    contentID.store (other.contentID.exchange (0, std::memory_order_relaxed), std::memory_order_relaxed);
     return *this;
 }
 
+uint64 Path::getContentID() const noexcept
+{
+    auto currentID = contentID.load (std::memory_order_relaxed);
+
+    if (currentID != 0)
+        return currentID;
+
+    // Copies share an ID, as they have the same contents
+    static std::atomic<uint64> lastContentID { 0 };
+    const auto newID = ++lastContentID;
+
+    return contentID.compare_exchange_strong (currentID, newID, std::memory_order_relaxed) ? newID : currentID;
+}
+
 bool Path::operator== (const Path& other) const noexcept    { return useNonZeroWinding == other.useNonZeroWinding && data == other.data; }
 bool Path::operator!= (const Path& other) const noexcept    { return ! operator== (other); }
 
@@ -152,6 +170,7 @@ void Path::clear() noexcept
 {
     data.clearQuick();
     bounds.reset();
+    contentChanged();
 }
 
 void Path::swapWithPath (Path& other) noexcept
@@ -162,12 +181,17 @@ void Path::swapWithPath (Path& other) noexcept
     std::swap (bounds.pathYMin, other.bounds.pathYMin);
     std::swap (bounds.pathYMax, other.bounds.pathYMax);
     std::swap (useNonZeroWinding, other.useNonZeroWinding);
+
+    const auto otherID = other.contentID.load (std::memory_order_relaxed);
+    other.contentID.store (contentID.load (std::memory_order_relaxed), std::memory_order_relaxed);
+    contentID.store (otherID, std::memory_order_relaxed);
 }
 
 //==============================================================================
 void Path::setUsingNonZeroWinding (const bool isNonZero) noexcept
 {
     useNonZeroWinding = isNonZero;
+    contentChanged();
 }
 
 void Path::scaleToFit (float x, float y, float w, float h, bool preserveProportions) noexcept
@@ -223,6 +247,7 @@ void Path::startNewSubPath (const float x, const float y)
         bounds.extend (x, y);
 
     data.add (moveMarker, x, y);
+    contentChanged();
 }
 
 void Path::startNewSubPath (Point<float> start)
@@ -239,6 +264,7 @@ void Path::lineTo (const float x, const float y)
 
     data.add (lineMarker, x, y);
     bounds.extend (x, y);
+    contentChanged();
 }
 
 void Path::lineTo (Point<float> end)
@@ -257,6 +283,7 @@ void Path::quadraticTo (const float x1, const float y1,
 
     data.add (quadMarker, x1, y1, x2, y2);
     bounds.extend (x1, y1, x2, y2);
+    contentChanged();
 }
 
 void Path::quadraticTo (Point<float> controlPoint, Point<float> endPoint)
@@ -278,6 +305,7 @@ void Path::cubicTo (const float x1, const float y1,
 
     data.add (cubicMarker, x1, y1, x2, y2, x3, y3);
     bounds.extend (x1, y1, x2, y2, x3, y3);
+    contentChanged();
 }
 
 void Path::cubicTo (Point<float> controlPoint1,
@@ -292,7 +320,10 @@ void Path::cubicTo (Point<float> controlPoint1,
 void Path::closeSubPath()
 {
     if (! (data.isEmpty() || isMarker (data.getLast(), closeSubPathMarker)))
+    {
         data.add (closeSubPathMarker);
+        contentChanged();
+    }
 }
 
 Point<float> Path::getCurrentPosition() const
@@ -347,6 +378,8 @@ void Path::addRectangle (float x, float y, float w, float h)
               lineMarker, x2, y1,
               lineMarker, x2, y2,
               closeSubPathMarker);
+
+    contentChanged();
 }
 
 void Path::addRoundedRectangle (float x, float y, float w, float h, float csx, float csy)
@@ -820,6 +853,7 @@ void Path::addPath (const Path& other,
 //==============================================================================
 void Path::applyTransform (const AffineTransform& transform) noexcept
 {
+    contentChanged();
     bounds.reset();
     bool firstPoint = true;
     float* d = data.begin();
@@ -803,6 +803,7 @@ private:
     friend class PathFlatteningIterator;
     friend class Path::Iterator;
     friend class EdgeTable;
+    friend struct StrokedPathCache;
 
     Array<float> data;
 
@@ -827,6 +828,13 @@ private:
     PathBounds bounds;
     bool useNonZeroWinding = true;
 
+    // Identifies the current contents of the path so that results derived from it can be
+    // cached. It's handed out lazily, and reset to zero whenever the path is modified.
+    mutable std::atomic<uint64> contentID { 0 };
+
+    uint64 getContentID() const noexcept;
+    void contentChanged() noexcept      { contentID.store (0, std::memory_order_relaxed); }
+
     static const float lineMarker;
     static const float moveMarker;
     static const float quadMarker;
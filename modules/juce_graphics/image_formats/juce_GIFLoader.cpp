@@ -446,6 +446,20 @@ Image GIFImageFormat::decodeImage (InputStream& in)
    #endif
 }
 
+Rectangle<int> GIFImageFormat::readImageBounds (InputStream& in)
+{
+    char header [6];
+
+    if (in.read (header, sizeof (header)) != (int) sizeof (header)
+         || header[0] != 'G' || header[1] != 'I' || header[2] != 'F')
+        return {};
+
+    const auto width  = (int) (uint16) in.readShort();
+    const auto height = (int) (uint16) in.readShort();
+
+    return { width, height };
+}
+
 bool GIFImageFormat::writeImageToStream (const Image& /*sourceImage*/, OutputStream& /*destStream*/)
 {
     jassertfalse; // writing isn't implemented for GIFs!
@@ -249,11 +249,11 @@ bool JPEGImageFormat::canUnderstand (InputStream& in)
  Image juce_loadWithCoreImage (InputStream& input);
 #endif
 
-Image JPEGImageFormat::decodeImage (InputStream& in)
+#if ! JUCE_USING_COREIMAGE_LOADER
+// If maxWidth and maxHeight are positive, the image is decoded at the smallest of libjpeg's
+// reduced sizes that isn't smaller than the scaled size, which the caller then rescales.
+static Image decodeJPEG (InputStream& in, int maxWidth, int maxHeight)
 {
-   #if JUCE_USING_COREIMAGE_LOADER
-    return juce_loadWithCoreImage (in);
-   #else
     using namespace jpeglibNamespace;
     using namespace JPEGHelpers;
 
@@ -291,6 +291,23 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            if (maxWidth > 0 || maxHeight > 0)
+            {
+                const Rectangle<int> fullBounds ((int) jpegDecompStruct.image_width, (int) jpegDecompStruct.image_height);
+                const auto scaledBounds = ImageFileFormat::getScaledImageBounds (fullBounds, maxWidth, maxHeight);
+
+                for (unsigned int denominator = 8; denominator > 1; denominator /= 2)
+                {
+                    if ((fullBounds.getWidth()  + (int) denominator - 1) / (int) denominator >= scaledBounds.getWidth()
+                     && (fullBounds.getHeight() + (int) denominator - 1) / (int) denominator >= scaledBounds.getHeight())
+                    {
+                        jpegDecompStruct.scale_num = 1;
+                        jpegDecompStruct.scale_denom = denominator;
+                        break;
+                    }
+                }
+            }
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -356,9 +373,87 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
     }
 
     return image;
+}
+#endif
+
+Image JPEGImageFormat::decodeImage (InputStream& in)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return juce_loadWithCoreImage (in);
+   #else
+    return decodeJPEG (in, 0, 0);
    #endif
 }
 
+Image JPEGImageFormat::decodeScaledImage (InputStream& in, int maxWidth, int maxHeight)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return ImageFileFormat::decodeScaledImage (in, maxWidth, maxHeight);
+   #else
+    auto image = decodeJPEG (in, maxWidth, maxHeight);
+
+    if (image.isValid())
+    {
+        auto scaledBounds = getScaledImageBounds (image.getBounds(), maxWidth, maxHeight);
+
+        if (scaledBounds != image.getBounds())
+            image = image.rescaled (scaledBounds.getWidth(), scaledBounds.getHeight(), Graphics::highResamplingQuality);
+    }
+
+    return image;
+   #endif
+}
+
+Rectangle<int> JPEGImageFormat::readImageBounds (InputStream& in)
+{
+    if (in.readByte() != (char) 0xff || in.readByte() != (char) 0xd8)
+        return {};
+
+    // Walk through the markers until one of the start-of-frame markers, which holds the size
+    while (! in.isExhausted())
+    {
+        if ((uint8) in.readByte() != 0xff)
+            return {};
+
+        auto marker = (uint8) in.readByte();
+
+        while (marker == 0xff && ! in.isExhausted())
+            marker = (uint8) in.readByte();
+
+        if (marker == 0xd8 || marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7))
+            continue;
+
+        if (marker == 0xd9 || marker == 0xda)
+            return {};
+
+        const auto length = (int) (uint16) in.readShortBigEndian();
+
+        if (length < 2)
+            return {};
+
+        const auto isStartOfFrame = marker >= 0xc0 && marker <= 0xcf
+                                     && marker != 0xc4 && marker != 0xc8 && marker != 0xcc;
+
+        if (isStartOfFrame)
+        {
+            in.readByte(); // sample precision
+
+            const auto height = (int) (uint16) in.readShortBigEndian();
+            const auto width  = (int) (uint16) in.readShortBigEndian();
+
+            if (width == 0 || height == 0)
+                return {};
+
+            return { width, height };
+        }
+
+        if (! in.setPosition (in.getPosition() + length - 2))
+            return {};
+    }
+
+    return {};
+}
+
 bool JPEGImageFormat::writeImageToStream (const Image& image, OutputStream& out)
 {
     using namespace jpeglibNamespace;
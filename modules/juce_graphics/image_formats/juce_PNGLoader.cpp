@@ -537,6 +537,25 @@ Image PNGImageFormat::decodeImage (InputStream& in)
    #endif
 }
 
+Rectangle<int> PNGImageFormat::readImageBounds (InputStream& in)
+{
+    // The IHDR chunk always comes first, straight after the 8-byte signature
+    uint8 header [16];
+
+    if (in.read (header, sizeof (header)) != (int) sizeof (header)
+         || header[1] != 'P' || header[2] != 'N' || header[3] != 'G'
+         || memcmp (header + 12, "IHDR", 4) != 0)
+        return {};
+
+    const auto width  = in.readIntBigEndian();
+    const auto height = in.readIntBigEndian();
+
+    if (width <= 0 || height <= 0)
+        return {};
+
+    return { width, height };
+}
+
 bool PNGImageFormat::writeImageToStream (const Image& image, OutputStream& out)
 {
     using namespace pnglibNamespace;
@@ -299,12 +299,121 @@ Image Image::createCopy() const
     return {};
 }
 
-Image Image::rescaled (int newWidth, int newHeight, Graphics::ResamplingQuality quality) const
+//==============================================================================
+/*  Shrinks an image by setting each destination pixel to the area-weighted average of
+    the source pixels that it covers. This works on the raw bytes of each pixel, so it
+    doesn't care about the channel order, and because ARGB images are premultiplied,
+    averaging their components directly gives the correct result.
+*/
+struct AreaAveragingResampler
+{
+    static void resample (const Image::BitmapData& src, const Image::BitmapData& dest,
+                          int numChannels, WorkStealingThreadPool* threadPool)
+    {
+        const Contributions columns (src.width, dest.width), rows (src.height, dest.height);
+
+        auto resampleRow = [&] (int y)
+        {
+            std::vector<float> sums ((size_t) (dest.width * numChannels), 0.0f);
+            auto* rowWeights = rows.getWeights (y);
+
+            for (int r = 0; r < rows.getNumWeights (y); ++r)
+            {
+                auto* srcLine = src.getLinePointer (rows.getStart (y) + r);
+                auto* sum = sums.data();
+
+                for (int x = 0; x < dest.width; ++x, sum += numChannels)
+                {
+                    auto* srcPixel = srcLine + columns.getStart (x) * src.pixelStride;
+                    auto* columnWeights = columns.getWeights (x);
+
+                    for (int c = 0; c < columns.getNumWeights (x); ++c, srcPixel += src.pixelStride)
+                    {
+                        auto weight = columnWeights[c] * rowWeights[r];
+
+                        for (int channel = 0; channel < numChannels; ++channel)
+                            sum[channel] += weight * (float) srcPixel[channel];
+                    }
+                }
+            }
+
+            auto* destPixel = dest.getLinePointer (y);
+            auto* sum = sums.data();
+
+            for (int x = 0; x < dest.width; ++x, destPixel += dest.pixelStride, sum += numChannels)
+                for (int channel = 0; channel < numChannels; ++channel)
+                    destPixel[channel] = (uint8) jlimit (0, 255, roundToInt (sum[channel]));
+        };
+
+        if (threadPool != nullptr)
+        {
+            threadPool->parallelFor (0, dest.height, resampleRow);
+        }
+        else
+        {
+            for (int y = 0; y < dest.height; ++y)
+                resampleRow (y);
+        }
+    }
+
+private:
+    // The range of source pixels that each destination pixel covers along one axis,
+    // and how much of each one falls inside it.
+    struct Contributions
+    {
+        Contributions (int sourceSize, int destSize)
+        {
+            const auto scale = (double) sourceSize / (double) destSize;
+
+            for (int i = 0; i < destSize; ++i)
+            {
+                const auto start = i * scale, end = (i + 1) * scale;
+                const auto first = (int) start;
+                const auto last = jmin (sourceSize, (int) std::ceil (end));
+
+                starts.push_back (first);
+                offsets.push_back ((int) weights.size());
+
+                for (int s = first; s < last; ++s)
+                    weights.push_back ((float) ((jmin (end, s + 1.0) - jmax (start, (double) s)) / scale));
+            }
+
+            offsets.push_back ((int) weights.size());
+        }
+
+        int getStart (int i) const noexcept             { return starts[(size_t) i]; }
+        int getNumWeights (int i) const noexcept        { return offsets[(size_t) i + 1] - offsets[(size_t) i]; }
+        const float* getWeights (int i) const noexcept  { return weights.data() + offsets[(size_t) i]; }
+
+        std::vector<int> starts, offsets;
+        std::vector<float> weights;
+    };
+};
+
+Image Image::rescaled (int newWidth, int newHeight, Graphics::ResamplingQuality quality,
+                       WorkStealingThreadPool* threadPool) const
 {
     if (image == nullptr || (image->width == newWidth && image->height == newHeight))
         return *this;
 
     auto type = image->createType();
+
+    if (quality == Graphics::highResamplingQuality
+         && newWidth > 0 && newHeight > 0
+         && newWidth <= image->width && newHeight <= image->height
+         && image->pixelFormat != UnknownFormat)
+    {
+        Image newImage (type->create (image->pixelFormat, newWidth, newHeight, false));
+
+        const BitmapData srcData (*this, 0, 0, image->width, image->height);
+        const BitmapData destData (newImage, 0, 0, newWidth, newHeight, BitmapData::writeOnly);
+
+        AreaAveragingResampler::resample (srcData, destData,
+                                          image->pixelFormat == ARGB ? 4 : (image->pixelFormat == RGB ? 3 : 1),
+                                          threadPool);
+        return newImage;
+    }
+
     Image newImage (type->create (image->pixelFormat, newWidth, newHeight, hasAlphaChannel()));
 
     Graphics g (newImage);
@@ -314,6 +423,19 @@ Image Image::rescaled (int newWidth, int newHeight, Graphics::ResamplingQuality
     return newImage;
 }
 
+template <class DestPixelType, class SrcPixelType>
+static void convertPixels (const Image::BitmapData& dest, const Image::BitmapData& src)
+{
+    for (int y = 0; y < src.height; ++y)
+    {
+        auto* srcPixel = src.getLinePointer (y);
+        auto* destPixel = dest.getLinePointer (y);
+
+        for (int x = 0; x < src.width; ++x, srcPixel += src.pixelStride, destPixel += dest.pixelStride)
+            reinterpret_cast<DestPixelType*> (destPixel)->set (*reinterpret_cast<const SrcPixelType*> (srcPixel));
+    }
+}
+
 Image Image::convertedToFormat (PixelFormat newFormat) const
 {
     if (image == nullptr || newFormat == image->pixelFormat)
@@ -332,32 +454,25 @@ Image Image::convertedToFormat (PixelFormat newFormat) const
         }
         else
         {
-            const BitmapData destData (newImage, 0, 0, w, h, BitmapData::writeOnly);
-            const BitmapData srcData (*this, 0, 0, w, h);
-
-            for (int y = 0; y < h; ++y)
-            {
-                auto src = reinterpret_cast<const PixelARGB*> (srcData.getLinePointer (y));
-                auto dst = destData.getLinePointer (y);
-
-                for (int x = 0; x < w; ++x)
-                    dst[x] = src[x].getAlpha();
-            }
+            convertPixels<PixelAlpha, PixelARGB> (BitmapData (newImage, 0, 0, w, h, BitmapData::writeOnly),
+                                                  BitmapData (*this, 0, 0, w, h));
         }
     }
     else if (image->pixelFormat == SingleChannel && newFormat == Image::ARGB)
     {
-        const BitmapData destData (newImage, 0, 0, w, h, BitmapData::writeOnly);
-        const BitmapData srcData (*this, 0, 0, w, h);
-
-        for (int y = 0; y < h; ++y)
-        {
-            auto src = reinterpret_cast<const PixelAlpha*> (srcData.getLinePointer (y));
-            auto dst = reinterpret_cast<PixelARGB*> (destData.getLinePointer (y));
-
-            for (int x = 0; x < w; ++x)
-                dst[x].set (src[x]);
-        }
+        convertPixels<PixelARGB, PixelAlpha> (BitmapData (newImage, 0, 0, w, h, BitmapData::writeOnly),
+                                              BitmapData (*this, 0, 0, w, h));
+    }
+    else if (image->pixelFormat == RGB && newFormat == Image::ARGB)
+    {
+        convertPixels<PixelARGB, PixelRGB> (BitmapData (newImage, 0, 0, w, h, BitmapData::writeOnly),
+                                            BitmapData (*this, 0, 0, w, h));
+    }
+    else if (image->pixelFormat == ARGB && newFormat == Image::RGB)
+    {
+        // the premultiplied colour components are the same as the pixel drawn over black
+        convertPixels<PixelRGB, PixelARGB> (BitmapData (newImage, 0, 0, w, h, BitmapData::writeOnly),
+                                            BitmapData (*this, 0, 0, w, h));
     }
     else
     {
@@ -697,4 +812,90 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 
 #endif
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageTests  : public UnitTest
+{
+public:
+    ImageTests()
+        : UnitTest ("Image", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Converting between RGB and ARGB");
+        {
+            Image rgb (Image::RGB, 8, 4, false);
+
+            for (int y = 0; y < rgb.getHeight(); ++y)
+                for (int x = 0; x < rgb.getWidth(); ++x)
+                    rgb.setPixelAt (x, y, Colour ((uint8) (x * 30), (uint8) (y * 60), (uint8) (x + y)));
+
+            auto argb = rgb.convertedToFormat (Image::ARGB);
+            expect (argb.getFormat() == Image::ARGB);
+
+            for (int y = 0; y < rgb.getHeight(); ++y)
+                for (int x = 0; x < rgb.getWidth(); ++x)
+                    expect (argb.getPixelAt (x, y) == rgb.getPixelAt (x, y));
+
+            auto roundTrip = argb.convertedToFormat (Image::RGB);
+
+            for (int y = 0; y < rgb.getHeight(); ++y)
+                for (int x = 0; x < rgb.getWidth(); ++x)
+                    expect (roundTrip.getPixelAt (x, y) == rgb.getPixelAt (x, y));
+
+            Image translucent (Image::ARGB, 1, 1, true);
+            translucent.setPixelAt (0, 0, Colours::white.withAlpha ((uint8) 0x80));
+            auto overBlack = translucent.convertedToFormat (Image::RGB).getPixelAt (0, 0);
+            expect (std::abs ((int) overBlack.getRed() - 0x80) <= 1);
+            expect (overBlack.getRed() == overBlack.getGreen() && overBlack.getRed() == overBlack.getBlue());
+        }
+
+        beginTest ("High quality downscaling averages the covered pixels");
+        {
+            Image checkerboard (Image::ARGB, 64, 32, true);
+
+            for (int y = 0; y < checkerboard.getHeight(); ++y)
+                for (int x = 0; x < checkerboard.getWidth(); ++x)
+                    checkerboard.setPixelAt (x, y, ((x + y) % 2) == 0 ? Colours::white : Colours::transparentBlack);
+
+            auto half = checkerboard.rescaled (32, 16, Graphics::highResamplingQuality);
+            expectEquals (half.getWidth(), 32);
+            expectEquals (half.getHeight(), 16);
+
+            for (int y = 0; y < half.getHeight(); ++y)
+                for (int x = 0; x < half.getWidth(); ++x)
+                    expectEquals ((int) half.getPixelAt (x, y).getAlpha(), 0x80);
+
+            Image gradient (Image::RGB, 300, 200, false);
+
+            for (int y = 0; y < gradient.getHeight(); ++y)
+                for (int x = 0; x < gradient.getWidth(); ++x)
+                    gradient.setPixelAt (x, y, Colour ((uint8) (x % 256), (uint8) (y % 256), (uint8) ((x * y) % 256)));
+
+            WorkStealingThreadPool pool (4);
+            auto serial = gradient.rescaled (77, 41, Graphics::highResamplingQuality);
+            auto parallel = gradient.rescaled (77, 41, Graphics::highResamplingQuality, &pool);
+
+            auto allMatch = true;
+
+            for (int y = 0; y < serial.getHeight(); ++y)
+                for (int x = 0; x < serial.getWidth(); ++x)
+                    allMatch = allMatch && serial.getPixelAt (x, y) == parallel.getPixelAt (x, y);
+
+            expect (allMatch);
+
+            // the mean of (x % 256) for x in [0, 300) is about 111.95
+            auto single = gradient.rescaled (1, 1, Graphics::highResamplingQuality);
+            expectEquals ((int) single.getPixelAt (0, 0).getRed(), 112);
+        }
+    }
+};
+
+static ImageTests imageTests;
+
+#endif
+
 } // namespace juce
@@ -193,11 +193,18 @@ public:
 
         A new image is returned which is a copy of this one, rescaled to the given size.
 
+        When an image is being shrunk with Graphics::highResamplingQuality, each new pixel
+        is set to the area-weighted average of all the pixels it covers, which avoids the
+        aliasing you'd get from sampling when the size is reduced by a large factor. If a
+        thread pool is supplied, the rows of the new image are shared out between its
+        threads. Other resizes are drawn using a Graphics context, and ignore the pool.
+
         Note that if the new size is identical to the existing image, this will just return
         a reference to the original image, and won't actually create a duplicate.
     */
     Image rescaled (int newWidth, int newHeight,
-                    Graphics::ResamplingQuality quality = Graphics::mediumResamplingQuality) const;
+                    Graphics::ResamplingQuality quality = Graphics::mediumResamplingQuality,
+                    WorkStealingThreadPool* threadPool = nullptr) const;
 
     /** Creates a copy of this image.
         Note that it's usually more efficient to use duplicateIfShared(), because it may not be necessary
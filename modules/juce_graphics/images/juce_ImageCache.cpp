@@ -30,7 +30,12 @@ struct ImageCache::Pimpl     : private Timer,
                                private DeletedAtShutdown
 {
     Pimpl() = default;
-    ~Pimpl() override { clearSingletonInstance(); }
+
+    ~Pimpl() override
+    {
+        clearSingletonInstance();
+        threadPool.reset();
+    }
 
     JUCE_DECLARE_SINGLETON (ImageCache::Pimpl, false)
 
@@ -58,7 +63,8 @@ struct ImageCache::Pimpl     : private Timer,
                 startTimer (2000);
 
             const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter(), getNumBytes (image) });
+            applyMemoryBudget();
         }
     }
 
@@ -83,6 +89,8 @@ struct ImageCache::Pimpl     : private Timer,
             }
         }
 
+        applyMemoryBudget();
+
         if (images.isEmpty())
             stopTimer();
     }
@@ -96,16 +104,214 @@ struct ImageCache::Pimpl     : private Timer,
                 images.remove (i);
     }
 
+    //==============================================================================
+    void setMemoryBudget (size_t maxNumBytes)
+    {
+        const ScopedLock sl (lock);
+        memoryBudget = maxNumBytes;
+        applyMemoryBudget();
+    }
+
+    size_t getMemoryUsage() const
+    {
+        const ScopedLock sl (lock);
+        size_t total = 0;
+
+        for (auto& item : images)
+            total += item.numBytes;
+
+        return total;
+    }
+
+    void applyMemoryBudget()
+    {
+        if (memoryBudget == 0)
+            return;
+
+        for (auto total = getMemoryUsage(); total > memoryBudget;)
+        {
+            int oldest = -1;
+
+            for (int i = 0; i < images.size(); ++i)
+            {
+                auto& item = images.getReference (i);
+
+                if (item.image.getReferenceCount() <= 1
+                     && (oldest < 0 || item.lastUseTime < images.getReference (oldest).lastUseTime))
+                    oldest = i;
+            }
+
+            if (oldest < 0)
+                break; // everything left is still in use
+
+            total -= images.getReference (oldest).numBytes;
+            images.remove (oldest);
+        }
+    }
+
+    static size_t getNumBytes (const Image& image)
+    {
+        auto bytesPerPixel = image.getFormat() == Image::ARGB ? 4
+                           : (image.getFormat() == Image::RGB ? 3 : 1);
+
+        return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+    }
+
+    //==============================================================================
+    Image loadAsync (const File& file, int64 hashCode, int maxWidth, int maxHeight,
+                     std::function<void (const Image&)> onLoaded)
+    {
+        const ScopedLock sl (lock);
+
+        auto pending = pendingLoads.find (hashCode);
+
+        if (pending != pendingLoads.end())
+        {
+            if (onLoaded != nullptr)
+                pending->second.callbacks.push_back (std::move (onLoaded));
+
+            return pending->second.placeholder;
+        }
+
+        auto image = getFromHashCode (hashCode);
+
+        if (image.isValid())
+        {
+            if (onLoaded != nullptr)
+                onLoaded (image);
+
+            return image;
+        }
+
+        auto bounds = readScaledBounds (file, maxWidth, maxHeight);
+
+        if (! bounds.isEmpty())
+        {
+            image = Image (Image::ARGB, bounds.getWidth(), bounds.getHeight(), true);
+            addImageToCache (image, hashCode);
+        }
+
+        auto& load = pendingLoads[hashCode];
+        load.placeholder = image;
+
+        if (onLoaded != nullptr)
+            load.callbacks.push_back (std::move (onLoaded));
+
+        getThreadPool().addJob ([file, hashCode, maxWidth, maxHeight]
+        {
+            auto decoded = ImageFileFormat::loadFrom (file, maxWidth, maxHeight);
+
+            auto deliver = [hashCode, decoded]
+            {
+                if (auto* instance = getInstanceWithoutCreating())
+                    instance->loadFinished (hashCode, decoded);
+            };
+
+            if (! MessageManager::callAsync (deliver))
+                deliver();
+        });
+
+        return image;
+    }
+
+    void loadFinished (int64 hashCode, const Image& decoded)
+    {
+        PendingLoad load;
+
+        {
+            const ScopedLock sl (lock);
+            auto pending = pendingLoads.find (hashCode);
+
+            if (pending == pendingLoads.end())
+                return;
+
+            load = std::move (pending->second);
+            pendingLoads.erase (pending);
+        }
+
+        auto result = decoded;
+
+        if (load.placeholder.isValid())
+        {
+            if (decoded.isValid())
+            {
+                // The placeholder is already in the cache and may be held elsewhere,
+                // so the pixels are copied into it rather than replacing it.
+                Graphics g (load.placeholder);
+                g.drawImage (decoded,
+                             0, 0, load.placeholder.getWidth(), load.placeholder.getHeight(),
+                             0, 0, decoded.getWidth(), decoded.getHeight());
+
+                result = load.placeholder;
+            }
+            else
+            {
+                removeImage (load.placeholder);
+            }
+        }
+        else
+        {
+            addImageToCache (decoded, hashCode);
+        }
+
+        for (auto& callback : load.callbacks)
+            callback (result);
+    }
+
+    void removeImage (const Image& image)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = images.size(); --i >= 0;)
+            if (images.getReference (i).image == image)
+                images.remove (i);
+    }
+
+    static Rectangle<int> readScaledBounds (const File& file, int maxWidth, int maxHeight)
+    {
+        FileInputStream stream (file);
+
+        if (stream.openedOk())
+        {
+            BufferedInputStream b (stream, 1024);
+
+            if (auto* format = ImageFileFormat::findImageFormatForStream (b))
+                return ImageFileFormat::getScaledImageBounds (format->readImageBounds (b), maxWidth, maxHeight);
+        }
+
+        return {};
+    }
+
+    ThreadPool& getThreadPool()
+    {
+        if (threadPool == nullptr)
+            threadPool = std::make_unique<ThreadPool> (jlimit (1, 4, SystemStats::getNumCpus() - 1),
+                                                       0, Thread::Priority::low);
+
+        return *threadPool;
+    }
+
+    //==============================================================================
     struct Item
     {
         Image image;
         int64 hashCode;
         uint32 lastUseTime;
+        size_t numBytes;
+    };
+
+    struct PendingLoad
+    {
+        Image placeholder;
+        std::vector<std::function<void (const Image&)>> callbacks;
     };
 
     Array<Item> images;
+    std::map<int64, PendingLoad> pendingLoads;
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
+    size_t memoryBudget = 0;
+    std::unique_ptr<ThreadPool> threadPool;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -155,15 +361,90 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
     return image;
 }
 
+Image ImageCache::getFromFileAsync (const File& file, std::function<void (const Image&)> onLoaded)
+{
+    return Pimpl::getInstance()->loadAsync (file, file.hashCode64(), 0, 0, std::move (onLoaded));
+}
+
+Image ImageCache::getFromFileAsync (const File& file, int maxWidth, int maxHeight,
+                                    std::function<void (const Image&)> onLoaded)
+{
+    if (maxWidth <= 0 && maxHeight <= 0)
+        return getFromFileAsync (file, std::move (onLoaded));
+
+    auto hashCode = (file.getFullPathName() + "@" + String (maxWidth) + "x" + String (maxHeight)).hashCode64();
+    return Pimpl::getInstance()->loadAsync (file, hashCode, maxWidth, maxHeight, std::move (onLoaded));
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setMemoryBudget (size_t maxNumBytes)
+{
+    Pimpl::getInstance()->setMemoryBudget (maxNumBytes);
+}
+
+size_t ImageCache::getMemoryUsage()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getMemoryUsage();
+
+    return 0;
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageCacheTests  : public UnitTest
+{
+public:
+    ImageCacheTests()
+        : UnitTest ("ImageCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Memory budget releases the least recently used unreferenced images");
+        {
+            const int64 baseHash = 0x7e57ca4e0000;
+            ImageCache::releaseUnusedImages();
+            const auto usageBefore = ImageCache::getMemoryUsage();
+
+            Image held (Image::ARGB, 32, 32, true);
+            ImageCache::addImageToCache (held, baseHash);
+            ImageCache::addImageToCache (Image (Image::ARGB, 32, 32, true), baseHash + 1);
+            ImageCache::addImageToCache (Image (Image::ARGB, 32, 32, true), baseHash + 2);
+
+            expectEquals ((int) (ImageCache::getMemoryUsage() - usageBefore), 3 * 32 * 32 * 4);
+
+            ImageCache::setMemoryBudget (usageBefore + 2 * 32 * 32 * 4);
+            expect (ImageCache::getFromHashCode (baseHash).isValid());
+            expect (ImageCache::getFromHashCode (baseHash + 2).isValid());
+            expect (ImageCache::getFromHashCode (baseHash + 1).isNull());
+
+            ImageCache::setMemoryBudget (1);
+            expect (ImageCache::getFromHashCode (baseHash).isValid());
+            expect (ImageCache::getFromHashCode (baseHash + 2).isNull());
+
+            ImageCache::setMemoryBudget (0);
+            held = {};
+            ImageCache::releaseUnusedImages();
+            expect (ImageCache::getFromHashCode (baseHash).isNull());
+        }
+    }
+};
+
+static ImageCacheTests imageCacheTests;
+
+#endif
+
 } // namespace juce
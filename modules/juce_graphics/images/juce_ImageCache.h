@@ -80,6 +80,44 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Loads an image from a file on a background thread, (or just returns the image if it's
+        already cached).
+
+        If the cache doesn't already contain this file's image, the size of the image is read
+        from the start of the file, and a transparent placeholder image of that size is added
+        to the cache and returned straight away. The file is then decoded on a background
+        thread, and when it's ready, its pixels are copied into the placeholder on the message
+        thread, and the callback is called with the finished image. Because the placeholder is
+        the same Image that's filled in, anything holding on to it just needs to repaint when
+        the callback happens.
+
+        If the size can't be read without decoding the whole file, or the file isn't a
+        recognised image, this returns an invalid image, and the decoded image will only be
+        delivered to the callback. If decoding fails, the callback receives an invalid image.
+
+        If the image was already in the cache, the callback is called before this returns.
+        Calling this again for a file that's still loading returns the same placeholder, and
+        the file is only decoded once.
+
+        @param file         the file to try to load
+        @param onLoaded     an optional function to call when the image has been decoded
+        @see getFromFile, ImageFileFormat::loadFrom
+    */
+    static Image getFromFileAsync (const File& file, std::function<void (const Image&)> onLoaded = {});
+
+    /** Loads a scaled-down version of an image from a file on a background thread.
+
+        This works like the other getFromFileAsync() method, but the image is scaled down if
+        necessary to fit within the given size, keeping its aspect ratio. JPEG files are decoded
+        directly at a reduced resolution, so this is much quicker than loading the full image
+        when you only need a thumbnail. Each size is cached separately.
+
+        @see ImageFileFormat::decodeScaledImage
+    */
+    static Image getFromFileAsync (const File& file, int maxWidth, int maxHeight,
+                                   std::function<void (const Image&)> onLoaded = {});
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -108,6 +146,23 @@ public:
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Sets the maximum amount of memory that the cache should use for images that aren't
+        being used anywhere else.
+
+        When the total size of the cached images goes over this budget, the least recently used
+        of the images that nothing else is referencing are released straight away, rather than
+        waiting for the timeout. Images that are still in use are never released, so the cache
+        may go over budget if they take up more than this.
+
+        A value of 0, which is the default, means there's no limit.
+    */
+    static void setMemoryBudget (size_t maxNumBytes);
+
+    /** Returns the approximate number of bytes used by the pixel data of all the images that
+        are currently in the cache.
+    */
+    static size_t getMemoryUsage();
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
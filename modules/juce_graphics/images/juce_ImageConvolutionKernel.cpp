@@ -23,6 +23,14 @@
   ==============================================================================
 */
 
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #include <emmintrin.h>
+ #define JUCE_CONVOLUTION_USE_SSE2 1
+#elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (_M_ARM64))
+ #include <arm_neon.h>
+ #define JUCE_CONVOLUTION_USE_NEON 1
+#endif
+
 namespace juce
 {
 
@@ -102,13 +110,265 @@ void ImageConvolutionKernel::createGaussianBlur (const float radius)
 }
 
 //==============================================================================
+/*  Applies a kernel to a band of rows at a time, so that the bands can be shared out
+    between threads. Every channel of every pixel is convolved in the same way, so this
+    works on the raw bytes of each pixel and doesn't care about the channel order.
+*/
+struct ConvolutionHelpers
+{
+    // Adds src * weight to dest, four values at a time where possible
+    static void addScaled (float* dest, const float* src, float weight, int num) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_CONVOLUTION_USE_SSE2
+        const auto w = _mm_set1_ps (weight);
+
+        for (; i + 4 <= num; i += 4)
+            _mm_storeu_ps (dest + i, _mm_add_ps (_mm_loadu_ps (dest + i), _mm_mul_ps (_mm_loadu_ps (src + i), w)));
+       #elif JUCE_CONVOLUTION_USE_NEON
+        const auto w = vdupq_n_f32 (weight);
+
+        for (; i + 4 <= num; i += 4)
+            vst1q_f32 (dest + i, vmlaq_f32 (vld1q_f32 (dest + i), vld1q_f32 (src + i), w));
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] += src[i] * weight;
+    }
+
+    // Adds (toAdd - toRemove) to dest, which keeps the running sums of a box filter moving
+    static void addDifference (float* dest, const float* toAdd, const float* toRemove, int num) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_CONVOLUTION_USE_SSE2
+        for (; i + 4 <= num; i += 4)
+            _mm_storeu_ps (dest + i, _mm_add_ps (_mm_loadu_ps (dest + i),
+                                                 _mm_sub_ps (_mm_loadu_ps (toAdd + i), _mm_loadu_ps (toRemove + i))));
+       #elif JUCE_CONVOLUTION_USE_NEON
+        for (; i + 4 <= num; i += 4)
+            vst1q_f32 (dest + i, vaddq_f32 (vld1q_f32 (dest + i), vsubq_f32 (vld1q_f32 (toAdd + i), vld1q_f32 (toRemove + i))));
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] += toAdd[i] - toRemove[i];
+    }
+
+    static void writeRow (uint8* dest, const float* sums, float scale, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            dest[i] = (uint8) jlimit (0, 255, roundToInt (sums[i] * scale));
+    }
+
+    /*  A kernel that's the product of a column of weights and a row of weights, which can
+        be applied as a horizontal pass followed by a vertical one. If all the weights along
+        one direction are the same, that pass just keeps a running sum, so its cost doesn't
+        depend on the size of the kernel.
+    */
+    struct SeparableKernel
+    {
+        std::vector<float> rowWeights, columnWeights;
+        bool isRowUniform = false, isColumnUniform = false;
+    };
+
+    static std::optional<SeparableKernel> findSeparableFactors (const float* values, int size)
+    {
+        // If the kernel is separable, the row and column through its largest value are
+        // scaled copies of all the other rows and columns
+        int pivot = 0;
+
+        for (int i = 1; i < size * size; ++i)
+            if (std::abs (values[i]) > std::abs (values[pivot]))
+                pivot = i;
+
+        const auto pivotValue = values[pivot];
+
+        if (pivotValue == 0.0f)
+            return {};
+
+        SeparableKernel kernel;
+        const auto pivotX = pivot % size, pivotY = pivot / size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            kernel.rowWeights.push_back (values[i + pivotY * size]);
+            kernel.columnWeights.push_back (values[pivotX + i * size] / pivotValue);
+        }
+
+        const auto tolerance = std::abs (pivotValue) * 1.0e-5f;
+
+        for (int y = 0; y < size; ++y)
+            for (int x = 0; x < size; ++x)
+                if (std::abs (values[x + y * size] - kernel.rowWeights[(size_t) x] * kernel.columnWeights[(size_t) y]) > tolerance)
+                    return {};
+
+        auto isUniform = [] (const std::vector<float>& weights)
+        {
+            return std::all_of (weights.begin(), weights.end(), [&] (float w) { return w == weights.front(); });
+        };
+
+        // Running sums stay exact while they're sums of whole numbers that a float can hold
+        const auto canUseRunningSums = size * size * 255 < (1 << 24);
+        kernel.isRowUniform    = canUseRunningSums && isUniform (kernel.rowWeights);
+        kernel.isColumnUniform = canUseRunningSums && isUniform (kernel.columnWeights);
+        return kernel;
+    }
+
+    static void applySeparable (const SeparableKernel& kernel, const Image::BitmapData& src, const Image::BitmapData& dest,
+                                Rectangle<int> area, int numChannels, int bandStart, int bandEnd)
+    {
+        const auto size = (int) kernel.rowWeights.size();
+        const auto half = size >> 1;
+        const auto rowLength = area.getWidth() * numChannels;
+
+        // The source rows that this band of destination rows needs, after the horizontal pass
+        const auto firstRow = jmax (0, bandStart - half);
+        const auto lastRow  = jmin (src.height, bandEnd - half + size);
+
+        if (firstRow >= lastRow)
+        {
+            for (int y = bandStart; y < bandEnd; ++y)
+                zeromem (dest.getLinePointer (y - area.getY()), (size_t) rowLength);
+
+            return;
+        }
+
+        std::vector<float> padded ((size_t) ((area.getWidth() + size - 1) * numChannels));
+        std::vector<float> filtered ((size_t) ((lastRow - firstRow) * rowLength), 0.0f);
+        const auto firstSourceX = area.getX() - half;
+
+        for (int sy = firstRow; sy < lastRow; ++sy)
+        {
+            // Pixels beyond the edges of the image count as zero
+            std::fill (padded.begin(), padded.end(), 0.0f);
+            const auto* srcLine = src.getLinePointer (sy);
+
+            for (int sx = jmax (0, firstSourceX); sx < jmin (src.width, firstSourceX + area.getWidth() + size - 1); ++sx)
+                for (int c = 0; c < numChannels; ++c)
+                    padded[(size_t) ((sx - firstSourceX) * numChannels + c)] = (float) srcLine[sx * src.pixelStride + c];
+
+            auto* out = filtered.data() + (sy - firstRow) * rowLength;
+
+            if (kernel.isRowUniform)
+            {
+                for (int k = 0; k < size; ++k)
+                    for (int c = 0; c < numChannels; ++c)
+                        out[c] += padded[(size_t) (k * numChannels + c)];
+
+                for (int i = numChannels; i < rowLength; ++i)
+                    out[i] = out[i - numChannels] + padded[(size_t) (i - numChannels + size * numChannels)] - padded[(size_t) (i - numChannels)];
+            }
+            else
+            {
+                for (int k = 0; k < size; ++k)
+                    addScaled (out, padded.data() + k * numChannels, kernel.rowWeights[(size_t) k], rowLength);
+            }
+        }
+
+        // The uniform row weight hasn't been applied yet, so it's folded into the vertical pass
+        const auto rowScale = kernel.isRowUniform ? kernel.rowWeights.front() : 1.0f;
+        std::vector<float> sums ((size_t) rowLength, 0.0f);
+
+        auto getFilteredRow = [&] (int sy) -> const float*
+        {
+            return isPositiveAndBelow (sy - firstRow, lastRow - firstRow) ? filtered.data() + (sy - firstRow) * rowLength
+                                                                           : nullptr;
+        };
+
+        if (kernel.isColumnUniform)
+        {
+            for (int k = 0; k < size; ++k)
+                if (auto* row = getFilteredRow (bandStart - half + k))
+                    addScaled (sums.data(), row, 1.0f, rowLength);
+
+            const auto scale = rowScale * kernel.columnWeights.front();
+
+            for (int y = bandStart; y < bandEnd; ++y)
+            {
+                if (y > bandStart)
+                {
+                    auto* added   = getFilteredRow (y - half + size - 1);
+                    auto* removed = getFilteredRow (y - half - 1);
+
+                    if (added != nullptr && removed != nullptr)  addDifference (sums.data(), added, removed, rowLength);
+                    else if (added != nullptr)                   addScaled (sums.data(), added, 1.0f, rowLength);
+                    else if (removed != nullptr)                 addScaled (sums.data(), removed, -1.0f, rowLength);
+                }
+
+                writeRow (dest.getLinePointer (y - area.getY()), sums.data(), scale, rowLength);
+            }
+        }
+        else
+        {
+            for (int y = bandStart; y < bandEnd; ++y)
+            {
+                std::fill (sums.begin(), sums.end(), 0.0f);
+
+                for (int k = 0; k < size; ++k)
+                    if (auto* row = getFilteredRow (y - half + k))
+                        addScaled (sums.data(), row, kernel.columnWeights[(size_t) k] * rowScale, rowLength);
+
+                writeRow (dest.getLinePointer (y - area.getY()), sums.data(), 1.0f, rowLength);
+            }
+        }
+    }
+
+    static void applyToRow (const float* values, int size, const Image::BitmapData& src, const Image::BitmapData& dest,
+                            Rectangle<int> area, int numChannels, int y)
+    {
+        auto* destPixel = dest.getLinePointer (y - area.getY());
+        float sums[4];
+
+        for (int x = area.getX(); x < area.getRight(); ++x, destPixel += dest.pixelStride)
+        {
+            std::fill (std::begin (sums), std::end (sums), 0.0f);
+
+            for (int yy = 0; yy < size; ++yy)
+            {
+                const int sy = y + yy - (size >> 1);
+
+                if (sy >= src.height)
+                    break;
+
+                if (sy < 0)
+                    continue;
+
+                for (int xx = 0; xx < size; ++xx)
+                {
+                    const int sx = x + xx - (size >> 1);
+
+                    if (sx >= src.width)
+                        break;
+
+                    if (sx >= 0)
+                    {
+                        const auto* srcPixel = src.getPixelPointer (sx, sy);
+                        const float kernelMult = values [xx + yy * size];
+
+                        for (int c = 0; c < numChannels; ++c)
+                            sums[c] += kernelMult * srcPixel[c];
+                    }
+                }
+            }
+
+            writeRow (destPixel, sums, 1.0f, numChannels);
+        }
+    }
+};
+
 void ImageConvolutionKernel::applyToImage (Image& destImage,
                                            const Image& sourceImage,
-                                           const Rectangle<int>& destinationArea) const
+                                           const Rectangle<int>& destinationArea,
+                                           WorkStealingThreadPool* threadPool) const
 {
+    Image source (sourceImage);
+
     if (sourceImage == destImage)
     {
+        // The source pixels mustn't change while they're being read
         destImage.duplicateIfShared();
+        source = destImage.createCopy();
     }
     else
     {
@@ -126,171 +386,254 @@ void ImageConvolutionKernel::applyToImage (Image& destImage,
     if (area.isEmpty())
         return;
 
-    auto right = area.getRight();
-    auto bottom = area.getBottom();
-
     const Image::BitmapData destData (destImage, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
                                       Image::BitmapData::writeOnly);
-    uint8* line = destData.data;
+    const Image::BitmapData srcData (source, Image::BitmapData::readOnly);
+    const auto numChannels = destData.pixelStride;
 
-    const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
+    if (numChannels != 1 && numChannels != 3 && numChannels != 4)
+    {
+        jassertfalse;
+        return;
+    }
 
-    if (destData.pixelStride == 4)
+    auto forEach = [threadPool] (int begin, int end, auto&& function)
     {
-        for (int y = area.getY(); y < bottom; ++y)
+        if (threadPool != nullptr)
+        {
+            threadPool->parallelFor (begin, end, function);
+        }
+        else
         {
-            uint8* dest = line;
-            line += destData.lineStride;
+            for (int i = begin; i < end; ++i)
+                function (i);
+        }
+    };
 
-            for (int x = area.getX(); x < right; ++x)
-            {
-                float c1 = 0;
-                float c2 = 0;
-                float c3 = 0;
-                float c4 = 0;
+    if (auto separable = ConvolutionHelpers::findSeparableFactors (values, size))
+    {
+        // Each band filters the rows that overlap its neighbours again, so large kernels get taller bands
+        const auto bandHeight = jmax (32, size * 2);
+        const auto numBands = (area.getHeight() + bandHeight - 1) / bandHeight;
 
-                for (int yy = 0; yy < size; ++yy)
-                {
-                    const int sy = y + yy - (size >> 1);
+        forEach (0, numBands, [&] (int band)
+        {
+            const auto bandStart = area.getY() + band * bandHeight;
+            ConvolutionHelpers::applySeparable (*separable, srcData, destData, area, numChannels,
+                                                bandStart, jmin (area.getBottom(), bandStart + bandHeight));
+        });
+    }
+    else
+    {
+        forEach (area.getY(), area.getBottom(), [&] (int y)
+        {
+            ConvolutionHelpers::applyToRow (values, size, srcData, destData, area, numChannels, y);
+        });
+    }
+}
 
-                    if (sy >= srcData.height)
-                        break;
 
-                    if (sy >= 0)
-                    {
-                        int sx = x - (size >> 1);
-                        const uint8* src = srcData.getPixelPointer (sx, sy);
-
-                        for (int xx = 0; xx < size; ++xx)
-                        {
-                            if (sx >= srcData.width)
-                                break;
-
-                            if (sx >= 0)
-                            {
-                                const float kernelMult = values [xx + yy * size];
-                                c1 += kernelMult * *src++;
-                                c2 += kernelMult * *src++;
-                                c3 += kernelMult * *src++;
-                                c4 += kernelMult * *src++;
-                            }
-                            else
-                            {
-                                src += 4;
-                            }
-
-                            ++sx;
-                        }
-                    }
-                }
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
 
-                *dest++ = (uint8) jmin (0xff, roundToInt (c1));
-                *dest++ = (uint8) jmin (0xff, roundToInt (c2));
-                *dest++ = (uint8) jmin (0xff, roundToInt (c3));
-                *dest++ = (uint8) jmin (0xff, roundToInt (c4));
-            }
-        }
-    }
-    else if (destData.pixelStride == 3)
+class ImageConvolutionKernelTests  : public UnitTest
+{
+public:
+    ImageConvolutionKernelTests()
+        : UnitTest ("ImageConvolutionKernel", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
     {
-        for (int y = area.getY(); y < bottom; ++y)
+        auto random = getRandom();
+
+        beginTest ("Gaussian blurs match a direct convolution");
         {
-            uint8* dest = line;
-            line += destData.lineStride;
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+            {
+                ImageConvolutionKernel kernel (7);
+                kernel.createGaussianBlur (2.5f);
+                checkAgainstReference (random, kernel, format);
+            }
+        }
 
-            for (int x = area.getX(); x < right; ++x)
+        beginTest ("Box blurs match a direct convolution");
+        {
+            for (auto kernelSize : { 1, 2, 5, 9 })
             {
-                float c1 = 0;
-                float c2 = 0;
-                float c3 = 0;
+                ImageConvolutionKernel kernel (kernelSize);
 
-                for (int yy = 0; yy < size; ++yy)
-                {
-                    const int sy = y + yy - (size >> 1);
+                for (int y = 0; y < kernelSize; ++y)
+                    for (int x = 0; x < kernelSize; ++x)
+                        kernel.setKernelValue (x, y, 1.0f);
 
-                    if (sy >= srcData.height)
-                        break;
+                kernel.setOverallSum (1.0f);
+                checkAgainstReference (random, kernel, Image::ARGB);
+            }
+        }
 
-                    if (sy >= 0)
-                    {
-                        int sx = x - (size >> 1);
-                        const uint8* src = srcData.getPixelPointer (sx, sy);
-
-                        for (int xx = 0; xx < size; ++xx)
-                        {
-                            if (sx >= srcData.width)
-                                break;
-
-                            if (sx >= 0)
-                            {
-                                const float kernelMult = values [xx + yy * size];
-                                c1 += kernelMult * *src++;
-                                c2 += kernelMult * *src++;
-                                c3 += kernelMult * *src++;
-                            }
-                            else
-                            {
-                                src += 3;
-                            }
-
-                            ++sx;
-                        }
-                    }
-                }
+        beginTest ("Separable kernels with uneven weights match a direct convolution");
+        {
+            const float rowWeights[] = { 0.1f, 0.5f, 0.3f, 0.1f, 0.0f };
+            const float columnWeights[] = { 0.2f, 0.2f, 0.2f, 0.2f, 0.2f };
 
-                *dest++ = (uint8) roundToInt (c1);
-                *dest++ = (uint8) roundToInt (c2);
-                *dest++ = (uint8) roundToInt (c3);
-            }
+            ImageConvolutionKernel kernel (5);
+
+            for (int y = 0; y < 5; ++y)
+                for (int x = 0; x < 5; ++x)
+                    kernel.setKernelValue (x, y, rowWeights[x] * columnWeights[y]);
+
+            checkAgainstReference (random, kernel, Image::ARGB);
+        }
+
+        beginTest ("Other kernels match a direct convolution");
+        {
+            ImageConvolutionKernel sharpen (3);
+
+            for (int y = 0; y < 3; ++y)
+                for (int x = 0; x < 3; ++x)
+                    sharpen.setKernelValue (x, y, x == 1 && y == 1 ? 5.0f : (x == 1 || y == 1 ? -1.0f : 0.0f));
+
+            checkAgainstReference (random, sharpen, Image::ARGB);
+            checkAgainstReference (random, sharpen, Image::SingleChannel);
         }
+
+        beginTest ("Using a thread pool gives the same results");
+        {
+            WorkStealingThreadPool pool (4);
+            const auto source = createRandomImage (random, Image::ARGB, 150, 97);
+
+            ImageConvolutionKernel kernel (9);
+            kernel.createGaussianBlur (3.0f);
+
+            Image serial (Image::ARGB, source.getWidth(), source.getHeight(), true, SoftwareImageType());
+            Image parallel (Image::ARGB, source.getWidth(), source.getHeight(), true, SoftwareImageType());
+
+            kernel.applyToImage (serial, source, serial.getBounds());
+            kernel.applyToImage (parallel, source, parallel.getBounds(), &pool);
+
+            expect (imagesMatch (serial, parallel, 0));
+        }
+
+        beginTest ("Convolving an image in place reads the original pixels");
+        {
+            const auto source = createRandomImage (random, Image::ARGB, 40, 30);
+
+            ImageConvolutionKernel kernel (5);
+            kernel.createGaussianBlur (2.0f);
+
+            Image copied (Image::ARGB, source.getWidth(), source.getHeight(), true, SoftwareImageType());
+            kernel.applyToImage (copied, source, copied.getBounds());
+
+            auto inPlace = source.createCopy();
+            kernel.applyToImage (inPlace, inPlace, inPlace.getBounds());
+
+            expect (imagesMatch (copied, inPlace, 0));
+        }
+
+        beginTest ("Benchmarks");
+        {
+            const auto source = createRandomImage (random, Image::ARGB, 1024, 1024);
+            Image dest (Image::ARGB, source.getWidth(), source.getHeight(), true, SoftwareImageType());
+            WorkStealingThreadPool pool;
+
+            ImageConvolutionKernel gaussian (15);
+            gaussian.createGaussianBlur (5.0f);
+
+            ImageConvolutionKernel box (15);
+
+            for (int y = 0; y < 15; ++y)
+                for (int x = 0; x < 15; ++x)
+                    box.setKernelValue (x, y, 1.0f);
+
+            box.setOverallSum (1.0f);
+
+            benchmark ("15x15 gaussian", gaussian, source, dest, nullptr);
+            benchmark ("15x15 gaussian, thread pool", gaussian, source, dest, &pool);
+            benchmark ("15x15 box", box, source, dest, nullptr);
+        }
+    }
+
+private:
+    static Image createRandomImage (Random& random, Image::PixelFormat format, int width, int height)
+    {
+        Image image (format, width, height, false, SoftwareImageType());
+        const Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width * data.pixelStride; ++x)
+                data.getLinePointer (y)[x] = (uint8) random.nextInt (256);
+
+        return image;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b, int tolerance)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly), dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth() * dataA.pixelStride; ++x)
+                if (std::abs ((int) dataA.getLinePointer (y)[x] - (int) dataB.getLinePointer (y)[x]) > tolerance)
+                    return false;
+
+        return true;
     }
-    else if (destData.pixelStride == 1)
+
+    void checkAgainstReference (Random& random, const ImageConvolutionKernel& kernel, Image::PixelFormat format)
     {
-        for (int y = area.getY(); y < bottom; ++y)
+        const auto source = createRandomImage (random, format, 53, 41);
+        const auto area = Rectangle<int> (5, 3, 40, 35);
+
+        auto dest = createRandomImage (random, format, source.getWidth(), source.getHeight());
+        auto expected = dest.createCopy();
+
+        kernel.applyToImage (dest, source, area);
+
         {
-            uint8* dest = line;
-            line += destData.lineStride;
+            const Image::BitmapData src (source, Image::BitmapData::readOnly);
+            const Image::BitmapData out (expected, Image::BitmapData::readWrite);
+            const auto size = kernel.getKernelSize();
 
-            for (int x = area.getX(); x < right; ++x)
+            for (int y = area.getY(); y < area.getBottom(); ++y)
             {
-                float c1 = 0;
-
-                for (int yy = 0; yy < size; ++yy)
+                for (int x = area.getX(); x < area.getRight(); ++x)
                 {
-                    const int sy = y + yy - (size >> 1);
+                    for (int c = 0; c < src.pixelStride; ++c)
+                    {
+                        double sum = 0;
 
-                    if (sy >= srcData.height)
-                        break;
+                        for (int yy = 0; yy < size; ++yy)
+                            for (int xx = 0; xx < size; ++xx)
+                                if (isPositiveAndBelow (x + xx - size / 2, src.width) && isPositiveAndBelow (y + yy - size / 2, src.height))
+                                    sum += kernel.getKernelValue (xx, yy) * src.getPixelPointer (x + xx - size / 2, y + yy - size / 2)[c];
 
-                    if (sy >= 0)
-                    {
-                        int sx = x - (size >> 1);
-                        const uint8* src = srcData.getPixelPointer (sx, sy);
-
-                        for (int xx = 0; xx < size; ++xx)
-                        {
-                            if (sx >= srcData.width)
-                                break;
-
-                            if (sx >= 0)
-                            {
-                                const float kernelMult = values [xx + yy * size];
-                                c1 += kernelMult * *src++;
-                            }
-                            else
-                            {
-                                src += 3;
-                            }
-
-                            ++sx;
-                        }
+                        out.getPixelPointer (x, y)[c] = (uint8) jlimit (0, 255, roundToInt (sum));
                     }
                 }
-
-                *dest++ = (uint8) roundToInt (c1);
             }
         }
+
+        // Pixels outside the area are left alone, and the others can only differ by rounding
+        expect (imagesMatch (dest, expected, 1));
+        expect (dest.getPixelAt (0, 0) == expected.getPixelAt (0, 0));
     }
-}
+
+    void benchmark (const String& kernelName, const ImageConvolutionKernel& kernel,
+                    const Image& source, Image& dest, WorkStealingThreadPool* pool)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        kernel.applyToImage (dest, source, dest.getBounds(), pool);
+
+        logMessage (kernelName + ": " + String (Time::getMillisecondCounterHiRes() - start, 1) + " ms for 1024x1024");
+    }
+};
+
+static ImageConvolutionKernelTests imageConvolutionKernelTests;
+
+#endif
 
 } // namespace juce
+
+#undef JUCE_CONVOLUTION_USE_SSE2
+#undef JUCE_CONVOLUTION_USE_NEON
@@ -91,15 +91,23 @@ public:
     //==============================================================================
     /** Applies the kernel to an image.
 
+        Kernels that are the product of a row and a column of weights, like the ones made by
+        createGaussianBlur(), are applied as a horizontal pass followed by a vertical one, and
+        if all the weights in one direction are equal, that pass keeps a running sum, so its
+        cost doesn't grow with the size of the kernel.
+
         @param destImage        the image that will receive the resultant convoluted pixels.
         @param sourceImage      the source image to read from - this can be the same image as
                                 the destination, but if different, it must be exactly the same
                                 size and format.
         @param destinationArea  the region of the image to apply the filter to
+        @param threadPool       if this is supplied, bands of rows are shared out between
+                                its threads
     */
     void applyToImage (Image& destImage,
                        const Image& sourceImage,
-                       const Rectangle<int>& destinationArea) const;
+                       const Rectangle<int>& destinationArea,
+                       WorkStealingThreadPool* threadPool = nullptr) const;
 
 private:
     //==============================================================================
@@ -75,6 +75,47 @@ ImageFileFormat* ImageFileFormat::findImageFormatForFileExtension (const File& f
     return nullptr;
 }
 
+//==============================================================================
+Image ImageFileFormat::decodeScaledImage (InputStream& input, int maxWidth, int maxHeight)
+{
+    auto image = decodeImage (input);
+
+    if (image.isValid())
+    {
+        auto scaledBounds = getScaledImageBounds (image.getBounds(), maxWidth, maxHeight);
+
+        if (scaledBounds != image.getBounds())
+            image = image.rescaled (scaledBounds.getWidth(), scaledBounds.getHeight(), Graphics::highResamplingQuality);
+    }
+
+    return image;
+}
+
+Rectangle<int> ImageFileFormat::readImageBounds (InputStream&)
+{
+    return {};
+}
+
+Rectangle<int> ImageFileFormat::getScaledImageBounds (Rectangle<int> originalBounds, int maxWidth, int maxHeight)
+{
+    if (originalBounds.isEmpty())
+        return {};
+
+    auto scale = 1.0;
+
+    if (maxWidth > 0)
+        scale = jmin (scale, maxWidth / (double) originalBounds.getWidth());
+
+    if (maxHeight > 0)
+        scale = jmin (scale, maxHeight / (double) originalBounds.getHeight());
+
+    if (scale >= 1.0)
+        return originalBounds.withZeroOrigin();
+
+    return { jmax (1, roundToInt (originalBounds.getWidth()  * scale)),
+             jmax (1, roundToInt (originalBounds.getHeight() * scale)) };
+}
+
 //==============================================================================
 Image ImageFileFormat::loadFrom (InputStream& input)
 {
@@ -97,6 +138,21 @@ Image ImageFileFormat::loadFrom (const File& file)
     return Image();
 }
 
+Image ImageFileFormat::loadFrom (const File& file, int maxWidth, int maxHeight)
+{
+    FileInputStream stream (file);
+
+    if (stream.openedOk())
+    {
+        BufferedInputStream b (stream, 8192);
+
+        if (auto* format = findImageFormatForStream (b))
+            return format->decodeScaledImage (b, maxWidth, maxHeight);
+    }
+
+    return Image();
+}
+
 Image ImageFileFormat::loadFrom (const void* rawData, const size_t numBytes)
 {
     if (rawData != nullptr && numBytes > 4)
@@ -108,4 +164,71 @@ Image ImageFileFormat::loadFrom (const void* rawData, const size_t numBytes)
     return Image();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageFileFormatTests  : public UnitTest
+{
+public:
+    ImageFileFormatTests()
+        : UnitTest ("ImageFileFormat", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Scaled bounds keep the aspect ratio");
+        {
+            expect (ImageFileFormat::getScaledImageBounds ({ 400, 200 }, 100, 100) == Rectangle<int> (100, 50));
+            expect (ImageFileFormat::getScaledImageBounds ({ 400, 200 }, 0, 50) == Rectangle<int> (100, 50));
+            expect (ImageFileFormat::getScaledImageBounds ({ 400, 200 }, 1000, 1000) == Rectangle<int> (400, 200));
+            expect (ImageFileFormat::getScaledImageBounds ({ 1000, 1 }, 10, 10) == Rectangle<int> (10, 1));
+            expect (ImageFileFormat::getScaledImageBounds ({}, 10, 10).isEmpty());
+        }
+
+        PNGImageFormat png;
+        JPEGImageFormat jpeg;
+        GIFImageFormat gif;
+
+        beginTest ("Image bounds can be read from the header");
+        {
+            expect (png.readImageBounds (*encode (png, 123, 45)) == Rectangle<int> (123, 45));
+            expect (jpeg.readImageBounds (*encode (jpeg, 123, 45)) == Rectangle<int> (123, 45));
+
+            MemoryInputStream notAnImage ("not an image", 12, false);
+            expect (png.readImageBounds (notAnImage).isEmpty());
+
+            const uint8 gifHeader[] = { 'G', 'I', 'F', '8', '9', 'a', 0x7b, 0x00, 0x2d, 0x00 };
+            MemoryInputStream gifStream (gifHeader, sizeof (gifHeader), false);
+            expect (gif.readImageBounds (gifStream) == Rectangle<int> (123, 45));
+        }
+
+        beginTest ("Scaled decoding fits within the requested size");
+        {
+            for (auto* format : { static_cast<ImageFileFormat*> (&png), static_cast<ImageFileFormat*> (&jpeg) })
+            {
+                auto scaled = format->decodeScaledImage (*encode (*format, 640, 480), 100, 100);
+                expect (scaled.getBounds() == Rectangle<int> (100, 75));
+
+                auto full = format->decodeScaledImage (*encode (*format, 64, 48), 100, 100);
+                expect (full.getBounds() == Rectangle<int> (64, 48));
+            }
+        }
+    }
+
+    static std::unique_ptr<InputStream> encode (ImageFileFormat& format, int w, int h)
+    {
+        Image image (Image::RGB, w, h, true);
+        Graphics (image).fillAll (Colours::orange);
+
+        MemoryOutputStream out;
+        format.writeImageToStream (image, out);
+        return std::make_unique<MemoryInputStream> (out.getMemoryBlock(), true);
+    }
+};
+
+static ImageFileFormatTests imageFileFormatTests;
+
+#endif
+
 } // namespace juce
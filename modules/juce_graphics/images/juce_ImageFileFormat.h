@@ -84,6 +84,28 @@ public:
     */
     virtual Image decodeImage (InputStream& input) = 0;
 
+    /** Tries to decode an image, scaling it down if necessary so that it fits within the
+        given size.
+
+        The image keeps its aspect ratio, and smaller images aren't enlarged. The default
+        implementation decodes the image at full size and then rescales it, but some formats
+        can decode directly at a lower resolution, which is much quicker for thumbnails.
+
+        @returns        the image that was decoded, or an invalid image if it fails.
+        @see getScaledImageBounds
+    */
+    virtual Image decodeScaledImage (InputStream& input, int maxWidth, int maxHeight);
+
+    /** Reads the size of the image from the start of the stream, without decoding it.
+
+        Like canUnderstand(), this will advance the stream.
+
+        @returns        the image's bounds, or an empty rectangle if the size can't be found
+                        without decoding the whole image. The default implementation always
+                        returns an empty rectangle.
+    */
+    virtual Rectangle<int> readImageBounds (InputStream& input);
+
     //==============================================================================
     /** Attempts to write an image to a stream.
 
@@ -137,6 +159,19 @@ public:
     */
     static Image loadFrom (const void* rawData,
                            size_t numBytesOfData);
+
+    /** Tries to load an image from a file, scaling it down if necessary so that it fits within
+        the given size.
+
+        @returns        the image that was decoded, or an invalid image if it fails.
+        @see decodeScaledImage
+    */
+    static Image loadFrom (const File& file, int maxWidth, int maxHeight);
+
+    /** Returns the bounds of an image of the given size after it has been scaled down by
+        decodeScaledImage() to fit within a maximum width and height.
+    */
+    static Rectangle<int> getScaledImageBounds (Rectangle<int> originalBounds, int maxWidth, int maxHeight);
 };
 
 //==============================================================================
@@ -159,6 +194,7 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+    Rectangle<int> readImageBounds (InputStream&) override;
     bool writeImageToStream (const Image&, OutputStream&) override;
 };
 
@@ -191,6 +227,8 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+    Image decodeScaledImage (InputStream&, int maxWidth, int maxHeight) override;
+    Rectangle<int> readImageBounds (InputStream&) override;
     bool writeImageToStream (const Image&, OutputStream&) override;
 
 private:
@@ -217,6 +255,7 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+    Rectangle<int> readImageBounds (InputStream&) override;
     bool writeImageToStream (const Image&, OutputStream&) override;
 };
 
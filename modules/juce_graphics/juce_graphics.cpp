@@ -94,6 +94,13 @@
   #include <ft2build.h>
   #include FT_FREETYPE_H
  #endif
+
+ #if JUCE_USE_FONTCONFIG && (JUCE_LINUX || JUCE_BSD)
+  #include <fontconfig/fontconfig.h>
+ #else
+  #undef JUCE_USE_FONTCONFIG
+  #define JUCE_USE_FONTCONFIG 0
+ #endif
 #endif
 
 #undef SIZEOF
@@ -118,6 +125,9 @@
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_GraphicsDisplayList.cpp"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.cpp"
+#include "native/juce_RenderingHelpers.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
@@ -87,6 +87,16 @@
  #define JUCE_DISABLE_COREGRAPHICS_FONT_SMOOTHING 0
 #endif
 
+/** Config: JUCE_USE_FONTCONFIG
+
+    On Linux, enabling this flag means that fontconfig will be asked for the list of
+    installed fonts instead of JUCE scanning the font directories itself. If you enable
+    this, you'll also need to link against fontconfig.
+*/
+#ifndef JUCE_USE_FONTCONFIG
+ #define JUCE_USE_FONTCONFIG 0
+#endif
+
 #ifndef JUCE_INCLUDE_PNGLIB_CODE
  #define JUCE_INCLUDE_PNGLIB_CODE 1
 #endif
@@ -144,6 +154,8 @@ namespace juce
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_GraphicsDisplayList.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
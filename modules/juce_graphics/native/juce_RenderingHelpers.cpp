@@ -0,0 +1,806 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_LITTLE_ENDIAN
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #include <emmintrin.h>
+  #define JUCE_PIXEL_SPANS_USE_SSE2 1
+
+  #if defined (__AVX2__)
+   #include <immintrin.h>
+   #define JUCE_PIXEL_SPANS_USE_AVX2 1
+  #endif
+ #elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (_M_ARM64))
+  #include <arm_neon.h>
+  #define JUCE_PIXEL_SPANS_USE_NEON 1
+ #endif
+#endif
+
+namespace juce
+{
+
+namespace PixelSpanHelpers
+{
+    /*  Each instruction set provides the same operations on a register of pixels, and on
+        the 16-bit lanes that the pixels are unpacked into. The blending maths below mirrors
+        PixelARGB::blend(): every component becomes src + ((dest * (256 - srcAlpha)) >> 8),
+        saturated to 255, which the lanes can hold without overflowing.
+    */
+   #if JUCE_PIXEL_SPANS_USE_AVX2
+    struct AVX2
+    {
+        using Pixels = __m256i;
+        using Lanes  = __m256i;
+        enum { numPixels = 8 };
+
+        static forcedinline Pixels load (const void* p) noexcept                  { return _mm256_loadu_si256 ((const __m256i*) p); }
+        static forcedinline void store (void* p, Pixels v) noexcept               { _mm256_storeu_si256 ((__m256i*) p, v); }
+        static forcedinline Pixels fill (uint32 v) noexcept                       { return _mm256_set1_epi32 ((int) v); }
+        static forcedinline Pixels select (Pixels mask, Pixels a, Pixels b) noexcept  { return _mm256_blendv_epi8 (b, a, mask); }
+
+        static forcedinline Lanes low (Pixels v) noexcept                         { return _mm256_unpacklo_epi8 (v, _mm256_setzero_si256()); }
+        static forcedinline Lanes high (Pixels v) noexcept                        { return _mm256_unpackhi_epi8 (v, _mm256_setzero_si256()); }
+        static forcedinline Pixels pack (Lanes lo, Lanes hi) noexcept             { return _mm256_packus_epi16 (lo, hi); }
+        static forcedinline Lanes fillLanes (int v) noexcept                      { return _mm256_set1_epi16 ((short) v); }
+        static forcedinline Lanes add (Lanes a, Lanes b) noexcept                 { return _mm256_add_epi16 (a, b); }
+        static forcedinline Lanes sub (Lanes a, Lanes b) noexcept                 { return _mm256_sub_epi16 (a, b); }
+        static forcedinline Lanes mulShift (Lanes a, Lanes b) noexcept            { return _mm256_srli_epi16 (_mm256_mullo_epi16 (a, b), 8); }
+        static forcedinline Lanes alphas (Lanes v) noexcept                       { return _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (v, 0xff), 0xff); }
+    };
+   #endif
+
+   #if JUCE_PIXEL_SPANS_USE_SSE2
+    struct SSE2
+    {
+        using Pixels = __m128i;
+        using Lanes  = __m128i;
+        enum { numPixels = 4 };
+
+        static forcedinline Pixels load (const void* p) noexcept                  { return _mm_loadu_si128 ((const __m128i*) p); }
+        static forcedinline void store (void* p, Pixels v) noexcept               { _mm_storeu_si128 ((__m128i*) p, v); }
+        static forcedinline Pixels fill (uint32 v) noexcept                       { return _mm_set1_epi32 ((int) v); }
+        static forcedinline Pixels select (Pixels mask, Pixels a, Pixels b) noexcept  { return _mm_or_si128 (_mm_and_si128 (mask, a), _mm_andnot_si128 (mask, b)); }
+
+        static forcedinline Lanes low (Pixels v) noexcept                         { return _mm_unpacklo_epi8 (v, _mm_setzero_si128()); }
+        static forcedinline Lanes high (Pixels v) noexcept                        { return _mm_unpackhi_epi8 (v, _mm_setzero_si128()); }
+        static forcedinline Pixels pack (Lanes lo, Lanes hi) noexcept             { return _mm_packus_epi16 (lo, hi); }
+        static forcedinline Lanes fillLanes (int v) noexcept                      { return _mm_set1_epi16 ((short) v); }
+        static forcedinline Lanes add (Lanes a, Lanes b) noexcept                 { return _mm_add_epi16 (a, b); }
+        static forcedinline Lanes sub (Lanes a, Lanes b) noexcept                 { return _mm_sub_epi16 (a, b); }
+        static forcedinline Lanes mulShift (Lanes a, Lanes b) noexcept            { return _mm_srli_epi16 (_mm_mullo_epi16 (a, b), 8); }
+        static forcedinline Lanes alphas (Lanes v) noexcept                       { return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, 0xff), 0xff); }
+    };
+   #endif
+
+   #if JUCE_PIXEL_SPANS_USE_NEON
+    struct NEON
+    {
+        using Pixels = uint8x16_t;
+        using Lanes  = uint16x8_t;
+        enum { numPixels = 4 };
+
+        static forcedinline Pixels load (const void* p) noexcept                  { return vld1q_u8 ((const uint8*) p); }
+        static forcedinline void store (void* p, Pixels v) noexcept               { vst1q_u8 ((uint8*) p, v); }
+        static forcedinline Pixels fill (uint32 v) noexcept                       { return vreinterpretq_u8_u32 (vdupq_n_u32 (v)); }
+        static forcedinline Pixels select (Pixels mask, Pixels a, Pixels b) noexcept  { return vbslq_u8 (mask, a, b); }
+
+        static forcedinline Lanes low (Pixels v) noexcept                         { return vmovl_u8 (vget_low_u8 (v)); }
+        static forcedinline Lanes high (Pixels v) noexcept                        { return vmovl_u8 (vget_high_u8 (v)); }
+        static forcedinline Pixels pack (Lanes lo, Lanes hi) noexcept             { return vcombine_u8 (vqmovn_u16 (lo), vqmovn_u16 (hi)); }
+        static forcedinline Lanes fillLanes (int v) noexcept                      { return vdupq_n_u16 ((uint16) v); }
+        static forcedinline Lanes add (Lanes a, Lanes b) noexcept                 { return vaddq_u16 (a, b); }
+        static forcedinline Lanes sub (Lanes a, Lanes b) noexcept                 { return vsubq_u16 (a, b); }
+        static forcedinline Lanes mulShift (Lanes a, Lanes b) noexcept            { return vshrq_n_u16 (vmulq_u16 (a, b), 8); }
+
+        static forcedinline Lanes alphas (Lanes v) noexcept
+        {
+            // each pixel occupies 64 bits, with its alpha in the top lane
+            auto a = vshrq_n_u64 (vreinterpretq_u64_u16 (v), 48);
+            a = vorrq_u64 (a, vshlq_n_u64 (a, 16));
+            return vreinterpretq_u16_u64 (vorrq_u64 (a, vshlq_n_u64 (a, 32)));
+        }
+    };
+   #endif
+
+    //==============================================================================
+    template <class Ops>
+    struct Blender
+    {
+        using Pixels = typename Ops::Pixels;
+        using Lanes  = typename Ops::Lanes;
+
+        static forcedinline Lanes blend (Lanes src, Lanes dest) noexcept
+        {
+            return Ops::add (src, Ops::mulShift (dest, Ops::sub (Ops::fillLanes (256), Ops::alphas (src))));
+        }
+
+        template <class BlendFunction>
+        static void process (void* destPixels, const PixelARGB* srcPixels, int numPixels,
+                             bool preserveTopByte, BlendFunction&& blendPixels) noexcept
+        {
+            auto* dest = static_cast<uint8*> (destPixels);
+            auto* src = reinterpret_cast<const uint8*> (srcPixels);
+            const auto mask = Ops::fill (preserveTopByte ? 0x00ffffffu : 0xffffffffu);
+            constexpr int vectorBytes = Ops::numPixels * 4;
+
+            auto processVector = [&] (uint8* d, const uint8* s)
+            {
+                const auto existing = Ops::load (d);
+                Ops::store (d, Ops::select (mask, blendPixels (existing, s), existing));
+            };
+
+            for (; numPixels >= Ops::numPixels; numPixels -= Ops::numPixels)
+            {
+                processVector (dest, src);
+                dest += vectorBytes;
+
+                if (src != nullptr)
+                    src += vectorBytes;
+            }
+
+            if (numPixels > 0)
+            {
+                uint32 destTail[Ops::numPixels] = {}, srcTail[Ops::numPixels] = {};
+                const auto tailBytes = (size_t) numPixels * 4;
+
+                memcpy (destTail, dest, tailBytes);
+
+                if (src != nullptr)
+                    memcpy (srcTail, src, tailBytes);
+
+                processVector (reinterpret_cast<uint8*> (destTail), reinterpret_cast<const uint8*> (srcTail));
+                memcpy (dest, destTail, tailBytes);
+            }
+        }
+
+        static void blendColour (void* dest, PixelARGB colour, int numPixels, bool preserveTopByte) noexcept
+        {
+            const auto src = Ops::low (Ops::fill (colour.getNativeARGB()));
+            const auto inverseAlpha = Ops::fillLanes (256 - colour.getAlpha());
+
+            process (dest, nullptr, numPixels, preserveTopByte, [&] (Pixels d, const uint8*)
+            {
+                return Ops::pack (Ops::add (src, Ops::mulShift (Ops::low (d),  inverseAlpha)),
+                                  Ops::add (src, Ops::mulShift (Ops::high (d), inverseAlpha)));
+            });
+        }
+
+        static void blendPixels (void* dest, const PixelARGB* src, int numPixels, bool preserveTopByte) noexcept
+        {
+            process (dest, src, numPixels, preserveTopByte, [] (Pixels d, const uint8* s)
+            {
+                const auto source = Ops::load (s);
+                return Ops::pack (blend (Ops::low (source),  Ops::low (d)),
+                                  blend (Ops::high (source), Ops::high (d)));
+            });
+        }
+
+        static void blendPixels (void* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha, bool preserveTopByte) noexcept
+        {
+            const auto extra = Ops::fillLanes ((int) extraAlpha);
+
+            process (dest, src, numPixels, preserveTopByte, [&] (Pixels d, const uint8* s)
+            {
+                const auto source = Ops::load (s);
+                return Ops::pack (blend (Ops::mulShift (Ops::low (source),  extra), Ops::low (d)),
+                                  blend (Ops::mulShift (Ops::high (source), extra), Ops::high (d)));
+            });
+        }
+    };
+
+   #if JUCE_PIXEL_SPANS_USE_AVX2
+    using NativeBlender = Blender<AVX2>;
+   #elif JUCE_PIXEL_SPANS_USE_SSE2
+    using NativeBlender = Blender<SSE2>;
+   #elif JUCE_PIXEL_SPANS_USE_NEON
+    using NativeBlender = Blender<NEON>;
+   #else
+    // A plain version for other targets, which just calls the pixel methods
+    struct NativeBlender
+    {
+        template <class BlendFunction>
+        static void process (void* dest, int numPixels, bool preserveTopByte, BlendFunction&& blendPixel) noexcept
+        {
+            auto* d = static_cast<PixelARGB*> (dest);
+
+            for (int i = 0; i < numPixels; ++i)
+            {
+                const auto topByte = d[i].getAlpha();
+                blendPixel (d[i], i);
+
+                if (preserveTopByte)
+                    d[i].setAlpha (topByte);
+            }
+        }
+
+        static void blendColour (void* dest, PixelARGB colour, int numPixels, bool preserveTopByte) noexcept
+        {
+            process (dest, numPixels, preserveTopByte, [&] (PixelARGB& d, int) { d.blend (colour); });
+        }
+
+        static void blendPixels (void* dest, const PixelARGB* src, int numPixels, bool preserveTopByte) noexcept
+        {
+            process (dest, numPixels, preserveTopByte, [&] (PixelARGB& d, int i) { d.blend (src[i]); });
+        }
+
+        static void blendPixels (void* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha, bool preserveTopByte) noexcept
+        {
+            process (dest, numPixels, preserveTopByte, [&] (PixelARGB& d, int i) { d.blend (src[i], extraAlpha); });
+        }
+    };
+   #endif
+
+    //==============================================================================
+    /*  The radial gradient loops work on registers of doubles, so that they round in exactly
+        the same way as the scalar GradientPixelIterators.
+    */
+   #if JUCE_PIXEL_SPANS_USE_AVX2
+    struct AVXDoubles
+    {
+        using Doubles = __m256d;
+        enum { numLanes = 4 };
+
+        static forcedinline Doubles fill (double v) noexcept                      { return _mm256_set1_pd (v); }
+        static forcedinline Doubles ramp (double v) noexcept                      { return _mm256_set_pd (v + 3.0, v + 2.0, v + 1.0, v); }
+        static forcedinline Doubles add (Doubles a, Doubles b) noexcept           { return _mm256_add_pd (a, b); }
+        static forcedinline Doubles mul (Doubles a, Doubles b) noexcept           { return _mm256_mul_pd (a, b); }
+        static forcedinline Doubles min (Doubles a, Doubles b) noexcept           { return _mm256_min_pd (a, b); }
+        static forcedinline Doubles sqrt (Doubles v) noexcept                     { return _mm256_sqrt_pd (v); }
+        static forcedinline void storeRounded (int* dest, Doubles v) noexcept     { _mm_storeu_si128 ((__m128i*) dest, _mm256_cvtpd_epi32 (v)); }
+    };
+   #endif
+
+   #if JUCE_PIXEL_SPANS_USE_SSE2
+    struct SSE2Doubles
+    {
+        using Doubles = __m128d;
+        enum { numLanes = 2 };
+
+        static forcedinline Doubles fill (double v) noexcept                      { return _mm_set1_pd (v); }
+        static forcedinline Doubles ramp (double v) noexcept                      { return _mm_set_pd (v + 1.0, v); }
+        static forcedinline Doubles add (Doubles a, Doubles b) noexcept           { return _mm_add_pd (a, b); }
+        static forcedinline Doubles mul (Doubles a, Doubles b) noexcept           { return _mm_mul_pd (a, b); }
+        static forcedinline Doubles min (Doubles a, Doubles b) noexcept           { return _mm_min_pd (a, b); }
+        static forcedinline Doubles sqrt (Doubles v) noexcept                     { return _mm_sqrt_pd (v); }
+        static forcedinline void storeRounded (int* dest, Doubles v) noexcept     { _mm_storel_epi64 ((__m128i*) dest, _mm_cvtpd_epi32 (v)); }
+    };
+   #endif
+
+   #if JUCE_PIXEL_SPANS_USE_NEON && JUCE_64BIT
+    struct NEONDoubles
+    {
+        using Doubles = float64x2_t;
+        enum { numLanes = 2 };
+
+        static forcedinline Doubles fill (double v) noexcept                      { return vdupq_n_f64 (v); }
+        static forcedinline Doubles ramp (double v) noexcept                      { return vsetq_lane_f64 (v + 1.0, vdupq_n_f64 (v), 1); }
+        static forcedinline Doubles add (Doubles a, Doubles b) noexcept           { return vaddq_f64 (a, b); }
+        static forcedinline Doubles mul (Doubles a, Doubles b) noexcept           { return vmulq_f64 (a, b); }
+        static forcedinline Doubles min (Doubles a, Doubles b) noexcept           { return vminnmq_f64 (a, b); }
+        static forcedinline Doubles sqrt (Doubles v) noexcept                     { return vsqrtq_f64 (v); }
+        static forcedinline void storeRounded (int* dest, Doubles v) noexcept     { vst1_s32 (dest, vmovn_s64 (vcvtnq_s64_f64 (v))); }
+    };
+   #endif
+
+    struct GradientLookup
+    {
+        static void linear (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex,
+                            int start, int step, int shift, int numPixels) noexcept
+        {
+            // The arithmetic is done on unsigned values so that it wraps in the same way as the
+            // scalar iterator, without any undefined behaviour
+            auto value = (uint32) start;
+
+           #if JUCE_PIXEL_SPANS_USE_SSE2
+            auto values = _mm_set_epi32 ((int) (value + 3 * (uint32) step), (int) (value + 2 * (uint32) step),
+                                         (int) (value + (uint32) step), (int) value);
+            const auto increment = _mm_set1_epi32 ((int) (4 * (uint32) step));
+            const auto shiftCount = _mm_cvtsi32_si128 (shift);
+            const auto minusOne = _mm_set1_epi32 (-1), maxIndices = _mm_set1_epi32 (maxIndex);
+
+            for (; numPixels >= 4; numPixels -= 4)
+            {
+                auto indices = _mm_sra_epi32 (values, shiftCount);
+                indices = _mm_and_si128 (indices, _mm_cmpgt_epi32 (indices, minusOne));
+
+                const auto tooHigh = _mm_cmpgt_epi32 (indices, maxIndices);
+                indices = _mm_or_si128 (_mm_and_si128 (tooHigh, maxIndices), _mm_andnot_si128 (tooHigh, indices));
+
+                dest[0] = lookupTable[_mm_cvtsi128_si32 (indices)];
+                dest[1] = lookupTable[_mm_cvtsi128_si32 (_mm_srli_si128 (indices, 4))];
+                dest[2] = lookupTable[_mm_cvtsi128_si32 (_mm_srli_si128 (indices, 8))];
+                dest[3] = lookupTable[_mm_cvtsi128_si32 (_mm_srli_si128 (indices, 12))];
+
+                dest += 4;
+                value += 4 * (uint32) step;
+                values = _mm_add_epi32 (values, increment);
+            }
+           #endif
+
+            for (int i = 0; i < numPixels; ++i)
+            {
+                dest[i] = lookupTable[jlimit (0, maxIndex, ((int) value) >> shift)];
+                value += (uint32) step;
+            }
+        }
+
+        template <class Ops>
+        static void radial (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex, int firstX,
+                            double m00, double c0, double m10, double c1,
+                            double invScale, int numPixels) noexcept
+        {
+            const auto vm00 = Ops::fill (m00), vc0 = Ops::fill (c0);
+            const auto vm10 = Ops::fill (m10), vc1 = Ops::fill (c1);
+            const auto vScale = Ops::fill (invScale), vMax = Ops::fill ((double) maxIndex);
+            const auto vStep = Ops::fill ((double) Ops::numLanes);
+            auto xs = Ops::ramp ((double) firstX);
+            int indices[Ops::numLanes];
+
+            for (; numPixels >= Ops::numLanes; numPixels -= Ops::numLanes, firstX += Ops::numLanes)
+            {
+                const auto y = Ops::add (Ops::mul (vm10, xs), vc1);
+                const auto x = Ops::add (Ops::mul (vm00, xs), vc0);
+                const auto distSquared = Ops::add (Ops::mul (x, x), Ops::mul (y, y));
+
+                // Clamping before the conversion keeps far-away pixels within the range of an int.
+                // If the value is NaN, min() returns its second argument, as jmin() does.
+                Ops::storeRounded (indices, Ops::min (Ops::mul (Ops::sqrt (distSquared), vScale), vMax));
+
+                for (auto index : indices)
+                    *dest++ = lookupTable[index];
+
+                xs = Ops::add (xs, vStep);
+            }
+
+            radialScalar (dest, lookupTable, maxIndex, firstX, m00, c0, m10, c1, invScale, numPixels);
+        }
+
+        static void radialScalar (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex, int firstX,
+                                  double m00, double c0, double m10, double c1,
+                                  double invScale, int numPixels) noexcept
+        {
+            for (int i = 0; i < numPixels; ++i)
+            {
+                const auto px = (double) (firstX + i);
+                const auto y = m10 * px + c1;
+                const auto x = m00 * px + c0;
+
+                dest[i] = lookupTable[roundToInt (jmin ((double) maxIndex, std::sqrt (x * x + y * y) * invScale))];
+            }
+        }
+    };
+}
+
+//==============================================================================
+class GradientLookupTableCache final : public DeletedAtShutdown
+{
+public:
+    GradientLookupTableCache() = default;
+
+    ~GradientLookupTableCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    using Table = RenderingHelpers::GradientLookupTables::Table;
+
+    std::shared_ptr<const Table> get (const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        Key key { gradient.getLookupTableSize (transform), {} };
+
+        for (int i = 0; i < gradient.getNumColours(); ++i)
+            key.second.emplace_back (gradient.getColourPosition (i), gradient.getColour (i).getARGB());
+
+        {
+            const ScopedTryLock stl (lock);
+
+            if (stl.isLocked())
+            {
+                const auto iter = cache.find (key);
+
+                if (iter != cache.end())
+                {
+                    if (iter->second.cachePosition != cacheOrder.begin())
+                        cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second.cachePosition);
+
+                    return iter->second.table;
+                }
+            }
+        }
+
+        auto table = std::make_shared<Table>();
+        table->numEntries = key.first;
+        table->colours.malloc (table->numEntries);
+        gradient.createLookupTable (table->colours, table->numEntries);
+
+        const ScopedTryLock stl (lock);
+
+        if (stl.isLocked())
+        {
+            const auto [iter, inserted] = cache.emplace (std::move (key), CachedTable { table, {} });
+
+            if (inserted)
+            {
+                cacheOrder.push_front (iter);
+                iter->second.cachePosition = cacheOrder.begin();
+
+                while (cache.size() > cacheSize)
+                {
+                    cache.erase (cacheOrder.back());
+                    cacheOrder.pop_back();
+                }
+            }
+        }
+
+        return table;
+    }
+
+    JUCE_DECLARE_SINGLETON (GradientLookupTableCache, false)
+
+private:
+    // The table's size, and the position and colour of each stop
+    using Key = std::pair<int, std::vector<std::pair<double, uint32>>>;
+
+    struct CachedTable
+    {
+        std::shared_ptr<const Table> table;
+        std::list<std::map<Key, CachedTable>::iterator>::iterator cachePosition;
+    };
+
+    static constexpr size_t cacheSize = 32;
+    std::map<Key, CachedTable> cache;
+    std::list<std::map<Key, CachedTable>::iterator> cacheOrder;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (GradientLookupTableCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (GradientLookupTableCache)
+
+//==============================================================================
+std::shared_ptr<const RenderingHelpers::GradientLookupTables::Table> JUCE_CALLTYPE
+    RenderingHelpers::GradientLookupTables::get (const ColourGradient& gradient, const AffineTransform& transform)
+{
+    return GradientLookupTableCache::getInstance()->get (gradient, transform);
+}
+
+void JUCE_CALLTYPE RenderingHelpers::GradientSpans::lookupLinear (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex,
+                                                                  int start, int step, int shift, int numPixels) noexcept
+{
+    PixelSpanHelpers::GradientLookup::linear (dest, lookupTable, maxIndex, start, step, shift, numPixels);
+}
+
+void JUCE_CALLTYPE RenderingHelpers::GradientSpans::lookupRadial (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex, int firstX,
+                                                                  double m00, double c0, double m10, double c1,
+                                                                  double invScale, int numPixels) noexcept
+{
+   #if JUCE_PIXEL_SPANS_USE_AVX2
+    using Ops = PixelSpanHelpers::AVXDoubles;
+   #elif JUCE_PIXEL_SPANS_USE_SSE2
+    using Ops = PixelSpanHelpers::SSE2Doubles;
+   #elif JUCE_PIXEL_SPANS_USE_NEON && JUCE_64BIT
+    using Ops = PixelSpanHelpers::NEONDoubles;
+   #endif
+
+   #if JUCE_PIXEL_SPANS_USE_SSE2 || (JUCE_PIXEL_SPANS_USE_NEON && JUCE_64BIT)
+    PixelSpanHelpers::GradientLookup::radial<Ops> (dest, lookupTable, maxIndex, firstX, m00, c0, m10, c1, invScale, numPixels);
+   #else
+    PixelSpanHelpers::GradientLookup::radialScalar (dest, lookupTable, maxIndex, firstX, m00, c0, m10, c1, invScale, numPixels);
+   #endif
+}
+
+//==============================================================================
+void JUCE_CALLTYPE RenderingHelpers::PixelSpans::blendColour (void* dest, PixelARGB colour, int numPixels, bool preserveTopByte) noexcept
+{
+    PixelSpanHelpers::NativeBlender::blendColour (dest, colour, numPixels, preserveTopByte);
+}
+
+void JUCE_CALLTYPE RenderingHelpers::PixelSpans::blendPixels (void* dest, const PixelARGB* src, int numPixels, bool preserveTopByte) noexcept
+{
+    PixelSpanHelpers::NativeBlender::blendPixels (dest, src, numPixels, preserveTopByte);
+}
+
+void JUCE_CALLTYPE RenderingHelpers::PixelSpans::blendPixels (void* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha, bool preserveTopByte) noexcept
+{
+    PixelSpanHelpers::NativeBlender::blendPixels (dest, src, numPixels, extraAlpha, preserveTopByte);
+}
+
+#undef JUCE_PIXEL_SPANS_USE_SSE2
+#undef JUCE_PIXEL_SPANS_USE_AVX2
+#undef JUCE_PIXEL_SPANS_USE_NEON
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PixelSpansTests  : public UnitTest
+{
+public:
+    PixelSpansTests()
+        : UnitTest ("PixelSpans", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Blending a colour matches PixelARGB::blend");
+        {
+            for (int numPixels = 0; numPixels < 40; ++numPixels)
+            {
+                const auto colour = randomPixel (random);
+
+                checkSpan (random, numPixels, [&] (void* dest, const PixelARGB*, bool preserveTopByte)
+                           {
+                               RenderingHelpers::PixelSpans::blendColour (dest, colour, numPixels, preserveTopByte);
+                           },
+                           [&] (PixelARGB& d, PixelARGB)  { d.blend (colour); });
+            }
+        }
+
+        beginTest ("Blending pixels matches PixelARGB::blend");
+        {
+            for (int numPixels = 0; numPixels < 40; ++numPixels)
+            {
+                checkSpan (random, numPixels, [&] (void* dest, const PixelARGB* src, bool preserveTopByte)
+                           {
+                               RenderingHelpers::PixelSpans::blendPixels (dest, src, numPixels, preserveTopByte);
+                           },
+                           [&] (PixelARGB& d, PixelARGB s)  { d.blend (s); });
+            }
+        }
+
+        beginTest ("Blending pixels with an extra alpha matches PixelARGB::blend");
+        {
+            for (const uint32 extraAlpha : { 0u, 1u, 127u, 200u, 254u, 255u, 256u })
+            {
+                for (int numPixels = 0; numPixels < 40; ++numPixels)
+                {
+                    checkSpan (random, numPixels, [&] (void* dest, const PixelARGB* src, bool preserveTopByte)
+                               {
+                                   RenderingHelpers::PixelSpans::blendPixels (dest, src, numPixels, extraAlpha, preserveTopByte);
+                               },
+                               [&] (PixelARGB& d, PixelARGB s)  { d.blend (s, extraAlpha); });
+                }
+            }
+        }
+
+        beginTest ("Solid fills give the same results as blending each pixel");
+        {
+            for (const auto format : { Image::ARGB, Image::RGB })
+            {
+                Image image (format, 37, 5, true, SoftwareImageType());
+
+                {
+                    Graphics g (image);
+                    g.fillAll (Colours::darkgrey);
+                    g.setColour (Colours::orange.withAlpha (0.4f));
+                    g.fillRect (3, 1, 30, 3);
+                }
+
+                auto expected = Colours::darkgrey.getPixelARGB();
+                expected.blend (Colours::orange.withAlpha (0.4f).getPixelARGB());
+
+                for (int x = 3; x < 33; ++x)
+                    expect (image.getPixelAt (x, 2) == Colour (expected.getUnpremultiplied()));
+            }
+        }
+    }
+
+private:
+    static PixelARGB randomPixel (Random& random)
+    {
+        const auto alpha = (uint8) random.nextInt (256);
+
+        // colours have premultiplied alpha, so no component can exceed the alpha
+        return PixelARGB (alpha,
+                          (uint8) random.nextInt (alpha + 1),
+                          (uint8) random.nextInt (alpha + 1),
+                          (uint8) random.nextInt (alpha + 1));
+    }
+
+    template <class SpanFunction, class PixelFunction>
+    void checkSpan (Random& random, int numPixels, SpanFunction&& spanFunction, PixelFunction&& pixelFunction)
+    {
+        for (const auto preserveTopByte : { false, true })
+        {
+            std::vector<PixelARGB> src, dest, expected;
+
+            for (int i = 0; i < numPixels + 1; ++i)
+            {
+                src.push_back (randomPixel (random));
+                dest.push_back (randomPixel (random));
+            }
+
+            expected = dest;
+
+            for (int i = 0; i < numPixels; ++i)
+            {
+                const auto topByte = expected[(size_t) i].getAlpha();
+                pixelFunction (expected[(size_t) i], src[(size_t) i]);
+
+                if (preserveTopByte)
+                    expected[(size_t) i].setAlpha (topByte);
+            }
+
+            spanFunction (dest.data(), src.data(), preserveTopByte);
+
+            for (size_t i = 0; i < dest.size(); ++i)
+                expectEquals ((int64) dest[i].getNativeARGB(), (int64) expected[i].getNativeARGB());
+        }
+    }
+};
+
+static PixelSpansTests pixelSpansTests;
+
+//==============================================================================
+class GradientFillTests  : public UnitTest
+{
+public:
+    GradientFillTests()
+        : UnitTest ("Gradient fills", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Linear gradient spans match the per-pixel iterator");
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto gradient = randomGradient (random, false);
+                const auto transform = i % 2 == 0 ? AffineTransform() : randomTransform (random);
+                checkIterator<RenderingHelpers::GradientPixelIterators::Linear> (random, gradient, transform);
+            }
+        }
+
+        beginTest ("Radial gradient spans match the per-pixel iterator");
+        {
+            for (int i = 0; i < 50; ++i)
+                checkIterator<RenderingHelpers::GradientPixelIterators::Radial> (random, randomGradient (random, true), {});
+        }
+
+        beginTest ("Transformed radial gradient spans match the per-pixel iterator");
+        {
+            for (int i = 0; i < 50; ++i)
+                checkIterator<RenderingHelpers::GradientPixelIterators::TransformedRadial> (random, randomGradient (random, true), randomTransform (random));
+        }
+
+        beginTest ("Lookup tables are shared between fills with the same gradient");
+        {
+            ColourGradient gradient (Colours::red, 0.0f, 0.0f, Colours::blue.withAlpha (0.5f), 50.0f, 0.0f, false);
+            gradient.addColour (0.3, Colours::yellow);
+            const auto table = RenderingHelpers::GradientLookupTables::get (gradient, {});
+
+            HeapBlock<PixelARGB> expected;
+            const auto numEntries = gradient.createLookupTable ({}, expected);
+
+            expectEquals (table->numEntries, numEntries);
+            expect (std::equal (expected.get(), expected.get() + numEntries, table->colours.get(),
+                                [] (PixelARGB a, PixelARGB b) { return a.getNativeARGB() == b.getNativeARGB(); }));
+
+            // Moving the gradient doesn't change its table
+            auto moved = gradient;
+            moved.point1 += Point<float> (10.0f, 20.0f);
+            moved.point2 += Point<float> (10.0f, 20.0f);
+            expect (RenderingHelpers::GradientLookupTables::get (moved, {}) == table);
+
+            auto recoloured = gradient;
+            recoloured.setColour (0, gradient.getColour (0).contrasting());
+            expect (RenderingHelpers::GradientLookupTables::get (recoloured, {}) != table);
+            expect (RenderingHelpers::GradientLookupTables::get (gradient, AffineTransform::scale (2.0f)) != table);
+        }
+
+        beginTest ("Benchmarks");
+        {
+            Image image (Image::ARGB, 512, 512, true, SoftwareImageType());
+
+            ColourGradient linear (Colours::red, 0.0f, 0.0f, Colours::blue, 512.0f, 300.0f, false);
+            linear.addColour (0.5, Colours::green.withAlpha (0.5f));
+
+            ColourGradient radial (Colours::white, 256.0f, 256.0f, Colours::black.withAlpha (0.2f), 0.0f, 100.0f, true);
+
+            benchmark (image, "Linear", linear, {});
+            benchmark (image, "Radial", radial, {});
+            benchmark (image, "Transformed radial", radial, AffineTransform::scale (1.0f, 0.5f, 256.0f, 256.0f).rotated (0.3f, 256.0f, 256.0f));
+        }
+    }
+
+private:
+    static ColourGradient randomGradient (Random& random, bool isRadial)
+    {
+        auto randomPoint = [&] { return Point<float> (random.nextFloat() * 400.0f - 100.0f, random.nextFloat() * 400.0f - 100.0f); };
+
+        ColourGradient gradient (Colour (random.nextInt()), randomPoint(),
+                                 Colour (random.nextInt()), randomPoint(), isRadial);
+
+        gradient.addColour (random.nextDouble(), Colour (random.nextInt()));
+        return gradient;
+    }
+
+    static AffineTransform randomTransform (Random& random)
+    {
+        return AffineTransform::rotation (random.nextFloat() * 6.0f)
+                               .scaled (0.5f + random.nextFloat(), 0.5f + random.nextFloat())
+                               .sheared (random.nextFloat() * 0.5f, 0.0f)
+                               .translated (random.nextFloat() * 50.0f, random.nextFloat() * 50.0f);
+    }
+
+    template <class Iterator>
+    void checkIterator (Random& random, const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        // Each entry holds its own index, so that the pixels show which entries were used
+        const auto numEntries = gradient.getLookupTableSize (transform);
+        std::vector<PixelARGB> table;
+
+        for (int i = 0; i < numEntries; ++i)
+            table.emplace_back ((uint8) (i >> 24), (uint8) (i >> 16), (uint8) (i >> 8), (uint8) i);
+
+        Iterator iterator (gradient, transform, table.data(), numEntries - 1);
+
+        for (int y = -20; y < 300; y += 7)
+        {
+            iterator.setY (y);
+
+            const auto x = random.nextInt (400) - 100;
+            const auto numPixels = random.nextInt (100);
+            std::vector<PixelARGB> pixels ((size_t) numPixels);
+
+            iterator.getPixels (x, pixels.data(), numPixels);
+
+            for (int i = 0; i < numPixels; ++i)
+            {
+                // The rounding can differ by one entry if the compiler fuses the scalar arithmetic
+                const auto expected = (int) iterator.getPixel (x + i).getNativeARGB();
+                const auto actual = (int) pixels[(size_t) i].getNativeARGB();
+                expect (std::abs (expected - actual) <= 1);
+            }
+        }
+    }
+
+    void benchmark (Image& image, const String& fillName, const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        constexpr int numFills = 100;
+        auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numFills; ++i)
+        {
+            Graphics g (image);
+            g.setGradientFill (gradient);
+            g.addTransform (transform);
+            g.fillRect (image.getBounds().toFloat().reduced (0.5f));
+        }
+
+        logMessage (fillName + ": " + String ((Time::getMillisecondCounterHiRes() - start) / numFills, 3) + " ms per 512x512 fill");
+    }
+};
+
+static GradientFillTests gradientFillTests;
+
+#endif
+
+} // namespace juce
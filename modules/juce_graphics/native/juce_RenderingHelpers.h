@@ -398,6 +398,42 @@ struct FloatRectangleRasterisingInfo
     int topAlpha, leftAlpha, bottomAlpha, rightAlpha; // alpha of each anti-aliased edge
 };
 
+//==============================================================================
+/** Keeps the lookup tables of recently used gradients, so that filling with the same
+    gradient again doesn't need to rebuild its table.
+*/
+namespace GradientLookupTables
+{
+    struct Table
+    {
+        HeapBlock<PixelARGB> colours;
+        int numEntries = 0;
+    };
+
+    /** Returns the table that ColourGradient::createLookupTable() would create for this
+        gradient and transform.
+    */
+    JUCE_API std::shared_ptr<const Table> JUCE_CALLTYPE get (const ColourGradient& gradient, const AffineTransform& transform);
+}
+
+//==============================================================================
+/** Contains vectorised loops that look up runs of gradient colours. They give the same
+    results as calling the getPixel() methods of the GradientPixelIterators for each pixel.
+*/
+namespace GradientSpans
+{
+    /** Sets each pixel i to lookupTable[jlimit (0, maxIndex, (start + i * step) >> shift)]. */
+    JUCE_API void JUCE_CALLTYPE lookupLinear (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex,
+                                              int start, int step, int shift, int numPixels) noexcept;
+
+    /** For each pixel x, starting at firstX, this finds the distance from the origin of the point
+        (m00 * x + c0, m10 * x + c1), and uses lookupTable[jmin (maxIndex, roundToInt (distance * invScale))].
+    */
+    JUCE_API void JUCE_CALLTYPE lookupRadial (PixelARGB* dest, const PixelARGB* lookupTable, int maxIndex, int firstX,
+                                              double m00, double c0, double m10, double c1,
+                                              double invScale, int numPixels) noexcept;
+}
+
 //==============================================================================
 /** Contains classes for calculating the colour of pixels within various types of gradient. */
 namespace GradientPixelIterators
@@ -461,6 +497,14 @@ namespace GradientPixelIterators
                             : lookupTable[jlimit (0, numEntries, (x * scale - start) >> (int) numScaleBits)];
         }
 
+        void getPixels (int x, PixelARGB* dest, int numPixels) const noexcept
+        {
+            if (vertical)
+                std::fill (dest, dest + numPixels, linePix);
+            else
+                GradientSpans::lookupLinear (dest, lookupTable, numEntries, x * scale - start, scale, (int) numScaleBits, numPixels);
+        }
+
         const PixelARGB* const lookupTable;
         const int numEntries;
         PixelARGB linePix;
@@ -492,8 +536,8 @@ namespace GradientPixelIterators
 
         forcedinline void setY (int y) noexcept
         {
-            dy = y - gy1;
-            dy *= dy;
+            lineY = y - gy1;
+            dy = lineY * lineY;
         }
 
         inline PixelARGB getPixel (int px) const noexcept
@@ -505,10 +549,15 @@ namespace GradientPixelIterators
             return lookupTable[x >= maxDist ? numEntries : roundToInt (std::sqrt (x) * invScale)];
         }
 
+        void getPixels (int x, PixelARGB* dest, int numPixels) const noexcept
+        {
+            GradientSpans::lookupRadial (dest, lookupTable, numEntries, x, 1.0, -gx1, 0.0, lineY, invScale, numPixels);
+        }
+
         const PixelARGB* const lookupTable;
         const int numEntries;
         const double gx1, gy1;
-        double maxDist, invScale, dy;
+        double maxDist, invScale, dy, lineY;
 
         JUCE_DECLARE_NON_COPYABLE (Radial)
     };
@@ -547,6 +596,11 @@ namespace GradientPixelIterators
             return lookupTable[jmin (numEntries, roundToInt (std::sqrt (x) * invScale))];
         }
 
+        void getPixels (int x, PixelARGB* dest, int numPixels) const noexcept
+        {
+            GradientSpans::lookupRadial (dest, lookupTable, numEntries, x, tM00, lineYM01, tM10, lineYM11, invScale, numPixels);
+        }
+
     private:
         double tM10, tM00, lineYM01, lineYM11;
         const AffineTransform inverseTransform;
@@ -555,6 +609,45 @@ namespace GradientPixelIterators
     };
 }
 
+//==============================================================================
+/** Contains vectorised versions of the blending operations used by the EdgeTableFillers.
+
+    These work on runs of pixels that are stored four bytes apart, and give exactly the
+    same results as calling PixelARGB::blend() or PixelRGB::blend() on each pixel in turn.
+    When preserveTopByte is true the unused fourth byte of each destination pixel is left
+    alone, so that PixelRGB data with a four-byte stride can be blended too.
+*/
+namespace PixelSpans
+{
+    /** Blends a premultiplied colour onto each pixel in the run. */
+    JUCE_API void JUCE_CALLTYPE blendColour (void* dest, PixelARGB colour, int numPixels, bool preserveTopByte) noexcept;
+
+    /** Blends a run of premultiplied source pixels onto the destination. */
+    JUCE_API void JUCE_CALLTYPE blendPixels (void* dest, const PixelARGB* src, int numPixels, bool preserveTopByte) noexcept;
+
+    /** Blends a run of premultiplied source pixels onto the destination, scaling their
+        opacity by extraAlpha (0 to 256) in the same way as PixelARGB::blend (src, extraAlpha).
+    */
+    JUCE_API void JUCE_CALLTYPE blendPixels (void* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha, bool preserveTopByte) noexcept;
+
+    /** Returns true if pixels of this type and layout can be passed to the functions above. */
+    template <class PixelType>
+    bool canBlend (const Image::BitmapData& data) noexcept
+    {
+       #if JUCE_LITTLE_ENDIAN
+        return (std::is_same_v<PixelType, PixelARGB> || std::is_same_v<PixelType, PixelRGB>)
+                 && data.pixelStride == 4;
+       #else
+        ignoreUnused (data);
+        return false;
+       #endif
+    }
+
+    /** Returns true if the fourth byte of each pixel of this type is unused. */
+    template <class PixelType>
+    constexpr bool hasUnusedTopByte() noexcept      { return std::is_same_v<PixelType, PixelRGB>; }
+}
+
 #define JUCE_PERFORM_PIXEL_OP_LOOP(op) \
 { \
     const int destStride = destData.pixelStride;  \
@@ -667,7 +760,10 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            if (PixelSpans::canBlend<PixelType> (destData))
+                PixelSpans::blendColour (dest, colour, width, PixelSpans::hasUnusedTopByte<PixelType>());
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
@@ -726,7 +822,9 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
-            if (alphaLevel < 0xff)
+            if (PixelSpans::canBlend<PixelType> (destData))
+                blendSpan (dest, x, width, (uint32) alphaLevel);
+            else if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
@@ -735,7 +833,11 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+
+            if (PixelSpans::canBlend<PixelType> (destData))
+                blendSpan (dest, x, width, 0xff);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -765,6 +867,28 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        void blendSpan (PixelType* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            constexpr int chunkSize = 64;
+            PixelARGB colours[chunkSize];
+
+            while (width > 0)
+            {
+                const auto num = jmin (width, chunkSize);
+
+                GradientType::getPixels (x, colours, num);
+                x += num;
+
+                if (alphaLevel < 0xff)
+                    PixelSpans::blendPixels (dest, colours, num, alphaLevel, PixelSpans::hasUnusedTopByte<PixelType>());
+                else
+                    PixelSpans::blendPixels (dest, colours, num, PixelSpans::hasUnusedTopByte<PixelType>());
+
+                dest = addBytesToPointer (dest, num * destData.pixelStride);
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -826,9 +950,17 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                {
+                    if (canBlendSpans())
+                        PixelSpans::blendPixels (dest, (const PixelARGB*) getSrcPixel (x), width, (uint32) alphaLevel,
+                                                 PixelSpans::hasUnusedTopByte<DestPixelType>());
+                    else
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                }
                 else
+                {
                     copyRow (dest, getSrcPixel (x), width);
+                }
             }
         }
 
@@ -849,9 +981,17 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                {
+                    if (canBlendSpans())
+                        PixelSpans::blendPixels (dest, (const PixelARGB*) getSrcPixel (x), width, (uint32) extraAlpha,
+                                                 PixelSpans::hasUnusedTopByte<DestPixelType>());
+                    else
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                }
                 else
+                {
                     copyRow (dest, getSrcPixel (x), width);
+                }
             }
         }
 
@@ -902,6 +1042,13 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        bool canBlendSpans() const noexcept
+        {
+            return std::is_same_v<SrcPixelType, PixelARGB>
+                    && srcData.pixelStride == (int) sizeof (PixelARGB)
+                    && PixelSpans::canBlend<DestPixelType> (destData);
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -913,6 +1060,10 @@ namespace EdgeTableFillers
             {
                 memcpy ((void*) dest, src, (size_t) (width * srcStride));
             }
+            else if (canBlendSpans())
+            {
+                PixelSpans::blendPixels (dest, (const PixelARGB*) src, width, PixelSpans::hasUnusedTopByte<DestPixelType>());
+            }
             else
             {
                 do
@@ -984,10 +1135,22 @@ namespace EdgeTableFillers
             alphaLevel *= extraAlpha;
             alphaLevel >>= 8;
 
-            if (alphaLevel < 0xfe)
+            if (std::is_same_v<SrcPixelType, PixelARGB> && PixelSpans::canBlend<DestPixelType> (destData))
+            {
+                if (alphaLevel < 0xfe)
+                    PixelSpans::blendPixels (dest, (const PixelARGB*) span, width, (uint32) alphaLevel,
+                                             PixelSpans::hasUnusedTopByte<DestPixelType>());
+                else
+                    PixelSpans::blendPixels (dest, (const PixelARGB*) span, width, PixelSpans::hasUnusedTopByte<DestPixelType>());
+            }
+            else if (alphaLevel < 0xfe)
+            {
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
+            }
             else
+            {
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
+            }
         }
 
         forcedinline void handleEdgeTableLineFull (int x, int width) noexcept
@@ -1736,6 +1899,13 @@ struct ClipRegions
         void fillRectWithColour (SavedStateType& state, Rectangle<int> area, PixelARGB colour, bool replaceContents) const override
         {
             auto totalClip = edgeTable.getMaximumBounds();
+
+            if (area.contains (totalClip))
+            {
+                state.fillWithSolidColour (edgeTable, colour, replaceContents);
+                return;
+            }
+
             auto clipped = totalClip.getIntersection (area);
 
             if (! clipped.isEmpty())
@@ -1836,8 +2006,32 @@ struct ClipRegions
             return clip.isEmpty() ? Ptr() : Ptr (*this);
         }
 
-        Ptr clipToPath (const Path& p, const AffineTransform& transform) override  { return toEdgeTable()->clipToPath (p, transform); }
-        Ptr clipToEdgeTable (const EdgeTable& et) override                         { return toEdgeTable()->clipToEdgeTable (et); }
+        Ptr clipToPath (const Path& p, const AffineTransform& transform) override
+        {
+            // A single rectangle can be used as the limits of the path's table, which saves
+            // building a table for the rectangle and then intersecting the two.
+            if (clip.getNumRectangles() == 1)
+            {
+                auto* region = new EdgeTableRegion (clip.getRectangle (0), p, transform);
+                Ptr result (*region);
+                return region->edgeTable.isEmpty() ? Ptr() : result;
+            }
+
+            return toEdgeTable()->clipToPath (p, transform);
+        }
+
+        Ptr clipToEdgeTable (const EdgeTable& et) override
+        {
+            if (clip.getNumRectangles() == 1)
+            {
+                auto* region = new EdgeTableRegion (et);
+                Ptr result (*region);
+                region->edgeTable.clipToRectangle (clip.getRectangle (0));
+                return region->edgeTable.isEmpty() ? Ptr() : result;
+            }
+
+            return toEdgeTable()->clipToEdgeTable (et);
+        }
 
         Ptr clipToImageAlpha (const Image& image, const AffineTransform& transform, Graphics::ResamplingQuality quality) override
         {
@@ -2237,17 +2431,22 @@ public:
 
     void fillTargetRect (Rectangle<float> r)
     {
-        if (fillType.isColour())
-        {
-            clip->fillRectWithColour (getThis(), r, fillType.colour.getPixelARGB());
-        }
-        else
-        {
-            auto clipped = clip->getClipBounds().toFloat().getIntersection (r);
+        // Rectangles that land exactly on pixel boundaries don't need anti-aliasing, so
+        // can be filled without building an edge table
+        auto clipped = clip->getClipBounds().toFloat().getIntersection (r);
 
+        if (isPixelAligned (clipped))
+        {
             if (! clipped.isEmpty())
-                fillShape (*new EdgeTableRegionType (clipped), false);
+                fillTargetRect (clipped.toNearestInt(), false);
+
+            return;
         }
+
+        if (fillType.isColour())
+            clip->fillRectWithColour (getThis(), r, fillType.colour.getPixelARGB());
+        else if (! clipped.isEmpty())
+            fillShape (*new EdgeTableRegionType (clipped), false);
     }
 
     template <typename CoordType>
@@ -2300,7 +2499,8 @@ public:
 
             if (transform.isIdentity())
             {
-                fillShape (*new EdgeTableRegionType (list), false);
+                if (! fillPixelAlignedRectList (list))
+                    fillShape (*new EdgeTableRegionType (list), false);
             }
             else if (! transform.isRotated)
             {
@@ -2311,7 +2511,8 @@ public:
                 else
                     transformed.transformAll (transform.getTransform());
 
-                fillShape (*new EdgeTableRegionType (transformed), false);
+                if (! fillPixelAlignedRectList (transformed))
+                    fillShape (*new EdgeTableRegionType (transformed), false);
             }
             else
             {
@@ -2320,6 +2521,35 @@ public:
         }
     }
 
+    static bool isPixelAligned (Rectangle<float> r) noexcept
+    {
+        return r.toNearestInt().toFloat() == r;
+    }
+
+    // If every rectangle in the list lies on pixel boundaries, this fills them as a
+    // RectangleList and returns true. Otherwise it does nothing and returns false.
+    bool fillPixelAlignedRectList (const RectangleList<float>& list)
+    {
+        auto clipBounds = clip->getClipBounds().toFloat();
+        RectangleList<int> pixelAligned;
+
+        for (auto& r : list)
+        {
+            auto clipped = clipBounds.getIntersection (r);
+
+            if (! isPixelAligned (clipped))
+                return false;
+
+            if (! clipped.isEmpty())
+                pixelAligned.add (clipped.toNearestInt());
+        }
+
+        if (! pixelAligned.isEmpty())
+            fillShape (*new RectangleListRegionType (pixelAligned), false);
+
+        return true;
+    }
+
     void fillPath (const Path& path, const AffineTransform& t)
     {
         if (clip != nullptr)
@@ -2612,8 +2842,9 @@ public:
     template <typename IteratorType>
     void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool isIdentity) const
     {
-        HeapBlock<PixelARGB> lookupTable;
-        auto numLookupEntries = gradient.createLookupTable (trans, lookupTable);
+        const auto table = GradientLookupTables::get (gradient, trans);
+        const PixelARGB* lookupTable = table->colours;
+        const auto numLookupEntries = table->numEntries;
         jassert (numLookupEntries > 0);
 
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
@@ -65,6 +65,11 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return StringArray ("/system/fonts");
 }
 
+File FTTypefaceList::getFontIndexCacheFile()
+{
+    return {};
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
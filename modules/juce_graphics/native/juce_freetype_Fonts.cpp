@@ -78,6 +78,9 @@ struct FTFaceWrapper     : public ReferenceCountedObject
     FTLibWrapper::Ptr library;
     MemoryBlock savedFaceData;
 
+    // FT_Face objects aren't thread-safe, and a face may be shared by several typefaces
+    CriticalSection lock;
+
     using Ptr = ReferenceCountedObjectPtr<FTFaceWrapper>;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FTFaceWrapper)
@@ -87,8 +90,14 @@ struct FTFaceWrapper     : public ReferenceCountedObject
 class FTTypefaceList  : private DeletedAtShutdown
 {
 public:
-    FTTypefaceList()  : library (new FTLibWrapper())
+    FTTypefaceList()  : library (new FTLibWrapper()),
+                        indexCache (getFontIndexCacheFile())
     {
+       #if JUCE_USE_FONTCONFIG
+        if (SystemStats::getEnvironmentVariable ("JUCE_FONT_PATH", {}).isEmpty() && scanFontconfig())
+            return;
+       #endif
+
         scanFontPaths (getDefaultFontDirectories());
     }
 
@@ -100,13 +109,15 @@ public:
     //==============================================================================
     struct KnownTypeface
     {
-        KnownTypeface (const File& f, int index, const FTFaceWrapper& face)
+        KnownTypeface (const File& f, int index, const String& familyName, const String& styleName,
+                       bool monospaced, std::optional<float> ascentProportion)
            : file (f),
-             family (face.face->family_name),
-             style (face.face->style_name),
+             family (familyName),
+             style (styleName),
              faceIndex (index),
-             isMonospaced ((face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0),
-             isSansSerif (isFaceSansSerif (family))
+             isMonospaced (monospaced),
+             isSansSerif (isFaceSansSerif (family)),
+             ascent (ascentProportion)
         {
         }
 
@@ -115,9 +126,17 @@ public:
         const int faceIndex;
         const bool isMonospaced, isSansSerif;
 
+        // The face's ascent as a proportion of its height, if it's known without opening the face
+        const std::optional<float> ascent;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownTypeface)
     };
 
+    static float getAscentProportion (FT_Face face)
+    {
+        return (float) face->ascender / (float) (face->ascender - face->descender);
+    }
+
     //==============================================================================
     static FTFaceWrapper::Ptr selectUnicodeCharmap (FTFaceWrapper* face)
     {
@@ -133,19 +152,49 @@ public:
         return selectUnicodeCharmap (new FTFaceWrapper (library, data, dataSize, index));
     }
 
+    /** Returns the face for a font file, sharing it with any other typefaces that are
+        already using the same file and index.
+    */
     FTFaceWrapper::Ptr createFace (const File& file, int index)
     {
-        return selectUnicodeCharmap (new FTFaceWrapper (library, file, index));
+        const ScopedLock sl (openFacesLock);
+
+        for (auto it = openFaces.begin(); it != openFaces.end();)
+        {
+            // Only the list itself is still holding these
+            if (it->second->getReferenceCount() == 1)
+                it = openFaces.erase (it);
+            else
+                ++it;
+        }
+
+        const auto key = std::make_pair (file.getFullPathName(), index);
+        const auto existing = openFaces.find (key);
+
+        if (existing != openFaces.end())
+            return existing->second;
+
+        auto face = selectUnicodeCharmap (new FTFaceWrapper (library, file, index));
+
+        if (face->face != nullptr)
+            openFaces.emplace (key, face);
+
+        return face;
     }
 
-    FTFaceWrapper::Ptr createFace (const String& fontName, const String& fontStyle)
+    const KnownTypeface* findTypeface (const String& fontName, const String& fontStyle) const noexcept
     {
         auto ftFace = matchTypeface (fontName, fontStyle);
 
         if (ftFace == nullptr)  ftFace = matchTypeface (fontName, "Regular");
         if (ftFace == nullptr)  ftFace = matchTypeface (fontName, {});
 
-        if (ftFace != nullptr)
+        return ftFace;
+    }
+
+    FTFaceWrapper::Ptr createFace (const String& fontName, const String& fontStyle)
+    {
+        if (auto* ftFace = findTypeface (fontName, fontStyle))
             return createFace (ftFace->file, ftFace->faceIndex);
 
         return nullptr;
@@ -190,6 +239,12 @@ public:
             }
         }
 
+        indexCache.save();
+        sortFaces();
+    }
+
+    void sortFaces()
+    {
         std::sort (faces.begin(), faces.end(), [] (const auto* a, const auto* b)
         {
             const auto tie = [] (const KnownTypeface& t)
@@ -252,13 +307,143 @@ public:
     JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL (FTTypefaceList)
 
 private:
+    //==============================================================================
+    /** A persistent record of the faces found in each font file, so that files which
+        haven't changed since the last scan don't need to be opened by FreeType again.
+    */
+    class FontIndexCache
+    {
+    public:
+        struct Face
+        {
+            int index;
+            String family, style;
+            bool isMonospaced;
+            float ascent;
+        };
+
+        explicit FontIndexCache (const File& f)  : cacheFile (f)
+        {
+            if (cacheFile == File())
+                return;
+
+            if (auto xml = parseXMLIfTagMatches (cacheFile, "FONTINDEX"))
+            {
+                if (xml->getIntAttribute ("version") != formatVersion)
+                    return;
+
+                for (auto* fileXml : xml->getChildWithTagNameIterator ("FILE"))
+                {
+                    Entry entry { fileXml->getStringAttribute ("time").getLargeIntValue(),
+                                  fileXml->getStringAttribute ("size").getLargeIntValue(),
+                                  {} };
+
+                    for (auto* faceXml : fileXml->getChildWithTagNameIterator ("FACE"))
+                        entry.faces.push_back ({ faceXml->getIntAttribute ("index"),
+                                                 faceXml->getStringAttribute ("family"),
+                                                 faceXml->getStringAttribute ("style"),
+                                                 faceXml->getBoolAttribute ("mono"),
+                                                 (float) faceXml->getDoubleAttribute ("ascent") });
+
+                    entries[fileXml->getStringAttribute ("path")] = std::move (entry);
+                }
+            }
+        }
+
+        /** Returns the cached faces for a file, or nullptr if the file has changed since it was indexed. */
+        const std::vector<Face>* find (const File& file) const
+        {
+            const auto it = entries.find (file.getFullPathName());
+
+            if (it != entries.end()
+                 && it->second.modificationTime == file.getLastModificationTime().toMilliseconds()
+                 && it->second.size == file.getSize())
+                return &it->second.faces;
+
+            return nullptr;
+        }
+
+        void set (const File& file, std::vector<Face> faces)
+        {
+            entries[file.getFullPathName()] = { file.getLastModificationTime().toMilliseconds(),
+                                                file.getSize(),
+                                                std::move (faces) };
+            needsSaving = cacheFile != File();
+        }
+
+        void save()
+        {
+            if (! needsSaving)
+                return;
+
+            needsSaving = false;
+
+            XmlElement xml ("FONTINDEX");
+            xml.setAttribute ("version", formatVersion);
+
+            for (const auto& [path, entry] : entries)
+            {
+                if (! File (path).existsAsFile())
+                    continue;
+
+                auto* fileXml = xml.createNewChildElement ("FILE");
+                fileXml->setAttribute ("path", path);
+                fileXml->setAttribute ("time", String (entry.modificationTime));
+                fileXml->setAttribute ("size", String (entry.size));
+
+                for (const auto& face : entry.faces)
+                {
+                    auto* faceXml = fileXml->createNewChildElement ("FACE");
+                    faceXml->setAttribute ("index", face.index);
+                    faceXml->setAttribute ("family", face.family);
+                    faceXml->setAttribute ("style", face.style);
+                    faceXml->setAttribute ("mono", face.isMonospaced);
+                    faceXml->setAttribute ("ascent", face.ascent);
+                }
+            }
+
+            if (cacheFile.getParentDirectory().createDirectory().wasOk())
+                xml.writeTo (cacheFile, XmlElement::TextFormat().singleLine());
+        }
+
+    private:
+        struct Entry
+        {
+            int64 modificationTime, size;
+            std::vector<Face> faces;
+        };
+
+        static constexpr int formatVersion = 1;
+
+        File cacheFile;
+        std::map<String, Entry> entries;
+        bool needsSaving = false;
+    };
+
+    //==============================================================================
     FTLibWrapper::Ptr library;
     OwnedArray<KnownTypeface> faces;
+    FontIndexCache indexCache;
+
+    CriticalSection openFacesLock;
+    std::map<std::pair<String, int>, FTFaceWrapper::Ptr> openFaces;
 
     static StringArray getDefaultFontDirectories();
 
+    /** Returns the file used to persist the font index between runs, or File() to disable it. */
+    static File getFontIndexCacheFile();
+
     void scanFont (const File& file)
     {
+        if (auto* cached = indexCache.find (file))
+        {
+            for (const auto& face : *cached)
+                faces.add (new KnownTypeface (file, face.index, face.family, face.style, face.isMonospaced, face.ascent));
+
+            return;
+        }
+
+        std::vector<FontIndexCache::Face> found;
         int faceIndex = 0;
         int numFaces = 0;
 
@@ -272,14 +457,77 @@ private:
                     numFaces = (int) face.face->num_faces;
 
                 if ((face.face->face_flags & FT_FACE_FLAG_SCALABLE) != 0)
-                    faces.add (new KnownTypeface (file, faceIndex, face));
+                {
+                    found.push_back ({ faceIndex,
+                                       face.face->family_name,
+                                       face.face->style_name,
+                                       (face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0,
+                                       getAscentProportion (face.face) });
+
+                    const auto& f = found.back();
+                    faces.add (new KnownTypeface (file, f.index, f.family, f.style, f.isMonospaced, f.ascent));
+                }
             }
 
             ++faceIndex;
         }
         while (faceIndex < numFaces);
+
+        indexCache.set (file, std::move (found));
     }
 
+   #if JUCE_USE_FONTCONFIG
+    /** Asks fontconfig for the installed fonts, which avoids opening any of them here. */
+    bool scanFontconfig()
+    {
+        if (FcInit() == FcFalse)
+            return false;
+
+        auto* pattern = FcPatternCreate();
+        auto* objects = FcObjectSetBuild (FC_FILE, FC_INDEX, FC_FAMILY, FC_STYLE, FC_SPACING, FC_SCALABLE, nullptr);
+        auto* fontSet = FcFontList (nullptr, pattern, objects);
+        const auto numFacesBefore = faces.size();
+
+        if (fontSet != nullptr)
+        {
+            for (int i = 0; i < fontSet->nfont; ++i)
+            {
+                auto* font = fontSet->fonts[i];
+                FcChar8* fileName = nullptr;
+                FcChar8* family = nullptr;
+                FcChar8* style = nullptr;
+                int index = 0, spacing = FC_PROPORTIONAL;
+                FcBool scalable = FcFalse;
+
+                if (FcPatternGetString (font, FC_FILE, 0, &fileName) != FcResultMatch
+                     || FcPatternGetString (font, FC_FAMILY, 0, &family) != FcResultMatch
+                     || FcPatternGetString (font, FC_STYLE, 0, &style) != FcResultMatch
+                     || FcPatternGetBool (font, FC_SCALABLE, 0, &scalable) != FcResultMatch
+                     || scalable == FcFalse)
+                    continue;
+
+                FcPatternGetInteger (font, FC_INDEX, 0, &index);
+                FcPatternGetInteger (font, FC_SPACING, 0, &spacing);
+
+                faces.add (new KnownTypeface (File (String (CharPointer_UTF8 ((const char*) fileName))),
+                                              index,
+                                              String (CharPointer_UTF8 ((const char*) family)),
+                                              String (CharPointer_UTF8 ((const char*) style)),
+                                              spacing == FC_MONO,
+                                              {}));
+            }
+
+            FcFontSetDestroy (fontSet);
+        }
+
+        FcObjectSetDestroy (objects);
+        FcPatternDestroy (pattern);
+
+        sortFaces();
+        return faces.size() > numFacesBefore;
+    }
+   #endif
+
     const KnownTypeface* matchTypeface (const String& familyName, const String& style) const noexcept
     {
         for (auto* face : faces)
@@ -312,12 +560,28 @@ class FreeTypeTypeface   : public CustomTypeface
 {
 public:
     FreeTypeTypeface (const Font& font)
-        : faceWrapper (FTTypefaceList::getInstance()->createFace (font.getTypefaceName(),
-                                                                  font.getTypefaceStyle()))
     {
-        if (faceWrapper != nullptr)
-            initialiseCharacteristics (font.getTypefaceName(),
-                                       font.getTypefaceStyle());
+        auto* list = FTTypefaceList::getInstance();
+
+        if (auto* known = list->findTypeface (font.getTypefaceName(), font.getTypefaceStyle()))
+        {
+            // If the metrics are already known, the face itself isn't opened until a glyph is needed
+            if (known->ascent.has_value())
+            {
+                lazyFaceFile = known->file;
+                lazyFaceIndex = known->faceIndex;
+                setCharacteristics (font.getTypefaceName(), font.getTypefaceStyle(), *known->ascent, L' ');
+                return;
+            }
+
+            faceWrapper = list->createFace (known->file, known->faceIndex);
+
+            if (faceWrapper != nullptr && faceWrapper->face != nullptr)
+                initialiseCharacteristics (font.getTypefaceName(),
+                                           font.getTypefaceStyle());
+            else
+                faceWrapper = nullptr;
+        }
     }
 
     FreeTypeTypeface (const void* data, size_t dataSize)
@@ -331,14 +595,24 @@ public:
     void initialiseCharacteristics (const String& fontName, const String& fontStyle)
     {
         setCharacteristics (fontName, fontStyle,
-                            faceWrapper->face->ascender / (float) (faceWrapper->face->ascender - faceWrapper->face->descender),
+                            FTTypefaceList::getAscentProportion (faceWrapper->face),
                             L' ');
     }
 
     bool loadGlyphIfPossible (const juce_wchar character)
     {
+        if (faceWrapper == nullptr && lazyFaceFile != File())
+        {
+            faceWrapper = FTTypefaceList::getInstance()->createFace (lazyFaceFile, lazyFaceIndex);
+            lazyFaceFile = File();
+
+            if (faceWrapper->face == nullptr)
+                faceWrapper = nullptr;
+        }
+
         if (faceWrapper != nullptr)
         {
+            const ScopedLock sl (faceWrapper->lock);
             auto face = faceWrapper->face;
             auto glyphIndex = FT_Get_Char_Index (face, (FT_ULong) character);
 
@@ -365,6 +639,8 @@ public:
 
 private:
     FTFaceWrapper::Ptr faceWrapper;
+    File lazyFaceFile;
+    int lazyFaceIndex = 0;
 
     bool getGlyphShape (Path& destShape, const FT_Outline& outline, float scaleX)
     {
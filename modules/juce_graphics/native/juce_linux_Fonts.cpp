@@ -80,6 +80,16 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return fontDirs;
 }
 
+File FTTypefaceList::getFontIndexCacheFile()
+{
+    auto cacheHome = SystemStats::getEnvironmentVariable ("XDG_CACHE_HOME", {}).trim();
+
+    if (cacheHome.isEmpty())
+        cacheHome = "~/.cache";
+
+    return File (cacheHome).getChildFile ("JUCE").getChildFile ("FontIndex.xml");
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
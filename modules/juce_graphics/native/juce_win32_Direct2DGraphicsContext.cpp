@@ -109,6 +109,108 @@ static void rectToGeometrySink (const Rectangle<int>& rect, ID2D1GeometrySink* s
 //==============================================================================
 struct Direct2DLowLevelGraphicsContext::Pimpl
 {
+    void createRenderTarget (HWND hwnd, D2D1_SIZE_U size)
+    {
+        bitmapCache.clear();
+        colourBrush = nullptr;
+        renderingTarget = nullptr;
+
+        if (factories->d2dFactory == nullptr)
+            return;
+
+        // A fixed DPI of 96 makes one unit equal to one physical pixel, as it is for the software
+        // renderer, and the peer then applies the platform scale factor as a transform
+        const auto properties = D2D1::RenderTargetProperties (D2D1_RENDER_TARGET_TYPE_DEFAULT, D2D1::PixelFormat(), 96.0f, 96.0f);
+
+        [[maybe_unused]] auto hr = factories->d2dFactory->CreateHwndRenderTarget (properties, { hwnd, size }, renderingTarget.resetAndGetPointerAddress());
+        jassert (SUCCEEDED (hr));
+
+        if (renderingTarget != nullptr)
+            hr = renderingTarget->CreateSolidColorBrush (D2D1::ColorF::ColorF (0.0f, 0.0f, 0.0f, 1.0f), colourBrush.resetAndGetPointerAddress());
+    }
+
+    static ComSmartPtr<ID2D1Bitmap> createBitmap (ID2D1RenderTarget& target, const Image& image)
+    {
+        D2D1_SIZE_U size = { (UINT32) image.getWidth(), (UINT32) image.getHeight() };
+        auto bp = D2D1::BitmapProperties();
+
+        Image img (image.convertedToFormat (Image::ARGB));
+        Image::BitmapData bd (img, Image::BitmapData::readOnly);
+        bp.pixelFormat = target.GetPixelFormat();
+        bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+
+        ComSmartPtr<ID2D1Bitmap> bitmap;
+        target.CreateBitmap (size, bd.data, (UINT32) bd.lineStride, bp, bitmap.resetAndGetPointerAddress());
+        return bitmap;
+    }
+
+    //==============================================================================
+    /*  Holds on to the bitmaps that drawImage() has uploaded, so that an image that's drawn
+        over and over again only gets copied to the GPU when its pixels have changed.
+    */
+    struct BitmapCache  : private ImagePixelData::Listener
+    {
+        ~BitmapCache() override
+        {
+            clear();
+        }
+
+        ID2D1Bitmap* get (ID2D1RenderTarget& target, const Image& image)
+        {
+            auto* pixelData = image.getPixelData();
+            auto iter = bitmaps.find (pixelData);
+
+            if (iter == bitmaps.end())
+            {
+                if (totalPixels > maxTotalPixels)
+                    clear();
+
+                iter = bitmaps.emplace (pixelData, ComSmartPtr<ID2D1Bitmap>()).first;
+                pixelData->listeners.add (this);
+                totalPixels += getNumPixels (pixelData);
+            }
+
+            if (iter->second == nullptr)
+                iter->second = createBitmap (target, image);
+
+            return iter->second;
+        }
+
+        void clear()
+        {
+            for (auto& item : bitmaps)
+                item.first->listeners.remove (this);
+
+            bitmaps.clear();
+            totalPixels = 0;
+        }
+
+    private:
+        static size_t getNumPixels (const ImagePixelData* pixelData) noexcept
+        {
+            return (size_t) pixelData->width * (size_t) pixelData->height;
+        }
+
+        void imageDataChanged (ImagePixelData* pixelData) override
+        {
+            auto iter = bitmaps.find (pixelData);
+
+            if (iter != bitmaps.end())
+                iter->second = nullptr;
+        }
+
+        void imageDataBeingDeleted (ImagePixelData* pixelData) override
+        {
+            if (bitmaps.erase (pixelData) > 0)
+                totalPixels -= getNumPixels (pixelData);
+        }
+
+        static constexpr size_t maxTotalPixels = 16 * 1024 * 1024;
+
+        std::map<ImagePixelData*, ComSmartPtr<ID2D1Bitmap>> bitmaps;
+        size_t totalPixels = 0;
+    };
+
     ID2D1PathGeometry* rectListToPathGeometry (const RectangleList<int>& clipRegion)
     {
         ID2D1PathGeometry* p = nullptr;
@@ -144,6 +246,7 @@ struct Direct2DLowLevelGraphicsContext::Pimpl
 
     ComSmartPtr<ID2D1HwndRenderTarget> renderingTarget;
     ComSmartPtr<ID2D1SolidColorBrush> colourBrush;
+    BitmapCache bitmapCache;
 };
 
 //==============================================================================
@@ -161,6 +264,7 @@ public:
             currentBrush = owner.currentState->currentBrush;
             clipRect = owner.currentState->clipRect;
             transform = owner.currentState->transform;
+            interpolationQuality = owner.currentState->interpolationQuality;
 
             font = owner.currentState->font;
             currentFontFace = owner.currentState->currentFontFace;
@@ -182,6 +286,23 @@ public:
         clearImageClip();
         complexClipLayer = nullptr;
         bitmapMaskLayer = nullptr;
+
+        // This was pushed before any of this state's clips, so must be popped after them
+        if (transparencyLayer != nullptr)
+            owner.pimpl->renderingTarget->PopLayer();
+    }
+
+    void pushTransparencyLayer (float opacity)
+    {
+        jassert (transparencyLayer == nullptr);
+        owner.pimpl->renderingTarget->CreateLayer (transparencyLayer.resetAndGetPointerAddress());
+
+        if (transparencyLayer != nullptr)
+        {
+            auto layerParams = D2D1::LayerParameters();
+            layerParams.opacity = opacity;
+            owner.pimpl->renderingTarget->PushLayer (layerParams, transparencyLayer);
+        }
     }
 
     void clearClip()
@@ -193,7 +314,7 @@ public:
     void clipToRectangle (const Rectangle<int>& r)
     {
         clearClip();
-        clipRect = r.toFloat().transformedBy (transform).getSmallestIntegerContainer();
+        clipRect = clipRect.getIntersection (r.toFloat().transformedBy (transform).getSmallestIntegerContainer());
         shouldClipRect = true;
         pushClips();
     }
@@ -232,9 +353,11 @@ public:
         }
     }
 
-    void clipToRectList (ID2D1Geometry* geometry)
+    void clipToRectList (const RectangleList<int>& list, ID2D1Geometry* geometry)
     {
         clearRectListClip();
+        rectList = list;
+        clipRect = clipRect.getIntersection (list.getBounds());
 
         if (rectListLayer == nullptr)
             owner.pimpl->renderingTarget->CreateLayer (rectListLayer.resetAndGetPointerAddress());
@@ -474,6 +597,7 @@ public:
     Direct2DLowLevelGraphicsContext& owner;
 
     AffineTransform transform;
+    Graphics::ResamplingQuality interpolationQuality = Graphics::mediumResamplingQuality;
 
     Font font;
     float fontHeightToEmSizeFactor = 1.0f;
@@ -493,6 +617,7 @@ public:
     ComSmartPtr<ID2D1Layer> complexClipLayer;
     bool clipsComplex = false, shouldClipComplex = false;
 
+    RectangleList<int> rectList;
     ComSmartPtr<ID2D1Geometry> rectListGeometry;
     D2D1_LAYER_PARAMETERS rectListLayerParams;
     ComSmartPtr<ID2D1Layer> rectListLayer;
@@ -504,6 +629,8 @@ public:
     ComSmartPtr<ID2D1Bitmap> maskBitmap;
     ComSmartPtr<ID2D1BitmapBrush> bitmapMaskBrush;
 
+    ComSmartPtr<ID2D1Layer> transparencyLayer;
+
     ID2D1Brush* currentBrush = nullptr;
     ComSmartPtr<ID2D1BitmapBrush> bitmapBrush;
     ComSmartPtr<ID2D1LinearGradientBrush> linearGradient;
@@ -526,12 +653,7 @@ Direct2DLowLevelGraphicsContext::Direct2DLowLevelGraphicsContext (HWND hwnd_)
     D2D1_SIZE_U size = { (UINT32) (windowRect.right - windowRect.left), (UINT32) (windowRect.bottom - windowRect.top) };
     bounds.setSize (size.width, size.height);
 
-    if (pimpl->factories->d2dFactory != nullptr)
-    {
-        [[maybe_unused]] auto hr = pimpl->factories->d2dFactory->CreateHwndRenderTarget ({}, { hwnd, size }, pimpl->renderingTarget.resetAndGetPointerAddress());
-        jassert (SUCCEEDED (hr));
-        hr = pimpl->renderingTarget->CreateSolidColorBrush (D2D1::ColorF::ColorF (0.0f, 0.0f, 0.0f, 1.0f), pimpl->colourBrush.resetAndGetPointerAddress());
-    }
+    pimpl->createRenderTarget (hwnd, size);
 }
 
 Direct2DLowLevelGraphicsContext::~Direct2DLowLevelGraphicsContext()
@@ -560,12 +682,21 @@ void Direct2DLowLevelGraphicsContext::start()
     saveState();
 }
 
-void Direct2DLowLevelGraphicsContext::end()
+bool Direct2DLowLevelGraphicsContext::end()
 {
     states.clear();
     currentState = nullptr;
-    pimpl->renderingTarget->EndDraw();
+
+    if (pimpl->renderingTarget->EndDraw() == D2DERR_RECREATE_TARGET)
+    {
+        // The device has been lost (e.g. the display driver was updated), so everything that
+        // was created on it has to be made again, and the frame redrawn
+        pimpl->createRenderTarget (hwnd, { (UINT32) bounds.getWidth(), (UINT32) bounds.getHeight() });
+        return false;
+    }
+
     pimpl->renderingTarget->CheckWindowState();
+    return true;
 }
 
 void Direct2DLowLevelGraphicsContext::setOrigin (Point<int> o)
@@ -591,18 +722,40 @@ bool Direct2DLowLevelGraphicsContext::clipToRectangle (const Rectangle<int>& r)
 
 bool Direct2DLowLevelGraphicsContext::clipToRectangleList (const RectangleList<int>& clipRegion)
 {
-    currentState->clipToRectList (pimpl->rectListToPathGeometry (clipRegion));
+    if (clipRegion.getNumRectangles() == 1)
+        return clipToRectangle (clipRegion.getRectangle (0));
+
+    if (! currentState->transform.isOnlyTranslation())
+    {
+        clipToPath (clipRegion.toPath(), {});
+        return ! isClipEmpty();
+    }
+
+    auto deviceRegion = clipRegion;
+    deviceRegion.offsetAll (Point<float> (currentState->transform.getTranslationX(),
+                                          currentState->transform.getTranslationY()).roundToInt());
+
+    if (currentState->shouldClipRectList)
+        deviceRegion.clipTo (currentState->rectList);
+
+    currentState->clipToRectList (deviceRegion, pimpl->rectListToPathGeometry (deviceRegion));
     return ! isClipEmpty();
 }
 
-void Direct2DLowLevelGraphicsContext::excludeClipRectangle (const Rectangle<int>&)
+void Direct2DLowLevelGraphicsContext::excludeClipRectangle (const Rectangle<int>& r)
 {
-    //xxx
+    auto remaining = currentState->shouldClipRectList ? currentState->rectList
+                                                      : RectangleList<int> (currentState->clipRect);
+
+    remaining.subtract (r.toFloat().transformedBy (currentState->transform).getLargestIntegerWithin());
+    currentState->clipToRectList (remaining, pimpl->rectListToPathGeometry (remaining));
 }
 
 void Direct2DLowLevelGraphicsContext::clipToPath (const Path& path, const AffineTransform& transform)
 {
-    currentState->clipToPath (pimpl->pathToPathGeometry (path, transform));
+    const auto deviceTransform = transform.followedBy (currentState->transform);
+    currentState->clipRect = currentState->clipRect.getIntersection (path.getBoundsTransformed (deviceTransform).getSmallestIntegerContainer());
+    currentState->clipToPath (pimpl->pathToPathGeometry (path, deviceTransform));
 }
 
 void Direct2DLowLevelGraphicsContext::clipToImageAlpha (const Image& sourceImage, const AffineTransform& transform)
@@ -639,14 +792,15 @@ void Direct2DLowLevelGraphicsContext::restoreState()
     currentState = states.getLast();
 }
 
-void Direct2DLowLevelGraphicsContext::beginTransparencyLayer (float /*opacity*/)
+void Direct2DLowLevelGraphicsContext::beginTransparencyLayer (float opacity)
 {
-    jassertfalse; //xxx todo
+    saveState();
+    currentState->pushTransparencyLayer (opacity);
 }
 
 void Direct2DLowLevelGraphicsContext::endTransparencyLayer()
 {
-    jassertfalse; //xxx todo
+    restoreState();
 }
 
 void Direct2DLowLevelGraphicsContext::setFill (const FillType& fillType)
@@ -659,12 +813,24 @@ void Direct2DLowLevelGraphicsContext::setOpacity (float newOpacity)
     currentState->setOpacity (newOpacity);
 }
 
-void Direct2DLowLevelGraphicsContext::setInterpolationQuality (Graphics::ResamplingQuality /*quality*/)
+void Direct2DLowLevelGraphicsContext::setInterpolationQuality (Graphics::ResamplingQuality quality)
 {
+    currentState->interpolationQuality = quality;
 }
 
-void Direct2DLowLevelGraphicsContext::fillRect (const Rectangle<int>& r, bool /*replaceExistingContents*/)
+void Direct2DLowLevelGraphicsContext::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
 {
+    if (replaceExistingContents && currentState->fillType.isColour() && currentState->transform.isOnlyTranslation())
+    {
+        // Clear() ignores the transform but respects the clip, so this overwrites just the area of the rectangle
+        const auto deviceRect = r.toFloat().transformedBy (currentState->transform);
+
+        pimpl->renderingTarget->PushAxisAlignedClip (rectangleToRectF (deviceRect), D2D1_ANTIALIAS_MODE_ALIASED);
+        pimpl->renderingTarget->Clear (colourToD2D (currentState->fillType.colour.withMultipliedAlpha (currentState->fillType.getOpacity())));
+        pimpl->renderingTarget->PopAxisAlignedClip();
+        return;
+    }
+
     fillRect (r.toFloat());
 }
 
@@ -693,21 +859,18 @@ void Direct2DLowLevelGraphicsContext::fillPath (const Path& p, const AffineTrans
 
 void Direct2DLowLevelGraphicsContext::drawImage (const Image& image, const AffineTransform& transform)
 {
-    pimpl->renderingTarget->SetTransform (transformToMatrix (transform.followedBy (currentState->transform)));
-
-    D2D1_SIZE_U size = { (UINT32) image.getWidth(), (UINT32) image.getHeight() };
-    auto bp = D2D1::BitmapProperties();
+    if (! image.isValid())
+        return;
 
-    Image img (image.convertedToFormat (Image::ARGB));
-    Image::BitmapData bd (img, Image::BitmapData::readOnly);
-    bp.pixelFormat = pimpl->renderingTarget->GetPixelFormat();
-    bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+    pimpl->renderingTarget->SetTransform (transformToMatrix (transform.followedBy (currentState->transform)));
 
+    if (auto* bitmap = pimpl->bitmapCache.get (*pimpl->renderingTarget, image))
     {
-        ComSmartPtr<ID2D1Bitmap> tempBitmap;
-        pimpl->renderingTarget->CreateBitmap (size, bd.data, bd.lineStride, bp, tempBitmap.resetAndGetPointerAddress());
-        if (tempBitmap != nullptr)
-            pimpl->renderingTarget->DrawBitmap (tempBitmap);
+        const auto interpolationMode = currentState->interpolationQuality == Graphics::lowResamplingQuality
+                                         ? D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR
+                                         : D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
+
+        pimpl->renderingTarget->DrawBitmap (bitmap, nullptr, currentState->fillType.getOpacity(), interpolationMode);
     }
 
     pimpl->renderingTarget->SetTransform (D2D1::IdentityMatrix());
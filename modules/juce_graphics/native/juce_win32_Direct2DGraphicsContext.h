@@ -81,7 +81,9 @@ public:
     void clear();
 
     void start();
-    void end();
+
+    /** Finishes the frame, returning false if the device was lost and it needs to be painted again. */
+    bool end();
 
     //==============================================================================
 private:
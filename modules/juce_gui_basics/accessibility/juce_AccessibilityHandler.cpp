@@ -40,6 +40,86 @@ enum class InternalAccessibilityEvent
 
 void notifyAccessibilityEventInternal (const AccessibilityHandler&, InternalAccessibilityEvent);
 
+//==============================================================================
+/*  This is incremented whenever anything happens that might change the accessibility
+    tree, such as a component being repainted, moved, resized, shown, hidden, added,
+    removed or reordered, or an AccessibilityHandler being deleted.
+
+    Each AccessibilityHandler caches its parent, children and visibility, and reuses them
+    until this changes. An accessibility client tends to make a lot of queries between
+    two updates of the UI, and without this each one would walk the component hierarchy.
+*/
+static uint32 accessibilityTreeGeneration = 1;
+
+void invalidateAccessibilityTreeCaches() noexcept
+{
+    ++accessibilityTreeGeneration;
+}
+
+//==============================================================================
+/*  Collects notifications that tend to get sent many times in quick succession, such as
+    the parent's layout being invalidated as each of its children is created, or a value
+    changing while a slider is dragged. Each distinct one is sent once, asynchronously,
+    to whatever handler its component has at that point.
+*/
+class AccessibilityNotificationCoalescer  : private AsyncUpdater,
+                                            private DeletedAtShutdown
+{
+public:
+    using Sender = void (*) (const AccessibilityHandler&, int notificationType);
+
+    ~AccessibilityNotificationCoalescer() override
+    {
+        cancelPendingUpdate();
+        clearSingletonInstance();
+    }
+
+    static void post (const AccessibilityHandler& handler, int notificationType, Sender sender)
+    {
+        auto& component = const_cast<Component&> (handler.getComponent());
+        getInstance()->add (component, notificationType, sender);
+    }
+
+    JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL (AccessibilityNotificationCoalescer)
+
+private:
+    struct Notification
+    {
+        WeakReference<Component> component;
+        int type;
+        Sender sender;
+    };
+
+    AccessibilityNotificationCoalescer() = default;
+
+    void add (Component& component, int type, Sender sender)
+    {
+        if (pendingKeys.emplace (&component, type).second)
+        {
+            pending.push_back ({ &component, type, sender });
+            triggerAsyncUpdate();
+        }
+    }
+
+    void handleAsyncUpdate() override
+    {
+        auto toSend = std::exchange (pending, {});
+        pendingKeys.clear();
+
+        for (auto& notification : toSend)
+            if (auto* component = notification.component.get())
+                if (auto* handler = component->getAccessibilityHandler())
+                    notification.sender (*handler, notification.type);
+    }
+
+    std::vector<Notification> pending;
+    std::set<std::pair<const Component*, int>> pendingKeys;
+
+    JUCE_DECLARE_NON_COPYABLE (AccessibilityNotificationCoalescer)
+};
+
+JUCE_IMPLEMENT_SINGLETON (AccessibilityNotificationCoalescer)
+
 inline String getAccessibleApplicationOrPluginName()
 {
    #if defined (JucePlugin_Name)
@@ -60,8 +140,7 @@ AccessibilityHandler::AccessibilityHandler (Component& comp,
       typeIndex (typeid (component)),
       role (accessibilityRole),
       actions (std::move (accessibilityActions)),
-      interfaces (std::move (interfacesIn)),
-      nativeImpl (createNativeImpl (*this))
+      interfaces (std::move (interfacesIn))
 {
 }
 
@@ -69,6 +148,7 @@ AccessibilityHandler::~AccessibilityHandler()
 {
     giveAwayFocus();
     notifyAccessibilityEventInternal (*this, InternalAccessibilityEvent::elementDestroyed);
+    invalidateAccessibilityTreeCaches();
 }
 
 //==============================================================================
@@ -111,8 +191,22 @@ static bool isComponentVisibleWithinParent (Component* comp)
 
 bool AccessibilityHandler::isVisibleWithinParent() const
 {
-    return getCurrentState().isAccessibleOffscreen()
-          || (isComponentVisibleWithinParent (&component) && isComponentVisibleWithinWindow (component));
+    if (auto cached = getCachedTreeInfo().visibleWithinParent)
+        return *cached;
+
+    const auto visible = getCurrentState().isAccessibleOffscreen()
+                          || (isComponentVisibleWithinParent (&component) && isComponentVisibleWithinWindow (component));
+
+    getCachedTreeInfo().visibleWithinParent = visible;
+    return visible;
+}
+
+AccessibilityHandler::CachedTreeInfo& AccessibilityHandler::getCachedTreeInfo() const
+{
+    if (cachedTreeInfo.generation != accessibilityTreeGeneration)
+        cachedTreeInfo = { accessibilityTreeGeneration, {}, {}, {} };
+
+    return cachedTreeInfo;
 }
 
 //==============================================================================
@@ -195,13 +289,29 @@ static AccessibilityHandler* getFirstUnignoredDescendant (AccessibilityHandler*
 
 AccessibilityHandler* AccessibilityHandler::getParent() const
 {
-    if (auto* focusContainer = component.findFocusContainer())
-        return getUnignoredAncestor (findEnclosingHandler (focusContainer));
+    if (auto cached = getCachedTreeInfo().parent)
+        return *cached;
 
-    return nullptr;
+    auto* focusContainer = component.findFocusContainer();
+    auto* parent = focusContainer != nullptr ? getUnignoredAncestor (findEnclosingHandler (focusContainer))
+                                             : nullptr;
+
+    // (The cache is fetched again, as finding the parent may have invalidated it)
+    getCachedTreeInfo().parent = parent;
+    return parent;
 }
 
 std::vector<AccessibilityHandler*> AccessibilityHandler::getChildren() const
+{
+    if (auto& cached = getCachedTreeInfo().children)
+        return *cached;
+
+    auto children = findChildren();
+    getCachedTreeInfo().children = children;
+    return children;
+}
+
+std::vector<AccessibilityHandler*> AccessibilityHandler::findChildren() const
 {
     if (! component.isFocusContainer() && component.getParentComponent() != nullptr)
         return {};
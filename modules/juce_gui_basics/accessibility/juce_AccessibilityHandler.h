@@ -201,10 +201,17 @@ public:
     //==============================================================================
     /** Returns the first unignored parent of this UI element in the accessibility hierarchy,
         or nullptr if this is a root element without a parent.
+
+        The result is cached until any component is repainted, moved, resized, shown,
+        hidden, added, removed or reordered.
     */
     AccessibilityHandler* getParent() const;
 
-    /** Returns the unignored children of this UI element in the accessibility hierarchy. */
+    /** Returns the unignored children of this UI element in the accessibility hierarchy.
+
+        The result is cached until any component is repainted, moved, resized, shown,
+        hidden, added, removed or reordered.
+    */
     std::vector<AccessibilityHandler*> getChildren() const;
 
     /** Checks whether a given UI element is a child of this one in the accessibility
@@ -312,10 +319,25 @@ private:
 
     Interfaces interfaces;
 
+    //==============================================================================
+    struct CachedTreeInfo
+    {
+        uint32 generation = 0;
+        std::optional<AccessibilityHandler*> parent;
+        std::optional<std::vector<AccessibilityHandler*>> children;
+        std::optional<bool> visibleWithinParent;
+    };
+
+    mutable CachedTreeInfo cachedTreeInfo;
+
+    CachedTreeInfo& getCachedTreeInfo() const;
+    std::vector<AccessibilityHandler*> findChildren() const;
+
     //==============================================================================
     class AccessibilityNativeImpl;
-    std::unique_ptr<AccessibilityNativeImpl> nativeImpl;
+    mutable std::unique_ptr<AccessibilityNativeImpl> nativeImpl;
 
+    AccessibilityNativeImpl* getNativeImpl() const;
     static std::unique_ptr<AccessibilityNativeImpl> createNativeImpl (AccessibilityHandler&);
 
     //==============================================================================
@@ -69,4 +69,47 @@ public:
     virtual void releaseResources() = 0;
 };
 
+//==============================================================================
+/**
+    A CachedComponentImage that records a component's paint routine into a
+    GraphicsDisplayList, and replays the list until the component is repainted.
+
+    Unlike the image used by Component::setBufferedToImage(), the recorded operations
+    stay as vectors, so the component can be drawn at any scale without losing
+    quality, and no memory is used for pixels. This works best for components whose
+    paint routines do a lot of work to decide what to draw, e.g. by laying out
+    text or building paths, rather than ones that mostly fill large areas.
+
+    Any call to repaint() on the component or one of its children discards the whole
+    list, which is recorded again the next time the component is painted.
+
+    To use it, pass a new one to Component::setCachedComponentImage().
+
+    @see GraphicsDisplayList, Component::setCachedComponentImage
+
+    @tags{GUI}
+*/
+class JUCE_API  DisplayListCachedComponentImage  : public CachedComponentImage
+{
+public:
+    /** Creates a cache for the given component, which must outlive it. */
+    explicit DisplayListCachedComponentImage (Component& componentToCache) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+    /** @internal */
+    bool invalidateAll() override;
+    /** @internal */
+    bool invalidate (const Rectangle<int>& area) override;
+    /** @internal */
+    void releaseResources() override;
+
+private:
+    Component& owner;
+    GraphicsDisplayList displayList;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayListCachedComponentImage)
+};
+
 } // namespace juce
@@ -495,6 +495,160 @@ struct Component::ComponentHelpers
     }
 };
 
+//==============================================================================
+/*  Divides a component into a grid of cells, each listing the indexes of the children
+    that overlap it, in z-order. To find the child at a point, only the children in the
+    cell under that point need to be tried.
+
+    The whole grid is rebuilt lazily when the children are added, removed or reordered,
+    or when the component is resized. When a single child moves, just its own cells are
+    updated.
+*/
+class Component::ChildHitTestIndex
+{
+public:
+    explicit ChildHitTestIndex (Component& c)  : owner (c) {}
+
+    void invalidate() noexcept
+    {
+        needsRebuild = true;
+    }
+
+    void childBoundsChanged (Component& child)
+    {
+        if (needsRebuild)
+            return;
+
+        auto entry = entries.find (&child);
+
+        if (entry == entries.end())
+        {
+            invalidate();
+            return;
+        }
+
+        auto newCells = getCellRange (child);
+
+        if (newCells != entry->second.cells)
+        {
+            removeFromCells (entry->second.zOrder, entry->second.cells);
+            addToCells (entry->second.zOrder, newCells);
+            entry->second.cells = newCells;
+        }
+    }
+
+    Component* findChildAt (Point<float> position)
+    {
+        if (needsRebuild)
+            rebuild();
+
+        const auto x = jlimit (0, numColumns - 1, (int) std::floor (position.x) / cellSize);
+        const auto y = jlimit (0, numRows - 1,    (int) std::floor (position.y) / cellSize);
+        const auto& candidates = cells[(size_t) (y * numColumns + x)];
+
+        for (auto i = candidates.size(); i > 0;)
+        {
+            auto* child = owner.childComponentList.getUnchecked (candidates[--i]);
+
+            if (auto* c = child->getComponentAt (ComponentHelpers::convertFromParentSpace (*child, position)))
+                return c;
+        }
+
+        return nullptr;
+    }
+
+private:
+    struct Entry
+    {
+        int zOrder;
+        Rectangle<int> cells;
+    };
+
+    // Aims for about one cell per child, as long as the cells don't get too small
+    static constexpr int minCellSize = 16;
+
+    void rebuild()
+    {
+        needsRebuild = false;
+
+        const auto& children = owner.childComponentList;
+        const auto area = (double) jmax (1, owner.getWidth()) * (double) jmax (1, owner.getHeight());
+
+        cellSize = jmax (minCellSize, (int) std::sqrt (area / jmax (1, children.size())));
+        numColumns = jmax (1, (owner.getWidth()  + cellSize - 1) / cellSize);
+        numRows    = jmax (1, (owner.getHeight() + cellSize - 1) / cellSize);
+
+        for (auto& cell : cells)
+            cell.clear();
+
+        cells.resize ((size_t) (numColumns * numRows));
+        entries.clear();
+        entries.reserve ((size_t) children.size());
+
+        for (int i = 0; i < children.size(); ++i)
+        {
+            auto* child = children.getUnchecked (i);
+            const auto range = getCellRange (*child);
+
+            entries[child] = { i, range };
+            addToCells (i, range);
+        }
+    }
+
+    Rectangle<int> getCellRange (const Component& child) const
+    {
+        // (Expanded, because hit-testing rounds the position to the nearest pixel)
+        const auto area = child.getBoundsInParent().expanded (1).getIntersection (owner.getLocalBounds());
+
+        if (area.isEmpty())
+            return {};
+
+        return Rectangle<int>::leftTopRightBottom (area.getX() / cellSize,
+                                                   area.getY() / cellSize,
+                                                   (area.getRight()  - 1) / cellSize + 1,
+                                                   (area.getBottom() - 1) / cellSize + 1);
+    }
+
+    void addToCells (int zOrder, Rectangle<int> range)
+    {
+        for (int y = range.getY(); y < range.getBottom(); ++y)
+        {
+            for (int x = range.getX(); x < range.getRight(); ++x)
+            {
+                auto& cell = cells[(size_t) (y * numColumns + x)];
+
+                if (cell.empty() || cell.back() < zOrder)
+                    cell.push_back (zOrder);
+                else
+                    cell.insert (std::lower_bound (cell.begin(), cell.end(), zOrder), zOrder);
+            }
+        }
+    }
+
+    void removeFromCells (int zOrder, Rectangle<int> range)
+    {
+        for (int y = range.getY(); y < range.getBottom(); ++y)
+        {
+            for (int x = range.getX(); x < range.getRight(); ++x)
+            {
+                auto& cell = cells[(size_t) (y * numColumns + x)];
+                auto item = std::lower_bound (cell.begin(), cell.end(), zOrder);
+
+                if (item != cell.end() && *item == zOrder)
+                    cell.erase (item);
+            }
+        }
+    }
+
+    Component& owner;
+    std::vector<std::vector<int>> cells;
+    std::unordered_map<const Component*, Entry> entries;
+    int cellSize = minCellSize, numColumns = 1, numRows = 1;
+    bool needsRebuild = true;
+
+    JUCE_DECLARE_NON_COPYABLE (ChildHitTestIndex)
+};
+
 //==============================================================================
 Component::Component() noexcept
   : componentFlags (0)
@@ -606,6 +760,8 @@ void Component::visibilityChanged() {}
 
 void Component::sendVisibilityChangeMessage()
 {
+    invalidateAccessibilityTreeCaches();
+
     BailOutChecker checker (this);
     visibilityChanged();
 
@@ -889,6 +1045,35 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StandardCachedComponentImage)
 };
 
+//==============================================================================
+DisplayListCachedComponentImage::DisplayListCachedComponentImage (Component& c) noexcept  : owner (c) {}
+
+void DisplayListCachedComponentImage::paint (Graphics& g)
+{
+    if (displayList.isEmpty())
+    {
+        displayList.clear();
+
+        GraphicsDisplayList::Recorder recorder (displayList, owner.getLocalBounds());
+        Graphics recorderGraphics (recorder);
+        owner.paintEntireComponent (recorderGraphics, true);
+    }
+
+    const auto alpha = owner.getAlpha();
+
+    if (alpha < 1.0f)
+        g.beginTransparencyLayer (alpha);
+
+    displayList.replay (g.getInternalContext());
+
+    if (alpha < 1.0f)
+        g.endTransparencyLayer();
+}
+
+bool DisplayListCachedComponentImage::invalidateAll()                          { displayList.clear(); return true; }
+bool DisplayListCachedComponentImage::invalidate (const Rectangle<int>&)       { displayList.clear(); return true; }
+void DisplayListCachedComponentImage::releaseResources()                       { displayList.clear(); }
+
 void Component::setCachedComponentImage (CachedComponentImage* newCachedImage)
 {
     if (cachedImage.get() != newCachedImage)
@@ -928,6 +1113,10 @@ void Component::reorderChildInternal (int sourceIndex, int destIndex)
 
         childComponentList.move (sourceIndex, destIndex);
 
+        if (childHitTestIndex != nullptr)
+            childHitTestIndex->invalidate();
+
+        invalidateAccessibilityTreeCaches();
         sendFakeMouseMove();
         internalChildrenChanged();
     }
@@ -1125,6 +1314,149 @@ Point<float>     Component::localPointToGlobal (Point<float> point) const     {
 Rectangle<int>   Component::localAreaToGlobal  (Rectangle<int> area) const    { return ComponentHelpers::convertCoordinate (nullptr, this, area); }
 Rectangle<float> Component::localAreaToGlobal  (Rectangle<float> area) const  { return ComponentHelpers::convertCoordinate (nullptr, this, area); }
 
+//==============================================================================
+//==============================================================================
+struct Component::ScopedLayoutTransaction::State
+{
+    static State& getInstance()
+    {
+        static State state;
+        return state;
+    }
+
+    bool deferBoundsChange (Component& c)
+    {
+        if (depth == 0 || c.flags.hasHeavyweightPeerFlag || ! MessageManager::existsAndIsCurrentThread())
+            return false;
+
+        if (! c.flags.isInLayoutTransaction)
+        {
+            c.flags.isInLayoutTransaction = true;
+            changes.push_back ({ &c, c.getParentComponent(), ComponentHelpers::convertToParentSpace (c, c.getLocalBounds()), 0 });
+        }
+
+        return true;
+    }
+
+    void flush()
+    {
+        // any bounds that are changed by the callbacks are collected and flushed too
+        ++depth;
+
+        std::vector<DirtyArea> dirtyAreas;
+        WeakReference<Component> firstShowingComponent;
+
+        while (! changes.empty())
+        {
+            auto batch = std::move (changes);
+            changes.clear();
+
+            for (auto& change : batch)
+                if (auto* c = change.component.get())
+                    for (auto* p = c->getParentComponent(); p != nullptr; p = p->getParentComponent())
+                        ++change.depthInHierarchy;
+
+            std::stable_sort (batch.begin(), batch.end(), [] (const Change& a, const Change& b)
+            {
+                return a.depthInHierarchy < b.depthInHierarchy;
+            });
+
+            for (auto& change : batch)
+            {
+                if (auto* c = change.component.get())
+                {
+                    c->flags.isInLayoutTransaction = false;
+
+                    addDirtyArea (dirtyAreas, change.parent, change.originalArea);
+                    addDirtyArea (dirtyAreas, c->getParentComponent(), ComponentHelpers::convertToParentSpace (*c, c->getLocalBounds()));
+
+                    if (c->flags.isResizeCallbackPending && c->cachedImage != nullptr)
+                        c->cachedImage->invalidateAll();
+
+                    if (firstShowingComponent == nullptr && c->isShowing())
+                        firstShowingComponent = c;
+
+                    c->sendMovedResizedMessagesIfPending();
+                }
+            }
+        }
+
+        --depth;
+
+        for (auto& dirty : dirtyAreas)
+        {
+            if (auto* parent = dirty.parent.get())
+            {
+                dirty.area.consolidate();
+
+                if (dirty.area.getNumRectangles() > maxRectanglesPerRepaint)
+                {
+                    parent->repaint (dirty.area.getBounds());
+                }
+                else
+                {
+                    for (auto& area : dirty.area)
+                        parent->repaint (area);
+                }
+            }
+        }
+
+        if (auto* c = firstShowingComponent.get())
+            c->sendFakeMouseMove();
+    }
+
+    int depth = 0;
+
+private:
+    struct Change
+    {
+        WeakReference<Component> component, parent;
+        Rectangle<int> originalArea;
+        int depthInHierarchy;
+    };
+
+    struct DirtyArea
+    {
+        WeakReference<Component> parent;
+        RectangleList<int> area;
+    };
+
+    static constexpr int maxRectanglesPerRepaint = 16;
+
+    static void addDirtyArea (std::vector<DirtyArea>& dirtyAreas, Component* parent, Rectangle<int> area)
+    {
+        if (parent == nullptr || area.isEmpty())
+            return;
+
+        for (auto& dirty : dirtyAreas)
+        {
+            if (dirty.parent == parent)
+            {
+                dirty.area.add (area);
+                return;
+            }
+        }
+
+        dirtyAreas.push_back ({ parent, area });
+    }
+
+    std::vector<Change> changes;
+};
+
+Component::ScopedLayoutTransaction::ScopedLayoutTransaction()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    ++State::getInstance().depth;
+}
+
+Component::ScopedLayoutTransaction::~ScopedLayoutTransaction()
+{
+    auto& state = State::getInstance();
+
+    if (--state.depth == 0)
+        state.flush();
+}
+
 //==============================================================================
 void Component::setBounds (int x, int y, int w, int h)
 {
@@ -1145,6 +1477,14 @@ void Component::setBounds (int x, int y, int w, int h)
 
     if (wasMoved || wasResized)
     {
+        if (ScopedLayoutTransaction::State::getInstance().deferBoundsChange (*this))
+        {
+            boundsRelativeToParent.setBounds (x, y, w, h);
+            flags.isMoveCallbackPending   = flags.isMoveCallbackPending   || wasMoved;
+            flags.isResizeCallbackPending = flags.isResizeCallbackPending || wasResized;
+            return;
+        }
+
         const bool showing = isShowing();
 
         if (showing)
@@ -1197,6 +1537,14 @@ void Component::sendMovedResizedMessagesIfPending()
 
 void Component::sendMovedResizedMessages (bool wasMoved, bool wasResized)
 {
+    if (parentComponent != nullptr && parentComponent->childHitTestIndex != nullptr)
+        parentComponent->childHitTestIndex->childBoundsChanged (*this);
+
+    if (wasResized && childHitTestIndex != nullptr)
+        childHitTestIndex->invalidate();
+
+    invalidateAccessibilityTreeCaches();
+
     BailOutChecker checker (this);
 
     if (wasMoved)
@@ -1458,6 +1806,14 @@ Component* Component::getComponentAt (Point<float> position)
 {
     if (flags.visibleFlag && ComponentHelpers::hitTest (*this, position))
     {
+        if (childHitTestIndex != nullptr)
+        {
+            if (auto* child = childHitTestIndex->findChildAt (position))
+                return child;
+
+            return this;
+        }
+
         for (int i = childComponentList.size(); --i >= 0;)
         {
             auto* child = childComponentList.getUnchecked (i);
@@ -1479,6 +1835,12 @@ Component* Component::getComponentAt (int x, int y)
     return getComponentAt (Point<int> { x, y });
 }
 
+void Component::setChildHitTestIndexEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled != isChildHitTestIndexEnabled())
+        childHitTestIndex = shouldBeEnabled ? std::make_unique<ChildHitTestIndex> (*this) : nullptr;
+}
+
 //==============================================================================
 void Component::addChildComponent (Component& child, int zOrder)
 {
@@ -1516,6 +1878,11 @@ void Component::addChildComponent (Component& child, int zOrder)
 
         childComponentList.insert (zOrder, &child);
 
+        if (childHitTestIndex != nullptr)
+            childHitTestIndex->invalidate();
+
+        invalidateAccessibilityTreeCaches();
+
         child.internalHierarchyChanged();
         internalChildrenChanged();
     }
@@ -1579,6 +1946,11 @@ Component* Component::removeChildComponent (int index, bool sendParentEvents, bo
         childComponentList.remove (index);
         child->parentComponent = nullptr;
 
+        if (childHitTestIndex != nullptr)
+            childHitTestIndex->invalidate();
+
+        invalidateAccessibilityTreeCaches();
+
         ComponentHelpers::releaseAllCachedImageResources (*child);
 
         // (NB: there are obscure situations where child->isShowing() = false, but it still has the focus)
@@ -1751,6 +2123,8 @@ void Component::enterModalState (bool shouldTakeKeyboardFocus,
     // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
+    invalidateAccessibilityTreeCaches();
+
     SafePointer safeReference { this };
 
     if (! isCurrentlyModal (false))
@@ -1785,6 +2159,8 @@ void Component::enterModalState (bool shouldTakeKeyboardFocus,
 
 void Component::exitModalState (int returnValue)
 {
+    invalidateAccessibilityTreeCaches();
+
     WeakReference<Component> deletionChecker (this);
 
     if (isCurrentlyModal (false))
@@ -1940,6 +2316,8 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
     // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
+    invalidateAccessibilityTreeCaches();
+
     if (flags.visibleFlag)
     {
         if (cachedImage != nullptr)
@@ -2000,6 +2378,7 @@ void Component::paintComponentAndChildren (Graphics& g)
 
     if (flags.dontClipGraphicsFlag && getNumChildComponents() == 0)
     {
+        JUCE_TRACE_ZONE ("Component::paint");
         paint (g);
     }
     else
@@ -2007,7 +2386,10 @@ void Component::paintComponentAndChildren (Graphics& g)
         Graphics::ScopedSaveState ss (g);
 
         if (! (ComponentHelpers::clipObscuredRegions (*this, g, clipBounds, {}) && g.isClipEmpty()))
+        {
+            JUCE_TRACE_ZONE ("Component::paint");
             paint (g);
+        }
     }
 
     for (int i = 0; i < childComponentList.size(); ++i)
@@ -2825,6 +3207,7 @@ void Component::internalChildKeyboardFocusChange (FocusChangeType cause,
 void Component::setWantsKeyboardFocus (bool wantsFocus) noexcept
 {
     flags.wantsKeyboardFocusFlag = wantsFocus;
+    invalidateAccessibilityTreeCaches();
 }
 
 void Component::setMouseClickGrabsKeyboardFocus (bool shouldGrabFocus)
@@ -2848,6 +3231,7 @@ void Component::setFocusContainerType (FocusContainerType containerType) noexcep
                                   || containerType == FocusContainerType::keyboardFocusContainer);
 
     flags.isKeyboardFocusContainerFlag = (containerType == FocusContainerType::keyboardFocusContainer);
+    invalidateAccessibilityTreeCaches();
 }
 
 bool Component::isFocusContainer() const noexcept
@@ -2894,6 +3278,7 @@ int Component::getExplicitFocusOrder() const
 void Component::setExplicitFocusOrder (int newFocusOrderIndex)
 {
     properties.set (juce_explicitFocusOrderId, newFocusOrderIndex);
+    invalidateAccessibilityTreeCaches();
 }
 
 std::unique_ptr<ComponentTraverser> Component::createFocusTraverser()
@@ -3256,6 +3641,7 @@ void Component::setHelpText (const String& newHelpText)
 void Component::setAccessible (bool shouldBeAccessible)
 {
     flags.accessibilityIgnoredFlag = ! shouldBeAccessible;
+    invalidateAccessibilityTreeCaches();
 
     if (flags.accessibilityIgnoredFlag)
         invalidateAccessibilityHandler();
@@ -3308,4 +3694,144 @@ AccessibilityHandler* Component::getAccessibilityHandler()
     return accessibilityHandler.get();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ScopedLayoutTransactionTests  : public UnitTest
+{
+public:
+    ScopedLayoutTransactionTests()
+        : UnitTest ("ScopedLayoutTransaction", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Callbacks are held back until the transaction ends");
+        {
+            std::vector<String> log;
+            Box parent ("parent", log, 3);
+
+            {
+                Component::ScopedLayoutTransaction transaction;
+                parent.setSize (90, 90);
+
+                expectEquals (parent.getWidth(), 90);
+                expect (log.empty());
+            }
+
+            expect (log == std::vector<String> { "parent resized",
+                                                 "child0 resized",
+                                                 "child1 moved", "child1 resized",
+                                                 "child2 moved", "child2 resized" });
+        }
+
+        beginTest ("Each component is resized once, parents first");
+        {
+            std::vector<String> log;
+            Box parent ("parent", log, 3);
+            parent.setSize (9, 9);
+            log.clear();
+
+            {
+                Component::ScopedLayoutTransaction transaction;
+
+                for (int i = 0; i < parent.getNumChildComponents(); ++i)
+                    parent.getChildComponent (i)->setSize (5, 5);
+
+                parent.setSize (90, 30);
+            }
+
+            expect (log == std::vector<String> { "parent resized",
+                                                 "child0 resized",
+                                                 "child1 moved", "child1 resized",
+                                                 "child2 moved", "child2 resized" });
+            expect (parent.getChildComponent (2)->getBounds() == Rectangle<int> (60, 0, 30, 30));
+        }
+
+        beginTest ("Nested transactions are flushed by the outermost one");
+        {
+            std::vector<String> log;
+            Box parent ("parent", log, 0);
+            parent.setSize (10, 10);
+            log.clear();
+
+            {
+                Component::ScopedLayoutTransaction outer;
+
+                {
+                    Component::ScopedLayoutTransaction inner;
+                    parent.setTopLeftPosition (5, 5);
+                }
+
+                expect (log.empty());
+                parent.setTopLeftPosition (7, 7);
+            }
+
+            expect (log == std::vector<String> { "parent moved" });
+        }
+
+        beginTest ("Listeners are called once, and deleted components are skipped");
+        {
+            std::vector<String> log;
+            Box parent ("parent", log, 3);
+            parent.setSize (9, 9);
+
+            struct Listener  : public ComponentListener
+            {
+                void componentMovedOrResized (Component&, bool, bool) override  { ++numCalls; }
+                int numCalls = 0;
+            };
+
+            Listener listener;
+            parent.addComponentListener (&listener);
+            log.clear();
+
+            {
+                Component::ScopedLayoutTransaction transaction;
+                auto temporary = std::make_unique<Box> ("temporary", log, 0);
+                temporary->setSize (20, 20);
+
+                parent.setSize (30, 30);
+                parent.setSize (60, 60);
+                temporary.reset();
+            }
+
+            expectEquals (listener.numCalls, 1);
+            expect (log.front() == "parent resized");
+            parent.removeComponentListener (&listener);
+        }
+    }
+
+private:
+    struct Box  : public Component
+    {
+        Box (const String& name, std::vector<String>& l, int numChildren)
+            : Component (name), log (l)
+        {
+            for (int i = 0; i < numChildren; ++i)
+                addAndMakeVisible (children.add (std::make_unique<Box> ("child" + String (i), log, 0)));
+        }
+
+        void moved() override       { log.push_back (getName() + " moved"); }
+        void resized() override
+        {
+            log.push_back (getName() + " resized");
+
+            auto area = getLocalBounds();
+            const auto childWidth = children.isEmpty() ? 0 : getWidth() / children.size();
+
+            for (auto* child : children)
+                child->setBounds (area.removeFromLeft (childWidth));
+        }
+
+        std::vector<String>& log;
+        OwnedArray<Box> children;
+    };
+};
+
+static ScopedLayoutTransactionTests scopedLayoutTransactionTests;
+
+#endif
+
 } // namespace juce
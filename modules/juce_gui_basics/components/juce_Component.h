@@ -580,6 +580,58 @@ public:
     */
     void centreWithSize (int width, int height);
 
+    //==============================================================================
+    /**
+        Batches up the side-effects of moving and resizing lots of components.
+
+        While one of these objects exists, setBounds() and the other methods that move or
+        resize a component still change its bounds straight away, but the moved(), resized(),
+        parentSizeChanged(), childBoundsChanged() and ComponentListener callbacks that it
+        would normally trigger are held back, and so are the repaints.
+
+        When the last transaction is deleted, each component that changed gets a single
+        set of callbacks, with parents being called before their children. Any bounds that
+        are changed by those callbacks (e.g. by a parent's resized() method laying out its
+        children) are collected in the same way, so a child whose bounds were set both by
+        your code and by its parent's resized() only has its own resized() called once.
+        Finally, the areas that changed are merged and repainted once per parent.
+
+        This makes it much cheaper to reposition thousands of components in one go, e.g.
+        when zooming a large view:
+
+        @code
+        {
+            Component::ScopedLayoutTransaction transaction;
+
+            for (auto* module : modules)
+                module->setBounds (getModuleArea (*module) * zoom);
+        } // all the callbacks and repaints happen here
+        @endcode
+
+        Bear in mind that code inside the transaction won't see the results of any
+        callbacks, e.g. a component's children won't have been laid out by its resized()
+        method yet. Components that are on the desktop aren't affected.
+
+        These can be nested, and must only be used on the message thread.
+    */
+    class JUCE_API  ScopedLayoutTransaction
+    {
+    public:
+        /** Starts a transaction. */
+        ScopedLayoutTransaction();
+
+        /** Ends the transaction, and if it's the outermost one, delivers all the
+            callbacks and repaints that were held back.
+        */
+        ~ScopedLayoutTransaction();
+
+    private:
+        struct State;
+        friend class Component;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedLayoutTransaction)
+    };
+
     //==============================================================================
     /** Sets a transform matrix to be applied to this component.
 
@@ -1003,6 +1055,24 @@ public:
     */
     Component* getComponentAt (Point<float> position);
 
+    /** Enables an index of this component's children that speeds up getComponentAt().
+
+        Normally getComponentAt() has to try each child in turn, which gets slow for a
+        component with thousands of children, such as a large patch editor, because
+        it happens for every mouse move. With the index enabled, only the children
+        whose bounds overlap the point are tried.
+
+        The index is kept up to date as children are added, removed, moved, resized or
+        reordered. That costs a little memory and some extra work whenever a child's
+        bounds change, so it's only worth enabling for components with many children.
+
+        @see getComponentAt
+    */
+    void setChildHitTestIndexEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the child index has been enabled with setChildHitTestIndexEnabled(). */
+    bool isChildHitTestIndexEnabled() const noexcept        { return childHitTestIndex != nullptr; }
+
     //==============================================================================
     /** Marks the whole component as needing to be redrawn.
 
@@ -2544,6 +2614,8 @@ private:
 
     class MouseListenerList;
     std::unique_ptr<MouseListenerList> mouseListeners;
+    class ChildHitTestIndex;
+    std::unique_ptr<ChildHitTestIndex> childHitTestIndex;
     std::unique_ptr<Array<KeyListener*>> keyListeners;
     ListenerList<ComponentListener> componentListeners;
     NamedValueSet properties;
@@ -2578,6 +2650,7 @@ private:
         bool viewportIgnoreDragFlag       : 1;
         bool accessibilityIgnoredFlag     : 1;
         bool cachedMouseInsideComponent   : 1;
+        bool isInLayoutTransaction        : 1;
        #if JUCE_DEBUG
         bool isInsidePaintCall            : 1;
        #endif
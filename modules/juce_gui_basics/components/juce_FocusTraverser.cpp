@@ -167,7 +167,9 @@ struct FocusTraverserTests  : public UnitTest
 {
     FocusTraverserTests()
         : UnitTest ("FocusTraverser", UnitTestCategories::gui)
-    {}
+    {
+        setIsolation (Isolation::messageThread);
+    }
 
     void runTest() override
     {
@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct DrawableDisplayList::Recording
+{
+    Recording() = default;
+
+    explicit Recording (const Drawable& source)
+    {
+        // The recording is made without the transform that positions the source, which
+        // is copied to the DrawableDisplayList instead
+        std::unique_ptr<Drawable> untransformedCopy;
+        auto* drawable = &source;
+
+        if (source.isTransformed())
+        {
+            untransformedCopy = source.createCopy();
+            untransformedCopy->setTransform ({});
+            drawable = untransformedCopy.get();
+        }
+
+        bounds = drawable->getDrawableBounds();
+        outline = drawable->getOutlineAsPath();
+
+        GraphicsDisplayList::Recorder recorder (list, bounds.getSmallestIntegerContainer().expanded (2));
+        Graphics g (recorder);
+        drawable->draw (g, 1.0f);
+    }
+
+    GraphicsDisplayList list;
+    Rectangle<float> bounds;
+    Path outline;
+};
+
+//==============================================================================
+/*  Holds the data for an object made by createFromImageData() until it has been parsed.
+
+    Decoding the image or parsing the XML is safe on any thread, so that's the part that
+    parse() does in the background. Building the Drawable creates components, so that
+    only happens in createRecording(), which must be called on the message thread.
+*/
+class DrawableDisplayList::PendingRecording
+{
+public:
+    explicit PendingRecording (MemoryBlock dataToParse)  : data (std::move (dataToParse)) {}
+
+    void parse()
+    {
+        const ScopedLock sl (lock);
+
+        if (data.isEmpty())
+            return;
+
+        image = ImageFileFormat::loadFrom (data.getData(), data.getSize());
+
+        if (! image.isValid())
+            svg = parseXMLIfTagMatches (data.toString(), "svg");
+
+        data.reset();
+    }
+
+    std::shared_ptr<const Recording> createRecording()
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        parse();
+
+        const ScopedLock sl (lock);
+
+        if (image.isValid())
+            return std::make_shared<const Recording> (DrawableImage (image));
+
+        if (svg != nullptr)
+            if (auto drawable = Drawable::createFromSVG (*svg))
+                return std::make_shared<const Recording> (*drawable);
+
+        return std::make_shared<const Recording>();
+    }
+
+private:
+    CriticalSection lock;
+    MemoryBlock data;
+    Image image;
+    std::unique_ptr<XmlElement> svg;
+
+    JUCE_DECLARE_NON_COPYABLE (PendingRecording)
+};
+
+//==============================================================================
+DrawableDisplayList::DrawableDisplayList()
+    : recording (std::make_shared<const Recording>())
+{
+}
+
+DrawableDisplayList::DrawableDisplayList (const Drawable& drawableToRecord)
+    : recording (std::make_shared<const Recording> (drawableToRecord))
+{
+    setName (drawableToRecord.getName());
+    setComponentID (drawableToRecord.getComponentID());
+    setTransform (drawableToRecord.getTransform());
+    setBoundsToEnclose (getDrawableBounds());
+}
+
+DrawableDisplayList::DrawableDisplayList (const DrawableDisplayList& other)
+    : Drawable (other),
+      recording (other.recording),
+      pendingRecording (other.pendingRecording),
+      imageCachingEnabled (other.imageCachingEnabled)
+{
+    setBounds (other.getBounds());
+}
+
+DrawableDisplayList::~DrawableDisplayList()
+{
+}
+
+std::unique_ptr<Drawable> DrawableDisplayList::createCopy() const
+{
+    return std::make_unique<DrawableDisplayList> (*this);
+}
+
+std::unique_ptr<DrawableDisplayList> DrawableDisplayList::createFromImageData (const void* data, size_t numBytes,
+                                                                             ThreadPool* poolToParseOn)
+{
+    if (data == nullptr || numBytes == 0)
+        return {};
+
+    auto pending = std::make_shared<PendingRecording> (MemoryBlock (data, numBytes));
+
+    if (poolToParseOn != nullptr)
+        poolToParseOn->addJob ([pending] { pending->parse(); });
+
+    auto result = std::make_unique<DrawableDisplayList>();
+    result->recording = nullptr;
+    result->pendingRecording = std::move (pending);
+    return result;
+}
+
+//==============================================================================
+const DrawableDisplayList::Recording& DrawableDisplayList::getRecording() const
+{
+    if (recording == nullptr)
+    {
+        recording = pendingRecording->createRecording();
+        pendingRecording = nullptr;
+    }
+
+    return *recording;
+}
+
+void DrawableDisplayList::setImageCachingEnabled (bool shouldCacheImages)
+{
+    imageCachingEnabled = shouldCacheImages;
+
+    if (! imageCachingEnabled)
+        cachedImages.clear();
+}
+
+const DrawableDisplayList::CachedImage& DrawableDisplayList::getCachedImage (const Recording& r, float scale)
+{
+    for (auto& cached : cachedImages)
+        if (cached.scale == scale)
+            return cached;
+
+    // Only keep the few most recently added scales
+    constexpr size_t maxCachedImages = 4;
+
+    if (cachedImages.size() >= maxCachedImages)
+        cachedImages.erase (cachedImages.begin());
+
+    // Align the image to whole physical pixels of the drawable's coordinate space
+    const auto scaledArea = (r.bounds * scale).getSmallestIntegerContainer().expanded (1);
+    const auto origin = scaledArea.getPosition().toFloat() / scale;
+
+    Image image (Image::ARGB, jmax (1, scaledArea.getWidth()), jmax (1, scaledArea.getHeight()), true);
+
+    {
+        Graphics g (image);
+        r.list.draw (g, AffineTransform::translation (-origin).scaled (scale));
+    }
+
+    cachedImages.push_back ({ scale, origin, std::move (image) });
+    return cachedImages.back();
+}
+
+//==============================================================================
+void DrawableDisplayList::paint (Graphics& g)
+{
+    auto& r = getRecording();
+
+    transformContextToCorrectOrigin (g);
+
+    if (imageCachingEnabled && ! r.list.isEmpty())
+    {
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (scale > 0.0f)
+        {
+            auto& cached = getCachedImage (r, scale);
+            g.drawImageTransformed (cached.image, AffineTransform::scale (1.0f / scale).translated (cached.origin));
+            return;
+        }
+    }
+
+    r.list.draw (g);
+}
+
+Rectangle<float> DrawableDisplayList::getDrawableBounds() const
+{
+    return getRecording().bounds;
+}
+
+Path DrawableDisplayList::getOutlineAsPath() const
+{
+    auto p = getRecording().outline;
+    p.applyTransform (getTransform());
+    return p;
+}
+
+bool DrawableDisplayList::replaceColour (Colour, Colour)
+{
+    return false;
+}
+
+} // namespace juce
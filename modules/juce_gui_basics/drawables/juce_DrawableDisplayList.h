@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A drawable that paints a recorded copy of another Drawable.
+
+    A Drawable loaded from an SVG is a tree of DrawableComposite, DrawablePath and
+    DrawableText components, and every time it's painted that tree has to be walked
+    and each shape's transform and fill applied again. This class draws the tree once
+    into a GraphicsDisplayList and replays that instead, so it's a single component
+    that costs about the same to paint as the shapes it contains.
+
+    Because it doesn't keep the original tree, the result can't be edited: methods
+    such as replaceColour() have no effect.
+
+    It can also be made to keep a rendered image for each scale it's painted at (see
+    setImageCachingEnabled()), which makes repainting it even cheaper.
+
+    A DrawableDisplayList can also be created straight from SVG or image data with
+    createFromImageData(). That returns immediately, and the data is only parsed when
+    it's first needed, or straight away on a ThreadPool if you supply one, so that a
+    large number of icons can be loaded without holding up the message thread.
+
+    @see Drawable, GraphicsDisplayList
+
+    @tags{GUI}
+*/
+class JUCE_API  DrawableDisplayList  : public Drawable
+{
+public:
+    //==============================================================================
+    /** Creates an empty DrawableDisplayList. */
+    DrawableDisplayList();
+
+    /** Records a Drawable, so that this object paints the same thing.
+
+        The drawable is only used during the constructor, and can be deleted afterwards.
+    */
+    explicit DrawableDisplayList (const Drawable& drawableToRecord);
+
+    /** Creates a copy of a DrawableDisplayList, which shares its recording. */
+    DrawableDisplayList (const DrawableDisplayList&);
+
+    /** Destructor. */
+    ~DrawableDisplayList() override;
+
+    //==============================================================================
+    /** Creates a DrawableDisplayList from SVG or image data, without parsing it yet.
+
+        The data is copied, and is parsed with Drawable::createFromImageData() when the
+        object first needs it: when it's painted, added to a parent component, or asked
+        for its bounds.
+
+        If a ThreadPool is supplied, a job is added to it to decode the image or parse
+        the XML straight away, and anything that needs the result before that job has
+        finished will wait for it. The Drawable that gets recorded is still built on the
+        message thread, because that involves creating components. The pool must be
+        running, but needn't outlive the object.
+
+        Returns nullptr if there's no data.
+    */
+    static std::unique_ptr<DrawableDisplayList> createFromImageData (const void* data, size_t numBytes,
+                                                                     ThreadPool* poolToParseOn = nullptr);
+
+    //==============================================================================
+    /** Enables or disables caching a rendered image for each scale that the object is
+        painted at.
+
+        When this is enabled, painting at a scale for which there's already an image
+        just draws that image, which is much quicker than replaying the recording. The
+        images are aligned to whole physical pixels, so the result may differ very
+        slightly from an uncached paint if the object is positioned at a fractional
+        pixel offset. Only a few of the most recently used scales are kept.
+
+        This is disabled by default.
+    */
+    void setImageCachingEnabled (bool shouldCacheImages);
+
+    /** Returns true if images are being cached.
+        @see setImageCachingEnabled
+    */
+    bool isImageCachingEnabled() const noexcept                 { return imageCachingEnabled; }
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+    /** @internal */
+    std::unique_ptr<Drawable> createCopy() const override;
+    /** @internal */
+    Rectangle<float> getDrawableBounds() const override;
+    /** @internal */
+    Path getOutlineAsPath() const override;
+    /** @internal */
+    bool replaceColour (Colour, Colour) override;
+
+private:
+    //==============================================================================
+    struct Recording;
+    class PendingRecording;
+
+    struct CachedImage
+    {
+        float scale;
+        Point<float> origin;
+        Image image;
+    };
+
+    const Recording& getRecording() const;
+    const CachedImage& getCachedImage (const Recording&, float scale);
+
+    mutable std::shared_ptr<const Recording> recording;
+    mutable std::shared_ptr<PendingRecording> pendingRecording;
+    std::vector<CachedImage> cachedImages;
+    bool imageCachingEnabled = false;
+
+    DrawableDisplayList& operator= (const DrawableDisplayList&);
+    JUCE_LEAK_DETECTOR (DrawableDisplayList)
+};
+
+} // namespace juce
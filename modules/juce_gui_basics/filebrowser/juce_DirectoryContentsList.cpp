@@ -105,6 +105,10 @@ void DirectoryContentsList::setTypeFlags (const int newFlags)
 void DirectoryContentsList::stopSearching()
 {
     shouldStop = true;
+
+    if (parallelScanner != nullptr)
+        parallelScanner->stop();
+
     thread.removeTimeSliceClient (this);
     isSearching = false;
 }
@@ -113,28 +117,56 @@ void DirectoryContentsList::clear()
 {
     stopSearching();
 
-    if (! files.isEmpty())
+    bool hadFiles;
+
     {
+        const ScopedLock sl (fileListLock);
+        hadFiles = ! files.empty();
         files.clear();
-        changed();
     }
+
+    if (hadFiles)
+        changed();
 }
 
 void DirectoryContentsList::refresh()
 {
     stopSearching();
-    wasEmpty = files.isEmpty();
-    files.clear();
+
+    {
+        const ScopedLock sl (fileListLock);
+        wasEmpty = files.empty();
+        files.clear();
+    }
 
     if (root.isDirectory())
     {
-        fileFindHandle = std::make_unique<RangedDirectoryIterator> (root, false, "*", fileTypeFlags);
+        if (parallelScanner == nullptr)
+            fileFindHandle = std::make_unique<RangedDirectoryIterator> (root, false, "*", fileTypeFlags);
+
         shouldStop = false;
         isSearching = true;
+        lastChangeTime = 0;
         thread.addTimeSliceClient (this);
     }
 }
 
+void DirectoryContentsList::setThreadPool (WorkStealingThreadPool* poolToUse)
+{
+    if (threadPool != poolToUse)
+    {
+        const bool wasSearching = isSearching;
+        stopSearching();
+
+        threadPool = poolToUse;
+        parallelScanner = poolToUse != nullptr ? std::make_unique<ParallelDirectoryScanner> (*poolToUse)
+                                               : nullptr;
+
+        if (wasSearching)
+            refresh();
+    }
+}
+
 void DirectoryContentsList::setFileFilter (const FileFilter* newFileFilter)
 {
     const ScopedLock sl (fileListLock);
@@ -145,16 +177,16 @@ void DirectoryContentsList::setFileFilter (const FileFilter* newFileFilter)
 int DirectoryContentsList::getNumFiles() const noexcept
 {
     const ScopedLock sl (fileListLock);
-    return files.size();
+    return (int) files.size();
 }
 
 bool DirectoryContentsList::getFileInfo (const int index, FileInfo& result) const
 {
     const ScopedLock sl (fileListLock);
 
-    if (auto* info = files [index])
+    if (isPositiveAndBelow (index, files.size()))
     {
-        result = *info;
+        result = files[(size_t) index];
         return true;
     }
 
@@ -165,21 +197,44 @@ File DirectoryContentsList::getFile (const int index) const
 {
     const ScopedLock sl (fileListLock);
 
-    if (auto* info = files [index])
-        return root.getChildFile (info->filename);
+    if (isPositiveAndBelow (index, files.size()))
+        return root.getChildFile (files[(size_t) index].filename);
 
     return {};
 }
 
 bool DirectoryContentsList::contains (const File& targetFile) const
+{
+    return indexOf (targetFile) >= 0;
+}
+
+int DirectoryContentsList::indexOf (const File& targetFile) const
 {
     const ScopedLock sl (fileListLock);
 
-    for (int i = files.size(); --i >= 0;)
-        if (root.getChildFile (files.getUnchecked(i)->filename) == targetFile)
-            return true;
+    const auto search = [&] (bool isDirectory)
+    {
+        FileInfo key;
+        key.filename = targetFile.getFileName();
+        key.isDirectory = isDirectory;
+
+        // Names that only differ in case sort next to each other, so on a case-insensitive
+        // file system the first item at or after the key is still the one to check
+        const auto found = std::lower_bound (files.begin(), files.end(), key, isBefore);
 
-    return false;
+        if (found != files.end() && root.getChildFile (found->filename) == targetFile)
+            return (int) std::distance (files.begin(), found);
+
+        return -1;
+    };
+
+   #if JUCE_WINDOWS
+    // The folders come first here, so the file could be in either half of the list
+    if (auto index = search (true); index >= 0)
+        return index;
+   #endif
+
+    return search (false);
 }
 
 bool DirectoryContentsList::isStillLoading() const
@@ -195,94 +250,216 @@ void DirectoryContentsList::changed()
 //==============================================================================
 int DirectoryContentsList::useTimeSlice()
 {
+    if (! isSearching || shouldStop)
+        return 500;
+
+    if (parallelScanner != nullptr)
+    {
+        scanWithThreadPool();
+        return 500;
+    }
+
+    readNextBatch();
+    return isSearching ? 0 : 500;
+}
+
+void DirectoryContentsList::readNextBatch()
+{
+    if (fileFindHandle == nullptr)
+        return;
+
     auto startTime = Time::getApproximateMillisecondCounter();
-    bool hasChanged = false;
+    auto& iter = *fileFindHandle;
+
+    std::vector<FileInfo> batch;
+    batch.reserve ((size_t) maxBatchSize);
 
-    for (int i = 100; --i >= 0;)
+    while (iter != RangedDirectoryIterator() && (int) batch.size() < maxBatchSize)
     {
-        if (! checkNextFile (hasChanged))
-        {
-            if (hasChanged)
-                changed();
+        const auto entry = *iter++;
 
-            return 500;
+        if (isSuitable (entry.getFile(), entry.isDirectory()))
+        {
+            FileInfo info;
+            info.filename         = entry.getFile().getFileName();
+            info.fileSize         = entry.getFileSize();
+            info.modificationTime = entry.getModificationTime();
+            info.creationTime     = entry.getCreationTime();
+            info.isDirectory      = entry.isDirectory();
+            info.isReadOnly       = entry.isReadOnly();
+
+            batch.push_back (std::move (info));
         }
 
         if (shouldStop || (Time::getApproximateMillisecondCounter() > startTime + 150))
             break;
     }
 
-    if (hasChanged)
-        changed();
+    const auto isFinished = iter == RangedDirectoryIterator();
+
+    if (addFiles (std::move (batch)) && ! isFinished)
+        sendChangeIfDue();
 
-    return 0;
+    if (isFinished)
+    {
+        fileFindHandle = nullptr;
+        finishedSearching();
+    }
 }
 
-bool DirectoryContentsList::checkNextFile (bool& hasChanged)
+void DirectoryContentsList::scanWithThreadPool()
 {
-    if (fileFindHandle == nullptr)
-        return false;
+    // Only the names and types are read while scanning, so that the rest of the
+    // details can be fetched for a whole batch of files at once on the pool
+    const auto options = ParallelDirectoryScanner::Options{}.withRecursion (false)
+                                                            .withTypesToFind (fileTypeFlags)
+                                                            .withMetadata (false);
+    const auto directory = root;
+
+    CriticalSection batchLock;
+    std::vector<FileInfo> batch;
 
-    if (*fileFindHandle == RangedDirectoryIterator())
+    const auto addBatch = [&]
     {
-        fileFindHandle = nullptr;
-        isSearching = false;
-        hasChanged = true;
-        return false;
+        fetchDetails (batch, directory);
+
+        if (addFiles (std::move (batch)))
+            sendChangeIfDue();
+
+        batch.clear();
+    };
+
+    parallelScanner->scan (directory, options, [&] (const DirectoryEntry& entry)
+    {
+        if (shouldStop)
+        {
+            parallelScanner->stop();
+            return;
+        }
+
+        if (! isSuitable (entry.getFile(), entry.isDirectory()))
+            return;
+
+        const ScopedLock sl (batchLock);
+
+        FileInfo info;
+        info.filename    = entry.getFile().getFileName();
+        info.isDirectory = entry.isDirectory();
+        batch.push_back (std::move (info));
+
+        if ((int) batch.size() >= maxBatchSize)
+            addBatch();
+    });
+
+    if (! shouldStop)
+    {
+        addBatch();
+        finishedSearching();
     }
+}
 
-    const auto entry = *(*fileFindHandle)++;
+void DirectoryContentsList::fetchDetails (std::vector<FileInfo>& batch, const File& directory)
+{
+    threadPool->parallelFor (0, (int) batch.size(), [&] (int i)
+    {
+        auto& info = batch[(size_t) i];
+        const auto file = directory.getChildFile (info.filename);
+
+        info.fileSize         = file.getSize();
+        info.modificationTime = file.getLastModificationTime();
+        info.creationTime     = file.getCreationTime();
+        info.isReadOnly       = ! file.hasWriteAccess();
+    }, 16);
+}
+
+void DirectoryContentsList::finishedSearching()
+{
+    isSearching = false;
+    lastChangeTime = Time::getApproximateMillisecondCounter();
+    changed();
+}
 
-    hasChanged |= addFile (entry.getFile(),
-                           entry.isDirectory(),
-                           entry.getFileSize(),
-                           entry.getModificationTime(),
-                           entry.getCreationTime(),
-                           entry.isReadOnly());
+void DirectoryContentsList::sendChangeIfDue()
+{
+    // While a big folder is loading, listeners are only told about the new files a few
+    // times a second, rather than repainting for every batch
+    auto now = Time::getApproximateMillisecondCounter();
 
-    return true;
+    if (lastChangeTime == 0 || now >= lastChangeTime + minChangeInterval)
+    {
+        lastChangeTime = now;
+        changed();
+    }
 }
 
-bool DirectoryContentsList::addFile (const File& file, const bool isDir,
-                                     const int64 fileSize,
-                                     Time modTime, Time creationTime,
-                                     const bool isReadOnly)
+bool DirectoryContentsList::isSuitable (const File& file, const bool isDir) const
 {
     const ScopedLock sl (fileListLock);
 
-    if (fileFilter == nullptr
-         || ((! isDir) && fileFilter->isFileSuitable (file))
-         || (isDir && fileFilter->isDirectorySuitable (file)))
-    {
-        auto info = std::make_unique<FileInfo>();
+    return fileFilter == nullptr
+            || ((! isDir) && fileFilter->isFileSuitable (file))
+            || (isDir && fileFilter->isDirectorySuitable (file));
+}
 
-        info->filename         = file.getFileName();
-        info->fileSize         = fileSize;
-        info->modificationTime = modTime;
-        info->creationTime     = creationTime;
-        info->isDirectory      = isDir;
-        info->isReadOnly       = isReadOnly;
+bool DirectoryContentsList::isBefore (const FileInfo& a, const FileInfo& b)
+{
+   #if JUCE_WINDOWS
+    if (a.isDirectory != b.isDirectory)
+        return a.isDirectory;
+   #endif
 
-        for (int i = files.size(); --i >= 0;)
-            if (files.getUnchecked(i)->filename == info->filename)
-                return false;
+    // Names that compare as equal naturally (e.g. that only differ in case) are put into
+    // a fixed order, so that the list can be binary-searched
+    if (auto order = a.filename.compareNatural (b.filename))
+        return order < 0;
 
-        files.add (std::move (info));
+    return a.filename.compare (b.filename) < 0;
+}
 
-        std::sort (files.begin(), files.end(), [] (const FileInfo* a, const FileInfo* b)
-        {
-           #if JUCE_WINDOWS
-            if (a->isDirectory != b->isDirectory)
-                return a->isDirectory;
-           #endif
+bool DirectoryContentsList::addFiles (std::vector<FileInfo>&& batch)
+{
+    if (batch.empty())
+        return false;
 
-            return a->filename.compareNatural (b->filename) < 0;
-        });
+    // Each batch is sorted on its own before the list is locked, and then merged into
+    // the list in a single pass, rather than re-sorting the whole list for every file
+    std::sort (batch.begin(), batch.end(), isBefore);
 
-        return true;
-    }
+    const ScopedLock sl (fileListLock);
 
-    return false;
+    const auto oldSize = files.size();
+    files.insert (files.end(), std::make_move_iterator (batch.begin()), std::make_move_iterator (batch.end()));
+    std::inplace_merge (files.begin(), files.begin() + (ptrdiff_t) oldSize, files.end(), isBefore);
+
+    // The merge is stable, so if a file was already in the list, its old entry is kept
+    files.erase (std::unique (files.begin(), files.end(), [] (const FileInfo& a, const FileInfo& b)
+                 {
+                     return a.filename == b.filename;
+                 }),
+                 files.end());
+
+    return files.size() > oldSize;
+}
+
+bool DirectoryContentsList::addFile (const File& file, const bool isDir,
+                                     const int64 fileSize,
+                                     Time modTime, Time creationTime,
+                                     const bool isReadOnly)
+{
+    if (! isSuitable (file, isDir))
+        return false;
+
+    FileInfo info;
+    info.filename         = file.getFileName();
+    info.fileSize         = fileSize;
+    info.modificationTime = modTime;
+    info.creationTime     = creationTime;
+    info.isDirectory      = isDir;
+    info.isReadOnly       = isReadOnly;
+
+    std::vector<FileInfo> batch;
+    batch.push_back (std::move (info));
+    return addFiles (std::move (batch));
 }
 
 } // namespace juce
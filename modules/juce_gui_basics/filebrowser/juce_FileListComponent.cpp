@@ -69,16 +69,15 @@ void FileListComponent::setSelectedFile (const File& f)
 {
     if (! directoryContentsList.isStillLoading())
     {
-        for (int i = directoryContentsList.getNumFiles(); --i >= 0;)
+        auto index = directoryContentsList.indexOf (f);
+
+        if (index >= 0)
         {
-            if (directoryContentsList.getFile (i) == f)
-            {
-                fileWaitingToBeSelected = File();
+            fileWaitingToBeSelected = File();
 
-                updateContent();
-                selectRow (i);
-                return;
-            }
+            updateContent();
+            selectRow (index);
+            return;
         }
     }
 
@@ -45,19 +45,7 @@ public:
           subContentsList (nullptr, false),
           thread (t)
     {
-        DirectoryContentsList::FileInfo fileInfo;
-
-        if (parentContents != nullptr
-             && parentContents->getFileInfo (indexInContents, fileInfo))
-        {
-            fileSize = File::descriptionOfSizeInBytes (fileInfo.fileSize);
-            modTime = fileInfo.modificationTime.formatted ("%d %b '%y %H:%M");
-            isDirectory = fileInfo.isDirectory;
-        }
-        else
-        {
-            isDirectory = true;
-        }
+        updateFileInfo();
     }
 
     ~FileListTreeItem() override
@@ -88,6 +76,7 @@ public:
                 {
                     auto l = new DirectoryContentsList (parentContentsList->getFilter(), thread);
 
+                    l->setThreadPool (parentContentsList->getThreadPool());
                     l->setDirectory (file,
                                      parentContentsList->isFindingDirectories(),
                                      parentContentsList->isFindingFiles());
@@ -150,14 +139,52 @@ public:
 
     void rebuildItemsFromContentList()
     {
-        clearSubItems();
+        if (! isOpen() || subContentsList == nullptr)
+        {
+            clearSubItems();
+            return;
+        }
+
+        // The list only changes by having new files merged into it while it loads, so the
+        // existing items are kept (along with their openness and selection), and only the
+        // items for the new files are created
+        int itemIndex = 0;
 
-        if (isOpen() && subContentsList != nullptr)
+        for (int i = 0; i < subContentsList->getNumFiles(); ++i)
         {
-            for (int i = 0; i < subContentsList->getNumFiles(); ++i)
-                addSubItem (new FileListTreeItem (owner, subContentsList, i,
-                                                  subContentsList->getFile(i), thread));
+            auto newFile = subContentsList->getFile (i);
+
+            if (newFile == File())
+                break;
+
+            while (itemIndex < getNumSubItems())
+            {
+                auto* item = static_cast<FileListTreeItem*> (getSubItem (itemIndex));
+
+                if (item->file == newFile || subContentsList->contains (item->file))
+                    break;
+
+                removeSubItem (itemIndex);
+            }
+
+            auto* item = itemIndex < getNumSubItems() ? static_cast<FileListTreeItem*> (getSubItem (itemIndex))
+                                                      : nullptr;
+
+            if (item != nullptr && item->file == newFile)
+            {
+                item->indexInContentsList = i;
+                item->updateFileInfo();
+            }
+            else
+            {
+                addSubItem (new FileListTreeItem (owner, subContentsList, i, newFile, thread), itemIndex);
+            }
+
+            ++itemIndex;
         }
+
+        while (getNumSubItems() > itemIndex)
+            removeSubItem (itemIndex);
     }
 
     void paintItem (Graphics& g, int width, int height) override
@@ -252,6 +279,23 @@ private:
     Image icon;
     String fileSize, modTime;
 
+    void updateFileInfo()
+    {
+        DirectoryContentsList::FileInfo fileInfo;
+
+        if (parentContentsList != nullptr
+             && parentContentsList->getFileInfo (indexInContentsList, fileInfo))
+        {
+            fileSize = File::descriptionOfSizeInBytes (fileInfo.fileSize);
+            modTime = fileInfo.modificationTime.formatted ("%d %b '%y %H:%M");
+            isDirectory = fileInfo.isDirectory;
+        }
+        else
+        {
+            isDirectory = true;
+        }
+    }
+
     void updateIcon (const bool onlyUpdateIfCached)
     {
         if (icon.isNull())
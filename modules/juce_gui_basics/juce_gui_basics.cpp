@@ -187,6 +187,7 @@ namespace juce
 #include "drawables/juce_DrawableRectangle.cpp"
 #include "drawables/juce_DrawableShape.cpp"
 #include "drawables/juce_DrawableText.cpp"
+#include "drawables/juce_DrawableDisplayList.cpp"
 #include "drawables/juce_SVGParser.cpp"
 #include "filebrowser/juce_DirectoryContentsDisplayComponent.cpp"
 #include "filebrowser/juce_DirectoryContentsList.cpp"
@@ -199,6 +200,7 @@ namespace juce
 #include "filebrowser/juce_FileTreeComponent.cpp"
 #include "filebrowser/juce_ImagePreviewComponent.cpp"
 #include "filebrowser/juce_ContentSharer.cpp"
+#include "layout/juce_FrameClock.cpp"
 #include "layout/juce_ComponentAnimator.cpp"
 #include "layout/juce_ComponentBoundsConstrainer.cpp"
 #include "layout/juce_ComponentBuilder.cpp"
@@ -388,6 +390,16 @@ namespace juce
         return std::make_unique<AccessibilityNativeImpl> (handler);
     }
    #endif
+
+    // The native element is only created once something asks for it, which normally
+    // means that an accessibility client is running
+    AccessibilityHandler::AccessibilityNativeImpl* AccessibilityHandler::getNativeImpl() const
+    {
+        if (nativeImpl == nullptr)
+            nativeImpl = createNativeImpl (const_cast<AccessibilityHandler&> (*this));
+
+        return nativeImpl.get();
+    }
 }
 
 //==============================================================================
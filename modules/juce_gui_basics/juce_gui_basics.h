@@ -185,6 +185,7 @@ namespace juce
 #include "components/juce_ComponentListener.h"
 #include "components/juce_CachedComponentImage.h"
 #include "components/juce_Component.h"
+#include "layout/juce_FrameClock.h"
 #include "layout/juce_ComponentAnimator.h"
 #include "desktop/juce_Desktop.h"
 #include "desktop/juce_Displays.h"
@@ -248,6 +249,7 @@ namespace juce
 #include "drawables/juce_DrawablePath.h"
 #include "drawables/juce_DrawableRectangle.h"
 #include "drawables/juce_DrawableText.h"
+#include "drawables/juce_DrawableDisplayList.h"
 #include "widgets/juce_TextEditor.h"
 #include "widgets/juce_Label.h"
 #include "widgets/juce_ComboBox.h"
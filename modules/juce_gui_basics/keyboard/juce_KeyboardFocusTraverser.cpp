@@ -98,7 +98,9 @@ struct KeyboardFocusTraverserTests  : public UnitTest
 {
     KeyboardFocusTraverserTests()
         : UnitTest ("KeyboardFocusTraverser", UnitTestCategories::gui)
-    {}
+    {
+        setIsolation (Isolation::messageThread);
+    }
 
     void runTest() override
     {
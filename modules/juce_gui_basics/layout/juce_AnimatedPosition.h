@@ -35,7 +35,7 @@ namespace juce
     thrown around with the mouse/touch, and by writing your own behaviour class, you can
     customise the trajectory that it follows when released.
 
-    The class uses its own Timer to continuously change its value when a drag ends, and
+    The class uses the FrameClock to continuously change its value when a drag ends, and
     Listener objects can be registered to receive callbacks whenever the value changes.
 
     The value is stored as a double, and can be used to represent whatever units you need.
@@ -50,7 +50,7 @@ namespace juce
     @tags{GUI}
 */
 template <typename Behaviour>
-class AnimatedPosition  : private Timer
+class AnimatedPosition  : private FrameClock::Listener
 {
 public:
     AnimatedPosition()
@@ -59,6 +59,12 @@ public:
     {
     }
 
+    /** Destructor. */
+    ~AnimatedPosition() override
+    {
+        stopAnimating();
+    }
+
     /** Sets a range within which the value will be constrained. */
     void setLimits (Range<double> newRange) noexcept
     {
@@ -78,7 +84,7 @@ public:
     {
         grabbedPos = position;
         releaseVelocity = 0;
-        stopTimer();
+        stopAnimating();
     }
 
     /** Called during a mouse-drag operation, to indicate that the mouse has moved.
@@ -95,7 +101,7 @@ public:
     */
     void endDrag()
     {
-        startTimerHz (60);
+        startAnimating (0.0);
     }
 
     /** Called outside of a drag operation to cause a nudge in the specified direction.
@@ -103,7 +109,7 @@ public:
     */
     void nudge (double deltaFromCurrentPosition)
     {
-        startTimerHz (10);
+        startAnimating (100.0);
         moveTo (position + deltaFromCurrentPosition);
     }
 
@@ -120,7 +126,7 @@ public:
     */
     void setPosition (double newPosition)
     {
-        stopTimer();
+        stopAnimating();
         setPositionAndSendChange (newPosition);
     }
 
@@ -155,8 +161,25 @@ private:
     double position = 0.0, grabbedPos = 0.0, releaseVelocity = 0.0;
     Range<double> range;
     Time lastUpdate, lastDrag;
+    double animationStartTime = 0.0;
+    bool isAnimating = false;
     ListenerList<Listener> listeners;
 
+    void startAnimating (double delayMs)
+    {
+        animationStartTime = Time::getMillisecondCounterHiRes() + delayMs;
+
+        if (! std::exchange (isAnimating, true))
+            FrameClock::getInstance()->addListener (this);
+    }
+
+    void stopAnimating()
+    {
+        if (std::exchange (isAnimating, false))
+            if (auto* clock = FrameClock::getInstanceWithoutCreating())
+                clock->removeListener (this);
+    }
+
     static double getSpeed (const Time last, double lastPos,
                             const Time now, double newPos)
     {
@@ -186,17 +209,18 @@ private:
         }
     }
 
-    void timerCallback() override
+    void frameClockTick (double frameTimeMs) override
     {
+        if (frameTimeMs < animationStartTime)
+            return;
+
         auto now = Time::getCurrentTime();
         auto elapsed = jlimit (0.001, 0.020, (now - lastUpdate).inSeconds());
         lastUpdate = now;
         auto newPos = behaviour.getNextPosition (position, elapsed);
 
         if (behaviour.isStopped (newPos))
-            stopTimer();
-        else
-            startTimerHz (60);
+            stopAnimating();
 
         setPositionAndSendChange (newPos);
     }
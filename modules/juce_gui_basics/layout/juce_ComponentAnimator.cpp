@@ -214,8 +214,12 @@ private:
 };
 
 //==============================================================================
-ComponentAnimator::ComponentAnimator()  : lastTime (0) {}
-ComponentAnimator::~ComponentAnimator() {}
+ComponentAnimator::ComponentAnimator() {}
+
+ComponentAnimator::~ComponentAnimator()
+{
+    stopListeningToClock();
+}
 
 //==============================================================================
 ComponentAnimator::AnimationTask* ComponentAnimator::findTaskFor (Component* const component) const noexcept
@@ -252,10 +256,11 @@ void ComponentAnimator::animateComponent (Component* const component,
         at->reset (finalBounds, finalAlpha, millisecondsToSpendMoving,
                    useProxyComponent, startSpeed, endSpeed);
 
-        if (! isTimerRunning())
+        if (! isListeningToClock)
         {
-            lastTime = Time::getMillisecondCounter();
-            startTimerHz (50);
+            lastTime = Time::getMillisecondCounterHiRes();
+            isListeningToClock = true;
+            FrameClock::getInstance()->addListener (this);
         }
     }
 }
@@ -327,14 +332,17 @@ bool ComponentAnimator::isAnimating() const noexcept
     return tasks.size() != 0;
 }
 
-void ComponentAnimator::timerCallback()
+void ComponentAnimator::stopListeningToClock()
 {
-    auto timeNow = Time::getMillisecondCounter();
-
-    if (lastTime == 0)
-        lastTime = timeNow;
+    if (std::exchange (isListeningToClock, false))
+        if (auto* clock = FrameClock::getInstanceWithoutCreating())
+            clock->removeListener (this);
+}
 
-    auto elapsed = (int) (timeNow - lastTime);
+void ComponentAnimator::frameClockTick (double frameTimeMs)
+{
+    // (Only whole milliseconds are used up, so that the remainders aren't lost)
+    auto elapsed = (int) (frameTimeMs - lastTime);
 
     for (auto* task : Array<AnimationTask*> (tasks.begin(), tasks.size()))
     {
@@ -345,10 +353,10 @@ void ComponentAnimator::timerCallback()
         }
     }
 
-    lastTime = timeNow;
+    lastTime += elapsed;
 
     if (tasks.size() == 0)
-        stopTimer();
+        stopListeningToClock();
 }
 
 } // namespace juce
@@ -45,12 +45,14 @@ namespace juce
     The class is a ChangeBroadcaster and sends a notification when any components
     start or finish being animated.
 
-    @see Desktop::getAnimator
+    The animations are updated once per display frame by the FrameClock.
+
+    @see Desktop::getAnimator, FrameClock
 
     @tags{GUI}
 */
 class JUCE_API  ComponentAnimator  : public ChangeBroadcaster,
-                                     private Timer
+                                     private FrameClock::Listener
 {
 public:
     //==============================================================================
@@ -151,10 +153,12 @@ private:
     //==============================================================================
     class AnimationTask;
     OwnedArray<AnimationTask> tasks;
-    uint32 lastTime;
+    double lastTime = 0;
+    bool isListeningToClock = false;
 
     AnimationTask* findTaskFor (Component*) const noexcept;
-    void timerCallback() override;
+    void stopListeningToClock();
+    void frameClockTick (double) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentAnimator)
 };
@@ -32,14 +32,24 @@ struct FlexBoxLayoutCalculation
 
     enum class Axis { main, cross };
 
-    FlexBoxLayoutCalculation (FlexBox& fb, Coord w, Coord h)
+    struct Scratch;
+
+    FlexBoxLayoutCalculation (FlexBox& fb, Scratch& scratch, Coord w, Coord h)
         : owner (fb), parentWidth (w), parentHeight (h), numItems (owner.items.size()),
           isRowDirection (fb.flexDirection == FlexBox::Direction::row
                        || fb.flexDirection == FlexBox::Direction::rowReverse),
-          containerLineLength (getContainerSize (Axis::main))
+          containerLineLength (getContainerSize (Axis::main)),
+          lineItems (scratch.lineItems), lineInfo (scratch.lineInfo), itemStates (scratch.itemStates)
     {
-        lineItems.calloc (numItems * numItems);
-        lineInfo.calloc (numItems);
+        if (scratch.capacity < numItems)
+        {
+            scratch.capacity = numItems;
+            lineItems.malloc (numItems);
+            lineInfo.malloc (numItems);
+        }
+
+        lineInfo.clear ((size_t) numItems);
+        itemStates.clearQuick();
     }
 
     struct ItemWithState
@@ -65,10 +75,19 @@ struct FlexBoxLayoutCalculation
 
     struct RowInfo
     {
-        int numItems;
+        int numItems, firstItem;
         Coord crossSize, lineY, totalLength;
     };
 
+    // Working storage that's kept between layouts, so that laying out again doesn't allocate
+    struct Scratch
+    {
+        HeapBlock<ItemWithState*> lineItems;
+        HeapBlock<RowInfo> lineInfo;
+        Array<ItemWithState> itemStates;
+        int capacity = 0;
+    };
+
     FlexBox& owner;
     const Coord parentWidth, parentHeight;
     const int numItems;
@@ -78,11 +97,11 @@ struct FlexBoxLayoutCalculation
     int numberOfRows = 1;
     Coord containerCrossLength = 0;
 
-    HeapBlock<ItemWithState*> lineItems;
-    HeapBlock<RowInfo> lineInfo;
-    Array<ItemWithState> itemStates;
+    HeapBlock<ItemWithState*>& lineItems;
+    HeapBlock<RowInfo>& lineInfo;
+    Array<ItemWithState>& itemStates;
 
-    ItemWithState& getItem (int x, int y) const noexcept     { return *lineItems[y * numItems + x]; }
+    ItemWithState& getItem (int x, int y) const noexcept     { return *lineItems[lineInfo[y].firstItem + x]; }
 
     static bool isAuto (Coord value) noexcept                { return value == FlexItem::autoValue; }
     static bool isAssigned (Coord value) noexcept            { return value != FlexItem::notAssigned; }
@@ -181,7 +200,7 @@ struct FlexBoxLayoutCalculation
         else // if multi-line, group the flexbox items into multiple lines
         {
             auto currentLength = containerLineLength;
-            int column = 0, row = 0;
+            int column = 0, row = 0, index = 0;
             bool firstRow = true;
 
             for (auto& item : itemStates)
@@ -204,7 +223,11 @@ struct FlexBoxLayoutCalculation
                 }
 
                 currentLength -= flexitemLength;
-                lineItems[row * numItems + column] = &item;
+
+                if (column == 0)
+                    lineInfo[row].firstItem = index;
+
+                lineItems[index++] = &item;
                 ++column;
                 lineInfo[row].numItems = jmax (lineInfo[row].numItems, column);
                 firstRow = false;
@@ -737,6 +760,70 @@ private:
     }
 };
 
+//==============================================================================
+struct FlexBox::LayoutCache
+{
+    bool matches (const FlexBox& box, Rectangle<float> area) const noexcept
+    {
+        if (! isValid
+             || area.getWidth() != width || area.getHeight() != height
+             || box.flexDirection != flexDirection || box.flexWrap != flexWrap
+             || box.alignContent != alignContent || box.alignItems != alignItems
+             || box.justifyContent != justifyContent
+             || box.items.size() != items.size())
+            return false;
+
+        for (int i = 0; i < items.size(); ++i)
+            if (! haveSameLayoutProperties (box.items.getReference (i), items.getReference (i)))
+                return false;
+
+        return true;
+    }
+
+    // Must be called before the items' bounds are moved to the target area's position
+    void store (const FlexBox& box, Rectangle<float> area)
+    {
+        isValid = true;
+        width = area.getWidth();
+        height = area.getHeight();
+        flexDirection = box.flexDirection;
+        flexWrap = box.flexWrap;
+        alignContent = box.alignContent;
+        alignItems = box.alignItems;
+        justifyContent = box.justifyContent;
+
+        items.clearQuick();
+        items.addArray (box.items);
+    }
+
+    void restoreBounds (FlexBox& box) const noexcept
+    {
+        for (int i = 0; i < items.size(); ++i)
+            box.items.getReference (i).currentBounds = items.getReference (i).currentBounds;
+    }
+
+    static bool haveSameLayoutProperties (const FlexItem& a, const FlexItem& b) noexcept
+    {
+        return a.order == b.order
+            && a.flexGrow == b.flexGrow && a.flexShrink == b.flexShrink && a.flexBasis == b.flexBasis
+            && a.alignSelf == b.alignSelf
+            && a.width == b.width && a.minWidth == b.minWidth && a.maxWidth == b.maxWidth
+            && a.height == b.height && a.minHeight == b.minHeight && a.maxHeight == b.maxHeight
+            && a.margin.left == b.margin.left && a.margin.right == b.margin.right
+            && a.margin.top == b.margin.top && a.margin.bottom == b.margin.bottom;
+    }
+
+    FlexBoxLayoutCalculation::Scratch scratch;
+    Array<FlexItem> items;
+    float width = 0, height = 0;
+    FlexBox::Direction flexDirection {};
+    FlexBox::Wrap flexWrap {};
+    FlexBox::AlignContent alignContent {};
+    FlexBox::AlignItems alignItems {};
+    FlexBox::JustifyContent justifyContent {};
+    bool isValid = false;
+};
+
 //==============================================================================
 FlexBox::FlexBox (JustifyContent jc) noexcept  : justifyContent (jc) {}
 
@@ -749,19 +836,32 @@ void FlexBox::performLayout (Rectangle<float> targetArea)
 {
     if (! items.isEmpty())
     {
-        FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
-
-        layout.createStates();
-        layout.initialiseItems();
-        layout.resolveFlexibleLengths();
-        layout.resolveAutoMarginsOnMainAxis();
-        layout.calculateCrossSizesByLine();
-        layout.calculateCrossSizeOfAllItems();
-        layout.alignLinesPerAlignContent();
-        layout.resolveAutoMarginsOnCrossAxis();
-        layout.alignItemsInCrossAxisInLinesPerAlignSelf();
-        layout.alignItemsByJustifyContent();
-        layout.layoutAllItems();
+        // Copies of a FlexBox share its cache, which is fine because it's keyed on all of the inputs
+        if (layoutCache == nullptr)
+            layoutCache = std::make_shared<LayoutCache>();
+
+        if (layoutCache->matches (*this, targetArea))
+        {
+            layoutCache->restoreBounds (*this);
+        }
+        else
+        {
+            FlexBoxLayoutCalculation layout (*this, layoutCache->scratch, targetArea.getWidth(), targetArea.getHeight());
+
+            layout.createStates();
+            layout.initialiseItems();
+            layout.resolveFlexibleLengths();
+            layout.resolveAutoMarginsOnMainAxis();
+            layout.calculateCrossSizesByLine();
+            layout.calculateCrossSizeOfAllItems();
+            layout.alignLinesPerAlignContent();
+            layout.resolveAutoMarginsOnCrossAxis();
+            layout.alignItemsInCrossAxisInLinesPerAlignSelf();
+            layout.alignItemsByJustifyContent();
+            layout.layoutAllItems();
+
+            layoutCache->store (*this, targetArea);
+        }
 
         for (auto& item : items)
         {
@@ -1131,6 +1231,28 @@ public:
                 expect (flex.items[2].currentBounds == Rectangle<float> (rect.getX(), rect.getBottom() + spacer, 10.0f, 10.0f));
             }
         }
+
+        beginTest ("a cached layout is recalculated when the items or the size of the area change");
+        {
+            juce::FlexBox flex;
+            flex.items = { FlexItem().withFlex (1.0f), FlexItem().withFlex (1.0f) };
+
+            flex.performLayout (rect);
+            expect (flex.items[1].currentBounds == Rectangle<float> (rect.getX() + 150.0f, rect.getY(), 150.0f, rect.getHeight()));
+
+            flex.performLayout (rect);
+            expect (flex.items[1].currentBounds == Rectangle<float> (rect.getX() + 150.0f, rect.getY(), 150.0f, rect.getHeight()));
+
+            flex.items.getReference (0).flexGrow = 3.0f;
+            flex.performLayout (rect);
+            expect (flex.items[1].currentBounds == Rectangle<float> (rect.getX() + 225.0f, rect.getY(), 75.0f, rect.getHeight()));
+
+            flex.performLayout (rect.withWidth (100.0f));
+            expect (flex.items[1].currentBounds == Rectangle<float> (rect.getX() + 75.0f, rect.getY(), 25.0f, rect.getHeight()));
+
+            flex.performLayout (rect.withWidth (100.0f).translated (5.0f, 5.0f));
+            expect (flex.items[1].currentBounds == Rectangle<float> (rect.getX() + 80.0f, rect.getY() + 5.0f, 25.0f, rect.getHeight()));
+        }
     }
 };
 
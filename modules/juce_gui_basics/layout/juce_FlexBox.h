@@ -100,7 +100,12 @@ public:
     FlexBox (JustifyContent) noexcept;
 
     //==============================================================================
-    /** Lays-out the box's items within the given rectangle. */
+    /** Lays-out the box's items within the given rectangle.
+
+        The result is cached, so if the size of the area, the box's properties and
+        its items haven't changed since the last call, the previous bounds are just
+        applied again rather than being recalculated.
+    */
     void performLayout (Rectangle<float> targetArea);
 
     /** Lays-out the box's items within the given rectangle. */
@@ -137,6 +142,9 @@ public:
     Array<FlexItem> items;
 
 private:
+    struct LayoutCache;
+    std::shared_ptr<LayoutCache> layoutCache;
+
     JUCE_LEAK_DETECTOR (FlexBox)
 };
 
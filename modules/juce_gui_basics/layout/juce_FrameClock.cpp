@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FrameClock::VBlankSource  : private ComponentPeer::VBlankListener
+{
+public:
+    VBlankSource (FrameClock& c, ComponentPeer& p)  : peer (&p), clock (c)
+    {
+        peer->addVBlankListener (this);
+    }
+
+    ~VBlankSource() override
+    {
+        if (ComponentPeer::isValidPeer (peer))
+            peer->removeVBlankListener (this);
+    }
+
+    bool hasStalled() const noexcept
+    {
+        return Time::getMillisecondCounterHiRes() - lastVBlankTime > 50.0;
+    }
+
+    ComponentPeer* const peer;
+
+private:
+    void onVBlank() override
+    {
+        lastVBlankTime = Time::getMillisecondCounterHiRes();
+        clock.deliverFrame();
+    }
+
+    double lastVBlankTime = Time::getMillisecondCounterHiRes();
+
+    FrameClock& clock;
+
+    JUCE_DECLARE_NON_COPYABLE (VBlankSource)
+};
+
+//==============================================================================
+FrameClock::FrameClock() {}
+
+FrameClock::~FrameClock()
+{
+    clearSingletonInstance();
+}
+
+JUCE_IMPLEMENT_SINGLETON (FrameClock)
+
+//==============================================================================
+void FrameClock::addListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    listeners.add (listener);
+
+    if (! isTimerRunning())
+        updateFrameSource();
+}
+
+void FrameClock::removeListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // The frame source is released by the next timer callback, because this may be
+    // called from inside one of its own callbacks
+    listeners.remove (listener);
+}
+
+void FrameClock::deliverFrame()
+{
+    lastFrameTime = Time::getMillisecondCounterHiRes();
+    listeners.call ([this] (Listener& l) { l.frameClockTick (lastFrameTime); });
+}
+
+void FrameClock::updateFrameSource()
+{
+    auto* peer = ComponentPeer::getNumPeers() > 0 ? ComponentPeer::getPeer (0) : nullptr;
+
+    if (listeners.isEmpty())
+        peer = nullptr;
+
+    if (vBlankSource != nullptr && vBlankSource->peer != peer)
+        vBlankSource.reset();
+
+    if (vBlankSource == nullptr && peer != nullptr)
+        vBlankSource = std::make_unique<VBlankSource> (*this, *peer);
+
+    if (listeners.isEmpty())
+        stopTimer();
+    else if (vBlankSource == nullptr)
+        startTimerHz (60);
+    else if (! isTimerRunning())
+        startTimerHz (10);
+}
+
+void FrameClock::timerCallback()
+{
+    updateFrameSource();
+
+    if (! isTimerRunning())
+        return;
+
+    if (vBlankSource == nullptr)
+    {
+        deliverFrame();
+        return;
+    }
+
+    // While the vertical blank callbacks are arriving, this timer just checks that
+    // they haven't stopped. If they have, it takes over until they start again.
+    const auto stalled = vBlankSource->hasStalled();
+
+    if (stalled)
+        deliverFrame();
+
+    startTimerHz (stalled ? 60 : 10);
+}
+
+} // namespace juce
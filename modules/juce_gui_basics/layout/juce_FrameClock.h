@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Calls its listeners once for every frame that the display shows.
+
+    Animations and meters that need updating continuously can register with the
+    FrameClock instead of each running their own Timer. All the listeners are called
+    one after another from a single callback per frame, so the changes they make get
+    painted together, and they keep in step with the display's refresh rate rather
+    than drifting against it.
+
+    While there are any windows on screen, the frames come from the vertical blank
+    callbacks of the first ComponentPeer (see ComponentPeer::VBlankListener). If there
+    aren't any windows, or the vertical blank callbacks stop arriving (which some
+    platforms do for hidden windows), a 60Hz Timer is used instead.
+
+    All callbacks are made on the message thread.
+
+    @see VBlankAttachment, ComponentAnimator, AnimatedPosition
+
+    @tags{GUI}
+*/
+class JUCE_API  FrameClock  : private Timer,
+                              private DeletedAtShutdown
+{
+public:
+    //==============================================================================
+    /** Receives a callback for each frame from a FrameClock. */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() = default;
+
+        /** Called once per frame.
+
+            The frame time is the value of Time::getMillisecondCounterHiRes() when the
+            frame began, and is the same for all the listeners that are called for it.
+        */
+        virtual void frameClockTick (double frameTimeMs) = 0;
+    };
+
+    //==============================================================================
+    /** Registers a listener to be called for each frame.
+
+        The clock only runs while it has listeners, so remove them when they don't need
+        callbacks any more.
+    */
+    void addListener (Listener* listener);
+
+    /** Removes a previously-registered listener.
+
+        This is safe to call from inside a listener's callback.
+    */
+    void removeListener (Listener* listener);
+
+    /** Returns the time at which the most recent frame began, as a
+        Time::getMillisecondCounterHiRes() value.
+    */
+    double getLastFrameTime() const noexcept                    { return lastFrameTime; }
+
+    //==============================================================================
+   #ifndef DOXYGEN
+    JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL (FrameClock)
+   #endif
+
+private:
+    //==============================================================================
+    class VBlankSource;
+    std::unique_ptr<VBlankSource> vBlankSource;
+    ListenerList<Listener> listeners;
+    double lastFrameTime = 0;
+
+    FrameClock();
+    ~FrameClock() override;
+
+    void deliverFrame();
+    void updateFrameSource();
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE (FrameClock)
+};
+
+} // namespace juce
@@ -405,20 +405,23 @@ struct Grid::PlacementHelpers
     }
 
     //==============================================================================
-    static float getCoord (int trackNumber, float relativeUnit, Px gap, const Array<TrackInfo>& tracks)
+    static void getTrackStarts (Array<float>& starts, float relativeUnit, Px gap, const Array<TrackInfo>& tracks)
     {
+        starts.clearQuick();
         float c = 0;
 
-        for (const auto* it = tracks.begin(); it != tracks.begin() + trackNumber; ++it)
-            c += it->getAbsoluteSize (relativeUnit) + static_cast<float> (gap.pixels);
-
-        return c;
+        for (const auto& track : tracks)
+        {
+            starts.add (c);
+            c += track.getAbsoluteSize (relativeUnit) + static_cast<float> (gap.pixels);
+        }
     }
 
     static Rectangle<float> getCellBounds (int columnNumber, int rowNumber,
                                            const Tracks& tracks,
                                            SizeCalculation calculation,
-                                           Px columnGap, Px rowGap)
+                                           const Array<float>& columnStarts,
+                                           const Array<float>& rowStarts)
     {
         const auto correctedColumn = columnNumber - 1 + tracks.columns.numImplicitLeading;
         const auto correctedRow    = rowNumber    - 1 + tracks.rows   .numImplicitLeading;
@@ -426,8 +429,8 @@ struct Grid::PlacementHelpers
         jassert (isPositiveAndBelow (correctedColumn, tracks.columns.items.size()));
         jassert (isPositiveAndBelow (correctedRow,    tracks.rows   .items.size()));
 
-        return { getCoord (correctedColumn, calculation.relativeWidthUnit,  columnGap, tracks.columns.items),
-                 getCoord (correctedRow,    calculation.relativeHeightUnit, rowGap,    tracks.rows   .items),
+        return { columnStarts.getUnchecked (correctedColumn),
+                 rowStarts   .getUnchecked (correctedRow),
                  tracks.columns.items.getReference (correctedColumn).getAbsoluteSize (calculation.relativeWidthUnit),
                  tracks.rows   .items.getReference (correctedRow)   .getAbsoluteSize (calculation.relativeHeightUnit) };
     }
@@ -502,11 +505,12 @@ struct Grid::PlacementHelpers
                                            SizeCalculation calculation,
                                            AlignContent alignContent,
                                            JustifyContent justifyContent,
-                                           Px columnGap, Px rowGap)
+                                           const Array<float>& columnStarts,
+                                           const Array<float>& rowStarts)
     {
         const auto findAlignedCell = [&] (int column, int row)
         {
-            const auto cell = getCellBounds (column, row, tracks, calculation, columnGap, rowGap);
+            const auto cell = getCellBounds (column, row, tracks, calculation, columnStarts, rowStarts);
             return alignCell (cell,
                               column,
                               row,
@@ -894,20 +898,22 @@ struct Grid::AutoPlacement
         {
             auto& array = tracksInDirection.items;
 
-            for (int index = 0; index < array.size(); ++index)
+            for (auto& track : array)
+                if (track.isAuto())
+                    track.size = 0.0f;
+
+            for (const auto& element : placements)
             {
-                if (array.getReference (index).isAuto())
+                const auto item = getItem (element.second);
+                const auto isNotSpan = std::abs (item.end - item.start) <= 1;
+                const auto index = item.start - 1 + tracksInDirection.numImplicitLeading;
+
+                if (isNotSpan && isPositiveAndBelow (index, array.size()))
                 {
-                    const auto combiner = [&] (const auto acc, const auto& element)
-                    {
-                        const auto item = getItem (element.second);
-                        const auto isNotSpan = std::abs (item.end - item.start) <= 1;
-                        return isNotSpan && item.start == index + 1 - tracksInDirection.numImplicitLeading
-                               ? std::max (acc, getItemSize (*element.first))
-                               : acc;
-                    };
-
-                    array.getReference (index).size = std::accumulate (placements.begin(), placements.end(), 0.0f, combiner);
+                    auto& track = array.getReference (index);
+
+                    if (track.isAuto())
+                        track.size = std::max (track.size, getItemSize (*element.first));
                 }
             }
         };
@@ -964,6 +970,90 @@ struct Grid::BoxAlignment
     }
 };
 
+//==============================================================================
+struct Grid::LayoutCache
+{
+    bool hasSamePlacement (const Grid& grid) const
+    {
+        if (! isValid
+             || grid.autoFlow != autoFlow
+             || ! haveSameTracks (grid.templateColumns, templateColumns)
+             || ! haveSameTracks (grid.templateRows, templateRows)
+             || ! isSameTrack (grid.autoColumns, autoColumns)
+             || ! isSameTrack (grid.autoRows, autoRows)
+             || grid.templateAreas != templateAreas
+             || grid.items.size() != items.size())
+            return false;
+
+        for (int i = 0; i < items.size(); ++i)
+            if (! haveSamePlacementProperties (grid.items.getReference (i), items.getReference (i)))
+                return false;
+
+        return true;
+    }
+
+    void storePlacement (const Grid& grid, const AutoPlacement::ItemPlacementArray& itemsAndAreas, Tracks newTracks)
+    {
+        isValid = true;
+        autoFlow = grid.autoFlow;
+        templateColumns = grid.templateColumns;
+        templateRows = grid.templateRows;
+        autoColumns = grid.autoColumns;
+        autoRows = grid.autoRows;
+        templateAreas = grid.templateAreas;
+
+        items.clearQuick();
+        items.addArray (grid.items);
+
+        placements.clearQuick();
+
+        for (const auto& itemAndArea : itemsAndAreas)
+            placements.add ({ (int) (itemAndArea.first - grid.items.begin()), itemAndArea.second });
+
+        tracks = std::move (newTracks);
+    }
+
+    static bool isSameTrack (const TrackInfo& a, const TrackInfo& b)
+    {
+        return a.size == b.size && a.isFraction == b.isFraction && a.hasKeyword == b.hasKeyword
+            && a.startLineName == b.startLineName && a.endLineName == b.endLineName;
+    }
+
+    static bool haveSameTracks (const Array<TrackInfo>& a, const Array<TrackInfo>& b)
+    {
+        return std::equal (a.begin(), a.end(), b.begin(), b.end(), isSameTrack);
+    }
+
+    static bool isSameProperty (const GridItem::Property& a, const GridItem::Property& b)
+    {
+        return a.hasSpan() == b.hasSpan() && a.hasAuto() == b.hasAuto()
+            && a.getNumber() == b.getNumber() && a.getName() == b.getName();
+    }
+
+    // The properties used to place an item and to size the auto tracks it's in
+    static bool haveSamePlacementProperties (const GridItem& a, const GridItem& b)
+    {
+        return a.order == b.order
+            && a.area == b.area
+            && isSameProperty (a.column.start, b.column.start) && isSameProperty (a.column.end, b.column.end)
+            && isSameProperty (a.row.start, b.row.start) && isSameProperty (a.row.end, b.row.end)
+            && a.width == b.width && a.height == b.height
+            && a.margin.left == b.margin.left && a.margin.right == b.margin.right
+            && a.margin.top == b.margin.top && a.margin.bottom == b.margin.bottom;
+    }
+
+    Array<TrackInfo> templateColumns, templateRows;
+    TrackInfo autoColumns, autoRows;
+    StringArray templateAreas;
+    AutoFlow autoFlow {};
+    Array<GridItem> items;
+
+    Array<std::pair<int, PlacementHelpers::LineArea>> placements;
+    Tracks tracks;
+    Array<float> columnStarts, rowStarts;
+    bool isValid = false;
+};
+
 //==============================================================================
 Grid::TrackInfo::TrackInfo() noexcept : hasKeyword (true) {}
 
@@ -1017,11 +1107,24 @@ float Grid::TrackInfo::getAbsoluteSize (float relativeFractionalUnit) const
 //==============================================================================
 void Grid::performLayout (Rectangle<int> targetArea)
 {
-    const auto itemsAndAreas = AutoPlacement().deduceAllItems (*this);
+    // Copies of a Grid share its cache, which is fine because it's keyed on all of the inputs
+    if (layoutCache == nullptr)
+        layoutCache = std::make_shared<LayoutCache>();
 
-    auto implicitTracks = AutoPlacement::createImplicitTracks (*this, itemsAndAreas);
+    auto& cache = *layoutCache;
+
+    if (! cache.hasSamePlacement (*this))
+    {
+        const auto itemsAndAreas = AutoPlacement().deduceAllItems (*this);
 
-    AutoPlacement::applySizeForAutoTracks (implicitTracks, itemsAndAreas);
+        auto implicitTracks = AutoPlacement::createImplicitTracks (*this, itemsAndAreas);
+
+        AutoPlacement::applySizeForAutoTracks (implicitTracks, itemsAndAreas);
+
+        cache.storePlacement (*this, itemsAndAreas, std::move (implicitTracks));
+    }
+
+    const auto& implicitTracks = cache.tracks;
 
     SizeCalculation calculation;
     calculation.computeSizes (targetArea.toFloat().getWidth(),
@@ -1030,24 +1133,27 @@ void Grid::performLayout (Rectangle<int> targetArea)
                               rowGap,
                               implicitTracks);
 
-    for (auto& itemAndArea : itemsAndAreas)
+    PlacementHelpers::getTrackStarts (cache.columnStarts, calculation.relativeWidthUnit,  columnGap, implicitTracks.columns.items);
+    PlacementHelpers::getTrackStarts (cache.rowStarts,    calculation.relativeHeightUnit, rowGap,    implicitTracks.rows   .items);
+
+    for (const auto& placement : cache.placements)
     {
-        const auto a = itemAndArea.second;
+        const auto a = placement.second;
         const auto areaBounds = PlacementHelpers::getAreaBounds (a.column,
                                                                  a.row,
                                                                  implicitTracks,
                                                                  calculation,
                                                                  alignContent,
                                                                  justifyContent,
-                                                                 columnGap,
-                                                                 rowGap);
+                                                                 cache.columnStarts,
+                                                                 cache.rowStarts);
 
-        auto* item = itemAndArea.first;
-        item->currentBounds = BoxAlignment::alignItem (*item, *this, areaBounds)
-                                + targetArea.toFloat().getPosition();
+        auto& item = items.getReference (placement.first);
+        item.currentBounds = BoxAlignment::alignItem (item, *this, areaBounds)
+                               + targetArea.toFloat().getPosition();
 
-        if (auto* c = item->associatedComponent)
-            c->setBounds (item->currentBounds.getSmallestIntegerContainer());
+        if (auto* c = item.associatedComponent)
+            c->setBounds (item.currentBounds.getSmallestIntegerContainer());
     }
 }
 
@@ -1355,6 +1461,33 @@ struct GridTests  : public UnitTest
             expect (grid.items[1].currentBounds == Rect (420.0f,  70.0f,  60.0f, 70.0f));
             expect (grid.items[2].currentBounds == Rect (200.0f, 330.0f, 200.0f, 70.0f));
         }
+
+        {
+            beginTest ("Grid cached placement is updated when the items or tracks change");
+
+            Grid grid;
+
+            grid.templateColumns = { Tr (1_fr), Tr (1_fr) };
+            grid.templateRows    = { Tr (1_fr) };
+
+            grid.items = { GridItem{}, GridItem{} };
+
+            grid.performLayout ({ 200, 100 });
+            expect (grid.items[1].currentBounds == Rect (100.0f, 0.0f, 100.0f, 100.0f));
+
+            grid.performLayout ({ 400, 100 });
+            expect (grid.items[1].currentBounds == Rect (200.0f, 0.0f, 200.0f, 100.0f));
+
+            grid.items.getReference (0).order = 1;
+            grid.performLayout ({ 400, 100 });
+            expect (grid.items[0].currentBounds == Rect (200.0f, 0.0f, 200.0f, 100.0f));
+            expect (grid.items[1].currentBounds == Rect (0.0f,   0.0f, 200.0f, 100.0f));
+
+            grid.templateColumns.add (Tr (2_fr));
+            grid.performLayout ({ 400, 100 });
+            expect (grid.items[0].currentBounds == Rect (100.0f, 0.0f, 100.0f, 100.0f));
+            expect (grid.items[1].currentBounds == Rect (0.0f,   0.0f, 100.0f, 100.0f));
+        }
     }
 };
 
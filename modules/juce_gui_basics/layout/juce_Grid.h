@@ -205,7 +205,12 @@ public:
     Array<GridItem> items;
 
     //==============================================================================
-    /** Lays-out the grid's items within the given rectangle. */
+    /** Lays-out the grid's items within the given rectangle.
+
+        The placement of the items in the grid's cells doesn't depend on its size, so
+        it's cached and only worked out again when the tracks or the items' placement
+        properties change.
+    */
     void performLayout (Rectangle<int>);
 
     //==============================================================================
@@ -220,6 +225,9 @@ private:
     struct PlacementHelpers;
     struct AutoPlacement;
     struct BoxAlignment;
+    struct LayoutCache;
+
+    std::shared_ptr<LayoutCache> layoutCache;
 };
 
 constexpr Grid::Px operator"" _px (long double px)          { return Grid::Px { px }; }
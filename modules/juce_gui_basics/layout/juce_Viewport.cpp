@@ -156,6 +156,124 @@ struct Viewport::DragToScrollListener   : private MouseListener,
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DragToScrollListener)
 };
 
+//==============================================================================
+/*  An image of the content holder, which is scrolled by moving the pixels that are
+    already in it, so that only the area that comes into view needs to be painted.
+*/
+struct Viewport::ScrollBlitImage  : public CachedComponentImage
+{
+    explicit ScrollBlitImage (Component& c) noexcept : owner (c) {}
+
+    void paint (Graphics& g) override
+    {
+        scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        auto compBounds = owner.getLocalBounds();
+        auto imageBounds = compBounds * scale;
+
+        if (image.isNull() || image.getBounds() != imageBounds)
+        {
+            image = Image (Image::ARGB, jmax (1, imageBounds.getWidth()), jmax (1, imageBounds.getHeight()), true);
+            validArea.clear();
+        }
+
+        if (! validArea.containsRectangle (compBounds))
+        {
+            Graphics imG (image);
+            auto& lg = imG.getInternalContext();
+
+            lg.addTransform (AffineTransform::scale (scale));
+
+            for (auto& i : validArea)
+                lg.excludeClipRectangle (i);
+
+            lg.setFill (Colours::transparentBlack);
+            lg.fillRect (compBounds, true);
+            lg.setFill (Colours::black);
+
+            owner.paintEntireComponent (imG, true);
+        }
+
+        validArea = compBounds;
+
+        g.setColour (Colours::black.withAlpha (owner.getAlpha()));
+        g.drawImageTransformed (image, AffineTransform::scale ((float) compBounds.getWidth()  / (float) imageBounds.getWidth(),
+                                                               (float) compBounds.getHeight() / (float) imageBounds.getHeight()), false);
+    }
+
+    bool invalidateAll() override
+    {
+        validArea.clear();
+        return true;
+    }
+
+    bool invalidate (const Rectangle<int>& area) override
+    {
+        // While the content is being scrolled, the holder is told to repaint the content's
+        // old and new positions. The peer still needs to repaint those areas, but the pixels
+        // in the image have already been moved into place.
+        if (! areasAlreadyMoved.isEmpty() && areasAlreadyMoved.getReference (0) == area)
+            areasAlreadyMoved.remove (0);
+        else
+            validArea.subtract (area);
+
+        return true;
+    }
+
+    void releaseResources() override
+    {
+        image = Image();
+        validArea.clear();
+    }
+
+    void moveContent (Component& content, Point<int> newPosition)
+    {
+        const auto delta = newPosition - content.getPosition();
+        const auto physicalDelta = delta.toFloat() * scale;
+        const auto pixelDelta = physicalDelta.roundToInt();
+
+        if (image.isNull()
+             || content.isTransformed()
+             || physicalDelta.getDistanceFrom (pixelDelta.toFloat()) > 0.001f)
+        {
+            invalidateAll();
+            content.setTopLeftPosition (newPosition);
+            return;
+        }
+
+        const auto imageBounds = image.getBounds();
+        const auto destArea = imageBounds.translated (pixelDelta.x, pixelDelta.y).getIntersection (imageBounds);
+
+        if (! destArea.isEmpty())
+            image.moveImageSection (destArea.getX(), destArea.getY(),
+                                    destArea.getX() - pixelDelta.x, destArea.getY() - pixelDelta.y,
+                                    destArea.getWidth(), destArea.getHeight());
+
+        const auto bounds = owner.getLocalBounds();
+        validArea.offsetAll (delta);
+        validArea.clipTo (bounds);
+
+        for (auto area : { content.getBounds(), content.getBounds().withPosition (newPosition) })
+        {
+            area = area.getIntersection (bounds);
+
+            if (! area.isEmpty())
+                areasAlreadyMoved.add (area);
+        }
+
+        content.setTopLeftPosition (newPosition);
+        areasAlreadyMoved.clearQuick();
+    }
+
+private:
+    Component& owner;
+    Image image;
+    RectangleList<int> validArea;
+    Array<Rectangle<int>> areasAlreadyMoved;
+    float scale = 1.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScrollBlitImage)
+};
+
 //==============================================================================
 Viewport::Viewport (const String& name)
     : Component (name),
@@ -269,7 +387,12 @@ void Viewport::setViewPosition (const int xPixelsOffset, const int yPixelsOffset
 void Viewport::setViewPosition (Point<int> newPosition)
 {
     if (contentComp != nullptr)
-        contentComp->setTopLeftPosition (viewportPosToCompPos (newPosition));
+    {
+        if (scrollBlitImage != nullptr)
+            scrollBlitImage->moveContent (*contentComp, viewportPosToCompPos (newPosition));
+        else
+            contentComp->setTopLeftPosition (viewportPosToCompPos (newPosition));
+    }
 }
 
 void Viewport::setViewPositionProportionately (const double x, const double y)
@@ -334,6 +457,15 @@ void Viewport::setScrollOnDragMode (const ScrollOnDragMode mode)
     scrollOnDragMode = mode;
 }
 
+void Viewport::setScrollBlittingEnabled (bool shouldCopyPixelsWhenScrolling)
+{
+    if (shouldCopyPixelsWhenScrolling != isScrollBlittingEnabled())
+    {
+        scrollBlitImage = shouldCopyPixelsWhenScrolling ? new ScrollBlitImage (contentHolder) : nullptr;
+        contentHolder.setCachedComponentImage (scrollBlitImage);
+    }
+}
+
 bool Viewport::isCurrentlyScrollingOnDrag() const noexcept
 {
     return dragToScrollListener->isDragging;
@@ -652,4 +784,124 @@ void Viewport::setScrollBarPosition (bool verticalScrollbarOnRight,
     resized();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ViewportTests  : public UnitTest
+{
+public:
+    ViewportTests()
+        : UnitTest ("Viewport", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Scroll blitting only paints the area that comes into view");
+        {
+            Stripes content;
+            Viewport viewport;
+            createViewport (viewport, content);
+            viewport.setScrollBlittingEnabled (true);
+            expect (viewport.isScrollBlittingEnabled());
+
+            viewport.createComponentSnapshot (viewport.getLocalBounds());
+            expect (content.paintedArea == Rectangle<int> (0, 0, 200, 100));
+
+            content.paintedArea = {};
+            viewport.setViewPosition (0, 30);
+            auto scrolled = viewport.createComponentSnapshot (viewport.getLocalBounds());
+            expect (content.paintedArea == Rectangle<int> (0, 100, 200, 30));
+            expect (imagesMatch (scrolled, 30));
+
+            content.paintedArea = {};
+            viewport.setViewPosition (0, 10);
+            scrolled = viewport.createComponentSnapshot (viewport.getLocalBounds());
+            expect (content.paintedArea == Rectangle<int> (0, 10, 200, 20));
+            expect (imagesMatch (scrolled, 10));
+        }
+
+        beginTest ("Repaints inside the content are still honoured");
+        {
+            Stripes content;
+            Viewport viewport;
+            createViewport (viewport, content);
+            viewport.setScrollBlittingEnabled (true);
+            viewport.setViewPosition (0, 50);
+            viewport.createComponentSnapshot (viewport.getLocalBounds());
+
+            content.paintedArea = {};
+            content.repaint (0, 80, 200, 10);
+            viewport.setViewPosition (0, 60);
+            viewport.createComponentSnapshot (viewport.getLocalBounds());
+            expect (content.paintedArea == Rectangle<int> (0, 80, 200, 10).getUnion ({ 0, 150, 200, 10 }));
+        }
+
+        beginTest ("Scrolling by a fraction of a physical pixel repaints everything");
+        {
+            Stripes content;
+            Viewport viewport;
+            createViewport (viewport, content);
+            viewport.setScrollBlittingEnabled (true);
+            viewport.createComponentSnapshot (viewport.getLocalBounds(), true, 1.5f);
+
+            content.paintedArea = {};
+            viewport.setViewPosition (0, 3);
+            viewport.createComponentSnapshot (viewport.getLocalBounds(), true, 1.5f);
+            expect (content.paintedArea == Rectangle<int> (0, 3, 200, 100));
+
+            viewport.setScrollBlittingEnabled (false);
+            expect (! viewport.isScrollBlittingEnabled());
+        }
+    }
+
+private:
+    struct Stripes  : public Component
+    {
+        Stripes()
+        {
+            setOpaque (true);
+            setSize (200, 2000);
+        }
+
+        void paint (Graphics& g) override
+        {
+            paintedArea = paintedArea.getUnion (g.getClipBounds());
+
+            for (int y = 0; y < getHeight(); y += 10)
+            {
+                g.setColour (getStripeColour (y));
+                g.fillRect (0, y, getWidth(), 10);
+            }
+        }
+
+        static Colour getStripeColour (int y)
+        {
+            return Colour ((uint8) ((y * 7) & 0xff), (uint8) ((y / 10) & 0xff), (uint8) 0x40);
+        }
+
+        Rectangle<int> paintedArea;
+    };
+
+    static void createViewport (Viewport& viewport, Stripes& content)
+    {
+        viewport.setScrollBarsShown (false, false, true, true);
+        viewport.setViewedComponent (&content, false);
+        viewport.setBounds (0, 0, 200, 100);
+    }
+
+    static bool imagesMatch (const Image& image, int viewY)
+    {
+        for (int y = 0; y < image.getHeight(); ++y)
+            if (image.getPixelAt (0, y) != Stripes::getStripeColour (((y + viewY) / 10) * 10))
+                return false;
+
+        return true;
+    }
+};
+
+static ViewportTests viewportTests;
+
+#endif
+
 } // namespace juce
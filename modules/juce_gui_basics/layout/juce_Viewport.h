@@ -310,6 +310,39 @@ public:
     */
     bool isCurrentlyScrollingOnDrag() const noexcept;
 
+    //==============================================================================
+    /** Enables or disables scrolling by copying the pixels that are already visible.
+
+        When this is enabled, the viewport keeps an image of its visible area. Each time
+        setViewPosition() is called (which is what the scrollbars, mouse-wheel and
+        drag-to-scroll all do), the pixels in that image are moved by the scroll distance,
+        and only the strip that has just come into view is painted, rather than the whole
+        viewport. This makes scrolling much cheaper for large content that's expensive to
+        draw, e.g. piano rolls or arrangement views.
+
+        The image is kept up to date by the repaint() calls made by the viewed component
+        and its children, so:
+        - content that draws itself differently depending on which part of it is visible
+          must call repaint() from visibleAreaChanged(), or whenever that changes;
+        - child components that are moved or resized within the viewed component will
+          repaint the right areas automatically, as usual;
+        - components that overlap the viewport but aren't inside the viewed component
+          aren't part of the image, and are painted as normal by their own parents.
+
+        The pixels can only be copied when the scroll distance is a whole number of
+        physical pixels, and the viewed component has no transform. Otherwise, the whole
+        visible area is repainted as it would be without this mode.
+
+        This is off by default. It uses the viewport's internal content-holder component's
+        CachedComponentImage, so the two can't be combined.
+    */
+    void setScrollBlittingEnabled (bool shouldCopyPixelsWhenScrolling);
+
+    /** Returns true if scrolling copies pixels, rather than repainting the visible area.
+        @see setScrollBlittingEnabled
+    */
+    bool isScrollBlittingEnabled() const noexcept     { return scrollBlitImage != nullptr; }
+
     //==============================================================================
     /** @internal */
     void resized() override;
@@ -362,6 +395,9 @@ private:
     struct DragToScrollListener;
     std::unique_ptr<DragToScrollListener> dragToScrollListener;
 
+    struct ScrollBlitImage;
+    ScrollBlitImage* scrollBlitImage = nullptr; // owned by the contentHolder
+
     Point<int> viewportPosToCompPos (Point<int>) const;
 
     void updateVisibleArea();
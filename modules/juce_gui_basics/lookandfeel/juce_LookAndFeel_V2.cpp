@@ -1067,8 +1067,8 @@ void LookAndFeel_V2::drawPopupMenuItemWithOptions (Graphics& g, const Rectangle<
                                                    const PopupMenu::Options&)
 {
     const auto colour = item.colour != Colour() ? &item.colour : nullptr;
-    const auto hasSubMenu = item.subMenu != nullptr
-                            && (item.itemID == 0 || item.subMenu->getNumItems() > 0);
+    const auto hasSubMenu = item.subMenu != nullptr ? (item.itemID == 0 || item.subMenu->getNumItems() > 0)
+                                                    : item.subMenuCreator != nullptr;
 
     drawPopupMenuItem (g,
                        area,
@@ -30,6 +30,8 @@ namespace PopupMenuSettings
 {
     const int scrollZone = 24;
     const int dismissCommandId = 0x6287345f;
+    const int maxItemsBeforeVirtualising = 100;
+    const uint32 typeAheadTimeoutMs = 1000;
 
     static bool menuWasHiddenBecauseOfAppChange = false;
 }
@@ -51,8 +53,10 @@ static bool canBeTriggered (const PopupMenu::Item& item) noexcept
 
 static bool hasActiveSubMenu (const PopupMenu::Item& item) noexcept
 {
+    if (item.subMenu == nullptr)
+        return item.isEnabled && item.subMenuCreator != nullptr;
+
     return item.isEnabled
-        && item.subMenu != nullptr
         && item.subMenu->items.size() > 0;
 }
 
@@ -633,7 +637,8 @@ struct MenuWindow  : public Component
                 componentAttachedTo->keyPressed (key);
             }
         }
-        else if (key.isKeyCode (KeyPress::returnKey) || key.isKeyCode (KeyPress::spaceKey))
+        else if (key.isKeyCode (KeyPress::returnKey)
+                  || (key.isKeyCode (KeyPress::spaceKey) && ! isTypingAhead()))
         {
             triggerCurrentlyHighlightedItem();
         }
@@ -643,12 +648,72 @@ struct MenuWindow  : public Component
         }
         else
         {
+            return handleTypeAhead (key);
+        }
+
+        return true;
+    }
+
+    bool isTypingAhead() const noexcept
+    {
+        return typeAheadText.isNotEmpty()
+                && Time::getMillisecondCounter() <= lastTypeAheadTime + PopupMenuSettings::typeAheadTimeoutMs;
+    }
+
+    bool handleTypeAhead (const KeyPress& key)
+    {
+        const auto c = key.getTextCharacter();
+        const auto mods = key.getModifiers();
+
+        if (c < ' ' || mods.isCommandDown() || mods.isCtrlDown() || mods.isAltDown())
             return false;
+
+        if (! isTypingAhead())
+            typeAheadText.clear();
+
+        typeAheadText << c;
+        lastTypeAheadTime = Time::getMillisecondCounter();
+
+        if (auto* match = findTypeAheadMatch (typeAheadText))
+        {
+            disableTimerUntilMouseMoves();
+            setCurrentlyHighlightedChild (match);
+            ensureItemComponentIsVisible (*match, -1);
         }
 
         return true;
     }
 
+    ItemComponent* findTypeAheadMatch (const String& prefix)
+    {
+        // The index is sorted by lower-case text, so all the items that share a prefix
+        // are adjacent, and we pick whichever of those comes first in the menu.
+        if (typeAheadIndex.empty())
+        {
+            for (int i = 0; i < items.size(); ++i)
+            {
+                auto& item = items.getUnchecked (i)->item;
+
+                if (canBeTriggered (item) || hasActiveSubMenu (item))
+                    typeAheadIndex.push_back ({ item.text.toLowerCase(), i });
+            }
+
+            std::sort (typeAheadIndex.begin(), typeAheadIndex.end(),
+                       [] (const TypeAheadEntry& a, const TypeAheadEntry& b) { return a.text < b.text; });
+        }
+
+        const auto lowerPrefix = prefix.toLowerCase();
+        auto it = std::lower_bound (typeAheadIndex.begin(), typeAheadIndex.end(), lowerPrefix,
+                                    [] (const TypeAheadEntry& e, const String& p) { return e.text < p; });
+
+        auto bestIndex = items.size();
+
+        for (; it != typeAheadIndex.end() && it->text.startsWith (lowerPrefix); ++it)
+            bestIndex = jmin (bestIndex, it->itemIndex);
+
+        return items[bestIndex];
+    }
+
     void inputAttemptWhenModal() override
     {
         WeakReference<Component> deletionChecker (this);
@@ -1167,10 +1232,44 @@ struct MenuWindow  : public Component
             }
         }
 
+        updateAttachedItems();
+
         return std::accumulate (columnWidths.begin(), columnWidths.end(), 0)
                + (separatorWidth * (columnWidths.size() - 1));
     }
 
+    bool isVirtualised() const noexcept
+    {
+        return items.size() > PopupMenuSettings::maxItemsBeforeVirtualising;
+    }
+
+    // For very large menus, only the rows that are currently on-screen are kept as
+    // child components, so that painting and hit-testing don't have to visit every item.
+    void updateAttachedItems()
+    {
+        const auto visibleArea = getLocalBounds();
+
+        if (! isVirtualised() || visibleArea.isEmpty())
+            return;
+
+        for (int i = items.size(); --i >= 0;)
+        {
+            auto* item = items.getUnchecked (i);
+
+            const auto shouldBeAttached = item == currentChild
+                                           || item->item.customComponent != nullptr
+                                           || visibleArea.intersects (item->getBounds());
+
+            if (shouldBeAttached != (item->getParentComponent() == this))
+            {
+                if (shouldBeAttached)
+                    addAndMakeVisible (item);
+                else
+                    removeChildComponent (item);
+            }
+        }
+    }
+
     void setCurrentlyHighlightedChild (ItemComponent* child)
     {
         if (currentChild != nullptr)
@@ -1180,6 +1279,9 @@ struct MenuWindow  : public Component
 
         if (currentChild != nullptr)
         {
+            if (currentChild->getParentComponent() != this)
+                addAndMakeVisible (currentChild);
+
             currentChild->setHighlighted (true);
             timeEnteredCurrentChildComp = Time::getApproximateMillisecondCounter();
         }
@@ -1194,6 +1296,13 @@ struct MenuWindow  : public Component
     {
         activeSubMenu.reset();
 
+        if (childComp != nullptr
+             && childComp->item.subMenu == nullptr
+             && childComp->item.subMenuCreator != nullptr)
+        {
+            childComp->item.subMenu = std::make_unique<PopupMenu> (childComp->item.subMenuCreator());
+        }
+
         if (childComp != nullptr
              && hasActiveSubMenu (childComp->item))
         {
@@ -1318,6 +1427,16 @@ struct MenuWindow  : public Component
     Component::SafePointer<ItemComponent> currentChild;
     std::unique_ptr<MenuWindow> activeSubMenu;
     Array<int> columnWidths;
+
+    struct TypeAheadEntry
+    {
+        String text;
+        int itemIndex;
+    };
+
+    std::vector<TypeAheadEntry> typeAheadIndex;
+    String typeAheadText;
+    uint32 lastTypeAheadTime = 0;
     uint32 windowCreationTime, lastFocusedTime, timeEnteredCurrentChildComp;
     OwnedArray<MouseSourceState> mouseSourceStates;
     float scaleFactor;
@@ -1647,6 +1766,7 @@ PopupMenu::Item::Item (const Item& other)
     itemID (other.itemID),
     action (other.action),
     subMenu (createCopyIfNotNull (other.subMenu.get())),
+    subMenuCreator (other.subMenuCreator),
     image (other.image != nullptr ? other.image->createCopy() : nullptr),
     customComponent (other.customComponent),
     customCallback (other.customCallback),
@@ -1666,6 +1786,7 @@ PopupMenu::Item& PopupMenu::Item::operator= (const Item& other)
     itemID = other.itemID;
     action = other.action;
     subMenu.reset (createCopyIfNotNull (other.subMenu.get()));
+    subMenuCreator = other.subMenuCreator;
     image = other.image != nullptr ? other.image->createCopy() : std::unique_ptr<Drawable>();
     customComponent = other.customComponent;
     customCallback = other.customCallback;
@@ -1770,7 +1891,7 @@ void PopupMenu::addItem (Item newItem)
     // didn't pick anything, so you shouldn't use it as the ID for an item.
     jassert (newItem.itemID != 0
               || newItem.isSeparator || newItem.isSectionHeader
-              || newItem.subMenu != nullptr);
+              || newItem.subMenu != nullptr || newItem.subMenuCreator != nullptr);
 
     items.add (std::move (newItem));
 }
@@ -1931,6 +2052,17 @@ void PopupMenu::addSubMenu (String subMenuName, PopupMenu subMenu, bool isActive
     addItem (std::move (i));
 }
 
+void PopupMenu::addLazySubMenu (String subMenuName, std::function<PopupMenu()> createSubMenu,
+                                bool isActive, bool isTicked)
+{
+    Item i (std::move (subMenuName));
+    i.itemID = 0;
+    i.isEnabled = isActive && createSubMenu != nullptr;
+    i.subMenuCreator = std::move (createSubMenu);
+    i.isTicked = isTicked;
+    addItem (std::move (i));
+}
+
 void PopupMenu::addSeparator()
 {
     if (items.size() > 0 && ! items.getLast().isSeparator)
@@ -2392,4 +2524,130 @@ void PopupMenu::LookAndFeelMethods::getIdealPopupMenuItemSize (const String&, bo
 
 int PopupMenu::LookAndFeelMethods::getPopupMenuBorderSize() { return 0; }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PopupMenuTests  : public UnitTest
+{
+public:
+    PopupMenuTests()
+        : UnitTest ("PopupMenu", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        // Menu windows are positioned relative to a display, so these tests can't run headless
+        if (Desktop::getInstance().getDisplays().getPrimaryDisplay() == nullptr)
+            return;
+
+        beginTest ("Large menus only attach the visible rows");
+        {
+            Component parent;
+            parent.setSize (300, 400);
+
+            PopupMenu menu;
+            int triggered = 0;
+
+            for (int i = 1; i <= 1000; ++i)
+                addItem (menu, i, "Item " + String (i).paddedLeft ('0', 4), triggered);
+
+            auto* window = show (menu, parent);
+            expect (window != nullptr);
+            expect (window->getNumChildComponents() > 0);
+            expect (window->getNumChildComponents() < 100);
+
+            PopupMenu::dismissAllActiveMenus();
+        }
+
+        beginTest ("Type-ahead highlights the first matching item");
+        {
+            Component parent;
+            parent.setSize (300, 400);
+
+            PopupMenu menu;
+            int triggered = 0;
+
+            for (int i = 1; i <= 500; ++i)
+                addItem (menu, i, "Item " + String (i), triggered);
+
+            addItem (menu, 1001, "Zebra", triggered);
+            addItem (menu, 1002, "Zeta", triggered);
+            addItem (menu, 1003, "zeta 2", triggered);
+
+            auto* window = show (menu, parent);
+            expect (window->keyPressed (KeyPress ('z', {}, 'z')));
+            expect (window->keyPressed (KeyPress ('e', {}, 'e')));
+            expect (window->keyPressed (KeyPress ('t', {}, 't')));
+            expect (window->getNumChildComponents() < 100);
+
+            window->keyPressed (KeyPress (KeyPress::returnKey));
+            expectEquals (triggered, 1002);
+        }
+
+        beginTest ("Lazy sub-menus are only created when opened");
+        {
+            Component parent;
+            parent.setSize (300, 400);
+
+            int numCreated = 0, triggered = 0;
+
+            PopupMenu menu;
+            menu.addLazySubMenu ("Lazy", [&]
+            {
+                ++numCreated;
+                PopupMenu subMenu;
+                addItem (subMenu, 7, "Inner", triggered);
+                return subMenu;
+            });
+
+            auto* window = show (menu, parent);
+            expectEquals (numCreated, 0);
+
+            window->keyPressed (KeyPress (KeyPress::downKey));
+            window->keyPressed (KeyPress (KeyPress::rightKey));
+            expectEquals (numCreated, 1);
+            expectEquals (parent.getNumChildComponents(), 2);
+
+            parent.getChildComponent (1)->keyPressed (KeyPress (KeyPress::returnKey));
+            expectEquals (triggered, 7);
+        }
+    }
+
+private:
+    struct RecordingCallback  : public PopupMenu::CustomCallback
+    {
+        RecordingCallback (int id, int& target) : itemID (id), triggered (target) {}
+
+        bool menuItemTriggered() override
+        {
+            triggered = itemID;
+            return false;
+        }
+
+        int itemID;
+        int& triggered;
+    };
+
+    static void addItem (PopupMenu& menu, int itemID, const String& text, int& triggered)
+    {
+        PopupMenu::Item item (text);
+        item.itemID = itemID;
+        item.customCallback = new RecordingCallback (itemID, triggered);
+        menu.addItem (std::move (item));
+    }
+
+    static Component* show (PopupMenu& menu, Component& parent)
+    {
+        menu.showMenuAsync (PopupMenu::Options().withParentComponent (&parent)
+                                                .withTargetScreenArea ({ 0, 0, 1, 1 }));
+        return parent.getChildComponent (0);
+    }
+};
+
+static PopupMenuTests popupMenuTests;
+
+#endif
+
 } // namespace juce
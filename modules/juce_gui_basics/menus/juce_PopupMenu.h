@@ -142,6 +142,13 @@ public:
         /** A sub-menu, or nullptr if there isn't one. */
         std::unique_ptr<PopupMenu> subMenu;
 
+        /** An optional function that builds the sub-menu the first time it is opened.
+            This can be used instead of subMenu when a hierarchy is large or expensive
+            to create up-front.
+            @see PopupMenu::addLazySubMenu
+        */
+        std::function<PopupMenu()> subMenuCreator;
+
         /** A drawable to use as an icon, or nullptr if there isn't one. */
         std::unique_ptr<Drawable> image;
 
@@ -407,6 +414,18 @@ public:
                      bool isTicked = false,
                      int itemResultID = 0);
 
+    /** Appends a sub-menu whose contents are only created when it is first opened.
+
+        The createSubMenu function is called each time a menu window needs to show the
+        sub-menu, so it can be used to avoid building very large menu hierarchies
+        up-front. Note that the contents of a lazy sub-menu are not visited by
+        MenuItemIterator or containsCommandItem().
+    */
+    void addLazySubMenu (String subMenuName,
+                         std::function<PopupMenu()> createSubMenu,
+                         bool isEnabled = true,
+                         bool isTicked = false);
+
     /** Appends a separator to the menu, to help break it up into sections.
         The menu class is smart enough not to display separators at the top or bottom
         of the menu, and it will replace multiple adjacent separators with a single
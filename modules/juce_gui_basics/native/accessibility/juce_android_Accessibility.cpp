@@ -923,7 +923,7 @@ public:
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return nativeImpl.get();
+    return getNativeImpl();
 }
 
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler,
@@ -933,8 +933,18 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler,
         || eventType == InternalAccessibilityEvent::elementDestroyed
         || eventType == InternalAccessibilityEvent::elementMovedOrResized)
     {
+        // Finding the parent can be slow, so don't bother if nobody's listening. Each
+        // parent only needs to be told once, however many of its children have changed.
+        if (! AccessibilityNativeHandle::areAnyAccessibilityClientsActive())
+            return;
+
         if (auto* parent = handler.getParent())
-            AccessibilityNativeHandle::sendAccessibilityEventImpl (*parent, TYPE_WINDOW_CONTENT_CHANGED, CONTENT_CHANGE_TYPE_SUBTREE);
+        {
+            AccessibilityNotificationCoalescer::post (*parent, TYPE_WINDOW_CONTENT_CHANGED, [] (const AccessibilityHandler& h, int type)
+            {
+                AccessibilityNativeHandle::sendAccessibilityEventImpl (h, type, CONTENT_CHANGE_TYPE_SUBTREE);
+            });
+        }
 
         return;
     }
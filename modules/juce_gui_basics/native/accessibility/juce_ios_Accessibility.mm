@@ -591,7 +591,7 @@ private:
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return (AccessibilityNativeHandle*) nativeImpl->getAccessibilityElement();
+    return (AccessibilityNativeHandle*) getNativeImpl()->getAccessibilityElement();
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -806,7 +806,7 @@ private:
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
     if (@available (macOS 10.10, *))
-        return (AccessibilityNativeHandle*) nativeImpl->getAccessibilityElement();
+        return (AccessibilityNativeHandle*) getNativeImpl()->getAccessibilityElement();
 
     return nullptr;
 }
@@ -863,8 +863,39 @@ static NSAccessibilityNotificationName layoutChangedNotification()
     return layoutChangedString;
 }
 
+// These notifications are often sent many times in a row, so they're posted through the
+// AccessibilityNotificationCoalescer, which sends each distinct one once
+enum class CoalescedNotification
+{
+    valueChanged,
+    titleChanged,
+    layoutChanged
+};
+
+static void sendCoalescedNotification (const AccessibilityHandler& handler, int notificationType)
+{
+    switch ((CoalescedNotification) notificationType)
+    {
+        case CoalescedNotification::valueChanged:   sendHandlerNotification (handler, NSAccessibilityValueChangedNotification); break;
+        case CoalescedNotification::titleChanged:   sendHandlerNotification (handler, NSAccessibilityTitleChangedNotification); break;
+        case CoalescedNotification::layoutChanged:  sendHandlerNotification (handler, layoutChangedNotification()); break;
+    }
+}
+
+static void postCoalescedNotification (const AccessibilityHandler& handler, CoalescedNotification notificationType)
+{
+    if (areAnyAccessibilityClientsActive())
+        AccessibilityNotificationCoalescer::post (handler, (int) notificationType, sendCoalescedNotification);
+}
+
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, InternalAccessibilityEvent eventType)
 {
+    if (eventType == InternalAccessibilityEvent::elementMovedOrResized)
+    {
+        postCoalescedNotification (handler, CoalescedNotification::layoutChanged);
+        return;
+    }
+
     auto notification = [eventType]
     {
         switch (eventType)
@@ -885,6 +916,16 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, Inte
 
 void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventType) const
 {
+    switch (eventType)
+    {
+        case AccessibilityEvent::textChanged:
+        case AccessibilityEvent::valueChanged:          postCoalescedNotification (*this, CoalescedNotification::valueChanged);  return;
+        case AccessibilityEvent::titleChanged:          postCoalescedNotification (*this, CoalescedNotification::titleChanged);  return;
+        case AccessibilityEvent::structureChanged:      postCoalescedNotification (*this, CoalescedNotification::layoutChanged); return;
+        case AccessibilityEvent::textSelectionChanged:
+        case AccessibilityEvent::rowSelectionChanged:   break;
+    }
+
     auto notification = [eventType]
     {
         switch (eventType)
@@ -91,7 +91,7 @@ int AccessibilityHandler::AccessibilityNativeImpl::providerCount = 0;
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return nativeImpl->accessibilityElement;
+    return getNativeImpl()->accessibilityElement;
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -153,6 +153,41 @@ void sendAccessibilityPropertyChangedEvent (const AccessibilityHandler& handler,
     });
 }
 
+static void sendCurrentPropertyValue (const AccessibilityHandler& handler, int property)
+{
+    VARIANT newValue;
+
+    if (property == UIA_NamePropertyId)
+    {
+        VariantHelpers::setString (handler.getTitle(), &newValue);
+    }
+    else if (auto* valueInterface = handler.getValueInterface())
+    {
+        newValue = property == UIA_RangeValueValuePropertyId ? VariantHelpers::getWithValue (valueInterface->getCurrentValue())
+                                                             : VariantHelpers::getWithValue (valueInterface->getCurrentValueAsString());
+    }
+    else
+    {
+        return;
+    }
+
+    sendAccessibilityPropertyChangedEvent (handler, property, newValue);
+}
+
+// Events and property changes that are often sent many times in a row are posted through
+// the AccessibilityNotificationCoalescer, which sends each distinct one once
+static void postCoalescedEvent (const AccessibilityHandler& handler, int eventOrProperty,
+                                AccessibilityNotificationCoalescer::Sender sender)
+{
+    if (areAnyAccessibilityClientsActive() && ! isStartingUpOrShuttingDown())
+        AccessibilityNotificationCoalescer::post (handler, eventOrProperty, sender);
+}
+
+static void sendCoalescedAutomationEvent (const AccessibilityHandler& handler, int event)
+{
+    sendAccessibilityAutomationEvent (handler, (EVENTID) event);
+}
+
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, InternalAccessibilityEvent eventType)
 {
     using namespace ComTypes::Constants;
@@ -160,8 +195,12 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, Inte
     if (eventType == InternalAccessibilityEvent::elementCreated
         || eventType == InternalAccessibilityEvent::elementDestroyed)
     {
+        // Finding the parent can be slow, so don't bother if nobody's listening
+        if (! areAnyAccessibilityClientsActive() || isStartingUpOrShuttingDown())
+            return;
+
         if (auto* parent = handler.getParent())
-            sendAccessibilityAutomationEvent (*parent, UIA_LayoutInvalidatedEventId);
+            postCoalescedEvent (*parent, UIA_LayoutInvalidatedEventId, sendCoalescedAutomationEvent);
 
         return;
     }
@@ -197,30 +236,29 @@ void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventTyp
 {
     if (eventType == AccessibilityEvent::titleChanged)
     {
-        VARIANT newValue;
-        VariantHelpers::setString (getTitle(), &newValue);
-
-        sendAccessibilityPropertyChangedEvent (*this, UIA_NamePropertyId, newValue);
+        postCoalescedEvent (*this, UIA_NamePropertyId, sendCurrentPropertyValue);
         return;
     }
 
     if (eventType == AccessibilityEvent::valueChanged)
     {
-        if (auto* valueInterface = getValueInterface())
+        if (getValueInterface() != nullptr)
         {
             const auto propertyType = getRole() == AccessibilityRole::slider ? UIA_RangeValueValuePropertyId
                                                                              : UIA_ValueValuePropertyId;
 
-            const auto value = getRole() == AccessibilityRole::slider
-                               ? VariantHelpers::getWithValue (valueInterface->getCurrentValue())
-                               : VariantHelpers::getWithValue (valueInterface->getCurrentValueAsString());
-
-            sendAccessibilityPropertyChangedEvent (*this, propertyType, value);
+            postCoalescedEvent (*this, propertyType, sendCurrentPropertyValue);
         }
 
         return;
     }
 
+    if (eventType == AccessibilityEvent::structureChanged)
+    {
+        postCoalescedEvent (*this, ComTypes::Constants::UIA_StructureChangedEventId, sendCoalescedAutomationEvent);
+        return;
+    }
+
     auto event = [eventType]() -> EVENTID
     {
         using namespace ComTypes::Constants;
@@ -418,17 +418,26 @@ private:
         {
         }
 
+        ~LinuxRepaintManager()
+        {
+            blitter->cancelJobsFor (*this);
+        }
+
         void dispatchDeferredRepaints()
         {
             XWindowSystem::getInstance()->processPendingPaintsForWindow (peer.windowH);
 
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
-                return;
-
             if (! regionsNeedingRepaint.isEmpty())
-                performAnyPendingRepaintsNow();
+            {
+                if (findFreeBuffer() != nullptr && peer.beginFrameIfDue())
+                    performAnyPendingRepaintsNow();
+            }
             else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
-                image = Image();
+            {
+                for (auto& buffer : buffers)
+                    if (isFree (buffer))
+                        buffer.image = Image();
+            }
         }
 
         void repaint (Rectangle<int> area)
@@ -438,24 +447,30 @@ private:
 
         void performAnyPendingRepaintsNow()
         {
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
+            auto* buffer = findFreeBuffer();
+
+            if (buffer == nullptr)
                 return;
 
             auto originalRepaintRegion = regionsNeedingRepaint;
             regionsNeedingRepaint.clear();
+            peer.optimiseRepaintRegion (originalRepaintRegion);
             auto totalArea = originalRepaintRegion.getBounds();
 
             if (! totalArea.isEmpty())
             {
-                const auto wasImageNull = image.isNull();
+                auto& image = buffer->image;
 
-                if (wasImageNull || image.getWidth() < totalArea.getWidth()
+                if (image.isNull() || image.getWidth() < totalArea.getWidth()
                      || image.getHeight() < totalArea.getHeight())
                 {
+                    const auto wereAllImagesNull = std::all_of (std::begin (buffers), std::end (buffers),
+                                                                [] (const Buffer& b) { return b.image.isNull(); });
+
                     image = XWindowSystem::getInstance()->createImage (isSemiTransparentWindow,
                                                                        totalArea.getWidth(), totalArea.getHeight(),
                                                                        useARGBImagesForRendering);
-                    if (wasImageNull)
+                    if (wereAllImagesNull)
                     {
                         // After calling createImage() XWindowSystem::getWindowBounds() will return
                         // changed coordinates that look like the result of some position
@@ -482,26 +497,183 @@ private:
                         image.clear (i - totalArea.getPosition());
 
                 {
-                    auto context = peer.getComponent().getLookAndFeel()
-                                     .createGraphicsContext (image, -totalArea.getPosition(), adjustedList);
+                    const auto paintStartTime = Time::getMillisecondCounterHiRes();
+
+                    {
+                        auto context = peer.getComponent().getLookAndFeel()
+                                         .createGraphicsContext (image, -totalArea.getPosition(), adjustedList);
+
+                        context->addTransform (AffineTransform::scale ((float) peer.currentScaleFactor));
+                        peer.handlePaint (*context);
+                    }
 
-                    context->addTransform (AffineTransform::scale ((float) peer.currentScaleFactor));
-                    peer.handlePaint (*context);
+                    peer.frameWasPainted (originalRepaintRegion, Time::getMillisecondCounterHiRes() - paintStartTime);
                 }
 
-                for (auto& i : originalRepaintRegion)
-                   XWindowSystem::getInstance()->blitToWindow (peer.windowH, image, i, totalArea);
+                if (XWindowSystem::getInstance()->canBlitFromBackgroundThread())
+                {
+                    buffer->isBeingBlitted = true;
+                    blitter->addJob ({ this, buffer, peer.windowH, std::move (originalRepaintRegion), totalArea });
+                }
+                else
+                {
+                    blit (peer.windowH, image, originalRepaintRegion, totalArea);
+                }
             }
 
             lastTimeImageUsed = Time::getApproximateMillisecondCounter();
         }
 
     private:
+        //==============================================================================
+        /*  Each frame is painted into whichever buffer the X server has finished with, so
+            that painting the next frame doesn't have to wait for the previous one to be
+            copied to the window.
+        */
+        struct Buffer
+        {
+            Image image;
+            std::atomic<bool> isBeingBlitted { false };
+        };
+
+        static bool isFree (const Buffer& buffer)
+        {
+            return ! buffer.isBeingBlitted
+                && XWindowSystem::getInstance()->getNumPaintsPendingForImage (buffer.image) == 0;
+        }
+
+        Buffer* findFreeBuffer()
+        {
+            for (auto& buffer : buffers)
+                if (isFree (buffer))
+                    return &buffer;
+
+            return nullptr;
+        }
+
+        static void blit (::Window window, const Image& image, const RectangleList<int>& region, Rectangle<int> totalArea)
+        {
+            for (auto& i : region)
+                XWindowSystem::getInstance()->blitToWindow (window, image, i, totalArea);
+        }
+
+        //==============================================================================
+        /*  Sending an image to the X server can take a long time, especially when shared
+            memory isn't available, so when Xlib allows it, the blits for all windows are
+            done in order on a single background thread.
+        */
+        class BackgroundBlitter  : private Thread
+        {
+        public:
+            struct Job
+            {
+                const LinuxRepaintManager* owner = nullptr;
+                Buffer* buffer = nullptr;
+                ::Window window = 0;
+                RectangleList<int> region;
+                Rectangle<int> totalArea;
+            };
+
+            BackgroundBlitter()  : Thread ("JUCE X11 Blitter") {}
+
+            ~BackgroundBlitter() override
+            {
+                signalThreadShouldExit();
+                jobAdded.signal();
+                stopThread (10000);
+            }
+
+            void addJob (Job job)
+            {
+                {
+                    const ScopedLock sl (lock);
+                    jobs.push_back (std::move (job));
+                }
+
+                if (! isThreadRunning())
+                    startThread (Priority::high);
+
+                jobAdded.signal();
+            }
+
+            /*  Removes any jobs for the given manager that haven't been started, and waits
+                for one that's in progress to finish.
+            */
+            void cancelJobsFor (const LinuxRepaintManager& owner)
+            {
+                for (;;)
+                {
+                    {
+                        const ScopedLock sl (lock);
+
+                        jobs.erase (std::remove_if (jobs.begin(), jobs.end(), [&] (const Job& j) { return j.owner == &owner; }),
+                                    jobs.end());
+
+                        if (currentOwner != &owner)
+                            return;
+                    }
+
+                    jobFinished.wait (10);
+                }
+            }
+
+        private:
+            void run() override
+            {
+                while (! threadShouldExit())
+                {
+                    Job job;
+
+                    {
+                        const ScopedLock sl (lock);
+
+                        if (jobs.empty())
+                        {
+                            currentOwner = nullptr;
+                        }
+                        else
+                        {
+                            job = std::move (jobs.front());
+                            jobs.pop_front();
+                            currentOwner = job.owner;
+                        }
+                    }
+
+                    if (job.owner == nullptr)
+                    {
+                        jobFinished.signal();
+                        jobAdded.wait (-1);
+                        continue;
+                    }
+
+                    blit (job.window, job.buffer->image, job.region, job.totalArea);
+                    XWindowSystem::getInstance()->flushBlits();
+                    job.buffer->isBeingBlitted = false;
+
+                    {
+                        const ScopedLock sl (lock);
+                        currentOwner = nullptr;
+                    }
+
+                    jobFinished.signal();
+                }
+            }
+
+            CriticalSection lock;
+            std::deque<Job> jobs;
+            const LinuxRepaintManager* currentOwner = nullptr;
+            WaitableEvent jobAdded, jobFinished;
+
+            JUCE_DECLARE_NON_COPYABLE (BackgroundBlitter)
+        };
+
+        //==============================================================================
         LinuxComponentPeer& peer;
         const bool isSemiTransparentWindow;
-        Image image;
+        Buffer buffers[2];
         uint32 lastTimeImageUsed = 0;
         RectangleList<int> regionsNeedingRepaint;
+        SharedResourcePointer<BackgroundBlitter> blitter;
 
         bool useARGBImagesForRendering = XWindowSystem::getInstance()->canUseARGBImages();
 
@@ -257,7 +257,7 @@ public:
 
             [item setEnabled: false];
         }
-        else if (i.subMenu != nullptr)
+        else if (i.subMenu != nullptr || i.subMenuCreator != nullptr)
         {
             if (recentItemsMenuName.isNotEmpty() && i.text == recentItemsMenuName)
             {
@@ -281,7 +281,9 @@ public:
             [item setTag: i.itemID];
             [item setEnabled: i.isEnabled];
 
-            NSMenu* sub = createMenu (*i.subMenu, i.text, topLevelMenuId, topLevelIndex, false);
+            // native menus are built up-front, so any lazy sub-menus have to be created here
+            NSMenu* sub = createMenu (i.subMenu != nullptr ? *i.subMenu : i.subMenuCreator(),
+                                      i.text, topLevelMenuId, topLevelIndex, false);
             [menuToAddTo setSubmenu: sub forItem: item];
             [sub release];
         }
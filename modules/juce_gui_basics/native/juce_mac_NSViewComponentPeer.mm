@@ -956,6 +956,8 @@ public:
 
     void renderRect (CGContextRef cg, NSRect r, float displayScale)
     {
+        const auto paintStartTime = Time::getMillisecondCounterHiRes();
+
        #if USE_COREGRAPHICS_RENDERING
         if (usingCoreGraphics)
         {
@@ -963,6 +965,9 @@ public:
             CGContextConcatCTM (cg, CGAffineTransformMake (1, 0, 0, -1, 0, height));
             CoreGraphicsContext context (cg, (float) height);
             handlePaint (context);
+
+            frameWasPainted ((convertToRectFloat (r) * displayScale).getSmallestIntegerContainer(),
+                             Time::getMillisecondCounterHiRes() - paintStartTime);
         }
         else
        #endif
@@ -996,6 +1001,8 @@ public:
                     handlePaint (*context);
                 }
 
+                frameWasPainted (clip, Time::getMillisecondCounterHiRes() - paintStartTime);
+
                 detail::ColorSpacePtr colourSpace { CGColorSpaceCreateWithName (kCGColorSpaceSRGB) };
                 CGImageRef image = juce_createCoreGraphicsImage (temp, colourSpace.get());
                 CGContextConcatCTM (cg, CGAffineTransformMake (1, 0, 0, -1, r.origin.x, r.origin.y + clipH));
@@ -1023,7 +1030,9 @@ public:
     void onVBlank()
     {
         vBlankListeners.call ([] (auto& l) { l.onVBlank(); });
-        setNeedsDisplayRectangles();
+
+        if (! deferredRepaints.isEmpty() && beginFrameIfDue())
+            setNeedsDisplayRectangles();
     }
 
     void setNeedsDisplayRectangles()
@@ -1730,6 +1730,16 @@ public:
         if (parentToAddTo != nullptr)
             monitorUpdateTimer.emplace (1000, [this] { updateCurrentMonitorAndRefreshVBlankDispatcher(); });
 
+       #if JUCE_DIRECT2D
+        // When Direct2D has been enabled it's the default for windows that it can draw, i.e.
+        // opaque ones that JUCE paints itself
+        if (! dontRepaint && ! isUsingUpdateLayeredWindow() && getAvailableRenderingEngines().size() > 1)
+        {
+            currentRenderingEngine = direct2DRenderingEngine;
+            updateDirect2DContext();
+        }
+       #endif
+
         suspendResumeRegistration = ScopedSuspendResumeNotificationRegistration { hwnd };
     }
 
@@ -2117,6 +2127,8 @@ public:
 
     void dispatchDeferredRepaints()
     {
+        optimiseRepaintRegion (deferredRepaints);
+
         for (auto deferredRect : deferredRepaints)
         {
             auto r = RECTFromRectangle (deferredRect);
@@ -2145,7 +2157,9 @@ public:
     void onVBlank() override
     {
         vBlankListeners.call ([] (auto& l) { l.onVBlank(); });
-        dispatchDeferredRepaints();
+
+        if (! deferredRepaints.isEmpty() && beginFrameIfDue())
+            dispatchDeferredRepaints();
     }
 
     //==============================================================================
@@ -2802,18 +2816,31 @@ private:
     void handlePaintMessage()
     {
        #if JUCE_DIRECT2D
-        if (direct2DContext != nullptr)
+        if (direct2DContext != nullptr && ! isUsingUpdateLayeredWindow())
         {
-            RECT r;
+            HRGN rgn = CreateRectRgn (0, 0, 0, 0);
 
-            if (GetUpdateRect (hwnd, &r, false))
+            if (GetUpdateRgn (hwnd, rgn, false) != NULLREGION)
             {
+                // Only the invalid parts of the window are drawn, rather than the whole of
+                // their bounding box
+                auto contextClip = getRegionRectangles (rgn);
+
                 direct2DContext->start();
-                direct2DContext->clipToRectangle (convertPhysicalScreenRectangleToLogical (rectangleFromRECT (r), hwnd));
+                direct2DContext->clipToRectangleList (contextClip);
+                direct2DContext->addTransform (AffineTransform::scale ((float) getPlatformScaleFactor()));
+
+                const auto paintStartTime = Time::getMillisecondCounterHiRes();
                 handlePaint (*direct2DContext);
-                direct2DContext->end();
-                ValidateRect (hwnd, &r);
+                frameWasPainted (contextClip, Time::getMillisecondCounterHiRes() - paintStartTime);
+
+                if (direct2DContext->end())
+                    ValidateRgn (hwnd, rgn);
+                else
+                    InvalidateRect (hwnd, nullptr, FALSE);
             }
+
+            DeleteObject (rgn);
         }
         else
        #endif
@@ -2851,6 +2878,30 @@ private:
         lastPaintTime = Time::getMillisecondCounter();
     }
 
+   #if JUCE_DIRECT2D
+    static RectangleList<int> getRegionRectangles (HRGN rgn)
+    {
+        RectangleList<int> result;
+        const auto size = GetRegionData (rgn, 0, nullptr);
+
+        if (size == 0)
+            return result;
+
+        HeapBlock<char> data (size);
+        auto* rgnData = unalignedPointerCast<RGNDATA*> (data.get());
+
+        if (GetRegionData (rgn, size, rgnData) == size)
+        {
+            auto rects = unalignedPointerCast<const RECT*> (data.get() + sizeof (RGNDATAHEADER));
+
+            for (DWORD i = 0; i < rgnData->rdh.nCount; ++i)
+                result.addWithoutMerging (rectangleFromRECT (rects[i]));
+        }
+
+        return result;
+    }
+   #endif
+
     void performPaint (HDC dc, HRGN rgn, int regionType, PAINTSTRUCT& paintStruct)
     {
         int x = paintStruct.rcPaint.left;
@@ -2938,11 +2989,17 @@ private:
                         offscreenImage.clear (i);
 
                 {
-                    auto context = component.getLookAndFeel()
-                                    .createGraphicsContext (offscreenImage, { -x, -y }, contextClip);
+                    const auto paintStartTime = Time::getMillisecondCounterHiRes();
+
+                    {
+                        auto context = component.getLookAndFeel()
+                                        .createGraphicsContext (offscreenImage, { -x, -y }, contextClip);
+
+                        context->addTransform (AffineTransform::scale ((float) getPlatformScaleFactor()));
+                        handlePaint (*context);
+                    }
 
-                    context->addTransform (AffineTransform::scale ((float) getPlatformScaleFactor()));
-                    handlePaint (*context);
+                    frameWasPainted (contextClip, Time::getMillisecondCounterHiRes() - paintStartTime);
                 }
 
                 static_cast<WindowsBitmapImage*> (offscreenImage.getPixelData())
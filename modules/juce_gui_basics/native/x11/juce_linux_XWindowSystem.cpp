@@ -1017,7 +1017,7 @@ public:
 
        #if JUCE_USE_XSHM
         if (isUsingXShm())
-            XWindowSystem::getInstance()->addPendingPaintForWindow (window);
+            XWindowSystem::getInstance()->addPendingPaintForWindow (window, segmentInfo.shmseg);
        #endif
 
         if (gc == None)
@@ -1077,6 +1077,7 @@ public:
 
     #if JUCE_USE_XSHM
      bool isUsingXShm() const noexcept       { return usingXShm; }
+     ShmSeg getShmSegment() const noexcept   { return segmentInfo.shmseg; }
     #endif
 
 private:
@@ -1478,6 +1479,8 @@ XWindowSystem::XWindowSystem()
             initThreadCalled = true;
         }
 
+        xlibIsThreadSafe = true;
+
         X11ErrorHandling::installXErrorHandlers();
     }
 
@@ -1647,7 +1650,10 @@ void XWindowSystem::destroyWindow (::Window windowH)
 
    #if JUCE_USE_XSHM
     if (XSHMHelpers::isShmAvailable (display))
+    {
+        const ScopedLock sl (shmPaintsPendingLock);
         shmPaintsPendingMap.erase (windowH);
+    }
    #endif
 }
 
@@ -2159,6 +2165,12 @@ void XWindowSystem::blitToWindow (::Window windowH, Image image, Rectangle<int>
                            destinationRect.getX() - totalRect.getX(), destinationRect.getY() - totalRect.getY());
 }
 
+void XWindowSystem::flushBlits() const
+{
+    XWindowSystemUtilities::ScopedXLock xLock;
+    X11Symbols::getInstance()->xFlush (display);
+}
+
 void XWindowSystem::processPendingPaintsForWindow (::Window windowH)
 {
    #if JUCE_USE_XSHM
@@ -2171,7 +2183,7 @@ void XWindowSystem::processPendingPaintsForWindow (::Window windowH)
 
         XEvent evt;
         while (X11Symbols::getInstance()->xCheckTypedWindowEvent (display, windowH, shmCompletionEvent, &evt))
-            removePendingPaintForWindow (windowH);
+            removePendingPaintForWindow (windowH, reinterpret_cast<XShmCompletionEvent&> (evt).shmseg);
     }
    #endif
 }
@@ -2180,25 +2192,57 @@ int XWindowSystem::getNumPaintsPendingForWindow (::Window windowH)
 {
    #if JUCE_USE_XSHM
     if (XSHMHelpers::isShmAvailable (display))
+    {
+        const ScopedLock sl (shmPaintsPendingLock);
         return shmPaintsPendingMap[windowH];
+    }
+   #endif
+
+    return 0;
+}
+
+int XWindowSystem::getNumPaintsPendingForImage ([[maybe_unused]] const Image& image)
+{
+   #if JUCE_USE_XSHM
+    if (auto* xbitmap = dynamic_cast<XBitmapImage*> (image.getPixelData()))
+    {
+        if (xbitmap->isUsingXShm())
+        {
+            const ScopedLock sl (shmPaintsPendingLock);
+            const auto iter = shmPaintsPendingForSegmentMap.find (xbitmap->getShmSegment());
+            return iter != shmPaintsPendingForSegmentMap.end() ? iter->second : 0;
+        }
+    }
    #endif
 
     return 0;
 }
 
-void XWindowSystem::addPendingPaintForWindow (::Window windowH)
+void XWindowSystem::addPendingPaintForWindow ([[maybe_unused]] ::Window windowH, [[maybe_unused]] unsigned long shmSegment)
 {
    #if JUCE_USE_XSHM
     if (XSHMHelpers::isShmAvailable (display))
+    {
+        const ScopedLock sl (shmPaintsPendingLock);
         ++shmPaintsPendingMap[windowH];
+        ++shmPaintsPendingForSegmentMap[shmSegment];
+    }
    #endif
 }
 
-void XWindowSystem::removePendingPaintForWindow (::Window windowH)
+void XWindowSystem::removePendingPaintForWindow ([[maybe_unused]] ::Window windowH, [[maybe_unused]] unsigned long shmSegment)
 {
    #if JUCE_USE_XSHM
     if (XSHMHelpers::isShmAvailable (display))
+    {
+        const ScopedLock sl (shmPaintsPendingLock);
         --shmPaintsPendingMap[windowH];
+
+        const auto iter = shmPaintsPendingForSegmentMap.find (shmSegment);
+
+        if (iter != shmPaintsPendingForSegmentMap.end() && --(iter->second) <= 0)
+            shmPaintsPendingForSegmentMap.erase (iter);
+    }
    #endif
 }
 
@@ -3354,7 +3398,8 @@ void XWindowSystem::handleWindowMessage (LinuxComponentPeer* peer, XEvent& event
                 XWindowSystemUtilities::ScopedXLock xLock;
 
                 if (event.xany.type == shmCompletionEvent)
-                    XWindowSystem::getInstance()->removePendingPaintForWindow ((::Window) peer->getNativeHandle());
+                    XWindowSystem::getInstance()->removePendingPaintForWindow ((::Window) peer->getNativeHandle(),
+                                                                               reinterpret_cast<XShmCompletionEvent&> (event).shmseg);
             }
            #endif
             break;
@@ -203,12 +203,19 @@ public:
     bool isDarkModeActive() const;
 
     int getNumPaintsPendingForWindow (::Window);
+    int getNumPaintsPendingForImage (const Image&);
     void processPendingPaintsForWindow (::Window);
-    void addPendingPaintForWindow (::Window);
-    void removePendingPaintForWindow (::Window);
+    void addPendingPaintForWindow (::Window, unsigned long shmSegment);
+    void removePendingPaintForWindow (::Window, unsigned long shmSegment);
 
     Image createImage (bool isSemiTransparentWindow, int width, int height, bool argb) const;
     void blitToWindow (::Window, Image, Rectangle<int> destinationRect, Rectangle<int> totalRect) const;
+    void flushBlits() const;
+
+    /** True if Xlib has been initialised for use from several threads, so that images
+        can be blitted from a thread other than the message thread.
+    */
+    bool canBlitFromBackgroundThread() const noexcept  { return xlibIsThreadSafe; }
 
     void setScreenSaverEnabled (bool enabled) const;
 
@@ -334,9 +341,13 @@ private:
     std::unique_ptr<XWindowSystemUtilities::XSettings> xSettings;
 
    #if JUCE_USE_XSHM
+    CriticalSection shmPaintsPendingLock;
     std::map<::Window, int> shmPaintsPendingMap;
+    std::map<unsigned long, int> shmPaintsPendingForSegmentMap;
    #endif
 
+    bool xlibIsThreadSafe = false;
+
     int shmCompletionEvent = 0;
     int pointerMap[5] = {};
     String localClipboardContent;
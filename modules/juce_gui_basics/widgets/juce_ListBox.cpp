@@ -112,6 +112,11 @@ public:
         }
     }
 
+    bool isShowingRow (int rowToCheck, bool selected) const noexcept
+    {
+        return row == rowToCheck && isSelected == selected;
+    }
+
     void performSelection (const MouseEvent& e, bool isMouseUp)
     {
         owner.selectRowsBasedOnModifierKeys (row, e.mods, isMouseUp);
@@ -269,6 +274,94 @@ public:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RowComponent)
 };
 
+//==============================================================================
+class ListBox::RowContentLoader  : private TimeSliceClient,
+                                   private AsyncUpdater
+{
+public:
+    RowContentLoader (ListBox& lb, TimeSliceThread& t) : owner (lb), thread (t) {}
+
+    ~RowContentLoader() override
+    {
+        stop();
+    }
+
+    void setVisibleRows (Range<int> newRange)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (newRange == visibleRows)
+                return;
+
+            visibleRows = newRange;
+        }
+
+        thread.addTimeSliceClient (this);
+    }
+
+    void reset()
+    {
+        {
+            const ScopedLock sl (lock);
+            rowsLoaded.clear();
+        }
+
+        thread.addTimeSliceClient (this);
+    }
+
+    // Waits for any loadRowContent() call in progress, so must be used before the model changes.
+    void stop()
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+private:
+    int useTimeSlice() override
+    {
+        int row = -1;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto r = visibleRows.getStart(); r < visibleRows.getEnd(); ++r)
+            {
+                if (! rowsLoaded.contains (r))
+                {
+                    rowsLoaded.addRange ({ r, r + 1 });
+                    row = r;
+                    break;
+                }
+            }
+        }
+
+        if (row < 0)
+            return -1;
+
+        if (auto* m = owner.model)
+        {
+            if (m->loadRowContent (row))
+            {
+                const ScopedLock sl (lock);
+                rowsToRefresh.addRange ({ row, row + 1 });
+                triggerAsyncUpdate();
+            }
+        }
+
+        return 0;
+    }
+
+    void handleAsyncUpdate() override;
+
+    ListBox& owner;
+    TimeSliceThread& thread;
+    CriticalSection lock;
+    Range<int> visibleRows;
+    SparseSet<int> rowsLoaded, rowsToRefresh;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RowContentLoader)
+};
+
 
 //==============================================================================
 class ListBox::ListViewport  : public Viewport,
@@ -320,7 +413,8 @@ public:
 
     void visibleAreaChanged (const Rectangle<int>&) override
     {
-        updateVisibleArea (true);
+        // Rows that were already showing before the scroll don't need refreshing
+        updateVisibleArea (true, false);
 
         if (auto* m = owner.getModel())
             m->listWasScrolled();
@@ -328,7 +422,7 @@ public:
         startTimer (50);
     }
 
-    void updateVisibleArea (const bool makeSureItUpdatesContent)
+    void updateVisibleArea (const bool makeSureItUpdatesContent, const bool refreshUnchangedRows = true)
     {
         hasUpdated = false;
 
@@ -344,10 +438,10 @@ public:
         content.setBounds (newX, newY, newW, newH);
 
         if (makeSureItUpdatesContent && ! hasUpdated)
-            updateContents();
+            updateContents (refreshUnchangedRows);
     }
 
-    void updateContents()
+    void updateContents (const bool refreshUnchangedRows = true)
     {
         hasUpdated = true;
         auto rowH = owner.getRowHeight();
@@ -378,14 +472,22 @@ public:
             {
                 if (auto* rowComp = getComponentForRowIfOnscreen (row))
                 {
+                    const auto selected = owner.isRowSelected (row);
+                    const auto sizeChanged = rowComp->getWidth() != w || rowComp->getHeight() != rowH;
+
                     rowComp->setBounds (0, row * rowH, w, rowH);
-                    rowComp->update (row, owner.isRowSelected (row));
+
+                    if (refreshUnchangedRows || sizeChanged || ! rowComp->isShowingRow (row, selected))
+                        rowComp->update (row, selected);
                 }
                 else
                 {
                     jassertfalse;
                 }
             }
+
+            if (owner.rowContentLoader != nullptr)
+                owner.rowContentLoader->setVisibleRows ({ startIndex, jmin (lastIndex, owner.totalItems) });
         }
 
         if (owner.headerComponent != nullptr)
@@ -485,6 +587,27 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListViewport)
 };
 
+void ListBox::RowContentLoader::handleAsyncUpdate()
+{
+    SparseSet<int> rows;
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (rows, rowsToRefresh);
+    }
+
+    for (int i = 0; i < rows.size(); ++i)
+    {
+        const auto row = rows[i];
+
+        if (auto* rowComp = owner.viewport->getComponentForRowIfOnscreen (row))
+        {
+            rowComp->update (row, owner.isRowSelected (row));
+            rowComp->repaint();
+        }
+    }
+}
+
 //==============================================================================
 struct ListBoxMouseMoveSelector  : public MouseListener
 {
@@ -530,6 +653,7 @@ ListBox::ListBox (const String& name, ListBoxModel* const m)
 
 ListBox::~ListBox()
 {
+    rowContentLoader.reset();
     headerComponent.reset();
     viewport.reset();
 }
@@ -547,6 +671,9 @@ void ListBox::setModel (ListBoxModel* const newModel)
 {
     if (model != newModel)
     {
+        if (rowContentLoader != nullptr)
+            rowContentLoader->stop();
+
         assignModelPtr (newModel);
         repaint();
         updateContent();
@@ -609,6 +736,17 @@ Viewport* ListBox::getViewport() const noexcept
 }
 
 //==============================================================================
+void ListBox::setRowContentLoadingThread (TimeSliceThread* thread)
+{
+    rowContentLoader.reset();
+
+    if (thread != nullptr)
+    {
+        rowContentLoader = std::make_unique<RowContentLoader> (*this, *thread);
+        viewport->updateContents (false);
+    }
+}
+
 void ListBox::updateContent()
 {
     checkModelPtrIsValid();
@@ -624,6 +762,9 @@ void ListBox::updateContent()
         selectionChanged = true;
     }
 
+    if (rowContentLoader != nullptr)
+        rowContentLoader->reset();
+
     viewport->updateVisibleArea (isVisible());
     viewport->resized();
 
@@ -1224,5 +1365,6 @@ void ListBoxModel::listWasScrolled() {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return {}; }
 String ListBoxModel::getTooltipForRow (int)                             { return {}; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
+bool ListBoxModel::loadRowContent (int)                                 { return false; }
 
 } // namespace juce
@@ -164,6 +164,24 @@ public:
     /** You can override this to return a custom mouse cursor for each row. */
     virtual MouseCursor getMouseCursorForRow (int row);
 
+    /** Override this to load expensive row content (e.g. thumbnails or file metadata)
+        away from the message thread.
+
+        This is only called if the ListBox has been given a thread with
+        ListBox::setRowContentLoadingThread(). It's called on that thread, once for each
+        row as it becomes visible, starting from the top; rows that scroll out of view
+        before their turn are skipped. Until the content for a row is ready, your
+        paintListBoxItem() and refreshComponentForRow() methods should draw a placeholder.
+
+        Return true if the row needs to be redrawn, and the ListBox will call
+        refreshComponentForRow() and repaint the row on the message thread. Because this
+        runs concurrently with your other methods, any data it shares with them must be
+        protected by a lock.
+
+        @see ListBox::setRowContentLoadingThread
+    */
+    virtual bool loadRowContent (int rowNumber);
+
 private:
    #if ! JUCE_DISABLE_ASSERTIONS
     friend class ListBox;
@@ -235,6 +253,17 @@ public:
     */
     void updateContent();
 
+    /** Gives the list a thread on which to call ListBoxModel::loadRowContent() for rows
+        as they scroll into view.
+
+        Pass nullptr to stop loading row content. The thread isn't owned by the list, so
+        it must outlive it, and it must be running. Calling updateContent() causes all
+        the visible rows to be loaded again.
+
+        @see ListBoxModel::loadRowContent
+    */
+    void setRowContentLoadingThread (TimeSliceThread* thread);
+
     //==============================================================================
     /** Turns on multiple-selection of rows.
 
@@ -604,9 +633,11 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class ListViewport)
     JUCE_PUBLIC_IN_DLL_BUILD (class RowComponent)
+    JUCE_PUBLIC_IN_DLL_BUILD (class RowContentLoader)
     friend class ListViewport;
     friend class TableListBox;
     ListBoxModel* model = nullptr;
+    std::unique_ptr<RowContentLoader> rowContentLoader;
     std::unique_ptr<ListViewport> viewport;
     std::unique_ptr<Component> headerComponent;
     std::unique_ptr<MouseListener> mouseMoveSelector;
@@ -414,12 +414,16 @@ TableListBox::TableListBox (const String& name, TableListBoxModel* const m)
 
 TableListBox::~TableListBox()
 {
+    rowContentLoader.reset();
 }
 
 void TableListBox::setModel (TableListBoxModel* newModel)
 {
     if (model != newModel)
     {
+        if (rowContentLoader != nullptr)
+            rowContentLoader->stop();
+
         model = newModel;
         updateContent();
     }
@@ -561,6 +565,11 @@ void TableListBox::listWasScrolled()
         model->listWasScrolled();
 }
 
+bool TableListBox::loadRowContent (int row)
+{
+    return model != nullptr && model->loadRowContent (row);
+}
+
 void TableListBox::tableColumnsChanged (TableHeaderComponent*)
 {
     setMinimumContentWidth (header->getTotalWidth());
@@ -721,6 +730,7 @@ void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
 void TableListBoxModel::listWasScrolled()                               {}
+bool TableListBoxModel::loadRowContent (int)                            { return false; }
 
 String TableListBoxModel::getCellTooltip (int /*rowNumber*/, int /*columnId*/)    { return {}; }
 var TableListBoxModel::getDragSourceDescription (const SparseSet<int>&)           { return {}; }
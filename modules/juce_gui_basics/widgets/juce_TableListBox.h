@@ -186,6 +186,13 @@ public:
         @see getDragSourceCustomData, DragAndDropContainer::startDragging
     */
     virtual var getDragSourceDescription (const SparseSet<int>& currentlySelectedRows);
+
+    /** Override this to load expensive row content on the thread given to
+        ListBox::setRowContentLoadingThread(), returning true if the row should be redrawn.
+
+        @see ListBoxModel::loadRowContent
+    */
+    virtual bool loadRowContent (int rowNumber);
 };
 
 
@@ -317,6 +324,8 @@ public:
     /** @internal */
     void listWasScrolled() override;
     /** @internal */
+    bool loadRowContent (int rowNumber) override;
+    /** @internal */
     void tableColumnsChanged (TableHeaderComponent*) override;
     /** @internal */
     void tableColumnsResized (TableHeaderComponent*) override;
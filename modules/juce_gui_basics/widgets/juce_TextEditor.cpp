@@ -108,6 +108,8 @@ public:
                 atoms.add (other.atoms.getReference(i));
                 ++i;
             }
+
+            totalLength += other.totalLength;
         }
     }
 
@@ -153,6 +155,12 @@ public:
             index = nextIndex;
         }
 
+        for (auto& atom : section2->atoms)
+            section2->totalLength += atom.numChars;
+
+        totalLength -= section2->totalLength;
+        atomStarts.resize (jmin (atomStarts.size(), (size_t) atoms.size()));
+
         return section2;
     }
 
@@ -187,12 +195,22 @@ public:
 
     int getTotalLength() const noexcept
     {
-        int total = 0;
+        return totalLength;
+    }
 
-        for (auto& atom : atoms)
-            total += atom.numChars;
+    // Returns the index of the atom which starts at the given character, or -1 if none does
+    int getIndexOfAtomStartingAt (int charIndex) const
+    {
+        // the offsets are only extended as far as needed, because text is usually appended
+        for (auto i = (int) atomStarts.size(); i < atoms.size(); ++i)
+            atomStarts.push_back (i == 0 ? 0 : atomStarts.back() + atoms.getReference (i - 1).numChars);
 
-        return total;
+        const auto found = std::lower_bound (atomStarts.begin(), atomStarts.end(), charIndex);
+
+        if (found == atomStarts.end() || *found != charIndex)
+            return -1;
+
+        return (int) std::distance (atomStarts.begin(), found);
     }
 
     void setFont (const Font& newFont, const juce_wchar passwordCharToUse)
@@ -214,6 +232,9 @@ public:
     juce_wchar passwordChar;
 
 private:
+    int totalLength = 0;
+    mutable std::vector<int> atomStarts;
+
     void initialiseAtoms (const String& textToParse)
     {
         auto text = textToParse.getCharPointer();
@@ -266,6 +287,8 @@ private:
             atom.width = (atom.isNewLine() ? 0.0f : font.getStringWidthFloat (atom.getText (passwordChar)));
             atom.numChars = (uint16) numChars;
             atoms.add (atom);
+
+            totalLength += atom.numChars;
         }
     }
 
@@ -614,53 +637,50 @@ struct TextEditor::Iterator
         return false;
     }
 
-    float getYOffset()
+    Rectangle<int> getTextBounds (Range<int> range) const
     {
-        if (justification.testFlags (Justification::top) || lineY >= bottomRight.y)
-            return 0;
-
-        while (next())
-        {
-            if (lineY >= bottomRight.y)
-                return 0;
-        }
-
-        auto bottom = jmax (0.0f, bottomRight.y - lineY - lineHeight);
-
-        if (justification.testFlags (Justification::bottom))
-            return bottom;
+        auto startX = indexToX (range.getStart());
+        auto endX   = indexToX (range.getEnd());
 
-        return bottom * 0.5f;
+        return Rectangle<float> (startX, lineY, endX - startX, lineHeight * lineSpacing).getSmallestIntegerContainer();
     }
 
-    int getTotalTextHeight()
+    //==============================================================================
+    // The state of the iterator after it has moved past a newline atom. Nothing that
+    // follows the newline affects it, so iteration can be resumed from here.
+    struct LineBreak
     {
-        while (next()) {}
-
-        auto height = lineY + lineHeight + getYOffset();
+        int indexInText;
+        float lineY, lineHeight, maxDescent, atomX, atomRight;
 
-        if (atom != nullptr && atom->isNewLine())
-            height += lineHeight;
-
-        return roundToInt (height);
-    }
+        bool hasSameLayoutAs (const LineBreak& other) const noexcept
+        {
+            return lineHeight == other.lineHeight && maxDescent == other.maxDescent
+                    && atomX == other.atomX && atomRight == other.atomRight;
+        }
+    };
 
-    int getTextRight()
+    LineBreak getLineBreak() const noexcept
     {
-        float maxWidth = 0.0f;
-
-        while (next())
-            maxWidth = jmax (maxWidth, atomRight);
-
-        return roundToInt (maxWidth);
+        jassert (atom != nullptr && atom->isNewLine());
+        return { indexInText, lineY, lineHeight, maxDescent, atomX, atomRight };
     }
 
-    Rectangle<int> getTextBounds (Range<int> range) const
+    void resumeAfter (int newSectionIndex, int newlineAtomIndex, const LineBreak& lineBreak)
     {
-        auto startX = indexToX (range.getStart());
-        auto endX   = indexToX (range.getEnd());
+        sectionIndex = newSectionIndex;
+        currentSection = sections.getUnchecked (sectionIndex);
+        atom = &(currentSection->atoms.getReference (newlineAtomIndex));
+        atomIndex = newlineAtomIndex + 1;
 
-        return Rectangle<float> (startX, lineY, endX - startX, lineHeight * lineSpacing).getSmallestIntegerContainer();
+        jassert (atom->isNewLine());
+
+        indexInText = lineBreak.indexInText;
+        lineY       = lineBreak.lineY;
+        lineHeight  = lineBreak.lineHeight;
+        maxDescent  = lineBreak.maxDescent;
+        atomX       = lineBreak.atomX;
+        atomRight   = lineBreak.atomRight;
     }
 
     //==============================================================================
@@ -739,6 +759,244 @@ private:
     JUCE_LEAK_DETECTOR (Iterator)
 };
 
+//==============================================================================
+// Remembers the layout at line breaks spread through the text, so that after an edit
+// only the lines between the edit and the next line break that's unaffected by it
+// need laying out again, and positions can be found without starting from the top.
+struct TextEditor::LayoutIndex
+{
+    explicit LayoutIndex (const TextEditor& ed)  : editor (ed) {}
+
+    //==============================================================================
+    void textChanged (int start, int numRemoved, int numInserted)
+    {
+        const auto first = getFirstCheckpointAtOrAfter (start);
+
+        checkpoints.erase (checkpoints.begin() + (ptrdiff_t) first,
+                           checkpoints.begin() + (ptrdiff_t) getFirstCheckpointAtOrAfter (start + numRemoved));
+
+        for (auto i = first; i < checkpoints.size(); ++i)
+            checkpoints[i].lineBreak.indexInText += numInserted - numRemoved;
+
+        numResolved = jmin (numResolved, first);
+        sectionStarts.clear();
+        isComplete = false;
+    }
+
+    void clear()
+    {
+        checkpoints.clear();
+        sectionStarts.clear();
+        numResolved = 0;
+        isComplete = false;
+    }
+
+    //==============================================================================
+    // Returns an iterator whose next atom is at or before the given character
+    Iterator getIteratorBefore (int index)
+    {
+        update();
+
+        Iterator i (editor);
+
+        const auto found = checkpoints.begin() + (ptrdiff_t) getFirstCheckpointAtOrAfter (index);
+
+        if (found != checkpoints.begin())
+            resume (i, std::prev (found)->lineBreak);
+
+        return i;
+    }
+
+    // Returns an iterator whose next atom is on a line that ends below the given position
+    Iterator getIteratorAbove (float y)
+    {
+        update();
+
+        Iterator i (editor);
+
+        const auto found = std::partition_point (checkpoints.begin(), checkpoints.end(), [&] (const Checkpoint& c)
+        {
+            return c.lineBreak.lineY + c.lineBreak.lineHeight * editor.lineSpacing <= y;
+        });
+
+        if (found != checkpoints.begin())
+            resume (i, std::prev (found)->lineBreak);
+
+        return i;
+    }
+
+    float getTextBottom()   { update(); return textBottom; }
+    float getTextRight()    { update(); return textRight; }
+
+    float getYOffset()
+    {
+        if (editor.justification.testFlags (Justification::top))
+            return 0;
+
+        update();
+
+        auto bottom = jmax (0.0f, (float) editor.getMaximumTextHeight() - endLineY - endLineHeight);
+
+        if (editor.justification.testFlags (Justification::bottom))
+            return bottom;
+
+        return bottom * 0.5f;
+    }
+
+private:
+    struct Checkpoint
+    {
+        Iterator::LineBreak lineBreak;
+        float maxRight; // of the atoms since the previous checkpoint
+    };
+
+    // the minimum number of characters between checkpoints
+    static constexpr int checkpointSpacing = 1024;
+
+    const TextEditor& editor;
+    std::vector<Checkpoint> checkpoints;
+    size_t numResolved = 0;
+    bool isComplete = false;
+    float textBottom = 0, textRight = 0, endLineY = 0, endLineHeight = 0;
+    std::tuple<int, int, int, juce_wchar, float, float> layoutKey;
+    std::vector<int> sectionStarts;
+
+    size_t getFirstCheckpointAtOrAfter (int index) const
+    {
+        const auto found = std::lower_bound (checkpoints.begin(), checkpoints.end(), index, [] (const Checkpoint& c, int i)
+        {
+            return c.lineBreak.indexInText < i;
+        });
+
+        return (size_t) std::distance (checkpoints.begin(), found);
+    }
+
+    bool resume (Iterator& i, const Iterator::LineBreak& lineBreak)
+    {
+        auto& sections = editor.sections;
+
+        if (sectionStarts.empty())
+        {
+            int start = 0;
+
+            for (auto* s : sections)
+            {
+                sectionStarts.push_back (start);
+                start += s->getTotalLength();
+            }
+        }
+
+        const auto nextSection = std::upper_bound (sectionStarts.begin(), sectionStarts.end(), lineBreak.indexInText);
+
+        if (nextSection == sectionStarts.begin())
+            return false;
+
+        const auto sectionIndex = (int) std::distance (sectionStarts.begin(), nextSection) - 1;
+        auto* section = sections.getUnchecked (sectionIndex);
+        const auto atomIndex = section->getIndexOfAtomStartingAt (lineBreak.indexInText - *std::prev (nextSection));
+
+        if (atomIndex < 0 || ! section->atoms.getReference (atomIndex).isNewLine())
+            return false;
+
+        i.resumeAfter (sectionIndex, atomIndex, lineBreak);
+        return true;
+    }
+
+    void relayout()
+    {
+        // the index is always kept in step with the text, so this shouldn't happen
+        jassertfalse;
+        clear();
+        update();
+    }
+
+    void update()
+    {
+        const auto key = std::make_tuple (editor.getWordWrapWidth(), editor.getMaximumTextWidth(), editor.justification.getFlags(),
+                                          editor.passwordCharacter, editor.lineSpacing, editor.currentFont.getHeight());
+
+        if (key != layoutKey)
+        {
+            layoutKey = key;
+            clear();
+        }
+
+        if (isComplete)
+            return;
+
+        // Checkpoints after an edit are kept until the layout reaches them again. If it's the
+        // same there as it was before, the rest of the text just needs moving up or down.
+        std::vector<Checkpoint> pending (checkpoints.begin() + (ptrdiff_t) numResolved, checkpoints.end());
+        checkpoints.resize (numResolved);
+        size_t nextPending = 0;
+
+        Iterator i (editor);
+
+        if (! checkpoints.empty() && ! resume (i, checkpoints.back().lineBreak))
+            return relayout();
+
+        auto lastIndex = checkpoints.empty() ? 0 : checkpoints.back().lineBreak.indexInText;
+        auto maxRight = 0.0f;
+
+        while (i.next())
+        {
+            maxRight = jmax (maxRight, i.atomRight);
+
+            if (! i.atom->isNewLine())
+                continue;
+
+            const auto lineBreak = i.getLineBreak();
+
+            while (nextPending < pending.size() && pending[nextPending].lineBreak.indexInText < lineBreak.indexInText)
+                ++nextPending;
+
+            if (nextPending < pending.size()
+                 && pending[nextPending].lineBreak.indexInText == lineBreak.indexInText
+                 && pending[nextPending].lineBreak.hasSameLayoutAs (lineBreak))
+            {
+                const auto deltaY = lineBreak.lineY - pending[nextPending].lineBreak.lineY;
+                checkpoints.push_back ({ lineBreak, maxRight });
+
+                for (auto j = nextPending + 1; j < pending.size(); ++j)
+                {
+                    pending[j].lineBreak.lineY += deltaY;
+                    checkpoints.push_back (pending[j]);
+                }
+
+                if (nextPending + 1 < pending.size() && ! resume (i, checkpoints.back().lineBreak))
+                    return relayout();
+
+                nextPending = pending.size();
+                lastIndex = checkpoints.back().lineBreak.indexInText;
+                maxRight = 0;
+            }
+            else if (lineBreak.indexInText - lastIndex >= checkpointSpacing)
+            {
+                checkpoints.push_back ({ lineBreak, maxRight });
+                lastIndex = lineBreak.indexInText;
+                maxRight = 0;
+            }
+        }
+
+        numResolved = checkpoints.size();
+        isComplete = true;
+
+        endLineY = i.lineY;
+        endLineHeight = i.lineHeight;
+        textBottom = i.lineY + i.lineHeight;
+
+        if (i.atom != nullptr && i.atom->isNewLine())
+            textBottom += i.lineHeight;
+
+        textRight = maxRight;
+
+        for (auto& c : checkpoints)
+            textRight = jmax (textRight, c.maxRight);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LayoutIndex)
+};
+
 
 //==============================================================================
 struct TextEditor::InsertAction  : public UndoableAction
@@ -936,6 +1194,7 @@ TextEditor::TextEditor (const String& name, juce_wchar passwordChar)
 {
     setMouseCursor (MouseCursor::IBeamCursor);
 
+    layoutIndex.reset (new LayoutIndex (*this));
     viewport.reset (new TextEditorViewport (*this));
     addAndMakeVisible (viewport.get());
     viewport->setViewedComponent (textHolder = new TextHolderComponent (*this));
@@ -1101,6 +1360,7 @@ void TextEditor::applyFontToAllText (const Font& newFont, bool changeCurrentFont
         uts->colour = overallColour;
     }
 
+    layoutIndex->clear();
     coalesceSimilarSections();
     checkLayout();
     scrollToMakeSureCursorIsVisible();
@@ -1167,9 +1427,8 @@ void TextEditor::updateCaretPosition()
     if (caret != nullptr
         && getWidth() > 0 && getHeight() > 0)
     {
-        Iterator i (*this);
         caret->setCaretPosition (getCaretRectangle().translated (leftIndent,
-                                                                 topIndent + roundToInt (i.getYOffset())) - getTextOffset());
+                                                                 topIndent + roundToInt (layoutIndex->getYOffset())) - getTextOffset());
 
         if (auto* handler = getAccessibilityHandler())
             handler->notifyAccessibilityEvent (AccessibilityEvent::textSelectionChanged);
@@ -1356,11 +1615,9 @@ void TextEditor::repaintText (Range<int> range)
             return;
         }
 
-        Iterator i (*this);
-
         Point<float> anchor;
         auto lh = currentFont.getHeight();
-        i.getCharPosition (range.getStart(), anchor, lh);
+        getCharPosition (range.getStart(), anchor, lh);
 
         auto y1 = std::trunc (anchor.y);
         int y2 = 0;
@@ -1371,11 +1628,11 @@ void TextEditor::repaintText (Range<int> range)
         }
         else
         {
-            i.getCharPosition (range.getEnd(), anchor, lh);
+            getCharPosition (range.getEnd(), anchor, lh);
             y2 = (int) (anchor.y + lh * 2.0f);
         }
 
-        auto offset = i.getYOffset();
+        auto offset = layoutIndex->getYOffset();
         textHolder->repaint (0, roundToInt (y1 + offset), textHolder->getWidth(), roundToInt ((float) y2 - y1 + offset));
     }
 }
@@ -1460,8 +1717,7 @@ Rectangle<int> TextEditor::getCaretRectangleForCharIndex (int index) const
 
 Point<int> TextEditor::getTextOffset() const noexcept
 {
-    Iterator i (*this);
-    auto yOffset = i.getYOffset();
+    auto yOffset = layoutIndex->getYOffset();
 
     return { getLeftIndent() + borderSize.getLeft() - viewport->getViewPositionX(),
              roundToInt ((float) getTopIndent() + (float) borderSize.getTop() + yOffset) - viewport->getViewPositionY() };
@@ -1470,9 +1726,9 @@ Point<int> TextEditor::getTextOffset() const noexcept
 RectangleList<int> TextEditor::getTextBounds (Range<int> textRange) const
 {
     RectangleList<int> boundingBox;
-    Iterator i (*this);
 
-    while (i.next())
+    for (auto i = layoutIndex->getIteratorBefore (textRange.getStart());
+         i.next() && i.indexInText < textRange.getEnd();)
     {
         if (textRange.intersects ({ i.indexInText,
                                     i.indexInText + i.atom->numChars }))
@@ -1509,9 +1765,9 @@ void TextEditor::checkLayout()
 {
     if (getWordWrapWidth() > 0)
     {
-        const auto textBottom = Iterator (*this).getTotalTextHeight() + topIndent;
+        const auto textBottom = roundToInt (layoutIndex->getTextBottom() + layoutIndex->getYOffset()) + topIndent;
         const auto textRight = jmax (viewport->getMaximumVisibleWidth(),
-                                     Iterator (*this).getTextRight() + leftIndent + rightEdgeSpace);
+                                     roundToInt (layoutIndex->getTextRight()) + leftIndent + rightEdgeSpace);
 
         textHolder->setSize (textRight, textBottom);
         viewport->setScrollBarsShown (scrollbarVisible && multiline && textBottom > viewport->getMaximumVisibleHeight(),
@@ -1718,7 +1974,7 @@ void TextEditor::drawContent (Graphics& g)
         g.setOrigin (leftIndent, topIndent);
         auto clip = g.getClipBounds();
 
-        auto yOffset = Iterator (*this).getYOffset();
+        auto yOffset = layoutIndex->getYOffset();
 
         AffineTransform transform;
 
@@ -1728,7 +1984,6 @@ void TextEditor::drawContent (Graphics& g)
             clip.setY (roundToInt ((float) clip.getY() - yOffset));
         }
 
-        Iterator i (*this);
         Colour selectedTextColour;
 
         if (! selection.isEmpty())
@@ -1745,6 +2000,10 @@ void TextEditor::drawContent (Graphics& g)
 
         const UniformTextSection* lastSection = nullptr;
 
+        // lines that end above the clip region can be skipped
+        auto firstVisibleY = (float) clip.getY() - 1.0f;
+        auto i = layoutIndex->getIteratorAbove (firstVisibleY);
+
         while (i.next() && i.lineY < (float) clip.getBottom())
         {
             if (i.lineY + i.lineHeight >= (float) clip.getY())
@@ -1763,7 +2022,7 @@ void TextEditor::drawContent (Graphics& g)
 
         for (auto& underlinedSection : underlinedSections)
         {
-            Iterator i2 (*this);
+            auto i2 = layoutIndex->getIteratorAbove (firstVisibleY);
 
             while (i2.next() && i2.lineY < (float) clip.getBottom())
             {
@@ -2342,6 +2601,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
             repaintText ({ insertIndex, getTotalNumChars() }); // must do this before and after changing the data, in case
                                                                // a line gets moved due to word wrap
 
+            const auto oldTotalNumChars = getTotalNumChars();
             int index = 0;
             int nextIndex = 0;
 
@@ -2368,8 +2628,10 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
             if (nextIndex == insertIndex)
                 sections.add (new UniformTextSection (text, font, colour, passwordCharacter));
 
-            coalesceSimilarSections();
             totalNumChars = -1;
+            layoutIndex->textChanged (insertIndex, 0, getTotalNumChars() - oldTotalNumChars);
+
+            coalesceSimilarSections();
             valueTextNeedsUpdating = true;
 
             checkLayout();
@@ -2382,6 +2644,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
 
 void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>& sectionsToInsert)
 {
+    const auto oldTotalNumChars = getTotalNumChars();
     int index = 0;
     int nextIndex = 0;
 
@@ -2414,8 +2677,10 @@ void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>
         for (auto* s : sectionsToInsert)
             sections.add (new UniformTextSection (*s));
 
-    coalesceSimilarSections();
     totalNumChars = -1;
+    layoutIndex->textChanged (insertIndex, 0, getTotalNumChars() - oldTotalNumChars);
+
+    coalesceSimilarSections();
     valueTextNeedsUpdating = true;
 }
 
@@ -2475,6 +2740,7 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
         }
         else
         {
+            const auto oldTotalNumChars = getTotalNumChars();
             auto remainingRange = range;
 
             for (int i = 0; i < sections.size(); ++i)
@@ -2498,8 +2764,10 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
                 }
             }
 
-            coalesceSimilarSections();
             totalNumChars = -1;
+            layoutIndex->textChanged (range.getStart(), oldTotalNumChars - getTotalNumChars(), 0);
+
+            coalesceSimilarSections();
             valueTextNeedsUpdating = true;
 
             checkLayout();
@@ -2582,7 +2850,7 @@ void TextEditor::getCharPosition (int index, Point<float>& anchor, float& lineHe
     }
     else
     {
-        Iterator i (*this);
+        auto i = layoutIndex->getIteratorBefore (index);
 
         if (sections.isEmpty())
         {
@@ -2600,7 +2868,7 @@ int TextEditor::indexAtPosition (const float x, const float y) const
 {
     if (getWordWrapWidth() > 0)
     {
-        for (Iterator i (*this); i.next();)
+        for (auto i = layoutIndex->getIteratorAbove (y); i.next();)
         {
             if (y < i.lineY + (i.lineHeight * lineSpacing))
             {
@@ -2677,6 +2945,8 @@ void TextEditor::splitSection (const int sectionIndex, const int charToSplitAt)
 
 void TextEditor::coalesceSimilarSections()
 {
+    int index = 0;
+
     for (int i = 0; i < sections.size() - 1; ++i)
     {
         auto* s1 = sections.getUnchecked (i);
@@ -2685,10 +2955,17 @@ void TextEditor::coalesceSimilarSections()
         if (s1->font == s2->font
              && s1->colour == s2->colour)
         {
+            // the atoms either side of the join may be merged, which can change the layout
+            layoutIndex->textChanged (index + s1->getTotalLength(), 0, 0);
+
             s1->append (*s2);
             sections.remove (i + 1);
             --i;
         }
+        else
+        {
+            index += s1->getTotalLength();
+        }
     }
 }
 
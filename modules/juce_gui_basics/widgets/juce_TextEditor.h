@@ -765,6 +765,7 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class UniformTextSection)
     struct Iterator;
+    struct LayoutIndex;
     struct TextHolderComponent;
     struct TextEditorViewport;
     struct InsertAction;
@@ -818,6 +819,7 @@ private:
     mutable int totalNumChars = 0;
     int caretPosition = 0;
     OwnedArray<UniformTextSection> sections;
+    std::unique_ptr<LayoutIndex> layoutIndex;
     String textToShowWhenEmpty;
     Colour colourForTextWhenEmpty;
     juce_wchar passwordCharacter;
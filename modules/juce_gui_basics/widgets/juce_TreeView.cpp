@@ -642,11 +642,19 @@ private:
 
         std::vector<TreeViewItem*> visibleItems;
 
-        auto* item = [&]
+        auto* item = [&]() -> TreeViewItem*
         {
             auto* i = owner.rootItemVisible ? owner.rootItem
                                             : owner.rootItem->subItems.getFirst();
 
+            if (owner.rootItem->hasUpToDateRows())
+            {
+                if (auto* found = findFirstItemAtOrBelow (owner.rootItem, visibleTop))
+                    return found != owner.rootItem || owner.rootItemVisible ? found : i;
+
+                return nullptr;
+            }
+
             while (i != nullptr && i->y < visibleTop)
                 i = getNextVisibleItem (i, true);
 
@@ -682,6 +690,28 @@ private:
         return visibleItems;
     }
 
+    // Finds the first item, in row order, whose top edge is at or below the given y position.
+    // Once the layout is up to date, the positions increase along each list of sub-items, so
+    // this only needs to binary-search one list per level rather than walking every row above it.
+    static TreeViewItem* findFirstItemAtOrBelow (TreeViewItem* item, int y)
+    {
+        if (item->y >= y)
+            return item;
+
+        if (! item->isOpen())
+            return nullptr;
+
+        auto& subItems = item->subItems;
+        const auto next = std::partition_point (subItems.begin(), subItems.end(),
+                                                [y] (const TreeViewItem* i) { return i->y < y; });
+
+        if (next != subItems.begin())
+            if (auto* found = findFirstItemAtOrBelow (*std::prev (next), y))
+                return found;
+
+        return next != subItems.end() ? *next : nullptr;
+    }
+
     //==============================================================================
     class Deleter
     {
@@ -758,6 +788,18 @@ public:
             handleAsyncUpdate();
     }
 
+    // The row numbers cached by the last layout stay valid until the tree's structure
+    // changes, even if the positions are being recalculated for some other reason.
+    bool hasUpToDateRows (const TreeViewItem& item) const noexcept
+    {
+        return item.layoutGeneration == layoutGeneration;
+    }
+
+    void rowsChanged() noexcept
+    {
+        ++layoutGeneration;
+    }
+
 private:
     std::unique_ptr<AccessibilityHandler> createAccessibilityHandler() override
     {
@@ -778,7 +820,7 @@ private:
             {
                 const auto startY = owner.rootItemVisible ? 0 : -root->itemHeight;
 
-                root->updatePositions (startY);
+                root->updatePositions (startY, 0, ++layoutGeneration);
                 getViewedComponent()->setSize (jmax (getMaximumVisibleWidth(), root->totalWidth + 50),
                                                root->totalHeight + startY);
             }
@@ -808,7 +850,7 @@ private:
     }
 
     TreeView& owner;
-    int lastX = -1;
+    int lastX = -1, layoutGeneration = 0;
     bool structureChanged = false, needsRecalculating = false;
     std::optional<Point<int>> viewportAfterRecalculation;
 
@@ -849,6 +891,7 @@ void TreeView::setRootItem (TreeViewItem* const newRootItem)
             rootItem->setOwnerView (nullptr);
 
         rootItem = newRootItem;
+        viewport->rowsChanged();
 
         if (newRootItem != nullptr)
             newRootItem->setOwnerView (this);
@@ -908,6 +951,7 @@ void TreeView::setDefaultOpenness (const bool isOpenByDefault)
     if (defaultOpenness != isOpenByDefault)
     {
         defaultOpenness = isOpenByDefault;
+        viewport->rowsChanged();
         updateVisibleItems();
     }
 }
@@ -1858,7 +1902,10 @@ Rectangle<int> TreeViewItem::getItemPosition (const bool relativeToTreeViewTopLe
 void TreeViewItem::treeHasChanged() const noexcept
 {
     if (ownerView != nullptr)
+    {
+        ownerView->viewport->rowsChanged();
         ownerView->updateVisibleItems();
+    }
 }
 
 void TreeViewItem::repaintItem() const
@@ -1874,9 +1921,11 @@ bool TreeViewItem::areAllParentsOpen() const noexcept
             || (parentItem->isOpen() && parentItem->areAllParentsOpen());
 }
 
-void TreeViewItem::updatePositions (int newY)
+void TreeViewItem::updatePositions (int newY, int newRow, int generation)
 {
     y = newY;
+    row = newRow;
+    numOpenRows = 1;
     itemHeight = getItemHeight();
     totalHeight = itemHeight;
     itemWidth = getItemWidth();
@@ -1886,14 +1935,26 @@ void TreeViewItem::updatePositions (int newY)
     {
         newY += totalHeight;
 
-        for (auto* i : subItems)
+        for (int index = 0; index < subItems.size(); ++index)
         {
-            i->updatePositions (newY);
+            auto* i = subItems.getUnchecked (index);
+            i->indexInParent = index;
+            i->updatePositions (newY, newRow + numOpenRows, generation);
             newY += i->totalHeight;
             totalHeight += i->totalHeight;
+            numOpenRows += i->numOpenRows;
             totalWidth = jmax (totalWidth, i->totalWidth);
         }
     }
+
+    // Only marked as laid out once the sub-items are done, in case any of the
+    // getItemHeight() callbacks ask for row numbers in the meantime.
+    layoutGeneration = generation;
+}
+
+bool TreeViewItem::hasUpToDateRows() const noexcept
+{
+    return ownerView != nullptr && ownerView->viewport->hasUpToDateRows (*this);
 }
 
 const TreeViewItem* TreeViewItem::getDeepestOpenParentItem() const noexcept
@@ -1963,8 +2024,13 @@ bool TreeViewItem::isLastOfSiblings() const noexcept
 
 int TreeViewItem::getIndexInParent() const noexcept
 {
-    return parentItem == nullptr ? 0
-                                 : parentItem->subItems.indexOf (this);
+    if (parentItem == nullptr)
+        return 0;
+
+    if (parentItem->subItems[indexInParent] == this)
+        return indexInParent;
+
+    return parentItem->subItems.indexOf (this);
 }
 
 TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
@@ -1975,6 +2041,9 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
 
 int TreeViewItem::getNumRows() const noexcept
 {
+    if (hasUpToDateRows())
+        return numOpenRows;
+
     int num = 1;
 
     if (isOpen())
@@ -1991,6 +2060,18 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
 
     if (index > 0 && isOpen())
     {
+        if (hasUpToDateRows())
+        {
+            if (index >= numOpenRows)
+                return nullptr;
+
+            const auto targetRow = row + index;
+            auto* i = *std::prev (std::upper_bound (subItems.begin(), subItems.end(), targetRow,
+                                                    [] (int r, const TreeViewItem* item) { return r < item->row; }));
+
+            return i->getItemOnRow (targetRow - i->row);
+        }
+
         --index;
 
         for (auto* i : subItems)
@@ -2052,6 +2133,9 @@ int TreeViewItem::getRowNumberInTree() const noexcept
         if (! parentItem->isOpen())
             return parentItem->getRowNumberInTree();
 
+        if (hasUpToDateRows())
+            return row - (ownerView->rootItemVisible ? 0 : 1);
+
         auto n = 1 + parentItem->getRowNumberInTree();
 
         auto ourIndex = parentItem->subItems.indexOf (this);
@@ -123,6 +123,7 @@ public:
     void sortSubItems (ElementComparator& comparator)
     {
         subItems.sort (comparator);
+        treeHasChanged();
     }
 
     //==============================================================================
@@ -609,7 +610,8 @@ private:
     //==============================================================================
     friend class TreeView;
 
-    void updatePositions (int);
+    void updatePositions (int, int, int);
+    bool hasUpToDateRows() const noexcept;
     int getIndentX() const noexcept;
     void setOwnerView (TreeView*) noexcept;
     TreeViewItem* getTopLevelItem() noexcept;
@@ -635,6 +637,7 @@ private:
 
     Openness openness = Openness::opennessDefault;
     int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0, uid = 0;
+    int row = 0, numOpenRows = 1, indexInParent = 0, layoutGeneration = -1;
     bool selected = false, redrawNeeded = true, drawLinesInside = false, drawLinesSet = false,
          drawsInLeftMargin = false, drawsInRightMargin = false;
 
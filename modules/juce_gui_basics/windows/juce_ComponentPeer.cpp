@@ -28,11 +28,160 @@ namespace juce
 
 static uint32 lastUniquePeerID = 1;
 
+//==============================================================================
+/*  Estimates the time taken to paint a frame as
+
+        fixed + perRectangle * numRectangles + perPixel * numPixels
+
+    with a least-squares fit over recent frames, weighting older frames less. The ratio of the
+    per-rectangle and per-pixel costs gives the number of extra pixels that it's worth painting
+    to avoid painting one more rectangle.
+*/
+class ComponentPeer::RepaintCostModel
+{
+public:
+    static constexpr int64 defaultMergeThreshold = 4096, minMergeThreshold = 256, maxMergeThreshold = 65536;
+
+    void addFrame (int numRectangles, int64 numPixels, double milliseconds)
+    {
+        const double x[] { 1.0, (double) numRectangles, (double) numPixels };
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                products[i][j] = products[i][j] * decay + x[i] * x[j];
+
+            productsWithTime[i] = productsWithTime[i] * decay + x[i] * milliseconds;
+        }
+
+        updateMergeThreshold();
+    }
+
+    int64 getMergeThreshold() const noexcept    { return mergeThreshold; }
+
+    /*  Repeatedly replaces the pair of rectangles whose bounding box adds the fewest extra
+        pixels with that bounding box, for as long as the extra area is within the limit.
+    */
+    static void mergeRectangles (RectangleList<int>& region, int64 maxWastedPixels)
+    {
+        if (region.getNumRectangles() < 2)
+            return;
+
+        // Consolidating can sometimes split a region into more pieces, so the original is
+        // only replaced by a result that really has fewer rectangles.
+        auto consolidated = region;
+        consolidated.consolidate();
+
+        if (consolidated.getNumRectangles() < region.getNumRectangles())
+            region.swapWith (consolidated);
+
+        // The search is quadratic in the number of rectangles, so leave very fragmented
+        // regions alone rather than spending longer on this than on the painting.
+        constexpr int maxRectanglesToSearch = 64;
+
+        if (region.getNumRectangles() < 2 || region.getNumRectangles() > maxRectanglesToSearch)
+            return;
+
+        std::vector<Rectangle<int>> rects (region.begin(), region.end());
+        bool anyMerged = false;
+
+        for (;;)
+        {
+            auto bestWaste = maxWastedPixels + 1;
+            size_t bestA = 0, bestB = 0;
+
+            for (size_t a = 0; a < rects.size(); ++a)
+            {
+                for (size_t b = a + 1; b < rects.size(); ++b)
+                {
+                    const auto waste = getArea (rects[a].getUnion (rects[b])) - getArea (rects[a]) - getArea (rects[b]);
+
+                    if (waste < bestWaste)
+                    {
+                        bestWaste = waste;
+                        bestA = a;
+                        bestB = b;
+                    }
+                }
+            }
+
+            if (bestWaste > maxWastedPixels)
+                break;
+
+            rects[bestA] = rects[bestA].getUnion (rects[bestB]);
+            rects.erase (rects.begin() + (std::ptrdiff_t) bestB);
+            anyMerged = true;
+        }
+
+        if (! anyMerged)
+            return;
+
+        // (merged rectangles can overlap, and the list splits any overlaps back up)
+        RectangleList<int> merged;
+
+        for (auto& r : rects)
+            merged.add (r);
+
+        if (merged.getNumRectangles() < region.getNumRectangles())
+            region.swapWith (merged);
+    }
+
+    static int64 getArea (Rectangle<int> r) noexcept
+    {
+        return (int64) r.getWidth() * (int64) r.getHeight();
+    }
+
+private:
+    void updateMergeThreshold()
+    {
+        // products[0][0] is the weighted number of frames seen
+        if (products[0][0] < minFramesForEstimate)
+            return;
+
+        const auto det = determinant (products[0], products[1], products[2]);
+
+        // If the number of rectangles or pixels hasn't varied enough, the costs can't be
+        // separated, so stick with the previous estimate.
+        if (std::abs (det) <= 1.0e-9 * products[0][0] * products[1][1] * products[2][2])
+            return;
+
+        double withRectangles[3][3], withPixels[3][3];
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                withRectangles[i][j] = (j == 1 ? productsWithTime[i] : products[i][j]);
+                withPixels[i][j]     = (j == 2 ? productsWithTime[i] : products[i][j]);
+            }
+        }
+
+        const auto perRectangle = determinant (withRectangles[0], withRectangles[1], withRectangles[2]) / det;
+        const auto perPixel     = determinant (withPixels[0], withPixels[1], withPixels[2]) / det;
+
+        if (perRectangle > 0 && perPixel > 0)
+            mergeThreshold = (int64) std::round (jlimit ((double) minMergeThreshold, (double) maxMergeThreshold, perRectangle / perPixel));
+    }
+
+    static double determinant (const double* r0, const double* r1, const double* r2) noexcept
+    {
+        return r0[0] * (r1[1] * r2[2] - r1[2] * r2[1])
+             - r0[1] * (r1[0] * r2[2] - r1[2] * r2[0])
+             + r0[2] * (r1[0] * r2[1] - r1[1] * r2[0]);
+    }
+
+    static constexpr double decay = 0.98, minFramesForEstimate = 8.0;
+
+    double products[3][3] {}, productsWithTime[3] {};
+    int64 mergeThreshold = defaultMergeThreshold;
+};
+
 //==============================================================================
 ComponentPeer::ComponentPeer (Component& comp, int flags)
     : component (comp),
       styleFlags (flags),
-      uniqueID (lastUniquePeerID += 2) // increment by 2 so that this can never hit 0
+      uniqueID (lastUniquePeerID += 2), // increment by 2 so that this can never hit 0
+      repaintCostModel (std::make_unique<RepaintCostModel>())
 {
     auto& desktop = Desktop::getInstance();
     desktop.peers.add (this);
@@ -161,6 +310,64 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
     jassert (roundToInt (10.1f) == 10);
 }
 
+//==============================================================================
+void ComponentPeer::setMaximumFrameRate (double framesPerSecond)
+{
+    jassert (framesPerSecond >= 0);
+    maximumFrameRate = jmax (0.0, framesPerSecond);
+}
+
+bool ComponentPeer::beginFrameIfDue()
+{
+    if (maximumFrameRate <= 0)
+        return true;
+
+    const auto now = Time::getMillisecondCounterHiRes();
+
+    // The vblank callbacks jitter a little, so allow some slack, otherwise a limit that
+    // divides the display's refresh rate would keep missing its vblank by a fraction.
+    if (now - lastFrameTime < 900.0 / maximumFrameRate)
+        return false;
+
+    lastFrameTime = now;
+    return true;
+}
+
+void ComponentPeer::optimiseRepaintRegion (RectangleList<int>& region) const
+{
+    RepaintCostModel::mergeRectangles (region, repaintCostModel->getMergeThreshold());
+}
+
+void ComponentPeer::frameWasPainted (const RectangleList<int>& regionPainted, double milliseconds)
+{
+    int64 numPixels = 0;
+
+    for (auto& r : regionPainted)
+        numPixels += RepaintCostModel::getArea (r);
+
+    auto& stats = frameStatistics;
+    stats.averagePaintMilliseconds = stats.numFramesPainted == 0 ? milliseconds
+                                                                 : stats.averagePaintMilliseconds + 0.1 * (milliseconds - stats.averagePaintMilliseconds);
+    ++stats.numFramesPainted;
+    stats.lastPaintMilliseconds = milliseconds;
+    stats.lastNumPixelsPainted = numPixels;
+    stats.lastNumRectangles = regionPainted.getNumRectangles();
+
+    repaintCostModel->addFrame (regionPainted.getNumRectangles(), numPixels, milliseconds);
+}
+
+ComponentPeer::FrameStatistics ComponentPeer::getFrameStatistics() const noexcept
+{
+    auto stats = frameStatistics;
+    stats.mergeThresholdPixels = repaintCostModel->getMergeThreshold();
+    return stats;
+}
+
+void ComponentPeer::resetFrameStatistics() noexcept
+{
+    frameStatistics = {};
+}
+
 Component* ComponentPeer::getTargetForKeyPress()
 {
     auto* c = Component::getCurrentlyFocusedComponent();
@@ -611,4 +818,97 @@ void ComponentPeer::globalFocusChanged ([[maybe_unused]] Component* comp)
     refreshTextInputTarget();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ComponentPeerRepaintCostModelTests  : public UnitTest
+{
+    ComponentPeerRepaintCostModelTests()
+        : UnitTest ("ComponentPeer repaint cost model", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        using Model = ComponentPeer::RepaintCostModel;
+
+        beginTest ("Nearby rectangles are merged when the extra area is small");
+        {
+            RectangleList<int> region;
+            region.addWithoutMerging ({ 0, 0, 10, 10 });
+            region.addWithoutMerging ({ 12, 0, 10, 10 });
+            region.addWithoutMerging ({ 500, 500, 10, 10 });
+
+            Model::mergeRectangles (region, 100);
+
+            expectEquals (region.getNumRectangles(), 2);
+            expect (region.containsRectangle ({ 0, 0, 22, 10 }));
+            expect (region.containsRectangle ({ 500, 500, 10, 10 }));
+        }
+
+        beginTest ("Distant rectangles are left alone");
+        {
+            RectangleList<int> region;
+            region.addWithoutMerging ({ 0, 0, 10, 10 });
+            region.addWithoutMerging ({ 100, 100, 10, 10 });
+
+            Model::mergeRectangles (region, 100);
+
+            expectEquals (region.getNumRectangles(), 2);
+        }
+
+        beginTest ("Merging never loses any of the original area");
+        {
+            Random r (getRandom());
+
+            for (int i = 0; i < 50; ++i)
+            {
+                RectangleList<int> original;
+
+                for (int j = 0; j < 10; ++j)
+                    original.add ({ r.nextInt (200), r.nextInt (200), 1 + r.nextInt (40), 1 + r.nextInt (40) });
+
+                auto merged = original;
+                Model::mergeRectangles (merged, r.nextInt (2000));
+
+                auto missing = original;
+                missing.subtract (merged);
+                expect (missing.isEmpty());
+                expect (merged.getNumRectangles() <= original.getNumRectangles());
+            }
+        }
+
+        beginTest ("Threshold is the ratio of per-rectangle to per-pixel cost");
+        {
+            Model model;
+            expectEquals (model.getMergeThreshold(), Model::defaultMergeThreshold);
+
+            Random r (getRandom());
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto numRects = 1 + r.nextInt (20);
+                const auto numPixels = (int64) (1000 + r.nextInt (200000));
+                model.addFrame (numRects, numPixels, 0.5 + 0.2 * numRects + 0.0001 * (double) numPixels);
+            }
+
+            expectEquals (model.getMergeThreshold(), (int64) 2000);
+        }
+
+        beginTest ("Threshold is unchanged when the costs can't be told apart");
+        {
+            Model model;
+
+            for (int i = 0; i < 100; ++i)
+                model.addFrame (1, 10000, 1.0);
+
+            expectEquals (model.getMergeThreshold(), Model::defaultMergeThreshold);
+        }
+    }
+};
+
+static ComponentPeerRepaintCostModelTests componentPeerRepaintCostModelTests;
+
+#endif
+
 } // namespace juce
@@ -501,6 +501,58 @@ public:
     /** Removes a VBlankListener. */
     void removeVBlankListener (VBlankListener* listenerToRemove) { vBlankListeners.remove (listenerToRemove); }
 
+    //==============================================================================
+    /** Limits the rate at which the peer will repaint itself.
+
+        Normally, pending repaints are dispatched on every vertical blank. Setting a maximum
+        frame rate makes the peer hold repaints back until enough time has passed since the
+        previous frame; everything invalidated in the meantime is painted together.
+
+        Pass 0 to remove the limit, which is the default. Explicit calls to
+        performAnyPendingRepaintsNow() aren't affected.
+    */
+    void setMaximumFrameRate (double framesPerSecond);
+
+    /** Returns the limit set by setMaximumFrameRate(), or 0 if there isn't one. */
+    double getMaximumFrameRate() const noexcept                  { return maximumFrameRate; }
+
+    /** Timing information about the frames that the peer has painted.
+
+        @see getFrameStatistics
+    */
+    struct JUCE_API  FrameStatistics
+    {
+        /** The number of frames painted since the statistics were last reset. */
+        int64 numFramesPainted = 0;
+
+        /** The time taken to paint the most recent frame, in milliseconds. */
+        double lastPaintMilliseconds = 0;
+
+        /** A smoothed average of the time taken to paint a frame, in milliseconds. */
+        double averagePaintMilliseconds = 0;
+
+        /** The number of physical pixels that were touched by the most recent frame. */
+        int64 lastNumPixelsPainted = 0;
+
+        /** The number of rectangles that made up the most recent frame's repaint region. */
+        int lastNumRectangles = 0;
+
+        /** The largest repaint region area, in pixels, that is currently allowed to be
+            wasted when two rectangles are merged into one. This adapts to the measured cost
+            of painting.
+        */
+        int64 mergeThresholdPixels = 0;
+    };
+
+    /** Returns timing information about the frames that this peer has painted.
+
+        Not all platforms are able to measure this, in which case the statistics stay empty.
+    */
+    FrameStatistics getFrameStatistics() const noexcept;
+
+    /** Clears the frame statistics, leaving the repaint merging heuristics as they were. */
+    void resetFrameStatistics() noexcept;
+
     //==============================================================================
     /** On Windows and Linux this will return the OS scaling factor currently being applied
         to the native window. This is used to convert between physical and logical pixels
@@ -546,6 +598,23 @@ protected:
     //==============================================================================
     static void forceDisplayUpdate();
 
+    /** Peer implementations should call this before dispatching deferred repaints from a
+        vblank callback. It returns false if the frame should be skipped to honour the
+        maximum frame rate, otherwise it starts a new frame and returns true.
+    */
+    bool beginFrameIfDue();
+
+    /** Merges rectangles in a repaint region wherever painting the extra area between them
+        is likely to be cheaper than painting them separately, based on the cost of
+        previous frames.
+    */
+    void optimiseRepaintRegion (RectangleList<int>& region) const;
+
+    /** Peer implementations should call this after painting, with the region that was
+        painted and the time that it took.
+    */
+    void frameWasPainted (const RectangleList<int>& regionPainted, double milliseconds);
+
     Component& component;
     const int styleFlags;
     Rectangle<int> lastNonFullscreenBounds;
@@ -586,6 +655,12 @@ private:
     const uint32 uniqueID;
     bool isWindowMinimised = false;
 
+    class RepaintCostModel;
+    friend struct ComponentPeerRepaintCostModelTests;
+    std::unique_ptr<RepaintCostModel> repaintCostModel;
+    FrameStatistics frameStatistics;
+    double maximumFrameRate = 0, lastFrameTime = 0;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentPeer)
 };
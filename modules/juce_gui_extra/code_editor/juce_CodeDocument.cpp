@@ -414,7 +414,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -427,7 +427,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -452,13 +452,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
                 for (int i = lineStart; i < lineEnd; ++i)
                 {
                     auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+                    auto lineStartInFile = owner->getLineStart (i);
+                    auto index = newPosition - lineStartInFile;
 
                     if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
                     {
                         line = i;
                         indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
+                        characterPos = lineStartInFile + indexInLine;
                     }
                 }
 
@@ -468,7 +469,7 @@ void CodeDocument::Position::setPosition (const int newPosition)
             {
                 auto midIndex = (lineStart + lineEnd + 1) / 2;
 
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
+                if (newPosition >= owner->getLineStart (midIndex))
                     lineStart = midIndex;
                 else
                     lineEnd = midIndex;
@@ -615,7 +616,7 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 int CodeDocument::getNumCharacters() const noexcept
 {
     if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+        return getLineStart (lines.size() - 1) + lastLine->lineLength;
 
     return 0;
 }
@@ -864,16 +865,42 @@ void CodeDocument::checkLastLineStatus()
         lines.removeLast();
     }
 
+    lineStartsShiftedFrom = jmin (lineStartsShiftedFrom, lines.size());
+
     const CodeDocumentLine* const lastLine = lines.getLast();
 
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
+        // the new line's start is stored in the same way as the preceding one's
+        if (lineStartsShiftedFrom == lines.size())
+            ++lineStartsShiftedFrom;
+
         // check that there's an empty line at the end if the preceding one ends in a newline..
         lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
                                          lastLine->lineStartInFile + lastLine->lineLength));
     }
 }
 
+int CodeDocument::getLineStart (int lineIndex) const noexcept
+{
+    return lines.getUnchecked (lineIndex)->lineStartInFile
+             + (lineIndex >= lineStartsShiftedFrom ? lineStartsShift : 0);
+}
+
+void CodeDocument::moveLineStartShift (int firstLineToShift) noexcept
+{
+    if (lineStartsShift != 0)
+    {
+        for (int i = firstLineToShift; i < lineStartsShiftedFrom; ++i)
+            lines.getUnchecked (i)->lineStartInFile -= lineStartsShift;
+
+        for (int i = lineStartsShiftedFrom; i < firstLineToShift; ++i)
+            lines.getUnchecked (i)->lineStartInFile += lineStartsShift;
+    }
+
+    lineStartsShiftedFrom = firstLineToShift;
+}
+
 //==============================================================================
 void CodeDocument::addListener    (CodeDocument::Listener* l)   { listeners.add (l); }
 void CodeDocument::removeListener (CodeDocument::Listener* l)   { listeners.remove (l); }
@@ -933,11 +960,18 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
                                          + firstLine->line.substring (index);
             }
 
-            maximumLineLength = -1;
             Array<CodeDocumentLine*> newLines;
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
+            if (firstLine != nullptr && firstLine->lineLength >= maximumLineLength)
+                maximumLineLength = -1;
+            else if (maximumLineLength >= 0)
+                for (auto* l : newLines)
+                    maximumLineLength = jmax (maximumLineLength, l->lineLength);
+
+            moveLineStartShift (jmin (firstAffectedLine + 1, lines.size()));
+
             auto* newFirstLine = newLines.getUnchecked (0);
             newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
             lines.set (firstAffectedLine, newFirstLine);
@@ -947,13 +981,17 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
 
             int lineStart = newFirstLine->lineStartInFile;
 
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
+            for (int i = firstAffectedLine; i < firstAffectedLine + newLines.size(); ++i)
             {
                 auto& l = *lines.getUnchecked (i);
                 l.lineStartInFile = lineStart;
                 lineStart += l.lineLength;
             }
 
+            // the lines after the new ones just move along by the length of the text
+            lineStartsShiftedFrom = firstAffectedLine + newLines.size();
+            lineStartsShift += text.length();
+
             checkLastLineStatus();
             auto newTextLength = text.length();
 
@@ -1013,10 +1051,22 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         Position startPosition (*this, startPos);
         Position endPosition (*this, endPos);
 
-        maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
+        int oldLength = 0;
+
+        for (int i = firstAffectedLine; i <= endLine; ++i)
+        {
+            auto lineLength = lines.getUnchecked (i)->lineLength;
+
+            if (lineLength >= maximumLineLength)
+                maximumLineLength = -1;
+
+            oldLength += lineLength;
+        }
+
+        moveLineStartShift (firstAffectedLine + 1);
 
         if (firstAffectedLine == endLine)
         {
@@ -1036,12 +1086,10 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
+        if (maximumLineLength >= 0)
+            maximumLineLength = jmax (maximumLineLength, firstLine.lineLength);
+
+        lineStartsShift += firstLine.lineLength - oldLength;
 
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
@@ -440,9 +440,17 @@ private:
     ListenerList<Listener> listeners;
     String newLineChars { "\r\n" };
 
+    // The start positions of the lines from lineStartsShiftedFrom onwards don't include the
+    // shift of lineStartsShift, which is added when they're read. Like the gap in a gap buffer,
+    // this boundary is moved to each edit, so a run of edits in one area of a large document
+    // doesn't have to update every line that follows it.
+    int lineStartsShiftedFrom = 0, lineStartsShift = 0;
+
     void insert (const String& text, int insertPos, bool undoable);
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
+    int getLineStart (int lineIndex) const noexcept;
+    void moveLineStartShift (int firstLineToShift) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };
@@ -329,6 +329,12 @@ private:
 
 namespace CodeEditorHelpers
 {
+    static int getLinesBetweenCachedIterators (const CodeDocument& document) noexcept
+    {
+        const int maxNumCachedPositions = 5000;
+        return jmax (10, document.getNumLines() / maxNumCachedPositions);
+    }
+
     static int findFirstNonWhitespaceChar (StringRef line) noexcept
     {
         auto t = line.text;
@@ -383,6 +389,172 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
+//==============================================================================
+/*  Tokenises a copy of a stretch of the document on a TimeSliceThread, and hands the
+    resulting resync points back to the editor's cachedIterators on the message thread.
+*/
+class CodeEditorComponent::BackgroundTokeniser  : public TimeSliceClient,
+                                                  private AsyncUpdater
+{
+public:
+    BackgroundTokeniser (CodeEditorComponent& ed, TimeSliceThread& t)
+        : owner (ed), thread (t)
+    {
+    }
+
+    ~BackgroundTokeniser() override
+    {
+        thread.removeTimeSliceClient (this);
+        cancelPendingUpdate();
+    }
+
+    static constexpr int maxLinesToTokeniseSynchronously = 2000;
+
+    void tokeniseUpToLine (int lineNum)
+    {
+        jassert (owner.cachedIterators.size() > 0 && owner.codeTokeniser != nullptr);
+
+        if (owner.cachedIteratorsVersion == requestedVersion && lineNum <= requestedUpToLine)
+            return;
+
+        auto& document = owner.document;
+        const auto& start = owner.cachedIterators.getReference (owner.cachedIterators.size() - 1);
+
+        requestedVersion = owner.cachedIteratorsVersion;
+        requestedUpToLine = jmin (document.getNumLines(), lineNum + maxLinesToTokeniseSynchronously);
+
+        // The copy ends a line beyond the last one we need, so that a token which runs
+        // off the end of it can't move any of the resync points that get used.
+        Job job;
+        job.tokeniser = owner.codeTokeniser;
+        job.version = requestedVersion;
+        job.startPosition = start.getPosition();
+        job.linesBetweenResults = CodeEditorHelpers::getLinesBetweenCachedIterators (document);
+        job.text = document.getTextBetween (CodeDocument::Position (document, start.getPosition()),
+                                            CodeDocument::Position (document, requestedUpToLine + 2, 0));
+
+        {
+            const ScopedLock sl (lock);
+            job.jobID = ++latestJobID;
+            pendingJob = std::move (job);
+        }
+
+        thread.addTimeSliceClient (this);
+    }
+
+    int useTimeSlice() override
+    {
+        Optional<Job> job;
+
+        {
+            const ScopedLock sl (lock);
+            job.swap (pendingJob);
+        }
+
+        if (! job.hasValue())
+            return -1;
+
+        CodeDocument copy;
+        copy.replaceAllContent (job->text);
+
+        CodeDocument::Iterator t (copy);
+        const int lastUsableLine = copy.getNumLines() - 2;
+        int nextLine = job->linesBetweenResults;
+        Array<int> positions;
+
+        while (! t.isEOF())
+        {
+            job->tokeniser->readNextToken (t);
+
+            if (t.getLine() >= nextLine)
+            {
+                if (t.getLine() >= lastUsableLine)
+                    break;
+
+                positions.add (t.getPosition());
+                nextLine = t.getLine() + job->linesBetweenResults;
+
+                if (positions.size() >= 64)
+                {
+                    if (latestJobID != job->jobID)
+                        return 0;
+
+                    publish (*job, positions);
+                }
+            }
+        }
+
+        publish (*job, positions);
+        return 0;
+    }
+
+private:
+    struct Job
+    {
+        CodeTokeniser* tokeniser = nullptr;
+        String text;
+        int jobID = 0, version = 0, startPosition = 0, linesBetweenResults = 0;
+    };
+
+    CodeEditorComponent& owner;
+    TimeSliceThread& thread;
+    int requestedVersion = -1, requestedUpToLine = 0;
+
+    CriticalSection lock;
+    Optional<Job> pendingJob;
+    std::atomic<int> latestJobID { 0 };
+    Array<int> results;
+    int resultsVersion = -1;
+
+    void publish (const Job& job, Array<int>& positions)
+    {
+        if (positions.isEmpty())
+            return;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (resultsVersion != job.version)
+                results.clearQuick();
+
+            resultsVersion = job.version;
+
+            for (auto p : positions)
+                results.add (job.startPosition + p);
+        }
+
+        positions.clearQuick();
+        triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        Array<int> positions;
+        int version;
+
+        {
+            const ScopedLock sl (lock);
+            positions.swapWith (results);
+            version = resultsVersion;
+        }
+
+        auto& cachedIterators = owner.cachedIterators;
+
+        if (version != owner.cachedIteratorsVersion || positions.isEmpty() || cachedIterators.isEmpty())
+            return;
+
+        // Every resync point lies on the same chain of token boundaries, so anything beyond
+        // the last cached iterator can simply be appended.
+        for (auto p : positions)
+            if (p > cachedIterators.getReference (cachedIterators.size() - 1).getPosition())
+                cachedIterators.add (CodeDocument::Iterator (CodeDocument::Position (owner.document, p)));
+
+        owner.rebuildLineTokens();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundTokeniser)
+};
+
 //==============================================================================
 class CodeEditorComponent::GutterComponent  : public Component
 {
@@ -684,6 +856,14 @@ void CodeEditorComponent::retokenise (int startIndex, [[maybe_unused]] int endIn
     rebuildLineTokensAsync();
 }
 
+void CodeEditorComponent::setTokenisationThread (TimeSliceThread* thread)
+{
+    backgroundTokeniser.reset();
+
+    if (thread != nullptr)
+        backgroundTokeniser.reset (new BackgroundTokeniser (*this, *thread));
+}
+
 //==============================================================================
 void CodeEditorComponent::updateCaretPosition()
 {
@@ -1732,18 +1912,25 @@ void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
             break;
 
     cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
+    ++cachedIteratorsVersion;
 }
 
 void CodeEditorComponent::updateCachedIterators (int maxLineNum)
 {
-    const int maxNumCachedPositions = 5000;
-    const int linesBetweenCachedSources = jmax (10, document.getNumLines() / maxNumCachedPositions);
+    const int linesBetweenCachedSources = CodeEditorHelpers::getLinesBetweenCachedIterators (document);
 
     if (cachedIterators.size() == 0)
         cachedIterators.add (CodeDocument::Iterator (document));
 
     if (codeTokeniser != nullptr)
     {
+        if (backgroundTokeniser != nullptr
+             && maxLineNum - cachedIterators.getLast().getLine() > BackgroundTokeniser::maxLinesToTokeniseSynchronously)
+        {
+            backgroundTokeniser->tokeniseUpToLine (maxLineNum);
+            return;
+        }
+
         for (;;)
         {
             const auto last = cachedIterators.getLast();
@@ -1784,6 +1971,19 @@ void CodeEditorComponent::getIteratorForPosition (int position, CodeDocument::It
             }
         }
 
+        if (backgroundTokeniser != nullptr)
+        {
+            const CodeDocument::Position target (document, position);
+
+            if (target.getLineNumber() - source.getLine() > BackgroundTokeniser::maxLinesToTokeniseSynchronously)
+            {
+                // until the background tokeniser catches up, start from the target itself
+                updateCachedIterators (target.getLineNumber());
+                source = CodeDocument::Iterator (target);
+                return;
+            }
+        }
+
         while (source.getPosition() < position)
         {
             const CodeDocument::Iterator original (source);
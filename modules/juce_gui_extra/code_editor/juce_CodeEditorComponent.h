@@ -284,6 +284,21 @@ public:
      */
     void retokenise (int startIndex, int endIndex);
 
+    /** Lets the editor tokenise long stretches of the document on a background thread.
+
+        Colouring a line normally means tokenising everything above it that hasn't been
+        tokenised yet, so jumping to the end of a very large document, or pasting near the
+        top of one while a later part is on screen, can stall the message thread. When a
+        thread is supplied, any long runs of text are tokenised on it instead, and the visible
+        lines are coloured provisionally until the results arrive.
+
+        The thread must be running, and must outlive the editor unless you call this again
+        with nullptr. The editor's CodeTokeniser will be called on this thread while it's
+        also being used on the message thread, so it mustn't keep any mutable state of its
+        own.
+    */
+    void setTokenisationThread (TimeSliceThread* thread);
+
     //==============================================================================
     /** A set of colour IDs to use to change the colour of various aspects of the editor.
 
@@ -446,6 +461,9 @@ private:
     void codeDocumentChanged (int start, int end);
 
     Array<CodeDocument::Iterator> cachedIterators;
+    int cachedIteratorsVersion = 0;
+    class BackgroundTokeniser;
+    std::unique_ptr<BackgroundTokeniser> backgroundTokeniser;
     void clearCachedIterators (int firstLineToBeInvalid);
     void updateCachedIterators (int maxLineNum);
     void getIteratorForPosition (int position, CodeDocument::Iterator&);
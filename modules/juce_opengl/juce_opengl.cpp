@@ -263,6 +263,7 @@ static bool contextRequiresTexture2DEnableDisable()
 #include "opengl/juce_OpenGLGraphicsContext.cpp"
 #include "opengl/juce_OpenGLHelpers.cpp"
 #include "opengl/juce_OpenGLImage.cpp"
+#include "opengl/juce_OpenGLPixelBuffers.cpp"
 #include "opengl/juce_OpenGLPixelFormat.cpp"
 #include "opengl/juce_OpenGLShaderProgram.cpp"
 #include "opengl/juce_OpenGLTexture.cpp"
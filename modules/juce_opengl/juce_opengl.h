@@ -115,6 +115,7 @@ namespace juce
 #include "opengl/juce_OpenGLFrameBuffer.h"
 #include "opengl/juce_OpenGLGraphicsContext.h"
 #include "opengl/juce_OpenGLImage.h"
+#include "opengl/juce_OpenGLPixelBuffers.h"
 #include "opengl/juce_OpenGLShaderProgram.h"
 #include "opengl/juce_OpenGLTexture.h"
 #include "utils/juce_OpenGLAppComponent.h"
@@ -243,6 +243,49 @@ public:
         renderThread->triggerRepaint();
     }
 
+    // Requests a new frame without repainting the attached components, so the render
+    // thread doesn't need to take the message manager lock to draw it.
+    void triggerRender()
+    {
+        state |= StateFlags::pendingRender;
+        renderThread->triggerRepaint();
+    }
+
+    bool needsMessageManagerLock() const noexcept
+    {
+        return context.renderComponents && isFlagSet (state, StateFlags::paintComponents);
+    }
+
+    //==============================================================================
+    OpenGLContext::FrameStatistics getFrameStatistics() const
+    {
+        const std::scoped_lock lock { statisticsMutex };
+        return statistics;
+    }
+
+    void resetFrameStatistics()
+    {
+        const std::scoped_lock lock { statisticsMutex };
+        statistics = {};
+    }
+
+    void recordFrame (double frameDurationMs, double lockWaitMs, bool paintedComponents)
+    {
+        const std::scoped_lock lock { statisticsMutex };
+
+        ++statistics.numFramesRendered;
+
+        if (paintedComponents)
+            ++statistics.numFramesWithComponentPainting;
+
+        statistics.lastFrameDurationMs = frameDurationMs;
+        statistics.maxFrameDurationMs = jmax (statistics.maxFrameDurationMs, frameDurationMs);
+        statistics.averageFrameDurationMs += (frameDurationMs - statistics.averageFrameDurationMs)
+                                                / (double) statistics.numFramesRendered;
+        statistics.lastMessageLockWaitMs = lockWaitMs;
+        statistics.totalMessageLockWaitMs += lockWaitMs;
+    }
+
     //==============================================================================
     bool ensureFrameBufferSize (Rectangle<int> viewportArea)
     {
@@ -347,6 +390,10 @@ public:
 
         const auto isUpdating = isFlagSet (stateToUse, StateFlags::paintComponents);
 
+        using Clock = std::chrono::steady_clock;
+        const auto frameStart = Clock::now();
+        auto lockWait = Clock::duration{};
+
         if (context.renderComponents && isUpdating)
         {
             bool abortScope = false;
@@ -362,7 +409,9 @@ public:
 
             doWorkWhileWaitingForLock (contextActivator);
 
+            const auto lockStart = Clock::now();
             scopedLock.emplace (mmLock);
+            lockWait = Clock::now() - lockStart;
 
             // If we can't get the lock here, it's probably because a context has been removed
             // on the main thread.
@@ -417,6 +466,12 @@ public:
         }
 
         nativeContext->swapBuffers();
+
+        using Ms = std::chrono::duration<double, std::milli>;
+        recordFrame (Ms (Clock::now() - frameStart).count(),
+                     Ms (lockWait).count(),
+                     context.renderComponents && isUpdating);
+
         return RenderStatus::nominal;
     }
 
@@ -664,6 +719,10 @@ public:
         if (context.renderer != nullptr)
             context.renderer->newOpenGLContextCreated();
 
+        // The component frame buffer was released above, so it must be repainted
+        // before it can be drawn again.
+        state |= StateFlags::paintComponents;
+
         return InitResult::success;
     }
 
@@ -821,26 +880,37 @@ public:
         bool isListChanging()   { return ! flags.isSafe(); }
 
     private:
+        /*  Renders every context that has work to do.
+
+            Contexts that only need their GL content redrawn are rendered first, so that
+            they aren't held up behind contexts that have to wait for the message manager
+            lock in order to repaint their components.
+        */
         RenderStatus renderAll()
         {
             auto result = RenderStatus::noWork;
 
             const std::scoped_lock lock { callbackMutex, listMutex };
 
-            for (auto* x : images)
+            for (const auto lockedPass : { false, true })
             {
-                listMutex.unlock();
-                const ScopeGuard scope { [&] { listMutex.lock(); } };
+                for (auto* x : images)
+                {
+                    if (x->needsMessageManagerLock() != lockedPass)
+                        continue;
 
-                const auto status = x->renderFrame (messageManagerLock);
+                    listMutex.unlock();
+                    const ScopeGuard scope { [&] { listMutex.lock(); } };
 
-                switch (status)
-                {
-                    case RenderStatus::noWork: break;
-                    case RenderStatus::nominal: result = RenderStatus::nominal; break;
-                    case RenderStatus::messageThreadAborted: return RenderStatus::messageThreadAborted;
-                }
+                    const auto status = x->renderFrame (messageManagerLock);
 
+                    switch (status)
+                    {
+                        case RenderStatus::noWork: break;
+                        case RenderStatus::nominal: result = RenderStatus::nominal; break;
+                        case RenderStatus::messageThreadAborted: return RenderStatus::messageThreadAborted;
+                    }
+                }
             }
 
             return result;
@@ -939,7 +1009,7 @@ public:
                         if (auto* window = [view window])
                             if (auto* screen = [window screen])
                                 if (display == ScopedDisplayLink::getDisplayIdForScreen (screen))
-                                    triggerRepaint();
+                                    triggerRender();
                 };
             }));
         }
@@ -978,6 +1048,9 @@ public:
     bool textureNpotSupported = false;
     std::chrono::steady_clock::time_point lastMMLockReleaseTime{};
 
+    mutable std::mutex statisticsMutex;
+    OpenGLContext::FrameStatistics statistics;
+
    #if JUCE_MAC
     NSView* getCurrentView() const
     {
@@ -1381,7 +1454,21 @@ void OpenGLContext::deactivateCurrentContext()
 void OpenGLContext::triggerRepaint()
 {
     if (auto* cachedImage = getCachedImage())
-        cachedImage->triggerRepaint();
+        cachedImage->triggerRender();
+}
+
+OpenGLContext::FrameStatistics OpenGLContext::getFrameStatistics() const
+{
+    if (auto* cachedImage = getCachedImage())
+        return cachedImage->getFrameStatistics();
+
+    return {};
+}
+
+void OpenGLContext::resetFrameStatistics()
+{
+    if (auto* cachedImage = getCachedImage())
+        cachedImage->resetFrameStatistics();
 }
 
 void OpenGLContext::swapBuffers()
@@ -172,9 +172,51 @@ public:
     */
     void setContinuousRepainting (bool shouldContinuouslyRepaint) noexcept;
 
-    /** Asynchronously causes a repaint to be made. */
+    /** Asynchronously causes a repaint to be made.
+
+        This only re-renders the GL content: the attached components are repainted
+        when they are invalidated, so a frame triggered by this method won't need to
+        lock the message thread.
+    */
     void triggerRepaint();
 
+    //==============================================================================
+    /** Timing information about the frames rendered by this context.
+        @see getFrameStatistics
+    */
+    struct FrameStatistics
+    {
+        /** The number of frames that have been rendered. */
+        int64 numFramesRendered = 0;
+
+        /** The number of frames that needed to lock the message thread to repaint components. */
+        int64 numFramesWithComponentPainting = 0;
+
+        /** The time taken to render the most recent frame, including swapping buffers. */
+        double lastFrameDurationMs = 0.0;
+
+        /** The mean time taken to render a frame. */
+        double averageFrameDurationMs = 0.0;
+
+        /** The longest time taken to render a frame. */
+        double maxFrameDurationMs = 0.0;
+
+        /** The time the most recent frame spent waiting for the message manager lock. */
+        double lastMessageLockWaitMs = 0.0;
+
+        /** The total time spent waiting for the message manager lock. */
+        double totalMessageLockWaitMs = 0.0;
+    };
+
+    /** Returns timing information about the frames rendered since the context was
+        attached, or since resetFrameStatistics() was last called.
+        This may be called from any thread.
+    */
+    FrameStatistics getFrameStatistics() const;
+
+    /** Clears the statistics returned by getFrameStatistics(). */
+    void resetFrameStatistics();
+
     //==============================================================================
     /** This retrieves an object that was previously stored with setAssociatedObject().
         If no object is found with the given name, this will return nullptr.
@@ -38,6 +38,43 @@ struct TextureInfo
     float fullWidthProportion, fullHeightProportion;
 };
 
+//==============================================================================
+// This persists in the OpenGLContext, and counts the work done while drawing a frame.
+struct RenderingStatistics  : public ReferenceCountedObject
+{
+    using Ptr = ReferenceCountedObjectPtr<RenderingStatistics>;
+
+    static Ptr get (OpenGLContext& c)
+    {
+        const char statisticsValueID[] = "GraphicsContextStatistics";
+        Ptr stats (static_cast<RenderingStatistics*> (c.getAssociatedObject (statisticsValueID)));
+
+        if (stats == nullptr)
+        {
+            stats = new RenderingStatistics();
+            c.setAssociatedObject (statisticsValueID, stats.get());
+        }
+
+        return stats;
+    }
+
+    // Nested graphics contexts are counted as part of the outermost one's frame
+    void beginFrame() noexcept
+    {
+        if (numActiveStates++ == 0)
+            current = {};
+    }
+
+    void endFrame() noexcept
+    {
+        if (--numActiveStates == 0)
+            lastFrame = current;
+    }
+
+    OpenGLGraphicsContextStatistics current, lastFrame;
+    int numActiveStates = 0;
+};
+
 //==============================================================================
 // This list persists in the OpenGLContext, and will re-use cached textures which
 // are created from Images.
@@ -117,6 +154,9 @@ struct CachedImageList  : public ReferenceCountedObject,
             {
                 textureNeedsReloading = false;
                 texture.loadImage (Image (*pixelData));
+
+                RenderingStatistics::get (owner.context)->current.numTextureBytesUploaded
+                    += (int64) texture.getWidth() * (int64) texture.getHeight() * 4;
             }
 
             t.textureID = texture.getTextureID();
@@ -364,7 +404,8 @@ struct ShaderPrograms  : public ReferenceCountedObject
           tiledImage (context),
           tiledImageMasked (context),
           copyTexture (context),
-          maskTexture (context)
+          maskTexture (context),
+          glyphAtlas (context)
     {}
 
     using Ptr = ReferenceCountedObjectPtr<ShaderPrograms>;
@@ -422,20 +463,25 @@ struct ShaderPrograms  : public ReferenceCountedObject
             screenBounds.set (bounds.getX(), bounds.getY(), 0.5f * bounds.getWidth(), 0.5f * bounds.getHeight());
         }
 
-        void bindAttributes()
+        virtual ~ShaderBase() = default;
+
+        virtual void bindAttributes()
         {
-            gl::glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, nullptr);
-            gl::glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) 4);
+            gl::glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, vertexStride, nullptr);
+            gl::glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, vertexStride, (void*) 4);
             gl::glEnableVertexAttribArray ((GLuint) positionAttribute.attributeID);
             gl::glEnableVertexAttribArray ((GLuint) colourAttribute.attributeID);
         }
 
-        void unbindAttributes()
+        virtual void unbindAttributes()
         {
             gl::glDisableVertexAttribArray ((GLuint) positionAttribute.attributeID);
             gl::glDisableVertexAttribArray ((GLuint) colourAttribute.attributeID);
         }
 
+        // The size of each vertex in the ShaderQuadQueue
+        static constexpr GLsizei vertexStride = 12;
+
         OpenGLShaderProgram::Attribute positionAttribute, colourAttribute;
         OpenGLShaderProgram::Uniform screenBounds;
         std::function<void (OpenGLShaderProgram&)> onShaderActivated;
@@ -801,6 +847,79 @@ struct ShaderPrograms  : public ReferenceCountedObject
         ImageParams imageParams;
     };
 
+    struct GlyphAtlasProgram  : public ShaderBase
+    {
+        GlyphAtlasProgram (OpenGLContext& context)
+            : ShaderBase (context, JUCE_DECLARE_VARYING_COLOUR
+                          "uniform sampler2D glyphTexture;"
+                          "uniform " JUCE_MEDIUMP " float coverageScale;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "gl_FragColor = frontColour * min (1.0, coverageScale * texture2D (glyphTexture, texturePos).a);"
+                          "}",
+                          "attribute vec2 position;"
+                          "attribute vec4 colour;"
+                          "attribute vec2 textureCoord;"
+                          "uniform vec4 screenBounds;"
+                          "uniform " JUCE_HIGHP " vec2 textureScale;"
+                          "varying " JUCE_MEDIUMP " vec4 frontColour;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "frontColour = colour;"
+                            "texturePos = textureCoord * textureScale;"
+                            "vec2 adjustedPos = position - screenBounds.xy;"
+                            "vec2 scaledPos = adjustedPos / screenBounds.zw;"
+                            "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
+                          "}"),
+              textureCoordAttribute (program, "textureCoord"),
+              glyphTexture (program, "glyphTexture"),
+              coverageScale (program, "coverageScale"),
+              textureScale (program, "textureScale")
+        {}
+
+        void bindAttributes() override
+        {
+            ShaderBase::bindAttributes();
+            gl::glVertexAttribPointer ((GLuint) textureCoordAttribute.attributeID, 2, GL_UNSIGNED_SHORT, GL_FALSE, vertexStride, (void*) 8);
+            gl::glEnableVertexAttribArray ((GLuint) textureCoordAttribute.attributeID);
+        }
+
+        void unbindAttributes() override
+        {
+            ShaderBase::unbindAttributes();
+            gl::glDisableVertexAttribArray ((GLuint) textureCoordAttribute.attributeID);
+        }
+
+        // Must be called while the program is active
+        template <typename QuadQueueType>
+        void setParameters (QuadQueueType& quadQueue, int textureSize, float newCoverageScale)
+        {
+            if (currentTextureSize != textureSize)
+            {
+                quadQueue.flush();
+                currentTextureSize = textureSize;
+                glyphTexture.set ((GLint) 0);
+                textureScale.set (1.0f / (float) textureSize, 1.0f / (float) textureSize);
+            }
+
+            if (currentCoverageScale != newCoverageScale)
+            {
+                quadQueue.flush();
+                currentCoverageScale = newCoverageScale;
+                coverageScale.set (newCoverageScale);
+            }
+        }
+
+        OpenGLShaderProgram::Attribute textureCoordAttribute;
+        OpenGLShaderProgram::Uniform glyphTexture, coverageScale, textureScale;
+
+    private:
+        int currentTextureSize = 0;
+        float currentCoverageScale = -1.0f;
+    };
+
     SolidColourProgram solidColourProgram;
     SolidColourMaskedProgram solidColourMasked;
     RadialGradientProgram radialGradient;
@@ -815,6 +934,7 @@ struct ShaderPrograms  : public ReferenceCountedObject
     TiledImageMaskedProgram tiledImageMasked;
     CopyTextureProgram copyTexture;
     MaskTextureProgram maskTexture;
+    GlyphAtlasProgram glyphAtlas;
 };
 
 //==============================================================================
@@ -1120,7 +1240,8 @@ struct StateHelpers
             gradientNeedsRefresh = true;
         }
 
-        void bindTextureForGradient (ActiveTextures& activeTextures, const ColourGradient& gradient)
+        void bindTextureForGradient (ActiveTextures& activeTextures, const ColourGradient& gradient,
+                                     OpenGLGraphicsContextStatistics& statistics)
         {
             if (gradientNeedsRefresh)
             {
@@ -1141,6 +1262,7 @@ struct StateHelpers
                 PixelARGB lookup[gradientTextureSize];
                 gradient.createLookupTable (lookup, gradientTextureSize);
                 gradientTextures.getUnchecked (activeGradientIndex)->loadARGB (lookup, gradientTextureSize, 1);
+                statistics.numTextureBytesUploaded += (int64) sizeof (lookup);
             }
 
             activeTextures.bindTexture (gradientTextures.getUnchecked (activeGradientIndex)->getTextureID());
@@ -1156,31 +1278,20 @@ struct StateHelpers
     };
 
     //==============================================================================
-    struct ShaderQuadQueue
+    // The index and vertex buffers used by the ShaderQuadQueue persist in the OpenGLContext.
+    // Each batch of quads is written into the vertex buffer just after the previous one, and
+    // the buffer is only orphaned when it fills up, so an upload never has to wait for the GPU
+    // to finish drawing from the same part of the buffer.
+    struct QuadBuffers  : public ReferenceCountedObject
     {
-        ShaderQuadQueue (const OpenGLContext& c) noexcept  : context (c)
-        {}
+        using Ptr = ReferenceCountedObjectPtr<QuadBuffers>;
 
-        ~ShaderQuadQueue() noexcept
-        {
-            static_assert (sizeof (VertexInfo) == 8, "Sanity check VertexInfo size");
-            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, 0);
-            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, 0);
-            context.extensions.glDeleteBuffers (2, buffers);
-        }
+        // This is as many quads as 16-bit indices can address
+        static constexpr int numQuads = 16384;
 
-        void initialise() noexcept
+        explicit QuadBuffers (OpenGLContext& c)  : context (c)
         {
-            JUCE_CHECK_OPENGL_ERROR
-
-           #if JUCE_ANDROID || JUCE_IOS
-            int numQuads = maxNumQuads;
-           #else
-            GLint maxIndices = 0;
-            glGetIntegerv (GL_MAX_ELEMENTS_INDICES, &maxIndices);
-            auto numQuads = jmin ((int) maxNumQuads, (int) maxIndices / 6);
-            maxVertices = numQuads * 4 - 4;
-           #endif
+            HeapBlock<GLushort> indexData ((size_t) numQuads * 6);
 
             for (int i = 0, v = 0; i < numQuads * 6; i += 6, v += 4)
             {
@@ -1192,39 +1303,114 @@ struct StateHelpers
 
             context.extensions.glGenBuffers (2, buffers);
             context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
-            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData, GL_STATIC_DRAW);
+            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr) ((size_t) numQuads * 6 * sizeof (GLushort)),
+                                             indexData, GL_STATIC_DRAW);
             context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
-            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), vertexData, GL_STREAM_DRAW);
+            orphanVertexBuffer();
             JUCE_CHECK_OPENGL_ERROR
         }
 
-        void add (int x, int y, int w, int h, PixelARGB colour) noexcept
+        ~QuadBuffers() override
         {
-            jassert (w > 0 && h > 0);
+            context.extensions.glDeleteBuffers (2, buffers);
+        }
 
-            auto* v = vertexData + numVertices;
-            v[0].x = v[2].x = (GLshort) x;
-            v[0].y = v[1].y = (GLshort) y;
-            v[1].x = v[3].x = (GLshort) (x + w);
-            v[2].y = v[3].y = (GLshort) (y + h);
+        static Ptr get (OpenGLContext& c)
+        {
+            const char buffersValueID[] = "GraphicsContextQuadBuffers";
+            Ptr quadBuffers (static_cast<QuadBuffers*> (c.getAssociatedObject (buffersValueID)));
 
-           #if JUCE_BIG_ENDIAN
-            auto rgba = (GLuint) ((colour.getRed() << 24) | (colour.getGreen() << 16)
-                                | (colour.getBlue() << 8) |  colour.getAlpha());
-           #else
-            auto rgba = (GLuint) ((colour.getAlpha() << 24) | (colour.getBlue() << 16)
-                                | (colour.getGreen() << 8) |  colour.getRed());
+            if (quadBuffers == nullptr)
+            {
+                quadBuffers = new QuadBuffers (c);
+                c.setAssociatedObject (buffersValueID, quadBuffers.get());
+            }
+
+            return quadBuffers;
+        }
+
+        void bind() const noexcept
+        {
+            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
+            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
+        }
+
+        // Returns the index of the first of a run of quads that can be written to.
+        // The vertex buffer must be bound.
+        int reserve (int numQuadsNeeded) noexcept
+        {
+            jassert (numQuadsNeeded <= numQuads);
+
+            if (nextQuad + numQuadsNeeded > numQuads)
+            {
+                orphanVertexBuffer();
+                nextQuad = 0;
+            }
+
+            const auto firstQuad = nextQuad;
+            nextQuad += numQuadsNeeded;
+            return firstQuad;
+        }
+
+    private:
+        void orphanVertexBuffer() noexcept
+        {
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, (GLsizeiptr) numQuads * 4 * ShaderPrograms::ShaderBase::vertexStride,
+                                             nullptr, GL_STREAM_DRAW);
+        }
+
+        OpenGLContext& context;
+        GLuint buffers[2];
+        int nextQuad = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (QuadBuffers)
+    };
+
+    //==============================================================================
+    struct ShaderQuadQueue
+    {
+        ShaderQuadQueue (OpenGLContext& c) noexcept  : context (c)
+        {}
+
+        ~ShaderQuadQueue() noexcept
+        {
+            static_assert (sizeof (VertexInfo) == (size_t) ShaderPrograms::ShaderBase::vertexStride, "Sanity check VertexInfo size");
+            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, 0);
+            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        void initialise (OpenGLGraphicsContextStatistics& statisticsToUpdate) noexcept
+        {
+            JUCE_CHECK_OPENGL_ERROR
+
+           #if ! (JUCE_ANDROID || JUCE_IOS)
+            GLint maxIndices = 0;
+            glGetIntegerv (GL_MAX_ELEMENTS_INDICES, &maxIndices);
+            auto numQuads = jmin ((int) maxNumQuads, (int) maxIndices / 6);
+            maxVertices = numQuads * 4 - 4;
            #endif
 
-            v[0].colour = rgba;
-            v[1].colour = rgba;
-            v[2].colour = rgba;
-            v[3].colour = rgba;
+            statistics = &statisticsToUpdate;
+            quadBuffers = QuadBuffers::get (context);
+            quadBuffers->bind();
+            JUCE_CHECK_OPENGL_ERROR
+        }
 
-            numVertices += 4;
+        OpenGLGraphicsContextStatistics& getStatistics() noexcept
+        {
+            jassert (statistics != nullptr);
+            return *statistics;
+        }
 
-            if (numVertices > maxVertices)
-                draw();
+        void add (int x, int y, int w, int h, PixelARGB colour) noexcept
+        {
+            addQuad (x, y, w, h, 0, 0, colour);
+        }
+
+        // Adds a quad whose texture coordinates start at the given texel, for the glyph atlas shader
+        void add (Rectangle<int> r, Point<int> textureOrigin, PixelARGB colour) noexcept
+        {
+            addQuad (r.getX(), r.getY(), r.getWidth(), r.getHeight(), textureOrigin.x, textureOrigin.y, colour);
         }
 
         void add (Rectangle<int> r, PixelARGB colour) noexcept
@@ -1273,14 +1459,49 @@ struct StateHelpers
         {
             GLshort x, y;
             GLuint colour;
+            GLushort u, v;
         };
 
-        enum { maxNumQuads = 256 };
+        void addQuad (int x, int y, int w, int h, int u, int v, PixelARGB colour) noexcept
+        {
+            jassert (w > 0 && h > 0);
+
+            auto* vertex = vertexData + numVertices;
+            vertex[0].x = vertex[2].x = (GLshort) x;
+            vertex[0].y = vertex[1].y = (GLshort) y;
+            vertex[1].x = vertex[3].x = (GLshort) (x + w);
+            vertex[2].y = vertex[3].y = (GLshort) (y + h);
+
+            vertex[0].u = vertex[2].u = (GLushort) u;
+            vertex[0].v = vertex[1].v = (GLushort) v;
+            vertex[1].u = vertex[3].u = (GLushort) (u + w);
+            vertex[2].v = vertex[3].v = (GLushort) (v + h);
+
+           #if JUCE_BIG_ENDIAN
+            auto rgba = (GLuint) ((colour.getRed() << 24) | (colour.getGreen() << 16)
+                                | (colour.getBlue() << 8) |  colour.getAlpha());
+           #else
+            auto rgba = (GLuint) ((colour.getAlpha() << 24) | (colour.getBlue() << 16)
+                                | (colour.getGreen() << 8) |  colour.getRed());
+           #endif
+
+            vertex[0].colour = rgba;
+            vertex[1].colour = rgba;
+            vertex[2].colour = rgba;
+            vertex[3].colour = rgba;
+
+            numVertices += 4;
+
+            if (numVertices > maxVertices)
+                draw();
+        }
+
+        enum { maxNumQuads = 2048 };
 
-        GLuint buffers[2];
         VertexInfo vertexData[maxNumQuads * 4];
-        GLushort indexData[maxNumQuads * 6];
-        const OpenGLContext& context;
+        OpenGLContext& context;
+        QuadBuffers::Ptr quadBuffers;
+        OpenGLGraphicsContextStatistics* statistics = nullptr;
         int numVertices = 0;
 
        #if JUCE_ANDROID || JUCE_IOS
@@ -1291,12 +1512,22 @@ struct StateHelpers
 
         void draw() noexcept
         {
-            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
+            const auto numQuads = numVertices / 4;
+            const auto numBytes = (size_t) numVertices * sizeof (VertexInfo);
+            const auto firstQuad = (size_t) quadBuffers->reserve (numQuads);
+
+            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, (GLintptr) (firstQuad * 4 * sizeof (VertexInfo)),
+                                                (GLsizeiptr) numBytes, vertexData);
             // NB: If you get a random crash in here and are running in a Parallels VM, it seems to be a bug in
             // their driver.. Can't find a workaround unfortunately.
-            glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT, nullptr);
+            glDrawElements (GL_TRIANGLES, numQuads * 6, GL_UNSIGNED_SHORT,
+                            reinterpret_cast<const void*> (firstQuad * 6 * sizeof (GLushort)));
             JUCE_CHECK_OPENGL_ERROR
             numVertices = 0;
+
+            ++statistics->numDrawCalls;
+            statistics->numQuads += numQuads;
+            statistics->numVertexBytesUploaded += (int64) numBytes;
         }
 
         JUCE_DECLARE_NON_COPYABLE (ShaderQuadQueue)
@@ -1329,6 +1560,7 @@ struct StateHelpers
                 clearShader (quadQueue);
 
                 activeShader = &shader;
+                ++quadQueue.getStatistics().numShaderChanges;
                 shader.program.use();
                 shader.bindAttributes();
 
@@ -1374,6 +1606,203 @@ struct StateHelpers
     };
 };
 
+//==============================================================================
+// A texture holding the coverage masks of recently drawn glyphs. It persists in the
+// OpenGLContext, so that each glyph is rasterised and uploaded once, after which
+// drawing it only needs one textured quad.
+struct GlyphAtlas  : public ReferenceCountedObject
+{
+    struct Glyph
+    {
+        Rectangle<int> area;    // the mask's position in the texture
+        Point<int> offset;      // the mask's top-left, relative to the glyph's origin
+    };
+
+    static constexpr int textureSize = 1024, maxGlyphSize = 128, numSubpixelPhases = 4;
+
+    static GlyphAtlas* get (OpenGLContext& c)
+    {
+        const char atlasValueID[] = "GraphicsContextGlyphAtlas";
+        auto atlas = static_cast<GlyphAtlas*> (c.getAssociatedObject (atlasValueID));
+
+        if (atlas == nullptr)
+        {
+            atlas = new GlyphAtlas();
+            c.setAssociatedObject (atlasValueID, atlas);
+        }
+
+        return atlas;
+    }
+
+    // Incremented when the shared glyph caches are cleared, so that every atlas starts again
+    static std::atomic<int>& getGeneration() noexcept
+    {
+        static std::atomic<int> generation { 0 };
+        return generation;
+    }
+
+    void bind (StateHelpers::ActiveTextures& activeTextures)
+    {
+        if (texture.getTextureID() == 0)
+        {
+            texture.loadAlpha (nullptr, textureSize, textureSize);
+            activeTextures.clear();
+        }
+
+        activeTextures.bindTexture (texture.getTextureID());
+    }
+
+    // The texture must already be bound. Returns nullptr if the glyph is too big for the atlas.
+    const Glyph* findOrAdd (const Font& font, int glyphNumber, int subpixelPhase, StateHelpers::ShaderQuadQueue& quadQueue)
+    {
+        const auto currentGeneration = getGeneration().load();
+
+        if (generation != currentGeneration)
+        {
+            reset (quadQueue);
+            generation = currentGeneration;
+        }
+
+        auto typeface = font.getTypefacePtr();
+        const Key key { typeface.get(), font.getHeight(), font.getHorizontalScale(), glyphNumber, subpixelPhase };
+        const auto iter = glyphs.find (key);
+
+        if (iter != glyphs.end())
+            return &iter->second.glyph;
+
+        const auto fontHeight = font.getHeight();
+        const std::unique_ptr<EdgeTable> et (typeface->getEdgeTableForGlyph (glyphNumber,
+                                                                             AffineTransform::scale (fontHeight * font.getHorizontalScale(),
+                                                                                                     fontHeight),
+                                                                             fontHeight));
+        Glyph glyph;
+
+        if (et != nullptr)
+        {
+            et->translate ((float) subpixelPhase / (float) numSubpixelPhases, 0);
+            const auto bounds = et->getMaximumBounds();
+
+            if (bounds.getWidth() > maxGlyphSize || bounds.getHeight() > maxGlyphSize)
+                return nullptr;
+
+            if (! bounds.isEmpty())
+            {
+                Point<int> position;
+
+                if (! allocate (bounds.getWidth(), bounds.getHeight(), position))
+                {
+                    reset (quadQueue);
+                    allocate (bounds.getWidth(), bounds.getHeight(), position);
+                }
+
+                glyph.area = bounds.withPosition (position);
+                glyph.offset = bounds.getPosition();
+                upload (*et, glyph.area);
+                quadQueue.getStatistics().numTextureBytesUploaded += (int64) glyph.area.getWidth() * glyph.area.getHeight();
+            }
+        }
+
+        return &glyphs.emplace (key, Entry { glyph, typeface }).first->second.glyph;
+    }
+
+private:
+    struct Key
+    {
+        auto tie() const noexcept { return std::tie (typeface, height, horizontalScale, glyphNumber, subpixelPhase); }
+        bool operator< (const Key& other) const noexcept { return tie() < other.tie(); }
+
+        const Typeface* typeface;
+        float height, horizontalScale;
+        int glyphNumber, subpixelPhase;
+    };
+
+    struct Entry
+    {
+        Glyph glyph;
+        Typeface::Ptr typeface; // keeps the key's typeface pointer valid
+    };
+
+    struct MaskRasteriser
+    {
+        MaskRasteriser (uint8* d, Rectangle<int> b) noexcept : data (d), bounds (b) {}
+
+        void setEdgeTableYPos (int y) noexcept
+        {
+            currentLine = data + (y - bounds.getY()) * bounds.getWidth() - bounds.getX();
+        }
+
+        void handleEdgeTablePixel (int x, int alphaLevel) const noexcept        { currentLine[x] = (uint8) alphaLevel; }
+        void handleEdgeTablePixelFull (int x) const noexcept                    { currentLine[x] = 255; }
+        void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept  { memset (currentLine + x, alphaLevel, (size_t) width); }
+        void handleEdgeTableLineFull (int x, int width) const noexcept          { memset (currentLine + x, 255, (size_t) width); }
+
+        void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
+        {
+            while (--height >= 0)
+            {
+                setEdgeTableYPos (y++);
+                handleEdgeTableLine (x, width, alphaLevel);
+            }
+        }
+
+        void handleEdgeTableRectangleFull (int x, int y, int width, int height) noexcept
+        {
+            while (--height >= 0)
+            {
+                setEdgeTableYPos (y++);
+                handleEdgeTableLineFull (x, width);
+            }
+        }
+
+        uint8* data;
+        const Rectangle<int> bounds;
+        uint8* currentLine = nullptr;
+    };
+
+    bool allocate (int w, int h, Point<int>& position) noexcept
+    {
+        if (rowX + w > textureSize)
+        {
+            rowY += rowHeight + 1;
+            rowX = rowHeight = 0;
+        }
+
+        if (rowY + h > textureSize)
+            return false;
+
+        position = { rowX, rowY };
+        rowX += w + 1;
+        rowHeight = jmax (rowHeight, h);
+        return true;
+    }
+
+    void upload (const EdgeTable& et, Rectangle<int> area)
+    {
+        const auto bounds = et.getMaximumBounds();
+        HeapBlock<uint8> mask ((size_t) (bounds.getWidth() * bounds.getHeight()), true);
+
+        MaskRasteriser rasteriser (mask, bounds);
+        et.iterate (rasteriser);
+
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D (GL_TEXTURE_2D, 0, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                         GL_ALPHA, GL_UNSIGNED_BYTE, mask);
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
+    void reset (StateHelpers::ShaderQuadQueue& quadQueue)
+    {
+        // any quads that still refer to the old masks must be drawn before they're overwritten
+        quadQueue.flush();
+        glyphs.clear();
+        rowX = rowY = rowHeight = 0;
+    }
+
+    OpenGLTexture texture;
+    std::map<Key, Entry> glyphs;
+    int rowX = 0, rowY = 0, rowHeight = 0, generation = 0;
+};
+
 //==============================================================================
 struct GLState
 {
@@ -1392,7 +1821,9 @@ struct GLState
         blendMode.resync();
         JUCE_CHECK_OPENGL_ERROR
         activeTextures.clear();
-        shaderQuadQueue.initialise();
+        statistics = RenderingStatistics::get (t.context);
+        statistics->beginFrame();
+        shaderQuadQueue.initialise (statistics->current);
         cachedImageList = CachedImageList::get (t.context);
         JUCE_CHECK_OPENGL_ERROR
     }
@@ -1400,6 +1831,7 @@ struct GLState
     ~GLState()
     {
         flush();
+        statistics->endFrame();
         target.context.extensions.glBindFramebuffer (GL_FRAMEBUFFER, previousFrameBufferTarget);
     }
 
@@ -1430,12 +1862,12 @@ struct GLState
             activeTextures.setActiveTexture (1);
             activeTextures.bindTexture ((GLuint) maskTextureID);
             activeTextures.setActiveTexture (0);
-            textureCache.bindTextureForGradient (activeTextures, g);
+            textureCache.bindTextureForGradient (activeTextures, g, shaderQuadQueue.getStatistics());
         }
         else
         {
             activeTextures.setSingleTextureMode (shaderQuadQueue);
-            textureCache.bindTextureForGradient (activeTextures, g);
+            textureCache.bindTextureForGradient (activeTextures, g, shaderQuadQueue.getStatistics());
         }
 
         auto t = transform.translated (0.5f - (float) target.bounds.getX(),
@@ -1567,6 +1999,26 @@ struct GLState
             maskParams->setBounds (*maskArea, target, 1);
     }
 
+    // Returns nullptr if the glyph atlas can't be used
+    GlyphAtlas* setShaderForGlyphAtlas (float coverageScale)
+    {
+        auto& program = currentShader.programs->glyphAtlas;
+
+        if (program.lastError.isNotEmpty())
+            return nullptr;
+
+        if (glyphAtlas == nullptr)
+            glyphAtlas = GlyphAtlas::get (target.context);
+
+        setShader (program);
+        blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
+        activeTextures.setSingleTextureMode (shaderQuadQueue);
+        glyphAtlas->bind (activeTextures);
+        program.setParameters (shaderQuadQueue, GlyphAtlas::textureSize, coverageScale);
+
+        return glyphAtlas.get();
+    }
+
     Target target;
 
     StateHelpers::BlendingMode blendMode;
@@ -1576,6 +2028,8 @@ struct GLState
     StateHelpers::ShaderQuadQueue shaderQuadQueue;
 
     CachedImageList::Ptr cachedImageList;
+    ReferenceCountedObjectPtr<GlyphAtlas> glyphAtlas;
+    RenderingStatistics::Ptr statistics;
 
 private:
     GLuint previousFrameBufferTarget;
@@ -1648,7 +2102,10 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
 
                 if (transform.isOnlyTranslated)
                 {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                    pos += transform.offset.toFloat();
+
+                    if (! drawGlyphFromAtlas (font, glyphNumber, pos))
+                        cache.drawGlyph (*this, font, glyphNumber, pos);
                 }
                 else
                 {
@@ -1662,7 +2119,8 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
                     if (std::abs (xScale - 1.0f) > 0.01f)
                         f.setHorizontalScale (xScale);
 
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                    if (! drawGlyphFromAtlas (f, glyphNumber, pos))
+                        cache.drawGlyph (*this, f, glyphNumber, pos);
                 }
             }
             else
@@ -1680,6 +2138,58 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
         }
     }
 
+    // Draws a solid-colour glyph as a textured quad for each clip rectangle, returning
+    // false if the fill or clip needs the general EdgeTable path instead
+    bool drawGlyphFromAtlas (const Font& f, int glyphNumber, Point<float> pos)
+    {
+        if (! fillType.isColour() || isUsingCustomShader)
+            return false;
+
+        auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get());
+
+        if (rectangleClip == nullptr)
+            return false;
+
+        // matches the level adjustment made by fillEdgeTable()
+        auto brightness = fillType.colour.getBrightness() - 0.5f;
+        auto* atlas = state->setShaderForGlyphAtlas (brightness > 0.0f ? 1.0f + 1.6f * brightness : 1.0f);
+
+        if (atlas == nullptr)
+            return false;
+
+        if (f.getTypefacePtr()->isHinted())
+            pos.x = std::floor (pos.x + 0.5f);
+
+        auto x = (int) std::floor (pos.x);
+        auto phase = roundToInt ((pos.x - (float) x) * (float) GlyphAtlas::numSubpixelPhases);
+
+        if (phase == GlyphAtlas::numSubpixelPhases)
+        {
+            ++x;
+            phase = 0;
+        }
+
+        auto* glyph = atlas->findOrAdd (f, glyphNumber, phase, state->shaderQuadQueue);
+
+        if (glyph == nullptr)
+            return false;
+
+        const auto glyphArea = glyph->area.withPosition (Point<int> (x, roundToInt (pos.y)) + glyph->offset);
+        const auto colour = fillType.colour.getPixelARGB();
+
+        for (auto& r : rectangleClip->clip)
+        {
+            const auto visibleArea = r.getIntersection (glyphArea);
+
+            if (! visibleArea.isEmpty())
+                state->shaderQuadQueue.add (visibleArea,
+                                            glyph->area.getPosition() + (visibleArea.getPosition() - glyphArea.getPosition()),
+                                            colour);
+        }
+
+        return true;
+    }
+
     Rectangle<int> getMaximumBounds() const     { return state->target.bounds; }
 
     void setFillType (const FillType& newFill)
@@ -1817,6 +2327,7 @@ private:
 static void clearOpenGLGlyphCacheCallback()
 {
     SavedState::GlyphCacheType::getInstance().reset();
+    ++GlyphAtlas::getGeneration();
 }
 
 static std::unique_ptr<LowLevelGraphicsContext> createOpenGLContext (const Target& target)
@@ -1848,6 +2359,11 @@ std::unique_ptr<LowLevelGraphicsContext> createOpenGLGraphicsContext (OpenGLCont
     return OpenGLRendering::createOpenGLContext (OpenGLRendering::Target (context, frameBufferID, width, height));
 }
 
+OpenGLGraphicsContextStatistics getOpenGLGraphicsContextStatistics (OpenGLContext& context)
+{
+    return OpenGLRendering::RenderingStatistics::get (context)->lastFrame;
+}
+
 //==============================================================================
 struct CustomProgram  : public ReferenceCountedObject,
                         public OpenGLRendering::ShaderPrograms::ShaderBase
@@ -39,6 +39,43 @@ std::unique_ptr<LowLevelGraphicsContext> createOpenGLGraphicsContext (OpenGLCont
                                                                       unsigned int frameBufferID,
                                                                       int width, int height);
 
+//==============================================================================
+/**
+    Counts of the work that the OpenGL graphics contexts did while rendering a frame.
+
+    @see getOpenGLGraphicsContextStatistics
+
+    @tags{OpenGL}
+*/
+struct JUCE_API  OpenGLGraphicsContextStatistics
+{
+    /** The number of draw calls that were issued. */
+    int numDrawCalls = 0;
+
+    /** The number of quads that were drawn. */
+    int numQuads = 0;
+
+    /** The number of times that a different shader program had to be selected. */
+    int numShaderChanges = 0;
+
+    /** The number of bytes of vertex data that were sent to the GPU. */
+    int64 numVertexBytesUploaded = 0;
+
+    /** The number of bytes of image, gradient and glyph texture data that were sent to the GPU. */
+    int64 numTextureBytesUploaded = 0;
+};
+
+/** Returns the statistics for the most recent frame drawn with an OpenGL graphics context.
+
+    A frame starts when a context is created with createOpenGLGraphicsContext(), and ends
+    when it's deleted. Any contexts that are created while another one is active, e.g. to
+    draw into an OpenGLImage, are counted as part of the outer frame.
+
+    This must be called on the thread that's rendering with the OpenGLContext, for example
+    at the end of your OpenGLRenderer::renderOpenGL() callback.
+*/
+OpenGLGraphicsContextStatistics getOpenGLGraphicsContextStatistics (OpenGLContext&);
+
 
 //==============================================================================
 /**
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static bool waitForFence (GLsync& fence, GLuint64 timeoutNs)
+{
+    if (fence == nullptr)
+        return true;
+
+    const auto result = glClientWaitSync (fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+        return false;
+
+    glDeleteSync (fence);
+    fence = nullptr;
+    return true;
+}
+
+static void deleteFence (GLsync& fence)
+{
+    if (fence != nullptr)
+        glDeleteSync (fence);
+
+    fence = nullptr;
+}
+
+// Long enough to be sure the GPU has finished with a buffer, without hanging forever
+// if the driver has lost the context.
+static constexpr GLuint64 fenceTimeoutNs = 1000000000;
+
+//==============================================================================
+OpenGLPixelUploadRing::OpenGLPixelUploadRing (int numBuffers)
+    : buffers ((size_t) jmax (1, numBuffers))
+{
+}
+
+OpenGLPixelUploadRing::~OpenGLPixelUploadRing()
+{
+    // The buffers can only be deleted while their context is active. Call release()
+    // from one of the OpenGLRenderer callbacks before deleting this object!
+    jassert (std::none_of (buffers.begin(), buffers.end(), [] (const Buffer& b) { return b.id != 0; }));
+}
+
+bool OpenGLPixelUploadRing::isSupported()
+{
+    return OpenGLHelpers::isContextActive()
+        && glMapBufferRange != nullptr && glUnmapBuffer != nullptr
+        && glFenceSync != nullptr && glClientWaitSync != nullptr && glDeleteSync != nullptr;
+}
+
+void OpenGLPixelUploadRing::release()
+{
+    jassert (mappedBuffer == nullptr);
+
+    for (auto& b : buffers)
+    {
+        deleteFence (b.fence);
+
+        if (b.id != 0)
+            glDeleteBuffers (1, &b.id);
+
+        b = {};
+    }
+
+    nextBuffer = 0;
+    unmappedBuffer = nullptr;
+}
+
+void* OpenGLPixelUploadRing::mapNextBuffer (size_t numBytes)
+{
+    // You must call unmapBuffer() before mapping another buffer!
+    jassert (mappedBuffer == nullptr);
+
+    if (! isSupported() || numBytes == 0)
+        return nullptr;
+
+    auto& b = buffers[nextBuffer];
+
+    if (! waitForFence (b.fence, fenceTimeoutNs))
+        return nullptr;
+
+    if (b.id == 0)
+        glGenBuffers (1, &b.id);
+
+    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, b.id);
+
+    if (b.capacity < numBytes)
+    {
+        b.capacity = numBytes + numBytes / 4;
+        glBufferData (GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) b.capacity, nullptr, GL_STREAM_DRAW);
+    }
+
+    // The fence has been waited on, so there's no need for the driver to synchronise too.
+    auto* data = glMapBufferRange (GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) numBytes,
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+    JUCE_CHECK_OPENGL_ERROR
+
+    if (data != nullptr)
+    {
+        mappedBuffer = &b;
+        nextBuffer = (nextBuffer + 1) % buffers.size();
+    }
+
+    return data;
+}
+
+GLuint OpenGLPixelUploadRing::unmapBuffer()
+{
+    jassert (mappedBuffer != nullptr);
+
+    if (mappedBuffer == nullptr)
+        return 0;
+
+    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, mappedBuffer->id);
+    const auto ok = glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER) != GL_FALSE;
+    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+    JUCE_CHECK_OPENGL_ERROR
+
+    unmappedBuffer = std::exchange (mappedBuffer, nullptr);
+
+    // If the buffer's contents were lost while it was mapped, it can't be used.
+    return ok ? unmappedBuffer->id : 0;
+}
+
+void OpenGLPixelUploadRing::uploadIssued()
+{
+    if (unmappedBuffer != nullptr)
+    {
+        deleteFence (unmappedBuffer->fence);
+        unmappedBuffer->fence = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        unmappedBuffer = nullptr;
+    }
+}
+
+//==============================================================================
+OpenGLAsyncReadback::OpenGLAsyncReadback() {}
+
+OpenGLAsyncReadback::~OpenGLAsyncReadback()
+{
+    // The buffer can only be deleted while its context is active. Call release()
+    // from one of the OpenGLRenderer callbacks before deleting this object!
+    jassert (bufferID == 0);
+}
+
+bool OpenGLAsyncReadback::start (OpenGLFrameBuffer& source, const Rectangle<int>& area)
+{
+    if (! OpenGLPixelUploadRing::isSupported() || area.isEmpty())
+        return false;
+
+    deleteFence (fence);
+
+    if (! source.makeCurrentRenderingTarget())
+        return false;
+
+    const auto numBytes = (size_t) area.getWidth() * (size_t) area.getHeight() * sizeof (PixelARGB);
+
+    if (bufferID == 0)
+        glGenBuffers (1, &bufferID);
+
+    glBindBuffer (GL_PIXEL_PACK_BUFFER, bufferID);
+
+    if (capacity < numBytes)
+    {
+        capacity = numBytes;
+        glBufferData (GL_PIXEL_PACK_BUFFER, (GLsizeiptr) capacity, nullptr, GL_STREAM_READ);
+    }
+
+    glPixelStorei (GL_PACK_ALIGNMENT, 4);
+    glReadPixels (area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                  JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, nullptr);
+
+    glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+    source.releaseAsRenderingTarget();
+    JUCE_CHECK_OPENGL_ERROR
+
+    fence = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    numBytesPending = numBytes;
+    return fence != nullptr;
+}
+
+bool OpenGLAsyncReadback::isReady() const
+{
+    if (fence == nullptr)
+        return false;
+
+    const auto result = glClientWaitSync (fence, 0, 0);
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+bool OpenGLAsyncReadback::finish (PixelARGB* target)
+{
+    if (fence == nullptr)
+        return false;
+
+    if (! waitForFence (fence, fenceTimeoutNs))
+        return false;
+
+    glBindBuffer (GL_PIXEL_PACK_BUFFER, bufferID);
+    const auto* data = glMapBufferRange (GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) numBytesPending, GL_MAP_READ_BIT);
+
+    if (data != nullptr)
+    {
+        memcpy (target, data, numBytesPending);
+        glUnmapBuffer (GL_PIXEL_PACK_BUFFER);
+    }
+
+    glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+    JUCE_CHECK_OPENGL_ERROR
+
+    numBytesPending = 0;
+    return data != nullptr;
+}
+
+void OpenGLAsyncReadback::release()
+{
+    deleteFence (fence);
+
+    if (bufferID != 0)
+        glDeleteBuffers (1, &bufferID);
+
+    bufferID = 0;
+    capacity = 0;
+    numBytesPending = 0;
+}
+
+} // namespace juce
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A ring of pixel buffer objects used to upload pixel data to textures.
+
+    Staging pixels through a pixel buffer object lets the driver copy them to the
+    GPU asynchronously, rather than stalling the render thread inside glTexImage2D().
+    Each buffer is fenced after use, so a buffer is only rewritten once the GPU has
+    finished reading from it.
+
+    All methods must be called on a thread with an active OpenGL context, and
+    release() must be called before the context is destroyed.
+
+    @see OpenGLTexture::loadImage, OpenGLAsyncReadback
+
+    @tags{OpenGL}
+*/
+class JUCE_API  OpenGLPixelUploadRing
+{
+public:
+    /** Creates a ring that cycles through the given number of buffers. */
+    explicit OpenGLPixelUploadRing (int numBuffers = 3);
+
+    /** Destructor. */
+    ~OpenGLPixelUploadRing();
+
+    /** Returns true if the active context supports pixel buffer objects and fences. */
+    static bool isSupported();
+
+    /** Deletes all of the buffers. */
+    void release();
+
+    /** Maps the next buffer in the ring, making sure it can hold at least numBytes.
+        Returns a pointer to the writable memory, or nullptr if the buffer couldn't be
+        mapped. Each successful call must be followed by a call to unmapBuffer().
+    */
+    void* mapNextBuffer (size_t numBytes);
+
+    /** Unmaps the buffer returned by the last call to mapNextBuffer(), and returns its ID.
+        Bind this to GL_PIXEL_UNPACK_BUFFER to make it the source of a texture upload,
+        then call uploadIssued() once the upload commands have been issued.
+    */
+    GLuint unmapBuffer();
+
+    /** Fences the most recently unmapped buffer, so that it won't be rewritten until
+        the GPU has finished the commands issued so far.
+    */
+    void uploadIssued();
+
+private:
+    struct Buffer
+    {
+        GLuint id = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+    };
+
+    std::vector<Buffer> buffers;
+    size_t nextBuffer = 0;
+    Buffer* mappedBuffer = nullptr;
+    Buffer* unmappedBuffer = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLPixelUploadRing)
+};
+
+//==============================================================================
+/**
+    Reads pixels back from an OpenGLFrameBuffer without stalling the pipeline.
+
+    OpenGLFrameBuffer::readPixels() waits for the GPU to finish rendering before it
+    returns. Instead, start() queues a copy into a pixel buffer object and fences it,
+    so that the pixels can be collected with finish() a frame or two later, once
+    isReady() returns true.
+
+    All methods must be called on a thread with an active OpenGL context, and
+    release() must be called before the context is destroyed.
+
+    @tags{OpenGL}
+*/
+class JUCE_API  OpenGLAsyncReadback
+{
+public:
+    /** Creates an idle readback object. */
+    OpenGLAsyncReadback();
+
+    /** Destructor. */
+    ~OpenGLAsyncReadback();
+
+    /** Queues a copy of an area of the frame buffer, in the same layout as
+        OpenGLFrameBuffer::readPixels() would produce.
+        Returns false if the copy couldn't be started, for example because the context
+        doesn't support pixel buffer objects, in which case you should fall back to
+        OpenGLFrameBuffer::readPixels().
+    */
+    bool start (OpenGLFrameBuffer& source, const Rectangle<int>& sourceArea);
+
+    /** Returns true if a copy has been started that hasn't been collected with finish(). */
+    bool isPending() const noexcept                 { return fence != nullptr; }
+
+    /** Returns true if the pending copy has completed, so that finish() won't block. */
+    bool isReady() const;
+
+    /** Copies the pixels read by the pending copy into a packed array, which must have
+        room for the area passed to start(). This will block if the copy isn't ready yet.
+        Returns false if there was no pending copy, or if it didn't complete.
+    */
+    bool finish (PixelARGB* targetData);
+
+    /** Cancels any pending copy and deletes the pixel buffer. */
+    void release();
+
+private:
+    GLuint bufferID = 0;
+    size_t capacity = 0, numBytesPending = 0;
+    GLsync fence = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLAsyncReadback)
+};
+
+} // namespace juce
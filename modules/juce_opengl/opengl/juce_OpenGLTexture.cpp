@@ -41,7 +41,7 @@ bool OpenGLTexture::isValidSize (int width, int height)
     return isPowerOfTwo (width) && isPowerOfTwo (height);
 }
 
-void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum type, bool topLeft)
+void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum type, bool topLeft, GLuint unpackBuffer)
 {
     ownerContext = OpenGLContext::getCurrentContext();
 
@@ -83,62 +83,136 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
 
     const GLint internalformat = type == GL_ALPHA ? GL_ALPHA : GL_RGBA;
 
+    // When the pixels come from a pixel buffer object, the pointer is an offset into it.
+    // The buffer mustn't be bound while allocating a padded texture, as it's too small.
     if (width != w || height != h)
     {
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
                       width, height, 0, type, GL_UNSIGNED_BYTE, nullptr);
 
+        if (unpackBuffer != 0)
+            glBindBuffer (GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+
         glTexSubImage2D (GL_TEXTURE_2D, 0, 0, topLeft ? (height - h) : 0, w, h,
                          type, GL_UNSIGNED_BYTE, pixels);
     }
     else
     {
+        if (unpackBuffer != 0)
+            glBindBuffer (GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
                       w, h, 0, type, GL_UNSIGNED_BYTE, pixels);
     }
 
+    if (unpackBuffer != 0)
+        glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+
     JUCE_CHECK_OPENGL_ERROR
 }
 
 template <class PixelType>
 struct Flipper
 {
-    static void flip (HeapBlock<PixelARGB>& dataCopy, const uint8* srcData, const int lineStride,
+    static void flip (PixelARGB* dest, const uint8* srcData, const int lineStride,
                       const int w, const int h)
     {
-        dataCopy.malloc (w * h);
-
         for (int y = 0; y < h; ++y)
         {
             auto* src = (const PixelType*) srcData;
-            auto* dst = (PixelARGB*) (dataCopy + w * (h - 1 - y));
-
-            for (int x = 0; x < w; ++x)
-                dst[x].set (src[x]);
+            auto* dst = dest + w * (h - 1 - y);
+
+            if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            {
+                memcpy (dst, src, (size_t) w * sizeof (PixelARGB));
+            }
+            else
+            {
+                for (int x = 0; x < w; ++x)
+                    dst[x].set (src[x]);
+            }
 
             srcData += lineStride;
         }
     }
+
+    static void flip (HeapBlock<PixelARGB>& dataCopy, const uint8* srcData, const int lineStride,
+                      const int w, const int h)
+    {
+        dataCopy.malloc (w * h);
+        flip (dataCopy.get(), srcData, lineStride, w, h);
+    }
 };
 
-void OpenGLTexture::loadImage (const Image& image)
+static void convertImagePixels (PixelARGB* dest, const Image& image)
 {
-    const int imageW = image.getWidth();
-    const int imageH = image.getHeight();
-
-    HeapBlock<PixelARGB> dataCopy;
     Image::BitmapData srcData (image, Image::BitmapData::readOnly);
+    const auto w = image.getWidth();
+    const auto h = image.getHeight();
 
     switch (srcData.pixelFormat)
     {
-        case Image::ARGB:           Flipper<PixelARGB> ::flip (dataCopy, srcData.data, srcData.lineStride, imageW, imageH); break;
-        case Image::RGB:            Flipper<PixelRGB>  ::flip (dataCopy, srcData.data, srcData.lineStride, imageW, imageH); break;
-        case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dataCopy, srcData.data, srcData.lineStride, imageW, imageH); break;
+        case Image::ARGB:           Flipper<PixelARGB> ::flip (dest, srcData.data, srcData.lineStride, w, h); break;
+        case Image::RGB:            Flipper<PixelRGB>  ::flip (dest, srcData.data, srcData.lineStride, w, h); break;
+        case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dest, srcData.data, srcData.lineStride, w, h); break;
         case Image::UnknownFormat:
         default: break;
     }
+}
+
+OpenGLTexture::ConvertedImage::ConvertedImage (const Image& image)
+    : pixels ((size_t) (image.getWidth() * image.getHeight())),
+      width (image.getWidth()),
+      height (image.getHeight())
+{
+    convertImagePixels (pixels, image);
+}
+
+void OpenGLTexture::loadImage (const Image& image)
+{
+    loadImage (ConvertedImage (image));
+}
+
+void OpenGLTexture::loadImage (const ConvertedImage& image)
+{
+    create (image.width, image.height, image.pixels, JUCE_RGBA_FORMAT, true);
+}
+
+template <typename WritePixels>
+bool OpenGLTexture::loadThroughUploadRing (OpenGLPixelUploadRing& uploadRing, int w, int h, WritePixels&& writePixels)
+{
+    const auto numBytes = (size_t) w * (size_t) h * sizeof (PixelARGB);
+    auto* mapped = uploadRing.mapNextBuffer (numBytes);
+
+    if (mapped == nullptr)
+        return false;
+
+    writePixels (static_cast<PixelARGB*> (mapped));
+
+    const auto bufferID = uploadRing.unmapBuffer();
+
+    if (bufferID == 0)
+        return false;
+
+    create (w, h, nullptr, JUCE_RGBA_FORMAT, true, bufferID);
+    uploadRing.uploadIssued();
+    return true;
+}
+
+void OpenGLTexture::loadImage (const Image& image, OpenGLPixelUploadRing& uploadRing)
+{
+    if (! loadThroughUploadRing (uploadRing, image.getWidth(), image.getHeight(),
+                                 [&] (PixelARGB* dest) { convertImagePixels (dest, image); }))
+        loadImage (image);
+}
+
+void OpenGLTexture::loadImage (const ConvertedImage& image, OpenGLPixelUploadRing& uploadRing)
+{
+    const auto numBytes = (size_t) image.width * (size_t) image.height * sizeof (PixelARGB);
 
-    create (imageW, imageH, dataCopy, JUCE_RGBA_FORMAT, true);
+    if (! loadThroughUploadRing (uploadRing, image.width, image.height,
+                                 [&] (PixelARGB* dest) { memcpy (dest, image.pixels, numBytes); }))
+        loadImage (image);
 }
 
 void OpenGLTexture::loadARGB (const PixelARGB* pixels, const int w, const int h)
@@ -48,6 +48,40 @@ public:
     */
     void loadImage (const Image& image);
 
+    /** Holds an image's pixels, converted into the layout that loadImage() uploads.
+
+        Converting the pixels doesn't need an OpenGL context, so it can be done on a
+        background thread, leaving only the upload to be done on the render thread.
+    */
+    struct ConvertedImage
+    {
+        /** Creates an empty object. */
+        ConvertedImage() = default;
+
+        /** Converts the pixels of an image. */
+        explicit ConvertedImage (const Image& image);
+
+        HeapBlock<PixelARGB> pixels;
+        int width = 0, height = 0;
+    };
+
+    /** Creates a texture from an image that has already been converted.
+        This produces the same texture as calling loadImage() with the original image.
+    */
+    void loadImage (const ConvertedImage& image);
+
+    /** Creates a texture from the given image, staging its pixels in a pixel buffer object
+        from the given ring so that the driver can upload them asynchronously.
+        The pixels are converted straight into the mapped buffer. If the context doesn't
+        support pixel buffer objects, this behaves like loadImage (const Image&).
+    */
+    void loadImage (const Image& image, OpenGLPixelUploadRing& uploadRing);
+
+    /** Creates a texture from an image that has already been converted, staging its
+        pixels in a pixel buffer object from the given ring.
+    */
+    void loadImage (const ConvertedImage& image, OpenGLPixelUploadRing& uploadRing);
+
     /** Creates a texture from a raw array of pixels.
         If width and height are not powers-of-two, the texture will be created with a
         larger size, and only the subsection (0, 0, width, height) will be initialised.
@@ -96,7 +130,10 @@ private:
     int width, height;
     OpenGLContext* ownerContext;
 
-    void create (int w, int h, const void*, GLenum, bool topLeft);
+    void create (int w, int h, const void*, GLenum, bool topLeft, GLuint unpackBuffer = 0);
+
+    template <typename WritePixels>
+    bool loadThroughUploadRing (OpenGLPixelUploadRing&, int w, int h, WritePixels&&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLTexture)
 };
@@ -42,3 +42,4 @@
 #include "osc/juce_OSCBundle.cpp"
 #include "osc/juce_OSCReceiver.cpp"
 #include "osc/juce_OSCSender.cpp"
+#include "osc/juce_OSCMessageView.cpp"
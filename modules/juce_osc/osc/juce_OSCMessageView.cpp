@@ -0,0 +1,430 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace OSCMessageViewHelpers
+{
+    static size_t getPaddedSize (size_t size) noexcept
+    {
+        return (size + 3) & ~(size_t) 3;
+    }
+
+    static size_t getPaddedStringSize (const char* s) noexcept
+    {
+        return getPaddedSize (std::strlen (s) + 1);
+    }
+
+    // Checks a null-terminated string and its padding, and moves past it.
+    static bool skipString (const char*& p, const char* end) noexcept
+    {
+        auto* terminator = static_cast<const char*> (std::memchr (p, 0, (size_t) (end - p)));
+
+        if (terminator == nullptr)
+            return false;
+
+        auto paddedEnd = p + getPaddedSize ((size_t) (terminator - p) + 1);
+
+        if (paddedEnd > end)
+            return false;
+
+        for (auto* c = terminator + 1; c < paddedEnd; ++c)
+            if (*c != 0)
+                return false;
+
+        p = paddedEnd;
+        return true;
+    }
+
+    static size_t getArgumentSize (OSCType type, const char* data) noexcept
+    {
+        switch (type)
+        {
+            case OSCTypes::string:  return getPaddedStringSize (data);
+            case OSCTypes::blob:    return 4 + getPaddedSize (ByteOrder::bigEndianInt (data));
+            default:                return 4;
+        }
+    }
+}
+
+//==============================================================================
+OSCMessageView::OSCMessageView (const char* data, size_t dataSize, OSCTimeTag enclosingTimeTag) noexcept
+    : address (data),
+      dataEnd (data + dataSize),
+      timeTag (enclosingTimeTag)
+{
+    using namespace OSCMessageViewHelpers;
+
+    auto* typeTagString = address + getPaddedStringSize (address);
+    typeTags = typeTagString + 1;
+    arguments = typeTagString + getPaddedStringSize (typeTagString);
+}
+
+OSCMessageView OSCMessageView::fromData (const void* data, size_t dataSize) noexcept
+{
+    auto* d = static_cast<const char*> (data);
+
+    if (dataSize > 0 && *d == '/' && isValidElement (d, dataSize, 0))
+        return OSCMessageView (d, dataSize, OSCTimeTag::immediately);
+
+    return {};
+}
+
+//==============================================================================
+bool OSCMessageView::isValidElement (const char* data, size_t size, int depth) noexcept
+{
+    // A bundle can only contain other bundles up to this depth, which keeps a
+    // malicious packet from exhausting the stack.
+    constexpr int maxBundleDepth = 32;
+
+    if (size == 0 || (size & 3) != 0)
+        return false;
+
+    if (*data == '/')
+        return isValidMessage (data, size);
+
+    if (*data == '#' && depth < maxBundleDepth)
+        return isValidBundle (data, size, depth);
+
+    return false;
+}
+
+bool OSCMessageView::isValidMessage (const char* data, size_t size) noexcept
+{
+    using namespace OSCMessageViewHelpers;
+
+    auto* p = data;
+    auto* end = data + size;
+
+    if (! skipString (p, end))
+        return false;
+
+    if (p == end || *p != ',')
+        return false;
+
+    auto* types = p + 1;
+
+    if (! skipString (p, end))
+        return false;
+
+    for (auto* t = types; *t != 0; ++t)
+    {
+        auto remaining = (size_t) (end - p);
+
+        switch (*t)
+        {
+            case OSCTypes::int32:
+            case OSCTypes::float32:
+            case OSCTypes::colour:
+                if (remaining < 4)
+                    return false;
+
+                p += 4;
+                break;
+
+            case OSCTypes::string:
+                if (! skipString (p, end))
+                    return false;
+
+                break;
+
+            case OSCTypes::blob:
+            {
+                if (remaining < 4)
+                    return false;
+
+                auto blobSize = (int32) ByteOrder::bigEndianInt (p);
+
+                if (blobSize < 0 || getPaddedSize ((size_t) blobSize) > remaining - 4)
+                    return false;
+
+                auto* blobEnd = p + 4 + blobSize;
+                p += 4 + getPaddedSize ((size_t) blobSize);
+
+                for (auto* c = blobEnd; c < p; ++c)
+                    if (*c != 0)
+                        return false;
+
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    return p == end;
+}
+
+bool OSCMessageView::isValidBundle (const char* data, size_t size, int depth) noexcept
+{
+    if (size < 16 || std::memcmp (data, "#bundle", 8) != 0)
+        return false;
+
+    for (size_t pos = 16; pos < size;)
+    {
+        if (size - pos < 4)
+            return false;
+
+        auto elementSize = (size_t) ByteOrder::bigEndianInt (data + pos);
+
+        if (elementSize > size - pos - 4 || ! isValidElement (data + pos + 4, elementSize, depth + 1))
+            return false;
+
+        pos += 4 + elementSize;
+    }
+
+    return true;
+}
+
+uint32 OSCMessageView::readUint32 (const char* data) noexcept    { return ByteOrder::bigEndianInt (data); }
+uint64 OSCMessageView::readUint64 (const char* data) noexcept    { return ByteOrder::bigEndianInt64 (data); }
+
+//==============================================================================
+int OSCMessageView::size() const noexcept
+{
+    return typeTags != nullptr ? (int) std::strlen (typeTags) : 0;
+}
+
+OSCMessageView::Iterator OSCMessageView::begin() const noexcept   { return { typeTags, arguments }; }
+OSCMessageView::Iterator OSCMessageView::end() const noexcept     { return { typeTags + size(), dataEnd }; }
+
+OSCMessageView::Argument OSCMessageView::operator[] (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, size()));
+
+    auto i = begin();
+
+    while (--index >= 0)
+        ++i;
+
+    return *i;
+}
+
+OSCMessage OSCMessageView::createMessage() const
+{
+    jassert (isValid());
+
+    OSCMessage message { OSCAddressPattern (String::fromUTF8 (address)) };
+
+    for (auto arg : *this)
+        message.addArgument (arg.createArgument());
+
+    return message;
+}
+
+OSCMessageView::Iterator& OSCMessageView::Iterator::operator++() noexcept
+{
+    data += OSCMessageViewHelpers::getArgumentSize (*typeTag, data);
+    ++typeTag;
+    return *this;
+}
+
+//==============================================================================
+int32 OSCMessageView::Argument::getInt32() const noexcept
+{
+    jassert (isInt32());
+    return (int32) ByteOrder::bigEndianInt (data);
+}
+
+float OSCMessageView::Argument::getFloat32() const noexcept
+{
+    jassert (isFloat32());
+
+    auto bits = ByteOrder::bigEndianInt (data);
+    float value;
+    std::memcpy (&value, &bits, sizeof (value));
+    return value;
+}
+
+OSCColour OSCMessageView::Argument::getColour() const noexcept
+{
+    jassert (isColour());
+    return OSCColour::fromInt32 (ByteOrder::bigEndianInt (data));
+}
+
+const char* OSCMessageView::Argument::getString() const noexcept
+{
+    jassert (isString());
+    return data;
+}
+
+const void* OSCMessageView::Argument::getBlobData() const noexcept
+{
+    jassert (isBlob());
+    return data + 4;
+}
+
+size_t OSCMessageView::Argument::getBlobSize() const noexcept
+{
+    jassert (isBlob());
+    return (size_t) ByteOrder::bigEndianInt (data);
+}
+
+OSCArgument OSCMessageView::Argument::createArgument() const
+{
+    switch (type)
+    {
+        case OSCTypes::int32:       return OSCArgument (getInt32());
+        case OSCTypes::float32:     return OSCArgument (getFloat32());
+        case OSCTypes::string:      return OSCArgument (String::fromUTF8 (getString()));
+        case OSCTypes::blob:        return OSCArgument (MemoryBlock (getBlobData(), getBlobSize()));
+        case OSCTypes::colour:      return OSCArgument (getColour());
+
+        default:
+            jassertfalse;
+            throw OSCInternalError ("OSCMessageView: internal error while copying message argument");
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageViewTests  : public UnitTest
+{
+public:
+    OSCMessageViewTests()
+        : UnitTest ("OSCMessageView class", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        const char blobData[] = { 1, 2, 3, 4, 5 };
+        const OSCColour colour { 10, 20, 30, 40 };
+        OSCMessage message ("/test/args", 42, 0.5f, String ("foo"), MemoryBlock (blobData, sizeof (blobData)));
+        message.addColour (colour);
+
+        OSCOutputStream output;
+        output.writeMessage (message);
+
+        auto* data = static_cast<const char*> (output.getData());
+        auto size = output.getDataSize();
+
+        beginTest ("Reading a message");
+        {
+            auto view = OSCMessageView::fromData (data, size);
+
+            expect (view.isValid());
+            expectEquals (String (view.getAddressPattern()), String ("/test/args"));
+            expectEquals (String (view.getTypeTags()), String ("ifsbr"));
+            expectEquals (view.size(), 5);
+            expect (view.getTimeTag().isImmediately());
+            expect (view.getRawData() == data);
+            expectEquals ((int) view.getRawDataSize(), (int) size);
+
+            int numArgs = 0;
+
+            for (auto arg : view)
+            {
+                expectEquals ((int) arg.getType(), (int) view.getTypeTags()[numArgs]);
+                ++numArgs;
+            }
+
+            expectEquals (numArgs, 5);
+            expectEquals (view[0].getInt32(), 42);
+            expectEquals (view[1].getFloat32(), 0.5f);
+            expectEquals (String (view[2].getString()), String ("foo"));
+            expectEquals ((int) view[3].getBlobSize(), (int) sizeof (blobData));
+            expect (std::memcmp (view[3].getBlobData(), blobData, sizeof (blobData)) == 0);
+            expect (view[4].getColour().toInt32() == colour.toInt32());
+
+            auto copy = view.createMessage();
+            expectEquals (copy.getAddressPattern().toString(), String ("/test/args"));
+            expectEquals (copy.size(), 5);
+            expectEquals (copy[2].getString(), String ("foo"));
+            expect (copy[3].getBlob() == MemoryBlock (blobData, sizeof (blobData)));
+        }
+
+        beginTest ("Rejecting malformed messages");
+        {
+            for (size_t i = 0; i < size; ++i)
+                expect (! OSCMessageView::fromData (data, i).isValid());
+
+            MemoryBlock copy (data, size);
+            auto* bytes = static_cast<char*> (copy.getData());
+
+            bytes[11] = 'x';    // a padding byte after the address
+            expect (! OSCMessageView::fromData (bytes, size).isValid());
+
+            bytes[11] = 0;
+            bytes[13] = 'h';    // an unsupported type
+            expect (! OSCMessageView::fromData (bytes, size).isValid());
+
+            bytes[13] = 'i';
+            expect (OSCMessageView::fromData (bytes, size).isValid());
+            expect (! OSCMessageView::fromData (bytes, size + 4).isValid());
+        }
+
+        beginTest ("Walking through bundles");
+        {
+            const OSCTimeTag innerTimeTag (Time (2020, 1, 1, 0, 0));
+
+            OSCBundle inner (innerTimeTag);
+            inner.addElement (OSCMessage ("/inner", 1));
+
+            OSCBundle outer;
+            outer.addElement (OSCMessage ("/outer/first", 2));
+            outer.addElement (inner);
+            outer.addElement (OSCMessage ("/outer/last", 3));
+
+            OSCOutputStream bundleOutput;
+            bundleOutput.writeBundle (outer);
+
+            StringArray addresses;
+            Array<int> values;
+            Array<uint64> timeTags;
+
+            expect (OSCMessageView::forEachMessage (bundleOutput.getData(), bundleOutput.getDataSize(),
+                                                    [&] (const OSCMessageView& m)
+                                                    {
+                                                        addresses.add (m.getAddressPattern());
+                                                        values.add (m[0].getInt32());
+                                                        timeTags.add (m.getTimeTag().getRawTimeTag());
+                                                    }));
+
+            expectEquals (addresses.joinIntoString (" "), String ("/outer/first /inner /outer/last"));
+            expect (values == Array<int> (2, 1, 3));
+            expect (timeTags[0] == OSCTimeTag::immediately.getRawTimeTag());
+            expect (timeTags[1] == innerTimeTag.getRawTimeTag());
+
+            MemoryBlock corrupt (bundleOutput.getData(), bundleOutput.getDataSize());
+            static_cast<char*> (corrupt.getData())[19] += 4;    // the size of the first element
+            int numCalls = 0;
+
+            expect (! OSCMessageView::forEachMessage (corrupt.getData(), corrupt.getSize(),
+                                                      [&] (const OSCMessageView&) { ++numCalls; }));
+            expectEquals (numCalls, 0);
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A read-only view of an OSC message inside a block of received data.
+
+    An OSCMessageView gives you access to the address pattern and arguments of a
+    message without copying them out of the packet, so unlike an OSCMessage it
+    doesn't allocate any memory. The strings and blobs that it returns point directly
+    into the packet, which means that the view is only valid for as long as the data
+    it was made from.
+
+    You'll normally be given one of these by an OSCReceiver::MessageViewListener,
+    but you can also use forEachMessage() to go through a packet yourself.
+
+    Note that the address pattern is only checked for a leading slash, not for the
+    full set of characters that an OSCAddressPattern allows.
+
+    @see OSCMessage, OSCReceiver::MessageViewListener
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** Creates an invalid view that holds no message. */
+    OSCMessageView() noexcept = default;
+
+    /** Creates a view of a single OSC message.
+
+        If the data doesn't hold a well-formed OSC message that is exactly dataSize bytes
+        long, the view that is returned will be invalid.
+    */
+    static OSCMessageView fromData (const void* data, size_t dataSize) noexcept;
+
+    /** Checks that a packet holds a well-formed OSC message or bundle, and then calls
+        a function for each message that it contains.
+
+        The callback is passed a const OSCMessageView&. Messages inside bundles are
+        given the time tag of the bundle that directly encloses them.
+
+        @returns false if the packet was malformed, in which case the callback won't
+                 have been called at all.
+    */
+    template <typename Callback>
+    static bool forEachMessage (const void* packetData, size_t packetSize, Callback&& callback)
+    {
+        auto* data = static_cast<const char*> (packetData);
+
+        if (! isValidElement (data, packetSize, 0))
+            return false;
+
+        visitElement (data, packetSize, OSCTimeTag::immediately, callback);
+        return true;
+    }
+
+    //==============================================================================
+    /** Returns true if this view refers to a message. */
+    bool isValid() const noexcept                   { return address != nullptr; }
+
+    /** Returns the message's address pattern as a null-terminated string. */
+    const char* getAddressPattern() const noexcept  { return address; }
+
+    /** Returns the type tags of the arguments as a null-terminated string, without
+        the leading comma.
+    */
+    const char* getTypeTags() const noexcept        { return typeTags; }
+
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept;
+
+    /** Returns true if the message has no arguments. */
+    bool isEmpty() const noexcept                   { return typeTags == nullptr || *typeTags == 0; }
+
+    /** Returns the time tag of the bundle that contained the message, or
+        OSCTimeTag::immediately if it wasn't part of a bundle.
+    */
+    OSCTimeTag getTimeTag() const noexcept          { return timeTag; }
+
+    /** Returns the message data, starting with the address pattern. */
+    const void* getRawData() const noexcept         { return address; }
+
+    /** Returns the size in bytes of the message data. */
+    size_t getRawDataSize() const noexcept          { return (size_t) (dataEnd - address); }
+
+    /** Copies the message into an OSCMessage.
+
+        @throw OSCFormatError if the address pattern isn't a valid OSCAddressPattern.
+    */
+    OSCMessage createMessage() const;
+
+    //==============================================================================
+    /** One of the arguments of an OSCMessageView.
+
+        The getters don't check the type of the argument, so you must make sure that
+        it's the one you expect before calling them.
+    */
+    class JUCE_API  Argument
+    {
+    public:
+        /** Returns the type of the argument. */
+        OSCType getType() const noexcept            { return type; }
+
+        bool isInt32() const noexcept               { return type == OSCTypes::int32; }
+        bool isFloat32() const noexcept             { return type == OSCTypes::float32; }
+        bool isString() const noexcept              { return type == OSCTypes::string; }
+        bool isBlob() const noexcept                { return type == OSCTypes::blob; }
+        bool isColour() const noexcept              { return type == OSCTypes::colour; }
+
+        int32 getInt32() const noexcept;
+        float getFloat32() const noexcept;
+        OSCColour getColour() const noexcept;
+
+        /** Returns a null-terminated string that points into the packet. */
+        const char* getString() const noexcept;
+
+        /** Returns a pointer to the blob's data, which points into the packet. */
+        const void* getBlobData() const noexcept;
+
+        /** Returns the size of the blob in bytes. */
+        size_t getBlobSize() const noexcept;
+
+        /** Copies the argument into an OSCArgument. */
+        OSCArgument createArgument() const;
+
+    private:
+        friend class OSCMessageView;
+        Argument (OSCType t, const char* d) noexcept  : type (t), data (d) {}
+
+        OSCType type;
+        const char* data;
+    };
+
+    //==============================================================================
+    /** Iterates over the arguments of an OSCMessageView. */
+    class JUCE_API  Iterator
+    {
+    public:
+        Argument operator*() const noexcept         { return { *typeTag, data }; }
+        Iterator& operator++() noexcept;
+
+        bool operator== (const Iterator& other) const noexcept  { return typeTag == other.typeTag; }
+        bool operator!= (const Iterator& other) const noexcept  { return typeTag != other.typeTag; }
+
+    private:
+        friend class OSCMessageView;
+        Iterator (const char* t, const char* d) noexcept  : typeTag (t), data (d) {}
+
+        const char* typeTag;
+        const char* data;
+    };
+
+    /** Returns an iterator to the first argument. */
+    Iterator begin() const noexcept;
+
+    /** Returns an iterator past the last argument. */
+    Iterator end() const noexcept;
+
+    /** Returns the argument at the given index.
+
+        This has to step through the arguments before it, so if you need them all, it's
+        quicker to iterate over the view. The index must be less than size().
+    */
+    Argument operator[] (int index) const noexcept;
+
+private:
+    //==============================================================================
+    OSCMessageView (const char* data, size_t dataSize, OSCTimeTag) noexcept;
+
+    static bool isValidElement (const char* data, size_t size, int depth) noexcept;
+    static bool isValidMessage (const char* data, size_t size) noexcept;
+    static bool isValidBundle (const char* data, size_t size, int depth) noexcept;
+    static uint32 readUint32 (const char* data) noexcept;
+    static uint64 readUint64 (const char* data) noexcept;
+
+    template <typename Callback>
+    static void visitElement (const char* data, size_t size, OSCTimeTag enclosingTimeTag, Callback& callback)
+    {
+        if (*data == '/')
+        {
+            callback (static_cast<const OSCMessageView&> (OSCMessageView (data, size, enclosingTimeTag)));
+            return;
+        }
+
+        OSCTimeTag bundleTimeTag (readUint64 (data + 8));
+
+        for (size_t pos = 16; pos < size;)
+        {
+            auto elementSize = (size_t) readUint32 (data + pos);
+            visitElement (data + pos + 4, elementSize, bundleTimeTag, callback);
+            pos += 4 + elementSize;
+        }
+    }
+
+    const char* address = nullptr;
+    const char* typeTags = nullptr;
+    const char* arguments = nullptr;
+    const char* dataEnd = nullptr;
+    OSCTimeTag timeTag;
+};
+
+} // namespace juce
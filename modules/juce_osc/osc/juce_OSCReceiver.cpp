@@ -311,12 +311,132 @@ namespace
 
 } // namespace
 
+namespace OSCReceiverHelpers
+{
+    //==============================================================================
+    /** Holds the listeners that were added with an OSC address.
+
+        The entries are kept sorted by a hash of their address, so a message whose address
+        pattern has no wildcards can find its listeners with a binary search instead of
+        being matched against every address in turn. Patterns with wildcards still have
+        to be tried against all of them.
+    */
+    template <typename ListenerType>
+    class AddressDispatchTable
+    {
+    public:
+        void add (ListenerType* listenerToAdd, const OSCAddress& address)
+        {
+            for (auto& entry : entries)
+                if (entry.listener == listenerToAdd && entry.address == address)
+                    return;
+
+            auto addressString = address.toString();
+            auto hash = getHash (addressString.toRawUTF8(), addressString.getNumBytesAsUTF8());
+
+            // insert after any entries with the same hash, so that listeners for the same
+            // address are called in the order they were added
+            entries.insert (std::upper_bound (entries.begin(), entries.end(), hash, HashOrder()),
+                            { hash, address, addressString, listenerToAdd });
+        }
+
+        void remove (ListenerType* listenerToRemove)
+        {
+            auto found = std::find_if (entries.begin(), entries.end(),
+                                       [=] (const Entry& e) { return e.listener == listenerToRemove; });
+
+            if (found != entries.end())
+                entries.erase (found);
+        }
+
+        bool isEmpty() const noexcept       { return entries.empty(); }
+
+        template <typename Callback>
+        void callMatching (const OSCAddressPattern& pattern, Callback&& callback) const
+        {
+            if (pattern.containsWildcards())
+            {
+                for (auto& entry : entries)
+                    if (pattern.matches (entry.address))
+                        callback (*entry.listener);
+
+                return;
+            }
+
+            auto patternString = pattern.toString();
+            callExactMatches (patternString.toRawUTF8(), patternString.getNumBytesAsUTF8(), callback);
+        }
+
+        template <typename Callback>
+        void callMatching (const char* pattern, Callback&& callback) const
+        {
+            if (std::strpbrk (pattern, "*?{}[]") != nullptr)
+            {
+                try
+                {
+                    callMatching (OSCAddressPattern (pattern), callback);
+                }
+                catch (const OSCFormatError&) {}
+
+                return;
+            }
+
+            auto length = std::strlen (pattern);
+
+            while (length > 0 && pattern[length - 1] == '/')
+                --length;
+
+            callExactMatches (pattern, length, callback);
+        }
+
+    private:
+        struct Entry
+        {
+            uint32 hash;
+            OSCAddress address;
+            String addressString;
+            ListenerType* listener;
+        };
+
+        struct HashOrder
+        {
+            bool operator() (const Entry& e, uint32 hash) const noexcept   { return e.hash < hash; }
+            bool operator() (uint32 hash, const Entry& e) const noexcept   { return hash < e.hash; }
+        };
+
+        static uint32 getHash (const char* text, size_t length) noexcept
+        {
+            uint32 hash = 2166136261u;
+
+            for (size_t i = 0; i < length; ++i)
+                hash = (hash ^ (uint8) text[i]) * 16777619u;
+
+            return hash;
+        }
+
+        template <typename Callback>
+        void callExactMatches (const char* address, size_t length, Callback& callback) const
+        {
+            auto range = std::equal_range (entries.begin(), entries.end(), getHash (address, length), HashOrder());
+
+            for (auto i = range.first; i != range.second; ++i)
+                if (i->addressString.getNumBytesAsUTF8() == length
+                     && std::memcmp (i->addressString.toRawUTF8(), address, length) == 0)
+                    callback (*i->listener);
+        }
+
+        std::vector<Entry> entries;
+    };
+
+} // namespace OSCReceiverHelpers
+
 
 //==============================================================================
 struct OSCReceiver::Pimpl   : private Thread,
                               private MessageListener
 {
-    Pimpl (const String& oscThreadName)  : Thread (oscThreadName)
+    Pimpl (const String& oscThreadName, SocketIOService* serviceToUse = nullptr)
+        : Thread (oscThreadName), ioService (serviceToUse)
     {
     }
 
@@ -336,7 +456,7 @@ struct OSCReceiver::Pimpl   : private Thread,
         if (! socket->bindToPort (portNumber))
             return false;
 
-        startThread();
+        startReceiving();
         return true;
     }
 
@@ -346,7 +466,7 @@ struct OSCReceiver::Pimpl   : private Thread,
             return false;
 
         socket.setNonOwned (&newSocket);
-        startThread();
+        startReceiving();
         return true;
     }
 
@@ -354,6 +474,9 @@ struct OSCReceiver::Pimpl   : private Thread,
     {
         if (socket != nullptr)
         {
+            if (ioService != nullptr)
+                ioService->cancel (*socket);
+
             signalThreadShouldExit();
 
             if (socket.willDeleteObject())
@@ -380,12 +503,22 @@ struct OSCReceiver::Pimpl   : private Thread,
     void addListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress);
+        listenersWithAddress.add (listenerToAdd, addressToMatch);
     }
 
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd, OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.add (listenerToAdd, addressToMatch);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd)
+    {
+        viewListeners.add (listenerToAdd);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+    {
+        viewListenersWithAddress.add (listenerToAdd, addressToMatch);
     }
 
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
@@ -400,12 +533,18 @@ struct OSCReceiver::Pimpl   : private Thread,
 
     void removeListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, listenersWithAddress);
+        listenersWithAddress.remove (listenerToRemove);
     }
 
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.remove (listenerToRemove);
+    }
+
+    void removeListener (MessageViewListener* listenerToRemove)
+    {
+        viewListeners.remove (listenerToRemove);
+        viewListenersWithAddress.remove (listenerToRemove);
     }
 
     //==============================================================================
@@ -420,6 +559,23 @@ struct OSCReceiver::Pimpl   : private Thread,
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
     {
+        if (! viewListeners.isEmpty() || ! viewListenersWithAddress.isEmpty())
+        {
+            if (! OSCMessageView::forEachMessage (data, dataSize, [this] (const OSCMessageView& m) { callMessageViewListeners (m); }))
+            {
+                if (formatErrorHandler != nullptr)
+                    formatErrorHandler (data, (int) dataSize);
+
+                return;
+            }
+        }
+
+        // building the OSCMessage and OSCBundle objects means allocating, so
+        // don't bother unless somebody is going to be given them
+        if (realtimeListeners.isEmpty() && realtimeListenersWithAddress.isEmpty()
+             && listeners.isEmpty() && listenersWithAddress.isEmpty())
+            return;
+
         OSCInputStream inStream (data, dataSize);
 
         try
@@ -435,7 +591,7 @@ struct OSCReceiver::Pimpl   : private Thread,
 
             // now post the message that will trigger the handleMessage callback
             // dealing with the non-realtime listeners.
-            if (listeners.size() > 0 || listenersWithAddress.size() > 0)
+            if (! listeners.isEmpty() || ! listenersWithAddress.isEmpty())
                 postMessage (new CallbackMessage (content));
         }
         catch (const OSCFormatError&)
@@ -453,9 +609,38 @@ struct OSCReceiver::Pimpl   : private Thread,
 
 private:
     //==============================================================================
+    static constexpr int bufferSize = 65535;
+
+    void startReceiving()
+    {
+        if (ioService == nullptr)
+        {
+            startThread();
+            return;
+        }
+
+        if (asyncBuffer == nullptr)
+            asyncBuffer.malloc (bufferSize);
+
+        readNextPacket();
+    }
+
+    void readNextPacket()
+    {
+        ioService->asyncRead (*socket, asyncBuffer, bufferSize, [this] (int bytesRead, const String&, int)
+        {
+            if (bytesRead < 0)
+                return;
+
+            if (bytesRead >= 4)
+                handleBuffer (asyncBuffer, (size_t) bytesRead);
+
+            readNextPacket();
+        });
+    }
+
     void run() override
     {
-        int bufferSize = 65535;
         HeapBlock<char> oscBuffer (bufferSize);
 
         while (! threadShouldExit())
@@ -476,38 +661,6 @@ private:
         }
     }
 
-    //==============================================================================
-    template <typename ListenerType>
-    void addListenerWithAddress (ListenerType* listenerToAdd,
-                                 OSCAddress address,
-                                 Array<std::pair<OSCAddress, ListenerType*>>& array)
-    {
-        for (auto& i : array)
-            if (address == i.first && listenerToAdd == i.second)
-                return;
-
-        array.add (std::make_pair (address, listenerToAdd));
-    }
-
-    //==============================================================================
-    template <typename ListenerType>
-    void removeListenerWithAddress (ListenerType* listenerToRemove,
-                                    Array<std::pair<OSCAddress, ListenerType*>>& array)
-    {
-        for (int i = 0; i < array.size(); ++i)
-        {
-            if (listenerToRemove == array.getReference (i).second)
-            {
-                // aarrgh... can't simply call array.remove (i) because this
-                // requires a default c'tor to be present for OSCAddress...
-                // luckily, we don't care about methods preserving element order:
-                array.swap (i, array.size() - 1);
-                array.removeLast();
-                break;
-            }
-        }
-    }
-
     //==============================================================================
     void handleMessage (const Message& msg) override
     {
@@ -558,30 +711,40 @@ private:
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        listenersWithAddress.callMatching (message.getAddressPattern(),
+                                           [&] (ListenerWithOSCAddress<MessageLoopCallback>& l) { l.oscMessageReceived (message); });
     }
 
     void callRealtimeListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        realtimeListenersWithAddress.callMatching (message.getAddressPattern(),
+                                                   [&] (ListenerWithOSCAddress<RealtimeCallback>& l) { l.oscMessageReceived (message); });
+    }
+
+    void callMessageViewListeners (const OSCMessageView& message)
+    {
+        viewListeners.call ([&] (MessageViewListener& l) { l.oscMessageViewReceived (message); });
+
+        viewListenersWithAddress.callMatching (message.getAddressPattern(),
+                                               [&] (MessageViewListener& l) { l.oscMessageViewReceived (message); });
     }
 
     //==============================================================================
     ListenerList<OSCReceiver::Listener<OSCReceiver::MessageLoopCallback>> listeners;
     ListenerList<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>>    realtimeListeners;
 
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
+    OSCReceiverHelpers::AddressDispatchTable<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>> listenersWithAddress;
+    OSCReceiverHelpers::AddressDispatchTable<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>>    realtimeListenersWithAddress;
+
+    ListenerList<OSCReceiver::MessageViewListener> viewListeners;
+    OSCReceiverHelpers::AddressDispatchTable<OSCReceiver::MessageViewListener> viewListenersWithAddress;
 
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
 
+    SocketIOService* ioService = nullptr;
+    HeapBlock<char> asyncBuffer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
@@ -594,6 +757,11 @@ OSCReceiver::OSCReceiver()  : OSCReceiver ("JUCE OSC server")
 {
 }
 
+OSCReceiver::OSCReceiver (SocketIOService& serviceToUse)
+    : pimpl (new Pimpl ("JUCE OSC server", &serviceToUse))
+{
+}
+
 OSCReceiver::~OSCReceiver()
 {
     pimpl.reset();
@@ -634,6 +802,16 @@ void OSCReceiver::addListener (ListenerWithOSCAddress<RealtimeCallback>* listene
     pimpl->addListener (listenerToAdd, addressToMatch);
 }
 
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+{
+    pimpl->addListener (listenerToAdd, addressToMatch);
+}
+
 void OSCReceiver::removeListener (Listener<MessageLoopCallback>* listenerToRemove)
 {
     pimpl->removeListener (listenerToRemove);
@@ -654,6 +832,11 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::removeListener (MessageViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1189,6 +1372,69 @@ public:
 
 static OSCInputStreamTests OSCInputStreamUnitTests;
 
+//==============================================================================
+class OSCReceiverTests  : public UnitTest
+{
+public:
+    OSCReceiverTests()
+        : UnitTest ("OSCReceiver class", UnitTestCategories::osc)
+    {}
+
+    struct CountingListener  : public OSCReceiver::Listener<OSCReceiver::RealtimeCallback>
+    {
+        void oscMessageReceived (const OSCMessage& message) override
+        {
+            if (message.size() == 1 && message[0].isInt32())
+                total += message[0].getInt32();
+
+            if (++numReceived == numExpected)
+                finished.signal();
+        }
+
+        std::atomic<int> numReceived { 0 }, total { 0 };
+        int numExpected = 0;
+        WaitableEvent finished;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Receiving on a SocketIOService");
+        {
+            SocketIOService service;
+            DatagramSocket socket;
+            expect (socket.bindToPort (0, "127.0.0.1"));
+
+            constexpr int numMessages = 100;
+            CountingListener listener;
+            listener.numExpected = numMessages;
+
+            OSCReceiver receiver (service);
+            receiver.addListener (&listener);
+            expect (receiver.connectToSocket (socket));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", socket.getBoundPort()));
+
+            for (int i = 0; i < numMessages; ++i)
+            {
+                expect (sender.send ("/juce/test", i));
+
+                // give the receiver a chance to keep up, as datagrams can be dropped
+                if (i % 10 == 9)
+                    Thread::sleep (1);
+            }
+
+            expect (listener.finished.wait (5000));
+            expectEquals (listener.total.load(), numMessages * (numMessages - 1) / 2);
+
+            expect (receiver.disconnect());
+            receiver.removeListener (&listener);
+        }
+    }
+};
+
+static OSCReceiverTests OSCReceiverUnitTests;
+
 #endif
 
 } // namespace juce
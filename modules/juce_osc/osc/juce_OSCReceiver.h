@@ -47,6 +47,15 @@ public:
     /** Creates an OSCReceiver with a specific name for its thread. */
     OSCReceiver (const String& threadName);
 
+    /** Creates an OSCReceiver that waits for packets on one of the threads of a
+        SocketIOService, rather than starting a thread of its own.
+
+        This lets you run many receivers without needing a thread for each. Realtime
+        listeners will be called on one of the service's threads. The service must
+        outlive this object.
+    */
+    explicit OSCReceiver (SocketIOService& serviceToUse);
+
     /** Destructor. */
     ~OSCReceiver();
 
@@ -157,6 +166,35 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any memory
+        being allocated.
+
+        Instead of an OSCMessage, this type of listener is given an OSCMessageView that
+        points into the receiver's buffer, and it's always called directly on the network
+        thread. If a receiver only has listeners of this type, it never builds OSCMessage
+        or OSCBundle objects at all, so this is the quickest way to handle high rates of
+        small messages.
+
+        Unlike the other listeners, this one is called separately for each of the messages
+        inside a bundle, so it also sees messages that an OSCSender has bundled together.
+
+        @see OSCReceiver::addListener, OSCMessageView, OSCSender::setBundlingWindow
+    */
+    class JUCE_API  MessageViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~MessageViewListener() = default;
+
+        /** Called when the OSCReceiver receives an OSC message.
+
+            The view and the data it refers to are only valid until this callback returns,
+            so make a copy of anything you need to keep.
+        */
+        virtual void oscMessageViewReceived (const OSCMessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -183,6 +221,17 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that is given a view of every incoming OSC message, including
+        those inside bundles. The listener will be called directly on the network thread.
+    */
+    void addListener (MessageViewListener* listenerToAdd);
+
+    /** Adds a listener that is given a view of every incoming OSC message that matches
+        the address used to register it, including those inside bundles. The listener
+        will be called directly on the network thread.
+    */
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -195,6 +244,9 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener. */
+    void removeListener (MessageViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.
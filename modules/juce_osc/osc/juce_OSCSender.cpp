@@ -26,7 +26,7 @@
 namespace juce
 {
 
-namespace
+namespace OSCSenderHelpers
 {
     //==============================================================================
     /** Writes OSC data to an internal memory buffer, which grows as required.
@@ -73,6 +73,14 @@ namespace
             return output.writeRepeatedByte ('\0', numPaddingZeros);
         }
 
+        bool writeString (const char* value)
+        {
+            auto numBytes = std::strlen (value);
+
+            return output.write (value, numBytes + 1)
+                    && output.writeRepeatedByte ('\0', ~numBytes & 3);
+        }
+
         bool writeBlob (const MemoryBlock& blob)
         {
             if (! (output.writeIntBigEndian ((int) blob.getSize())
@@ -105,15 +113,20 @@ namespace
         }
 
         bool writeTypeTagString (const OSCTypeList& typeList)
+        {
+            return writeTypeTagString (typeList.begin(), typeList.size());
+        }
+
+        bool writeTypeTagString (const OSCType* types, int numTypes)
         {
             output.writeByte (',');
 
-            if (typeList.size() > 0)
-                output.write (typeList.begin(), (size_t) typeList.size());
+            if (numTypes > 0)
+                output.write (types, (size_t) numTypes);
 
             output.writeByte ('\0');
 
-            size_t bytesWritten = (size_t) typeList.size() + 1;
+            size_t bytesWritten = (size_t) numTypes + 1;
             size_t numPaddingZeros = ~bytesWritten & 0x03;
 
             return output.writeRepeatedByte ('\0', numPaddingZeros);
@@ -142,12 +155,16 @@ namespace
             if (! writeAddressPattern (msg.getAddressPattern()))
                 return false;
 
-            OSCTypeList typeList;
+            // writing the type tags directly, rather than building an OSCTypeList for
+            // writeTypeTagString(), saves an allocation for every message
+            output.writeByte (',');
 
             for (auto& arg : msg)
-                typeList.add (arg.getType());
+                output.writeByte (arg.getType());
 
-            if (! writeTypeTagString (typeList))
+            auto bytesWritten = (size_t) msg.size() + 1;
+
+            if (! output.writeRepeatedByte ('\0', 1 + (~bytesWritten & 0x03)))
                 return false;
 
             for (auto& arg : msg)
@@ -199,20 +216,41 @@ namespace
                      && output.setPosition (endPos);
         }
 
+        /** Writes a bundle element whose content has already been written to another stream. */
+        bool writeBundleElement (const OSCOutputStream& content)
+        {
+            return writeInt32 ((int32) content.getDataSize())
+                    && output.write (content.getData(), content.getDataSize());
+        }
+
+        /** Empties the stream, but keeps its memory for the next time it's used. */
+        void reset() noexcept
+        {
+            output.reset();
+        }
+
     private:
         MemoryOutputStream output;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
     };
 
-} // namespace
+} // namespace OSCSenderHelpers
+
+using OSCSenderHelpers::OSCOutputStream;
 
 
 //==============================================================================
-struct OSCSender::Pimpl
+struct OSCSender::Pimpl  : private HighResolutionTimer
 {
     Pimpl() noexcept  {}
-    ~Pimpl() noexcept { disconnect(); }
+
+    ~Pimpl() noexcept override
+    {
+        stopRealtimeQueue();
+        stopTimer();
+        disconnect();
+    }
 
     //==============================================================================
     bool connect (const String& newTargetHost, int newTargetPort)
@@ -220,6 +258,8 @@ struct OSCSender::Pimpl
         if (! disconnect())
             return false;
 
+        const ScopedLock sl (lock);
+
         socket.setOwned (new DatagramSocket (true));
         targetHostName = newTargetHost;
         targetPortNumber = newTargetPort;
@@ -236,6 +276,8 @@ struct OSCSender::Pimpl
         if (! disconnect())
             return false;
 
+        const ScopedLock sl (lock);
+
         socket.setNonOwned (&newSocket);
         targetHostName = newTargetHost;
         targetPortNumber = newTargetPort;
@@ -244,6 +286,11 @@ struct OSCSender::Pimpl
 
     bool disconnect()
     {
+        const ScopedLock sl (lock);
+
+        if (socket != nullptr)
+            sendPendingBundle();
+
         socket.reset();
         return true;
     }
@@ -265,19 +312,313 @@ struct OSCSender::Pimpl
             && sendOutputStream (outStream, hostName, portNumber);
     }
 
-    bool send (const OSCMessage& message)   { return send (message, targetHostName, targetPortNumber); }
-    bool send (const OSCBundle& bundle)     { return send (bundle,  targetHostName, targetPortNumber); }
+    bool send (const OSCMessage& message)
+    {
+        const ScopedLock sl (lock);
+
+        if (bundlingWindowMs > 0)
+            return addToPendingBundle ([&] (OSCOutputStream& out) { return out.writeMessage (message); }, false);
+
+        return send (message, targetHostName, targetPortNumber);
+    }
+
+    bool send (const OSCBundle& bundle)
+    {
+        const ScopedLock sl (lock);
+
+        auto sentPendingMessages = sendPendingBundle();
+        return send (bundle, targetHostName, targetPortNumber) && sentPendingMessages;
+    }
+
+    //==============================================================================
+    void setBundlingWindow (int milliseconds, int maximumPacketSize)
+    {
+        // the timer has to be stopped without holding the lock, as its
+        // callback might be waiting for it
+        stopTimer();
+
+        const ScopedLock sl (lock);
+
+        sendPendingBundle();
+        bundlingWindowMs = jmax (0, milliseconds);
+        maxBundleSize = (size_t) jmax (32, maximumPacketSize);
+
+        if (bundlingWindowMs > 0)
+            startTimer (bundlingWindowMs);
+    }
+
+    bool flush()
+    {
+        const ScopedLock sl (lock);
+        return sendPendingBundle();
+    }
+
+    //==============================================================================
+    void startRealtimeQueue (int maxNumMessages, int intervalMilliseconds)
+    {
+        stopRealtimeQueue();
+
+        numRealtimeMessagesQueued = 0;
+        numRealtimeMessagesDropped = 0;
+        numRealtimeMessagesSent = 0;
+        numRealtimeMessagesFailed = 0;
+
+        realtimeQueue.reset (new RealtimeQueue (*this, maxNumMessages, intervalMilliseconds));
+        realtimeQueue->startThread (Thread::Priority::high);
+    }
+
+    void stopRealtimeQueue()
+    {
+        // this mustn't hold the lock, as the queue's thread needs it to finish
+        realtimeQueue.reset();
+    }
+
+    bool isRealtimeQueueRunning() const noexcept
+    {
+        return realtimeQueue != nullptr;
+    }
+
+    bool sendFromRealtimeThread (const char* addressPattern, const RealtimeArgument* args, int numArgs) noexcept
+    {
+        return addToRealtimeQueue (addressPattern, numArgs, [=] (RealtimeMessage& message)
+        {
+            for (int i = 0; i < numArgs; ++i)
+            {
+                message.types[i] = args[i].type;
+                std::memcpy (message.values + i, &args[i].value, sizeof (int32));
+            }
+        });
+    }
+
+    bool sendFromRealtimeThread (const char* addressPattern, const float* values, int numValues) noexcept
+    {
+        return addToRealtimeQueue (addressPattern, numValues, [=] (RealtimeMessage& message)
+        {
+            for (int i = 0; i < numValues; ++i)
+            {
+                message.types[i] = OSCTypes::float32;
+                std::memcpy (message.values + i, values + i, sizeof (int32));
+            }
+        });
+    }
+
+    RealtimeQueueStatistics getRealtimeQueueStatistics() const noexcept
+    {
+        RealtimeQueueStatistics stats;
+        stats.numMessagesQueued  = numRealtimeMessagesQueued;
+        stats.numMessagesDropped = numRealtimeMessagesDropped;
+        stats.numMessagesSent    = numRealtimeMessagesSent;
+        stats.numMessagesFailed  = numRealtimeMessagesFailed;
+        return stats;
+    }
 
 private:
     //==============================================================================
+    template <typename FillArguments>
+    bool addToRealtimeQueue (const char* addressPattern, int numArgs, FillArguments&& fillArguments) noexcept
+    {
+        if (realtimeQueue == nullptr)
+        {
+            // You need to call startRealtimeQueue() before sending anything with this!
+            jassertfalse;
+            return false;
+        }
+
+        auto length = std::strlen (addressPattern);
+
+        if (length > (size_t) maxRealtimeAddressLength || ! isPositiveAndNotGreaterThan (numArgs, maxRealtimeArguments))
+        {
+            // The address or the number of arguments is too large for the preallocated queue.
+            jassertfalse;
+            ++numRealtimeMessagesFailed;
+            return false;
+        }
+
+        auto scope = realtimeQueue->fifo.write (1);
+
+        if (scope.blockSize1 == 0)
+        {
+            ++numRealtimeMessagesDropped;
+            return false;
+        }
+
+        auto& message = realtimeQueue->messages[(size_t) scope.startIndex1];
+        std::memcpy (message.addressPattern, addressPattern, length + 1);
+        message.numArguments = numArgs;
+        fillArguments (message);
+
+        ++numRealtimeMessagesQueued;
+        return true;
+    }
+
+    struct RealtimeMessage
+    {
+        char addressPattern[maxRealtimeAddressLength + 1];
+        int numArguments;
+        OSCType types[maxRealtimeArguments];
+        int32 values[maxRealtimeArguments];
+    };
+
+    struct RealtimeQueue  : public Thread
+    {
+        RealtimeQueue (Pimpl& o, int maxNumMessages, int interval)
+            : Thread ("JUCE OSC realtime sender"),
+              owner (o),
+              fifo (jmax (1, maxNumMessages) + 1),
+              messages ((size_t) fifo.getTotalSize()),
+              intervalMs (jmax (1, interval))
+        {
+        }
+
+        ~RealtimeQueue() override
+        {
+            signalThreadShouldExit();
+            notify();
+            stopThread (10000);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait (intervalMs);
+                owner.sendRealtimeMessages (*this);
+            }
+
+            owner.sendRealtimeMessages (*this);
+        }
+
+        Pimpl& owner;
+        AbstractFifo fifo;
+        std::vector<RealtimeMessage> messages;
+        const int intervalMs;
+    };
+
+    void sendRealtimeMessages (RealtimeQueue& queue)
+    {
+        auto numReady = queue.fifo.getNumReady();
+
+        if (numReady == 0)
+            return;
+
+        const ScopedLock sl (lock);
+
+        queue.fifo.read (numReady).forEach ([&] (int index)
+        {
+            auto& message = queue.messages[(size_t) index];
+
+            if (message.addressPattern[0] != '/' || socket == nullptr)
+            {
+                ++numRealtimeMessagesFailed;
+                return;
+            }
+
+            auto written = addToPendingBundle ([&] (OSCOutputStream& out)
+            {
+                if (! (out.writeString (message.addressPattern)
+                        && out.writeTypeTagString (message.types, message.numArguments)))
+                    return false;
+
+                for (int i = 0; i < message.numArguments; ++i)
+                    if (! out.writeInt32 (message.values[i]))
+                        return false;
+
+                return true;
+            }, true);
+
+            if (! written)
+                ++numRealtimeMessagesFailed;
+        });
+
+        sendPendingBundle();
+    }
+
+    //==============================================================================
+    template <typename WriteMessage>
+    bool addToPendingBundle (WriteMessage&& writeMessage, bool isRealtimeMessage)
+    {
+        if (socket == nullptr)
+        {
+            // if you hit this, you tried to send some OSC data without being
+            // connected to a port! You should call OSCSender::connect() first.
+            jassertfalse;
+            return false;
+        }
+
+        pendingMessage.reset();
+
+        if (! writeMessage (pendingMessage))
+            return false;
+
+        auto sentOk = true;
+
+        if (numPendingMessages > 0
+             && pendingBundle.getDataSize() + 4 + pendingMessage.getDataSize() > maxBundleSize)
+            sentOk = sendPendingBundle();
+
+        if (numPendingMessages == 0)
+        {
+            pendingBundle.reset();
+            pendingBundle.writeString ("#bundle");
+            pendingBundle.writeTimeTag (OSCTimeTag::immediately);
+        }
+
+        if (! pendingBundle.writeBundleElement (pendingMessage))
+            return false;
+
+        ++numPendingMessages;
+
+        if (isRealtimeMessage)
+            ++numPendingRealtimeMessages;
+
+        if (pendingBundle.getDataSize() >= maxBundleSize)
+            return sendPendingBundle() && sentOk;
+
+        return sentOk;
+    }
+
+    bool sendPendingBundle()
+    {
+        if (numPendingMessages == 0)
+            return true;
+
+        auto* data = static_cast<const char*> (pendingBundle.getData());
+        auto size = pendingBundle.getDataSize();
+
+        // a bundle that only contains one message is sent as the message on its own,
+        // skipping the bundle header and the element size
+        if (numPendingMessages == 1)
+        {
+            data += bundleHeaderSize;
+            size -= bundleHeaderSize;
+        }
+
+        auto sentOk = sendData (data, size, targetHostName, targetPortNumber);
+
+        (sentOk ? numRealtimeMessagesSent : numRealtimeMessagesFailed) += numPendingRealtimeMessages;
+        numPendingMessages = 0;
+        numPendingRealtimeMessages = 0;
+        return sentOk;
+    }
+
+    void hiResTimerCallback() override
+    {
+        const ScopedLock sl (lock);
+        sendPendingBundle();
+    }
+
     bool sendOutputStream (OSCOutputStream& outStream, const String& hostName, int portNumber)
+    {
+        return sendData (outStream.getData(), outStream.getDataSize(), hostName, portNumber);
+    }
+
+    bool sendData (const void* data, size_t size, const String& hostName, int portNumber)
     {
         if (socket != nullptr)
         {
-            const int streamSize = (int) outStream.getDataSize();
+            const int streamSize = (int) size;
 
-            const int bytesWritten = socket->write (hostName, portNumber,
-                                                    outStream.getData(), streamSize);
+            const int bytesWritten = socket->write (hostName, portNumber, data, streamSize);
             return bytesWritten == streamSize;
         }
 
@@ -289,10 +630,22 @@ private:
     }
 
     //==============================================================================
+    static constexpr size_t bundleHeaderSize = 20; // "#bundle", the time tag and the first element's size
+
+    CriticalSection lock;
     OptionalScopedPointer<DatagramSocket> socket;
     String targetHostName;
     int targetPortNumber = 0;
 
+    int bundlingWindowMs = 0;
+    size_t maxBundleSize = 1472;
+    OSCOutputStream pendingBundle, pendingMessage;
+    int numPendingMessages = 0, numPendingRealtimeMessages = 0;
+
+    std::unique_ptr<RealtimeQueue> realtimeQueue;
+    std::atomic<int64> numRealtimeMessagesQueued { 0 }, numRealtimeMessagesDropped { 0 },
+                       numRealtimeMessagesSent { 0 }, numRealtimeMessagesFailed { 0 };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
@@ -331,6 +684,48 @@ bool OSCSender::send (const OSCBundle& bundle)      { return pimpl->send (bundle
 bool OSCSender::sendToIPAddress (const String& host, int port, const OSCMessage& message) { return pimpl->send (message, host, port); }
 bool OSCSender::sendToIPAddress (const String& host, int port, const OSCBundle& bundle)   { return pimpl->send (bundle,  host, port); }
 
+//==============================================================================
+void OSCSender::setBundlingWindow (int milliseconds, int maximumPacketSize)
+{
+    pimpl->setBundlingWindow (milliseconds, maximumPacketSize);
+}
+
+bool OSCSender::flush()
+{
+    return pimpl->flush();
+}
+
+//==============================================================================
+void OSCSender::startRealtimeQueue (int maxNumMessages, int intervalMilliseconds)
+{
+    pimpl->startRealtimeQueue (maxNumMessages, intervalMilliseconds);
+}
+
+void OSCSender::stopRealtimeQueue()
+{
+    pimpl->stopRealtimeQueue();
+}
+
+bool OSCSender::isRealtimeQueueRunning() const noexcept
+{
+    return pimpl->isRealtimeQueueRunning();
+}
+
+bool OSCSender::sendFromRealtimeThread (const char* addressPattern, std::initializer_list<RealtimeArgument> arguments) noexcept
+{
+    return pimpl->sendFromRealtimeThread (addressPattern, arguments.begin(), (int) arguments.size());
+}
+
+bool OSCSender::sendFromRealtimeThread (const char* addressPattern, const float* values, int numValues) noexcept
+{
+    return pimpl->sendFromRealtimeThread (addressPattern, values, numValues);
+}
+
+OSCSender::RealtimeQueueStatistics OSCSender::getRealtimeQueueStatistics() const noexcept
+{
+    return pimpl->getRealtimeQueueStatistics();
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -871,6 +1266,209 @@ public:
 
 static OSCRoundTripTests OSCRoundTripUnitTests;
 
+//==============================================================================
+class OSCSenderBundlingTests  : public UnitTest
+{
+public:
+    OSCSenderBundlingTests()
+        : UnitTest ("OSCSender bundling and address dispatch", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        DatagramSocket receiverSocket (false);
+        expect (receiverSocket.bindToPort (0, "127.0.0.1"));
+
+        OSCReceiver receiver;
+        expect (receiver.connectToSocket (receiverSocket));
+
+        CountingListener counter;
+        receiver.addListener (static_cast<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>*> (&counter));
+        receiver.addListener (static_cast<OSCReceiver::MessageViewListener*> (&counter));
+
+        OSCSender sender;
+        expect (sender.connect ("127.0.0.1", receiverSocket.getBoundPort()));
+
+        beginTest ("Messages are bundled together");
+        {
+            counter.reset();
+            sender.setBundlingWindow (10000);
+
+            for (int i = 0; i < 10; ++i)
+                expect (sender.send ("/test/bundled", i));
+
+            Thread::sleep (50);
+            expectEquals (counter.numViews.load(), 0);
+
+            expect (sender.flush());
+            expect (counter.waitForViews (10));
+            expectEquals (counter.numBundles.load(), 1);
+            expectEquals (counter.numMessages.load(), 0);
+            expectEquals (counter.lastValue.load(), 9);
+        }
+
+        beginTest ("A single message isn't wrapped in a bundle");
+        {
+            counter.reset();
+
+            expect (sender.send ("/test/single", 1));
+            expect (sender.flush());
+            expect (counter.waitForViews (1));
+            expectEquals (counter.numBundles.load(), 0);
+            expectEquals (counter.numMessages.load(), 1);
+        }
+
+        beginTest ("Bundles are split at the maximum packet size");
+        {
+            counter.reset();
+            sender.setBundlingWindow (10000, 256);
+
+            for (int i = 0; i < 40; ++i)
+                expect (sender.send ("/test/split", i));
+
+            expect (sender.flush());
+            expect (counter.waitForViews (40));
+            expectEquals (counter.numBundles.load(), 4);
+            expectEquals (counter.lastValue.load(), 39);
+        }
+
+        beginTest ("Messages are sent when the window has passed");
+        {
+            counter.reset();
+            sender.setBundlingWindow (20);
+
+            for (int i = 0; i < 3; ++i)
+                expect (sender.send ("/test/timed", i));
+
+            expect (counter.waitForViews (3));
+            sender.setBundlingWindow (0);
+        }
+
+        beginTest ("Listeners with an address");
+        {
+            counter.reset();
+
+            AddressListener exactView, exactRealtime, other;
+            receiver.addListener (static_cast<OSCReceiver::MessageViewListener*> (&exactView), "/test/a");
+            receiver.addListener (static_cast<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*> (&exactRealtime), "/test/a");
+            receiver.addListener (static_cast<OSCReceiver::MessageViewListener*> (&other), "/test/b/c");
+
+            expect (sender.send ("/test/a", 1));
+            expect (sender.send ("/test/b", 2));
+            expect (sender.send ("/test/[ab]", 3));
+            expect (sender.send ("/test/b/c/", 4));
+            expect (counter.waitForViews (4));
+
+            expect (exactView.values == Array<int> (1, 3));
+            expect (exactRealtime.values == Array<int> (1, 3));
+            expect (other.values == Array<int> (4));
+
+            receiver.removeListener (static_cast<OSCReceiver::MessageViewListener*> (&exactView));
+            receiver.removeListener (static_cast<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*> (&exactRealtime));
+            receiver.removeListener (static_cast<OSCReceiver::MessageViewListener*> (&other));
+        }
+
+        beginTest ("Sending from a realtime thread");
+        {
+            counter.reset();
+            sender.startRealtimeQueue (64, 2);
+            expect (sender.isRealtimeQueueRunning());
+
+            for (int i = 0; i < 50; ++i)
+                expect (sender.sendFromRealtimeThread ("/test/realtime", { i, 0.5f }));
+
+            expect (counter.waitForViews (50));
+            expectEquals (counter.lastValue.load(), 49);
+
+            auto stats = sender.getRealtimeQueueStatistics();
+            expectEquals (stats.numMessagesQueued, (int64) 50);
+            expectEquals (stats.numMessagesSent, (int64) 50);
+            expectEquals (stats.numMessagesDropped, (int64) 0);
+            expectEquals (stats.numMessagesFailed, (int64) 0);
+
+            counter.reset();
+            const float levels[] = { 0.25f, 0.5f };
+            expect (sender.sendFromRealtimeThread ("/test/levels", levels, 2));
+            expect (counter.waitForViews (1));
+            expectEquals (counter.lastFloat.load(), 0.5f);
+
+            sender.stopRealtimeQueue();
+            expect (! sender.isRealtimeQueueRunning());
+        }
+
+        beginTest ("Messages are dropped when the realtime queue is full");
+        {
+            counter.reset();
+            sender.startRealtimeQueue (8, 10000);
+
+            for (int i = 0; i < 20; ++i)
+                sender.sendFromRealtimeThread ("/test/realtime", { i });
+
+            auto stats = sender.getRealtimeQueueStatistics();
+            expectEquals (stats.numMessagesQueued, (int64) 8);
+            expectEquals (stats.numMessagesDropped, (int64) 12);
+
+            sender.stopRealtimeQueue();
+            expect (counter.waitForViews (8));
+            expectEquals (counter.lastValue.load(), 7);
+            expectEquals (sender.getRealtimeQueueStatistics().numMessagesSent, (int64) 8);
+        }
+
+        receiver.removeListener (static_cast<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>*> (&counter));
+        receiver.removeListener (static_cast<OSCReceiver::MessageViewListener*> (&counter));
+        receiver.disconnect();
+    }
+
+private:
+    struct CountingListener  : public OSCReceiver::Listener<OSCReceiver::RealtimeCallback>,
+                               public OSCReceiver::MessageViewListener
+    {
+        void oscMessageReceived (const OSCMessage&) override     { ++numMessages; }
+        void oscBundleReceived (const OSCBundle&) override       { ++numBundles; }
+
+        void oscMessageViewReceived (const OSCMessageView& m) override
+        {
+            if (m[0].isInt32())
+                lastValue = m[0].getInt32();
+            else if (m.size() > 1 && m[1].isFloat32())
+                lastFloat = m[1].getFloat32();
+
+            ++numViews;
+        }
+
+        void reset()
+        {
+            numMessages = 0;
+            numBundles = 0;
+            numViews = 0;
+            lastValue = -1;
+        }
+
+        bool waitForViews (int target) const
+        {
+            for (int i = 0; i < 400 && numViews < target; ++i)
+                Thread::sleep (5);
+
+            Thread::sleep (20);
+            return numViews == target;
+        }
+
+        std::atomic<int> numMessages { 0 }, numBundles { 0 }, numViews { 0 }, lastValue { -1 };
+        std::atomic<float> lastFloat { 0.0f };
+    };
+
+    struct AddressListener  : public OSCReceiver::MessageViewListener,
+                              public OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>
+    {
+        void oscMessageViewReceived (const OSCMessageView& m) override   { values.add (m[0].getInt32()); }
+        void oscMessageReceived (const OSCMessage& m) override           { values.add (m[0].getInt32()); }
+
+        Array<int, CriticalSection> values;
+    };
+};
+
+static OSCSenderBundlingTests OSCSenderBundlingUnitTests;
+
 #endif
 
 } // namespace juce
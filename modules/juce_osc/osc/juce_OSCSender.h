@@ -137,6 +137,113 @@ public:
     bool sendToIPAddress (const String& targetIPAddress, int targetPortNumber,
                           const OSCAddressPattern& address, Args&&... args);
 
+    //==============================================================================
+    /** Makes the sender collect the messages that it sends to its target into bundles.
+
+        When the window is more than zero, send (const OSCMessage&) doesn't send the
+        message straight away, but adds it to a bundle. The bundle is sent once the
+        window has passed, or as soon as it reaches maximumPacketSize bytes. Packing
+        many small messages into each UDP packet greatly reduces the work done per
+        message at both ends when you're sending thousands of them every second. The
+        default packet size is the largest that fits in a single Ethernet frame.
+
+        A bundle holding only one message is sent as a plain message. Bundles and
+        messages sent with sendToIPAddress() are never delayed, but sending a bundle
+        to the target first sends any messages that are waiting, so that they arrive
+        in order.
+
+        Bear in mind that an OSCReceiver's ListenerWithOSCAddress objects ignore bundles,
+        so the receiving end will need to use an OSCReceiver::Listener or an
+        OSCReceiver::MessageViewListener to see these messages.
+
+        Passing 0 turns bundling off again, after sending anything that was waiting.
+
+        @see flush
+    */
+    void setBundlingWindow (int milliseconds, int maximumPacketSize = 1472);
+
+    /** Sends any messages that are waiting to be bundled straight away.
+
+        @returns true if the operation was successful.
+        @see setBundlingWindow
+    */
+    bool flush();
+
+    //==============================================================================
+    /** One of the arguments of a message sent with sendFromRealtimeThread().
+
+        Only int32, float32 and colour arguments can be sent in this way, as they
+        don't need any memory to be allocated.
+    */
+    struct RealtimeArgument
+    {
+        RealtimeArgument (int32 v) noexcept        : type (OSCTypes::int32)    { value.intValue = v; }
+        RealtimeArgument (float v) noexcept        : type (OSCTypes::float32)  { value.floatValue = v; }
+        RealtimeArgument (OSCColour c) noexcept    : type (OSCTypes::colour)   { value.intValue = (int32) c.toInt32(); }
+
+        OSCType type;
+        union { int32 intValue; float floatValue; } value;
+    };
+
+    /** The statistics that are kept by the realtime queue.
+        @see getRealtimeQueueStatistics
+    */
+    struct RealtimeQueueStatistics
+    {
+        int64 numMessagesQueued = 0;    /**< The number of messages added to the queue. */
+        int64 numMessagesDropped = 0;   /**< The number of messages that were dropped because the queue was full. */
+        int64 numMessagesSent = 0;      /**< The number of queued messages that have been sent. */
+        int64 numMessagesFailed = 0;    /**< The number of queued messages that couldn't be sent. */
+    };
+
+    /** The longest address pattern that can be sent with sendFromRealtimeThread(). */
+    static constexpr int maxRealtimeAddressLength = 63;
+
+    /** The largest number of arguments that can be sent with sendFromRealtimeThread(). */
+    static constexpr int maxRealtimeArguments = 16;
+
+    /** Starts a background thread and a preallocated queue, so that messages can be
+        sent from a realtime thread such as the audio callback.
+
+        Call this to get the sender ready before using sendFromRealtimeThread(). Every
+        intervalMilliseconds the thread takes whatever is in the queue, writes it as OSC
+        data, and sends it to the target in as few packets as it can, splitting them at
+        the maximum packet size set with setBundlingWindow().
+
+        @see sendFromRealtimeThread, stopRealtimeQueue
+    */
+    void startRealtimeQueue (int maxNumMessages = 1024, int intervalMilliseconds = 2);
+
+    /** Sends anything that is left in the realtime queue, then stops its thread.
+        @see startRealtimeQueue
+    */
+    void stopRealtimeQueue();
+
+    /** Returns true if the realtime queue has been started. */
+    bool isRealtimeQueueRunning() const noexcept;
+
+    /** Adds a message for the connected target to the realtime queue.
+
+        This doesn't allocate, lock, or make any system calls, so it's safe to call from
+        the audio callback, e.g. sendFromRealtimeThread ("/meter/left", { level }).
+        Only one thread at a time may call this. You can't start or stop the queue while
+        it might be running.
+
+        @returns false if the message was dropped because the queue is full or hasn't been
+                 started, or because it had too long an address or too many arguments.
+        @see startRealtimeQueue, getRealtimeQueueStatistics
+    */
+    bool sendFromRealtimeThread (const char* addressPattern,
+                                 std::initializer_list<RealtimeArgument> arguments = {}) noexcept;
+
+    /** Adds a message with a list of float arguments to the realtime queue.
+        @see sendFromRealtimeThread
+    */
+    bool sendFromRealtimeThread (const char* addressPattern, const float* values, int numValues) noexcept;
+
+    /** Returns the statistics of the realtime queue since it was started. */
+    RealtimeQueueStatistics getRealtimeQueueStatistics() const noexcept;
+
 private:
     //==============================================================================
     struct Pimpl;
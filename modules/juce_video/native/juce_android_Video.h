@@ -464,6 +464,9 @@ struct VideoComponent::Pimpl
     void setVolume (float newVolume)      { mediaSession.setVolume (newVolume); }
     float getVolume() const               { return mediaSession.getVolume(); }
 
+    // Frame access isn't supported by the MediaPlayer renderer.
+    VideoComponent::VideoFrame getFrameAt (double) { return {}; }
+
     File currentFile;
     URL currentURL;
 
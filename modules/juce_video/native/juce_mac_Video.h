@@ -103,6 +103,7 @@ struct VideoComponent::Pimpl   : public Base
     void close()
     {
         stop();
+        detachVideoOutput();
         playerController.close();
         currentFile = File();
         currentURL = {};
@@ -184,6 +185,36 @@ struct VideoComponent::Pimpl   : public Base
         return 0.0f;
     }
 
+    VideoComponent::VideoFrame getFrameAt (double timeInSeconds)
+    {
+        auto* item = [playerController.getPlayer() currentItem];
+
+        if (item == nil)
+            return {};
+
+        if (videoOutputItem.get() != item)
+            attachVideoOutput (item);
+
+        const auto itemTime = CMTimeMakeWithSeconds (timeInSeconds, 100000);
+
+        if (! [videoOutput.get() hasNewPixelBufferForItemTime: itemTime])
+            return {};
+
+        CMTime displayTime = kCMTimeInvalid;
+        auto* pixelBuffer = [videoOutput.get() copyPixelBufferForItemTime: itemTime
+                                                       itemTimeForDisplay: &displayTime];
+
+        if (pixelBuffer == nullptr)
+            return {};
+
+        VideoComponent::VideoFrame frame;
+        frame.presentationTimeSeconds = toSeconds (displayTime);
+        frame.width  = (int) CVPixelBufferGetWidth (pixelBuffer);
+        frame.height = (int) CVPixelBufferGetHeight (pixelBuffer);
+        frame.nativeHandle = std::shared_ptr<void> (pixelBuffer, [] (void* b) { CVPixelBufferRelease ((CVPixelBufferRef) b); });
+        return frame;
+    }
+
     File currentFile;
     URL currentURL;
 
@@ -793,6 +824,38 @@ private:
 
     double playSpeedMult = 1.0;
 
+    NSUniquePtr<AVPlayerItemVideoOutput> videoOutput;
+    NSUniquePtr<AVPlayerItem> videoOutputItem;
+
+    void attachVideoOutput (AVPlayerItem* item)
+    {
+        detachVideoOutput();
+
+        // Asking for IOSurface-backed buffers lets the decoded frames be bound as GL textures
+        // without being copied.
+        NSDictionary* attributes = @{ (NSString*) kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+                                     (NSString*) kCVPixelBufferIOSurfacePropertiesKey: @{},
+                                    #if JUCE_MAC
+                                     (NSString*) kCVPixelBufferOpenGLCompatibilityKey: @YES
+                                    #else
+                                     (NSString*) kCVPixelBufferOpenGLESCompatibilityKey: @YES
+                                    #endif
+                                   };
+
+        videoOutput.reset ([[AVPlayerItemVideoOutput alloc] initWithPixelBufferAttributes: attributes]);
+        [item addOutput: videoOutput.get()];
+        videoOutputItem.reset ([item retain]);
+    }
+
+    void detachVideoOutput()
+    {
+        if (videoOutputItem != nullptr)
+            [videoOutputItem.get() removeOutput: videoOutput.get()];
+
+        videoOutputItem.reset();
+        videoOutput.reset();
+    }
+
     static double toSeconds (const CMTime& t) noexcept
     {
         return t.timescale != 0 ? (t.value / (double) t.timescale) : 0.0;
@@ -291,6 +291,12 @@ struct VideoComponent::Pimpl  : public Component,
         return videoLoaded ? context->getVolume() : 0.0f;
     }
 
+    VideoComponent::VideoFrame getFrameAt (double)
+    {
+        // Frame access isn't supported by the DirectShow renderer.
+        return {};
+    }
+
     void paint (Graphics& g) override
     {
         if (videoLoaded)
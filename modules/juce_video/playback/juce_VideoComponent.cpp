@@ -106,6 +106,11 @@ double VideoComponent::getPlaySpeed() const                 { return pimpl->getS
 void VideoComponent::setAudioVolume (float newVolume)       { pimpl->setVolume (newVolume); }
 float VideoComponent::getAudioVolume() const                { return pimpl->getVolume(); }
 
+VideoComponent::VideoFrame VideoComponent::getFrameAt (double timeInSeconds)
+{
+    return pimpl->getFrameAt (timeInSeconds);
+}
+
 void VideoComponent::resized()
 {
     auto r = getLocalBounds();
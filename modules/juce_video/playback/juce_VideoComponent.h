@@ -153,6 +153,39 @@ public:
     */
     float getAudioVolume() const;
 
+    //==============================================================================
+    /** A decoded video frame, as returned by getFrameAt(). */
+    struct VideoFrame
+    {
+        /** The time at which this frame should be shown, in seconds from the start of the video. */
+        double presentationTimeSeconds = 0.0;
+
+        /** The size of the frame, in pixels. */
+        int width = 0, height = 0;
+
+        /** A platform-specific handle to the decoder's pixel buffer, or nullptr if there's no frame.
+
+            On macOS and iOS this is a CVPixelBufferRef backed by an IOSurface, so it can be
+            bound to an OpenGL texture without copying, using a CVOpenGLTextureCache or
+            CGLTexImageIOSurface2D. The buffer stays alive while any copy of this object exists.
+        */
+        std::shared_ptr<void> nativeHandle;
+
+        /** Returns true if this object holds a frame. */
+        bool isValid() const noexcept       { return nativeHandle != nullptr; }
+    };
+
+    /** Returns the decoded frame that should be shown at the given time in the video.
+
+        Pass the position of your own audio clock to keep the picture in sync with audio
+        that you're rendering yourself. This returns an invalid frame if the frame for that
+        time hasn't been decoded yet, or if it's the same one that was returned last time.
+
+        This is currently only supported on macOS and iOS - on other platforms, it always
+        returns an invalid frame.
+    */
+    VideoFrame getFrameAt (double timeInSeconds);
+
    #if JUCE_SYNC_VIDEO_VOLUME_WITH_OS_MEDIA_VOLUME
     /** Set this callback to be notified whenever OS global media volume changes.
         Currently used on Android only.